@@ -116,6 +116,39 @@ void baryon(const LatticePropagator& quark_propagator,
   SpinMatrix S_proj = 
     0.5*((g_one + Gamma(8) * g_one) - timesI(Gamma(3) * g_one  +  Gamma(11) * g_one));
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  /* The distinct Proton and Delta^+ channels B_1..B_3 in one sweep */
+  SpinMatrix Cg5 = Gamma(5) * g_one;
+  SpinMatrix Cg5g4 = Gamma(13) * g_one;
+
+  multi1d<BaryonChannel> chan(6);
+  chan[0] = BaryonChannel(Cg5, S_proj, 1);
+  chan[1] = BaryonChannel(Cgm, S_proj, 2);
+  chan[2] = BaryonChannel(Cg5g4, S_proj, 1);
+  chan[3] = BaryonChannel(Cg4m, S_proj, 2);
+  chan[4] = BaryonChannel(Cg5 + Cg5g4, S_proj, 1);
+  chan[5] = BaryonChannel(CgmNR, S_proj, 2);
+
+  multi1d< multi1d<DComplex> > csum = 
+    sumMultiBaryons(quark_propagator, quark_propagator, quark_propagator, chan, timeslice);
+
+  /* Lambda_k = 3*Proton_k, and the Delta^+_k are multiplied by 3 for
+     compatibility with the heavy-light routine */
+  multi2d<DComplex> hsum_a(9, length);
+  for(int k = 0; k < 3; ++k)
+  {
+    barprop[3*k].resize(length);
+    barprop[3*k+1].resize(length);
+    barprop[3*k+2].resize(length);
+
+    for(int t = 0; t < length; ++t)
+    {
+      hsum_a(3*k,t)   = csum[2*k][t];
+      hsum_a(3*k+1,t) = Double(3) * csum[2*k][t];
+      hsum_a(3*k+2,t) = Double(3) * csum[2*k+1][t];
+    }
+  }
+#else
   LatticeComplex b_prop;
   multi1d<LatticeComplex> b_prop_a(9);
 
@@ -213,10 +246,11 @@ void baryon(const LatticePropagator& quark_propagator,
 
   /* Project on zero momentum: Do a slice-wise sum. */
   multi2d<DComplex> hsum_a = sumMulti(b_prop_a, timeslice);
+#endif
 
 
   /* Loop over baryons */
-  for(int baryons = 0; baryons < b_prop_a.size(); ++baryons)
+  for(int baryons = 0; baryons < barprop.size(); ++baryons)
   {
     /* forward */
     for(int t = 0; t < length; ++t)
@@ -0,0 +1,159 @@
+/*! \file
+ *  \brief Timed benchmark mode for the example programs
+ */
+
+#include "bench_harness.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace QDP;
+
+namespace
+{
+  //! Wait for all the nodes
+  void barrier()
+  {
+    double d = 0;
+    QDPInternal::globalSum(d);
+  }
+
+  //! Parse a list like 1,2,4
+  std::vector<int> parseList(const char* s)
+  {
+    std::vector<int> v;
+    for(const char* p=s; *p; )
+    {
+      v.push_back(atoi(p));
+      while (*p && *p != ',')
+	++p;
+      if (*p == ',')
+	++p;
+    }
+    return v;
+  }
+}
+
+
+BenchHarness::BenchHarness(int argc, char **argv) : bench(false), warmup(2), reps(10)
+{
+  std::string csv_file;
+
+  for(int i=1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-bench") == 0)
+      bench = true;
+    else if (strcmp(argv[i], "-bench-warmup") == 0 && i+1 < argc)
+      warmup = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "-bench-reps") == 0 && i+1 < argc)
+      reps = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "-bench-threads") == 0 && i+1 < argc)
+      threads = parseList(argv[++i]);
+    else if (strcmp(argv[i], "-bench-csv") == 0 && i+1 < argc)
+      csv_file = argv[++i];
+  }
+
+  if (threads.empty())
+    threads.push_back(qdpNumThreads());
+
+  if (bench && Layout::primaryNode() && ! csv_file.empty())
+  {
+    csv.open(csv_file.c_str());
+    if (! csv)
+    {
+      QDPIO::cerr << "BenchHarness: cannot write " << csv_file << std::endl;
+      QDP_abort(1);
+    }
+    csv << "workload,nodes,threads,reps,sec_min,sec_median,sec_mean,sec_stddev,sec_max,"
+	<< "rank_mean_min,rank_mean_max,gflops_per_sec" << std::endl;
+  }
+}
+
+
+void BenchHarness::time(const std::string& name, const std::function<void()>& f)
+{
+  if (! bench)
+  {
+    f();
+    return;
+  }
+
+  const int max_threads = qdpNumThreads();
+  const int nodes = Layout::numNodes();
+
+  for(int t=0; t < threads.size(); ++t)
+  {
+    int nthr = max_threads;
+#if defined(QDP_USE_OMP_THREADS)
+    nthr = std::max(1, std::min(threads[t], max_threads));
+    omp_set_num_threads(nthr);
+#else
+    // The thread count is fixed at QDP_initialize
+    if (t > 0)
+      break;
+#endif
+
+    // Count the flops of one call while warming up
+    const bool counting = getExprCounting();
+    const double flops0 = getExprFlops();
+    setExprCounting(true);
+    f();
+    double flops = double(getExprFlops()) - flops0;
+    setExprCounting(counting);
+    QDPInternal::globalSum(flops);
+
+    for(int w=1; w < warmup; ++w)
+      f();
+
+    std::vector<double> secs(reps);
+    for(int r=0; r < reps; ++r)
+    {
+      barrier();
+      const QDPTime_t t0 = getClockTime();
+      f();
+      secs[r] = 1.0e-9*(getClockTime() - t0);
+    }
+
+    std::vector<double> sorted(secs);
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0;
+    for(int r=0; r < reps; ++r)
+      mean += secs[r] / reps;
+    double var = 0;
+    for(int r=0; r < reps; ++r)
+      var += (secs[r] - mean)*(secs[r] - mean) / std::max(1, reps-1);
+    const double median = (reps % 2) ? sorted[reps/2] : 0.5*(sorted[reps/2-1] + sorted[reps/2]);
+
+    // The mean of every rank, to see one holding the others up
+    std::vector<double> rank_mean(nodes, 0.0);
+    rank_mean[Layout::nodeNumber()] = mean;
+    QDPInternal::globalSumArray(&rank_mean[0], nodes);
+    const double rmin = *std::min_element(rank_mean.begin(), rank_mean.end());
+    const double rmax = *std::max_element(rank_mean.begin(), rank_mean.end());
+
+    const double gflops = (flops > 0) ? flops / median / 1.0e9 : 0.0;
+
+    QDPIO::cout << "BENCH " << name << ": nodes= " << nodes << " threads= " << nthr
+		<< " reps= " << reps << " median= " << median << " s  min= " << sorted[0]
+		<< " max= " << sorted[reps-1] << " stddev= " << std::sqrt(var)
+		<< "  rank mean " << rmin << " .. " << rmax << " s";
+    if (flops > 0)
+      QDPIO::cout << "  " << gflops << " GFLOP/s";
+    QDPIO::cout << std::endl;
+
+    if (csv.is_open())
+    {
+      char line[512];
+      snprintf(line, sizeof(line), "%s,%d,%d,%d,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.4f\n",
+	       name.c_str(), nodes, nthr, reps, sorted[0], median, mean, std::sqrt(var),
+	       sorted[reps-1], rmin, rmax, gflops);
+      csv << line << std::flush;
+    }
+  }
+
+#if defined(QDP_USE_OMP_THREADS)
+  omp_set_num_threads(max_threads);
+#endif
+}
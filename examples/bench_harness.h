@@ -0,0 +1,49 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Timed benchmark mode for the example programs
+ *
+ * A program hands its kernels to a BenchHarness made from its arguments:
+ *
+ *   BenchHarness bench(argc, argv);
+ *   bench.time("dslash", [&]() {dslash(chi, u, psi, isign, cb);});
+ *
+ * Without -bench each kernel runs once and the program behaves as it
+ * did. With -bench each kernel runs -bench-warmup times untimed and then
+ * -bench-reps times, each rep timed on its own with the nodes starting
+ * together, for every thread count in -bench-threads. The statistics of
+ * the reps and the spread of the mean over the ranks are printed, and
+ * written as CSV to -bench-csv. The flops are those the expression
+ * counter sees in one warm-up call, so work done by the specialised
+ * kernels is not included.
+ */
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include "qdp.h"
+#include <functional>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class BenchHarness
+{
+public:
+  //! Read the -bench options from the program arguments
+  BenchHarness(int argc, char **argv);
+
+  //! Is the benchmark mode on
+  bool enabled() const {return bench;}
+
+  //! Run f once, or time it in the benchmark mode
+  void time(const std::string& name, const std::function<void()>& f);
+
+private:
+  bool bench;
+  int warmup;
+  int reps;
+  std::vector<int> threads;
+  std::ofstream csv;
+};
+
+#endif
@@ -46,11 +46,39 @@ void dslash2(LatticeFermion& chi, const multi1d<LatticeColorMatrix>& u, const La
 	    int isign, int cb);
 
 #ifdef QDP_USE_LIBXML2
+//! Write the links to an ILDG record in the precision of T
+template<class T>
+void writeILDGLinks(QDPFileWriter& out, XMLBufferWriter& record_xml, const multi1d<LatticeColorMatrix>& u)
+{
+  multi1d<T> u_out(Nd);
+  for(int mu=0; mu < Nd; mu++)
+    u_out[mu] = u[mu];
+  out.write(record_xml, u_out);
+}
+
+//! Write the links to an ILDG record in their own precision, without a copy
+template<>
+inline void writeILDGLinks<LatticeColorMatrix>(QDPFileWriter& out, XMLBufferWriter& record_xml, 
+					       const multi1d<LatticeColorMatrix>& u)
+{
+  out.write(record_xml, u);
+}
+
 void FormFac(const multi1d<LatticeColorMatrix>& u, const LatticePropagator& quark_propagator,
 	     const LatticePropagator& seq_quark_prop, const multi1d<int>& t_source, 
 	     int t_sink, int j_decay, XMLWriter& xml);
 #endif
 
+void deriv_loops(const multi1d<LatticeColorMatrix>& u,
+		 const int mu, const int nu, const int cb,
+		 LatticeColorMatrix& ds_u_mu,
+		 LatticeColorMatrix& ds_u_nu,
+		 const LatticeColorMatrix& Lambda);
+void deriv(const multi1d<LatticeColorMatrix>& u,
+	   multi1d<LatticeColorMatrix>& ds_u, 
+	   const LatticeFermion& chi, const LatticeFermion& psi, 
+	   int cb);
+
 void expm12(LatticeColorMatrix& a);
 
 void rgauge(multi1d<LatticeColorMatrix>& u, LatticeColorMatrix& g);
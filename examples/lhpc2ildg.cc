@@ -16,6 +16,8 @@ typedef struct {
   std::string ILDG_file_name;
   std::string dataLFN;
   int output_size;
+  bool parallel;   // every node reads and writes its own sites
+  bool verify;     // read the ILDG file back and print its plaquette
 } UserInput;
 
 int main(int argc, char *argv[])
@@ -62,6 +64,14 @@ int main(int argc, char *argv[])
     read(paramtop, "nrow", nrow);
     read(paramtop, "output_size", p.output_size);
 
+    p.parallel = false;
+    if (paramtop.count("parallel") > 0)
+      read(paramtop, "parallel", p.parallel);
+
+    p.verify = true;
+    if (paramtop.count("verify") > 0)
+      read(paramtop, "verify", p.verify);
+
   } catch(const std::string& e) { 
     QDPIO::cout << "Caught exception while reading XML: " << e << endl;
     QDP_abort(1);
@@ -81,6 +91,8 @@ int main(int argc, char *argv[])
   // Afterwards, QDP is useable
   Layout::create();
 
+  QDP_serialparallel_t serpar = p.parallel ? QDPIO_PARALLEL : QDPIO_SERIAL;
+
   // Try to read the NERSC Archive file
   multi1d<LatticeColorMatrix> u(Nd);
   
@@ -89,7 +101,7 @@ int main(int argc, char *argv[])
 
   QDPFileReader lhpc_in(file_in_xml,	
 			p.ILDG_file_name,
-			QDPIO_SERIAL);
+			serpar);
 
   lhpc_in.read(record_in_xml, u);
   lhpc_in.close();
@@ -155,51 +167,31 @@ int main(int argc, char *argv[])
   QDPFileWriter ildg_out(file_out,  
 			 outfilename,
 			 QDPIO_SINGLEFILE,
-			 QDPIO_SERIAL,
+			 serpar,
   			 p.dataLFN);
 
+  // No copy when the output precision is that of the build
+  if (p.output_size == 32)
+    writeILDGLinks<LatticeColorMatrixF>(ildg_out, record_out, u);
+  else
+    writeILDGLinks<LatticeColorMatrixD>(ildg_out, record_out, u);
 
-  switch( p.output_size ) { 
-  case 32:
-    {
-      multi1d<LatticeColorMatrixF> u_single_out(Nd);
-      for(int mu=0; mu < Nd; mu++) {
-	u_single_out[mu] = u[mu];
-      }
-      ildg_out.write(record_out, u_single_out);
-    }
-    break;
-  case 64:
-    {
-      multi1d<LatticeColorMatrixD> u_double_out(Nd);
-      for(int mu=0; mu < Nd; mu++) {
-	u_double_out[mu] = u[mu];
-      }
-      ildg_out.write(record_out, u_double_out);
-    }
-    break;
-  default: 
-    {
-      QDPIO::cerr << "Output precision must be either 32 or 64. You entered " << p.output_size << endl;
-      QDP_abort(1);
-      break;
-    }
-  }
   ildg_out.close();
 
-  // Reread the ILDG File
-  XMLReader record_back_in_xml;
-  XMLReader file_back_in_xml;
-  QDPFileReader ildg_back_in(file_back_in_xml, outfilename, QDPIO_SERIAL);
+  // Reread the ILDG File into the same links
+  if (p.verify)
+  {
+    XMLReader record_back_in_xml;
+    XMLReader file_back_in_xml;
+    QDPFileReader ildg_back_in(file_back_in_xml, outfilename, serpar);
+    ildg_back_in.read(record_back_in_xml, u);
 
-  multi1d<LatticeColorMatrix> u_back_in(Nd);
-  ildg_back_in.read(record_back_in_xml, u_back_in);
+    record_in_xml.print(cout);
+    cout.flush();
 
-  record_in_xml.print(cout);
-  cout.flush();
-
-  MesPlq(u_back_in, w_plaq, s_plaq, t_plaq, link);
-  QDPIO::cout << "Read Back Plaquette " << w_plaq << endl;
+    MesPlq(u, w_plaq, s_plaq, t_plaq, link);
+    QDPIO::cout << "Read Back Plaquette " << w_plaq << endl;
+  }
 
   pop(xmlout);
   xmlout.close();
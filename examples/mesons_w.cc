@@ -65,6 +65,22 @@ void mesons(const LatticePropagator& quark_prop_1, const LatticePropagator& quar
   // Contruct the antiquark prop
   LatticePropagator anti_quark_prop =  Gamma(G5) * quark_prop_2 * Gamma(G5);
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  // All the gamma channels, slice-wise summed in one sweep
+  multi1d< multi1d<DComplex> > gsum = sumMultiGammaTraces(anti_quark_prop, quark_prop_1, timeslice);
+
+  for(int n = 0; n < (Ns*Ns); ++n)
+  {
+    meson_propagator[n].resize(length);
+
+    for(int t = 0; t < length; ++t)
+    {
+      int t_eff = (t - t0 + length) % length;
+
+      meson_propagator[n][t_eff] = Real(real(gsum[n][t]));
+    }
+  }
+#else
   for(int n = 0; n < (Ns*Ns); ++n)
   {
     // Initialize the propagator so that we just add to it below
@@ -83,6 +99,7 @@ void mesons(const LatticePropagator& quark_prop_1, const LatticePropagator& quar
       meson_propagator[n][t_eff] += Real(hsum[t]);
     }
   }
+#endif
 
   END_CODE();
 }
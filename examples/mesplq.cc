@@ -26,12 +26,20 @@ void MesPlq(const multi1d<LatticeColorMatrix>& u, Double& w_plaq, Double& s_plaq
 
   s_plaq = t_plaq = w_plaq = link = 0.0;
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  // All the planes in one sweep
+  multi2d<Double> plaq = sumPlaquettes(u);
+#endif
+
   // Compute the average plaquettes
   for(int mu=1; mu < Nd; ++mu)
   {
     for(int nu=0; nu < mu; ++nu)
     {
-#if 1
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+      Double tmp = plaq(mu,nu);
+
+#elif 1
       /* tmp_0 = u(x+mu,nu)*u_dag(x+nu,mu) */
       LatticeColorMatrix tmp_0 = shift(u[nu],FORWARD,mu) * adj(shift(u[mu],FORWARD,nu));
 
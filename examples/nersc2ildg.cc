@@ -12,13 +12,92 @@
 
 using namespace QDP;
 
+//! One configuration to convert
 typedef struct { 
   std::string NERSC_file_name;
   std::string ILDG_file_name;
   std::string dataLFN;
+} ConfigFiles;
+
+typedef struct { 
+  multi1d<ConfigFiles> configs;
   int output_size;
+  bool parallel;   // every node reads and writes its own sites
+  bool verify;     // read the ILDG file back and check its plaquette
 } UserInput;
 
+
+//! Read the names of one configuration
+void read(XMLReader& xml, const std::string& path, ConfigFiles& c)
+{
+  XMLReader top(xml, path);
+  read(top, "NERSC_file", c.NERSC_file_name);
+  read(top, "ILDG_file", c.ILDG_file_name);
+  read(top, "dataLFN", c.dataLFN);
+}
+
+
+//! Convert one configuration
+/*!
+  The NERSC payload is read straight into the links, byte swapped,
+  checksummed and with its third row made in the same pass, from every
+  node at once when parallel. The links are then written without a copy
+  when the output precision is that of the build.
+*/
+void convert(const ConfigFiles& c, const UserInput& p, multi1d<LatticeColorMatrix>& u)
+{
+  QDP_serialparallel_t serpar = p.parallel ? QDPIO_PARALLEL : QDPIO_SERIAL;
+
+  // Reading checks the checksum and the plaquette against the header
+  ArchivGauge_t header;
+  readArchiv(header, u, c.NERSC_file_name);
+
+  XMLBufferWriter file_metadata;
+  push(file_metadata, "file_metadata");
+  write(file_metadata, "annotation", "NERSC Config Converted by QDP++ NERS2ILDG");
+  pop(file_metadata);
+
+  QDPFileWriter ildg_out(file_metadata,  
+			 c.ILDG_file_name,
+			 QDPIO_SINGLEFILE,
+			 serpar,
+  			 c.dataLFN);
+
+  XMLBufferWriter record_metadata;
+  push(record_metadata, "record_metadata");
+  write(record_metadata, "annotation", "NERSC Config Record Converted by QDP++ NERSC2ILDG");
+  pop(record_metadata);
+
+  if (p.output_size == 32)
+    writeILDGLinks<LatticeColorMatrixF>(ildg_out, record_metadata, u);
+  else
+    writeILDGLinks<LatticeColorMatrixD>(ildg_out, record_metadata, u);
+
+  ildg_out.close();
+
+  if (! p.verify)
+    return;
+
+  // Reread the ILDG File into the same links
+  XMLReader record_in_xml;
+  XMLReader file_in_xml;
+  QDPFileReader ildg_back_in(file_in_xml, c.ILDG_file_name, serpar);
+  ildg_back_in.read(record_in_xml, u);
+  ildg_back_in.close();
+
+  Double w_plaq, s_plaq, t_plaq, link;
+  MesPlq(u, w_plaq, s_plaq, t_plaq, link);
+  QDPIO::cout << c.ILDG_file_name << ": read back plaquette " << w_plaq 
+	      << "  header value= " << header.w_plaq << endl;
+
+  if (toBool(fabs(w_plaq - header.w_plaq) > 1.e-5))
+  {
+    QDPIO::cerr << c.ILDG_file_name << ": plaquette read back does not agree with the NERSC header" << endl;
+    QDP_abort(1);
+  }
+}
+
+
 int main(int argc, char *argv[])
 {
   // Put the machine into a known state
@@ -35,12 +114,29 @@ int main(int argc, char *argv[])
     
 
     XMLReader paramtop(param, "/nersc2ildg");
-    read(paramtop, "NERSC_file", p.NERSC_file_name);
-    read(paramtop, "ILDG_file", p.ILDG_file_name);
-    read(paramtop, "dataLFN", p.dataLFN);
+
+    // A list of configurations, or a single one
+    if (paramtop.count("configs") > 0)
+      read(paramtop, "configs", p.configs);
+    else
+    {
+      p.configs.resize(1);
+      read(paramtop, "NERSC_file", p.configs[0].NERSC_file_name);
+      read(paramtop, "ILDG_file", p.configs[0].ILDG_file_name);
+      read(paramtop, "dataLFN", p.configs[0].dataLFN);
+    }
+
     read(paramtop, "nrow", nrow);
     read(paramtop, "output_size", p.output_size);
 
+    p.parallel = false;
+    if (paramtop.count("parallel") > 0)
+      read(paramtop, "parallel", p.parallel);
+
+    p.verify = true;
+    if (paramtop.count("verify") > 0)
+      read(paramtop, "verify", p.verify);
+
   } catch(const std::string& e) { 
     QDPIO::cout << "Caught exception while reading XML: " << e << endl;
     QDP_abort(1);
@@ -60,71 +156,16 @@ int main(int argc, char *argv[])
   // Afterwards, QDP is useable
   Layout::create();
 
-  // Try to read the NERSC Archive file
-  multi1d<LatticeColorMatrix> u(Nd);
-  readArchiv(u, p.NERSC_file_name);
+  setArchivParallel(p.parallel);
 
-  // Do checks here.
-  XMLBufferWriter file_metadata;
-  push(file_metadata, "file_metadata");
-  write(file_metadata, "annotation", "NERSC Config Converted by QDP++ NERS2ILDG");
-  pop(file_metadata);
-
-  Double w_plaq, s_plaq, t_plaq, link;
-  MesPlq(u, w_plaq, s_plaq, t_plaq, link);
-
-  QDPFileWriter ildg_out(file_metadata,  
-			 p.ILDG_file_name,
-			 QDPIO_SINGLEFILE,
-			 QDPIO_SERIAL,
-  			 p.dataLFN);
-
-  XMLBufferWriter record_metadata;
-  push(record_metadata, "record_metadata");
-  write(record_metadata, "annotation", "NERSC Config Record Converted by QDP++ NERSC2ILDG");
-  pop(record_metadata);
-
-  switch( p.output_size ) { 
-  case 32:
-    {
-      multi1d<LatticeColorMatrixF> u_single_out(Nd);
-      for(int mu=0; mu < Nd; mu++) {
-	u_single_out[mu] = u[mu];
-      }
-      ildg_out.write(record_metadata, u_single_out);
-    }
-    break;
-  case 64:
-    {
-      multi1d<LatticeColorMatrixD> u_double_out(Nd);
-      for(int mu=0; mu < Nd; mu++) {
-	u_double_out[mu] = u[mu];
-      }
-      ildg_out.write(record_metadata, u_double_out);
-    }
-    break;
-  default: 
-    {
-      QDPIO::cerr << "Output precision must be either 32 or 64. You entered " << p.output_size << endl;
-      QDP_abort(1);
-      break;
-    }
+  // One layout and one set of links for the whole ensemble
+  multi1d<LatticeColorMatrix> u(Nd);
+  for(int i=0; i < p.configs.size(); i++)
+  {
+    QDPIO::cout << "Converting " << p.configs[i].NERSC_file_name 
+		<< " to " << p.configs[i].ILDG_file_name << endl;
+    convert(p.configs[i], p, u);
   }
-  ildg_out.close();
-
-  // Reread the ILDG File
-  XMLReader record_in_xml;
-  XMLReader file_in_xml;
-  QDPFileReader ildg_back_in(file_in_xml, p.ILDG_file_name, QDPIO_SERIAL);
-
-  multi1d<LatticeColorMatrix> u_back_in(Nd);
-  ildg_back_in.read(record_in_xml, u_back_in);
-
-  record_in_xml.print(cout);
-  cout.flush();
-
-  MesPlq(u_back_in, w_plaq, s_plaq, t_plaq, link);
-  QDPIO::cout << "Read Back Plaquette " << w_plaq << endl;
 
     // Possibly shutdown the machine
   QDP_finalize();
@@ -24,17 +24,26 @@ void rgauge(multi1d<LatticeColorMatrix>& u, LatticeColorMatrix& g)
   
   // g = exp(A), where A = random traceless antihermitian matrix.
   
-  // NOTE!!!!: we are using a hack. The twelth_order exponentiation followed
-  //   by a reunitarization should be replace by an exact exponentiation.
-  //   So, the gauge field distriubution is NOT from Haar measure, but
+  // NOTE!!!!: the gauge field distriubution is NOT from Haar measure, but
   //   if someone can think of a really good reason why it should be Haar
-  //   measure, then something can be done about it.
+  //   measure, then something can be done about it. For SU(3) the
+  //   exponentiation is exact, otherwise it is the twelth_order one
+  //   followed by a reunitarization.
   
   gaussian(g);
 
-  taproj(g);
-  expm12(g);
-  reunit(g);
+  if (Nc == 3)
+  {
+    // exp(A) = exp(i Q) with Q = -i A
+    projectTA(g);
+    expiQ(g, timesMinusI(g));
+  }
+  else
+  {
+    taproj(g);
+    expm12(g);
+    reunit(g);
+  }
     
   for(int mu = 0; mu < Nd; ++mu)
   {
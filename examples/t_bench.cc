@@ -0,0 +1,81 @@
+/*! \file
+ *  \brief Time the kernels of the example programs
+ *
+ * Runs the Wilson dslash, the plaquette, the meson and baryon
+ * contractions and the clover force on a random gauge field and
+ * propagator through the BenchHarness, so
+ *
+ *   t_bench -lat 8 8 8 16 -bench -bench-reps 20 -bench-threads 1,2,4 -bench-csv t.csv
+ *
+ * gives the time of each with its spread over reps, threads and ranks.
+ * Without -bench every kernel runs once.
+ */
+
+#include "qdp.h"
+#include "examples.h"
+#include "bench_harness.h"
+
+using namespace QDP;
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  multi1d<int> nrow(Nd);
+  nrow = 8;
+
+  for(int i=1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-lat") == 0 && i+Nd < argc)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+	nrow[mu] = atoi(argv[++i]);
+    }
+  }
+
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  BenchHarness bench(argc, argv);
+
+  // Random gauge field, fermions and propagator
+  multi1d<LatticeColorMatrix> u(Nd);
+  multi1d<LatticeColorMatrix> ds_u;
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  LatticeFermion psi, chi;
+  gaussian(psi);
+  gaussian(chi);
+
+  LatticePropagator quark_prop;
+  gaussian(quark_prop);
+
+  const int j_decay = Nd-1;
+  multi1d<int> t_source(Nd);
+  t_source = 0;
+
+  bench.time("dslash", [&]() {dslash(chi, u, psi, +1, 0);});
+  bench.time("dslash2", [&]() {dslash2(chi, u, psi, +1, 0);});
+
+  Double w_plaq, s_plaq, t_plaq, link;
+  bench.time("MesPlq", [&]() {MesPlq(u, w_plaq, s_plaq, t_plaq, link);});
+  QDPIO::cout << "w_plaq = " << w_plaq << "  link = " << link << std::endl;
+
+  multi1d< multi1d<Real> > meson_prop;
+  bench.time("mesons", [&]() {mesons(quark_prop, quark_prop, meson_prop, t_source, j_decay);});
+
+  multi1d< multi1d<Complex> > bar_prop;
+  bench.time("baryon", [&]() {baryon(quark_prop, bar_prop, t_source, j_decay, 1);});
+
+  bench.time("deriv", [&]() {deriv(u, ds_u, chi, psi, 0);});
+
+  // Possibly shutdown the machine
+  QDP_finalize();
+
+  exit(0);
+}
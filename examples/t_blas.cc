@@ -728,7 +728,53 @@ int main(int argc, char *argv[])
   }
   dreal = innerProductReal(lqx,lqy,rb[1]);
   QDPIO::cout << "Diff innerProductReal(multi1d) Subset = " << Real(daccr-dreal) << endl;
-  
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  // Test the interleaved block against the separate vectors
+  {
+    LatticeColorMatrix u;
+    gaussian(u);
+
+    LatticeFermionBlock bx(NN), by(NN);
+    multi1d<Complex> ca(NN);
+    for(int i=0; i < NN; ++i) {
+      bx.insert(i, lqx[i]);
+      by.insert(i, lqy[i]);
+      ca[i] = cmplx(Real(i+1), Real(0.5));
+    }
+
+    axpy(by, ca, bx, rb[1]);
+    multiply(by, u, by, rb[1]);
+    multi1d<Double>   bn = norm2(by, rb[1]);
+    multi1d<DComplex> bi = innerProduct(bx, by, rb[1]);
+
+    dreal = zero;
+    Double dimag = zero;
+    for(int i=0; i < NN; ++i) {
+      LatticeFermion t = lqy[i];
+      t[rb[1]] += ca[i]*lqx[i];
+      t[rb[1]] = u*t;
+      dreal += fabs(bn[i] - norm2(t,rb[1])) / bn[i];
+      dimag += norm2(bi[i] - innerProduct(lqx[i],t,rb[1])) / norm2(bi[i]);
+    }
+    QDPIO::cout << "Diff norm2(LatticeFermionBlock) Subset = " << dreal << endl;
+    QDPIO::cout << "Diff innerProduct(LatticeFermionBlock) Subset = " << dimag << endl;
+  }
+
+  // Test the REAL64 accumulated single precision reductions
+  {
+    LatticeFermionF fx = lqx[0], fy = lqy[0];
+    LatticeFermionD dx = fx, dy = fy;
+
+    dreal = mixedNorm2(fx,rb[1]) - norm2(dx,rb[1]);
+    QDPIO::cout << "Diff mixedNorm2 Subset = " << dreal << endl;
+
+    dy[rb[1]] += Double(a)*dx;
+    dreal = axpyNorm2(fy, a, fx, rb[1]) - norm2(dy,rb[1]);
+    QDPIO::cout << "Diff axpyNorm2 Subset = " << dreal << endl;
+  }
+#endif
+
 #endif
   // Timings
    // Test VSCAL
@@ -104,6 +104,70 @@ int main(int argc, char **argv)
     }
   }
 
+  // The fused hopping term against dslash
+  for(int isign=-1; isign < 2; isign+=2) { 
+    for(int cb=0; cb<2; cb++) {
+      int otherCB= cb == 0 ? 1 : 0;
+      dslash(chi, u, psi, isign, cb);
+      chi2 = zero;
+      wilsonHop(chi2, u, psi, isign, rb[cb]);
+      LatticeFermion diff;
+      diff[rb[cb]]= chi2 - chi;
+      QDPIO::cout << "wilsonHop: isign="<<isign<<" cb=" << cb << " Diff = " << sqrt( norm2(diff,rb[cb]) / norm2(psi, rb[otherCB]))<< std::endl;
+    }
+  }
+
+  // The hopping term with the links packed by checkerboard
+  PackedGauge<REAL> packed;
+  packed.pack(u);
+  for(int isign=-1; isign < 2; isign+=2) {
+    for(int cb=0; cb<2; cb++) {
+      int otherCB= cb == 0 ? 1 : 0;
+      dslash(chi, u, psi, isign, cb);
+      chi2 = zero;
+      wilsonHop(chi2, packed, psi, isign, cb);
+      LatticeFermion diff;
+      diff[rb[cb]]= chi2 - chi;
+      QDPIO::cout << "packed wilsonHop: isign="<<isign<<" cb=" << cb << " Diff = " << sqrt( norm2(diff,rb[cb]) / norm2(psi, rb[otherCB]))<< std::endl;
+    }
+  }
+
+  {
+    int isign = +1;
+    int cb = 0;
+    QDPIO::cout << "Applying wilsonHop" << std::endl;
+      
+    clock_t myt1=clock();
+    for(int i=0; i < iter; i++)
+      wilsonHop(chi, u, psi, isign, rb[cb]);
+    clock_t myt2=clock();
+      
+    double mydt=(double)(myt2-myt1)/((double)(CLOCKS_PER_SEC));
+    mydt=1.0e6*mydt/((double)(iter*(Layout::vol()/2)));
+      
+    QDPIO::cout << "cb = " << cb << " isign = " << isign << std::endl;
+    QDPIO::cout << "The time per lattice point is "<< mydt << " micro sec" 
+		<< " (" <<  (double)(1392.0f/mydt) << ") Mflops " << std::endl;
+  }
+
+  {
+    int isign = +1;
+    int cb = 0;
+    QDPIO::cout << "Applying packed wilsonHop" << std::endl;
+      
+    clock_t myt1=clock();
+    for(int i=0; i < iter; i++)
+      wilsonHop(chi, packed, psi, isign, cb);
+    clock_t myt2=clock();
+      
+    double mydt=(double)(myt2-myt1)/((double)(CLOCKS_PER_SEC));
+    mydt=1.0e6*mydt/((double)(iter*(Layout::vol()/2)));
+      
+    QDPIO::cout << "cb = " << cb << " isign = " << isign << std::endl;
+    QDPIO::cout << "The time per lattice point is "<< mydt << " micro sec" 
+		<< " (" <<  (double)(1392.0f/mydt) << ") Mflops " << std::endl;
+  }
+
   // Time to bolt
   QDP_finalize();
 
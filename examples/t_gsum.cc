@@ -114,6 +114,17 @@ int main(int argc, char *argv[])
   Double double_norm_diff4(  (local_norm2_site_global_result - double_global_sum )/ ( double_global_sum ) );
   QDPIO::cout << "( local_norm2 Single SSE on Site, DP Accross Nodes - DP Norm 2 ) / ( DP Norm 2 ) = " << double_norm_diff4 << endl;
 
+  // ----------------------------------------------------------------------//
+  // Split-phase sum overlapped with local work                            //
+  // ----------------------------------------------------------------------//
+  REAL64 async_global_sum = double_local_sum;
+  QDPInternal::GlobalSumHandle h = QDPInternal::globalSumAsync(async_global_sum);
+  Double overlap_norm2 = norm2(x);
+  h.wait();
+
+  Double double_norm_diff6( (async_global_sum - double_global_sum) / ( double_global_sum ) );
+  QDPIO::cout << "( Split-phase DP Sum - DP Norm 2 ) / ( DP Norm 2 ) = " << double_norm_diff6 << endl;
+
 #if 0
   REAL64 local_norm2_result;
   local_sumsq_24_48(&local_norm2_result, &x.elem(0).elem(0).elem(0).real(), nvec);
@@ -46,6 +46,68 @@ int main(int argc, char **argv)
     frombinary.close();
   }
 
+  // Test parallel writing and reading
+  {
+    BinaryFileWriter tobinary("t_io_par.bin");
+    tobinary.setParallel(true);
+    write(tobinary, a);
+    write(tobinary, d);
+    QDPIO::cout <<  "WriteBinary: t_io_par.bin:checksum = " << tobinary.getChecksum() << std::endl;
+    tobinary.close();
+
+    BinaryFileReader frombinary("t_io_par.bin");
+    frombinary.setParallel(true);
+    read(frombinary, aa);
+    read(frombinary, dd);
+    QDPIO::cout <<  "ReadBinary: t_io_par.bin:checksum = " << frombinary.getChecksum() << std::endl;
+    QDPIO::cout <<  "ReadBinary: t_io_par.bin: norm2(a-aa) = " << norm2(a-aa) << std::endl;
+    frombinary.close();
+  }
+
+  // Test background writing
+  {
+    AsyncLatticeWriter tobinary;
+    tobinary.open("t_io_async.bin");
+    tobinary.write(a);
+    tobinary.wait();
+    QDPIO::cout <<  "AsyncWrite: t_io_async.bin:checksum = " << tobinary.getChecksum() << std::endl;
+
+    BinaryFileReader frombinary("t_io_async.bin");
+    read(frombinary, aa);
+    QDPIO::cout <<  "ReadBinary: t_io_async.bin: norm2(a-aa) = " << norm2(a-aa) << std::endl;
+    frombinary.close();
+  }
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  // Test part files, cut differently from the nodes
+  {
+    multi1d<int> grid(Nd);
+    grid = 1;
+    grid[Nd-1] = 2;
+
+    PartFileWriter toparts;
+    toparts.open("t_io_parts", grid);
+    toparts.write(a);
+#if defined(QDP_USE_ZLIB)
+    PartFileCompression lossy;
+    lossy.rel_error = 1.0e-5;
+    toparts.setCompression(lossy);
+    toparts.write(a);
+#endif
+    toparts.close();
+
+    PartFileReader fromparts;
+    fromparts.open("t_io_parts");
+    fromparts.read(aa);
+    QDPIO::cout <<  "ReadParts: t_io_parts: norm2(a-aa) = " << norm2(a-aa) << std::endl;
+#if defined(QDP_USE_ZLIB)
+    fromparts.read(aa);
+    QDPIO::cout <<  "ReadParts: t_io_parts: lossy norm2(a-aa)/norm2(a) = " << norm2(a-aa)/norm2(a) << std::endl;
+#endif
+    fromparts.close();
+  }
+#endif
+
   // Test seeks
   {
     BinaryFileReader frombinary("t_io.bin");
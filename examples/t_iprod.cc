@@ -156,6 +156,35 @@ using namespace QDP;
     }
   }
 
+  namespace
+  {
+    //! Function object of the set of blocks, numbered lexicographically
+    class BlockFunc : public SetFunc
+    {
+    public:
+      BlockFunc(const multi1d<int>& block_): block(block_) {}
+
+      int operator() (const multi1d<int>& coordinate) const
+	{
+	  int b = 0;
+	  for(int mu=Nd-1; mu >= 0; --mu)
+	    b = b*(Layout::lattSize()[mu]/block[mu]) + coordinate[mu]/block[mu];
+	  return b;
+	}
+
+      int numSubsets() const
+	{
+	  int nb = 1;
+	  for(int mu=0; mu < Nd; ++mu)
+	    nb *= Layout::lattSize()[mu]/block[mu];
+	  return nb;
+	}
+
+    private:
+      multi1d<int> block;
+    };
+  }
+
 int main(int argc, char *argv[])
 {
 
@@ -191,6 +220,202 @@ int main(int argc, char *argv[])
 
   multi1d<ComplexD> iprod1 = sumMulti(localInnerProduct(s1,s2),my_set);
 
+  // Summing over the subset site tables must agree with the coloring pass
+  multi1d<ComplexD> iprod3 = sumMultiSubsets(localInnerProduct(s1,s2),my_set);
+  for(int i=0; i < iprod1.size(); i++) { 
+    QDPIO::cout << "subsets diff["<< i <<"] = " << norm2(iprod1[i]-iprod3[i]) << std::endl;
+  }
+  QDPIO::cout << std::endl;
+
+  // Fused reductions must agree with the separate calls
+  {
+    Double n1, n2;
+    DComplex ip;
+    MultiReduction red(all);
+    red.norm2(n1, s1);
+    red.innerProduct(ip, s1, s2);
+    red.norm2(n2, s2);
+    red.evaluate();
+
+    QDPIO::cout << "fused norm2 diff = " << Double(n1 - norm2(s1)) 
+		<< "  innerProduct diff = " << Double(sqrt(norm2(ip - innerProduct(s1,s2))))
+		<< "  norm2 diff = " << Double(n2 - norm2(s2)) << std::endl;
+  }
+
+  // Fused statements must agree with the separate ones
+  {
+    LatticeColorVector r1, p1, r2, p2;
+    Double rr1, rr2;
+    r1 = s1 - Real(0.5)*s2;
+    p1 = r1;
+    rr1 = norm2(r1);
+    {
+      DeferredScope fused(all);
+      fused.assign(r2, s1 - Real(0.5)*s2);
+      fused.assign(p2, r2);
+      fused.norm2(rr2, r2);
+    }
+
+    QDPIO::cout << "deferred r diff = " << Double(norm2(r2 - r1))
+		<< "  p diff = " << Double(norm2(p2 - p1))
+		<< "  norm2 diff = " << Double(rr2 - rr1) << std::endl;
+  }
+
+  // Momentum projections must agree with sums of phase fields
+  {
+    multi1d< multi1d<int> > moms(2);
+    moms[0].resize(Nd);
+    moms[0] = 0;
+    moms[1] = moms[0];
+    moms[1][0] = 1;
+
+    multi2d<DComplex> pm = sumMultiMomenta(localInnerProduct(s1,s2), my_set, moms);
+
+    LatticeReal arg = Real(2*M_PI/nrow[0]) * LatticeReal(Layout::latticeCoordinate(0));
+    multi1d<DComplex> p0 = sumMulti(localInnerProduct(s1,s2), my_set);
+    multi1d<DComplex> p1 = sumMulti(cmplx(cos(arg),sin(arg)) * localInnerProduct(s1,s2), my_set);
+
+    Double d0 = zero, d1 = zero;
+    for(int i=0; i < p0.size(); i++) {
+      d0 += norm2(p0[i] - pm[0][i]);
+      d1 += norm2(p1[i] - pm[1][i]);
+    }
+    QDPIO::cout << "momenta diff p=0 " << d0 << "  p=1 " << d1 << std::endl;
+
+    // And so must the Fourier transform of each timeslice
+    LatticeComplex ft = localInnerProduct(s1,s2);
+    fft3d(ft, +1, 3);
+
+    Double d2 = zero;
+    multi1d<int> coord(moms[1]);
+    for(int i=0; i < p0.size(); i++) {
+      coord[3] = i;
+      d2 += norm2(DComplex(peekSite(ft, coord)) - pm[1][i]);
+    }
+    QDPIO::cout << "fft3d diff p=1 " << d2 << std::endl;
+  }
+
+  // Block restriction must agree with sums over the set of blocks
+  {
+    multi1d<int> block(Nd);
+    block = 4;
+    block[Nd-1] = 8;
+    BlockAggregation agg(block);
+
+    const int n = 3;
+    LatticeColorVectorBlock v(n);
+    for(int k=0; k < n; ++k) {
+      LatticeColorVector t;
+      gaussian(t);
+      v.insert(k, t);
+    }
+
+    multi2d<DComplex> c;
+    blockRestrict(c, v, s1, agg);
+
+    Set blocks;
+    blocks.make(BlockFunc(block));
+
+    Double d0 = zero;
+    for(int k=0; k < n; ++k) {
+      LatticeColorVector vk;
+      v.extract(k, vk);
+      multi1d<DComplex> ck = sumMulti(localInnerProduct(vk,s1), blocks);
+
+      for(int b=0; b < agg.numBlocks(); ++b) {
+	multi1d<int> cc = agg.coarseCoord(b);
+	int lex = 0;
+	for(int mu=Nd-1; mu >= 0; --mu)
+	  lex = lex*agg.coarseLattSize()[mu] + cc[mu];
+	d0 += norm2(c(b,k) - ck[lex]);
+      }
+    }
+
+    // After orthonormalizing, restriction undoes prolongation
+    blockOrthonormalize(v, agg);
+    LatticeColorVector t;
+    blockProlong(t, v, c, agg);
+    multi2d<DComplex> c2;
+    blockRestrict(c2, v, t, agg);
+
+    Double d1 = zero;
+    for(int b=0; b < agg.numBlocks(); ++b)
+      for(int k=0; k < n; ++k)
+	d1 += norm2(c2(b,k) - c(b,k));
+
+    QDPIO::cout << "block restrict diff " << d0 << "  restrict(prolong) diff " << d1 << std::endl;
+
+    // The first coarse vector as a field of the coarse lattice
+    LatticeLayout coarse(agg.coarseLattSize());
+    LatticeComplex ck(coarse);
+    Double n0 = zero;
+    for(int b=0; b < agg.numBlocks(); ++b) {
+      Complex cb = c(b,0);
+      ck.elem(coarse.linearSiteIndex(agg.coarseCoord(b))) = cb.elem();
+      n0 += localNorm2(cb);
+    }
+    QDPInternal::globalSum(n0);
+
+    LatticeComplex ck2 = ck + ck;
+    Double d2 = fabs(norm2(ck) - n0) / n0;
+    Double d3 = norm2(ck2 - Real(2)*ck) + fabs(norm2(ck,coarse.rb()[0]) + norm2(ck,coarse.rb()[1]) - norm2(ck));
+    ck2 = zero;
+    d3 += norm2(ck2);
+
+    // Shifts on a five dimensional lattice of coordinate labels
+    multi1d<int> size5(Nd+1);
+    for(int mu=0; mu < Nd; ++mu)
+      size5[mu] = coarse.lattSize()[mu];
+    size5[Nd] = 4;
+    LatticeLayout fifth(size5);
+
+    LatticeInteger lab(fifth);
+    const int node = Layout::nodeNumber();
+    for(int i=0; i < fifth.sitesOnNode(); ++i) {
+      multi1d<int> x = fifth.siteCoords(node, i);
+      int l = 0;
+      for(int mu=Nd; mu >= 0; --mu)
+	l = l*size5[mu] + x[mu];
+      lab.elem(i).elem().elem().elem() = l;
+    }
+
+    int bad = 0;
+    for(int mu=0; mu <= Nd; ++mu)
+      for(int isign=+1; isign >= -1; isign -= 2) {
+	LatticeInteger sh = fifth.shift(lab, isign, mu);
+	for(int i=0; i < fifth.sitesOnNode(); ++i) {
+	  multi1d<int> x = fifth.siteCoords(node, i);
+	  x[mu] = (x[mu] + isign + size5[mu]) % size5[mu];
+	  int l = 0;
+	  for(int nu=Nd; nu >= 0; --nu)
+	    l = l*size5[nu] + x[nu];
+	  bad += (sh.elem(i).elem().elem().elem() != l);
+	}
+      }
+    QDPInternal::globalSum(bad);
+
+    QDPIO::cout << "coarse lattice norm diff " << d2 << "  expr diff " << d3
+		<< "  bad 5d shifts " << bad << std::endl;
+  }
+
+  // 16 bit storage: expressions on it must agree with its REAL32 copy
+  {
+    LatticeColorVectorF x = s1, y = s2;
+    LatticeColorVectorH h = x;
+    LatticeColorVectorF hx = h;
+
+    Double dround = sqrt(norm2(hx - x) / norm2(x));
+    Double dnorm = norm2(h) - norm2(hx);
+    Double dinner = sqrt(norm2(innerProduct(h, y) - innerProduct(hx, y)));
+    LatticeColorVectorF z1 = Real(0.5)*h + shift(h, FORWARD, 0);
+    LatticeColorVectorF z2 = Real(0.5)*hx + shift(hx, FORWARD, 0);
+    Double dexpr = norm2(z1 - z2);
+    Double dmixed = mixedNorm2(h) - norm2(hx);
+
+    QDPIO::cout << "half rounding " << dround << "  norm2 diff " << dnorm << "  innerProduct diff " << dinner
+		<< "  expr diff " << dexpr << "  mixedNorm2 diff " << dmixed << std::endl;
+  }
+
 #if 0
   int n_threads=qdpNumThreads();
   int n_color = my_set.numSubsets();
@@ -198,9 +423,9 @@ int main(int argc, char *argv[])
 
   multi1d<ComplexD> iprod2 = innerProductMulti(s1,s2,my_set);
   for(int i=0; i < iprod1.size(); i++) { 
-    QDPIO::cout << "diff["<< i <<"] = " << norm2(iprod1[i]-iprod2[i]) << endl;
+    QDPIO::cout << "diff["<< i <<"] = " << norm2(iprod1[i]-iprod2[i]) << std::endl;
   }
-  QDPIO::cout << endl;
+  QDPIO::cout << std::endl;
 #endif
 
 
@@ -213,7 +438,16 @@ int main(int argc, char *argv[])
     iprod1 = sumMulti(localInnerProduct(s1,s2),my_set);
   }
   swatch.stop();
-  QDPIO::cout << "Old Way Time = " << swatch.getTimeInSeconds() << endl;
+  QDPIO::cout << "Old Way Time = " << swatch.getTimeInSeconds() << std::endl;
+
+  swatch.reset();
+  swatch.start();
+
+  for(int i=0; i < 500; i++)  {
+    iprod3 = sumMultiSubsets(localInnerProduct(s1,s2),my_set);
+  }
+  swatch.stop();
+  QDPIO::cout << "Subset Tables Time = " << swatch.getTimeInSeconds() << std::endl;
 
 #if 0
   swatch.reset();
@@ -224,7 +458,7 @@ int main(int argc, char *argv[])
     iprod2 = innerProductMulti(s1,s2,my_set);
   }
   swatch.stop();
-  QDPIO::cout << "New Way Time = " << swatch.getTimeInSeconds() << endl;
+  QDPIO::cout << "New Way Time = " << swatch.getTimeInSeconds() << std::endl;
 #endif
 
   // Possibly shutdown the machine
@@ -3,6 +3,8 @@
 #include <iostream>
 
 #include "qdp_map_obj_disk.h"
+#include "qdp_map_obj_disk_sharded.h"
+#include "qdp_map_obj_disk_multiple.h"
 #include "qdp_disk_map_slice.h"
 
 // Including these just to check compilation
@@ -497,6 +499,61 @@ int main(int argc, char *argv[])
   }
 #endif
 
+#if 1
+  //
+  // Test batched inserts and compaction
+  //
+  try {
+    MapObjectDisk<char,float> made_map;
+    made_map.setWriteBehind(16);
+    made_map.insertUserdata(meta_data);
+    made_map.open(map_obj_file, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
+
+    testMapObjInsertions(made_map);
+    testMapObjLookups(made_map);
+    made_map.close();
+
+    compactMapObjectDisk<char,float>(map_obj_file, "t_map_obj_disk_compact.mod");
+
+    MapObjectDisk<char,float> compact_map;
+    compact_map.open("t_map_obj_disk_compact.mod", std::ios_base::in);
+    testMapObjLookups(compact_map);
+
+    // The compacted copy has a key index
+    MapObjectDisk<char,float> lazy_map;
+    lazy_map.setLazy(true);
+    lazy_map.open("t_map_obj_disk_compact.mod", std::ios_base::in);
+    if (lazy_map.size() != 10 || lazy_map.exist('z'))
+      fail(__LINE__);
+    testMapObjLookups(lazy_map);
+
+    // Lookups from many threads, through the index and through the map
+    MapObjectDisk<char,float> conc_map;
+    conc_map.setLazy(true);
+    conc_map.setConcurrent(true);
+    conc_map.open("t_map_obj_disk_compact.mod", std::ios_base::in);
+    for(int pass=0; pass < 2; ++pass)
+    {
+      int bad = 0;
+#pragma omp parallel for reduction(+:bad)
+      for(int i=0; i < 1000; i++) {
+	char key = 'a' + i % 11;
+	float val;
+	int ret = conc_map.getConcurrent(key, val);
+	if (i % 11 == 10 ? ret == 0 : (ret != 0 || val != float((i % 11)*(i % 11))))
+	  ++bad;
+      }
+      if (bad != 0)
+	fail(__LINE__);
+      testMapObjLookups(conc_map);
+    }
+  }
+  catch(const std::string& e) { 
+    QDPIO::cout << "Caught: " << e << std::endl;
+    fail(__LINE__);
+  }
+#endif
+
 
   // Make an array of LF-s filled with noise
   multi1d<LatticeFermion> lf_array(10);
@@ -706,6 +763,113 @@ int main(int argc, char *argv[])
   }
 #endif
 
+#if 1
+  //
+  // Test mapped read mode on previous DB
+  //
+  try {
+    QDPIO::cout << "\n\n\nTest reading previous DB with time-slices through mmap" << std::endl;
+
+    MapObjectDisk<KeyPropColorVecTimeSlice_t, TimeSliceIO<LatticeFermion> > pc_map;
+
+    pc_map.setDebug(1);
+    pc_map.setMmap(true);
+    pc_map.open(map_obj_file, std::ios_base::in);
+
+    testMapKeyPropColorVecLookupsTimeSlice(pc_map, lf_array);
+    QDPIO::cout << std::endl << "OK" << std::endl;
+  }
+  catch(const std::string& e) {
+    QDPIO::cout << "Caught: " << e << std::endl;
+    fail(__LINE__);
+  }
+#endif
+
+#if 1
+  //
+  // Test batched time-slice reads on previous DB
+  //
+  try {
+    QDPIO::cout << "\n\n\nTest batched reading of previous DB with time-slices" << std::endl;
+
+    MapObjectDisk<KeyPropColorVecTimeSlice_t, TimeSliceIO<LatticeFermion> > pc_map;
+    pc_map.open(map_obj_file, std::ios_base::in);
+
+    multi1d<LatticeFermion> lf_tmp(lf_array.size());
+    TimeSliceBatchReader<KeyPropColorVecTimeSlice_t, LatticeFermion> batch(pc_map);
+    KeyPropColorVecTimeSlice_t the_key = {0,0,0,0};
+
+    for(int i=0; i < lf_array.size(); i++) {
+      the_key.colorvec_src = i;
+      for(int time_slice=0; time_slice < Layout::lattSize()[Nd-1]; ++time_slice)
+      {
+	the_key.t_slice = time_slice;
+	TimeSliceIO<LatticeFermion> time_slice_lf(lf_tmp[i], time_slice);
+	batch.push(the_key, time_slice_lf);
+      }
+    }
+
+    while (batch.pending() > 0)
+      batch.next();
+
+    // The update test changed colorvec_src 5
+    for(int i=0; i < lf_array.size(); i++) {
+      LatticeFermion lf_get;
+      the_key.colorvec_src = i;
+      for(int time_slice=0; time_slice < Layout::lattSize()[Nd-1]; ++time_slice)
+      {
+	the_key.t_slice = time_slice;
+	TimeSliceIO<LatticeFermion> time_slice_lf(lf_get, time_slice);
+	pc_map.get(the_key, time_slice_lf);
+      }
+      if (toDouble(norm2(lf_get - lf_tmp[i])) != 0)
+	fail(__LINE__);
+    }
+    QDPIO::cout << std::endl << "OK" << std::endl;
+  }
+  catch(const std::string& e) {
+    QDPIO::cout << "Caught: " << e << std::endl;
+    fail(__LINE__);
+  }
+#endif
+
+#if 1
+  //
+  // Test sharded writes, every node its own keys
+  //
+  try {
+    QDPIO::cout << "\n\n\nTest a sharded DB" << std::endl;
+
+    std::string manifest("t_map_obj_disk_sharded.mod");
+    {
+      MapObjectDiskSharded<char,float> shard_map;
+      shard_map.insertUserdata(meta_data);
+      shard_map.open(manifest);
+
+      for(char i=Layout::nodeNumber(); i < 10; i += Layout::numNodes())
+	shard_map.insert('a'+i, float(i*i));
+
+      shard_map.close();
+    }
+
+    MapObjectDiskMultiple<char,float> all_map;
+    all_map.openManifest(manifest);
+
+    for(char i=0; i < 10; i++) 
+    {
+      float val;
+      if (all_map.get('a'+i, val) != 0 || val != float(i*i))
+	fail(__LINE__);
+    }
+    all_map.close();
+    QDPIO::cout << std::endl << "OK" << std::endl;
+  }
+  catch(const std::string& e) {
+    QDPIO::cout << "Caught: " << e << std::endl;
+    fail(__LINE__);
+  }
+#endif
+
 #if 1
   //
   // Test stuff
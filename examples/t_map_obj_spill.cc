@@ -0,0 +1,82 @@
+/*! \file
+ *  \brief Test the map object spilling lattice fields to disk
+ */
+
+#include "qdp.h"
+#include <cstdlib>
+#include <iostream>
+
+#include "qdp_map_obj_spill.h"
+
+using namespace QDP;
+
+void fail(int line)
+{
+  QDPIO::cout << "FAIL: line= " << line << std::endl;
+  QDP_finalize();
+  exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,4};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  const int nvec = 10;
+  multi1d<LatticeColorVector> vec(nvec);
+  for(int i=0; i < nvec; ++i)
+    gaussian(vec[i]);
+
+  // Only three of the ten stay in memory
+  MapObjectSpill<int,LatticeColorVector> the_map(3);
+  for(int i=0; i < nvec; ++i)
+    the_map.insert(i, vec[i]);
+
+  if (the_map.size() != nvec || the_map.resident() != 3)
+    fail(__LINE__);
+
+  // A sweep reading each back, ahead of use
+  Double diff = zero;
+  for(int i=0; i < nvec; ++i)
+  {
+    the_map.prefetch(i+1);
+    diff += norm2(the_map[i] - vec[i]);
+  }
+
+  // Replace a spilled value and look it up with get
+  gaussian(vec[0]);
+  the_map.insert(0, vec[0]);
+  for(int i=nvec-1; i >= 0; --i)
+  {
+    LatticeColorVector v;
+    if (the_map.get(i, v) != 0)
+      fail(__LINE__);
+    diff += norm2(v - vec[i]);
+  }
+
+  the_map.erase(5);
+  if (the_map.exist(5) || the_map.size() != nvec-1)
+    fail(__LINE__);
+
+  QDPIO::cout << "spilled bytes= " << the_map.bytesSpilled()
+	      << "  faulted bytes= " << the_map.bytesFaulted()
+	      << "  diff= " << diff << std::endl;
+
+  if (toDouble(diff) != 0.0)
+    fail(__LINE__);
+
+  QDPIO::cout << "OK" << std::endl;
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
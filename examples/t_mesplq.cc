@@ -53,6 +53,93 @@ int main(int argc, char *argv[])
   QDPIO::cout << "w_plaq = " << w_plaq << std::endl;
   QDPIO::cout << "link = " << link << std::endl;
 
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+  // The fused plaquettes and staples must agree with the shifts
+  {
+    multi2d<Double> plaq = sumPlaquettes(u);
+    multi1d<LatticeColorMatrix> st;
+    staples(st, u);
+
+    Double dp = zero, ds = zero, tot = zero, sum_st = zero;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      LatticeColorMatrix ref = zero;
+      for(int nu=0; nu < Nd; ++nu)
+      {
+	if (nu == mu)
+	  continue;
+
+	if (nu < mu)
+	{
+	  Double p = sum(real(trace(u[mu]*shift(u[nu],FORWARD,mu)*adj(shift(u[mu],FORWARD,nu))*adj(u[nu]))));
+	  dp += fabs(p - plaq(mu,nu));
+	  tot += plaq(mu,nu);
+	}
+
+	ref += shift(u[nu],FORWARD,mu) * adj(shift(u[mu],FORWARD,nu)) * adj(u[nu]);
+	LatticeColorMatrix tmp = adj(shift(u[nu],FORWARD,mu)) * adj(u[mu]) * u[nu];
+	ref += shift(tmp,BACKWARD,nu);
+      }
+      ds += norm2(st[mu] - ref);
+      sum_st += sum(real(trace(u[mu]*st[mu])));
+    }
+
+    QDPIO::cout << "sumPlaquettes diff = " << dp << "  staples diff = " << sqrt(ds)
+		<< "  staples/plaquettes = " << sum_st / tot << std::endl;
+  }
+
+  // A 5D fermion: the block shift and the s hopping against slice by slice
+  {
+    const int Ls = 6;
+    const Real m = 0.1;
+    LatticeFermion5D psi(Ls), chi(Ls), eta(Ls);
+    multi1d<LatticeFermion> x(Ls);
+    for(int s=0; s < Ls; ++s)
+    {
+      gaussian(x[s]);
+      psi.insert(s, x[s]);
+    }
+
+    Double dsh = zero;
+    for(int mu=0; mu < Nd; ++mu)
+      for(int isign=-1; isign <= +1; isign += 2)
+      {
+	shift(chi, psi, isign, mu);
+	for(int s=0; s < Ls; ++s)
+	{
+	  LatticeFermion y;
+	  chi.extract(s, y);
+	  dsh += norm2(y - shift(x[s], isign, mu));
+	}
+      }
+
+    Double dhop = zero;
+    hopS(chi, psi, m, +1, all);
+    for(int s=0; s < Ls; ++s)
+    {
+      LatticeFermion up = (s+1 < Ls) ? x[s+1] : LatticeFermion(-m*x[0]);
+      LatticeFermion dn = (s > 0) ? x[s-1] : LatticeFermion(-m*x[Ls-1]);
+      LatticeFermion y;
+      chi.extract(s, y);
+      dhop += norm2(y - Real(0.5)*(up - Gamma(15)*up) - Real(0.5)*(dn + Gamma(15)*dn));
+    }
+
+    // The isign < 0 hopping is the adjoint
+    hopS(eta, chi, m, -1, all);
+    multi1d<DComplex> zx = innerProduct(chi, chi, all);
+    multi1d<DComplex> ex = innerProduct(eta, psi, all);
+    DComplex lhs = zero, rhs = zero;
+    for(int s=0; s < Ls; ++s)
+    {
+      lhs += zx[s];
+      rhs += ex[s];
+    }
+
+    QDPIO::cout << "5D shift diff = " << sqrt(dsh) << "  hopS diff = " << sqrt(dhop)
+		<< "  adjoint diff = " << sqrt(norm2(lhs - rhs)) << std::endl;
+  }
+#endif
+
 #ifdef QDP_USE_LIBXML2
   // Write out the results
   push(xml,"observables");
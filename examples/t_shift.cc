@@ -46,6 +46,79 @@ int main(int argc, char *argv[])
       pop(xml);
     }
     pop(xml);
+
+    // Shifts inside an expression must agree with shifted copies
+    push(xml,"test2");
+    LatticeColorMatrix u;
+    LatticeFermion psi, chi;
+    gaussian(u);
+    gaussian(psi);
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      LatticeFermion fwd = shift(psi,FORWARD,mu);
+      LatticeFermion bwd = shift(psi,BACKWARD,mu);
+
+      chi = u*shift(psi,FORWARD,mu) + shift(psi,BACKWARD,mu) - shift(u*psi,FORWARD,mu);
+      Double diff = norm2(chi - (u*fwd + bwd - shift(LatticeFermion(u*psi),FORWARD,mu)));
+
+      QDPIO::cout << "mu= " << mu << "  fused shift diff = " << diff << std::endl;
+      write(xml,"diff", diff);
+    }
+    pop(xml);
+
+    // A destination shifted into itself must match an explicit temporary
+    push(xml,"test3");
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      LatticeFermion ref = psi + u*shift(psi,FORWARD,mu);
+      psi = psi + u*shift(psi,FORWARD,mu);
+
+      Double diff = norm2(psi - ref);
+
+      QDPIO::cout << "mu= " << mu << "  aliased shift diff = " << diff << std::endl;
+      write(xml,"diff", diff);
+    }
+    pop(xml);
+
+    // Spin projections moved across a shift must match projecting a shifted copy
+    push(xml,"test4");
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      LatticeFermion fwd = shift(psi,FORWARD,mu);
+      LatticeHalfFermion ref = spinProjectDir0Minus(fwd);
+      LatticeHalfFermion h1 = spinProjectDir0Minus(shift(psi,FORWARD,mu));
+      LatticeHalfFermion h2 = shift(spinProjectDir0Minus(psi),FORWARD,mu);
+
+      Double diff = norm2(h1 - ref) + norm2(h2 - ref);
+
+      QDPIO::cout << "mu= " << mu << "  projected shift diff = " << diff << std::endl;
+      write(xml,"diff", diff);
+    }
+    pop(xml);
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+    // A shift read only on a checkerboard must match the full shift there
+    push(xml,"test5");
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      for(int cb=0; cb < 2; ++cb)
+      {
+	LatticeFermion ref = zero, fwd = zero;
+	ref[rb[cb]] = u*shift(psi,FORWARD,mu);
+	fwd[rb[cb]] = shift(psi,FORWARD,mu,rb[cb]);
+	chi = zero;
+	chi[rb[cb]] = u*shift(psi,FORWARD,mu,rb[cb]);
+
+	Double diff = norm2(chi - ref) + norm2(u*fwd - ref, rb[cb]);
+
+	QDPIO::cout << "mu= " << mu << "  cb= " << cb << "  restricted shift diff = " << diff << std::endl;
+	write(xml,"diff", diff);
+      }
+    }
+    pop(xml);
+#endif
+
     xml.close();
   }
 #endif
@@ -0,0 +1,99 @@
+/*! \file
+ *  \brief Test handing fields to other libraries: bulk copies and borrowed sites
+ */
+
+#include "qdp.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace QDP;
+
+void fail(int line)
+{
+  QDPIO::cout << "FAIL: line= " << line << std::endl;
+  QDP_finalize();
+  exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  QDP_initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,6};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  typedef LatticeColorMatrix::Subtype_t T;
+  typedef WordType<T>::Type_t W;
+  const int words = sizeof(T)/sizeof(W);
+
+  LatticeColorMatrix u;
+  gaussian(u);
+
+  // Whole sites, even then odd: the first half holds the sites of rb[0]
+  SiteOrder eo = SiteOrder::evenOdd();
+  std::vector<W> buf(eo.numWords(words));
+  QDP_extract(&buf[0], u, eo);
+
+  LatticeColorMatrix v = zero;
+  QDP_insert(v, &buf[0], eo);
+  if (toDouble(norm2(u - v)) != 0.0)
+    fail(__LINE__);
+
+  for(int j=0; j < eo.numSlots(); ++j)
+  {
+    multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), eo.site(j));
+    int sum = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      sum += coord[mu];
+    if ((sum % 2) != (2*j >= eo.numSlots()))
+      fail(__LINE__);
+  }
+
+  // Vectors of 8 sites of the odd subset only
+  SiteOrder odd = SiteOrder::subset(rb[1], 8);
+  std::vector<W> vbuf(odd.numWords(words));
+  QDP_extract(&vbuf[0], u, odd);
+
+  for(int j=0; j < odd.numSlots(); ++j)
+  {
+    const W* w = (const W*)&u.elem(odd.site(j));
+    for(int k=0; k < words; ++k)
+      if (vbuf[(j/8)*words*8 + k*8 + j%8] != w[k])
+	fail(__LINE__);
+  }
+
+  LatticeColorMatrix x = zero;
+  QDP_insert(x, &vbuf[0], odd);
+  if (toDouble(norm2(u - x, rb[1])) != 0.0 || toDouble(norm2(x, rb[0])) != 0.0)
+    fail(__LINE__);
+
+  // A field over sites owned by the caller, in the layout order
+  std::vector<T> ext(Layout::sitesOnNode());
+  {
+    LatticeColorMatrix view(&ext[0], BorrowedSites());
+    if (view.ownsSites() || view.data() != &ext[0])
+      fail(__LINE__);
+
+    view = u;
+    LatticeColorMatrix copy = view;
+    if (copy.getF() == &ext[0] || toDouble(norm2(copy - u)) != 0.0)
+      fail(__LINE__);
+  }
+  if (std::memcmp(&ext[0], u.getF(), ext.size()*sizeof(T)) != 0)
+    fail(__LINE__);
+
+  QDPIO::cout << "OK" << std::endl;
+
+  // Time to bolt
+  QDP_finalize();
+
+  exit(0);
+}
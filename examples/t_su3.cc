@@ -6,6 +6,7 @@
 #include <time.h>
 
 #include "qdp.h"
+#include "examples.h"
 
 //#define DEBUG_BAGELQDP_LINALG 1
 // #include "scalarsite_bagel_qdp/qdp_scalarsite_bagel_qdp_linalg.h"
@@ -945,6 +946,91 @@ int main(int argc, char *argv[])
 
 #endif
 
+  // -----------------------------------------------------------------
+  // Compressed links
+  // -----------------------------------------------------------------
+  {
+    LatticeColorMatrix u;
+    LatticeFermion psi, chi, ref;
+    gaussian(u);
+    reunit(u);
+    gaussian(psi);
+
+    LatticeColorMatrix12 u12(u);
+    LatticeColorMatrix8 u8(u);
+
+    ref = u*psi;
+    chi = u12*psi;
+    QDPIO::cout << "U12*V: || diff || = " << sqrt(norm2(chi - ref)) << std::endl;
+
+    chi = u8*psi;
+    QDPIO::cout << "U8*V: || diff || = " << sqrt(norm2(chi - ref)) << std::endl;
+
+    ref = adj(u)*psi;
+    chi = adj(u12)*psi;
+    QDPIO::cout << "adj(U12)*V: || diff || = " << sqrt(norm2(chi - ref)) << std::endl;
+
+    QDP::StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < 500; i++)
+      ref = u*psi;
+    swatch.stop();
+    double original_secs = swatch.getTimeInSeconds();
+
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < 500; i++)
+      chi = u12*psi;
+    swatch.stop();
+    double u12_secs = swatch.getTimeInSeconds();
+
+    QDPIO::cout << "U*V: original seconds= " << original_secs << std::endl;
+    QDPIO::cout << "U*V: 12 real seconds= " << u12_secs << std::endl;
+  }
+
+  // -----------------------------------------------------------------
+  // Fused SU(3) kernels against the chains of lattice expressions
+  // -----------------------------------------------------------------
+  {
+    LatticeColorMatrix w, a, b, ref;
+    gaussian(w);
+
+    a = w;
+    reunit(a);
+    b = w;
+    reunitarize(b);
+    QDPIO::cout << "reunitarize: || diff || = " << sqrt(norm2(b - a)) << std::endl;
+
+    a = w;
+    taproj(a);
+    projectTA(b, w);
+    QDPIO::cout << "projectTA: || diff || = " << sqrt(norm2(b - a)) << std::endl;
+
+    // exp(a) for a small traceless antihermitian a is the Taylor series
+    a *= Real(0.1);
+    ref = a;
+    expm12(ref);
+    expiQ(b, timesMinusI(a));
+    QDPIO::cout << "expiQ: || diff || = " << sqrt(norm2(b - ref)) << std::endl;
+
+    LatticeColorMatrix u = w;
+    reunitarize(u);
+    ref = b * u;
+    multiplyExpiQ(u, timesMinusI(a));
+    QDPIO::cout << "multiplyExpiQ: || diff || = " << sqrt(norm2(u - ref)) << std::endl;
+
+    // The nearest SU(3) matrix to an SU(3) matrix is itself
+    b = u;
+    projectSU3(b);
+    QDPIO::cout << "projectSU3 of SU(3): || diff || = " << sqrt(norm2(b - u)) << std::endl;
+
+    LatticeColorMatrix one = 1;
+    projectSU3(b, w);
+    QDPIO::cout << "projectSU3: || adj(v)*v - 1 || = " << sqrt(norm2(adj(b)*b - one))
+		<< "  || det(v) - 1 || = " << sqrt(norm2(colorContract(b,b,b)/Real(6) - cmplx(Real(1),Real(0)))) << std::endl;
+  }
+
 
   // Time to bolt
   QDP_finalize();
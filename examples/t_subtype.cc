@@ -67,10 +67,10 @@ void test_tslice()
   zero_rep(a);
   a = tmp; // This writes into the subset that was attached to tmp
 
-  // The OSubLattice is *not* fleshed into PETE. Thus only those operations that are explicitly implemented work, i.e. like innerProduct
-  // This does not work:
-  // vec[0] = vec[1] + vec[2];
+  // OSubLattices go into expressions evaluated on their own subset
+  vec[0] = vec[0] + Real(2)*vec[0];
 
+#ifdef QDP_USE_LIBXML2
   if (0)
   {
     XMLFileWriter foo("out.xml");
@@ -79,6 +79,7 @@ void test_tslice()
     write(foo,"tmp",a);
     foo.close();
   }
+#endif
 
 
 
@@ -122,7 +123,7 @@ void stuff()
 
   SubLatticeColorVector s2(s);
   s2 = s;
-  a[rb[0]] = s;
+  a[rb[1]] = s;
   s = a[rb[1]];
 
 
@@ -145,6 +146,93 @@ void stuff()
 
 
 
+//! Half-volume fields against the same operations on full fields
+void test_checkerboard()
+{
+  typedef OSubLattice< PSpinVector< PColorVector< RComplex<REAL>, Nc>, Ns > > SubLatticeFermion;
+
+  LatticeFermion psi, chi;
+  gaussian(psi);
+  gaussian(chi);
+  const Real a = 0.3;
+
+  SubLatticeFermion psi_e(rb[0]), chi_e(rb[0]), psi_o(rb[1]), eta_o(rb[1]);
+  psi_e = psi;
+  chi_e = chi;
+  psi_o = psi;
+
+  // Expressions, reductions and shifts
+  LatticeFermion ref;
+  ref[rb[0]] = a*psi + chi;
+  chi_e = a*psi_e + chi_e;
+  Double dexpr = norm2(chi_e - ref, rb[0]);
+
+  Double dnorm = fabs(norm2(psi_e) - norm2(psi, rb[0]));
+  Double dinner = sqrt(norm2(innerProduct(psi_e, chi_e) - innerProduct(psi, ref, rb[0])));
+
+  Double dshift = zero;
+  for(int mu=0; mu < Nd; ++mu)
+    for(int isign=-1; isign <= +1; isign += 2)
+    {
+      ref[rb[0]] = shift(psi, isign, mu);
+      chi_e = shift(psi_o, isign, mu);
+      dshift += norm2(chi_e - ref, rb[0]);
+
+      // The compact shift moves only the half volume
+      shift(chi_e, psi_o, isign, mu);
+      dshift += norm2(chi_e - ref, rb[0]);
+
+      ref[rb[1]] = shift(psi, isign, mu);
+      shift(eta_o, psi_e, isign, mu);
+      dshift += norm2(eta_o - ref, rb[1]);
+    }
+
+  // A shift within a time slice reads the destination itself
+  Set tslice;
+  tslice.make(TimeSliceFunc());
+  SubLatticeFermion x_t(tslice[1]);
+  x_t = psi;
+  x_t = shift(x_t, FORWARD, 0);
+  ref[tslice[1]] = shift(psi, FORWARD, 0);
+  dshift += norm2(x_t - ref, tslice[1]);
+
+  zero_rep(chi_e);
+  random(psi_e);
+
+  QDPIO::cout << "checkerboard: expr diff = " << sqrt(dexpr) << "  norm2 diff = " << dnorm
+	      << "  innerProduct diff = " << dinner << "  shift diff = " << sqrt(dshift)
+	      << "  zero_rep = " << norm2(chi_e) << std::endl;
+}
+
+
+//! Copies sharing their sites must part on the first write to either
+void test_copy_on_write()
+{
+  LatticeFermion psi;
+  gaussian(psi);
+  LatticeFermion ref = psi;  // a deep copy
+
+  Allocator::setLatticeCopyOnWrite(true);
+
+  LatticeFermion a = psi, b = psi, c = psi;
+  bool shared = psi.shared();
+
+  a += psi;
+  b[rb[0]] = zero;
+  random(c);
+
+  Double diff = norm2(psi - ref) + norm2(a - Real(2)*ref) + norm2(b - ref, rb[1]) + norm2(b, rb[0]);
+
+  // The last holder of the sites writes them in place
+  LatticeFermion d = psi;
+  psi = zero;
+  diff += norm2(d - ref) + norm2(psi);
+
+  Allocator::setLatticeCopyOnWrite(false);
+
+  QDPIO::cout << "copy on write: shared = " << shared << "  diff = " << diff << std::endl;
+}
+
 
 int main(int argc, char *argv[])
 {
@@ -160,6 +248,8 @@ int main(int argc, char *argv[])
 
 
   test_tslice();
+  test_checkerboard();
+  test_copy_on_write();
 
 
 
@@ -567,6 +567,22 @@ adj(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Hermitian adjoint
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnAdjoint,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnAdjoint >::Type_t >::Expression_t
+adj(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnAdjoint,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnAdjoint >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Complex conjugate
 /*! @ingroup group1
   @relates QDPType */
@@ -583,6 +599,22 @@ conj(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Complex conjugate
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnConjugate,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnConjugate >::Type_t >::Expression_t
+conj(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnConjugate,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnConjugate >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Transpose
 /*! @ingroup group1
   @relates QDPType */
@@ -599,6 +631,22 @@ transpose(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Transpose
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTranspose,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTranspose >::Type_t >::Expression_t
+transpose(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTranspose,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTranspose >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Transpose in Color Space Only
 /*! @ingroup group1
   @relates QDPType */
@@ -615,6 +663,22 @@ transposeColor(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Transpose in Color Space Only
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTransposeColor,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTransposeColor >::Type_t >::Expression_t
+transposeColor(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTransposeColor,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTransposeColor >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Transpose in Spin Space Only
 /*! @ingroup group1
   @relates QDPType */
@@ -631,6 +695,22 @@ transposeSpin(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Transpose in Spin Space Only
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTransposeSpin,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTransposeSpin >::Type_t >::Expression_t
+transposeSpin(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTransposeSpin,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTransposeSpin >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Trace on all fiber indices
 /*! @ingroup group1
   @relates QDPType */
@@ -647,6 +727,22 @@ trace(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Trace on all fiber indices
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTrace,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTrace >::Type_t >::Expression_t
+trace(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTrace,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTrace >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Real part of the trace on all fiber indices
 /*! @ingroup group1
   @sa real()
@@ -664,6 +760,23 @@ realTrace(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Real part of the trace on all fiber indices
+/*! @ingroup group1
+  @sa real()
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnRealTrace,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnRealTrace >::Type_t >::Expression_t
+realTrace(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnRealTrace,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnRealTrace >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Imag part of the trace on all fiber indices
 /*! @ingroup group1
   @sa imag()
@@ -681,6 +794,23 @@ imagTrace(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Imag part of the trace on all fiber indices
+/*! @ingroup group1
+  @sa imag()
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnImagTrace,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnImagTrace >::Type_t >::Expression_t
+imagTrace(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnImagTrace,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnImagTrace >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Trace on only color indices
 /*! @ingroup group1
   @sa trace(), TraceColor()
@@ -698,6 +828,23 @@ traceColor(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Trace on only color indices
+/*! @ingroup group1
+  @sa trace(), TraceColor()
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTraceColor,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTraceColor >::Type_t >::Expression_t
+traceColor(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTraceColor,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTraceColor >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Trace on only spin indices
 /*! @ingroup group1
   @sa trace()
@@ -715,6 +862,23 @@ traceSpin(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Trace on only spin indices
+/*! @ingroup group1
+  @sa trace()
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTraceSpin,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTraceSpin >::Type_t >::Expression_t
+traceSpin(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTraceSpin,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTraceSpin >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Real part
 /*! @ingroup group1
   @relates QDPType */
@@ -731,6 +895,22 @@ real(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Real part
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnReal,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnReal >::Type_t >::Expression_t
+real(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnReal,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnReal >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Imag part
 /*! @ingroup group1
   @relates QDPType */
@@ -747,6 +927,22 @@ imag(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Imag part
+/*! @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnImag,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnImag >::Type_t >::Expression_t
+imag(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnImag,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnImag >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! InnerProduct on only fiber indices
 /*! L2 norm only fiber indices
   @sa adj(), trace()
@@ -766,6 +962,25 @@ localNorm2(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! InnerProduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace()
+  @return (trace(adj(l)*l)
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnLocalNorm2,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnLocalNorm2 >::Type_t >::Expression_t
+localNorm2(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnLocalNorm2,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnLocalNorm2 >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Multiply by imaginary i
 /*! @sa operator*()
   @return (i * a)
@@ -784,6 +999,24 @@ timesI(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Multiply by imaginary i
+/*! @sa operator*()
+  @return (i * a)
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTimesI,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTimesI >::Type_t >::Expression_t
+timesI(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTimesI,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTimesI >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Multiply by minus imaginary i
 /*! @sa operator*()
   @return (-i * a)
@@ -802,6 +1035,24 @@ timesMinusI(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Multiply by minus imaginary i
+/*! @sa operator*()
+  @return (-i * a)
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTimesMinusI,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTimesMinusI >::Type_t >::Expression_t
+timesMinusI(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTimesMinusI,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTimesMinusI >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Convert a seed (big int) to a float
 /*! Used only by random number generator
   @return a float in [0,1] from a seed (big int)
@@ -820,6 +1071,24 @@ seedToFloat(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Convert a seed (big int) to a float
+/*! Used only by random number generator
+  @return a float in [0,1] from a seed (big int)
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSeedToFloat,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSeedToFloat >::Type_t >::Expression_t
+seedToFloat(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSeedToFloat,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSeedToFloat >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin projection in direction 0
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
@@ -839,6 +1108,25 @@ spinProjectDir0Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin projection in direction 0
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 + gamma[0])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir0Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir0Plus >::Type_t >::Expression_t
+spinProjectDir0Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir0Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir0Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin projection in direction 1
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
@@ -858,6 +1146,25 @@ spinProjectDir1Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin projection in direction 1
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 + gamma[1])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir1Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir1Plus >::Type_t >::Expression_t
+spinProjectDir1Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir1Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir1Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin projection in direction 2
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
@@ -877,6 +1184,25 @@ spinProjectDir2Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin projection in direction 2
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 + gamma[2])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir2Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir2Plus >::Type_t >::Expression_t
+spinProjectDir2Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir2Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir2Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin projection in direction 3
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
@@ -896,15 +1222,34 @@ spinProjectDir3Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
-//! Spin projection in direction 0
+//! Spin projection in direction 3
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
-  @return (1 - gamma[0])*l
+  @return (1 + gamma[3])*l
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1>
-inline typename MakeReturn<UnaryNode<FnSpinProjectDir0Minus,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>,
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir3Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir3Plus >::Type_t >::Expression_t
+spinProjectDir3Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir3Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir3Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
+//! Spin projection in direction 0
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 - gamma[0])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir0Minus,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>,
   typename UnaryReturn<C1,FnSpinProjectDir0Minus >::Type_t >::Expression_t
 spinProjectDir0Minus(const QDPType<T1,C1> & l)
 {
@@ -915,6 +1260,25 @@ spinProjectDir0Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin projection in direction 0
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 - gamma[0])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir0Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir0Minus >::Type_t >::Expression_t
+spinProjectDir0Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir0Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir0Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin projection in direction 1
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
@@ -934,6 +1298,25 @@ spinProjectDir1Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin projection in direction 1
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 - gamma[1])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir1Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir1Minus >::Type_t >::Expression_t
+spinProjectDir1Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir1Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir1Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin projection in direction 2
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
@@ -953,6 +1336,25 @@ spinProjectDir2Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin projection in direction 2
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 - gamma[2])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir2Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir2Minus >::Type_t >::Expression_t
+spinProjectDir2Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir2Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir2Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin projection in direction 3
 /*! Returns half-spin vector from a full spin vector source
   @param l  full spin vector
@@ -972,6 +1374,25 @@ spinProjectDir3Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin projection in direction 3
+/*! Returns half-spin vector from a full spin vector source
+  @param l  full spin vector
+  @return (1 - gamma[3])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinProjectDir3Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinProjectDir3Minus >::Type_t >::Expression_t
+spinProjectDir3Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinProjectDir3Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinProjectDir3Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 3
 /*! Returns full spin vector from a half spin vector source
   @param l  half-spin vector
@@ -991,6 +1412,25 @@ spinReconstructDir0Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 3
+/*! Returns full spin vector from a half spin vector source
+  @param l  half-spin vector
+  @return (1 + gamma[0])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir0Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir0Plus >::Type_t >::Expression_t
+spinReconstructDir0Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir0Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir0Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 1
 /*! Returns full-spin vector from a half-spin vector source
   @param l  half-spin vector
@@ -1010,6 +1450,25 @@ spinReconstructDir1Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 1
+/*! Returns full-spin vector from a half-spin vector source
+  @param l  half-spin vector
+  @return (1 + gamma[1])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir1Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir1Plus >::Type_t >::Expression_t
+spinReconstructDir1Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir1Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir1Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 2
 /*! Returns full-spin vector from a half-spin vector source
   @param l  half-spin vector
@@ -1029,6 +1488,25 @@ spinReconstructDir2Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 2
+/*! Returns full-spin vector from a half-spin vector source
+  @param l  half-spin vector
+  @return (1 + gamma[2])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir2Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir2Plus >::Type_t >::Expression_t
+spinReconstructDir2Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir2Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir2Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 3
 /*! Returns full-spin vector from a half-spin vector source
   @param l  half-spin vector
@@ -1048,6 +1526,25 @@ spinReconstructDir3Plus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 3
+/*! Returns full-spin vector from a half-spin vector source
+  @param l  half-spin vector
+  @return (1 + gamma[3])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir3Plus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir3Plus >::Type_t >::Expression_t
+spinReconstructDir3Plus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir3Plus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir3Plus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 0
 /*! Returns full-spin vector from a half-spin vector source
   @param l  half-spin vector
@@ -1067,6 +1564,25 @@ spinReconstructDir0Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 0
+/*! Returns full-spin vector from a half-spin vector source
+  @param l  half-spin vector
+  @return (1 - gamma[0])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir0Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir0Minus >::Type_t >::Expression_t
+spinReconstructDir0Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir0Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir0Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 1
 /*! Returns full-spin vector from a half-spin vector source
   @param l  half-spin vector
@@ -1086,6 +1602,25 @@ spinReconstructDir1Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 1
+/*! Returns full-spin vector from a half-spin vector source
+  @param l  half-spin vector
+  @return (1 - gamma[1])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir1Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir1Minus >::Type_t >::Expression_t
+spinReconstructDir1Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir1Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir1Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 2
 /*! Returns full-spin vector from a half-spin vector source
   @param l  half-spin vector
@@ -1105,6 +1640,25 @@ spinReconstructDir2Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 2
+/*! Returns full-spin vector from a half-spin vector source
+  @param l  half-spin vector
+  @return (1 - gamma[2])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir2Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir2Minus >::Type_t >::Expression_t
+spinReconstructDir2Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir2Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir2Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Spin reconstruct in direction 3
 /*! Returns full-spin vector from a half-spin vector source
   @param l  half-spin vector
@@ -1124,6 +1678,25 @@ spinReconstructDir3Minus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Spin reconstruct in direction 3
+/*! Returns full-spin vector from a half-spin vector source
+  @param l  half-spin vector
+  @return (1 - gamma[3])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSpinReconstructDir3Minus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSpinReconstructDir3Minus >::Type_t >::Expression_t
+spinReconstructDir3Minus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSpinReconstructDir3Minus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSpinReconstructDir3Minus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Apply P_+ = 0.5*(1+gamma_5)
 /*! Returns full-spin vector 
   @param l  full-spin vector
@@ -1143,6 +1716,25 @@ chiralProjectPlus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Apply P_+ = 0.5*(1+gamma_5)
+/*! Returns full-spin vector 
+  @param l  full-spin vector
+  @return 0.5*(1 + gamma[5])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnChiralProjectPlus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnChiralProjectPlus >::Type_t >::Expression_t
+chiralProjectPlus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnChiralProjectPlus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnChiralProjectPlus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Apply P_ = -0.5*(1-gamma_5)
 /*! Returns full-spin vector 
   @param l  full-spin vector
@@ -1162,6 +1754,25 @@ chiralProjectMinus(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Apply P_ = -0.5*(1-gamma_5)
+/*! Returns full-spin vector 
+  @param l  full-spin vector
+  @return 0.5*(1 - gamma[5])*l
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnChiralProjectMinus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnChiralProjectMinus >::Type_t >::Expression_t
+chiralProjectMinus(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnChiralProjectMinus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnChiralProjectMinus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Arc cos
 /*! @ingroup group1
 @relates QDPType */
@@ -1178,6 +1789,22 @@ acos(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Arc cos
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnArcCos,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnArcCos >::Type_t >::Expression_t
+acos(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnArcCos,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnArcCos >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Arc sin
 /*! @ingroup group1
 @relates QDPType */
@@ -1194,6 +1821,22 @@ asin(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Arc sin
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnArcSin,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnArcSin >::Type_t >::Expression_t
+asin(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnArcSin,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnArcSin >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Arc tangent
 /*! @ingroup group1
 @relates QDPType */
@@ -1210,13 +1853,29 @@ atan(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
-//! Floating point ceiling of source
+//! Arc tangent
 /*! @ingroup group1
 @relates QDPType */
 template<class T1,class C1>
-inline typename MakeReturn<UnaryNode<FnCeil,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>,
-  typename UnaryReturn<C1,FnCeil >::Type_t >::Expression_t
+inline typename MakeReturn<UnaryNode<FnArcTan,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnArcTan >::Type_t >::Expression_t
+atan(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnArcTan,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnArcTan >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
+//! Floating point ceiling of source
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnCeil,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnCeil >::Type_t >::Expression_t
 ceil(const QDPType<T1,C1> & l)
 {
   typedef UnaryNode<FnCeil,
@@ -1226,6 +1885,22 @@ ceil(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Floating point ceiling of source
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnCeil,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnCeil >::Type_t >::Expression_t
+ceil(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnCeil,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnCeil >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Cosine
 /*! @ingroup group1
 @relates QDPType */
@@ -1242,6 +1917,22 @@ cos(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Cosine
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnCos,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnCos >::Type_t >::Expression_t
+cos(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnCos,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnCos >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Hyperbolic cosine
 /*! @ingroup group1
 @relates QDPType */
@@ -1258,6 +1949,22 @@ cosh(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Hyperbolic cosine
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnHypCos,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnHypCos >::Type_t >::Expression_t
+cosh(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnHypCos,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnHypCos >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Exponential
 /*! @ingroup group1
 @relates QDPType */
@@ -1274,6 +1981,22 @@ exp(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Exponential
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnExp,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnExp >::Type_t >::Expression_t
+exp(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnExp,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnExp >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Floating point absolute value
 /*! @ingroup group1
 @relates QDPType */
@@ -1290,6 +2013,22 @@ fabs(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Floating point absolute value
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnFabs,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnFabs >::Type_t >::Expression_t
+fabs(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnFabs,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnFabs >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! floating point floor of source
 /*! @ingroup group1
 @relates QDPType */
@@ -1306,6 +2045,22 @@ floor(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! floating point floor of source
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnFloor,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnFloor >::Type_t >::Expression_t
+floor(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnFloor,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnFloor >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Log
 /*! @ingroup group1
 @relates QDPType */
@@ -1322,6 +2077,22 @@ log(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Log
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnLog,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnLog >::Type_t >::Expression_t
+log(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnLog,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnLog >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Log base 10
 /*! @ingroup group1
 @relates QDPType */
@@ -1338,6 +2109,22 @@ log10(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Log base 10
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnLog10,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnLog10 >::Type_t >::Expression_t
+log10(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnLog10,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnLog10 >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Sine
 /*! @ingroup group1
 @relates QDPType */
@@ -1354,6 +2141,22 @@ sin(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Sine
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSin,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSin >::Type_t >::Expression_t
+sin(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSin,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSin >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Hyperbolic sine
 /*! @ingroup group1
 @relates QDPType */
@@ -1370,6 +2173,22 @@ sinh(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Hyperbolic sine
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnHypSin,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnHypSin >::Type_t >::Expression_t
+sinh(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnHypSin,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnHypSin >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Square root
 /*! @ingroup group1
 @relates QDPType */
@@ -1386,6 +2205,22 @@ sqrt(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Square root
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnSqrt,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnSqrt >::Type_t >::Expression_t
+sqrt(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnSqrt,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnSqrt >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Tangent
 /*! @ingroup group1
 @relates QDPType */
@@ -1402,6 +2237,22 @@ tan(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Tangent
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnTan,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnTan >::Type_t >::Expression_t
+tan(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnTan,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnTan >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Hyperbolic tangent
 /*! @ingroup group1
 @relates QDPType */
@@ -1418,6 +2269,22 @@ tanh(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Hyperbolic tangent
+/*! @ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<FnHypTan,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnHypTan >::Type_t >::Expression_t
+tanh(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<FnHypTan,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,FnHypTan >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Unary minus
 /*! 
 @return -a
@@ -1436,6 +2303,24 @@ operator-(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Unary minus
+/*! 
+@return -a
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<OpUnaryMinus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,OpUnaryMinus >::Type_t >::Expression_t
+operator-(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<OpUnaryMinus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,OpUnaryMinus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Unary plus
 /*!
 @return +a
@@ -1454,6 +2339,24 @@ operator+(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Unary plus
+/*!
+@return +a
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<OpUnaryPlus,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,OpUnaryPlus >::Type_t >::Expression_t
+operator+(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<OpUnaryPlus,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,OpUnaryPlus >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Bitwise not
 /*!
 @return (~a)
@@ -1472,6 +2375,24 @@ operator~(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Bitwise not
+/*!
+@return (~a)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<OpBitwiseNot,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,OpBitwiseNot >::Type_t >::Expression_t
+operator~(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<OpBitwiseNot,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,OpBitwiseNot >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Identity operator
 /*! Constructs expression form of a source
 @return (a)
@@ -1490,6 +2411,24 @@ PETE_identity(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Identity operator
+/*! Constructs expression form of a source
+@return (a)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<OpIdentity,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,OpIdentity >::Type_t >::Expression_t
+PETE_identity(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<OpIdentity,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,OpIdentity >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Boolean not operator
 /*! 
 @return (!a)
@@ -1508,6 +2447,24 @@ operator!(const QDPType<T1,C1> & l)
     CreateLeaf<QDPType<T1,C1> >::make(l)));
 }
 
+//! Boolean not operator
+/*! 
+@return (!a)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1>
+inline typename MakeReturn<UnaryNode<OpNot,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,OpNot >::Type_t >::Expression_t
+operator!(const QDPSubType<T1,C1> & l)
+{
+  typedef UnaryNode<OpNot,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+  typedef typename UnaryReturn<C1,OpNot >::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+}
+
 //! Build a complex from two reals
 /*! Returns a complex value
   @param l  real (a reality scalar)
@@ -1531,685 +2488,2839 @@ cmplx(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Construct the outer product of two vectors
-/*! 
-  Constructs the outer product of two vectors within the same vector space
-  @param l  vector
-  @param r  vector
-  @return \f$(l_i * r_j^*)_{ij}\f$
+//! Build a complex from two reals
+/*! Returns a complex value
+  @param l  real (a reality scalar)
+  @param r  real (a reality scalar)
+  @return (l + i*r)
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnOuterProduct,
+inline typename MakeReturn<BinaryNode<FnCmplx,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
-outerProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnCmplx>::Type_t >::Expression_t
+cmplx(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnOuterProduct,
+  typedef BinaryNode<FnCmplx,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnCmplx>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Build a complex from two reals
+/*! Returns a complex value
+  @param l  real (a reality scalar)
+  @param r  real (a reality scalar)
+  @return (l + i*r)
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnCmplx,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnCmplx>::Type_t >::Expression_t
+cmplx(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnCmplx,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnCmplx>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Sum over colorvector indices
+//! Build a complex from two reals
+/*! Returns a complex value
+  @param l  real (a reality scalar)
+  @param r  real (a reality scalar)
+  @return (l + i*r)
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnCmplx,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnCmplx>::Type_t >::Expression_t
+cmplx(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnCmplx,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnCmplx>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Construct the outer product of two vectors
 /*! 
-  Contract two colorvectors with no conjugation
+  Constructs the outer product of two vectors within the same vector space
   @param l  vector
   @param r  vector
-  @return \f$\sum_i l_i * r_i\f$
+  @return \f$(l_i * r_j^*)_{ij}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnColorVectorContract,
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
-colorVectorContract(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnColorVectorContract,
+  typedef BinaryNode<FnOuterProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Cross product of two Nc=3 color vectors
+//! Construct the outer product of two vectors
 /*! 
-  Antisymmetric combination of two Nc=3 color vectors
+  Constructs the outer product of two vectors within the same vector space
   @param l  vector
   @param r  vector
-  @return \f$target^{i} = \sum_{jk}\epsilon^{i j k}*source1^{j}*source2^{k}\f$
+  @return \f$(l_i * r_j^*)_{ij}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t >::Expression_t
-colorCrossProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnColorCrossProduct,
+  typedef BinaryNode<FnOuterProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! InnerProduct on only fiber indices
-/*! L2 norm only fiber indices
-  @sa adj(), trace()
-  @return (trace(adj(l)*r)
+//! Construct the outer product of two vectors
+/*! 
+  Constructs the outer product of two vectors within the same vector space
+  @param l  vector
+  @param r  vector
+  @return \f$(l_i * r_j^*)_{ij}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Expression_t
-localInnerProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnLocalInnerProduct,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typedef BinaryNode<FnOuterProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Real part of innerproduct on only fiber indices
-/*! L2 norm only fiber indices
-  @sa adj(), trace(), real()
-  @return (real(trace(adj(l)*r))
+//! Construct the outer product of two vectors
+/*! 
+  Constructs the outer product of two vectors within the same vector space
+  @param l  vector
+  @param r  vector
+  @return \f$(l_i * r_j^*)_{ij}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
-localInnerProductReal(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnLocalInnerProductReal,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t Container_t;
+  typedef BinaryNode<FnOuterProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! InnerProduct on only color fiber indices
-/*! L2 norm only color fiber indices
-  @sa adj(), trace()
-  @return (traceColor(adj(l)*r)
+//! Sum over colorvector indices
+/*! 
+  Contract two colorvectors with no conjugation
+  @param l  vector
+  @param r  vector
+  @return \f$\sum_i l_i * r_i\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
-localColorInnerProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnLocalColorInnerProduct,
+  typedef BinaryNode<FnColorVectorContract,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Contraction for quark propagators
+//! Sum over colorvector indices
 /*! 
-   epsilon contract 2 quark propagators and return a quark propagator.
-   This is used for diquark constructions. Eventually, it could handle larger
-   Nc. 
-   The numbers represent which spin index to sum over.
-   
-   The sources and targets must all be propagators but not
-   necessarily of the same lattice type. Effectively, one can use
-   this to construct an anti-quark from a di-quark contraction. In
-   explicit index form, the operation  QuarkContract13 does
-   
-   \f$target^{k' k}_{\alpha\beta} =
-     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}_{\rho\alpha}* source2^{j j'}_{\rho\beta}\f$
-   
-   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  Contract two colorvectors with no conjugation
+  @param l  vector
+  @param r  vector
+  @return \f$\sum_i l_i * r_i\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnQuarkContract13,
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t >::Expression_t
-quarkContract13(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnQuarkContract13,
+  typedef BinaryNode<FnColorVectorContract,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Contraction for quark propagators
+//! Sum over colorvector indices
 /*! 
-   epsilon contract 2 quark propagators and return a quark propagator.
-   This is used for diquark constructions. Eventually, it could handle larger
-   Nc. 
-   The numbers represent which spin index to sum over.
-   
-   The sources and targets must all be propagators but not
-   necessarily of the same lattice type. Effectively, one can use
-   this to construct an anti-quark from a di-quark contraction. In
-   explicit index form, the operation  QuarkContract14 does
-   
-  \f$target^{k' k}_{\alpha\beta} =
-    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
-
-   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  Contract two colorvectors with no conjugation
+  @param l  vector
+  @param r  vector
+  @return \f$\sum_i l_i * r_i\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnQuarkContract14,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t >::Expression_t
-quarkContract14(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnQuarkContract14,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typedef BinaryNode<FnColorVectorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Contraction for quark propagators
+//! Sum over colorvector indices
 /*! 
-   epsilon contract 2 quark propagators and return a quark propagator.
-   This is used for diquark constructions. Eventually, it could handle larger
-   Nc. 
-   The numbers represent which spin index to sum over.
-   
-   The sources and targets must all be propagators but not
-   necessarily of the same lattice type. Effectively, one can use
-   this to construct an anti-quark from a di-quark contraction. In
-   explicit index form, the operation  QuarkContract23 does
-   
-  \f$target^{k' k}_{\alpha\beta} =
-    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\rho}*source2^{j j'}_{\rho\beta}\f$
+  Contract two colorvectors with no conjugation
+  @param l  vector
+  @param r  vector
+  @return \f$\sum_i l_i * r_i\f$
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnColorVectorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
 
-   and is (currently) only appropriate for Nc=3  (or SU(3)).
+//! Cross product of two Nc=3 color vectors
+/*! 
+  Antisymmetric combination of two Nc=3 color vectors
+  @param l  vector
+  @param r  vector
+  @return \f$target^{i} = \sum_{jk}\epsilon^{i j k}*source1^{j}*source2^{k}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t >::Expression_t
-quarkContract23(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnQuarkContract23,
+  typedef BinaryNode<FnColorCrossProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Contraction for quark propagators
+//! Cross product of two Nc=3 color vectors
 /*! 
-   epsilon contract 2 quark propagators and return a quark propagator.
-   This is used for diquark constructions. Eventually, it could handle larger
-   Nc. 
-   The numbers represent which spin index to sum over.
-   
-   The sources and targets must all be propagators but not
-   necessarily of the same lattice type. Effectively, one can use
-   this to construct an anti-quark from a di-quark contraction. In
-   explicit index form, the operation  QuarkContract24 does
-   
-  \f$target^{k' k}_{\alpha\beta} =
-    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
-
-   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  Antisymmetric combination of two Nc=3 color vectors
+  @param l  vector
+  @param r  vector
+  @return \f$target^{i} = \sum_{jk}\epsilon^{i j k}*source1^{j}*source2^{k}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t >::Expression_t
-quarkContract24(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnQuarkContract24,
+  typedef BinaryNode<FnColorCrossProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Contraction for quark propagators
+//! Cross product of two Nc=3 color vectors
 /*! 
-   epsilon contract 2 quark propagators and return a quark propagator.
-   This is used for diquark constructions. Eventually, it could handle larger
-   Nc. 
-   The numbers represent which spin index to sum over.
-   
-   The sources and targets must all be propagators but not
-   necessarily of the same lattice type. Effectively, one can use
-   this to construct an anti-quark from a di-quark contraction. In
-   explicit index form, the operation  QuarkContract12 does
-   
-  \f$target^{k' k}_{\alpha\beta} =
-    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\rho}*source2^{j j'}_{\alpha\beta}\f$
-
-   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  Antisymmetric combination of two Nc=3 color vectors
+  @param l  vector
+  @param r  vector
+  @return \f$target^{i} = \sum_{jk}\epsilon^{i j k}*source1^{j}*source2^{k}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnQuarkContract12,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t >::Expression_t
-quarkContract12(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnQuarkContract12,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typedef BinaryNode<FnColorCrossProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Contraction for quark propagators
+//! Cross product of two Nc=3 color vectors
 /*! 
-   epsilon contract 2 quark propagators and return a quark propagator.
-   This is used for diquark constructions. Eventually, it could handle larger
-   Nc. 
-   The numbers represent which spin index to sum over.
-   
-   The sources and targets must all be propagators but not
-   necessarily of the same lattice type. Effectively, one can use
-   this to construct an anti-quark from a di-quark contraction. In
-   explicit index form, the operation  QuarkContract34 does
-   
-  \f$target^{k' k}_{\alpha\beta} =
-    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\beta}*source2^{j j'}_{\rho\rho}\f$
-
-   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  Antisymmetric combination of two Nc=3 color vectors
+  @param l  vector
+  @param r  vector
+  @return \f$target^{i} = \sum_{jk}\epsilon^{i j k}*source1^{j}*source2^{k}\f$
   @ingroup group1
   @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnQuarkContract34,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t >::Expression_t
-quarkContract34(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnQuarkContract34,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t Container_t;
+  typedef BinaryNode<FnColorCrossProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Binary addition
-/*! 
-@return (a+b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace()
+  @return (trace(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpAdd,
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpAdd>::Type_t >::Expression_t
-operator+(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpAdd,
+  typedef BinaryNode<FnLocalInnerProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpAdd>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Binary subtract
-/*! 
-@return (a-b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace()
+  @return (trace(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpSubtract,
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpSubtract>::Type_t >::Expression_t
-operator-(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<OpSubtract,
+  typedef BinaryNode<FnLocalInnerProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpSubtract>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Binary multiply
-/*!
- @return (a * b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace()
+  @return (trace(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpMultiply,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpMultiply>::Type_t >::Expression_t
-operator*(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpMultiply,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typedef BinaryNode<FnLocalInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpMultiply>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Binary division
-/*!
- @return (a / b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace()
+  @return (trace(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpDivide,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
-operator/(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<OpDivide,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  typedef BinaryNode<FnLocalInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Binary mod
-/*! Also call mod(a,b)
-@return (a % b)
-@ingroup group1
-@relates QDPType */
+//! Real part of innerproduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace(), real()
+  @return (real(trace(adj(l)*r))
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpMod,
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
-operator%(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpMod,
+  typedef BinaryNode<FnLocalInnerProductReal,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Bitwise and
-/*!
- @return (a & b)
-@ingroup group1
-@relates QDPType */
+//! Real part of innerproduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace(), real()
+  @return (real(trace(adj(l)*r))
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t >::Expression_t
-operator&(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<OpBitwiseAnd,
+  typedef BinaryNode<FnLocalInnerProductReal,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Bitwise or
-/*! 
-@return (a | b)
-@ingroup group1
-@relates QDPType */
+//! Real part of innerproduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace(), real()
+  @return (real(trace(adj(l)*r))
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpBitwiseOr,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t >::Expression_t
-operator|(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpBitwiseOr,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typedef BinaryNode<FnLocalInnerProductReal,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Bitwise exclusive or
-/*! 
-@return (a ^ b)
-@ingroup group1
-@relates QDPType */
+//! Real part of innerproduct on only fiber indices
+/*! L2 norm only fiber indices
+  @sa adj(), trace(), real()
+  @return (real(trace(adj(l)*r))
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpBitwiseXor,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t >::Expression_t
-operator^(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<OpBitwiseXor,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t Container_t;
+  typedef BinaryNode<FnLocalInnerProductReal,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Load exponent
-/*! Calculates the value a times 2 to the power b.
-Based on the C-math lib function.
-@return ldexp(a,b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only color fiber indices
+/*! L2 norm only color fiber indices
+  @sa adj(), trace()
+  @return (traceColor(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnLdexp,
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
-ldexp(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnLdexp,
+  typedef BinaryNode<FnLocalColorInnerProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! a to the power b
-/*! Based on the C-math lib function.
-@return pow(a,b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only color fiber indices
+/*! L2 norm only color fiber indices
+  @sa adj(), trace()
+  @return (traceColor(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnPow,
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
-pow(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnPow,
+  typedef BinaryNode<FnLocalColorInnerProduct,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Floating point remainder
-/*! Computes a modulo b.
-Based on the C-math lib function.
-@return fmod(a,b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only color fiber indices
+/*! L2 norm only color fiber indices
+  @sa adj(), trace()
+  @return (traceColor(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnFmod,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnFmod>::Type_t >::Expression_t
-fmod(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnFmod,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typedef BinaryNode<FnLocalColorInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnFmod>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Arctan of a/b
-/*! Produces correct angles near +-pi/2 (or a near 0).
-Based on the C-math lib function.
-@return atan2(a,b)
-@ingroup group1
-@relates QDPType */
+//! InnerProduct on only color fiber indices
+/*! L2 norm only color fiber indices
+  @sa adj(), trace()
+  @return (traceColor(adj(l)*r)
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnArcTan2,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnArcTan2>::Type_t >::Expression_t
-atan2(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<FnArcTan2,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnArcTan2>::Type_t Container_t;
+  typedef BinaryNode<FnLocalColorInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Less than
-/*! Boolean result 
-@return (a < b)
-@ingroup group1
-@relates QDPType */
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract13 does
+   
+   \f$target^{k' k}_{\alpha\beta} =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}_{\rho\alpha}* source2^{j j'}_{\rho\beta}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpLT,
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpLT>::Type_t >::Expression_t
-operator<(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpLT,
+  typedef BinaryNode<FnQuarkContract13,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpLT>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Less than equal
-/*! Boolean result 
-@return (a <= b)
-@ingroup group1
-@relates QDPType */
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract13 does
+   
+   \f$target^{k' k}_{\alpha\beta} =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}_{\rho\alpha}* source2^{j j'}_{\rho\beta}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpLE,
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpLE>::Type_t >::Expression_t
-operator<=(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<OpLE,
+  typedef BinaryNode<FnQuarkContract13,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpLE>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
-//! Great than
-/*! Boolean result 
-@return (a > b)
-@ingroup group1
-@relates QDPType */
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract13 does
+   
+   \f$target^{k' k}_{\alpha\beta} =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}_{\rho\alpha}* source2^{j j'}_{\rho\beta}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpGT,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpGT>::Type_t >::Expression_t
-operator>(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpGT,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typedef BinaryNode<FnQuarkContract13,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpGT>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Great than equal
-/*! Boolean result 
-@return (a >= b)
-@ingroup group1
-@relates QDPType */
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract13 does
+   
+   \f$target^{k' k}_{\alpha\beta} =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}_{\rho\alpha}* source2^{j j'}_{\rho\beta}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpGE,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpGE>::Type_t >::Expression_t
-operator>=(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<OpGE,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef BinaryNode<FnQuarkContract13,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract14 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract14 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract14 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract14 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract23 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\rho}*source2^{j j'}_{\rho\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract23 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\rho}*source2^{j j'}_{\rho\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract23 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\rho}*source2^{j j'}_{\rho\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract23 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\rho}*source2^{j j'}_{\rho\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract24 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract24 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract24 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract24 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\alpha}*source2^{j j'}_{\beta\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract12 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\rho}*source2^{j j'}_{\alpha\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract12 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\rho}*source2^{j j'}_{\alpha\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract12 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\rho}*source2^{j j'}_{\alpha\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract12 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\rho\rho}*source2^{j j'}_{\alpha\beta}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract34 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\beta}*source2^{j j'}_{\rho\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract34,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract34 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\beta}*source2^{j j'}_{\rho\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract34,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract34 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\beta}*source2^{j j'}_{\rho\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract34,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Contraction for quark propagators
+/*! 
+   epsilon contract 2 quark propagators and return a quark propagator.
+   This is used for diquark constructions. Eventually, it could handle larger
+   Nc. 
+   The numbers represent which spin index to sum over.
+   
+   The sources and targets must all be propagators but not
+   necessarily of the same lattice type. Effectively, one can use
+   this to construct an anti-quark from a di-quark contraction. In
+   explicit index form, the operation  QuarkContract34 does
+   
+  \f$target^{k' k}_{\alpha\beta} =
+    \epsilon^{i j k}\epsilon^{i' j' k'}*source1^{i i'}_{\alpha\beta}*source2^{j j'}_{\rho\rho}\f$
+
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract34,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary addition
+/*! 
+@return (a+b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAdd>::Type_t >::Expression_t
+operator+(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary addition
+/*! 
+@return (a+b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAdd>::Type_t >::Expression_t
+operator+(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary addition
+/*! 
+@return (a+b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAdd>::Type_t >::Expression_t
+operator+(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary addition
+/*! 
+@return (a+b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAdd>::Type_t >::Expression_t
+operator+(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary subtract
+/*! 
+@return (a-b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpSubtract>::Type_t >::Expression_t
+operator-(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary subtract
+/*! 
+@return (a-b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpSubtract>::Type_t >::Expression_t
+operator-(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary subtract
+/*! 
+@return (a-b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpSubtract>::Type_t >::Expression_t
+operator-(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary subtract
+/*! 
+@return (a-b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpSubtract>::Type_t >::Expression_t
+operator-(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary multiply
+/*!
+ @return (a * b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMultiply>::Type_t >::Expression_t
+operator*(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary multiply
+/*!
+ @return (a * b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMultiply>::Type_t >::Expression_t
+operator*(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary multiply
+/*!
+ @return (a * b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMultiply>::Type_t >::Expression_t
+operator*(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary multiply
+/*!
+ @return (a * b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMultiply>::Type_t >::Expression_t
+operator*(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary division
+/*!
+ @return (a / b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
+operator/(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary division
+/*!
+ @return (a / b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
+operator/(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary division
+/*!
+ @return (a / b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
+operator/(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary division
+/*!
+ @return (a / b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
+operator/(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary mod
+/*! Also call mod(a,b)
+@return (a % b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
+operator%(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMod,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary mod
+/*! Also call mod(a,b)
+@return (a % b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
+operator%(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMod,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Binary mod
+/*! Also call mod(a,b)
+@return (a % b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
+operator%(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMod,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Binary mod
+/*! Also call mod(a,b)
+@return (a % b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
+operator%(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMod,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Bitwise and
+/*!
+ @return (a & b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Bitwise and
+/*!
+ @return (a & b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Bitwise and
+/*!
+ @return (a & b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Bitwise and
+/*!
+ @return (a & b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Bitwise or
+/*! 
+@return (a | b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Bitwise or
+/*! 
+@return (a | b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Bitwise or
+/*! 
+@return (a | b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Bitwise or
+/*! 
+@return (a | b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Bitwise exclusive or
+/*! 
+@return (a ^ b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Bitwise exclusive or
+/*! 
+@return (a ^ b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Bitwise exclusive or
+/*! 
+@return (a ^ b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Bitwise exclusive or
+/*! 
+@return (a ^ b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Load exponent
+/*! Calculates the value a times 2 to the power b.
+Based on the C-math lib function.
+@return ldexp(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
+ldexp(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Load exponent
+/*! Calculates the value a times 2 to the power b.
+Based on the C-math lib function.
+@return ldexp(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
+ldexp(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Load exponent
+/*! Calculates the value a times 2 to the power b.
+Based on the C-math lib function.
+@return ldexp(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
+ldexp(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Load exponent
+/*! Calculates the value a times 2 to the power b.
+Based on the C-math lib function.
+@return ldexp(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
+ldexp(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! a to the power b
+/*! Based on the C-math lib function.
+@return pow(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
+pow(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnPow,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! a to the power b
+/*! Based on the C-math lib function.
+@return pow(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
+pow(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnPow,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! a to the power b
+/*! Based on the C-math lib function.
+@return pow(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
+pow(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnPow,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! a to the power b
+/*! Based on the C-math lib function.
+@return pow(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
+pow(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnPow,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Floating point remainder
+/*! Computes a modulo b.
+Based on the C-math lib function.
+@return fmod(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnFmod>::Type_t >::Expression_t
+fmod(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Floating point remainder
+/*! Computes a modulo b.
+Based on the C-math lib function.
+@return fmod(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnFmod>::Type_t >::Expression_t
+fmod(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Floating point remainder
+/*! Computes a modulo b.
+Based on the C-math lib function.
+@return fmod(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnFmod>::Type_t >::Expression_t
+fmod(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Floating point remainder
+/*! Computes a modulo b.
+Based on the C-math lib function.
+@return fmod(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnFmod>::Type_t >::Expression_t
+fmod(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Arctan of a/b
+/*! Produces correct angles near +-pi/2 (or a near 0).
+Based on the C-math lib function.
+@return atan2(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnArcTan2>::Type_t >::Expression_t
+atan2(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Arctan of a/b
+/*! Produces correct angles near +-pi/2 (or a near 0).
+Based on the C-math lib function.
+@return atan2(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnArcTan2>::Type_t >::Expression_t
+atan2(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Arctan of a/b
+/*! Produces correct angles near +-pi/2 (or a near 0).
+Based on the C-math lib function.
+@return atan2(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnArcTan2>::Type_t >::Expression_t
+atan2(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Arctan of a/b
+/*! Produces correct angles near +-pi/2 (or a near 0).
+Based on the C-math lib function.
+@return atan2(a,b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnArcTan2>::Type_t >::Expression_t
+atan2(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Less than
+/*! Boolean result 
+@return (a < b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLT>::Type_t >::Expression_t
+operator<(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Less than
+/*! Boolean result 
+@return (a < b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLT>::Type_t >::Expression_t
+operator<(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Less than
+/*! Boolean result 
+@return (a < b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLT>::Type_t >::Expression_t
+operator<(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Less than
+/*! Boolean result 
+@return (a < b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLT>::Type_t >::Expression_t
+operator<(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Less than equal
+/*! Boolean result 
+@return (a <= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLE>::Type_t >::Expression_t
+operator<=(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Less than equal
+/*! Boolean result 
+@return (a <= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLE>::Type_t >::Expression_t
+operator<=(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Less than equal
+/*! Boolean result 
+@return (a <= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLE>::Type_t >::Expression_t
+operator<=(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Less than equal
+/*! Boolean result 
+@return (a <= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLE>::Type_t >::Expression_t
+operator<=(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Great than
+/*! Boolean result 
+@return (a > b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGT>::Type_t >::Expression_t
+operator>(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGT,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Great than
+/*! Boolean result 
+@return (a > b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGT>::Type_t >::Expression_t
+operator>(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGT,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Great than
+/*! Boolean result 
+@return (a > b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGT>::Type_t >::Expression_t
+operator>(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGT,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Great than
+/*! Boolean result 
+@return (a > b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGT>::Type_t >::Expression_t
+operator>(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGT,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Great than equal
+/*! Boolean result 
+@return (a >= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGE>::Type_t >::Expression_t
+operator>=(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Great than equal
+/*! Boolean result 
+@return (a >= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGE>::Type_t >::Expression_t
+operator>=(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Great than equal
+/*! Boolean result 
+@return (a >= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGE>::Type_t >::Expression_t
+operator>=(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Great than equal
+/*! Boolean result 
+@return (a >= b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGE>::Type_t >::Expression_t
+operator>=(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,C2,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Equality
+/*! Boolean result 
+@return (a == b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpEQ,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpEQ>::Type_t >::Expression_t
+operator==(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpEQ,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpEQ>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Equality
+/*! Boolean result 
+@return (a == b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpEQ,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpEQ>::Type_t >::Expression_t
+operator==(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpEQ,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpEQ>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 //! Equality
@@ -2219,20 +5330,41 @@ operator>=(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 @relates QDPType */
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpEQ,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
   typename BinaryReturn<C1,C2,OpEQ>::Type_t >::Expression_t
-operator==(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+operator==(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
   typedef BinaryNode<OpEQ,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,C2,OpEQ>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+//! Equality
+/*! Boolean result 
+@return (a == b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpEQ,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpEQ>::Type_t >::Expression_t
+operator==(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpEQ,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpEQ>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 //! Not equal
 /*! Boolean result 
 @return (a != b)
@@ -2254,6 +5386,69 @@ operator!=(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+//! Not equal
+/*! Boolean result 
+@return (a != b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpNE,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpNE>::Type_t >::Expression_t
+operator!=(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpNE,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpNE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Not equal
+/*! Boolean result 
+@return (a != b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpNE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpNE>::Type_t >::Expression_t
+operator!=(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpNE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpNE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Not equal
+/*! Boolean result 
+@return (a != b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpNE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpNE>::Type_t >::Expression_t
+operator!=(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpNE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpNE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 //! Logical and
 /*! Boolean result 
 @return (a && b)
@@ -2275,6 +5470,69 @@ operator&&(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+//! Logical and
+/*! Boolean result 
+@return (a && b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAnd,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAnd>::Type_t >::Expression_t
+operator&&(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Logical and
+/*! Boolean result 
+@return (a && b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAnd>::Type_t >::Expression_t
+operator&&(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Logical and
+/*! Boolean result 
+@return (a && b)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAnd>::Type_t >::Expression_t
+operator&&(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 //! Logical or
 /*! Boolean result 
 @return (a | b)
@@ -2288,34 +5546,205 @@ inline typename MakeReturn<BinaryNode<OpOr,
   typename BinaryReturn<C1,C2,OpOr>::Type_t >::Expression_t
 operator||(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpOr,
+  typedef BinaryNode<OpOr,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Logical or
+/*! Boolean result 
+@return (a | b)
+@ingroup group1
+@relates QDPType */
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpOr,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpOr>::Type_t >::Expression_t
+operator||(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpOr,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Logical or
+/*! Boolean result 
+@return (a | b)
+@ingroup group1
+@relates QDPType */
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpOr>::Type_t >::Expression_t
+operator||(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Logical or
+/*! Boolean result 
+@return (a | b)
+@ingroup group1
+@relates QDPType */
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpOr>::Type_t >::Expression_t
+operator||(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Left shift
+/*! Not cyclic
+@return (a left shifted by b bits)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLeftShift>::Type_t >::Expression_t
+operator<<(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Left shift
+/*! Not cyclic
+@return (a left shifted by b bits)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLeftShift>::Type_t >::Expression_t
+operator<<(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Left shift
+/*! Not cyclic
+@return (a left shifted by b bits)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLeftShift>::Type_t >::Expression_t
+operator<<(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+//! Left shift
+/*! Not cyclic
+@return (a left shifted by b bits)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLeftShift>::Type_t >::Expression_t
+operator<<(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+//! Right shift
+/*! Not cyclic
+@return (a right shifted by b bits)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpRightShift,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpRightShift>::Type_t >::Expression_t
+operator>>(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpRightShift,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpOr>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,OpRightShift>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
-//! Left shift
+//! Right shift
 /*! Not cyclic
-@return (a left shifted by b bits)
+@return (a right shifted by b bits)
 @ingroup group1
 @relates QDPType */
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<OpLeftShift,
+inline typename MakeReturn<BinaryNode<OpRightShift,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,OpLeftShift>::Type_t >::Expression_t
-operator<<(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpRightShift>::Type_t >::Expression_t
+operator>>(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
-  typedef BinaryNode<OpLeftShift,
+  typedef BinaryNode<OpRightShift,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpLeftShift>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpRightShift>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 //! Right shift
@@ -2325,20 +5754,41 @@ operator<<(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
 @relates QDPType */
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpRightShift,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
   typename BinaryReturn<C1,C2,OpRightShift>::Type_t >::Expression_t
-operator>>(const QDPType<T1,C1> & l,const QDPType<T2,C2> & r)
+operator>>(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
 {
   typedef BinaryNode<OpRightShift,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,C2,OpRightShift>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+//! Right shift
+/*! Not cyclic
+@return (a right shifted by b bits)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpRightShift,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpRightShift>::Type_t >::Expression_t
+operator>>(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpRightShift,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpRightShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnCmplx,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2355,6 +5805,22 @@ cmplx(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnCmplx,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnCmplx>::Type_t >::Expression_t
+cmplx(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnCmplx,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnCmplx>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnOuterProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2371,6 +5837,22 @@ outerProduct(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnOuterProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnColorVectorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2387,6 +5869,22 @@ colorVectorContract(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnColorVectorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2403,6 +5901,22 @@ colorCrossProduct(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnColorCrossProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2419,6 +5933,22 @@ localInnerProduct(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2435,6 +5965,22 @@ localInnerProductReal(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalInnerProductReal,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2451,6 +5997,22 @@ localColorInnerProduct(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalColorInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract13,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2467,6 +6029,22 @@ quarkContract13(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract13,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract14,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2483,6 +6061,22 @@ quarkContract14(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract23,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2499,6 +6093,22 @@ quarkContract23(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract24,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2515,6 +6125,22 @@ quarkContract24(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract12,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2531,6 +6157,22 @@ quarkContract12(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract34,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2547,6 +6189,22 @@ quarkContract34(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract34,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpAdd,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2563,6 +6221,22 @@ operator+(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAdd>::Type_t >::Expression_t
+operator+(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpSubtract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2579,6 +6253,22 @@ operator-(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpSubtract>::Type_t >::Expression_t
+operator-(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpMultiply,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2595,6 +6285,22 @@ operator*(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMultiply>::Type_t >::Expression_t
+operator*(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpDivide,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2602,10 +6308,42 @@ inline typename MakeReturn<BinaryNode<OpDivide,
   typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
 operator/(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
 {
-  typedef BinaryNode<OpDivide,
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
+operator/(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
+operator%(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpMod,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
@@ -2613,17 +6351,17 @@ operator/(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
 
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpMod,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
   typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
-operator%(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+operator%(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
 {
   typedef BinaryNode<OpMod,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
@@ -2643,6 +6381,22 @@ operator&(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseOr,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2659,6 +6413,22 @@ operator|(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseXor,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2675,6 +6445,22 @@ operator^(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLdexp,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2691,6 +6477,22 @@ ldexp(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
+ldexp(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnPow,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2707,6 +6509,22 @@ pow(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
+pow(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnPow,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnFmod,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2723,6 +6541,22 @@ fmod(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnFmod>::Type_t >::Expression_t
+fmod(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnArcTan2,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2739,6 +6573,22 @@ atan2(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnArcTan2>::Type_t >::Expression_t
+atan2(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLT,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2755,6 +6605,22 @@ operator<(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLT>::Type_t >::Expression_t
+operator<(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLE,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2771,6 +6637,22 @@ operator<=(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLE>::Type_t >::Expression_t
+operator<=(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpGT,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2787,6 +6669,22 @@ operator>(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGT>::Type_t >::Expression_t
+operator>(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpGT,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpGE,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2803,6 +6701,22 @@ operator>=(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGE>::Type_t >::Expression_t
+operator>=(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpEQ,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2819,6 +6733,22 @@ operator==(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpEQ,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpEQ>::Type_t >::Expression_t
+operator==(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpEQ,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpEQ>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpNE,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2835,6 +6765,22 @@ operator!=(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpNE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpNE>::Type_t >::Expression_t
+operator!=(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpNE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpNE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpAnd,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2851,6 +6797,22 @@ operator&&(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAnd>::Type_t >::Expression_t
+operator&&(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpOr,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2867,6 +6829,22 @@ operator||(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpOr>::Type_t >::Expression_t
+operator||(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLeftShift,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2883,6 +6861,22 @@ operator<<(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLeftShift>::Type_t >::Expression_t
+operator<<(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpRightShift,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -2899,6 +6893,22 @@ operator>>(const QDPType<T1,C1> & l,const QDPExpr<T2,C2> & r)
     CreateLeaf<QDPExpr<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpRightShift,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpRightShift>::Type_t >::Expression_t
+operator>>(const QDPSubType<T1,C1> & l,const QDPExpr<T2,C2> & r)
+{
+  typedef BinaryNode<OpRightShift,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpRightShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnCmplx,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -2912,20 +6922,68 @@ cmplx(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
   typedef typename BinaryReturn<C1,C2,FnCmplx>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPExpr<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnCmplx,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnCmplx>::Type_t >::Expression_t
+cmplx(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnCmplx,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnCmplx>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnOuterProduct,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnOuterProduct,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnOuterProduct,
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t >::Expression_t
-outerProduct(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnOuterProduct,
+  typedef BinaryNode<FnColorVectorContract,
     typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnOuterProduct>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPExpr<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
@@ -2934,17 +6992,17 @@ outerProduct(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnColorVectorContract,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
   typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t >::Expression_t
-colorVectorContract(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
+colorVectorContract(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
   typedef BinaryNode<FnColorVectorContract,
     typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,C2,FnColorVectorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPExpr<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 template<class T1,class C1,class T2,class C2>
@@ -2963,6 +7021,22 @@ colorCrossProduct(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnColorCrossProduct,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnColorCrossProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -2979,6 +7053,22 @@ localInnerProduct(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalInnerProduct,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -2995,6 +7085,22 @@ localInnerProductReal(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalInnerProductReal,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalInnerProductReal>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3011,6 +7117,22 @@ localColorInnerProduct(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalColorInnerProduct,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract13,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3027,6 +7149,22 @@ quarkContract13(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract13,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract13>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract14,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3043,6 +7181,22 @@ quarkContract14(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract23,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3059,6 +7213,22 @@ quarkContract23(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract24,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3075,6 +7245,22 @@ quarkContract24(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract12,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3091,6 +7277,22 @@ quarkContract12(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract34,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3107,6 +7309,22 @@ quarkContract34(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract34,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnQuarkContract34>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpAdd,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3123,6 +7341,22 @@ operator+(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAdd>::Type_t >::Expression_t
+operator+(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpSubtract,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3139,6 +7373,22 @@ operator-(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpSubtract>::Type_t >::Expression_t
+operator-(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpMultiply,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3155,6 +7405,22 @@ operator*(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMultiply>::Type_t >::Expression_t
+operator*(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpDivide,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3171,6 +7437,22 @@ operator/(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpDivide>::Type_t >::Expression_t
+operator/(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpMod,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3187,6 +7469,22 @@ operator%(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpMod>::Type_t >::Expression_t
+operator%(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMod,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpMod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3203,6 +7501,22 @@ operator&(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseOr,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3219,6 +7533,22 @@ operator|(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseXor,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3235,6 +7565,22 @@ operator^(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLdexp,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3242,10 +7588,42 @@ inline typename MakeReturn<BinaryNode<FnLdexp,
   typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
 ldexp(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnLdexp,
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnLdexp>::Type_t >::Expression_t
+ldexp(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
+pow(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnPow,
     typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,C2,FnLdexp>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPExpr<T1,C1> >::make(l),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
@@ -3254,17 +7632,17 @@ ldexp(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnPow,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
   typename BinaryReturn<C1,C2,FnPow>::Type_t >::Expression_t
-pow(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
+pow(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
 {
   typedef BinaryNode<FnPow,
     typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,C2,FnPow>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPExpr<T1,C1> >::make(l),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 template<class T1,class C1,class T2,class C2>
@@ -3283,6 +7661,22 @@ fmod(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnFmod>::Type_t >::Expression_t
+fmod(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnArcTan2,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3299,6 +7693,22 @@ atan2(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,FnArcTan2>::Type_t >::Expression_t
+atan2(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLT,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3315,6 +7725,22 @@ operator<(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLT>::Type_t >::Expression_t
+operator<(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLE,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3331,6 +7757,22 @@ operator<=(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLE>::Type_t >::Expression_t
+operator<=(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpGT,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3347,6 +7789,22 @@ operator>(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGT>::Type_t >::Expression_t
+operator>(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGT,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpGE,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3363,6 +7821,22 @@ operator>=(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpGE>::Type_t >::Expression_t
+operator>=(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpEQ,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3379,6 +7853,22 @@ operator==(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpEQ,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpEQ>::Type_t >::Expression_t
+operator==(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpEQ,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpEQ>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpNE,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3395,6 +7885,22 @@ operator!=(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpNE,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpNE>::Type_t >::Expression_t
+operator!=(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpNE,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpNE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpAnd,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3411,6 +7917,22 @@ operator&&(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAnd,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpAnd>::Type_t >::Expression_t
+operator&&(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpOr,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3427,6 +7949,22 @@ operator||(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpOr,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpOr>::Type_t >::Expression_t
+operator||(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpOr,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLeftShift,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3443,6 +7981,22 @@ operator<<(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpLeftShift>::Type_t >::Expression_t
+operator<<(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpRightShift,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -3459,6 +8013,22 @@ operator>>(const QDPExpr<T1,C1> & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpRightShift,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<C1,C2,OpRightShift>::Type_t >::Expression_t
+operator>>(const QDPExpr<T1,C1> & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpRightShift,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,C2,OpRightShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnCmplx,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3475,6 +8045,22 @@ cmplx(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnCmplx,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnCmplx>::Type_t >::Expression_t
+cmplx(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnCmplx,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnCmplx>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnOuterProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3491,6 +8077,22 @@ outerProduct(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnOuterProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnOuterProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnColorVectorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3507,6 +8109,22 @@ colorVectorContract(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnColorVectorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorVectorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3523,6 +8141,22 @@ colorCrossProduct(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t &
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnColorCrossProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorCrossProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3539,6 +8173,22 @@ localInnerProduct(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t &
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnLocalInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3551,21 +8201,69 @@ localInnerProductReal(const QDPType<T1,C1> & l,const typename WordType<C1>::Type
     typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalInnerProductReal>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnLocalInnerProductReal,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalInnerProductReal>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnLocalColorInnerProduct,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalColorInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnLocalColorInnerProduct,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalColorInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
 template<class T1,class C1>
-inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
-  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalColorInnerProduct>::Type_t >::Expression_t
-localColorInnerProduct(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
 {
-  typedef BinaryNode<FnLocalColorInnerProduct,
+  typedef BinaryNode<FnQuarkContract13,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLocalColorInnerProduct>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract13>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
@@ -3573,17 +8271,17 @@ localColorInnerProduct(const QDPType<T1,C1> & l,const typename WordType<C1>::Typ
 
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnQuarkContract13,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
   typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract13>::Type_t >::Expression_t
-quarkContract13(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+quarkContract13(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
 {
   typedef BinaryNode<FnQuarkContract13,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract13>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
@@ -3603,6 +8301,22 @@ quarkContract14(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnQuarkContract23,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3619,6 +8333,22 @@ quarkContract23(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnQuarkContract24,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3635,6 +8365,22 @@ quarkContract24(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnQuarkContract12,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3651,6 +8397,22 @@ quarkContract12(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnQuarkContract34,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3667,6 +8429,22 @@ quarkContract34(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnQuarkContract34,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnQuarkContract34>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpAdd,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3683,6 +8461,22 @@ operator+(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpAdd>::Type_t >::Expression_t
+operator+(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpSubtract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3699,6 +8493,22 @@ operator-(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpSubtract>::Type_t >::Expression_t
+operator-(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpMultiply,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3715,6 +8525,22 @@ operator*(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpMultiply>::Type_t >::Expression_t
+operator*(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpDivide,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3731,6 +8557,22 @@ operator/(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpDivide>::Type_t >::Expression_t
+operator/(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpMod,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3747,6 +8589,22 @@ operator%(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpMod>::Type_t >::Expression_t
+operator%(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpMod,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpMod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3763,6 +8621,22 @@ operator&(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpBitwiseOr,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3779,6 +8653,22 @@ operator|(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpBitwiseXor,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3795,6 +8685,22 @@ operator^(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnLdexp,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3811,6 +8717,22 @@ ldexp(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLdexp>::Type_t >::Expression_t
+ldexp(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnPow,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3827,6 +8749,22 @@ pow(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnPow>::Type_t >::Expression_t
+pow(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnPow,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnPow>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnFmod,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3843,6 +8781,22 @@ fmod(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnFmod>::Type_t >::Expression_t
+fmod(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<FnArcTan2,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3859,6 +8813,22 @@ atan2(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnArcTan2>::Type_t >::Expression_t
+atan2(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpLT,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3875,6 +8845,22 @@ operator<(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLT>::Type_t >::Expression_t
+operator<(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpLE,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3882,10 +8868,42 @@ inline typename MakeReturn<BinaryNode<OpLE,
   typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLE>::Type_t >::Expression_t
 operator<=(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
 {
-  typedef BinaryNode<OpLE,
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLE>::Type_t >::Expression_t
+operator<=(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpGT>::Type_t >::Expression_t
+operator>(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpGT,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLE>::Type_t Container_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpGT>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(l),
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
@@ -3893,17 +8911,17 @@ operator<=(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
 
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpGT,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
   typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpGT>::Type_t >::Expression_t
-operator>(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+operator>(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
 {
   typedef BinaryNode<OpGT,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpGT>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(l),
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
@@ -3923,6 +8941,22 @@ operator>=(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpGE>::Type_t >::Expression_t
+operator>=(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpEQ,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3939,6 +8973,22 @@ operator==(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpEQ,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpEQ>::Type_t >::Expression_t
+operator==(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpEQ,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpEQ>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpNE,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3955,6 +9005,22 @@ operator!=(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpNE,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpNE>::Type_t >::Expression_t
+operator!=(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpNE,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpNE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpAnd,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3971,6 +9037,22 @@ operator&&(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpAnd,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpAnd>::Type_t >::Expression_t
+operator&&(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpOr,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -3987,6 +9069,22 @@ operator||(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpOr,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpOr>::Type_t >::Expression_t
+operator||(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpOr,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpLeftShift,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -4003,6 +9101,22 @@ operator<<(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLeftShift>::Type_t >::Expression_t
+operator<<(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<BinaryNode<OpRightShift,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -4019,6 +9133,22 @@ operator>>(const QDPType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<BinaryNode<OpRightShift,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpRightShift>::Type_t >::Expression_t
+operator>>(const QDPSubType<T1,C1> & l,const typename WordType<C1>::Type_t & r)
+{
+  typedef BinaryNode<OpRightShift,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,OpRightShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(l),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(r))));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnCmplx,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4035,6 +9165,22 @@ cmplx(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnCmplx,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnCmplx>::Type_t >::Expression_t
+cmplx(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnCmplx,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnCmplx>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnOuterProduct,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4051,6 +9197,22 @@ outerProduct(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnOuterProduct,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnOuterProduct>::Type_t >::Expression_t
+outerProduct(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnOuterProduct,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnOuterProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnColorVectorContract,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4067,6 +9229,22 @@ colorVectorContract(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2>
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnColorVectorContract,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnColorVectorContract>::Type_t >::Expression_t
+colorVectorContract(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnColorVectorContract,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnColorVectorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4083,6 +9261,22 @@ colorCrossProduct(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> &
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnColorCrossProduct,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnColorCrossProduct>::Type_t >::Expression_t
+colorCrossProduct(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnColorCrossProduct,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnColorCrossProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4099,6 +9293,22 @@ localInnerProduct(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> &
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProduct,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLocalInnerProduct>::Type_t >::Expression_t
+localInnerProduct(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalInnerProduct,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLocalInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4115,6 +9325,22 @@ localInnerProductReal(const typename WordType<C2>::Type_t & l,const QDPType<T2,C
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalInnerProductReal,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLocalInnerProductReal>::Type_t >::Expression_t
+localInnerProductReal(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalInnerProductReal,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLocalInnerProductReal>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4131,6 +9357,22 @@ localColorInnerProduct(const typename WordType<C2>::Type_t & l,const QDPType<T2,
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLocalColorInnerProduct,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLocalColorInnerProduct>::Type_t >::Expression_t
+localColorInnerProduct(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLocalColorInnerProduct,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLocalColorInnerProduct>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract13,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4147,6 +9389,22 @@ quarkContract13(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract13,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract13>::Type_t >::Expression_t
+quarkContract13(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract13,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract13>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract14,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4163,6 +9421,22 @@ quarkContract14(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract14,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract14>::Type_t >::Expression_t
+quarkContract14(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract14,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract14>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract23,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4179,6 +9453,22 @@ quarkContract23(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract23,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract23>::Type_t >::Expression_t
+quarkContract23(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract23,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract23>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract24,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4192,20 +9482,68 @@ quarkContract24(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r
   typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract24>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract24,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract24>::Type_t >::Expression_t
+quarkContract24(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract24,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract24>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract12>::Type_t >::Expression_t
+quarkContract12(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnQuarkContract12,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract12>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 template<class T2,class C2>
-inline typename MakeReturn<BinaryNode<FnQuarkContract12,
+inline typename MakeReturn<BinaryNode<FnQuarkContract34,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
-  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract12>::Type_t >::Expression_t
-quarkContract12(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract34>::Type_t >::Expression_t
+quarkContract34(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<FnQuarkContract12,
+  typedef BinaryNode<FnQuarkContract34,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract12>::Type_t Container_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract34>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
@@ -4214,17 +9552,17 @@ quarkContract12(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnQuarkContract34,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
   typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract34>::Type_t >::Expression_t
-quarkContract34(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
+quarkContract34(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
 {
   typedef BinaryNode<FnQuarkContract34,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnQuarkContract34>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 template<class T2,class C2>
@@ -4243,6 +9581,22 @@ operator+(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAdd,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpAdd>::Type_t >::Expression_t
+operator+(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAdd,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpAdd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpSubtract,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4259,6 +9613,22 @@ operator-(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpSubtract,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpSubtract>::Type_t >::Expression_t
+operator-(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpSubtract,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpSubtract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpMultiply,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4275,6 +9645,22 @@ operator*(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMultiply,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpMultiply>::Type_t >::Expression_t
+operator*(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMultiply,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpMultiply>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpDivide,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4291,6 +9677,22 @@ operator/(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpDivide,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpDivide>::Type_t >::Expression_t
+operator/(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpDivide,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpDivide>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpMod,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4307,6 +9709,22 @@ operator%(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpMod,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpMod>::Type_t >::Expression_t
+operator%(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpMod,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpMod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4323,6 +9741,22 @@ operator&(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseAnd,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpBitwiseAnd>::Type_t >::Expression_t
+operator&(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseAnd,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpBitwiseAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseOr,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4339,6 +9773,22 @@ operator|(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseOr,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpBitwiseOr>::Type_t >::Expression_t
+operator|(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseOr,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpBitwiseOr>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpBitwiseXor,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4355,6 +9805,22 @@ operator^(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpBitwiseXor,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpBitwiseXor>::Type_t >::Expression_t
+operator^(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpBitwiseXor,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpBitwiseXor>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnLdexp,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4371,6 +9837,22 @@ ldexp(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnLdexp,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLdexp>::Type_t >::Expression_t
+ldexp(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnLdexp,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnLdexp>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnPow,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4387,6 +9869,22 @@ pow(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnPow,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnPow>::Type_t >::Expression_t
+pow(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnPow,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnPow>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnFmod,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4403,6 +9901,22 @@ fmod(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnFmod,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnFmod>::Type_t >::Expression_t
+fmod(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnFmod,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnFmod>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<FnArcTan2,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4419,6 +9933,22 @@ atan2(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<FnArcTan2,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnArcTan2>::Type_t >::Expression_t
+atan2(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<FnArcTan2,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,FnArcTan2>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLT,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4435,6 +9965,22 @@ operator<(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLT,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpLT>::Type_t >::Expression_t
+operator<(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLT,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpLT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpLE,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4451,6 +9997,22 @@ operator<=(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLE,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpLE>::Type_t >::Expression_t
+operator<=(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLE,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpLE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpGT,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4467,6 +10029,22 @@ operator>(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGT,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpGT>::Type_t >::Expression_t
+operator>(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGT,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpGT>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpGE,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4483,6 +10061,22 @@ operator>=(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpGE,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpGE>::Type_t >::Expression_t
+operator>=(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpGE,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpGE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpEQ,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4499,6 +10093,22 @@ operator==(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpEQ,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpEQ>::Type_t >::Expression_t
+operator==(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpEQ,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpEQ>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpNE,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4515,6 +10125,22 @@ operator!=(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpNE,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpNE>::Type_t >::Expression_t
+operator!=(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpNE,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpNE>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpAnd,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4522,10 +10148,42 @@ inline typename MakeReturn<BinaryNode<OpAnd,
   typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpAnd>::Type_t >::Expression_t
 operator&&(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpAnd,
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpAnd,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpAnd>::Type_t >::Expression_t
+operator&&(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpAnd,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpAnd>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpOr,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpOr>::Type_t >::Expression_t
+operator||(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
+{
+  typedef BinaryNode<OpOr,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpAnd>::Type_t Container_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpOr>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
     CreateLeaf<QDPType<T2,C2> >::make(r)));
@@ -4534,17 +10192,17 @@ operator&&(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpOr,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
   typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpOr>::Type_t >::Expression_t
-operator||(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
+operator||(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
 {
   typedef BinaryNode<OpOr,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
   typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpOr>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
 }
 
 template<class T1,class C1,class T2,class C2>
@@ -4566,6 +10224,63 @@ colorContract(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const typename W
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -4585,6 +10300,63 @@ where(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const typename WordType<
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
 template<class T1,class C1,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -4604,6 +10376,63 @@ colorContract(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,c
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -4623,6 +10452,63 @@ where(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDP
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -4642,6 +10528,25 @@ colorContract(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,c
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -4661,6 +10566,25 @@ where(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const typ
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
 }
 
+template<class T1,class C1>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4680,6 +10604,25 @@ colorContract(const typename WordType<C2>::Type_t & a,const QDPType<T2,C2> & b,c
     CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(c))));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const typename WordType<C2>::Type_t & a,const QDPSubType<T2,C2> & b,const typename WordType<C2>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(c))));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4694,28 +10637,66 @@ where(const typename WordType<C2>::Type_t & a,const QDPType<T2,C2> & b,const typ
     typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t> Tree_t;
   typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
-    CreateLeaf<QDPType<T2,C2> >::make(b),
-    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(c))));
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(c))));
+}
+
+template<class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
+where(const typename WordType<C2>::Type_t & a,const QDPSubType<T2,C2> & b,const typename WordType<C2>::Type_t & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(c))));
+}
+
+template<class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const typename WordType<C3>::Type_t & a,const typename WordType<C3>::Type_t & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t(a)),
+    CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
 template<class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
-  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
   typename TrinaryReturn<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,C3,FnColorContract>::Type_t >::Expression_t
-colorContract(const typename WordType<C3>::Type_t & a,const typename WordType<C3>::Type_t & b,const QDPType<T3,C3> & c)
+colorContract(const typename WordType<C3>::Type_t & a,const typename WordType<C3>::Type_t & b,const QDPSubType<T3,C3> & c)
 {
   typedef TrinaryNode<FnColorContract,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
-    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
   typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,C3,FnColorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t(a)),
     CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t(b)),
-    CreateLeaf<QDPType<T3,C3> >::make(c)));
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
 }
 
 template<class T3,class C3>
@@ -4736,6 +10717,25 @@ where(const typename WordType<C3>::Type_t & a,const typename WordType<C3>::Type_
     CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t(b)),
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
+
+template<class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,C3,FnWhere>::Type_t >::Expression_t
+where(const typename WordType<C3>::Type_t & a,const typename WordType<C3>::Type_t & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t(a)),
+    CreateLeaf<typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C3>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
 #ifdef PETE_ALLOW_SCALAR_SHIFT
 
 template<class T2,class C2>
@@ -4754,6 +10754,22 @@ operator<<(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
     CreateLeaf<QDPType<T2,C2> >::make(r)));
 }
 
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpLeftShift,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpLeftShift>::Type_t >::Expression_t
+operator<<(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpLeftShift,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpLeftShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+
 template<class T2,class C2>
 inline typename MakeReturn<BinaryNode<OpRightShift,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -4761,15 +10777,290 @@ inline typename MakeReturn<BinaryNode<OpRightShift,
   typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t >::Expression_t
 operator>>(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
 {
-  typedef BinaryNode<OpRightShift,
-    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t Container_t;
+  typedef BinaryNode<OpRightShift,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPType<T2,C2> >::make(r)));
+}
+
+template<class T2,class C2>
+inline typename MakeReturn<BinaryNode<OpRightShift,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t>,
+  typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t >::Expression_t
+operator>>(const typename WordType<C2>::Type_t & l,const QDPSubType<T2,C2> & r)
+{
+  typedef BinaryNode<OpRightShift,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(r)));
+}
+#endif // PETE_ALLOW_SCALAR_SHIFT
+
+//! Contraction for color objects
+/*! 
+   epsilon contract 3 color primitives and return a primitive scalar.
+   Eventually, it could handle larger Nc. 
+   
+   The sources and targets must all be of the same primitive type (a matrix or vector)
+   but not necessarily of the same lattice type. In
+   explicit index form, the operation  colorContract does
+   
+   \f$target =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}* source2^{j j'}*source3^{k k'}\f$
+   or
+   \f$target =
+     \epsilon^{i j k}* source1^{i}* source2^{j}*source3^{k}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+//! Contraction for color objects
+/*! 
+   epsilon contract 3 color primitives and return a primitive scalar.
+   Eventually, it could handle larger Nc. 
+   
+   The sources and targets must all be of the same primitive type (a matrix or vector)
+   but not necessarily of the same lattice type. In
+   explicit index form, the operation  colorContract does
+   
+   \f$target =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}* source2^{j j'}*source3^{k k'}\f$
+   or
+   \f$target =
+     \epsilon^{i j k}* source1^{i}* source2^{j}*source3^{k}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+//! Contraction for color objects
+/*! 
+   epsilon contract 3 color primitives and return a primitive scalar.
+   Eventually, it could handle larger Nc. 
+   
+   The sources and targets must all be of the same primitive type (a matrix or vector)
+   but not necessarily of the same lattice type. In
+   explicit index form, the operation  colorContract does
+   
+   \f$target =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}* source2^{j j'}*source3^{k k'}\f$
+   or
+   \f$target =
+     \epsilon^{i j k}* source1^{i}* source2^{j}*source3^{k}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+//! Contraction for color objects
+/*! 
+   epsilon contract 3 color primitives and return a primitive scalar.
+   Eventually, it could handle larger Nc. 
+   
+   The sources and targets must all be of the same primitive type (a matrix or vector)
+   but not necessarily of the same lattice type. In
+   explicit index form, the operation  colorContract does
+   
+   \f$target =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}* source2^{j j'}*source3^{k k'}\f$
+   or
+   \f$target =
+     \epsilon^{i j k}* source1^{i}* source2^{j}*source3^{k}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+//! Contraction for color objects
+/*! 
+   epsilon contract 3 color primitives and return a primitive scalar.
+   Eventually, it could handle larger Nc. 
+   
+   The sources and targets must all be of the same primitive type (a matrix or vector)
+   but not necessarily of the same lattice type. In
+   explicit index form, the operation  colorContract does
+   
+   \f$target =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}* source2^{j j'}*source3^{k k'}\f$
+   or
+   \f$target =
+     \epsilon^{i j k}* source1^{i}* source2^{j}*source3^{k}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+//! Contraction for color objects
+/*! 
+   epsilon contract 3 color primitives and return a primitive scalar.
+   Eventually, it could handle larger Nc. 
+   
+   The sources and targets must all be of the same primitive type (a matrix or vector)
+   but not necessarily of the same lattice type. In
+   explicit index form, the operation  colorContract does
+   
+   \f$target =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}* source2^{j j'}*source3^{k k'}\f$
+   or
+   \f$target =
+     \epsilon^{i j k}* source1^{i}* source2^{j}*source3^{k}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+//! Contraction for color objects
+/*! 
+   epsilon contract 3 color primitives and return a primitive scalar.
+   Eventually, it could handle larger Nc. 
+   
+   The sources and targets must all be of the same primitive type (a matrix or vector)
+   but not necessarily of the same lattice type. In
+   explicit index form, the operation  colorContract does
+   
+   \f$target =
+     \epsilon^{i j k}\epsilon^{i' j' k'}* source1^{i i'}* source2^{j j'}*source3^{k k'}\f$
+   or
+   \f$target =
+     \epsilon^{i j k}* source1^{i}* source2^{j}*source3^{k}\f$
+   
+   and is (currently) only appropriate for Nc=3  (or SU(3)).
+  @ingroup group1
+  @relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
-    CreateLeaf<QDPType<T2,C2> >::make(r)));
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
-#endif // PETE_ALLOW_SCALAR_SHIFT
 
 //! Contraction for color objects
 /*! 
@@ -4791,17 +11082,41 @@ operator>>(const typename WordType<C2>::Type_t & l,const QDPType<T2,C2> & r)
   @relates QDPType */
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+//! The C ? operator
+/*! The where statement is similar to the C ? operator.
+@return (if (a) return b; else return c;)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
   typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
-  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
-colorContract(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
 {
-  typedef TrinaryNode<FnColorContract,
+  typedef TrinaryNode<FnWhere,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
     typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
-  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(a),
     CreateLeaf<QDPType<T2,C2> >::make(b),
@@ -4817,20 +11132,164 @@ template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
-  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
   typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
-where(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+where(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPSubType<T3,C3> & c)
 {
   typedef TrinaryNode<FnWhere,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+//! The C ? operator
+/*! The where statement is similar to the C ? operator.
+@return (if (a) return b; else return c;)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
     typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
   typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+//! The C ? operator
+/*! The where statement is similar to the C ? operator.
+@return (if (a) return b; else return c;)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+//! The C ? operator
+/*! The where statement is similar to the C ? operator.
+@return (if (a) return b; else return c;)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+//! The C ? operator
+/*! The where statement is similar to the C ? operator.
+@return (if (a) return b; else return c;)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
     CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+//! The C ? operator
+/*! The where statement is similar to the C ? operator.
+@return (if (a) return b; else return c;)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
+
+//! The C ? operator
+/*! The where statement is similar to the C ? operator.
+@return (if (a) return b; else return c;)
+@ingroup group1
+@relates QDPType */
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
 #ifndef PETE_EXPRESSION_OPERATORS
 #define PETE_EXPRESSION_OPERATORS
 
@@ -7254,6 +13713,25 @@ colorContract(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const typename W
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7273,6 +13751,25 @@ where(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const typename WordType<
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
 }
 
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
 template<class T1,class C1,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7292,6 +13789,25 @@ colorContract(const QDPExpr<T1,C1> & a,const typename WordType<C1>::Type_t & b,c
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7311,6 +13827,25 @@ where(const QDPExpr<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDP
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7350,18 +13885,56 @@ where(const QDPExpr<T1,C1> & a,const typename WordType<C1>::Type_t & b,const typ
 }
 
 template<class T1,class C1,class T2,class C2>
-inline typename MakeReturn<TrinaryNode<FnColorContract,
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
+}
+
+template<class T1,class C1,class T2,class C2>
+inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
-  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t >::Expression_t
-colorContract(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+  typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const typename WordType<C1>::Type_t & c)
 {
-  typedef TrinaryNode<FnColorContract,
+  typedef TrinaryNode<FnWhere,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
-  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnColorContract>::Type_t Container_t;
+  typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(a),
     CreateLeaf<QDPExpr<T2,C2> >::make(b),
@@ -7370,19 +13943,19 @@ colorContract(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const typename W
 
 template<class T1,class C1,class T2,class C2>
 inline typename MakeReturn<TrinaryNode<FnWhere,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t>,
   typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t >::Expression_t
-where(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const typename WordType<C1>::Type_t & c)
+where(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const typename WordType<C1>::Type_t & c)
 {
   typedef TrinaryNode<FnWhere,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
     typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t> Tree_t;
   typedef typename TrinaryReturn<C1,C2,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
     CreateLeaf<QDPExpr<T2,C2> >::make(b),
     CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(c))));
 }
@@ -7406,6 +13979,25 @@ colorContract(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,c
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -7425,6 +14017,25 @@ where(const QDPType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDP
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const typename WordType<C1>::Type_t & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C1>::Type_t>::Type_t(b)),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -7444,6 +14055,25 @@ colorContract(const typename WordType<C2>::Type_t & a,const QDPExpr<T2,C2> & b,c
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const typename WordType<C2>::Type_t & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -7463,6 +14093,25 @@ where(const typename WordType<C2>::Type_t & a,const QDPExpr<T2,C2> & b,const QDP
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const typename WordType<C2>::Type_t & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -7482,6 +14131,25 @@ colorContract(const typename WordType<C2>::Type_t & a,const QDPType<T2,C2> & b,c
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const typename WordType<C2>::Type_t & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -7501,6 +14169,25 @@ where(const typename WordType<C2>::Type_t & a,const QDPType<T2,C2> & b,const QDP
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const typename WordType<C2>::Type_t & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(a)),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
@@ -7639,92 +14326,320 @@ inline typename MakeReturn<BinaryNode<OpRightShift,
   typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t >::Expression_t
 operator>>(const typename WordType<C2>::Type_t & l,const QDPExpr<T2,C2> & r)
 {
-  typedef BinaryNode<OpRightShift,
-    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
-    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
-  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t Container_t;
+  typedef BinaryNode<OpRightShift,
+    typename CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t> Tree_t;
+  typedef typename BinaryReturn<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t,C2,OpRightShift>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
+    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+}
+#endif // PETE_ALLOW_SCALAR_SHIFT
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t >::make(typename SimpleScalar<typename WordType<C2>::Type_t>::Type_t(l)),
-    CreateLeaf<QDPExpr<T2,C2> >::make(r)));
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
 }
-#endif // PETE_ALLOW_SCALAR_SHIFT
 
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
-  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
   typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
   typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
-colorContract(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+colorContract(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3,C3> & c)
 {
   typedef TrinaryNode<FnColorContract,
-    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
     typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
   typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPExpr<T1,C1> >::make(a),
-    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
-  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
   typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
   typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
-where(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPType<T3,C3> & c)
+where(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3,C3> & c)
 {
   typedef TrinaryNode<FnWhere,
-    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
-    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
     typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
   typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPExpr<T1,C1> >::make(a),
-    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
 template<class T1,class C1,class T2,class C2,class T3,class C3>
-inline typename MakeReturn<TrinaryNode<FnColorContract,
+inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
-  typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
-  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
-colorContract(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3,C3> & c)
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
 {
-  typedef TrinaryNode<FnColorContract,
+  typedef TrinaryNode<FnWhere,
     typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
-    typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
-  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     CreateLeaf<QDPType<T1,C1> >::make(a),
     CreateLeaf<QDPExpr<T2,C2> >::make(b),
-    CreateLeaf<QDPType<T3,C3> >::make(c)));
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
 }
 
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
-  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
   typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
   typename CreateLeaf<QDPType<T3,C3> >::Leaf_t>,
   typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
-where(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3,C3> & c)
+where(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3,C3> & c)
 {
   typedef TrinaryNode<FnWhere,
-    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
     typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
     typename CreateLeaf<QDPType<T3,C3> >::Leaf_t> Tree_t;
   typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
-    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
     CreateLeaf<QDPExpr<T2,C2> >::make(b),
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -7744,6 +14659,63 @@ colorContract(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPExpr<T3
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -7763,6 +14735,63 @@ where(const QDPType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPExpr<T3,C3> & c
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7782,6 +14811,25 @@ colorContract(const QDPExpr<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7801,6 +14849,25 @@ where(const QDPExpr<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPType<T3,C3> & c
     CreateLeaf<QDPType<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPSubType<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPSubType<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -7820,6 +14887,25 @@ colorContract(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPExpr<T3
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPType<T1,C1> >::Leaf_t,
@@ -7839,6 +14925,25 @@ where(const QDPType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPExpr<T3,C3> & c
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPSubType<T1,C1> & a,const QDPExpr<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPSubType<T1,C1> >::make(a),
+    CreateLeaf<QDPExpr<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnColorContract,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7858,6 +14963,25 @@ colorContract(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPExpr<T3
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
 
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnColorContract,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t >::Expression_t
+colorContract(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnColorContract,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnColorContract>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
+
 template<class T1,class C1,class T2,class C2,class T3,class C3>
 inline typename MakeReturn<TrinaryNode<FnWhere,
   typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
@@ -7876,6 +15000,25 @@ where(const QDPExpr<T1,C1> & a,const QDPType<T2,C2> & b,const QDPExpr<T3,C3> & c
     CreateLeaf<QDPType<T2,C2> >::make(b),
     CreateLeaf<QDPExpr<T3,C3> >::make(c)));
 }
+
+template<class T1,class C1,class T2,class C2,class T3,class C3>
+inline typename MakeReturn<TrinaryNode<FnWhere,
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+  typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+  typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t>,
+  typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t >::Expression_t
+where(const QDPExpr<T1,C1> & a,const QDPSubType<T2,C2> & b,const QDPExpr<T3,C3> & c)
+{
+  typedef TrinaryNode<FnWhere,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t,
+    typename CreateLeaf<QDPSubType<T2,C2> >::Leaf_t,
+    typename CreateLeaf<QDPExpr<T3,C3> >::Leaf_t> Tree_t;
+  typedef typename TrinaryReturn<C1,C2,C3,FnWhere>::Type_t Container_t;
+  return MakeReturn<Tree_t,Container_t>::make(Tree_t(
+    CreateLeaf<QDPExpr<T1,C1> >::make(a),
+    CreateLeaf<QDPSubType<T2,C2> >::make(b),
+    CreateLeaf<QDPExpr<T3,C3> >::make(c)));
+}
 #endif  // PETE_EXPRESSION_OPERATORS
 
 #endif // QDPOPS_H
@@ -50,6 +50,7 @@
 // gcc
 #define QDP_ALIGN8   __attribute__ ((aligned (8)))
 #define QDP_ALIGN16  __attribute__ ((aligned (16)))
+#define QDP_ALIGN(n) __attribute__ ((aligned (n)))
 #define QDP_INLINE   __attribute__ ((always_inline))
 // The attributes in QDP_CONST is buggering g++-3.4 
 //#define QDP_CONST    __attribute__ ((const,pure))
@@ -59,6 +60,7 @@
 // default
 #define QDP_ALIGN8
 #define QDP_ALIGN16
+#define QDP_ALIGN(n)
 #define QDP_INLINE
 #define QDP_CONST
 #define QDP_CINLINE
@@ -82,11 +84,19 @@
 #define QDP_ALIGNMENT_SIZE 16
 #endif
 
+// Sites per block of a structure of arrays lattice copy
+#ifdef QDP_AC_SOA_LENGTH
+#define QDP_SOA_LENGTH QDP_AC_SOA_LENGTH
+#else
+#define QDP_SOA_LENGTH 8
+#endif
+
 // YUKKY - Eventually get rid of these includes
 #include <cstdio>
 #include <cstdlib>
 #include <ostream>
 #include <iostream>
+#include <array>
 
 #if 0
 // NOTE: having this off will probably break a bunch of old code.
@@ -104,12 +114,15 @@ namespace QDP {
 }
 
 #include "qdp_init.h"
+#include "qdp_ensemble.h"
 #include "qdp_forward.h"
+#include "qdp_halfword.h"
 #include "qdp_multi.h"
 #include "qdp_arrays.h"
 
 #include "qdp_params.h"
 #include "qdp_layout.h"
+#include "qdp_numformat.h"
 #include "qdp_io.h"
 #include "qdp_stdio.h"
 
@@ -128,6 +141,8 @@ QDPXX_MESSAGE("not using hdf5")
 
 #include "qdp_subset.h"
 #include "qdp_map.h"
+#include "qdp_table_cache.h"
+#include "qdp_lattice_layout.h"
 #include "qdp_stopwatch.h"
 
 #include "qdp_traits.h"
@@ -145,6 +160,7 @@ namespace QDP {
 #include "qdp_newops.h"
 #include "qdp_optops.h"
 #include "qdp_profile.h"
+#include "qdp_comm_stats.h"
 //#include "qdp_word.h"
 #include "qdp_simpleword.h"
 #include "qdp_reality.h"
@@ -160,9 +176,17 @@ namespace QDP {
 
 //#include "qdp_special.h"
 #include "qdp_random.h"
+#include "qdp_noise.h"
 
 // Include threading code here if applicable
+#include "qdp_thread_report.h"
 #include "qdp_dispatch.h"
+#include "qdp_autotune.h"
+#include "qdp_hardware_probe.h"
+#include "qdp_partition.h"
+#include "qdp_sitecopy.h"
+#include "qdp_offload.h"
+#include "qdp_kernel_select.h"
 
 namespace ThreadReductions { 
  
@@ -218,6 +242,8 @@ QDPXX_MESSAGE("Using scalar architecture with vector extensions")
 // Include optimized code here if applicable
 #if QDP_USE_SSE == 1
 #include "qdp_scalarvecsite_sse.h"
+#else
+#include "qdp_scalarvecsite_simd.h"
 #endif
 
 #elif defined(ARCH_PARSCALARVEC)
@@ -229,6 +255,8 @@ QDPXX_MESSAGE("Using parallel scalar architecture with vector extensions")
 // Include optimized code here if applicable
 #if QDP_USE_SSE == 1
 #include "qdp_scalarvecsite_sse.h"
+#else
+#include "qdp_scalarvecsite_simd.h"
 #endif
 
 #else
@@ -237,5 +265,45 @@ QDPXX_MESSAGE("Using parallel scalar architecture with vector extensions")
 
 #include "qdp_flopcount.h"
 #include "qdp_globalfuncs_subtype.h"
+#include "qdp_multireduction.h"
+#include "qdp_soa.h"
+#include "qdp_async_io.h"
+#include "qdp_subvolume_io.h"
+#include "qdp_derived_cache.h"
+
+#if defined(ARCH_SCALAR) || defined(ARCH_PARSCALAR)
+#include "qdp_wilson_hop.h"
+#include "qdp_compressed_link.h"
+#include "qdp_su3_kernels.h"
+#include "qdp_small_matrix.h"
+#include "qdp_clover_term.h"
+#include "qdp_packed_gauge.h"
+#include "qdp_multirhs.h"
+#include "qdp_block_inner.h"
+#include "qdp_mixed_blas.h"
+#include "qdp_multishift_blas.h"
+#include "qdp_staggered.h"
+#include "qdp_deferred.h"
+#include "qdp_async.h"
+#include "qdp_partfile.h"
+#include "qdp_contract.h"
+#include "qdp_elementals.h"
+#include "qdp_field_view.h"
+#include "qdp_sparse_field.h"
+#include "qdp_replicated.h"
+#include "qdp_fft.h"
+#include "qdp_gauge_loops.h"
+#include "qdp_link_smearing.h"
+#include "qdp_wilson_lines.h"
+#include "qdp_gauge_transform.h"
+#include "qdp_aggregate.h"
+#include "qdp_latticemask.h"
+#include "qdp_site_export.h"
+#include "qdp_spin_color_order.h"
+#include "qdp_checksum.h"
+#include "qdp_halo.h"
+#include "qdp_neighbour_table.h"
+#include "qdp_smearing.h"
+#endif
 
 #endif  // QDP_INCLUDE
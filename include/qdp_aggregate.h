@@ -0,0 +1,288 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Block restriction and prolongation for multigrid
+ */
+
+#ifndef QDP_AGGREGATE_H
+#define QDP_AGGREGATE_H
+
+#include <cmath>
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! The lattice cut into equal rectangular blocks, the aggregates of a coarse grid
+  /*!
+   * Block b of this node is a coarse site. Its fine sites are
+   * sites(b)[0] ... sites(b)[blockVolume()-1], node linear indices in
+   * increasing order, and block(i) is the block of fine site i. Every
+   * block lies on one node, so the block extents must divide the subgrid
+   * extents. Blocks are numbered lexicographically in the coarse
+   * coordinates of the node, direction 0 fastest.
+   *
+   * The tables are made once, by the constructor, and all of the
+   * functions below read them: none makes a Set or a temporary field.
+   */
+  class BlockAggregation
+  {
+  public:
+    //! Blocks of extent block[mu] in direction mu
+    explicit BlockAggregation(const multi1d<int>& block);
+
+    //! Extents of a block
+    const multi1d<int>& blockSize() const {return bsize;}
+
+    //! Extents of the coarse lattice
+    const multi1d<int>& coarseLattSize() const {return csize;}
+
+    //! Number of blocks on this node
+    int numBlocks() const {return nblocks;}
+
+    //! Number of fine sites in a block
+    int blockVolume() const {return bvol;}
+
+    //! Block of the fine site with node linear index i
+    int block(int i) const {return blk[i];}
+
+    //! Fine sites of block b
+    const int* sites(int b) const {return &fine[b*bvol];}
+
+    //! Coarse lattice coordinate of block b
+    multi1d<int> coarseCoord(int b) const;
+
+  private:
+    multi1d<int> bsize;
+    multi1d<int> csize;
+    multi1d<int> local_csize;
+    int nblocks;
+    int bvol;
+    std::vector<int> blk;
+    std::vector<int> fine;
+  };
+
+
+  namespace AggregateInternal
+  {
+    //! user argument for the block kernels
+    template<class T>
+    struct Args
+    {
+      Args(const BlockAggregation* agg_, int n_, T* v_, T* x_, RComplex<REAL64>* c_) :
+	agg(agg_), n(n_), v(v_), x(x_), c(c_) {}
+
+      const BlockAggregation* agg;
+      int n;
+      T* v;
+      T* x;
+      RComplex<REAL64>* c;
+    };
+
+    //! c(b,k) = sum over block b of <v_k, x>
+    template<class T>
+    void restrictKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int n = a->n;
+	const int np = BlockKernels::pairs<T>();
+	const int bvol = a->agg->blockVolume();
+	for(int b=lo; b < hi; ++b)
+	{
+	  RComplex<REAL64>* cb = a->c + b*n;
+	  for(int k=0; k < n; ++k)
+	    cb[k] = RComplex<REAL64>(0, 0);
+
+	  const int* sites = a->agg->sites(b);
+	  for(int s=0; s < bvol; ++s)
+	  {
+	    const int i = sites[s];
+	    const W* xp = (const W*)&a->x[i];
+	    for(int k=0; k < n; ++k)
+	    {
+	      const W* vp = (const W*)&a->v[i*n+k];
+	      REAL64 sr = 0, si = 0;
+	      for(int p=0; p < np; ++p)
+	      {
+		const REAL64 vr = vp[2*p], vi = vp[2*p+1];
+		const REAL64 xr = xp[2*p], xi = xp[2*p+1];
+		sr += vr*xr + vi*xi;
+		si += vr*xi - vi*xr;
+	      }
+	      cb[k].real() += sr;
+	      cb[k].imag() += si;
+	    }
+	  }
+	}
+      }
+
+    //! x = sum over k of c(b,k) v_k on each block b
+    template<class T>
+    void prolongKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int n = a->n;
+	const int np = BlockKernels::pairs<T>();
+	const int bvol = a->agg->blockVolume();
+	for(int b=lo; b < hi; ++b)
+	{
+	  const RComplex<REAL64>* cb = a->c + b*n;
+	  const int* sites = a->agg->sites(b);
+	  for(int s=0; s < bvol; ++s)
+	  {
+	    const int i = sites[s];
+	    W* xp = (W*)&a->x[i];
+	    for(int p=0; p < 2*np; ++p)
+	      xp[p] = 0;
+
+	    for(int k=0; k < n; ++k)
+	    {
+	      const W cr = cb[k].real(), ci = cb[k].imag();
+	      const W* vp = (const W*)&a->v[i*n+k];
+	      for(int p=0; p < np; ++p)
+	      {
+		const W vr = vp[2*p], vi = vp[2*p+1];
+		xp[2*p]   += cr*vr - ci*vi;
+		xp[2*p+1] += cr*vi + ci*vr;
+	      }
+	    }
+	  }
+	}
+      }
+
+    //! Modified Gram-Schmidt of v_0 ... v_{n-1} on each block
+    template<class T>
+    void orthonormalizeKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int n = a->n;
+	const int np = BlockKernels::pairs<T>();
+	const int bvol = a->agg->blockVolume();
+	for(int b=lo; b < hi; ++b)
+	{
+	  const int* sites = a->agg->sites(b);
+	  for(int k=0; k < n; ++k)
+	  {
+	    for(int j=0; j < k; ++j)
+	    {
+	      // <v_j, v_k> on the block, then v_k -= <v_j, v_k> v_j
+	      REAL64 sr = 0, si = 0;
+	      for(int s=0; s < bvol; ++s)
+	      {
+		const int i = sites[s];
+		const W* jp = (const W*)&a->v[i*n+j];
+		const W* kp = (const W*)&a->v[i*n+k];
+		for(int p=0; p < np; ++p)
+		{
+		  const REAL64 jr = jp[2*p], ji = jp[2*p+1];
+		  const REAL64 kr = kp[2*p], ki = kp[2*p+1];
+		  sr += jr*kr + ji*ki;
+		  si += jr*ki - ji*kr;
+		}
+	      }
+
+	      const W cr = sr, ci = si;
+	      for(int s=0; s < bvol; ++s)
+	      {
+		const int i = sites[s];
+		const W* jp = (const W*)&a->v[i*n+j];
+		W* kp = (W*)&a->v[i*n+k];
+		for(int p=0; p < np; ++p)
+		{
+		  const W jr = jp[2*p], ji = jp[2*p+1];
+		  kp[2*p]   -= cr*jr - ci*ji;
+		  kp[2*p+1] -= cr*ji + ci*jr;
+		}
+	      }
+	    }
+
+	    REAL64 nn = 0;
+	    for(int s=0; s < bvol; ++s)
+	    {
+	      const W* kp = (const W*)&a->v[sites[s]*n+k];
+	      for(int p=0; p < 2*np; ++p)
+		nn += REAL64(kp[p])*REAL64(kp[p]);
+	    }
+
+	    // A vector that vanishes on the block is left as zero there
+	    const W scale = (nn > 0) ? W(1/std::sqrt(nn)) : W(0);
+	    for(int s=0; s < bvol; ++s)
+	    {
+	      W* kp = (W*)&a->v[sites[s]*n+k];
+	      for(int p=0; p < 2*np; ++p)
+		kp[p] *= scale;
+	    }
+	  }
+	}
+      }
+
+    //! Check c has a row for every block and a column for every vector
+    inline void checkCoarse(multi2d<DComplex>& c, const BlockAggregation& agg, int n, bool resize)
+      {
+	if (resize)
+	  c.resize(agg.numBlocks(), n);
+	else if (c.size2() != agg.numBlocks() || c.size1() != n)
+	  QDP_error_exit("blockProlong: coarse vector is %d x %d, need %d blocks x %d vectors",
+			 c.size2(), c.size1(), agg.numBlocks(), n);
+      }
+
+    //! The complex numbers of c, which are stored one after the other
+    inline RComplex<REAL64>* coarseData(multi2d<DComplex>& c)
+      {
+	return &c(0,0).elem().elem().elem();
+      }
+  }
+
+
+  //! Restrict x to the coarse grid: c(b,k) = <v_k, x> summed over block b
+  /*!
+   * All n vectors of the block v are done in one threaded sweep, each
+   * thread taking whole blocks, with the sums kept in REAL64. Blocks are
+   * on one node, so there is no communication. c is resized to
+   * agg.numBlocks() x v.numRHS().
+   */
+  template<class T>
+  void blockRestrict(multi2d<DComplex>& c, const LatticeBlock<T>& v, const OLattice<T>& x,
+		     const BlockAggregation& agg)
+  {
+    AggregateInternal::checkCoarse(c, agg, v.numRHS(), true);
+    AggregateInternal::Args<T> a(&agg, v.numRHS(), const_cast<T*>(v.getF()),
+				 const_cast<T*>(x.getF()), AggregateInternal::coarseData(c));
+    dispatch_to_threads(agg.numBlocks(), a, AggregateInternal::restrictKernel<T>);
+  }
+
+  //! Prolong c to the fine grid: x = sum over k of c(b,k) v_k on each block b
+  /*! c must be agg.numBlocks() x v.numRHS(). Every site of x is set. */
+  template<class T>
+  void blockProlong(OLattice<T>& x, const LatticeBlock<T>& v, const multi2d<DComplex>& c,
+		    const BlockAggregation& agg)
+  {
+    multi2d<DComplex>& cc = const_cast<multi2d<DComplex>&>(c);
+    AggregateInternal::checkCoarse(cc, agg, v.numRHS(), false);
+    AggregateInternal::Args<T> a(&agg, v.numRHS(), const_cast<T*>(v.getF()),
+				 x.getF(), AggregateInternal::coarseData(cc));
+    dispatch_to_threads(agg.numBlocks(), a, AggregateInternal::prolongKernel<T>);
+  }
+
+  //! Orthonormalize the vectors of v on every block
+  /*!
+   * Modified Gram-Schmidt in the order v_0, v_1, ..., with the inner
+   * products in REAL64. Afterwards the block restriction of the
+   * prolongation of c is c again.
+   */
+  template<class T>
+  void blockOrthonormalize(LatticeBlock<T>& v, const BlockAggregation& agg)
+  {
+    AggregateInternal::Args<T> a(&agg, v.numRHS(), v.getF(), 0, 0);
+    dispatch_to_threads(agg.numBlocks(), a, AggregateInternal::orthonormalizeKernel<T>);
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
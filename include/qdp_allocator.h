@@ -9,6 +9,7 @@
 
 #include "qdp_config.h"
 #include "qdp_singleton.h"
+#include "qdp_allocator_stats.h"
 /*! QDP Allocator
  *  A raw memory allocator for QDP, for particular use 
  *  with OLattice Objects. The pointers returned by allocate
@@ -22,7 +23,218 @@ namespace QDP
   namespace Allocator 
   {
 
-    enum MemoryPoolHint { DEFAULT, FAST };
+    //! NUMA_LOCAL asks for the pages of each thread's sites on its own node
+    enum MemoryPoolHint { DEFAULT, FAST, NUMA_LOCAL };
+
+    //! How fresh OLattice storage is placed in memory
+    /*!
+     * PLACE_LAZY leaves placement to whoever writes a page first.
+     * PLACE_FIRST_TOUCH lets every thread touch the pages of the sites it
+     * gets in evaluate, so under Linux first-touch they land on its node.
+     * PLACE_BIND also binds those pages to the node of that thread and
+     * moves any already there, which stays right for recycled memory.
+     */
+    enum LatticePlacement { PLACE_LAZY, PLACE_FIRST_TOUCH, PLACE_BIND };
+
+    //! Set the placement used by OLattice allocations
+    void setLatticePlacement(LatticePlacement p);
+
+    //! The placement used by OLattice allocations
+    LatticePlacement getLatticePlacement();
+
+    //! Let copies of an OLattice share its sites until one is written
+    /*!
+     * Off by default. When on, the OLattice copy constructor hands out the
+     * same sites with a count of their holders, and the first write to
+     * either side - through evaluate or any function filling the field -
+     * copies them. Fields passed by value or returned as copies that are
+     * only read then cost nothing.
+     */
+    void setLatticeCopyOnWrite(bool on);
+
+    //! Do copies of an OLattice share their sites
+    bool latticeCopyOnWrite();
+
+    //! Pages backing a preallocated memory pool
+    /*!
+     * POOL_PAGES_THP asks for transparent huge pages with madvise. The
+     * HUGE_ modes map explicit hugetlbfs pages of that size, which must
+     * have been reserved by the administrator. The pool falls back
+     * towards POOL_PAGES_DEFAULT when a mode is not available and
+     * reports what it got.
+     */
+    enum PoolPages { POOL_PAGES_DEFAULT, POOL_PAGES_THP, POOL_PAGES_HUGE_2M, POOL_PAGES_HUGE_1G };
+
+    //! Set the pages used when the pool is created
+    void setPoolPages(PoolPages p);
+
+    //! The pages used when the pool is created
+    PoolPages getPoolPages();
+
+    //! Least bytes the pool maps more of when it is full
+    /*!
+     * The pool of -poolsize is the first arena; when neither it nor the
+     * arenas added so far have room, another of at least this size is
+     * mapped. Grown arenas that empty go back to the OS. 0 keeps the
+     * pool fixed and a full pool aborts.
+     */
+    void setPoolGrowth(size_t bytes);
+
+    //! The growth step of the pool
+    size_t getPoolGrowth();
+
+    //! Give allocations hinted FAST the memory of a faster tier
+    /*!
+     * numa_node is the NUMA node of the fast memory, as the HBM or a
+     * CXL tier shows up under Linux, or -1 for the high bandwidth memory
+     * of memkind when built --with-memkind. At most limit_bytes are
+     * placed there, 0 for no limit; beyond that, or when the tier is
+     * full, FAST allocations get normal memory. Without a call the hint
+     * is ignored.
+     */
+    void setFastMemory(int numa_node, size_t limit_bytes = 0);
+
+    //! Is there a fast tier for the FAST hint
+    bool fastMemory();
+
+    //! bytes of the fast tier, or null if it has no room
+    /*! Used by the allocators for the FAST hint */
+    void* fastAllocate(size_t bytes);
+
+    //! Give back p of bytes bytes from fastAllocate
+    void fastFree(void* p, size_t bytes);
+
+    //! The hint OLattice allocations of this thread pass
+    MemoryPoolHint latticeHint();
+
+    //! Lattice fields made on this thread while alive are hinted FAST
+    /*!
+     * For the fields of a hot region, say the vectors of a solver:
+     *
+     *   {
+     *     Allocator::FastMemoryScope fast;
+     *     multi1d<LatticeFermion> p(n);   // in the fast tier if there is room
+     *     ...
+     *   }
+     *
+     * Existing fields, the gauge links say, are moved with
+     * Hints::moveToFastMemoryHint. Scopes nest.
+     */
+    class FastMemoryScope
+    {
+    public:
+      FastMemoryScope();
+      ~FastMemoryScope();
+
+    private:
+      //! Hide copies
+      FastMemoryScope(const FastMemoryScope&);
+      void operator=(const FastMemoryScope&);
+
+      MemoryPoolHint prev;
+    };
+
+    //! Place nsites sites of site_bytes each starting at mem
+    /*!
+     * The sites are split across threads as in dispatch_to_threads over
+     * the whole lattice. Does nothing for PLACE_LAZY unless the hint is
+     * NUMA_LOCAL.
+     */
+    void placeLatticeMem(void* mem, size_t site_bytes, size_t nsites, MemoryPoolHint hint);
+
+    //! Bump arena for the lattice temporaries of a code region
+    /*!
+     * While a scope is alive, OLattice storage allocated on this thread
+     * is carved from one block taken from the QDP allocator when the
+     * scope was made, at the cost of a pointer bump. Freeing the most
+     * recent pieces hands their space back, so the temporaries of each
+     * call in a loop reuse the same memory. When the block is full the
+     * normal allocator is used instead. Scopes nest and the innermost
+     * one is used.
+     *
+     *   {
+     *     Allocator::ArenaScope arena(8*Layout::sitesOnNode()*sizeof(Fermion));
+     *     chi = D(psi);      // temporaries inside come from the arena
+     *   }
+     *
+     * Every lattice object using the arena must be gone before the
+     * scope ends, otherwise QDP aborts.
+     */
+    class ArenaScope
+    {
+    public:
+      //! Take an arena of the given size from the QDP allocator
+      explicit ArenaScope(size_t bytes);
+
+      //! Give the arena back
+      ~ArenaScope();
+
+      //! Bytes in the arena
+      size_t size() const {return end - base;}
+
+      //! Most bytes in use at any time
+      size_t highWater() const {return peak - base;}
+
+      //! Allocations that did not fit and went to the normal allocator
+      int fallbacks() const {return misses;}
+
+    private:
+      //! Hide copies
+      ArenaScope(const ArenaScope&);
+      void operator=(const ArenaScope&);
+
+      friend void* arenaAllocate(size_t bytes);
+      friend bool arenaFree(void* p);
+
+      //! In-band header in front of each piece
+      struct Piece
+      {
+	Piece* prev;       // the piece below this one
+	bool live;
+      };
+
+      unsigned char* base;
+      unsigned char* top;
+      unsigned char* end;
+      unsigned char* peak;
+      Piece* last;         // most recent piece still holding space
+      int live;
+      int misses;
+      ArenaScope* outer;
+    };
+
+    //! Storage from the innermost arena scope of this thread, null if none fits
+    void* arenaAllocate(size_t bytes);
+
+    //! Release p if it came from an arena scope of this thread
+    /*! Returns false, and does nothing, for memory from elsewhere */
+    bool arenaFree(void* p);
+
+    //! Slots of scratch space each thread has
+    enum {NumScratchSlots = 4};
+
+    //! Scratch space of bytes bytes for the calling thread
+    /*!
+     * Each thread keeps a block per slot for as long as it lives and only
+     * grows it when asked for more, so a kernel run over and over by the
+     * persistent threads takes its temporaries without going to the heap.
+     * The blocks are aligned to QDP_ALIGNMENT_SIZE and first written by
+     * their thread, so a bound thread gets pages on its own NUMA node.
+     * The contents last until the next call for the same slot on the
+     * same thread, so the temporaries of one kernel take distinct slots:
+     *
+     *   REAL64* re = Allocator::threadScratch<REAL64>(n, 0);
+     *   REAL64* im = Allocator::threadScratch<REAL64>(n, 1);
+     */
+    void* threadScratchBytes(size_t bytes, int slot = 0);
+
+    //! Scratch space for n objects of type T, see threadScratchBytes
+    /*! The objects are not constructed; T should be a plain word or struct of words */
+    template<class T>
+    inline T* threadScratch(size_t n, int slot = 0)
+    {
+      return (T*)threadScratchBytes(n*sizeof(T), slot);
+    }
 
   } // namespace Allocator
 
@@ -0,0 +1,121 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Statistics kept by the lattice memory allocators
+ */
+
+#ifndef QDP_ALLOCATOR_STATS
+#define QDP_ALLOCATOR_STATS
+
+#include <cstddef>
+
+namespace QDP
+{
+  namespace Allocator
+  {
+
+    //! Counts for the allocations of one size class
+    /*! Class k holds requests of [2^k, 2^(k+1)) bytes, class 0 also 0 bytes */
+    struct SizeClassStats
+    {
+      size_t allocs;      // allocations made
+      size_t live;        // blocks not yet freed
+    };
+
+    //! Counts for the allocations made under one pushFunc tag
+    struct TagStats
+    {
+      const char* tag;    // the func given to pushFunc
+      size_t allocs;      // allocations made
+      size_t bytes;       // bytes requested by them
+    };
+
+    //! Allocation statistics of this node
+    /*!
+     * Bytes are the sizes requested by the callers, without the alignment
+     * padding and headers the allocators add.
+     */
+    struct AllocStats
+    {
+      enum { NumSizeClasses = 48, MaxTags = 64 };
+
+      size_t current_bytes;
+      size_t peak_bytes;
+      size_t live_objects;
+      size_t peak_objects;
+      size_t allocs;
+      size_t frees;
+      size_t failures;              // allocations the allocator could not satisfy
+      size_t failed_bytes;          // size of the last one
+
+      //! The fast tier of setFastMemory, in the bytes it maps
+      size_t fast_current_bytes;
+      size_t fast_peak_bytes;
+      size_t fast_allocs;           // FAST allocations placed in the tier
+      size_t fast_fallbacks;        // FAST allocations given normal memory
+
+      //! Arenas of the pool allocator, see setPoolGrowth
+      size_t pool_arenas;
+      size_t pool_bytes;            // mapped by them
+      size_t pool_peak_bytes;
+
+      SizeClassStats size_class[NumSizeClasses];
+
+      //! Tags in order of first use - the last one collects any overflow
+      int num_tags;
+      TagStats tags[MaxTags];
+    };
+
+    //! The statistics so far
+    const AllocStats& getAllocStats();
+
+    //! Start a new high-water mark from the current usage
+    void resetAllocPeak();
+
+    //! Print the statistics of the primary node
+    void printAllocStats();
+
+    //! Print the statistics from QDP_finalize
+    void setAllocStatsAtFinalize(bool p);
+
+    //! Will QDP_finalize print the statistics
+    bool allocStatsAtFinalize();
+
+    //! Record every OLattice allocation with its reason and caller
+    /*!
+     * The reason is the one alloc_mem is given - "construct from expr",
+     * "copy", ... - and the caller the innermost pushFunc tag, or
+     * without one a hash of the call stack, shown by its frames. This
+     * shows which code makes hidden temporaries. Costs a backtrace per
+     * allocation while on.
+     */
+    void setLatticeTrace(bool on);
+
+    //! Are OLattice allocations recorded
+    bool latticeTrace();
+
+    //! Print the allocations recorded, by reason and caller, on the primary node
+    void printLatticeTrace();
+
+    //! Hooks for the allocators
+    namespace Stats
+    {
+      //! An OLattice allocation of bytes, site_bytes a site, for reason
+      void noteLattice(const char* reason, size_t bytes, size_t site_bytes);
+
+      void noteAlloc(size_t bytes);
+      void noteFree(size_t bytes);
+      void noteFailure(size_t bytes);
+      void noteFastAlloc(size_t bytes);
+      void noteFastFree(size_t bytes);
+      void noteFastFallback(size_t bytes);
+      void notePoolArena(size_t bytes);
+      void notePoolArenaFree(size_t bytes);
+      void pushTag(const char* tag);
+      void popTag();
+    }
+
+  } // namespace Allocator
+} // namespace QDP
+
+#endif
@@ -0,0 +1,391 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Independent lattice statements, sums and I/O run as tasks
+ */
+
+#ifndef QDP_ASYNC_H
+#define QDP_ASYNC_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  class AsyncScope;
+
+  namespace AsyncInternal
+  {
+    //! Whether a task has run, and its result
+    struct State
+    {
+      State() : done(false), scope(0) {}
+      virtual ~State() {}
+
+      bool done;
+      AsyncScope* scope;    // the scope to run to get done, null once it went
+    };
+
+    template<class T>
+    struct Value : public State
+    {
+      T value;
+    };
+  }
+
+
+  //! Handle on a task recorded in an AsyncScope
+  class AsyncTask
+  {
+  public:
+    AsyncTask() {}
+
+    //! Has the task run
+    bool done() const {return ! st || st->done;}
+
+    //! Run the scope of the task until it has. Collective
+    inline void wait() const;
+
+  protected:
+    explicit AsyncTask(const std::shared_ptr<AsyncInternal::State>& s) : st(s) {}
+
+    std::shared_ptr<AsyncInternal::State> st;
+
+    friend class AsyncScope;
+  };
+
+
+  //! Handle on a sum recorded in an AsyncScope
+  template<class T>
+  class Future : public AsyncTask
+  {
+  public:
+    Future() {}
+
+    //! The sum, running the scope first if needed. Collective
+    const T& get() const
+      {
+	wait();
+	return static_cast<AsyncInternal::Value<T>&>(*st).value;
+      }
+
+  private:
+    explicit Future(const std::shared_ptr<AsyncInternal::Value<T> >& s) : AsyncTask(s) {}
+
+    friend class AsyncScope;
+  };
+
+
+  //! The fields and other objects a task reads or writes
+  /*! AsyncFields().on(u[mu]).on(&buffer) */
+  class AsyncFields
+  {
+  public:
+    //! The sites of f
+    template<class T>
+    AsyncFields& on(const OLattice<T>& f) {ptrs.push_back(f.getF()); return *this;}
+
+    //! Any other object, by its address
+    AsyncFields& on(const void* p) {ptrs.push_back(p); return *this;}
+
+    const std::vector<const void*>& list() const {return ptrs;}
+
+  private:
+    std::vector<const void*> ptrs;
+  };
+
+
+  //! Statements, sums and I/O recorded with what they read and write, run wave by wave
+  /*!
+   * Statements of a program that do not touch each other's fields are
+   * still run one after another: the staples of the planes, two sums of
+   * different fields, reading a record while contracting the last. Here
+   * they are recorded as tasks, and wait() runs them in waves: a task
+   * goes in the wave after the last task it depends on, one that writes
+   * what it reads, reads what it writes or writes the same. In a wave:
+   *
+   *  - the io() tasks run on a helper thread beside everything else,
+   *  - the statements and call() tasks run in the order recorded, each
+   *    over all the threads,
+   *  - the sums are made on the node and then added over the nodes all
+   *    in one global sum.
+   *
+   *   AsyncScope tasks;
+   *   tasks.io([&]() { readRecord(next, buf); }, AsyncFields(), AsyncFields().on(buf));
+   *   for(int nu=0; nu < Nd; ++nu)
+   *     tasks.assign(staple[nu], u[nu]*shift(u[mu],FORWARD,nu)*adj(shift(u[nu],FORWARD,mu)));
+   *   Future<Double> r2 = tasks.norm2(r);
+   *   Future<DComplex> pr = tasks.innerProduct(p, r);
+   *   tasks.wait();                    // or r2.get(), or the end of the scope
+   *
+   * The fields are told apart by their sites, as seen when the task is
+   * recorded. The fields, expressions and objects of a task must live
+   * until it has run. Every node must record the same tasks, since the
+   * statements and sums communicate. io() tasks run beside the others
+   * and so must not communicate, or call QDP functions that do: put the
+   * bytes of a record into memory there and do the collective part in a
+   * call() task after it.
+   */
+  class AsyncScope
+  {
+  public:
+    AsyncScope() {}
+
+    //! Runs what is left
+    ~AsyncScope() {wait();}
+
+    //! Record dest op= rhs on the sites of s
+    template<class T, class Op, class RHS, class T1>
+    AsyncTask evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
+		       const Subset& s = all)
+      {
+	return add(new EvalTask<T,Op,RHS,T1>(dest, op, rhs, s));
+      }
+
+    //! Record dest = rhs on the sites of s
+    template<class T, class RHS, class T1>
+    AsyncTask assign(OLattice<T>& dest, const QDPExpr<RHS,OLattice<T1> >& rhs, const Subset& s = all)
+      {
+	return evaluate(dest, OpAssign(), rhs, s);
+      }
+
+    //! Record dest = l on the sites of s
+    template<class T, class T1>
+    AsyncTask assign(OLattice<T>& dest, const OLattice<T1>& l, const Subset& s = all)
+      {
+	return evaluate(dest, OpAssign(), PETE_identity(l), s);
+      }
+
+    //! Record dest = shift(l, isign, dir) on the sites of s
+    template<class T>
+    AsyncTask shift(OLattice<T>& dest, const OLattice<T>& l, int isign, int dir, const Subset& s = all)
+      {
+	return evaluate(dest, OpAssign(), QDP::shift(l, isign, dir), s);
+      }
+
+    //! Record sum(expr) over the sites of s
+    template<class RHS, class T>
+    Future<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>
+    sum(const QDPExpr<RHS,OLattice<T> >& expr, const Subset& s = all)
+      {
+	typedef typename UnaryReturn<OLattice<T>, FnSum>::Type_t Sum_t;
+	SumTask<RHS,T>* t = new SumTask<RHS,T>(expr, s);
+	add(t);
+	return Future<Sum_t>(t->result);
+      }
+
+    //! Record sum(l) over the sites of s
+    template<class T>
+    Future<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>
+    sum(const OLattice<T>& l, const Subset& s = all)
+      {
+	return sum(PETE_identity(l), s);
+      }
+
+    //! Record norm2(x) over the sites of s
+    template<class X>
+    auto norm2(const X& x, const Subset& s = all) -> decltype(this->sum(localNorm2(x), s))
+      {
+	return sum(localNorm2(x), s);
+      }
+
+    //! Record innerProduct(x,y) over the sites of s
+    template<class X, class Y>
+    auto innerProduct(const X& x, const Y& y, const Subset& s = all)
+      -> decltype(this->sum(localInnerProduct(x,y), s))
+      {
+	return sum(localInnerProduct(x,y), s);
+      }
+
+    //! Record innerProductReal(x,y) over the sites of s
+    template<class X, class Y>
+    auto innerProductReal(const X& x, const Y& y, const Subset& s = all)
+      -> decltype(this->sum(localInnerProductReal(x,y), s))
+      {
+	return sum(localInnerProductReal(x,y), s);
+      }
+
+    //! Record fn, run on this thread in its turn
+    /*! It may communicate, like any QDP statement */
+    AsyncTask call(const std::function<void()>& fn, const AsyncFields& reads, const AsyncFields& writes)
+      {
+	return add(new FnTask(fn, reads, writes, false));
+      }
+
+    //! Record fn, run on the helper thread beside the rest of its wave
+    /*! It must not communicate */
+    AsyncTask io(const std::function<void()>& fn, const AsyncFields& reads, const AsyncFields& writes)
+      {
+	return add(new FnTask(fn, reads, writes, true));
+      }
+
+    //! Number of tasks not run yet
+    int size() const {return tasks.size();}
+
+    //! Run every task recorded. Collective
+    void wait();
+
+  private:
+    //! Hide copies - tasks are owned
+    AsyncScope(const AsyncScope&);
+    void operator=(const AsyncScope&);
+
+    //! One recorded task
+    struct Task
+    {
+      Task() : wave(0), helper(false) {}
+      virtual ~Task() {}
+
+      //! Does the task read what lives at p
+      virtual bool reads(const void* p) const = 0;
+
+      //! What the task writes
+      virtual void writes(std::vector<const void*>& w) const {}
+
+      //! Do it, only on the node for a sum
+      virtual void run() = 0;
+
+      //! Number of REAL64 words the sum of the node packs into
+      virtual int words() const {return 0;}
+      virtual void pack(REAL64* buf) const {}
+      virtual void unpack(const REAL64* buf) {}
+
+      std::shared_ptr<AsyncInternal::State> state;
+      int wave;
+      bool helper;            // runs on the helper thread
+    };
+
+    template<class T, class Op, class RHS, class T1>
+    struct EvalTask : public Task
+    {
+      EvalTask(OLattice<T>& dest_, const Op& op_, const QDPExpr<RHS,OLattice<T1> >& expr_, const Subset& s_) :
+	dest(dest_), op(op_), expr(expr_), s(s_) {}
+
+      bool reads(const void* p) const
+	{
+	  return forEach(expr, ReadsFieldLeaf(p), OrCombine());
+	}
+
+      void writes(std::vector<const void*>& w) const {w.push_back(dest.getF());}
+
+      void run() {QDP::evaluate(dest, op, expr, s);}
+
+      OLattice<T>& dest;
+      Op op;
+      QDPExpr<RHS,OLattice<T1> > expr;
+      const Subset& s;
+    };
+
+    template<class RHS, class T>
+    struct SumTask : public Task
+    {
+      typedef typename UnaryReturn<OLattice<T>, FnSum>::Type_t Sum_t;
+      typedef typename WordType<Sum_t>::Type_t W;
+
+      SumTask(const QDPExpr<RHS,OLattice<T> >& expr_, const Subset& s_) :
+	expr(expr_), s(s_), result(new AsyncInternal::Value<Sum_t>)
+	{
+	  state = result;
+	}
+
+      bool reads(const void* p) const
+	{
+	  return forEach(expr, ReadsFieldLeaf(p), OrCombine());
+	}
+
+      void run()
+	{
+	  startShifts(expr, s);
+
+	  // A partial per thread, added in thread order
+	  multi1d<Sum_t> partial(qdpNumThreads());
+	  for(int k=0; k < partial.size(); ++k)
+	    zero_rep(partial[k]);
+
+	  const int* tab = s.siteTable().slice();
+	  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+	      Sum_t d;
+	      zero_rep(d);
+	      for(int j=lo; j < hi; ++j)
+		d.elem() += forEach(expr, EvalLeaf1(tab[j]), OpCombine());
+	      partial[myId].elem() += d.elem();
+	    });
+
+	  zero_rep(local);
+	  for(int k=0; k < partial.size(); ++k)
+	    local.elem() += partial[k].elem();
+	}
+
+      int words() const {return sizeof(Sum_t)/sizeof(W);}
+
+      void pack(REAL64* buf) const
+	{
+	  const W* w = (const W*)&local;
+	  for(int k=0; k < words(); ++k)
+	    buf[k] = w[k];
+	}
+
+      void unpack(const REAL64* buf)
+	{
+	  W* w = (W*)&result->value;
+	  for(int k=0; k < words(); ++k)
+	    w[k] = W(buf[k]);
+	}
+
+      QDPExpr<RHS,OLattice<T> > expr;
+      const Subset& s;
+      Sum_t local;
+      std::shared_ptr<AsyncInternal::Value<Sum_t> > result;
+    };
+
+    struct FnTask : public Task
+    {
+      FnTask(const std::function<void()>& fn_, const AsyncFields& r, const AsyncFields& w, bool io) :
+	fn(fn_), rd(r.list()), wr(w.list())
+	{
+	  helper = io;
+	}
+
+      bool reads(const void* p) const
+	{
+	  for(int k=0; k < rd.size(); ++k)
+	    if (rd[k] == p)
+	      return true;
+	  return false;
+	}
+
+      void writes(std::vector<const void*>& w) const {w.insert(w.end(), wr.begin(), wr.end());}
+
+      void run() {fn();}
+
+      std::function<void()> fn;
+      std::vector<const void*> rd, wr;
+    };
+
+    //! Put t in the wave after the last task it depends on
+    AsyncTask add(Task* t);
+
+    //! Run the tasks of the helper thread
+    static void* helperLoop(void* arg);
+
+    std::vector<Task*> tasks;
+  };
+
+
+  inline void AsyncTask::wait() const
+  {
+    if (st && ! st->done && st->scope)
+      st->scope->wait();
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
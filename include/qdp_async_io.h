@@ -0,0 +1,223 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Background writing of lattice fields
+ */
+
+#ifndef QDP_ASYNC_IO_H
+#define QDP_ASYNC_IO_H
+
+#include <string>
+#include <list>
+#include <vector>
+#include <sys/types.h>
+
+namespace QDP
+{
+  /*! @addtogroup io
+   *
+   * @{
+   */
+
+  //--------------------------------------------------------------------------------
+  //! Writes checkpoints of lattice fields while the job carries on
+  /*!
+    write() copies the sites this node holds into a staging buffer and
+    returns. A thread on each node then puts them straight into the file
+    with pwrite, lex ordered and big-endian, the same bytes write() to a
+    BinaryFileWriter produces, so the file reads back with a
+    BinaryFileReader. The file must be visible to all nodes.
+
+    Nothing is communicated in the background; wait() is collective and
+    finishes the checksum of the file over all nodes. If the staging
+    buffer cannot be had the field is written at once instead.
+
+      AsyncLatticeWriter ckpt;
+      ...
+      ckpt.open("cfg.bin");
+      ckpt.write(u);
+      ... carry on with the trajectory
+      ckpt.wait();
+  */
+  class AsyncLatticeWriter
+  {
+  public:
+    AsyncLatticeWriter();
+
+    //! Waits for any checkpoint still in flight
+    /*! Collective, like wait() */
+    ~AsyncLatticeWriter();
+
+    //! Start a new file, truncating it
+    /*! Collective. Waits for the previous file first */
+    void open(const std::string& p);
+
+    //! Snapshot a field and queue it behind the ones before
+    template<class T>
+    void write(const OLattice<T>& d)
+      {
+	typedef typename WordType<T>::Type_t W;
+	writeLattice((const char*)d.getF(), sizeof(W), sizeof(T)/sizeof(W));
+      }
+
+    //! Snapshot an array of fields one after the other
+    /*! Unlike write(BinaryWriter&, const multi1d&) no length goes first */
+    template<class T>
+    void write(const multi1d< OLattice<T> >& d)
+      {
+	for(int i=0; i < d.size(); ++i)
+	  write(d[i]);
+      }
+
+    //! True once this node has written all it was given
+    /*! Does not block or communicate */
+    bool test();
+
+    //! Wait until the file is complete on all nodes
+    /*! Collective. Frees the staging buffers */
+    void wait();
+
+    //! Checksum of the file written so far
+    /*! Valid on all nodes after wait() */
+    QDPUtil::n_uint32_t getChecksum() const {return checksum;}
+
+    //! Is a file open
+    bool is_open() const {return fd >= 0;}
+
+  private:
+    //! Hide copies
+    AsyncLatticeWriter(const AsyncLatticeWriter&);
+    void operator=(const AsyncLatticeWriter&);
+
+    //! One field in the file
+    struct Job
+    {
+      const char* data;       // node local sites
+      bool owned;             // data is a staging buffer
+      size_t size, nmemb;     // word size and words per site
+      off_t start;            // offset in the file
+      std::vector<unsigned int> crcs;  // crc of every x-row, 0 if not here
+    };
+
+    void writeLattice(const char* data, size_t size, size_t nmemb);
+    void run(Job* job);
+    static void* workerLoop(void* arg);
+
+    std::string path;
+    int fd;
+    off_t offset;
+    QDPUtil::n_uint32_t checksum;
+
+    std::vector<int> sites;   // linear index of the node sites in file order
+    std::vector<int> rows;    // lex site of the start of each x-row here
+
+    std::list<Job*> queue;    // not started yet
+    std::list<Job*> jobs;     // all of this file
+    bool busy, closing;
+    struct Worker;
+    Worker* worker;
+  };
+
+  //--------------------------------------------------------------------------------
+  //! Reads time slices of lattice fields ahead of their use
+  /*!
+    read() queues one time slice of a field, stored lex ordered and
+    big-endian from an offset in the file, as TimeSliceIO writes it. A
+    thread on each node works through the queue, fetching the x-rows of
+    the slice that the node holds with pread, so the data goes straight
+    to its owners instead of through the primary node. next() finishes
+    the oldest slice, filling its field, while the thread is already
+    reading the ones behind it. The file must be visible to all nodes.
+
+    Nothing is communicated in the background; next() is collective and
+    checks the slice checksum over all nodes.
+
+      AsyncTimeSliceReader in;
+      in.open("evecs.db");
+      for(int t=0; t < Lt; ++t)
+        in.read(vec[t], t, pos[t], true);
+      for(int t=0; t < Lt; ++t)
+      {
+        in.next();
+        ... work on time slice t while t+1 is read
+      }
+  */
+  class AsyncTimeSliceReader
+  {
+  public:
+    AsyncTimeSliceReader();
+
+    //! Drops anything not yet read
+    ~AsyncTimeSliceReader();
+
+    //! Open a file on every node
+    void open(const std::string& p);
+
+    //! Stop reading and close the file
+    /*! Queued slices not finished by next() are dropped */
+    void close();
+
+    //! Queue time slice t of a field, stored from offset start
+    /*!
+      With check set, the big-endian checksum a MapObjectDisk record
+      keeps after its value follows the slice and next() verifies it.
+      The field must not be touched until next() has finished it.
+    */
+    template<class T>
+    void read(OLattice<T>& d, int t, off_t start, bool check=false)
+      {
+	typedef typename WordType<T>::Type_t W;
+	readSlice((char*)d.getF(), sizeof(W), sizeof(T)/sizeof(W), t, start, check);
+      }
+
+    //! Finish the oldest queued slice
+    /*! Collective. Returns the checksum of its bytes in the file */
+    QDPUtil::n_uint32_t next();
+
+    //! Number of slices queued and not yet finished
+    int pending() const {return jobs.size();}
+
+    //! Is a file open
+    bool is_open() const {return fd >= 0;}
+
+  private:
+    //! Hide copies
+    AsyncTimeSliceReader(const AsyncTimeSliceReader&);
+    void operator=(const AsyncTimeSliceReader&);
+
+    //! One time slice of a field
+    struct Job
+    {
+      char* data;             // node local sites
+      size_t size, nmemb;     // word size and words per site
+      off_t start;            // offset of the slice in the file
+      int t;                  // the time slice
+      bool check;             // a checksum follows the slice
+      std::vector<char> buf;  // the rows here, in file order and swapped
+      std::vector<unsigned int> crcs;  // crc of every x-row of the slice, 0 if not here
+      QDPUtil::n_uint32_t stored;      // checksum after the slice, primary node
+      bool done;
+    };
+
+    void readSlice(char* data, size_t size, size_t nmemb, int t, off_t start, bool check);
+    void run(Job* job);
+    static void* workerLoop(void* arg);
+
+    std::string path;
+    int fd;
+
+    std::vector<int> sites;   // linear index of the node sites in file order
+    std::vector<int> rows;    // lex site of the start of each x-row here
+
+    std::list<Job*> queue;    // not started yet
+    std::list<Job*> jobs;     // all not yet finished
+    bool closing;
+    struct Worker;
+    Worker* worker;
+  };
+
+  /*! @} */   // end of group io
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,149 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Run time choice of the threading and SIMD level of a kernel
+ *
+ * dispatch_to_threads_tuned is dispatch_to_threads for kernels whose
+ * result does not change when they are run again, like an evaluate
+ * whose target does not alias its operands. With the tuner on
+ * (-autotune or AutoTune::setEnabled) the first call for each kernel
+ * name, site count and argument type times the candidate variants on
+ * the live fields, and the fastest is used for the rest of the run.
+ * -autotune-file loads the winners of earlier jobs and saves the table
+ * at QDP_finalize. Each node tunes on its own and never communicates,
+ * so the nodes may differ in their subsets. With the tuner off this
+ * is dispatch_to_threads.
+ */
+
+#ifndef QDP_AUTOTUNE_H
+#define QDP_AUTOTUNE_H
+
+#include <functional>
+#include <string>
+#include <typeinfo>
+
+namespace QDP
+{
+  namespace AutoTune
+  {
+    //! One way of running a kernel
+    struct Variant
+    {
+      int threads;   //!< threads given work, at most qdpNumThreads()
+      int chunk;     //!< sites handed out round robin, 0 for one range per thread
+      int simd;      //!< AVX::Level for the SSE kernels, -1 to leave it alone
+    };
+
+    //! Turn the tuner on or off
+    void setEnabled(bool on);
+
+    //! Is the tuner on
+    bool enabled();
+
+    //! Load the table from file when it exists, and save it there at QDP_finalize
+    /*! Also turns the tuner on */
+    void setCacheFile(const std::string& file);
+
+    //! Add the entries of a file to the table
+    void load(const std::string& file);
+
+    //! Write the table, on the primary node
+    void save(const std::string& file);
+
+    //! Number of kernels in the table
+    int numEntries();
+
+    //! Print the table
+    void print();
+
+    //! Save the table to the cache file, called by QDP_finalize
+    void finalize();
+
+    //! The variant for a key, timing the candidates with run on first use
+    Variant lookup(const char* kernel, int sites, const char* type,
+		   const std::function<void(const Variant&)>& run);
+
+    //! Use a SIMD level for the life of the scope
+    class SimdScope
+    {
+    public:
+      explicit SimdScope(int simd);
+      ~SimdScope();
+    private:
+      int saved;
+    };
+
+    //! The work of a tuned dispatch
+    template<class Arg>
+    struct TunedArg
+    {
+      Arg* a;
+      void (*func)(int,int,int,Arg*);
+      int n;
+      Variant v;
+    };
+
+    //! Give thread slots lo..hi their share of the sites
+    template<class Arg>
+    void tunedSlots(int lo, int hi, int myId, TunedArg<Arg>* t)
+    {
+      const int nthr = t->v.threads;
+      const int chunk = t->v.chunk;
+
+      for(int slot=lo; slot < hi && slot < nthr; ++slot)
+      {
+	if (chunk <= 0)
+	{
+	  const int l = (t->n*slot)/nthr;
+	  const int h = (t->n*(slot+1))/nthr;
+	  if (l < h)
+	    t->func(l, h, myId, t->a);
+	}
+	else
+	{
+	  for(int l=slot*chunk; l < t->n; l += nthr*chunk)
+	    t->func(l, (l+chunk < t->n) ? l+chunk : t->n, myId, t->a);
+	}
+      }
+    }
+
+    //! Run func over [0,n) as the variant says
+    template<class Arg>
+    void run(int n, Arg& a, void (*func)(int,int,int,Arg*), const Variant& v)
+    {
+      SimdScope simd(v.simd);
+
+      if (v.threads >= qdpNumThreads() && v.chunk <= 0)
+      {
+	dispatch_to_threads(n, a, func);
+	return;
+      }
+
+      // One slot per thread, the slot decides its sites
+      TunedArg<Arg> t = {&a, func, n, v};
+      dispatch_to_threads(qdpNumThreads(), t, tunedSlots<Arg>);
+    }
+  }
+
+
+  //! dispatch_to_threads with the variant the tuner found for kernel
+  /*! func may be run several times on first use, so pass rerun=false
+   *  when it reads what it writes, e.g. an operand aliases the target,
+   *  and it is plain dispatch_to_threads */
+  template<class Arg>
+  void dispatch_to_threads_tuned(const char* kernel, int numSiteTable, Arg a,
+				 void (*func)(int,int,int,Arg*), bool rerun = true)
+  {
+    if (! rerun || ! AutoTune::enabled() || numSiteTable <= 0)
+    {
+      dispatch_to_threads(numSiteTable, a, func);
+      return;
+    }
+
+    const AutoTune::Variant v = AutoTune::lookup(kernel, numSiteTable, typeid(Arg).name(),
+      [&](const AutoTune::Variant& c) {AutoTune::run(numSiteTable, a, func, c);});
+    AutoTune::run(numSiteTable, a, func, v);
+  }
+}
+
+#endif
@@ -0,0 +1,242 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Inner products of all pairs of two sets of lattice vectors, and their block axpy
+ */
+
+#ifndef QDP_BLOCK_INNER_H
+#define QDP_BLOCK_INNER_H
+
+#include <algorithm>
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  namespace GramKernels
+  {
+    //! user argument for the Gram kernels
+    template<class T>
+    struct Args
+    {
+      const int* tab;
+      int nv, nw;
+      std::vector<const T*> v;
+      std::vector<const T*> w;
+      std::vector<T*> y;
+      const REAL64* c;       // [i][j][re,im]
+      REAL64* part;          // the same, per thread
+      int tile_sites;
+    };
+
+    //! Rows and columns of the register tile of the product
+    const int tile = 4;
+
+    //! Sites of a cache tile, so that they fit in about 256KB for all n vectors
+    template<class T>
+    inline int tileSites(int n)
+    {
+      return std::max(16, int((256*1024) / (std::max(n, 1)*sizeof(T))));
+    }
+
+    //! Partial <v_i,w_j> of thread myId for all i, j, summed in REAL64
+    /*!
+     * The sites of the thread go a cache tile at a time. For each tile
+     * every tile x tile block of the matrix reads its vectors of the
+     * tile once for tile*tile complex products, the order of ZGEMM with
+     * the first argument conjugate transposed.
+     */
+    template<class T>
+    void innerProductMatrixKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int np = BlockKernels::pairs<T>();
+	const int nv = a->nv, nw = a->nw;
+	REAL64* part = a->part + size_t(2)*myId*nv*nw;
+
+	for(int b0=lo; b0 < hi; b0 += a->tile_sites)
+	{
+	  const int b1 = std::min(hi, b0 + a->tile_sites);
+
+	  for(int i0=0; i0 < nv; i0 += tile)
+	    for(int j0=0; j0 < nw; j0 += tile)
+	    {
+	      const int ni = std::min(tile, nv - i0);
+	      const int nj = std::min(tile, nw - j0);
+
+	      REAL64 cr[tile][tile] = {{0}}, ci[tile][tile] = {{0}};
+	      for(int s=b0; s < b1; ++s)
+	      {
+		const int x = a->tab[s];
+		const W* vp[tile];
+		const W* wp[tile];
+		for(int i=0; i < ni; ++i)
+		  vp[i] = (const W*)&a->v[i0+i][x];
+		for(int j=0; j < nj; ++j)
+		  wp[j] = (const W*)&a->w[j0+j][x];
+
+		for(int p=0; p < np; ++p)
+		  for(int i=0; i < ni; ++i)
+		  {
+		    const REAL64 vr = vp[i][2*p], vi = vp[i][2*p+1];
+		    for(int j=0; j < nj; ++j)
+		    {
+		      const REAL64 wr = wp[j][2*p], wi = wp[j][2*p+1];
+		      cr[i][j] += vr*wr + vi*wi;
+		      ci[i][j] += vr*wi - vi*wr;
+		    }
+		  }
+	      }
+
+	      for(int i=0; i < ni; ++i)
+		for(int j=0; j < nj; ++j)
+		{
+		  REAL64* d = &part[2*(size_t(i0+i)*nw + j0+j)];
+		  d[0] += cr[i][j];
+		  d[1] += ci[i][j];
+		}
+	    }
+	}
+      }
+
+    //! y_j += sum over i of c(i,j) v_i at the sites [lo,hi)
+    /*! The v of a site are read from cache for every j */
+    template<class T>
+    void blockAxpyKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int np = BlockKernels::pairs<T>();
+	const int nv = a->nv, nw = a->nw;
+
+	for(int s=lo; s < hi; ++s)
+	{
+	  const int x = a->tab[s];
+	  for(int j=0; j < nw; ++j)
+	  {
+	    W* yp = (W*)&a->y[j][x];
+	    for(int i=0; i < nv; ++i)
+	    {
+	      const W cr = a->c[2*(i*nw + j)], ci = a->c[2*(i*nw + j) + 1];
+	      const W* vp = (const W*)&a->v[i][x];
+	      for(int p=0; p < np; ++p)
+	      {
+		const W vr = vp[2*p], vi = vp[2*p+1];
+		yp[2*p]   += cr*vr - ci*vi;
+		yp[2*p+1] += cr*vi + ci*vr;
+	      }
+	    }
+	  }
+	}
+      }
+  }
+
+
+  //! The matrix of <v[i],w[j]> on s for all pairs i, j, with one global sum
+  /*!
+   * The result is indexed (i,j). In place of the N*M sweeps and global
+   * sums of innerProduct(v[i], w[j], s), the threads take their sites a
+   * cache sized tile at a time and form all entries from it, see
+   * GramKernels::innerProductMatrixKernel. The per-thread sums are
+   * combined in thread order. For the overlaps of block Krylov solvers,
+   * deflation and eigensolvers.
+   *
+   * T must be built from RComplex words, like the fermions.
+   */
+  template<class T>
+  multi2d<DComplex> innerProductMatrix(const multi1d< OLattice<T> >& v, const multi1d< OLattice<T> >& w,
+				       const Subset& s)
+  {
+    const int nv = v.size(), nw = w.size();
+    const int len = 2*nv*nw;
+
+    GramKernels::Args<T> a;
+    a.tab = s.siteTable().slice();
+    a.nv = nv;
+    a.nw = nw;
+    for(int i=0; i < nv; ++i)
+      a.v.push_back(v[i].getF());
+    for(int j=0; j < nw; ++j)
+      a.w.push_back(w[j].getF());
+    a.c = 0;
+    a.tile_sites = GramKernels::tileSites<T>(nv + nw);
+
+    std::vector<REAL64> part(size_t(qdpNumThreads())*len, 0), res;
+    a.part = &part[0];
+
+    if (len > 0)
+    {
+      dispatch_to_threads(s.numSiteTable(), a, GramKernels::innerProductMatrixKernel<T>);
+      BlockKernels::reducePartials(part, len, res);
+    }
+
+    multi2d<DComplex> d(nv, nw);
+    for(int i=0; i < nv; ++i)
+      for(int j=0; j < nw; ++j)
+	d(i,j) = cmplx(Double(res[2*(i*nw + j)]), Double(res[2*(i*nw + j) + 1]));
+    return d;
+  }
+
+  //! The matrix of <v[i],w[j]> on all sites
+  template<class T>
+  multi2d<DComplex> innerProductMatrix(const multi1d< OLattice<T> >& v, const multi1d< OLattice<T> >& w)
+  {
+    return innerProductMatrix(v, w, all);
+  }
+
+
+  //! y[j] += sum over i of c(i,j) v[i] on s, that is Y += V C
+  /*!
+   * c is v.size() x y.size(), indexed as the result of
+   * innerProductMatrix. One sweep does all of y. With y zero first this
+   * is y = V C, the rotation of a basis by the coefficients of a small
+   * eigenproblem. No y may be one of the v.
+   */
+  template<class T>
+  void blockAxpy(multi1d< OLattice<T> >& y, const multi1d< OLattice<T> >& v, const multi2d<DComplex>& c,
+		 const Subset& s)
+  {
+    const int nv = v.size(), nw = y.size();
+    if (c.size2() != nv || c.size1() != nw)
+      QDP_error_exit("blockAxpy: coefficients are %d x %d, need %d x %d",
+		     c.size2(), c.size1(), nv, nw);
+
+    std::vector<REAL64> cc(2*nv*nw);
+    for(int i=0; i < nv; ++i)
+      for(int j=0; j < nw; ++j)
+      {
+	cc[2*(i*nw + j)]     = toDouble(real(c(i,j)));
+	cc[2*(i*nw + j) + 1] = toDouble(imag(c(i,j)));
+      }
+
+    GramKernels::Args<T> a;
+    a.tab = s.siteTable().slice();
+    a.nv = nv;
+    a.nw = nw;
+    for(int i=0; i < nv; ++i)
+      a.v.push_back(v[i].getF());
+    for(int j=0; j < nw; ++j)
+      a.y.push_back(writable(y[j]).getF());
+    a.c = cc.empty() ? 0 : &cc[0];
+    a.part = 0;
+    a.tile_sites = 0;
+
+    if (nv > 0 && nw > 0)
+      dispatch_to_threads(s.numSiteTable(), a, GramKernels::blockAxpyKernel<T>);
+  }
+
+  //! y[j] += sum over i of c(i,j) v[i] on all sites
+  template<class T>
+  void blockAxpy(multi1d< OLattice<T> >& y, const multi1d< OLattice<T> >& v, const multi2d<DComplex>& c)
+  {
+    blockAxpy(y, v, c, all);
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
@@ -27,12 +27,36 @@ namespace QDPUtil
   //! crc32
   n_uint32_t crc32(n_uint32_t crc, const char *buf, size_t len);
 
+  //! Operator taking the crc32 of A to that of A followed by a fixed number of bytes
+  struct CRC32Shift
+  {
+    n_uint32_t m[32];
+  };
+
+  //! Build the operator for blocks of len bytes
+  void crc32_shift(CRC32Shift& op, size_t len);
+
+  //! crc32 of A followed by B, given crc1 of A and crc2 of B of op's length
+  n_uint32_t crc32_combine(const CRC32Shift& op, n_uint32_t crc1, n_uint32_t crc2);
+
+  //! crc32 of A followed by B, given crc1 of A and crc2 of B of len2 bytes
+  n_uint32_t crc32_combine(n_uint32_t crc1, n_uint32_t crc2, size_t len2);
+
   //! Is the native byte order big endian?
   bool big_endian();
 
   //! Byte-swap an array of data each of size nmemb
   void byte_swap(void *ptr, size_t size, size_t nmemb);
 
+  //! Copy nmemb words of size between native and big-endian order. dst may be src
+  void copy_big_endian(char *dst, const char *src, size_t size, size_t nmemb);
+
+  //! Copy into big-endian order, returning crc updated with the copied bytes
+  n_uint32_t crc32_to_big_endian(n_uint32_t crc, char *dst, const char *src, size_t size, size_t nmemb);
+
+  //! Copy big-endian words into native order, returning crc updated with the source bytes
+  n_uint32_t crc32_from_big_endian(n_uint32_t crc, char *dst, const char *src, size_t size, size_t nmemb);
+
   //! fread on a binary file written in big-endian order
   size_t bfread(void *ptr, size_t size, size_t nmemb, FILE *stream);
 
@@ -0,0 +1,143 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief QIO and NERSC checksums of lattice fields, each node over its own sites
+ */
+
+#ifndef QDP_CHECKSUM_H
+#define QDP_CHECKSUM_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup io
+   *  @{
+   */
+
+  //! The checksum of a QIO record
+  /*!
+   * Each site's data, big endian as in the file, has a crc32 which is
+   * rotated left by its lexicographic site index modulo 29 and modulo 31
+   * and xor'ed into suma and sumb.
+   */
+  struct QIOChecksum
+  {
+    QDPUtil::n_uint32_t suma;
+    QDPUtil::n_uint32_t sumb;
+
+    bool operator==(const QIOChecksum& c) const {return suma == c.suma && sumb == c.sumb;}
+    bool operator!=(const QIOChecksum& c) const {return ! (*this == c);}
+  };
+
+  namespace ChecksumInternal
+  {
+    inline QDPUtil::n_uint32_t rotl(QDPUtil::n_uint32_t x, int k)
+    {
+      return (k == 0) ? x : ((x << k) | (x >> (32 - k)));
+    }
+
+    //! Lexicographic index, x fastest, of the site at linear index x of this node
+    inline size_t lexIndex(int x)
+    {
+      Layout::LatticeCoord c;
+      Layout::siteCoords(Layout::nodeNumber(), x, c);
+
+      const multi1d<int>& latt = Layout::lattSize();
+      size_t lex = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+	lex = lex*latt[mu] + c[mu];
+      return lex;
+    }
+
+    //! user argument for qioKernel
+    template<class T>
+    struct QIOArgs
+    {
+      std::vector<const T*> f;       // the fields of one site record
+      QDPUtil::n_uint32_t* a;        // per thread
+      QDPUtil::n_uint32_t* b;
+    };
+
+    //! user function for the checksum of sites [lo,hi)
+    template<class T>
+    void qioKernel(int lo, int hi, int myId, QIOArgs<T>* p)
+    {
+      typedef typename WordType<T>::Type_t W;
+
+      char* buf = Allocator::threadScratch<char>(sizeof(T), 0);
+      QDPUtil::n_uint32_t a = 0, b = 0;
+
+      for(int x=lo; x < hi; ++x)
+      {
+	QDPUtil::n_uint32_t crc = 0;
+	for(int j=0; j < p->f.size(); ++j)
+	  crc = QDPUtil::crc32_to_big_endian(crc, buf, (const char*)&p->f[j][x], sizeof(W), sizeof(T)/sizeof(W));
+
+	const size_t lex = lexIndex(x);
+	a ^= rotl(crc, lex % 29);
+	b ^= rotl(crc, lex % 31);
+      }
+
+      p->a[myId] ^= a;
+      p->b[myId] ^= b;
+    }
+
+    //! The xor of the checksums of the threads and then of the nodes
+    QIOChecksum combine(const std::vector<QDPUtil::n_uint32_t>& a, const std::vector<QDPUtil::n_uint32_t>& b);
+
+    //! The checksum of records made of one site of each field
+    template<class T>
+    QIOChecksum qioChecksum(const std::vector<const T*>& f)
+    {
+      QIOArgs<T> p;
+      p.f = f;
+      std::vector<QDPUtil::n_uint32_t> a(qdpNumThreads(), 0), b(qdpNumThreads(), 0);
+      p.a = &a[0];
+      p.b = &b[0];
+
+      dispatch_to_threads(Layout::sitesOnNode(), p, qioKernel<T>);
+
+      return combine(a, b);
+    }
+  }
+
+
+  //! The QIO checksum of f as a record of T
+  /*!
+   * Each node takes its own sites on the threads and there is one global
+   * sum, instead of the sites going in lexicographic order through the
+   * primary node. A field written in another precision, say single
+   * from double, has the checksum of its copy in that precision.
+   */
+  template<class T>
+  QIOChecksum qioChecksum(const OLattice<T>& f)
+  {
+    return ChecksumInternal::qioChecksum(std::vector<const T*>(1, f.getF()));
+  }
+
+  //! The QIO checksum of a record of f.size() components per site, as written from a multi1d
+  template<class T>
+  QIOChecksum qioChecksum(const multi1d< OLattice<T> >& f)
+  {
+    std::vector<const T*> p;
+    for(int j=0; j < f.size(); ++j)
+      p.push_back(f[j].getF());
+    return ChecksumInternal::qioChecksum(p);
+  }
+
+
+  //! The NERSC checksum of u written as an archive of mat_size REAL32 words per link
+  /*! The 32 bit words summed on the threads of each node, then over the nodes */
+  QDPUtil::n_uint32_t nerscChecksum(const multi1d<LatticeColorMatrix>& u, int mat_size);
+
+  //! The sum of the 32 bit words of bytes bytes at buf, on the threads of this node only
+  /*! For the NERSC checksum of archive sites this node holds */
+  QDPUtil::n_uint32_t nerscWordSum(const void* buf, size_t bytes);
+
+  /** @} */ // end of io
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,326 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Clover terms stored as packed hermitian chiral blocks, and their application
+ */
+
+#ifndef QDP_CLOVER_TERM_H
+#define QDP_CLOVER_TERM_H
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  namespace CloverInternal
+  {
+    //! Rows of a chiral block: two spins of Nc colours, 6 for QCD
+    const int nb = (Ns/2)*Nc;
+
+    //! Position of the entry (i,j), i > j, among the strictly lower entries of a block
+    inline int lower(int i, int j) {return i*(i-1)/2 + j;}
+  }
+
+  //! One hermitian chiral block: the real diagonal and the complex entries below it
+  template<class T>
+  struct PackedCloverBlock
+  {
+    T diag[CloverInternal::nb];
+    T off[CloverInternal::nb*(CloverInternal::nb-1)];   // re, im of lower(i,j)
+  };
+
+  //! The clover term of a site, blocks of the spin pairs (0,1) and (2,3)
+  /*! 72 words for QCD against the 288 of a full spin-colour matrix */
+  template<class T>
+  struct PackedCloverSite
+  {
+    PackedCloverBlock<T> block[2];
+  };
+
+
+  //! A clover term A = diag(A_0, A_1) with hermitian blocks, stored packed
+  /*!
+   * The term 1 + c_sw/4 sigma.F of a Wilson-clover operator, as any
+   * matrix in the span of the sigma_{mu nu}, is block diagonal in the
+   * chiral (DeGrand-Rossi) basis of QDP, with hermitian blocks on the
+   * spin pairs (0,1) and (2,3). Only those blocks are kept, the
+   * diagonal real and the lower triangle complex, a quarter of the
+   * bytes of a LatticePropagator and half of the two full blocks.
+   *
+   *   PackedClover<REAL> a, ainv;
+   *   a.pack(clov);               // from a LatticePropagator
+   *   ainv.inverse(a);
+   *   a.apply(chi, psi, rb[0]);   // chi = A psi on the even sites
+   *   ainv.apply(psi, chi, rb[0]);
+   *
+   * The application reads each site's term once and works the two
+   * blocks as plain arrays of reals, which the compiler vectorizes.
+   */
+  template<class T>
+  class PackedClover
+  {
+  public:
+    typedef PackedCloverSite<T> Site_t;
+    typedef OLattice< PSpinVector< PColorVector< RComplex<T>, Nc>, Ns> > Fermion_t;
+
+    PackedClover() {alloc_mem();}
+    ~PackedClover() {free_mem();}
+
+    //! The term of site i
+    Site_t& elem(int i) {return F[i];}
+    const Site_t& elem(int i) const {return F[i];}
+
+    //! Keep the chiral blocks of a, the real part of their diagonal and their lower triangle
+    /*! a is taken as hermitian and block diagonal; nothing else of it is read */
+    template<class T2>
+    void pack(const OLattice< PSpinMatrix< PColorMatrix< RComplex<T2>, Nc>, Ns> >& a)
+      {
+	PackArgs<T2> args(this, &const_cast<OLattice< PSpinMatrix< PColorMatrix< RComplex<T2>, Nc>, Ns> >&>(a), true);
+	dispatch_to_threads(Layout::sitesOnNode(), args, packKernel<T2>);
+      }
+
+    //! a = the full spin-colour matrix, zero off the blocks
+    template<class T2>
+    void unpack(OLattice< PSpinMatrix< PColorMatrix< RComplex<T2>, Nc>, Ns> >& a) const
+      {
+	PackArgs<T2> args(const_cast<PackedClover*>(this), &writable(a), false);
+	dispatch_to_threads(Layout::sitesOnNode(), args, packKernel<T2>);
+      }
+
+    //! Make this the inverse of a, block by block
+    /*! By Gauss-Jordan elimination in double precision at each site */
+    void inverse(const PackedClover& a)
+      {
+	InvArgs args(this, &a);
+	dispatch_to_threads(Layout::sitesOnNode(), args, inverseKernel);
+      }
+
+    //! chi = A psi on the sites of s
+    void apply(Fermion_t& chi, const Fermion_t& psi, const Subset& s) const
+      {
+	typename Fermion_t::Subtype_t* d = writable(chi).getF();
+	ApplyArgs args(this, d, psi.getF(), s.siteTable().slice());
+	dispatch_to_threads(s.numSiteTable(), args, applyKernel);
+      }
+
+    //! chi = A psi on all sites
+    void apply(Fermion_t& chi, const Fermion_t& psi) const {apply(chi, psi, all);}
+
+    //! chi = c psi at one site
+    /*!
+     * Each block is a hermitian 6x6 times a 6-vector: the diagonal, and
+     * every lower entry used twice, as itself and as its conjugate.
+     */
+    static inline void applySite(typename Fermion_t::Subtype_t& chi, const Site_t& c,
+				 const typename Fermion_t::Subtype_t& psi)
+      {
+	using namespace CloverInternal;
+
+	for(int b=0; b < 2; ++b)
+	{
+	  const PackedCloverBlock<T>& a = c.block[b];
+
+	  T vr[nb], vi[nb], wr[nb], wi[nb];
+	  for(int i=0; i < nb; ++i)
+	  {
+	    const RComplex<T>& v = psi.elem(spin(b,i)).elem(color(i));
+	    vr[i] = v.real();
+	    vi[i] = v.imag();
+	  }
+
+	  for(int i=0; i < nb; ++i)
+	  {
+	    wr[i] = a.diag[i]*vr[i];
+	    wi[i] = a.diag[i]*vi[i];
+	  }
+
+	  for(int i=1; i < nb; ++i)
+	    for(int k=0; k < i; ++k)
+	    {
+	      const T lr = a.off[2*lower(i,k)], li = a.off[2*lower(i,k)+1];
+
+	      // w_i += l v_k, w_k += conj(l) v_i
+	      wr[i] += lr*vr[k] - li*vi[k];
+	      wi[i] += lr*vi[k] + li*vr[k];
+	      wr[k] += lr*vr[i] + li*vi[i];
+	      wi[k] += lr*vi[i] - li*vr[i];
+	    }
+
+	  for(int i=0; i < nb; ++i)
+	  {
+	    RComplex<T>& w = chi.elem(spin(b,i)).elem(color(i));
+	    w.real() = wr[i];
+	    w.imag() = wi[i];
+	  }
+	}
+      }
+
+  private:
+    //! Hide copies
+    PackedClover(const PackedClover&);
+    void operator=(const PackedClover&);
+
+    //! Row of a block's entry i in the spin-colour matrix
+    static int spin(int b, int i) {return 2*b + i/Nc;}
+    static int color(int i) {return i%Nc;}
+
+    //! user argument for pack and unpack
+    template<class T2>
+    struct PackArgs
+    {
+      PackArgs(PackedClover* c_, OLattice< PSpinMatrix< PColorMatrix< RComplex<T2>, Nc>, Ns> >* a_, bool in_) :
+	c(c_), a(a_), in(in_) {}
+
+      PackedClover* c;
+      OLattice< PSpinMatrix< PColorMatrix< RComplex<T2>, Nc>, Ns> >* a;
+      bool in;
+    };
+
+    //! user function for pack and unpack
+    template<class T2>
+    static void packKernel(int lo, int hi, int myId, PackArgs<T2>* p)
+      {
+	using namespace CloverInternal;
+
+	for(int x=lo; x < hi; ++x)
+	{
+	  PSpinMatrix< PColorMatrix< RComplex<T2>, Nc>, Ns>& m = p->a->elem(x);
+	  Site_t& c = p->c->elem(x);
+
+	  if (! p->in)
+	    zero_rep(m);
+
+	  for(int b=0; b < 2; ++b)
+	    for(int i=0; i < nb; ++i)
+	    {
+	      RComplex<T2>& d = m.elem(spin(b,i),spin(b,i)).elem(color(i),color(i));
+	      if (p->in)
+		c.block[b].diag[i] = d.real();
+	      else
+		d.real() = c.block[b].diag[i];
+
+	      for(int j=0; j < i; ++j)
+	      {
+		T* o = &c.block[b].off[2*lower(i,j)];
+		RComplex<T2>& l = m.elem(spin(b,i),spin(b,j)).elem(color(i),color(j));
+		if (p->in)
+		{
+		  o[0] = l.real();
+		  o[1] = l.imag();
+		}
+		else
+		{
+		  RComplex<T2>& u = m.elem(spin(b,j),spin(b,i)).elem(color(j),color(i));
+		  l.real() = o[0];
+		  l.imag() = o[1];
+		  u.real() = o[0];
+		  u.imag() = -o[1];
+		}
+	      }
+	    }
+	}
+      }
+
+    //! user argument for inverse
+    struct InvArgs
+    {
+      InvArgs(PackedClover* d_, const PackedClover* a_) : d(d_), a(a_) {}
+
+      PackedClover* d;
+      const PackedClover* a;
+    };
+
+    //! user function for inverse
+    static void inverseKernel(int lo, int hi, int myId, InvArgs* p)
+      {
+	using namespace CloverInternal;
+
+	SmallMatrixInternal::CMat<nb> m;
+	for(int x=lo; x < hi; ++x)
+	  for(int b=0; b < 2; ++b)
+	  {
+	    const PackedCloverBlock<T>& a = p->a->elem(x).block[b];
+	    for(int i=0; i < nb; ++i)
+	    {
+	      m.re[i][i] = a.diag[i];
+	      m.im[i][i] = 0;
+	      for(int j=0; j < i; ++j)
+	      {
+		m.re[i][j] = m.re[j][i] = a.off[2*lower(i,j)];
+		m.im[i][j] = a.off[2*lower(i,j)+1];
+		m.im[j][i] = -m.im[i][j];
+	      }
+	    }
+
+	    SmallMatrixInternal::invert(m);
+
+	    // The inverse of a hermitian block is hermitian
+	    PackedCloverBlock<T>& d = p->d->elem(x).block[b];
+	    for(int i=0; i < nb; ++i)
+	    {
+	      d.diag[i] = m.re[i][i];
+	      for(int j=0; j < i; ++j)
+	      {
+		d.off[2*lower(i,j)]   = 0.5*(m.re[i][j] + m.re[j][i]);
+		d.off[2*lower(i,j)+1] = 0.5*(m.im[i][j] - m.im[j][i]);
+	      }
+	    }
+	  }
+      }
+
+    //! user argument for apply
+    struct ApplyArgs
+    {
+      typedef typename Fermion_t::Subtype_t F_t;
+
+      ApplyArgs(const PackedClover* c_, F_t* chi_, const F_t* psi_, const int* tab_) :
+	c(c_), chi(chi_), psi(psi_), tab(tab_) {}
+
+      const PackedClover* c;
+      F_t* chi;
+      const F_t* psi;
+      const int* tab;
+    };
+
+    //! user function for apply
+    static void applyKernel(int lo, int hi, int myId, ApplyArgs* p)
+      {
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int x = p->tab[j];
+	  applySite(p->chi[x], p->c->elem(x), p->psi[x]);
+	}
+      }
+
+    void alloc_mem()
+      {
+	if (Ns != 4)
+	  QDP_error_exit("PackedClover: needs Ns = 4, have %d", Ns);
+
+	size_t bytes = size_t(Layout::sitesOnNode())*sizeof(Site_t);
+	try
+	{
+	  F = (Site_t*)QDP::Allocator::theQDPAllocator::Instance().allocate(bytes, QDP::Allocator::DEFAULT);
+	}
+	catch(std::bad_alloc) {
+	  QDPIO::cerr << "Allocation failed in PackedClover: " << bytes << " bytes" << std::endl;
+	  QDP::Allocator::printAllocStats();
+	  QDP_abort(1);
+	}
+      }
+
+    void free_mem()
+      {
+	QDP::Allocator::theQDPAllocator::Instance().free(F);
+      }
+
+    Site_t* F;
+  };
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
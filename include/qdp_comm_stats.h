@@ -0,0 +1,118 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Statistics kept by the communications
+ */
+
+#ifndef QDP_COMM_STATS_H
+#define QDP_COMM_STATS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace QDP
+{
+  namespace CommStats
+  {
+
+    //! Channels every build has - the maps add their own after these
+    enum FixedChannel {Reduction = 0, Broadcast, Route, PointToPoint, NumFixedChannels};
+
+    //! Counts for one channel of this node
+    /*!
+     * A call is one exchange, collective or transfer. The overlap is
+     * the time from the start of the messages to the call that waits
+     * on them, which is spent doing other work for a split-phase map
+     * and is next to nothing otherwise. The wait is the time blocked
+     * until the messages are done, and for a collective its whole
+     * duration.
+     */
+    struct Counters
+    {
+      size_t calls;
+      size_t msgs_sent;
+      size_t msgs_recv;
+      size_t bytes_sent;        // for a collective the bytes contributed
+      size_t bytes_recv;
+      QDPTime_t overlap_ns;
+      QDPTime_t wait_ns;
+    };
+
+    //! Point-to-point traffic between this node and one other
+    struct PeerCounters
+    {
+      size_t msgs_sent;
+      size_t msgs_recv;
+      size_t bytes_sent;
+      size_t bytes_recv;
+    };
+
+    //! One message of an exchange
+    struct Message
+    {
+      int node;                 // the other end
+      size_t bytes;
+      bool send;
+    };
+
+    //! Number of channels so far
+    int numChannels();
+
+    //! The label of channel ch
+    const std::string& channelLabel(int ch);
+
+    //! The counts of channel ch on this node
+    const Counters& channelCounters(int ch);
+
+    //! Point-to-point traffic of this node keyed by the other node
+    const std::map<int, PeerCounters>& peerCounters();
+
+    //! Find or make the channel with this label
+    /*!
+     * Maps with the same label share a channel. As the summary combines
+     * the channels of all nodes, every node has to make them in the
+     * same order, as happens when the maps are built.
+     */
+    int channel(const std::string& label);
+
+    //! Zero all the counts, keeping the channels
+    void resetCommStats();
+
+    //! Print the statistics, combining all nodes - call on every node
+    /*!
+     * Each channel gets its totals over the nodes and the smallest,
+     * mean and largest wait of a node, so a slow network shows up in
+     * every node's wait while an imbalance shows up as a large spread.
+     * The traffic with each peer is that of the primary node.
+     */
+    void printCommStats();
+
+    //! Print the statistics from QDP_finalize
+    void setCommStatsAtFinalize(bool p);
+
+    //! Will QDP_finalize print the statistics
+    bool commStatsAtFinalize();
+
+    //! Hooks for the communications
+    namespace Stats
+    {
+      //! Messages started at t_start, waited on from t_wait and done at t_done
+      void noteExchange(int ch, const std::vector<Message>& msgs,
+			QDPTime_t t_start, QDPTime_t t_wait, QDPTime_t t_done);
+
+      //! A collective of bytes started at t_start, waited on from t_wait and done at t_done
+      void noteCollective(int ch, size_t bytes, QDPTime_t t_start, QDPTime_t t_wait, QDPTime_t t_done);
+
+      //! A blocking collective of bytes running from t_start to t_done
+      inline void noteCollective(int ch, size_t bytes, QDPTime_t t_start, QDPTime_t t_done)
+      {
+	noteCollective(ch, bytes, t_start, t_start, t_done);
+      }
+    }
+
+  } // namespace CommStats
+} // namespace QDP
+
+#endif
@@ -0,0 +1,358 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Gauge links stored in 12 or 8 reals
+ */
+
+#ifndef QDP_COMPRESSED_LINK_H
+#define QDP_COMPRESSED_LINK_H
+
+#include <cmath>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! SU(3) matrix kept as its first two rows
+  /*!
+   * The third row of an SU(3) matrix is the complex conjugate of the
+   * cross product of the first two, so 12 of the 18 reals are enough.
+   * Only exact for unitary matrices of determinant one.
+   */
+  template<class T>
+  struct PCompressedSU3_12
+  {
+    typedef PScalar< PColorMatrix< RComplex<T>, Nc> >  Link_t;
+
+    //! Number of reals kept
+    enum {Reals = 12};
+
+    //! Keep the first two rows of u
+    void compress(const Link_t& u)
+      {
+	for(int i=0; i < 2; ++i)
+	  for(int j=0; j < 3; ++j)
+	  {
+	    w[2*(3*i+j)]   = u.elem().elem(i,j).real();
+	    w[2*(3*i+j)+1] = u.elem().elem(i,j).imag();
+	  }
+      }
+
+    //! The full matrix
+    inline Link_t reconstruct() const
+      {
+	Link_t u;
+	for(int i=0; i < 2; ++i)
+	  for(int j=0; j < 3; ++j)
+	  {
+	    u.elem().elem(i,j).real() = w[2*(3*i+j)];
+	    u.elem().elem(i,j).imag() = w[2*(3*i+j)+1];
+	  }
+
+	// c = (a x b)^*
+	for(int j=0; j < 3; ++j)
+	{
+	  const int j1 = (j+1) % 3;
+	  const int j2 = (j+2) % 3;
+	  const T ar1 = w[2*j1], ai1 = w[2*j1+1], ar2 = w[2*j2], ai2 = w[2*j2+1];
+	  const T br1 = w[6+2*j1], bi1 = w[6+2*j1+1], br2 = w[6+2*j2], bi2 = w[6+2*j2+1];
+
+	  u.elem().elem(2,j).real() =   (ar1*br2 - ai1*bi2) - (ar2*br1 - ai2*bi1);
+	  u.elem().elem(2,j).imag() = -((ar1*bi2 + ai1*br2) - (ar2*bi1 + ai2*br1));
+	}
+
+	return u;
+      }
+
+    T w[12];
+  };
+
+
+  //! SU(3) matrix kept in 8 reals
+  /*!
+   * Keeps a2, a3 and b1 of
+   *
+   *       ( a1 a2 a3 )
+   *   u = ( b1 b2 b3 )
+   *       ( c1 c2 c3 )
+   *
+   * and the phases of a1 and c1. The moduli of a1 and c1 follow from
+   * the normalisation of the first row and column, the rest from
+   * unitarity and det u = 1. Only exact for SU(3) matrices, and loses
+   * precision when |a1| is close to one.
+   */
+  template<class T>
+  struct PCompressedSU3_8
+  {
+    typedef PScalar< PColorMatrix< RComplex<T>, Nc> >  Link_t;
+
+    //! Number of reals kept
+    enum {Reals = 8};
+
+    //! Keep the parameters of u
+    void compress(const Link_t& u)
+      {
+	const RComplex<T>& a1 = u.elem().elem(0,0);
+	const RComplex<T>& c1 = u.elem().elem(2,0);
+
+	w[0] = std::atan2(a1.imag(), a1.real());
+	w[1] = std::atan2(c1.imag(), c1.real());
+	w[2] = u.elem().elem(0,1).real();
+	w[3] = u.elem().elem(0,1).imag();
+	w[4] = u.elem().elem(0,2).real();
+	w[5] = u.elem().elem(0,2).imag();
+	w[6] = u.elem().elem(1,0).real();
+	w[7] = u.elem().elem(1,0).imag();
+      }
+
+    //! The full matrix
+    inline Link_t reconstruct() const
+      {
+	const T a2r = w[2], a2i = w[3], a3r = w[4], a3i = w[5];
+	const T b1r = w[6], b1i = w[7];
+
+	// |a2|^2 + |a3|^2 = 1 - |a1|^2
+	const T n = a2r*a2r + a2i*a2i + a3r*a3r + a3i*a3i;
+	const T m1 = std::sqrt(std::max(T(1) - n, T(0)));
+	const T a1r = m1*std::cos(w[0]), a1i = m1*std::sin(w[0]);
+
+	const T mc = std::sqrt(std::max(n - (b1r*b1r + b1i*b1i), T(0)));
+	const T c1r = mc*std::cos(w[1]), c1i = mc*std::sin(w[1]);
+
+	const T rn = T(-1) / n;
+
+	// conj(a1) * b1 and conj(a1) * c1
+	const T pbr = a1r*b1r + a1i*b1i, pbi = a1r*b1i - a1i*b1r;
+	const T pcr = a1r*c1r + a1i*c1i, pci = a1r*c1i - a1i*c1r;
+
+	Link_t u;
+	u.elem().elem(0,0) = RComplex<T>(a1r, a1i);
+	u.elem().elem(0,1) = RComplex<T>(a2r, a2i);
+	u.elem().elem(0,2) = RComplex<T>(a3r, a3i);
+	u.elem().elem(1,0) = RComplex<T>(b1r, b1i);
+	u.elem().elem(2,0) = RComplex<T>(c1r, c1i);
+
+	// b2 = -(conj(a1) b1 a2 + conj(a3) conj(c1)) / n
+	u.elem().elem(1,1) = RComplex<T>(rn*((pbr*a2r - pbi*a2i) + (a3r*c1r - a3i*c1i)),
+					 rn*((pbr*a2i + pbi*a2r) - (a3r*c1i + a3i*c1r)));
+
+	// b3 = -(conj(a1) b1 a3 - conj(a2) conj(c1)) / n
+	u.elem().elem(1,2) = RComplex<T>(rn*((pbr*a3r - pbi*a3i) - (a2r*c1r - a2i*c1i)),
+					 rn*((pbr*a3i + pbi*a3r) + (a2r*c1i + a2i*c1r)));
+
+	// c2 = -(conj(a1) c1 a2 - conj(a3) conj(b1)) / n
+	u.elem().elem(2,1) = RComplex<T>(rn*((pcr*a2r - pci*a2i) - (a3r*b1r - a3i*b1i)),
+					 rn*((pcr*a2i + pci*a2r) + (a3r*b1i + a3i*b1r)));
+
+	// c3 = -(conj(a1) c1 a3 + conj(a2) conj(b1)) / n
+	u.elem().elem(2,2) = RComplex<T>(rn*((pcr*a3r - pci*a3i) + (a2r*b1r - a2i*b1i)),
+					 rn*((pcr*a3i + pci*a3r) - (a2r*b1i + a2i*b1r)));
+
+	return u;
+      }
+
+    T w[8];
+  };
+
+
+  template<class S> class CompressedLinkLeaf;
+
+  //! A lattice of SU(3) links stored compressed
+  /*!
+   * S is PCompressedSU3_12 or PCompressedSU3_8 and says how each link
+   * is stored. The links are rebuilt site by site as an expression
+   * reads them, so e.g.
+   *
+   *   LatticeColorMatrix12 uc(u[mu]);
+   *   chi = uc * psi;
+   *
+   * streams 12 instead of 18 reals per link through memory and feeds
+   * the usual SU(3) times vector kernels. The links must be SU(3).
+   * The field cannot be shifted; expand(uc) gives it as an expression
+   * anywhere a LatticeColorMatrix would go.
+   */
+  template<class S>
+  class CompressedLinkField
+  {
+  public:
+    typedef typename S::Link_t  Link_t;
+
+    //! Uninitialized links
+    CompressedLinkField() {alloc_mem();}
+
+    //! The links of u
+    explicit CompressedLinkField(const OLattice<Link_t>& u) {alloc_mem(); compress(u);}
+
+    ~CompressedLinkField() {free_mem();}
+
+    //! Compress u in
+    CompressedLinkField& operator=(const OLattice<Link_t>& u)
+      {
+	compress(u);
+	return *this;
+      }
+
+    //! Link i rebuilt
+    inline Link_t elem(int i) const {return F[i].reconstruct();}
+
+    //! The stored links
+    const S* getF() const {return F;}
+
+  private:
+    //! Hide copies
+    CompressedLinkField(const CompressedLinkField&);
+    void operator=(const CompressedLinkField&);
+
+    //! user argument for compress
+    struct CompressArgs
+    {
+      CompressArgs(S* f_, const Link_t* u_) : f(f_), u(u_) {}
+
+      S* f;
+      const Link_t* u;
+    };
+
+    //! user function for compress
+    static void compressKernel(int lo, int hi, int myId, CompressArgs* a)
+      {
+	for(int i=lo; i < hi; ++i)
+	  a->f[i].compress(a->u[i]);
+      }
+
+    void compress(const OLattice<Link_t>& u)
+      {
+	CompressArgs a(F, u.getF());
+	dispatch_to_threads(Layout::sitesOnNode(), a, compressKernel);
+      }
+
+    void alloc_mem()
+      {
+	if (Nc != 3)
+	  QDP_error_exit("CompressedLinkField: needs Nc = 3, have %d", Nc);
+
+	size_t bytes = size_t(Layout::sitesOnNode())*sizeof(S);
+	try
+	{
+	  F = (S*)QDP::Allocator::theQDPAllocator::Instance().allocate(bytes, QDP::Allocator::DEFAULT);
+	}
+	catch(std::bad_alloc) {
+	  QDPIO::cerr << "Allocation failed in CompressedLinkField: " << bytes << " bytes" << std::endl;
+	  QDP::Allocator::printAllocStats();
+	  QDP_abort(1);
+	}
+      }
+
+    void free_mem()
+      {
+	QDP::Allocator::theQDPAllocator::Instance().free(F);
+      }
+
+    S* F;
+  };
+
+
+  //! Expression tree leaf rebuilding the links of a CompressedLinkField
+  template<class S>
+  class CompressedLinkLeaf
+  {
+  public:
+    CompressedLinkLeaf(const CompressedLinkField<S>& u_) : u(&u_) {}
+
+    inline typename S::Link_t elem(int i) const {return u->elem(i);}
+
+  private:
+    const CompressedLinkField<S>* u;
+  };
+
+  template<class S>
+  struct LeafFunctor<CompressedLinkLeaf<S>, EvalLeaf1>
+  {
+    typedef typename S::Link_t Type_t;
+    inline static Type_t apply(const CompressedLinkLeaf<S> &a, const EvalLeaf1 &f)
+      {return a.elem(f.val1());}
+  };
+
+#if defined(QDP_USE_PROFILING)
+  template<class S>
+  struct LeafFunctor<CompressedLinkLeaf<S>, PrintTag>
+  {
+    typedef int Type_t;
+    static int apply(const CompressedLinkLeaf<S> &s, const PrintTag &f)
+      {
+	f.os_m << "compressed(OLat<";
+	LeafFunctor<typename S::Link_t,PrintTag>::apply(s.elem(0),f);
+	f.os_m << ">)";
+	return 0;
+      }
+  };
+#endif
+
+  template<class S>
+  struct LeafFunctor<CompressedLinkLeaf<S>, ByteCountLeaf>
+  {
+    typedef int Type_t;
+    inline static Type_t apply(const CompressedLinkLeaf<S> &s, const ByteCountLeaf &f)
+      {return sizeof(S);}
+  };
+
+  template<class S>
+  struct LeafFunctor<CompressedLinkLeaf<S>, FlopCountLeaf>
+  {
+    typedef ExprFlops<typename S::Link_t> Type_t;
+    inline static Type_t apply(const CompressedLinkLeaf<S> &s, const FlopCountLeaf &f) {return Type_t();}
+  };
+
+
+  //! The links of u as an expression
+  template<class S>
+  inline typename MakeReturn<CompressedLinkLeaf<S>, OLattice<typename S::Link_t> >::Expression_t
+  expand(const CompressedLinkField<S>& u)
+  {
+    typedef CompressedLinkLeaf<S> Tree_t;
+    return MakeReturn<Tree_t, OLattice<typename S::Link_t> >::make(Tree_t(u));
+  }
+
+  //! adj(u) of compressed links
+  template<class S>
+  inline typename MakeReturn<UnaryNode<FnAdjoint, CompressedLinkLeaf<S> >,
+    OLattice<typename S::Link_t> >::Expression_t
+  adj(const CompressedLinkField<S>& u)
+  {
+    return adj(expand(u));
+  }
+
+  //! u * r with compressed links u
+  template<class S, class T2, class C2>
+  inline typename MakeReturn<BinaryNode<OpMultiply, CompressedLinkLeaf<S>,
+    typename CreateLeaf<QDPType<T2,C2> >::Leaf_t>,
+    typename BinaryReturn<OLattice<typename S::Link_t>, C2, OpMultiply>::Type_t>::Expression_t
+  operator*(const CompressedLinkField<S>& u, const QDPType<T2,C2>& r)
+  {
+    return expand(u) * r;
+  }
+
+  //! u * r with compressed links u
+  template<class S, class T2, class C2>
+  inline typename MakeReturn<BinaryNode<OpMultiply, CompressedLinkLeaf<S>,
+    typename CreateLeaf<QDPExpr<T2,C2> >::Leaf_t>,
+    typename BinaryReturn<OLattice<typename S::Link_t>, C2, OpMultiply>::Type_t>::Expression_t
+  operator*(const CompressedLinkField<S>& u, const QDPExpr<T2,C2>& r)
+  {
+    return expand(u) * r;
+  }
+
+
+  //! Links of the working precision in 12 reals
+  typedef CompressedLinkField< PCompressedSU3_12<REAL> >  LatticeColorMatrix12;
+
+  //! Links of the working precision in 8 reals
+  typedef CompressedLinkField< PCompressedSU3_8<REAL> >   LatticeColorMatrix8;
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,628 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Correlator contractions and projections of many channels in one sweep
+ */
+
+#ifndef QDP_CONTRACT_H
+#define QDP_CONTRACT_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace ContractInternal
+  {
+    //! The Ns*Ns products Gamma(n) as signed permutations
+    /*!
+     * Gamma(n) has the single entry phase[n][i] in row i, at column
+     * perm[pidx[n]][i]. The gammas share few permutations - four for
+     * Ns = 4 - so the colour traces behind every channel are computed
+     * once per permutation.
+     */
+    struct GammaTable
+    {
+      GammaTable()
+	{
+	  SpinMatrixD one = Double(1);
+	  for(int n=0; n < Ns*Ns; ++n)
+	  {
+	    SpinMatrixD g = Gamma(n) * one;
+
+	    std::vector<int> p(Ns);
+	    for(int i=0; i < Ns; ++i)
+	      for(int j=0; j < Ns; ++j)
+	      {
+		const RComplex<REAL64>& z = g.elem().elem(i,j).elem();
+		if (z.real() != 0 || z.imag() != 0)
+		{
+		  p[i] = j;
+		  phase_re[n][i] = z.real();
+		  phase_im[n][i] = z.imag();
+		}
+	      }
+
+	    pidx[n] = std::find(perm.begin(), perm.end(), p) - perm.begin();
+	    if (pidx[n] == perm.size())
+	      perm.push_back(p);
+	  }
+	}
+
+      std::vector< std::vector<int> > perm;
+      int pidx[Ns*Ns];
+      REAL64 phase_re[Ns*Ns][Ns], phase_im[Ns*Ns][Ns];
+    };
+
+    //! The table, built on first use
+    inline const GammaTable& gammaTable()
+    {
+      static const GammaTable table;
+      return table;
+    }
+
+    //! user argument for gammaTraceKernel
+    template<class T>
+    struct Args
+    {
+      typedef PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns>  Prop_t;
+
+      const Prop_t* a;
+      const Prop_t* q;
+      std::vector<const LatticeComplex*> phases;   // none for a plain sum
+      const int* color;
+      int nsub;
+      std::vector< std::vector<REAL64> >* part;    // per thread [p][n][subset][re,im]
+    };
+
+    //! user function accumulating the traces of sites [lo,hi) by subset
+    /*!
+     * With Gamma(n)_{jk} = c(j) delta(k,pi(j)) the trace is
+     * sum_{j,l} c(j) c(l) tr_colour[adj(a_{j pi(l)}) q_{pi(j) l}],
+     * so each site reads both propagators once and runs Ns*Ns colour
+     * traces per distinct permutation.
+     */
+    template<class T>
+    void gammaTraceKernel(int lo, int hi, int myId, Args<T>* a)
+    {
+      const GammaTable& gt = gammaTable();
+      const int nperm = gt.perm.size();
+      const int nph = a->phases.empty() ? 1 : a->phases.size();
+      std::vector<REAL64>& part = (*a->part)[myId];
+
+      REAL64* dre = Allocator::threadScratch<REAL64>(nperm*Ns*Ns, 0);
+      REAL64* dim = Allocator::threadScratch<REAL64>(nperm*Ns*Ns, 1);
+
+      for(int x=lo; x < hi; ++x)
+      {
+	const typename Args<T>::Prop_t& A = a->a[x];
+	const typename Args<T>::Prop_t& Q = a->q[x];
+
+	for(int p=0; p < nperm; ++p)
+	{
+	  const std::vector<int>& pi = gt.perm[p];
+	  for(int j=0; j < Ns; ++j)
+	    for(int l=0; l < Ns; ++l)
+	    {
+	      const PColorMatrix<RComplex<T>,Nc>& X = A.elem(j,pi[l]);
+	      const PColorMatrix<RComplex<T>,Nc>& Y = Q.elem(pi[j],l);
+
+	      REAL64 re = 0, im = 0;
+	      for(int b=0; b < Nc; ++b)
+		for(int c=0; c < Nc; ++c)
+		{
+		  REAL64 xr = X.elem(b,c).real(), xi = X.elem(b,c).imag();
+		  REAL64 yr = Y.elem(b,c).real(), yi = Y.elem(b,c).imag();
+		  re += xr*yr + xi*yi;
+		  im += xr*yi - xi*yr;
+		}
+
+	      dre[(p*Ns + j)*Ns + l] = re;
+	      dim[(p*Ns + j)*Ns + l] = im;
+	    }
+	}
+
+	const int k = a->color[x];
+	for(int n=0; n < Ns*Ns; ++n)
+	{
+	  const REAL64* cre = gt.phase_re[n];
+	  const REAL64* cim = gt.phase_im[n];
+	  const int off = gt.pidx[n]*Ns*Ns;
+
+	  REAL64 tre = 0, tim = 0;
+	  for(int j=0; j < Ns; ++j)
+	    for(int l=0; l < Ns; ++l)
+	    {
+	      REAL64 pr = cre[j]*cre[l] - cim[j]*cim[l];
+	      REAL64 pim = cre[j]*cim[l] + cim[j]*cre[l];
+	      REAL64 dr = dre[off + j*Ns + l], di = dim[off + j*Ns + l];
+	      tre += pr*dr - pim*di;
+	      tim += pr*di + pim*dr;
+	    }
+
+	  for(int ph=0; ph < nph; ++ph)
+	  {
+	    REAL64 wr = 1, wi = 0;
+	    if (! a->phases.empty())
+	    {
+	      const RComplex<REAL>& w = a->phases[ph]->elem(x).elem().elem();
+	      wr = w.real();
+	      wi = w.imag();
+	    }
+
+	    REAL64* d = &part[2*((ph*Ns*Ns + n)*a->nsub + k)];
+	    d[0] += wr*tre - wi*tim;
+	    d[1] += wr*tim + wi*tre;
+	  }
+	}
+      }
+    }
+
+    //! The traces of a and q summed over the subsets of ss, weighted by each of phases
+    template<class T>
+    multi1d< multi1d< multi1d<DComplex> > >
+    sumMultiGammaTraces(const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& a,
+			const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& q,
+			const multi1d<LatticeComplex>* phases, const Set& ss)
+    {
+      const int nsub = ss.numSubsets();
+      const int nph = (phases == 0) ? 1 : phases->size();
+      const int nwords = 2*nph*Ns*Ns*nsub;
+
+      std::vector< std::vector<REAL64> > part(qdpNumThreads(), std::vector<REAL64>(nwords, 0.0));
+
+      Args<T> args;
+      args.a = &a.elem(0);
+      args.q = &q.elem(0);
+      if (phases != 0)
+	for(int ph=0; ph < nph; ++ph)
+	  args.phases.push_back(&(*phases)[ph]);
+      args.color = ss.latticeColoring().slice();
+      args.nsub = nsub;
+      args.part = &part;
+
+      gammaTable();    // built before the threads start
+      dispatch_to_threads(Layout::sitesOnNode(), args, gammaTraceKernel<T>);
+
+      // Combine in thread order so the result does not depend on the scheduling
+      std::vector<REAL64> sum(nwords, 0.0);
+      for(int thread=0; thread < part.size(); ++thread)
+	for(int w=0; w < nwords; ++w)
+	  sum[w] += part[thread][w];
+
+      QDPInternal::globalSumArray(&sum[0], nwords);
+
+      multi1d< multi1d< multi1d<DComplex> > > dest(nph);
+      for(int ph=0; ph < nph; ++ph)
+      {
+	dest[ph].resize(Ns*Ns);
+	for(int n=0; n < Ns*Ns; ++n)
+	{
+	  dest[ph][n].resize(nsub);
+	  for(int k=0; k < nsub; ++k)
+	  {
+	    const REAL64* d = &sum[2*((ph*Ns*Ns + n)*nsub + k)];
+	    dest[ph][n][k] = cmplx(Double(d[0]), Double(d[1]));
+	  }
+	}
+      }
+
+      return dest;
+    }
+  }
+
+
+  //! tr[adj(a) Gamma(n) q Gamma(n)] summed over each subset of ss, for all Ns*Ns gammas
+  /*!
+   * The result is indexed [n][subset]. All channels come out of one
+   * threaded sweep reading each propagator once, where a loop over
+   *
+   *   sumMulti(trace(adj(a) * Gamma(n) * q * Gamma(n)), ss)
+   *
+   * reads both Ns*Ns times. The meson two-point function of channel n
+   * is the real part with a = Gamma(15) * q2 * Gamma(15). Partial sums
+   * are combined in thread order, so the result is reproducible for a
+   * given number of threads.
+   */
+  template<class T>
+  multi1d< multi1d<DComplex> >
+  sumMultiGammaTraces(const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& a,
+		      const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& q,
+		      const Set& ss)
+  {
+    return ContractInternal::sumMultiGammaTraces(a, q, 0, ss)[0];
+  }
+
+
+  //! The same weighted by each of phases, such as exp(i p.x) for momenta p
+  /*! The result is indexed [phase][n][subset], still from a single sweep */
+  template<class T>
+  multi1d< multi1d< multi1d<DComplex> > >
+  sumMultiGammaTraces(const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& a,
+		      const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& q,
+		      const multi1d<LatticeComplex>& phases, const Set& ss)
+  {
+    return ContractInternal::sumMultiGammaTraces(a, q, &phases, ss);
+  }
+
+
+  //! One channel of sumMultiBaryons
+  /*!
+   * With the diquark D = quarkContract13(q1 * cg, cg * q2) the channel
+   * is tr[proj * traceColor(q3 * traceSpin(D))] + cross * tr[proj *
+   * traceColor(q3 * D)]. The proton has cg = C gamma_5 = Gamma(5) and
+   * cross = 1, the Delta^+ has cg = C gamma_- and cross = 2.
+   */
+  struct BaryonChannel
+  {
+    BaryonChannel() : cross(1) {}
+    BaryonChannel(const SpinMatrix& cg_, const SpinMatrix& proj_, const Real& cross_) :
+      cg(cg_), proj(proj_), cross(cross_) {}
+
+    SpinMatrix cg;      //!< diquark spin structure
+    SpinMatrix proj;    //!< spin projector of the baryon
+    Real cross;         //!< weight of the exchange term
+  };
+
+
+  namespace ContractInternal
+  {
+    //! A nonzero entry m(r,c) of a spin matrix
+    struct SpinEntry
+    {
+      int r, c;
+      REAL64 re, im;
+    };
+
+    //! The nonzero entries of a spin matrix
+    inline std::vector<SpinEntry> spinEntries(const SpinMatrix& m)
+    {
+      std::vector<SpinEntry> e;
+      for(int r=0; r < Ns; ++r)
+	for(int c=0; c < Ns; ++c)
+	{
+	  SpinEntry z = {r, c, REAL64(m.elem().elem(r,c).elem().real()), REAL64(m.elem().elem(r,c).elem().imag())};
+	  if (z.re != 0 || z.im != 0)
+	    e.push_back(z);
+	}
+      return e;
+    }
+
+    //! re + i im += z tr(x y)
+    template<class T>
+    inline void traceProd(const PColorMatrix<RComplex<T>,Nc>& x, const PColorMatrix<RComplex<T>,Nc>& y,
+			  REAL64 zr, REAL64 zi, REAL64& re, REAL64& im)
+    {
+      REAL64 tr = 0, ti = 0;
+      for(int b=0; b < Nc; ++b)
+	for(int c=0; c < Nc; ++c)
+	{
+	  REAL64 xr = x.elem(b,c).real(), xi = x.elem(b,c).imag();
+	  REAL64 yr = y.elem(c,b).real(), yi = y.elem(c,b).imag();
+	  tr += xr*yr - xi*yi;
+	  ti += xr*yi + xi*yr;
+	}
+      re += zr*tr - zi*ti;
+      im += zr*ti + zi*tr;
+    }
+
+    //! user argument for baryonKernel
+    template<class T>
+    struct BaryonArgs
+    {
+      typedef PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns>  Prop_t;
+
+      const Prop_t* q1;
+      const Prop_t* q2;
+      const Prop_t* q3;
+      std::vector< std::vector<SpinEntry> > cg, proj;   // of each channel
+      std::vector<REAL64> cross;
+      const int* color;
+      int nsub;
+      std::vector< std::vector<REAL64> >* part;    // per thread [channel][subset][re,im]
+    };
+
+    //! user function accumulating the channels of sites [lo,hi) by subset
+    /*!
+     * The diquark D_ij = sum_k eps eps (q1 cg)_ki (cg q2)_kj is built on
+     * the stack from the nonzero entries of cg, skipping the columns of
+     * cg that are zero, and the two traces run only over the nonzero
+     * entries of proj. Nothing of a site goes back to memory.
+     */
+    template<class T>
+    void baryonKernel(int lo, int hi, int myId, BaryonArgs<T>* a)
+    {
+      typedef typename BaryonArgs<T>::Prop_t  Prop_t;
+      typedef PColorMatrix< RComplex<T>, Nc>  CM;
+
+      const int nchan = a->cg.size();
+      std::vector<REAL64>& part = (*a->part)[myId];
+
+      CM A[Ns][Ns], B[Ns][Ns], D[Ns][Ns], M;
+
+      for(int x=lo; x < hi; ++x)
+      {
+	const Prop_t& q1 = a->q1[x];
+	const Prop_t& q2 = a->q2[x];
+	const Prop_t& q3 = a->q3[x];
+	const int k = a->color[x];
+
+	for(int ch=0; ch < nchan; ++ch)
+	{
+	  const std::vector<SpinEntry>& cg = a->cg[ch];
+	  const std::vector<SpinEntry>& proj = a->proj[ch];
+
+	  // A = q1 cg and B = cg q2 on the columns and rows of cg in use
+	  bool acol[Ns], brow[Ns];
+	  for(int s=0; s < Ns; ++s)
+	  {
+	    acol[s] = brow[s] = false;
+	    for(int t=0; t < Ns; ++t)
+	    {
+	      zero_rep(A[t][s]);
+	      zero_rep(B[s][t]);
+	    }
+	  }
+
+	  for(int e=0; e < cg.size(); ++e)
+	  {
+	    const RComplex<T> v(cg[e].re, cg[e].im);
+	    acol[cg[e].c] = brow[cg[e].r] = true;
+	    for(int t=0; t < Ns; ++t)
+	      for(int b=0; b < Nc; ++b)
+		for(int c=0; c < Nc; ++c)
+		{
+		  A[t][cg[e].c].elem(b,c) += q1.elem(t,cg[e].r).elem(b,c) * v;
+		  B[cg[e].r][t].elem(b,c) += v * q2.elem(cg[e].c,t).elem(b,c);
+		}
+	  }
+
+	  // D = quarkContract13(A, B), and M = traceSpin(D)
+	  zero_rep(M);
+	  for(int i=0; i < Ns; ++i)
+	    for(int j=0; j < Ns; ++j)
+	    {
+	      zero_rep(D[i][j]);
+	      if (! acol[i])
+		continue;
+	      for(int t=0; t < Ns; ++t)
+		if (brow[t])
+		  D[i][j] += quarkContractXX(A[t][i], B[t][j]);
+	      if (i == j)
+		M += D[i][i];
+	    }
+
+	  // tr[proj traceColor(q3 M)] + cross tr[proj traceColor(q3 D)]
+	  REAL64 dre = 0, dim = 0, ere = 0, eim = 0;
+	  for(int e=0; e < proj.size(); ++e)
+	  {
+	    const int j = proj[e].r, i = proj[e].c;
+	    traceProd(q3.elem(i,j), M, proj[e].re, proj[e].im, dre, dim);
+	    for(int t=0; t < Ns; ++t)
+	      if (acol[t])
+		traceProd(q3.elem(i,t), D[t][j], proj[e].re, proj[e].im, ere, eim);
+	  }
+
+	  REAL64* d = &part[2*(ch*a->nsub + k)];
+	  d[0] += dre + a->cross[ch]*ere;
+	  d[1] += dim + a->cross[ch]*eim;
+	}
+      }
+    }
+  }
+
+
+  //! The baryon channels of q1, q2, q3 summed over each subset of ss
+  /*!
+   * The result is indexed [channel][subset]. Every channel of a site is
+   * contracted from the three propagators of the site in one threaded
+   * sweep, so no diquark or traced field is made. For degenerate quarks
+   * pass the same propagator three times. Partial sums are combined in
+   * thread order. Needs Nc = 3, as quarkContract13 does.
+   */
+  template<class T>
+  multi1d< multi1d<DComplex> >
+  sumMultiBaryons(const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& q1,
+		  const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& q2,
+		  const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& q3,
+		  const multi1d<BaryonChannel>& chan, const Set& ss)
+  {
+    typedef ContractInternal::BaryonArgs<T>  Args_t;
+
+    const int nsub = ss.numSubsets();
+    const int nwords = 2*chan.size()*nsub;
+
+    Args_t args;
+    args.q1 = &q1.elem(0);
+    args.q2 = &q2.elem(0);
+    args.q3 = &q3.elem(0);
+    for(int c=0; c < chan.size(); ++c)
+    {
+      args.cg.push_back(ContractInternal::spinEntries(chan[c].cg));
+      args.proj.push_back(ContractInternal::spinEntries(chan[c].proj));
+      args.cross.push_back(toDouble(chan[c].cross));
+    }
+    args.color = ss.latticeColoring().slice();
+    args.nsub = nsub;
+
+    std::vector< std::vector<REAL64> > part(qdpNumThreads(), std::vector<REAL64>(nwords, 0.0));
+    args.part = &part;
+
+    dispatch_to_threads(Layout::sitesOnNode(), args, ContractInternal::baryonKernel<T>);
+
+    // Combine in thread order so the result does not depend on the scheduling
+    std::vector<REAL64> sum(nwords, 0.0);
+    for(int thread=0; thread < part.size(); ++thread)
+      for(int w=0; w < nwords; ++w)
+	sum[w] += part[thread][w];
+
+    QDPInternal::globalSumArray(&sum[0], nwords);
+
+    multi1d< multi1d<DComplex> > dest(chan.size());
+    for(int c=0; c < chan.size(); ++c)
+    {
+      dest[c].resize(nsub);
+      for(int k=0; k < nsub; ++k)
+	dest[c][k] = cmplx(Double(sum[2*(c*nsub + k)]), Double(sum[2*(c*nsub + k) + 1]));
+    }
+
+    return dest;
+  }
+
+  namespace ContractInternal
+  {
+    //! user argument for momentaKernel
+    template<class RHS, class T, class S>
+    struct MomentaArgs
+    {
+      MomentaArgs(const QDPExpr<RHS,OLattice<T> >& s_) : s(s_) {}
+
+      const QDPExpr<RHS,OLattice<T> >& s;
+      const int* color;
+      int nsub;
+      int nmom;
+      std::vector< std::vector<int> > dirs;   // of each momentum, the directions with p_mu != 0
+      std::vector< std::vector< std::vector<REAL64> > > tab;  // [mom][mu] exp(i 2 pi p_mu x/L_mu), re and im
+      std::vector< multi1d<S> >* part;        // per thread [mom][subset]
+    };
+
+    //! user function summing exp(i p.x) s(x) over sites [lo,hi) for every momentum
+    template<class RHS, class T, class S>
+    void momentaKernel(int lo, int hi, int myId, MomentaArgs<RHS,T,S>* a)
+    {
+      typedef typename WordType<T>::Type_t  W;
+      multi1d<S>& d = (*a->part)[myId];
+      const int node = Layout::nodeNumber();
+      Layout::LatticeCoord x;
+
+      for(int i=lo; i < hi; ++i)
+      {
+	T v = forEach(a->s, EvalLeaf1(i), OpCombine());
+	Layout::siteCoords(node, i, x);
+	const int k = a->color[i];
+
+	for(int m=0; m < a->nmom; ++m)
+	{
+	  REAL64 re = 1, im = 0;
+	  for(int n=0; n < a->dirs[m].size(); ++n)
+	  {
+	    const int mu = a->dirs[m][n];
+	    const REAL64* z = &a->tab[m][mu][2*x[mu]];
+	    REAL64 t = re*z[0] - im*z[1];
+	    im = re*z[1] + im*z[0];
+	    re = t;
+	  }
+
+	  PScalar< PScalar< RComplex<W> > > phase;
+	  phase.elem().elem() = RComplex<W>(re, im);
+	  d[m*a->nsub + k].elem() += phase * v;
+	}
+      }
+    }
+  }
+
+
+  //! sum_x exp(i p.x) s(x) over each subset of ss, for every momentum p of moms
+  /*!
+   * Each momentum is Nd integers, p.x being sum_mu 2 pi p_mu x_mu / L_mu,
+   * and the result is indexed [mom][subset]. The expression is evaluated
+   * once a site and the phases are multiplied up from one small table
+   * per direction, so no phase field is made, the lattice is swept once
+   * for all the momenta and there is a single global sum. Multiply by
+   * exp(-i p.x0) for a source at x0, or pass -p for the other sign.
+   * Partial sums are combined in thread order.
+   */
+  template<class RHS, class T>
+  multi2d<typename UnaryReturn<OLattice<typename BinaryReturn<PScalar<PScalar<RComplex<typename WordType<T>::Type_t> > >,
+								T, OpMultiply>::Type_t>, FnSum>::Type_t>
+  sumMultiMomenta(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss, const multi1d< multi1d<int> >& moms)
+  {
+    typedef PScalar< PScalar< RComplex<typename WordType<T>::Type_t> > >  C_t;
+    typedef typename BinaryReturn<C_t, T, OpMultiply>::Type_t  TC;
+    typedef typename UnaryReturn<OLattice<TC>, FnSum>::Type_t  S;
+
+    const multi1d<int>& latt = Layout::lattSize();
+    const int nsub = ss.numSubsets();
+    const int nmom = moms.size();
+
+    typedef ContractInternal::MomentaArgs<RHS,T,S>  Args_t;
+    Args_t args(s1);
+    args.color = ss.latticeColoring().slice();
+    args.nsub = nsub;
+    args.nmom = nmom;
+    args.dirs.resize(nmom);
+    args.tab.resize(nmom);
+    for(int m=0; m < nmom; ++m)
+    {
+      if (moms[m].size() != Nd)
+	QDP_error_exit("sumMultiMomenta: momentum %d has %d components, not %d", m, moms[m].size(), Nd);
+
+      args.tab[m].resize(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	if (moms[m][mu] == 0)
+	  continue;
+	args.dirs[m].push_back(mu);
+	args.tab[m][mu].resize(2*latt[mu]);
+	for(int x=0; x < latt[mu]; ++x)
+	{
+	  // Reduce p x mod L first so the phase is exact for large momenta
+	  long long px = ((long long)(moms[m][mu]) * x) % latt[mu];
+	  REAL64 arg = 2*M_PI*REAL64(px)/REAL64(latt[mu]);
+	  args.tab[m][mu][2*x] = std::cos(arg);
+	  args.tab[m][mu][2*x+1] = std::sin(arg);
+	}
+      }
+    }
+
+    std::vector< multi1d<S> > part(qdpNumThreads());
+    for(int thread=0; thread < part.size(); ++thread)
+    {
+      part[thread].resize(nmom*nsub);
+      for(int j=0; j < part[thread].size(); ++j)
+	zero_rep(part[thread][j]);
+    }
+    args.part = &part;
+
+    startShifts(s1);
+    dispatch_to_threads(Layout::sitesOnNode(), args, ContractInternal::momentaKernel<RHS,T,S>);
+
+    // Combine in thread order, then one global sum for everything
+    multi1d<S> sum(nmom*nsub);
+    for(int j=0; j < sum.size(); ++j)
+    {
+      sum[j] = part[0][j];
+      for(int thread=1; thread < part.size(); ++thread)
+	sum[j] += part[thread][j];
+    }
+
+    QDPInternal::globalSumArray(sum);
+
+    multi2d<S> dest(nmom, nsub);
+    for(int m=0; m < nmom; ++m)
+      for(int k=0; k < nsub; ++k)
+	dest(m,k) = sum[m*nsub + k];
+
+    return dest;
+  }
+
+  //! sum_x exp(i p.x) s(x) over each subset of ss, for a lattice field
+  template<class T>
+  multi2d<typename UnaryReturn<OLattice<typename BinaryReturn<PScalar<PScalar<RComplex<typename WordType<T>::Type_t> > >,
+								T, OpMultiply>::Type_t>, FnSum>::Type_t>
+  sumMultiMomenta(const OLattice<T>& s1, const Set& ss, const multi1d< multi1d<int> >& moms)
+  {
+    return sumMultiMomenta(PETE_identity(s1), ss, moms);
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
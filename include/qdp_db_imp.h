@@ -9,6 +9,9 @@
 #include "qdp_layout.h"
 #include "ConfDataStoreDB.h"
 
+#include <list>
+#include <map>
+
 namespace QDP
 {
   /*! @defgroup io IO
@@ -43,6 +46,8 @@ namespace QDP
      */
     BinaryStoreDB ()
     {
+      value_cache_max = 0;
+
       // Initialize default values
       if (Layout::primaryNode())
       {
@@ -119,6 +124,23 @@ namespace QDP
     }
 
 
+    /**
+     * Keep deserialised values for random access
+     *
+     * get() keeps up to num of the values it has read, dropping the least
+     * recently used, and returns a kept value without going to the file.
+     * 0, the default, keeps none.
+     *
+     * @param num the number of values to keep
+     */
+    virtual void setValueCache (const unsigned int num)
+    {
+      value_cache_max = num;
+      while (value_cache.size() > value_cache_max)
+	dropOldestValue();
+    }
+
+
     /**
      * Set whether to move pages when close to save disk space
      *
@@ -218,6 +240,7 @@ namespace QDP
     virtual void close (void)
     {
       int ret = 0;
+      clearValues();
       if (Layout::primaryNode()) 
 	ret = db.close();
 
@@ -258,7 +281,10 @@ namespace QDP
     {
       int ret = 0;
       if (Layout::primaryNode()) 
+      {
+	forgetValue(binaryKey(key));
 	ret = db.insert(key, data);
+      }
 
       QDPInternal::broadcast(ret);
       if (ret != 0)
@@ -280,7 +306,10 @@ namespace QDP
     {
       int ret = 0;
       if (Layout::primaryNode()) 
+      {
+	forgetValue(key);
 	ret = db.insertBinary(key, data);
+      }
 
       QDPInternal::broadcast(ret);
       if (ret != 0)
@@ -301,7 +330,7 @@ namespace QDP
     {
       int ret = 0;
       if (Layout::primaryNode()) 
-	ret = db.get(key, data);
+	ret = (value_cache_max > 0) ? getCached(key, data) : db.get(key, data);
       else
 	notImplemented();
 
@@ -450,7 +479,144 @@ namespace QDP
       QDP_error_exit("FILEDB read routines do not work (yet) in parallel - only single node");
     }
 
+    //! The key as it is stored
+    static std::string binaryKey(const K& key)
+    {
+      std::string bk;
+      key.writeObject(bk);
+      return bk;
+    }
+
+    //! get() through the kept values
+    int getCached(const K& key, D& data)
+    {
+      const std::string bk = binaryKey(key);
+      typename ValueMap::iterator v = value_index.find(bk);
+      if (v != value_index.end())
+      {
+	// Most recently used goes to the front
+	value_cache.splice(value_cache.begin(), value_cache, v->second);
+	data = v->second->second;
+	return 0;
+      }
+
+      int ret = db.get(key, data);
+      if (ret == 0)
+      {
+	value_cache.push_front(std::make_pair(bk, data));
+	value_index[bk] = value_cache.begin();
+	if (value_cache.size() > value_cache_max)
+	  dropOldestValue();
+      }
+      return ret;
+    }
+
+    void dropOldestValue()
+    {
+      value_index.erase(value_cache.back().first);
+      value_cache.pop_back();
+    }
+
+    void forgetValue(const std::string& bk)
+    {
+      typename ValueMap::iterator v = value_index.find(bk);
+      if (v != value_index.end())
+      {
+	value_cache.erase(v->second);
+	value_index.erase(v);
+      }
+    }
+
+    void clearValues()
+    {
+      value_cache.clear();
+      value_index.clear();
+    }
+
     FILEDB::ConfDataStoreDB<K,D> db;
+
+    typedef std::list< std::pair<std::string, D> > ValueList;
+    typedef std::map<std::string, typename ValueList::iterator> ValueMap;
+    ValueList value_cache;         // most recently used first
+    ValueMap value_index;
+    unsigned int value_cache_max;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Walks the pairs of a BinaryStoreDB without holding all the values
+  /*!
+    Unlike keysAndData, only the keys and a batch of values are held. The
+    values are fetched in batches of read_ahead, in the order of keys(),
+    which is the order of the pages of the file, so the pages are read one
+    after the other. Like get() and keys(), only on a single node.
+
+      BinaryStoreDBScan<K,D> scan(db);
+      K key;
+      D val;
+      while (scan.next(key, val))
+        ...
+  */
+  template<typename K, typename D>
+  class BinaryStoreDBScan
+  {
+  public:
+    //! Scan db, fetching read_ahead values at a time
+    BinaryStoreDBScan(BinaryStoreDB<K,D>& db_, unsigned int read_ahead = 64) : 
+      db(db_), ahead(read_ahead > 0 ? read_ahead : 1), pos(0), batch_pos(0)
+    {
+      db.keys(all_keys);
+    }
+
+    //! Number of pairs in the database
+    size_t size() const {return all_keys.size();}
+
+    //! The next pair, false once all have been seen
+    bool next(K& key, D& data)
+    {
+      if (batch_pos == batch.size())
+      {
+	fill();
+	if (batch.empty())
+	  return false;
+      }
+
+      key  = all_keys[pos - batch.size() + batch_pos];
+      data = batch[batch_pos++];
+      return true;
+    }
+
+    //! Start again from the first pair
+    void rewind()
+    {
+      pos = 0;
+      batch.clear();
+      batch_pos = 0;
+    }
+
+  private:
+    //! Fetch the values of the next batch of keys
+    void fill()
+    {
+      batch.clear();
+      batch_pos = 0;
+      for(; pos < all_keys.size() && batch.size() < ahead; ++pos)
+      {
+	batch.push_back(D());
+	if (db.get(all_keys[pos], batch.back()) != 0)
+	{
+	  QDPIO::cerr << __func__ << ": key of the scan not found in db" << std::endl;
+	  QDP_abort(1);
+	}
+      }
+    }
+
+    BinaryStoreDB<K,D>& db;
+    size_t ahead;
+    std::vector<K> all_keys;
+    size_t pos;                // keys fetched so far
+    std::vector<D> batch;
+    size_t batch_pos;          // next of the batch to hand out
   };
 
 
@@ -206,6 +206,14 @@ o     *
     virtual void setNumberBuckets (const unsigned int num) {notImplemented();}
 
 
+    /**
+     * Keep deserialised values for random access
+     *
+     * @param num the number of values to keep
+     */
+    virtual void setValueCache (const unsigned int num) {notImplemented();}
+
+
     /**
      * Set whether to move pages when close to save disk space
      *
@@ -355,6 +363,29 @@ o     *
 	QDP_abort(1);
       }
   };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Walks the pairs of a BinaryStoreDB without holding all the values
+  template<typename K, typename D>
+  class BinaryStoreDBScan
+  {
+  public:
+    BinaryStoreDBScan(BinaryStoreDB<K,D>& db_, unsigned int read_ahead = 64) {notImplemented();}
+
+    size_t size() const {notImplemented(); return 0;}
+
+    bool next(K& key, D& data) {notImplemented(); return false;}
+
+    void rewind() {notImplemented();}
+
+  private:
+    void notImplemented() const
+      {
+	QDPIO::cerr << "BinaryStoreDBScan: not implemented - this is a stub version. You must --enable-filedb in qdp++" << std::endl;
+	QDP_abort(1);
+      }
+  };
 }  // namespace QDP
 
 #endif
@@ -18,7 +18,12 @@
 #include "qdp_stdio.h"
 
 #include <string>
-#include <map>
+
+// Memory debugging needs the list of live blocks. Other builds may ask
+// for it with -DQDP_ALLOCATOR_REGISTRY to get the block list in dump().
+#if defined(QDP_DEBUG_MEMORY) && ! defined(QDP_ALLOCATOR_REGISTRY)
+#define QDP_ALLOCATOR_REGISTRY
+#endif
 
 namespace QDP
 {
@@ -26,33 +31,39 @@ namespace QDP
   {
 
 #if defined(QDP_DEBUG_MEMORY)
-    // Struct to hold in map
-    struct MapVal {
-      MapVal(unsigned char* u, const std::string& f, int l, size_t b) :
-	unaligned(u), func(f), line(l), bytes(b) {}
-
-      unsigned char* unaligned;
-      std::string    func;
-      int            line;
-      size_t         bytes;
-    };
-
-    // Convenience typedefs to save typing
-
-    // The type of the map to hold the aligned unaligned values
-    typedef std::map<unsigned char*, MapVal> MapT;
-
     // Func info
+    /*! func must outlive the allocations, like __func__ */
     struct FuncInfo_t {
       FuncInfo_t(const char* f, int l) : func(f), line(l) {}
 
-      std::string  func;
+      const char*  func;
       int          line;
     };
-#else
-    typedef std::map<unsigned char*, unsigned char *> MapT;
 #endif
 
+    //! Bookkeeping stored just in front of each aligned block
+    /*!
+     * free() steps back from the aligned pointer to find the unaligned one,
+     * so allocate and free are O(1) and allocate nothing themselves.
+     */
+    struct BlockHeader {
+      unsigned int   magic;       // marks a live block of ours
+      size_t         bytes;       // bytes obtained
+      size_t         size;        // bytes asked for
+      unsigned char* unaligned;   // what new[] returned
+      bool           fast;        // unaligned came from fastAllocate
+
+#if defined(QDP_ALLOCATOR_REGISTRY)
+      // Intrusive list of live blocks for dump()
+      BlockHeader*   prev;
+      BlockHeader*   next;
+#endif
+#if defined(QDP_DEBUG_MEMORY)
+      const char*    func;
+      int            line;
+#endif
+    };
+
 
     // Specialise allocator to the default case
     class QDPDefaultAllocator {
@@ -62,7 +73,10 @@ namespace QDP
       std::stack<FuncInfo_t> infostack;
 #endif
 
-      MapT the_alignment_map;
+#if defined(QDP_ALLOCATOR_REGISTRY)
+      //! Most recently allocated live block
+      BlockHeader* registry;
+#endif
 
       // Disallow Copies
       QDPDefaultAllocator(const QDPDefaultAllocator& c) {}
@@ -74,7 +88,11 @@ namespace QDP
       // the singleton CreateUsingNew policy which is a "friend"
       // I don't like friends but this follows Alexandrescu's advice
       // on p154 of Modern C++ Design (A. Alexandrescu)
-      QDPDefaultAllocator() {}
+      QDPDefaultAllocator()
+#if defined(QDP_ALLOCATOR_REGISTRY)
+	: registry(0)
+#endif
+      {}
       ~QDPDefaultAllocator() {}
 
       friend class QDP::CreateUsingNew<QDP::Allocator::QDPDefaultAllocator>;
@@ -99,7 +117,7 @@ namespace QDP
       void 
       free(void *mem);
 
-      //! Dump the map
+      //! Dump the live blocks
       void
       dump();
 
@@ -0,0 +1,351 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Consecutive lattice statements fused into one site loop
+ */
+
+#ifndef QDP_DEFERRED_H
+#define QDP_DEFERRED_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! Statements and sums over one subset recorded and run in a single sweep
+  /*!
+   * A solver update such as r = b - Ax; p = r; rr = norm2(r) is three
+   * sweeps over the lattice when written as QDP++ statements. Recorded
+   * here it is one: flush() walks the subset in blocks of sites and runs
+   * every statement on a block, in the order they were recorded, while
+   * the block is in cache. The sums share one global reduction.
+   *
+   *   Double rr;
+   *   {
+   *     DeferredScope fused(rb[cb]);
+   *     fused.assign(r, b - ax);
+   *     fused.assign(p, r);
+   *     fused.norm2(rr, r);
+   *   }                          // flushed here, or by fused.flush()
+   *
+   * A statement reading a field at the site it writes sees what the
+   * statements before it wrote there. A field read through a shift is
+   * read at other sites, so the scope is flushed before recording a
+   * statement that overwrites a field a pending statement shifts. An
+   * expression that shifts a field written by a pending statement is an
+   * error, because the shift may already have been made of the old
+   * values: flush() first.
+   *
+   * The fields in a recorded expression and the result objects must live
+   * until the scope is flushed. Sums are reproducible for a given number
+   * of threads.
+   */
+  class DeferredScope
+  {
+  public:
+    //! Statements over the subset s
+    explicit DeferredScope(const Subset& s_) : s(s_) {}
+
+    //! Flush what is left
+    ~DeferredScope() {flush();}
+
+    //! Record dest op= rhs
+    template<class T, class Op, class RHS, class T1>
+    void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs)
+      {
+	checkShiftsOfPending(rhs);
+
+	// A pending statement reading dest at other sites must see it unchanged
+	for(int t=0; t < terms.size(); ++t)
+	  if (terms[t]->readsShifted(dest.getF()))
+	  {
+	    flush();
+	    break;
+	  }
+
+	// Reading dest at other sites needs the temporary evaluate makes
+	if (forEach(rhs, DestAliasLeaf(dest.getF()), OrCombine()))
+	{
+	  flush();
+	  QDP::evaluate(dest, op, rhs, s);
+	  return;
+	}
+
+	terms.push_back(new EvalTerm<T,Op,RHS,T1>(dest, op, rhs));
+      }
+
+    //! Record dest = rhs
+    template<class T, class RHS, class T1>
+    void assign(OLattice<T>& dest, const QDPExpr<RHS,OLattice<T1> >& rhs)
+      {
+	evaluate(dest, OpAssign(), rhs);
+      }
+
+    //! Record dest = l
+    template<class T, class T1>
+    void assign(OLattice<T>& dest, const OLattice<T1>& l)
+      {
+	evaluate(dest, OpAssign(), PETE_identity(l));
+      }
+
+    //! Record dest = sum(expr)
+    template<class D, class RHS, class T>
+    void sum(D& dest, const QDPExpr<RHS,OLattice<T> >& expr)
+      {
+	checkShiftsOfPending(expr);
+	terms.push_back(new SumTerm<D,RHS,T>(dest, expr));
+      }
+
+    //! Record dest = sum(l)
+    template<class D, class T>
+    void sum(D& dest, const OLattice<T>& l)
+      {
+	sum(dest, PETE_identity(l));
+      }
+
+    //! Record dest = norm2(x)
+    template<class D, class X>
+    void norm2(D& dest, const X& x)
+      {
+	sum(dest, localNorm2(x));
+      }
+
+    //! Record dest = innerProduct(x,y)
+    template<class D, class X, class Y>
+    void innerProduct(D& dest, const X& x, const Y& y)
+      {
+	sum(dest, localInnerProduct(x,y));
+      }
+
+    //! Record dest = innerProductReal(x,y)
+    template<class D, class X, class Y>
+    void innerProductReal(D& dest, const X& x, const Y& y)
+      {
+	sum(dest, localInnerProductReal(x,y));
+      }
+
+    //! Number of recorded statements and sums
+    int size() const {return terms.size();}
+
+    //! Run the recorded statements in one sweep and fill the sums
+    void flush();
+
+  private:
+    //! One recorded statement or sum
+    struct Term
+    {
+      virtual ~Term() {}
+
+      //! Field written, or null
+      virtual const void* writes() const {return 0;}
+
+      //! Does the term read field f at other sites than the one written
+      virtual bool readsShifted(const void* f) const = 0;
+
+      //! Number of REAL64 words a sum packs into
+      virtual int words() const {return 0;}
+
+      //! Zero the per-thread partials
+      virtual void start(int num_threads) {}
+
+      //! Run on sites tab[lo..hi) as thread myId
+      virtual void run(const int *tab, int lo, int hi, int myId) = 0;
+
+      //! Combine the partials in thread order into buf
+      virtual void pack(REAL64 *buf) const {}
+
+      //! Store the globally summed buf into the result
+      virtual void unpack(const REAL64 *buf) {}
+    };
+
+    template<class T, class Op, class RHS, class T1>
+    struct EvalTerm : public Term
+    {
+      EvalTerm(OLattice<T>& dest_, const Op& op_, const QDPExpr<RHS,OLattice<T1> >& expr_) :
+	dest(dest_), op(op_), expr(expr_)
+	{
+	  startShifts(expr);
+	}
+
+      const void* writes() const {return dest.getF();}
+
+      bool readsShifted(const void* f) const
+	{
+	  return forEach(expr, DestAliasLeaf(f), OrCombine());
+	}
+
+      void run(const int *tab, int lo, int hi, int myId)
+	{
+	  for(int j=lo; j < hi; ++j)
+	  {
+	    int i = tab[j];
+	    op(dest.elem(i), forEach(expr, EvalLeaf1(i), OpCombine()));
+	  }
+	}
+
+      OLattice<T>& dest;
+      Op op;
+      QDPExpr<RHS,OLattice<T1> > expr;
+    };
+
+    template<class D, class RHS, class T>
+    struct SumTerm : public Term
+    {
+      typedef typename UnaryReturn<OLattice<T>, FnSum>::Type_t Sum_t;
+      typedef typename WordType<Sum_t>::Type_t W;
+
+      SumTerm(D& dest_, const QDPExpr<RHS,OLattice<T> >& expr_) : dest(dest_), expr(expr_)
+	{
+	  startShifts(expr);
+	}
+
+      bool readsShifted(const void* f) const
+	{
+	  return forEach(expr, DestAliasLeaf(f), OrCombine());
+	}
+
+      int words() const {return sizeof(Sum_t)/sizeof(W);}
+
+      void start(int num_threads)
+	{
+	  partial.resize(num_threads);
+	  for(int thread=0; thread < partial.size(); ++thread)
+	    zero_rep(partial[thread]);
+	}
+
+      void run(const int *tab, int lo, int hi, int myId)
+	{
+	  Sum_t d;
+	  zero_rep(d);
+
+	  for(int j=lo; j < hi; ++j)
+	  {
+	    int i = tab[j];
+	    d.elem() += forEach(expr, EvalLeaf1(i), OpCombine());
+	  }
+
+	  partial[myId].elem() += d.elem();
+	}
+
+      void pack(REAL64 *buf) const
+	{
+	  Sum_t d;
+	  zero_rep(d);
+	  for(int thread=0; thread < partial.size(); ++thread)
+	    d.elem() += partial[thread].elem();
+
+	  const W *w = (const W *)&d;
+	  for(int k=0; k < words(); ++k)
+	    buf[k] = w[k];
+	}
+
+      void unpack(const REAL64 *buf)
+	{
+	  Sum_t d;
+	  W *w = (W *)&d;
+	  for(int k=0; k < words(); ++k)
+	    w[k] = W(buf[k]);
+
+	  dest = d;
+	}
+
+      D& dest;
+      QDPExpr<RHS,OLattice<T> > expr;
+      multi1d<Sum_t> partial;
+    };
+
+    //! Fail when rhs shifts a field a pending statement writes
+    template<class RHS, class T1>
+    void checkShiftsOfPending(const QDPExpr<RHS,OLattice<T1> >& rhs) const
+      {
+	for(int t=0; t < terms.size(); ++t)
+	  if (terms[t]->writes() && forEach(rhs, DestAliasLeaf(terms[t]->writes()), OrCombine()))
+	  {
+	    QDPIO::cerr << "DeferredScope: an expression shifts a field written earlier in the scope, flush() before building it" << std::endl;
+	    QDP_abort(1);
+	  }
+      }
+
+    //! user argument for the sweep
+    struct ThreadArgs
+    {
+      ThreadArgs(std::vector<Term*>& terms_, const int *tab_) : terms(terms_), tab(tab_) {}
+
+      std::vector<Term*>& terms;
+      const int *tab;
+    };
+
+    //! user function for the sweep
+    /*! Walks the range in blocks so every term sees a block while it is in cache */
+    static void kernel(int lo, int hi, int myId, ThreadArgs *a)
+      {
+	const int block = 64;
+	std::vector<Term*>& terms = a->terms;
+
+	for(int jlo=lo; jlo < hi; jlo += block)
+	{
+	  int jhi = (jlo + block < hi) ? jlo + block : hi;
+	  for(int t=0; t < terms.size(); ++t)
+	    terms[t]->run(a->tab, jlo, jhi, myId);
+	}
+      }
+
+    //! Drop the recorded terms
+    void clear()
+      {
+	for(int t=0; t < terms.size(); ++t)
+	  delete terms[t];
+	terms.clear();
+      }
+
+    //! Hide copies - terms are owned
+    DeferredScope(const DeferredScope&);
+    void operator=(const DeferredScope&);
+
+    const Subset& s;
+    std::vector<Term*> terms;
+  };
+
+
+  inline void DeferredScope::flush()
+  {
+    if (terms.size() == 0)
+      return;
+
+    const int num_threads = qdpNumThreads();
+
+    int nwords = 0;
+    for(int t=0; t < terms.size(); ++t)
+    {
+      terms[t]->start(num_threads);
+      nwords += terms[t]->words();
+    }
+
+    ThreadArgs args(terms, s.siteTable().slice());
+    dispatch_to_threads(s.numSiteTable(), args, kernel);
+
+    // Pack the sums for a single global sum
+    if (nwords > 0)
+    {
+      std::vector<REAL64> buf(nwords);
+      for(int t=0, off=0; t < terms.size(); off += terms[t]->words(), ++t)
+	terms[t]->pack(&buf[off]);
+
+      QDPInternal::globalSumArray(&buf[0], nwords);
+
+      for(int t=0, off=0; t < terms.size(); off += terms[t]->words(), ++t)
+	terms[t]->unpack(&buf[off]);
+    }
+
+    clear();
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
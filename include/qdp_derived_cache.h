@@ -0,0 +1,283 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief A cache of fields derived from others, dropped when those change
+ */
+
+#ifndef __qdp_derived_cache_h__
+#define __qdp_derived_cache_h__
+
+#include <list>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace QDP
+{
+
+  //----------------------------------------------------------------------------
+  //! What a derived field was made from
+  /*!
+   * The name of the operation, its integer parameters and the version()
+   * of each source field. Writing a source moves it to a new version, so
+   * a key made after that never matches the entries made before.
+   *
+   *   DerivedKey("shift").on(u[mu]).with(FORWARD).with(nu)
+   */
+  class DerivedKey
+  {
+  public:
+    explicit DerivedKey(const std::string& op_) : op(op_) {}
+
+    //! Made from the current value of f
+    template<class T>
+    DerivedKey& on(const OLattice<T>& f) {vers.push_back(f.version()); return *this;}
+
+    //! With parameter p
+    DerivedKey& with(int p) {params.push_back(p); return *this;}
+
+    bool operator<(const DerivedKey& k) const
+      {
+	if (op != k.op)
+	  return op < k.op;
+	if (vers != k.vers)
+	  return vers < k.vers;
+	return params < k.params;
+      }
+
+  private:
+    std::string op;
+    std::vector<unsigned long> vers;
+    std::vector<int> params;
+  };
+
+
+  //----------------------------------------------------------------------------
+  //! A least recently used cache of derived lattice fields
+  /*!
+   * Holds at most max_fields fields. lookup() returns the field of a key,
+   * making it with the function given when it is not there:
+   *
+   *   DerivedFieldCache<LatticeColorMatrix::Subtype_t> cache(16);
+   *   const LatticeColorMatrix& u_nu = cache.shifted(u[mu], FORWARD, nu);
+   *   const LatticeColorMatrix& leaf = cache.lookup(DerivedKey("plaq").on(u[mu]).on(u[nu]),
+   *     [&](LatticeColorMatrix& d) { d = u[mu]*shift(u[nu],FORWARD,mu)*adj(...); });
+   *
+   * Entries of sources since written are never found again and fall out
+   * as the oldest. The references returned stay valid until the next
+   * lookup or clear(). Making a field is collective when the function
+   * given is, so all nodes must make the same lookups.
+   */
+  template<class T>
+  class DerivedFieldCache
+  {
+  public:
+    //! Keep at most max_fields fields
+    explicit DerivedFieldCache(int max_fields) : max_size(max_fields), nhits(0), nmisses(0)
+      {
+	if (max_size < 1)
+	  QDP_error_exit("DerivedFieldCache: needs room for one field, not %d", max_size);
+      }
+
+    //! The field of key, made by make(field) if it is not held
+    template<class Fn>
+    const OLattice<T>& lookup(const DerivedKey& key, Fn make)
+      {
+	typename Index::iterator it = index.find(key);
+	if (it != index.end())
+	{
+	  ++nhits;
+	  lru.splice(lru.begin(), lru, it->second);
+	  return it->second->second;
+	}
+
+	++nmisses;
+	if (int(lru.size()) >= max_size)
+	{
+	  index.erase(lru.back().first);
+	  lru.pop_back();
+	}
+
+	lru.emplace_front(key, OLattice<T>());
+	index[key] = lru.begin();
+	make(lru.front().second);
+	return lru.front().second;
+      }
+
+    //! shift(f, isign, dir)
+    const OLattice<T>& shifted(const OLattice<T>& f, int isign, int dir)
+      {
+	return lookup(DerivedKey("shift").on(f).with(isign).with(dir),
+		      [&](OLattice<T>& d) { d = shift(f, isign, dir); });
+      }
+
+    //! Drop every field
+    void clear()
+      {
+	index.clear();
+	lru.clear();
+      }
+
+    //! Number of fields held
+    int size() const {return lru.size();}
+
+    //! Lookups found and made so far
+    unsigned long hits() const {return nhits;}
+    unsigned long misses() const {return nmisses;}
+
+  private:
+    //! Hide
+    DerivedFieldCache(const DerivedFieldCache&);
+    void operator=(const DerivedFieldCache&);
+
+    typedef std::list< std::pair<DerivedKey, OLattice<T> > > List;
+    typedef std::map<DerivedKey, typename List::iterator> Index;
+
+    int max_size;
+    List lru;       // most recently used first
+    Index index;
+    unsigned long nhits;
+    unsigned long nmisses;
+  };
+
+
+  //----------------------------------------------------------------------------
+  //! A field with copies of it in other precisions kept up to date
+  /*!
+   * Mixed precision solvers convert the gauge field or the clover term
+   * to single precision at every solve: a sweep of the lattice and a new
+   * field each time. Here the copy in precision T2 is made at the first
+   * as<T2>() and handed out again until the field changes:
+   *
+   *   PrecisionCachedField<LatticeColorMatrixD::Subtype_t> u(ud);
+   *   const LatticeColorMatrixF& uf = u.as<LatticeColorMatrixF::Subtype_t>();
+   *   u.assign(expr, rb[1]);        // the copies are updated on rb[1] only
+   *   u.field() = expr;             // the copies are made again at their next use
+   *
+   * Writing the field through assign() or operator= converts just the
+   * sites written into the copies that were current. Any other evaluate
+   * into field() gives it a new version(), and each copy is converted
+   * whole at its next as(). Writes through elem() or getF() alone go
+   * unnoticed, as for version(). The references returned by as() stay
+   * valid until drop().
+   */
+  template<class T>
+  class PrecisionCachedField
+  {
+  public:
+    //! No field yet, no copies
+    PrecisionCachedField() {}
+
+    //! Shares the sites of f until either is written
+    explicit PrecisionCachedField(const OLattice<T>& f) : master(f) {}
+
+    ~PrecisionCachedField() {drop();}
+
+    //! The field in its own precision
+    const OLattice<T>& field() const {return master;}
+
+    //! The field, to be written by any evaluate
+    OLattice<T>& field() {return master;}
+
+    //! The field in the precision of T2, converted if it changed since the last call
+    template<class T2>
+    const OLattice<T2>& as()
+      {
+	CopyBase*& b = copies[typeid(T2).name()];
+	if (b == 0)
+	  b = new Copy<T2>;
+
+	Copy<T2>* c = static_cast<Copy<T2>*>(b);
+
+	if (c->ver != master.version() || c->ver == 0)
+	{
+	  c->f = master;
+	  c->ver = master.version();
+	  ++nconv;
+	}
+	return c->f;
+      }
+
+    //! The field becomes r on the sites of s, and so do the current copies
+    template<class T1, class C1>
+    void assign(const QDPType<T1,C1>& r, const Subset& s)
+      {
+	assign(PETE_identity(r), s);
+      }
+
+    template<class RHS, class T1>
+    void assign(const QDPExpr<RHS,OLattice<T1> >& r, const Subset& s)
+      {
+	const unsigned long before = master.version();
+	evaluate(master, OpAssign(), r, s);
+
+	for(typename Copies::iterator p=copies.begin(); p != copies.end(); ++p)
+	  if (p->second->ver == before && before != 0)
+	    p->second->update(master, s);
+      }
+
+    //! The field becomes r on all sites, and so do the current copies
+    template<class T1, class C1>
+    PrecisionCachedField& operator=(const QDPType<T1,C1>& r)
+      {
+	assign(PETE_identity(r), allSites(master));
+	return *this;
+      }
+
+    template<class RHS, class T1>
+    PrecisionCachedField& operator=(const QDPExpr<RHS,OLattice<T1> >& r)
+      {
+	assign(r, allSites(master));
+	return *this;
+      }
+
+    //! Free the copies
+    void drop()
+      {
+	for(typename Copies::iterator p=copies.begin(); p != copies.end(); ++p)
+	  delete p->second;
+	copies.clear();
+      }
+
+    //! Whole conversions made so far
+    unsigned long conversions() const {return nconv;}
+
+  private:
+    //! Hide
+    PrecisionCachedField(const PrecisionCachedField&);
+    void operator=(const PrecisionCachedField&);
+
+    //! A copy and the version of the field it holds
+    struct CopyBase
+    {
+      CopyBase() : ver(0) {}
+      virtual ~CopyBase() {}
+
+      //! Convert the sites of s of f, now of a new version
+      virtual void update(const OLattice<T>& f, const Subset& s) = 0;
+
+      unsigned long ver;
+    };
+
+    template<class T2>
+    struct Copy : public CopyBase
+    {
+      void update(const OLattice<T>& f, const Subset& s)
+	{
+	  evaluate(this->f, OpAssign(), PETE_identity(f), s);
+	  this->ver = f.version();
+	}
+
+      OLattice<T2> f;
+    };
+
+    typedef std::map<std::string, CopyBase*> Copies;
+
+    OLattice<T> master;
+    Copies copies;           // by the typeid name of the site type
+    unsigned long nconv = 0;
+  };
+
+} // namespace QDP
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "qdp.h"
 #include "qdp_util.h"
+#include "qdp_map_obj_disk.h"
 
 
 namespace QDP
@@ -97,5 +98,46 @@ namespace QDP
     val.binaryWrite(bin);
   }
 
+
+  //! Batched reads of time slices stored in a MapObjectDisk
+  /*!
+   * The slices are fetched by an AsyncTimeSliceReader, so each node reads
+   * its own part of a slice from the file and the next slices are read
+   * while the current one is in use. Queue the slices needed with push(),
+   * e.g. all time slices of a set of eigenvectors, then finish them in
+   * the same order with next(), which is collective. The database must
+   * stay open while slices are in flight.
+   */
+  template<typename K, typename T>
+  class TimeSliceBatchReader
+  {
+  public:
+    //! Read from an open database
+    explicit TimeSliceBatchReader(const MapObjectDisk<K, TimeSliceIO<T> >& db_) : db(db_) {}
+
+    //! Queue the value of key for the time slice and field of slice
+    void push(const K& key, TimeSliceIO<T>& slice)
+    {
+      typename MapObjectDisk<K, TimeSliceIO<T> >::pos_type pos;
+      if (! db.getPosition(key, pos))
+	throw std::string("TimeSliceBatchReader: key not found");
+
+      if (! in.is_open())
+	in.open(db.getFilename());
+
+      in.read(slice.getObject(), slice.getTimeSlice(), off_t(std::streamoff(pos)), true);
+    }
+
+    //! Finish the oldest queued slice, verifying its checksum
+    void next() {in.next();}
+
+    //! Number of slices queued and not yet finished
+    int pending() const {return in.pending();}
+
+  private:
+    const MapObjectDisk<K, TimeSliceIO<T> >& db;
+    AsyncTimeSliceReader in;
+  };
+
 } 
 #endif
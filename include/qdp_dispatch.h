@@ -27,7 +27,7 @@ namespace QDP {
 
 
 template<class Arg>
-void dispatch_to_threads(int numSiteTable, Arg a, void (*func)(int,int,int, Arg*)){
+void dispatch_to_threads_untimed(int numSiteTable, Arg a, void (*func)(int,int,int, Arg*)){
    
 
 #pragma omp parallel shared(numSiteTable, a)
@@ -80,10 +80,41 @@ namespace QDP {
 
 
 template<class Arg>
-void dispatch_to_threads(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*)){
+void dispatch_to_threads_untimed(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*)){
  
    qmt_call((qmt_userfunc_t)func, numSiteTable, &a);
  
+}
+}
+#elif defined(QDP_USE_POOL_THREADS)
+QDPXX_MESSAGE("QDP using the persistent thread pool")
+
+ /* Thread pool version of the dispatch. The workers are started once in
+    QDP_initialize and the static partition of [0,numSiteTable) is the
+    same as the OpenMP one */
+
+#include "qdp_threadpool.h"
+
+namespace QDP { 
+
+ inline
+   int qdpNumThreads()
+ {
+   return ThreadPool::numThreads();
+ }
+
+ inline
+   int qdpThreadNum()
+ {
+   return ThreadPool::threadNum();
+ }
+
+
+template<class Arg>
+void dispatch_to_threads_untimed(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*)){
+ 
+   ThreadPool::call((ThreadPool::userfunc_t)func, numSiteTable, &a);
+ 
 }
 }
 #else
@@ -102,7 +133,7 @@ namespace QDP {
  }
 
 template<class Arg>
-void dispatch_to_threads(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*)){
+void dispatch_to_threads_untimed(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*)){
    
   int low = 0;
   int high = numSiteTable;
@@ -115,4 +146,45 @@ void dispatch_to_threads(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*)
 #endif
 #endif
 
+namespace QDP {
+
+  //! Run func(low, high, myId, &a) on the threads, each over its share of [0,numSiteTable)
+  /*! Timed thread by thread when ThreadReport is on */
+  template<class Arg>
+  void dispatch_to_threads(int numSiteTable, Arg a, void (*func)(int,int,int,Arg*))
+  {
+    if (ThreadReport::enabled() && ! ThreadReport::timing())
+      ThreadReport::timed(numSiteTable, a, func);
+    else
+      dispatch_to_threads_untimed(numSiteTable, a, func);
+  }
+
+  //! The dispatch with every thread's share timed, see ThreadReport
+  template<class Arg>
+  void ThreadReport::timed(int numSiteTable, Arg& a, void (*func)(int,int,int,Arg*))
+  {
+    const int threads = qdpNumThreads();
+    QDPTime_t* st = stamps(threads);
+
+    TimedArgs<Arg> t;
+    t.a = &a;
+    t.func = func;
+    t.start = st;
+    t.end = st + threads;
+
+    Region* r = current();
+    if (r == 0)
+      r = region(typeid(Arg));
+
+    setTiming(true);
+    const QDPTime_t t0 = getClockTime();
+    dispatch_to_threads_untimed(numSiteTable, t, timedKernel<Arg>);
+    const QDPTime_t t1 = getClockTime();
+    setTiming(false);
+
+    record(r, numSiteTable, t0, t1, t.start, t.end, threads);
+  }
+
+}
+
 #endif
@@ -0,0 +1,307 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Distillation elementals of many colour vectors as matrix products per subset
+ */
+
+#ifndef QDP_ELEMENTALS_H
+#define QDP_ELEMENTALS_H
+
+#include <algorithm>
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace ElementalsInternal
+  {
+    //! Columns of the colour vectors on the sites of one subset, real and imaginary parts apart
+    /*!
+     * Vector j is the row of n = sites*Nc words at re[j*n], im[j*n], the
+     * layout of the transpose of a column major matrix of n rows.
+     */
+    struct Packed
+    {
+      int n;
+      std::vector<REAL64> re, im;
+    };
+
+    //! user argument for packKernel
+    template<class T>
+    struct PackArgs
+    {
+      typedef PScalar< PColorVector< RComplex<T>, Nc> >  Vec_t;
+
+      std::vector<const Vec_t*> v;
+      const PScalar< PScalar< RComplex<REAL> > >* phase;    // or null
+      const int* sites;
+      Packed* p;
+    };
+
+    //! user function packing vectors [lo,hi), each times the phase
+    template<class T>
+    void packKernel(int lo, int hi, int myId, PackArgs<T>* a)
+    {
+      const int nsites = a->p->n / Nc;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	REAL64* re = &a->p->re[size_t(j)*a->p->n];
+	REAL64* im = &a->p->im[size_t(j)*a->p->n];
+
+	for(int s=0; s < nsites; ++s)
+	{
+	  const int x = a->sites[s];
+	  REAL64 wr = 1, wi = 0;
+	  if (a->phase)
+	  {
+	    wr = a->phase[x].elem().elem().real();
+	    wi = a->phase[x].elem().elem().imag();
+	  }
+
+	  for(int c=0; c < Nc; ++c)
+	  {
+	    const RComplex<T>& z = a->v[j][x].elem().elem(c);
+	    re[s*Nc + c] = wr*z.real() - wi*z.imag();
+	    im[s*Nc + c] = wr*z.imag() + wi*z.real();
+	  }
+	}
+      }
+    }
+
+    //! Tile of the product, the rows and columns of one thread's block
+    const int tile = 4;
+
+    //! user argument for gemmKernel
+    struct GemmArgs
+    {
+      const Packed* a;
+      const Packed* b;
+      int na, nb;            // vectors in a and b
+      REAL64* c;             // [i][j][re,im], added to
+    };
+
+    //! user function for the tiles [lo,hi) of c += adj(A) B
+    /*!
+     * Each tile of tile x tile entries reads tile rows of a and of b once
+     * for tile*tile complex products, the order of ZGEMM with the first
+     * argument conjugate transposed. Every entry is made by one thread
+     * in a fixed order, so the result does not depend on the scheduling.
+     */
+    inline void gemmKernel(int lo, int hi, int myId, GemmArgs* g)
+    {
+      const int n = g->a->n;
+      const int ntj = (g->nb + tile - 1) / tile;
+
+      for(int t=lo; t < hi; ++t)
+      {
+	const int i0 = (t / ntj)*tile;
+	const int j0 = (t % ntj)*tile;
+	const int ni = std::min(tile, g->na - i0);
+	const int nj = std::min(tile, g->nb - j0);
+
+	REAL64 cr[tile][tile] = {{0}}, ci[tile][tile] = {{0}};
+	const REAL64* ar[tile];
+	const REAL64* ai[tile];
+	const REAL64* br[tile];
+	const REAL64* bi[tile];
+	for(int k=0; k < ni; ++k)
+	{
+	  ar[k] = &g->a->re[size_t(i0+k)*n];
+	  ai[k] = &g->a->im[size_t(i0+k)*n];
+	}
+	for(int k=0; k < nj; ++k)
+	{
+	  br[k] = &g->b->re[size_t(j0+k)*n];
+	  bi[k] = &g->b->im[size_t(j0+k)*n];
+	}
+
+	for(int r=0; r < n; ++r)
+	  for(int i=0; i < ni; ++i)
+	  {
+	    const REAL64 xr = ar[i][r], xi = ai[i][r];
+	    for(int j=0; j < nj; ++j)
+	    {
+	      cr[i][j] += xr*br[j][r] + xi*bi[j][r];
+	      ci[i][j] += xr*bi[j][r] - xi*br[j][r];
+	    }
+	  }
+
+	for(int i=0; i < ni; ++i)
+	  for(int j=0; j < nj; ++j)
+	  {
+	    REAL64* d = &g->c[2*(size_t(i0+i)*g->nb + j0+j)];
+	    d[0] += cr[i][j];
+	    d[1] += ci[i][j];
+	  }
+      }
+    }
+
+    //! Pack v on the sites of a subset, times phase when not null
+    template<class T>
+    void pack(Packed& p, const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& v,
+	      const OLattice< PScalar< PScalar< RComplex<REAL> > > >* phase, const Subset& s)
+    {
+      PackArgs<T> a;
+      for(int j=0; j < v.size(); ++j)
+	a.v.push_back(v[j].getF());
+      a.phase = (phase == 0) ? 0 : phase->getF();
+      a.sites = s.siteTable().slice();
+      a.p = &p;
+
+      p.n = s.numSiteTable()*Nc;
+      p.re.resize(size_t(p.n)*v.size());
+      p.im.resize(size_t(p.n)*v.size());
+
+      dispatch_to_threads(v.size(), a, packKernel<T>);
+    }
+
+    //! c[ph][k] = adj(v) phases[ph] w on subset k, phases null for none, from one global sum
+    template<class T>
+    multi1d< multi1d< multi2d<DComplex> > >
+    sumMultiElementals(const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& v,
+		       const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& w,
+		       const multi1d<LatticeComplex>* phases, const Set& ss)
+    {
+      const int na = v.size();
+      const int nb = w.size();
+      const int nsub = ss.numSubsets();
+      const int nph = (phases == 0) ? 1 : phases->size();
+      const size_t block = size_t(2)*na*nb;
+
+      std::vector<REAL64> sum(block*nph*nsub, 0.0);
+
+      GemmArgs g;
+      g.na = na;
+      g.nb = nb;
+
+      const int ntiles = ((na + tile - 1) / tile) * ((nb + tile - 1) / tile);
+
+      Packed a, b;
+      for(int k=0; k < nsub; ++k)
+      {
+	if (ss[k].numSiteTable() == 0 || ntiles == 0)
+	  continue;
+
+	// v once per subset, w once per phase, then one product each
+	pack(a, v, 0, ss[k]);
+	g.a = &a;
+	g.b = &b;
+
+	for(int ph=0; ph < nph; ++ph)
+	{
+	  pack(b, w, (phases == 0) ? 0 : &(*phases)[ph], ss[k]);
+	  g.c = &sum[(ph*nsub + k)*block];
+	  dispatch_to_threads(ntiles, g, gemmKernel);
+	}
+      }
+
+      QDPInternal::globalSumArray(&sum[0], sum.size());
+
+      multi1d< multi1d< multi2d<DComplex> > > dest(nph);
+      for(int ph=0; ph < nph; ++ph)
+      {
+	dest[ph].resize(nsub);
+	for(int k=0; k < nsub; ++k)
+	{
+	  dest[ph][k].resize(na, nb);
+	  const REAL64* d = &sum[(ph*nsub + k)*block];
+	  for(int i=0; i < na; ++i)
+	    for(int j=0; j < nb; ++j)
+	      dest[ph][k](i,j) = cmplx(Double(d[2*(i*nb + j)]), Double(d[2*(i*nb + j) + 1]));
+	}
+      }
+
+      return dest;
+    }
+  }
+
+
+  //! adj(v[i]) w[j] summed over each subset of ss, for all pairs i, j
+  /*!
+   * The result is indexed [subset](i,j). In place of the N^2 sweeps of
+   *
+   *   sumMulti(localInnerProduct(v[i], w[j]), ss)
+   *
+   * the vectors of each subset, a time slice of distillation, are
+   * packed once into the columns of two matrices and the elementals are
+   * their product adj(V) W, computed in cache sized tiles on the threads.
+   * There is one global sum for everything.
+   */
+  template<class T>
+  multi1d< multi2d<DComplex> >
+  sumMultiElementals(const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& v,
+		     const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& w,
+		     const Set& ss)
+  {
+    return ElementalsInternal::sumMultiElementals(v, w, 0, ss)[0];
+  }
+
+
+  //! The same weighted by each of phases, such as exp(i p.x) for momenta p
+  /*!
+   * The result is indexed [phase][subset](i,j). Each phase multiplies
+   * each w[j] once, as it is packed, not once per pair.
+   */
+  template<class T>
+  multi1d< multi1d< multi2d<DComplex> > >
+  sumMultiElementals(const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& v,
+		     const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& w,
+		     const multi1d<LatticeComplex>& phases, const Set& ss)
+  {
+    return ElementalsInternal::sumMultiElementals(v, w, &phases, ss);
+  }
+
+
+  //! The elementals adj(v[i]) exp(i p.x) D v[j] for each displacement D and phase
+  /*!
+   * The result is indexed [displacement][phase][subset](i,j). disp[d] is
+   * 0 for no displacement, mu+1 for D v(x) = U_mu(x) v(x+mu) and -(mu+1)
+   * for D v(x) = U_mu(x-mu)^dag v(x-mu). Each displacement is applied
+   * once per vector. The spin structure of a distillation operator sits
+   * in the perambulators and is not part of these.
+   */
+  template<class T, class U>
+  multi1d< multi1d< multi1d< multi2d<DComplex> > > >
+  sumMultiElementals(const multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > >& v,
+		     const multi1d< OLattice<U> >& u, const multi1d<int>& disp,
+		     const multi1d<LatticeComplex>& phases, const Set& ss)
+  {
+    multi1d< multi1d< multi1d< multi2d<DComplex> > > > dest(disp.size());
+    multi1d< OLattice< PScalar< PColorVector< RComplex<T>, Nc> > > > w(v.size());
+
+    for(int d=0; d < disp.size(); ++d)
+    {
+      const int mu = std::abs(disp[d]) - 1;
+      if (mu >= Nd)
+	QDP_error_exit("sumMultiElementals: no direction in displacement %d", disp[d]);
+
+      if (disp[d] == 0)
+      {
+	dest[d] = ElementalsInternal::sumMultiElementals(v, v, &phases, ss);
+	continue;
+      }
+
+      for(int j=0; j < v.size(); ++j)
+      {
+	if (disp[d] > 0)
+	  w[j] = u[mu] * shift(v[j], FORWARD, mu);
+	else
+	  w[j] = shift(adj(u[mu]) * v[j], BACKWARD, mu);
+      }
+
+      dest[d] = ElementalsInternal::sumMultiElementals(v, w, &phases, ss);
+    }
+
+    return dest;
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,64 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Several independent lattices in one job, each on its own group of nodes
+ */
+
+#ifndef QDP_ENSEMBLE_H
+#define QDP_ENSEMBLE_H
+
+#include <cstddef>
+
+namespace QDP
+{
+  //! Independent QDP contexts on disjoint groups of nodes
+  /*!
+   * QDP lays its lattice over the nodes of QMP's default communicator.
+   * With -ensemble n, or setMembers(n) before QDP_initialize, the nodes
+   * of the job are split into n groups of consecutive ranks and each
+   * group becomes the default communicator of its nodes. Every group
+   * then runs a QDP of its own: its own lattice size and Layout, maps,
+   * RNG and files, as if it were a separate job, so many small volumes
+   * or configurations share one scheduler slot and one startup.
+   *
+   * A caller that initializes QMP itself can split the nodes any way it
+   * likes with QMP_comm_split and QMP_comm_set_default before calling
+   * QDP_initialize; QDP takes that communicator as its machine.
+   *
+   * Nothing but the functions here talks across groups. Seed the RNG
+   * with member() to keep the groups' random numbers apart, and name
+   * output files after it. Only the parscalar architecture splits; on
+   * one node there is a single member.
+   */
+  namespace Ensemble
+  {
+    //! Split the nodes into n groups at QDP_initialize
+    /*! The number of nodes must be a multiple of n */
+    void setMembers(int n);
+
+    //! Number of groups
+    int members();
+
+    //! The group of this node, 0 .. members()-1
+    int member();
+
+    //! This node among all the nodes of the job
+    int worldNodeNumber();
+
+    //! All the nodes of the job
+    int worldNumNodes();
+
+    //! Copy bytes bytes at buf from the first node of the job to every node of every group
+    /*! For input read once for all the groups. All the nodes of the job call it together */
+    void worldBroadcast(void* buf, size_t bytes);
+
+    //! Wait for all the nodes of the job
+    void worldBarrier();
+
+    //! Split QMP's default communicator as setMembers asked
+    /*! Called by QDP_initialize once QMP runs, before anything is laid out */
+    void init();
+  }
+}
+
+#endif
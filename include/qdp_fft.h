@@ -0,0 +1,77 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Fourier transforms of lattice fields
+ */
+
+#ifndef QDP_FFT_H
+#define QDP_FFT_H
+
+namespace QDP
+{
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace FFTInternal
+  {
+    //! Transform sites of ncomp complex numbers along the directions with dirs[mu]
+    void fftLattice(REAL32* data, int ncomp, int sign, const multi1d<bool>& dirs);
+    void fftLattice(REAL64* data, int ncomp, int sign, const multi1d<bool>& dirs);
+  }
+
+
+  //! Fourier transform a complex field in place along the directions with dirs[mu]
+  /*!
+    Replaces x by
+      x~(p) = sum_x exp(sign i 2 pi sum_mu p_mu x_mu / L_mu) x(x)
+    with the sum over the directions picked, and p_mu in [0, L_mu) at the
+    site with those coordinates. Nothing is normalised: transforming
+    with sign and then -sign multiplies by the volume transformed.
+    sign +1 matches sumMultiMomenta.
+
+    Each direction is done in turn. The lines along it are dealt out
+    over the nodes of the machine along it in one all-to-all, each node
+    transforms the lines it has on threads with a mixed radix FFT, and a
+    second all-to-all takes them home. Lengths with factors 2, 3 and 5
+    are fastest; any length works. Every component of the site type is
+    transformed, so x must be complex valued. All calls are collective.
+  */
+  template<class T>
+  void fft(OLattice<T>& x, int sign, const multi1d<bool>& dirs)
+  {
+    typedef typename WordType<T>::Type_t W;
+
+    if (sizeof(T) % (2*sizeof(W)) != 0)
+    {
+      QDPIO::cerr << __func__ << ": the site type is not complex" << std::endl;
+      QDP_abort(1);
+    }
+
+    FFTInternal::fftLattice((W*)x.getF(), sizeof(T)/(2*sizeof(W)), sign, dirs);
+  }
+
+  //! Fourier transform a complex field in place along all directions
+  template<class T>
+  void fft(OLattice<T>& x, int sign)
+  {
+    multi1d<bool> dirs(Nd);
+    dirs = true;
+    fft(x, sign, dirs);
+  }
+
+  //! Fourier transform every slice of a complex field normal to j_decay in place
+  template<class T>
+  void fft3d(OLattice<T>& x, int sign, int j_decay = Nd-1)
+  {
+    multi1d<bool> dirs(Nd);
+    dirs = true;
+    dirs[j_decay] = false;
+    fft(x, sign, dirs);
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,186 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Spin and colour components of a lattice field read and written in place
+ */
+
+#ifndef QDP_FIELD_VIEW_H
+#define QDP_FIELD_VIEW_H
+
+namespace QDP
+{
+
+  /** \addtogroup group1
+   *  @{
+   */
+
+  //! Structure for extracting a column of a propagator as a fermion
+  /*! d(s1)(c1) = prop(s1,spin)(c1,color) */
+  struct FnPeekPropColumn
+  {
+    PETE_EMPTY_CONSTRUCTORS(FnPeekPropColumn)
+
+    FnPeekPropColumn(int _color, int _spin): color(_color), spin(_spin) {}
+
+    template<class T, int N, int M>
+    inline PSpinVector<PColorVector<T,N>,M>
+    operator()(const PSpinMatrix<PColorMatrix<T,N>,M>& a) const
+    {
+      PSpinVector<PColorVector<T,N>,M> d;
+      for(int s1=0; s1 < M; ++s1)
+	for(int c1=0; c1 < N; ++c1)
+	  d.elem(s1).elem(c1) = a.elem(s1,spin).elem(c1,color);
+      return d;
+    }
+
+  private:
+    int color, spin;
+  };
+
+  template<class T, int N, int M>
+  struct UnaryReturn<PSpinMatrix<PColorMatrix<T,N>,M>, FnPeekPropColumn> {
+    typedef PSpinVector<PColorVector<T,N>,M>  Type_t;
+  };
+
+
+  //! Structure for inserting a fermion as a column of a propagator
+  struct FnPokePropColumn
+  {
+    PETE_EMPTY_CONSTRUCTORS(FnPokePropColumn)
+
+    FnPokePropColumn(int _color, int _spin): color(_color), spin(_spin) {}
+
+    template<class T, class T1, int N, int M>
+    inline void
+    operator()(PSpinMatrix<PColorMatrix<T,N>,M>& a, const PSpinVector<PColorVector<T1,N>,M>& b) const
+    {
+      for(int s1=0; s1 < M; ++s1)
+	for(int c1=0; c1 < N; ++c1)
+	  a.elem(s1,spin).elem(c1,color) = b.elem(s1).elem(c1);
+    }
+
+  private:
+    int color, spin;
+  };
+
+
+  //! A component of a field, read as an expression and written in place
+  /*!
+   * The view is the peek expression of the component, so it can be a
+   * leaf of any expression, and assigning to it evaluates the right
+   * hand side straight into the component with the matching poke:
+   *
+   *   LatticePropagator prop;
+   *   LatticeFermion psi;
+   *   psi = propColumn(prop, color, spin);                  // one strided copy
+   *   propColumn(prop, color, spin) = psi;                  // and back
+   *   spinView(psi, 2) = Real(2)*colorView(chi, 0, 1)*cv;   // no temporaries
+   *
+   * Nothing is copied in or out besides the sites of the component:
+   * no lattice temporary holds it on the way.
+   */
+  template<class T1, class C1, class FnPeek, class FnPoke>
+  class FieldView :
+    public QDPExpr<UnaryNode<FnPeek, typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>,
+		   typename UnaryReturn<C1,FnPeek>::Type_t>
+  {
+  public:
+    typedef UnaryNode<FnPeek, typename CreateLeaf<QDPType<T1,C1> >::Leaf_t> Tree_t;
+    typedef QDPExpr<Tree_t, typename UnaryReturn<C1,FnPeek>::Type_t> Base_t;
+
+    FieldView(QDPType<T1,C1>& l, const FnPeek& fpeek, const FnPoke& fpoke) :
+      Base_t(Tree_t(fpeek, CreateLeaf<QDPType<T1,C1> >::make(l))),
+      field(static_cast<C1&>(l)), poke(fpoke) {}
+
+    //! Write the component on all sites
+    template<class T2, class C2>
+    FieldView& operator=(const QDPType<T2,C2>& r)
+      {
+	evaluate(field, poke, PETE_identity(r), allSites(field));
+	return *this;
+      }
+
+    template<class T2, class C2>
+    FieldView& operator=(const QDPExpr<T2,C2>& r)
+      {
+	evaluate(field, poke, r, allSites(field));
+	return *this;
+      }
+
+    //! Copy the component of another view
+    FieldView& operator=(const FieldView& r)
+      {
+	evaluate(field, poke, static_cast<const Base_t&>(r), allSites(field));
+	return *this;
+      }
+
+    //! Write the component on the sites of s only
+    template<class T2, class C2>
+    void assign(const QDPExpr<T2,C2>& r, const Subset& s)
+      {
+	evaluate(field, poke, r, s);
+      }
+
+    template<class T2, class C2>
+    void assign(const QDPType<T2,C2>& r, const Subset& s)
+      {
+	evaluate(field, poke, PETE_identity(r), s);
+      }
+
+  private:
+    C1& field;
+    FnPoke poke;
+  };
+
+
+  //! Spin vector component row of l, read and written in place
+  template<class T1, class C1>
+  inline FieldView<T1,C1,FnPeekSpinVector,FnPokeSpinVector>
+  spinView(QDPType<T1,C1>& l, int row)
+  {
+    return FieldView<T1,C1,FnPeekSpinVector,FnPokeSpinVector>(l, FnPeekSpinVector(row),
+							     FnPokeSpinVector(row));
+  }
+
+  //! Spin matrix component (row,col) of l, read and written in place
+  template<class T1, class C1>
+  inline FieldView<T1,C1,FnPeekSpinMatrix,FnPokeSpinMatrix>
+  spinView(QDPType<T1,C1>& l, int row, int col)
+  {
+    return FieldView<T1,C1,FnPeekSpinMatrix,FnPokeSpinMatrix>(l, FnPeekSpinMatrix(row,col),
+							     FnPokeSpinMatrix(row,col));
+  }
+
+  //! Colour vector component row of l, read and written in place
+  template<class T1, class C1>
+  inline FieldView<T1,C1,FnPeekColorVector,FnPokeColorVector>
+  colorView(QDPType<T1,C1>& l, int row)
+  {
+    return FieldView<T1,C1,FnPeekColorVector,FnPokeColorVector>(l, FnPeekColorVector(row),
+							       FnPokeColorVector(row));
+  }
+
+  //! Colour matrix component (row,col) of l, read and written in place
+  template<class T1, class C1>
+  inline FieldView<T1,C1,FnPeekColorMatrix,FnPokeColorMatrix>
+  colorView(QDPType<T1,C1>& l, int row, int col)
+  {
+    return FieldView<T1,C1,FnPeekColorMatrix,FnPokeColorMatrix>(l, FnPeekColorMatrix(row,col),
+							       FnPokeColorMatrix(row,col));
+  }
+
+  //! The fermion in column (color,spin) of a propagator, read and written in place
+  /*! The source of that colour and spin and the solution for it */
+  template<class T1, class C1>
+  inline FieldView<T1,C1,FnPeekPropColumn,FnPokePropColumn>
+  propColumn(QDPType<T1,C1>& l, int color, int spin)
+  {
+    return FieldView<T1,C1,FnPeekPropColumn,FnPokePropColumn>(l, FnPeekPropColumn(color,spin),
+							     FnPokePropColumn(color,spin));
+  }
+
+  /** @} */ // end of group1
+
+} // namespace QDP
+
+#endif
@@ -55,6 +55,12 @@ namespace QDP
       count += (flops * (unsigned long long)(s.numSiteTable()));
     }
 
+    //! Method to add the flops evaluate counted since getExprFlops() returned mark
+    /*! Needs counting turned on with setExprCounting or -flopcount */
+    inline void addExprFlops(unsigned long long mark) {
+      count += getExprFlops() - mark;
+    }
+
     //! Method to retrieve accumulated flopcount
     inline unsigned long long getFlops(void) const { 
       return count;
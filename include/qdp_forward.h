@@ -74,6 +74,12 @@ namespace QDP
   template<class T> class OSubScalar;
   template<class T> class OSubLattice;
 
+  // A lattice other than the one of Layout
+  class LatticeLayout;
+
+  // Several fields stored site by site
+  template<class T> class LatticeBlock;
+
   // Main type
   template<class T, class C> class QDPType;
 
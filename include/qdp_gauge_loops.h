@@ -0,0 +1,270 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Plaquettes and staples of a gauge field in one sweep
+ */
+
+#ifndef QDP_GAUGE_LOOPS_H
+#define QDP_GAUGE_LOOPS_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace GaugeLoopsInternal
+  {
+    //! The map reading x + mu - nu at x
+    /*! Built on first use and kept */
+    Map& cornerMap(int mu, int nu);
+
+    //! The links u[b](x+a) for a != b, u[b](x-a) for all a, b and u[b](x+a-b) for a != b
+    /*!
+     * Every map is started on construction and the messages of all of
+     * them are in flight together.
+     */
+    template<class U>
+    struct Neighbours
+    {
+      //! Start the forward maps, and with staples the backward and corner ones
+      Neighbours(const multi1d< OLattice<U> >& u, bool staples)
+	{
+	  for(int a=0; a < Nd; ++a)
+	    for(int b=0; b < Nd; ++b)
+	    {
+	      if (a != b)
+		add(fwd, a, b, shift.getMap(FORWARD, a), u[b]);
+	      if (staples)
+		add(bwd, a, b, shift.getMap(BACKWARD, a), u[b]);
+	      if (staples && a != b)
+		add(corner, a, b, cornerMap(a, b), u[b]);
+	    }
+
+	  // Sites needing nothing from another node
+	  std::vector<bool> edge(Layout::sitesOnNode(), false);
+	  for(int k=0; k < maps.size(); ++k)
+	  {
+	    const Subset& s = maps[k]->boundary(all);
+	    const int* tab = s.siteTable().slice();
+	    for(int j=0; j < s.numSiteTable(); ++j)
+	      edge[tab[j]] = true;
+	  }
+	  for(int x=0; x < edge.size(); ++x)
+	    (edge[x] ? outer : inner).push_back(x);
+	}
+
+      //! Wait on all the messages
+      void wait()
+	{
+	  for(int k=0; k < handles.size(); ++k)
+	    handles[k].wait();
+	}
+
+      //! u[b](x+a), u[b](x-a) and u[b](x+a-b) at site x
+      const U& forward(int a, int b, int x) const {return handles[fwd[a][b]].elem(x);}
+      const U& backward(int a, int b, int x) const {return handles[bwd[a][b]].elem(x);}
+      const U& diagonal(int a, int b, int x) const {return handles[corner[a][b]].elem(x);}
+
+      std::vector<int> inner, outer;
+
+    private:
+      void add(int (&k)[Nd][Nd], int a, int b, Map& m, const OLattice<U>& l)
+	{
+	  k[a][b] = handles.size();
+	  handles.push_back(m.start(l));
+	  maps.push_back(&m);
+	}
+
+      std::vector< MapHandle<U> > handles;
+      std::vector<Map*> maps;
+      int fwd[Nd][Nd], bwd[Nd][Nd], corner[Nd][Nd];
+    };
+
+    //! Re tr a b^dag
+    template<class T>
+    inline REAL64 realTraceAdj(const PScalar< PColorMatrix<RComplex<T>,Nc> >& a,
+			       const PScalar< PColorMatrix<RComplex<T>,Nc> >& b)
+    {
+      REAL64 t = 0;
+      for(int i=0; i < Nc; ++i)
+	for(int j=0; j < Nc; ++j)
+	  t += a.elem().elem(i,j).real()*b.elem().elem(i,j).real()
+	    + a.elem().elem(i,j).imag()*b.elem().elem(i,j).imag();
+      return t;
+    }
+
+    //! Start of a site list, null when empty
+    inline const int* sitePtr(const std::vector<int>& v) {return v.empty() ? 0 : &v[0];}
+
+    //! user argument for plaquetteKernel and stapleKernel
+    template<class U>
+    struct LoopArgs
+    {
+      const U* u[Nd];
+      U* s[Nd];
+      const Neighbours<U>* nb;
+      const int* sites;
+      std::vector< std::vector<REAL64> >* part;   // per thread Nd*Nd plane sums
+    };
+
+    //! user function summing Re tr U_mu(x) U_nu(x+mu) U_mu(x+nu)^dag U_nu(x)^dag in each plane
+    template<class U>
+    void plaquetteKernel(int lo, int hi, int myId, LoopArgs<U>* a)
+    {
+      std::vector<REAL64>& d = (*a->part)[myId];
+      const Neighbours<U>& nb = *a->nb;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	const int x = a->sites[j];
+	for(int mu=1; mu < Nd; ++mu)
+	  for(int nu=0; nu < mu; ++nu)
+	  {
+	    U lower = a->u[mu][x] * nb.forward(mu, nu, x);
+	    U upper = a->u[nu][x] * nb.forward(nu, mu, x);
+	    d[mu*Nd+nu] += realTraceAdj(lower, upper);
+	  }
+      }
+    }
+
+    //! The staple of U_mu(x) over the planes (mu,nu), nu neither mu nor skip
+    /*!
+     * acc = sum_nu U_nu(x+mu) U_mu(x+nu)^dag U_nu(x)^dag
+     *            + U_nu(x+mu-nu)^dag U_mu(x-nu)^dag U_nu(x-nu)
+     */
+    template<class U>
+    inline void siteStaple(U& acc, const Neighbours<U>& nb, const U* const u[Nd], int mu, int x, int skip)
+    {
+      zero_rep(acc);
+
+      for(int nu=0; nu < Nd; ++nu)
+      {
+	if (nu == mu || nu == skip)
+	  continue;
+
+	U up = multiplyAdj(nb.forward(mu, nu, x), nb.forward(nu, mu, x));
+	acc += multiplyAdj(up, u[nu][x]);
+
+	U down = adjMultiplyAdj(nb.diagonal(mu, nu, x), nb.backward(nu, mu, x));
+	acc += down * nb.backward(nu, nu, x);
+      }
+    }
+
+    //! user function summing the staples of every link at sites[lo..hi)
+    template<class U>
+    void stapleKernel(int lo, int hi, int myId, LoopArgs<U>* a)
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	const int x = a->sites[j];
+	for(int mu=0; mu < Nd; ++mu)
+	  siteStaple(a->s[mu][x], *a->nb, a->u, mu, x, -1);
+      }
+    }
+  }
+
+
+  //! Re tr of the plaquettes of u summed over the lattice, for each plane
+  /*!
+   * Returns p(mu,nu) = p(nu,mu) = sum_x Re tr U_mu(x) U_nu(x+mu) U_mu(x+nu)^dag U_nu(x)^dag,
+   * zero for mu = nu. The links of the neighbours are exchanged for all
+   * planes at once and the plaquettes done in a single sweep reading
+   * them in place, so no shifted field is made. Sites needing nothing from
+   * another node are done while the messages are in flight.
+   */
+  template<class U>
+  multi2d<Double> sumPlaquettes(const multi1d< OLattice<U> >& u)
+  {
+    using namespace GaugeLoopsInternal;
+
+    if (u.size() != Nd)
+      QDP_error_exit("sumPlaquettes: need Nd gauge links, have %d", u.size());
+
+    std::vector< std::vector<REAL64> > part(qdpNumThreads(), std::vector<REAL64>(Nd*Nd, 0.0));
+
+    LoopArgs<U> a;
+    for(int mu=0; mu < Nd; ++mu)
+      a.u[mu] = u[mu].getF();
+    a.part = &part;
+
+    Neighbours<U> nb(u, false);
+    a.nb = &nb;
+
+    a.sites = sitePtr(nb.inner);
+    dispatch_to_threads(nb.inner.size(), a, plaquetteKernel<U>);
+
+    nb.wait();
+    a.sites = sitePtr(nb.outer);
+    dispatch_to_threads(nb.outer.size(), a, plaquetteKernel<U>);
+
+    // Combine in thread order, then one global sum for all planes
+    multi1d<REAL64> sum(Nd*Nd);
+    for(int k=0; k < Nd*Nd; ++k)
+    {
+      sum[k] = part[0][k];
+      for(int thread=1; thread < part.size(); ++thread)
+	sum[k] += part[thread][k];
+    }
+    QDPInternal::globalSumArray(sum);
+
+    multi2d<Double> plaq(Nd, Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      for(int nu=0; nu < Nd; ++nu)
+	plaq(mu,nu) = (mu > nu) ? sum[mu*Nd+nu] : sum[nu*Nd+mu];
+    for(int mu=0; mu < Nd; ++mu)
+      plaq(mu,mu) = 0;
+
+    return plaq;
+  }
+
+  //! The staples of every link of u
+  /*!
+   * s[mu](x) = sum_{nu != mu} U_nu(x+mu) U_mu(x+nu)^dag U_nu(x)^dag
+   *                      + U_nu(x+mu-nu)^dag U_mu(x-nu)^dag U_nu(x-nu)
+   *
+   * so that Re tr U_mu(x) s[mu](x) sums the plaquettes holding U_mu(x).
+   * All the neighbouring links, the diagonal ones at x+mu-nu included,
+   * are exchanged at once and every staple is made in a single sweep,
+   * so none of the usual shifted temporaries is made. s must not be u.
+   */
+  template<class U>
+  void staples(multi1d< OLattice<U> >& s, const multi1d< OLattice<U> >& u)
+  {
+    using namespace GaugeLoopsInternal;
+
+    if (u.size() != Nd)
+      QDP_error_exit("staples: need Nd gauge links, have %d", u.size());
+    if (&s == &u)
+      QDP_error_exit("staples: s may not be u");
+
+    if (s.size() != Nd)
+      s.resize(Nd);
+
+    LoopArgs<U> a;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      a.u[mu] = u[mu].getF();
+      a.s[mu] = s[mu].getF();
+    }
+    a.part = 0;
+
+    Neighbours<U> nb(u, true);
+    a.nb = &nb;
+
+    a.sites = sitePtr(nb.inner);
+    dispatch_to_threads(nb.inner.size(), a, stapleKernel<U>);
+
+    nb.wait();
+    a.sites = sitePtr(nb.outer);
+    dispatch_to_threads(nb.outer.size(), a, stapleKernel<U>);
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,195 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Gauge transformations of links and fermions in one sweep
+ */
+
+#ifndef QDP_GAUGE_TRANSFORM_H
+#define QDP_GAUGE_TRANSFORM_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace GaugeTransformInternal
+  {
+    //! user argument for linkKernel
+    template<class U>
+    struct LinkArgs
+    {
+      U* u[Nd];
+      const U* g;
+      const std::vector< MapHandle<U> >* gf;   // g(x+mu)
+      const int* sites;
+    };
+
+    //! user function for u_mu(x) <- g(x) u_mu(x) g(x+mu)^dag at sites[lo..hi)
+    template<class U>
+    void linkKernel(int lo, int hi, int myId, LinkArgs<U>* a)
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	const int x = a->sites[j];
+	const U gx = a->g[x];
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  U t = gx * a->u[mu][x];
+	  a->u[mu][x] = multiplyAdj(t, (*a->gf)[mu].elem(x));
+	}
+      }
+    }
+
+    //! user argument for fermionKernel
+    template<class T, class U>
+    struct FermionArgs
+    {
+      T* psi;
+      const U* g;
+    };
+
+    //! user function for psi(x) <- g(x) psi(x)
+    template<class T, class U>
+    void fermionKernel(int lo, int hi, int myId, FermionArgs<T,U>* a)
+    {
+      for(int x=lo; x < hi; ++x)
+      {
+	T t = a->g[x] * a->psi[x];
+	a->psi[x] = t;
+      }
+    }
+
+    //! user argument for overRelaxKernel
+    template<class U>
+    struct OverRelaxArgs
+    {
+      U* g;
+      double omega;
+    };
+
+    //! user function for g <- P_SU3[1 + w (g-1) + w (w-1)/2 (g-1)^2]
+    template<class U>
+    void overRelaxKernel(int lo, int hi, int myId, OverRelaxArgs<U>* a)
+    {
+      using namespace SU3Internal;
+
+      const double w = a->omega;
+      const double w2 = 0.5*w*(w - 1);
+
+      for(int x=lo; x < hi; ++x)
+      {
+	M3 d, d2, r;
+	d.load(a->g[x].elem());
+	for(int i=0; i < 3; ++i)
+	  d.re[i][i] -= 1;
+	mult(d2, d, d);
+
+	for(int i=0; i < 3; ++i)
+	  for(int k=0; k < 3; ++k)
+	  {
+	    r.re[i][k] = w*d.re[i][k] + w2*d2.re[i][k] + ((i == k) ? 1 : 0);
+	    r.im[i][k] = w*d.im[i][k] + w2*d2.im[i][k];
+	  }
+
+	projectSU3(r);
+	r.store(a->g[x].elem());
+      }
+    }
+  }
+
+
+  //! u[mu](x) <- g(x) u[mu](x) g(x+mu)^dag for all mu in one sweep
+  /*!
+   * The Nd forward neighbours of g are started together, one message
+   * per face, and the links of the sites needing nothing from another
+   * node are transformed while they travel; each site reads g(x) once
+   * for all directions. This replaces the loop of
+   *
+   *   u[mu] = g * u[mu] * adj(shift(g, FORWARD, mu))
+   *
+   * with its Nd shifted copies of g and product temporaries.
+   */
+  template<class U>
+  void gaugeTransform(multi1d< OLattice<U> >& u, const OLattice<U>& g)
+  {
+    using namespace GaugeTransformInternal;
+
+    if (u.size() != Nd)
+      QDP_error_exit("gaugeTransform: need Nd gauge links, have %d", u.size());
+
+    std::vector< MapHandle<U> > gf;
+    std::vector<bool> edge(Layout::sitesOnNode(), false);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      Map& m = shift.getMap(FORWARD, mu);
+      gf.push_back(m.start(g));
+
+      const Subset& b = m.boundary(all);
+      const int* tab = b.siteTable().slice();
+      for(int j=0; j < b.numSiteTable(); ++j)
+	edge[tab[j]] = true;
+    }
+
+    std::vector<int> inner, outer;
+    for(int x=0; x < edge.size(); ++x)
+      (edge[x] ? outer : inner).push_back(x);
+
+    LinkArgs<U> a;
+    for(int mu=0; mu < Nd; ++mu)
+      a.u[mu] = writable(u[mu]).getF();
+    a.g = g.getF();
+    a.gf = &gf;
+
+    a.sites = GaugeLoopsInternal::sitePtr(inner);
+    dispatch_to_threads(inner.size(), a, linkKernel<U>);
+
+    for(int mu=0; mu < Nd; ++mu)
+      gf[mu].wait();
+
+    a.sites = GaugeLoopsInternal::sitePtr(outer);
+    dispatch_to_threads(outer.size(), a, linkKernel<U>);
+  }
+
+  //! The same after the over-relaxation g <- g^omega of gauge fixing
+  /*!
+   * g^omega is the expansion 1 + omega (g-1) + omega (omega-1)/2 (g-1)^2
+   * projected back onto SU(3), as in Mandula and Ogilvie; omega around
+   * 1.7 speeds up relaxation to Landau or Coulomb gauge. g is left
+   * over-relaxed. The site-local step is made before the messages of
+   * g start, in the same call.
+   */
+  template<class U>
+  void gaugeTransform(multi1d< OLattice<U> >& u, OLattice<U>& g, const Real& omega)
+  {
+    using namespace GaugeTransformInternal;
+
+    if (Nc != 3)
+      QDP_error_exit("gaugeTransform: over-relaxation needs Nc = 3, have %d", Nc);
+
+    OverRelaxArgs<U> a;
+    a.g = writable(g).getF();
+    a.omega = toDouble(omega);
+    dispatch_to_threads(Layout::sitesOnNode(), a, overRelaxKernel<U>);
+
+    gaugeTransform(u, g);
+  }
+
+  //! psi(x) <- g(x) psi(x), a fermion or colour vector, in one sweep
+  template<class T, class U>
+  void gaugeTransform(OLattice<T>& psi, const OLattice<U>& g)
+  {
+    GaugeTransformInternal::FermionArgs<T,U> a;
+    a.psi = writable(psi).getF();
+    a.g = g.getF();
+    dispatch_to_threads(Layout::sitesOnNode(), a, GaugeTransformInternal::fermionKernel<T,U>);
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
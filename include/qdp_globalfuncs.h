@@ -280,6 +280,62 @@ namespace QDP
   }
 
 
+  //! OScalar = globalMax(source) under an explicit subset
+  /*!
+   * Find the maximum of an object on the sites of a subset
+   */
+  template<class T, class C>
+  inline typename UnaryReturn<C, FnGlobalMax>::Type_t
+  globalMax(const QDPType<T,C>& s1, const Subset& s)
+  {
+    return globalMax(PETE_identity(s1), s);
+  }
+
+
+  //! OScalar = globalMin(source) under an explicit subset
+  /*!
+   * Find the minimum of an object on the sites of a subset
+   */
+  template<class T, class C>
+  inline typename UnaryReturn<C, FnGlobalMin>::Type_t
+  globalMin(const QDPType<T,C>& s1, const Subset& s)
+  {
+    return globalMin(PETE_identity(s1), s);
+  }
+
+
+  //! The value of a field at one site and the global coordinate of the site
+  template<class T>
+  struct SiteValue
+  {
+    T value;
+    multi1d<int> coord;   // empty when there was no site
+  };
+
+
+  //! Largest value of a real field on a subset and where it is
+  /*!
+   * E.g. the site with the worst residual:
+   *
+   *   SiteValue<Real> w = argMax(localNorm2(r), all);
+   */
+  template<class T, class C>
+  inline SiteValue<typename UnaryReturn<C, FnGlobalMax>::Type_t>
+  argMax(const QDPType<T,C>& s1, const Subset& s)
+  {
+    return argMax(PETE_identity(s1), s);
+  }
+
+
+  //! Smallest value of a real field on a subset and where it is
+  template<class T, class C>
+  inline SiteValue<typename UnaryReturn<C, FnGlobalMin>::Type_t>
+  argMin(const QDPType<T,C>& s1, const Subset& s)
+  {
+    return argMin(PETE_identity(s1), s);
+  }
+
+
   //-----------------------------------------------------------------------------
   // These functions always return bool
   //! bool = isnan(source)
@@ -7,165 +7,86 @@ namespace QDP
 {
 
 
+  //! OScalar = norm2(trace(adj(source)*source)) over the subset of the source
+  template<class T, class C>
+  inline typename UnaryReturn<C, FnNorm2>::Type_t
+  norm2(const QDPSubType<T,C>& s1)
+  {
+    return sum(localNorm2(s1),s1.subset());
+  }
+
+
+  //! OScalar = innerProduct(adj(source1)*source2) over the subset of the subtype
   template<class T1, class C1, class T2, class C2>
   inline typename BinaryReturn<C1, C2, FnInnerProduct>::Type_t
   innerProduct(const QDPSubType<T1,C1>& s1, const QDPType<T2,C2>& s2)
   {
-    return sum(localInnerProduct(s1,s2));
+    return sum(localInnerProduct(s1,s2),s1.subset());
   }
+
   template<class T1, class C1, class T2, class C2>
   inline typename BinaryReturn<C1, C2, FnInnerProduct>::Type_t
   innerProduct(const QDPType<T1,C1>& s1, const QDPSubType<T2,C2>& s2)
   {
-    return sum(localInnerProduct(s1,s2));
+    return sum(localInnerProduct(s1,s2),s2.subset());
   }
-#if 0
+
   template<class T1, class C1, class T2, class C2>
   inline typename BinaryReturn<C1, C2, FnInnerProduct>::Type_t
   innerProduct(const QDPSubType<T1,C1>& s1, const QDPSubType<T2,C2>& s2)
   {
-    return sum(localInnerProduct(s1,s2));
+    return sum(localInnerProduct(s1,s2),s1.subset());
   }
-#endif
-
-  template<class T1,class C1,class T2,class C2>
-  typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t
-  localInnerProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
-  {
-    if (!l.getOwnsMemory())
-      QDP_error_exit("localInnerProduct with subtype view called");
 
-    typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t ret;
-    ret.setSubset( l.subset() );
-
-    //QDP_info("localInnerProduct %d sites",l.subset().numSiteTable());
-
-    const int *tab = l.subset().siteTable().slice();
-    for(int j=0; j < l.subset().numSiteTable(); ++j)
-      {
-	int i = tab[j];
-	FnLocalInnerProduct op;
-	ret.getF()[j] = op( l.getF()[j] , r.elem(i) );
-      }
 
-    return ret;
+  //! OScalar = innerProductReal(adj(source1)*source2) over the subset of the subtype
+  template<class T1, class C1, class T2, class C2>
+  inline typename BinaryReturn<C1, C2, FnInnerProductReal>::Type_t
+  innerProductReal(const QDPSubType<T1,C1>& s1, const QDPType<T2,C2>& s2)
+  {
+    return sum(localInnerProductReal(s1,s2),s1.subset());
   }
 
-  template<class T1,class C1,class T2,class C2>
-  typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t
-  localInnerProduct(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+  template<class T1, class C1, class T2, class C2>
+  inline typename BinaryReturn<C1, C2, FnInnerProductReal>::Type_t
+  innerProductReal(const QDPType<T1,C1>& s1, const QDPSubType<T2,C2>& s2)
   {
-    if (!r.getOwnsMemory())
-      QDP_error_exit("localInnerProduct with subtype view called");
-
-    typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t ret;
-    ret.setSubset( r.subset() );
-
-    const int *tab = r.subset().siteTable().slice();
-    for(int j=0; j < r.subset().numSiteTable(); ++j)
-      {
-	int i = tab[j];
-	FnLocalInnerProduct op;
-	ret.getF()[j] = op( l.elem(i) , r.getF()[j] );
-      }
-
-    return ret;
+    return sum(localInnerProductReal(s1,s2),s2.subset());
   }
 
-
-#if 0
-  template<class T1,class C1,class T2,class C2>
-  typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t
-  localInnerProduct(const QDPSubType<T1,C1> & l,const QDPSubType<T2,C2> & r)
+  template<class T1, class C1, class T2, class C2>
+  inline typename BinaryReturn<C1, C2, FnInnerProductReal>::Type_t
+  innerProductReal(const QDPSubType<T1,C1>& s1, const QDPSubType<T2,C2>& s2)
   {
-    if (!l.getOwnsMemory())
-      QDP_error_exit("localInnerProduct with subtype view called");
-    if (!r.getOwnsMemory())
-      QDP_error_exit("localInnerProduct with subtype view called");
-    if (r.subset().numSiteTable() != l.subset().numSiteTable())
-      QDP_error_exit("localInnerProduct with incompatible subset sizes");
-
-    typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t ret;
-    ret.setSubset( r.subset() );
-
-    for(int j=0; j < r.subset().numSiteTable(); ++j)
-      {
-	FnLocalInnerProduct op;
-	ret.getF()[j] = op( l.getF()[j] , r.getF()[j] );
-      }
-
-    return ret;
+    return sum(localInnerProductReal(s1,s2),s1.subset());
   }
-#endif
 
 
-  template<class T1,class C1,class T2,class C2>
-  typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Type_t
-  localColorInnerProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
+  //! OScalar = sum(source) over the subset of the source
+  template<class T>
+  typename UnaryReturn<OLattice<T>, FnSum>::Type_t
+  sum( const OSubLattice<T>& s1 )
   {
-    if (!l.getOwnsMemory())
-      QDP_error_exit("localColorInnerProduct with subtype view called");
+    if (! s1.getOwnsMemory())
+      return sum(PETE_identity(s1),s1.subset());
 
-    typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Type_t ret;
-    ret.setSubset( l.subset() );
+    typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
 
-    //QDP_info("localColorInnerProduct %d sites",l.subset().numSiteTable());
+    // Must initialize to zero since we do not know if the loop will be entered
+    zero_rep(d.elem());
 
-    const int *tab = l.subset().siteTable().slice();
-    for(int j=0; j < l.subset().numSiteTable(); ++j)
+    for(int j=0; j < s1.subset().numSiteTable(); ++j) 
       {
-	int i = tab[j];
-	FnLocalColorInnerProduct op;
-	ret.getF()[j] = op( l.getF()[j] , r.elem(i) );
+	d.elem() += s1.getF()[j];
       }
 
-    return ret;
-  }
-
-  template<class T1,class C1,class T2,class C2>
-  typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Type_t
-  localColorInnerProduct(const QDPType<T1,C1> & l,const QDPSubType<T2,C2> & r)
-  {
-    if (!r.getOwnsMemory())
-      QDP_error_exit("localColorInnerProduct with subtype view called");
+    // Do a global sum on the result
+    QDPInternal::globalSum(d);
 
-    typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalColorInnerProduct>::Type_t >::Type_t ret;
-    ret.setSubset( r.subset() );
-
-    const int *tab = r.subset().siteTable().slice();
-    for(int j=0; j < r.subset().numSiteTable(); ++j)
-      {
-	int i = tab[j];
-	FnLocalColorInnerProduct op;
-	ret.getF()[j] = op( l.elem(i) , r.getF()[j] );
-      }
-
-    return ret;
+    return d;
   }
 
 
-
-template<class T>
-typename UnaryReturn<OLattice<T>, FnSum>::Type_t
-sum( const OSubLattice<T>& s1 )
-{
-  typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
-
-  // Must initialize to zero since we do not know if the loop will be entered
-  zero_rep(d.elem());
-
-  for(int j=0; j < s1.subset().numSiteTable(); ++j) 
-    {
-      d.elem() += s1.getF()[j];
-    }
-
-  // Do a global sum on the result
-  QDPInternal::globalSum(d);
-
-  return d;
- }
-
-
   template<class T> 
   inline
   void zero_rep_F( T* dest, const Subset& s)
@@ -177,10 +98,9 @@ sum( const OSubLattice<T>& s1 )
   }
 
 
-#if 0
   //! dest  = 0 
   template<class T>
-  void zero_rep(OSubLattice<T> dd) 
+  void zero_rep(const OSubLattice<T>& dd) 
   {
     if (dd.getOwnsMemory()) {
       zero_rep_F(dd.getF(),dd.subset());
@@ -189,7 +109,6 @@ sum( const OSubLattice<T>& s1 )
       zero_rep(tmp,dd.subset());
     }
   }
-#endif
 
 
 } // namespace
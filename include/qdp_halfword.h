@@ -0,0 +1,206 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief 16 bit storage word
+ */
+
+#ifndef QDP_HALFWORD_H
+#define QDP_HALFWORD_H
+
+#include <cstring>
+#include <stdint.h>
+
+namespace QDP {
+
+/*! \addtogroup simpleword Builtin word operations
+ * \ingroup fiber
+ *
+ * @{
+ */
+
+//! bfloat16 storage word
+/*!
+ * The upper 16 bits of a REAL32: the same exponent range with 8 bits of
+ * mantissa. It is a storage type only. Fields built on it, e.g.
+ * LatticeFermionH, are read as their REAL32 versions inside expressions,
+ * so every operation computes in REAL32 and only the stores round to 16
+ * bits:
+ *
+ *   LatticeFermionH v;          // half the memory of a LatticeFermionF
+ *   v = psi;                    // rounded to nearest even
+ *   chi = a*v + chi;            // v widened on the fly
+ *   Double n = norm2(v);
+ *
+ * Binary I/O writes the 16 bit words as they are. Fill random numbers
+ * into a REAL32 field and assign it.
+ */
+class REAL16
+{
+public:
+  REAL16() {}
+  REAL16(float x) : h(fromFloat(x)) {}
+  REAL16(double x) : h(fromFloat(x)) {}
+  REAL16(int x) : h(fromFloat(x)) {}
+
+  operator float() const
+    {
+      uint32_t u = uint32_t(h) << 16;
+      float x;
+      std::memcpy(&x, &u, sizeof(x));
+      return x;
+    }
+
+  REAL16& operator+=(float x) {h = fromFloat(float(*this) + x); return *this;}
+  REAL16& operator-=(float x) {h = fromFloat(float(*this) - x); return *this;}
+  REAL16& operator*=(float x) {h = fromFloat(float(*this) * x); return *this;}
+  REAL16& operator/=(float x) {h = fromFloat(float(*this) / x); return *this;}
+
+  //! The stored bits
+  uint16_t bits() const {return h;}
+
+private:
+  //! Round to nearest even, NaN stays NaN
+  static uint16_t fromFloat(float x)
+    {
+      uint32_t u;
+      std::memcpy(&u, &x, sizeof(u));
+      if ((u & 0x7fffffff) > 0x7f800000)
+	return uint16_t((u >> 16) | 0x40);
+
+      u += 0x7fff + ((u >> 16) & 1);
+      return uint16_t(u >> 16);
+    }
+
+  uint16_t h;
+};
+
+
+//! Is T a 16 bit storage word
+template<class T>
+struct HalfWord
+{
+  enum {value = 0};
+};
+
+template<>
+struct HalfWord<REAL16>
+{
+  enum {value = 1};
+};
+
+
+//! How a site of type T enters an expression
+/*! By reference, except sites of 16 bit words go in as their REAL32 version */
+template<class T, bool = HalfWord<typename WordType<T>::Type_t>::value>
+struct SiteLoad
+{
+  typedef Reference<T> Type_t;
+  inline static Type_t load(const T& s) {return Type_t(s);}
+};
+
+template<class T>
+struct SiteLoad<T, true>
+{
+  typedef typename SinglePrecType<T>::Type_t Type_t;
+  inline static Type_t load(const T& s)
+    {
+      Type_t d;
+      d = s;
+      return d;
+    }
+};
+
+
+//! dest = 0
+inline
+void zero_rep(REAL16& dest)
+{
+  dest = 0;
+}
+
+//! dest = (mask) ? s1 : dest
+inline
+void copymask(REAL16& d, bool mask, REAL16 s1)
+{
+  if (mask)
+    d = s1;
+}
+
+
+//-----------------------------------------------------------------------------
+// Traits classes
+//-----------------------------------------------------------------------------
+
+template<>
+struct SinglePrecType<REAL16>
+{
+  typedef REAL32 Type_t;
+};
+
+template<>
+struct DoublePrecType<REAL16>
+{
+  typedef REAL64 Type_t;
+};
+
+// Any operation on the word computes in REAL32
+template<>
+struct Promote<REAL16, REAL16> {
+  typedef REAL32 Type_t;
+};
+
+template<>
+struct Promote<REAL16, int> {
+  typedef REAL32 Type_t;
+};
+
+template<>
+struct Promote<REAL16, float> {
+  typedef float Type_t;
+};
+
+template<>
+struct Promote<REAL16, double> {
+  typedef double Type_t;
+};
+
+template<>
+struct Promote<int, REAL16> {
+  typedef REAL32 Type_t;
+};
+
+template<>
+struct Promote<float, REAL16> {
+  typedef float Type_t;
+};
+
+template<>
+struct Promote<double, REAL16> {
+  typedef double Type_t;
+};
+
+template<class Op>
+struct UnaryReturn<REAL16, Op> {
+  typedef typename UnaryReturn<REAL32, Op>::Type_t  Type_t;
+};
+
+template<class T2, class Op>
+struct BinaryReturn<REAL16, T2, Op> {
+  typedef typename BinaryReturn<REAL32, T2, Op>::Type_t  Type_t;
+};
+
+template<class T1, class Op>
+struct BinaryReturn<T1, REAL16, Op> {
+  typedef typename BinaryReturn<T1, REAL32, Op>::Type_t  Type_t;
+};
+
+template<class Op>
+struct BinaryReturn<REAL16, REAL16, Op> {
+  typedef typename BinaryReturn<REAL32, REAL32, Op>::Type_t  Type_t;
+};
+
+/** @} */ // end of group simpleword
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,170 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Fields with ghost zones deep enough for several stencil steps
+ */
+
+#ifndef QDP_HALO_H
+#define QDP_HALO_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! The subgrid of this node padded by depth ghost layers on every side
+  /*!
+   * Sites of the padded box are numbered lex with x fastest, the subgrid
+   * starting at depth in every direction. The ghost layers take the
+   * sites of the neighbouring subgrids, edges and corners included,
+   * wrapping around the lattice.
+   *
+   * A stencil step reads the neighbours of a site at p + stride(mu) and
+   * p - stride(mu). After one exchange by fill(), k steps are right on
+   * the sites at least k from the edge of the box, so k <= depth steps
+   * need no further messages for the subgrid.
+   *
+   * Building the tables walks the ghost zones of this node and of the
+   * nodes around it, so keep the layout and reuse it.
+   */
+  class HaloLayout
+  {
+  public:
+    //! Ghost layers of depth, at most the smallest subgrid extent
+    explicit HaloLayout(int depth);
+
+    //! Number of ghost layers
+    int depth() const {return d;}
+
+    //! Extent of the padded box in direction mu
+    int size(int mu) const {return pad[mu];}
+
+    //! Sites in the padded box
+    int volume() const {return vol;}
+
+    //! Distance between neighbours in direction mu
+    int stride(int mu) const {return str[mu];}
+
+    //! Position of the site at local coordinate x, each from -depth to subgrid+depth-1
+    int index(const multi1d<int>& x) const;
+
+    //! Position of the on-node site with linear index i
+    int position(int linear) const {return pos[linear];}
+
+    //! Is p at least margin from the edge of the box
+    bool inside(int p, int margin) const;
+
+    //! Copy the sites of one field into its padded box, by one exchange
+    /*!
+     * Collective. halo holds volume() sites of bytes bytes each and field
+     * the sites of the node in their linear order.
+     */
+    void fill(char* halo, const char* field, size_t bytes) const;
+
+    //! Copy the subgrid of the padded box back into a field
+    void extract(char* field, const char* halo, size_t bytes) const;
+
+    //! Call f(p) on the threads for every p at least margin from the edge of the box
+    template<class Fn>
+    void forEachSite(int margin, Fn f) const
+      {
+	const int nrows = vol / pad[0];
+
+#pragma omp parallel for
+	for(int r=0; r < nrows; ++r)
+	{
+	  const int p0 = r*pad[0];
+	  if (! inside(p0 + margin, margin))
+	    continue;
+
+	  for(int x=margin; x < pad[0]-margin; ++x)
+	    f(p0 + x);
+	}
+      }
+
+  private:
+    int d;
+    multi1d<int> pad;
+    multi1d<int> str;
+    int vol;
+
+    std::vector<int> pos;          // position of each linear site
+    std::vector<int> local_dst;    // ghost positions with a source on this node
+    std::vector<int> local_src;    // their sources
+    std::vector<int> recv_pos;     // ghost positions received, by source node
+    std::vector<size_t> recv_num;  // per node
+    std::vector<int> send_sites;   // linear sites sent, by destination node
+    std::vector<size_t> send_num;  // per node
+  };
+
+
+  //! The sites of a field and its ghost zone
+  /*!
+   * Steps of a smearing, say, go back and forth between two of these:
+   *
+   *   HaloLayout h(2);
+   *   HaloField<LatticeColorVector::Subtype_t> a(h), b(h);
+   *   a.fill(psi);
+   *   h.forEachSite(1, [&](int p) { b[p] = a[p] + a[p+h.stride(0)] + ...; });
+   *   h.forEachSite(2, [&](int p) { a[p] = b[p] + b[p+h.stride(0)] + ...; });
+   *   a.extract(psi);
+   *
+   * Links used by the stencil need ghost zones as deep too.
+   */
+  template<class T>
+  class HaloField
+  {
+  public:
+    explicit HaloField(const HaloLayout& h_) : h(h_)
+      {
+	size_t bytes = size_t(h.volume())*sizeof(T);
+	try
+	{
+	  F = (T*)QDP::Allocator::theQDPAllocator::Instance().allocate(bytes, QDP::Allocator::DEFAULT);
+	}
+	catch(std::bad_alloc) {
+	  QDPIO::cerr << "Allocation failed in HaloField: " << bytes << " bytes" << std::endl;
+	  QDP::Allocator::printAllocStats();
+	  QDP_abort(1);
+	}
+      }
+
+    ~HaloField() {QDP::Allocator::theQDPAllocator::Instance().free(F);}
+
+    //! The padded box of l, by one exchange
+    /*! Collective */
+    void fill(const OLattice<T>& l)
+      {
+	h.fill((char*)F, (const char*)l.getF(), sizeof(T));
+      }
+
+    //! Copy the subgrid back into l
+    void extract(OLattice<T>& l) const
+      {
+	h.extract((char*)writable(l).getF(), (const char*)F, sizeof(T));
+      }
+
+    //! Site at position p of the padded box
+    T& operator[](int p) {return F[p];}
+    const T& operator[](int p) const {return F[p];}
+
+    const HaloLayout& layout() const {return h;}
+
+  private:
+    //! Hide copies
+    HaloField(const HaloField&);
+    void operator=(const HaloField&);
+
+    const HaloLayout& h;
+    T* F;
+  };
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,75 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Startup probe of the machine choosing threads, pool size and kernels
+ *
+ * The thread count, the size of the pool and the kernel level are set
+ * by hand for each machine, and the defaults (all the cpus of the host
+ * for every node, an 8 GB pool, the widest SIMD the CPU has) are often
+ * wrong on a new one. With -probe (or HardwareProbe::setEnabled)
+ * QDP_initialize looks at the machine before the layout is made:
+ *
+ *  - the cpus each node may use, the nodes sharing its host, the SIMD
+ *    width and the cache sizes,
+ *  - the memory free on the host, shared out over its nodes,
+ *  - the STREAM triad bandwidth for each thread count, all the nodes of
+ *    a host running at once,
+ *
+ * and from that picks the largest thread count within a few percent of
+ * the best bandwidth, a pool of most of the free memory, the fastest
+ * level of the SSE/AVX kernels and whether the autotuner is on. The
+ * nodes agree on every choice. What was found and chosen is printed.
+ * A count given by OMP_NUM_THREADS and a size given by -poolsize are
+ * kept; the thread count is only chosen with OpenMP threads, the other
+ * models having theirs fixed when they start.
+ */
+
+#ifndef QDP_HARDWARE_PROBE_H
+#define QDP_HARDWARE_PROBE_H
+
+#include <string>
+#include <vector>
+
+namespace QDP
+{
+  namespace HardwareProbe
+  {
+    //! What the probe found and chose
+    struct Config
+    {
+      int cpus;                         //!< cpus a node may run on
+      int nodes_on_host;
+      int simd_bits;                    //!< widest vector registers, 0 when unknown
+      size_t l1, l2, l3;                //!< data cache bytes, 0 when unknown
+      size_t free_bytes;                //!< free memory of the host over its nodes, least of any host
+
+      std::vector<int> thread_counts;   //!< counts timed
+      std::vector<double> triad_gbs;    //!< their triad GB/s, mean over the nodes
+
+      int threads;                      //!< the thread count used
+      bool threads_given;               //!< kept as the environment or threading model set it
+      float pool_gb;                    //!< the pool size used
+      bool pool_given;                  //!< kept from -poolsize
+      std::string kernels;              //!< level of the SSE/AVX kernels, empty when the build has none
+      bool autotune;                    //!< is the autotuner on
+    };
+
+    //! Probe at QDP_initialize or not (the default)
+    void setEnabled(bool on);
+
+    //! Is the probe on
+    bool enabled();
+
+    //! Probe and apply the choices, pool_gb being the pool size, called by QDP_initialize
+    /*! All the nodes call it together, after the threads start and before the layout */
+    void run(float& pool_gb, bool pool_given);
+
+    //! What the last run found and chose
+    const Config& config();
+
+    //! Print the config
+    void print();
+  }
+}
+
+#endif
@@ -14,6 +14,9 @@
 #include <sstream>
 #include <stack>
 #include <list>
+#include <map>
+#include <functional>
+#include <vector>
 
 #include <hdf5.h>
 
@@ -32,6 +35,45 @@ namespace QDP {
 		//access modes
 		enum accessmode{ transpose_order=(1 << 0), maintain_order=(1 << 1) };
 	}
+
+	//--------------------------------------------------------------------------------
+	//! Dataset layout and transfer settings of an HDF5Writer
+	/*!
+	The defaults reproduce the plain behaviour: no filters, collective transfer for lattice fields
+	and chunks matching the node subgrid only when a stripe size is set. Alignment is a file
+	property, so set it before open(). Filters need chunks, so they turn chunking on, and under
+	parallel HDF5 they need collective transfer, which they force.
+	*/
+	struct HDF5WriteOptions
+	{
+		//! Chunk lattice datasets by the node subgrid
+		bool chunk_subgrid;
+		//! Chunk extents of lattice datasets in lattice order, overriding chunk_subgrid when of size Nd
+		multi1d<int> chunk;
+		//! Align objects of at least align_threshold bytes to alignment bytes (the stripe size). Zero uses the constructor values
+		long int alignment, align_threshold;
+		//! Byte shuffle before compressing
+		bool shuffle;
+		//! Deflate level 1-9, zero for none
+		int deflate;
+		//! Szip pixels per block (even, at most 32), zero for none
+		int szip;
+		//! Collective rather than independent transfer of lattice fields
+		bool collective;
+		//! Report the achieved bandwidth of every lattice write
+		bool benchmark;
+		//! Metadata read by one node and handed to the others, and written together (HDF5 1.10 on). Set before open()
+		bool collective_metadata;
+		//! Rows per chunk of the datasets made by append, which is also how many are kept in memory before a write
+		int append_rows;
+
+		HDF5WriteOptions() : chunk_subgrid(false), alignment(0), align_threshold(0),
+				     shuffle(false), deflate(0), szip(0), collective(true), benchmark(false),
+				     collective_metadata(true), append_rows(64) {}
+
+		//! Are any filters on
+		bool filtered() const {return shuffle || deflate > 0 || szip > 0;}
+	};
     
 	//--------------------------------------------------------------------------------                                                                 
 	//! HDF5 reader class                                                                                                                              
@@ -64,6 +106,26 @@ namespace QDP {
 		void tokenize(const ::std::string& str, ::std::vector< ::std::string >& tokens, const ::std::string& delimiters);
 		std::vector<std::string> splitPathname(const std::string& name);
 
+		//groups opened so far by absolute path, all but the root which is file_id.
+		//They stay open until close(), so going back to a group or writing into it again
+		//takes no lookups in the file:
+		std::map<std::string, hid_t> groups;
+		//absolute path of current_group:
+		std::string cwd;
+
+		//absolute path of name seen from the current group, resolving . and ..:
+		std::string absolutePath(const std::string& name) const;
+		//the open group of an absolute path, opened and kept if it is not yet; negative if there is none:
+		hid_t groupHandle(const std::string& path);
+		//keep the group h of an absolute path:
+		void keepGroup(const std::string& path, hid_t h);
+		//close the kept groups of a path and below it, before it is unlinked:
+		void forgetGroups(const std::string& path);
+		//close all the kept groups:
+		void closeGroups();
+		//set the metadata of the file access list fapl_id to be collective, when HDF5 can:
+		static void setCollectiveMetadata(hid_t fapl_id);
+
 		//check if an object exists, by iterating through the tree:
 		bool objectExists(const std::string& name);
 		bool objectExists(hid_t loc_id, const std::string& name);
@@ -462,6 +524,60 @@ namespace QDP {
 			delete [] token;
 		}
 
+		//rows first to first+count-1 of a two-dimensional dataset, converted to memtype:
+		template<typename ctype>
+		void rdRows(const std::string& dataname, multi2d<ctype>& datum, const hid_t& memtype, const H5T_class_t& hdfclass, const ullong& first, const long long& count){
+			std::string dname(dataname);
+			if(!objectExists(current_group,dname)){
+				HDF5_error_exit("HDF5::readRows: error reading "+dataname+", dataset does not exists!");
+			}
+			hid_t dset_id=H5Dopen(current_group,dname.c_str(),H5P_DEFAULT);
+			if(dset_id<0){
+				HDF5_error_exit("HDF5::readRows: error reading "+dataname+", cannot open dataset!");
+			}
+			hid_t type_id=H5Dget_type(dset_id);
+			if(H5Tget_class(type_id)!=hdfclass){
+				HDF5_error_exit("HDF5::readRows: error reading "+dataname+", datatype mismatch!");
+			}
+			H5Tclose(type_id);
+
+			hid_t filespace=H5Dget_space(dset_id);
+			if(H5Sget_simple_extent_ndims(filespace)!=2){
+				HDF5_error_exit("HDF5::readRows: error, "+dataname+" is not two-dimensional!");
+			}
+			hsize_t dims[2];
+			H5Sget_simple_extent_dims(filespace, dims, NULL);
+			hsize_t nrows=(count<0 ? (first<dims[0] ? dims[0]-first : 0) : static_cast<hsize_t>(count));
+			if(first+nrows>dims[0]){
+				HDF5_error_exit("HDF5::readRows: error, the rows asked for are past the end of "+dataname+"!");
+			}
+
+			//select the rows in the file, all nodes read the same:
+			hsize_t start[2]={first,0}, block[2]={nrows,dims[1]};
+			datum.resize(nrows,dims[1]);
+			if(nrows>0 && dims[1]>0){
+				H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, block, NULL);
+				hid_t memspace=H5Screate_simple(2, block, NULL);
+				ctype* token=new ctype[nrows*dims[1]];
+				hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
+				H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+				herr_t status=H5Dread(dset_id,memtype,memspace,filespace,plist_id,static_cast<void*>(token));
+				H5Pclose(plist_id);
+				H5Sclose(memspace);
+				if(status<0){
+					HDF5_error_exit("HDF5::readRows: error reading "+dataname+"!");
+				}
+				for(hsize_t i=0; i<nrows; i++){
+					for(hsize_t j=0; j<dims[1]; j++){
+						datum(i,j)=token[j+dims[1]*i]; //HDF5 stores row-major
+					}
+				}
+				delete [] token;
+			}
+			H5Sclose(filespace);
+			H5Dclose(dset_id);
+		}
+
 		//***********************************************************************************************************************************
 		//***********************************************************************************************************************************
 		//READING CUSTOM OBJECTS HELPERS                                                                                                     
@@ -472,7 +588,20 @@ namespace QDP {
 		void readPrepareLattice(const std::string& name, hid_t& type_id, multi1d<ullong>& sizes);
 
 		void readLattice(const std::string& name, const hid_t& type_id, const hid_t& base_type_id,
-		const ullong& obj_size, const ullong& tot_size, char* buf, bool invert_order=true);
+		const ullong& obj_size, const ullong& tot_size, char* buf, bool invert_order=true, const hid_t& mem_type_id=-1);
+
+		//native HDF5 type of a floating point word:
+		template<typename wtd>
+		static hid_t nativeFloatType(){
+			return (sizeof(wtd)==4 ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE);
+		}
+
+		//read the sites of the box lower..lower+extent-1 of a lattice dataset of words_per_site floats per site,
+		//as mem_type_id. Every node reads the part of the box it holds in slabs, put gets each slab with the
+		//linear indices of its sites:
+		void readLatticeRegion(const std::string& name, const hid_t& mem_type_id, const ullong& words_per_site,
+		const multi1d<int>& lower, const multi1d<int>& extent, bool invert_order,
+		const std::function<void(const std::vector<int>&, const char*)>& put);
 
 	public:		
 		//open and close files. Open is virtual since the openmode differs for reader and writer:                                                        
@@ -554,6 +683,14 @@ namespace QDP {
 		void read(const std::string& obj_name, multi2d<unsigned long long>& datum);
 		void read(const std::string& obj_name, multi2d<float>& datum);
 		void read(const std::string& obj_name, multi2d<double>& datum);
+
+		//rows of two-dimensional datasets, like those HDF5Writer::append makes: the count rows
+		//from row first on, or all of them from first on when count is negative:
+		void readRows(const std::string& obj_name, multi2d<int>& datum, const ullong& first=0, const long long& count=-1);
+		void readRows(const std::string& obj_name, multi2d<float>& datum, const ullong& first=0, const long long& count=-1);
+		void readRows(const std::string& obj_name, multi2d<double>& datum, const ullong& first=0, const long long& count=-1);
+		//number of rows of a dataset, the extent of its first dimension:
+		ullong numRows(const std::string& obj_name);
 	
 		//***********************************************************************************************************************************
 		//***********************************************************************************************************************************
@@ -712,43 +849,19 @@ namespace QDP {
 			const int mynode=Layout::nodeNumber();
 			const int nodeSites = Layout::sitesOnNode();
 			size_t tot_size = obj_size*nodeSites;
-			char* buf = new(std::nothrow) char[tot_size*hdf5_float_size];
+			//HDF5 converts to the precision of the field while reading, so no second buffer:
+			char* buf = new(std::nothrow) char[tot_size*field_float_size];
 			if( buf == 0x0 ) {
 				HDF5_error_exit("Unable to allocate buf\n");
 			}
-			readLattice(name,type_id,type_id,obj_size,tot_size,buf,invert_order);
+			readLattice(name,type_id,type_id,obj_size,tot_size,buf,invert_order,nativeFloatType<wtd>());
 			H5Tclose(type_id);
 			if(profile) swatch_read.stop();
 
 			//put lattice into u-field and reconstruct as well as reorder them on the fly:
 			// Reconstruct the gauge field
 			if(profile) swatch_reorder.start();
-			/*#pragma omp parallel for firstprivate(nodeSites,obj_size,float_size) shared(buf,field)
-			for(unsigned int run=0; run<nodeSites; run++){
-			memcpy(&(field.elem(reordermap[run])),reinterpret_cast<char*>(buf+run*obj_size),float_size*obj_size);
-			}*/
-			if(hdf5_float_size==field_float_size){
-				//convert layout directly
-				CvtToLayout(field,reinterpret_cast<void*>(buf),nodeSites,sizeof(T));
-			}
-			else{
-				//convert precision first
-				wtd* tmpbuf=new wtd[tot_size];
-				for(unsigned int i=0; i<tot_size; i++){
-					if(hdf5_float_size==4){
-						REAL32 tmpfloat;
-						memcpy(&tmpfloat,&buf[i*hdf5_float_size],hdf5_float_size);
-						tmpbuf[i]=static_cast< wtd >(tmpfloat);
-					}
-					else{
-						REAL64 tmpfloat;
-						memcpy(&tmpfloat,&buf[i*hdf5_float_size],hdf5_float_size);
-						tmpbuf[i]=static_cast< wtd >(tmpfloat);
-					}
-				}
-				CvtToLayout(field,reinterpret_cast<void*>(tmpbuf),nodeSites,sizeof(T));
-				delete [] tmpbuf;
-			}
+			CvtToLayout(field,reinterpret_cast<void*>(buf),nodeSites,sizeof(T));
 			delete [] buf;
 			if(profile) swatch_reorder.stop();
 			
@@ -829,11 +942,12 @@ namespace QDP {
 			const int mynode=Layout::nodeNumber();
 			const int nodeSites = Layout::sitesOnNode();
 			size_t tot_size = obj_size*arr_size*nodeSites;
-			char* buf = new(std::nothrow) char[tot_size*hdf5_float_size];
+			//HDF5 converts to the precision of the fields while reading, so no second buffer:
+			char* buf = new(std::nothrow) char[tot_size*field_float_size];
 			if( buf == 0x0 ) {
 				HDF5_error_exit("Unable to allocate buf!");
 			}
-			readLattice(name,type_id,type_id,obj_size*arr_size,tot_size,buf,invert_order);
+			readLattice(name,type_id,type_id,obj_size*arr_size,tot_size,buf,invert_order,nativeFloatType<wtd>());
 			H5Tclose(type_id);
 			if(profile) swatch_read.stop();
 
@@ -841,34 +955,7 @@ namespace QDP {
 			// Reconstruct the gauge field
 			if(profile) swatch_reorder.start();
 			fieldarray.resize(arr_size);
-			/*#pragma omp parallel for firstprivate(nodeSites,arr_size,obj_size,float_size) shared(buf,fieldarray)
-			for(unsigned int run=0; run<nodeSites; run++){
-			for(unsigned int dd=0; dd<arr_size; dd++){
-			memcpy(&(fieldarray[dd].elem(reordermap[run])),reinterpret_cast<char*>(buf+(dd+arr_size*run)*obj_size),float_size*obj_size);
-			}
-			}*/
-			if(hdf5_float_size==field_float_size){
-				//convert layout directly
-				CvtToLayout(fieldarray,reinterpret_cast<void*>(buf),nodeSites,arr_size,sizeof(T));
-			}
-			else{
-				//convert precision first
-				wtd* tmpbuf=new wtd[tot_size];
-				for(unsigned int i=0; i<tot_size; i++){
-					if(hdf5_float_size==4){
-						REAL32 tmpfloat;
-						memcpy(&tmpfloat,&buf[i*hdf5_float_size],hdf5_float_size);
-						tmpbuf[i]=static_cast< wtd >(tmpfloat);
-					}
-					else{
-						REAL64 tmpfloat;
-						memcpy(&tmpfloat,&buf[i*hdf5_float_size],hdf5_float_size);
-						tmpbuf[i]=static_cast< wtd >(tmpfloat);
-					}
-				}
-				CvtToLayout(fieldarray,reinterpret_cast<void*>(tmpbuf),nodeSites,arr_size,sizeof(T));
-				delete [] tmpbuf;
-			}
+			CvtToLayout(fieldarray,reinterpret_cast<void*>(buf),nodeSites,arr_size,sizeof(T));
 			delete [] buf;
 			if(profile) swatch_reorder.stop();
 			
@@ -882,6 +969,43 @@ namespace QDP {
 			}
 		}
 
+		//read part of an OLattice object:
+		/*!
+		Only the sites of the box lower..lower+extent-1 (in lattice coordinates, without wrapping)
+		are read, the other sites of field keep their values. Each node selects the part of the box
+		it holds and reads it in slabs, converted to the precision of field by HDF5, so a few
+		timeslices of an archived propagator cost the time and memory of those timeslices.
+		*/
+		template<class T>
+		void readRegion(const std::string& name, OLattice<T>& field, const multi1d<int>& lower, const multi1d<int>& extent,
+				const HDF5Base::accessmode& accmode=HDF5Base::transpose_order)
+		{
+			typedef typename WordType<T>::Type_t wtd;
+
+			readLatticeRegion(name,nativeFloatType<wtd>(),sizeof(T)/sizeof(wtd),lower,extent,
+					  accmode==HDF5Base::transpose_order,
+					  [&](const std::vector<int>& sites, const char* buf){
+						  for(size_t k=0; k<sites.size(); k++){
+							  memcpy(&(field.elem(sites[k])),buf+k*sizeof(T),sizeof(T));
+						  }
+					  });
+		}
+
+		//read the timeslices t0..t0+nt-1 of an OLattice object, see readRegion:
+		template<class T>
+		void readTimeslices(const std::string& name, OLattice<T>& field, int t0, int nt,
+				    const HDF5Base::accessmode& accmode=HDF5Base::transpose_order)
+		{
+			multi1d<int> lower(Nd), extent(Nd);
+			for(int mu=0; mu<Nd; mu++){
+				lower[mu]=0;
+				extent[mu]=Layout::lattSize()[mu];
+			}
+			lower[Nd-1]=t0;
+			extent[Nd-1]=nt;
+			readRegion(name,field,lower,extent,accmode);
+		}
+
 		//special file formats
 		//Qlua
 		void readQlua(const std::string& name, multi1d<LatticeColorMatrixD3>& field);
@@ -1132,22 +1256,20 @@ namespace QDP {
 			hsize_t size[1];
 			size[0]=static_cast<hsize_t>(datum.size());
 			herr_t errhandle=H5Sset_extent_simple(spaceid,1,size,size);
-			dataid=H5Dcreate(current_group,dname.c_str(),hdftype,spaceid,H5P_DEFAULT,H5P_DEFAULT,H5P_DEFAULT);
+			hid_t dcpl_id = createPrimaryDcpl(1,size);
+			dataid=H5Dcreate(current_group,dname.c_str(),hdftype,spaceid,H5P_DEFAULT,dcpl_id,H5P_DEFAULT);
+			H5Pclose(dcpl_id);
 			H5Sclose(spaceid);
 
-			hid_t plist_id = H5Pcreate (H5P_DATASET_XFER);
-			herr_t status = H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_INDEPENDENT);
-
+			herr_t status = 0;
+			ctype* datumcpy = 0x0;
 			if (Layout::nodeNumber()==0) { // CAREFULL THIS IS ONLY ON NODE=0!!!,
 				// do nothing collective, throw or exit here
-				ctype* datumcpy=new(std::nothrow) ctype[datum.size()];
+				datumcpy=new(std::nothrow) ctype[datum.size()];
 
 				if ( datumcpy != 0x0 ) {
 					for(ullong i=0; i<datum.size(); i++)
 						datumcpy[i]=datum[i];
-
-					status = H5Dwrite(dataid,hdftype,H5S_ALL,H5S_ALL,plist_id,static_cast<void*>(datumcpy));
-					delete [] datumcpy;
 				}
 				else {
 					QDPIO::cerr << "HDF5Writer::wt - buffer alloc failed" << std::endl;
@@ -1155,12 +1277,16 @@ namespace QDP {
 				}
 			}
 
+			// collective when filtered, so every node takes part
+			herr_t wstatus = writePrimary(dataid,hdftype,static_cast<void*>(datumcpy));
+			if (status == 0) status = wstatus;
+			delete [] datumcpy;
+
 			int g_stat = 0;
 			get_global(g_stat, (int)status);    // get node 0 value
 			if (g_stat < 0)
 				HDF5_error_exit("write from node ZERO failed");
 
-			status = H5Pclose(plist_id);
 			status = H5Dclose(dataid);
 		}
 
@@ -1190,17 +1316,16 @@ namespace QDP {
 			spacesize[1]=datum.size1();
 			spacesize[0]=datum.size2();
 			spaceid = H5Screate_simple(static_cast<int>(rank), const_cast<const hsize_t*>(spacesize), NULL);
-			hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+			hid_t dcpl_id = createPrimaryDcpl(static_cast<int>(rank),spacesize);
 			dataid=H5Dcreate(current_group,dname.c_str(),hdftype,spaceid,H5P_DEFAULT,dcpl_id,H5P_DEFAULT);
 			H5Pclose(dcpl_id);
 			H5Sclose(spaceid);
 
-			hid_t plist_id = H5Pcreate (H5P_DATASET_XFER);
-			herr_t status = H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_INDEPENDENT);
-
+			herr_t status = 0;
+			ctype* datumcpy = 0x0;
 			if (Layout::nodeNumber()==0) { // CAREFULL THIS IS ONLY ON NODE=0!!!,
 				// do nothing collective, throw or exit here
-				ctype* datumcpy = new(std::nothrow) ctype[spacesize[0]*spacesize[1]];
+				datumcpy = new(std::nothrow) ctype[spacesize[0]*spacesize[1]];
 
 				if ( datumcpy != 0x0 ) {
 					for (ullong i=0; i<spacesize[0]; i++) {
@@ -1208,9 +1333,6 @@ namespace QDP {
 							datumcpy[j+spacesize[1]*i]=datum(i,j);	//row-major
 						}
 					}
-			
-					status = H5Dwrite(dataid,hdftype,H5S_ALL,H5S_ALL,plist_id,static_cast<void*>(datumcpy));
-					delete [] datumcpy;
 				}
 				else {
 					QDPIO::cerr << "HDF5Writer::wt - buffer alloc failed" << std::endl;
@@ -1218,12 +1340,16 @@ namespace QDP {
 				}
 			}
 
+			// collective when filtered, so every node takes part
+			herr_t wstatus = writePrimary(dataid,hdftype,static_cast<void*>(datumcpy));
+			if (status == 0) status = wstatus;
+			delete [] datumcpy;
+
 			int g_stat = 0;
 			get_global(g_stat, (int)status);    // get node 0 value
 			if (g_stat < 0)
 				HDF5_error_exit("write from node ZERO failed");
 
-			status = H5Pclose(plist_id);
 			status = H5Dclose(dataid);
 		}
 		//***********************************************************************************************************************************
@@ -1235,6 +1361,55 @@ namespace QDP {
 		void writePrepare(const std::string& name, const HDF5Base::writemode& mode);
 		void writeLattice(const std::string& name, const hid_t& datatype, const ullong& obj_size, char* buf);
 
+		//layout and transfer settings:
+		HDF5WriteOptions wopts;
+
+		//add the filters in wopts to a dataset creation list:
+		void setFilters(hid_t dcpl_id);
+
+		//creation list for a dataset written from node 0, chunked and filtered as wopts asks:
+		hid_t createPrimaryDcpl(int rank, const hsize_t* dims);
+
+		//write a dataset from node 0. Called on all nodes, with buf only on node 0:
+		herr_t writePrimary(hid_t dataid, const hid_t& hdftype, const void* buf);
+
+		//rows appended to a dataset and not yet written, by absolute path of the dataset:
+		struct AppendBuffer{
+			hid_t memtype;
+			hsize_t rowlen, rows_in_file, nrows;
+			std::vector<char> rows;
+		};
+		std::map<std::string, AppendBuffer> appends;
+
+		//find or make the extensible dataset of path, rows of rowlen elements of class hdfclass:
+		void appendPrepare(const std::string& dataname, const std::string& path, const hid_t& hdftype, const hsize_t& rowlen);
+		//extend the dataset by the buffered rows and write them:
+		void appendFlush(const std::string& path, AppendBuffer& buffer);
+
+		template<typename ctype>
+		void ap(const std::string& dataname, const multi1d<ctype>& row, const hid_t& hdftype){
+			assert_global_size(row);
+			std::string path=absolutePath(dataname);
+			if(appends.find(path)==appends.end()){
+				appendPrepare(dataname,path,hdftype,static_cast<hsize_t>(row.size()));
+			}
+			AppendBuffer& buffer=appends[path];
+			if(buffer.rowlen!=static_cast<hsize_t>(row.size())){
+				HDF5_error_exit("HDF5Writer::append: error, the row appended to "+dataname+" differs in length from the rows before!");
+			}
+			if(buffer.memtype!=hdftype){
+				HDF5_error_exit("HDF5Writer::append: error, the row appended to "+dataname+" differs in type from the rows before!");
+			}
+
+			//only node 0 writes, the other nodes just count the rows:
+			if(Layout::nodeNumber()==0){
+				const char* bytes=reinterpret_cast<const char*>(row.slice());
+				buffer.rows.insert(buffer.rows.end(), bytes, bytes+row.size()*sizeof(ctype));
+			}
+			buffer.nrows++;
+			if(buffer.nrows>=static_cast<hsize_t>(std::max(wopts.append_rows,1))) appendFlush(path,buffer);
+		}
+
 	public:
 		//! Empty constructors
 		HDF5Writer();
@@ -1253,6 +1428,28 @@ namespace QDP {
 
 		void open(const std::string& filename, const HDF5Base::writemode& mode);
 
+		//dataset layout and transfer settings, see HDF5WriteOptions:
+		void set_write_options(const HDF5WriteOptions& options){wopts=options;};
+		const HDF5WriteOptions& get_write_options()const{return wopts;};
+
+		//write the rows still buffered by append, then close the file:
+		int close();
+
+		/*!
+		Append row as the next row of the two-dimensional dataset obj_name, for measurements
+		that come one configuration or source at a time, like a correlator C[config][t]. The
+		dataset is made at the first append with its row count unlimited and chunks of
+		append_rows rows (see HDF5WriteOptions), filtered as the options ask; if it exists
+		already, rows are added after those it holds. Rows are kept in memory and written a
+		chunk at a time, the rest at flushAppends() or close(). All nodes call it with the same
+		row length, the values of node 0 are written. Read the rows back with readRows.
+		*/
+		void append(const std::string& obj_name, const multi1d<int>& row);
+		void append(const std::string& obj_name, const multi1d<float>& row);
+		void append(const std::string& obj_name, const multi1d<double>& row);
+		//write the rows appended so far, say before a checkpoint:
+		void flushAppends();
+
 		/*!
 		Creates a new group and steps down into it (push) or not (mkdir). If it already exists, simply step into it. Creates new groups on the way down the tree:
 		*/
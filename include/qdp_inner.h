@@ -578,8 +578,12 @@ public:
   const T& elem(int i) const {return F[i];}
 
 private:
+  //! The lanes, aligned as a vector when it fits the OLattice alignment
+  enum {align = (sizeof(T)*N <= QDP_ALIGNMENT_SIZE && (sizeof(T)*N & (sizeof(T)*N-1)) == 0) ?
+	sizeof(T)*N : alignof(T)};
+
   /*! For now a fixed representation */
-  T F[N];
+  alignas(align) T F[N];
 
 };
 
@@ -68,6 +68,13 @@ namespace QDP
     virtual void read(double& result);
     virtual void read(bool& result);
 
+    //! Read the next values on the primary node only
+    /*! Nests. Pair with endObject, which broadcasts them in one go */
+    void beginObject() {++object_depth;}
+
+    //! End an object begun with beginObject, broadcasting its n bytes at p
+    void endObject(void* p, int n);
+
   protected:
     //! The universal data-reader.
     /*!
@@ -80,6 +87,10 @@ namespace QDP
 
     //! Get the internal input stream
     virtual std::istream& getIstream() = 0;
+
+  private:
+    //! Depth of beginObject, values are only broadcast at depth zero
+    int object_depth;
   };
 
 
@@ -407,6 +418,15 @@ namespace QDP
 
     virtual void readArrayPrimaryNodeLittleEndian(char* output, size_t nbytes, size_t nmemb);
 
+    //! Read bytes in file order on the primary node only
+    /*!
+      Nothing is byte swapped, but the bytes go into the checksum. The
+      lattice readers use this and swap the words as they scatter them.
+      \param output The location to which data is read
+      \param nbytes The number of bytes
+    */
+    virtual void readBytesPrimaryNode(char* output, size_t nbytes);
+
     // Overloaded reader functions
     virtual void readDesc(std::string& result);
 
@@ -461,6 +481,16 @@ namespace QDP
     /*! The checksum is reset */
     virtual void rewind();
 
+    //! File that every node may read its own sites of a lattice field from
+    /*! Empty unless this is a BinaryFileReader in parallel mode */
+    virtual std::string parallelFile() {return std::string();}
+
+    //! Start a parallel read - returns the current position on all nodes
+    off_type parallelBegin();
+
+    //! Finish a parallel read of len bytes from start with checksum crc
+    void parallelEnd(off_type start, size_t len, QDPUtil::n_uint32_t crc);
+
   protected:
     //! The universal data-reader.
     /*!
@@ -514,6 +544,63 @@ namespace QDP
 #endif
 
 
+  //! Types whose binary form is their memory, as words of Word_t
+  /*!
+    An array of such a type is read and written with one readArray or
+    writeArray call, which swaps and checksums the whole block in one
+    pass and, on many nodes, broadcasts it once. The bytes in the file
+    are the same as element by element. A fixed size key or value type
+    may specialise this when its write is one writeArray of its words.
+  */
+  template<class T>
+  struct BinaryBulk
+  {
+    enum {value = 0};
+  };
+
+  template<class W>
+  struct BinaryBulkWord
+  {
+    enum {value = 1};
+    typedef W Word_t;
+  };
+
+  template<> struct BinaryBulk<char> : public BinaryBulkWord<char> {};
+  template<> struct BinaryBulk<int> : public BinaryBulkWord<int> {};
+  template<> struct BinaryBulk<unsigned int> : public BinaryBulkWord<unsigned int> {};
+  template<> struct BinaryBulk<short int> : public BinaryBulkWord<short int> {};
+  template<> struct BinaryBulk<unsigned short int> : public BinaryBulkWord<unsigned short int> {};
+  template<> struct BinaryBulk<long int> : public BinaryBulkWord<long int> {};
+  template<> struct BinaryBulk<unsigned long int> : public BinaryBulkWord<unsigned long int> {};
+  template<> struct BinaryBulk<long long int> : public BinaryBulkWord<long long int> {};
+  template<> struct BinaryBulk<float> : public BinaryBulkWord<float> {};
+  template<> struct BinaryBulk<double> : public BinaryBulkWord<double> {};
+  template<> struct BinaryBulk<std::complex<float> > : public BinaryBulkWord<float> {};
+  template<> struct BinaryBulk<std::complex<double> > : public BinaryBulkWord<double> {};
+
+  //! Select the element by element or the bulk path
+  template<bool B> struct BinaryBulkTag {};
+
+  //! Read n elements from bin into d, one at a time
+  template<class T>
+  inline
+  void readElems(BinaryReader& bin, T* d, int n, BinaryBulkTag<false>)
+  {
+    for(int i=0; i < n; ++i)
+      read(bin, d[i]);
+  }
+
+  //! Read n elements from bin into d as one block of words
+  template<class T>
+  inline
+  void readElems(BinaryReader& bin, T* d, int n, BinaryBulkTag<true>)
+  {
+    typedef typename BinaryBulk<T>::Word_t W;
+    if (n > 0)
+      bin.readArray((char *)d, sizeof(W), size_t(n)*(sizeof(T)/sizeof(W)));
+  }
+
+
   //! Read a binary multi1d object
   /*!
     This assumes that the number of elements to be read is also written in
@@ -533,8 +620,8 @@ namespace QDP
     read(bin, n);    // the size is always written, even if 0
     d.resize(n);
 
-    for(int i=0; i < d.size(); ++i)
-      read(bin, d[i]);
+    if (n > 0)
+      readElems(bin, &d[0], n, BinaryBulkTag<BinaryBulk<T>::value>());
   }
 
 
@@ -554,8 +641,8 @@ namespace QDP
   inline
   void read(BinaryReader& bin, multi1d<T>& d, int num)
   {
-    for(int i=0; i < num; ++i)
-      read(bin, d[i]);
+    if (num > 0)
+      readElems(bin, &d[0], num, BinaryBulkTag<BinaryBulk<T>::value>());
   }
 
   //! Read a binary multi2d object
@@ -979,6 +1066,17 @@ namespace QDP
     //! Closes the last file opened
     void close();
 
+    //! Let every node read its own sites of lattice fields
+    /*!
+      In parallel mode each node reads the sites it holds with pread
+      straight from the file, which must be visible to all nodes. The
+      byte layout and the checksum are the same as in serial mode.
+      Only the parscalar build makes use of it.
+    */
+    void setParallel(bool p) {parallel = p;}
+
+    std::string parallelFile() {return parallel ? path : std::string();}
+
   protected:
     //! Get the current checksum to modify
     QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
@@ -990,6 +1088,95 @@ namespace QDP
     //! Checksum
     QDPUtil::n_uint32_t checksum;
     std::ifstream f;
+    std::string path;
+    bool parallel;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Binary input class reading a file mapped into memory
+  /*!
+    Reads the same big-endian data as a BinaryFileReader, but every node
+    maps the file read-only and reads its own copy straight out of the
+    mapping. There is no broadcast, so a seek and a read cost a memcpy
+    from the page cache, and the ranks on one host share the pages.
+
+    Every node must call the same sequence of reads. Lattice fields read
+    this way still go through the primary node.
+  */
+  class BinaryMappedFileReader : public BinaryReader
+  {
+  public:
+    BinaryMappedFileReader();
+
+    //! Unmaps the file
+    ~BinaryMappedFileReader();
+
+    //! Maps a file for reading
+    explicit BinaryMappedFileReader(const std::string& p);
+
+    //! Queries whether a file is mapped
+    bool is_open() {return base != 0;}
+
+    //! Maps a file for reading
+    void open(const std::string& p);
+
+    //! Unmaps the file
+    void close();
+
+    //! Start of the mapped file
+    const char* data() const {return base;}
+
+    //! Length of the mapped file
+    size_t size() const {return len;}
+
+    void readArrayPrimaryNode(char* output, size_t nbytes, size_t nmemb);
+    void readArray(char* output, size_t nbytes, size_t nmemb);
+    void readArrayLittleEndian(char* output, size_t nbytes, size_t nmemb);
+    void readArrayPrimaryNodeLittleEndian(char* output, size_t nbytes, size_t nmemb);
+    void readBytesPrimaryNode(char* output, size_t nbytes);
+    void readDesc(std::string& result);
+    void read(std::string& result, size_t nbytes);
+    using BinaryReader::read;
+
+    bool fail();
+    QDPUtil::n_uint32_t getChecksum();
+    pos_type currentPosition();
+    void seek(pos_type off);
+    void seekBegin(off_type off);
+    void seekRelative(off_type off);
+    void seekEnd(off_type off);
+    void rewind();
+
+  protected:
+    //! Get the current checksum to modify
+    QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+
+    //! Get the internal input stream
+    std::istream& getIstream() {return f;}
+
+  private:
+    //! Hide copies
+    BinaryMappedFileReader(const BinaryMappedFileReader&);
+    void operator=(const BinaryMappedFileReader&);
+
+    //! Stream buffer whose get area is the whole mapping
+    class MappedBuf : public std::streambuf
+    {
+    public:
+      void set(const char* p, size_t n) {char* b = const_cast<char*>(p); setg(b, b, b+n);}
+
+    protected:
+      pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which);
+      pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+    };
+
+    //! Checksum
+    QDPUtil::n_uint32_t checksum;
+    const char* base;
+    size_t len;
+    MappedBuf buf;
+    std::istream f;
   };
 
 
@@ -1032,6 +1219,15 @@ namespace QDP
     */
     virtual void writeArrayPrimaryNode(const char* output, size_t nbytes, size_t nmemb);
 
+    //! Write bytes already in file order from the primary node only
+    /*!
+      Nothing is byte swapped, but the bytes go into the checksum. The
+      lattice writers swap the words as they gather them and use this.
+      \param output The data to write
+      \param nbytes The number of bytes
+    */
+    virtual void writeBytesPrimaryNode(const char* output, size_t nbytes);
+
     //! Write data from the primary node.
     /*!
       \param output The data to write
@@ -1100,6 +1296,16 @@ namespace QDP
     /*! The checksum is reset */
     virtual void rewind();
 
+    //! File that every node may write its own sites of a lattice field to
+    /*! Empty unless this is a BinaryFileWriter in parallel mode */
+    virtual std::string parallelFile() {return std::string();}
+
+    //! Start a parallel write - flushes and returns the position on all nodes
+    off_type parallelBegin();
+
+    //! Finish a parallel write of len bytes at start with checksum crc
+    void parallelEnd(off_type start, size_t len, QDPUtil::n_uint32_t crc);
+
   protected:
 
     //! The universal data-writer.
@@ -1156,6 +1362,25 @@ namespace QDP
   void write(BinaryWriter& bin, const std::complex<double>& param);
 #endif
 
+  //! Write n elements of d to bin, one at a time
+  template<class T>
+  inline
+  void writeElems(BinaryWriter& bin, const T* d, int n, BinaryBulkTag<false>)
+  {
+    for(int i=0; i < n; ++i)
+      write(bin, d[i]);
+  }
+
+  //! Write n elements of d to bin as one block of words
+  template<class T>
+  inline
+  void writeElems(BinaryWriter& bin, const T* d, int n, BinaryBulkTag<true>)
+  {
+    typedef typename BinaryBulk<T>::Word_t W;
+    if (n > 0)
+      bin.writeArray((const char *)d, sizeof(W), size_t(n)*(sizeof(T)/sizeof(W)));
+  }
+
   //! Write all of a binary multi1d object
   /*!
     This also writes the number of elements to the file.
@@ -1169,8 +1394,7 @@ namespace QDP
   void write(BinaryWriter& bin, const multi1d<T>& d)
   {
     write(bin, d.size());    // always write the size
-    for(int i=0; i < d.size(); ++i)
-      write(bin, d[i]);
+    writeElems(bin, d.slice(), d.size(), BinaryBulkTag<BinaryBulk<T>::value>());
   }
 
   //! Write some or all of a binary multi1d object
@@ -1186,8 +1410,7 @@ namespace QDP
   inline
   void write(BinaryWriter& bin, const multi1d<T>& d, int num)
   {
-    for(int i=0; i < num; ++i)
-      write(bin, d[i]);
+    writeElems(bin, d.slice(), num, BinaryBulkTag<BinaryBulk<T>::value>());
   }
 
 
@@ -1471,6 +1694,17 @@ namespace QDP
     //! Flushes the buffer
     void flush();
 
+    //! Let every node write its own sites of lattice fields
+    /*!
+      In parallel mode each node writes the sites it holds with pwrite
+      straight into the file, which must be visible to all nodes. The
+      byte layout and the checksum are the same as in serial mode.
+      Only the parscalar build makes use of it.
+    */
+    void setParallel(bool p) {parallel = p;}
+
+    std::string parallelFile() {return parallel ? path : std::string();}
+
   protected:
     //! Get the current checksum to modify
     QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
@@ -1482,6 +1716,8 @@ namespace QDP
     //! Checksum
     QDPUtil::n_uint32_t checksum;
     std::ofstream f;
+    std::string path;
+    bool parallel;
   };
 
 
@@ -1676,6 +1912,122 @@ namespace QDP
   };
 
 
+  //--------------------------------------------------------------------------------
+  //!  Binary input/output private to one node
+  /*!
+    The same big-endian format and checksums as a BinaryReaderWriter, but
+    the stream belongs to the calling node alone. Every node may read or
+    write its own stream at its own pace: there is no primary node and
+    nothing is communicated.
+  */
+  class BinaryLocalReaderWriter : public BinaryReaderWriter
+  {
+  public:
+    void readArrayPrimaryNode(char* output, size_t nbytes, size_t nmemb);
+    void readArray(char* output, size_t nbytes, size_t nmemb);
+    void readArrayLittleEndian(char* output, size_t nbytes, size_t nmemb);
+    void readArrayPrimaryNodeLittleEndian(char* output, size_t nbytes, size_t nmemb);
+    void readBytesPrimaryNode(char* output, size_t nbytes);
+    void readDesc(std::string& result);
+    void read(std::string& result, size_t nbytes);
+    using BinaryReader::read;
+
+    void writeArrayPrimaryNode(const char* output, size_t nbytes, size_t nmemb);
+    void writeArray(const char* output, size_t nbytes, size_t nmemb);
+    void writeBytesPrimaryNode(const char* output, size_t nbytes);
+
+    bool fail();
+    QDPUtil::n_uint32_t getChecksum();
+    pos_type currentPosition();
+    void seek(pos_type off);
+    void seekBegin(off_type off);
+    void seekRelative(off_type off);
+    void seekEnd(off_type off);
+    void rewind();
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Binary file input/output class private to one node
+  class BinaryLocalFileReaderWriter : public BinaryLocalReaderWriter
+  {
+  public:
+    BinaryLocalFileReaderWriter();
+
+    //! Closes the last file opened
+    ~BinaryLocalFileReaderWriter();
+
+    //! Opens a file on this node
+    explicit BinaryLocalFileReaderWriter(const std::string& p, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out);
+
+    //! Queries whether the file is open
+    bool is_open() {return f.is_open();}
+
+    //! Opens a file on this node
+    void open(const std::string& p, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out);
+
+    //! Closes the last file opened
+    void close();
+
+    //! Flushes the buffer
+    void flush();
+
+  protected:
+    //! Get the current checksum to modify
+    QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+
+    //! Get the internal input stream
+    std::istream& getIstream() {return f;}
+
+    //! Get the internal output stream
+    std::ostream& getOstream() {return f;}
+
+    //! Get the internal inpu/output stream
+    std::iostream& getIOstream() {return f;}
+
+  private:
+    //! Checksum
+    QDPUtil::n_uint32_t checksum;
+    std::fstream f;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //!  Binary buffer input/output class private to one node
+  class BinaryLocalBufferReaderWriter : public BinaryLocalReaderWriter
+  {
+  public:
+    BinaryLocalBufferReaderWriter() {checksum=0;}
+
+    //! Construct from a string
+    explicit BinaryLocalBufferReaderWriter(const std::string& s) : f(s) {checksum=0;}
+
+    //! Return entire buffer as a string
+    std::string str() const {return f.str();}
+
+    //! Nothing to flush
+    void flush() {}
+
+  protected:
+    //! Get the current checksum to modify
+    QDPUtil::n_uint32_t& internalChecksum() {return checksum;}
+
+    //! Get the internal input stream
+    std::istream& getIstream() {return f;}
+
+    //! Get the internal output stream
+    std::ostream& getOstream() {return f;}
+
+    //! Get the internal inpu/output stream
+    std::iostream& getIOstream() {return f;}
+
+  private:
+    //! Checksum
+    QDPUtil::n_uint32_t checksum;
+    std::stringstream f;
+  };
+
+
   /*! @} */   // end of group io
 } // namespace QDP
 
@@ -120,6 +120,19 @@ void read(XMLReader& xml, const std::string& path, ArchivGauge_t& header);
 void write(XMLWriter& xml, const std::string& path, const ArchivGauge_t& header);
 
 
+//! Read and write archive payloads from every node at once
+/*!
+  \ingroup io
+  Each node moves its own sites between the lattice and the file, with
+  no gather through the primary node. Needs a file system every node
+  sees. Off by default, or set with -archiv-parallel.
+*/
+void setArchivParallel(bool on);
+
+//! Are archive payloads read and written from every node at once
+bool archivParallel();
+
+
 //! Compute simple NERSC-like checksum of a gauge field
 /*
   \ingroup io
@@ -0,0 +1,198 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Canonical forms of expressions and a report of the kernels chosen
+ *
+ * The optimised kernels (generic, SSE and BAGEL blas, spin projections,
+ * ...) are full specializations of evaluate on one shape of expression
+ * each. Before those are matched, evaluate rewrites an expression into a
+ * canonical form - scalars to the left of a product and a scaled field
+ * ahead of a bare field in a sum - so y += x*a finds the kernel of
+ * y += a*x, and y = y + x*a that of y = a*x + y. Only rewrites that give
+ * the same bits are made: a scalar times a field and a sum of two terms
+ * are exact whichever way round they are done.
+ */
+
+#ifndef QDP_KERNEL_SELECT_H
+#define QDP_KERNEL_SELECT_H
+
+#include <string>
+#include <typeinfo>
+
+namespace QDP
+{
+  //---------------------------------------------------------------------------
+  // Canonical forms
+  //---------------------------------------------------------------------------
+
+  //! Site types that commute with the site of any field they multiply
+  /*! A real or complex number with no spin or color */
+  template<class T> struct CanonicalScalar {enum {value = 0};};
+  template<class W> struct CanonicalScalar<PScalar<PScalar<RScalar<W> > > > {enum {value = 1};};
+  template<class W> struct CanonicalScalar<PScalar<PScalar<RComplex<W> > > > {enum {value = 1};};
+
+  //! Is Node a field leaf
+  template<class Node> struct CanonicalField {enum {value = 0};};
+  template<class T> struct CanonicalField<Reference<QDPType<T,OLattice<T> > > > {enum {value = 1};};
+
+  //! Is Node a scalar times a field leaf, in canonical order
+  template<class Node> struct CanonicalScaled {enum {value = 0};};
+  template<class S, class T>
+  struct CanonicalScaled<BinaryNode<OpMultiply, Reference<QDPType<S,OScalar<S> > >,
+				    Reference<QDPType<T,OLattice<T> > > > >
+  {
+    enum {value = CanonicalScalar<S>::value};
+  };
+
+  //! The operands of a binary node, swapped when swap
+  template<class Node, bool swap> struct CanonicalSwap;
+
+  template<class Op, class A, class B>
+  struct CanonicalSwap<BinaryNode<Op,A,B>, false>
+  {
+    typedef BinaryNode<Op,A,B> Type_t;
+    enum {changed = 0};
+    static Type_t make(const BinaryNode<Op,A,B>& n) {return n;}
+  };
+
+  template<class Op, class A, class B>
+  struct CanonicalSwap<BinaryNode<Op,A,B>, true>
+  {
+    typedef BinaryNode<Op,B,A> Type_t;
+    enum {changed = 1};
+    static Type_t make(const BinaryNode<Op,A,B>& n) {return Type_t(n.operation(), n.right(), n.left());}
+  };
+
+  //! Canonical form of an expression tree
+  /*!
+   * Type_t is the rewritten tree and make() builds it; changed is 0 when
+   * the tree is already canonical. Nodes not listed are left alone.
+   */
+  template<class Node>
+  struct Canonical
+  {
+    typedef Node Type_t;
+    enum {changed = 0};
+    static Type_t make(const Node& n) {return n;}
+  };
+
+  //! x*a -> a*x
+  template<class T, class S>
+  struct Canonical<BinaryNode<OpMultiply, Reference<QDPType<T,OLattice<T> > >,
+			      Reference<QDPType<S,OScalar<S> > > > > :
+    public CanonicalSwap<BinaryNode<OpMultiply, Reference<QDPType<T,OLattice<T> > >,
+				    Reference<QDPType<S,OScalar<S> > > >,
+			 CanonicalScalar<S>::value>
+  {};
+
+  //! Both terms made canonical, and y + a*x -> a*x + y
+  template<class L, class R>
+  struct Canonical<BinaryNode<OpAdd, L, R> >
+  {
+    typedef Canonical<L> CL;
+    typedef Canonical<R> CR;
+    typedef BinaryNode<OpAdd, typename CL::Type_t, typename CR::Type_t> Terms_t;
+    typedef CanonicalSwap<Terms_t, (CanonicalField<typename CL::Type_t>::value &&
+				    CanonicalScaled<typename CR::Type_t>::value)> Swap_t;
+
+    typedef typename Swap_t::Type_t Type_t;
+    enum {changed = CL::changed || CR::changed || Swap_t::changed};
+
+    static Type_t make(const BinaryNode<OpAdd, L, R>& n)
+      {
+	return Swap_t::make(Terms_t(n.operation(), CL::make(n.left()), CR::make(n.right())));
+      }
+  };
+
+  //! Both terms made canonical
+  template<class L, class R>
+  struct Canonical<BinaryNode<OpSubtract, L, R> >
+  {
+    typedef Canonical<L> CL;
+    typedef Canonical<R> CR;
+
+    typedef BinaryNode<OpSubtract, typename CL::Type_t, typename CR::Type_t> Type_t;
+    enum {changed = CL::changed || CR::changed};
+
+    static Type_t make(const BinaryNode<OpSubtract, L, R>& n)
+      {
+	return Type_t(n.operation(), CL::make(n.left()), CR::make(n.right()));
+      }
+  };
+
+  //! The canonical form of rhs
+  template<class RHS, class C>
+  inline QDPExpr<typename Canonical<RHS>::Type_t, C>
+  canonical(const QDPExpr<RHS,C>& rhs)
+  {
+    return QDPExpr<typename Canonical<RHS>::Type_t, C>(Canonical<RHS>::make(rhs.expression()));
+  }
+
+
+  //---------------------------------------------------------------------------
+  // Kernel report
+  //---------------------------------------------------------------------------
+
+  //! Which kernel ran each expression
+  /*!
+   * With -kernel-report every optimised kernel counts its calls, and so
+   * does the generic site loop for each expression it is given; an
+   * expression evaluated through its canonical form is listed as well.
+   * The table is printed at QDP_finalize. An expression that should have
+   * found a kernel but shows up under "generic" has a shape none of the
+   * kernels match.
+   */
+  namespace KernelReport
+  {
+    //! Count the calls of each kernel. Off by default
+    void setEnabled(bool on);
+
+    //! Are the calls counted
+    bool enabled();
+
+    //! Call counter of kernel for the expression expr, made on first use
+    unsigned long* counter(const std::string& kernel, const std::string& expr);
+
+    //! Readable name of a type from its typeid name
+    std::string typeName(const char* name);
+
+    //! Print the kernels and their calls on this node
+    void print();
+
+    //! Count a call of the generic site loop for op and rhs
+    template<class Op, class RHS, class C>
+    inline void generic(const Op&, const QDPExpr<RHS,C>&)
+    {
+      if (! enabled())
+	return;
+
+      static unsigned long* calls = counter("generic", typeName(typeid(Op).name()) + " " +
+					    typeName(typeid(RHS).name()));
+      ++(*calls);
+    }
+
+    //! Count an expression handed on in canonical form
+    template<class Op, class RHS, class C>
+    inline void canonicalised(const Op&, const QDPExpr<RHS,C>&)
+    {
+      if (! enabled())
+	return;
+
+      static unsigned long* calls = counter("canonical", typeName(typeid(Op).name()) + " " +
+					    typeName(typeid(RHS).name()));
+      ++(*calls);
+    }
+  }
+}
+
+//! Count a call of the optimised kernel name, listed with the file it is in
+#define QDP_KERNEL_SELECTED(name)					\
+  do {									\
+    if (QDP::KernelReport::enabled())					\
+    {									\
+      static unsigned long* qdp_kernel_calls = QDP::KernelReport::counter(name, __FILE__); \
+      ++(*qdp_kernel_calls);						\
+    }									\
+  } while (0)
+
+#endif
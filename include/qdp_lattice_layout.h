@@ -0,0 +1,193 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Secondary lattices with their own geometry
+ */
+
+#ifndef QDP_LATTICE_LAYOUT_H
+#define QDP_LATTICE_LAYOUT_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /*! @defgroup latticelayout Secondary lattices
+   *
+   * Layout holds the one lattice made at start up. A LatticeLayout is
+   * another lattice living next to it, e.g. the coarse grid of a
+   * multigrid solver, a fifth dimension or a time slice, and an OLattice
+   * made with OLattice(const LatticeLayout&) stores exactly the sites of
+   * that lattice on this node.
+   *
+   * @{
+   */
+
+  //! A lattice of any size and number of dimensions next to the one of Layout
+  /*!
+   * The first Nd directions are split over the nodes like the lattice of
+   * Layout, so its extents there must be multiples of
+   * Layout::logicalSize(). Further directions are not split, and a
+   * lattice of fewer than Nd directions needs a node grid of extent 1 in
+   * the missing ones. Sites are numbered lexicographically in the
+   * coordinates within the node, direction 0 fastest.
+   *
+   * Fields on the lattice are assigned and reduced over all() unless a
+   * subset of one of its sets is given, and shift() moves them. Random
+   * numbers, the Map classes and I/O are for fields of Layout only. The
+   * lattice must outlive its fields, and it can not be copied since its
+   * subsets point into it.
+   */
+  class LatticeLayout
+  {
+  public:
+    //! A lattice of extent latt_size[mu] in direction mu
+    explicit LatticeLayout(const multi1d<int>& latt_size);
+
+    //! Number of directions
+    int numDim() const {return latt_size.size();}
+
+    //! Extents of the lattice
+    const multi1d<int>& lattSize() const {return latt_size;}
+
+    //! Extents of the part on each node
+    const multi1d<int>& subgridLattSize() const {return subgrid;}
+
+    //! Extents of the node grid
+    const multi1d<int>& logicalSize() const {return node_grid;}
+
+    //! Number of sites of the lattice
+    int vol() const {return volume;}
+
+    //! Number of sites on this node
+    int sitesOnNode() const {return nsites;}
+
+    //! Node holding the site coord
+    int nodeNumber(const multi1d<int>& coord) const;
+
+    //! Index of the site coord on the node holding it
+    int linearSiteIndex(const multi1d<int>& coord) const;
+
+    //! Coordinate of the site with the given index on a node
+    multi1d<int> siteCoords(int node, int index) const;
+
+    //! The subset of every site
+    const Subset& all() const {return all_set[0];}
+
+    //! Checkerboards by the parity of the sum of the coordinates
+    const Set& rb() const {return rb_set;}
+
+    //! Colour the sites of the lattice with fn, like Set::make
+    /*! fn is called with coordinates of numDim() directions */
+    void makeSet(Set& set, const SetFunc& fn) const;
+
+    //! d(x) = s(x + isign*dir)
+    /*! d and s are fields of this lattice. In place is allowed */
+    template<class T>
+    void shift(OLattice<T>& d, const OLattice<T>& s, int isign, int dir) const;
+
+    //! Field of this lattice holding s(x + isign*dir)
+    template<class T>
+    OLattice<T> shift(const OLattice<T>& s, int isign, int dir) const
+      {
+	OLattice<T> d(*this);
+	shift(d, s, isign, dir);
+	return d;
+      }
+
+  private:
+    LatticeLayout(const LatticeLayout&);
+    LatticeLayout& operator=(const LatticeLayout&);
+
+    //! The sources of a shift
+    /*!
+     * Site i of the result is site src[i] of the field when src[i] >= 0
+     * and slot -1-src[i] of the face received from recv_node otherwise.
+     * The sites send[] go to send_node, in the slot order there.
+     */
+    struct ShiftTable
+    {
+      std::vector<int> src;
+      std::vector<int> send;
+      int nface;
+      int send_node;
+      int recv_node;
+    };
+
+    //! The table of the shift by isign in direction dir
+    const ShiftTable& shiftTable(int isign, int dir) const;
+
+    //! Send the packed sites of t and receive its face, each site of bytes bytes
+    void exchange(const ShiftTable& t, const char* send, char* recv, size_t bytes) const;
+
+    multi1d<int> latt_size;
+    multi1d<int> subgrid;
+    multi1d<int> node_grid;
+    int volume;
+    int nsites;
+    Set all_set;
+    Set rb_set;
+    std::vector<ShiftTable> shifts;
+  };
+
+
+  namespace LatticeLayoutInternal
+  {
+    //! user argument for the shift kernel
+    template<class T>
+    struct ShiftArgs
+    {
+      T* d;
+      const T* s;
+      const T* face;
+      const int* src;
+    };
+
+    //! d[i] from the field or the face, by src[i]
+    template<class T>
+    void shiftKernel(int lo, int hi, int myId, ShiftArgs<T>* a)
+      {
+	for(int i=lo; i < hi; ++i)
+	{
+	  const int j = a->src[i];
+	  a->d[i] = (j >= 0) ? a->s[j] : a->face[-1-j];
+	}
+      }
+  }
+
+
+  template<class T>
+  void LatticeLayout::shift(OLattice<T>& d, const OLattice<T>& s, int isign, int dir) const
+  {
+    if (d.layout() != this || s.layout() != this)
+      QDP_error_exit("LatticeLayout::shift: the fields are not on this lattice");
+
+    // Reading s while writing it would see new values
+    if (&d == &s)
+    {
+      OLattice<T> tmp(s);
+      shift(d, tmp, isign, dir);
+      return;
+    }
+
+    const ShiftTable& t = shiftTable(isign, dir);
+
+    multi1d<T> send(t.send.size());
+    multi1d<T> face(t.nface);
+    if (t.send_node != Layout::nodeNumber())
+    {
+      for(int j=0; j < send.size(); ++j)
+	send[j] = s.elem(t.send[j]);
+
+      exchange(t, (const char*)send.slice(), (char*)face.slice(), sizeof(T));
+    }
+
+    LatticeLayoutInternal::ShiftArgs<T> a = {d.getF(), s.getF(), face.slice(), &t.src[0]};
+    dispatch_to_threads(nsites, a, LatticeLayoutInternal::shiftKernel<T>);
+  }
+
+  /*! @} */  // end of group latticelayout
+
+} // namespace QDP
+
+#endif
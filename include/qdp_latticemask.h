@@ -0,0 +1,234 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Lattice booleans packed one bit per site, and masked copies with them
+ */
+
+#ifndef QDP_LATTICEMASK_H
+#define QDP_LATTICEMASK_H
+
+#include <vector>
+#include <cstring>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! A LatticeBoolean packed as one bit per site on the node
+  /*!
+   * Bit i%32 of word i/32 holds site i in the order the sites are stored,
+   * so the mask of 32 neighbouring sites is read with one load. A
+   * LatticeBoolean spends a whole bool on each site.
+   *
+   *   LatticeMask accept = (r < ratio);
+   *   copymask(u, accept, u_new);
+   *
+   * copymask and where with a mask blend whole sites with bit operations
+   * instead of branching on each. The bits past the last site are zero.
+   */
+  class LatticeMask
+  {
+  public:
+    typedef unsigned int Word_t;
+
+    //! Sites in a word
+    enum {Bits = 8*sizeof(Word_t)};
+
+    //! All sites false
+    LatticeMask() : bits((Layout::sitesOnNode() + Bits - 1) / Bits, 0) {}
+
+    //! The packed copy of b
+    LatticeMask(const LatticeBoolean& b) : bits((Layout::sitesOnNode() + Bits - 1) / Bits, 0)
+      {
+	pack(b);
+      }
+
+    //! The packed value of a boolean expression
+    template<class RHS>
+    LatticeMask(const QDPExpr<RHS,LatticeBoolean>& rhs) : bits((Layout::sitesOnNode() + Bits - 1) / Bits, 0)
+      {
+	pack(LatticeBoolean(rhs));
+      }
+
+    //! Set from b
+    void pack(const LatticeBoolean& b)
+      {
+	const int nsites = Layout::sitesOnNode();
+	const int nw = numWords();
+
+#pragma omp parallel for
+	for(int w=0; w < nw; ++w)
+	{
+	  const int lo = w*Bits;
+	  const int hi = (lo + Bits < nsites) ? lo + Bits : nsites;
+
+	  Word_t m = 0;
+	  for(int i=lo; i < hi; ++i)
+	    m |= Word_t(b.elem(i).elem().elem().elem() ? 1 : 0) << (i-lo);
+	  bits[w] = m;
+	}
+      }
+
+    //! Unpack into b
+    void unpack(LatticeBoolean& b) const
+      {
+	const int nsites = Layout::sitesOnNode();
+
+	b.detach();
+#pragma omp parallel for
+	for(int i=0; i < nsites; ++i)
+	  b.elem(i).elem().elem().elem() = test(i);
+      }
+
+    //! The value of site i on the node
+    bool test(int i) const {return (bits[i / Bits] >> (i % Bits)) & 1;}
+
+    //! Set site i on the node
+    void set(int i, bool v)
+      {
+	const Word_t b = Word_t(1) << (i % Bits);
+	bits[i / Bits] = v ? (bits[i / Bits] | b) : (bits[i / Bits] & ~b);
+      }
+
+    //! Number of words
+    int numWords() const {return bits.size();}
+
+    //! The bits of sites 32*w to 32*w+31
+    Word_t word(int w) const {return bits[w];}
+
+    //! Number of true sites on this node
+    int count() const
+      {
+	int n = 0;
+	for(int w=0; w < numWords(); ++w)
+	  n += __builtin_popcount(bits[w]);
+	return n;
+      }
+
+    //! Sites true in this and m
+    LatticeMask& operator&=(const LatticeMask& m)
+      {
+	for(int w=0; w < numWords(); ++w)
+	  bits[w] &= m.bits[w];
+	return *this;
+      }
+
+    //! Sites true in this or m
+    LatticeMask& operator|=(const LatticeMask& m)
+      {
+	for(int w=0; w < numWords(); ++w)
+	  bits[w] |= m.bits[w];
+	return *this;
+      }
+
+    //! Sites false here
+    LatticeMask operator!() const
+      {
+	LatticeMask m(*this);
+	for(int w=0; w < numWords(); ++w)
+	  m.bits[w] = ~bits[w];
+
+	// Keep the bits past the last site clear
+	const int tail = Layout::sitesOnNode() % Bits;
+	if (tail != 0)
+	  m.bits[numWords()-1] &= (Word_t(1) << tail) - 1;
+	return m;
+      }
+
+  private:
+    std::vector<Word_t> bits;
+  };
+
+
+  //! Sites true in both
+  inline LatticeMask operator&&(const LatticeMask& a, const LatticeMask& b)
+  {
+    LatticeMask m(a);
+    return m &= b;
+  }
+
+  //! Sites true in either
+  inline LatticeMask operator||(const LatticeMask& a, const LatticeMask& b)
+  {
+    LatticeMask m(a);
+    return m |= b;
+  }
+
+
+  //! dest = (mask) ? s1 : dest
+  /*!
+   * Each site is blended word by word as (d & ~m) | (s1 & m) with m all
+   * ones or all zeros, which compilers turn into SIMD and/andnot/or
+   * without a branch. Groups of 32 sites that are all false are skipped
+   * and those all true are copied whole.
+   */
+  template<class T>
+  void copymask(OLattice<T>& dest, const LatticeMask& mask, const OLattice<T>& s1)
+  {
+    typedef LatticeMask::Word_t Word_t;
+
+    dest.detach();
+
+    const int nsites = Layout::sitesOnNode();
+    const int nw = mask.numWords();
+
+    // Sites that are not a whole number of words are copied one by one
+    if (sizeof(T) % sizeof(Word_t) != 0)
+    {
+#pragma omp parallel for
+      for(int i=0; i < nsites; ++i)
+	if (mask.test(i))
+	  dest.elem(i) = s1.elem(i);
+      return;
+    }
+
+    const int n = sizeof(T) / sizeof(Word_t);
+    Word_t* d = (Word_t*)dest.getF();
+    const Word_t* s = (const Word_t*)s1.getF();
+
+#pragma omp parallel for
+    for(int w=0; w < nw; ++w)
+    {
+      const Word_t bits = mask.word(w);
+      if (bits == 0)
+	continue;
+
+      const int lo = w*LatticeMask::Bits;
+      const int hi = (lo + LatticeMask::Bits < nsites) ? lo + LatticeMask::Bits : nsites;
+
+      if (bits == ~Word_t(0))
+      {
+	std::memcpy(d + size_t(lo)*n, s + size_t(lo)*n, size_t(hi-lo)*sizeof(T));
+	continue;
+      }
+
+      for(int i=lo; i < hi; ++i)
+      {
+	const Word_t m = Word_t(0) - ((bits >> (i-lo)) & 1);
+	Word_t* dd = d + size_t(i)*n;
+	const Word_t* ss = s + size_t(i)*n;
+
+	for(int k=0; k < n; ++k)
+	  dd[k] = (dd[k] & ~m) | (ss[k] & m);
+      }
+    }
+  }
+
+
+  //! (mask) ? a : b, site by site
+  template<class T>
+  OLattice<T> where(const LatticeMask& mask, const OLattice<T>& a, const OLattice<T>& b)
+  {
+    OLattice<T> d(b);
+    copymask(d, mask, a);
+    return d;
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
@@ -46,10 +46,107 @@ namespace QDP {
 		//! Set number of processors in a multi-threaded implementation
 		void setNumProc(int N);
 
+		//! Visit sites in tiles of edge^Nd sites of the local lattice
+		/*!
+		 * Orders the traversalTable() of the subsets of the sets made
+		 * afterwards tile by tile, so call before create(). 0 keeps the
+		 * layout order and is the default.
+		 */
+		void setSiteTiling(int edge);
+
+		//! The tile edge of setSiteTiling, 0 when off
+		int siteTiling();
+
+		//! Orderings of the sites within a node
+		enum SiteOrdering
+		{
+			ORDER_CONFIGURED,   //!< the layout chosen at configure time
+			ORDER_LEXICO,       //!< lexicographic
+			ORDER_CB2,          //!< 2 checkerboard (red/black)
+			ORDER_CB3D,         //!< red/black in 3D, only when configured so
+			ORDER_CB32,         //!< checkerboards of hypercubes
+			ORDER_MORTON        //!< checkerboards with blocks along a Morton curve
+		};
+
+		//! Select the ordering of sites within a node
+		/*!
+		 * Takes effect at the next create(), which tabulates the ordering
+		 * so linearSiteIndex and siteCoords are lookups on the node.
+		 * ORDER_MORTON keeps every power-of-two block of a checkerboard
+		 * contiguous in memory, so shifts in any direction stay close.
+		 * ORDER_CB3D changes crtesn, so it is only available when it is
+		 * also the configured layout. Only the scalar and parscalar
+		 * architectures honour the selection.
+		 */
+		void setSiteOrdering(SiteOrdering order);
+
+		//! The selected ordering, with ORDER_CONFIGURED resolved
+		SiteOrdering siteOrdering();
+
+		//! Name of an ordering as given to -layout
+		const char* siteOrderingName(SiteOrdering order);
+
+		//! Look up an ordering by its name, false if there is none
+		bool siteOrderingFromName(const char* name, SiteOrdering& order);
+
+		//! Add secs to a named phase of create(), for printStartupTimes
+		void startupPhase(const char* name, double secs);
+
+		//! Print the time of each phase of the last create()
+		void printStartupTimes();
+
+		//! Let create choose the logical machine grid when none was declared, on by default
+		/*! Off leaves the choice to QMP. Only the parscalar architecture has a choice */
+		void setGeometryOptimizer(bool on);
+
+		//! Whether create chooses the logical machine grid
+		bool geometryOptimizer();
+
+		//! Sites a node sends in the shifts of all directions, both signs, for grid over latt
+		int haloSites(const multi1d<int>& latt, const multi1d<int>& grid);
+
+		//! Of those, the sites sent to another host on average
+		/*!
+		 * The ranks come per_host at a time to a host and follow the grid
+		 * lexicographically, direction 0 fastest, as QMP numbers them
+		 */
+		double offHostHaloSites(const multi1d<int>& latt, const multi1d<int>& grid, int per_host);
+
+		//! The logical machine grid of nodes nodes with the least halo for lattice latt
+		/*!
+		 * Of the grids whose sizes divide latt/min_dim, returns one with the
+		 * fewest haloSites, and of those the one with the fewest
+		 * offHostHaloSites, so neighbouring subgrids share a host. The
+		 * result is empty when no grid fits.
+		 */
+		multi1d<int> optimalLogicalSize(const multi1d<int>& latt, const multi1d<int>& min_dim,
+			int nodes, int per_host);
+
 		//! Returns the logical node number for the corresponding lattice coordinate
 		/*! The API requires this function to be here */
 		int nodeNumber(const multi1d<int>& coord) QDP_CONST;
 
+		//! A lattice coordinate that needs no heap allocation
+		typedef std::array<int,Nd> LatticeCoord;
+
+		//! Lattice coordinate of a lexicographic site, like crtesn on lattSize()
+		void lexicoCoord(int lexicosite, LatticeCoord& coord);
+
+		//! The logical node number of a lattice coordinate, without allocating
+		/*! Only the scalar and parscalar architectures provide it */
+		int nodeNumber(const LatticeCoord& coord);
+
+		//! The linearized site index of a lattice coordinate, without allocating
+		/*!
+		 * A lookup in the site tables of create() for sites on this node.
+		 * Only the scalar and parscalar architectures provide it.
+		 */
+		int linearSiteIndex(const LatticeCoord& coord);
+
+		//! Lattice coordinate of a node and site number, without allocating on this node
+		/*! Only the scalar and parscalar architectures provide it */
+		void siteCoords(int node, int index, LatticeCoord& coord);
+
 		//returns local lexicographical site coordinate from linear index:
 		multi1d<int> localLexiCoordFromLinear(const int& linearr) QDP_CONST;
 
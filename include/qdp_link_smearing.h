@@ -0,0 +1,202 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Stout and APE smearing of gauge links, one sweep per level
+ */
+
+#ifndef QDP_LINK_SMEARING_H
+#define QDP_LINK_SMEARING_H
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace LinkSmearingInternal
+  {
+    //! user argument for levelKernel
+    template<class U>
+    struct LevelArgs
+    {
+      const U* u[Nd];
+      U* d[Nd];
+      const GaugeLoopsInternal::Neighbours<U>* nb;
+      const int* sites;
+      int j_decay;      // links of this direction kept and its planes left out, or -1
+      bool ape;
+      double rho;       // stout weight, or APE alpha
+    };
+
+    //! user function making the next level of the links at sites[lo..hi)
+    /*!
+     * With the staple s of U (see staples), stout takes
+     * U' = exp(i rho TA(U s)) U as in hep-lat/0311018, and APE takes
+     * U' = P_SU3[(1-alpha) U + alpha/(2 n) s^dag] for n planes.
+     */
+    template<class U>
+    void levelKernel(int lo, int hi, int myId, LevelArgs<U>* a)
+    {
+      using namespace SU3Internal;
+
+      int nplanes = Nd-1;
+      if (a->j_decay >= 0 && a->j_decay < Nd)
+	nplanes = Nd-2;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	const int x = a->sites[j];
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  if (mu == a->j_decay)
+	  {
+	    a->d[mu][x] = a->u[mu][x];
+	    continue;
+	  }
+
+	  U s;
+	  GaugeLoopsInternal::siteStaple(s, *a->nb, a->u, mu, x, a->j_decay);
+
+	  M3 uu, ss, w;
+	  uu.load(a->u[mu][x].elem());
+	  ss.load(s.elem());
+
+	  if (a->ape)
+	  {
+	    const double c = a->rho / (2*nplanes);
+	    for(int r=0; r < 3; ++r)
+	      for(int k=0; k < 3; ++k)
+	      {
+		w.re[r][k] = (1 - a->rho)*uu.re[r][k] + c*ss.re[k][r];
+		w.im[r][k] = (1 - a->rho)*uu.im[r][k] - c*ss.im[k][r];
+	      }
+	    projectSU3(w);
+	    w.store(a->d[mu][x].elem());
+	    continue;
+	  }
+
+	  // q = i rho TA(U s), hermitian and traceless
+	  M3 us, q, e;
+	  mult(us, uu, ss);
+
+	  double tr = 0;
+	  for(int r=0; r < 3; ++r)
+	    for(int k=0; k < 3; ++k)
+	    {
+	      const double ar = 0.5*(us.re[r][k] - us.re[k][r]);
+	      const double ai = 0.5*(us.im[r][k] + us.im[k][r]);
+	      q.re[r][k] = -a->rho*ai;
+	      q.im[r][k] =  a->rho*ar;
+	    }
+	  for(int r=0; r < 3; ++r)
+	    tr += q.re[r][r];
+	  for(int r=0; r < 3; ++r)
+	    q.re[r][r] -= tr/3;
+
+	  expiQ(e, q);
+	  mult(w, e, uu);
+	  w.store(a->d[mu][x].elem());
+	}
+      }
+    }
+
+    //! d = the next level of u
+    template<class U>
+    void level(multi1d< OLattice<U> >& d, const multi1d< OLattice<U> >& u,
+	       double rho, int j_decay, bool ape)
+    {
+      using namespace GaugeLoopsInternal;
+
+      if (Nc != 3)
+	QDP_error_exit("%s: needs Nc = 3, have %d", ape ? "apeSmear" : "stoutSmear", Nc);
+      if (u.size() != Nd)
+	QDP_error_exit("%s: need Nd gauge links, have %d", ape ? "apeSmear" : "stoutSmear", u.size());
+
+      if (d.size() != Nd)
+	d.resize(Nd);
+
+      LevelArgs<U> a;
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	a.u[mu] = u[mu].getF();
+	a.d[mu] = writable(d[mu]).getF();
+      }
+      a.j_decay = j_decay;
+      a.ape = ape;
+      a.rho = rho;
+
+      // All the links around the staples in flight at once
+      Neighbours<U> nb(u, true);
+      a.nb = &nb;
+
+      a.sites = sitePtr(nb.inner);
+      dispatch_to_threads(nb.inner.size(), a, levelKernel<U>);
+
+      nb.wait();
+      a.sites = sitePtr(nb.outer);
+      dispatch_to_threads(nb.outer.size(), a, levelKernel<U>);
+    }
+  }
+
+
+  //! iter levels of stout smearing of u in place
+  /*!
+   * U' = exp(i Q) U with Q = i rho TA(U s), s the staple of U summed over
+   * the planes of the other directions, as in Morningstar and Peardon,
+   * hep-lat/0311018, with one weight rho for all planes. With j_decay
+   * in 0..Nd-1 those links are kept and their planes left out, for
+   * spatial smearing.
+   *
+   * Each level exchanges the neighbouring links once, all directions
+   * together, and makes the staple, the exponential and the new link of
+   * every site in a single threaded sweep; the only lattice temporaries
+   * are the links of the next level.
+   */
+  template<class U>
+  void stoutSmear(multi1d< OLattice<U> >& u, const Real& rho, int iter, int j_decay = -1)
+  {
+    multi1d< OLattice<U> > next(Nd);
+    for(int n=0; n < iter; ++n)
+    {
+      LinkSmearingInternal::level(next, u, toDouble(rho), j_decay, false);
+      for(int mu=0; mu < Nd; ++mu)
+	std::swap(u[mu], next[mu]);
+    }
+  }
+
+  //! The stout levels of u, levels[0] = u and levels[n] smeared n times
+  /*! Keeps every level, as the force recursion needs them */
+  template<class U>
+  void stoutSmear(multi1d< multi1d< OLattice<U> > >& levels, const multi1d< OLattice<U> >& u,
+		  const Real& rho, int iter, int j_decay = -1)
+  {
+    levels.resize(iter+1);
+    levels[0] = u;
+    for(int n=0; n < iter; ++n)
+      LinkSmearingInternal::level(levels[n+1], levels[n], toDouble(rho), j_decay, false);
+  }
+
+  //! iter levels of APE smearing of u in place
+  /*!
+   * U' = P_SU3[(1-alpha) U + alpha/(2 n) s^dag], s the staple of U over
+   * the n planes used and P_SU3 the projection of projectSU3. j_decay
+   * and the sweeps are as for stoutSmear.
+   */
+  template<class U>
+  void apeSmear(multi1d< OLattice<U> >& u, const Real& alpha, int iter, int j_decay = -1)
+  {
+    multi1d< OLattice<U> > next(Nd);
+    for(int n=0; n < iter; ++n)
+    {
+      LinkSmearingInternal::level(next, u, toDouble(alpha), j_decay, true);
+      for(int mu=0; mu < Nd; ++mu)
+	std::swap(u[mu], next[mu]);
+    }
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
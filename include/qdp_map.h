@@ -9,6 +9,9 @@
 #ifndef QDP_MAP_H
 #define QDP_MAP_H
 
+#include <cstring>
+#include <utility>
+
 namespace QDP {
 
 // Helpful for communications
@@ -36,6 +39,27 @@ public:
   //! Maps a lattice coordinate under a map to a new lattice coordinate
   /*! sign > 0 for map, sign < 0 for the inverse map */
   virtual multi1d<int> operator() (const multi1d<int>& coordinate, int sign) const = 0;
+
+  //! Same map on a coordinate that needs no heap allocation
+  /*! 
+   * Map::make calls this one. Override it together with the multi1d
+   * version to build maps without a malloc per site.
+   */
+  virtual Layout::LatticeCoord operator() (const Layout::LatticeCoord& coordinate, int sign) const
+    {
+      // A view on coordinate, no copy
+      multi1d<int> coord(const_cast<int*>(coordinate.data()), Nd);
+      multi1d<int> res = (*this)(coord, sign);
+
+      Layout::LatticeCoord lc;
+      for(int i=0; i < Nd; ++i)
+	lc[i] = res[i];
+      return lc;
+    }
+
+  //! Returns true if the map is x -> x + sign*disp, wrapped around the lattice
+  /*! Map::make then builds the map in one sweep without calling the function */
+  virtual bool displacement(Layout::LatticeCoord& disp) const {return false;}
 };
     
 
@@ -51,10 +75,86 @@ public:
   /*! sign > 0 for map, sign < 0 for the inverse map */
   virtual multi1d<int> operator() (const multi1d<int>& coordinate, int sign, int dir) const = 0;
 
+  //! Same map on a coordinate that needs no heap allocation
+  virtual Layout::LatticeCoord operator() (const Layout::LatticeCoord& coordinate, int sign, int dir) const
+    {
+      // A view on coordinate, no copy
+      multi1d<int> coord(const_cast<int*>(coordinate.data()), Nd);
+      multi1d<int> res = (*this)(coord, sign, dir);
+
+      Layout::LatticeCoord lc;
+      for(int i=0; i < Nd; ++i)
+	lc[i] = res[i];
+      return lc;
+    }
+
+  //! Returns true if direction dir is x -> x + sign*disp, wrapped around the lattice
+  virtual bool displacement(int dir, Layout::LatticeCoord& disp) const {return false;}
+
   //! Returns the array size - the number of directions which are to be used
   virtual int numArray() const = 0;
 };
     
+
+class Map;
+
+//! The map x -> x + isign*k in direction dir, a single exchange for any k
+/*! Made on first use and kept, see shift(source,isign,dir,k) */
+Map& distanceMap(int isign, int dir, int k);
+
+
+namespace MapInternal
+{
+  //! user argument for moving whole records of bytes bytes, one per site
+  struct RecordArgs
+  {
+    char* dest;
+    const char* src;
+    size_t bytes;
+    const int* off;     //!< source record of each destination record
+    const int* sites;   //!< the destination records, null for all in order
+  };
+
+  //! Record i of dest = record off[i] of src, i = sites[j] for j in [lo,hi)
+  inline void recordKernel(int lo, int hi, int myId, RecordArgs* a)
+  {
+    for(int j=lo; j < hi; ++j)
+    {
+      const int i = a->sites ? a->sites[j] : j;
+      std::memcpy(a->dest + i*a->bytes, a->src + a->off[i]*a->bytes, a->bytes);
+    }
+  }
+
+  //! user argument for moving records between fields stored on one subset
+  struct CompactArgs
+  {
+    char* dest;
+    const char* src;
+    size_t bytes;
+    const int* off;     //!< source site of each destination site
+    const int* sites;   //!< the destination sites, null for all in order
+    const int* dpos;    //!< record of each site in dest, null for the site itself
+    const int* spos;    //!< record of each site in src, null for the site itself
+    int nsrc;           //!< number of records of src when spos is given
+  };
+
+  //! Like recordKernel, with the records of the sites looked up in dpos and spos
+  /*! Sources beyond the nsrc records of a compact src belong to another
+   *  subset and are skipped */
+  inline void compactKernel(int lo, int hi, int myId, CompactArgs* a)
+  {
+    for(int j=lo; j < hi; ++j)
+    {
+      const int i = a->sites ? a->sites[j] : j;
+      const int s = a->spos ? a->spos[a->off[i]] : a->off[i];
+      if (a->spos && s >= a->nsrc)
+	continue;
+
+      std::memcpy(a->dest + (a->dpos ? a->dpos[i] : i)*a->bytes, a->src + s*a->bytes, a->bytes);
+    }
+  }
+}
+    
 /** @} */ // end of group map
 
 } // namespace QDP
@@ -9,7 +9,11 @@
 
 #include "qdp_map_obj.h"
 #include <limits>
+#include <array>
+#include <algorithm>
 #include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace QDP
 {
@@ -20,11 +24,26 @@ namespace QDP
     //! Get the file magic
     std::string getFileMagic();
 
+    //! Get the magic ending a file with a sorted key index
+    std::string getIndexMagic();
+
     //! Get the meta-data from a file
     std::string getMetaData(const std::string& filename);
 
     //! Check if this will be a new file
     bool checkForNewFile(const std::string& filename, std::ios_base::openmode mode);
+
+    //! Check if this will be a new file, on this node only
+    bool checkForNewFileLocal(const std::string& filename, std::ios_base::openmode mode);
+
+    //! Name of shard number shard of a database with the given manifest
+    std::string shardFile(const std::string& manifest, int shard);
+
+    //! Write a manifest listing shards 0..nshards-1
+    void writeManifest(const std::string& manifest, int nshards);
+
+    //! Read the shard files listed in a manifest
+    std::vector<std::string> readManifest(const std::string& manifest);
   };
 
 
@@ -37,7 +56,26 @@ namespace QDP
   {
   public:
     //! Empty constructor
-    MapObjectDisk() : file_version(1), state(INIT), level(0) {}
+    MapObjectDisk() : file_version(1), state(INIT), level(0), use_mmap(false),
+		      write_behind(0), pending_len(0), sorted_map(false),
+		      use_lazy(false), lazy(false), index_size(0),
+		      use_concurrent(false), read_fd(-1), file_size(0),
+		      local(false), streamer(file_streamer) {}
+
+    //! A database that belongs to the calling node alone
+    /*!
+     * With node_local set every call acts on this node only and nothing
+     * is communicated, so each node may open, fill and close its own
+     * file independently, e.g. one shard of a MapObjectDiskSharded. The
+     * file format is unchanged and any MapObjectDisk can read it.
+     */
+    explicit MapObjectDisk(bool node_local) : file_version(1), state(INIT), level(0), use_mmap(false),
+					      write_behind(0), pending_len(0), sorted_map(false),
+					      use_lazy(false), lazy(false), index_size(0),
+					      use_concurrent(false), read_fd(-1), file_size(0),
+					      local(node_local),
+					      streamer(node_local ? static_cast<BinaryReaderWriter&>(local_streamer) 
+						       : static_cast<BinaryReaderWriter&>(file_streamer)) {}
 
     //! Finalizes object
     ~MapObjectDisk();
@@ -48,12 +86,68 @@ namespace QDP
     //! Get debugging level
     int getDebug() const {return level;}
 
+    //! Map the file into memory when it is opened read-only
+    /*!
+     * Set before open(). Every node then maps the file and get() reads
+     * the value straight out of the mapping, so lookups need no seek or
+     * broadcast and the ranks on a host share the page cache. A file
+     * opened for writing ignores it.
+     */
+    void setMmap(bool m) {use_mmap = m;}
+
+    //! Collect new records in memory and append them in large writes
+    /*!
+     * With a non-zero size, insert() of a new key only serializes the
+     * value and its checksum into a buffer, and the buffer goes to disk
+     * in one sequential write once it holds at least bytes. It is also
+     * written out by flush(), close(), get() and the update of an
+     * existing key. Zero, the default, writes each record as it comes.
+     */
+    void setWriteBehind(size_t bytes) {write_behind = bytes;}
+
+    //! Write the key map in key order followed by an index into it
+    /*!
+     * Set before the file is closed. The index is a table of the file
+     * positions of the sorted map entries plus a trailer at the end of
+     * the file. Readers that do not know it just see the usual map.
+     */
+    void setIndex(bool i) {sorted_map = i;}
+
+    //! Look keys up in the on-disk index instead of loading the map
+    /*!
+     * Set before open(). A file opened read-only that has an index is
+     * opened without reading its key map. Each lookup is a binary
+     * search over the index, O(log n) small reads, and the positions
+     * found are kept in memory for the next time. keys() and compact()
+     * still load the complete map. The map checksum is not verified in
+     * this mode, only those of the records read.
+     */
+    void setLazy(bool l) {use_lazy = l;}
+
+    //! Allow getConcurrent() on a file opened read-only
+    /*!
+     * Set before open(). Every node then opens the file for positional
+     * reads of its own, so the file must be visible to all of them, as
+     * with setMmap.
+     */
+    void setConcurrent(bool c) {use_concurrent = c;}
+
+    /**
+     * Write a compacted copy of the database
+     * @param file the new database, which is overwritten
+     *
+     * The copy holds one record per key laid out in key order with the
+     * key map sorted the same way, and none of the stale maps that
+     * reopening a database for insertions leaves behind.
+     */
+    void compact(const std::string& file) const;
+
     //! Open a file
     void open(const std::string& file, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out);
 
     //! Check if a DB file exists before opening.
     bool fileExists(const std::string& file) const {
-      return (! MapObjDiskEnv::checkForNewFile(file, std::ios_base::in));
+      return (! checkForNewFile(file, std::ios_base::in));
     }
 
     //! Close the file
@@ -77,6 +171,21 @@ namespace QDP
     int get(const K& key, V& val) const;
 
 
+    /**
+     * Get data for a given key, from many threads at once
+     * @param key user supplied key
+     * @param data after the call data will be populated
+     * @return 0 on success, otherwise the key not found
+     *
+     * The file must be open read-only with setConcurrent or setMmap.
+     * Each call reads its record with positional reads on this node, or
+     * out of the mapping, and shares no stream or buffer with any other
+     * call, so OpenMP threads may look keys up in parallel. Nothing is
+     * communicated, so values that are lattice fields must go through
+     * get(). Keys found in a lazily opened file are not remembered.
+     */
+    int getConcurrent(const K& key, V& val) const;
+
     /**
      * Flush database in memory to disk
      */
@@ -93,7 +202,7 @@ namespace QDP
     /** 
      * The number of elements
      */
-    unsigned int size() const {return static_cast<unsigned long>(src_map.size());}
+    unsigned int size() const {return lazy ? index_size : static_cast<unsigned long>(src_map.size());}
 
     /**
      * Return all available keys to user
@@ -122,6 +231,19 @@ namespace QDP
     typedef std::iostream::pos_type pos_type;  // position in buffer
     typedef std::iostream::off_type off_type;  // offset in buffer
 
+    //! Name of the open file
+    const std::string& getFilename() const {return filename;}
+
+    /**
+     * Where the record of a key starts in the file
+     * @param key a key object
+     * @param pos the position of the value, followed by its checksum
+     * @return true if the key exists
+     *
+     * For readers that fetch records without going through get()
+     */
+    bool getPosition(const K& key, pos_type& pos) const;
+
   private:
     //! Sometime ago, chose 16 bytes for stream positions. Yup, really big.
     /**
@@ -156,8 +278,95 @@ namespace QDP
     //! Metadata
     std::string user_data;
 
+    //! Write-behind buffer, records not yet on disk and where they go
+    size_t write_behind;
+    mutable std::string pending;
+    mutable size_t pending_len;
+    mutable pos_type pending_start;
+
+    //! Write the key map in key order, with an index
+    bool sorted_map;
+
+    //! Lookups go through the on-disk index, and where it is
+    bool use_lazy;
+    mutable bool lazy;
+    unsigned int index_size;
+    pos_type index_start;
+    priv_pos_type_t map_start;
+
+    //! Positional reads for getConcurrent
+    bool use_concurrent;
+    int read_fd;
+    size_t file_size;
+
+    //! Read-only mapping of the file
+    bool use_mmap;
+    mutable BinaryMappedFileReader mapped;
+
     //! Reader and writer interfaces
-    mutable BinaryFileReaderWriter streamer;
+    bool local;
+    mutable BinaryFileReaderWriter file_streamer;
+    mutable BinaryLocalFileReaderWriter local_streamer;
+    BinaryReaderWriter& streamer;
+
+    //! Where reads come from
+    BinaryReader& reader() const {
+      return mapped.is_open() ? static_cast<BinaryReader&>(mapped) : static_cast<BinaryReader&>(streamer);
+    }
+
+    //! Open the reader and writer
+    void openStreamer(const std::string& file, std::ios_base::openmode mode) {
+      if (local)
+	local_streamer.open(file, mode);
+      else
+	file_streamer.open(file, mode);
+    }
+
+    //! Is the reader and writer open
+    bool streamerIsOpen() const {return local ? local_streamer.is_open() : file_streamer.is_open();}
+
+    //! Close the reader and writer
+    void closeStreamer() {
+      if (local)
+	local_streamer.close();
+      else
+	file_streamer.close();
+    }
+
+    //! Is the file open in any way
+    bool isOpen() const {return mapped.is_open() || streamerIsOpen();}
+
+    //! New file check, collective unless the database is node local
+    bool checkForNewFile(const std::string& file, std::ios_base::openmode mode) const {
+      return local ? MapObjDiskEnv::checkForNewFileLocal(file, mode) : MapObjDiskEnv::checkForNewFile(file, mode);
+    }
+
+    //! Key as stored in the map
+    std::string encodeKey(const K& key) const;
+
+    //! Key from the map
+    void decodeKey(const std::string& s, K& key) const;
+
+    //! Serialize a value and its checksum, returning the number of bytes
+    size_t encodeValue(const V& val, std::string& s) const;
+
+    //! Write out the write-behind buffer
+    void writePending() const;
+
+    //! Find the position of a key, in memory or in the index
+    bool findKey(const std::string& key, priv_pos_type_t& pos) const;
+
+    //! Up to len bytes of the file from pos, without touching any stream
+    std::string readAt(uint64_t pos, size_t len) const;
+
+    //! findKey without touching any stream or the map
+    bool findKeyAt(const std::string& key, priv_pos_type_t& pos) const;
+
+    //! Read the complete map of a lazily opened file
+    void loadMap() const;
+
+    //! Internal Utility: Find the index, returning false if there is none
+    bool readIndexTrailer(pos_type& table, unsigned int& count) const;
 
     //! Convert to known size
     priv_pos_type_t convertToPrivate(const pos_type& input) const;
@@ -210,9 +419,9 @@ namespace QDP
   typename MapObjectDisk<K,V>::priv_pos_type_t
   MapObjectDisk<K,V>::convertToPrivate(const pos_type& input) const
   {
-    const pos_type max_uint64 = pos_type(std::numeric_limits<uint64_t>::max()) + pos_type(1u);
-    uint64_t less = uint64_t(input % max_uint64);
-    uint64_t more = input / max_uint64;
+    // Stream offsets are 64 bits, so the most significant half is always zero
+    uint64_t less = uint64_t(std::streamoff(input));
+    uint64_t more = 0;
     // NOTE comment on priv_pos_type_t
     return (QDPUtil::big_endian() ? priv_pos_type_t{more, less} : priv_pos_type_t{less, more});
   }
@@ -222,12 +431,11 @@ namespace QDP
   typename MapObjectDisk<K,V>::pos_type 
   MapObjectDisk<K,V>::convertFromPrivate(const priv_pos_type_t& input) const
   {
-    const pos_type max_uint64 = pos_type(std::numeric_limits<uint64_t>::max()) + pos_type(1u);
     // NOTE comment on priv_pos_type_t
     if (!QDPUtil::big_endian())
-      return pos_type(input[0]) + pos_type(input[1]) * max_uint64;
+      return pos_type(std::streamoff(input[0]));
     else
-      return pos_type(input[1]) + pos_type(input[0]) * max_uint64;
+      return pos_type(std::streamoff(input[1]));
   }
 
 
@@ -236,7 +444,7 @@ namespace QDP
   void 
   MapObjectDisk<K,V>::open(const std::string& file, std::ios_base::openmode mode)
   {
-    if ( MapObjDiskEnv::checkForNewFile(file, mode) )
+    if ( checkForNewFile(file, mode) )
     {
       openWrite(file, mode);
     }
@@ -260,7 +468,7 @@ namespace QDP
       QDPIO::cout << "MapObjectDisk: opening file " << filename
 		  << " for writing" << std::endl;
       
-      streamer.open(filename, mode);
+      openStreamer(filename, mode);
           
       if (level >= 2) {
         QDPIO::cout << "sizeof(unsigned char) = " << sizeof(unsigned char) << std::endl;
@@ -300,7 +508,8 @@ namespace QDP
     
       if (level >= 2) {
 	int user_len = user_data.length();
-	QDPInternal::broadcast(user_len);
+	if (! local)
+	  QDPInternal::broadcast(user_len);
 
 	QDPIO::cout << "Sanity Check 1" << std::endl; ;
 	pos_type cur_pos = streamer.currentPosition();
@@ -324,7 +533,8 @@ namespace QDP
       if (level >= 2) {
 	QDPIO::cout << "Wrote dummy link: Current Position " << streamer.currentPosition() << std::endl;
 	int user_len = user_data.length();
-	QDPInternal::broadcast(user_len);
+	if (! local)
+	  QDPInternal::broadcast(user_len);
 
 	QDPIO::cout << "Sanity Check 2" << std::endl;
 	pos_type cur_pos = streamer.currentPosition();
@@ -372,17 +582,41 @@ namespace QDP
 		  << " for reading" << std::endl;
       
       // Open the reader
-      streamer.open(filename, mode);
+      if (use_mmap && ! (mode & std::ios_base::out))
+	mapped.open(filename);
+      else
+	openStreamer(filename, mode);
+
+      // Every node reads for itself in getConcurrent
+      if (use_concurrent && ! (mode & std::ios_base::out) && ! mapped.is_open())
+      {
+	read_fd = ::open(filename.c_str(), O_RDONLY);
+	if (read_fd < 0)
+	  QDP_error_exit("MapObjectDisk: cannot open %s on node %d for concurrent reads",
+			 filename.c_str(), Layout::nodeNumber());
+
+	off_t end = lseek(read_fd, 0, SEEK_END);
+	file_size = (end > 0) ? size_t(end) : 0;
+      }
 	
       QDPIO::cout << "MapObjectDisk: reading and checking header" << std::endl;
 
       priv_pos_type_t md_start = readCheckHeader();
+      map_start = md_start;
+
+      if (use_lazy && ! (mode & std::ios_base::out) && readIndexTrailer(index_start, index_size))
+      {
+	QDPIO::cout << "MapObjectDisk: using key index of " << index_size << " entries" << std::endl;
+	lazy = true;
+      }
+      else
+      {
+	// Seek to metadata
+	QDPIO::cout << "MapObjectDisk: reading key/fileposition data" << std::endl;
 	
-      // Seek to metadata
-      QDPIO::cout << "MapObjectDisk: reading key/fileposition data" << std::endl;
-	
-      /* Read the map in (metadata) */
-      readMapBinary(md_start);
+	/* Read the map in (metadata) */
+	readMapBinary(md_start);
+      }
 	
       /* And we are done */
       state = UNCHANGED;
@@ -405,14 +639,22 @@ namespace QDP
   {
     switch(state) { 
     case UNCHANGED:
-      if( streamer.is_open() ) { 
-	streamer.close();
+      if( mapped.is_open() ) { 
+	mapped.close();
+      }
+      if( read_fd >= 0 ) {
+	::close(read_fd);
+	read_fd = -1;
+      }
+      if( streamerIsOpen() ) { 
+	closeStreamer();
       }
       break;
     case MODIFIED:
+      writePending();
       closeWrite(); // This finalizes files for us
-      if( streamer.is_open() ) { 
-	streamer.close();
+      if( streamerIsOpen() ) { 
+	closeStreamer();
       }
       break;
     case INIT:
@@ -423,6 +665,7 @@ namespace QDP
     }
 
     state = INIT;
+    lazy = false;
   }
   
 
@@ -441,6 +684,7 @@ namespace QDP
   {
     switch(state) { 
     case MODIFIED:
+      writePending();
       closeWrite();  // not optimal
       state = UNCHANGED;
       break;
@@ -459,16 +703,17 @@ namespace QDP
   void
   MapObjectDisk<K,V>::keys(std::vector<K>& keys_) const 
   {
-    if( streamer.is_open() ) 
+    if( isOpen() ) 
     {
+      loadMap();
+
       typename MapType_t::const_iterator iter;
       for(iter  = src_map.begin();
 	  iter != src_map.end();
 	  ++iter) 
       { 
-	BinaryBufferReader bin(iter->first);
 	K key;
-	read(bin, key);
+	decodeKey(iter->first, key);
 	keys_.push_back(key);
       }
     }
@@ -544,16 +789,20 @@ namespace QDP
   {
     int ret = 0;
 
+    // A mapped file is read-only
+    if (mapped.is_open())
+      return 1;
+
     switch (state)  { 
     case MODIFIED :
     case UNCHANGED : {
       //  Find key
-      BinaryBufferWriter bin;
-      write(bin, key);
-      typename MapType_t::const_iterator key_ptr = src_map.find(bin.str());
+      typename MapType_t::const_iterator key_ptr = src_map.find(encodeKey(key));
 
       if (key_ptr != src_map.end()) { 
-	// Key does exist
+	// Key does exist. It may still be in the buffer
+	writePending();
+
 	pos_type wpos = convertFromPrivate(key_ptr->second);
 	if (level >= 2) {
 	  QDPIO::cout << "Found key to update. Position is " << wpos << std::endl;
@@ -580,6 +829,30 @@ namespace QDP
 	// Done
 	state = MODIFIED;
       }
+      else if (write_behind > 0) {
+	// Key does not exist. Queue the record behind the others
+	if (pending_len == 0) {
+	  streamer.seekEnd(0);
+	  pending_start = streamer.currentPosition();
+	}
+
+	pos_type pos = pending_start + off_type(pending_len);
+	src_map.insert(std::make_pair(encodeKey(key), convertToPrivate(pos)));
+
+	std::string rec;
+	pending_len += encodeValue(val, rec);
+	pending += rec;
+
+	if (level >= 2) {
+	  QDPIO::cout << "Queued record at position " << pos << ". Buffered bytes: " << pending_len << std::endl;
+	}
+
+	if (pending_len >= write_behind)
+	  writePending();
+
+	// Done
+	state = MODIFIED;
+      }
       else {
 	// Key does not exist
 
@@ -587,7 +860,7 @@ namespace QDP
 	pos_type pos = streamer.currentPosition();
       
 	// Insert pos into map
-	src_map.insert(std::make_pair(bin.str(), convertToPrivate(pos)));
+	src_map.insert(std::make_pair(encodeKey(key), convertToPrivate(pos)));
 
 	streamer.resetChecksum();
 
@@ -641,31 +914,33 @@ namespace QDP
   int 
   MapObjectDisk<K,V>::get(const K& key, V& val) const
   { 
+    writePending();
+
+    BinaryReader& in = reader();
+
     int ret = 0;
 
     switch(state) { 
     case UNCHANGED: // Deliberate fallthrough
     case MODIFIED: {
-      BinaryBufferWriter bin;
-      write(bin, key);
-      typename MapType_t::const_iterator key_ptr = src_map.find(bin.str());
+      priv_pos_type_t rpos;
 
-      if (key_ptr != src_map.end())
+      if (findKey(encodeKey(key), rpos))
       {
 	// If key exists find file offset
-	pos_type pos = convertFromPrivate(key_ptr->second);
+	pos_type pos = convertFromPrivate(rpos);
 
 	// Do the seek and time it 
 	StopWatch swatch;
 
 	swatch.reset();
 	swatch.start();
-	streamer.seek(pos);
+	in.seek(pos);
 	swatch.stop();
 	double seek_time = swatch.getTimeInSeconds();
 
 	// Reset the checkums
-	streamer.resetChecksum();
+	in.resetChecksum();
 
 	// Grab start pos: We've just seeked it
 	pos_type start_pos = pos;
@@ -673,11 +948,11 @@ namespace QDP
 	// Time the read
 	swatch.reset();
 	swatch.start();
-	read(streamer, val);
+	read(in, val);
 	swatch.stop();
 
 	double read_time = swatch.getTimeInSeconds();
-	pos_type end_pos = streamer.currentPosition();
+	pos_type end_pos = in.currentPosition();
 
 	// Print data
 	if (level >= 1) { 
@@ -689,15 +964,15 @@ namespace QDP
 
 
 	if (level >= 2) { 
-	  QDPIO::cout << "Read record. Current position: " << streamer.currentPosition() << std::endl;
+	  QDPIO::cout << "Read record. Current position: " << in.currentPosition() << std::endl;
 	}
 
-	QDPUtil::n_uint32_t calc_checksum=streamer.getChecksum();
+	QDPUtil::n_uint32_t calc_checksum=in.getChecksum();
 	QDPUtil::n_uint32_t read_checksum;
-	read(streamer, read_checksum);
+	read(in, read_checksum);
 
 	if (level >= 2) {
-	  QDPIO::cout << " Record checksum: " << read_checksum << "  Current Position: " << streamer.currentPosition() << std::endl;
+	  QDPIO::cout << " Record checksum: " << read_checksum << "  Current Position: " << in.currentPosition() << std::endl;
 	}
 
 	if( read_checksum != calc_checksum ) { 
@@ -723,6 +998,50 @@ namespace QDP
   }
   
   
+  /*! 
+   * Lookup an item in the map from any thread
+   */
+  template<typename K, typename V>
+  int 
+  MapObjectDisk<K,V>::getConcurrent(const K& key, V& val) const
+  { 
+    if (state != UNCHANGED || (read_fd < 0 && ! mapped.is_open()))
+      QDP_error_exit("MapObjectDisk: getConcurrent needs a file opened read-only with setConcurrent or setMmap");
+
+    // The key as stored, serialized on this node
+    BinaryLocalBufferReaderWriter kbin;
+    write(kbin, key);
+
+    priv_pos_type_t rpos;
+    if (! findKeyAt(kbin.str(), rpos))
+      return 1;
+
+    const uint64_t pos = uint64_t(std::streamoff(convertFromPrivate(rpos)));
+    const size_t end = mapped.is_open() ? mapped.size() : file_size;
+
+    // Records carry no length, so read more until the value and its checksum fit
+    for(size_t len = 65536; ; len *= 4)
+    {
+      BinaryLocalBufferReaderWriter bin(readAt(pos, len));
+      read(bin, val);
+      QDPUtil::n_uint32_t calc_checksum = bin.getChecksum();
+      QDPUtil::n_uint32_t read_checksum;
+      read(bin, read_checksum);
+
+      if (! bin.fail())
+      {
+	if (read_checksum != calc_checksum)
+	  QDP_error_exit("MapObjectDisk: mismatched checksums in %s: expected %u but read %u",
+			 filename.c_str(), calc_checksum, read_checksum);
+	return 0;
+      }
+
+      if (pos + len >= end)
+	QDP_error_exit("MapObjectDisk: record in %s runs past the end of the file", filename.c_str());
+    }
+  }
+  
+  
   /**
    * Does this key exist in the store
    * @param key a key object
@@ -732,9 +1051,28 @@ namespace QDP
   bool 
   MapObjectDisk<K,V>::exist(const K& key) const 
   {
-    BinaryBufferWriter bin;
-    write(bin, key);
-    return (src_map.find(bin.str()) == src_map.end()) ? false : true;
+    priv_pos_type_t pos;
+    return findKey(encodeKey(key), pos);
+  }
+  
+  
+
+  /**
+   * Where the record of a key starts
+   */
+  template<typename K, typename V>
+  bool 
+  MapObjectDisk<K,V>::getPosition(const K& key, pos_type& pos) const 
+  {
+    // The record must be on disk
+    writePending();
+
+    priv_pos_type_t rpos;
+    if (! findKey(encodeKey(key), rpos))
+      return false;
+
+    pos = convertFromPrivate(rpos);
+    return true;
   }
   
   
@@ -742,6 +1080,279 @@ namespace QDP
   /***************** UTILITY ******************/
 
 
+  //! Key as stored in the map
+  template<typename K, typename V>
+  std::string
+  MapObjectDisk<K,V>::encodeKey(const K& key) const
+  {
+    if (local)
+    {
+      BinaryLocalBufferReaderWriter bin;
+      write(bin, key);
+      return bin.str();
+    }
+
+    BinaryBufferWriter bin;
+    write(bin, key);
+    return bin.str();
+  }
+
+
+  //! Key from the map
+  template<typename K, typename V>
+  void
+  MapObjectDisk<K,V>::decodeKey(const std::string& s, K& key) const
+  {
+    if (local)
+    {
+      BinaryLocalBufferReaderWriter bin(s);
+      read(bin, key);
+      return;
+    }
+
+    BinaryBufferReader bin(s);
+    read(bin, key);
+  }
+
+
+
+  //! Serialize a value and its checksum
+  template<typename K, typename V>
+  size_t
+  MapObjectDisk<K,V>::encodeValue(const V& val, std::string& s) const
+  {
+    if (local)
+    {
+      BinaryLocalBufferReaderWriter bin;
+      write(bin, val);
+      write(bin, bin.getChecksum());
+      s = bin.str();
+      return s.size();
+    }
+
+    // Only the primary node holds the bytes, as it does the writing
+    BinaryBufferWriter bin;
+    write(bin, val);
+    write(bin, bin.getChecksum());
+    s = bin.strPrimaryNode();
+    return size_t(std::streamoff(bin.currentPosition()));
+  }
+
+
+  //! Write out the write-behind buffer
+  template<typename K, typename V>
+  void
+  MapObjectDisk<K,V>::writePending() const
+  {
+    if (pending_len == 0)
+      return;
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    // Reads and updates may have moved the stream since the batch began
+    streamer.seek(pending_start);
+    streamer.writeArray(pending.data(), 1, pending_len);
+    streamer.flush();
+    swatch.stop();
+
+    if (level >= 1) {
+      double MiBWritten = (double)(pending_len)/(double)(1024*1024);
+      double time = swatch.getTimeInSeconds();
+
+      QDPIO::cout << " wrote batch: " << MiBWritten << " MiB. Time: " << time << " sec. Write Bandwidth: " << MiBWritten/time<<std::endl;
+    }
+
+    pending.clear();
+    pending_len = 0;
+  }
+
+
+  //! Find a key
+  template<typename K, typename V>
+  bool
+  MapObjectDisk<K,V>::findKey(const std::string& key, priv_pos_type_t& pos) const
+  {
+    typename MapType_t::const_iterator key_ptr = src_map.find(key);
+    if (key_ptr != src_map.end())
+    {
+      pos = key_ptr->second;
+      return true;
+    }
+
+    if (! lazy)
+      return false;
+
+    // Binary search over the sorted entries
+    BinaryReader& in = reader();
+    unsigned int lo = 0, hi = index_size;
+    while (lo < hi)
+    {
+      unsigned int mid = lo + (hi - lo) / 2;
+
+      uint64_t entry;
+      in.seek(index_start + off_type(uint64_t(mid)*sizeof(uint64_t)));
+      in.readArray((char *)&entry, sizeof(uint64_t), 1);
+
+      std::string key_str;
+      in.seek(pos_type(off_type(entry)));
+      readDesc(in, key_str);
+
+      int cmp = key_str.compare(key);
+      if (cmp == 0)
+      {
+	in.readArray((char *)&pos, sizeof(priv_pos_type_t), 1);
+	src_map.insert(std::make_pair(key, pos));
+	return true;
+      }
+      else if (cmp < 0)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+    return false;
+  }
+
+
+  //! Bytes of the file at pos
+  template<typename K, typename V>
+  std::string
+  MapObjectDisk<K,V>::readAt(uint64_t pos, size_t len) const
+  {
+    if (mapped.is_open())
+    {
+      if (pos >= mapped.size())
+	return std::string();
+      return std::string(mapped.data() + pos, std::min(len, size_t(mapped.size() - pos)));
+    }
+
+    std::string buf(len, '\0');
+    size_t n = 0;
+    while (n < len)
+    {
+      ssize_t k = pread(read_fd, &buf[n], len - n, off_t(pos + n));
+      if (k < 0)
+	QDP_error_exit("MapObjectDisk: pread of %s failed on node %d", filename.c_str(), Layout::nodeNumber());
+      if (k == 0)
+	break;
+      n += k;
+    }
+    buf.resize(n);
+    return buf;
+  }
+
+
+  //! Find a key from any thread
+  template<typename K, typename V>
+  bool
+  MapObjectDisk<K,V>::findKeyAt(const std::string& key, priv_pos_type_t& pos) const
+  {
+    typename MapType_t::const_iterator key_ptr = src_map.find(key);
+    if (key_ptr != src_map.end())
+    {
+      pos = key_ptr->second;
+      return true;
+    }
+
+    if (! lazy)
+      return false;
+
+    // Binary search over the sorted entries, as in findKey
+    const uint64_t table = uint64_t(std::streamoff(index_start));
+    unsigned int lo = 0, hi = index_size;
+    while (lo < hi)
+    {
+      unsigned int mid = lo + (hi - lo) / 2;
+
+      uint64_t entry;
+      {
+	BinaryLocalBufferReaderWriter bin(readAt(table + uint64_t(mid)*sizeof(uint64_t), sizeof(uint64_t)));
+	bin.readArray((char *)&entry, sizeof(uint64_t), 1);
+      }
+
+      // An entry is the key, with its length in front, then the position
+      int len;
+      {
+	BinaryLocalBufferReaderWriter bin(readAt(entry, sizeof(int)));
+	read(bin, len);
+      }
+
+      BinaryLocalBufferReaderWriter bin(readAt(entry, sizeof(int) + size_t(len) + sizeof(priv_pos_type_t)));
+      std::string key_str;
+      readDesc(bin, key_str);
+
+      int cmp = key_str.compare(key);
+      if (cmp == 0)
+      {
+	bin.readArray((char *)&pos, sizeof(priv_pos_type_t), 1);
+	return true;
+      }
+      else if (cmp < 0)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+    return false;
+  }
+
+
+  //! Complete the map
+  template<typename K, typename V>
+  void
+  MapObjectDisk<K,V>::loadMap() const
+  {
+    if (! lazy)
+      return;
+
+    // Entries found so far get read again
+    src_map.clear();
+    const_cast<MapObjectDisk<K,V>*>(this)->readMapBinary(map_start);
+    lazy = false;
+  }
+
+
+  //! Compacted copy
+  template<typename K, typename V>
+  void
+  MapObjectDisk<K,V>::compact(const std::string& file) const
+  {
+    if (state == INIT)
+      errorState("MapObjectDisk: compact() called on a closed database");
+
+    loadMap();
+
+    std::vector<std::string> order;
+    order.reserve(src_map.size());
+    for(typename MapType_t::const_iterator iter = src_map.begin(); iter != src_map.end(); ++iter)
+      order.push_back(iter->first);
+
+    std::sort(order.begin(), order.end());
+
+    MapObjectDisk<K,V> out(local);
+    out.setDebug(level);
+    out.setWriteBehind((write_behind > 0) ? write_behind : 16*1024*1024);
+    out.sorted_map = true;
+    out.insertUserdata(user_data);
+    out.open(file, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
+
+    for(std::vector<std::string>::const_iterator k = order.begin(); k != order.end(); ++k)
+    {
+      K key;
+      V val;
+      decodeKey(*k, key);
+      if (get(key, val) != 0)
+	errorState("MapObjectDisk: compact() lost a key");
+
+      out.insert(key, val);
+    }
+
+    out.close();
+  }
+
+
   //! Skip past header
   template<typename K, typename V>
   void 
@@ -749,10 +1360,11 @@ namespace QDP
   { 
     switch(state) { 
     case MODIFIED: {
-      if ( streamer.is_open() ) 
+      if ( streamerIsOpen() ) 
       { 
 	int user_len = user_data.length();
-	QDPInternal::broadcast(user_len);
+	if (! local)
+	  QDPInternal::broadcast(user_len);
 	
 	streamer.seek( MapObjDiskEnv::getFileMagic().length() + sizeof(int)
 		       + user_len + sizeof(int)
@@ -775,18 +1387,20 @@ namespace QDP
   typename MapObjectDisk<K,V>::priv_pos_type_t
   MapObjectDisk<K,V>::readCheckHeader(void) 
   {
+    BinaryReader& in = reader();
+
     priv_pos_type_t md_position{0, 0};
 
-    if( streamer.is_open() ) 
+    if( isOpen() ) 
     {
       if (level >= 2) {
 	QDPIO::cout << "Rewinding File" << std::endl;
       }
       
-      streamer.rewind();
+      in.rewind();
       
       std::string read_magic;
-      streamer.readDesc(read_magic);
+      in.readDesc(read_magic);
       
       // Check magic
       if (read_magic != MapObjDiskEnv::getFileMagic()) { 
@@ -796,29 +1410,29 @@ namespace QDP
       }
 
       if (level >= 2) {
-	QDPIO::cout << "Read File Magic. Current Position: " << streamer.currentPosition() << std::endl;
+	QDPIO::cout << "Read File Magic. Current Position: " << in.currentPosition() << std::endl;
       }
       
       MapObjDiskEnv::file_version_t read_version;
-      read(streamer, read_version);
+      read(in, read_version);
       
       if (level >= 2) {
-	QDPIO::cout << "Read File Verion. Current Position: " << streamer.currentPosition() << std::endl;
+	QDPIO::cout << "Read File Verion. Current Position: " << in.currentPosition() << std::endl;
       }
       
       // Check version
       QDPIO::cout << "MapObjectDisk: file has version: " << read_version << std::endl;
       
-      QDP::readDesc(streamer, user_data);
+      QDP::readDesc(in, user_data);
       if (level >= 2) {
-	QDPIO::cout << "User data. String=" << user_data << ". Current Position: " << streamer.currentPosition() << std::endl;
+	QDPIO::cout << "User data. String=" << user_data << ". Current Position: " << in.currentPosition() << std::endl;
       }
       
       // Read MD location
-      streamer.readArray((char *)&md_position, sizeof(priv_pos_type_t), 1);
+      in.readArray((char *)&md_position, sizeof(priv_pos_type_t), 1);
 
       if (level >= 2) {
-	QDPIO::cout << "Read MD Location. Current position: " << streamer.currentPosition() << std::endl;
+	QDPIO::cout << "Read MD Location. Current position: " << in.currentPosition() << std::endl;
       }
       
       if (level >= 2) {
@@ -841,6 +1455,7 @@ namespace QDP
   MapObjectDisk<K,V>::writeMapBinary(void)  
   {
     unsigned int map_size = src_map.size();
+    pos_type md_pos = streamer.currentPosition();
 
     streamer.resetChecksum();
     write(streamer, map_size);
@@ -848,14 +1463,26 @@ namespace QDP
       QDPIO::cout << "Wrote map size: " << map_size << " entries.  Current position : " << streamer.currentPosition() << std::endl;
     }
     
+    std::vector<const typename MapType_t::value_type*> entries;
+    entries.reserve(map_size);
+
     typename MapType_t::const_iterator iter;
     for(iter  = src_map.begin();
 	iter != src_map.end();
 	++iter) 
     { 
-      priv_pos_type_t pos=iter->second;
+      entries.push_back(&*iter);
+    }
+
+    if (sorted_map)
+      std::sort(entries.begin(), entries.end(), 
+		[](const typename MapType_t::value_type* a, const typename MapType_t::value_type* b) {return a->first < b->first;});
+
+    for(size_t i=0; i < entries.size(); i++) 
+    { 
+      priv_pos_type_t pos=entries[i]->second;
       
-      writeDesc(streamer, iter->first); 
+      writeDesc(streamer, entries[i]->first); 
       streamer.writeArray((char *)&pos,sizeof(priv_pos_type_t),1);
       
       if (level >= 2) {
@@ -864,6 +1491,33 @@ namespace QDP
     }
     write(streamer, streamer.getChecksum());
     QDPIO::cout << "Wrote Checksum On Map: " << streamer.getChecksum() << std::endl;
+
+    if (sorted_map)
+    {
+      // Positions of the entries follow from the key lengths
+      uint64_t table_pos = uint64_t(std::streamoff(md_pos)) + sizeof(unsigned int);
+      std::vector<uint64_t> table(entries.size());
+      for(size_t i=0; i < entries.size(); i++) 
+      {
+	table[i] = table_pos;
+	table_pos += sizeof(int) + entries[i]->first.length() + sizeof(priv_pos_type_t);
+      }
+      table_pos += sizeof(QDPUtil::n_uint32_t);
+
+      uint64_t num = table.size();
+      const std::string magic = MapObjDiskEnv::getIndexMagic();
+
+      if (num > 0)
+	streamer.writeArray((char *)&table[0], sizeof(uint64_t), num);
+      streamer.writeArray((char *)&table_pos, sizeof(uint64_t), 1);
+      streamer.writeArray((char *)&num, sizeof(uint64_t), 1);
+      streamer.writeArray(magic.data(), 1, magic.length());
+
+      if (level >= 2) {
+	QDPIO::cout << "Wrote key index. Current position : " << streamer.currentPosition() << std::endl;
+      }
+    }
+
     streamer.flush();
   }
   
@@ -874,40 +1528,67 @@ namespace QDP
   void 
   MapObjectDisk<K,V>::readMapBinary(const priv_pos_type_t& md_start)
   {
-    streamer.seek(convertFromPrivate(md_start));
-    streamer.resetChecksum();
+    BinaryReader& in = reader();
+
+    // The map runs to the end of the file. Read it in one go and decode
+    // it on each node, rather than paying a broadcast per entry
+    pos_type md_pos = convertFromPrivate(md_start);
+    // An index, if any, follows the map
+    pos_type md_end;
+    unsigned int count;
+    if (! readIndexTrailer(md_end, count))
+    {
+      in.seekEnd(0);
+      md_end = in.currentPosition();
+    }
+    size_t md_len = size_t(md_end - md_pos);
+
+    std::string md(md_len, '\0');
+    in.seek(md_pos);
+    if (md_len > 0)
+      in.readArray(&md[0], 1, md_len);
 
     if (level >= 2) {
-      QDPIO::cout << "Sought start of metadata. Current position: " << streamer.currentPosition() << std::endl;
+      QDPIO::cout << "Read " << md_len << " bytes of metadata. Current position: " << in.currentPosition() << std::endl;
     }
-    
+
+    BinaryLocalBufferReaderWriter bin(md);
+    bin.resetChecksum();
+
     unsigned int num_records;
-    read(streamer, num_records);
+    read(bin, num_records);
 
     if (level >= 2) {
-      QDPIO::cout << "Read num of entries: " << num_records << " records. Current Position: " << streamer.currentPosition() << std::endl;
+      QDPIO::cout << "Read num of entries: " << num_records << " records" << std::endl;
     }
+
+    src_map.reserve(num_records);
     
     for(unsigned int i=0; i < num_records; i++) 
     { 
       priv_pos_type_t rpos;
       std::string key_str;
-      readDesc(streamer, key_str);
+      readDesc(bin, key_str);
       
-      streamer.readArray((char *)&rpos, sizeof(priv_pos_type_t),1);
+      bin.readArray((char *)&rpos, sizeof(priv_pos_type_t),1);
       
       if (level >= 2) {
-	QDPIO::cout << "Read Key/Position pair. Current position: " << streamer.currentPosition() << std::endl;
+	QDPIO::cout << "Read Key/Position pair. Current position: " << bin.currentPosition() << std::endl;
       }
       // Add position to the map
       src_map.insert(std::make_pair(key_str,rpos));
     }
-    QDPUtil::n_uint32_t calc_checksum = streamer.getChecksum();
+    QDPUtil::n_uint32_t calc_checksum = bin.getChecksum();
     QDPUtil::n_uint32_t read_checksum;
-    read(streamer, read_checksum);
+    read(bin, read_checksum);
+
+    if (bin.fail()) {
+      QDPIO::cerr << "MapObjectDisk: truncated key map in " << filename << std::endl;
+      QDP_abort(1);
+    }
 
     if (level >= 2) {
-      QDPIO::cout << "Read Map checksum: " << read_checksum << "  Current Position: " << streamer.currentPosition();
+      QDPIO::cout << "Read Map checksum: " << read_checksum;
     }
     if( read_checksum != calc_checksum ) { 
       QDPIO::cout << "Mismatched Checksums: Expected: " << calc_checksum << " but read " << read_checksum << std::endl;
@@ -921,6 +1602,48 @@ namespace QDP
 
 
 
+  //! Find the index
+  template<typename K, typename V>
+  bool
+  MapObjectDisk<K,V>::readIndexTrailer(pos_type& table, unsigned int& count) const
+  {
+    BinaryReader& in = reader();
+
+    // Trailer: table position, number of entries, magic
+    const std::string magic = MapObjDiskEnv::getIndexMagic();
+    const size_t trailer_len = 2*sizeof(uint64_t) + magic.length();
+
+    in.seekEnd(0);
+    pos_type end = in.currentPosition();
+    if (size_t(std::streamoff(end)) < trailer_len)
+      return false;
+
+    uint64_t table_pos, num;
+    std::string read_magic(magic.length(), '\0');
+    in.seek(end - off_type(trailer_len));
+    in.readArray((char *)&table_pos, sizeof(uint64_t), 1);
+    in.readArray((char *)&num, sizeof(uint64_t), 1);
+    in.readArray(&read_magic[0], 1, magic.length());
+
+    if (read_magic != magic)
+      return false;
+
+    // The table must end where the trailer starts
+    if (table_pos + num*sizeof(uint64_t) + trailer_len != uint64_t(std::streamoff(end)))
+      return false;
+
+    table = pos_type(off_type(table_pos));
+    count = num;
+
+    if (level >= 2) {
+      QDPIO::cout << "Found key index of " << count << " entries at position " << table << std::endl;
+    }
+
+    return true;
+  }
+
+
+
   /*!
    * This is a utility function to sync the in memory offset map
    * with the one on the disk, and then close the file for writing.
@@ -980,6 +1703,21 @@ namespace QDP
   }
 
 
+  //----------------------------------------------------------------------------
+  //! Compact a database file without otherwise using it
+  /*!
+   * Collective. See MapObjectDisk::compact
+   */
+  template<typename K, typename V>
+  void compactMapObjectDisk(const std::string& in_file, const std::string& out_file)
+  {
+    MapObjectDisk<K,V> db;
+    db.open(in_file, std::ios_base::in);
+    db.compact(out_file);
+    db.close();
+  }
+
+
 } // namespace Chroma
 
 #endif
@@ -36,17 +36,34 @@ namespace QDP
     int getDebug() const {return dbs_[0]->getDebug();}
 
     //! Open files
+    /*!
+     * The key maps of all files are merged, so a lookup goes straight to
+     * the first file holding the key.
+     */
     void open(const std::vector<std::string>& files)
     {
       dbs_.resize(files.size());
+      index_.clear();
 
       for(int i=0; i < dbs_.size(); ++i)
       {
 	dbs_[i] = new MapObjectDisk<K,V>();
 	dbs_[i]->open(files[i], std::ios_base::in);
+
+	std::vector<K> kk;
+	dbs_[i]->keys(kk);
+
+	for(typename std::vector<K>::const_iterator k=kk.begin(); k != kk.end(); ++k)
+	  index_.insert(std::make_pair(encodeKey(*k), i));
       }
     }
 
+    //! Open the shards listed in the manifest of a MapObjectDiskSharded
+    void openManifest(const std::string& manifest)
+    {
+      open(MapObjDiskEnv::readManifest(manifest));
+    }
+
 
     //! Check if a DB file exists before opening.
     bool fileExists(const std::vector<std::string>& files) const
@@ -71,6 +88,8 @@ namespace QDP
 	dbs_[i]->close();
 	delete dbs_[i];
       }
+      dbs_.clear();
+      index_.clear();
     }
 
 
@@ -82,15 +101,11 @@ namespace QDP
      */
     int get(const K& key, V& val) const
     {
-      int ret = -1;
+      typename std::unordered_map<std::string,int>::const_iterator k = index_.find(encodeKey(key));
+      if (k == index_.end())
+	return -1;
 
-      for(int i=0; i < dbs_.size(); ++i) 
-      {
-	ret = dbs_[i]->get(key, val);
-	if (ret == 0)
-	  break;
-      }
-      return ret;
+      return dbs_[k->second]->get(key, val);
     }
 
 
@@ -102,23 +117,7 @@ namespace QDP
     void keys(std::vector<K>& keys_) const {
       keys_.clear();
 
-      std::unordered_map<std::string,int> unique_it;
-
-      for(int i=0; i < dbs_.size(); ++i) 
-      {
-	std::vector<K> kk;
-	dbs_[i]->keys(kk);
-
-	for(typename std::vector<K>::const_iterator k=kk.begin(); k != kk.end(); ++k)
-	{
-	  BinaryBufferWriter bin;
-	  write(bin, *k);
-
-	  unique_it.insert(std::make_pair(bin.str(),1));
-	}
-      }
-
-      for(typename std::unordered_map<std::string,int>::const_iterator k=unique_it.begin(); k != unique_it.end(); ++k)
+      for(typename std::unordered_map<std::string,int>::const_iterator k=index_.begin(); k != index_.end(); ++k)
       {
 	BinaryBufferReader bin(k->first);
 	K key;
@@ -146,16 +145,7 @@ namespace QDP
      */
     bool exist(const K& key) const
     {
-      bool ret = false;
-      
-      for(int i=0; i < dbs_.size(); ++i)
-      {
-	ret = dbs_[i]->exist(key);
-	if (ret)
-	  break;
-      }
-      
-      return ret;
+      return index_.find(encodeKey(key)) != index_.end();
     }
 
     /**
@@ -184,9 +174,20 @@ namespace QDP
     //! Hide
     void operator=(const MapObjectDiskMultiple&) {}
 
+    //! Key as stored in the index
+    static std::string encodeKey(const K& key)
+    {
+      BinaryBufferWriter bin;
+      write(bin, key);
+      return bin.str();
+    }
+
   private:
     //! Array of read-only maps
     std::vector< MapObjectDisk<K,V>* > dbs_;
+
+    //! Which map holds each key
+    std::unordered_map<std::string,int> index_;
   };
 
 } // namespace Chroma
@@ -0,0 +1,96 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief A Map Object on Disk written by all nodes at once
+ */
+
+
+#ifndef __qdp_map_obj_disk_sharded_h__
+#define __qdp_map_obj_disk_sharded_h__
+
+#include "qdp_map_obj_disk.h"
+
+namespace QDP
+{
+
+  //----------------------------------------------------------------------------
+  //! Database that every node fills at the same time, one shard per node
+  /*!
+   * Each node writes its own shard file next to the manifest with a node
+   * local MapObjectDisk, so insert() is not collective and the output
+   * bandwidth grows with the number of nodes. close() writes a manifest
+   * listing the shards, which a MapObjectDiskMultiple opens with
+   * openManifest(). Each shard is an ordinary MapObjectDisk file.
+   *
+   * Values are written from the inserting node alone, so they must not
+   * be lattice fields. A key inserted on several nodes is looked up in
+   * the lowest numbered shard holding it.
+   */
+  template<typename K, typename V>
+  class MapObjectDiskSharded
+  {
+  public:
+    //! Empty constructor
+    MapObjectDiskSharded() : db(true) {}
+
+    //! Finalizes object
+    ~MapObjectDiskSharded() {close();}
+
+    //! Set debugging level
+    void setDebug(int level) {db.setDebug(level);}
+
+    //! Get debugging level
+    int getDebug() const {return db.getDebug();}
+
+    //! Insert user data, before open, into every shard
+    int insertUserdata(const std::string& user_data) {return db.insertUserdata(user_data);}
+
+    //! Start a new database. Collective
+    void open(const std::string& file)
+    {
+      close();
+      manifest = file;
+      db.open(MapObjDiskEnv::shardFile(manifest, Layout::nodeNumber()),
+	      std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
+    }
+
+    //! Insert into the shard of this node. Not collective
+    int insert(const K& key, const V& val) {return db.insert(key, val);}
+
+    //! Lookup in the shard of this node. Not collective
+    int get(const K& key, V& val) const {return db.get(key, val);}
+
+    //! Is the key in the shard of this node. Not collective
+    bool exist(const K& key) const {return db.exist(key);}
+
+    //! Number of entries in the shard of this node
+    unsigned int size() const {return db.size();}
+
+    //! Finish the shards and write the manifest. Collective
+    void close()
+    {
+      if (manifest.empty())
+	return;
+
+      db.close();
+      MapObjDiskEnv::writeManifest(manifest, Layout::numNodes());
+      manifest.clear();
+    }
+
+  private:
+    //! Hide
+    MapObjectDiskSharded(const MapObjectDiskSharded&);
+
+    //! Hide
+    void operator=(const MapObjectDiskSharded&);
+
+  private:
+    //! The manifest
+    std::string manifest;
+
+    //! Shard of this node
+    MapObjectDisk<K,V> db;
+  };
+
+} // namespace QDP
+
+#endif
@@ -9,6 +9,7 @@
 #include "qdp_map_obj.h"
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
 
 namespace QDP
 {
@@ -62,6 +63,12 @@ namespace QDP
 
   //----------------------------------------------------------------------------
   //! A wrapper over maps
+  /*!
+   * Entries are held in a hash table keyed by the binary serialization
+   * of the key, made on each node without communication. Iteration is
+   * in hash order; sortedKeys gives the keys in the order of their
+   * serialization, which does not change from run to run.
+   */
   template<typename K, typename V>
   class MapObjectMemory : public MapObject<K,V>
   {
@@ -115,18 +122,10 @@ namespace QDP
     int insert(const value_type& vv) 
     { 
       int ret = 0;
-      BinaryBufferWriter bin;
-      write(bin, vv.first);
-
-      const std::string bin_key(bin.str());
-      typename MapType_t::iterator iter = src_map.find(bin_key);
-      if (iter != src_map.end())
-      {
-	iter->second = vv;
-      }
-      else
+      std::pair<typename MapType_t::iterator,bool> ins = src_map.insert(std::make_pair(encodeKey(vv.first),vv));
+      if (! ins.second)
       {
-	src_map.insert(std::make_pair(bin_key,vv));
+	ins.first->second = vv;
       }
       return ret;
     }
@@ -135,10 +134,7 @@ namespace QDP
     int get(const K& key, V& val) const
     {
       int ret = 0;
-      BinaryBufferWriter bin;
-      write(bin, key);
-
-      typename MapType_t::const_iterator iter = src_map.find(bin.str());
+      typename MapType_t::const_iterator iter = src_map.find(encodeKey(key));
       if (iter == src_map.end()) {
 	ret = 1;
       }
@@ -148,13 +144,21 @@ namespace QDP
       return ret;
     }
 			
+    //! Getter that may be called from many threads at once
+    /*!
+     * Nothing is communicated, so OpenMP threads may look up keys in
+     * parallel as long as nothing inserts or erases while they do.
+     * Values that are lattice fields must not be copied this way.
+     */
+    int getConcurrent(const K& key, V& val) const {return get(key, val);}
+
+    //! Does a key exist, from any thread
+    bool existConcurrent(const K& key) const {return exist(key);}
+			
     //! Erase a key-value
     void erase(const K& key) 
     {
-      BinaryBufferWriter bin;
-      write(bin, key);
-
-      typename MapType_t::const_iterator iter = src_map.find(bin.str());
+      typename MapType_t::const_iterator iter = src_map.find(encodeKey(key));
       if (iter != src_map.end())
       {
 	src_map.erase(iter);
@@ -164,15 +168,16 @@ namespace QDP
     //! Clear the object
     void clear() {src_map.clear();}
 
+    //! Make room for n entries without rehashing
+    void reserve(size_t n) {src_map.reserve(n);}
+
     //! Flush out state of object
     void flush() {}
 
     //! Exists?
     bool exist(const K& key) const
     {
-      BinaryBufferWriter bin;
-      write(bin, key);
-      return (src_map.find(bin.str()) == src_map.end()) ? false : true;
+      return (src_map.find(encodeKey(key)) == src_map.end()) ? false : true;
     }
 			
     //! The number of elements
@@ -189,6 +194,22 @@ namespace QDP
       }
     }
 
+    //! Dump keys in the order of their serialization
+    void sortedKeys(std::vector<K>& _keys) const
+    {
+      std::vector<typename MapType_t::const_iterator> entries;
+      entries.reserve(src_map.size());
+      for(typename MapType_t::const_iterator iter  = src_map.begin(); iter != src_map.end(); ++iter)
+	entries.push_back(iter);
+
+      std::sort(entries.begin(), entries.end(), lessKey);
+
+      _keys.resize(0);
+      _keys.reserve(entries.size());
+      for(size_t i=0; i < entries.size(); ++i)
+	_keys.push_back(entries[i]->second.first);
+    }
+
     //! Dump keys and values
     virtual void keysAndValues(std::vector<K>& _keys, std::vector<V>& _vals) const 
     {
@@ -205,10 +226,7 @@ namespace QDP
     //! Getter
     const V& operator[](const K& key) const 
     {
-      BinaryBufferWriter bin;
-      write(bin, key);
-
-      typename MapType_t::const_iterator iter = src_map.find(bin.str());
+      typename MapType_t::const_iterator iter = src_map.find(encodeKey(key));
       if (iter == src_map.end())
       {
 	std::cerr << "MapObject: key not found" << std::endl;
@@ -221,10 +239,7 @@ namespace QDP
     //! Setter
     V& operator[](const K& key) 
     {
-      BinaryBufferWriter bin;
-      write(bin, key);
-
-      typename MapType_t::iterator iter = src_map.find(bin.str());
+      typename MapType_t::iterator iter = src_map.find(encodeKey(key));
       if (iter == src_map.end())
       {
 	std::cerr << "MapObject: key not found" << std::endl;
@@ -242,6 +257,20 @@ namespace QDP
 
 
   protected:  
+    //! Key as held in the map, serialized on this node
+    static std::string encodeKey(const K& key)
+    {
+      BinaryLocalBufferReaderWriter bin;
+      write(bin, key);
+      return bin.str();
+    }
+
+    //! Order of entries by serialized key
+    static bool lessKey(const typename MapType_t::const_iterator& a, const typename MapType_t::const_iterator& b)
+    {
+      return a->first < b->first;
+    }
+
     //! Map of objects
     mutable MapType_t src_map;
 
@@ -0,0 +1,380 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief A map of lattice fields that spills cold ones to node-local disk
+ */
+
+#ifndef __qdp_map_obj_spill_h__
+#define __qdp_map_obj_spill_h__
+
+#include "qdp_map_obj.h"
+#include <list>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace QDP
+{
+
+  //----------------------------------------------------------------------------
+  //! Slots of equal size in a memory mapped scratch file of this node
+  /*!
+   * The file is made in the spill directory and unlinked at once, so it
+   * goes away with the job. Storing a slot copies into the mapping and
+   * starts the write-back to disk without waiting for it; loading copies
+   * out of the mapping, faulting the pages in. Nothing is communicated.
+   */
+  class SpillFile
+  {
+  public:
+    SpillFile();
+
+    //! Unmaps and closes the file
+    ~SpillFile();
+
+    //! Directory of the scratch files, best on node-local NVMe
+    /*! The default is $QDP_SPILL_DIR, else $TMPDIR, else /tmp */
+    static void setDirectory(const std::string& dir);
+
+    //! Directory of the scratch files
+    static std::string directory();
+
+    //! Make the file for slots of slot_bytes each
+    void open(size_t slot_bytes);
+
+    //! Drop the file and all slots
+    void close();
+
+    //! Is the file open
+    bool isOpen() const {return fd >= 0;}
+
+    //! A free slot, growing the file when there is none
+    int newSlot();
+
+    //! Give back a slot
+    void freeSlot(int slot);
+
+    //! Copy src into slot and start writing it back
+    void store(int slot, const void* src);
+
+    //! Copy slot into dst
+    void load(int slot, void* dst);
+
+    //! Start reading slot from disk ahead of a load
+    void prefetch(int slot);
+
+    //! Bytes written to and read from the file so far
+    size_t bytesStored() const {return stored;}
+    size_t bytesLoaded() const {return loaded;}
+
+  private:
+    //! Hide
+    SpillFile(const SpillFile&);
+    void operator=(const SpillFile&);
+
+    //! Map slot into memory
+    unsigned char* mapSlot(int slot);
+
+    int fd;
+    size_t bytes;     // used bytes of a slot
+    size_t stride;    // bytes of a slot in the file, whole pages
+    int nslots;       // slots in the file
+    std::vector<int> free_slots;
+    size_t stored;
+    size_t loaded;
+  };
+
+
+  //----------------------------------------------------------------------------
+  //! A map of lattice fields holding only the most recently used in memory
+  /*!
+   * For the hundreds of eigenvectors or solutions kept by distillation and
+   * deflation. At most getMaxResident() values stay in memory; inserting
+   * or looking up another one writes the least recently used out to a
+   * memory mapped scratch file on node-local disk (see SpillFile) and
+   * frees it. A value not in memory is read back when it is looked up.
+   * prefetch() starts reading values ahead of a sweep over them, so the
+   * disk works while the previous value is used.
+   *
+   * V is a lattice field, OLattice<T>. Each node spills its own sites
+   * and nothing is communicated, so every node must make the same calls,
+   * as with any operation on lattice fields.
+   *
+   *   MapObjectSpill<int,LatticeColorVector> evecs(64);
+   *   for(int i=0; i < nvec; ++i)
+   *     evecs.insert(i, vec[i]);
+   *   ...
+   *   for(int i=0; i < nvec; ++i)
+   *   {
+   *     evecs.prefetch(i+1);
+   *     chi += evecs[i] * ...;
+   *   }
+   */
+  template<typename K, typename V>
+  class MapObjectSpill : public MapObject<K,V>
+  {
+  public:
+    //! Re-export these
+    typedef K key_type;
+    typedef V mapped_type;
+
+    //! Keep at most max_resident values in memory
+    explicit MapObjectSpill(int max_resident = 16) : max_res(max_resident), nres(0) {}
+
+    //! Destructor
+    ~MapObjectSpill() {clear();}
+
+    //! Set the number of values kept in memory, spilling any over it
+    void setMaxResident(int n)
+    {
+      max_res = (n < 1) ? 1 : n;
+      makeRoom(0);
+    }
+
+    //! The number of values kept in memory
+    int getMaxResident() const {return max_res;}
+
+    //! The number of values now in memory
+    int resident() const {return nres;}
+
+    //! Insert user data into the metadata database
+    int insertUserdata(const std::string& user_data_)
+    {
+      user_data = user_data_;
+      return 0;
+    }
+
+    //! Get user user data from the metadata database
+    int getUserdata(std::string& user_data_) const
+    {
+      user_data_ = user_data;
+      return 0;
+    }
+
+    //! Insert, or replace the value of a key
+    int insert(const K& key, const V& val)
+    {
+      std::string k = encodeKey(key);
+      typename MapType_t::iterator iter = src_map.find(k);
+      if (iter == src_map.end())
+      {
+	iter = src_map.insert(std::make_pair(k, Entry())).first;
+	iter->second.key = key;
+      }
+
+      Entry& e = iter->second;
+      if (e.val == 0)
+      {
+	makeRoom(1);
+	e.val = new V;
+	++nres;
+      }
+      *(e.val) = val;
+      e.dirty = true;
+      touch(iter);
+      return 0;
+    }
+
+    //! Getter, reading the value back from disk if it was spilled
+    int get(const K& key, V& val) const
+    {
+      typename MapType_t::iterator iter = src_map.find(encodeKey(key));
+      if (iter == src_map.end())
+	return 1;
+
+      val = fetch(iter);
+      return 0;
+    }
+
+    //! Start reading a spilled value back from disk
+    /*! A hint: nothing happens if key is absent or in memory */
+    void prefetch(const K& key) const
+    {
+      typename MapType_t::iterator iter = src_map.find(encodeKey(key));
+      if (iter != src_map.end() && iter->second.val == 0)
+	spill.prefetch(iter->second.slot);
+    }
+
+    //! Erase a key-value
+    void erase(const K& key)
+    {
+      typename MapType_t::iterator iter = src_map.find(encodeKey(key));
+      if (iter == src_map.end())
+	return;
+
+      drop(iter->second);
+      src_map.erase(iter);
+    }
+
+    //! Clear the object
+    void clear()
+    {
+      for(typename MapType_t::iterator iter = src_map.begin(); iter != src_map.end(); ++iter)
+	drop(iter->second);
+      src_map.clear();
+      spill.close();
+    }
+
+    //! Write every value in memory to disk as well, keeping it
+    void flush()
+    {
+      for(typename MapType_t::iterator iter = src_map.begin(); iter != src_map.end(); ++iter)
+	writeBack(iter->second);
+    }
+
+    //! Exists?
+    bool exist(const K& key) const
+    {
+      return (src_map.find(encodeKey(key)) == src_map.end()) ? false : true;
+    }
+
+    //! The number of elements
+    unsigned int size() const {return static_cast<unsigned long>(src_map.size());}
+
+    //! Dump keys
+    void keys(std::vector<K>& _keys) const
+    {
+      _keys.resize(0);
+      for(typename MapType_t::const_iterator iter  = src_map.begin(); iter != src_map.end(); ++iter)
+	_keys.push_back(iter->second.key);
+    }
+
+    //! Getter
+    /*! The reference holds until the next lookup or insert */
+    const V& operator[](const K& key) const
+    {
+      typename MapType_t::iterator iter = src_map.find(encodeKey(key));
+      if (iter == src_map.end())
+      {
+	std::cerr << "MapObject: key not found" << std::endl;
+	exit(1);
+      }
+
+      return fetch(iter);
+    }
+
+    //! Bytes written to and read back from disk so far
+    size_t bytesSpilled() const {return spill.bytesStored();}
+    size_t bytesFaulted() const {return spill.bytesLoaded();}
+
+  private:
+    //! A value, in memory or in a slot of the scratch file or both
+    struct Entry
+    {
+      Entry() : val(0), slot(-1), dirty(false), listed(false) {}
+
+      K key;
+      V* val;          // null when spilled
+      int slot;        // -1 until first spilled
+      bool dirty;      // val differs from its slot
+      bool listed;     // lru is set
+      std::list<std::string>::iterator lru;
+    };
+
+    //! Map type convenience
+    typedef std::unordered_map<std::string, Entry> MapType_t;
+
+    //! Hide
+    MapObjectSpill(const MapObjectSpill&);
+    void operator=(const MapObjectSpill&);
+
+    //! Key as held in the map, serialized on this node
+    static std::string encodeKey(const K& key)
+    {
+      BinaryLocalBufferReaderWriter bin;
+      write(bin, key);
+      return bin.str();
+    }
+
+    //! Bytes of the sites of a value on this node
+    static size_t valueBytes()
+    {
+      return Layout::sitesOnNode() * sizeof(*static_cast<const V*>(0)->getF());
+    }
+
+    //! The value of iter, read back if needed
+    const V& fetch(typename MapType_t::iterator iter) const
+    {
+      Entry& e = iter->second;
+      if (e.val == 0)
+      {
+	makeRoom(1);
+	e.val = new V;
+	++nres;
+	spill.load(e.slot, writable(*e.val).getF());
+	e.dirty = false;
+      }
+      touch(iter);
+      return *(e.val);
+    }
+
+    //! Mark the value of iter the most recently used
+    void touch(typename MapType_t::iterator iter) const
+    {
+      Entry& e = iter->second;
+      if (e.listed)
+	lru.erase(e.lru);
+      lru.push_front(iter->first);
+      e.lru = lru.begin();
+      e.listed = true;
+    }
+
+    //! Spill the least recently used values until extra more fit
+    void makeRoom(int extra) const
+    {
+      while (nres + extra > max_res && ! lru.empty())
+      {
+	Entry& e = src_map.find(lru.back())->second;
+	writeBack(e);
+	delete e.val;
+	e.val = 0;
+	--nres;
+
+	lru.pop_back();
+	e.listed = false;
+      }
+    }
+
+    //! Write a changed value in memory to its slot
+    void writeBack(Entry& e) const
+    {
+      if (e.val == 0 || ! e.dirty)
+	return;
+
+      if (! spill.isOpen())
+	spill.open(valueBytes());
+      if (e.slot < 0)
+	e.slot = spill.newSlot();
+
+      spill.store(e.slot, e.val->getF());
+      e.dirty = false;
+    }
+
+    //! Free the memory and slot of a value
+    void drop(Entry& e) const
+    {
+      if (e.val != 0)
+      {
+	delete e.val;
+	e.val = 0;
+	--nres;
+	lru.erase(e.lru);
+	e.listed = false;
+      }
+      if (e.slot >= 0)
+      {
+	spill.freeSlot(e.slot);
+	e.slot = -1;
+      }
+    }
+
+    int max_res;
+    mutable int nres;
+    mutable MapType_t src_map;
+    mutable std::list<std::string> lru;    // keys in memory, most recent first
+    mutable SpillFile spill;
+    std::string user_data;
+  };
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,563 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Lattice reductions accumulated in REAL64 whatever the storage
+ */
+
+#ifndef QDP_MIXED_BLAS_H
+#define QDP_MIXED_BLAS_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! One-pass BLAS reading fields of any precision and summing in REAL64
+  /*!
+   * These read the words of a single precision field directly and sum in
+   * REAL64, so a mixed precision solver can take the norm of a REAL32
+   * residual without converting it to a REAL64 temporary first. The fused
+   * forms update y and return its norm in the same sweep:
+   *
+   *   LatticeFermionF r, p;
+   *   Double rr = axpyNorm2(r, -alpha, p, rb[0]);   // r += -alpha*p; |r|^2
+   *   DComplex rp = mixedInnerProduct(r, p, rb[0]);
+   *
+   * caxpyNorm2 is the same with a complex a. The solver steps are fused
+   * the same way, each field read once:
+   *
+   *   rr = cgUpdate(x, r, alpha, p, mp, rb[0]);     // r -= alpha*mp; x += alpha*p
+   *   rho = bicgstabUpdate(x, r, alpha, p, omega, s, t, r0, rr, rb[0]);
+   *
+   * with axpyInnerProduct for y += a*x; <w,y> and xpayNorm2 for the
+   * updates of a set of vectors. Partial sums are kept per thread and
+   * combined in thread order, so the result does not depend on
+   * scheduling. The complex forms need fields built from RComplex words.
+   */
+  namespace MixedKernels
+  {
+    //! user argument for the mixed kernels
+    template<class T>
+    struct Args
+    {
+      Args(const int* tab_, const T* x_, T* y_, REAL64 ar_, REAL64 ai_, REAL64* part_, int nsum_) :
+	tab(tab_), runs(0), nruns(0), x(x_), y(y_), ar(ar_), ai(ai_), part(part_), nsum(nsum_),
+	p(0), q(0), v(0), u(0), br(0), bi(0) {}
+
+      const int* tab;     //!< site table, null to go by runs
+      const SiteRun* runs;
+      int nruns;
+      const T* x;
+      T* y;
+      REAL64 ar;
+      REAL64 ai;
+      REAL64* part;
+      int nsum;
+
+      // The further fields and coefficient of the fused solver updates
+      const T* p;
+      const T* q;
+      const T* v;
+      T* u;
+      REAL64 br;
+      REAL64 bi;
+
+      // The vectors and coefficients of the multi-vector forms
+      std::vector<const T*> xs;
+      std::vector<T*> ys;
+      std::vector<REAL64> coef;
+    };
+
+    //! Words in a site
+    template<class T>
+    inline int words() {return sizeof(T)/sizeof(typename WordType<T>::Type_t);}
+
+    //! Call f(site, n) on runs of n consecutive sites covering positions [lo,hi)
+    /*! The word loops of f then sweep each run of the subset in one go */
+    template<class T, class F>
+    inline void forRuns(int lo, int hi, const Args<T>* a, const F& f)
+      {
+	if (! a->tab)
+	{
+	  forSiteRuns(a->runs, a->nruns, lo, hi, f);
+	  return;
+	}
+	for(int j=lo; j < hi; ++j)
+	  f(a->tab[j], 1);
+      }
+
+    //! Partial |x|^2 of thread myId
+    template<class T>
+    void norm2Kernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int nw = words<T>();
+	REAL64 s = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* xp = (const W*)&a->x[i];
+	    for(int w=0; w < n*nw; ++w)
+	      s += REAL64(xp[w])*REAL64(xp[w]);
+	  });
+	a->part[myId] = s;
+      }
+
+    //! Partial <x,y> of thread myId
+    template<class T>
+    void innerProductKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int np = words<T>()/2;
+	REAL64 sr = 0, si = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* xp = (const W*)&a->x[i];
+	    const W* yp = (const W*)&a->y[i];
+	    for(int p=0; p < n*np; ++p)
+	    {
+	      const REAL64 xr = xp[2*p], xi = xp[2*p+1];
+	      const REAL64 yr = yp[2*p], yi = yp[2*p+1];
+	      sr += xr*yr + xi*yi;
+	      si += xr*yi - xi*yr;
+	    }
+	  });
+	a->part[2*myId]   = sr;
+	a->part[2*myId+1] = si;
+      }
+
+    //! Partial Re<x,y> of thread myId
+    template<class T>
+    void innerProductRealKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int nw = words<T>();
+	REAL64 s = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* xp = (const W*)&a->x[i];
+	    const W* yp = (const W*)&a->y[i];
+	    for(int w=0; w < n*nw; ++w)
+	      s += REAL64(xp[w])*REAL64(yp[w]);
+	  });
+	a->part[myId] = s;
+      }
+
+    //! y = a*x + y with real a, and the partial |y|^2 of thread myId
+    template<class T>
+    void axpyNorm2Kernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int nw = words<T>();
+	const REAL64 ar = a->ar;
+	REAL64 s = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* xp = (const W*)&a->x[i];
+	    W* yp = (W*)&a->y[i];
+	    for(int w=0; w < n*nw; ++w)
+	    {
+	      const W z = W(ar*REAL64(xp[w]) + REAL64(yp[w]));
+	      yp[w] = z;
+	      s += REAL64(z)*REAL64(z);
+	    }
+	  });
+	a->part[myId] = s;
+      }
+
+    //! y = a*x + y with complex a, and the partial |y|^2 of thread myId
+    template<class T>
+    void caxpyNorm2Kernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int np = words<T>()/2;
+	const REAL64 ar = a->ar, ai = a->ai;
+	REAL64 s = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* xp = (const W*)&a->x[i];
+	    W* yp = (W*)&a->y[i];
+	    for(int p=0; p < n*np; ++p)
+	    {
+	      const REAL64 xr = xp[2*p], xi = xp[2*p+1];
+	      const W zr = W(ar*xr - ai*xi + REAL64(yp[2*p]));
+	      const W zi = W(ar*xi + ai*xr + REAL64(yp[2*p+1]));
+	      yp[2*p]   = zr;
+	      yp[2*p+1] = zi;
+	      s += REAL64(zr)*REAL64(zr) + REAL64(zi)*REAL64(zi);
+	    }
+	  });
+	a->part[myId] = s;
+      }
+
+    //! y = a*x + y with complex a, and the partial <p,y> of thread myId
+    template<class T>
+    void caxpyInnerProductKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int np = words<T>()/2;
+	const REAL64 ar = a->ar, ai = a->ai;
+	REAL64 sr = 0, si = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* xp = (const W*)&a->x[i];
+	    const W* pp = (const W*)&a->p[i];
+	    W* yp = (W*)&a->y[i];
+	    for(int k=0; k < n*np; ++k)
+	    {
+	      const REAL64 xr = xp[2*k], xi = xp[2*k+1];
+	      const W zr = W(ar*xr - ai*xi + REAL64(yp[2*k]));
+	      const W zi = W(ar*xi + ai*xr + REAL64(yp[2*k+1]));
+	      yp[2*k]   = zr;
+	      yp[2*k+1] = zi;
+	      const REAL64 wr = pp[2*k], wi = pp[2*k+1];
+	      sr += wr*REAL64(zr) + wi*REAL64(zi);
+	      si += wr*REAL64(zi) - wi*REAL64(zr);
+	    }
+	  });
+	a->part[2*myId]   = sr;
+	a->part[2*myId+1] = si;
+      }
+
+    //! The CG step y = y - a*q, u = u + a*p with real a, and the partial |y|^2 of thread myId
+    template<class T>
+    void cgUpdateKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int nw = words<T>();
+	const REAL64 ar = a->ar;
+	REAL64 s = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* pp = (const W*)&a->p[i];
+	    const W* qp = (const W*)&a->q[i];
+	    W* yp = (W*)&a->y[i];
+	    W* up = (W*)&a->u[i];
+	    for(int w=0; w < n*nw; ++w)
+	    {
+	      const W z = W(REAL64(yp[w]) - ar*REAL64(qp[w]));
+	      yp[w] = z;
+	      up[w] = W(REAL64(up[w]) + ar*REAL64(pp[w]));
+	      s += REAL64(z)*REAL64(z);
+	    }
+	  });
+	a->part[myId] = s;
+      }
+
+    //! The BiCGStab step u += alpha p + omega x, y = x - omega q
+    /*!
+     * alpha is (ar,ai) and omega (br,bi). The partials of thread myId
+     * are |y|^2 and <v,y>. y may be x.
+     */
+    template<class T>
+    void bicgstabUpdateKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int np = words<T>()/2;
+	const REAL64 ar = a->ar, ai = a->ai, br = a->br, bi = a->bi;
+	REAL64 nn = 0, sr = 0, si = 0;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* pp = (const W*)&a->p[i];
+	    const W* xp = (const W*)&a->x[i];
+	    const W* qp = (const W*)&a->q[i];
+	    const W* vp = (const W*)&a->v[i];
+	    W* up = (W*)&a->u[i];
+	    W* yp = (W*)&a->y[i];
+	    for(int k=0; k < n*np; ++k)
+	    {
+	      const REAL64 pr = pp[2*k], pi = pp[2*k+1];
+	      const REAL64 xr = xp[2*k], xi = xp[2*k+1];
+	      const REAL64 qr = qp[2*k], qi = qp[2*k+1];
+
+	      up[2*k]   = W(REAL64(up[2*k])   + ar*pr - ai*pi + br*xr - bi*xi);
+	      up[2*k+1] = W(REAL64(up[2*k+1]) + ar*pi + ai*pr + br*xi + bi*xr);
+
+	      const W zr = W(xr - (br*qr - bi*qi));
+	      const W zi = W(xi - (br*qi + bi*qr));
+	      yp[2*k]   = zr;
+	      yp[2*k+1] = zi;
+
+	      const REAL64 wr = vp[2*k], wi = vp[2*k+1];
+	      nn += REAL64(zr)*REAL64(zr) + REAL64(zi)*REAL64(zi);
+	      sr += wr*REAL64(zr) + wi*REAL64(zi);
+	      si += wr*REAL64(zi) - wi*REAL64(zr);
+	    }
+	  });
+	a->part[3*myId]   = nn;
+	a->part[3*myId+1] = sr;
+	a->part[3*myId+2] = si;
+      }
+
+    //! ys[k] = xs[k] + coef[k]*ys[k] for all k, and the partial |ys[k]|^2 of thread myId
+    template<class T>
+    void xpayNorm2Kernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int nw = words<T>();
+	REAL64* part = a->part + myId*a->nsum;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    for(int v=0; v < a->nsum; ++v)
+	    {
+	      const REAL64 b = a->coef[v];
+	      const W* xp = (const W*)&a->xs[v][i];
+	      W* yp = (W*)&a->ys[v][i];
+	      REAL64 s = 0;
+	      for(int w=0; w < n*nw; ++w)
+	      {
+		const W z = W(REAL64(xp[w]) + b*REAL64(yp[w]));
+		yp[w] = z;
+		s += REAL64(z)*REAL64(z);
+	      }
+	      part[v] += s;
+	    }
+	  });
+      }
+
+    //! Run kernel over s and return the nsum globally summed results
+    template<class T>
+    void reduce(Args<T>& a, const Subset& s, void (*kernel)(int, int, int, Args<T>*), REAL64* res)
+      {
+	std::vector<REAL64> part(qdpNumThreads()*a.nsum, 0);
+	a.part = &part[0];
+	if (s.hasRuns())
+	{
+	  a.runs = s.runTable().slice();
+	  a.nruns = s.numRuns();
+	}
+	else
+	  a.tab = s.siteTable().slice();
+	dispatch_to_threads(s.numSiteTable(), a, kernel);
+
+	for(int k=0; k < a.nsum; ++k)
+	  res[k] = 0;
+	for(int t=0; t < qdpNumThreads(); ++t)
+	  for(int k=0; k < a.nsum; ++k)
+	    res[k] += part[t*a.nsum + k];
+
+	QDPInternal::globalSumArray(res, a.nsum);
+      }
+  }
+
+
+  //! |x|^2 on s summed in REAL64
+  template<class T>
+  Double mixedNorm2(const OLattice<T>& x, const Subset& s)
+  {
+    MixedKernels::Args<T> a(0, x.getF(), 0, 0, 0, 0, 1);
+    REAL64 r;
+    MixedKernels::reduce(a, s, MixedKernels::norm2Kernel<T>, &r);
+    return Double(r);
+  }
+
+  //! |x|^2 summed in REAL64
+  template<class T>
+  Double mixedNorm2(const OLattice<T>& x)
+  {
+    return mixedNorm2(x, all);
+  }
+
+  //! <x,y> on s summed in REAL64
+  template<class T>
+  DComplex mixedInnerProduct(const OLattice<T>& x, const OLattice<T>& y, const Subset& s)
+  {
+    MixedKernels::Args<T> a(0, x.getF(), const_cast<T*>(y.getF()), 0, 0, 0, 2);
+    REAL64 r[2];
+    MixedKernels::reduce(a, s, MixedKernels::innerProductKernel<T>, r);
+    return cmplx(Double(r[0]), Double(r[1]));
+  }
+
+  //! <x,y> summed in REAL64
+  template<class T>
+  DComplex mixedInnerProduct(const OLattice<T>& x, const OLattice<T>& y)
+  {
+    return mixedInnerProduct(x, y, all);
+  }
+
+  //! Re <x,y> on s summed in REAL64
+  template<class T>
+  Double mixedInnerProductReal(const OLattice<T>& x, const OLattice<T>& y, const Subset& s)
+  {
+    MixedKernels::Args<T> a(0, x.getF(), const_cast<T*>(y.getF()), 0, 0, 0, 1);
+    REAL64 r;
+    MixedKernels::reduce(a, s, MixedKernels::innerProductRealKernel<T>, &r);
+    return Double(r);
+  }
+
+  //! Re <x,y> summed in REAL64
+  template<class T>
+  Double mixedInnerProductReal(const OLattice<T>& x, const OLattice<T>& y)
+  {
+    return mixedInnerProductReal(x, y, all);
+  }
+
+  //! y = a*x + y on s, returning |y|^2 on s from the same sweep
+  /*! The update is done in REAL64 and rounded once to the storage of y */
+  template<class T, class S>
+  Double axpyNorm2(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x, const Subset& s)
+  {
+    MixedKernels::Args<T> args(0, x.getF(), y.getF(), toDouble(a), 0, 0, 1);
+    REAL64 r;
+    MixedKernels::reduce(args, s, MixedKernels::axpyNorm2Kernel<T>, &r);
+    return Double(r);
+  }
+
+  //! y = a*x + y, returning |y|^2 from the same sweep
+  template<class T, class S>
+  Double axpyNorm2(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x)
+  {
+    return axpyNorm2(y, a, x, all);
+  }
+
+  //! y = a*x + y on s with complex a, returning |y|^2 on s from the same sweep
+  template<class T, class S>
+  Double caxpyNorm2(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x, const Subset& s)
+  {
+    MixedKernels::Args<T> args(0, x.getF(), y.getF(),
+			       toDouble(real(a)), toDouble(imag(a)), 0, 1);
+    REAL64 r;
+    MixedKernels::reduce(args, s, MixedKernels::caxpyNorm2Kernel<T>, &r);
+    return Double(r);
+  }
+
+  //! y = a*x + y with complex a, returning |y|^2 from the same sweep
+  template<class T, class S>
+  Double caxpyNorm2(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x)
+  {
+    return caxpyNorm2(y, a, x, all);
+  }
+
+  //! y = a*x + y on s, returning <w,y> on s from the same sweep
+  template<class T, class S>
+  DComplex axpyInnerProduct(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x,
+			    const OLattice<T>& w, const Subset& s)
+  {
+    MixedKernels::Args<T> args(0, x.getF(), writable(y).getF(), toDouble(a), 0, 0, 2);
+    args.p = w.getF();
+    REAL64 r[2];
+    MixedKernels::reduce(args, s, MixedKernels::caxpyInnerProductKernel<T>, r);
+    return cmplx(Double(r[0]), Double(r[1]));
+  }
+
+  //! y = a*x + y, returning <w,y> from the same sweep
+  template<class T, class S>
+  DComplex axpyInnerProduct(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x, const OLattice<T>& w)
+  {
+    return axpyInnerProduct(y, a, x, w, all);
+  }
+
+  //! y = a*x + y on s with complex a, returning <w,y> on s from the same sweep
+  template<class T, class S>
+  DComplex caxpyInnerProduct(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x,
+			     const OLattice<T>& w, const Subset& s)
+  {
+    MixedKernels::Args<T> args(0, x.getF(), writable(y).getF(),
+			       toDouble(real(a)), toDouble(imag(a)), 0, 2);
+    args.p = w.getF();
+    REAL64 r[2];
+    MixedKernels::reduce(args, s, MixedKernels::caxpyInnerProductKernel<T>, r);
+    return cmplx(Double(r[0]), Double(r[1]));
+  }
+
+  //! y = a*x + y with complex a, returning <w,y> from the same sweep
+  template<class T, class S>
+  DComplex caxpyInnerProduct(OLattice<T>& y, const OScalar<S>& a, const OLattice<T>& x, const OLattice<T>& w)
+  {
+    return caxpyInnerProduct(y, a, x, w, all);
+  }
+
+  //! The CG step r -= a*q; x += a*p on s, returning |r|^2 on s from the same sweep
+  /*! q is the operator applied to p. Each of the four fields is read once */
+  template<class T, class S>
+  Double cgUpdate(OLattice<T>& x, OLattice<T>& r, const OScalar<S>& a,
+		  const OLattice<T>& p, const OLattice<T>& q, const Subset& s)
+  {
+    MixedKernels::Args<T> args(0, 0, writable(r).getF(), toDouble(a), 0, 0, 1);
+    args.u = writable(x).getF();
+    args.p = p.getF();
+    args.q = q.getF();
+    REAL64 rr;
+    MixedKernels::reduce(args, s, MixedKernels::cgUpdateKernel<T>, &rr);
+    return Double(rr);
+  }
+
+  //! The CG step r -= a*q; x += a*p, returning |r|^2 from the same sweep
+  template<class T, class S>
+  Double cgUpdate(OLattice<T>& x, OLattice<T>& r, const OScalar<S>& a,
+		  const OLattice<T>& p, const OLattice<T>& q)
+  {
+    return cgUpdate(x, r, a, p, q, all);
+  }
+
+  //! The BiCGStab step x += alpha*p + omega*sv; r = sv - omega*t on s
+  /*!
+   * Returns <r0,r> on s, the rho of the next iteration, and sets rr to
+   * |r|^2 on s, all from the same sweep and one global sum. r may be sv.
+   */
+  template<class T, class S>
+  DComplex bicgstabUpdate(OLattice<T>& x, OLattice<T>& r,
+			  const OScalar<S>& alpha, const OLattice<T>& p,
+			  const OScalar<S>& omega, const OLattice<T>& sv, const OLattice<T>& t,
+			  const OLattice<T>& r0, Double& rr, const Subset& s)
+  {
+    MixedKernels::Args<T> args(0, sv.getF(), writable(r).getF(),
+			       toDouble(real(alpha)), toDouble(imag(alpha)), 0, 3);
+    args.br = toDouble(real(omega));
+    args.bi = toDouble(imag(omega));
+    args.u = writable(x).getF();
+    args.p = p.getF();
+    args.q = t.getF();
+    args.v = r0.getF();
+    REAL64 res[3];
+    MixedKernels::reduce(args, s, MixedKernels::bicgstabUpdateKernel<T>, res);
+    rr = res[0];
+    return cmplx(Double(res[1]), Double(res[2]));
+  }
+
+  //! The BiCGStab step on all sites
+  template<class T, class S>
+  DComplex bicgstabUpdate(OLattice<T>& x, OLattice<T>& r,
+			  const OScalar<S>& alpha, const OLattice<T>& p,
+			  const OScalar<S>& omega, const OLattice<T>& sv, const OLattice<T>& t,
+			  const OLattice<T>& r0, Double& rr)
+  {
+    return bicgstabUpdate(x, r, alpha, p, omega, sv, t, r0, rr, all);
+  }
+
+  //! y[k] = x[k] + b[k]*y[k] on s for every k, returning each |y[k]|^2 on s
+  /*! All vectors go in one threaded sweep and the norms share one global sum */
+  template<class T, class S>
+  multi1d<Double> xpayNorm2(multi1d< OLattice<T> >& y, const multi1d< OScalar<S> >& b,
+			    const multi1d< OLattice<T> >& x, const Subset& s)
+  {
+    const int n = y.size();
+    if (x.size() != n || b.size() != n)
+      QDP_error_exit("xpayNorm2: %d vectors, %d vectors and %d coefficients", n, x.size(), b.size());
+
+    MixedKernels::Args<T> args(0, 0, 0, 0, 0, 0, n);
+    for(int k=0; k < n; ++k)
+    {
+      args.xs.push_back(x[k].getF());
+      args.ys.push_back(writable(y[k]).getF());
+      args.coef.push_back(toDouble(b[k]));
+    }
+
+    multi1d<Double> d(n);
+    if (n == 0)
+      return d;
+
+    std::vector<REAL64> res(n);
+    MixedKernels::reduce(args, s, MixedKernels::xpayNorm2Kernel<T>, &res[0]);
+    for(int k=0; k < n; ++k)
+      d[k] = res[k];
+    return d;
+  }
+
+  //! y[k] = x[k] + b[k]*y[k] for every k, returning each |y[k]|^2
+  template<class T, class S>
+  multi1d<Double> xpayNorm2(multi1d< OLattice<T> >& y, const multi1d< OScalar<S> >& b,
+			    const multi1d< OLattice<T> >& x)
+  {
+    return xpayNorm2(y, b, x, all);
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
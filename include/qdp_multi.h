@@ -10,6 +10,8 @@
 #define MULTI_INCLUDE
 
 #include "qdp_config.h"
+#include <utility>
+
 namespace QDP {
 
 /*! @defgroup multi  Multi-dimensional arrays
@@ -51,6 +53,25 @@ public:
 	F[i] = s.F[i];
     }
 
+  //! Move constructor
+  /*! Takes over the storage of s. A view on other memory is copied as before */
+  multi1d(multi1d&& s): copymem(false), n1(s.n1), F(0)
+    {
+      if (s.copymem)
+      {
+	resize(n1);
+
+	for(int i=0; i < n1; ++i)
+	  F[i] = s.F[i];
+      }
+      else
+      {
+	F = s.F;
+	s.F = 0;
+	s.n1 = 0;
+      }
+    }
+
   //! Resize routine, call a templated resize, using *this to disambiguate
   // template type
   void resize(int ns1) { resize(*this, ns1); }
@@ -72,6 +93,18 @@ public:
       return *this;
     }
 
+  //! Move assignment
+  /*! Swaps the storage when both sides own theirs, otherwise copies elements */
+  multi1d& operator=(multi1d&& s1)
+    {
+      if (copymem || s1.copymem)
+	return *this = static_cast<const multi1d&>(s1);
+
+      std::swap(n1, s1.n1);
+      std::swap(F, s1.F);
+      return *this;
+    }
+
   //! Equal operator uses underlying = of T
   template<class T1>
   multi1d<T>& operator=(const T1& s1)
@@ -277,6 +310,20 @@ private:
   template<typename I>
   inline void revertFromFastMemoryHint(multi1d<I>& disambiguator, bool copy=false) {}
 
+  //! Lattice fields move one by one
+  template<typename I>
+  inline void moveToFastMemoryHint(multi1d< OLattice<I> >& disambiguator, bool copy=false) {
+    for(int i=0; i < n1; ++i)
+      F[i].moveToFastMemoryHint(copy);
+  }
+
+  //! Lattice fields move one by one
+  template<typename I>
+  inline void revertFromFastMemoryHint(multi1d< OLattice<I> >& disambiguator, bool copy=false) {
+    for(int i=0; i < n1; ++i)
+      F[i].revertFromFastMemoryHint(copy);
+  }
+
   bool copymem;
   int n1;
   T *F;
@@ -653,6 +700,27 @@ public:
 	F[i] = s.F[i];
     }
 
+  //! Move constructor
+  /*! Takes over the storage of s. A view on other memory is copied as before */
+  multi2d(multi2d&& s): copymem(false), n1(s.n1), n2(s.n2), sz(s.sz), F(0)
+    {
+      if (s.copymem)
+      {
+	resize(n2,n1);
+
+	for(int i=0; i < sz; ++i)
+	  F[i] = s.F[i];
+      }
+      else
+      {
+	F = s.F;
+	s.F = 0;
+	s.n1 = 0;
+	s.n2 = 0;
+	s.sz = 0;
+      }
+    }
+
   //! Allocate mem for the array
   void resize(int ns2, int ns1) {
     if(copymem) {
@@ -687,6 +755,20 @@ public:
       return *this;
     }
 
+  //! Move assignment
+  /*! Swaps the storage when both sides own theirs, otherwise copies elements */
+  multi2d<T>& operator=(multi2d<T>&& s1)
+    {
+      if (copymem || s1.copymem)
+	return *this = static_cast<const multi2d<T>&>(s1);
+
+      std::swap(n1, s1.n1);
+      std::swap(n2, s1.n2);
+      std::swap(sz, s1.sz);
+      std::swap(F, s1.F);
+      return *this;
+    }
+
   //! Equal operator uses underlying = of T
   template<class T1>
   multi2d<T>& operator=(const T1& s1)
@@ -746,6 +828,28 @@ public:
 	F[i] = s.F[i];
     }
 
+  //! Move constructor
+  /*! Takes over the storage of s. A view on other memory is copied as before */
+  multi3d(multi3d&& s): copymem(false), n1(s.n1), n2(s.n2), n3(s.n3), sz(s.sz), F(0)
+    {
+      if (s.copymem)
+      {
+	resize(n3,n2,n1);
+
+	for(int i=0; i < sz; ++i)
+	  F[i] = s.F[i];
+      }
+      else
+      {
+	F = s.F;
+	s.F = 0;
+	s.n1 = 0;
+	s.n2 = 0;
+	s.n3 = 0;
+	s.sz = 0;
+      }
+    }
+
   //! Allocate mem for the array 
   void resize(int ns3, int ns2, int ns1) 
   {
@@ -786,6 +890,21 @@ public:
       return *this;
     }
 
+  //! Move assignment
+  /*! Swaps the storage when both sides own theirs, otherwise copies elements */
+  multi3d<T>& operator=(multi3d<T>&& s1)
+    {
+      if (copymem || s1.copymem)
+	return *this = static_cast<const multi3d<T>&>(s1);
+
+      std::swap(n1, s1.n1);
+      std::swap(n2, s1.n2);
+      std::swap(n3, s1.n3);
+      std::swap(sz, s1.sz);
+      std::swap(F, s1.F);
+      return *this;
+    }
+
   //! Equal operator uses underlying = of T
   template<class T1>
   multi3d<T>& operator=(const T1& s1)
@@ -845,6 +964,29 @@ public:
 	F[i] = s.F[i];
     }
 
+  //! Move constructor
+  /*! Takes over the storage of s. A view on other memory is copied as before */
+  multi4d(multi4d&& s): copymem(false), n1(s.n1), n2(s.n2), n3(s.n3), n4(s.n4), sz(s.sz), F(0)
+    {
+      if (s.copymem)
+      {
+	resize(n4,n3,n2,n1);
+
+	for(int i=0; i < sz; ++i)
+	  F[i] = s.F[i];
+      }
+      else
+      {
+	F = s.F;
+	s.F = 0;
+	s.n1 = 0;
+	s.n2 = 0;
+	s.n3 = 0;
+	s.n4 = 0;
+	s.sz = 0;
+      }
+    }
+
   //! Allocate mem for the array 
   void resize(int ns4, int ns3, int ns2, int ns1) 
   {
@@ -881,6 +1023,22 @@ public:
       return *this;
     }
 
+  //! Move assignment
+  /*! Swaps the storage when both sides own theirs, otherwise copies elements */
+  multi4d<T>& operator=(multi4d<T>&& s1)
+    {
+      if (copymem || s1.copymem)
+	return *this = static_cast<const multi4d<T>&>(s1);
+
+      std::swap(n1, s1.n1);
+      std::swap(n2, s1.n2);
+      std::swap(n3, s1.n3);
+      std::swap(n4, s1.n4);
+      std::swap(sz, s1.sz);
+      std::swap(F, s1.F);
+      return *this;
+    }
+
   //! Equal operator uses underlying = of T
   template<class T1>
   multi4d<T>& operator=(const T1& s1)
@@ -941,6 +1099,30 @@ public:
 	F[i] = s.F[i];
     }
 
+  //! Move constructor
+  /*! Takes over the storage of s. A view on other memory is copied as before */
+  multi5d(multi5d&& s): copymem(false), n1(s.n1), n2(s.n2), n3(s.n3), n4(s.n4), n5(s.n5), sz(s.sz), F(0)
+    {
+      if (s.copymem)
+      {
+	resize(n5,n4,n3,n2,n1);
+
+	for(int i=0; i < sz; ++i)
+	  F[i] = s.F[i];
+      }
+      else
+      {
+	F = s.F;
+	s.F = 0;
+	s.n1 = 0;
+	s.n2 = 0;
+	s.n3 = 0;
+	s.n4 = 0;
+	s.n5 = 0;
+	s.sz = 0;
+      }
+    }
+
   //! Allocate mem for the array 
   void resize(int ns5, int ns4, int ns3, int ns2, int ns1) 
   {
@@ -978,6 +1160,23 @@ public:
       return *this;
     }
 
+  //! Move assignment
+  /*! Swaps the storage when both sides own theirs, otherwise copies elements */
+  multi5d<T>& operator=(multi5d<T>&& s1)
+    {
+      if (copymem || s1.copymem)
+	return *this = static_cast<const multi5d<T>&>(s1);
+
+      std::swap(n1, s1.n1);
+      std::swap(n2, s1.n2);
+      std::swap(n3, s1.n3);
+      std::swap(n4, s1.n4);
+      std::swap(n5, s1.n5);
+      std::swap(sz, s1.sz);
+      std::swap(F, s1.F);
+      return *this;
+    }
+
   //! Equal operator uses underlying = of T
   template<class T1>
   multi5d<T>& operator=(const T1& s1)
@@ -0,0 +1,245 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Several global reductions in one pass and one global sum
+ */
+
+#ifndef QDP_MULTIREDUCTION_H
+#define QDP_MULTIREDUCTION_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! Several sums over the same subset with a single global reduction
+  /*!
+   * Krylov solvers need a few norms and inner products per iteration.
+   * Each of them on its own is a sweep over the lattice and an allreduce.
+   * Queue them here instead: evaluate() makes one threaded sweep over the
+   * subset and one globalSumArray on the packed results.
+   *
+   *   Double rr, apap;
+   *   DComplex pap;
+   *   MultiReduction red(rb[cb]);
+   *   red.norm2(rr, r);
+   *   red.innerProduct(pap, p, ap);
+   *   red.norm2(apap, ap);
+   *   red.evaluate();
+   *
+   * The fields in a queued expression and the result objects must live
+   * until evaluate() returns. The queue is emptied by evaluate(). Each
+   * result is reproducible for a given number of threads.
+   */
+  class MultiReduction
+  {
+  public:
+    //! Reductions over the subset s
+    explicit MultiReduction(const Subset& s_) : s(s_) {}
+
+    ~MultiReduction() {clear();}
+
+    //! Queue dest = sum(expr)
+    template<class D, class RHS, class T>
+    void sum(D& dest, const QDPExpr<RHS,OLattice<T> >& expr)
+      {
+	terms.push_back(new SumTerm<D,RHS,T>(dest, expr));
+      }
+
+    //! Queue dest = sum(expr) for a plain lattice field
+    template<class D, class T>
+    void sum(D& dest, const OLattice<T>& l)
+      {
+	sum(dest, PETE_identity(l));
+      }
+
+    //! Queue dest = norm2(x)
+    template<class D, class X>
+    void norm2(D& dest, const X& x)
+      {
+	sum(dest, localNorm2(x));
+      }
+
+    //! Queue dest = innerProduct(x,y)
+    template<class D, class X, class Y>
+    void innerProduct(D& dest, const X& x, const Y& y)
+      {
+	sum(dest, localInnerProduct(x,y));
+      }
+
+    //! Queue dest = innerProductReal(x,y)
+    template<class D, class X, class Y>
+    void innerProductReal(D& dest, const X& x, const Y& y)
+      {
+	sum(dest, localInnerProductReal(x,y));
+      }
+
+    //! Number of queued reductions
+    int size() const {return terms.size();}
+
+    //! Sweep the subset once, do one global sum and fill all results
+    void evaluate();
+
+  private:
+    //! One queued reduction
+    struct Term
+    {
+      virtual ~Term() {}
+
+      //! Number of REAL64 words the result packs into
+      virtual int words() const = 0;
+
+      //! Zero the per-thread partials
+      virtual void start(int num_threads) = 0;
+
+      //! Add sites tab[lo..hi) into the partial of thread myId
+      virtual void accumulate(const int *tab, int lo, int hi, int myId) = 0;
+
+      //! Combine the partials in thread order into buf
+      virtual void pack(REAL64 *buf) const = 0;
+
+      //! Store the globally summed buf into the result
+      virtual void unpack(const REAL64 *buf) = 0;
+    };
+
+    template<class D, class RHS, class T>
+    struct SumTerm : public Term
+    {
+      typedef typename UnaryReturn<OLattice<T>, FnSum>::Type_t Sum_t;
+      typedef typename WordType<Sum_t>::Type_t W;
+
+      SumTerm(D& dest_, const QDPExpr<RHS,OLattice<T> >& expr_) : dest(dest_), expr(expr_)
+	{
+	  startShifts(expr);
+	}
+
+      int words() const {return sizeof(Sum_t)/sizeof(W);}
+
+      void start(int num_threads)
+	{
+	  partial.resize(num_threads);
+	  for(int thread=0; thread < partial.size(); ++thread)
+	    zero_rep(partial[thread]);
+	}
+
+      void accumulate(const int *tab, int lo, int hi, int myId)
+	{
+	  Sum_t d;
+	  zero_rep(d);
+
+	  for(int j=lo; j < hi; ++j)
+	  {
+	    int i = tab[j];
+	    d.elem() += forEach(expr, EvalLeaf1(i), OpCombine());
+	  }
+
+	  partial[myId].elem() += d.elem();
+	}
+
+      void pack(REAL64 *buf) const
+	{
+	  Sum_t d;
+	  zero_rep(d);
+	  for(int thread=0; thread < partial.size(); ++thread)
+	    d.elem() += partial[thread].elem();
+
+	  const W *w = (const W *)&d;
+	  for(int k=0; k < words(); ++k)
+	    buf[k] = w[k];
+	}
+
+      void unpack(const REAL64 *buf)
+	{
+	  Sum_t d;
+	  W *w = (W *)&d;
+	  for(int k=0; k < words(); ++k)
+	    w[k] = W(buf[k]);
+
+	  dest = d;
+	}
+
+      D& dest;
+      QDPExpr<RHS,OLattice<T> > expr;
+      multi1d<Sum_t> partial;
+    };
+
+    //! user argument for the sweep
+    struct ThreadArgs
+    {
+      ThreadArgs(std::vector<Term*>& terms_, const int *tab_) : terms(terms_), tab(tab_) {}
+
+      std::vector<Term*>& terms;
+      const int *tab;
+    };
+
+    //! user function for the sweep
+    /*! Walks the range in blocks so every term sees a block while it is in cache */
+    static void kernel(int lo, int hi, int myId, ThreadArgs *a)
+      {
+	const int block = 64;
+	std::vector<Term*>& terms = a->terms;
+
+	for(int jlo=lo; jlo < hi; jlo += block)
+	{
+	  int jhi = (jlo + block < hi) ? jlo + block : hi;
+	  for(int t=0; t < terms.size(); ++t)
+	    terms[t]->accumulate(a->tab, jlo, jhi, myId);
+	}
+      }
+
+    //! Drop the queued reductions
+    void clear()
+      {
+	for(int t=0; t < terms.size(); ++t)
+	  delete terms[t];
+	terms.clear();
+      }
+
+    //! Hide copies - terms are owned
+    MultiReduction(const MultiReduction&);
+    void operator=(const MultiReduction&);
+
+    const Subset& s;
+    std::vector<Term*> terms;
+  };
+
+
+  inline void MultiReduction::evaluate()
+  {
+    const int num_threads = qdpNumThreads();
+
+    int nwords = 0;
+    for(int t=0; t < terms.size(); ++t)
+    {
+      terms[t]->start(num_threads);
+      nwords += terms[t]->words();
+    }
+
+    ThreadArgs args(terms, s.siteTable().slice());
+    dispatch_to_threads(s.numSiteTable(), args, kernel);
+
+    // Pack everything for a single global sum
+    if (nwords > 0)
+    {
+      std::vector<REAL64> buf(nwords);
+      for(int t=0, off=0; t < terms.size(); off += terms[t]->words(), ++t)
+	terms[t]->pack(&buf[off]);
+
+      QDPInternal::globalSumArray(&buf[0], nwords);
+
+      for(int t=0, off=0; t < terms.size(); off += terms[t]->words(), ++t)
+	terms[t]->unpack(&buf[off]);
+    }
+
+    clear();
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
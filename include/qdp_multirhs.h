@@ -0,0 +1,467 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Several lattice vectors interleaved site by site
+ */
+
+#ifndef QDP_MULTIRHS_H
+#define QDP_MULTIRHS_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! n lattice fields of the same type stored site by site
+  /*!
+   * Element k of site i lives at getF()[i*n + k], so a sweep over the
+   * lattice touches all n vectors of a site together. The kernels below
+   * do one sweep for all n vectors: the link of a site is read once for
+   * all of them and the reductions return n results from one global sum.
+   * This is the layout for multi-source solvers and deflation.
+   *
+   *   LatticeFermionBlock x(12), y(12);
+   *   for(int k=0; k < 12; ++k)
+   *     x.insert(k, psi[k]);
+   *   multiply(y, u, x, rb[0]);        // y_k = u * x_k
+   *   shift(y, x, FORWARD, mu);        // y_k = shift(x_k, FORWARD, mu)
+   *   axpy(y, a, x, rb[0]);            // y_k += a_k * x_k
+   *   multi1d<Double> r = norm2(y, rb[0]);
+   *
+   * T must be built from RComplex words, like the fermions.
+   */
+  template<class T>
+  class LatticeBlock
+  {
+  public:
+    typedef T Site_t;
+    typedef typename WordType<T>::Type_t W;
+
+    //! n uninitialized vectors
+    explicit LatticeBlock(int n_) : n(n_) {alloc_mem();}
+
+    ~LatticeBlock() {free_mem();}
+
+    //! Number of vectors
+    int numRHS() const {return n;}
+
+    //! Vector k at site i
+    inline T& elem(int i, int k) {return F[i*n + k];}
+    inline const T& elem(int i, int k) const {return F[i*n + k];}
+
+    //! The interleaved data
+    T* getF() {return F;}
+    const T* getF() const {return F;}
+
+    //! Copy x into vector k
+    void insert(int k, const OLattice<T>& x)
+      {
+	CopyArgs a(this, &const_cast<OLattice<T>&>(x), k, true);
+	dispatch_to_threads(Layout::sitesOnNode(), a, copyKernel);
+      }
+
+    //! Copy vector k into x
+    void extract(int k, OLattice<T>& x) const
+      {
+	CopyArgs a(const_cast<LatticeBlock*>(this), &x, k, false);
+	dispatch_to_threads(Layout::sitesOnNode(), a, copyKernel);
+      }
+
+  private:
+    //! Hide copies
+    LatticeBlock(const LatticeBlock&);
+    void operator=(const LatticeBlock&);
+
+    //! user argument for insert and extract
+    struct CopyArgs
+    {
+      CopyArgs(LatticeBlock* b_, OLattice<T>* x_, int k_, bool in_) : b(b_), x(x_), k(k_), in(in_) {}
+
+      LatticeBlock* b;
+      OLattice<T>* x;
+      int k;
+      bool in;
+    };
+
+    //! user function for insert and extract
+    static void copyKernel(int lo, int hi, int myId, CopyArgs* a)
+      {
+	for(int i=lo; i < hi; ++i)
+	{
+	  if (a->in)
+	    a->b->elem(i, a->k) = a->x->elem(i);
+	  else
+	    a->x->elem(i) = a->b->elem(i, a->k);
+	}
+      }
+
+    void alloc_mem()
+      {
+	if (n <= 0)
+	  QDP_error_exit("LatticeBlock: need at least one vector, have %d", n);
+
+	size_t bytes = size_t(Layout::sitesOnNode())*n*sizeof(T);
+	try
+	{
+	  F = (T*)QDP::Allocator::theQDPAllocator::Instance().allocate(bytes, QDP::Allocator::DEFAULT);
+	}
+	catch(std::bad_alloc) {
+	  QDPIO::cerr << "Allocation failed in LatticeBlock: " << bytes << " bytes" << std::endl;
+	  QDP::Allocator::printAllocStats();
+	  QDP_abort(1);
+	}
+      }
+
+    void free_mem()
+      {
+	QDP::Allocator::theQDPAllocator::Instance().free(F);
+      }
+
+    int n;
+    T* F;
+  };
+
+
+  namespace BlockKernels
+  {
+    //! user argument for the block kernels
+    template<class T, class U>
+    struct Args
+    {
+      Args(const int* tab_, int n_, const U* u_, const T* x_, T* y_,
+	   const REAL64* ar_, const REAL64* ai_, REAL64* part_) :
+	tab(tab_), n(n_), u(u_), x(x_), y(y_), ar(ar_), ai(ai_), part(part_) {}
+
+      const int* tab;
+      int n;
+      const U* u;
+      const T* x;
+      T* y;
+      const REAL64* ar;
+      const REAL64* ai;
+      REAL64* part;
+    };
+
+    //! Number of complex words in a site
+    template<class T>
+    inline int pairs() {return sizeof(T)/(2*sizeof(typename WordType<T>::Type_t));}
+
+    //! y_k = u * x_k; the link is loaded once for all k
+    template<class T, class U>
+    void multiplyKernel(int lo, int hi, int myId, Args<T,U>* a)
+      {
+	const int n = a->n;
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int i = a->tab[j];
+	  const U ui = a->u[i];
+	  for(int k=0; k < n; ++k)
+	    a->y[i*n+k] = ui * a->x[i*n+k];
+	}
+      }
+
+    //! y_k = adj(u) * x_k; the link is loaded once for all k
+    template<class T, class U>
+    void adjMultiplyKernel(int lo, int hi, int myId, Args<T,U>* a)
+      {
+	const int n = a->n;
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int i = a->tab[j];
+	  const U ui = adj(a->u[i]);
+	  for(int k=0; k < n; ++k)
+	    a->y[i*n+k] = ui * a->x[i*n+k];
+	}
+      }
+
+    //! y_k += a_k * x_k with complex a_k
+    template<class T, class U>
+    void axpyKernel(int lo, int hi, int myId, Args<T,U>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int n = a->n;
+	const int np = pairs<T>();
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int i = a->tab[j];
+	  for(int k=0; k < n; ++k)
+	  {
+	    const W ar = a->ar[k], ai = a->ai[k];
+	    const W* xp = (const W*)&a->x[i*n+k];
+	    W* yp = (W*)&a->y[i*n+k];
+	    for(int p=0; p < np; ++p)
+	    {
+	      const W xr = xp[2*p], xi = xp[2*p+1];
+	      yp[2*p]   += ar*xr - ai*xi;
+	      yp[2*p+1] += ar*xi + ai*xr;
+	    }
+	  }
+	}
+      }
+
+    //! Partial |x_k|^2 of thread myId, summed in REAL64
+    template<class T, class U>
+    void norm2Kernel(int lo, int hi, int myId, Args<T,U>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int n = a->n;
+	const int nw = sizeof(T)/sizeof(W);
+	REAL64* part = a->part + myId*n;
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int i = a->tab[j];
+	  for(int k=0; k < n; ++k)
+	  {
+	    const W* xp = (const W*)&a->x[i*n+k];
+	    REAL64 s = 0;
+	    for(int w=0; w < nw; ++w)
+	      s += REAL64(xp[w])*REAL64(xp[w]);
+	    part[k] += s;
+	  }
+	}
+      }
+
+    //! Partial <x_k,y_k> of thread myId, summed in REAL64
+    template<class T, class U>
+    void innerProductKernel(int lo, int hi, int myId, Args<T,U>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int n = a->n;
+	const int np = pairs<T>();
+	REAL64* part = a->part + 2*myId*n;
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int i = a->tab[j];
+	  for(int k=0; k < n; ++k)
+	  {
+	    const W* xp = (const W*)&a->x[i*n+k];
+	    const W* yp = (const W*)&a->y[i*n+k];
+	    REAL64 sr = 0, si = 0;
+	    for(int p=0; p < np; ++p)
+	    {
+	      const REAL64 xr = xp[2*p], xi = xp[2*p+1];
+	      const REAL64 yr = yp[2*p], yi = yp[2*p+1];
+	      sr += xr*yr + xi*yi;
+	      si += xr*yi - xi*yr;
+	    }
+	    part[2*k]   += sr;
+	    part[2*k+1] += si;
+	  }
+	}
+      }
+
+    //! user argument for the fifth dimension hopping
+    template<class T>
+    struct HopSArgs
+    {
+      const int* tab;
+      int ls;
+      REAL64 m;
+      int up[Ns];    //!< spin components taken from s-1, the others from s+1
+      const T* x;
+      T* y;
+    };
+
+    //! y_s = c x_{s-1} or c x_{s+1} by spin component, with c = -m across the ends
+    template<class T>
+    void hopSKernel(int lo, int hi, int myId, HopSArgs<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int ls = a->ls;
+	const int nw = sizeof(T)/(Ns*sizeof(W));
+	const W m = a->m;
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int i = a->tab[j];
+	  const W* x = (const W*)&a->x[i*ls];
+	  W* y = (W*)&a->y[i*ls];
+	  for(int s=0; s < ls; ++s)
+	    for(int sp=0; sp < Ns; ++sp)
+	    {
+	      int t = a->up[sp] ? s-1 : s+1;
+	      W c = 1;
+	      if (t < 0)
+	      {
+		t = ls-1;
+		c = -m;
+	      }
+	      else if (t == ls)
+	      {
+		t = 0;
+		c = -m;
+	      }
+
+	      const W* xp = x + (t*Ns + sp)*nw;
+	      W* yp = y + (s*Ns + sp)*nw;
+	      for(int w=0; w < nw; ++w)
+		yp[w] = c*xp[w];
+	    }
+	}
+      }
+
+    //! Sum the per-thread partials in thread order into res and globally
+    inline void reducePartials(std::vector<REAL64>& part, int len, std::vector<REAL64>& res)
+      {
+	res.assign(len, 0);
+	for(int t=0; t < part.size()/len; ++t)
+	  for(int k=0; k < len; ++k)
+	    res[k] += part[t*len + k];
+
+	QDPInternal::globalSumArray(&res[0], len);
+      }
+
+    template<class T>
+    void checkSizes(const LatticeBlock<T>& y, const LatticeBlock<T>& x, const char* name)
+      {
+	if (y.numRHS() != x.numRHS())
+	  QDP_error_exit("%s: blocks of %d and %d vectors", name, y.numRHS(), x.numRHS());
+      }
+  }
+
+
+  //! y_k = u * x_k on s for every vector k
+  template<class T, class U>
+  void multiply(LatticeBlock<T>& y, const OLattice<U>& u, const LatticeBlock<T>& x, const Subset& s)
+  {
+    BlockKernels::checkSizes(y, x, "multiply");
+    BlockKernels::Args<T,U> a(s.siteTable().slice(), x.numRHS(), u.getF(), x.getF(), y.getF(), 0, 0, 0);
+    dispatch_to_threads(s.numSiteTable(), a, BlockKernels::multiplyKernel<T,U>);
+  }
+
+  //! y_k = adj(u) * x_k on s for every vector k
+  template<class T, class U>
+  void adjMultiply(LatticeBlock<T>& y, const OLattice<U>& u, const LatticeBlock<T>& x, const Subset& s)
+  {
+    BlockKernels::checkSizes(y, x, "adjMultiply");
+    BlockKernels::Args<T,U> a(s.siteTable().slice(), x.numRHS(), u.getF(), x.getF(), y.getF(), 0, 0, 0);
+    dispatch_to_threads(s.numSiteTable(), a, BlockKernels::adjMultiplyKernel<T,U>);
+  }
+
+  //! y_k += a_k * x_k on s for every vector k
+  template<class T>
+  void axpy(LatticeBlock<T>& y, const multi1d<Complex>& a, const LatticeBlock<T>& x, const Subset& s)
+  {
+    BlockKernels::checkSizes(y, x, "axpy");
+    if (a.size() != x.numRHS())
+      QDP_error_exit("axpy: %d coefficients for %d vectors", a.size(), x.numRHS());
+
+    std::vector<REAL64> ar(a.size()), ai(a.size());
+    for(int k=0; k < a.size(); ++k)
+    {
+      ar[k] = toDouble(real(a[k]));
+      ai[k] = toDouble(imag(a[k]));
+    }
+
+    BlockKernels::Args<T,T> args(s.siteTable().slice(), x.numRHS(), 0, x.getF(), y.getF(), &ar[0], &ai[0], 0);
+    dispatch_to_threads(s.numSiteTable(), args, BlockKernels::axpyKernel<T,T>);
+  }
+
+  //! y_k += a_k * x_k on s for every vector k
+  template<class T>
+  void axpy(LatticeBlock<T>& y, const multi1d<Real>& a, const LatticeBlock<T>& x, const Subset& s)
+  {
+    multi1d<Complex> ac(a.size());
+    for(int k=0; k < a.size(); ++k)
+      ac[k] = cmplx(a[k], Real(0));
+
+    axpy(y, ac, x, s);
+  }
+
+  //! |x_k|^2 on s for every vector k, with one global sum
+  template<class T>
+  multi1d<Double> norm2(const LatticeBlock<T>& x, const Subset& s)
+  {
+    const int n = x.numRHS();
+    std::vector<REAL64> part(qdpNumThreads()*n, 0), res;
+
+    BlockKernels::Args<T,T> a(s.siteTable().slice(), n, 0, x.getF(), 0, 0, 0, &part[0]);
+    dispatch_to_threads(s.numSiteTable(), a, BlockKernels::norm2Kernel<T,T>);
+    BlockKernels::reducePartials(part, n, res);
+
+    multi1d<Double> d(n);
+    for(int k=0; k < n; ++k)
+      d[k] = res[k];
+    return d;
+  }
+
+  //! <x_k,y_k> on s for every vector k, with one global sum
+  template<class T>
+  multi1d<DComplex> innerProduct(const LatticeBlock<T>& x, const LatticeBlock<T>& y, const Subset& s)
+  {
+    BlockKernels::checkSizes(y, x, "innerProduct");
+    const int n = x.numRHS();
+    std::vector<REAL64> part(qdpNumThreads()*2*n, 0), res;
+
+    BlockKernels::Args<T,T> a(s.siteTable().slice(), n, 0, x.getF(), const_cast<T*>(y.getF()), 0, 0, &part[0]);
+    dispatch_to_threads(s.numSiteTable(), a, BlockKernels::innerProductKernel<T,T>);
+    BlockKernels::reducePartials(part, 2*n, res);
+
+    multi1d<DComplex> d(n);
+    for(int k=0; k < n; ++k)
+      d[k] = cmplx(Double(res[2*k]), Double(res[2*k+1]));
+    return d;
+  }
+
+
+  //! Hopping term of the fifth dimension of domain wall fermions on s
+  /*!
+   * With vector k of x the slice s = k of a 5D fermion,
+   *
+   *   y_s = P_- x_{s+1} + P_+ x_{s-1},   x_{Ls} = -m x_0,  x_{-1} = -m x_{Ls-1}
+   *
+   * for isign > 0, and the adjoint, with P_+ and P_- exchanged, for
+   * isign < 0. P_+- = (1 +- Gamma(15))/2 and Gamma(15) is diagonal, so
+   * each spin component of y is a scaled copy of one of x from the same
+   * site: one sweep moves whole rows of colour words.
+   */
+  template<class T>
+  void hopS(LatticeBlock< PSpinVector<T,4> >& y, const LatticeBlock< PSpinVector<T,4> >& x,
+	    const Real& m, int isign, const Subset& s)
+  {
+    BlockKernels::checkSizes(y, x, "hopS");
+    if (&y == &x)
+      QDP_error_exit("hopS: y and x are the same block");
+
+    BlockKernels::HopSArgs< PSpinVector<T,4> > a;
+    a.tab = s.siteTable().slice();
+    a.ls = x.numRHS();
+    a.m = toDouble(m);
+    a.x = x.getF();
+    a.y = y.getF();
+    for(int sp=0; sp < 4; ++sp)
+    {
+      if (GammaInternal::column[15][sp] != sp)
+	QDP_error_exit("hopS: Gamma(15) is not diagonal");
+
+      // P_+ picks the components where Gamma(15) is +1
+      const bool plus = (GammaInternal::phase[15][sp] == 0);
+      a.up[sp] = (plus == (isign > 0));
+    }
+
+    dispatch_to_threads(s.numSiteTable(), a, BlockKernels::hopSKernel< PSpinVector<T,4> >);
+  }
+
+
+  //! Blocks of fermions of the working precision
+  typedef LatticeBlock< PSpinVector< PColorVector< RComplex<REAL>, Nc>, Ns> >  LatticeFermionBlock;
+
+  //! Domain wall fermions: the Ls slices of a 5D fermion stored together at each site
+  /*!
+   * LatticeFermion5D psi(Ls). shift(chi, psi, FORWARD, mu) moves all the
+   * slices with one message per neighbour, multiply(chi, u[mu], psi, s)
+   * reads each link once for all of them and hopS() is the hopping in s.
+   */
+  typedef LatticeFermionBlock  LatticeFermion5D;
+
+  //! Blocks of color vectors of the working precision
+  typedef LatticeBlock< PScalar< PColorVector< RComplex<REAL>, Nc> > >  LatticeColorVectorBlock;
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,217 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Vector updates of all the shifts of a multi-shift solver in one sweep
+ */
+
+#ifndef QDP_MULTISHIFT_BLAS_H
+#define QDP_MULTISHIFT_BLAS_H
+
+#include <algorithm>
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! The shifted vector updates of multi-mass CG, all shifts in one sweep
+  /*!
+   * Per iteration multi-shift CG does, for every shift s,
+   *
+   *   x_s += alpha_s p_s;   p_s = beta_s p_s + zeta_s r
+   *
+   * Done one shift at a time, with vaxpy and friends, r is read from
+   * memory once per shift. Here the sites go in blocks small enough for
+   * the block of r to stay in cache while all the shifts are updated:
+   *
+   *   multiShiftUpdate(x, p, alpha, beta, zeta, r, rb[0]);
+   *
+   * The coefficients are arrays, one entry per shift. Shifts that have
+   * converged are left out by passing shorter arrays: only the first
+   * alpha.size() vectors of x and p are touched.
+   */
+  namespace MultiShiftKernels
+  {
+    //! user argument for the multi-shift kernels
+    template<class T>
+    struct Args
+    {
+      const int* tab;     //!< site table, null to go by runs
+      const SiteRun* runs;
+      int nruns;
+      int n;              //!< shifts
+      std::vector<T*> x;
+      std::vector<T*> p;
+      const T* r;
+      std::vector<REAL64> alpha, beta, zeta;
+    };
+
+    //! Sites done for all the shifts before moving on
+    /*! A block of 64 fermions of r is 6KB in single precision */
+    const int block_sites = 64;
+
+    //! Call f(site, n) on blocks of at most block_sites consecutive sites covering [lo,hi)
+    template<class T, class F>
+    inline void forBlocks(int lo, int hi, const Args<T>* a, const F& f)
+      {
+	if (! a->tab)
+	{
+	  forSiteRuns(a->runs, a->nruns, lo, hi, [&](int i0, int n) {
+	      for(int b=0; b < n; b += block_sites)
+		f(i0 + b, std::min(block_sites, n - b));
+	    });
+	  return;
+	}
+	for(int j=lo; j < hi; ++j)
+	  f(a->tab[j], 1);
+      }
+
+    //! x_s += alpha_s p_s, then p_s = beta_s p_s + zeta_s r, for all s
+    template<class T>
+    void updateKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int nw = sizeof(T)/sizeof(W);
+	forBlocks(lo, hi, a, [&](int i, int n) {
+	    const W* rp = (const W*)&a->r[i];
+	    for(int s=0; s < a->n; ++s)
+	    {
+	      const W al = a->alpha[s], be = a->beta[s], ze = a->zeta[s];
+	      W* xp = (W*)&a->x[s][i];
+	      W* pp = (W*)&a->p[s][i];
+	      for(int w=0; w < n*nw; ++w)
+	      {
+		const W pw = pp[w];
+		xp[w] += al*pw;
+		pp[w] = be*pw + ze*rp[w];
+	      }
+	    }
+	  });
+      }
+
+    //! p_s = beta_s p_s + zeta_s r for all s
+    template<class T>
+    void xpayKernel(int lo, int hi, int myId, Args<T>* a)
+      {
+	typedef typename WordType<T>::Type_t W;
+	const int nw = sizeof(T)/sizeof(W);
+	forBlocks(lo, hi, a, [&](int i, int n) {
+	    const W* rp = (const W*)&a->r[i];
+	    for(int s=0; s < a->n; ++s)
+	    {
+	      const W be = a->beta[s], ze = a->zeta[s];
+	      W* pp = (W*)&a->p[s][i];
+	      for(int w=0; w < n*nw; ++w)
+		pp[w] = be*pp[w] + ze*rp[w];
+	    }
+	  });
+      }
+
+    //! Fill the shift independent part of a and check the sizes
+    template<class T>
+    void setup(Args<T>& a, multi1d< OLattice<T> >* x, multi1d< OLattice<T> >& p, int n,
+	       const OLattice<T>& r, const Subset& s, const char* name)
+      {
+	if (p.size() < n || (x && x->size() < n))
+	  QDP_error_exit("%s: %d coefficients for %d vectors", name, n,
+			 x ? std::min(x->size(), p.size()) : p.size());
+
+	a.tab = 0;
+	a.runs = 0;
+	a.nruns = 0;
+	if (s.hasRuns())
+	{
+	  a.runs = s.runTable().slice();
+	  a.nruns = s.numRuns();
+	}
+	else
+	  a.tab = s.siteTable().slice();
+
+	a.n = n;
+	a.r = r.getF();
+	for(int k=0; k < n; ++k)
+	{
+	  a.p.push_back(writable(p[k]).getF());
+	  if (x)
+	    a.x.push_back(writable((*x)[k]).getF());
+	}
+      }
+
+    //! The coefficients c as REAL64
+    template<class S>
+    std::vector<REAL64> coefficients(const multi1d< OScalar<S> >& c)
+      {
+	std::vector<REAL64> d(c.size());
+	for(int k=0; k < c.size(); ++k)
+	  d[k] = toDouble(c[k]);
+	return d;
+      }
+  }
+
+
+  //! x[k] += alpha[k] p[k]; p[k] = beta[k] p[k] + zeta[k] r on s, for k < alpha.size()
+  /*! No x or p may be r */
+  template<class T, class S>
+  void multiShiftUpdate(multi1d< OLattice<T> >& x, multi1d< OLattice<T> >& p,
+			const multi1d< OScalar<S> >& alpha, const multi1d< OScalar<S> >& beta,
+			const multi1d< OScalar<S> >& zeta, const OLattice<T>& r, const Subset& s)
+  {
+    const int n = alpha.size();
+    if (beta.size() != n || zeta.size() != n)
+      QDP_error_exit("multiShiftUpdate: %d, %d and %d coefficients", n, beta.size(), zeta.size());
+
+    MultiShiftKernels::Args<T> a;
+    MultiShiftKernels::setup(a, &x, p, n, r, s, "multiShiftUpdate");
+    a.alpha = MultiShiftKernels::coefficients(alpha);
+    a.beta = MultiShiftKernels::coefficients(beta);
+    a.zeta = MultiShiftKernels::coefficients(zeta);
+
+    if (n > 0)
+      dispatch_to_threads(s.numSiteTable(), a, MultiShiftKernels::updateKernel<T>);
+  }
+
+  //! The same on all sites
+  template<class T, class S>
+  void multiShiftUpdate(multi1d< OLattice<T> >& x, multi1d< OLattice<T> >& p,
+			const multi1d< OScalar<S> >& alpha, const multi1d< OScalar<S> >& beta,
+			const multi1d< OScalar<S> >& zeta, const OLattice<T>& r)
+  {
+    multiShiftUpdate(x, p, alpha, beta, zeta, r, all);
+  }
+
+
+  //! p[k] = beta[k] p[k] + zeta[k] r on s, for k < beta.size()
+  /*! With beta zero and zeta one this starts every p from r */
+  template<class T, class S>
+  void multiShiftXpay(multi1d< OLattice<T> >& p, const multi1d< OScalar<S> >& beta,
+		      const multi1d< OScalar<S> >& zeta, const OLattice<T>& r, const Subset& s)
+  {
+    const int n = beta.size();
+    if (zeta.size() != n)
+      QDP_error_exit("multiShiftXpay: %d and %d coefficients", n, zeta.size());
+
+    MultiShiftKernels::Args<T> a;
+    MultiShiftKernels::setup<T>(a, 0, p, n, r, s, "multiShiftXpay");
+    a.beta = MultiShiftKernels::coefficients(beta);
+    a.zeta = MultiShiftKernels::coefficients(zeta);
+
+    if (n > 0)
+      dispatch_to_threads(s.numSiteTable(), a, MultiShiftKernels::xpayKernel<T>);
+  }
+
+  //! The same on all sites
+  template<class T, class S>
+  void multiShiftXpay(multi1d< OLattice<T> >& p, const multi1d< OScalar<S> >& beta,
+		      const multi1d< OScalar<S> >& zeta, const OLattice<T>& r)
+  {
+    multiShiftXpay(p, beta, zeta, r, all);
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,141 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Neighbour indexing of maps for hand written site loops
+ */
+
+#ifndef QDP_NEIGHBOUR_TABLE_H
+#define QDP_NEIGHBOUR_TABLE_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! Where each site of this node reads its mapped source
+  /*!
+   * Site x reads site index(x) of the field when onFace(x) is false, and
+   * record index(x) of the face the map receives otherwise. These are
+   * the goffset and receive offset tables of the map, in two flat arrays
+   * a kernel can index without branches on the node layout:
+   *
+   *   NeighbourTable fwd(+1, mu);
+   *   MapHandle<T> h = shift.getMap(FORWARD, mu).start(psi);
+   *   h.wait();
+   *   const T* f = psi.getF();
+   *   const T* face = h.face();
+   *   for x: chi[x] = u[x] * fwd.elem(f, face, x);
+   *
+   * Sites of interior() have no face and may be read before wait(). On
+   * a single node there is never a face.
+   */
+  class NeighbourTable
+  {
+  public:
+    //! The table of map m
+    explicit NeighbourTable(const Map& m);
+
+    //! The table of the nearest neighbour shift, x + isign*mu
+    NeighbourTable(int isign, int dir);
+
+    //! Site of the field, or record of the face, read at site x
+    int index(int x) const {return idx[x];}
+
+    //! Does site x read the face
+    bool onFace(int x) const {return face[x] != 0;}
+
+    //! index() of every site of the node
+    const int* indices() const {return idx.data();}
+
+    //! onFace() of every site of the node, 1 or 0
+    const unsigned char* faceFlags() const {return face.data();}
+
+    //! Number of sites reading the face
+    int numFaceSites() const {return nface;}
+
+    //! The source of site x, from the field f or the received face
+    template<class T>
+    const T& elem(const T* f, const T* recv, int x) const
+      {
+	return face[x] ? recv[idx[x]] : f[idx[x]];
+      }
+
+  private:
+    void make(const Map& m);
+
+    std::vector<int> idx;
+    std::vector<unsigned char> face;
+    int nface;
+  };
+
+
+  //! The 2 Nd nearest neighbours of a field, all exchanged together
+  /*!
+   * The faces of every direction and sign are started on construction
+   * through the persistent communications of the shift maps, and read in
+   * place after wait(). As for MapHandle, the field must not change and
+   * the shifts must not be started again meanwhile.
+   */
+  template<class T>
+  class NearestNeighbours
+  {
+  public:
+    //! Start the faces of f in every direction, forward and backward
+    explicit NearestNeighbours(const OLattice<T>& f)
+      {
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  handles.push_back(shift.getMap(FORWARD, mu).start(f));
+	  handles.push_back(shift.getMap(BACKWARD, mu).start(f));
+	}
+      }
+
+    //! Wait for all the faces
+    void wait()
+      {
+	for(int k=0; k < handles.size(); ++k)
+	  handles[k].wait();
+      }
+
+    //! f(x + isign*mu)
+    /*! Sites of interior() may be read before wait() */
+    const T& operator()(int x, int isign, int mu) const
+      {
+	return handles[2*mu + (isign > 0 ? 0 : 1)].elem(x);
+      }
+
+    //! The handle of the shift in direction mu, sign isign
+    const MapHandle<T>& handle(int isign, int mu) const {return handles[2*mu + (isign > 0 ? 0 : 1)];}
+
+    //! Sites of s reading no face in any direction
+    /*! Made with operator& once and kept */
+    Subset interior(const Subset& s = all) const
+      {
+	Subset r = handles[0].interior(s);
+	for(int k=1; k < handles.size(); ++k)
+	  r = r & handles[k].interior(s);
+	return r;
+      }
+
+    //! Sites of s reading a face in some direction
+    Subset boundary(const Subset& s = all) const
+      {
+	Subset r = handles[0].boundary(s);
+	for(int k=1; k < handles.size(); ++k)
+	  r = r | handles[k].boundary(s);
+	return r;
+      }
+
+  private:
+    std::vector< MapHandle<T> > handles;
+  };
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
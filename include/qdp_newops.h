@@ -157,7 +157,8 @@ peekColor(const QDPType<T1,C1> & l, int row, int col)
 
 template<class T1,class C1>
 inline typename MakeReturn<UnaryNode<FnPeekColorMatrix,
-  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>, C1>::Expression_t
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnPeekColorMatrix >::Type_t >::Expression_t
 peekColor(const QDPExpr<T1,C1> & l, int row, int col)
 {
   typedef UnaryNode<FnPeekColorMatrix,
@@ -206,7 +207,8 @@ peekColor(const QDPType<T1,C1> & l, int row)
 
 template<class T1,class C1>
 inline typename MakeReturn<UnaryNode<FnPeekColorVector,
-  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>, C1>::Expression_t
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnPeekColorVector >::Type_t >::Expression_t
 peekColor(const QDPExpr<T1,C1> & l, int row)
 {
   typedef UnaryNode<FnPeekColorVector,
@@ -254,7 +256,8 @@ peekSpin(const QDPType<T1,C1> & l, int row, int col)
 
 template<class T1,class C1>
 inline typename MakeReturn<UnaryNode<FnPeekSpinMatrix,
-  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>, C1>::Expression_t
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnPeekSpinMatrix >::Type_t >::Expression_t
 peekSpin(const QDPExpr<T1,C1> & l, int row, int col)
 {
   typedef UnaryNode<FnPeekSpinMatrix,
@@ -303,7 +306,8 @@ peekSpin(const QDPType<T1,C1> & l, int row)
 
 template<class T1,class C1>
 inline typename MakeReturn<UnaryNode<FnPeekSpinVector,
-  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>, C1>::Expression_t
+  typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>,
+  typename UnaryReturn<C1,FnPeekSpinVector >::Type_t >::Expression_t
 peekSpin(const QDPExpr<T1,C1> & l, int row)
 {
   typedef UnaryNode<FnPeekSpinVector,
@@ -350,7 +354,7 @@ inline C1&
 pokeColor(QDPType<T1,C1> & l, const QDPType<T2,C2>& r, int row, int col)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeColorMatrix(row,col),PETE_identity(r),all);
+  evaluate(ll,FnPokeColorMatrix(row,col),PETE_identity(r),allSites(ll));
   return ll;
 }
 
@@ -360,7 +364,7 @@ inline C1&
 pokeColor(QDPType<T1,C1> & l, const QDPExpr<T2,C2>& r, int row, int col)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeColorMatrix(row,col),r,all);
+  evaluate(ll,FnPokeColorMatrix(row,col),r,allSites(ll));
   return ll;
 }
 
@@ -425,7 +429,7 @@ inline C1&
 pokeColor(QDPType<T1,C1>& l, const QDPType<T2,C2>& r, int row)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeColorVector(row),PETE_identity(r),all);
+  evaluate(ll,FnPokeColorVector(row),PETE_identity(r),allSites(ll));
   return ll;
 }
 
@@ -434,7 +438,7 @@ inline C1&
 pokeColor(QDPType<T1,C1>& l, const QDPExpr<T2,C2>& r, int row)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeColorVector(row),r,all);
+  evaluate(ll,FnPokeColorVector(row),r,allSites(ll));
   return ll;
 }
 
@@ -500,7 +504,7 @@ inline C1&
 pokeSpin(QDPType<T1,C1> & l, const QDPType<T2,C2>& r, int row, int col)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeSpinMatrix(row,col),PETE_identity(r),all);
+  evaluate(ll,FnPokeSpinMatrix(row,col),PETE_identity(r),allSites(ll));
   return ll;
 }
 
@@ -509,7 +513,7 @@ inline C1&
 pokeSpin(QDPType<T1,C1> & l, const QDPExpr<T2,C2>& r, int row, int col)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeSpinMatrix(row,col),r,all);
+  evaluate(ll,FnPokeSpinMatrix(row,col),r,allSites(ll));
   return ll;
 }
 
@@ -576,7 +580,7 @@ inline C1&
 pokeSpin(QDPType<T1,C1>& l, const QDPType<T2,C2>& r, int row)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeSpinVector(row),PETE_identity(r),all);
+  evaluate(ll,FnPokeSpinVector(row),PETE_identity(r),allSites(ll));
   return ll;
 }
 
@@ -585,7 +589,7 @@ inline C1&
 pokeSpin(QDPType<T1,C1>& l, const QDPExpr<T2,C2>& r, int row)
 {
   C1& ll = static_cast<C1&>(l);
-  evaluate(ll,FnPokeSpinVector(row),r,all);
+  evaluate(ll,FnPokeSpinVector(row),r,allSites(ll));
   return ll;
 }
 
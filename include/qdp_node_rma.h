@@ -0,0 +1,88 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Faces put straight into the receive buffers of other nodes with MPI-3 one sided communication
+ */
+
+#ifndef QDP_NODE_RMA_H
+#define QDP_NODE_RMA_H
+
+#include <cstddef>
+
+namespace QDP
+{
+  //! One sided communications for the persistent faces of maps
+  /*!
+   * Instead of a matched QMP send and receive per face, the sender puts
+   * its packed face directly into the receive buffer of the other node
+   * and raises a flag there, which the receiver polls. The buffers are
+   * attached once to a dynamic window when a map sets up its
+   * communications for a size of site, so every later shift of that
+   * size costs one put and one flag update, without tag matching.
+   *
+   * Built with --enable-mpi-rma and selected at run time with
+   * -rma-comms on. Faces for nodes on this host still go through
+   * NodeShm when that is on.
+   */
+  namespace NodeRma
+  {
+    //! Make the window when the path is on; all the nodes call it together
+    void init();
+
+    //! Free what init made, after every channel and before QMP goes
+    void finalize();
+
+    //! Are faces put through the window
+    bool enabled();
+
+    //! Turn the one sided path on or off
+    /*!
+     * On takes effect at init, off at once. Only maps setting up their
+     * communications afterwards follow it.
+     */
+    void setEnabled(bool on);
+
+    //! One way channel between two nodes
+    /*!
+     * Both ends make their channel of a pair of nodes at the same point
+     * of the program, the n-th channel of the pair at one end being the
+     * n-th at the other. They swap the addresses of the receive buffer
+     * and of the flags once, then never talk outside the window.
+     */
+    class Channel
+    {
+    public:
+      //! The end of this node of a channel carrying bytes bytes from node from to node to
+      /*! buf is the packed face to send or the place it is put */
+      Channel(int from, int to, void* buf, size_t bytes);
+      ~Channel();
+
+      //! Put buf into the receiver once it took the last face, and raise its flag
+      /*! Done on return */
+      void send();
+
+      //! Wait for the face to be in buf
+      void receive();
+
+      //! Let the sender put the next face, buf being free again
+      void post();
+
+    private:
+      Channel(const Channel&);
+      Channel& operator=(const Channel&);
+
+      struct Flag;
+
+      Flag* flag;        // sent for the receiver, posted for the sender
+      void* buf;
+      size_t bytes;
+      int rank;          // of the other node in the window
+      long remote_buf;   // addresses at the other end, as MPI_Aint
+      long remote_flag;
+      long count;        // faces sent or received so far
+      bool sender;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,132 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Faces and global sums through shared memory between nodes on one host
+ */
+
+#ifndef QDP_NODE_SHM_H
+#define QDP_NODE_SHM_H
+
+#include <cstddef>
+
+namespace QDP
+{
+  //! Node-local communications
+  /*!
+   * With several nodes (QMP ranks) on one host, a map hands the face for
+   * a neighbour on the same host over through a shared memory segment
+   * instead of a QMP message: the sender copies its packed face into the
+   * segment and raises a flag, the receiver waits on the flag and copies
+   * the face out. Faces for other hosts still go through QMP. Likewise
+   * the global sums add up the nodes of a host in shared memory and only
+   * one node per host takes part in the network reduction.
+   *
+   * Built with --enable-mpi-shm, which finds the nodes sharing a host
+   * with MPI_Comm_split_type. Turned off with -shm-comms off.
+   */
+  namespace NodeShm
+  {
+    //! Find the nodes on this host; all the nodes call it together
+    void init();
+
+    //! Free what init made, before QMP goes
+    void finalize();
+
+    //! Are faces for nodes on this host sent through shared memory
+    bool enabled();
+
+    //! Turn the shared memory path on or off
+    /*! Only maps setting up their communications afterwards follow it */
+    void setEnabled(bool on);
+
+    //! Does node run on this host
+    bool onNode(int node);
+
+    //! Sum x[0..n) over all nodes, first over each host then between hosts
+    /*!
+     * The nodes of a host leave their arrays in shared memory, the first
+     * of them adds them up in a fixed order, sums that over the network
+     * with the first nodes of the other hosts only, and leaves the total
+     * for the rest. All the nodes call it together. Returns false,
+     * having done nothing, when the shared memory path is off.
+     */
+    bool globalSum(int* x, int n);
+    bool globalSum(float* x, int n);
+    bool globalSum(double* x, int n);
+
+    //! One way channel between two nodes on this host
+    /*!
+     * Both ends make their channel of a pair of nodes at the same point
+     * of the program, the n-th channel of the pair at one end being the
+     * n-th at the other. The receiving end makes the segment and the
+     * sending end waits for it to appear.
+     */
+    class Channel
+    {
+    public:
+      //! The end of this node of a channel carrying bytes bytes from node from to node to
+      /*! buf is the packed face to send or the place to receive it */
+      Channel(int from, int to, void* buf, size_t bytes);
+      ~Channel();
+
+      //! Copy buf into the segment once the receiver took the last one
+      void send();
+
+      //! Wait for the face and copy it to buf
+      void receive();
+
+    private:
+      Channel(const Channel&);
+      Channel& operator=(const Channel&);
+
+      struct Header;
+
+      Header* head;     // flags at the start of the segment
+      char* data;       // the face after them
+      void* buf;
+      size_t bytes;
+      size_t mapped;
+      long count;       // faces sent or received so far
+      bool sender;
+    };
+
+    //! A block of memory mapped by all the nodes of a host
+    /*!
+     * For data every node reads and nobody writes once it is filled, like
+     * a whole gauge field or a bank of vectors replicated on all nodes:
+     * the host holds one copy instead of one per node. Made and freed by
+     * all the nodes together. When the shared memory path is off the
+     * block is not made and shared() is false.
+     */
+    class SharedBlock
+    {
+    public:
+      //! bytes bytes for the host; all the nodes call it together
+      explicit SharedBlock(size_t bytes);
+      ~SharedBlock();
+
+      //! Is the block there
+      bool shared() const {return base != 0;}
+
+      char* data() const {return base;}
+      size_t size() const {return bytes;}
+
+      //! Each node wrote block bytes at offset + node*block, give every host all of them
+      /*! The first nodes of the hosts pass the blocks of their nodes to
+       *  each other. All the nodes call it together */
+      void allGather(size_t offset, size_t block);
+
+    private:
+      SharedBlock(const SharedBlock&);
+      SharedBlock& operator=(const SharedBlock&);
+
+      struct Window;
+
+      Window* win;
+      char* base;
+      size_t bytes;
+    };
+  }
+}
+
+#endif
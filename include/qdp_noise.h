@@ -0,0 +1,218 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Gaussian, Z2 and Z4 noise of a site in one pass
+ *
+ * The lattice noise() and the counter based gaussian() fill each site
+ * as a flat array of words: the Philox words of the site are turned
+ * into uniform numbers and then into the noise with loops of fixed
+ * length and no branches, and log, sqrt and sincos are the polynomial
+ * forms below rather than calls into libm, so those loops vectorise.
+ * The key is taken from the global seed the way every lattice fill
+ * takes it, so setrn/savern reproduce the noise, and a site draws the
+ * same numbers for any node and thread decomposition.
+ */
+
+#ifndef QDP_NOISE_H
+#define QDP_NOISE_H
+
+#include <cstring>
+
+namespace QDP
+{
+  //! Distributions of noise()
+  /*!
+   * NOISE_GAUSSIAN gives each real and imaginary part a normal number of
+   * unit variance as gaussian() does. NOISE_Z2 gives each complex +1 or
+   * -1 and NOISE_Z4 one of 1, i, -1, -i, with zero imaginary parts for Z2.
+   * On real fields Z4 is Z2.
+   */
+  enum NoiseType { NOISE_GAUSSIAN, NOISE_Z2, NOISE_Z4 };
+
+  namespace RNG
+  {
+    //! Is the word below T the real part of a complex
+    template<class T> struct NoiseComplex { enum {value = 0}; };
+
+    template<class T> struct NoiseComplex< PScalar<T> > : NoiseComplex<T> {};
+    template<class T, int N> struct NoiseComplex< PColorMatrix<T,N> > : NoiseComplex<T> {};
+    template<class T, int N> struct NoiseComplex< PSpinMatrix<T,N> > : NoiseComplex<T> {};
+    template<class T, int N> struct NoiseComplex< PColorVector<T,N> > : NoiseComplex<T> {};
+    template<class T, int N> struct NoiseComplex< PSpinVector<T,N> > : NoiseComplex<T> {};
+    template<class T> struct NoiseComplex< RScalar<T> > { enum {value = 0}; };
+    template<class T> struct NoiseComplex< RComplex<T> > { enum {value = 1}; };
+
+
+    //! log(x) for x in (0,1), to the precision of float
+    inline float noiseLog(float x)
+    {
+      unsigned int b;
+      std::memcpy(&b, &x, sizeof(b));
+      int e = int(b >> 23) - 127;
+      b = (b & 0x7fffffu) | 0x3f800000u;
+      float m;
+      std::memcpy(&m, &b, sizeof(m));
+
+      // m in [sqrt(1/2), sqrt(2)), s in [-0.172, 0.172]
+      const bool big = m > 1.41421356f;
+      m = big ? 0.5f*m : m;
+      e += big ? 1 : 0;
+
+      const float s = (m - 1.0f)/(m + 1.0f);
+      const float z = s*s;
+      const float p = 1.0f + z*(1.0f/3 + z*(1.0f/5 + z*(1.0f/7 + z*(1.0f/9 + z*(1.0f/11)))));
+      return float(e)*0.693147180559945f + 2.0f*s*p;
+    }
+
+    //! log(x) for x in (0,1), to the precision of double
+    inline double noiseLog(double x)
+    {
+      unsigned long long b;
+      std::memcpy(&b, &x, sizeof(b));
+      int e = int(b >> 52) - 1023;
+      b = (b & 0xfffffffffffffull) | 0x3ff0000000000000ull;
+      double m;
+      std::memcpy(&m, &b, sizeof(m));
+
+      const bool big = m > 1.4142135623730951;
+      m = big ? 0.5*m : m;
+      e += big ? 1 : 0;
+
+      const double s = (m - 1.0)/(m + 1.0);
+      const double z = s*s;
+      double p = 1.0/23;
+      for(int k=21; k >= 1; k -= 2)
+	p = 1.0/k + z*p;
+
+      // ln 2 split so e*ln2 is exact in the high part
+      return double(e)*6.93147180369123816490e-01 + (double(e)*1.90821492927058770002e-10 + 2.0*s*p);
+    }
+
+    //! s = sin(2 pi u), c = cos(2 pi u) for u in [0,1], to the precision of float
+    inline void noiseSinCos2Pi(float u, float& s, float& c)
+    {
+      // Quadrant q and t = 2 pi u - q pi/2 in [-pi/4, pi/4]
+      const float x = 4.0f*u;
+      const int q = int(x + 0.5f);
+      const float t = (x - float(q))*1.57079632679489662f;
+      const float z = t*t;
+
+      const float sn = t*(1.0f + z*(-1.0f/6 + z*(1.0f/120 + z*(-1.0f/5040 + z*(1.0f/362880)))));
+      const float cs = 1.0f + z*(-0.5f + z*(1.0f/24 + z*(-1.0f/720 + z*(1.0f/40320 + z*(-1.0f/3628800)))));
+
+      const int k = q & 3;
+      s = (k == 0) ? sn : (k == 1) ? cs : (k == 2) ? -sn : -cs;
+      c = (k == 0) ? cs : (k == 1) ? -sn : (k == 2) ? -cs : sn;
+    }
+
+    //! s = sin(2 pi u), c = cos(2 pi u) for u in [0,1], to the precision of double
+    inline void noiseSinCos2Pi(double u, double& s, double& c)
+    {
+      const double x = 4.0*u;
+      const int q = int(x + 0.5);
+      const double t = (x - double(q))*1.57079632679489661923;
+      const double z = t*t;
+
+      // Taylor series to t^17 and t^18, the terms after are below 1e-17
+      const double sn = t*(1.0 - z*(1.0/6 - z*(1.0/120 - z*(1.0/5040 - z*(1.0/362880
+	- z*(1.0/39916800 - z*(1.0/6227020800.0 - z*(1.0/1307674368000.0
+	- z*(1.0/355687428096000.0)))))))));
+      const double cs = 1.0 - z*(1.0/2 - z*(1.0/24 - z*(1.0/720 - z*(1.0/40320
+	- z*(1.0/3628800 - z*(1.0/479001600 - z*(1.0/87178291200.0
+	- z*(1.0/20922789888000.0 - z*(1.0/6402373705728000.0)))))))));
+
+      const int k = q & 3;
+      s = (k == 0) ? sn : (k == 1) ? cs : (k == 2) ? -sn : -cs;
+      c = (k == 0) ? cs : (k == 1) ? -sn : (k == 2) ? -cs : sn;
+    }
+
+
+    //! Uniform numbers in (0,1) from the words of a counter stream
+    inline void noiseUniform(const unsigned int* w, float* u, int n)
+    {
+#pragma omp simd
+      for(int i=0; i < n; ++i)
+	u[i] = (float(w[i] >> 8) + 0.5f) * (1.0f/16777216.0f);
+    }
+
+    //! Uniform numbers in (0,1) with 53 bits from a counter stream
+    inline void noiseUniform(const unsigned int* w, double* u, int n)
+    {
+#pragma omp simd
+      for(int i=0; i < n; ++i)
+      {
+	const unsigned long long hi = w[2*i] >> 5;
+	const unsigned long long lo = w[2*i+1] >> 6;
+	u[i] = (double((hi << 26) | lo) + 0.5) * (1.0/9007199254740992.0);
+      }
+    }
+
+
+    //! Fill the site d with noise from its counter stream
+    /*!
+     * The words of d are taken in pairs, which are the real and
+     * imaginary parts of a complex when T is complex. Gaussian noise
+     * uses two uniform numbers per pair and the Box-Muller transform,
+     * Z2 and Z4 one 32-bit word per pair.
+     */
+    template<class T>
+    inline void counterNoise(T& d, NoiseType type, const CounterKey& key, unsigned int site)
+    {
+      typedef typename WordType<T>::Type_t W;
+      enum {n = sizeof(T)/sizeof(W),
+	    pairs = (n + 1)/2,
+	    uwords = sizeof(W)/4,
+	    gblocks = (2*pairs*uwords + 3)/4,
+	    zblocks = (pairs + 3)/4};
+
+      W* x = reinterpret_cast<W*>(&d);
+      unsigned int w[4*gblocks];
+      W a[2*pairs];
+
+      if (type == NOISE_GAUSSIAN)
+      {
+	counterWords(key, site, w, gblocks);
+	noiseUniform(w, a, 2*pairs);
+
+	// r = sqrt(-2 log u1), then (r cos(2 pi u2), r sin(2 pi u2))
+#pragma omp simd
+	for(int p=0; p < pairs; ++p)
+	{
+	  W sn, cs;
+	  const W r = std::sqrt(W(-2)*noiseLog(a[2*p]));
+	  noiseSinCos2Pi(a[2*p+1], sn, cs);
+	  a[2*p] = r*cs;
+	  a[2*p+1] = r*sn;
+	}
+      }
+      else
+      {
+	counterWords(key, site, w, zblocks);
+	const bool z4 = (type == NOISE_Z4) && NoiseComplex<T>::value;
+
+#pragma omp simd
+	for(int p=0; p < pairs; ++p)
+	{
+	  const unsigned int b = w[p] >> 30;
+	  if (NoiseComplex<T>::value)
+	  {
+	    // Z4 takes two bits: 1, i, -1, -i; Z2 one: 1, -1
+	    const unsigned int k = z4 ? b : (b & 2u);
+	    a[2*p]   = (k == 0) ? W(1) : (k == 2) ? W(-1) : W(0);
+	    a[2*p+1] = (k == 1) ? W(1) : (k == 3) ? W(-1) : W(0);
+	  }
+	  else
+	  {
+	    a[2*p]   = (b & 2u) ? W(-1) : W(1);
+	    a[2*p+1] = (b & 1u) ? W(-1) : W(1);
+	  }
+	}
+      }
+
+      for(int i=0; i < n; ++i)
+	x[i] = a[i];
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,61 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Fast formatting and parsing of numbers for text and XML IO
+ *
+ * Floating point numbers are written in the shortest form that reads
+ * back to the same value, so text and XML dumps lose nothing and are no
+ * longer than they need be. Lists of numbers are parsed in one pass over
+ * the string. Where the library has std::to_chars and std::from_chars
+ * for floating point those are used, otherwise snprintf and strtod.
+ */
+
+#ifndef QDP_NUMFORMAT_H
+#define QDP_NUMFORMAT_H
+
+#include <string>
+#include <vector>
+
+namespace QDP
+{
+  namespace NumFormat
+  {
+    //! Room needed in the buffer of a formatted number
+    enum {maxChars = 32};
+
+    //! Write x into buf in the shortest form that reads back as x
+    /*! Returns the number of characters, no terminating zero is written */
+    int shortest(char* buf, float x);
+    int shortest(char* buf, double x);
+
+    //! Write an integer into buf, returning the number of characters
+    int integer(char* buf, long int x);
+    int integer(char* buf, unsigned long int x);
+
+    //! Append the text of x to out
+    inline void append(std::string& out, float x) {char b[maxChars]; out.append(b, shortest(b, x));}
+    inline void append(std::string& out, double x) {char b[maxChars]; out.append(b, shortest(b, x));}
+    inline void append(std::string& out, int x) {char b[maxChars]; out.append(b, integer(b, long(x)));}
+    inline void append(std::string& out, short int x) {char b[maxChars]; out.append(b, integer(b, long(x)));}
+    inline void append(std::string& out, long int x) {char b[maxChars]; out.append(b, integer(b, x));}
+    inline void append(std::string& out, unsigned int x) {char b[maxChars]; out.append(b, integer(b, (unsigned long)(x)));}
+    inline void append(std::string& out, unsigned short int x) {char b[maxChars]; out.append(b, integer(b, (unsigned long)(x)));}
+    inline void append(std::string& out, unsigned long int x) {char b[maxChars]; out.append(b, integer(b, x));}
+
+    //! Parse the white space separated numbers of s
+    /*!
+     * Returns false when a token is not a number of the type, out then
+     * holds the numbers before it
+     */
+    bool parseList(const std::string& s, std::vector<float>& out);
+    bool parseList(const std::string& s, std::vector<double>& out);
+    bool parseList(const std::string& s, std::vector<int>& out);
+    bool parseList(const std::string& s, std::vector<unsigned int>& out);
+    bool parseList(const std::string& s, std::vector<short int>& out);
+    bool parseList(const std::string& s, std::vector<unsigned short int>& out);
+    bool parseList(const std::string& s, std::vector<long int>& out);
+    bool parseList(const std::string& s, std::vector<unsigned long int>& out);
+  }
+}
+
+#endif
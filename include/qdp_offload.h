@@ -0,0 +1,175 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Device offload of lattice loops with OpenMP target
+ *
+ * When built with QDP_USE_OMP_OFFLOAD (configure --enable-omp-offload)
+ * and switched on with -offload or Offload::setEnabled, evaluate, sum
+ * and the face packing of the parscalar Map run their site loops as
+ * OpenMP target regions. The loop bodies are the same
+ * forEach(rhs, EvalLeaf1(i), OpCombine()) as on the host, so the
+ * compiler generates a device kernel per expression from the PETE tree.
+ *
+ * Lattice fields stay in the memory the allocator gives them. The
+ * target regions reach them through unified shared memory, so the
+ * driver migrates pages between host and device as they are touched and
+ * host code sees the fields unchanged. The requires directive is only
+ * given on compilers that implement it; without a device the target
+ * regions run on the host.
+ *
+ * Subsets of fewer than Offload::minSites() sites stay on the host
+ * threads, where the launch would cost more than the loop.
+ *
+ * The faces of parscalar shifts are packed on the device into device
+ * memory. With a GPU-aware message layer (COMMS_DEVICE) they are sent
+ * from there. Otherwise (COMMS_STAGED) each destination's part is copied
+ * to the host buffer and its send is started while the next part is
+ * packed. Received faces land in host comms memory, which the shifted
+ * expression reads in place.
+ */
+
+#ifndef QDP_OFFLOAD_H
+#define QDP_OFFLOAD_H
+
+#if defined(QDP_USE_OMP_OFFLOAD)
+#if defined(__clang__) || ! defined(__GNUC__) || __GNUC__ >= 13
+#pragma omp requires unified_shared_memory
+#endif
+#endif
+
+namespace QDP
+{
+  namespace Offload
+  {
+    //! Was the library built with offload
+    bool available();
+
+    //! Turn offload on or off, a no-op without available()
+    void setEnabled(bool on);
+
+    //! Is offload on
+    bool enabled();
+
+    //! Smallest subset run on the device
+    void setMinSites(int n);
+    int minSites();
+
+    //! Run a loop over n sites on the device
+    inline bool use(int n) {return enabled() && n >= minSites();}
+
+    //! Where the faces of shifts are packed and sent from when offload is on
+    enum CommsPath
+    {
+      COMMS_HOST,     //!< packed into the host comms buffers
+      COMMS_DEVICE,   //!< packed into device memory and sent from it
+      COMMS_STAGED    //!< packed on the device, copied to the host per destination
+    };
+
+    //! Set the comms path of shifts set up from now on
+    /*! The default is COMMS_DEVICE when built with --enable-gpu-aware-comms, COMMS_STAGED otherwise */
+    void setCommsPath(CommsPath p);
+    CommsPath commsPath();
+
+    //! Allocate n bytes of device memory
+    void* deviceAlloc(size_t n);
+
+    //! Free memory from deviceAlloc
+    void deviceFree(void* p);
+
+    //! Copy n bytes from device memory to host memory
+    void copyToHost(void* h, const void* d, size_t n);
+
+    //! Op that packs a site as it is
+    struct PackCopy
+    {
+      template<class T1>
+      const T1& operator()(const T1& x) const {return x;}
+    };
+
+    //! Type of a site of T1 packed with Op
+    template<class T1, class Op>
+    struct PackType
+    {
+      typedef typename UnaryReturn<T1, Op>::Type_t Type_t;
+    };
+
+    template<class T1>
+    struct PackType<T1, PackCopy>
+    {
+      typedef T1 Type_t;
+    };
+
+
+#if defined(QDP_USE_OMP_OFFLOAD)
+    //! dest op= rhs on the sites of s, on the device
+    template<class T, class C1, class Op, class RHS>
+    void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs, const Subset& s)
+    {
+      const int n = s.numSiteTable();
+      const int *tab = s.siteTable().slice();
+
+#pragma omp target teams distribute parallel for
+      for(int j=0; j < n; ++j)
+      {
+	const int i = tab[j];
+	op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
+      }
+    }
+
+
+    //! Blocks of sites summed by one team each, then added in order on the host
+    enum {sumBlocks = 1024};
+
+    //! d += the sum of s1 on the sites of s, on the device
+    /*! The blocks are fixed by the subset size, so the result does not depend on the device */
+    template<class RHS, class T, class D>
+    void sum(D& d, const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+    {
+      const int n = s.numSiteTable();
+      const int *tab = s.siteTable().slice();
+      const int nb = (n < sumBlocks) ? n : int(sumBlocks);
+
+      multi1d<D> part(nb);
+      D* p = &part[0];
+
+#pragma omp target teams distribute
+      for(int b=0; b < nb; ++b)
+      {
+	const int lo = int((long(n)*b)/nb);
+	const int hi = int((long(n)*(b+1))/nb);
+
+	D acc;
+	zero_rep(acc.elem());
+	for(int j=lo; j < hi; ++j)
+	  acc.elem() += forEach(s1, EvalLeaf1(tab[j]), OpCombine());
+	p[b].elem() = acc.elem();
+      }
+
+      for(int b=0; b < nb; ++b)
+	d.elem() += p[b].elem();
+    }
+
+
+    //! out[oidx[k]] = in[iidx[k]] for k < n, on the device
+    /*! oidx may be null for out[k] */
+    template<class T1>
+    void gather(T1* out, const int *oidx, const T1* in, const int *iidx, int n)
+    {
+#pragma omp target teams distribute parallel for
+      for(int k=0; k < n; ++k)
+	out[oidx ? oidx[k] : k] = in[iidx[k]];
+    }
+
+    //! out[k] = Op()(in[iidx[k]]) for k < n, out from deviceAlloc
+    template<class Op, class H, class T1>
+    void pack(H* out, const T1* in, const int *iidx, int n)
+    {
+#pragma omp target teams distribute parallel for is_device_ptr(out)
+      for(int k=0; k < n; ++k)
+	out[k] = Op()(in[iidx[k]]);
+    }
+#endif
+  }
+}
+
+#endif
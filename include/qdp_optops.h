@@ -253,13 +253,13 @@ trace(const QDPExpr<BinaryNode<OpMultiply,T1,T2>,CC> & ll)
 //! traceColorMultiply(l,r)  <-  traceColor(l*r)
 template<class T1,class T2,class CC>
 inline typename MakeReturn<BinaryNode<FnTraceColorMultiply,T1,T2>,
-  typename UnaryReturn<CC,FnTrace>::Type_t>::Expression_t
+  typename UnaryReturn<CC,FnTraceColor>::Type_t>::Expression_t
 traceColor(const QDPExpr<BinaryNode<OpMultiply,T1,T2>,CC> & ll)
 {
 //  cerr << "traceColorMultiply(l,r) <- traceColor(l*r)" << endl;
 
   typedef BinaryNode<FnTraceColorMultiply,T1,T2> Tree_t;
-  typedef typename UnaryReturn<CC,FnTrace>::Type_t Container_t;
+  typedef typename UnaryReturn<CC,FnTraceColor>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     ll.expression().left(), 
     ll.expression().right()));
@@ -268,13 +268,13 @@ traceColor(const QDPExpr<BinaryNode<OpMultiply,T1,T2>,CC> & ll)
 //! traceSpinMultiply(l,r)  <-  traceSpin(l*r)
 template<class T1,class T2,class CC>
 inline typename MakeReturn<BinaryNode<FnTraceSpinMultiply,T1,T2>,
-  typename UnaryReturn<CC,FnTrace>::Type_t>::Expression_t
+  typename UnaryReturn<CC,FnTraceSpin>::Type_t>::Expression_t
 traceSpin(const QDPExpr<BinaryNode<OpMultiply,T1,T2>,CC> & ll)
 {
 //  cerr << "traceSpinMultiply(l,r) <- traceSpin(l*r)" << endl;
 
   typedef BinaryNode<FnTraceSpinMultiply,T1,T2> Tree_t;
-  typedef typename UnaryReturn<CC,FnTrace>::Type_t Container_t;
+  typedef typename UnaryReturn<CC,FnTraceSpin>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     ll.expression().left(), 
     ll.expression().right()));
@@ -283,13 +283,13 @@ traceSpin(const QDPExpr<BinaryNode<OpMultiply,T1,T2>,CC> & ll)
 //! traceOuterProduct(l,r)  <-  traceSpin(outerProduct(l,r))
 template<class T1,class T2,class CC>
 inline typename MakeReturn<BinaryNode<FnTraceSpinOuterProduct,T1,T2>,
-  typename UnaryReturn<CC,FnTrace>::Type_t>::Expression_t
+  typename UnaryReturn<CC,FnTraceSpin>::Type_t>::Expression_t
 traceSpin(const QDPExpr<BinaryNode<FnOuterProduct,T1,T2>,CC> & ll)
 {
 //  cerr << "traceSpinOuterProduct(l,r) <- traceSpin(outerProduct(l,r))" << endl;
 
   typedef BinaryNode<FnTraceSpinOuterProduct,T1,T2> Tree_t;
-  typedef typename UnaryReturn<CC,FnTrace>::Type_t Container_t;
+  typedef typename UnaryReturn<CC,FnTraceSpin>::Type_t Container_t;
   return MakeReturn<Tree_t,Container_t>::make(Tree_t(
     ll.expression().left(), 
     ll.expression().right()));
@@ -6,6 +6,8 @@
 #include "qdp_config.h"
 #include "qdp_allocator.h"
 
+#include <atomic>
+
 /*! \file
  * \brief Outer grid classes
  */
@@ -164,10 +166,14 @@ std::ostream& operator<<(std::ostream& s, const QDPExpr<RHS, OScalar<T1> >& l)
 }
 
 //! Text input
+/*! The words are read on the primary node and broadcast together */
 template<class T>
 TextReader& operator>>(TextReader& txt, OScalar<T>& d)
 {
-  return txt >> d.elem();
+  txt.beginObject();
+  txt >> d.elem();
+  txt.endObject(&d.elem(), sizeof(T));
+  return txt;
 }
 
 //! Text input
@@ -257,6 +263,17 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >& rhs,
  * @{
  */
 
+//! Tag of the OLattice constructor over sites stored elsewhere
+struct BorrowedSites {};
+
+//! A version no field has had yet
+/*! Versions tell apart the values a field has held over time, see OLattice::version */
+inline unsigned long newLatticeVersion()
+{
+  static std::atomic<unsigned long> last(0);
+  return ++last;
+}
+
 //! Outer grid Lattice type
 /*! All outer lattices are of OScalar or OLattice type */
 template<class T> 
@@ -272,8 +289,27 @@ public:
       free_mem();
     }
 
+  //! The sites of a lattice other than the one of Layout
+  /*! l must outlive the field */
+  explicit OLattice(const LatticeLayout& l) : lay(&l)
+    {
+      alloc_mem("create on a layout");
+    }
+
+
+  OLattice( T* F , float f ): mem(false), F(F), ver(newLatticeVersion()) {}
 
-  OLattice( T* F , float f ): mem(false), F(F) {}
+  //! A field over sites owned by someone else
+  /*!
+   * F holds the sites on this node in the order of the layout, as getF()
+   * does, and must outlive the field. Nothing is allocated and F is not
+   * freed with the field; assignments write straight into it. Copies of
+   * the field have their own sites.
+   *
+   *   LatticeFermion psi(external, BorrowedSites());
+   */
+  OLattice(T* F_, const BorrowedSites&, const LatticeLayout* l = nullptr) :
+    mem(false), F(F_), lay(l), ver(newLatticeVersion()) {}
 
 
   //---------------------------------------------------------
@@ -288,7 +324,7 @@ public:
 
   //! conversion by constructor  OLattice<T> = OLattice<T1>
   template<class T1>
-  OLattice(const OLattice<T1>& rhs)
+  OLattice(const OLattice<T1>& rhs) : lay(rhs.layout())
     {
       alloc_mem("construct from OLattice");
       this->assign(rhs);
@@ -297,7 +333,7 @@ public:
 
   //! conversion by constructor  OLattice = Expr
   template<class RHS, class T1>
-  OLattice(const QDPExpr<RHS, OLattice<T1> >& rhs)
+  OLattice(const QDPExpr<RHS, OLattice<T1> >& rhs) : lay(forEach(rhs, LayoutLeaf(), LayoutCombine()))
     {
       alloc_mem("construct from expr");
       this->assign(rhs);
@@ -358,6 +394,26 @@ public:
       return this->assign(rhs);
     }
 
+  //! Move assignment
+  /*!
+   * Swaps the storage when rhs owns its sites and this either owns its
+   * own or was moved from, on the same lattice. Views are assigned site
+   * by site as before.
+   */
+  inline
+  OLattice& operator=(OLattice&& rhs)
+    {
+      if (rhs.mem && (mem || F == nullptr) && lay == rhs.lay)
+      {
+	std::swap(F, rhs.F);
+	std::swap(mem, rhs.mem);
+	std::swap(refs, rhs.refs);
+	ver = newLatticeVersion();
+	return *this;
+      }
+      return this->assign(rhs);
+    }
+
   template<class T1>
   inline
   void operator=(const OSubLattice<T1>& rhs)
@@ -373,13 +429,50 @@ public:
 
   //---------------------------------------------------------
   //! Copy constructor
-  /*! For now, a deep copy */
-  OLattice(const OLattice& rhs)
+  /*!
+   * A deep copy, unless Allocator::setLatticeCopyOnWrite is on. Then the
+   * copy shares the sites of rhs until either of them is written, see
+   * detach(). A view on other memory is always copied.
+   */
+  OLattice(const OLattice& rhs) : lay(rhs.lay)
     {
+      if (rhs.mem && rhs.F != nullptr && QDP::Allocator::latticeCopyOnWrite())
+      {
+	if (rhs.refs == nullptr)
+	  rhs.refs = new std::atomic<int>(1);
+	++(*rhs.refs);
+
+	mem = true;
+	F = rhs.F;
+	refs = rhs.refs;
+	ver = rhs.ver;
+	return;
+      }
+
       alloc_mem("copy");
       this->assign(rhs);
     }
 
+  //! Move constructor
+  /*!
+   * Takes over the sites of rhs, which is left empty: it may then only be
+   * destroyed or move assigned to. A view on other memory is still copied.
+   */
+  OLattice(OLattice&& rhs) : mem(rhs.mem), F(rhs.F), lay(rhs.lay), refs(rhs.refs), ver(rhs.ver)
+    {
+      if (mem)
+      {
+	rhs.mem = false;
+	rhs.F = nullptr;
+	rhs.refs = nullptr;
+      }
+      else
+      {
+	alloc_mem("copy");
+	this->assign(rhs);
+      }
+    }
+
 
 public:
   //! The backdoor
@@ -389,15 +482,51 @@ public:
    */
   inline T* getF() const {return F;}
 
-  // Nop if not on QCDOC
-  inline void moveToFastMemoryHint(bool copy=false) {}
+  //! The sites, to hand to other code that may write them
+  /*! Unlike getF() a copy sharing the sites is detached first */
+  inline T* data() {detach(); return F;}
+  inline const T* data() const {return F;}
+
+  //! Does the field allocate and free its sites
+  inline bool ownsSites() const {return mem;}
+
+  //! The lattice of the sites, null for the one of Layout
+  inline const LatticeLayout* layout() const {return lay;}
+
+  //! Move the sites to the fast tier of Allocator::setFastMemory
+  /*! The values are kept when copy is true. Nothing happens without a fast tier */
+  inline void moveToFastMemoryHint(bool copy=false) {moveSites(QDP::Allocator::FAST, copy);}
+
+  //! Move the sites back to normal memory
+  inline void revertFromFastMemoryHint(bool copy=false) {moveSites(QDP::Allocator::DEFAULT, copy);}
 
-  // Nop if not on QCDOC
-  inline void revertFromFastMemoryHint(bool copy=false) {}
+  //! Give this its own sites if a copy still shares them
+  /*!
+   * Called before the sites are written: by evaluate and the other
+   * functions filling a field. Code that writes through getF() itself
+   * must call it first. It also moves the field to a new version().
+   */
+  inline void detach()
+    {
+      if (refs != nullptr)
+	unshare();
+      ver = newLatticeVersion();
+    }
+
+  //! Do the sites of this live in another field too
+  inline bool shared() const {return refs != nullptr && *refs > 1;}
+
+  //! A number for the value of the field
+  /*!
+   * Distinct for every field and changed by every detach(), so by every
+   * evaluate into it, but not by writes through elem() or getF() alone.
+   * A copy sharing the sites keeps the version.
+   */
+  inline unsigned long version() const {return ver;}
   
   
 public:
-  inline T& elem(int i) {return F[i];}
+  inline T& elem(int i) {if (refs != nullptr) unshare(); return F[i];}
   inline const T& elem(int i) const {return F[i];}
 
 
@@ -412,34 +541,103 @@ private:
   inline void alloc_mem(const char* const p) 
     {
       mem=true;
+      ver=newLatticeVersion();
       // Barfs if allocator fails
-      size_t NSites = static_cast<size_t>(Layout::sitesOnNode());
+      size_t NSites = static_cast<size_t>(lay ? lay->sitesOnNode() : Layout::sitesOnNode());
       try
       {
-    	  F=(T*)QDP::Allocator::theQDPAllocator::Instance().allocate(sizeof(T)*NSites,QDP::Allocator::DEFAULT);
+	F=(T*)QDP::Allocator::arenaAllocate(sizeof(T)*NSites);
+	if (F == nullptr)
+    	  F=(T*)QDP::Allocator::theQDPAllocator::Instance().allocate(sizeof(T)*NSites,QDP::Allocator::latticeHint());
       }
       catch(std::bad_alloc) {
-    	  QDPIO::cerr << "Allocation failed in OLattice alloc_mem" << std::endl;
+    	  QDPIO::cerr << "Allocation failed in OLattice alloc_mem: " << p << ", " << sizeof(T)*NSites << " bytes" << std::endl;
+    	  QDP::Allocator::printAllocStats();
     	  QDP::Allocator::theQDPAllocator::Instance().dump();
 
 	QDP_abort(1);
       }
 
-#if 0
-      // Nuke touch for now
+      if (QDP::Allocator::latticeTrace())
+	QDP::Allocator::Stats::noteLattice(p, sizeof(T)*NSites, sizeof(T));
+
+      // Put the pages near the threads that will work on them
+      if (QDP::Allocator::getLatticePlacement() != QDP::Allocator::PLACE_LAZY)
+	QDP::Allocator::placeLatticeMem(F, sizeof(T), NSites, QDP::Allocator::latticeHint());
+
+    }
+
+  //! Copy the shared sites into storage of this field alone
+  void unshare()
+    {
+      if (--(*refs) == 0)
+      {
+	// The other copies are gone, so the sites are this field's
+	delete refs;
+	refs = nullptr;
+	return;
+      }
+
+      refs = nullptr;
+      const T* src = F;
+      alloc_mem("detach");
+
+      const int NSites = lay ? lay->sitesOnNode() : Layout::sitesOnNode();
 #pragma omp parallel for
-        for(int j=0; j < NSites; ++j) {
-             *((char *)&F[j])=0;
-        }
-#endif
+      for(int i=0; i < NSites; ++i)
+	F[i] = src[i];
+    }
+
+  //! Put the sites in new storage allocated with hint
+  void moveSites(QDP::Allocator::MemoryPoolHint hint, bool copy)
+    {
+      if (!mem || F == nullptr || !QDP::Allocator::fastMemory())
+	return;
+      if (refs != nullptr)
+	unshare();
+
+      const int NSites = lay ? lay->sitesOnNode() : Layout::sitesOnNode();
+      T* src = F;
+      T* dst;
+      try
+      {
+	dst = (T*)QDP::Allocator::theQDPAllocator::Instance().allocate(sizeof(T)*NSites, hint);
+      }
+      catch(std::bad_alloc) {
+	return;   // stays where it is
+      }
+
+      if (copy)
+      {
+#pragma omp parallel for
+	for(int i=0; i < NSites; ++i)
+	  dst[i] = src[i];
+      }
+      else
+	ver = newLatticeVersion();
 
+      F = dst;
+      if (! QDP::Allocator::arenaFree(src))
+	QDP::Allocator::theQDPAllocator::Instance().free(src);
     }
 
   //! Internal memory free
   inline void free_mem() 
   {
     if (!mem) return;
-    if( F != nullptr )
+
+    // Shared sites go with the last field holding them
+    if (refs != nullptr && --(*refs) > 0)
+    {
+      refs = nullptr;
+      mem = false;
+      F = nullptr;
+      return;
+    }
+    delete refs;
+    refs = nullptr;
+
+    if( F != nullptr && ! QDP::Allocator::arenaFree(F) )
     { 
     	QDP::Allocator::theQDPAllocator::Instance().free(F);
 
@@ -454,16 +652,63 @@ public:
   void print_info(char *name)
     {
       QDP_info("Info: %s = OLattice[%d]=0x%x, this=0x%xn",
-	       name,Layout::sitesOnNode(),(void *)F,this);
+	       name,lay ? lay->sitesOnNode() : Layout::sitesOnNode(),(void *)F,this);
     }
 
 
 private:
   bool mem;
   T *F; // Alias to current memory space
+  const LatticeLayout* lay = nullptr;
+  mutable std::atomic<int>* refs = nullptr;  // fields sharing F, null if only this one
+  unsigned long ver = 0;                     // see version()
 };
 
 
+//! The subset of every site of the lattice of x
+template<class T>
+inline const Subset& allSites(const OLattice<T>& x)
+{
+  return x.layout() ? x.layout()->all() : all;
+}
+
+
+//! dest, ready to be written
+/*! A field sharing its sites with a copy gets its own first, see OLattice::detach */
+template<class C>
+inline C& writable(C& dest)
+{
+  return dest;
+}
+
+template<class T>
+inline OLattice<T>& writable(OLattice<T>& dest)
+{
+  dest.detach();
+  return dest;
+}
+
+
+namespace Hints
+{
+  //! Move the sites of x to the fast tier, see OLattice::moveToFastMemoryHint
+  template<class T>
+  inline void moveToFastMemoryHint(OLattice<T>& x, bool copy=false) {x.moveToFastMemoryHint(copy);}
+
+  //! Move the sites of x back to normal memory
+  template<class T>
+  inline void revertFromFastMemoryHint(OLattice<T>& x, bool copy=false) {x.revertFromFastMemoryHint(copy);}
+
+  //! Move every lattice field of x, the gauge links say, to the fast tier
+  template<class T>
+  inline void moveToFastMemoryHint(multi1d<T>& x, bool copy=false) {x.moveToFastMemoryHint(copy);}
+
+  //! Move every lattice field of x back to normal memory
+  template<class T>
+  inline void revertFromFastMemoryHint(multi1d<T>& x, bool copy=false) {x.revertFromFastMemoryHint(copy);}
+}
+
+
 /*! @} */  // end of group olattice
 
 
@@ -521,9 +766,36 @@ template<class T>
 struct LeafFunctor<OLattice<T>, EvalLeaf1>
 {
 //  typedef T Type_t;
-  typedef Reference<T> Type_t;
+  typedef typename SiteLoad<T>::Type_t Type_t;
   inline static Type_t apply(const OLattice<T> &a, const EvalLeaf1 &f)
-    {return Type_t(a.elem(f.val1()));}
+    {return SiteLoad<T>::load(a.elem(f.val1()));}
+};
+
+
+template<class T>
+struct LeafFunctor<OLattice<T>, LayoutLeaf>
+{
+  typedef const LatticeLayout* Type_t;
+  inline static Type_t apply(const OLattice<T> &a, const LayoutLeaf &f)
+    {return a.layout();}
+};
+
+
+// A lattice field read through a shift
+template<class T>
+struct LeafFunctor<OLattice<T>, DestAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const OLattice<T> &a, const DestAliasLeaf &f)
+    {return f.shifted && (const void *)a.getF() == f.dest;}
+};
+
+template<class T>
+struct LeafFunctor<OLattice<T>, ReadsFieldLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const OLattice<T> &a, const ReadsFieldLeaf &f)
+    {return (const void *)a.getF() == f.field;}
 };
 
 
@@ -544,6 +816,14 @@ struct WordType<OLattice<T> >
   typedef typename WordType<T>::Type_t  Type_t;
 };
 
+//! An OScalar is written as the words of its element
+template<class T>
+struct BinaryBulk<OScalar<T> >
+{
+  enum {value = (sizeof(OScalar<T>) == sizeof(T))};
+  typedef typename WordType<T>::Type_t  Word_t;
+};
+
 template<class T> 
 struct SinglePrecType<OScalar<T> >
 {
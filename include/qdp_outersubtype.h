@@ -89,7 +89,19 @@ private:
 //-------------------------------------------------------------------------------------
 //! OLattice class narrowed to a subset
 /*! 
- * Only used for lvalues
+ * Either a view of the sites of a subset of an OLattice, x[rb[0]], or
+ * a field owning storage for only the sites of the subset, in the order
+ * of its site table:
+ *
+ *   SubLatticeFermion psi_e(rb[0]), chi_o(rb[1]);
+ *   chi_o = u[mu] * shift(psi_e, FORWARD, mu);
+ *   psi_e = psi_e + a * shift(chi_o, BACKWARD, mu);
+ *   Double r = norm2(psi_e);
+ *
+ * Such compact fields enter expressions like any field. Site i is read
+ * at position getSet().sitePositions()[i] of the storage, so an
+ * expression is evaluated on the subset a compact field lives on, or
+ * reads it through a shift from there.
  */
 template<class T> 
 class OSubLattice: public QDPSubType<T, OLattice<T> >
@@ -98,15 +110,15 @@ class OSubLattice: public QDPSubType<T, OLattice<T> >
 
 public:
   //OSubLattice(OLattice<T>& a, const Subset& ss): F(a.getF()), s(ss), ownsMemory(false) {}
-  OSubLattice(OLattice<T>& a, const Subset& ss): F(a.getF()), s(&(const_cast<Subset&>(ss))), ownsMemory(false) {}
+  OSubLattice(OLattice<T>& a, const Subset& ss): F(writable(a).getF()), s(&(const_cast<Subset&>(ss))), ownsMemory(false), pos(0) {}
   OSubLattice(const OSubLattice& a) {
     ownsMemory = a.ownsMemory; 
     s = a.s;
+    pos = a.pos;
     if (a.ownsMemory) {
       //std::cout << "OSubLattice copy ctor, must copy\n";
       alloc_mem();
-      for( int i = 0 ; i < s->numSiteTable() ; ++i )
-	F[i] = a.F[i];
+      copySites(F, a.F, s->numSiteTable());
     } else {
       F = a.F;
     }
@@ -114,7 +126,7 @@ public:
 
 
 #if 1
-  OSubLattice(): s(NULL), F(NULL), ownsMemory(false) {}
+  OSubLattice(): s(NULL), F(NULL), ownsMemory(false), pos(0) {}
 
 
   void setSubset( const Subset& ss ) {
@@ -129,13 +141,15 @@ public:
   }
 
 
+  //! Uninitialized field stored on the sites of ss only
+  explicit OSubLattice(const Subset& ss): s(&(const_cast<Subset&>(ss))), ownsMemory(true) {
+    alloc_mem();
+  }
+
+
   OSubLattice(const Subset& ss , OLattice<T>& a): s(&(const_cast<Subset&>(ss))), ownsMemory(true) {
     alloc_mem();
-    const int *tab = s->siteTable().slice();
-    for( int j = 0 ; j < s->numSiteTable() ; ++j ) {
-      int i = tab[j];
-      F[j] = a.elem(i);
-    }
+    gatherSites(F, a.getF(), *s);
   }
 
 
@@ -144,6 +158,7 @@ public:
     try 
       {
     	F = (T*)QDP::Allocator::theQDPAllocator::Instance().allocate(sizeof(T)*s->numSiteTable(),QDP::Allocator::DEFAULT);
+    	pos = s->getSet().sitePositions().slice();
       }
       catch(std::bad_alloc) 
       {
@@ -218,16 +233,76 @@ public:
   //const Subset& subset() const {return s;}
   const Subset& subset() const {return *s;}
 
+  //! Element of the storage holding site i, see Set::sitePositions
+  /*! Null for a view, whose storage is indexed by the site itself */
+  const int* sitePos() const {return pos;}
+
 private:
   T* F;
   bool ownsMemory;
   Subset* s;
+  const int* pos;
 
   //C&      F;
   //const Subset& s;
 };
 
 
+//-----------------------------------------------------------------------------
+// Specialization of LeafFunctor class for applying the EvalLeaf1
+// tag to a subtype. A view is indexed by the site, compact storage
+// through the positions of the sites in the site table.
+//-----------------------------------------------------------------------------
+
+template<class T>
+struct LeafFunctor<QDPSubType<T,OScalar<T> >, EvalLeaf1>
+{
+  typedef Reference<T> Type_t;
+  inline static Type_t apply(const QDPSubType<T,OScalar<T> > &a, const EvalLeaf1 &f)
+    {return Type_t(*a.getF());}
+};
+
+template<class T>
+struct LeafFunctor<QDPSubType<T,OLattice<T> >, EvalLeaf1>
+{
+  typedef typename SiteLoad<T>::Type_t Type_t;
+  inline static Type_t apply(const QDPSubType<T,OLattice<T> > &a, const EvalLeaf1 &f)
+    {
+      const int* pos = static_cast<const OSubLattice<T>&>(a).sitePos();
+      const int i = f.val1();
+      return SiteLoad<T>::load(a.getF()[pos ? pos[i] : i]);
+    }
+};
+
+
+//! Call f(d, s) with d an OLattice holding the sites of the subset s of dd
+/*!
+ * A view hands over the field it looks at. Compact storage is copied
+ * into a full field first when read is set and back when write is set,
+ * so this is for random numbers and I/O rather than work in a loop.
+ */
+template<class T, class F>
+void withFullField(const OSubLattice<T>& dd, bool read, bool write, const F& f)
+{
+  const Subset& s = dd.subset();
+  if (! dd.getOwnsMemory())
+  {
+    OLattice<T> d(dd.getF(), 1.0);
+    f(d, s);
+    return;
+  }
+
+  OLattice<T> d;
+  if (read)
+    scatterSites(d.getF(), dd.getF(), s);
+
+  f(d, s);
+
+  if (write)
+    gatherSites(dd.getF(), d.getF(), s);
+}
+
+
 //-----------------------------------------------------------------------------
 // Traits class for returning the subset-ted class name of a outer grid class
 //-----------------------------------------------------------------------------
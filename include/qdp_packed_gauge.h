@@ -0,0 +1,505 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Gauge and clover fields packed by checkerboard for the hopping term
+ */
+
+#ifndef QDP_PACKED_GAUGE_H
+#define QDP_PACKED_GAUGE_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  template<class T> class PackedGauge;
+
+  namespace PackedGaugeInternal
+  {
+    using WilsonHopInternal::bit;
+    using WilsonHopInternal::sitePtr;
+
+    //! Arguments of the threaded parts of wilsonHop with packed links
+    template<class T>
+    struct Args
+    {
+      typedef PSpinVector< PColorVector< RComplex<T>, Nc>, Ns>        F_t;
+      typedef typename UnaryReturn<F_t, FnSpinProjectDir0Minus>::Type_t  H;
+      typedef typename PackedGauge<T>::Link_t                          Link_t;
+      typedef PCompressedSU3_12<T>                                     Link12_t;
+
+      F_t* chi;
+      const F_t* psi;
+      const Link_t* full;            // links of the checkerboard, 2*Nd per site
+      const Link12_t* comp;          // or the same compressed
+      const int* sites;              // site of each packed position
+      const int* list;               // positions worked on, null for all
+      const int* goff[2][Nd];        // source of each site, [0] backward [1] forward
+      H* face[2][Nd];                // half spinors to send, then those received
+      const unsigned char* flags;    // off-node neighbours of each site, or null
+      int isign;
+      int mu;                        // direction filled by faceKernel
+    };
+
+    //! Project the sites others need for the forward and backward maps in mu
+    /*!
+     * Unlike WilsonHopInternal::faceKernel no link is applied: the node
+     * receiving the face has U_mu(x-mu)^dag among its own links.
+     */
+    template<class T>
+    void faceKernel(int lo, int hi, int myId, Args<T>* a)
+    {
+      using WilsonHopInternal::project;
+      const int mu = a->mu;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int y = a->list[j];
+	if (a->flags[y] & bit(0,mu))
+	  a->face[1][mu][y] = project(a->psi[y], mu, -a->isign);
+	if (a->flags[y] & bit(1,mu))
+	  a->face[0][mu][y] = project(a->psi[y], mu, a->isign);
+      }
+    }
+
+    //! Link k of packed position j
+    template<class T, bool Compressed>
+    inline typename Args<T>::Link_t link(const Args<T>* a, int j, int k)
+    {
+      if (Compressed)
+	return a->comp[size_t(j)*2*Nd + k].reconstruct();
+      else
+	return a->full[size_t(j)*2*Nd + k];
+    }
+
+    //! The hopping term on the positions list[lo..hi), or lo..hi when there is no list
+    /*!
+     * The links of a site follow each other and the sites follow the
+     * packed order, so they are read as one stream.
+     */
+    template<class T, bool Compressed>
+    void hopKernel(int lo, int hi, int myId, Args<T>* a)
+    {
+      using WilsonHopInternal::project;
+      using WilsonHopInternal::reconstruct;
+      typedef typename Args<T>::F_t  F_t;
+      typedef typename Args<T>::H    H;
+      const int isign = a->isign;
+
+      for(int i=lo; i < hi; ++i)
+      {
+	int j = a->list ? a->list[i] : i;
+	int x = a->sites[j];
+	unsigned char f = (a->flags == 0) ? 0 : a->flags[x];
+
+	F_t acc;
+	zero_rep(acc);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  // (1 - isign gamma_mu) U_mu(x) psi(x+mu)
+	  H h = (f & bit(1,mu)) ? a->face[1][mu][x] : project(a->psi[a->goff[1][mu][x]], mu, -isign);
+	  acc += reconstruct(link<T,Compressed>(a, j, 2*mu) * h, mu, -isign);
+
+	  // (1 + isign gamma_mu) U_mu(x-mu)^dag psi(x-mu)
+	  h = (f & bit(0,mu)) ? a->face[0][mu][x] : project(a->psi[a->goff[0][mu][x]], mu, isign);
+	  acc += reconstruct(link<T,Compressed>(a, j, 2*mu+1) * h, mu, isign);
+	}
+
+	a->chi[x] = acc;
+      }
+    }
+  }
+
+
+  //! Gauge links (and a clover term) packed by checkerboard for the hopping term
+  /*!
+   * Made once per configuration, the copy holds for each site of rb[0]
+   * and then of rb[1], in the order of their site tables,
+   *
+   *   U_0(x), U_0(x-0)^dag, U_1(x), U_1(x-1)^dag, ...
+   *
+   * the backward links already shifted and conjugated. wilsonHop with a
+   * PackedGauge then reads the links of a checkerboard front to back
+   * with no shift or adj of a link, and sends only projected half
+   * spinors to other nodes. With compress the links are kept as 12
+   * reals (PCompressedSU3_12), which needs SU(3) links; the full copy
+   * takes twice the memory of the links.
+   *
+   *   PackedGauge<REAL> g;
+   *   g.pack(u);                      // again whenever u changes, which drops the clover term
+   *   g.packClover(ainv);             // optional
+   *   wilsonHop(chi, g, psi, isign, cb);
+   *   g.applyClover(psi2, chi, cb);
+   *
+   * The site tables and the face lists of both checkerboards are also
+   * made by pack, so an application costs only its kernels and the
+   * exchange of the faces.
+   */
+  template<class T>
+  class PackedGauge
+  {
+  public:
+    typedef PScalar< PColorMatrix< RComplex<T>, Nc> >                 Link_t;
+    typedef PCompressedSU3_12<T>                                      Link12_t;
+    typedef PackedCloverSite<T>                                       Clover_t;
+    typedef OLattice< PSpinVector< PColorVector< RComplex<T>, Nc>, Ns> > Fermion_t;
+
+    PackedGauge() : full(0), comp(0), clov(0), compressed(false), face(false) {offset[0] = offset[1] = offset[2] = 0;}
+    ~PackedGauge() {free_mem();}
+
+    //! Pack the links u, compressed to 12 reals or not
+    template<class T2>
+    void pack(const multi1d< OLattice< PScalar< PColorMatrix< RComplex<T2>, Nc> > > >& u, bool compress = false)
+      {
+	typedef PScalar< PColorMatrix< RComplex<T2>, Nc> > U2;
+
+	if (Nd != 4 || Ns != 4)
+	  QDP_error_exit("PackedGauge: needs Nd = Ns = 4");
+
+	if (u.size() != Nd)
+	  QDP_error_exit("PackedGauge: need Nd gauge links, have %d", u.size());
+
+	if (compress && Nc != 3)
+	  QDP_error_exit("PackedGauge: compression needs Nc = 3, have %d", Nc);
+
+	makeTables();
+
+	free_mem();
+	compressed = compress;
+	if (compressed)
+	  comp = (Link12_t*)allocate(size_t(numSites())*2*Nd*sizeof(Link12_t));
+	else
+	  full = (Link_t*)allocate(size_t(numSites())*2*Nd*sizeof(Link_t));
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  OLattice<U2> back = adj(shift(u[mu], BACKWARD, mu));
+
+	  PackArgs<U2> fwd(this, u[mu].getF(), 2*mu);
+	  dispatch_to_threads(numSites(), fwd, packKernel<U2>);
+
+	  PackArgs<U2> bwd(this, back.getF(), 2*mu+1);
+	  dispatch_to_threads(numSites(), bwd, packKernel<U2>);
+	}
+      }
+
+    //! Keep the clover term c in the packed order too
+    void packClover(const PackedClover<T>& c)
+      {
+	if (numSites() == 0)
+	  QDP_error_exit("PackedGauge: pack the links before the clover term");
+
+	if (clov == 0)
+	  clov = (Clover_t*)allocate(size_t(numSites())*sizeof(Clover_t));
+
+	CloverArgs a(this, &c, 0, 0, 0);
+	dispatch_to_threads(numSites(), a, cloverPackKernel);
+      }
+
+    //! chi = A psi on rb[cb] with the clover term of packClover
+    void applyClover(Fermion_t& chi, const Fermion_t& psi, int cb) const
+      {
+	if (clov == 0)
+	  QDP_error_exit("PackedGauge: no clover term packed");
+
+	CloverArgs a(this, 0, writable(chi).getF(), psi.getF(), cb);
+	dispatch_to_threads(numSites(cb), a, cloverApplyKernel);
+      }
+
+    //! Are the links kept as 12 reals
+    bool isCompressed() const {return compressed;}
+
+    //! Is there a clover term
+    bool hasClover() const {return clov != 0;}
+
+    //! Reals per link as stored
+    int linkWords() const {return compressed ? Link12_t::Reals : 2*Nc*Nc;}
+
+    //! Sites of the node, or of rb[cb]
+    int numSites() const {return offset[2];}
+    int numSites(int cb) const {return offset[cb+1] - offset[cb];}
+
+    //! Link k of packed position j of rb[cb], k = 2*mu forward and 2*mu+1 backward
+    Link_t link(int cb, int j, int k) const
+      {
+	size_t i = size_t(offset[cb] + j)*2*Nd + k;
+	return compressed ? comp[i].reconstruct() : full[i];
+      }
+
+    //! The links of rb[cb], 2*Nd per site, null when compressed
+    const Link_t* fullLinks(int cb) const {return full ? full + size_t(offset[cb])*2*Nd : 0;}
+
+    //! The compressed links of rb[cb], null when not compressed
+    const Link12_t* compressedLinks(int cb) const {return comp ? comp + size_t(offset[cb])*2*Nd : 0;}
+
+    //! Site of each packed position of rb[cb]
+    const int* sites(int cb) const {return &site[offset[cb]];}
+
+    //! Off-node neighbours of each site of the node, as WilsonHopInternal::bit
+    const unsigned char* flags() const {return flag.empty() ? 0 : &flag[0];}
+
+    //! Is any neighbour off-node
+    bool hasFace() const {return face;}
+
+    //! Positions of rb[cb] needing nothing from another node
+    const std::vector<int>& inner(int cb) const {return inner_pos[cb];}
+
+    //! Positions of rb[cb] needing a face
+    const std::vector<int>& outer(int cb) const {return outer_pos[cb];}
+
+    //! Sites of rb[cb] others need
+    const std::vector<int>& senders(int cb) const {return send_sites[cb];}
+
+  private:
+    //! Hide copies
+    PackedGauge(const PackedGauge&);
+    void operator=(const PackedGauge&);
+
+    //! Site order, the off-node neighbours and the face lists
+    void makeTables()
+      {
+	const int nodeSites = Layout::sitesOnNode();
+
+	site.clear();
+	for(int cb=0; cb < 2; ++cb)
+	{
+	  offset[cb] = site.size();
+	  const int* tab = rb[cb].siteTable().slice();
+	  site.insert(site.end(), tab, tab + rb[cb].numSiteTable());
+	}
+	offset[2] = site.size();
+
+	// A site of rb[cb] flagged in (dir,mu) reads a face; one of
+	// rb[1-cb] flagged in (dir,mu) is sent the other way
+	flag.assign(nodeSites, 0);
+	face = false;
+	for(int mu=0; mu < Nd; ++mu)
+	  for(int dir=0; dir < 2; ++dir)
+	  {
+	    const Subset& b = shift.getMap(2*dir-1, mu).boundary(all);
+	    const int* tab = b.siteTable().slice();
+	    for(int j=0; j < b.numSiteTable(); ++j)
+	      flag[tab[j]] |= WilsonHopInternal::bit(dir,mu);
+
+	    face = face || (b.numSiteTable() > 0);
+	  }
+
+	for(int cb=0; cb < 2; ++cb)
+	{
+	  inner_pos[cb].clear();
+	  outer_pos[cb].clear();
+	  send_sites[cb].clear();
+	  for(int j=0; j < numSites(cb); ++j)
+	  {
+	    const int x = site[offset[cb] + j];
+	    (flag[x] ? outer_pos[cb] : inner_pos[cb]).push_back(j);
+	    if (flag[x])
+	      send_sites[cb].push_back(x);
+	  }
+	}
+      }
+
+    //! user argument for pack
+    template<class U2>
+    struct PackArgs
+    {
+      PackArgs(PackedGauge* g_, const U2* u_, int k_) : g(g_), u(u_), k(k_) {}
+
+      PackedGauge* g;
+      const U2* u;
+      int k;
+    };
+
+    //! user function for pack, link k of every position from u at its site
+    template<class U2>
+    static void packKernel(int lo, int hi, int myId, PackArgs<U2>* p)
+      {
+	PackedGauge& g = *p->g;
+
+	for(int j=lo; j < hi; ++j)
+	{
+	  const U2& s = p->u[g.site[j]];
+	  Link_t d;
+	  for(int i=0; i < Nc; ++i)
+	    for(int k=0; k < Nc; ++k)
+	    {
+	      d.elem().elem(i,k).real() = s.elem().elem(i,k).real();
+	      d.elem().elem(i,k).imag() = s.elem().elem(i,k).imag();
+	    }
+
+	  const size_t i = size_t(j)*2*Nd + p->k;
+	  if (g.compressed)
+	    g.comp[i].compress(d);
+	  else
+	    g.full[i] = d;
+	}
+      }
+
+    //! user argument for the clover term
+    struct CloverArgs
+    {
+      typedef typename Fermion_t::Subtype_t F_t;
+
+      CloverArgs(const PackedGauge* g_, const PackedClover<T>* c_, F_t* chi_, const F_t* psi_, int cb_) :
+	g(g_), c(c_), chi(chi_), psi(psi_), cb(cb_) {}
+
+      const PackedGauge* g;
+      const PackedClover<T>* c;
+      F_t* chi;
+      const F_t* psi;
+      int cb;
+    };
+
+    //! user function for packClover
+    static void cloverPackKernel(int lo, int hi, int myId, CloverArgs* p)
+      {
+	PackedGauge& g = const_cast<PackedGauge&>(*p->g);
+	for(int j=lo; j < hi; ++j)
+	  g.clov[j] = p->c->elem(g.site[j]);
+      }
+
+    //! user function for applyClover, the terms of rb[cb] read front to back
+    static void cloverApplyKernel(int lo, int hi, int myId, CloverArgs* p)
+      {
+	const int* tab = p->g->sites(p->cb);
+	const Clover_t* c = p->g->clov + p->g->offset[p->cb];
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int x = tab[j];
+	  PackedClover<T>::applySite(p->chi[x], c[j], p->psi[x]);
+	}
+      }
+
+    static void* allocate(size_t bytes)
+      {
+	try
+	{
+	  return QDP::Allocator::theQDPAllocator::Instance().allocate(bytes, QDP::Allocator::DEFAULT);
+	}
+	catch(std::bad_alloc) {
+	  QDPIO::cerr << "Allocation failed in PackedGauge: " << bytes << " bytes" << std::endl;
+	  QDP::Allocator::printAllocStats();
+	  QDP_abort(1);
+	}
+	return 0;
+      }
+
+    void free_mem()
+      {
+	if (full)
+	  QDP::Allocator::theQDPAllocator::Instance().free(full);
+	if (comp)
+	  QDP::Allocator::theQDPAllocator::Instance().free(comp);
+	if (clov)
+	  QDP::Allocator::theQDPAllocator::Instance().free(clov);
+	full = 0;
+	comp = 0;
+	clov = 0;
+      }
+
+    Link_t* full;
+    Link12_t* comp;
+    Clover_t* clov;
+    bool compressed;
+
+    int offset[3];                       // first position of rb[0], rb[1], and the end
+    std::vector<int> site;
+    std::vector<unsigned char> flag;
+    bool face;
+    std::vector<int> inner_pos[2], outer_pos[2], send_sites[2];
+  };
+
+
+  //! Wilson hopping term on rb[cb] with packed links
+  /*!
+   * The same as wilsonHop(chi, u, psi, isign, rb[cb]) for the u packed
+   * in g, up to the rounding of the compressed links. Only the half
+   * spinors of the sites of rb[1-cb] on the faces are projected and
+   * exchanged; the interior of rb[cb] is done while they are in flight.
+   *
+   * chi must not be psi.
+   */
+  template<class T>
+  void wilsonHop(typename PackedGauge<T>::Fermion_t& chi, const PackedGauge<T>& g,
+		 const typename PackedGauge<T>::Fermion_t& psi, int isign, int cb)
+  {
+    using namespace PackedGaugeInternal;
+    typedef typename Args<T>::H  H;
+
+    if (&chi == &psi)
+      QDP_error_exit("wilsonHop: chi may not be psi");
+
+    if (g.numSites() == 0)
+      QDP_error_exit("wilsonHop: the PackedGauge has no links");
+
+    Args<T> a;
+    a.chi   = writable(chi).getF();
+    a.psi   = psi.getF();
+    a.full  = g.fullLinks(cb);
+    a.comp  = g.compressedLinks(cb);
+    a.sites = g.sites(cb);
+    a.isign = isign;
+
+    for(int mu=0; mu < Nd; ++mu)
+      for(int dir=0; dir < 2; ++dir)
+	a.goff[dir][mu] = shift.getMap(2*dir-1, mu).goffset().slice();
+
+    void (*kernel)(int, int, int, Args<T>*) =
+      g.isCompressed() ? hopKernel<T,true> : hopKernel<T,false>;
+
+    if (! g.hasFace())
+    {
+      // Everything is on the node, the whole checkerboard in order
+      a.list  = 0;
+      a.flags = 0;
+      dispatch_to_threads(g.numSites(cb), a, kernel);
+      return;
+    }
+
+    // Project the faces of the other checkerboard and launch them
+    multi2d< OLattice<H> > faces(2, Nd);
+    std::vector< MapHandle<H> > handles;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      a.face[0][mu] = &faces(0,mu).elem(0);
+      a.face[1][mu] = &faces(1,mu).elem(0);
+    }
+
+    const std::vector<int>& senders = g.senders(1-cb);
+    a.list  = sitePtr(senders);
+    a.flags = g.flags();
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      a.mu = mu;
+      dispatch_to_threads(senders.size(), a, faceKernel<T>);
+
+      for(int dir=0; dir < 2; ++dir)
+	handles.push_back(shift.start(faces(dir,mu), 2*dir-1, mu));
+    }
+
+    // Interior sites while the faces are in flight
+    a.list  = sitePtr(g.inner(cb));
+    a.flags = 0;
+    dispatch_to_threads(g.inner(cb).size(), a, kernel);
+
+    // Then the sites that need a face
+    for(int mu=0, k=0; mu < Nd; ++mu)
+      for(int dir=0; dir < 2; ++dir, ++k)
+	handles[k].finishBoundary(faces(dir,mu));
+
+    a.list  = sitePtr(g.outer(cb));
+    a.flags = g.flags();
+    dispatch_to_threads(g.outer(cb).size(), a, kernel);
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
@@ -1,12 +1,46 @@
 #ifndef QDP_GLOBAL_SUM_H
 #define QDP_GLOBAL_SUM_H
- 
+
 #include <qmp.h>
- 
+
 namespace QDPGlobalSums {
   QMP_status_t QDP_sum_int(int *i);
   QMP_status_t QDP_sum_float_array(float *x, int length);
   QMP_status_t QDP_sum_double_array(double *x, int length);
+
+  //! Sum x[0..length) with sumTDirection along each machine direction
+  /*! The same as QDP_sum_double_array built with USE_QDP_QMP_GLOBAL_SUM */
+  QMP_status_t QDP_sum_double_array_ordered(double *x, int length);
+
+  //! Sum the per-slice arrays x[nslice*words] of the slices in direction dir
+  /*!
+   * Slice k is x[k*words .. (k+1)*words). The slices of a node are only
+   * held by the nodes with the same coordinate in dir, so they are summed
+   * over those first, a message of nslice/P words for P nodes in dir,
+   * and then gathered along dir. The entries of slices a node does not
+   * hold are taken as zero. Like sumTDirection the result is the same on
+   * all nodes and from run to run.
+   */
+  QMP_status_t QDP_sum_slices(double *x, int words, int nslice, int dir);
+  QMP_status_t QDP_sum_slices(float *x, int words, int nslice, int dir);
+
+  //! A global sum of a double array in flight
+  struct AsyncSum;
+
+  //! Start summing x[0..length) over all nodes
+  /*!
+   * x must stay untouched until finishSum. With reproducible set every
+   * node adds the contributions in the same order, as sumTDirection does,
+   * so the result is binary identical everywhere. Without a non-blocking
+   * transport the sum is done here and finishSum only tidies up.
+   */
+  AsyncSum* startSum(double *x, int length, bool reproducible);
+
+  //! Poll for completion without blocking
+  bool testSum(AsyncSum *s);
+
+  //! Wait for the sum, leave the result in x and free s
+  void finishSum(AsyncSum *s);
 };
- 
+
 #endif
@@ -8,6 +8,13 @@
 #define QDP_PARSCALAR_SPECIFIC_H
 
 #include "qmp.h"
+#include "qdp_parscalar_global_sum.h"
+#include "qdp_node_shm.h"
+#include "qdp_node_rma.h"
+#include "qdp_progress.h"
+#include <vector>
+#include <map>
+#include <limits>
 
 namespace QDP {
 
@@ -40,6 +47,10 @@ namespace QDPInternal
 	//! Receive from another node (wait)
 	void recvFromWait(void *recv_buf, int srce_node, int count);
 
+	//! Send send_bytes[q] bytes to each node q and receive recv_bytes[q] from each
+	/*! All nodes participate. The blocks lie in node order in send and recv */
+	void exchangeAll(const char* send, const size_t* send_bytes, char* recv, const size_t* recv_bytes);
+
 	//! Via some mechanism, get the dest to node 0
 	/*! Ultimately, I do not want to use point-to-point */
 	template<class T>
@@ -64,27 +75,38 @@ namespace QDPInternal
 	//! Wrapper to get a functional unsigned global sum
 	inline void globalSumArray(unsigned int *dest, int len)
 	{
+		QDPTime_t t0 = getClockTime();
 		for(int i=0; i < len; i++, dest++)
 			QMP_binary_reduction(dest, sizeof(unsigned int), sumAnUnsigned);
+		CommStats::Stats::noteCollective(CommStats::Reduction, len*sizeof(unsigned int), t0, getClockTime());
 	}
 
 	//! Low level hook to QMP_global_sum
 	inline void globalSumArray(int *dest, int len)
 	{
-		for(int i=0; i < len; i++, dest++)
-			QMP_sum_int(dest);
+		QDPTime_t t0 = getClockTime();
+		if (! NodeShm::globalSum(dest, len))
+			for(int i=0; i < len; i++, dest++)
+				QMP_sum_int(dest);
+		CommStats::Stats::noteCollective(CommStats::Reduction, len*sizeof(int), t0, getClockTime());
 	}
 
 	//! Low level hook to QMP_global_sum
 	inline void globalSumArray(float *dest, int len)
 	{
-		QMP_sum_float_array(dest, len);
+		QDPTime_t t0 = getClockTime();
+		if (! NodeShm::globalSum(dest, len))
+			QMP_sum_float_array(dest, len);
+		CommStats::Stats::noteCollective(CommStats::Reduction, len*sizeof(float), t0, getClockTime());
 	}
 
 	//! Low level hook to QMP_global_sum
 	inline void globalSumArray(double *dest, int len)
 	{
-		QMP_sum_double_array(dest, len);
+		QDPTime_t t0 = getClockTime();
+		if (! NodeShm::globalSum(dest, len))
+			QMP_sum_double_array(dest, len);
+		CommStats::Stats::noteCollective(CommStats::Reduction, len*sizeof(double), t0, getClockTime());
 	}
 
 	//! Global sum on a multi1d
@@ -120,6 +142,61 @@ namespace QDPInternal
 		globalSumArray((W *)dest.slice(0), dest.size1()*dest.size2()*sizeof(T)/sizeof(W));
 	}
 
+	//! Sum the per-slice arrays of the slices in direction dir, see QDPGlobalSums::QDP_sum_slices
+	/*! Returns false, doing nothing, when a plain global sum is as good */
+	template<class W>
+	inline bool sliceSumArray(W *dest, int words, int nslice, int dir)
+	{
+		return false;
+	}
+
+	inline bool sliceSumArray(double *dest, int words, int nslice, int dir)
+	{
+		if (Layout::logicalSize()[dir] == 1 || Layout::numNodes() == Layout::logicalSize()[dir] ||
+		    nslice != Layout::lattSize()[dir])
+			return false;
+
+		QDPTime_t t0 = getClockTime();
+		QMP_status_t err = QDPGlobalSums::QDP_sum_slices(dest, words, nslice, dir);
+		if (err != QMP_SUCCESS)
+			QDP_error_exit("sliceSumArray: %s", QMP_error_string(err));
+		CommStats::Stats::noteCollective(CommStats::Reduction, size_t(words)*nslice*sizeof(double), t0, getClockTime());
+		return true;
+	}
+
+	inline bool sliceSumArray(float *dest, int words, int nslice, int dir)
+	{
+		if (Layout::logicalSize()[dir] == 1 || Layout::numNodes() == Layout::logicalSize()[dir] ||
+		    nslice != Layout::lattSize()[dir])
+			return false;
+
+		QDPTime_t t0 = getClockTime();
+		QMP_status_t err = QDPGlobalSums::QDP_sum_slices(dest, words, nslice, dir);
+		if (err != QMP_SUCCESS)
+			QDP_error_exit("sliceSumArray: %s", QMP_error_string(err));
+		CommStats::Stats::noteCollective(CommStats::Reduction, size_t(words)*nslice*sizeof(float), t0, getClockTime());
+		return true;
+	}
+
+	//! Global sum of the per-subset results of the set ss
+	/*!
+	 * For the slices of a direction, SetFunc::sliceDirection, each node
+	 * only has values for the slices of its subgrid, and those are summed
+	 * over the nodes holding them instead of every entry over all nodes.
+	 */
+	template<class T>
+	inline void globalSumArray(multi1d<T>& dest, const Set& ss)
+	{
+		typedef typename WordType<T>::Type_t	W;
+
+		const int dir = ss.sliceDirection();
+		if (dir >= 0 && dest.size() == ss.numSubsets() &&
+		    sliceSumArray((W *)dest.slice(), int(sizeof(T)/sizeof(W)), dest.size(), dir))
+			return;
+
+		globalSumArray(dest);
+	}
+
 	//! Sum across all nodes
 	template<class T>
 	inline void globalSum(T& dest)
@@ -142,20 +219,161 @@ namespace QDPInternal
 #if 0 
     QDPIO::cout << "Using simple sum_double" << endl;
 #endif
-    QMP_sum_double(&dest);
+    QDPTime_t t0 = getClockTime();
+    if (! NodeShm::globalSum(&dest, 1))
+      QMP_sum_double(&dest);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(double), t0, getClockTime());
   }
 
 
+	//! Handle on a global sum started with globalSumAsync
+	/*!
+	 * The summed values are stored in the destination by wait(). Copies
+	 * share the same sum, and the last copy to go waits if nobody did.
+	 */
+	class GlobalSumHandle
+	{
+	public:
+		GlobalSumHandle() : rep(0) {}
+
+		GlobalSumHandle(const GlobalSumHandle& h) : rep(h.rep)
+			{
+				if (rep)
+					++rep->count;
+			}
+
+		GlobalSumHandle& operator=(const GlobalSumHandle& h)
+			{
+				if (h.rep)
+					++h.rep->count;
+				release();
+				rep = h.rep;
+				return *this;
+			}
+
+		~GlobalSumHandle() {release();}
+
+		//! Has the sum arrived - never blocks
+		bool test()
+			{
+				return (rep == 0) || (rep->req == 0) || QDPGlobalSums::testSum(rep->req);
+			}
+
+		//! Wait for the sum and store it in the destination
+		void wait()
+			{
+				if (rep == 0 || rep->req == 0)
+					return;
+
+				QDPTime_t t_wait = getClockTime();
+				QDPGlobalSums::finishSum(rep->req);
+				rep->req = 0;
+				CommStats::Stats::noteCollective(CommStats::Reduction, rep->buf.size()*sizeof(double),
+								 rep->t_start, t_wait, getClockTime());
+				rep->unpack(rep->dest, &rep->buf[0], rep->buf.size());
+			}
+
+		//! Start summing dest[0..len) - the sum runs in doubles
+		template<class W>
+		static GlobalSumHandle start(W *dest, int len, bool reproducible)
+			{
+				GlobalSumHandle h;
+				h.rep = new Rep;
+				h.rep->count = 1;
+				h.rep->dest = (void *)dest;
+				h.rep->unpack = &unpackWords<W>;
+				h.rep->buf.resize(len);
+				h.rep->t_start = getClockTime();
+				for(int k=0; k < len; ++k)
+					h.rep->buf[k] = dest[k];
+
+				h.rep->req = (len > 0) ? QDPGlobalSums::startSum(&h.rep->buf[0], len, reproducible) : 0;
+				return h;
+			}
+
+	private:
+		struct Rep
+		{
+			int count;
+			QDPGlobalSums::AsyncSum *req;
+			QDPTime_t t_start;
+			void *dest;
+			void (*unpack)(void *dest, const double *buf, int len);
+			std::vector<double> buf;
+		};
+
+		template<class W>
+		static void unpackWords(void *dest, const double *buf, int len)
+			{
+				W *w = (W *)dest;
+				for(int k=0; k < len; ++k)
+					w[k] = W(buf[k]);
+			}
+
+		void release()
+			{
+				if (rep && --rep->count == 0)
+				{
+					wait();
+					delete rep;
+				}
+				rep = 0;
+			}
+
+		Rep *rep;
+	};
+
+	//! Start a global sum of dest[0..len)
+	/*! 
+	 * The result is stored at h.wait(). With reproducible set every node
+	 * adds the contributions in the same order, giving binary identical
+	 * results like the QDPGlobalSums tree sum
+	 */
+	template<class W>
+	inline GlobalSumHandle globalSumArrayAsync(W *dest, int len, bool reproducible=false)
+	{
+		return GlobalSumHandle::start(dest, len, reproducible);
+	}
+
+	//! Start a global sum on a multi1d
+	template<class T>
+	inline GlobalSumHandle globalSumArrayAsync(multi1d<T>& dest, bool reproducible=false)
+	{
+		typedef typename WordType<T>::Type_t	W;	 // find the machine word type
+
+		return GlobalSumHandle::start((W *)dest.slice(), int(dest.size()*sizeof(T)/sizeof(W)), reproducible);
+	}
+
+	//! Start a sum across all nodes
+	template<class T>
+	inline GlobalSumHandle globalSumAsync(T& dest, bool reproducible=false)
+	{
+		typedef typename WordType<T>::Type_t	W;	 // find the machine word type
+
+		return GlobalSumHandle::start((W *)&dest, int(sizeof(T)/sizeof(W)), reproducible);
+	}
+
+	//! Start a sum of a double across all nodes
+	inline GlobalSumHandle globalSumAsync(double& dest, bool reproducible=false)
+	{
+		return GlobalSumHandle::start(&dest, 1, reproducible);
+	}
+
+
   //! Low level hook to QMP_max_double
   inline void globalMaxValue(float* dest)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_max_float(dest);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(float), t0, getClockTime());
   }
 
   //! Low level hook to QMP_max_double
   inline void globalMaxValue(double* dest)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_max_double(dest);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(double), t0, getClockTime());
   }
 
 
@@ -172,13 +390,17 @@ namespace QDPInternal
   //! Low level hook to QMP_min_float
   inline void globalMinValue(float* dest)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_min_float(dest);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(float), t0, getClockTime());
   }
 
   //! Low level hook to QMP_min_double
   inline void globalMinValue(double* dest)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_min_double(dest);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(double), t0, getClockTime());
   }
 
 
@@ -192,6 +414,49 @@ namespace QDPInternal
   }
 
 
+  //! An extremum on one node and where it is
+  struct ExtremumLoc
+  {
+    double value;
+    int node;
+    int site;     // linear site on node, -1 if none
+  };
+
+  //! Larger value, ties to the lower node
+  inline void maxLoc(void* inout, void* in)
+  {
+    ExtremumLoc& a = *(ExtremumLoc*)inout;
+    const ExtremumLoc& b = *(const ExtremumLoc*)in;
+    if (b.site >= 0 && (a.site < 0 || b.value > a.value || (b.value == a.value && b.node < a.node)))
+      a = b;
+  }
+
+  //! Smaller value, ties to the lower node
+  inline void minLoc(void* inout, void* in)
+  {
+    ExtremumLoc& a = *(ExtremumLoc*)inout;
+    const ExtremumLoc& b = *(const ExtremumLoc*)in;
+    if (b.site >= 0 && (a.site < 0 || b.value < a.value || (b.value == a.value && b.node < a.node)))
+      a = b;
+  }
+
+  //! Largest value across all nodes with its node and site, in one reduction
+  inline void globalMaxLoc(ExtremumLoc& dest)
+  {
+    QDPTime_t t0 = getClockTime();
+    QMP_binary_reduction(&dest, sizeof(ExtremumLoc), maxLoc);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(ExtremumLoc), t0, getClockTime());
+  }
+
+  //! Smallest value across all nodes with its node and site, in one reduction
+  inline void globalMinLoc(ExtremumLoc& dest)
+  {
+    QDPTime_t t0 = getClockTime();
+    QMP_binary_reduction(&dest, sizeof(ExtremumLoc), minLoc);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(ExtremumLoc), t0, getClockTime());
+  }
+
+
   //! Global And
   inline void globalCheckAnd(void* inout, void* in)
   {
@@ -201,7 +466,9 @@ namespace QDPInternal
   //! Wrapper to get a functional global And
   inline void globalAnd(bool& dest)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_binary_reduction(&dest, sizeof(bool), globalCheckAnd);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(bool), t0, getClockTime());
   }
 
 
@@ -215,14 +482,18 @@ namespace QDPInternal
   //! Wrapper to get a functional global Or
   inline void globalOr(bool& dest)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_binary_reduction(&dest, sizeof(bool), globalCheckOr);
+    CommStats::Stats::noteCollective(CommStats::Reduction, sizeof(bool), t0, getClockTime());
   }
 
   //! Broadcast from primary node to all other nodes
   template<class T>
   inline void broadcast(T& dest)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_broadcast((void *)&dest, sizeof(T));
+    CommStats::Stats::noteCollective(CommStats::Broadcast, sizeof(T), t0, getClockTime());
   }
 
   //! Broadcast a string from primary node to all other nodes
@@ -231,7 +502,9 @@ namespace QDPInternal
   //! Broadcast from primary node to all other nodes
   inline void broadcast(void* dest, size_t nbytes)
   {
+    QDPTime_t t0 = getClockTime();
     QMP_broadcast(dest, nbytes);
+    CommStats::Stats::noteCollective(CommStats::Broadcast, nbytes, t0, getClockTime());
   }
 
   //! Broadcast a string from primary node to all other nodes
@@ -258,27 +531,40 @@ struct u_arg{
 				OLattice<T>& d_,
 				const QDPExpr<RHS,OScalar<T1> >& r_,
 				const Op& op_,
-				const int *tab_
-		) : d(d_), r(r_), op(op_), tab(tab_) {}
+				const int *tab_,
+				const SiteRun *runs_ = 0,
+				int nruns_ = 0
+		) : d(d_), r(r_), op(op_), tab(tab_), runs(runs_), nruns(nruns_) {}
 		
 		OLattice<T>& d;
 		const QDPExpr<RHS,OScalar<T1> >& r;
 		const Op& op;
 		const int *tab;
+		const SiteRun *runs;
+		int nruns;
 	 };
 
 //! user function for the evaluate function:
 // "OLattice Op Scalar(Expression(source)) under an Subset"
 //
 template<class T, class T1, class Op, class RHS>
-void ev_userfunc(int lo, int hi, int myId, u_arg<T,T1,Op,RHS> *a)
+QDP_SITE_KERNEL void ev_userfunc(int lo, int hi, int myId, u_arg<T,T1,Op,RHS> *a)
 {
 	 OLattice<T>& dest = a->d;
 	 const QDPExpr<RHS,OScalar<T1> >&rhs = a->r;
 	 const int* tab = a->tab;
 	 const Op& op= a->op;
 
-      
+	 // Without a site table the sites come run by run
+	 if (! tab)
+	 {
+		 forSiteRuns(a->runs, a->nruns, lo, hi, [&](int i0, int n) {
+				 for(int i=i0; i < i0+n; ++i)
+					 op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
+			 });
+		 return;
+	 }
+
 	 for(int j=lo; j < hi; ++j)
 	 {
 		 int i = tab[j];
@@ -295,19 +581,23 @@ struct user_arg{
 				OLattice<T>& d_,
 				const QDPExpr<RHS,OLattice<T1> >& r_,
 				const Op& op_,
-				const int *tab_ ) : d(d_), r(r_), op(op_), tab(tab_) {}
+				const int *tab_,
+				const SiteRun *runs_ = 0,
+				int nruns_ = 0 ) : d(d_), r(r_), op(op_), tab(tab_), runs(runs_), nruns(nruns_) {}
 
 				OLattice<T>& d;
 				const QDPExpr<RHS,OLattice<T1> >& r;
 				const Op& op;
 				const int *tab;
+				const SiteRun *runs;
+				int nruns;
 	 };
 
 //! user function for the evaluate function:
 // "OLattice Op OLattice(Expression(source)) under an Subset"
 //
 template<class T, class T1, class Op, class RHS>
-void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
+QDP_SITE_KERNEL void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
 {
 
 	 OLattice<T>& dest = a->d;
@@ -315,7 +605,16 @@ void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
 	 const int* tab = a->tab;
 	 const Op& op= a->op;
 
-      
+	 // Without a site table the sites come run by run
+	 if (! tab)
+	 {
+		 forSiteRuns(a->runs, a->nruns, lo, hi, [&](int i0, int n) {
+				 for(int i=i0; i < i0+n; ++i)
+					 op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
+			 });
+		 return;
+	 }
+
 	 for(int j=lo; j < hi; ++j)
 	 {
 		 int i = tab[j];
@@ -327,6 +626,56 @@ void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
 #include "qdp_dispatch.h"
 
 
+//! user argument for the indexed copies done by the maps
+/*!
+ * Position k runs over [lo,hi), or over tab[lo..hi) when tab is set,
+ * and out[oidx ? oidx[k] : k] = in[iidx[k]]
+ */
+template<class T1>
+struct GatherThreadArgs{
+		GatherThreadArgs(
+				T1 *out_,
+				const int *oidx_,
+				const T1 *in_,
+				const int *iidx_,
+				const int *tab_ ) : out(out_), oidx(oidx_), in(in_), iidx(iidx_), tab(tab_) {}
+
+				T1 *out;
+				const int *oidx;
+				const T1 *in;
+				const int *iidx;
+				const int *tab;
+	 };
+
+//! user function for the indexed copies done by the maps
+template<class T1>
+void gatherKernel(int lo, int hi, int myId, GatherThreadArgs<T1> *a)
+{
+	T1 *out = a->out;
+	const T1 *in = a->in;
+	const int *oidx = a->oidx;
+	const int *iidx = a->iidx;
+	const int *tab = a->tab;
+
+	for(int j=lo; j < hi; ++j)
+	{
+		int k = tab ? tab[j] : j;
+		out[oidx ? oidx[k] : k] = in[iidx[k]];
+	}
+}
+
+
+template<class T1> class ShiftedLeaf;
+
+//! Launch the exchange of a shift at the top of an expression
+template<class T1>
+void startShifts(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& rhs);
+
+//! Launch the exchange of a shift at the top of an expression read on s
+template<class T1>
+void startShifts(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& rhs, const Subset& s);
+
+
 
 //-----------------------------------------------------------------------------
 //! OLattice Op Scalar(Expression(source)) under an Subset
@@ -341,36 +690,30 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 {
 // cerr << "In evaluateSubset(olattice,oscalar)\n";
 
-#if defined(QDP_USE_PROFILING)	 
+	// Copies sharing the sites of dest keep the old values
+	dest.detach();
+
 	static QDPProfile_t prof(dest, op, rhs);
-	prof.time -= getClockTime();
-#endif
+	ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
+	QDPTime_t prof_t0 = prof.start();
 
-#if 0
 	int numSiteTable = s.numSiteTable();
-	
-	u_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
 
-	dispatch_to_threads< u_arg<T,T1,Op,RHS> >(numSiteTable, a, ev_userfunc);
-#else
-	///////////////////
-	// Original code
-	//////////////////
-	const int* tab = s.siteTable().slice();
-	int numSiteTable = s.numSiteTable();
-#pragma omp parallel for
-	 for(int j=0; j < numSiteTable; ++j)
-	 {
-		 int i = tab[j];
-		 op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
-	 }
+#if defined(QDP_USE_OMP_OFFLOAD)
+	if (Offload::use(numSiteTable))
+	{
+		Offload::evaluate(dest, op, rhs, s);
+		prof.stop(prof_t0, s.numSiteTable());
+		return;
+	}
 #endif
+	
+	u_arg<T,T1,Op,RHS> a(dest, rhs, op, s.hasRuns() ? 0 : s.siteTable().slice(),
+			     s.hasRuns() ? s.runTable().slice() : 0, s.numRuns());
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	dispatch_to_subset(s, sizeof(T), a, ev_userfunc<T,T1,Op,RHS>);
+
+	prof.stop(prof_t0, s.numSiteTable());
 }
 
 
@@ -386,32 +729,54 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 {
 //	cerr << "In evaluateSubset(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)	 
+	// Copies sharing the sites of dest keep the old values
+	dest.detach();
+
+	// Kernels are matched on the canonical form, e.g. y += x*a as y += a*x
+	if (Canonical<RHS>::changed)
+	{
+		KernelReport::canonicalised(op, rhs);
+		evaluate(dest, op, canonical(rhs), s);
+		return;
+	}
+
+	startShifts(rhs, s);
+
+	// Writing dest in place while a shift reads it at other sites would
+	// mix old and new values. Go through a temporary then - the allocator
+	// cache hands the same block back on the next such call
+	if (forEach(rhs, DestAliasLeaf(dest.getF()), OrCombine()))
+	{
+		OLattice<T1> tmp;
+		evaluate(tmp, OpAssign(), rhs, s);
+		evaluate(dest, op, PETE_identity(tmp), s);
+		return;
+	}
+
+	KernelReport::generic(op, rhs);
+
 	static QDPProfile_t prof(dest, op, rhs);
-	prof.time -= getClockTime();
-#endif
+	ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
+	QDPTime_t prof_t0 = prof.start();
 
-#if 0
 	int numSiteTable = s.numSiteTable();
 
-	user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
-
-	dispatch_to_threads< user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
-#else
-	const int *tab = s.siteTable().slice();
-	const int numSiteTable = s.numSiteTable();
-#pragma omp parallel for
-	for(int j=0; j < numSiteTable; ++j)
+#if defined(QDP_USE_OMP_OFFLOAD)
+	if (Offload::use(numSiteTable))
 	{
-		int i = tab[j];
-		op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
+		Offload::evaluate(dest, op, rhs, s);
+		prof.stop(prof_t0, s.numSiteTable());
+		return;
 	}
 #endif
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+
+	// Sites go tile by tile when Layout::setSiteTiling is on, and
+	// run by run through the consecutive sites otherwise
+	user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.loopsByRuns() ? 0 : s.traversalTable().slice(),
+				s.hasRuns() ? s.runTable().slice() : 0, s.numRuns());
+
+	dispatch_to_subset(s, sizeof(T), a, evaluate_userfunc<T,T1,Op,RHS>);
+	prof.stop(prof_t0, s.numSiteTable());
 }
 
 
@@ -424,45 +789,31 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
 {
   //cerr << "In evaluate_F(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
-
-  // int numSiteTable = s.numSiteTable();
-  // user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
-  // dispatch_to_threads< user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
-
-  ////////////////////
-  // Original code
-  ///////////////////
+  startShifts(rhs, s);
 
-  //QDP_info("eval_F %d sites",s.numSiteTable());
+  static QDPProfile_t prof(dest, op, rhs);
+  ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
+  QDPTime_t prof_t0 = prof.start();
 
-  // General form of loop structure
+  // Compact storage: position j holds site tab[j]
   const int *tab = s.siteTable().slice();
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    //fprintf(stderr,"eval(olattice,olattice): site %d\n",i);
-    op( dest[j], forEach(rhs, EvalLeaf1(i), OpCombine()));
-  }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+      for(int j=lo; j < hi; ++j)
+	op(dest[j], forEach(rhs, EvalLeaf1(tab[j]), OpCombine()));
+    });
+
+  prof.stop(prof_t0, s.numSiteTable());
 }
 
 
 //-----------------------------------------------------------------------------
 //! dest = (mask) ? s1 : dest
 template<class T1, class T2>
-void copymask(OSubLattice<T2> d, const OLattice<T1>& mask, const OLattice<T2>& s1) 
+void copymask(const OSubLattice<T2>& d, const OLattice<T1>& mask, const OLattice<T2>& s1) 
 {
-	OLattice<T2>& dest = d.field();
 	const Subset& s = d.subset();
+	const int* pos = d.sitePos();
 
 	const int *tab = s.siteTable().slice();
 	const int nodeSites = s.numSiteTable();
@@ -470,7 +821,7 @@ void copymask(OSubLattice<T2> d, const OLattice<T1>& mask, const OLattice<T2>& s
 	for(int j=0; j < nodeSites; ++j)
 	{
 		int i = tab[j];
-		copymask(dest.elem(i), mask.elem(i), s1.elem(i));
+		copymask(d.getF()[pos ? j : i], mask.elem(i), s1.elem(i));
 	}
 }
 
@@ -478,6 +829,8 @@ void copymask(OSubLattice<T2> d, const OLattice<T1>& mask, const OLattice<T2>& s
 template<class T1, class T2> 
 void copymask(OLattice<T2>& dest, const OLattice<T1>& mask, const OLattice<T2>& s1) 
 {
+	dest.detach();
+
 	int nodeSites = Layout::sitesOnNode();
 	
 #pragma omp parallel for
@@ -503,6 +856,16 @@ template<class T>
 void 
 random(OScalar<T>& d)
 {
+	if (RNG::generator() == RNG::GEN_PHILOX)
+	{
+		typedef RNG::CounterWords<T> W;
+		unsigned int w[4*W::blocks];
+		RNG::counterWords(RNG::nextCounterKey(false), RNG::scalar_site, w, W::blocks);
+		RNG::CounterStream st = {w, 0};
+		fill_random(d.elem(), st, st, st);
+		return;
+	}
+
 	Seed seed = RNG::ran_seed;
 	Seed skewed_seed = RNG::ran_seed * RNG::ran_mult;
 
@@ -512,49 +875,144 @@ random(OScalar<T>& d)
 }
 
 
+//! user argument for random under a subset
+template<class T>
+struct RandomThreadArgs {
+		RandomThreadArgs(
+				OLattice<T>& d_,
+				const int *tab_,
+				Seed& seed_ ) : d(d_), tab(tab_), seed(seed_) {}
+
+				OLattice<T>& d;
+				const int *tab;
+				Seed& seed;
+	 };
+
+//! user function for random under a subset
+/*! RNG::ran_seed is only read here; thread 0 hands back the new seed */
+template<class T>
+void randomKernel(int lo, int hi, int myId, RandomThreadArgs<T> *a)
+{
+	OLattice<T>& d = a->d;
+	const int *tab = a->tab;
+
+	Seed seed;
+	Seed skewed_seed;
+
+	for(int j=lo; j < hi; ++j)
+	{
+		int i = tab[j];
+		seed = RNG::ran_seed;
+
+		skewed_seed.elem() = RNG::ran_seed.elem() * RNG::lattice_ran_mult->elem(i);
+		fill_random(d.elem(i), seed, skewed_seed, RNG::ran_mult_n);
+	}
+
+	// The seed from any site is the same as the new global seed
+	if (myId == 0 && lo < hi)
+		a->seed = seed;
+}
+
+
+//! user argument for the counter based random and gaussian
+template<class T>
+struct CounterRandomArgs {
+	OLattice<T>& d;
+	const int *tab;
+	RNG::CounterKey key;
+};
+
+//! user function for random from the counter based generator
+template<class T>
+void counterRandomKernel(int lo, int hi, int myId, CounterRandomArgs<T> *a)
+{
+	typedef RNG::CounterWords<T> W;
+	unsigned int w[4*W::blocks];
+
+	for(int j=lo; j < hi; ++j)
+	{
+		int i = a->tab[j];
+		RNG::counterWords(a->key, RNG::lexicoSite(i), w, W::blocks);
+		RNG::CounterStream st = {w, 0};
+		fill_random(a->d.elem(i), st, st, st);
+	}
+}
+
+//! user argument for noise
+template<class T>
+struct NoiseArgs {
+	OLattice<T>& d;
+	const int *tab;
+	RNG::CounterKey key;
+	NoiseType type;
+};
+
+//! user function for noise, one pass over the words of each site
+template<class T>
+void noiseKernel(int lo, int hi, int myId, NoiseArgs<T> *a)
+{
+	for(int j=lo; j < hi; ++j)
+	{
+		int i = a->tab[j];
+		RNG::counterNoise(a->d.elem(i), a->type, a->key, RNG::lexicoSite(i));
+	}
+}
+
+//! dest	= gaussian, Z2 or Z4 noise	 under a subset
+/*! Always from the counter based generator, whichever -rng selects */
+template<class T>
+void noise(OLattice<T>& d, NoiseType type, const Subset& s)
+{
+	d.detach();
+
+	NoiseArgs<T> args = {d, s.siteTable().slice(), RNG::nextCounterKey(true), type};
+	dispatch_to_threads(s.numSiteTable(), args, noiseKernel<T>);
+}
+
+//! dest	= noise	 under a subset
+template<class T>
+void noise(const OSubLattice<T>& dd, NoiseType type)
+{
+	withFullField(dd, false, true, [type](OLattice<T>& d, const Subset& s) {noise(d, type, s);});
+}
+
+//! dest	= noise
+template<class T>
+void noise(OLattice<T>& d, NoiseType type)
+{
+	noise(d, type, all);
+}
+
 //! dest	= random		under a subset
 template<class T>
 void 
 random(OLattice<T>& d, const Subset& s)
 {
-	const int *tab = s.siteTable().slice();
-	const int nodeSites = s.numSiteTable();
+	d.detach();
 
-#pragma omp parallel
+	if (RNG::generator() == RNG::GEN_PHILOX)
 	{
-		Seed seed;
-		Seed skewed_seed;
+		CounterRandomArgs<T> args = {d, s.siteTable().slice(), RNG::nextCounterKey(true)};
+		dispatch_to_threads(s.numSiteTable(), args, counterRandomKernel<T>);
+		return;
+	}
 
-#pragma omp for // need the barrier to avoid that RNG::ran_seed is changed too early!
-		for(int j=0; j < nodeSites; ++j)
-		{
-			int i = tab[j];
-			seed = RNG::ran_seed;
+	RNG::initLatticeRNG();
+	Seed seed = RNG::ran_seed;
 
-			skewed_seed.elem() = RNG::ran_seed.elem() * RNG::lattice_ran_mult->elem(i);
-			fill_random(d.elem(i), seed, skewed_seed, RNG::ran_mult_n);
-		}
+	RandomThreadArgs<T> args(d, s.siteTable().slice(), seed);
+	dispatch_to_threads(s.numSiteTable(), args, randomKernel<T>);
 
-		int myId = qdpThreadNum();
-		if( myId < nodeSites ) {
-#pragma omp critical (random)
-		{
-			RNG::ran_seed = seed;	 // The seed from any site is the same as the new global seed
-		}
-		}
-	}
+	RNG::ran_seed = seed;
 }
 
 
 
 //! dest	= random	 under a subset
 template<class T>
-void random(OSubLattice<T> dd)
+void random(const OSubLattice<T>& dd)
 {
-	OLattice<T>& d = dd.field();
-	const Subset& s = dd.subset();
-
-	random(d,s);
+	withFullField(dd, false, true, [](OLattice<T>& d, const Subset& s) {random(d,s);});
 }
 
 
@@ -570,6 +1028,14 @@ void random(OLattice<T>& d)
 template<class T>
 void gaussian(OLattice<T>& d, const Subset& s)
 {
+	d.detach();
+
+	if (RNG::generator() == RNG::GEN_PHILOX)
+	{
+		noise(d, NOISE_GAUSSIAN, s);
+		return;
+	}
+
 	OLattice<T>	 r1, r2;
 
 	random(r1,s);
@@ -590,12 +1056,9 @@ void gaussian(OLattice<T>& d, const Subset& s)
 
 //! dest	= gaussian	 under a subset
 template<class T>
-void gaussian(OSubLattice<T> dd)
+void gaussian(const OSubLattice<T>& dd)
 {
-	OLattice<T>& d = dd.field();
-	const Subset& s = dd.subset();
-
-	gaussian(d,s);
+	withFullField(dd, false, true, [](OLattice<T>& d, const Subset& s) {gaussian(d,s);});
 }
 
 
@@ -615,6 +1078,8 @@ template<class T>
 inline
 void zero_rep(OLattice<T>& dest, const Subset& s) 
 {
+	dest.detach();
+
 	const int *tab = s.siteTable().slice();
 	const int nodeSites = s.numSiteTable();
 
@@ -646,6 +1111,14 @@ void zero_rep(OSubLattice<T> dd)
 template<class T> 
 void zero_rep(OLattice<T>& dest) 
 {
+	dest.detach();
+
+	if (dest.layout())
+	{
+		zero_rep(dest, dest.layout()->all());
+		return;
+	}
+
 	const int nodeSites = Layout::sitesOnNode();
 
 #pragma omp parallel for
@@ -668,18 +1141,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1, const Subset& s)
 {
 	typename UnaryReturn<OScalar<T>, FnSum>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, 1);
 
 	return d;
 }
@@ -696,75 +1163,113 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnSum>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, 1);
 
 	return d;
 }
 
 
 
-//! OScalar = sum(OLattice)	 under an explicit subset
-/*!
- * Allow a global sum that sums over the lattice, but returns an object
- * of the same primitive type. E.g., contract only over lattice indices
- */
+//! user argument for the sum of an OLattice expression
 template<class RHS, class T>
-typename UnaryReturn<OLattice<T>, FnSum>::Type_t
-sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
-{
-	typename UnaryReturn<OLattice<T>, FnSum>::Type_t	d;
-
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+struct SumOLatticeThreadArgs {
+		SumOLatticeThreadArgs(
+				const QDPExpr<RHS,OLattice<T> >& s_,
+				const int *tab_,
+				multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest_,
+				const SiteRun *runs_ = 0,
+				int nruns_ = 0 ) : s(s_), tab(tab_), dest(dest_), runs(runs_), nruns(nruns_) {}
+
+				const QDPExpr<RHS,OLattice<T> >& s;
+				const int *tab;		// null means the runs, or all sites on the node without them
+				multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest;
+				const SiteRun *runs;
+				int nruns;
+	 };
 
-	// Must initialize to zero since we do not know if the loop will be entered
-	zero_rep(d.elem());
+//! user function for the sum of an OLattice expression
+/*! Each thread leaves its partial sum in dest[myId] */
+template<class RHS, class T>
+QDP_SITE_KERNEL void sumKernel(int lo, int hi, int myId, SumOLatticeThreadArgs<RHS,T> *a)
+{
+	const QDPExpr<RHS,OLattice<T> >& s1 = a->s;
+	const int *tab = a->tab;
 
-	const int *tab = s.siteTable().slice();
-	const int nodeSites = s.numSiteTable();
+	typename UnaryReturn<OLattice<T>, FnSum>::Type_t dthread;
+	zero_rep(dthread.elem());
 
-#pragma omp parallel
+	if (tab)
 	{
-		typename UnaryReturn<OLattice<T>, FnSum>::Type_t dthread;
-		zero_rep(dthread.elem());
-
-#pragma omp for
-		for(int j=0; j < nodeSites; ++j)
+		for(int j=lo; j < hi; ++j)
 		{
 			int i = tab[j];
 			dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());
 		}
+	}
+	else if (a->runs)
+	{
+		forSiteRuns(a->runs, a->nruns, lo, hi, [&](int i0, int n) {
+				for(int i=i0; i < i0+n; ++i)
+					dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());
+			});
+	}
+	else
+	{
+		for(int i=lo; i < hi; ++i)
+			dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());
+	}
 
-		int myId = qdpThreadNum();
-		if( myId < nodeSites ) {
-#pragma omp critical
-		{
-			d.elem() += dthread.elem();
-		}
-		}
+	a->dest[myId].elem() = dthread.elem();
+}
+
+
+//! OScalar = sum(OLattice)	 under an explicit subset
+/*!
+ * Allow a global sum that sums over the lattice, but returns an object
+ * of the same primitive type. E.g., contract only over lattice indices
+ */
+template<class RHS, class T>
+typename UnaryReturn<OLattice<T>, FnSum>::Type_t
+sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+{
+	startShifts(s1, s);
+
+	typename UnaryReturn<OLattice<T>, FnSum>::Type_t	d;
+
+	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
+	QDPTime_t prof_t0 = prof.start();
+
+	// Must initialize to zero since we do not know if the loop will be entered
+	zero_rep(d.elem());
+
+#if defined(QDP_USE_OMP_OFFLOAD)
+	if (Offload::use(s.numSiteTable()))
+		Offload::sum(d, s1, s);
+	else
+#endif
+	{
+		multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads());
+		for(int thread=0; thread < pdest.size(); ++thread)
+			zero_rep(pdest[thread].elem());
+
+		SumOLatticeThreadArgs<RHS,T> args(s1, s.hasRuns() ? 0 : s.siteTable().slice(), pdest,
+						  s.hasRuns() ? s.runTable().slice() : 0, s.numRuns());
+		dispatch_to_subset(s, sizeof(T), args, sumKernel<RHS,T>, Partition::ALIGNED);
+
+		// Combine in thread order so the result does not depend on the scheduling
+		for(int thread=0; thread < pdest.size(); ++thread)
+			d.elem() += pdest[thread].elem();
 	}
 	
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s.numSiteTable());
 
 	return d;
 }
@@ -779,44 +1284,35 @@ template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnSum>::Type_t
 sum(const QDPExpr<RHS,OLattice<T> >& s1)
 {
+	// Fields of a LatticeLayout are summed over the sites of their lattice
+	if (const LatticeLayout* l = forEach(s1, LayoutLeaf(), LayoutCombine()))
+		return sum(s1, l->all());
+
+	startShifts(s1);
+
 	typename UnaryReturn<OLattice<T>, FnSum>::Type_t	d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// Loop always entered - could unroll
 	zero_rep(d.elem());
-	const int nodeSites = Layout::sitesOnNode();
 
-#pragma omp parallel
-	{
-		typename UnaryReturn<OLattice<T>, FnSum>::Type_t	dthread;
-		zero_rep(dthread.elem());
-		
-#pragma omp for nowait
-		for(int i=0; i < nodeSites; ++i) 
-			dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());
-			
+	multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads());
+	for(int thread=0; thread < pdest.size(); ++thread)
+		zero_rep(pdest[thread].elem());
 
-		int myId = qdpThreadNum();
-		if( myId < nodeSites ) {
-#pragma omp critical
-		{
-			d.elem() += dthread.elem();
-		}
-		}
-	}
+	SumOLatticeThreadArgs<RHS,T> args(s1, 0, pdest);
+	dispatch_to_threads(Layout::sitesOnNode(), args, sumKernel<RHS,T>);
+
+	// Combine in thread order so the result does not depend on the scheduling
+	for(int thread=0; thread < pdest.size(); ++thread)
+		d.elem() += pdest[thread].elem();
 
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, all.numSiteTable());
 
 	return d;
 }
@@ -838,68 +1334,107 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
 {
 	typename UnaryReturn<OScalar<T>, FnSumMulti>::Type_t	dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// lazy - evaluate repeatedly
 	for(int i=0; i < ss.numSubsets(); ++i)
 		evaluate(dest[i],OpAssign(),s1,all);
 
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, 1);
 
 	return dest;
 }
 
 
+//! user argument for sumMulti over the coloring of a Set
+template<class RHS, class T>
+struct SumMultiOLatticeThreadArgs {
+		SumMultiOLatticeThreadArgs(
+				const int *lat_color_,
+				const multi1d<ColorRun>& cruns_,
+				const QDPExpr<RHS,OLattice<T> >& s_,
+				multi1d<typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t>& dest_ ) : lat_color(lat_color_), cruns(cruns_), s(s_), dest(dest_) {}
+
+				const int *lat_color;
+				const multi1d<ColorRun>& cruns;
+				const QDPExpr<RHS,OLattice<T> >& s;
+				multi1d<typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t>& dest;
+	 };
+
+//! user function for sumMulti over the coloring of a Set
+/*! Each thread accumulates into its own array dest[myId] */
+template<class RHS, class T>
+QDP_SITE_KERNEL void sumMultiKernel(int lo, int hi, int myId, SumMultiOLatticeThreadArgs<RHS,T> *a)
+{
+	const int *lat_color = a->lat_color;
+	const QDPExpr<RHS,OLattice<T> >& s1 = a->s;
+	typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t& d = a->dest[myId];
+
+	// One color per run, so the color is looked up once a run
+	if (a->cruns.size() > 0)
+	{
+		forColorRuns(a->cruns.slice(), a->cruns.size()-1, lo, hi, [&](int i0, int n, int j) {
+				for(int i=i0; i < i0+n; ++i)
+					d[j].elem() += forEach(s1, EvalLeaf1(i), OpCombine());
+			});
+		return;
+	}
+
+	for(int i=lo; i < hi; ++i) 
+	{
+		int j = lat_color[i];
+		d[j].elem() += forEach(s1, EvalLeaf1(i), OpCombine());
+	}
+}
+
+
 //! multi1d<OScalar> dest	 = sumMulti(OLattice,Set) 
 /*!
  * Compute the global sum on multiple subsets specified by Set 
  *
- * This is a very simple implementation. There is no need for
- * anything fancier unless global sums are just so extraordinarily
- * slow. Otherwise, generalized sums happen so infrequently the slow
- * version is fine.
+ * One threaded pass over the node sites accumulates by the coloring
+ * into per-thread arrays. These are combined in thread order, so the
+ * result is reproducible for a given number of threads.
  */
 template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t
 sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
+	startShifts(s1);
+
 	typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t	 dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
+
+	multi1d< typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t > pdest(qdpNumThreads());
 
 	// Initialize result with zero
+	for(int thread=0; thread < pdest.size(); ++thread)
+	{
+		pdest[thread].resize(ss.numSubsets());
+		for(int k=0; k < ss.numSubsets(); ++k)
+			zero_rep(pdest[thread][k]);
+	}
+
 	for(int k=0; k < ss.numSubsets(); ++k)
 		zero_rep(dest[k]);
 
 	// Loop over all sites and accumulate based on the coloring 
-	const multi1d<int>& lat_color =	 ss.latticeColoring();
-	const int nodeSites = Layout::sitesOnNode();
+	SumMultiOLatticeThreadArgs<RHS,T> args(ss.latticeColoring().slice(), ss.colorRuns(), s1, pdest);
+	dispatch_to_threads(Layout::sitesOnNode(), args, sumMultiKernel<RHS,T>);
 
-	for(int i=0; i < nodeSites; ++i) 
-	{
-		int j = lat_color[i];
-		dest[j].elem() += forEach(s1, EvalLeaf1(i), OpCombine());
-	}
+	// Combine in thread order so the result does not depend on the scheduling
+	for(int thread=0; thread < pdest.size(); ++thread)
+		for(int k=0; k < ss.numSubsets(); ++k)
+			dest[k].elem() += pdest[thread][k].elem();
 
 	// Do a global sum on the result
-	QDPInternal::globalSumArray(dest);
+	QDPInternal::globalSumArray(dest, ss);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, all.numSiteTable());
 
 	return dest;
 }
@@ -907,6 +1442,51 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 
 //-----------------------------------------------------------------------------
 // Multiple global sums on an array
+//! multi1d<OScalar> dest	 = sumMultiSubsets(OLattice,Set) 
+/*!
+ * Same result as sumMulti, but each subset is summed over its own site
+ * table instead of scanning the coloring array. Suits sets whose subsets
+ * are few and large. Each subset is reduced over the threads in a fixed
+ * order, so the result is reproducible for a given number of threads.
+ */
+template<class RHS, class T>
+typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t
+sumMultiSubsets(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
+{
+	startShifts(s1);
+
+	typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t	 dest(ss.numSubsets());
+
+	static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
+	QDPTime_t prof_t0 = prof.start();
+
+	multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads());
+
+	for(int k=0; k < ss.numSubsets(); ++k)
+	{
+		const Subset& sub = ss[k];
+
+		for(int thread=0; thread < pdest.size(); ++thread)
+			zero_rep(pdest[thread].elem());
+
+		SumOLatticeThreadArgs<RHS,T> args(s1, sub.hasRuns() ? 0 : sub.siteTable().slice(), pdest,
+						  sub.hasRuns() ? sub.runTable().slice() : 0, sub.numRuns());
+		dispatch_to_subset(sub, sizeof(T), args, sumKernel<RHS,T>, Partition::ALIGNED);
+
+		zero_rep(dest[k]);
+		for(int thread=0; thread < pdest.size(); ++thread)
+			dest[k].elem() += pdest[thread].elem();
+	}
+
+	// Do a global sum on the result
+	QDPInternal::globalSumArray(dest, ss);
+
+	prof.stop(prof_t0, all.numSiteTable());
+
+	return dest;
+}
+
+
 //! multi2d<OScalar> dest	 = sumMulti(multi1d<OScalar>,Set) 
 /*!
  * Compute the global sum on multiple subsets specified by Set 
@@ -921,21 +1501,15 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 {
 	multi2d<typename UnaryReturn<OScalar<T>, FnSumMulti>::Type_t> dest(s1.size(), ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// lazy - evaluate repeatedly
 	for(int i=0; i < dest.size1(); ++i)
 		for(int j=0; j < dest.size2(); ++j)
 			dest(j,i) = s1[j];
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s1.size());
 
 	return dest;
 }
@@ -945,10 +1519,8 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 /*!
  * Compute the global sum on multiple subsets specified by Set 
  *
- * This is a very simple implementation. There is no need for
- * anything fancier unless global sums are just so extraordinarily
- * slow. Otherwise, generalized sums happen so infrequently the slow
- * version is fine.
+ * All the fields are summed in one pass over the sites and one global
+ * sum, so an array of Ls or Nd fields costs a single reduction.
  */
 template<class T>
 multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>
@@ -956,38 +1528,48 @@ sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
 {
 	multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> dest(s1.size(), ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-	prof.time -= getClockTime();
-#endif
+	static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1[0]);
+	QDPTime_t prof_t0 = prof.start();
 
 	// Initialize result with zero
 	for(int i=0; i < dest.size1(); ++i)
 		for(int j=0; j < dest.size2(); ++j)
 			zero_rep(dest(j,i));
 
-	// Loop over all sites and accumulate based on the coloring 
-	const multi1d<int>& lat_color =	 ss.latticeColoring();
+	// One threaded pass over the node sites accumulates all the fields
+	// by the coloring into per-thread arrays
+	const int *lat_color = ss.latticeColoring().slice();
 
-	for(int k=0; k < s1.size(); ++k)
+	multi1d< multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> > pdest(qdpNumThreads());
+	for(int thread=0; thread < pdest.size(); ++thread)
 	{
-		const OLattice<T>& ss1 = s1[k];
-		const int nodeSites = Layout::sitesOnNode();
-		for(int i=0; i < nodeSites; ++i) 
-		{
-			int j = lat_color[i];
-			dest(k,j).elem() += ss1.elem(i);
-		}
+		pdest[thread].resize(s1.size(), ss.numSubsets());
+		for(int i=0; i < dest.size1(); ++i)
+			for(int j=0; j < dest.size2(); ++j)
+				zero_rep(pdest[thread](j,i));
 	}
 
+	dispatch_range(Layout::sitesOnNode(), [&](int lo, int hi, int myId) {
+			multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dthread = pdest[myId];
+
+			for(int i=lo; i < hi; ++i) 
+			{
+				int j = lat_color[i];
+				for(int k=0; k < s1.size(); ++k)
+					dthread(k,j).elem() += s1[k].elem(i);
+			}
+		});
+
+	// Combine in thread order so the result does not depend on the scheduling
+	for(int thread=0; thread < pdest.size(); ++thread)
+		for(int i=0; i < dest.size1(); ++i)
+			for(int j=0; j < dest.size2(); ++j)
+				dest(j,i).elem() += pdest[thread](j,i).elem();
+
 	// Do a global sum on the result
 	QDPInternal::globalSumArray(dest);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, all.numSiteTable()*s1.size());
 
 	return dest;
 }
@@ -1007,10 +1589,8 @@ norm2(const multi1d< OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnNorm2>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1021,11 +1601,7 @@ norm2(const multi1d< OScalar<T> >& s1)
 		d.elem() += localNorm2(ss1.elem());
 	}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s1.size());
 
 	return d;
 }
@@ -1053,51 +1629,41 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
 {
 	typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t	d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// Possibly loop entered
 	zero_rep(d.elem());
 
 	const int *tab = s.siteTable().slice();
-	const int nodeSites = s.numSiteTable();
 
-	for(int n=0; n < s1.size(); ++n)
-	{
-		const OLattice<T>& ss1 = s1[n];
+	// One pass of the threads over all the fields, each thread its own sites
+	multi1d<typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t> pdest(qdpNumThreads());
+	for(int thread=0; thread < pdest.size(); ++thread)
+		zero_rep(pdest[thread].elem());
 
-		#pragma omp parallel
-		{
-			typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t	dthread;
+	dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+			typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t dthread;
 			zero_rep(dthread.elem());
 
-			#pragma omp for
-			for(int j=0; j < nodeSites; ++j)
+			for(int j=lo; j < hi; ++j)
 			{
 				int i = tab[j];
-				dthread.elem() += localNorm2(ss1.elem(i));
+				for(int n=0; n < s1.size(); ++n)
+					dthread.elem() += localNorm2(s1[n].elem(i));
 			}
 
-			int myId = qdpThreadNum();
-			if ( myId < nodeSites ) {
-			#pragma omp critical
-			{
-				d.elem() += dthread.elem();
-			}
-			}
-		}
-	}
+			pdest[myId].elem() = dthread.elem();
+		}, Partition::ALIGNED);
+
+	// Combine in thread order so the result does not depend on the scheduling
+	for(int thread=0; thread < pdest.size(); ++thread)
+		d.elem() += pdest[thread].elem();
 
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s.numSiteTable()*s1.size());
 
 	return d;
 }
@@ -1133,10 +1699,8 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
 {
 	typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProduct>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1148,11 +1712,7 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
 		d.elem() += localInnerProduct(ss1.elem(),ss2.elem());
 	}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s1.size());
 
 	return d;
 }
@@ -1183,51 +1743,41 @@ innerProduct(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s
 {
 	typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// Possibly loop entered
 	zero_rep(d.elem());
 
 	const int *tab = s.siteTable().slice();
-	const int nodeSites = s.numSiteTable();
-	for(int n=0; n < s1.size(); ++n)
-	{
-		const OLattice<T1>& ss1 = s1[n];
-		const OLattice<T2>& ss2 = s2[n];
-		
-		#pragma omp parallel
-		{
-			typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t	 dthread;
+
+	// One pass of the threads over all the fields, each thread its own sites
+	multi1d<typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t> pdest(qdpNumThreads());
+	for(int thread=0; thread < pdest.size(); ++thread)
+		zero_rep(pdest[thread].elem());
+
+	dispatch_range(s, sizeof(T1), [&](int lo, int hi, int myId) {
+			typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t dthread;
 			zero_rep(dthread.elem());
-		
-			#pragma omp for
-			for(int j=0; j < nodeSites; ++j)
+
+			for(int j=lo; j < hi; ++j)
 			{
 				int i = tab[j];
-				dthread.elem() += localInnerProduct(ss1.elem(i),ss2.elem(i));
+				for(int n=0; n < s1.size(); ++n)
+					dthread.elem() += localInnerProduct(s1[n].elem(i),s2[n].elem(i));
 			}
 
-			int myId = qdpThreadNum();
-			if( myId < nodeSites ) {
-			#pragma omp critical
-			{
-				d.elem() += dthread.elem();
-			}
-			}
-		}
-	}
+			pdest[myId].elem() = dthread.elem();
+		}, Partition::ALIGNED);
+
+	// Combine in thread order so the result does not depend on the scheduling
+	for(int thread=0; thread < pdest.size(); ++thread)
+		d.elem() += pdest[thread].elem();
 
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s.numSiteTable()*s1.size());
 
 	return d;
 }
@@ -1263,10 +1813,8 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
 {
 	typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProductReal>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// Possibly loop entered
 	zero_rep(d.elem());
@@ -1278,11 +1826,7 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
 		d.elem() += localInnerProductReal(ss1.elem(),ss2.elem());
 	}
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s1.size());
 
 	return d;
 }
@@ -1313,52 +1857,41 @@ innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2>
 {
 	typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	// Possibly loop entered
 	zero_rep(d.elem());
 
 	const int *tab = s.siteTable().slice();
-	const int nodeSites = s.numSiteTable();
 
-	for(int n=0; n < s1.size(); ++n)
-	{
-		const OLattice<T1>& ss1 = s1[n];
-		const OLattice<T2>& ss2 = s2[n];
-		
-		#pragma omp parallel
-		{
-			typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t	 dthread;
+	// One pass of the threads over all the fields, each thread its own sites
+	multi1d<typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t> pdest(qdpNumThreads());
+	for(int thread=0; thread < pdest.size(); ++thread)
+		zero_rep(pdest[thread].elem());
+
+	dispatch_range(s, sizeof(T1), [&](int lo, int hi, int myId) {
+			typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t dthread;
 			zero_rep(dthread.elem());
-			
-			#pragma omp for
-			for(int j=0; j < nodeSites; ++j)
+
+			for(int j=lo; j < hi; ++j)
 			{
 				int i = tab[j];
-				dthread.elem() += localInnerProductReal(ss1.elem(i),ss2.elem(i));
+				for(int n=0; n < s1.size(); ++n)
+					dthread.elem() += localInnerProductReal(s1[n].elem(i),s2[n].elem(i));
 			}
 
-			int myId = qdpThreadNum();
-			if( myId < nodeSites )  {
-			#pragma omp critical
-			{
-				d.elem() += dthread.elem();
-			}
-			}
-		}
-	}
+			pdest[myId].elem() = dthread.elem();
+		}, Partition::ALIGNED);
+
+	// Combine in thread order so the result does not depend on the scheduling
+	for(int thread=0; thread < pdest.size(); ++thread)
+		d.elem() += pdest[thread].elem();
 
 	// Do a global sum on the result
 	QDPInternal::globalSum(d);
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s.numSiteTable()*s1.size());
 
 	return d;
 }
@@ -1381,10 +1914,93 @@ innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2>
 
 
 
+//-----------------------------------------------
+// Global max and min under a subset, and where they are
+//! user argument for the extremum of an expression
+template<class RHS, class T, class Fn>
+struct ExtremumThreadArgs
+{
+	typedef typename UnaryReturn<OLattice<T>, Fn>::Type_t Type_t;
+
+	ExtremumThreadArgs(const QDPExpr<RHS,OLattice<T> >& s_, const int* tab_, bool max_,
+			   multi1d<Type_t>& dest_, multi1d<int>& site_) :
+		s(s_), tab(tab_), max(max_), dest(dest_), site(site_) {}
+
+	const QDPExpr<RHS,OLattice<T> >& s;
+	const int* tab;
+	bool max;                  // largest, else smallest
+	multi1d<Type_t>& dest;
+	multi1d<int>& site;
+};
+
+
+//! user function for the extremum of an expression
+/*! Each thread leaves its extremum in dest[myId] and the site of it in site[myId] */
+template<class RHS, class T, class Fn>
+void extremumKernel(int lo, int hi, int myId, ExtremumThreadArgs<RHS,T,Fn> *a)
+{
+	if (lo >= hi)
+		return;
+
+	const QDPExpr<RHS,OLattice<T> >& s1 = a->s;
+
+	int best = a->tab[lo];
+	typename UnaryReturn<OLattice<T>, Fn>::Type_t d;
+	d.elem() = forEach(s1, EvalLeaf1(best), OpCombine());
+
+	for(int j=lo+1; j < hi; ++j)
+	{
+		int i = a->tab[j];
+		typename UnaryReturn<T, Fn>::Type_t dd = forEach(s1, EvalLeaf1(i), OpCombine());
+
+		if (a->max ? toBool(dd > d.elem()) : toBool(dd < d.elem()))
+		{
+			d.elem() = dd;
+			best = i;
+		}
+	}
+
+	a->dest[myId] = d;
+	a->site[myId] = best;
+}
+
+
+//! The extremum of s1 over the sites of s on this node
+/*!
+ * Returns the site of it, the first in the site table on a tie, or -1
+ * when s has no sites here. One threaded pass over the expression.
+ */
+template<class RHS, class T, class Fn>
+int localExtremum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s, bool max,
+		  typename UnaryReturn<OLattice<T>, Fn>::Type_t& d)
+{
+	multi1d<typename UnaryReturn<OLattice<T>, Fn>::Type_t> pdest(qdpNumThreads());
+	multi1d<int> psite(qdpNumThreads());
+	psite = -1;
+
+	ExtremumThreadArgs<RHS,T,Fn> args(s1, s.siteTable().slice(), max, pdest, psite);
+	dispatch_to_threads(s.numSiteTable(), args, extremumKernel<RHS,T,Fn>);
+
+	// Combine in thread order so ties go to the earliest site
+	int site = -1;
+	for(int thread=0; thread < pdest.size(); ++thread)
+	{
+		if (psite[thread] < 0)
+			continue;
+
+		if (site < 0 || (max ? toBool(pdest[thread].elem() > d.elem()) : toBool(pdest[thread].elem() < d.elem())))
+		{
+			d = pdest[thread];
+			site = psite[thread];
+		}
+	}
+
+	return site;
+}
+
+
 //-----------------------------------------------
 // Global max and min
-// NOTE: there are no subset version of these operations. It is very problematic
-// and QMP does not support them.
 //! OScalar = globalMax(OScalar)
 /*!
  * Find the maximum an object has across the lattice
@@ -1395,18 +2011,12 @@ globalMax(const QDPExpr<RHS,OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnGlobalMax>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global max needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, 1);
 
 	return d;
 }
@@ -1420,34 +2030,70 @@ template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t
 globalMax(const QDPExpr<RHS,OLattice<T> >& s1)
 {
-	typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t	d;
+	return globalMax(s1, all);
+}
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-	prof.time -= getClockTime();
-#endif
 
-	// Loop always entered so unroll
-	d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());	 // SINGLE NODE VERSION FOR NOW
+//! OScalar = globalMax(OLattice) under an explicit subset
+/*!
+ * Find the maximum an object has on the sites of a subset, in one
+ * threaded pass over the expression
+ */
+template<class RHS, class T>
+typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t
+globalMax(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+{
+	startShifts(s1, s);
+
+	typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t  d;
 
-	const int vvol = Layout::sitesOnNode();
-	for(int i=1; i < vvol; ++i) 
-	{
-		typename UnaryReturn<T, FnGlobalMax>::Type_t	dd = 
-			forEach(s1, EvalLeaf1(i), OpCombine());		// SINGLE NODE VERSION FOR NOW
+	static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
+	QDPTime_t prof_t0 = prof.start();
 
-		if (toBool(dd > d.elem()))
-			d.elem() = dd;
+	// A node without sites of s leaves the others to decide
+	if (localExtremum<RHS,T,FnGlobalMax>(s1, s, true, d) < 0)
+	{
+		typedef typename WordType<typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t>::Type_t W;
+		W* w = (W*)&d;
+		for(int k=0; k < int(sizeof(d)/sizeof(W)); ++k)
+			w[k] = -std::numeric_limits<W>::max();
 	}
 
 	// Do a global max on the result
 	QDPInternal::globalMax(d); 
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s.numSiteTable());
+
+	return d;
+}
+
+
+//! Largest value of OLattice on a subset and the global coordinate of its site
+/*!
+ * One threaded pass over the expression and a single reduction. On a
+ * tie the site first in the site table of the lowest node is taken.
+ * Only for fields of real numbers.
+ */
+template<class RHS, class T>
+SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t>
+argMax(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+{
+	startShifts(s1, s);
+
+	SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t> d;
+
+	QDPInternal::ExtremumLoc loc;
+	loc.site = localExtremum<RHS,T,FnGlobalMax>(s1, s, true, d.value);
+	loc.node = Layout::nodeNumber();
+
+	typedef typename WordType<typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t>::Type_t W;
+	loc.value = (loc.site >= 0) ? double(*(W*)&d.value) : 0.0;
+
+	QDPInternal::globalMaxLoc(loc);
+
+	*(W*)&d.value = W(loc.value);
+	if (loc.site >= 0)
+		d.coord = Layout::siteCoords(loc.node, loc.site);
 
 	return d;
 }
@@ -1463,18 +2109,12 @@ globalMin(const QDPExpr<RHS,OScalar<T> >& s1)
 {
 	typename UnaryReturn<OScalar<T>, FnGlobalMin>::Type_t	 d;
 
-#if defined(QDP_USE_PROFILING)	 
 	static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-	prof.time -= getClockTime();
-#endif
+	QDPTime_t prof_t0 = prof.start();
 
 	evaluate(d,OpAssign(),s1,all);	 // since OScalar, no global min needed
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, 1);
 
 	return d;
 }
@@ -1488,34 +2128,70 @@ template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t
 globalMin(const QDPExpr<RHS,OLattice<T> >& s1)
 {
-	typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t	d;
+	return globalMin(s1, all);
+}
 
-#if defined(QDP_USE_PROFILING)	 
-	static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-	prof.time -= getClockTime();
-#endif
 
-	// Loop always entered so unroll
-	d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());	 // SINGLE NODE VERSION FOR NOW
+//! OScalar = globalMin(OLattice) under an explicit subset
+/*!
+ * Find the minimum an object has on the sites of a subset, in one
+ * threaded pass over the expression
+ */
+template<class RHS, class T>
+typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t
+globalMin(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+{
+	startShifts(s1, s);
 
-	const int vvol = Layout::sitesOnNode();
-	for(int i=1; i < vvol; ++i) 
-	{
-		typename UnaryReturn<T, FnGlobalMin>::Type_t	dd = 
-			forEach(s1, EvalLeaf1(i), OpCombine());		// SINGLE NODE VERSION FOR NOW
+	typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t  d;
 
-		if (toBool(dd < d.elem()))
-			d.elem() = dd;
+	static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
+	QDPTime_t prof_t0 = prof.start();
+
+	// A node without sites of s leaves the others to decide
+	if (localExtremum<RHS,T,FnGlobalMin>(s1, s, false, d) < 0)
+	{
+		typedef typename WordType<typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t>::Type_t W;
+		W* w = (W*)&d;
+		for(int k=0; k < int(sizeof(d)/sizeof(W)); ++k)
+			w[k] = std::numeric_limits<W>::max();
 	}
 
 	// Do a global min on the result
 	QDPInternal::globalMin(d); 
 
-#if defined(QDP_USE_PROFILING)	 
-	prof.time += getClockTime();
-	prof.count++;
-	prof.print();
-#endif
+	prof.stop(prof_t0, s.numSiteTable());
+
+	return d;
+}
+
+
+//! Smallest value of OLattice on a subset and the global coordinate of its site
+/*!
+ * One threaded pass over the expression and a single reduction. On a
+ * tie the site first in the site table of the lowest node is taken.
+ * Only for fields of real numbers.
+ */
+template<class RHS, class T>
+SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t>
+argMin(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+{
+	startShifts(s1, s);
+
+	SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t> d;
+
+	QDPInternal::ExtremumLoc loc;
+	loc.site = localExtremum<RHS,T,FnGlobalMin>(s1, s, false, d.value);
+	loc.node = Layout::nodeNumber();
+
+	typedef typename WordType<typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t>::Type_t W;
+	loc.value = (loc.site >= 0) ? double(*(W*)&d.value) : 0.0;
+
+	QDPInternal::globalMinLoc(loc);
+
+	*(W*)&d.value = W(loc.value);
+	if (loc.site >= 0)
+		d.coord = Layout::siteCoords(loc.node, loc.site);
 
 	return d;
 }
@@ -1546,10 +2222,8 @@ isnan(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsNan(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1559,11 +2233,7 @@ isnan(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1591,10 +2261,8 @@ isinf(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsInf(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1604,11 +2272,7 @@ isinf(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1636,10 +2300,8 @@ isfinite(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsFinite(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1649,11 +2311,7 @@ isfinite(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1681,10 +2339,8 @@ isnormal(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsNormal(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int nodeSites = Layout::sitesOnNode();
   for(int i=0; i < nodeSites; ++i) 
@@ -1694,11 +2350,7 @@ isnormal(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1809,6 +2461,74 @@ pokeSite(OLattice<T1>& l, const OScalar<T1>& r, const multi1d<int>& coord)
 }
 
 
+//! Extract the elements at many sites
+/*! @ingroup group1
+	@param l	source to examine
+	@param coords	Nd lattice coordinates of each site to examine
+	@return single site objects of the same primitive type, on all nodes
+
+	The expression is evaluated only at the requested sites, on the nodes
+	that hold them, and all the results reach every node in one global
+	sum - the other nodes contribute zero.
+	@relates QDPType */
+template<class RHS, class T1>
+multi1d< OScalar<T1> >
+peekSites(const QDPExpr<RHS,OLattice<T1> > & l, const multi1d< multi1d<int> >& coords)
+{
+	multi1d< OScalar<T1> > dest(coords.size());
+
+	startShifts(l);
+
+	for(int k=0; k < coords.size(); ++k)
+	{
+		if (Layout::nodeNumber() == Layout::nodeNumber(coords[k]))
+			dest[k].elem() = forEach(l, EvalLeaf1(Layout::linearSiteIndex(coords[k])), OpCombine());
+		else
+			zero_rep(dest[k].elem());
+	}
+
+	if (coords.size() > 0)
+		QDPInternal::globalSumArray(dest);
+
+	return dest;
+}
+
+//! Extract the elements at many sites
+/*! @ingroup group1
+	@param l	source to examine
+	@param coords	Nd lattice coordinates of each site to examine
+	@return single site objects of the same primitive type, on all nodes
+	@relates QDPType */
+template<class T1>
+inline multi1d< OScalar<T1> >
+peekSites(const OLattice<T1>& l, const multi1d< multi1d<int> >& coords)
+{
+	return peekSites(PETE_identity(l), coords);
+}
+
+
+//! Insert elements at many sites
+/*! @ingroup group1
+	@param l	target to update
+	@param r	source to insert at each site, the same on all nodes
+	@param coords	Nd lattice coordinates where to insert
+	@return the updated target
+	@relates QDPType */
+template<class T1>
+OLattice<T1>&
+pokeSites(OLattice<T1>& l, const multi1d< OScalar<T1> >& r, const multi1d< multi1d<int> >& coords)
+{
+	if (r.size() != coords.size())
+		QDP_error_exit("pokeSites: %d values for %d sites", r.size(), coords.size());
+
+	for(int k=0; k < coords.size(); ++k)
+		if (Layout::nodeNumber() == Layout::nodeNumber(coords[k]))
+			l.elem(Layout::linearSiteIndex(coords[k])) = r[k].elem();
+
+	return l;
+}
+
+
 //! Copy data values from field src to array dest
 /*! @ingroup group1
 	@param dest	 target to update
@@ -1875,322 +2595,1060 @@ struct TagVisitor<FnMap, PrintTag> : public ParenPrinter<FnMap>
 #endif
 
 
+// Forward declarations
+template<class T1> class MapHandle;
+template<class T1> class ShiftedLeaf;
+template<class T1, class Op> class ShiftedProjLeaf;
+
+//! Leaf built by a map of the expression RHS of a T1 field
+/*! The default shifts the evaluated expression */
+template<class RHS, class T1, class Enable = void> struct MapExprLeaf;
+
+//! The spin projections, whose result is mapped as half spinors
+/*! Type_t only exists for the projection functors */
+template<class Op> struct SpinProjectOp {};
+template<> struct SpinProjectOp<FnSpinProjectDir0Minus> {typedef void Type_t;};
+template<> struct SpinProjectOp<FnSpinProjectDir1Minus> {typedef void Type_t;};
+template<> struct SpinProjectOp<FnSpinProjectDir2Minus> {typedef void Type_t;};
+template<> struct SpinProjectOp<FnSpinProjectDir3Minus> {typedef void Type_t;};
+template<> struct SpinProjectOp<FnSpinProjectDir0Plus>  {typedef void Type_t;};
+template<> struct SpinProjectOp<FnSpinProjectDir1Plus>  {typedef void Type_t;};
+template<> struct SpinProjectOp<FnSpinProjectDir2Plus>  {typedef void Type_t;};
+template<> struct SpinProjectOp<FnSpinProjectDir3Plus>  {typedef void Type_t;};
+
 //! General permutation map class for communications
 class Map
 {
 public:
 	//! Constructor - does nothing really
-	Map() {}
+	Map() : offnodeP(false), comm_channel(-1) {}
 
 	//! Destructor
-	~Map() {}
+	~Map() {freeComms(); freeSplitSets();}
 
 	//! Constructor from a function object
-	Map(const MapFunc& fn) {make(fn);}
+	Map(const MapFunc& fn) : offnodeP(false), comm_channel(-1) {make(fn);}
 
 	//! Actual constructor from a function object
 	/*! The semantics are		source_site = func(dest_site,isign) */
 	void make(const MapFunc& func);
 
+	//! Release the persistent communication buffers and message handles
+	/*! 
+	 * Buffers are rebuilt on demand by the next shift that needs them.
+	 */
+	void freeComms();
+
+	//! Release the persistent communications of every map
+	/*! Called from QDP_finalize before the message passing is shut down */
+	static void freeAllComms();
+
+	//! Count the communications of this map under label
+	/*! 
+	 * Maps are counted under "map" unless given a label. Maps with the
+	 * same label share their counts, see CommStats.
+	 */
+	void setCommLabel(const std::string& label) {comm_channel = CommStats::channel(label);}
+
+	//! Start a split-phase map of a lattice field
+	/*!
+	 * Gathers and launches the face of l and returns at once. The
+	 * returned handle completes the map with finish(). In between, sites
+	 * in interior() need no off-node data and can be worked on while the
+	 * messages are in flight.
+	 *
+	 * The source l must not be modified or destroyed before the handle
+	 * is finished.
+	 */
+	template<class T1>
+	MapHandle<T1> start(const OLattice<T1>& l);
+
+	//! Sites of s whose mapped source lives on this node
+	/*! The subset is built and cached on first use for each Set */
+	const Subset& interior(const Subset& s);
+
+	//! Sites of s whose mapped source comes from another node
+	/*! The subset is built and cached on first use for each Set */
+	const Subset& boundary(const Subset& s);
+
+	//! The map for destinations in s only
+	/*!
+	 * Its face holds only the sites that some site of s reads, e.g.
+	 * half the face of a nearest neighbour shift for a checkerboard.
+	 * Shifts through it are right on s only. It is built on first use
+	 * for each subset, which is collective and must not happen while
+	 * messages of maps between the same nodes are in flight. Returns
+	 * this map when s is a whole Set.
+	 */
+	Map& restricted(const Subset& s);
+
+	//! dest(x) = src(x+offsets) for a record of bytes bytes at each site
+	/*! 
+	 * E.g. all the vectors of a site of a LatticeBlock, see
+	 * qdp_multirhs.h. The records of the face go in one message per
+	 * node whatever they hold, and the interior is copied while the
+	 * messages are in flight.
+	 */
+	void shiftRecords(void* dest, const void* src, size_t bytes);
+
+	//! dest(x) = src(x+offsets) for x in ds, with dest and src stored on subsets
+	/*!
+	 * Site i of dest is record dpos[i] and site k of src is record
+	 * spos[k] of its nsrc records, see OSubLattice. Every x of ds must
+	 * take its source from the subset of src. Only the records of src
+	 * travel, and the interior of ds is copied while they are in flight.
+	 */
+	void shiftCompact(void* dest, const Subset& ds, const int* dpos,
+			  const void* src, const int* spos, int nsrc, size_t bytes);
+
 	//! Function call operator for a shift
 	/*! 
 	 * map(source)
 	 *
 	 * Implements:	dest(x) = s1(x+offsets)
 	 *
-	 * Shifts on a OLattice are non-trivial.
+	 * Shifts on a OLattice are non-trivial. The result is a ShiftedLeaf
+	 * in the expression tree that reads on-node sites through goffsets
+	 * and off-node sites from the receive buffer, so no shifted temporary
+	 * is made. The face is exchanged once the use of the shift is known,
+	 * when it is put into a larger expression or evaluated, so that a
+	 * spin projection of the shift only sends half spinors.
 	 *
 	 * Notice, this implementation does not allow an Inner grid
 	 */
 	template<class T1>
-	OLattice<T1>
-	operator()(const OLattice<T1> & l)
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
+	operator()(const OLattice<T1> & l);
+
+	template<class T1>
+	OScalar<T1>
+	operator()(const OScalar<T1> & l)
+		{
+			return l;
+		}
+
+	template<class RHS, class T1>
+	OScalar<T1>
+	operator()(const QDPExpr<RHS,OScalar<T1> > & l)
+		{
+			// For now, simply evaluate the expression and then do the map
+			typedef OScalar<T1> C1;
+
+//		fprintf(stderr,"map(QDPExpr<OScalar>)\n");
+			OScalar<T1> d = this->operator()(C1(l));
+
+			return d;
+		}
+
+	//! Shift of an expression
+	/*! 
+	 * The expression is evaluated once into a temporary owned by the
+	 * returned leaf. A spin projection of a field is not evaluated: only
+	 * its face is projected and exchanged, as half spinors, and the
+	 * on-node sites are projected as they are read.
+	 */
+	template<class RHS, class T1>
+	typename MakeReturn<typename MapExprLeaf<RHS,T1>::Leaf_t, OLattice<T1> >::Expression_t
+	operator()(const QDPExpr<RHS,OLattice<T1> > & l);
+
+	//! Shift of a field stored on a subset
+	/*! 
+	 * It is scattered into a full temporary owned by the returned leaf.
+	 * The compact shift of ArrayBiDirectionalMap avoids the temporary.
+	 */
+	template<class T1>
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
+	operator()(const OSubLattice<T1> & l);
+
+	//! Shift read only on the subset s
+	/*! 
+	 * Only the face sites that s needs are sent, see restricted(). For
+	 * e.g. chi[rb[1]] = u[mu]*shift(psi,FORWARD,mu,rb[1]).
+	 */
+	template<class T1>
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
+	operator()(const OLattice<T1> & l, const Subset& s)
+		{
+			return restricted(s)(l);
+		}
+
+	template<class RHS, class T1>
+	typename MakeReturn<typename MapExprLeaf<RHS,T1>::Leaf_t, OLattice<T1> >::Expression_t
+	operator()(const QDPExpr<RHS,OLattice<T1> > & l, const Subset& s)
+		{
+			return restricted(s)(l);
+		}
+
+
+public:
+	//! Accessor to offsets
+	const multi1d<int>& goffset() const {return goffsets;}
+	const multi1d<int>& soffset() const {return soffsets;}
+
+	//! Receive buffer index per site, -1 if on-node, see NeighbourTable
+	const multi1d<int>& roffset() const {return roffsets;}
+
+private:
+	//! Hide copy constructor
+	Map(const Map&) {}
+
+	//! Hide operator=
+	void operator=(const Map&) {}
+
+private:
+	//! Offset table used for communications. 
+	/*! 
+	 * The direction is in the sense of the Map or Shift functions from QDP.
+	 * goffsets(position) 
+	 */ 
+	multi1d<int> goffsets;
+	multi1d<int> soffsets;
+	multi1d<int> srcnode;
+	multi1d<int> dstnode;
+	multi1d<int> roffsets;    // receive buffer index per site, -1 if on-node
+
+	multi1d<int> srcenodes;
+	multi1d<int> destnodes;
+
+	multi1d<int> srcenodes_num;
+	multi1d<int> destnodes_num;
+
+	// Indicate off-node communications is needed;
+	bool offnodeP;
+
+	// Where the communications are counted
+	int comm_channel;
+
+	//! Persistent communication resources for one size of site object
+	/*! 
+	 * The packed send/receive buffers and the declared QMP message
+	 * handles only depend on the map and sizeof(T1), so they are set
+	 * up once and reused by every shift of an object of that size.
+	 * Faces for nodes on this host go through NodeShm channels instead
+	 * of QMP messages, and with -rma-comms on the faces for the other
+	 * nodes go through NodeRma channels.
+	 */
+	struct MapComms
 	{
-#if QDP_DEBUG >= 3
-		QDP_info("Map()");
-#endif
+		int elem_size;                 // sizeof(T1) these buffers serve
+		bool host;                     // packed by the host threads even with offload
+		QMP_mem_t *send_buf_mem;
+		QMP_mem_t *recv_buf_mem;
+		void *send_buf;                // packed data to send
+		void *recv_buf;                // packed receive data
+		void *dev_send;                // device memory the face is packed into, or null
+		bool staged;                   // dev_send is copied to send_buf per destination
+		std::vector<QMP_msgmem_t> msg; // one per source and destination node
+		QMP_msghandle_t mh;            // all the messages, or only the receives when staged, or null
+		std::vector<QMP_msghandle_t> send_mh;  // one per destination node when staged, null for a channel
+		std::vector<NodeShm::Channel*> recv_shm;  // per source node, null when it is a message
+		std::vector<NodeShm::Channel*> send_shm;  // per destination node, likewise
+		std::vector<NodeRma::Channel*> recv_rma;  // per source node, null when not put
+		std::vector<NodeRma::Channel*> send_rma;  // per destination node, likewise
+		bool in_flight;                // started but not yet waited on
+		int users;                     // live shifted leaves reading recv_buf
+		std::vector<CommStats::Message> stats_msgs;  // the messages as counted
+		QDPTime_t t_start;             // when the messages were started
+	};
+
+	//! Find or build free persistent comms for objects of size elem_size
+	MapComms& getComms(int elem_size, bool host = false);
+
+	//! Exchange the face of l and return the comms holding it
+	/*! Returns null when the map is entirely on-node */
+	template<class T1>
+	MapComms* exchange(const OLattice<T1>& l);
+
+	//! Exchange the face of l with op applied to each site sent
+	/*! Returns null when the map is entirely on-node */
+	template<class Op, class T1>
+	MapComms* exchange(const OLattice<T1>& l, const Op& op);
 
-		OLattice<T1> d;
-		const int nodeSites = Layout::sitesOnNode();
+	//! Start the messages of mh, all of them or the receives when staged
+	void startReceives(MapComms& c);
 
-		if (offnodeP)
+	//! Start the send to destination p when staged or through a channel
+	void startSend(MapComms& c, int p);
+
+	//! Start all the messages of the face packed in c
+	void startComms(MapComms& c);
+
+	//! Wait on the messages of c
+	void waitComms(MapComms& c);
+
+	//! Pack the face of l with Op applied into c and start the messages
+	template<class Op, class T1>
+	void startFace(MapComms& c, const OLattice<T1>& l);
+
+	//! Pack the face of l into send_buf
+	/*! Dispatched like evaluate; the packing order is fixed by soffsets */
+	template<class T1>
+	void gatherFace(T1 *send_buf, const OLattice<T1>& l) const
 		{
-	// Off-node communications required
 #if QDP_DEBUG >= 3
-			QDP_info("Map: off-node communications required");
+			for(int si=0; si < soffsets.size(); ++si) 
+				QDP_info("Map_scatter_send(buf[%d],olattice[%d])",si,soffsets[si]);
 #endif
 
-	// Eventually these declarations should move into d - the return object
-			typedef T1 * T1ptr;
-			T1 **dest = new(std::nothrow) T1ptr[nodeSites];
-			if( dest == 0x0 ) { 
-				QDP_error_exit("Unable to new T1ptr in OLattice<T1>::operator()\n");
+#if defined(QDP_USE_OMP_OFFLOAD)
+			if (Offload::use(soffsets.size()))
+			{
+				Offload::gather(send_buf, 0, l.getF(), soffsets.slice(), soffsets.size());
+				return;
 			}
-			QMP_msgmem_t msg[2];
-			QMP_msghandle_t mh_a[2], mh;
-
-#if 0
-			// This test has been moved into Map::create.
-			// For now, will assume there is only 1 destination nod e 
-			// and receive from only 1 node
-			if (srcenodes.size() != 1)
-				QDP_error_exit("Map: for now only allow 1 destination node");
-	
-			if (destnodes.size() != 1)
-				QDP_error_exit("Map: for now only allow receives from 1 node");
 #endif
+			GatherThreadArgs<T1> args(send_buf, 0, l.getF(), soffsets.slice(), 0);
+			dispatch_to_threads(soffsets.size(), args, gatherKernel<T1>);
+		}
 
-			int dstnum = destnodes_num[0]*sizeof(T1);
-			int srcnum = srcenodes_num[0]*sizeof(T1);
-
-	// Try getting fast and communicable memory
-			QMP_mem_t *send_buf_mem = QMP_allocate_aligned_memory(dstnum,QDP_ALIGNMENT_SIZE, 
-								(QMP_MEM_COMMS|QMP_MEM_FAST) ); // packed data to send
-	if( send_buf_mem == 0x0 ) { 
-				send_buf_mem = QMP_allocate_aligned_memory(dstnum, QDP_ALIGNMENT_SIZE, 
-									QMP_MEM_COMMS);
-				if( send_buf_mem == 0x0 ) { 
-					QDP_error_exit("Unable to allocate send_buf_mem\n");
-				}
-			}
+	//! Pack the face of l into send_buf on the host threads
+	template<class T1>
+	void packFace(T1 *send_buf, const OLattice<T1>& l, const Offload::PackCopy&) const;
 
-			QMP_mem_t *recv_buf_mem = QMP_allocate_aligned_memory(srcnum,QDP_ALIGNMENT_SIZE, 
-										(QMP_MEM_COMMS|QMP_MEM_FAST)); // packed receive data
-			if( recv_buf_mem == 0x0 ) { 
-				recv_buf_mem = QMP_allocate_aligned_memory(srcnum, QDP_ALIGNMENT_SIZE, QMP_MEM_COMMS); 
-				if( recv_buf_mem == 0x0 ) { 
-					QDP_error_exit("Unable to allocate recv_buf_mem\n");
-				}
-			}
-				
-			T1 *send_buf = (T1 *)QMP_get_memory_pointer(send_buf_mem);
-			T1 *recv_buf = (T1 *)QMP_get_memory_pointer(recv_buf_mem);
+	template<class H, class T1, class Op>
+	void packFace(H *send_buf, const OLattice<T1>& l, const Op&) const;
 
-			// Total and utter paranoia
-			if ( send_buf == 0x0 ) { 
-				QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (send_buf)\n");
-			}
+	std::vector<MapComms*> comms;
 
-			if ( recv_buf == 0x0 ) { 
-				QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (recv_buf)\n"); 
-			}
+	//! Set splitting each subset of a Set into interior and boundary sites
+	/*! Subset 2*c is the interior and 2*c+1 the boundary of color c */
+	const Set& splitSet(const Set& ss);
 
-			const int my_node = Layout::nodeNumber();
+	//! Release the cached interior/boundary sets and restricted maps
+	void freeSplitSets();
 
-			// Gather the face of data to send
-			// For now, use the all subset
-			for(int si=0; si < soffsets.size(); ++si) 
+	//! Make this the map m for destinations in s
+	void restrictFrom(const Map& m, const Subset& s);
+
+	//! Take the tables of the map key from the table cache, see TableCache
+	bool loadTables(const std::string& key);
+
+	//! Keep the tables in the table cache under key
+	void storeTables(const std::string& key) const;
+
+	std::map<const Set*, Set*> split_sets;
+	std::map<std::pair<const Set*,int>, Map*> restricted_maps;
+
+	template<class T1> friend class MapHandle;
+	template<class T1> friend class ShiftedLeaf;
+	template<class T1, class Op> friend class ShiftedProjLeaf;
+	friend class ArrayBiDirectionalMap;
+};
+
+
+//! Handle for a split-phase map started with Map::start
+/*!
+ * Typical use overlaps the halo exchange with the interior work:
+ *
+ *   MapHandle<T> h = shift.start(psi, FORWARD, mu);
+ *   h.copyInterior(tmp);
+ *   chi[h.interior(rb[cb])] = u[mu] * tmp;
+ *   h.finishBoundary(tmp);
+ *   chi[h.boundary(rb[cb])] = u[mu] * tmp;
+ */
+template<class T1>
+class MapHandle
+{
+public:
+	MapHandle(Map& m, const OLattice<T1>& l, Map::MapComms* c) : 
+		map(&m), src(&l), goff(m.goffsets.slice()), roff(m.roffsets.slice()), recv(0), comms(c) {}
+
+	//! Fill dest on the interior sites - needs no communications
+	void copyInterior(OLattice<T1>& dest) const
+		{
+			const Subset& inner = map->interior(all);
+
+			GatherThreadArgs<T1> args(writable(dest).getF(), 0, src->getF(), map->goffsets.slice(), inner.traversalTable().slice());
+			dispatch_to_threads(inner.numSiteTable(), args, gatherKernel<T1>);
+		}
+
+	//! Wait on the messages and fill dest on the boundary sites
+	void finishBoundary(OLattice<T1>& dest)
+		{
+			if (comms == 0)
+				return;
+
+			map->waitComms(*comms);
+
+			const Subset& face = map->boundary(all);
+
+			GatherThreadArgs<T1> args(writable(dest).getF(), 0, (const T1 *)comms->recv_buf, map->roffsets.slice(), face.traversalTable().slice());
+			dispatch_to_threads(face.numSiteTable(), args, gatherKernel<T1>);
+
+			comms = 0;
+		}
+
+	//! Wait on the messages, after which elem reads every site
+	/*! 
+	 * The received face is read in place, so it must be used before the
+	 * map is started again.
+	 */
+	void wait()
+		{
+			if (comms == 0)
+				return;
+
+			map->waitComms(*comms);
+			recv = (const T1 *)comms->recv_buf;
+			comms = 0;
+		}
+
+	//! Site i of the mapped field
+	/*! Only the interior sites can be read before wait() */
+	inline const T1& elem(int i) const
+		{
+			int r = roff[i];
+			return (r < 0) ? src->elem(goff[i]) : recv[r];
+		}
+
+	//! The received face, in the order of Map::roffset(), once waited on
+	/*! Null before wait() or when nothing comes from another node */
+	const T1* face() const {return recv;}
+
+	//! Wait on the messages and fill all of dest
+	void finish(OLattice<T1>& dest)
+		{
+			copyInterior(dest);
+			finishBoundary(dest);
+		}
+
+	//! Wait on the messages and return the mapped field
+	OLattice<T1> finish()
+		{
+			OLattice<T1> d;
+			finish(d);
+			return d;
+		}
+
+	//! Sites of s that need no off-node data
+	const Subset& interior(const Subset& s = all) const {return map->interior(s);}
+
+	//! Sites of s that need off-node data
+	const Subset& boundary(const Subset& s = all) const {return map->boundary(s);}
+
+private:
+	Map* map;
+	const OLattice<T1>* src;
+	const int* goff;
+	const int* roff;
+	const T1* recv;            // the face, once waited on
+	Map::MapComms* comms;      // null when there is nothing to wait on
+};
+
+
+//! Start a split-phase map of a lattice field
+template<class T1>
+MapHandle<T1> Map::start(const OLattice<T1>& l)
+{
+	if (! offnodeP)
+		return MapHandle<T1>(*this, l, 0);
+
+	MapComms& c = getComms(sizeof(T1));
+	startFace<Offload::PackCopy>(c, l);
+
+	return MapHandle<T1>(*this, l, &c);
+}
+
+
+//! Expression tree leaf for a shifted lattice field
+/*!
+ * Built by Map::operator(). Site i reads the source at goffsets[i] when
+ * it is on this node and the receive buffer otherwise, so e.g.
+ * u[mu]*shift(psi,FORWARD,mu) is evaluated in a single sweep without a
+ * shifted temporary.
+ *
+ * The face is not exchanged when the leaf is made but by start(), which
+ * is called when the shift is put into a larger expression or, for a
+ * shift alone, by the site loops before the first site is read. Until
+ * then a spin projection can take the leaf over and send half spinors.
+ *
+ * A shift alone evaluated on a subset only exchanges the face sites
+ * that subset reads, see Map::restricted. Reading it on more sites
+ * later exchanges again.
+ *
+ * The leaf holds on to the receive buffer, and for a shifted expression
+ * to the evaluated source, until its last copy is destroyed.
+ */
+template<class T1>
+class ShiftedLeaf
+{
+public:
+	//! Reference counted source made by evaluating a shifted expression
+	struct Source
+	{
+		template<class RHS>
+		Source(const QDPExpr<RHS,OLattice<T1> >& rhs) : count(0), field(rhs) {}
+
+		//! The sites of a field stored on a subset, the others are not set
+		Source(const OSubLattice<T1>& l) : count(0) {field[l.subset()] = l;}
+
+		int count;
+		OLattice<T1> field;
+	};
+
+	//! Leaf of map m of l, exchanged by start()
+	ShiftedLeaf(Map& m, const OLattice<T1>& l, Source* s = 0) :
+		map(&m), by(&m), src(&l), goff(m.goffsets.slice()), roff(m.roffsets.slice()), 
+		recv(0), comms(0), owned(s), pending(m.offnodeP)
+		{
+			acquire();
+		}
+
+	//! Leaf reading off-node sites from a buffer owned by the caller
+	/*! r_idx gives the position in r of each off-node site, -1 otherwise */
+	ShiftedLeaf(const Map& m, const OLattice<T1>& l, const int* r_idx, const T1* r) :
+		map(0), by(0), src(&l), goff(m.goffsets.slice()), roff(r_idx), 
+		recv(r), comms(0), owned(0), pending(false) {}
+
+	ShiftedLeaf(const ShiftedLeaf& a) :
+		map(a.map), by(a.by), src(a.src), goff(a.goff), roff(a.roff), recv(a.recv), 
+		comms(a.comms), owned(a.owned), pending(a.pending)
+		{
+			acquire();
+		}
+
+	~ShiftedLeaf() {release();}
+
+	//! Exchange the face if that has not been done yet. Collective
+	void start() const
+		{
+			if (pending || by != map)
+				exchangeBy(*map);
+		}
+
+	//! Exchange the face sites that the sites of s read. Collective
+	void start(const Subset& s) const
+		{
+			if (! map)
+				return;
+
+			Map& r = map->restricted(s);
+			if (pending || (by != map && by != &r))
+				exchangeBy(r);
+		}
+
+	//! Site i of the shifted field
+	inline const T1& elem(int i) const
+		{
+			int r = roff[i];
+			return (r < 0) ? src->elem(goff[i]) : recv[r];
+		}
+
+	//! The field being shifted
+	const OLattice<T1>& source() const {return *src;}
+
+private:
+	//! Hide operator=
+	void operator=(const ShiftedLeaf&) {}
+
+	//! Exchange the face of m, m being map or one restricted from it
+	void exchangeBy(Map& m) const
+		{
+			if (comms) --(comms->users);
+
+			comms = m.exchange(*src);
+			recv = (comms == 0) ? 0 : (const T1 *)comms->recv_buf;
+			roff = m.roffsets.slice();
+			if (comms) ++(comms->users);
+			by = &m;
+			pending = false;
+		}
+
+	void acquire()
+		{
+			if (comms) ++(comms->users);
+			if (owned) ++(owned->count);
+		}
+
+	void release()
+		{
+			if (comms) --(comms->users);
+			if (owned && --(owned->count) == 0)
+				delete owned;
+		}
+
+	Map* map;                  // null when the face is not exchanged here
+	mutable Map* by;           // map whose face recv holds, map or restricted from it
+	const OLattice<T1>* src;
+	const int* goff;
+	mutable const int* roff;
+	mutable const T1* recv;    // null when the map is on-node
+	mutable Map::MapComms* comms;
+	Source* owned;
+	mutable bool pending;      // face not exchanged yet
+
+	template<class T2, class Op> friend class ShiftedProjLeaf;
+};
+
+
+//! Expression tree leaf for a spin projection of a shifted field
+/*!
+ * Site i is Op applied to site i of the shift. Only the face is
+ * projected before it is exchanged, so half as many bytes are sent as
+ * for the full spinors, and the on-node sites are projected as they are
+ * read. Built by spinProjectDir*(shift(psi,...)) and
+ * shift(spinProjectDir*(psi),...).
+ */
+template<class T1, class Op>
+class ShiftedProjLeaf
+{
+public:
+	typedef typename UnaryReturn<T1, Op>::Type_t  H;
+
+	//! Projection of the shift s, exchanged here. Collective
+	/*! s needs not have been started */
+	ShiftedProjLeaf(const ShiftedLeaf<T1>& s) : 
+		shifted(s), recv(0), comms(s.map->exchange(s.source(), Op()))
+		{
+			if (comms)
 			{
+				recv = (const H *)comms->recv_buf;
+				++(comms->users);
+			}
+		}
+
+	ShiftedProjLeaf(const ShiftedProjLeaf& a) : 
+		shifted(a.shifted), recv(a.recv), comms(a.comms)
+		{
+			if (comms) ++(comms->users);
+		}
+
+	~ShiftedProjLeaf() {if (comms) --(comms->users);}
+
+	//! Site i of the projected shifted field
+	inline H elem(int i) const
+		{
+			int r = shifted.roff[i];
+			return (r < 0) ? H(Op()(shifted.src->elem(shifted.goff[i]))) : recv[r];
+		}
+
+	//! The field being shifted
+	const OLattice<T1>& source() const {return shifted.source();}
+
+private:
+	//! Hide operator=
+	void operator=(const ShiftedProjLeaf&) {}
+
+	ShiftedLeaf<T1> shifted;   // never started, holds the offsets and source
+	const H* recv;
+	Map::MapComms* comms;
+};
+
+
+//! Exchange the face of l and return the comms holding it
+template<class T1>
+Map::MapComms* Map::exchange(const OLattice<T1>& l)
+{
+	if (! offnodeP)
+		return 0;
+
+	// Off-node communications required
 #if QDP_DEBUG >= 3
-				QDP_info("Map_scatter_send(buf[%d],olattice[%d])",si,soffsets[si]);
+	QDP_info("Map: off-node communications required");
 #endif
 
-				send_buf[si] = l.elem(soffsets[si]);
-			}
+	// Persistent buffers and message handles for this object size.
+	// They are built on the first shift of a T1 and reused afterwards
+	MapComms& c = getComms(sizeof(T1));
+	startFace<Offload::PackCopy>(c, l);
+	waitComms(c);
 
-			// Set the dest gather pointers
-			// For now, use the all subset
+	return &c;
+}
 
-		// no threading to avoid confusion with order of recv_buf (and fast anyways)
-			for(int i=0, ri=0; i < nodeSites; ++i) 
-			{
-				if (srcnode[i] != my_node)
-				{
-#if QDP_DEBUG >= 3
-					QDP_info("Map_gather_recv(olattice[%d],recv[%d])",i,ri);
+
+//! Arguments for packing a face with an operation applied
+template<class T1, class Op>
+struct ProjectThreadArgs
+{
+	typedef typename UnaryReturn<T1, Op>::Type_t  H;
+
+	ProjectThreadArgs(H *out_, const T1 *in_, const int *iidx_) : 
+		out(out_), in(in_), iidx(iidx_) {}
+
+	H *out;
+	const T1 *in;
+	const int *iidx;
+};
+
+//! user function packing out[k] = Op(in[iidx[k]])
+template<class T1, class Op>
+void projectKernel(int lo, int hi, int myId, ProjectThreadArgs<T1,Op> *a)
+{
+	for(int k=lo; k < hi; ++k)
+		a->out[k] = Op()(a->in[a->iidx[k]]);
+}
+
+
+//! Pack the face of l as it is
+template<class T1>
+void Map::packFace(T1 *send_buf, const OLattice<T1>& l, const Offload::PackCopy&) const
+{
+	gatherFace(send_buf, l);
+}
+
+//! Pack the face of l with Op applied
+template<class H, class T1, class Op>
+void Map::packFace(H *send_buf, const OLattice<T1>& l, const Op&) const
+{
+	ProjectThreadArgs<T1,Op> args(send_buf, l.getF(), soffsets.slice());
+	dispatch_to_threads(soffsets.size(), args, projectKernel<T1,Op>);
+}
+
+
+template<class Op, class T1>
+void Map::startFace(MapComms& c, const OLattice<T1>& l)
+{
+	typedef typename Offload::PackType<T1, Op>::Type_t  H;
+
+#if defined(QDP_USE_OMP_OFFLOAD)
+	if (c.dev_send)
+	{
+		H *dev = (H *)c.dev_send;
+		if (! c.staged)
+		{
+			Offload::pack<Op>(dev, l.getF(), soffsets.slice(), soffsets.size());
+			startComms(c);
+			return;
+		}
+
+		// Receives first, then each destination's part is packed, copied
+		// to the host and sent while the next part is packed
+		startReceives(c);
+
+		int off = 0;
+		for(int p=0; p < destnodes.size(); ++p)
+		{
+			const int n = destnodes_num[p];
+			Offload::pack<Op>(dev + off, l.getF(), soffsets.slice() + off, n);
+			Offload::copyToHost((H *)c.send_buf + off, dev + off, n*sizeof(H));
+			startSend(c, p);
+			off += n;
+		}
+		return;
+	}
 #endif
 
-					dest[i] = &(recv_buf[ri++]);
-				}
-				else
-				{
+	packFace((H *)c.send_buf, l, Op());
+	startComms(c);
+}
+
+
+//! Exchange the face of l with op applied to each site sent
+template<class Op, class T1>
+Map::MapComms* Map::exchange(const OLattice<T1>& l, const Op& op)
+{
+	typedef typename UnaryReturn<T1, Op>::Type_t  H;
+
+	if (! offnodeP)
+		return 0;
+
+	// The buffers are those of any object of the size of the result
+	MapComms& c = getComms(sizeof(H));
+	startFace<Op>(c, l);
+	waitComms(c);
+
+	return &c;
+}
+
+
+//! Shift of a lattice field
+template<class T1>
+typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
+Map::operator()(const OLattice<T1> & l)
+{
 #if QDP_DEBUG >= 3
-					QDP_info("Map_gather_onnode(olattice[%d],olattice[%d])",i,goffsets[i]);
+	QDP_info("Map()");
 #endif
 
-					dest[i] = &(const_cast<T1&>(l.elem(goffsets[i])));
-				}
-			}
+	typedef ShiftedLeaf<T1> Tree_t;
+	return MakeReturn<Tree_t,OLattice<T1> >::make(Tree_t(*this, l));
+}
 
-			QMP_status_t err;
 
-#if QDP_DEBUG >= 3
-			QDP_info("Map: send = 0x%x	recv = 0x%x",send_buf,recv_buf);
-			QDP_info("Map: establish send=%d recv=%d",destnodes[0],srcenodes[0]);
-			{
-				const multi1d<int>& me = Layout::nodeCoord();
-				multi1d<int> scrd = Layout::getLogicalCoordFrom(destnodes[0]);
-				multi1d<int> rcrd = Layout::getLogicalCoordFrom(srcenodes[0]);
+//! Map of a general expression
+template<class RHS, class T1, class Enable>
+struct MapExprLeaf
+{
+	typedef ShiftedLeaf<T1> Leaf_t;
 
-				QDP_info("Map: establish-info		my_crds=[%d,%d,%d,%d]",me[0],me[1],me[2],me[3]);
-				QDP_info("Map: establish-info send_crds=[%d,%d,%d,%d]",scrd[0],scrd[1],scrd[2],scrd[3]);
-				QDP_info("Map: establish-info recv_crds=[%d,%d,%d,%d]",rcrd[0],rcrd[1],rcrd[2],rcrd[3]);
-			}
-#endif
+	static Leaf_t make(Map& m, const QDPExpr<RHS,OLattice<T1> >& l)
+		{
+			// Evaluate the expression once, then shift the result lazily
+			typename Leaf_t::Source* s = new typename Leaf_t::Source(l);
+			return Leaf_t(m, s->field, s);
+		}
+};
+
+//! Map of a spin projection of a field
+template<class Op, class T, class T1>
+struct MapExprLeaf<UnaryNode<Op, Reference<QDPType<T, OLattice<T> > > >, T1, 
+									 typename SpinProjectOp<Op>::Type_t>
+{
+	typedef ShiftedProjLeaf<T,Op> Leaf_t;
+
+	static Leaf_t make(Map& m, const QDPExpr<UnaryNode<Op, Reference<QDPType<T, OLattice<T> > > >, OLattice<T1> >& l)
+		{
+			const OLattice<T>& psi = static_cast<const OLattice<T>&>(l.expression().child());
+			return Leaf_t(ShiftedLeaf<T>(m, psi));
+		}
+};
 
-			msg[0]	= QMP_declare_msgmem(recv_buf, srcnum);
-			if( msg[0] == (QMP_msgmem_t)NULL ) { 
-				QDP_error_exit("QMP_declare_msgmem for msg[0] failed in Map::operator()\n");
-			}
-			msg[1]	= QMP_declare_msgmem(send_buf, dstnum);
-			if( msg[1] == (QMP_msgmem_t)NULL ) {
-				QDP_error_exit("QMP_declare_msgmem for msg[1] failed in Map::operator()\n");
-			}
 
-			mh_a[0] = QMP_declare_receive_from(msg[0], srcenodes[0], 0);
-			if( mh_a[0] == (QMP_msghandle_t)NULL ) { 
-				QDP_error_exit("QMP_declare_receive_from for mh_a[0] failed in Map::operator()\n");
-			}
+//! Shift of an expression
+template<class RHS, class T1>
+typename MakeReturn<typename MapExprLeaf<RHS,T1>::Leaf_t, OLattice<T1> >::Expression_t
+Map::operator()(const QDPExpr<RHS,OLattice<T1> > & l)
+{
+	typedef typename MapExprLeaf<RHS,T1>::Leaf_t Tree_t;
+	return MakeReturn<Tree_t,OLattice<T1> >::make(MapExprLeaf<RHS,T1>::make(*this, l));
+}
 
-			mh_a[1] = QMP_declare_send_to(msg[1], destnodes[0], 0);
-			if( mh_a[1] == (QMP_msghandle_t)NULL ) {
-				QDP_error_exit("QMP_declare_send_to for mh_a[1] failed in Map::operator()\n");
-			}
 
-			mh			= QMP_declare_multiple(mh_a, 2);
-			if( mh == (QMP_msghandle_t)NULL ) { 
-				QDP_error_exit("QMP_declare_multiple for mh failed in Map::operator()\n");
-			}
+template<class T1>
+typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
+Map::operator()(const OSubLattice<T1> & l)
+{
+	typedef ShiftedLeaf<T1> Tree_t;
+	typename Tree_t::Source* s = new typename Tree_t::Source(l);
+	return MakeReturn<Tree_t,OLattice<T1> >::make(Tree_t(*this, s->field, s));
+}
 
-#if QDP_DEBUG >= 3
-			QDP_info("Map: calling start send=%d recv=%d",destnodes[0],srcenodes[0]);
-#endif
 
-			// Launch the faces
-			if ((err = QMP_start(mh)) != QMP_SUCCESS)
-				QDP_error_exit(QMP_error_string(err));
+//-----------------------------------------------------------------------------
+// Specialization of LeafFunctor class for applying the EvalLeaf1
+// tag to a ShiftedLeaf
+template<class T1>
+struct LeafFunctor<ShiftedLeaf<T1>, EvalLeaf1>
+{
+	typedef typename SiteLoad<T1>::Type_t Type_t;
+	inline static Type_t apply(const ShiftedLeaf<T1> &a, const EvalLeaf1 &f)
+		{return SiteLoad<T1>::load(a.elem(f.val1()));}
+};
+
+// A shift alone at the top of an expression is handed out as a plain
+// reference, since assigning from a Reference<T1> would be ambiguous
+template<class T1, class CTag>
+struct ForEach<QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >, EvalLeaf1, CTag>
+{
+	typedef const T1& Type_t;
+	inline static
+	Type_t apply(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& expr, const EvalLeaf1 &f, 
+							 const CTag &c) 
+		{
+			return expr.expression().elem(f.val1());
+		}
+};
 
-#if QDP_DEBUG >= 3
-			QDP_info("Map: calling wait");
-#endif
+// The on-node sites of a shift are read straight from the source
+template<class T1>
+struct LeafFunctor<ShiftedLeaf<T1>, DestAliasLeaf>
+{
+	typedef bool Type_t;
+	inline static Type_t apply(const ShiftedLeaf<T1> &a, const DestAliasLeaf &f)
+		{return LeafFunctor<OLattice<T1>, DestAliasLeaf>::apply(a.source(), DestAliasLeaf(f.dest, true));}
+};
 
-			// Wait on the faces
-			if ((err = QMP_wait(mh)) != QMP_SUCCESS)
-				QDP_error_exit(QMP_error_string(err));
+template<class T1>
+struct LeafFunctor<ShiftedLeaf<T1>, ReadsFieldLeaf>
+{
+	typedef bool Type_t;
+	inline static Type_t apply(const ShiftedLeaf<T1> &a, const ReadsFieldLeaf &f)
+		{return LeafFunctor<OLattice<T1>, ReadsFieldLeaf>::apply(a.source(), f);}
+};
 
-#if QDP_DEBUG >= 3
-			QDP_info("Map: calling free msgs");
+#if defined(QDP_USE_PROFILING)	 
+template<class T1>
+struct LeafFunctor<ShiftedLeaf<T1>, PrintTag>
+{
+	typedef int Type_t;
+	static int apply(const ShiftedLeaf<T1> &s, const PrintTag &f)
+		{ 
+			f.os_m << "shift(OLat<";
+			LeafFunctor<T1,PrintTag>::apply(s.elem(0),f);
+			f.os_m << ">)"; 
+			return 0;
+		}
+};
 #endif
 
-			//	QMP_free_msghandle(mh_a[1]);
-			//	QMP_free_msghandle(mh_a[0]);
-			QMP_free_msghandle(mh);
-			QMP_free_msgmem(msg[1]);
-			QMP_free_msgmem(msg[0]);
+template<class T1>
+struct LeafFunctor<ShiftedLeaf<T1>, ByteCountLeaf>
+{
+	typedef int Type_t;
+	inline static Type_t apply(const ShiftedLeaf<T1> &s, const ByteCountLeaf &f) {return sizeof(T1);}
+};
 
-			// Scatter the data into the destination
-			// Some of the data maybe in receive buffers
-			// For now, use the all subset
-#pragma omp parallel for
-			for(int i=0; i < nodeSites; ++i) 
-			{
-#if QDP_DEBUG >= 3
-				QDP_info("Map_scatter(olattice[%d],olattice[0x%x])",i,dest[i]);
-#endif
-				d.elem(i) = *(dest[i]);
-			}
+template<class T1>
+struct LeafFunctor<ShiftedLeaf<T1>, FlopCountLeaf>
+{
+	typedef ExprFlops<T1> Type_t;
+	inline static Type_t apply(const ShiftedLeaf<T1> &s, const FlopCountLeaf &f) {return Type_t();}
+};
 
-			// Cleanup
-			QMP_free_memory(recv_buf_mem);
-			QMP_free_memory(send_buf_mem);
-			delete[] dest;
+// Putting a shift into a larger expression fixes its use, so the face
+// is exchanged there
+template<class T1>
+struct CreateLeaf<QDPExpr<ShiftedLeaf<T1>, OLattice<T1> > >
+{
+	typedef QDPExpr<ShiftedLeaf<T1>, OLattice<T1> > Input_t;
+	typedef ShiftedLeaf<T1> Leaf_t;
 
-#if QDP_DEBUG >= 3
-			QDP_info("finished cleanup");
-#endif
-		}
-		else 
+	inline static
+	const Leaf_t &make(const Input_t& a)
 		{
-			// No off-node communications - copy on node
-#if QDP_DEBUG >= 3
-			QDP_info("Map: copy on node - no communications, try this");
-#endif
-
-			// For now, use the all subset
-#pragma omp parallel for
-			for(int i=0; i < nodeSites; ++i) 
-			{
-#if QDP_DEBUG >= 3
-				QDP_info("Map(olattice[%d],olattice[%d])",i,goffsets[i]);
-#endif
-				d.elem(i) = l.elem(goffsets[i]);
-			}
+			a.expression().start();
+			return a.expression();
 		}
+};
 
-#if QDP_DEBUG >= 3
-		QDP_info("exiting Map()");
-#endif
+//! Launch the exchange of a shift at the top of an expression
+template<class T1>
+inline void startShifts(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& rhs)
+{
+	rhs.expression().start();
+}
 
-		return d;
-	}
+//! Launch the exchange of a shift at the top of an expression read on s
+template<class T1>
+inline void startShifts(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& rhs, const Subset& s)
+{
+	rhs.expression().start(s);
+}
 
 
-	template<class T1>
-	OScalar<T1>
-	operator()(const OScalar<T1> & l)
-		{
-			return l;
-		}
+//-----------------------------------------------------------------------------
+// Specialization of LeafFunctor class for applying the EvalLeaf1
+// tag to a ShiftedProjLeaf
+template<class T1, class Op>
+struct LeafFunctor<ShiftedProjLeaf<T1,Op>, EvalLeaf1>
+{
+	typedef typename ShiftedProjLeaf<T1,Op>::H Type_t;
+	inline static Type_t apply(const ShiftedProjLeaf<T1,Op> &a, const EvalLeaf1 &f)
+		{return a.elem(f.val1());}
+};
 
-	template<class RHS, class T1>
-	OScalar<T1>
-	operator()(const QDPExpr<RHS,OScalar<T1> > & l)
-		{
-			// For now, simply evaluate the expression and then do the map
-			typedef OScalar<T1> C1;
+// The on-node sites are projected straight from the source
+template<class T1, class Op>
+struct LeafFunctor<ShiftedProjLeaf<T1,Op>, DestAliasLeaf>
+{
+	typedef bool Type_t;
+	inline static Type_t apply(const ShiftedProjLeaf<T1,Op> &a, const DestAliasLeaf &f)
+		{return LeafFunctor<OLattice<T1>, DestAliasLeaf>::apply(a.source(), DestAliasLeaf(f.dest, true));}
+};
 
-//		fprintf(stderr,"map(QDPExpr<OScalar>)\n");
-			OScalar<T1> d = this->operator()(C1(l));
+template<class T1, class Op>
+struct LeafFunctor<ShiftedProjLeaf<T1,Op>, ReadsFieldLeaf>
+{
+	typedef bool Type_t;
+	inline static Type_t apply(const ShiftedProjLeaf<T1,Op> &a, const ReadsFieldLeaf &f)
+		{return LeafFunctor<OLattice<T1>, ReadsFieldLeaf>::apply(a.source(), f);}
+};
 
-			return d;
+#if defined(QDP_USE_PROFILING)	 
+template<class T1, class Op>
+struct LeafFunctor<ShiftedProjLeaf<T1,Op>, PrintTag>
+{
+	typedef int Type_t;
+	static int apply(const ShiftedProjLeaf<T1,Op> &s, const PrintTag &f)
+		{ 
+			f.os_m << "spinProject(shift(OLat<";
+			LeafFunctor<T1,PrintTag>::apply(s.source().elem(0),f);
+			f.os_m << ">))"; 
+			return 0;
 		}
+};
+#endif
 
-	template<class RHS, class T1>
-	OLattice<T1>
-	operator()(const QDPExpr<RHS,OLattice<T1> > & l)
-		{
-			// For now, simply evaluate the expression and then do the map
-			typedef OLattice<T1> C1;
+template<class T1, class Op>
+struct LeafFunctor<ShiftedProjLeaf<T1,Op>, ByteCountLeaf>
+{
+	typedef int Type_t;
+	inline static Type_t apply(const ShiftedProjLeaf<T1,Op> &s, const ByteCountLeaf &f) {return sizeof(T1);}
+};
 
-//		fprintf(stderr,"map(QDPExpr<OLattice>)\n");
-			OLattice<T1> d = this->operator()(C1(l));
+template<class T1, class Op>
+struct LeafFunctor<ShiftedProjLeaf<T1,Op>, FlopCountLeaf>
+{
+	typedef ExprFlops<typename ShiftedProjLeaf<T1,Op>::H> Type_t;
+	inline static Type_t apply(const ShiftedProjLeaf<T1,Op> &s, const FlopCountLeaf &f) {return Type_t();}
+};
 
-			return d;
-		}
 
+//! Spin projection of a shift, exchanged as half spinors
+template<class T1, class Op>
+inline typename MakeReturn<ShiftedProjLeaf<T1,Op>, 
+	OLattice<typename ShiftedProjLeaf<T1,Op>::H> >::Expression_t
+projectShift(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l, const Op&)
+{
+	typedef ShiftedProjLeaf<T1,Op> Tree_t;
+	return MakeReturn<Tree_t, OLattice<typename Tree_t::H> >::make(Tree_t(l.expression()));
+}
 
-public:
-	//! Accessor to offsets
-	const multi1d<int>& goffset() const {return goffsets;}
-	const multi1d<int>& soffset() const {return soffsets;}
+// The spin projections of a shift project the face before it is sent
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir0Minus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir0Minus>::Type_t>::Expression_t
+spinProjectDir0Minus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir0Minus());
+}
 
-private:
-	//! Hide copy constructor
-	Map(const Map&) {}
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir1Minus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir1Minus>::Type_t>::Expression_t
+spinProjectDir1Minus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir1Minus());
+}
 
-	//! Hide operator=
-	void operator=(const Map&) {}
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir2Minus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir2Minus>::Type_t>::Expression_t
+spinProjectDir2Minus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir2Minus());
+}
 
-private:
-	//! Offset table used for communications. 
-	/*! 
-	 * The direction is in the sense of the Map or Shift functions from QDP.
-	 * goffsets(position) 
-	 */ 
-	multi1d<int> goffsets;
-	multi1d<int> soffsets;
-	multi1d<int> srcnode;
-	multi1d<int> dstnode;
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir3Minus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir3Minus>::Type_t>::Expression_t
+spinProjectDir3Minus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir3Minus());
+}
 
-	multi1d<int> srcenodes;
-	multi1d<int> destnodes;
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir0Plus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir0Plus>::Type_t>::Expression_t
+spinProjectDir0Plus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir0Plus());
+}
 
-	multi1d<int> srcenodes_num;
-	multi1d<int> destnodes_num;
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir1Plus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir1Plus>::Type_t>::Expression_t
+spinProjectDir1Plus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir1Plus());
+}
 
-	// Indicate off-node communications is needed;
-	bool offnodeP;
-};
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir2Plus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir2Plus>::Type_t>::Expression_t
+spinProjectDir2Plus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir2Plus());
+}
+
+template<class T1>
+inline typename MakeReturn<ShiftedProjLeaf<T1,FnSpinProjectDir3Plus>, 
+	typename UnaryReturn<OLattice<T1>, FnSpinProjectDir3Plus>::Type_t>::Expression_t
+spinProjectDir3Plus(const QDPExpr<ShiftedLeaf<T1>, OLattice<T1> >& l)
+{
+	return projectShift(l, FnSpinProjectDir3Plus());
+}
 
 
 //-----------------------------------------------------------------------------
@@ -2222,7 +3680,7 @@ public:
 	 * This routine is very architecture dependent.
 	 */
 	template<class T1>
-	OLattice<T1>
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
 	operator()(const OLattice<T1> & l, int dir)
 		{
 #if QDP_DEBUG >= 3
@@ -2255,7 +3713,7 @@ public:
 		}
 
 	template<class RHS, class T1>
-	OLattice<T1>
+	typename MakeReturn<typename MapExprLeaf<RHS,T1>::Leaf_t, OLattice<T1> >::Expression_t
 	operator()(const QDPExpr<RHS,OLattice<T1> > & l, int dir)
 		{
 //		fprintf(stderr,"ArrayMap(QDPExpr<OLattice>,%d)\n",dir);
@@ -2265,6 +3723,22 @@ public:
 		}
 
 
+	//! Start a split-phase map(source,dir)
+	/*! See Map::start */
+	template<class T1>
+	MapHandle<T1>
+	start(const OLattice<T1> & l, int dir)
+		{
+			return mapsa[dir].start(l);
+		}
+
+	//! Release the persistent communications of all the maps
+	void freeComms()
+		{
+			for(int i=0; i < mapsa.size(); ++i)
+				mapsa[i].freeComms();
+		}
+
 private:
 	//! Hide copy constructor
 	ArrayMap(const ArrayMap&) {}
@@ -2306,7 +3780,7 @@ public:
 	 * This routine is very architecture dependent.
 	 */
 	template<class T1>
-	OLattice<T1>
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
 	operator()(const OLattice<T1> & l, int isign)
 		{
 #if QDP_DEBUG >= 3
@@ -2340,7 +3814,7 @@ public:
 		}
 
 	template<class RHS, class T1>
-	OLattice<T1>
+	typename MakeReturn<typename MapExprLeaf<RHS,T1>::Leaf_t, OLattice<T1> >::Expression_t
 	operator()(const QDPExpr<RHS,OLattice<T1> > & l, int isign)
 		{
 //		fprintf(stderr,"BiDirectionalMap(QDPExpr<OLattice>,%d)\n",isign);
@@ -2350,6 +3824,22 @@ public:
 		}
 
 
+	//! Start a split-phase map(source,isign)
+	/*! See Map::start */
+	template<class T1>
+	MapHandle<T1>
+	start(const OLattice<T1> & l, int isign)
+		{
+			return bimaps[(isign+1)>>1].start(l);
+		}
+
+	//! Release the persistent communications of both maps
+	void freeComms()
+		{
+			for(int i=0; i < bimaps.size(); ++i)
+				bimaps[i].freeComms();
+		}
+
 private:
 	//! Hide copy constructor
 	BiDirectionalMap(const BiDirectionalMap&) {}
@@ -2369,13 +3859,13 @@ class ArrayBiDirectionalMap
 {
 public:
 	//! Constructor - does nothing really
-	ArrayBiDirectionalMap() {}
+	ArrayBiDirectionalMap() : comm_label("bimap"), batch_channel(-1) {}
 
 	//! Destructor
-	~ArrayBiDirectionalMap() {}
+	~ArrayBiDirectionalMap() {freeBatches();}
 
 	//! Constructor from a function object
-	ArrayBiDirectionalMap(const ArrayMapFunc& fn) {make(fn);}
+	ArrayBiDirectionalMap(const ArrayMapFunc& fn) : comm_label("bimap"), batch_channel(-1) {make(fn);}
 
 	//! Actual constructor from a function object
 	/*! The semantics are		source_site = func(dest_site,isign,dir) */
@@ -2400,7 +3890,7 @@ public:
 	 * This routine is very architecture dependent.
 	 */
 	template<class T1>
-	OLattice<T1>
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
 	operator()(const OLattice<T1> & l, int isign, int dir)
 		{
 #if QDP_DEBUG >= 3
@@ -2433,7 +3923,7 @@ public:
 		}
 
 	template<class RHS, class T1>
-	OLattice<T1>
+	typename MakeReturn<typename MapExprLeaf<RHS,T1>::Leaf_t, OLattice<T1> >::Expression_t
 	operator()(const QDPExpr<RHS,OLattice<T1> > & l, int isign, int dir)
 		{
 //		fprintf(stderr,"ArrayBiDirectionalMap(QDPExpr<OLattice>,%d,%d)\n",isign,dir);
@@ -2442,6 +3932,116 @@ public:
 			return bimapsa((isign+1)>>1,dir)(l);
 		}
 
+	template<class T1>
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
+	operator()(const OSubLattice<T1> & l, int isign, int dir)
+		{
+			return bimapsa((isign+1)>>1,dir)(l);
+		}
+
+	//! map(source,isign,dir) read only on the subset s
+	/*! 
+	 * Only the face sites s needs travel, e.g. half the face for
+	 * chi[rb[1]] = u[mu]*shift(psi,FORWARD,mu,rb[1]). See Map::restricted
+	 */
+	template<class T1>
+	typename MakeReturn<ShiftedLeaf<T1>, OLattice<T1> >::Expression_t
+	operator()(const OLattice<T1> & l, int isign, int dir, const Subset& s)
+		{
+			return bimapsa((isign+1)>>1,dir)(l, s);
+		}
+
+	template<class RHS, class T1>
+	typename MakeReturn<typename MapExprLeaf<RHS,T1>::Leaf_t, OLattice<T1> >::Expression_t
+	operator()(const QDPExpr<RHS,OLattice<T1> > & l, int isign, int dir, const Subset& s)
+		{
+			return bimapsa((isign+1)>>1,dir)(l, s);
+		}
+
+	//! map(source,isign,dir) applied k times, as a single exchange
+	/*! 
+	 * shift(psi,FORWARD,mu,3) is psi(x+3mu) with one message of the 3
+	 * deep face in place of three nearest neighbor shifts, each waiting
+	 * on the one before. The map is kept per (direction, k), see
+	 * distanceMap.
+	 */
+	template<class T1>
+	inline auto operator()(const T1& l, int isign, int dir, int k)
+		-> decltype(std::declval<Map&>()(l))
+		{
+			return distanceMap(isign, dir, k)(l);
+		}
+
+
+	//! Start a split-phase map(source,isign,dir)
+	/*! See Map::start */
+	template<class T1>
+	MapHandle<T1>
+	start(const OLattice<T1> & l, int isign, int dir)
+		{
+			return bimapsa((isign+1)>>1,dir).start(l);
+		}
+
+	//! The map used for map(source,isign,dir)
+	Map& getMap(int isign, int dir) {return bimapsa((isign+1)>>1,dir);}
+
+	//! y_k = map(x_k,isign,dir) for every vector k of a block
+	/*! The vectors of a site move together, see Map::shiftRecords */
+	template<class T1>
+	void operator()(LatticeBlock<T1>& y, const LatticeBlock<T1>& x, int isign, int dir)
+		{
+			if (y.numRHS() != x.numRHS() || &y == &x)
+				QDP_error_exit("shift: blocks of %d and %d vectors, or in place", y.numRHS(), x.numRHS());
+
+			getMap(isign,dir).shiftRecords(y.getF(), x.getF(), x.numRHS()*sizeof(T1));
+		}
+
+	//! d = map(s,isign,dir) on the subset of d, both stored on their subsets
+	/*! 
+	 * E.g. the even sites of a shifted odd field, with no full lattice
+	 * field in between. The sources of the sites of d must be in the
+	 * subset of s.
+	 */
+	template<class T1>
+	void operator()(OSubLattice<T1>& d, const OSubLattice<T1>& s, int isign, int dir)
+		{
+			if (! d.getOwnsMemory() || ! s.getOwnsMemory() || &d == &s)
+				QDP_error_exit("shift: compact fields needed, not in place");
+
+			getMap(isign,dir).shiftCompact(d.getF(), d.subset(), d.sitePos(),
+						       s.getF(), s.sitePos(), s.subset().numSiteTable(), sizeof(T1));
+		}
+
+	//! Map source in every direction and sign with a single exchange
+	/*!
+	 * dest((isign+1)>>1,dir) = map(l,isign,dir)
+	 *
+	 * The faces for all the maps are gathered first and exchanged with
+	 * one batch of messages, so there is one wait instead of one per
+	 * direction and sign.
+	 */
+	template<class T1>
+	void all(multi2d< OLattice<T1> >& dest, const OLattice<T1>& l);
+
+	//! Release the persistent communications of all the maps
+	void freeComms()
+		{
+			freeBatches();
+
+			for(int i=0; i < bimapsa.size2(); ++i)
+				for(int j=0; j < bimapsa.size1(); ++j)
+					bimapsa(i,j).freeComms();
+		}
+
+	//! Release only the batched communications
+	void freeBatches();
+
+	//! Count the communications of the maps under label
+	/*! 
+	 * map(source,isign,dir) is counted as "label(isign,dir)" and all()
+	 * as "label all". The default label is "bimap".
+	 */
+	void setCommLabel(const std::string& label);
 
 private:
 	//! Hide copy constructor
@@ -2452,10 +4052,86 @@ private:
 
 private:
 	multi2d<Map> bimapsa;
-	
+
+	//! Persistent resources to exchange the faces of all maps at once
+	struct BatchComms
+	{
+		int elem_size;                 // sizeof(T1) these buffers serve
+		multi2d< multi1d<int> > send_idx;  // send_buf position of each soffsets entry
+		multi2d< multi1d<int> > recv_idx;  // recv_buf position of each site, -1 if on-node
+		QMP_mem_t *send_buf_mem;
+		QMP_mem_t *recv_buf_mem;
+		void *send_buf;
+		void *recv_buf;
+		std::vector<QMP_msgmem_t> msg;
+		QMP_msghandle_t mh;            // null when no map goes off-node
+		std::vector<CommStats::Message> stats_msgs;  // the messages as counted
+	};
+
+	//! Find or build the batched comms for objects of size elem_size
+	BatchComms& getBatch(int elem_size);
+
+	std::vector<BatchComms*> batches;
+
+	std::string comm_label;
+	int batch_channel;
 };
 
 
+//! Map source in every direction and sign with a single exchange
+template<class T1>
+void ArrayBiDirectionalMap::all(multi2d< OLattice<T1> >& dest, const OLattice<T1>& l)
+{
+#if QDP_DEBUG >= 3
+	QDP_info("ArrayBiDirectionalMap::all(OLattice)");
+#endif
+
+	dest.resize(bimapsa.size2(), bimapsa.size1());
+
+	BatchComms& b = getBatch(sizeof(T1));
+	T1 *send_buf = (T1 *)b.send_buf;
+	const T1 *recv_buf = (const T1 *)b.recv_buf;
+
+	// Gather the faces of every map
+	for(int i=0; i < bimapsa.size2(); ++i)
+		for(int j=0; j < bimapsa.size1(); ++j)
+		{
+			if (! bimapsa(i,j).offnodeP)
+				continue;
+
+			const multi1d<int>& soff = bimapsa(i,j).soffsets;
+
+			GatherThreadArgs<T1> args(send_buf, b.send_idx(i,j).slice(), l.getF(), soff.slice(), 0);
+			dispatch_to_threads(soff.size(), args, gatherKernel<T1>);
+		}
+
+	// One launch and one wait for all the faces
+	if (b.mh)
+	{
+		QMP_status_t err;
+
+		QDPTime_t t0 = getClockTime();
+		if ((err = QMP_start(b.mh)) != QMP_SUCCESS)
+			QDP_error_exit(QMP_error_string(err));
+
+		QDPTime_t t1 = getClockTime();
+		if ((err = QMP_wait(b.mh)) != QMP_SUCCESS)
+			QDP_error_exit(QMP_error_string(err));
+
+		CommStats::Stats::noteExchange(batch_channel, b.stats_msgs, t0, t1, getClockTime());
+	}
+
+	// Each result reads the on-node sites from l and the rest from its face
+	typedef ShiftedLeaf<T1> Tree_t;
+	for(int i=0; i < bimapsa.size2(); ++i)
+		for(int j=0; j < bimapsa.size1(); ++j)
+		{
+			Tree_t leaf(bimapsa(i,j), l, b.recv_idx(i,j).slice(), recv_buf);
+			dest(i,j) = MakeReturn<Tree_t,OLattice<T1> >::make(leaf);
+		}
+}
+
+
 //-----------------------------------------------------------------------------
 
 //! Binary output
@@ -2505,14 +4181,14 @@ XMLWriter& operator<<(XMLWriter& xml, const OLattice<T>& d)
 	// Find the location of each site and send to primary node
 	for(int site=0; site < Layout::vol(); ++site)
 	{
-		multi1d<int> coord = crtesn(site, Layout::lattSize());
+		Layout::LatticeCoord coord;
+		Layout::lexicoCoord(site, coord);
 
 		int node	 = Layout::nodeNumber(coord);
-		int linear = Layout::linearSiteIndex(coord);
 
 		// Copy to buffer: be really careful since max(linear) could vary among nodes
 		if (Layout::nodeNumber() == node)
-			recv_buf = d.elem(linear);
+			recv_buf = d.elem(Layout::linearSiteIndex(coord));
 
 		// Send result to primary node. Avoid sending prim-node sending to itself
 		if (node != 0)
@@ -2592,14 +4268,14 @@ void writeOLattice(BinaryWriter& bin,
 //! Write a single site of a lattice quantity
 /*! Assumes no inner grid */
 template<class T>
-void write(BinaryWriter& bin, OSubLattice<T> dd)
+void write(BinaryWriter& bin, const OSubLattice<T>& dd)
 {
-	const OLattice<T>& d = dd.field();
-
-	writeOLattice(bin, (const char *)&(d.elem(0)), 
-		sizeof(typename WordType<T>::Type_t), 
-		sizeof(T) / sizeof(typename WordType<T>::Type_t),
-		dd.subset());
+	withFullField(dd, true, false, [&bin](OLattice<T>& d, const Subset& s) {
+		writeOLattice(bin, (const char *)&(d.elem(0)), 
+			sizeof(typename WordType<T>::Type_t), 
+			sizeof(T) / sizeof(typename WordType<T>::Type_t),
+			s);
+	});
 }
 
 
@@ -2644,12 +4320,14 @@ void readOLattice(BinaryReader& bin,
 //! Read a single site of a lattice quantity
 /*! Assumes no inner grid */
 template<class T>
-void read(BinaryReader& bin, OSubLattice<T> d)
+void read(BinaryReader& bin, const OSubLattice<T>& dd)
 {
-	readOLattice(bin, (char *)(d.field().getF()),
-				 sizeof(typename WordType<T>::Type_t), 
-				 sizeof(T) / sizeof(typename WordType<T>::Type_t),
-				 d.subset());
+	withFullField(dd, false, true, [&bin](OLattice<T>& d, const Subset& s) {
+		readOLattice(bin, (char *)(writable(d).getF()),
+					 sizeof(typename WordType<T>::Type_t), 
+					 sizeof(T) / sizeof(typename WordType<T>::Type_t),
+					 s);
+	});
 }
 
 
@@ -23,6 +23,28 @@ namespace Layout
 }
 
 
+//-----------------------------------------------------------------------------
+// Lanes of the vector sites a subset touches
+namespace OuterGrid
+{
+  //! The outer sites of a subset with a bit set for each of its lanes
+  struct Lanes
+  {
+    multi1d<int> outer;
+    multi1d<unsigned int> mask;
+  };
+
+  //! All lanes of an outer site
+  const unsigned int fullMask = (1u << INNER_LEN) - 1;
+
+  //! The lanes of s, made on first use and kept until the next Set::make
+  const Lanes& lanes(const Subset& s);
+
+  //! Forget the lanes of all subsets
+  void clear();
+}
+
+
 //-----------------------------------------------------------------------------
 // Internal ops with ties to QMP
 namespace QDPInternal
@@ -96,6 +118,16 @@ namespace QDPInternal
     globalSumArray((W *)&dest, sizeof(T)/sizeof(W)); // call appropriate hook
   }
 
+  //! Global sum on a multi1d
+  template<class T>
+  inline void globalSumArray(multi1d<T>& dest)
+  {
+    // The implementation here is relying on the structure being packed
+    // tightly in memory - no padding
+    typedef typename WordType<T>::Type_t  W;   // find the machine word type
+    globalSumArray((W *)dest.slice(), dest.size()*sizeof(T)/sizeof(W)); // call appropriate hook
+  }
+
   //! Broadcast from primary node to all other nodes
   template<class T>
   inline void broadcast(T& dest)
@@ -123,6 +155,99 @@ namespace QDPInternal
 
 #define QDP_NOT_IMPLEMENTED
 
+//-----------------------------------------------------------------------------
+// Threading over the outer grid
+//
+// Each outer site holds INNER_LEN sites, so the loops below go over
+// outer sites with dispatch_to_threads the way the parscalar loops go
+// over sites. Subsets are only handled when they cover whole outer sites.
+
+//! Outer sites first .. last of an ordered subset made of whole outer sites
+/*! Returns false when the subset does not split along outer sites */
+inline bool outerRange(const Subset& s, int& first, int& last)
+{
+  if (! s.hasOrderedRep())
+    return false;
+  if ((s.start() & (INNER_LEN-1)) != 0 || ((s.end()+1) & (INNER_LEN-1)) != 0)
+    return false;
+
+  first = s.start() >> INNER_LOG;
+  last  = s.end() >> INNER_LOG;
+  return true;
+}
+
+
+//! user argument for the evaluate function over outer sites
+template<class T, class RHS, class Op>
+struct OuterEvalArgs
+{
+  OuterEvalArgs(OLattice<T>& d_, const RHS& r_, const Op& op_, int first_) :
+    d(d_), r(r_), op(op_), first(first_) {}
+
+  OLattice<T>& d;
+  const RHS& r;
+  const Op& op;
+  int first;
+};
+
+//! user function for an OLattice expression over outer sites
+template<class T, class RHS, class Op>
+void outerEvalKernel(int lo, int hi, int myId, OuterEvalArgs<T,RHS,Op> *a)
+{
+  for(int i=a->first+lo; i < a->first+hi; ++i)
+    a->op(a->d.elem(i), forEach(a->r, EvalLeaf1(i), OpCombine()));
+}
+
+//! user function for an OScalar expression over outer sites
+template<class T, class RHS, class Op>
+void outerScalarKernel(int lo, int hi, int myId, OuterEvalArgs<T,RHS,Op> *a)
+{
+  for(int i=a->first+lo; i < a->first+hi; ++i)
+    a->op(a->d.elem(i), forEach(a->r, EvalLeaf1(0), OpCombine()));
+}
+
+
+//! user argument for the evaluate function over the lanes of a subset
+template<class T, class RHS, class Op>
+struct MaskedEvalArgs
+{
+  MaskedEvalArgs(OLattice<T>& d_, const RHS& r_, const Op& op_, const OuterGrid::Lanes& l_) :
+    d(d_), r(r_), op(op_), outer(l_.outer.slice()), mask(l_.mask.slice()) {}
+
+  OLattice<T>& d;
+  const RHS& r;
+  const Op& op;
+  const int *outer;
+  const unsigned int *mask;
+};
+
+//! user function for an expression over the lanes of a subset
+/*!
+ * Outer sites with all lanes in the subset are done as vectors. The
+ * others are done as vectors into a copy, and only the lanes in the
+ * subset are copied back, so the other lanes keep their values
+ */
+template<class T, class RHS, class Op>
+void maskedEvalKernel(int lo, int hi, int myId, MaskedEvalArgs<T,RHS,Op> *a)
+{
+  for(int j=lo; j < hi; ++j)
+  {
+    const int i = a->outer[j];
+    const unsigned int m = a->mask[j];
+    if (m == OuterGrid::fullMask)
+    {
+      a->op(a->d.elem(i), forEach(a->r, EvalLeaf1(i), OpCombine()));
+      continue;
+    }
+
+    T tmp = a->d.elem(i);
+    a->op(tmp, forEach(a->r, EvalLeaf1(i), OpCombine()));
+    for(int k=0; k < INNER_LEN; ++k)
+      if (m & (1u << k))
+	copy_site(a->d.elem(i), k, getSite(tmp, k));
+  }
+}
+
 //-----------------------------------------------------------------------------
 //! OLattice Op Scalar(Expression(source)) under an Subset
 /*! 
@@ -138,21 +263,23 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 
 #if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(dest, op, rhs);
+  ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
   prof.time -= getClockTime();
 #endif
 
-#if ! defined(QDP_NOT_IMPLEMENTED)
-  const int *tab = s.siteTable().slice();
-  for(int j=0; j < s.numSiteTable(); ++j) 
+  int first, last;
+  if (outerRange(s, first, last))
   {
-    int i = tab[j];
-//    fprintf(stderr,"eval(olattice,oscalar): site %d\n",i);
-//    op(dest.elem(i), forEach(rhs, ElemLeaf(), OpCombine()));
-    op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
+    OuterEvalArgs<T,QDPExpr<RHS,OScalar<T1> >,Op> args(dest, rhs, op, first);
+    dispatch_to_threads(last-first+1, args, outerScalarKernel<T,QDPExpr<RHS,OScalar<T1> >,Op>);
+  }
+  else
+  {
+    // Checkerboards and other subsets that split the vector sites
+    const OuterGrid::Lanes& lanes = OuterGrid::lanes(s);
+    MaskedEvalArgs<T,QDPExpr<RHS,OScalar<T1> >,Op> args(dest, rhs, op, lanes);
+    dispatch_to_threads(lanes.outer.size(), args, maskedEvalKernel<T,QDPExpr<RHS,OScalar<T1> >,Op>);
   }
-#else
-  QDP_error("evaluateSubset not implemented");
-#endif
 
 #if defined(QDP_USE_PROFILING)   
   prof.time += getClockTime();
@@ -176,21 +303,23 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 
 #if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(dest, op, rhs);
+  ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
   prof.time -= getClockTime();
 #endif
 
-#if ! defined(QDP_NOT_IMPLEMENTED)
-  // General form of loop structure
-  const int *tab = s.siteTable().slice();
-  for(int j=0; j < s.numSiteTable(); ++j) 
+  int first, last;
+  if (outerRange(s, first, last))
   {
-    int i = tab[j];
-//    fprintf(stderr,"eval(olattice,olattice): site %d\n",i);
-    op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
+    OuterEvalArgs<T,QDPExpr<RHS,OLattice<T1> >,Op> args(dest, rhs, op, first);
+    dispatch_to_threads(last-first+1, args, outerEvalKernel<T,QDPExpr<RHS,OLattice<T1> >,Op>);
+  }
+  else
+  {
+    // Checkerboards and other subsets that split the vector sites
+    const OuterGrid::Lanes& lanes = OuterGrid::lanes(s);
+    MaskedEvalArgs<T,QDPExpr<RHS,OLattice<T1> >,Op> args(dest, rhs, op, lanes);
+    dispatch_to_threads(lanes.outer.size(), args, maskedEvalKernel<T,QDPExpr<RHS,OLattice<T1> >,Op>);
   }
-#else
-  QDP_error("evaluateSubset not implemented");
-#endif
 
 #if defined(QDP_USE_PROFILING)   
   prof.time += getClockTime();
@@ -203,6 +332,51 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 
 
 //-----------------------------------------------------------------------------
+//! user argument for copymask over outer sites
+template<class T1, class T2>
+struct OuterCopymaskArgs
+{
+  OuterCopymaskArgs(OLattice<T2>& d_, const OLattice<T1>& m_, const OLattice<T2>& s1_,
+		    const OuterGrid::Lanes* l_ = 0) :
+    dest(d_), mask(m_), s1(s1_), lanes(l_) {}
+
+  OLattice<T2>& dest;
+  const OLattice<T1>& mask;
+  const OLattice<T2>& s1;
+  const OuterGrid::Lanes* lanes;
+};
+
+//! user function for copymask over outer sites
+template<class T1, class T2>
+void outerCopymaskKernel(int lo, int hi, int myId, OuterCopymaskArgs<T1,T2> *a)
+{
+  for(int i=lo; i < hi; ++i) 
+    copymask(a->dest.elem(i), a->mask.elem(i), a->s1.elem(i));
+}
+
+//! user function for copymask over the lanes of a subset
+template<class T1, class T2>
+void maskedCopymaskKernel(int lo, int hi, int myId, OuterCopymaskArgs<T1,T2> *a)
+{
+  for(int j=lo; j < hi; ++j) 
+  {
+    const int i = a->lanes->outer[j];
+    const unsigned int m = a->lanes->mask[j];
+    if (m == OuterGrid::fullMask)
+    {
+      copymask(a->dest.elem(i), a->mask.elem(i), a->s1.elem(i));
+      continue;
+    }
+      
+    T2 tmp = a->dest.elem(i);
+    copymask(tmp, a->mask.elem(i), a->s1.elem(i));
+    for(int k=0; k < INNER_LEN; ++k)
+      if (m & (1u << k))
+	copy_site(a->dest.elem(i), k, getSite(tmp, k));
+  }
+}
+
+
 //! dest = (mask) ? s1 : dest
 template<class T1, class T2> 
 void 
@@ -211,16 +385,8 @@ copymask(OSubLattice<T2,Subset> d, const OLattice<T1>& mask, const OLattice<T2>&
   OLattice<T2>& dest = d.field();
   const Subset& s = d.subset();
 
-#if ! defined(QDP_NOT_IMPLEMENTED)
-  const int *tab = s.siteTable().slice();
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    copymask(dest.elem(i), mask.elem(i), s1.elem(i));
-  }
-#else
-  QDP_error("copymask_Subset not implemented");
-#endif
+  OuterCopymaskArgs<T1,T2> args(dest, mask, s1, &OuterGrid::lanes(s));
+  dispatch_to_threads(args.lanes->outer.size(), args, maskedCopymaskKernel<T1,T2>);
 }
 
 
@@ -229,9 +395,8 @@ template<class T1, class T2>
 void 
 copymask(OLattice<T2>& dest, const OLattice<T1>& mask, const OLattice<T2>& s1) 
 {
-  const int iend = Layout::outerSitesOnNode();
-  for(int i=0; i < iend; ++i) 
-    copymask(dest.elem(i), mask.elem(i), s1.elem(i));
+  OuterCopymaskArgs<T1,T2> args(dest, mask, s1);
+  dispatch_to_threads(Layout::outerSitesOnNode(), args, outerCopymaskKernel<T1,T2>);
 }
 
 
@@ -352,20 +517,45 @@ void gaussian(OLattice<T>& d)
 
 //-----------------------------------------------------------------------------
 // Broadcast operations
+//! user argument for zero_rep over the lanes of a subset
+template<class T>
+struct MaskedZeroArgs
+{
+  OLattice<T>* d;
+  const OuterGrid::Lanes* lanes;
+};
+
+//! user function for zero_rep over the lanes of a subset
+template<class T>
+void maskedZeroKernel(int lo, int hi, int myId, MaskedZeroArgs<T> *a)
+{
+  typedef typename UnaryReturn<T, FnGetSite>::Type_t  Site_t;  // strip-off inner-grid
+
+  Site_t z;
+  zero_rep(z);
+
+  for(int j=lo; j < hi; ++j) 
+  {
+    const int i = a->lanes->outer[j];
+    const unsigned int m = a->lanes->mask[j];
+    if (m == OuterGrid::fullMask)
+    {
+      zero_rep(a->d->elem(i));
+      continue;
+    }
+
+    for(int k=0; k < INNER_LEN; ++k)
+      if (m & (1u << k))
+	copy_site(a->d->elem(i), k, z);
+  }
+}
+
 //! dest  = 0 
 template<class T> 
 void zero_rep(OLattice<T>& dest, const Subset& s) 
 {
-#if ! defined(QDP_NOT_IMPLEMENTED)
-  const int *tab = s.siteTable().slice();
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    zero_rep(dest.elem(i));
-  }
-#else
-  QDP_error("zero_rep_Subset not implemented");
-#endif
+  MaskedZeroArgs<T> args = {&dest, &OuterGrid::lanes(s)};
+  dispatch_to_threads(args.lanes->outer.size(), args, maskedZeroKernel<T>);
 }
 
 
@@ -381,13 +571,20 @@ void zero_rep(OSubLattice<T,S> dd)
 }
 
 
+//! user function for zero_rep over outer sites
+template<class T>
+void outerZeroKernel(int lo, int hi, int myId, OLattice<T> **d)
+{
+  for(int i=lo; i < hi; ++i) 
+    zero_rep((*d)->elem(i));
+}
+
 //! dest  = 0 
 template<class T> 
 void zero_rep(OLattice<T>& dest) 
 {
-  const int iend = Layout::outerSitesOnNode();
-  for(int i=0; i < iend; ++i) 
-    zero_rep(dest.elem(i));
+  OLattice<T>* d = &dest;
+  dispatch_to_threads(Layout::outerSitesOnNode(), d, outerZeroKernel<T>);
 }
 
 
@@ -451,6 +648,63 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1)
 
 
 
+//! user argument for the sum of an OLattice expression over outer sites
+template<class RHS, class T>
+struct OuterSumArgs
+{
+  OuterSumArgs(const QDPExpr<RHS,OLattice<T> >& s_,
+	       multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest_, int first_,
+	       const OuterGrid::Lanes* l_ = 0) :
+    s(s_), dest(dest_), first(first_), lanes(l_) {}
+
+  const QDPExpr<RHS,OLattice<T> >& s;
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest;
+  int first;
+  const OuterGrid::Lanes* lanes;   //!< when set, the outer sites and lanes to sum
+};
+
+//! user function for the sum over outer sites
+/*!
+ * Each thread leaves its partial sum in dest[myId]. Whole outer sites
+ * are summed as vectors with one horizontal add each, the lanes of
+ * split outer sites one by one
+ */
+template<class RHS, class T>
+void outerSumKernel(int lo, int hi, int myId, OuterSumArgs<RHS,T> *a)
+{
+  typename UnaryReturn<OLattice<T>, FnSum>::Type_t dthread;
+  OScalar<T> tmp;   // Note, expect to have ILattice inner grid
+  zero_rep(dthread.elem());
+
+  if (! a->lanes)
+  {
+    for(int i=a->first+lo; i < a->first+hi; ++i) 
+    {
+      tmp.elem() = forEach(a->s, EvalLeaf1(i), OpCombine()); // Evaluate to ILattice part
+      dthread.elem() += sum(tmp.elem());    // sum as well the ILattice part
+    }
+  }
+  else
+  {
+    for(int j=lo; j < hi; ++j) 
+    {
+      const int i = a->lanes->outer[j];
+      const unsigned int m = a->lanes->mask[j];
+      tmp.elem() = forEach(a->s, EvalLeaf1(i), OpCombine());
+
+      if (m == OuterGrid::fullMask)
+	dthread.elem() += sum(tmp.elem());
+      else
+	for(int k=0; k < INNER_LEN; ++k)
+	  if (m & (1u << k))
+	    dthread.elem() += getSite(tmp.elem(),k);
+    }
+  }
+
+  a->dest[myId].elem() = dthread.elem();
+}
+
+
 //! OScalar = sum(OLattice)  under an explicit subset
 /*!
  * Allow a global sum that sums over the lattice, but returns an object
@@ -466,7 +720,6 @@ typename UnaryReturn<OLattice<T>, FnSum>::Type_t
 sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
-  OScalar<T> tmp;   // Note, expect to have ILattice inner grid
 
 #if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
@@ -476,31 +729,28 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
   // Must initialize to zero since we do not know if the loop will be entered
   zero_rep(d.elem());
 
-  if (s.hasOrderedRep())
-  {
-    const int istart = s.start() >> INNER_LOG;
-    const int iend   = s.end()   >> INNER_LOG;
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads());
+  for(int thread=0; thread < pdest.size(); ++thread)
+    zero_rep(pdest[thread].elem());
 
-    for(int i=istart; i <= iend; ++i) 
-    {
-      tmp.elem() = forEach(s1, EvalLeaf1(i), OpCombine()); // Evaluate to ILattice part
-      d.elem() += sum(tmp.elem());    // sum as well the ILattice part
-    }
+  int first, last;
+  if (outerRange(s, first, last))
+  {
+    OuterSumArgs<RHS,T> args(s1, pdest, first);
+    dispatch_to_threads(last-first+1, args, outerSumKernel<RHS,T>);
   }
   else
   {
-    const int *tab = s.siteTable().slice();
-    for(int j=0; j < s.numSiteTable(); ++j) 
-    {
-      int i = tab[j];
-      int outersite = i >> INNER_LOG;
-      int innersite = i & (INNER_LEN-1);
-
-      tmp.elem() = forEach(s1, EvalLeaf1(outersite), OpCombine()); // Evaluate to ILattice part
-      d.elem() += getSite(tmp.elem(),innersite);    // wasteful - only extract a single site worth
-    }
+    // Each outer site is evaluated once for all of its lanes
+    const OuterGrid::Lanes& lanes = OuterGrid::lanes(s);
+    OuterSumArgs<RHS,T> args(s1, pdest, 0, &lanes);
+    dispatch_to_threads(lanes.outer.size(), args, outerSumKernel<RHS,T>);
   }
 
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int thread=0; thread < pdest.size(); ++thread)
+    d.elem() += pdest[thread].elem();
+
   // Do a global sum on the result
   QDPInternal::globalSum(d);
   
@@ -565,6 +815,39 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
 }
 
 
+//! user argument for the sums over all subsets of a Set
+template<class RHS, class T>
+struct SumMultiOuterArgs
+{
+  SumMultiOuterArgs(const QDPExpr<RHS,OLattice<T> >& s_,
+		    multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest_,
+		    const int *color_, int nsub_) :
+    s(s_), dest(dest_), color(color_), nsub(nsub_) {}
+
+  const QDPExpr<RHS,OLattice<T> >& s;
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest;   //!< nsub partials per thread
+  const int *color;
+  int nsub;
+};
+
+//! user function for the sums over all subsets of a Set
+template<class RHS, class T>
+void sumMultiOuterKernel(int lo, int hi, int myId, SumMultiOuterArgs<RHS,T> *a)
+{
+  OScalar<T> tmp;   // Note, expect to have ILattice inner grid
+
+  for(int i=lo; i < hi; ++i) 
+  {
+    tmp.elem() = forEach(a->s, EvalLeaf1(i), OpCombine()); // Evaluate to ILattice part
+    for(int k=0; k < INNER_LEN; ++k)
+    {
+      const int c = a->color[(i << INNER_LOG) + k];
+      a->dest[myId*a->nsub + c].elem() += getSite(tmp.elem(),k);
+    }
+  }
+}
+
+
 //! multi1d<OScalar> dest  = sumMulti(OLattice,Set) 
 /*!
  * Compute the global sum on multiple subsets specified by Set 
@@ -585,9 +868,25 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
   prof.time -= getClockTime();
 #endif
 
-  // lazy - evaluate repeatedly
-  for(int i=0; i < ss.numSubsets(); ++i)
-    dest[i] = sum(s1,ss[i]);
+  const int nsub = ss.numSubsets();
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads()*nsub);
+  for(int i=0; i < pdest.size(); ++i)
+    zero_rep(pdest[i].elem());
+
+  // One pass over the outer sites, each lane goes to the sum of its color
+  SumMultiOuterArgs<RHS,T> args(s1, pdest, ss.latticeColoring().slice(), nsub);
+  dispatch_to_threads(Layout::outerSitesOnNode(), args, sumMultiOuterKernel<RHS,T>);
+
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int i=0; i < nsub; ++i)
+  {
+    zero_rep(dest[i].elem());
+    for(int thread=0; thread < qdpNumThreads(); ++thread)
+      dest[i].elem() += pdest[thread*nsub+i].elem();
+  }
+
+  // Do a global sum on the result
+  QDPInternal::globalSumArray(dest);
 
 #if defined(QDP_USE_PROFILING)   
   prof.time += getClockTime();
@@ -655,10 +954,27 @@ sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
   prof.time -= getClockTime();
 #endif
 
-  // lazy - evaluate repeatedly
+  // One pass over the lanes of each field, accumulated by the coloring
+  const int *lat_color = ss.latticeColoring().slice();
+  const int outerSites = Layout::outerSitesOnNode();
+
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> row(ss.numSubsets());
   for(int k=0; k < s1.size(); ++k)
-    for(int i=0; i < ss.numSubsets(); ++i)
-      dest(k,i) = sum(s1[k],ss[i]);
+  {
+    for(int j=0; j < row.size(); ++j)
+      zero_rep(row[j].elem());
+
+    const OLattice<T>& ss1 = s1[k];
+    for(int i=0; i < outerSites; ++i) 
+      for(int l=0; l < INNER_LEN; ++l)
+	row[lat_color[(i << INNER_LOG) + l]].elem() += getSite(ss1.elem(i),l);
+
+    // Do a global sum on the result
+    QDPInternal::globalSumArray(row);
+
+    for(int j=0; j < row.size(); ++j)
+      dest(k,j) = row[j];
+  }
 
 #if defined(QDP_USE_PROFILING)   
   prof.time += getClockTime();
@@ -738,20 +1054,25 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
   // Possibly loop entered
   zero_rep(d.elem());
 
-#if ! defined(QDP_NOT_IMPLEMENTED)
-  const int *tab = s.siteTable().slice();
+  // Whole outer sites take a horizontal add, split ones lane by lane
+  const OuterGrid::Lanes& lanes = OuterGrid::lanes(s);
   for(int n=0; n < s1.size(); ++n)
   {
     const OLattice<T>& ss1 = s1[n];
-    for(int j=0; j < s.numSiteTable(); ++j) 
+    for(int j=0; j < lanes.outer.size(); ++j) 
     {
-      int i = tab[j];
-      d.elem() += localNorm2(ss1.elem(i));
+      const int i = lanes.outer[j];
+      const unsigned int m = lanes.mask[j];
+      typename UnaryReturn<T, FnLocalNorm2>::Type_t tmp = localNorm2(ss1.elem(i));
+
+      if (m == OuterGrid::fullMask)
+	d.elem() += sum(tmp);
+      else
+	for(int k=0; k < INNER_LEN; ++k)
+	  if (m & (1u << k))
+	    d.elem() += getSite(tmp,k);
     }
   }
-#else
-  QDP_error_exit("norm2-Subset not implemented");
-#endif
 
   // Do a global sum on the result
   QDPInternal::globalSum(d);
@@ -995,7 +1316,8 @@ public:
   operator()(const OLattice<T1> & l)
     {
       OLattice<T1> d;
-      int nodeSites = Layout::sitesOnNode();
+      const int outerSites = Layout::outerSitesOnNode();
+      const int my_node = Layout::nodeNumber();
 
 #if QDP_DEBUG >= 3
       QDP_info("Map()");
@@ -1010,33 +1332,9 @@ public:
 	QDP_info("Map: off-node communications required");
 #endif
 
-	// Eventually these declarations should move into d - the return object
-	typedef Site_t * T1ptr;
-
-
-	Site_t **dest = new T1ptr[nodeSites];
-	if( dest == 0x0 ) { 
-	  QDP_error_exit("Unable to new memory in OLattice<T1>::operator()\n");
-        } 
 	QMP_msgmem_t msg[2];
 	QMP_msghandle_t mh_a[2], mh;
 
-	//------------
-	// yukky hack - transform all source to packed format
-	Site_t *ll = new Site_t[nodeSites]; 
-        if ( ll == 0x0 ) { 
-	   QDP_error_exit("Unable to new memory in OLattice<T1>::operator()\n");
-	}
-	for(int i=0; i < nodeSites; ++i) 
-	{
-	  int iouter = i >> INNER_LOG;
-	  int iinner = i & (INNER_LEN - 1);
-
-	  ll[i] = getSite(l.elem(iouter), iinner);
-	}
-	//-------------
-
-
 	int dstnum = destnodes_num[0]*sizeof(Site_t);
 	int srcnum = srcenodes_num[0]*sizeof(Site_t);
 	QMP_mem_t* send_buf_mem_t;
@@ -1067,9 +1365,7 @@ public:
 	  QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (recv_buf)\n");
         }
 
-	const int my_node = Layout::nodeNumber();
-
-	// Gather the face of data to send
+	// Pack the face to send straight from the vector sites
 	// For now, use the all subset
 	for(int si=0; si < soffsets.size(); ++si) 
 	{
@@ -1077,29 +1373,10 @@ public:
 	  QDP_info("Map_scatter_send(buf[%d],olattice[%d])",si,soffsets[si]);
 #endif
 
-	  send_buf[si] = ll[soffsets[si]];
-	}
-
-	// Set the dest gather pointers
-	// For now, use the all subset
-	for(int i=0, ri=0; i < nodeSites; ++i) 
-	{
-	  if (srcnode[i] != my_node)
-	  {
-#if QDP_DEBUG >= 3
-	    QDP_info("Map_gather_recv(olattice[%d],recv[%d])",i,ri);
-#endif
+	  int iouter = soffsets[si] >> INNER_LOG;
+	  int iinner = soffsets[si] & (INNER_LEN-1);
 
-	    dest[i] = &(recv_buf[ri++]);
-	  }
-	  else
-	  {
-#if QDP_DEBUG >= 3
-	    QDP_info("Map_gather_onnode(olattice[%d],olattice[%d])",i,goffsets[i]);
-#endif
-
-	    dest[i] = &(ll[goffsets[i]]);
-	  }
+	  send_buf[si] = getSite(l.elem(iouter), iinner);
 	}
 
 	QMP_status_t err;
@@ -1159,25 +1436,30 @@ public:
 	QMP_free_msgmem(msg[1]);
 	QMP_free_msgmem(msg[0]);
 
-	// Scatter the data into the destination
-	// Some of the data maybe in receive buffers
-	// For now, use the all subset
-	for(int i=0; i < nodeSites; ++i) 
+	// Whole vectors come from this node, the other outer sites are
+	// filled lane by lane from this node or the receive buffer. The
+	// receive buffer is in site order, so it is read in order
+	for(int ii=0, ri=0; ii < outerSites; ++ii) 
 	{
-#if QDP_DEBUG >= 3
-	  QDP_info("Map_scatter(olattice[%d],olattice[0x%x])",i,dest[i]);
-#endif
-	  int iouter = i >> INNER_LOG;
-	  int iinner = i & (INNER_LEN-1);
+	  if (outer_goffsets[ii] >= 0)
+	  {
+	    d.elem(ii) = l.elem(outer_goffsets[ii]);
+	    continue;
+	  }
 
-	  copy_site(d.elem(iouter), iinner, *(dest[i]));    // slow - should use gather_sites
+	  for(int k=0; k < INNER_LEN; ++k)
+	  {
+	    int i = (ii << INNER_LOG) + k;
+	    if (srcnode[i] != my_node)
+	      copy_site(d.elem(ii), k, recv_buf[ri++]);
+	    else
+	      copy_site(d.elem(ii), k, getSite(l.elem(goffsets[i] >> INNER_LOG), goffsets[i] & (INNER_LEN-1)));
+	  }
 	}
 
 	// Cleanup
 	QMP_free_memory(recv_buf_mem_t);
 	QMP_free_memory(send_buf_mem_t);
-	delete[] ll;
-	delete[] dest;
 
 #if QDP_DEBUG >= 3
 	QDP_info("finished cleanup");
@@ -1187,45 +1469,25 @@ public:
       {
 	// No off-node communications - copy on node
 #if QDP_DEBUG >= 3
-	QDP_info("Map: copy on node - no communications, try this");
+	QDP_info("Map: copy on node - no communications");
 #endif
 
-	// *** SHOULD IMPROVE THIS - JUST GET IT TO WORK FIRST ***
-	// For now, use the all subset
-#if INNER_LOG == 2
-
-	for(int i=0; i < nodeSites; i+= INNER_LEN) 
+	// Directions along the outer grid move whole vectors, directions
+	// folded into the inner grid permute the lanes
+	for(int ii=0; ii < outerSites; ++ii) 
 	{
-	  int ii = i >> INNER_LOG;
-	  int o0 = goffsets[i+0] >> INNER_LOG;
-	  int i0 = goffsets[i+0] & (INNER_LEN - 1);
-
-	  int o1 = goffsets[i+1] >> INNER_LOG;
-	  int i1 = goffsets[i+1] & (INNER_LEN - 1);
-
-	  int o2 = goffsets[i+2] >> INNER_LOG;
-	  int i2 = goffsets[i+2] & (INNER_LEN - 1);
-
-	  int o3 = goffsets[i+3] >> INNER_LOG;
-	  int i3 = goffsets[i+3] & (INNER_LEN - 1);
-
-#if QDP_DEBUG >= 3
-	  QDP_info("Map(lattice[%d]=lattice([%d,%d],[%d,%d],[%d,%d],[%d,%d])",
-		   ii,o0,i0,o1,i1,o2,i2,o3,i3);
-#endif
+	  if (outer_goffsets[ii] >= 0)
+	  {
+	    d.elem(ii) = l.elem(outer_goffsets[ii]);
+	    continue;
+	  }
 
-	  // Gather 4 inner-grid sites together
-	  gather_sites(d.elem(ii),
-		       l.elem(o0),i0,
-		       l.elem(o1),i1,
-		       l.elem(o2),i2,
-		       l.elem(o3),i3);
+	  for(int k=0; k < INNER_LEN; ++k)
+	  {
+	    int i = (ii << INNER_LOG) + k;
+	    copy_site(d.elem(ii), k, getSite(l.elem(goffsets[i] >> INNER_LOG), goffsets[i] & (INNER_LEN-1)));
+	  }
 	}
-
-#else
-#error "Map: this inner grid length is not supported - easy to fix"
-#endif
-
       }
 
 #if QDP_DEBUG >= 3
@@ -1299,6 +1561,9 @@ private:
   multi1d<int> srcenodes_num;
   multi1d<int> destnodes_num;
 
+  //! Source outer site of each outer site moved as a whole vector, or -1
+  multi1d<int> outer_goffsets;
+
   // Indicate off-node communications is needed;
   bool offnodeP;
 };
@@ -1553,6 +1818,19 @@ public:
       return bimapsa((isign+1)>>1,dir)(l);
     }
 
+  //! map(source,isign,dir) applied k times, as a single exchange
+  /*! 
+   * shift(psi,FORWARD,mu,3) is psi(x+3mu) with one message of the 3
+   * deep face in place of three nearest neighbor shifts. The map is
+   * kept per (direction, k), see distanceMap.
+   */
+  template<class T1>
+  inline auto operator()(const T1& l, int isign, int dir, int k)
+    -> decltype(std::declval<Map&>()(l))
+    {
+      return distanceMap(isign, dir, k)(l);
+    }
+
 
 private:
   //! Hide copy constructor
@@ -0,0 +1,267 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Lattice fields in one file per I/O node
+ */
+
+#ifndef QDP_PARTFILE_H
+#define QDP_PARTFILE_H
+
+#include <limits>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace QDP
+{
+  /*! @addtogroup io
+   *
+   * @{
+   */
+
+  //--------------------------------------------------------------------------------
+  //! The boxes a part file set cuts the lattice into, and who handles each
+  /*!
+    The lattice is cut by a grid of parts into equal boxes. Part p holds
+    its box in lex order, big-endian, as the serial writer would put the
+    box if it were the whole lattice. Parts whose box is exactly a node
+    subgrid belong to that node; otherwise they are dealt out evenly by
+    part number, so a set written on one node geometry is still read by
+    many nodes on another.
+  */
+  class PartFileGeometry
+  {
+  public:
+    //! Cut the lattice of this layout with grid
+    explicit PartFileGeometry(const multi1d<int>& grid);
+
+    //! The grid of parts
+    const multi1d<int>& grid() const {return part_grid;}
+
+    //! Number of parts
+    int numParts() const {return nparts;}
+
+    //! Sites in each part
+    size_t partVol() const {return box_vol;}
+
+    //! Node that reads or writes part p
+    int owner(int p) const {return owners[p];}
+
+    //! Parts of this node, in order
+    const std::vector<int>& myParts() const {return my_parts;}
+
+    //! Linear index of the sites of this node, in the order they go to their owners
+    /*! layoutCount()[q] of them go to node q, the ones for each node in file order */
+    const std::vector<int>& layoutSites() const {return layout_sites;}
+    const std::vector<size_t>& layoutCount() const {return layout_count;}
+
+    //! The node holding each site of myParts(), in file order
+    /*! partCount()[q] of them live on node q */
+    const std::vector<int>& partNodes() const {return part_nodes;}
+    const std::vector<size_t>& partCount() const {return part_count;}
+
+    //! Name of the file of part p of the set stem
+    static std::string partName(const std::string& stem, int p);
+
+  private:
+    int partOf(const multi1d<int>& coord, size_t& lex) const;
+
+    multi1d<int> part_grid;
+    multi1d<int> box;
+    int nparts;
+    size_t box_vol;
+    std::vector<int> owners;
+    std::vector<int> my_parts;
+    std::vector<int> layout_sites, part_nodes;
+    std::vector<size_t> layout_count, part_count;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //! How a PartFileWriter stores the parts of the fields that follow
+  /*!
+    The defaults store the parts as they are. With deflate the bytes of
+    the words in each part are shuffled into planes, so that sign and
+    exponent bytes sit together, and the part is compressed by its owner,
+    every node and thread working on parts of its own. rel_error makes it
+    lossy: floating point mantissas are rounded to the fewest bits that
+    keep every normal number within rel_error of its value, which leaves
+    the low planes empty. Integer words are always exact. Rounding only
+    pays when compressed, so it turns deflate on. Compression needs QDP++
+    configured with zlib; readers find it in the index and undo it.
+  */
+  struct PartFileCompression
+  {
+    //! Deflate level 1-9, zero for none
+    int deflate;
+    //! Largest relative error of floating point words, zero for exact
+    double rel_error;
+
+    PartFileCompression() : deflate(0), rel_error(0) {}
+
+    //! Is anything compressed
+    bool on() const {return deflate > 0 || rel_error > 0;}
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //! Writes lattice fields as a part file set
+  /*!
+    Each field is moved in one all-to-all from the nodes holding its
+    sites to the owners of the parts, which write their own files
+    stem.part.<p>. close() writes the index file stem on the primary
+    node: the lattice size, the grid of parts and, for every field, its
+    word size, how it is stored and the length and checksum of each part.
+
+    The grid defaults to the I/O node grid given with -iogeom, or else
+    to the node grid, when every node writes its own subgrid and nothing
+    is communicated. All calls are collective.
+
+      PartFileWriter out;
+      out.open("cfg");
+      out.write(u);
+      out.close();
+  */
+  class PartFileWriter
+  {
+  public:
+    PartFileWriter() : geom(0) {}
+
+    //! Closes a set still open
+    ~PartFileWriter();
+
+    //! Start a set cut by the default grid of parts
+    void open(const std::string& stem);
+
+    //! Start a set cut by grid
+    void open(const std::string& stem, const multi1d<int>& grid);
+
+    //! Append a field to every part
+    template<class T>
+    void write(const OLattice<T>& d)
+      {
+	typedef typename WordType<T>::Type_t W;
+	writeLattice((const char*)d.getF(), sizeof(W), sizeof(T)/sizeof(W),
+		     ! std::numeric_limits<W>::is_integer);
+      }
+
+    //! Append an array of fields one after the other
+    template<class T>
+    void write(const multi1d< OLattice<T> >& d)
+      {
+	for(int i=0; i < d.size(); ++i)
+	  write(d[i]);
+      }
+
+    //! Compress the fields written from now on
+    void setCompression(const PartFileCompression& c) {compress = c;}
+
+    //! The compression of the next field
+    const PartFileCompression& getCompression() const {return compress;}
+
+    //! Write the index and close the parts
+    void close();
+
+    //! Is a set open
+    bool is_open() const {return geom != 0;}
+
+  private:
+    //! Hide copies
+    PartFileWriter(const PartFileWriter&);
+    void operator=(const PartFileWriter&);
+
+    void writeLattice(const char* data, size_t size, size_t nmemb, bool real);
+
+    std::string stem;
+    PartFileCompression compress;
+    PartFileGeometry* geom;                // while open
+    std::vector<int> fds;                  // of myParts()
+    std::vector<off_t> offsets;            // of the next field in each of myParts()
+
+    std::vector<size_t> sizes, nmembs;     // of each field
+    std::vector<int> codecs, keeps;        // how each field is stored, mantissa bits kept or -1
+    std::vector< multi1d<unsigned int> > crcs;  // of each part of each field
+    std::vector< multi1d<long long> > lengths;  // stored bytes of each part of each field
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //! Reads lattice fields back from a part file set
+  /*!
+    The set may have been written on any number of nodes in any
+    geometry, as long as the lattice size is the same. The parts are
+    dealt out over the nodes reading them, each reads its own files and
+    one all-to-all takes every site to its node. Compressed parts are
+    inflated by the nodes reading them. The checksum of every part is
+    checked against the index. All calls are collective.
+
+      PartFileReader in;
+      in.open("cfg");
+      in.read(u);
+      in.close();
+  */
+  class PartFileReader
+  {
+  public:
+    PartFileReader() : geom(0), next(0) {}
+
+    ~PartFileReader();
+
+    //! Read the index of the set stem and open the parts of this node
+    void open(const std::string& stem);
+
+    //! Read the next field
+    template<class T>
+    void read(OLattice<T>& d)
+      {
+	typedef typename WordType<T>::Type_t W;
+	readLattice((char*)d.getF(), sizeof(W), sizeof(T)/sizeof(W));
+      }
+
+    //! Read the next d.size() fields
+    template<class T>
+    void read(multi1d< OLattice<T> >& d)
+      {
+	for(int i=0; i < d.size(); ++i)
+	  read(d[i]);
+      }
+
+    //! Number of fields in the set
+    int numFields() const {return sizes.size();}
+
+    //! Were the floating point words of field f rounded when written
+    bool isLossy(int f) const {return keeps[f] >= 0;}
+
+    //! The grid of parts the set was written with
+    const multi1d<int>& grid() const {return geom->grid();}
+
+    //! Close the parts
+    void close();
+
+    //! Is a set open
+    bool is_open() const {return geom != 0;}
+
+  private:
+    //! Hide copies
+    PartFileReader(const PartFileReader&);
+    void operator=(const PartFileReader&);
+
+    void readLattice(char* data, size_t size, size_t nmemb);
+
+    std::string stem;
+    PartFileGeometry* geom;
+    std::vector<int> fds;
+    std::vector<off_t> offsets;
+    int next;
+
+    std::vector<size_t> sizes, nmembs;
+    std::vector<int> codecs, keeps;
+    std::vector< multi1d<unsigned int> > crcs;
+    std::vector< multi1d<long long> > lengths;
+  };
+
+  /*! @} */   // end of group io
+
+} // namespace QDP
+
+#endif
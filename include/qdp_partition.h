@@ -0,0 +1,145 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Thread partitions of subsets, cached and optionally rebalanced
+ *
+ * dispatch_to_subset is dispatch_to_threads over the site table
+ * positions of a subset, but each thread gets the slot of a partition
+ * kept per subset and site size instead of an even split. Slot bounds are
+ * aligned so a thread starts its sites on a page, or on a cache line
+ * when the subset is too small for pages, and threads do not share the
+ * lines at their ends. With rebalancing on (-partition-balance or
+ * Partition::setRebalance) the time each slot takes is measured, and
+ * after a few calls the bounds are moved so the slots take the same
+ * time, which helps subsets of uneven cost such as sparse sources.
+ *
+ * Sums pass Partition::ALIGNED and keep the aligned bounds, so their
+ * results do not depend on the timings.
+ */
+
+#ifndef QDP_PARTITION_H
+#define QDP_PARTITION_H
+
+#include <vector>
+
+namespace QDP
+{
+  namespace Partition
+  {
+    //! Which bounds of a cached partition to use
+    enum Kind { ALIGNED, BALANCED };
+
+    //! Turn the rebalancing from measured slot times on or off
+    void setRebalance(bool on);
+
+    //! Is the rebalancing on
+    bool rebalance();
+
+    //! Slot bounds of s for sites of bytes bytes, made on first use
+    /*!
+     * Slot t covers the site table positions bounds[t] .. bounds[t+1]-1,
+     * with one slot per thread. The bounds stay valid until the next
+     * Set::make or clear()
+     */
+    const std::vector<int>& bounds(const Subset& s, int bytes, Kind kind);
+
+    //! Add the slot times of a dispatch with the BALANCED bounds
+    void record(const Subset& s, int bytes, const std::vector<double>& secs);
+
+    //! Forget all partitions
+    void clear();
+
+    //! Number of cached partitions
+    int numEntries();
+
+
+    //! The work of a partitioned dispatch
+    template<class Arg>
+    struct SlotArg
+    {
+      Arg* a;
+      void (*func)(int,int,int,Arg*);
+      const int* bounds;
+      double* secs;
+    };
+
+    //! Run the slots lo..hi, timing them when asked
+    template<class Arg>
+    void slots(int lo, int hi, int myId, SlotArg<Arg>* s)
+    {
+      for(int t=lo; t < hi; ++t)
+      {
+	const QDPTime_t t0 = s->secs ? getClockTime() : 0;
+	if (s->bounds[t] < s->bounds[t+1])
+	  s->func(s->bounds[t], s->bounds[t+1], t, s->a);
+	if (s->secs)
+	  s->secs[t] = 1.0e-9*(getClockTime() - t0);
+      }
+    }
+  }
+
+
+  //! dispatch_to_threads over the site table positions of s with its cached partition
+  /*! bytes is the size of a site of the field written, for the alignment */
+  template<class Arg>
+  void dispatch_to_subset(const Subset& s, int bytes, Arg a, void (*func)(int,int,int,Arg*),
+			  Partition::Kind kind = Partition::BALANCED)
+  {
+    const int nthr = qdpNumThreads();
+    if (nthr == 1 || s.numSiteTable() == 0)
+    {
+      dispatch_to_threads(s.numSiteTable(), a, func);
+      return;
+    }
+
+    const bool timed = (kind == Partition::BALANCED) && Partition::rebalance();
+    std::vector<double> secs(timed ? nthr : 0);
+
+    // One slot per thread, slot t goes to thread t
+    Partition::SlotArg<Arg> sa = {&a, func, &Partition::bounds(s, bytes, kind)[0],
+				  timed ? &secs[0] : 0};
+    dispatch_to_threads(nthr, sa, Partition::slots<Arg>);
+
+    if (timed)
+      Partition::record(s, bytes, secs);
+  }
+
+
+  namespace Partition
+  {
+    //! user argument for rangeKernel
+    template<class F>
+    struct RangeArgs
+    {
+      const F* f;
+    };
+
+    //! user function handing its range to the functor
+    template<class F>
+    void rangeKernel(int lo, int hi, int myId, RangeArgs<F>* a)
+    {
+      (*a->f)(lo, hi, myId);
+    }
+  }
+
+
+  //! Call f(lo, hi, myId) on the threads for the ranges of 0 .. n-1
+  /*! A loop written in place as a lambda, for dispatch_to_threads without its own kernel */
+  template<class F>
+  void dispatch_range(int n, const F& f)
+  {
+    Partition::RangeArgs<F> a = {&f};
+    dispatch_to_threads(n, a, Partition::rangeKernel<F>);
+  }
+
+  //! Call f(lo, hi, myId) on the threads for the site table positions of s, as dispatch_to_subset
+  template<class F>
+  void dispatch_range(const Subset& s, int bytes, const F& f,
+		      Partition::Kind kind = Partition::BALANCED)
+  {
+    Partition::RangeArgs<F> a = {&f};
+    dispatch_to_subset(s, bytes, a, Partition::rangeKernel<F>, kind);
+  }
+}
+
+#endif
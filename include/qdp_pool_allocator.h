@@ -13,23 +13,39 @@
 #include "tbb/memory_pool.h"
 
 #include "qdp_singleton.h"
+#include <vector>
+#include <mutex>
 namespace QDP
 {
  	 namespace Allocator {
 
- 	 // A Descrptor contains the start block and the number of blocks
- 	 // In an object
- 	 // The idea is that when we allocate n_blocks, they will be contiguous
- 	 // so we can just note the start, and the number
- 	 // and then pop them off the end of the free list.
- 	 // When we return to the pool we can just add back the blocks.
-
-	   struct PoolMemInfo                                                                                                                                                                                          {                                                                                                                                                                                                
-	     size_t Size;                                                                                                                                                                                 
-	     unsigned char* Unaligned;                                                                                                                                                                    
-	   };                                                                                                                                                                                                   
-                                                                                                                                                                                                         
-	   using PoolMapT = std::map<void *,PoolMemInfo>;       
+ 	 // A Descriptor sits in front of each aligned block, so free()
+ 	 // finds the size and the unaligned pool pointer without a lookup.
+ 	 // Size is the requested size, which is also the cache key.
+	   struct PoolMemInfo {
+	     size_t Size;
+	     unsigned char* Unaligned;
+	     bool Fast;               // from fastAllocate, outside the pool
+	     int Arena;               // the arena it was carved from
+	   };
+
+ 	 // One mapping the pool carves blocks from. The first is made by
+ 	 // init(), later ones when the pool is full, see setPoolGrowth.
+	   struct PoolArena {
+	     unsigned char* Mem;      // nullptr for a free slot
+	     size_t Bytes;
+	     int Kind;                // how Mem was obtained, an ArenaKind
+	     tbb::fixed_pool* Pool;
+	     size_t Live;             // blocks not yet back in Pool, cached ones included
+	     size_t LiveBytes;        // bytes of them taken from Pool
+	   };
+
+ 	 // Recently freed blocks of one size, still aligned and with their
+ 	 // descriptor, ready to be handed out again.
+	   struct PoolCacheBin {
+	     size_t Size;
+	     std::vector<unsigned char*> Blocks;
+	   };
 
 
  	 // Quick and Dirty Pool ALlocator
@@ -60,13 +76,43 @@ namespace QDP
 	   void pushFunc(const char *func, int line);
 	   void popFunc(void);
 	   void dump();
-	   
+
+	   //! Return all cached blocks to the pool, and empty grown arenas to the OS
+	   void flushCache();
+
+	   //! Free bytes in the arenas, and the largest block they can still give
+	   /*! The largest block is found by trial allocations, so this is for reports */
+	   void fragmentation(size_t& free_bytes, size_t& largest_block);
 
  	 private:
 	   size_t _PoolSize;
-	   unsigned char* _MyMem;
-	   tbb::fixed_pool* _LargePool;
-	   PoolMapT theAllocMap;
+
+	   // How the memory of an arena was obtained, so it goes back the same way
+	   enum ArenaKind { ARENA_NEW, ARENA_MALLOC, ARENA_MMAP };
+
+	   enum { MaxArenas = 64 };
+	   PoolArena _Arenas[MaxArenas];
+	   int _NumArenas;             // slots in use or released, at most MaxArenas
+
+	   bool allocArena(PoolArena& a, size_t bytes, PoolPages pages, bool verbose);
+	   void freeArena(PoolArena& a);
+	   unsigned char* growLocked(size_t bytes, int& arena);
+	   void releaseEmptyLocked(int keep);
+	   void freeBlockLocked(const PoolMemInfo* d);
+
+	   // Size-class cache of freed blocks. Lattice temporaries come in a
+	   // handful of sizes, so a few bins searched linearly cover them.
+	   enum { NumCacheBins = 16, MaxBlocksPerBin = 32 };
+	   PoolCacheBin _Cache[NumCacheBins];
+	   std::mutex _Lock;
+
+	   // Cache statistics for dump()
+	   size_t _CacheHits;
+	   size_t _PoolCalls;
+	   size_t _Grows;
+
+	   PoolCacheBin* findBin(size_t n_bytes);
+	   void flushCacheLocked();
 
  	 };
 
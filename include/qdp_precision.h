@@ -22,23 +22,64 @@ typedef float     REAL32;
 typedef double    REAL64;
 typedef bool      LOGICAL;
 
+// Vector width in bits that the inner grid of the scalarvec
+// architectures fills. Set by configure, otherwise taken from the
+// target: fixed length SVE (-msve-vector-bits), AVX-512, AVX, else 128
+#if ! defined(QDP_SIMD_BITS)
+#if defined(__ARM_FEATURE_SVE_BITS) && __ARM_FEATURE_SVE_BITS > 0
+#define QDP_SIMD_BITS __ARM_FEATURE_SVE_BITS
+#elif defined(__AVX512F__)
+#define QDP_SIMD_BITS 512
+#elif defined(__AVX__)
+#define QDP_SIMD_BITS 256
+#else
+#define QDP_SIMD_BITS 128
+#endif
+#endif
+
+// The site loops of evaluate and the sums are built once for each
+// target of QDP_KERNEL_CLONES (configure --enable-kernel-clones), e.g.
+// "avx512f,avx2,default", and the loader picks the best one the node
+// runs. Only on x86 ELF targets with GCC or clang
+#if defined(QDP_KERNEL_CLONES) && defined(__x86_64__) && defined(__ELF__) && \
+  ((defined(__clang__) && __clang_major__ >= 14) || (! defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 6))
+#define QDP_SITE_KERNEL __attribute__((target_clones(QDP_KERNEL_CLONES)))
+#else
+#define QDP_SITE_KERNEL
+#endif
+
 // Set the base floating precision
 #if BASE_PRECISION == 32
 // Use single precision for base precision
 typedef REAL32    REAL;
 typedef REAL64    DOUBLE;
 
-#define INNER_LOG 2
-
 #elif BASE_PRECISION == 64
 // Use double precision for base precision
 typedef REAL64    REAL;
 typedef REAL64    DOUBLE;
 
-#define INNER_LOG 1
-
 #else
 #error "Unknown BASE_PRECISION"
 #endif
 
+// INNER_LOG is log_2 of the words of REAL in a vector, unless given
+#if ! defined(INNER_LOG)
+#if QDP_SIMD_BITS / BASE_PRECISION == 64
+#define INNER_LOG 6
+#elif QDP_SIMD_BITS / BASE_PRECISION == 32
+#define INNER_LOG 5
+#elif QDP_SIMD_BITS / BASE_PRECISION == 16
+#define INNER_LOG 4
+#elif QDP_SIMD_BITS / BASE_PRECISION == 8
+#define INNER_LOG 3
+#elif QDP_SIMD_BITS / BASE_PRECISION == 4
+#define INNER_LOG 2
+#elif QDP_SIMD_BITS / BASE_PRECISION == 2
+#define INNER_LOG 1
+#else
+#error "QDP_SIMD_BITS must be 128, 256, 512, 1024 or 2048"
+#endif
+#endif
+
 #endif
@@ -171,11 +171,84 @@ template<class T, int N> inline T Multiply_arg_gamma15(const T& s1) {return (s1
 
 
 
+//-----------------------------------------------------------------------------
+//! Gamma(n) as a table
+/*!
+ * Each row i of Gamma(n) in the DeGrand-Rossi basis has a single nonzero,
+ * i^phase[n][i] in column column[n][i]. With the table a runtime Gamma
+ * is a shuffle of the spin components and a phase on each, the same work
+ * as the GammaConst<4,n> specialisations, done without a call per site.
+ * On colour vectors the phase is applied without a branch.
+ */
+namespace GammaInternal
+{
+  const int column[16][4] = {{0,1,2,3}, {3,2,1,0}, {3,2,1,0}, {0,1,2,3},
+			     {2,3,0,1}, {1,0,3,2}, {1,0,3,2}, {2,3,0,1},
+			     {2,3,0,1}, {1,0,3,2}, {1,0,3,2}, {2,3,0,1},
+			     {0,1,2,3}, {3,2,1,0}, {3,2,1,0}, {0,1,2,3}};
+
+  //! p = 0, 1, 2, 3 for 1, i, -1, -i
+  const int phase[16][4] = {{0,0,0,0}, {1,1,3,3}, {2,0,0,2}, {3,1,3,1},
+			    {1,3,3,1}, {2,0,2,0}, {3,3,3,3}, {0,0,2,2},
+			    {0,0,0,0}, {1,1,3,3}, {2,0,0,2}, {3,1,3,1},
+			    {1,3,3,1}, {2,0,2,0}, {3,3,3,3}, {0,0,2,2}};
+
+  //! d = i^p x
+  template<class T, class T1>
+  inline void timesPhase(T& d, const T1& x, int p)
+  {
+    switch (p)
+    {
+    case 0:  d = x; break;
+    case 1:  d = timesI(x); break;
+    case 2:  d = -x; break;
+    default: d = timesMinusI(x);
+    }
+  }
+
+  //! Real and imaginary parts of i^p
+  const int cosPhase[4] = {1, 0, -1, 0};
+  const int sinPhase[4] = {0, 1, 0, -1};
+
+  //! d = i^p x on the complex numbers themselves, without a branch
+  inline void timesPhase(RComplex<REAL32>& d, const RComplex<REAL32>& x, int p)
+  {
+    const REAL32 c = cosPhase[p];
+    const REAL32 s = sinPhase[p];
+    d.real() = c*x.real() - s*x.imag();
+    d.imag() = c*x.imag() + s*x.real();
+  }
+
+  inline void timesPhase(RComplex<REAL64>& d, const RComplex<REAL64>& x, int p)
+  {
+    const REAL64 c = cosPhase[p];
+    const REAL64 s = sinPhase[p];
+    d.real() = c*x.real() - s*x.imag();
+    d.imag() = c*x.imag() + s*x.real();
+  }
+
+  template<class T, class T1>
+  inline void timesPhase(PScalar<T>& d, const PScalar<T1>& x, int p)
+  {
+    timesPhase(d.elem(), x.elem(), p);
+  }
+
+  template<class T, class T1, int N>
+  inline void timesPhase(PColorVector<T,N>& d, const PColorVector<T1,N>& x, int p)
+  {
+    for(int i=0; i < N; ++i)
+      timesPhase(d.elem(i), x.elem(i), p);
+  }
+}
+
+
+//! Gamma(n) * b for any spin type through the GammaConst specialisations
+/*! Spin vectors and matrices with Ns = 4 have the table driven overloads */
 template<int N, class T>
-inline T OpGammaTypeMultiply:: operator()(const GammaType<N>& a, const T &b) const
+inline T gammaTypeMultiply(const GammaType<N>& a, const T &b)
 {
   typedef T (*Ptrfunc)(const T&);
-  Ptrfunc s[] = {&Multiply_gamma0_arg<T,N>, 
+  static const Ptrfunc s[] = {&Multiply_gamma0_arg<T,N>, 
 		 &Multiply_gamma1_arg<T,N>,
 		 &Multiply_gamma2_arg<T,N>,
 		 &Multiply_gamma3_arg<T,N>,
@@ -198,12 +271,19 @@ inline T OpGammaTypeMultiply:: operator()(const GammaType<N>& a, const T &b) con
   return s[a.elem()](b);
 }
 
+template<int N, class T>
+inline T OpGammaTypeMultiply:: operator()(const GammaType<N>& a, const T &b) const
+{
+  return gammaTypeMultiply(a, b);
+}
+
 
+//! a * Gamma(n) for any spin type through the GammaConst specialisations
 template<class T, int N>
-inline T OpMultiplyGammaType::operator()(const T &a, const GammaType<N>& b) const
+inline T multiplyGammaType(const T &a, const GammaType<N>& b)
 {
   typedef T (*Ptrfunc)(const T&);
-  Ptrfunc s[] = {&Multiply_arg_gamma0<T,N>, 
+  static const Ptrfunc s[] = {&Multiply_arg_gamma0<T,N>, 
 		 &Multiply_arg_gamma1<T,N>,
 		 &Multiply_arg_gamma2<T,N>,
 		 &Multiply_arg_gamma3<T,N>,
@@ -226,6 +306,12 @@ inline T OpMultiplyGammaType::operator()(const T &a, const GammaType<N>& b) cons
   return s[b.elem()](a);
 }
 
+template<class T, int N>
+inline T OpMultiplyGammaType::operator()(const T &a, const GammaType<N>& b) const
+{
+  return multiplyGammaType(a, b);
+}
+
 //-----------------------------------------------------------------------------
 // Operators
 //-----------------------------------------------------------------------------
@@ -657,7 +657,7 @@ operator*(const PMatrix<T1,N,C>& l, const PMatrix<T2,N,C>& r)
     {
       d.elem(i,j) = l.elem(i,0) * r.elem(0,j);
       for(int k=1; k < N; ++k)
-	d.elem(i,j) += l.elem(i,k) * r.elem(k,j);
+	cmadd(d.elem(i,j), l.elem(i,k), r.elem(k,j));
     }
 
   return d;
@@ -680,7 +680,7 @@ adjMultiply(const PMatrix<T1,N,C>& l, const PMatrix<T2,N,C>& r)
     {
       d.elem(i,j) = adjMultiply(l.elem(0,i), r.elem(0,j));
       for(int k=1; k < N; ++k)
-	d.elem(i,j) += adjMultiply(l.elem(k,i), r.elem(k,j));
+	conj_cmadd(d.elem(i,j), l.elem(k,i), r.elem(k,j));
     }
 
   return d;
@@ -1647,11 +1647,11 @@ localInnerProduct(const PMatrix<T1,N,C>& s1, const PMatrix<T2,N,C>& s2)
 
   d.elem() = localInnerProduct(s1.elem(0,0), s2.elem(0,0));
   for(int k=1; k < N; ++k)
-    d.elem() += localInnerProduct(s1.elem(k,0), s2.elem(k,0));
+    innerProductAdd(d.elem(), s1.elem(k,0), s2.elem(k,0));
 
   for(int j=1; j < N; ++j)
     for(int k=0; k < N; ++k)
-      d.elem() += localInnerProduct(s1.elem(k,j), s2.elem(k,j));
+      innerProductAdd(d.elem(), s1.elem(k,j), s2.elem(k,j));
 
   return d;
 }
@@ -853,6 +853,23 @@ operator*(const GammaConst<4,15>&, const PSpinMatrix<T2,4>& r)
 }
 
 
+// SpinMatrix<4> = Gamma(n) * SpinMatrix<4> for a runtime n
+template<class T2>
+inline typename BinaryReturn<GammaType<4>, PSpinMatrix<T2,4>, OpGammaTypeMultiply>::Type_t
+gammaTypeMultiply(const GammaType<4>& a, const PSpinMatrix<T2,4>& r)
+{
+  typename BinaryReturn<GammaType<4>, PSpinMatrix<T2,4>, OpGammaTypeMultiply>::Type_t  d;
+  const int* col = GammaInternal::column[a.elem()];
+  const int* ph  = GammaInternal::phase[a.elem()];
+
+  for(int i=0; i < 4; ++i)
+    for(int j=0; j < 4; ++j)
+      GammaInternal::timesPhase(d.elem(i,j), r.elem(col[i],j), ph[i]);
+
+  return d;
+}
+
+
 // SpinMatrix<4> = SpinMatrix<4> * Gamma<4,m>
 // There are 16 cases here for Nd=4
 template<class T2>
@@ -1128,6 +1145,24 @@ operator*(const PSpinMatrix<T2,4>& l, const GammaConst<4,15>&)
 }
 
 
+// SpinMatrix<4> = SpinMatrix<4> * Gamma(n) for a runtime n
+/*! Row k of Gamma(n) sends column k of l to column column[n][k] */
+template<class T2>
+inline typename BinaryReturn<PSpinMatrix<T2,4>, GammaType<4>, OpMultiplyGammaType>::Type_t
+multiplyGammaType(const PSpinMatrix<T2,4>& l, const GammaType<4>& a)
+{
+  typename BinaryReturn<PSpinMatrix<T2,4>, GammaType<4>, OpMultiplyGammaType>::Type_t  d;
+  const int* col = GammaInternal::column[a.elem()];
+  const int* ph  = GammaInternal::phase[a.elem()];
+
+  for(int i=0; i < 4; ++i)
+    for(int k=0; k < 4; ++k)
+      GammaInternal::timesPhase(d.elem(i,col[k]), l.elem(i,k), ph[k]);
+
+  return d;
+}
+
+
 //-----------------------------------------------
 
 // SpinMatrix<4> = GammaDP<4,m> * SpinMatrix<4>
@@ -1368,6 +1368,24 @@ operator*(const GammaConst<4,15>&, const PSpinVector<T2,4>& r)
 }
 
 
+// SpinVector<4> = Gamma(n) * SpinVector<4> for a runtime n
+template<class T2>
+inline typename BinaryReturn<GammaType<4>, PSpinVector<T2,4>, OpGammaTypeMultiply>::Type_t
+gammaTypeMultiply(const GammaType<4>& a, const PSpinVector<T2,4>& r)
+{
+  typename BinaryReturn<GammaType<4>, PSpinVector<T2,4>, OpGammaTypeMultiply>::Type_t  d;
+  const int* col = GammaInternal::column[a.elem()];
+  const int* ph  = GammaInternal::phase[a.elem()];
+
+  GammaInternal::timesPhase(d.elem(0), r.elem(col[0]), ph[0]);
+  GammaInternal::timesPhase(d.elem(1), r.elem(col[1]), ph[1]);
+  GammaInternal::timesPhase(d.elem(2), r.elem(col[2]), ph[2]);
+  GammaInternal::timesPhase(d.elem(3), r.elem(col[3]), ph[3]);
+
+  return d;
+}
+
+
 // SpinVector<2> = SpinProject(SpinVector<4>)
 // There are 4 cases here for Nd=4 for each forward/backward direction
 template<class T>
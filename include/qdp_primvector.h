@@ -458,7 +458,7 @@ operator*(const PMatrix<T1,N,C1>& l, const PVector<T2,N,C2>& r)
   {
     d.elem(i) = l.elem(i,0) * r.elem(0);
     for(int j=1; j < N; ++j)
-      d.elem(i) += l.elem(i,j) * r.elem(j);
+      cmadd(d.elem(i), l.elem(i,j), r.elem(j));
   }
 
   return d;
@@ -475,7 +475,7 @@ adjMultiply(const PMatrix<T1,N,C1>& l, const PVector<T2,N,C2>& r)
   {
     d.elem(i) = adjMultiply(l.elem(0,i), r.elem(0));
     for(int j=1; j < N; ++j)
-      d.elem(i) += adjMultiply(l.elem(j,i), r.elem(j));
+      conj_cmadd(d.elem(i), l.elem(j,i), r.elem(j));
   }
 
   return d;
@@ -915,7 +915,7 @@ localInnerProduct(const PVector<T1,N,C>& s1, const PVector<T2,N,C>& s2)
 
   d.elem() = localInnerProduct(s1.elem(0), s2.elem(0));
   for(int i=1; i < N; ++i)
-    d.elem() += localInnerProduct(s1.elem(i), s2.elem(i));
+    innerProductAdd(d.elem(), s1.elem(i), s2.elem(i));
 
   return d;
 }
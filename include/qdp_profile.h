@@ -9,15 +9,34 @@
 #ifndef QDP_PROFILE_INCLUDE
 #define QDP_PROFILE_INCLUDE
 
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
 namespace QDP {
 
 typedef unsigned long  QDPTime_t;
 
-//! Get the wallclock time
+//! Get the time of a monotonic clock
 /*!
-  \return The wallclock time (since Epoch) in seconds.
+  \return The time in nanoseconds since an arbitrary start.
 */
 QDPTime_t getClockTime();
+
+//! Write the profile to file at QDP_finalize, as CSV if it ends in .csv and JSON otherwise
+void setProfileFile(const std::string& file);
+
+//! Read these hardware counters in every profile scope
+/*!
+ * A comma separated list of cycles, instructions, cache-references,
+ * cache-misses, branch-misses, stalled-cycles-frontend,
+ * stalled-cycles-backend, L1-dcache-load-misses, LLC-load-misses, the
+ * software task-clock, page-faults, context-switches and cpu-migrations, or
+ * rNNNN for a raw event in hex, e.g. a vector instruction count of the CPU.
+ * Needs a build with --enable-perf-counters.
+ */
+void setProfileCounters(const std::string& events);
 void initProfile(const std::string& file, const std::string& caller, int line);
 void closeProfile();
 void printProfile();
@@ -28,6 +47,388 @@ int getProgramProfileLevel();
 void pushProfileInfo(int level, const std::string& file, const std::string& caller, int line);
 void popProfileInfo();
 
+//! Add the bytes and flops of every evaluate and reduction to totals of this node
+/*! Off by default, and turned on with -flopcount */
+void setExprCounting(bool on);
+bool getExprCounting();
+
+//! Flops counted by evaluate and the reductions on this node so far
+unsigned long long getExprFlops();
+
+//! Bytes of lattice fields read and written by evaluate and the reductions on this node so far
+unsigned long long getExprBytes();
+
+//! Zero the counted flops and bytes
+void resetExprCounts();
+
+//! Print the counted flops and bytes of all nodes
+void printExprCounts();
+
+//! Add to the counted flops and bytes - called by QDPExprCount_t
+void addExprCounts(double flops, double bytes);
+
+
+//-----------------------------------------------------------------------------
+// Timeline of the operations
+//-----------------------------------------------------------------------------
+
+namespace Trace
+{
+  //! Kinds of events on the timeline
+  enum Category {Evaluate = 0, Comm, User, NumCategories};
+
+  //! Record a timeline, written to file by QDP_finalize as Chrome trace JSON
+  /*!
+   * Every evaluate and sum, every map exchange, reduction, broadcast and
+   * route becomes an event. Events are kept in a compact binary buffer on
+   * each node and only converted when written. Evaluates are named by their
+   * expression in a build with --enable-profiling, and "evaluate" otherwise.
+   */
+  void setTraceFile(const std::string& file);
+
+  //! Is the timeline being recorded
+  bool enabled();
+
+  //! Id of an event name, made on first use
+  int name(const std::string& n);
+
+  //! Record an event of category cat and name id running from t0 to t1
+  void record(int cat, int id, QDPTime_t t0, QDPTime_t t1);
+
+  //! Gather the timelines of all nodes and write them - call on every node
+  void write();
+
+  //! Mark a region of user code on the timeline
+  /*! { Trace::Region r("solve"); ... } */
+  class Region
+  {
+  public:
+    explicit Region(const std::string& n) : id(enabled() ? name(n) : -1), t0(id >= 0 ? getClockTime() : 0) {}
+    ~Region() {if (id >= 0) record(User, id, t0, getClockTime());}
+
+  private:
+    int id;
+    QDPTime_t t0;
+  };
+}
+
+
+//-----------------------------------------------------------------------------
+// Bytes and flops of an expression
+//-----------------------------------------------------------------------------
+
+//! Tag counting the bytes of lattice fields an expression reads at a site
+/*! forEach(rhs, ByteCountLeaf(), SumCombine()) */
+struct ByteCountLeaf {};
+
+template<class T>
+struct LeafFunctor<T, ByteCountLeaf>
+{
+  typedef int Type_t;
+  inline static Type_t apply(const T &a, const ByteCountLeaf &f) {return 0;}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPType<T,C>, ByteCountLeaf>
+{
+  typedef int Type_t;
+  inline static Type_t apply(const QDPType<T,C> &a, const ByteCountLeaf &f)
+    {return LeafFunctor<C, ByteCountLeaf>::apply(static_cast<const C&>(a), f);}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPSubType<T,C>, ByteCountLeaf>
+{
+  typedef int Type_t;
+  inline static Type_t apply(const QDPSubType<T,C> &a, const ByteCountLeaf &f) {return sizeof(T);}
+};
+
+template<class T>
+struct LeafFunctor<OLattice<T>, ByteCountLeaf>
+{
+  typedef int Type_t;
+  inline static Type_t apply(const OLattice<T> &a, const ByteCountLeaf &f) {return sizeof(T);}
+};
+
+
+//! Flops of a subexpression whose site type is T
+/*! T is void when the site type is not known, e.g. below a gamma matrix */
+template<class T>
+struct ExprFlops
+{
+  ExprFlops(double f = 0) : flops(f) {}
+  double flops;
+};
+
+//! Floating point words of a site
+template<class T>
+struct ProfileWords
+{
+  enum {value = sizeof(T) / sizeof(typename WordType<T>::Type_t)};
+};
+
+template<>
+struct ProfileWords<void>
+{
+  enum {value = 0};
+};
+
+//! Is a site built from complex numbers
+template<class T> struct ProfileComplex {enum {value = 0};};
+template<class T> struct ProfileComplex<RComplex<T> > {enum {value = 1};};
+template<class T> struct ProfileComplex<PScalar<T> > {enum {value = ProfileComplex<T>::value};};
+template<class T, int N> struct ProfileComplex<PColorVector<T,N> > {enum {value = ProfileComplex<T>::value};};
+template<class T, int N> struct ProfileComplex<PColorMatrix<T,N> > {enum {value = ProfileComplex<T>::value};};
+template<class T, int N> struct ProfileComplex<PSpinVector<T,N> > {enum {value = ProfileComplex<T>::value};};
+template<class T, int N> struct ProfileComplex<PSpinMatrix<T,N> > {enum {value = ProfileComplex<T>::value};};
+
+//! How an operation is counted
+/*!
+ * PROF_ELEMENT costs one flop per word of the result, PROF_PRODUCT is a
+ * matrix-like product, PROF_NORM and PROF_INNER cost 2 and 4 flops per word
+ * of the first operand. Anything else (adj, trace, peeks, ...) counts as
+ * data movement.
+ */
+enum ProfileFlopKind {PROF_NONE, PROF_ELEMENT, PROF_PRODUCT, PROF_NORM, PROF_INNER};
+
+template<class Op> struct ProfileOpKind {enum {value = PROF_NONE};};
+template<> struct ProfileOpKind<OpAdd> {enum {value = PROF_ELEMENT};};
+template<> struct ProfileOpKind<OpSubtract> {enum {value = PROF_ELEMENT};};
+template<> struct ProfileOpKind<OpUnaryMinus> {enum {value = PROF_ELEMENT};};
+template<> struct ProfileOpKind<OpAddAssign> {enum {value = PROF_ELEMENT};};
+template<> struct ProfileOpKind<OpSubtractAssign> {enum {value = PROF_ELEMENT};};
+template<> struct ProfileOpKind<FnSum> {enum {value = PROF_ELEMENT};};
+template<> struct ProfileOpKind<OpMultiply> {enum {value = PROF_PRODUCT};};
+template<> struct ProfileOpKind<OpAdjMultiply> {enum {value = PROF_PRODUCT};};
+template<> struct ProfileOpKind<OpMultiplyAdj> {enum {value = PROF_PRODUCT};};
+template<> struct ProfileOpKind<OpAdjMultiplyAdj> {enum {value = PROF_PRODUCT};};
+template<> struct ProfileOpKind<FnLocalNorm2> {enum {value = PROF_NORM};};
+template<> struct ProfileOpKind<FnNorm2> {enum {value = PROF_NORM};};
+template<> struct ProfileOpKind<FnLocalInnerProduct> {enum {value = PROF_INNER};};
+template<> struct ProfileOpKind<FnInnerProduct> {enum {value = PROF_INNER};};
+template<> struct ProfileOpKind<FnLocalInnerProductReal> {enum {value = PROF_NORM};};
+template<> struct ProfileOpKind<FnInnerProductReal> {enum {value = PROF_NORM};};
+
+//! Flops per site of one operation on site types A and B giving R
+/*!
+ * A product of operands with eA and eB elements giving eR elements does
+ * sqrt(eA*eB*eR) multiplies, e.g. 9 for a color matrix times a color vector,
+ * and that many adds less eR.
+ */
+template<class A, class B, class R>
+inline double profileOpFlops(int kind)
+{
+  const double wA = ProfileWords<A>::value, wR = ProfileWords<R>::value;
+  switch (kind)
+  {
+  case PROF_ELEMENT:
+    return (wR > 0) ? wR : wA;
+  case PROF_NORM:
+    return 2*wA;
+  case PROF_INNER:
+    return 4*wA;
+  case PROF_PRODUCT:
+  {
+    const int cA = ProfileComplex<A>::value, cB = ProfileComplex<B>::value, cR = ProfileComplex<R>::value;
+    const double eA = wA / (cA ? 2 : 1);
+    const double eB = double(ProfileWords<B>::value) / (cB ? 2 : 1);
+    const double eR = wR / (cR ? 2 : 1);
+    const double m = std::sqrt(eA*eB*eR);
+    const double mul = (cA && cB) ? 6 : ((cA || cB) ? 2 : 1);
+    return mul*m + ((m > eR) ? (cR ? 2 : 1)*(m - eR) : 0);
+  }
+  default:
+    return 0;
+  }
+}
+
+//! Combiner summing ExprFlops up a tree
+/*! forEach(rhs, FlopCountLeaf(), FlopCombine()).flops */
+struct FlopCountLeaf {};
+struct FlopCombine {};
+
+template<class T>
+struct LeafFunctor<T, FlopCountLeaf>
+{
+  typedef ExprFlops<void> Type_t;
+  inline static Type_t apply(const T &a, const FlopCountLeaf &f) {return Type_t();}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPType<T,C>, FlopCountLeaf>
+{
+  typedef typename LeafFunctor<C, FlopCountLeaf>::Type_t Type_t;
+  inline static Type_t apply(const QDPType<T,C> &a, const FlopCountLeaf &f)
+    {return LeafFunctor<C, FlopCountLeaf>::apply(static_cast<const C&>(a), f);}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPSubType<T,C>, FlopCountLeaf>
+{
+  typedef ExprFlops<T> Type_t;
+  inline static Type_t apply(const QDPSubType<T,C> &a, const FlopCountLeaf &f) {return Type_t();}
+};
+
+template<class T>
+struct LeafFunctor<OScalar<T>, FlopCountLeaf>
+{
+  typedef ExprFlops<T> Type_t;
+  inline static Type_t apply(const OScalar<T> &a, const FlopCountLeaf &f) {return Type_t();}
+};
+
+template<class T>
+struct LeafFunctor<OLattice<T>, FlopCountLeaf>
+{
+  typedef ExprFlops<T> Type_t;
+  inline static Type_t apply(const OLattice<T> &a, const FlopCountLeaf &f) {return Type_t();}
+};
+
+//! Site type of a unary or binary node, void once it is not known
+template<class A, class Op>
+struct ProfileUnary
+{
+  typedef typename UnaryReturn<A, Op>::Type_t Type_t;
+};
+
+template<class Op>
+struct ProfileUnary<void, Op>
+{
+  typedef void Type_t;
+};
+
+template<class A, class B, class Op>
+struct ProfileBinary
+{
+  typedef typename BinaryReturn<A, B, Op>::Type_t Type_t;
+};
+
+template<class A, class Op>
+struct ProfileBinary<A, void, Op>
+{
+  typedef void Type_t;
+};
+
+template<class B, class Op>
+struct ProfileBinary<void, B, Op>
+{
+  typedef void Type_t;
+};
+
+template<class Op>
+struct ProfileBinary<void, void, Op>
+{
+  typedef void Type_t;
+};
+
+template<class A, class Op>
+struct Combine1<ExprFlops<A>, Op, FlopCombine>
+{
+  typedef typename ProfileUnary<A, Op>::Type_t R;
+  typedef ExprFlops<R> Type_t;
+  inline static Type_t combine(const ExprFlops<A>& a, const Op&, FlopCombine)
+    {return Type_t(a.flops + profileOpFlops<A,void,R>(ProfileOpKind<Op>::value));}
+};
+
+template<class A, class B, class Op>
+struct Combine2<ExprFlops<A>, ExprFlops<B>, Op, FlopCombine>
+{
+  typedef typename ProfileBinary<A, B, Op>::Type_t R;
+  typedef ExprFlops<R> Type_t;
+  inline static Type_t combine(const ExprFlops<A>& a, const ExprFlops<B>& b, const Op&, FlopCombine)
+    {return Type_t(a.flops + b.flops + profileOpFlops<A,B,R>(ProfileOpKind<Op>::value));}
+};
+
+template<class A, class B, class C, class Op>
+struct Combine3<ExprFlops<A>, ExprFlops<B>, ExprFlops<C>, Op, FlopCombine>
+{
+  typedef ExprFlops<void> Type_t;
+  inline static Type_t combine(const ExprFlops<A>& a, const ExprFlops<B>& b, const ExprFlops<C>& c,
+			       const Op&, FlopCombine)
+    {return Type_t(a.flops + b.flops + c.flops);}
+};
+
+//! Bytes per site written by dest
+template<class T, class Op>
+inline int profileDestBytes(const OLattice<T>& d, const Op& op) {return 2*sizeof(T);}
+
+template<class T>
+inline int profileDestBytes(const OLattice<T>& d, const OpAssign& op) {return sizeof(T);}
+
+template<class C, class Op>
+inline int profileDestBytes(const C& d, const Op& op) {return 0;}
+
+//! Site type of dest
+template<class C> struct ProfileSite {typedef void Type_t;};
+template<class T> struct ProfileSite<OLattice<T> > {typedef T Type_t;};
+template<class T> struct ProfileSite<OScalar<T> > {typedef T Type_t;};
+
+
+//! Bytes and flops per site of one expression
+/*!
+ * Estimated once from the types of the tree when the expression is first
+ * evaluated, and added to the totals of getExprFlops and getExprBytes by
+ * every later evaluate while setExprCounting is on.
+ */
+struct QDPExprCount_t
+{
+  double        bytes;
+  double        flops;
+
+  QDPExprCount_t() : bytes(0), flops(0) {}
+
+  //! Count dest op rhs
+  template<class T, class C, class Op, class RHS, class C1>
+  QDPExprCount_t(const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
+    {
+      typedef typename ProfileSite<C>::Type_t D;
+
+      bytes = forEach(rhs, ByteCountLeaf(), SumCombine()) + profileDestBytes(static_cast<const C&>(dest), op);
+      flops = forEach(rhs, FlopCountLeaf(), FlopCombine()).flops
+	+ profileOpFlops<D,void,D>(ProfileOpKind<Op>::value);
+    }
+
+  //! Count rhs written to the sites of a subset field
+  template<class T, class Op, class RHS, class C1>
+  QDPExprCount_t(T* dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
+    {
+      bytes = forEach(rhs, ByteCountLeaf(), SumCombine()) + sizeof(T)*(int(ProfileOpKind<Op>::value) == int(PROF_NONE) ? 1 : 2);
+      flops = forEach(rhs, FlopCountLeaf(), FlopCombine()).flops
+	+ profileOpFlops<T,void,T>(ProfileOpKind<Op>::value);
+    }
+
+  //! Count opOuter(rhs); the result stays on the node
+  template<class T, class C, class Op, class OpOuter, class RHS, class C1>
+  QDPExprCount_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPExpr<RHS,C1>& rhs)
+    {
+      count_outer(opOuter, rhs);
+    }
+
+  //! Count opOuter(rhs); the result stays on the node
+  template<class T, class C, class Op, class OpOuter, class T1, class C1>
+  QDPExprCount_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPType<T1,C1>& rhs)
+    {
+      count_outer(opOuter, PETE_identity(rhs));
+    }
+
+  //! Add a call that visited n sites to the totals
+  void count(unsigned long n) const
+    {
+      if (getExprCounting())
+	addExprCounts(flops*n, bytes*n);
+    }
+
+private:
+  template<class OpOuter, class RHS, class C1>
+  void count_outer(const OpOuter& opOuter, const QDPExpr<RHS,C1>& rhs)
+    {
+      typedef typename ProfileSite<C1>::Type_t S;
+
+      bytes = forEach(rhs, ByteCountLeaf(), SumCombine());
+      flops = forEach(rhs, FlopCountLeaf(), FlopCombine()).flops
+	+ profileOpFlops<S,void,void>(ProfileOpKind<OpOuter>::value);
+    }
+};
+
 
 //--------------------------------------------------------------------------------------
 // Selectively turn on profiling
@@ -38,6 +439,23 @@ void popProfileInfo();
 #define QDP_PUSH_PROFILE(a)
 #define QDP_POP_PROFILE()
 
+//! Stand-in for the profiling object that only counts bytes and flops
+struct QDPProfile_t : public QDPExprCount_t
+{
+  using QDPExprCount_t::QDPExprCount_t;
+
+  //! Clock at the start of a call, or 0 when the timeline is off
+  QDPTime_t start() const {return Trace::enabled() ? getClockTime() : 0;}
+
+  //! Close a call begun at t0 that visited n sites
+  void stop(QDPTime_t t0, unsigned long n) const
+    {
+      count(n);
+      if (t0 != 0)
+	Trace::record(Trace::Evaluate, 0, t0, getClockTime());
+    }
+};
+
 #else   // Profiling enabled
 
 #define QDP_PUSH_PROFILE(a) pushProfileInfo(a, __FILE__, __func__, __LINE__)
@@ -55,74 +473,135 @@ void registerProfile(QDPProfile_t* qp);
 
 //! Profiling object
 /*!
- * Hold profiling state
+ * Hold profiling state of one expression. Time is in nanoseconds; bytes and
+ * flops are per site, so the totals are bytes*sites and flops*sites. Flops
+ * are an estimate from the site types of the expression tree.
+ *
+ * The counters are atomic, so one expression may run on several threads.
+ * A call is timed as
+ *
+ *   static QDPProfile_t prof(dest, op, rhs);
+ *   QDPTime_t t0 = prof.start();
+ *   ...
+ *   prof.stop(t0, s.numSiteTable());
+ *
+ * and costs one test of the profile level while profiling is turned off.
  */
-struct QDPProfile_t
+struct QDPProfile_t : public QDPExprCount_t
 {
-  QDPTime_t     time;
+  std::atomic<QDPTime_t>      time;
+  std::atomic<unsigned long>  count;
+  std::atomic<unsigned long>  sites;
   std::string   expr;
-  int           count;
   QDPProfile_t* next;
+  int           trace_id;
 
   void print();
 
   void init();
   QDPProfile_t() {init();}
 
+  //! Name of the expression is known - register it and name it on the timeline
+  void named();
+
+  //! Clock at the start of a call, or 0 when profiling and the timeline are off
+  QDPTime_t start() const {return (getProfileLevel() > 0 || trace_id >= 0) ? getClockTime() : 0;}
+
+  //! Close a call begun at t0 that visited n sites
+  void stop(QDPTime_t t0, unsigned long n)
+    {
+      QDPExprCount_t::count(n);
+
+      if (t0 == 0)
+	return;
+
+      const QDPTime_t t1 = getClockTime();
+      if (trace_id >= 0)
+	Trace::record(Trace::Evaluate, trace_id, t0, t1);
+
+      time += t1 - t0;
+      count++;
+      sites += n;
+      print();
+    }
+
   //! Profile rhs
   template<class T, class C, class Op, class RHS, class C1>
-  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
+  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs) :
+    QDPExprCount_t(dest, op, rhs)
     {
       init();
 
-      if (getProfileLevel() > 0)
+      if (getProfileLevel() > 0 || Trace::enabled())
       {
-	ostringstream os;
+	std::ostringstream os;
 	printExprTree(os, dest, op, rhs);
 	expr = os.str();
-	registerProfile(this);
+	named();
+      }
+    }
+
+  //! Profile rhs written to the sites of a subset field
+  template<class T, class Op, class RHS, class C1>
+  QDPProfile_t(T* dest, const Op& op, const QDPExpr<RHS,C1>& rhs) :
+    QDPExprCount_t(dest, op, rhs)
+    {
+      init();
+
+      if (getProfileLevel() > 0 || Trace::enabled())
+      {
+	std::ostringstream os;
+	printExprTree(os, dest, op, rhs);
+	expr = os.str();
+	named();
       }
     }
 
   //! Profile  opOuter(rhs)
   template<class T, class C, class Op, class OpOuter, class RHS, class C1>
-  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPExpr<RHS,C1>& rhs)
+  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPExpr<RHS,C1>& rhs) :
+    QDPExprCount_t(dest, op, opOuter, rhs)
     {
       init();
 
-      if (getProfileLevel() > 0)
+      if (getProfileLevel() > 0 || Trace::enabled())
       {
 	typedef UnaryNode<OpOuter, typename CreateLeaf<QDPExpr<RHS,C1> >::Leaf_t> Tree_t;
 	typedef typename UnaryReturn<C1,OpOuter>::Type_t Container_t;
 
-	ostringstream os;
+	std::ostringstream os;
 	printExprTree(os, dest, op, 
 		      MakeReturn<Tree_t,Container_t>::make(Tree_t(
 			CreateLeaf<QDPExpr<RHS,C1> >::make(rhs))));
 	expr = os.str();
-	registerProfile(this);
+	named();
       }
     }
 
   //! Profile  opOuter(rhs)
   template<class T, class C, class Op, class OpOuter, class T1, class C1>
-  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPType<T1,C1>& rhs)
+  QDPProfile_t(const QDPType<T,C>& dest, const Op& op, const OpOuter& opOuter, const QDPType<T1,C1>& rhs) :
+    QDPExprCount_t(dest, op, opOuter, rhs)
     {
       init();
 
-      if (getProfileLevel() > 0)
+      if (getProfileLevel() > 0 || Trace::enabled())
       {
 	typedef UnaryNode<OpOuter, typename CreateLeaf<QDPType<T1,C1> >::Leaf_t> Tree_t;
 	typedef typename UnaryReturn<C1,OpOuter>::Type_t Container_t;
 
-	ostringstream os;
+	std::ostringstream os;
 	printExprTree(os, dest, op, 
 		      MakeReturn<Tree_t,Container_t>::make(Tree_t(
 			CreateLeaf<QDPType<T1,C1> >::make(rhs))));
 	expr = os.str();
-	registerProfile(this);
+	named();
       }
     }
+
+private:
+  QDPProfile_t(const QDPProfile_t&);
+  void operator=(const QDPProfile_t&);
 };
 
 
@@ -148,10 +627,12 @@ struct QDPProfileHead_t
   QDPProfileInfo_t  info;
   QDPProfile_t*     start;
   QDPProfile_t*     end;
+  QDPTime_t         time;   // while this was the current scope
+  std::vector<double> hw;   // hardware counts over all threads in that time
 
-  QDPProfileHead_t() {start=0; end=0;}
-  QDPProfileHead_t(const QDPProfileInfo_t& a) : info(a), start(0), end(0) {}
-  QDPProfileHead_t(const QDPProfileHead_t& a) : info(a.info), start(a.start), end(a.end) {}
+  QDPProfileHead_t() {start=0; end=0; time=0;}
+  QDPProfileHead_t(const QDPProfileInfo_t& a) : info(a), start(0), end(0), time(0) {}
+  QDPProfileHead_t(const QDPProfileHead_t& a) : info(a.info), start(a.start), end(a.end), time(a.time), hw(a.hw) {}
 };
 
 
@@ -163,7 +644,7 @@ struct QDPProfileHead_t
  */
 template<class T, class C, class Op, class RHS, class C1>
 //inline
-void printExprTree(ostream& os, 
+void printExprTree(std::ostream& os, 
 		   const QDPType<T,C>& dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
 {
   typedef EvalLeaf1    FTag_t;
@@ -193,6 +674,26 @@ void printExprTree(ostream& os,
   os << ";";
 }
 
+//! Print an expression tree assigned to a subset field
+template<class T, class Op, class RHS, class C1>
+void printExprTree(std::ostream& os, 
+		   T* dest, const Op& op, const QDPExpr<RHS,C1>& rhs)
+{
+  typedef QDPExpr<RHS,C1>  Expr;
+  typedef typename CreateLeaf<Expr>::Leaf_t Expr_t;
+  const Expr_t &e = CreateLeaf<Expr>::make(rhs);
+
+  typedef ForEachInOrder<RHS, PrintTag, PrintTag, NullTag> Print_t;
+  T d;
+  os << "OSubLat<";
+  LeafFunctor<T,PrintTag>::apply(d,PrintTag(os));
+  os << "> ";
+  TagVisitor<Op,PrintTag>::visit(op, PrintTag(os));
+  os << " ";
+  Print_t::apply(e, PrintTag(os), PrintTag(os), NullTag());
+  os << ";";
+}
+
 //
 // struct PrintTag
 //
@@ -201,8 +702,8 @@ void printExprTree(ostream& os,
 
 struct PrintTag
 {
-  mutable ostream &os_m;
-  PrintTag(ostream &os) : os_m(os) {}
+  std::ostream &os_m;
+  PrintTag(std::ostream &os) : os_m(os) {}
 };
 
 
@@ -224,6 +725,19 @@ struct LeafFunctor<QDPType<T,C>, PrintTag>
     }
 };
 
+template<class T, class C>
+struct LeafFunctor<QDPSubType<T,C>, PrintTag>
+{
+  typedef int Type_t;
+  static int apply(const QDPSubType<T,C> &s, const PrintTag &f)
+    { 
+      f.os_m << "OSub<";
+      LeafFunctor<T,PrintTag>::apply(*s.getF(),f);
+      f.os_m << ">"; 
+      return 0;
+    }
+};
+
 //
 // struct LeafFunctor<T, PrintTag>
 //
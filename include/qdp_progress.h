@@ -0,0 +1,50 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief A thread driving outstanding messages while the workers compute
+ */
+
+#ifndef QDP_PROGRESS_H
+#define QDP_PROGRESS_H
+
+#include "qmp.h"
+
+namespace QDP
+{
+  //! Communication progress thread
+  /*!
+   * Many MPI libraries only move a message along while the node is inside
+   * an MPI call, so a face started before the interior work may not go
+   * anywhere until the wait after it. With -progress on, the maps hand
+   * every message they start to a thread that keeps testing it with
+   * QMP_is_complete until it is done or taken back for the wait. The
+   * thread sleeps while nothing is in flight; -progress <cpu> also pins
+   * it to that cpu, which is best left free of the worker threads.
+   *
+   * Needs QMP_THREAD_MULTIPLE, which QDP_initialize asks QMP for.
+   */
+  namespace Progress
+  {
+    //! Run the thread, on cpu when it is not negative
+    /*! Only takes effect at init */
+    void setMode(bool on, int cpu = -1);
+
+    //! Start the thread if asked for and the threading of QMP allows it
+    void init(bool thread_multiple);
+
+    //! Stop the thread, before QMP goes
+    void finalize();
+
+    //! Is the thread running
+    bool enabled();
+
+    //! Have the thread drive a started message
+    void watch(QMP_msghandle_t mh);
+
+    //! Take a message back before waiting on or freeing it
+    /*! The thread no longer touches mh on return */
+    void unwatch(QMP_msghandle_t mh);
+  }
+}
+
+#endif
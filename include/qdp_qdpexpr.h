@@ -80,6 +80,21 @@ struct CreateLeaf<QDPExpr<T,C> >
 };
 
 
+//! Launch a map left pending at the top of an expression
+/*!
+ * Architectures that defer the communications of a shift until its
+ * use is known overload this for their shifted leaf. Called by the
+ * site loops before any site of the expression is read.
+ */
+template<class T, class C>
+inline void startShifts(const QDPExpr<T,C>&) {}
+
+//! Launch a pending map when only the sites of s are read
+/*! An architecture may then communicate only the face those sites need */
+template<class T, class C>
+inline void startShifts(const QDPExpr<T,C>&, const Subset&) {}
+
+
 template<class T, class FTag, class CTag, class DTag>
 struct ForEach<QDPExpr<T,DTag>, FTag, CTag>
 {
@@ -12,6 +12,8 @@
 #include "qdp_defs.h"
 #include "qdp_traits.h"
 #include <cstring>
+#include <map>
+#include <vector>
 
 namespace QDP 
 {
@@ -151,6 +153,25 @@ namespace QDP
   template<>
   char *QIOStringTraits< LatticeColorVectorD3 >::tname;
 
+  // The same for the other numbers of colours
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL32>, 2> > > > >::tname;
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL64>, 2> > > > >::tname;
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL32>, 4> > > > >::tname;
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL64>, 4> > > > >::tname;
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL32>, 5> > > > >::tname;
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL64>, 5> > > > >::tname;
+
 
   // Generic version of the template
   // Declares a static value
@@ -407,13 +428,38 @@ namespace QDP
     */
     void clear(QDP_iostate_t state = QDPIO_goodbit);
 
+    //! Bytes of the file read ahead of the records taken so far
+    /*!
+      With a serial read, the primary node fetches the file into the page
+      cache from a background thread, up to this many bytes past the last
+      record read. While one record is distributed and converted, the next
+      is already coming off the file system. 0, the default, reads
+      nothing ahead. Applies to files opened afterwards.
+    */
+    static void setReadAhead(size_t bytes);
+    static size_t readAhead();
+
   protected:
     QIO_Reader *get() const {return qio_in;}
 
   private:
+    //! Start reading ahead from the beginning of path
+    void startReadAhead(const std::string& path);
+
+    //! Stop reading ahead
+    void stopReadAhead();
+
+    //! A record of bytes of data has been taken
+    void advance(size_t bytes);
+
     QDP_iostate_t iostate;
     bool iop;
     QIO_Reader *qio_in;
+
+    struct ReadAhead;
+    ReadAhead* read_ahead;
+
+    friend class QDPPackedReader;
   };
 
 
@@ -1214,6 +1260,57 @@ namespace QDP
   }
 
 
+  //! Functions moving sites of file type D into a lattice of type T
+  /*!
+    The sites are converted one at a time as they arrive, so a record of
+    another precision needs no lattice temporary of the file precision.
+  */
+  template<class T, class D>
+  struct QDPOLatticeFactory
+  {
+    //! Convert count sites of buf into the field arg at linear
+    static void put(char *buf, size_t linear, int count, void *arg)
+    {
+      T *field = (T *)arg;
+      D site;
+      for(int i=0; i < count; ++i)
+      {
+	memcpy((void*)&site, (const void*)buf, sizeof(D));
+	field[linear+i] = site;
+	buf += sizeof(D);
+      }
+    }
+
+    //! Convert one site of buf into each field of the multi1d< OLattice<T> > arg
+    static void putArray(char *buf, size_t linear, int count, void *arg)
+    {
+      multi1d< OLattice<T> >& field = *(multi1d< OLattice<T> > *)arg;
+      D site;
+      for(int i=0; i < field.size(); ++i)
+      {
+	memcpy((void*)&site, (const void*)buf, sizeof(D));
+	field[i].elem(linear) = site;
+	buf += sizeof(D);
+      }
+    }
+  };
+
+  //! The file has the lattice type, so the sites are copied straight into place
+  template<class T>
+  struct QDPOLatticeFactory<T,T>
+  {
+    static void put(char *buf, size_t linear, int count, void *arg)
+    {
+      QDPOLatticeFactoryPut<T>(buf, linear, count, arg);
+    }
+
+    static void putArray(char *buf, size_t linear, int count, void *arg)
+    {
+      QDPOLatticeFactoryPutArray<T>(buf, linear, count, arg);
+    }
+  };
+
+
   //! Reads an OLattice object
   /*!
     This implementation is only correct for scalar ILattice.
@@ -1236,72 +1333,42 @@ namespace QDP
       QDP_abort(1);
     }
       
+    // Sites of the file precision are converted straight into s1
+    typedef typename SinglePrecType<T>::Type_t TF;
+    typedef typename DoublePrecType<T>::Type_t TD;
+    void (*put)(char *buf, size_t linear, int count, void *arg);
+    size_t datum_size;
+    int word_size;
+
     switch( (QIO_get_precision(&rec_info))[0] ) { 
     case 'F' :
-    {
       QDPIO::cout << "Single Precision Read" << std::endl;
-      OLattice< typename SinglePrecType<T>::Type_t > from_disk;
-      zero_rep(from_disk);
-
-      
-      status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPut<typename SinglePrecType<T>::Type_t> ),
-				    sizeof(typename SinglePrecType<T>::Type_t),
-				    sizeof(typename WordType< typename SinglePrecType<T>::Type_t >::Type_t),
-				    (void *)from_disk.getF());
-      
-      if (status != QIO_SUCCESS) { 
-	QDPIO::cerr << "Failed to read data" << std::endl;
-	clear(QDPIO_badbit);
-	QDP_abort(1);
-      }
-      QDPIO::cout << "QIO_read_finished" << std::endl;
-      s1 = from_disk; // Cast
-    }
-    break;
+      put = &(QDPOLatticeFactory<T,TF>::put);
+      datum_size = sizeof(TF);
+      word_size = sizeof(typename WordType<TF>::Type_t);
+      break;
     case 'D' :
-    {
       QDPIO::cout << "Reading Double Precision" << std::endl;
-      OLattice< typename DoublePrecType<T>::Type_t > from_disk;
-      zero_rep(from_disk);
-
-      /* Disagnostics */
-      status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPut< typename DoublePrecType<T>::Type_t>),
-				    sizeof(typename DoublePrecType<T>::Type_t),
-				    sizeof(typename WordType< typename DoublePrecType<T>::Type_t >::Type_t),
-				    (void *)from_disk.getF());
-      
-      if (status != QIO_SUCCESS) { 
-	QDPIO::cerr << "Failed to read data" << std::endl;
-	clear(QDPIO_badbit);
-	QDP_abort(1);
-      }
-      QDPIO::cout << "QIO_read_finished" << std::endl;
-      
-      // Cast appropriately
-      s1= from_disk;
-	
-    }
-    break;
+      put = &(QDPOLatticeFactory<T,TD>::put);
+      datum_size = sizeof(TD);
+      word_size = sizeof(typename WordType<TD>::Type_t);
+      break;
     default:
-    {
       QDPIO::cout << "Reading I or U precisions" << std::endl;
-      status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPut<T>),
-				    sizeof(T),
-				    sizeof(typename WordType<T>::Type_t),
-				    (void *)s1.getF());
-     
-      if (status != QIO_SUCCESS) { 
-	QDPIO::cerr << "Failed to read data" << std::endl;
-	clear(QDPIO_badbit);
-	QDP_abort(1);
-      }
-      QDPIO::cout << "QIO_read_finished" << std::endl;
-    }
-    break;
+      put = &(QDPOLatticeFactory<T,T>::put);
+      datum_size = sizeof(T);
+      word_size = sizeof(typename WordType<T>::Type_t);
+      break;
     };
+
+    status = QIO_read_record_data(qio_in, put, datum_size, word_size, (void *)s1.getF());
+    if (status != QIO_SUCCESS) { 
+      QDPIO::cerr << "Failed to read data" << std::endl;
+      clear(QDPIO_badbit);
+      QDP_abort(1);
+    }
+    QDPIO::cout << "QIO_read_finished" << std::endl;
+    advance(datum_size*Layout::vol());
         
     std::istringstream ss;
     if (Layout::primaryNode()) {
@@ -1336,74 +1403,43 @@ namespace QDP
       QDP_abort(1);
     }
   
+    // Sites of the file precision are converted straight into s1
+    typedef typename SinglePrecType<T>::Type_t TF;
+    typedef typename DoublePrecType<T>::Type_t TD;
+    void (*put)(char *buf, size_t linear, int count, void *arg);
+    size_t datum_size;
+    int word_size;
+
     switch( (QIO_get_precision(&rec_info))[0] ) { 
     case 'F' :
-    {
       QDPIO::cout << "Single Precision Read" << std::endl;
-      multi1d< OLattice< typename SinglePrecType<T>::Type_t > > from_disk(s1.size());
-      for(int i=0; i < s1.size(); i++) { zero_rep(from_disk[i]); }
-
-      status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPutArray<typename SinglePrecType<T>::Type_t> ),
-				    s1.size()*sizeof(typename SinglePrecType<T>::Type_t),
-				    sizeof(typename WordType< typename SinglePrecType<T>::Type_t >::Type_t),
-				    (void *)&from_disk);
-      if (status != QIO_SUCCESS) { 
-	QDPIO::cerr << "Failed to read data" << std::endl;
-	clear(QDPIO_badbit);
-	QDP_abort(1);
-      }
-      QDPIO::cout << "QIO_read_finished" << std::endl;
-      
-      // Cast appropriately
-      for(int i=0; i < from_disk.size(); i++) { 
-	s1[i] = from_disk[i];
-      }
-      
-    }
-    break;
+      put = &(QDPOLatticeFactory<T,TF>::putArray);
+      datum_size = s1.size()*sizeof(TF);
+      word_size = sizeof(typename WordType<TF>::Type_t);
+      break;
     case 'D' :
-    {
       QDPIO::cout << "Reading Double Precision" << std::endl;
-      multi1d< typename DoublePrecType< OLattice<T> >::Type_t > from_disk(s1.size());
-      for(int i=0; i < s1.size(); i++) { zero_rep(from_disk[i]); }
-
-      status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPutArray< typename DoublePrecType<T>::Type_t > ),
-				    s1.size()*sizeof(typename DoublePrecType<T>::Type_t),
-				    sizeof(typename WordType< typename DoublePrecType<T>::Type_t >::Type_t),
-				    (void *)&from_disk);
-      if (status != QIO_SUCCESS) { 
-	QDPIO::cerr << "Failed to read data" << std::endl;
-	clear(QDPIO_badbit);
-	QDP_abort(1);
-      }
-      QDPIO::cout << "QIO_read_finished" << std::endl;
-      
-      // Cast appropriately
-      for(int i=0; i < from_disk.size(); i++) { 
-	s1[i] = from_disk[i];
-      }
-    }
-    break;
+      put = &(QDPOLatticeFactory<T,TD>::putArray);
+      datum_size = s1.size()*sizeof(TD);
+      word_size = sizeof(typename WordType<TD>::Type_t);
+      break;
     default:
-    {
       QDPIO::cout << "Reading I or U Precision" << std::endl;
-      status = QIO_read_record_data(qio_in,
-				    &(QDPOLatticeFactoryPutArray<T> ),
-				    s1.size()*sizeof(T),
-				    sizeof(typename WordType<T>::Type_t),
-				    (void *)&s1);
-      if (status != QIO_SUCCESS) { 
-	QDPIO::cerr << "Failed to read data" << std::endl;
-	clear(QDPIO_badbit);
-	QDP_abort(1);
-      }
-      QDPIO::cout << "QIO_read_finished" << std::endl;
-    }
-    break;
+      put = &(QDPOLatticeFactory<T,T>::putArray);
+      datum_size = s1.size()*sizeof(T);
+      word_size = sizeof(typename WordType<T>::Type_t);
+      break;
+    };
+
+    status = QIO_read_record_data(qio_in, put, datum_size, word_size, (void *)&s1);
+    if (status != QIO_SUCCESS) { 
+      QDPIO::cerr << "Failed to read data" << std::endl;
+      clear(QDPIO_badbit);
+      QDP_abort(1);
     }
-  
+    QDPIO::cout << "QIO_read_finished" << std::endl;
+    advance(datum_size*Layout::vol());
+        
     std::istringstream ss;
     if (Layout::primaryNode()) {
       std::string foo = QIO_string_ptr(xml_c);
@@ -1666,6 +1702,162 @@ namespace QDP
     QIO_destroy_record_info(info);
   }
 
+  //--------------------------------------------------------------------------------
+  //! Many small records written as a few packed ones
+  /*!
+    Every write(XMLBufferWriter&, ...) of a QDPFileWriter makes a QIO
+    record of its own, with its own LIME headers, XML and checksum. A
+    file of thousands of correlators or other small measurements is then
+    mostly headers, slow to write and slower to scan. Here the objects
+    are gathered, each with a name and its record XML, and written as
+    one record of binary data whenever max_bytes are held, at flush() or
+    at destruction. The record XML of a packed record is its index:
+
+      <packedRecords>
+        <version>1</version>
+        <entries>
+          <elem><name>..</name><offset>..</offset><xmlBytes>..</xmlBytes><bytes>..</bytes></elem>
+          ..
+        </entries>
+      </packedRecords>
+
+    and the data of an entry is its record XML followed by the object,
+    in the big-endian form of BinaryWriter. Read them back with a
+    QDPPackedReader. Lattice objects still go to the QDPFileWriter
+    itself; call flush() first to keep the records in order.
+  */
+  class QDPPackedWriter
+  {
+  public:
+    //! Gather into packed records of about max_bytes written to qsw
+    explicit QDPPackedWriter(QDPFileWriter& qsw, size_t max_bytes = 1024*1024);
+
+    //! Writes what is held
+    ~QDPPackedWriter();
+
+    //! Adds an OScalar object
+    template<class T>
+    void write(const std::string& name, XMLBufferWriter& xml, const OScalar<T>& s1)
+      {
+	BinaryBufferWriter bin;
+	QDP::write(bin, s1);
+	add(name, xml, bin);
+      }
+
+    //! Adds an array of OScalar objects
+    template<class T>
+    void write(const std::string& name, XMLBufferWriter& xml, const multi1d< OScalar<T> >& s1)
+      {
+	BinaryBufferWriter bin;
+	QDP::write(bin, s1.size());
+	for(int i=0; i < s1.size(); ++i)
+	  QDP::write(bin, s1[i]);
+	add(name, xml, bin);
+      }
+
+    //! Adds the bytes of a BinaryBufferWriter
+    void write(const std::string& name, XMLBufferWriter& xml, BinaryBufferWriter& s1)
+      {
+	add(name, xml, s1);
+      }
+
+    //! Writes the objects held as one packed record
+    void flush();
+
+    //! Number of objects held
+    int size() const {return entries.size();}
+
+  private:
+    QDPPackedWriter(const QDPPackedWriter&);
+    void operator=(const QDPPackedWriter&);
+
+    void add(const std::string& name, XMLBufferWriter& xml, BinaryBufferWriter& bin);
+
+    struct Entry
+    {
+      std::string name;
+      unsigned long offset, xml_bytes, bytes;
+    };
+
+    QDPFileWriter& qsw;
+    size_t max_bytes;
+    std::string data;          // on the primary node
+    std::vector<Entry> entries;
+  };
+
+
+  //! The objects of the packed records of a file, by name
+  /*!
+    The constructor goes through the records left in the reader and
+    keeps the packed ones, reading one header per packed record rather
+    than one per object; other records are skipped without reading
+    their data. An object is then found by name in the indices and read
+    from memory, in any order:
+
+      QDPPackedReader packed(qsr);
+      packed.read("pion/t0_4", rec_xml, corr);
+
+    The reader is at the end of the file afterwards.
+  */
+  class QDPPackedReader
+  {
+  public:
+    //! The packed records from the current record of qsr to the end
+    explicit QDPPackedReader(QDPFileReader& qsr);
+
+    //! Number of objects
+    int size() const {return entries.size();}
+
+    //! Name of the object i, in the order written
+    const std::string& name(int i) const {return entries[i].name;}
+
+    //! Is there an object of this name
+    bool exists(const std::string& name) const {return index.find(name) != index.end();}
+
+    //! Reads an OScalar object
+    template<class T>
+    void read(const std::string& name, XMLReader& xml, OScalar<T>& s1)
+      {
+	BinaryBufferReader bin;
+	open(name, xml, bin);
+	QDP::read(bin, s1);
+      }
+
+    //! Reads an array of OScalar objects
+    template<class T>
+    void read(const std::string& name, XMLReader& xml, multi1d< OScalar<T> >& s1)
+      {
+	BinaryBufferReader bin;
+	open(name, xml, bin);
+	int n;
+	QDP::read(bin, n);
+	s1.resize(n);
+	for(int i=0; i < n; ++i)
+	  QDP::read(bin, s1[i]);
+      }
+
+    //! Reads the bytes of an object
+    void read(const std::string& name, XMLReader& xml, BinaryBufferReader& s1)
+      {
+	open(name, xml, s1);
+      }
+
+  private:
+    //! The record XML and the data of an object
+    void open(const std::string& name, XMLReader& xml, BinaryBufferReader& bin);
+
+    struct Entry
+    {
+      std::string name;
+      int record;
+      unsigned long offset, xml_bytes, bytes;
+    };
+
+    std::vector<std::string> records;    // data of the packed records
+    std::vector<Entry> entries;
+    std::map<std::string, int> index;
+  };
+
   /*! @} */   // end of group qio
 } // namespace QDP
 
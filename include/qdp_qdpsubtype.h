@@ -81,9 +81,16 @@ public:
       //std::cout << "own = own\n";
       if (subset().numSiteTable() != rhs.subset().numSiteTable())
 	QDP_error_exit("assignment with incompatible subset sizes");
-      for(int j=0; j < subset().numSiteTable(); ++j)
-	getF()[j] = rhs.getF()[j];
-    } else
+      copySites(getF(), rhs.getF(), subset().numSiteTable());
+      return;
+    }
+
+    // A compact field only holds the sites of its own subset
+    if (rhs.getOwnsMemory() && 
+	(&rhs.subset().getSet() != &subset().getSet() || rhs.subset().color() != subset().color()))
+      QDP_error_exit("assignment with incompatible subsets");
+
+    assign(PETE_identity(rhs));
 
 #if 0
     if (!getOwnsMemory() && rhs.getOwnsMemory()) {
@@ -107,8 +114,8 @@ public:
       }
     }
     if (!getOwnsMemory() && !rhs.getOwnsMemory())
-#endif
       QDP_error_exit("assignment of two view subtypes is not supported");
+#endif
   }
 
 
@@ -501,6 +508,38 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------
+// We need to specialize CreateLeaf<T> for our class, so that operators
+// know what to stick in the leaves of the expression tree.
+//-----------------------------------------------------------------------------
+
+template<class T, class C>
+struct CreateLeaf<QDPSubType<T,C> >
+{
+  typedef QDPSubType<T,C> Inp_t;
+  typedef Reference<Inp_t> Leaf_t;
+  inline static
+  Leaf_t make(const Inp_t &a) { return Leaf_t(a); }
+};
+
+//! Reads the destination at other sites when shifted and sharing its storage
+template<class T, class C>
+struct LeafFunctor<QDPSubType<T,C>, DestAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const QDPSubType<T,C> &a, const DestAliasLeaf &f)
+    {return f.shifted && a.getF() == f.dest;}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPSubType<T,C>, ReadsFieldLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const QDPSubType<T,C> &a, const ReadsFieldLeaf &f)
+    {return (const void *)a.getF() == f.field;}
+};
+
+
 } // namespace QDP
 
 #endif
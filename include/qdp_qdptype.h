@@ -19,6 +19,12 @@ namespace QDP {
  */
 
 
+//! The subset of every site of the lattice x lives on
+/*! all, but for a field of a LatticeLayout the all() of that lattice */
+template<class C>
+inline const Subset& allSites(const C& x) {return all;}
+
+
 //! QDPType - major type class/container for all QDP objects
 /*! 
  * This is the top level class all users should access for functional
@@ -52,7 +58,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -69,7 +75,7 @@ public:
   C& assign(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -78,7 +84,7 @@ public:
   C& assign(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpAssign(),rhs,all);
+      evaluate(writable(*me),OpAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -96,7 +102,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpAddAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpAddAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -105,7 +111,7 @@ public:
   C& operator+=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpAddAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpAddAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -114,7 +120,7 @@ public:
   C& operator+=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpAddAssign(),rhs,all);
+      evaluate(writable(*me),OpAddAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -124,7 +130,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpSubtractAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpSubtractAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -133,7 +139,7 @@ public:
   C& operator-=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpSubtractAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpSubtractAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -142,7 +148,7 @@ public:
   C& operator-=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpSubtractAssign(),rhs,all);
+      evaluate(writable(*me),OpSubtractAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -152,7 +158,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpMultiplyAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpMultiplyAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -161,7 +167,7 @@ public:
   C& operator*=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpMultiplyAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpMultiplyAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -170,7 +176,7 @@ public:
   C& operator*=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpMultiplyAssign(),rhs,all);
+      evaluate(writable(*me),OpMultiplyAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -180,7 +186,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpDivideAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpDivideAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -189,7 +195,7 @@ public:
   C& operator/=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpDivideAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpDivideAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -198,7 +204,7 @@ public:
   C& operator/=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpDivideAssign(),rhs,all);
+      evaluate(writable(*me),OpDivideAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -208,7 +214,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpModAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpModAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -217,7 +223,7 @@ public:
   C& operator%=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpModAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpModAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -226,7 +232,7 @@ public:
   C& operator%=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpModAssign(),rhs,all);
+      evaluate(writable(*me),OpModAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -236,7 +242,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpBitwiseOrAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpBitwiseOrAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -245,7 +251,7 @@ public:
   C& operator|=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpBitwiseOrAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpBitwiseOrAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -254,7 +260,7 @@ public:
   C& operator|=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpBitwiseOrAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpBitwiseOrAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -264,7 +270,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpBitwiseAndAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpBitwiseAndAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -273,7 +279,7 @@ public:
   C& operator&=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpBitwiseAndAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpBitwiseAndAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -282,7 +288,7 @@ public:
   C& operator&=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpBitwiseAndAssign(),rhs,all);
+      evaluate(writable(*me),OpBitwiseAndAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -292,7 +298,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpBitwiseXorAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpBitwiseXorAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -301,7 +307,7 @@ public:
   C& operator^=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpBitwiseXorAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpBitwiseXorAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -310,7 +316,7 @@ public:
   C& operator^=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpBitwiseXorAssign(),rhs,all);
+      evaluate(writable(*me),OpBitwiseXorAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -320,7 +326,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpLeftShiftAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpLeftShiftAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -329,7 +335,7 @@ public:
   C& operator<<=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpLeftShiftAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpLeftShiftAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -338,7 +344,7 @@ public:
   C& operator<<=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpLeftShiftAssign(),rhs,all);
+      evaluate(writable(*me),OpLeftShiftAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -348,7 +354,7 @@ public:
     {
       C* me = static_cast<C*>(this);
       typedef typename SimpleScalar<typename WordType<C>::Type_t>::Type_t  Scalar_t;
-      evaluate(*me,OpRightShiftAssign(),PETE_identity(Scalar_t(rhs)),all);
+      evaluate(writable(*me),OpRightShiftAssign(),PETE_identity(Scalar_t(rhs)),allSites(*me));
       return *me;
     }
 
@@ -357,7 +363,7 @@ public:
   C& operator>>=(const QDPType<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpRightShiftAssign(),PETE_identity(rhs),all);
+      evaluate(writable(*me),OpRightShiftAssign(),PETE_identity(rhs),allSites(*me));
       return *me;
     }
 
@@ -366,7 +372,7 @@ public:
   C& operator>>=(const QDPExpr<T1,C1>& rhs)
     {
       C* me = static_cast<C*>(this);
-      evaluate(*me,OpRightShiftAssign(),rhs,all);
+      evaluate(writable(*me),OpRightShiftAssign(),rhs,allSites(*me));
       return *me;
     }
 
@@ -464,14 +470,125 @@ struct LeafFunctor<QDPType<T,C>, ElemLeaf>
 template<class T, class C>
 struct LeafFunctor<QDPType<T,C>, EvalLeaf1>
 {
-  typedef Reference<T> Type_t;
+  typedef typename SiteLoad<T>::Type_t Type_t;
 //  typedef T Type_t;
   inline static Type_t apply(const QDPType<T,C> &a, const EvalLeaf1 &f)
     { 
-      return Type_t(a.elem(f.val1()));
+      return SiteLoad<T>::load(a.elem(f.val1()));
     }
 };
 
+
+//-----------------------------------------------------------------------------
+//! Tag asking whether an expression reads the destination at other sites
+/*!
+ * forEach(rhs, DestAliasLeaf(dest.getF()), OrCombine()) is true when rhs
+ * reads dest through a shift. Plain fields are read at the site being
+ * written, so e.g. psi = psi + a*chi is still evaluated in place. Shift
+ * nodes pass the tag on with shifted set.
+ */
+struct DestAliasLeaf
+{
+  DestAliasLeaf(const void* d, bool sh = false) : dest(d), shifted(sh) {}
+  const void* dest;
+  bool shifted;
+};
+
+template<class T>
+struct LeafFunctor<T, DestAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const T &a, const DestAliasLeaf &f)
+    {return false;}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPType<T,C>, DestAliasLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const QDPType<T,C> &a, const DestAliasLeaf &f)
+    {return LeafFunctor<C, DestAliasLeaf>::apply(static_cast<const C&>(a), f);}
+};
+
+
+//-----------------------------------------------------------------------------
+//! Tag asking whether an expression reads a field at all
+/*!
+ * forEach(rhs, ReadsFieldLeaf(f.getF()), OrCombine()) is true when rhs
+ * reads f at any site, shifted or not.
+ */
+struct ReadsFieldLeaf
+{
+  explicit ReadsFieldLeaf(const void* f) : field(f) {}
+  const void* field;
+};
+
+template<class T>
+struct LeafFunctor<T, ReadsFieldLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const T &a, const ReadsFieldLeaf &f)
+    {return false;}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPType<T,C>, ReadsFieldLeaf>
+{
+  typedef bool Type_t;
+  inline static Type_t apply(const QDPType<T,C> &a, const ReadsFieldLeaf &f)
+    {return LeafFunctor<C, ReadsFieldLeaf>::apply(static_cast<const C&>(a), f);}
+};
+
+
+//-----------------------------------------------------------------------------
+//! Tag finding the LatticeLayout of the fields of an expression
+/*!
+ * forEach(rhs, LayoutLeaf(), LayoutCombine()) is the layout of the first
+ * field of rhs that has one, and null when all are fields of Layout.
+ */
+struct LayoutLeaf
+{
+  PETE_EMPTY_CONSTRUCTORS(LayoutLeaf)
+};
+
+struct LayoutCombine
+{
+  PETE_EMPTY_CONSTRUCTORS(LayoutCombine)
+};
+
+template<class T>
+struct LeafFunctor<T, LayoutLeaf>
+{
+  typedef const LatticeLayout* Type_t;
+  inline static Type_t apply(const T &a, const LayoutLeaf &f)
+    {return 0;}
+};
+
+template<class T, class C>
+struct LeafFunctor<QDPType<T,C>, LayoutLeaf>
+{
+  typedef const LatticeLayout* Type_t;
+  inline static Type_t apply(const QDPType<T,C> &a, const LayoutLeaf &f)
+    {return LeafFunctor<C, LayoutLeaf>::apply(static_cast<const C&>(a), f);}
+};
+
+template<class Op>
+struct Combine2<const LatticeLayout*, const LatticeLayout*, Op, LayoutCombine>
+{
+  typedef const LatticeLayout* Type_t;
+  inline static
+  Type_t combine(const LatticeLayout* a, const LatticeLayout* b, Op, LayoutCombine)
+    {return a ? a : b;}
+};
+
+//! The subset of every site of the lattice of the fields of x
+template<class RHS, class C>
+inline const Subset& allSites(const QDPExpr<RHS,C>& x)
+{
+  const LatticeLayout* l = forEach(x, LayoutLeaf(), LayoutCombine());
+  return l ? l->all() : all;
+}
+
 } // namespace QDP
 
 #endif
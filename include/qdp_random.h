@@ -27,6 +27,10 @@ namespace RNG
   //! Initialize the internals of the RNG
   void initRNG(void);
 
+  //! Build the site multipliers of the linear congruential generator, once
+  /*! Done by the first lattice fill that needs them, not by initRNG */
+  void initLatticeRNG(void);
+
   //! Initialize the RNG seed
   /*!
    * Seeds are big-ints
@@ -39,6 +43,23 @@ namespace RNG
    */
   void savern(Seed& lseed);
 
+  //! Write the whole state of the generator
+  /*!
+   * The generator, the lattice size, the seed and, when they were
+   * built, the site multipliers, lexicographically ordered like any
+   * field. Collective. Written through the same writer as a gauge
+   * configuration it goes into its checkpoint.
+   */
+  void writeState(BinaryWriter& bin);
+
+  //! Take up a state written by writeState
+  /*!
+   * Instead of setrn and setGenerator, and the site multipliers come
+   * from the file, so no fill has to build them. The lattice must be
+   * that of the writer, the node grid may differ. Collective.
+   */
+  void readState(BinaryReader& bin);
+
   void finalizeRNG();
 
   //! Internal seed multiplier
@@ -46,6 +67,104 @@ namespace RNG
 
   //! Internal seed multiplier
   void sranf(float* d, int N, Seed& seed, ILatticeSeed&, const Seed&);
+
+
+  //! The generators of the lattice fills
+  /*!
+   * GEN_LCG is the skewed linear congruential generator above, whose
+   * numbers depend on the site ordering of the layout. GEN_PHILOX is the
+   * Philox4x32-10 counter based generator keyed by the global seed and
+   * indexed by the lexicographic site, so a fill is the same for any
+   * node and thread decomposition and needs no state per site. Both
+   * advance the global seed of setrn/savern the same way per call.
+   */
+  enum Generator { GEN_LCG, GEN_PHILOX };
+
+  //! Select the generator of later random and gaussian calls
+  void setGenerator(Generator g);
+
+  //! The generator in use
+  Generator generator();
+
+  //! Look up a generator by its name as given to -rng, false if there is none
+  bool generatorFromName(const char* name, Generator& g);
+
+  //! Key of one call of the counter based generator
+  struct CounterKey
+  {
+    unsigned int k[2];
+  };
+
+  //! The key of the next lattice (or scalar) fill, advancing the global seed
+  CounterKey nextCounterKey(bool lattice);
+
+  //! Lexicographic index on the whole lattice of a site of this node
+  unsigned int lexicoSite(int site);
+
+  //! The counter index standing for a scalar fill, which no site has
+  const unsigned int scalar_site = 0xffffffffu;
+
+  //! Philox4x32-10 of counter c under key k
+  inline void philox4x32(const unsigned int c_in[4], const unsigned int k_in[2], unsigned int out[4])
+  {
+    unsigned int c0 = c_in[0], c1 = c_in[1], c2 = c_in[2], c3 = c_in[3];
+    unsigned int k0 = k_in[0], k1 = k_in[1];
+
+    for(int r=0; r < 10; ++r)
+    {
+      const unsigned long long p0 = 0xD2511F53ull * c0;
+      const unsigned long long p1 = 0xCD9E8D57ull * c2;
+      const unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)p0;
+      const unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)p1;
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+  }
+
+  //! The first 4*nblocks words of the stream of a site
+  /*! The blocks are independent, so the loop vectorises */
+  inline void counterWords(const CounterKey& key, unsigned int site, unsigned int* w, int nblocks)
+  {
+    for(int b=0; b < nblocks; ++b)
+    {
+      const unsigned int c[4] = {(unsigned int)b, site, 0u, 0u};
+      philox4x32(c, key.k, w + 4*b);
+    }
+  }
+
+  //! Hands out the words of one site to fill_random
+  struct CounterStream
+  {
+    const unsigned int* w;
+    int pos;
+  };
+
+  //! Number of 32-bit words a fill of T draws, a float takes one and a double two
+  template<class T>
+  struct CounterWords
+  {
+    enum {words = (sizeof(T) + 3)/4, blocks = (words + 3)/4};
+  };
+
+  //! dest = uniform in (0,1) from the counter stream
+  inline void fill_random(float& d, CounterStream& s, CounterStream&, const CounterStream&)
+  {
+    d = (float((s.w[s.pos++] >> 8)) + 0.5f) * (1.0f/16777216.0f);
+  }
+
+  //! dest = uniform in (0,1) from the counter stream, with 53 bits
+  inline void fill_random(double& d, CounterStream& s, CounterStream&, const CounterStream&)
+  {
+    const unsigned long long hi = s.w[s.pos++] >> 5;
+    const unsigned long long lo = s.w[s.pos++] >> 6;
+    d = (double((hi << 26) | lo) + 0.5) * (1.0/9007199254740992.0);
+  }
 }
 
 //! dest  = random
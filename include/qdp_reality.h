@@ -386,7 +386,7 @@ public:
 private:
   T re;
   T im;
-} QDP_ALIGN8;   // possibly force alignment
+} QDP_ALIGN(2*sizeof(T) < 8 ? 2*sizeof(T) : 8);   // possibly force alignment, a pair of 16 bit words stays 4 bytes
 
 
 //! Stream output
@@ -1915,6 +1915,65 @@ operator*(const RComplex<T1>& __restrict__ l, const RComplex<T2>& __restrict__ r
 	       l.real()*r.imag() + l.imag()*r.real());
 }
 
+//-----------------------------------------------------------------------------
+// Fused complex multiply-adds
+//
+// d += l*r and its conjugate forms as primitives, so the matrix and
+// vector products below are built from them rather than from a product
+// and an add of whole complex temporaries. On machine words the
+// products go through fmaWord, which is std::fma when the target has
+// hardware FMA and a multiply and an add otherwise (std::fma without
+// hardware support is a slow library call).
+
+//! a*b + c
+template<class T>
+inline T fmaWord(const T& a, const T& b, const T& c) {return a*b + c;}
+
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+inline float fmaWord(const float& a, const float& b, const float& c) {return std::fma(a,b,c);}
+inline double fmaWord(const double& a, const double& b, const double& c) {return std::fma(a,b,c);}
+#endif
+
+//! d += l*r, for the types that are not a complex of one word type
+template<class T, class T1, class T2>
+inline void cmadd(T& d, const T1& l, const T2& r) {d += l*r;}
+
+//! d += adj(l)*r, for the types that are not a complex of one word type
+template<class T, class T1, class T2>
+inline void conj_cmadd(T& d, const T1& l, const T2& r) {d += adjMultiply(l,r);}
+
+//! d += localInnerProduct(l,r), for the types that are not a complex of one word type
+template<class T, class T1, class T2>
+inline void innerProductAdd(T& d, const T1& l, const T2& r) {d += localInnerProduct(l,r);}
+
+//! RComplex d += l*r
+template<class T>
+inline void cmadd(RComplex<T>& d, const RComplex<T>& l, const RComplex<T>& r)
+{
+  d.real() = fmaWord(l.real(), r.real(), d.real());
+  d.real() = fmaWord(T(-l.imag()), r.imag(), d.real());
+  d.imag() = fmaWord(l.real(), r.imag(), d.imag());
+  d.imag() = fmaWord(l.imag(), r.real(), d.imag());
+}
+
+//! RComplex d += conj(l)*r
+template<class T>
+inline void conj_cmadd(RComplex<T>& d, const RComplex<T>& l, const RComplex<T>& r)
+{
+  d.real() = fmaWord(l.real(), r.real(), d.real());
+  d.real() = fmaWord(l.imag(), r.imag(), d.real());
+  d.imag() = fmaWord(l.real(), r.imag(), d.imag());
+  d.imag() = fmaWord(T(-l.imag()), r.real(), d.imag());
+}
+
+//! RComplex d += localInnerProduct(l,r), which is conj(l)*r
+template<class T>
+inline void innerProductAdd(RComplex<T>& d, const RComplex<T>& l, const RComplex<T>& r)
+{
+  conj_cmadd(d, l, r);
+}
+
+
 //! RComplex = RScalar * RComplex
 template<class T1, class T2>
 inline typename BinaryReturn<RScalar<T1>, RComplex<T2>, OpMultiply>::Type_t
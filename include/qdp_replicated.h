@@ -0,0 +1,146 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Read-only copies of whole lattice fields held once per host
+ */
+
+#ifndef QDP_REPLICATED_H
+#define QDP_REPLICATED_H
+
+#include <cstring>
+
+namespace QDP
+{
+
+  /** \addtogroup group1
+   *  @{
+   */
+
+  namespace ReplicaInternal
+  {
+    //! Bytes every node of a host reads, once per host where the architecture can
+    /*! Made and freed by all the nodes together */
+    class Store
+    {
+    public:
+      explicit Store(size_t bytes);
+      ~Store();
+
+      //! Is there one copy per host rather than one per node
+      bool shared() const;
+
+      char* data() const;
+
+      //! Each node wrote block bytes at offset + node*block, give every node all of them
+      /*! All the nodes call it together */
+      void allGather(size_t offset, size_t block);
+
+    private:
+      Store(const Store&);
+      Store& operator=(const Store&);
+
+      struct Impl;
+      Impl* impl;
+    };
+  }
+
+
+  //! All the sites of one or more lattice fields, readable on every node
+  /*!
+   * Codes that want the whole of a field on every node, like gauge
+   * fixing or smearing on a full-volume gauge field, or banks of
+   * eigenvectors or other objects kept for the whole job, otherwise hold
+   * a copy per node: with n nodes on a host that is n copies of the
+   * same bytes in its memory. Here the nodes of a host map one copy,
+   * in shared memory when built with --enable-mpi-shm, and fill it in
+   * one all-gather between the hosts:
+   *
+   *   ReplicatedLattice<ColorMatrix::Subtype_t> umu(u[mu]);
+   *   const ColorMatrix::Subtype_t& link = umu(coord);      // any site
+   *
+   *   ReplicatedLattice<LatticeFermion::Subtype_t> bank(evecs);  // multi1d of fields
+   *   const LatticeFermion::Subtype_t& v = bank(k, coord);
+   *
+   * The sites are held node by node, each node's in its linear order,
+   * so field(k) + node*sitesOnNode() is the part of field k held by that
+   * node. The copy is made at construction and never written again:
+   * changing the fields afterwards does not change it. Made and
+   * destroyed by all the nodes together.
+   */
+  template<class T>
+  class ReplicatedLattice
+  {
+  public:
+    //! All the sites of f
+    explicit ReplicatedLattice(const OLattice<T>& f) : store(0), nfields(0)
+      {
+	fill(&f, 1);
+      }
+
+    //! All the sites of every field of f
+    explicit ReplicatedLattice(const multi1d< OLattice<T> >& f) : store(0), nfields(0)
+      {
+	fill(f.slice(), f.size());
+      }
+
+    ~ReplicatedLattice() {delete store;}
+
+    //! Number of fields held
+    int numFields() const {return nfields;}
+
+    //! Is the copy held once per host
+    bool shared() const {return store->shared();}
+
+    //! All the sites of field k, node by node
+    const T* field(int k) const
+      {
+	return (const T*)store->data() + size_t(k)*Layout::vol();
+      }
+
+    //! Field k at the site of linear index linear on node
+    const T& elem(int k, int node, int linear) const
+      {
+	return field(k)[size_t(node)*Layout::sitesOnNode() + linear];
+      }
+
+    //! Field k at the site coord
+    const T& operator()(int k, const multi1d<int>& coord) const
+      {
+	return elem(k, Layout::nodeNumber(coord), Layout::linearSiteIndex(coord));
+      }
+
+    //! The first field at the site coord
+    const T& operator()(const multi1d<int>& coord) const
+      {
+	return (*this)(0, coord);
+      }
+
+  private:
+    ReplicatedLattice(const ReplicatedLattice&);
+    ReplicatedLattice& operator=(const ReplicatedLattice&);
+
+    //! Each node copies its sites into its block, then the blocks go round
+    void fill(const OLattice<T>* f, int n)
+      {
+	const size_t block = size_t(Layout::sitesOnNode())*sizeof(T);
+	const size_t whole = size_t(Layout::vol())*sizeof(T);
+
+	nfields = n;
+	store = new ReplicaInternal::Store(whole*n);
+
+	for(int k=0; k < n; ++k)
+	{
+	  std::memcpy(store->data() + k*whole + Layout::nodeNumber()*block, f[k].getF(), block);
+	  store->allGather(k*whole, block);
+	}
+      }
+
+    ReplicaInternal::Store* store;
+    int nfields;
+  };
+
+  /** @} */ // end of group1
+
+} // namespace QDP
+
+#endif
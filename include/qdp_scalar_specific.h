@@ -41,6 +41,26 @@ namespace QDPInternal
   template<class T>
   inline void globalSum(T& dest) {}
 
+  //! Dummy handle on a global sum - there is nothing in flight
+  class GlobalSumHandle
+  {
+  public:
+    bool test() {return true;}
+    void wait() {}
+  };
+
+  //! Dummy start of an array sum accross all nodes
+  template<class T>
+  inline GlobalSumHandle globalSumArrayAsync(T* dest, int n, bool reproducible=false) {return GlobalSumHandle();}
+
+  //! Dummy start of a global sum on a multi1d
+  template<class T>
+  inline GlobalSumHandle globalSumArrayAsync(multi1d<T>& dest, bool reproducible=false) {return GlobalSumHandle();}
+
+  //! Dummy start of a sum across all nodes
+  template<class T>
+  inline GlobalSumHandle globalSumAsync(T& dest, bool reproducible=false) {return GlobalSumHandle();}
+
   //! Dummy global And
   inline void globalAnd(bool& in) {}
 
@@ -58,6 +78,13 @@ namespace QDPInternal
   //! Dummy broadcast a string from primary node to all other nodes
   inline void broadcast_str(std::string& dest) {}
 
+  //! The one node keeps what it sends itself
+  inline void exchangeAll(const char* send, const size_t* send_bytes, char* recv, const size_t* recv_bytes)
+  {
+    if (send_bytes[0] > 0)
+      std::memcpy(recv, send, send_bytes[0]);
+  }
+
   //! Dummy broadcast from primary node to all other nodes
   inline void broadcast(void* dest, size_t nbytes) {}
 }
@@ -77,24 +104,37 @@ struct u_arg{
         const QDPExpr<RHS,OScalar<T1> >& r;
         const Op& op;
         const int *tab;
+        const SiteRun *runs;
+        int nruns;
   u_arg( OLattice<T>& d_,
 	 const QDPExpr<RHS, OScalar<T1> >& r_,
 	 const Op& op_,
-	 const int *tab_ ) : d(d_), r(r_), op(op_), tab(tab_) {}
+	 const int *tab_,
+	 const SiteRun *runs_ = 0,
+	 int nruns_ = 0 ) : d(d_), r(r_), op(op_), tab(tab_), runs(runs_), nruns(nruns_) {}
    };
 
 //! user function for the evaluate function:
 // "OLattice Op Scalar(Expression(source)) under an Subset"
 //
 template<class T, class T1, class Op, class RHS>
-void ev_userfunc(int lo, int hi, int myId, u_arg<T,T1,Op,RHS> *a)
+QDP_SITE_KERNEL void ev_userfunc(int lo, int hi, int myId, u_arg<T,T1,Op,RHS> *a)
 {
    OLattice<T>& dest = a->d;
    const QDPExpr<RHS,OScalar<T1> >&rhs = a->r;
    const int* tab = a->tab;
    const Op& op= a->op;
 
-      
+   // Without a site table the sites come run by run
+   if (! tab)
+   {
+     forSiteRuns(a->runs, a->nruns, lo, hi, [&](int i0, int n) {
+	 for(int i=i0; i < i0+n; ++i)
+	   op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
+       });
+     return;
+   }
+
    for(int j=lo; j < hi; ++j)
    {
      int i = tab[j];
@@ -112,10 +152,14 @@ struct user_arg{
         const QDPExpr<RHS,OLattice<T1> >& r;
         const Op& op;
         const int *tab;
+        const SiteRun *runs;
+        int nruns;
   user_arg(OLattice<T>& d_,
 	   const QDPExpr<RHS,OLattice<T1> >& r_,
 	   const Op& op_,
-	   const int *tab_) : d(d_), r(r_), op(op_), tab(tab_) {}
+	   const int *tab_,
+	   const SiteRun *runs_ = 0,
+	   int nruns_ = 0) : d(d_), r(r_), op(op_), tab(tab_), runs(runs_), nruns(nruns_) {}
 
    };
 
@@ -123,7 +167,7 @@ struct user_arg{
 // "OLattice Op OLattice(Expression(source)) under an Subset"
 //
 template<class T, class T1, class Op, class RHS>
-void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
+QDP_SITE_KERNEL void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
 {
 
    OLattice<T>& dest = a->d;
@@ -131,7 +175,16 @@ void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
    const int* tab = a->tab;
    const Op& op= a->op;
 
-      
+   // Without a site table the sites come run by run
+   if (! tab)
+   {
+     forSiteRuns(a->runs, a->nruns, lo, hi, [&](int i0, int n) {
+	 for(int i=i0; i < i0+n; ++i)
+	   op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
+       });
+     return;
+   }
+
    for(int j=lo; j < hi; ++j)
    {
      int i = tab[j];
@@ -142,6 +195,41 @@ void evaluate_userfunc(int lo, int hi, int myId, user_arg<T,T1,Op,RHS> *a)
 //! include the header file for dispatch
 #include "qdp_dispatch.h"
 
+
+//! user argument for the indexed copies done by the maps
+/*!
+ * Position k runs over [lo,hi), or over tab[lo..hi) when tab is set,
+ * and out[oidx ? oidx[k] : k] = in[iidx[k]]
+ */
+template<class T1>
+struct GatherThreadArgs {
+  GatherThreadArgs(T1 *out_, const int *oidx_, const T1 *in_, const int *iidx_, const int *tab_) : 
+    out(out_), oidx(oidx_), in(in_), iidx(iidx_), tab(tab_) {}
+
+  T1 *out;
+  const int *oidx;
+  const T1 *in;
+  const int *iidx;
+  const int *tab;
+};
+
+//! user function for the indexed copies done by the maps
+template<class T1>
+void gatherKernel(int lo, int hi, int myId, GatherThreadArgs<T1> *a)
+{
+  T1 *out = a->out;
+  const T1 *in = a->in;
+  const int *oidx = a->oidx;
+  const int *iidx = a->iidx;
+  const int *tab = a->tab;
+
+  for(int j=lo; j < hi; ++j)
+  {
+    int k = tab ? tab[j] : j;
+    out[oidx ? oidx[k] : k] = in[iidx[k]];
+  }
+}
+
 //-----------------------------------------------------------------------------
 //! OLattice Op Scalar(Expression(source)) under an Subset
 /*! 
@@ -155,16 +243,28 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
 {
 //  cerr << "In evaluateUnorderedSubet(olattice,oscalar)\n";
 
-#if defined(QDP_USE_PROFILING)   
+  // Copies sharing the sites of dest keep the old values
+  dest.detach();
+
   static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
+  QDPTime_t prof_t0 = prof.start();
 
   int numSiteTable = s.numSiteTable();
+
+#if defined(QDP_USE_OMP_OFFLOAD)
+  if (Offload::use(numSiteTable))
+  {
+    Offload::evaluate(dest, op, rhs, s);
+    prof.stop(prof_t0, s.numSiteTable());
+    return;
+  }
+#endif
   
-  u_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
+  u_arg<T,T1,Op,RHS> a(dest, rhs, op, s.hasRuns() ? 0 : s.siteTable().slice(),
+		       s.hasRuns() ? s.runTable().slice() : 0, s.numRuns());
 
-  dispatch_to_threads< u_arg<T,T1,Op,RHS> >(numSiteTable, a, ev_userfunc);
+  dispatch_to_subset(s, sizeof(T), a, ev_userfunc<T,T1,Op,RHS>);
  
   ///////////////////
   // Original code
@@ -178,11 +278,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OScalar<T1> >&
   //op(dest.elem(i), forEach(rhs, EvalLeaf1(0), OpCombine()));
   //}
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s.numSiteTable());
 }
 
 
@@ -199,16 +295,51 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
 {
 //  cerr << "In evaluateSubset(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
+  // Copies sharing the sites of dest keep the old values
+  dest.detach();
+
+  // Kernels are matched on the canonical form, e.g. y += x*a as y += a*x
+  if (Canonical<RHS>::changed)
+  {
+    KernelReport::canonicalised(op, rhs);
+    evaluate(dest, op, canonical(rhs), s);
+    return;
+  }
+
+  // Writing dest in place while a shift reads it at other sites would
+  // mix old and new values. Go through a temporary then - the allocator
+  // cache hands the same block back on the next such call
+  if (forEach(rhs, DestAliasLeaf(dest.getF()), OrCombine()))
+  {
+    OLattice<T1> tmp;
+    evaluate(tmp, OpAssign(), rhs, s);
+    evaluate(dest, op, PETE_identity(tmp), s);
+    return;
+  }
+
+  KernelReport::generic(op, rhs);
+
   static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
+  QDPTime_t prof_t0 = prof.start();
 
   int numSiteTable = s.numSiteTable();
 
-  user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
+#if defined(QDP_USE_OMP_OFFLOAD)
+  if (Offload::use(numSiteTable))
+  {
+    Offload::evaluate(dest, op, rhs, s);
+    prof.stop(prof_t0, s.numSiteTable());
+    return;
+  }
+#endif
+
+  // Sites go tile by tile when Layout::setSiteTiling is on, and
+  // run by run through the consecutive sites otherwise
+  user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.loopsByRuns() ? 0 : s.traversalTable().slice(),
+			  s.hasRuns() ? s.runTable().slice() : 0, s.numRuns());
 
-  dispatch_to_threads<user_arg<T,T1,Op,RHS> >(numSiteTable, a, evaluate_userfunc);
+  dispatch_to_subset(s, sizeof(T), a, evaluate_userfunc<T,T1,Op,RHS>);
 
   ////////////////////
   // Original code
@@ -223,11 +354,7 @@ void evaluate(OLattice<T>& dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >&
   //op(dest.elem(i), forEach(rhs, EvalLeaf1(i), OpCombine()));
   //}
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s.numSiteTable());
 }
 
 
@@ -240,10 +367,19 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
 {
   //cerr << "In evaluate_F(olattice,olattice)" << endl;
 
-#if defined(QDP_USE_PROFILING)   
+  // A shift reading dest, see evaluate
+  if (forEach(rhs, DestAliasLeaf(dest), OrCombine()))
+  {
+    multi1d<T1> tmp(s.numSiteTable());
+    evaluate_F(tmp.slice(), OpAssign(), rhs, s);
+    for(int j=0; j < tmp.size(); ++j)
+      op(dest[j], tmp[j]);
+    return;
+  }
+
   static QDPProfile_t prof(dest, op, rhs);
-  prof.time -= getClockTime();
-#endif
+  ThreadReport::Scope thread_scope(ThreadReport::exprRegion(op, rhs));
+  QDPTime_t prof_t0 = prof.start();
 
   // int numSiteTable = s.numSiteTable();
   // user_arg<T,T1,Op,RHS> a(dest, rhs, op, s.siteTable().slice());
@@ -258,19 +394,12 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
   // General form of loop structure
   const int *tab = s.siteTable().slice();
 
-#pragma omp parallel for
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    //fprintf(stderr,"eval(olattice,olattice): site %d\n",i);
-    op( dest[j], forEach(rhs, EvalLeaf1(i), OpCombine()));
-  }
+  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+      for(int j=lo; j < hi; ++j)
+	op(dest[j], forEach(rhs, EvalLeaf1(tab[j]), OpCombine()));
+    });
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s.numSiteTable());
 }
 
 
@@ -278,18 +407,19 @@ void evaluate_F(T* dest, const Op& op, const QDPExpr<RHS,OLattice<T1> >& rhs,
 //! dest = (mask) ? s1 : dest
 template<class T1, class T2> 
 void 
-copymask(OSubLattice<T2> d, const OLattice<T1>& mask, const OLattice<T2>& s1) 
+copymask(const OSubLattice<T2>& d, const OLattice<T1>& mask, const OLattice<T2>& s1) 
 {
-  OLattice<T2>& dest = d.field();
   const Subset& s = d.subset();
+  const int* pos = d.sitePos();
 
   const int *tab = s.siteTable().slice();
-#pragma omp parallel for
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    copymask(dest.elem(i), mask.elem(i), s1.elem(i));
-  }
+  dispatch_range(s, sizeof(T2), [&](int lo, int hi, int myId) {
+      for(int j=lo; j < hi; ++j)
+      {
+	int i = tab[j];
+	copymask(d.getF()[pos ? j : i], mask.elem(i), s1.elem(i));
+      }
+    });
 }
 
 
@@ -298,11 +428,12 @@ template<class T1, class T2>
 void 
 copymask(OLattice<T2>& dest, const OLattice<T1>& mask, const OLattice<T2>& s1) 
 {
-  const int vvol = Layout::vol();
+  dest.detach();
 
-#pragma omp parallel for
-  for(int i=0; i < vvol; ++i) 
-    copymask(dest.elem(i), mask.elem(i), s1.elem(i));
+  dispatch_range(Layout::vol(), [&](int lo, int hi, int myId) {
+      for(int i=lo; i < hi; ++i)
+	copymask(dest.elem(i), mask.elem(i), s1.elem(i));
+    });
 }
 
 
@@ -324,6 +455,16 @@ template<class T>
 void 
 random(OScalar<T>& d)
 {
+  if (RNG::generator() == RNG::GEN_PHILOX)
+  {
+    typedef RNG::CounterWords<T> W;
+    unsigned int w[4*W::blocks];
+    RNG::counterWords(RNG::nextCounterKey(false), RNG::scalar_site, w, W::blocks);
+    RNG::CounterStream st = {w, 0};
+    fill_random(d.elem(), st, st, st);
+    return;
+  }
+
   Seed seed = RNG::ran_seed;
   Seed skewed_seed = RNG::ran_seed * RNG::ran_mult;
 
@@ -333,44 +474,138 @@ random(OScalar<T>& d)
 }
 
 
+//! user argument for random under a subset
+template<class T>
+struct RandomThreadArgs {
+  RandomThreadArgs(OLattice<T>& d_, const int *tab_, Seed& seed_) : d(d_), tab(tab_), seed(seed_) {}
+
+  OLattice<T>& d;
+  const int *tab;
+  Seed& seed;
+};
+
+//! user function for random under a subset
+/*! RNG::ran_seed is only read here; thread 0 hands back the new seed */
+template<class T>
+void randomKernel(int lo, int hi, int myId, RandomThreadArgs<T> *a)
+{
+  OLattice<T>& d = a->d;
+  const int *tab = a->tab;
+
+  Seed seed;
+  Seed skewed_seed;
+
+  for(int j=lo; j < hi; ++j) {
+    int i = tab[j];
+    seed = RNG::ran_seed;
+    skewed_seed.elem() = RNG::ran_seed.elem() * RNG::lattice_ran_mult->elem(i);
+    fill_random(d.elem(i), seed, skewed_seed, RNG::ran_mult_n);
+  }
+
+  // The seed from any site is the same as the new global seed
+  if (myId == 0 && lo < hi)
+    a->seed = seed;
+}
+
+
+//! user argument for the counter based random and gaussian
+template<class T>
+struct CounterRandomArgs {
+  OLattice<T>& d;
+  const int *tab;
+  RNG::CounterKey key;
+};
+
+//! user function for random from the counter based generator
+template<class T>
+void counterRandomKernel(int lo, int hi, int myId, CounterRandomArgs<T> *a)
+{
+  typedef RNG::CounterWords<T> W;
+  unsigned int w[4*W::blocks];
+
+  for(int j=lo; j < hi; ++j)
+  {
+    int i = a->tab[j];
+    RNG::counterWords(a->key, RNG::lexicoSite(i), w, W::blocks);
+    RNG::CounterStream st = {w, 0};
+    fill_random(a->d.elem(i), st, st, st);
+  }
+}
+
+//! user argument for noise
+template<class T>
+struct NoiseArgs {
+  OLattice<T>& d;
+  const int *tab;
+  RNG::CounterKey key;
+  NoiseType type;
+};
+
+//! user function for noise, one pass over the words of each site
+template<class T>
+void noiseKernel(int lo, int hi, int myId, NoiseArgs<T> *a)
+{
+  for(int j=lo; j < hi; ++j)
+  {
+    int i = a->tab[j];
+    RNG::counterNoise(a->d.elem(i), a->type, a->key, RNG::lexicoSite(i));
+  }
+}
+
+//! dest  = gaussian, Z2 or Z4 noise   under a subset
+/*! Always from the counter based generator, whichever -rng selects */
+template<class T>
+void noise(OLattice<T>& d, NoiseType type, const Subset& s)
+{
+  d.detach();
+
+  NoiseArgs<T> args = {d, s.siteTable().slice(), RNG::nextCounterKey(true), type};
+  dispatch_to_threads(s.numSiteTable(), args, noiseKernel<T>);
+}
+
+//! dest  = noise   under a subset
+template<class T>
+void noise(const OSubLattice<T>& dd, NoiseType type)
+{
+  withFullField(dd, false, true, [type](OLattice<T>& d, const Subset& s) {noise(d, type, s);});
+}
+
+//! dest  = noise
+template<class T>
+void noise(OLattice<T>& d, NoiseType type)
+{
+  noise(d, type, all);
+}
+
 //! dest  = random    under a subset
 template<class T>
 void 
 random(OLattice<T>& d, const Subset& s)
 {
-  // Grab table array
-  const int *tab = s.siteTable().slice();
+  d.detach();
 
-#pragma omp parallel 
+  if (RNG::generator() == RNG::GEN_PHILOX)
   {
-    Seed seed;
-    Seed skewed_seed;
+    CounterRandomArgs<T> args = {d, s.siteTable().slice(), RNG::nextCounterKey(true)};
+    dispatch_to_threads(s.numSiteTable(), args, counterRandomKernel<T>);
+    return;
+  }
 
-#pragma omp for // need the barrier to avoid that RNG::ran_seed is changed too early
-    for(int j=0; j < s.numSiteTable(); ++j) {
-      int i = tab[j];
-      seed = RNG::ran_seed;
-      skewed_seed.elem() = RNG::ran_seed.elem() * RNG::lattice_ran_mult->elem(i);
-      fill_random(d.elem(i), seed, skewed_seed, RNG::ran_mult_n);
-    }
+  RNG::initLatticeRNG();
+  Seed seed = RNG::ran_seed;
 
-#pragma omp critical (random)
-    {
-      RNG::ran_seed = seed;  // The seed from any site is the same as the new global seed
-    }
-  }
+  RandomThreadArgs<T> args(d, s.siteTable().slice(), seed);
+  dispatch_to_threads(s.numSiteTable(), args, randomKernel<T>);
 
+  RNG::ran_seed = seed;
 }
 
 
 //! dest  = random   under a subset
 template<class T>
-void random(OSubLattice<T> dd)
+void random(const OSubLattice<T>& dd)
 {
-  OLattice<T>& d = dd.field();
-  const Subset& s = dd.subset();
-
-  random(d,s);
+  withFullField(dd, false, true, [](OLattice<T>& d, const Subset& s) {random(d,s);});
 }
 
 
@@ -386,6 +621,14 @@ void random(OLattice<T>& d)
 template<class T>
 void gaussian(OLattice<T>& d, const Subset& s)
 {
+  d.detach();
+
+  if (RNG::generator() == RNG::GEN_PHILOX)
+  {
+    noise(d, NOISE_GAUSSIAN, s);
+    return;
+  }
+
   OLattice<T>  r1, r2;
 
   random(r1,s);
@@ -393,24 +636,22 @@ void gaussian(OLattice<T>& d, const Subset& s)
 
   const int *tab = s.siteTable().slice();
 
-#pragma omp parallel for
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    fill_gaussian(d.elem(i), r1.elem(i), r2.elem(i));
-  }
+  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+      for(int j=lo; j < hi; ++j)
+      {
+	int i = tab[j];
+	fill_gaussian(d.elem(i), r1.elem(i), r2.elem(i));
+      }
+    });
 }
 
 
 
 //! dest  = gaussian   under a subset
 template<class T>
-void gaussian(OSubLattice<T> dd)
+void gaussian(const OSubLattice<T>& dd)
 {
-  OLattice<T>& d = dd.field();
-  const Subset& s = dd.subset();
-
-  gaussian(d,s);
+  withFullField(dd, false, true, [](OLattice<T>& d, const Subset& s) {gaussian(d,s);});
 }
 
 
@@ -429,14 +670,14 @@ void gaussian(OLattice<T>& d)
 template<class T> 
 void zero_rep(OLattice<T>& dest, const Subset& s) 
 {
+  dest.detach();
+
   const int *tab = s.siteTable().slice();
 
-#pragma omp parallel for
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    zero_rep(dest.elem(i));
-  }
+  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+      for(int j=lo; j < hi; ++j)
+	zero_rep(dest.elem(tab[j]));
+    });
 }
 
 
@@ -456,10 +697,18 @@ void zero_rep(OSubLattice<T> dd)
 template<class T> 
 void zero_rep(OLattice<T>& dest) 
 {
-  const int vvol = Layout::vol();
-#pragma omp parallel for
-  for(int i=0; i < vvol; ++i) 
-    zero_rep(dest.elem(i));
+  dest.detach();
+
+  if (dest.layout())
+  {
+    zero_rep(dest, dest.layout()->all());
+    return;
+  }
+
+  dispatch_range(Layout::vol(), [&](int lo, int hi, int myId) {
+      for(int i=lo; i < hi; ++i)
+	zero_rep(dest.elem(i));
+    });
 }
 
 
@@ -477,18 +726,12 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global sum needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, 1);
 
   return d;
 }
@@ -505,24 +748,65 @@ sum(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   evaluate(d,OpAssign(),s1,all);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, 1);
 
   return d;
 }
 
 
 
+//! user argument for the sum of an OLattice expression
+template<class RHS, class T>
+struct SumOLatticeThreadArgs {
+  SumOLatticeThreadArgs(const QDPExpr<RHS,OLattice<T> >& s_,
+			const int *tab_,
+			multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest_,
+			const SiteRun *runs_ = 0, int nruns_ = 0) : s(s_), tab(tab_), dest(dest_), runs(runs_), nruns(nruns_) {}
+
+  const QDPExpr<RHS,OLattice<T> >& s;
+  const int *tab;    // null means the runs, or all sites without them
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dest;
+  const SiteRun *runs;
+  int nruns;
+};
+
+//! user function for the sum of an OLattice expression
+/*! Each thread leaves its partial sum in dest[myId] */
+template<class RHS, class T>
+QDP_SITE_KERNEL void sumKernel(int lo, int hi, int myId, SumOLatticeThreadArgs<RHS,T> *a)
+{
+  const QDPExpr<RHS,OLattice<T> >& s1 = a->s;
+  const int *tab = a->tab;
+
+  typename UnaryReturn<OLattice<T>, FnSum>::Type_t dthread;
+  zero_rep(dthread.elem());
+
+  if (tab) {
+    for(int j=lo; j < hi; ++j) {
+      int i = tab[j];
+      dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());   // SINGLE NODE VERSION FOR NOW
+    }
+  }
+  else if (a->runs) {
+    forSiteRuns(a->runs, a->nruns, lo, hi, [&](int i0, int n) {
+	for(int i=i0; i < i0+n; ++i)
+	  dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());
+      });
+  }
+  else {
+    for(int i=lo; i < hi; ++i)
+      dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());
+  }
+
+  a->dest[myId].elem() = dthread.elem();
+}
+
+
 //! OScalar = sum(OLattice)  under an explicit subset
 /*!
  * Allow a global sum that sums over the lattice, but returns an object
@@ -534,40 +818,34 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Must initialize to zero since we do not know if the loop will be entered
   zero_rep(d.elem());
 
-  const int *tab = s.siteTable().slice();
-
-#pragma omp parallel 
+#if defined(QDP_USE_OMP_OFFLOAD)
+  if (Offload::use(s.numSiteTable()))
   {
-    typename UnaryReturn<OLattice<T>, FnSum>::Type_t dthread;
-    zero_rep(dthread.elem());
+    Offload::sum(d, s1, s);
+    prof.stop(prof_t0, s.numSiteTable());
+    return d;
+  }
+#endif
 
-#pragma omp for nowait
-    for(int j=0; j < s.numSiteTable(); ++j) {
-      
-      int i = tab[j];
-      dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());   // SINGLE NODE VERSION FOR NOW
-    }
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads());
+  for(int thread=0; thread < pdest.size(); ++thread)
+    zero_rep(pdest[thread].elem());
 
-#pragma omp critical
-    {
-      d.elem() += dthread.elem();
-    }
+  SumOLatticeThreadArgs<RHS,T> args(s1, s.hasRuns() ? 0 : s.siteTable().slice(), pdest,
+				    s.hasRuns() ? s.runTable().slice() : 0, s.numRuns());
+  dispatch_to_subset(s, sizeof(T), args, sumKernel<RHS,T>, Partition::ALIGNED);
 
-  }
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int thread=0; thread < pdest.size(); ++thread)
+    d.elem() += pdest[thread].elem();
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s.numSiteTable());
 
   return d;
 }
@@ -582,39 +860,30 @@ template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnSum>::Type_t
 sum(const QDPExpr<RHS,OLattice<T> >& s1)
 {
+  // Fields of a LatticeLayout are summed over the sites of their lattice
+  if (const LatticeLayout* l = forEach(s1, LayoutLeaf(), LayoutCombine()))
+    return sum(s1, l->all());
+
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Loop always entered - could unroll
   zero_rep(d.elem());
-  
-  const int vvol = Layout::vol();
 
-#pragma omp parallel
-  {
-    typename UnaryReturn<OLattice<T>, FnSum>::Type_t	dthread;
-    zero_rep(dthread.elem());
-    
-#pragma omp for nowait
-    for(int i=0; i < vvol; ++i)  {
-      dthread.elem() += forEach(s1, EvalLeaf1(i), OpCombine());
-    }
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads());
+  for(int thread=0; thread < pdest.size(); ++thread)
+    zero_rep(pdest[thread].elem());
 
-#pragma omp critical
-    {
-      d.elem() += dthread.elem();
-    }
-  }
+  SumOLatticeThreadArgs<RHS,T> args(s1, 0, pdest);
+  dispatch_to_threads(Layout::vol(), args, sumKernel<RHS,T>);
 
-#if defined(QDP_USE_PROFILING)	 
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int thread=0; thread < pdest.size(); ++thread)
+    d.elem() += pdest[thread].elem();
+
+  prof.stop(prof_t0, all.numSiteTable());
   
   return d;
 }
@@ -632,10 +901,8 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
 {
   typename UnaryReturn<OLattice<T>, FnSum>::Type_t	d;
   
-#if defined(QDP_USE_PROFILING)	 
   static QDPProfile_t prof(d, OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
   
   // Loop always entered - could unroll
   zero_rep(d.elem());
@@ -657,11 +924,7 @@ sum(const QDPExpr<RHS,OLattice<T> >& s1)
     }
   }
 	
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -683,20 +946,14 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OScalar<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // lazy - evaluate repeatedly
   for(int i=0; i < ss.numSubsets(); ++i)
     evaluate(dest[i],OpAssign(),s1,all);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, 1);
 
   return dest;
 }
@@ -714,11 +971,13 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
   template<class RHS, class T>
   struct SumMultiOLatticeThreadArgs {
     const multi1d<int>& lat_color;
+    const multi1d<ColorRun>& cruns;
     const QDPExpr<RHS,OLattice<T> >& s;
     multi1d<typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t>& dest;
     SumMultiOLatticeThreadArgs(const multi1d<int>& lat_color_,
+			       const multi1d<ColorRun>& cruns_,
 			       const QDPExpr<RHS,OLattice<T> >& s_,
-			       multi1d<typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t>& dest_) : lat_color(lat_color_), s(s_), dest(dest_) {}
+			       multi1d<typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t>& dest_) : lat_color(lat_color_), cruns(cruns_), s(s_), dest(dest_) {}
 
   };
 
@@ -728,6 +987,16 @@ sumMulti(const QDPExpr<RHS,OScalar<T> >& s1, const Set& ss)
     const multi1d<int>& lat_color = a->lat_color;
     const  QDPExpr<RHS,OLattice<T> >& s=a->s;
     multi1d<typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t>& dest=a->dest;
+
+    // One color per run, so the color is looked up once a run
+    if (a->cruns.size() > 0) {
+      forColorRuns(a->cruns.slice(), a->cruns.size()-1, lo, hi, [&](int i0, int n, int j) {
+	  for(int i=i0; i < i0+n; ++i)
+	    (dest[my_id])[j].elem() += forEach(s, EvalLeaf1(i), OpCombine());
+	});
+      return;
+    }
+
     for(int i=lo; i < hi; ++i) { 
       int j = lat_color[i];
       (dest[my_id])[j].elem() += forEach(s, EvalLeaf1(i), OpCombine());   // SINGLE NODE VERSION FOR NOW
@@ -740,10 +1009,8 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   multi1d< typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t > pdest(qdpNumThreads());
 
@@ -758,7 +1025,7 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 
   // Loop over all sites and accumulate based on the coloring 
   const multi1d<int>& lat_color =  ss.latticeColoring();
-  SumMultiOLatticeThreadArgs<RHS,T> args(lat_color,s1,pdest);
+  SumMultiOLatticeThreadArgs<RHS,T> args(lat_color,ss.colorRuns(),s1,pdest);
 
   const int vvol = Layout::vol();
   dispatch_to_threads(vvol, args, sumMultiKernel<RHS,T>);
@@ -781,11 +1048,46 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
   }
 #endif
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
+
+  return dest;
+}
+
+
+//! multi1d<OScalar> dest  = sumMultiSubsets(OLattice,Set) 
+/*!
+ * Same result as sumMulti, but each subset is summed over its own site
+ * table instead of scanning the coloring array. Suits sets whose subsets
+ * are few and large. Each subset is reduced over the threads in a fixed
+ * order, so the result is reproducible for a given number of threads.
+ */
+template<class RHS, class T>
+typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t
+sumMultiSubsets(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
+{
+  typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
+
+  static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
+  QDPTime_t prof_t0 = prof.start();
+
+  multi1d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> pdest(qdpNumThreads());
+
+  for(int k=0; k < ss.numSubsets(); ++k) {
+    const Subset& sub = ss[k];
+
+    for(int thread=0; thread < pdest.size(); ++thread)
+      zero_rep(pdest[thread].elem());
+
+    SumOLatticeThreadArgs<RHS,T> args(s1, sub.hasRuns() ? 0 : sub.siteTable().slice(), pdest,
+				      sub.hasRuns() ? sub.runTable().slice() : 0, sub.numRuns());
+    dispatch_to_subset(sub, sizeof(T), args, sumKernel<RHS,T>, Partition::ALIGNED);
+
+    zero_rep(dest[k]);
+    for(int thread=0; thread < pdest.size(); ++thread)
+      dest[k].elem() += pdest[thread].elem();
+  }
+
+  prof.stop(prof_t0, all.numSiteTable());
 
   return dest;
 }
@@ -798,10 +1100,8 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
 {
   typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t  dest(ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(dest[0], OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Initialize result with zero
   for(int k=0; k < ss.numSubsets(); ++k)
@@ -817,11 +1117,7 @@ sumMulti(const QDPExpr<RHS,OLattice<T> >& s1, const Set& ss)
     dest[j].elem() += forEach(s1, EvalLeaf1(i), OpCombine());   // SINGLE NODE VERSION FOR NOW
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return dest;
 }
@@ -843,21 +1139,15 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OScalar<T>, FnSum>::Type_t>  dest(s1.size(),ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // lazy - evaluate repeatedly
   for(int i=0; i < dest.size1(); ++i)
     for(int j=0; j < dest.size2(); ++j)
       dest(j,i) = s1[j];
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s1.size());
 
   return dest;
 }
@@ -867,47 +1157,53 @@ sumMulti(const multi1d< OScalar<T> >& s1, const Set& ss)
 /*!
  * Compute the global sum on multiple subsets specified by Set 
  *
- * This is a very simple implementation. There is no need for
- * anything fancier unless global sums are just so extraordinarily
- * slow. Otherwise, generalized sums happen so infrequently the slow
- * version is fine.
+ * All the fields are summed in one pass over the sites.
  */
 template<class T>
-multi2d<typename UnaryReturn<OLattice<T>, FnSumMulti>::Type_t>
+multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>
 sumMulti(const multi1d< OLattice<T> >& s1, const Set& ss)
 {
   multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>  dest(s1.size(),ss.numSubsets());
 
-#if defined(QDP_USE_PROFILING)   
-  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1);
-  prof.time -= getClockTime();
-#endif
+  static QDPProfile_t prof(dest(0,0), OpAssign(), FnSum(), s1[0]);
+  QDPTime_t prof_t0 = prof.start();
 
   // Initialize result with zero
   for(int i=0; i < dest.size1(); ++i)
     for(int j=0; j < dest.size2(); ++j)
       zero_rep(dest(j,i));
 
-  // Loop over all sites and accumulate based on the coloring 
-  const multi1d<int>& lat_color =  ss.latticeColoring();
+  // One threaded pass over the sites accumulates all the fields by the
+  // coloring into per-thread arrays
+  const int *lat_color = ss.latticeColoring().slice();
 
-  const int vvol = Layout::vol();
-  for(int k=0; k < s1.size(); ++k)
+  multi1d< multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t> > pdest(qdpNumThreads());
+  for(int thread=0; thread < pdest.size(); ++thread)
   {
-    const OLattice<T>& ss1 = s1[k];
-
-    for(int i=0; i < vvol; ++i) 
-    {
-      int j = lat_color[i];
-      dest(k,j).elem() += ss1.elem(i);
-    }
+    pdest[thread].resize(s1.size(), ss.numSubsets());
+    for(int i=0; i < dest.size1(); ++i)
+      for(int j=0; j < dest.size2(); ++j)
+	zero_rep(pdest[thread](j,i));
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  dispatch_range(Layout::vol(), [&](int lo, int hi, int myId) {
+      multi2d<typename UnaryReturn<OLattice<T>, FnSum>::Type_t>& dthread = pdest[myId];
+
+      for(int i=lo; i < hi; ++i) 
+      {
+	int j = lat_color[i];
+	for(int k=0; k < s1.size(); ++k)
+	  dthread(k,j).elem() += s1[k].elem(i);
+      }
+    });
+
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int thread=0; thread < pdest.size(); ++thread)
+    for(int i=0; i < dest.size1(); ++i)
+      for(int j=0; j < dest.size2(); ++j)
+	dest(j,i).elem() += pdest[thread](j,i).elem();
+
+  prof.stop(prof_t0, all.numSiteTable()*s1.size());
 
   return dest;
 }
@@ -927,10 +1223,8 @@ norm2(const multi1d< OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -941,11 +1235,7 @@ norm2(const multi1d< OScalar<T> >& s1)
     d.elem() += localNorm2(ss1.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s1.size());
 
   return d;
 }
@@ -974,45 +1264,36 @@ norm2(const multi1d< OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnNorm2(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Possibly loop entered
   zero_rep(d.elem());
 
   const int *tab = s.siteTable().slice();
 
-  for(int n=0; n < s1.size(); ++n) {
-    
-    const OLattice<T>& ss1 = s1[n];
-    
-#pragma omp parallel
-    {
-      typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t	dthread;
+  // One pass of the threads over all the fields, each thread its own sites
+  multi1d<typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t> pdest(qdpNumThreads());
+  for(int thread=0; thread < pdest.size(); ++thread)
+    zero_rep(pdest[thread].elem());
+
+  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+      typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t dthread;
       zero_rep(dthread.elem());
-      
-#pragma omp for
-      for(int j=0; j < s.numSiteTable(); ++j) {
-	
-	int i = tab[j];
-	dthread.elem() += localNorm2(ss1.elem(i));
-      }
-      
-#pragma omp critical
-      {
-	d.elem() += dthread.elem();
-      }
-    }
-  }
 
+      for(int n=0; n < s1.size(); ++n)
+	for(int j=lo; j < hi; ++j)
+	  dthread.elem() += localNorm2(s1[n].elem(tab[j]));
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+      pdest[myId].elem() = dthread.elem();
+    }, Partition::ALIGNED);
+
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int thread=0; thread < pdest.size(); ++thread)
+    d.elem() += pdest[thread].elem();
+
+
+  prof.stop(prof_t0, s.numSiteTable()*s1.size());
 
   return d;
 }
@@ -1049,10 +1330,8 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
 {
   typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProduct>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -1064,11 +1343,7 @@ innerProduct(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >& s2)
     d.elem() += localInnerProduct(ss1.elem(),ss2.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s1.size());
 
   return d;
 }
@@ -1098,43 +1373,38 @@ innerProduct(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s
 {
   typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnInnerProduct(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Possibly loop entered
   zero_rep(d.elem());
 
   const int *tab = s.siteTable().slice();
 
-  for(int n=0; n < s1.size(); ++n) {
-    const OLattice<T1>& ss1 = s1[n];
-    const OLattice<T2>& ss2 = s2[n];
-		
-#pragma omp parallel
-    {
-      typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t	 dthread;
+  // One pass of the threads over all the fields, each thread its own sites
+  multi1d<typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t> pdest(qdpNumThreads());
+  for(int thread=0; thread < pdest.size(); ++thread)
+    zero_rep(pdest[thread].elem());
+
+  dispatch_range(s, sizeof(T1), [&](int lo, int hi, int myId) {
+      typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProduct>::Type_t dthread;
       zero_rep(dthread.elem());
-      
-#pragma omp for
-      for(int j=0; j < s.numSiteTable(); ++j) 
+
+      for(int n=0; n < s1.size(); ++n)
+	for(int j=lo; j < hi; ++j)
 	{
 	  int i = tab[j];
-	  dthread.elem() += localInnerProduct(ss1.elem(i),ss2.elem(i));
+	  dthread.elem() += localInnerProduct(s1[n].elem(i),s2[n].elem(i));
 	}
-#pragma omp critical
-      {
-	d.elem() += dthread.elem();
-      }
-    }
-  }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+      pdest[myId].elem() = dthread.elem();
+    }, Partition::ALIGNED);
+
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int thread=0; thread < pdest.size(); ++thread)
+    d.elem() += pdest[thread].elem();
+
+  prof.stop(prof_t0, s.numSiteTable()*s1.size());
 
   return d;
 }
@@ -1170,10 +1440,8 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
 {
   typename BinaryReturn<OScalar<T1>, OScalar<T2>, FnInnerProductReal>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Possibly loop entered
   zero_rep(d.elem());
@@ -1185,11 +1453,7 @@ innerProductReal(const multi1d< OScalar<T1> >& s1, const multi1d< OScalar<T2> >&
     d.elem() += localInnerProductReal(ss1.elem(),ss2.elem());
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, s1.size());
 
   return d;
 }
@@ -1220,68 +1484,145 @@ innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2>
 {
   typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnInnerProductReal(), s1[0]);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   // Possibly loop entered
   zero_rep(d.elem());
 
   const int *tab = s.siteTable().slice();
 
-  for(int n=0; n < s1.size(); ++n) {
+  // One pass of the threads over all the fields, each thread its own sites
+  multi1d<typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t> pdest(qdpNumThreads());
+  for(int thread=0; thread < pdest.size(); ++thread)
+    zero_rep(pdest[thread].elem());
 
-    const OLattice<T1>& ss1 = s1[n];
-    const OLattice<T2>& ss2 = s2[n];
-		
-#pragma omp parallel
-    {
-      typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t	 dthread;
+  dispatch_range(s, sizeof(T1), [&](int lo, int hi, int myId) {
+      typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t dthread;
       zero_rep(dthread.elem());
-      
-#pragma omp for
-      for(int j=0; j < s.numSiteTable(); ++j) 
+
+      for(int n=0; n < s1.size(); ++n)
+	for(int j=lo; j < hi; ++j)
 	{
 	  int i = tab[j];
-	  dthread.elem() += localInnerProductReal(ss1.elem(i),ss2.elem(i));
+	  dthread.elem() += localInnerProductReal(s1[n].elem(i),s2[n].elem(i));
 	}
-#pragma omp critical
-      {
-	d.elem() += dthread.elem();
-      }
+
+      pdest[myId].elem() = dthread.elem();
+    }, Partition::ALIGNED);
+
+  // Combine in thread order so the result does not depend on the scheduling
+  for(int thread=0; thread < pdest.size(); ++thread)
+    d.elem() += pdest[thread].elem();
+
+  prof.stop(prof_t0, s.numSiteTable()*s1.size());
+
+  return d;
+}
+
+
+//! OScalar = innerProductReal(multi1d<OLattice>,multi1d<OLattice>)
+/*!
+ * return  \sum_{multi1d} \sum_x(trace(adj(multi1d<source>)*multi1d<source>))
+ *
+ * Sum over the lattice
+ * Allow a global sum that sums over all indices
+ */
+template<class T1, class T2>
+inline typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t
+innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s2)
+{
+  return innerProductReal(s1,s2,all);
+}
+
+
+//-----------------------------------------------
+// Global max and min under a subset, and where they are
+//! user argument for the extremum of an expression
+template<class RHS, class T, class Fn>
+struct ExtremumThreadArgs
+{
+  typedef typename UnaryReturn<OLattice<T>, Fn>::Type_t Type_t;
+
+  ExtremumThreadArgs(const QDPExpr<RHS,OLattice<T> >& s_, const int* tab_, bool max_,
+         multi1d<Type_t>& dest_, multi1d<int>& site_) :
+    s(s_), tab(tab_), max(max_), dest(dest_), site(site_) {}
+
+  const QDPExpr<RHS,OLattice<T> >& s;
+  const int* tab;
+  bool max;                  // largest, else smallest
+  multi1d<Type_t>& dest;
+  multi1d<int>& site;
+};
+
+
+//! user function for the extremum of an expression
+/*! Each thread leaves its extremum in dest[myId] and the site of it in site[myId] */
+template<class RHS, class T, class Fn>
+void extremumKernel(int lo, int hi, int myId, ExtremumThreadArgs<RHS,T,Fn> *a)
+{
+  if (lo >= hi)
+    return;
+
+  const QDPExpr<RHS,OLattice<T> >& s1 = a->s;
+
+  int best = a->tab[lo];
+  typename UnaryReturn<OLattice<T>, Fn>::Type_t d;
+  d.elem() = forEach(s1, EvalLeaf1(best), OpCombine());
+
+  for(int j=lo+1; j < hi; ++j)
+  {
+    int i = a->tab[j];
+    typename UnaryReturn<T, Fn>::Type_t dd = forEach(s1, EvalLeaf1(i), OpCombine());
+
+    if (a->max ? toBool(dd > d.elem()) : toBool(dd < d.elem()))
+    {
+      d.elem() = dd;
+      best = i;
     }
   }
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
-
-  return d;
+  a->dest[myId] = d;
+  a->site[myId] = best;
 }
 
 
-//! OScalar = innerProductReal(multi1d<OLattice>,multi1d<OLattice>)
+//! The extremum of s1 over the sites of s on this node
 /*!
- * return  \sum_{multi1d} \sum_x(trace(adj(multi1d<source>)*multi1d<source>))
- *
- * Sum over the lattice
- * Allow a global sum that sums over all indices
+ * Returns the site of it, the first in the site table on a tie, or -1
+ * when s has no sites here. One threaded pass over the expression.
  */
-template<class T1, class T2>
-inline typename BinaryReturn<OLattice<T1>, OLattice<T2>, FnInnerProductReal>::Type_t
-innerProductReal(const multi1d< OLattice<T1> >& s1, const multi1d< OLattice<T2> >& s2)
+template<class RHS, class T, class Fn>
+int localExtremum(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s, bool max,
+      typename UnaryReturn<OLattice<T>, Fn>::Type_t& d)
 {
-  return innerProductReal(s1,s2,all);
+  multi1d<typename UnaryReturn<OLattice<T>, Fn>::Type_t> pdest(qdpNumThreads());
+  multi1d<int> psite(qdpNumThreads());
+  psite = -1;
+
+  ExtremumThreadArgs<RHS,T,Fn> args(s1, s.siteTable().slice(), max, pdest, psite);
+  dispatch_to_threads(s.numSiteTable(), args, extremumKernel<RHS,T,Fn>);
+
+  // Combine in thread order so ties go to the earliest site
+  int site = -1;
+  for(int thread=0; thread < pdest.size(); ++thread)
+  {
+    if (psite[thread] < 0)
+      continue;
+
+    if (site < 0 || (max ? toBool(pdest[thread].elem() > d.elem()) : toBool(pdest[thread].elem() < d.elem())))
+    {
+      d = pdest[thread];
+      site = psite[thread];
+    }
+  }
+
+  return site;
 }
 
 
 //-----------------------------------------------
 // Global max and min
-// NOTE: there are no subset version of these operations. It is very problematic
-// and QMP does not support them.
 //! OScalar = globalMax(OScalar)
 /*!
  * Find the maximum an object has across the lattice
@@ -1292,18 +1633,12 @@ globalMax(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnGlobalMax>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global max needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, 1);
 
   return d;
 }
@@ -1317,32 +1652,49 @@ globalMax(const QDPExpr<RHS,OScalar<T> >& s1)
 template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t
 globalMax(const QDPExpr<RHS,OLattice<T> >& s1)
+{
+  return globalMax(s1, all);
+}
+
+
+//! OScalar = globalMax(OLattice) under an explicit subset
+/*!
+ * Find the maximum an object has on the sites of a subset, in one
+ * threaded pass over the expression
+ */
+template<class RHS, class T>
+typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t
+globalMax(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnGlobalMax(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
-  // Loop always entered so unroll
-  d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());   // SINGLE NODE VERSION FOR NOW
+  zero_rep(d.elem());
+  localExtremum<RHS,T,FnGlobalMax>(s1, s, true, d);
 
-  const int vvol = Layout::vol();
-  for(int i=1; i < vvol; ++i) 
-  {
-    typename UnaryReturn<T, FnGlobalMax>::Type_t  dd = 
-      forEach(s1, EvalLeaf1(i), OpCombine());   // SINGLE NODE VERSION FOR NOW
+  prof.stop(prof_t0, s.numSiteTable());
 
-    if (toBool(dd > d.elem()))
-      d.elem() = dd;
-  }
+  return d;
+}
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+
+//! Largest value of OLattice on a subset and the global coordinate of its site
+/*!
+ * One threaded pass over the expression. On a tie the site first in
+ * the site table is taken. Only for fields of real numbers.
+ */
+template<class RHS, class T>
+SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t>
+argMax(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+{
+  SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMax>::Type_t> d;
+
+  zero_rep(d.value.elem());
+  int site = localExtremum<RHS,T,FnGlobalMax>(s1, s, true, d.value);
+  if (site >= 0)
+    d.coord = Layout::siteCoords(0, site);
 
   return d;
 }
@@ -1358,18 +1710,12 @@ globalMin(const QDPExpr<RHS,OScalar<T> >& s1)
 {
   typename UnaryReturn<OScalar<T>, FnGlobalMin>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   evaluate(d,OpAssign(),s1,all);   // since OScalar, no global min needed
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, 1);
 
   return d;
 }
@@ -1378,37 +1724,54 @@ globalMin(const QDPExpr<RHS,OScalar<T> >& s1)
 
 //! OScalar = globalMin(OLattice)
 /*!
- * Find the minimum of an object under a subset of the lattice
+ * Find the minimum an object has across the lattice
  */
 template<class RHS, class T>
 typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t
 globalMin(const QDPExpr<RHS,OLattice<T> >& s1)
+{
+  return globalMin(s1, all);
+}
+
+
+//! OScalar = globalMin(OLattice) under an explicit subset
+/*!
+ * Find the minimum an object has on the sites of a subset, in one
+ * threaded pass over the expression
+ */
+template<class RHS, class T>
+typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t
+globalMin(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
 {
   typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t  d;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnGlobalMin(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
-  // Loop always entered so unroll
-  d.elem() = forEach(s1, EvalLeaf1(0), OpCombine());   // SINGLE NODE VERSION FOR NOW
+  zero_rep(d.elem());
+  localExtremum<RHS,T,FnGlobalMin>(s1, s, false, d);
 
-  const int vvol = Layout::vol();
-  for(int i=1; i < vvol; ++i) 
-  {
-    typename UnaryReturn<T, FnGlobalMin>::Type_t  dd = 
-      forEach(s1, EvalLeaf1(i), OpCombine());   // SINGLE NODE VERSION FOR NOW
+  prof.stop(prof_t0, s.numSiteTable());
 
-    if (toBool(dd < d.elem()))
-      d.elem() = dd;
-  }
+  return d;
+}
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+
+//! Smallest value of OLattice on a subset and the global coordinate of its site
+/*!
+ * One threaded pass over the expression. On a tie the site first in
+ * the site table is taken. Only for fields of real numbers.
+ */
+template<class RHS, class T>
+SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t>
+argMin(const QDPExpr<RHS,OLattice<T> >& s1, const Subset& s)
+{
+  SiteValue<typename UnaryReturn<OLattice<T>, FnGlobalMin>::Type_t> d;
+
+  zero_rep(d.value.elem());
+  int site = localExtremum<RHS,T,FnGlobalMin>(s1, s, false, d.value);
+  if (site >= 0)
+    d.coord = Layout::siteCoords(0, site);
 
   return d;
 }
@@ -1439,10 +1802,8 @@ isnan(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsNan(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1452,11 +1813,7 @@ isnan(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1484,10 +1841,8 @@ isinf(const OLattice<T>& s1)
 {
   bool d = false;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsInf(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1497,11 +1852,7 @@ isinf(const OLattice<T>& s1)
 
   QDPInternal::globalOr(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1529,10 +1880,8 @@ isfinite(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsFinite(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1542,11 +1891,7 @@ isfinite(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1574,10 +1919,8 @@ isnormal(const OLattice<T>& s1)
 {
   bool d = true;
 
-#if defined(QDP_USE_PROFILING)   
   static QDPProfile_t prof(d, OpAssign(), FnIsNormal(), s1);
-  prof.time -= getClockTime();
-#endif
+  QDPTime_t prof_t0 = prof.start();
 
   const int vvol = Layout::vol();
   for(int i=0; i < vvol; ++i) 
@@ -1587,11 +1930,7 @@ isnormal(const OLattice<T>& s1)
 
   QDPInternal::globalAnd(d);
 
-#if defined(QDP_USE_PROFILING)   
-  prof.time += getClockTime();
-  prof.count++;
-  prof.print();
-#endif
+  prof.stop(prof_t0, all.numSiteTable());
 
   return d;
 }
@@ -1685,6 +2024,61 @@ pokeSite(OLattice<T1>& l, const OScalar<T1>& r, const multi1d<int>& coord)
 }
 
 
+//! Extract the elements at many sites
+/*! @ingroup group1
+  @param l  source to examine
+  @param coords  Nd lattice coordinates of each site to examine
+  @return single site objects of the same primitive type
+
+  The expression is evaluated only at the requested sites.
+  @relates QDPType */
+template<class RHS, class T1>
+multi1d< OScalar<T1> >
+peekSites(const QDPExpr<RHS,OLattice<T1> > & l, const multi1d< multi1d<int> >& coords)
+{
+  multi1d< OScalar<T1> > dest(coords.size());
+
+  for(int k=0; k < coords.size(); ++k)
+    dest[k].elem() = forEach(l, EvalLeaf1(Layout::linearSiteIndex(coords[k])), OpCombine());
+
+  return dest;
+}
+
+//! Extract the elements at many sites
+/*! @ingroup group1
+  @param l  source to examine
+  @param coords  Nd lattice coordinates of each site to examine
+  @return single site objects of the same primitive type
+  @relates QDPType */
+template<class T1>
+inline multi1d< OScalar<T1> >
+peekSites(const OLattice<T1>& l, const multi1d< multi1d<int> >& coords)
+{
+  return peekSites(PETE_identity(l), coords);
+}
+
+
+//! Insert elements at many sites
+/*! @ingroup group1
+  @param l  target to update
+  @param r  source to insert at each site
+  @param coords  Nd lattice coordinates where to insert
+  @return the updated target
+  @relates QDPType */
+template<class T1>
+OLattice<T1>&
+pokeSites(OLattice<T1>& l, const multi1d< OScalar<T1> >& r, const multi1d< multi1d<int> >& coords)
+{
+  if (r.size() != coords.size())
+    QDP_error_exit("pokeSites: %d values for %d sites", r.size(), coords.size());
+
+  for(int k=0; k < coords.size(); ++k)
+    l.elem(Layout::linearSiteIndex(coords[k])) = r[k].elem();
+
+  return l;
+}
+
+
 //! Copy data values from field src to array dest
 /*! @ingroup group1
   @param dest  target to update
@@ -1698,12 +2092,13 @@ QDP_extract(multi1d<OScalar<T> >& dest, const OLattice<T>& src, const Subset& s)
 {
   const int *tab = s.siteTable().slice();
 
-#pragma omp parallel for
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    dest[i].elem() = src.elem(i);
-  }
+  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+      for(int j=lo; j < hi; ++j)
+      {
+	int i = tab[j];
+	dest[i].elem() = src.elem(i);
+      }
+    });
 }
 
 //! Inserts data values from site array src.
@@ -1719,12 +2114,13 @@ QDP_insert(OLattice<T>& dest, const multi1d<OScalar<T> >& src, const Subset& s)
 {
   const int *tab = s.siteTable().slice();
 
-#pragma omp parallel for 
-  for(int j=0; j < s.numSiteTable(); ++j) 
-  {
-    int i = tab[j];
-    dest.elem(i) = src[i].elem();
-  }
+  dispatch_range(s, sizeof(T), [&](int lo, int hi, int myId) {
+      for(int j=lo; j < hi; ++j)
+      {
+	int i = tab[j];
+	dest.elem(i) = src[i].elem();
+      }
+    });
 }
 
 
@@ -1780,7 +2176,24 @@ struct ForEach<UnaryNode<FnMap, A>, EvalLeaf1, CTag>
 
 
 
+// Everything under a map is read at shifted sites
+template<class A, class CTag>
+struct ForEach<UnaryNode<FnMap, A>, DestAliasLeaf, CTag>
+{
+  typedef bool Type_t;
+  inline static
+  Type_t apply(const UnaryNode<FnMap, A> &expr, const DestAliasLeaf &f, 
+    const CTag &c) 
+  {
+    return ForEach<A, DestAliasLeaf, CTag>::apply(expr.child(), DestAliasLeaf(f.dest, true), c);
+  }
+};
+
+
 //-----------------------------------------------------------------------------
+// Forward declaration
+template<class T1> class MapHandle;
+
 //! General permutation map class for communications
 class Map
 {
@@ -1831,10 +2244,76 @@ public:
 	CreateLeaf<QDPExpr<T1,C1> >::make(l)));
     }
 
+  //! Shift of a field stored on a subset
+  /*! Its sites are read through the site positions, see OSubLattice */
+  template<class T1,class C1>
+  inline typename MakeReturn<UnaryNode<FnMap,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>, C1>::Expression_t
+  operator()(const QDPSubType<T1,C1> & l)
+    {
+      typedef UnaryNode<FnMap,
+	typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t> Tree_t;
+      return MakeReturn<Tree_t,C1>::make(Tree_t(FnMap(goffsets.slice()),
+	CreateLeaf<QDPSubType<T1,C1> >::make(l)));
+    }
+
+  //! Shift read only on a subset
+  /*! Nothing is communicated here, so it is the plain shift */
+  template<class T1,class C1>
+  inline typename MakeReturn<UnaryNode<FnMap,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>, C1>::Expression_t
+  operator()(const QDPType<T1,C1> & l, const Subset& s)
+    {
+      return operator()(l);
+    }
+
+  template<class T1,class C1>
+  inline typename MakeReturn<UnaryNode<FnMap,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>, C1>::Expression_t
+  operator()(const QDPExpr<T1,C1> & l, const Subset& s)
+    {
+      return operator()(l);
+    }
+
 
 public:
   //! Accessor to offsets
   const multi1d<int>& Offsets() const {return goffsets;}
+  const multi1d<int>& goffset() const {return goffsets;}
+
+  //! Receive buffer index per site - empty, there is no face on a single node
+  const multi1d<int>& roffset() const {static const multi1d<int> none; return none;}
+
+  //! Release persistent communication resources
+  /*! Nothing to release on a single node */
+  void freeComms() {}
+
+  //! Start a split-phase map of a lattice field
+  /*! On a single node there is nothing in flight; see the parallel version */
+  template<class T1>
+  MapHandle<T1> start(const OLattice<T1>& l) {return MapHandle<T1>(*this, l);}
+
+  //! Sites of s whose mapped source lives on this node - all of them
+  const Subset& interior(const Subset& s) {return s;}
+
+  //! Sites of s whose mapped source comes from another node - none
+  const Subset& boundary(const Subset& s);
+
+  //! The map for destinations in s only - this one, having no face
+  Map& restricted(const Subset& s) {return *this;}
+
+  //! dest(x) = src(x+offsets) for a record of bytes bytes at each site
+  /*! E.g. all the vectors of a site of a LatticeBlock, see qdp_multirhs.h */
+  void shiftRecords(void* dest, const void* src, size_t bytes);
+
+  //! dest(x) = src(x+offsets) for x in ds, with dest and src stored on subsets
+  /*!
+   * Site i of dest is record dpos[i] and site k of src is record
+   * spos[k] of its nsrc records, see OSubLattice. Every x of ds must
+   * take its source from the subset of src.
+   */
+  void shiftCompact(void* dest, const Subset& ds, const int* dpos,
+		    const void* src, const int* spos, int nsrc, size_t bytes);
 
 private:
   //! Hide copy constructor
@@ -1846,6 +2325,58 @@ private:
 private:
   //! Offset table used for communications. 
   multi1d<int> goffsets;
+
+  template<class T1> friend class MapHandle;
+};
+
+
+//! Handle for a split-phase map started with Map::start
+/*! On a single node all sites are interior and nothing is in flight */
+template<class T1>
+class MapHandle
+{
+public:
+  MapHandle(Map& m, const OLattice<T1>& l) : map(&m), src(&l) {}
+
+  //! Fill dest on the interior sites - here the whole lattice
+  void copyInterior(OLattice<T1>& dest) const
+    {
+      GatherThreadArgs<T1> args(writable(dest).getF(), 0, src->getF(), map->goffsets.slice(), all.traversalTable().slice());
+      dispatch_to_threads(all.numSiteTable(), args, gatherKernel<T1>);
+    }
+
+  //! Fill dest on the boundary sites - there are none
+  void finishBoundary(OLattice<T1>& dest) {}
+
+  //! Wait on the messages - there are none
+  void wait() {}
+
+  //! Site i of the mapped field
+  inline const T1& elem(int i) const {return src->elem(map->goffsets[i]);}
+
+  //! The received face - none on a single node
+  const T1* face() const {return 0;}
+
+  //! Fill all of dest
+  void finish(OLattice<T1>& dest) {copyInterior(dest);}
+
+  //! Return the mapped field
+  OLattice<T1> finish()
+    {
+      OLattice<T1> d;
+      finish(d);
+      return d;
+    }
+
+  //! Sites of s that need no off-node data
+  const Subset& interior(const Subset& s = all) const {return map->interior(s);}
+
+  //! Sites of s that need off-node data
+  const Subset& boundary(const Subset& s = all) const {return map->boundary(s);}
+
+private:
+  Map* map;
+  const OLattice<T1>* src;
 };
 
 
@@ -1901,6 +2432,18 @@ public:
     }
 
 
+  //! Start a split-phase map - see Map::start
+  template<class T1>
+  MapHandle<T1>
+  start(const OLattice<T1> & l, int dir)
+    {
+      return mapsa[dir].start(l);
+    }
+
+  //! Release persistent communication resources
+  /*! Nothing to release on a single node */
+  void freeComms() {}
+
 private:
   //! Hide copy constructor
   ArrayMap(const ArrayMap&) {}
@@ -1966,6 +2509,18 @@ public:
     }
 
 
+  //! Start a split-phase map - see Map::start
+  template<class T1>
+  MapHandle<T1>
+  start(const OLattice<T1> & l, int isign)
+    {
+      return bimaps[(isign+1)>>1].start(l);
+    }
+
+  //! Release persistent communication resources
+  /*! Nothing to release on a single node */
+  void freeComms() {}
+
 private:
   //! Hide copy constructor
   BiDirectionalMap(const BiDirectionalMap&) {}
@@ -2030,6 +2585,103 @@ public:
 	CreateLeaf<QDPExpr<T1,C1> >::make(l)));
     }
 
+  template<class T1,class C1>
+  inline typename MakeReturn<UnaryNode<FnMap,
+    typename CreateLeaf<QDPSubType<T1,C1> >::Leaf_t>, C1>::Expression_t
+  operator()(const QDPSubType<T1,C1> & l, int isign, int dir)
+    {
+      return bimapsa((isign+1)>>1,dir)(l);
+    }
+
+  //! map(source,isign,dir) read only on a subset
+  /*! Nothing is communicated here, so it is the plain shift */
+  template<class T1,class C1>
+  inline typename MakeReturn<UnaryNode<FnMap,
+    typename CreateLeaf<QDPType<T1,C1> >::Leaf_t>, C1>::Expression_t
+  operator()(const QDPType<T1,C1> & l, int isign, int dir, const Subset& s)
+    {
+      return operator()(l, isign, dir);
+    }
+
+  template<class T1,class C1>
+  inline typename MakeReturn<UnaryNode<FnMap,
+    typename CreateLeaf<QDPExpr<T1,C1> >::Leaf_t>, C1>::Expression_t
+  operator()(const QDPExpr<T1,C1> & l, int isign, int dir, const Subset& s)
+    {
+      return operator()(l, isign, dir);
+    }
+
+  //! map(source,isign,dir) applied k times, as a single exchange
+  /*! 
+   * shift(psi,FORWARD,mu,3) is psi(x+3mu) with one message of the 3
+   * deep face in place of three nearest neighbor shifts. The map is
+   * kept per (direction, k), see distanceMap.
+   */
+  template<class T1>
+  inline auto operator()(const T1& l, int isign, int dir, int k)
+    -> decltype(std::declval<Map&>()(l))
+    {
+      return distanceMap(isign, dir, k)(l);
+    }
+
+
+  //! Start a split-phase map - see Map::start
+  template<class T1>
+  MapHandle<T1>
+  start(const OLattice<T1> & l, int isign, int dir)
+    {
+      return bimapsa((isign+1)>>1,dir).start(l);
+    }
+
+  //! The map used for map(source,isign,dir)
+  Map& getMap(int isign, int dir) {return bimapsa((isign+1)>>1,dir);}
+
+  //! y_k = map(x_k,isign,dir) for every vector k of a block
+  /*! The vectors of a site move together, see Map::shiftRecords */
+  template<class T1>
+  void operator()(LatticeBlock<T1>& y, const LatticeBlock<T1>& x, int isign, int dir)
+    {
+      if (y.numRHS() != x.numRHS() || &y == &x)
+	QDP_error_exit("shift: blocks of %d and %d vectors, or in place", y.numRHS(), x.numRHS());
+
+      getMap(isign,dir).shiftRecords(y.getF(), x.getF(), x.numRHS()*sizeof(T1));
+    }
+
+  //! d = map(s,isign,dir) on the subset of d, both stored on their subsets
+  /*! 
+   * E.g. the even sites of a shifted odd field, with no full lattice
+   * field in between. The sources of the sites of d must be in the
+   * subset of s.
+   */
+  template<class T1>
+  void operator()(OSubLattice<T1>& d, const OSubLattice<T1>& s, int isign, int dir)
+    {
+      if (! d.getOwnsMemory() || ! s.getOwnsMemory() || &d == &s)
+	QDP_error_exit("shift: compact fields needed, not in place");
+
+      getMap(isign,dir).shiftCompact(d.getF(), d.subset(), d.sitePos(),
+				     s.getF(), s.sitePos(), s.subset().numSiteTable(), sizeof(T1));
+    }
+
+  //! Map source in every direction and sign
+  /*!
+   * dest((isign+1)>>1,dir) = map(l,isign,dir)
+   *
+   * There is nothing to batch on a single node; see the parallel version
+   */
+  template<class T1>
+  void all(multi2d< OLattice<T1> >& dest, const OLattice<T1>& l)
+    {
+      dest.resize(bimapsa.size2(), bimapsa.size1());
+
+      for(int i=0; i < bimapsa.size2(); ++i)
+	for(int j=0; j < bimapsa.size1(); ++j)
+	  dest(i,j) = bimapsa(i,j)(l);
+    }
+
+  //! Release persistent communication resources
+  /*! Nothing to release on a single node */
+  void freeComms() {}
 
 private:
   //! Hide copy constructor
@@ -2114,13 +2766,15 @@ void write(BinaryWriter& bin, const OLattice<T>& d)
 //! Binary output
 /*! Assumes no inner grid */
 template<class T>  
-void write(BinaryWriter& bin, OSubLattice<T> dd)
+void write(BinaryWriter& bin, const OSubLattice<T>& dd)
 {
   // Single node code
   const Subset& sub = dd.subset();
   const Set& set    = sub.getSet();
 
-  const OLattice<T>& d = dd.field();
+  // The storage of a compact field is indexed by the position of the site
+  const T* F = dd.getF();
+  const int* pos = dd.sitePos();
 
   const multi1d<int>& lat_color = set.latticeColoring();
   const int color = sub.color();
@@ -2132,7 +2786,7 @@ void write(BinaryWriter& bin, OSubLattice<T> dd)
     int i = Layout::linearSiteIndex(site);
     if (lat_color[i] == color)
     {
-      bin.writeArray((const char*)&(d.elem(i)), 
+      bin.writeArray((const char*)&(F[pos ? pos[i] : i]), 
 		     sizeof(typename WordType<T>::Type_t), 
 		     sizeof(T) / sizeof(typename WordType<T>::Type_t));
     }
@@ -2189,13 +2843,14 @@ void read(BinaryReader& bin, OLattice<T>& d, const multi1d<int>& coord)
 //! Binary input
 /*! Assumes no inner grid */
 template<class T>  
-void read(BinaryReader& bin, OSubLattice<T> dd)
+void read(BinaryReader& bin, const OSubLattice<T>& dd)
 {
   // Single node code
   const Subset& sub = dd.subset();
   const Set& set    = sub.getSet();
 
-  OLattice<T>& d = dd.field();
+  T* F = dd.getF();
+  const int* pos = dd.sitePos();
 
   const multi1d<int>& lat_color = set.latticeColoring();
   const int color = sub.color();
@@ -2207,7 +2862,7 @@ void read(BinaryReader& bin, OSubLattice<T> dd)
     int i = Layout::linearSiteIndex(site);
     if (lat_color[i] == color)
     {
-      bin.readArray((char*)&(d.elem(i)), 
+      bin.readArray((char*)&(F[pos ? pos[i] : i]), 
 		    sizeof(typename WordType<T>::Type_t), 
 		    sizeof(T) / sizeof(typename WordType<T>::Type_t));
     }
@@ -431,6 +431,15 @@ typedef OLattice< PSpinMatrix < PColorMatrix< PSpinMatrix< PColorMatrix< RComple
 typedef OScalar< PSpinMatrix < PColorMatrix< PSpinMatrix< PColorMatrix< RComplex<REAL64>, Nc>, (Ns>>1) >, Nc>, (Ns>>1) > > HalfFourquarkD;
 typedef OLattice< PSpinMatrix < PColorMatrix< PSpinMatrix< PColorMatrix< RComplex<REAL64>, Nc>, (Ns>>1) >, Nc>, (Ns>>1) > > LatticeHalfFourquarkD;
 
+// REAL16 storage types, read as their REAL32 versions
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, Nc>, Ns> > LatticeFermionH;
+typedef OLattice< PSpinVector< PColorVector< RComplex<REAL16>, Nc>, 1> > LatticeStaggeredFermionH;
+typedef OLattice< PSpinMatrix< PColorMatrix< RComplex<REAL16>, Nc>, Ns> > LatticePropagatorH;
+typedef OLattice< PScalar< PColorMatrix< RComplex<REAL16>, Nc> > > LatticeColorMatrixH;
+typedef OLattice< PScalar< PColorVector< RComplex<REAL16>, Nc> > > LatticeColorVectorH;
+typedef OLattice< PScalar< PScalar< RComplex<REAL16> > > > LatticeComplexH;
+typedef OLattice< PScalar< PScalar< RScalar<REAL16> > > > LatticeRealH;
+
 // Equivalent names
 typedef Integer  Int;
 
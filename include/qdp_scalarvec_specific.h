@@ -945,7 +945,16 @@ public:
       }
 
 #else
-#error "Map: this inner grid length is not supported - easy to fix"
+      // Any other inner grid length, lane by lane
+      const int vvol = Layout::sitesOnNode();
+      for(int i=0; i < vvol; ++i) 
+      {
+	int ii = i >> INNER_LOG;
+	int o  = goffsets[i] >> INNER_LOG;
+	int k  = goffsets[i] & (INNER_LEN - 1);
+
+	copy_site(d.elem(ii), i & (INNER_LEN - 1), getSite(l.elem(o), k));
+      }
 #endif
 
 #if QDP_DEBUG >= 3
@@ -1259,6 +1268,19 @@ public:
       return bimapsa((isign+1)>>1,dir)(l);
     }
 
+  //! map(source,isign,dir) applied k times, as a single exchange
+  /*! 
+   * shift(psi,FORWARD,mu,3) is psi(x+3mu) with one message of the 3
+   * deep face in place of three nearest neighbor shifts. The map is
+   * kept per (direction, k), see distanceMap.
+   */
+  template<class T1>
+  inline auto operator()(const T1& l, int isign, int dir, int k)
+    -> decltype(std::declval<Map&>()(l))
+    {
+      return distanceMap(isign, dir, k)(l);
+    }
+
 
 private:
   //! Hide copy constructor
@@ -26,9 +26,8 @@ namespace QDP {
 //! Gamma matrices are conveniently defined for this Ns
 typedef GammaType<Ns> Gamma;
 
-// For now, fix this inner-grid length to 4 or 2 depending on base precision. 
-// This causes problems for doubles which I eventually must work out.
-// Here, INNER_LOG is the log_2(INNER)
+// The inner-grid length fills a vector of QDP_SIMD_BITS with REAL words,
+// see qdp_precision.h. Here, INNER_LOG is the log_2(INNER)
 #define INNER_LEN (1 << INNER_LOG)
 
 // Aliases for a scalarvec-like architecture
@@ -0,0 +1,115 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Lane loops of complex inner-grid arithmetic
+ *
+ * The generic RComplex operations on an ILattice build each of the real
+ * and imaginary parts from whole ILattice temporaries. The versions here
+ * do a complex add, multiply or multiply-add as one loop over the lanes,
+ * which the compiler turns into vector code of the width INNER_LEN was
+ * chosen for (QDP_SIMD_BITS), be it AVX, AVX-512 or fixed length SVE.
+ * PColorMatrix*PColorVector is built on the multiply-add so it becomes
+ * fused multiply-adds of full vectors.
+ *
+ * Not used when the SSE specialisation of ILattice is in place.
+ */
+
+#ifndef QDP_SCALARVECSITE_SIMD_H
+#define QDP_SCALARVECSITE_SIMD_H
+
+namespace QDP {
+
+#if defined(_OPENMP)
+#define QDP_SIMD_LOOP _Pragma("omp simd")
+#else
+#define QDP_SIMD_LOOP
+#endif
+
+//! d = l + r on the lanes
+template<class T, int N>
+inline void cadd(RComplex< ILattice<T,N> >& d,
+		 const RComplex< ILattice<T,N> >& l, const RComplex< ILattice<T,N> >& r)
+{
+  QDP_SIMD_LOOP
+  for(int i=0; i < N; ++i)
+  {
+    d.real().elem(i) = l.real().elem(i) + r.real().elem(i);
+    d.imag().elem(i) = l.imag().elem(i) + r.imag().elem(i);
+  }
+}
+
+//! d = l * r on the lanes
+template<class T, int N>
+inline void cmul(RComplex< ILattice<T,N> >& d,
+		 const RComplex< ILattice<T,N> >& l, const RComplex< ILattice<T,N> >& r)
+{
+  QDP_SIMD_LOOP
+  for(int i=0; i < N; ++i)
+  {
+    const T lr = l.real().elem(i), li = l.imag().elem(i);
+    const T rr = r.real().elem(i), ri = r.imag().elem(i);
+    d.real().elem(i) = lr*rr - li*ri;
+    d.imag().elem(i) = lr*ri + li*rr;
+  }
+}
+
+//! d += l * r on the lanes
+template<class T, int N>
+inline void cmadd(RComplex< ILattice<T,N> >& d,
+		  const RComplex< ILattice<T,N> >& l, const RComplex< ILattice<T,N> >& r)
+{
+  QDP_SIMD_LOOP
+  for(int i=0; i < N; ++i)
+  {
+    const T lr = l.real().elem(i), li = l.imag().elem(i);
+    const T rr = r.real().elem(i), ri = r.imag().elem(i);
+    d.real().elem(i) += lr*rr - li*ri;
+    d.imag().elem(i) += lr*ri + li*rr;
+  }
+}
+
+
+//! RComplex = RComplex + RComplex on the inner grid
+template<class T, int N>
+inline RComplex< ILattice<T,N> >
+operator+(const RComplex< ILattice<T,N> >& l, const RComplex< ILattice<T,N> >& r)
+{
+  RComplex< ILattice<T,N> > d;
+  cadd(d, l, r);
+  return d;
+}
+
+//! RComplex = RComplex * RComplex on the inner grid
+template<class T, int N>
+inline RComplex< ILattice<T,N> >
+operator*(const RComplex< ILattice<T,N> >& l, const RComplex< ILattice<T,N> >& r)
+{
+  RComplex< ILattice<T,N> > d;
+  cmul(d, l, r);
+  return d;
+}
+
+
+//! PColorVector = PColorMatrix * PColorVector on the inner grid
+template<class T, int N, int Nc>
+inline PColorVector<RComplex< ILattice<T,N> >, Nc>
+operator*(const PColorMatrix<RComplex< ILattice<T,N> >, Nc>& l,
+	  const PColorVector<RComplex< ILattice<T,N> >, Nc>& r)
+{
+  PColorVector<RComplex< ILattice<T,N> >, Nc> d;
+
+  for(int i=0; i < Nc; ++i)
+  {
+    cmul(d.elem(i), l.elem(i,0), r.elem(0));
+    for(int j=1; j < Nc; ++j)
+      cmadd(d.elem(i), l.elem(i,j), r.elem(j));
+  }
+
+  return d;
+}
+
+#undef QDP_SIMD_LOOP
+
+} // namespace QDP
+
+#endif
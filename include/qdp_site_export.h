@@ -0,0 +1,214 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Bulk copies of lattice fields to and from buffers in a foreign layout
+ */
+
+#ifndef QDP_SITE_EXPORT_H
+#define QDP_SITE_EXPORT_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group1
+   *  @{
+   */
+
+  //! The layout of a buffer shared with an external library
+  /*!
+   * Slot j of the buffer holds the site on this node with linear index
+   * site(j). With a vector length N of one the words of a slot are
+   * contiguous, as in OLattice. With N > 1 slots are cut into blocks of
+   * N, and within a block word k of all N slots is contiguous:
+   *
+   *   word(j,k) = buf[(j/N)*Words*N + k*N + j%N]
+   *
+   * which is the structure of arrays layout of SoAField.
+   *
+   *   SiteOrder eo = SiteOrder::evenOdd();
+   *   std::vector<REAL> buf(eo.numWords(sizeof(LatticeColorMatrix::Subtype_t)/sizeof(REAL)));
+   *   QDP_extract(&buf[0], u[0], eo);
+   *   ... external solver ...
+   *   QDP_insert(u[0], &buf[0], eo);
+   */
+  class SiteOrder
+  {
+  public:
+    //! The sites of the node lex ordered within the subgrid, x fastest
+    static SiteOrder lexico(int veclen = 1);
+
+    //! The even sites lex ordered within the subgrid, then the odd ones
+    static SiteOrder evenOdd(int veclen = 1);
+
+    //! The sites of subset s in the order of its site table
+    static SiteOrder subset(const Subset& s, int veclen = 1);
+
+    //! Slot j holds the site with linear index sites[j]
+    SiteOrder(const multi1d<int>& sites, int veclen = 1);
+
+    //! Number of slots
+    int numSlots() const {return slots.size();}
+
+    //! Linear index of the site in slot j
+    int site(int j) const {return slots[j];}
+
+    //! Linear index of the site in every slot
+    const int* slotTable() const {return &slots[0];}
+
+    //! Vector length
+    int vectorLength() const {return veclen;}
+
+    //! Words the buffer needs for sites of Words words, tail block included
+    size_t numWords(int words) const
+      {
+	return size_t((numSlots() + veclen - 1) / veclen) * veclen * words;
+      }
+
+  private:
+    SiteOrder(std::vector<int>& s, int n);
+
+    std::vector<int> slots;
+    int veclen;
+  };
+
+
+  namespace SiteExport
+  {
+    //! user argument for the copies
+    template<class T, class W>
+    struct CopyArgs
+    {
+      CopyArgs(T* l_, W* buf_, const int* slots_, int nslots_, int veclen_) :
+	l(l_), buf(buf_), slots(slots_), nslots(nslots_), veclen(veclen_) {}
+
+      T* l;
+      W* buf;
+      const int* slots;
+      int nslots;
+      int veclen;
+    };
+
+    //! user function for copies out, over slots or blocks of slots
+    template<class T, class W>
+    void extractKernel(int lo, int hi, int myId, CopyArgs<T,W>* a)
+    {
+      const int Words = sizeof(T)/sizeof(W);
+      const int N = a->veclen;
+
+      if (N == 1)
+      {
+	for(int j=lo; j < hi; ++j)
+	{
+	  const W* w = (const W*)&(a->l[a->slots[j]]);
+	  W* v = a->buf + size_t(j)*Words;
+	  for(int k=0; k < Words; ++k)
+	    v[k] = w[k];
+	}
+	return;
+      }
+
+      for(int b=lo; b < hi; ++b)
+      {
+	W* v = a->buf + size_t(b)*Words*N;
+
+	for(int lane=0; lane < N; ++lane)
+	{
+	  const int j = b*N + lane;
+	  if (j >= a->nslots)
+	  {
+	    for(int k=0; k < Words; ++k)
+	      v[k*N + lane] = W(0);
+	    continue;
+	  }
+
+	  const W* w = (const W*)&(a->l[a->slots[j]]);
+	  for(int k=0; k < Words; ++k)
+	    v[k*N + lane] = w[k];
+	}
+      }
+    }
+
+    //! user function for copies in, over slots or blocks of slots
+    template<class T, class W>
+    void insertKernel(int lo, int hi, int myId, CopyArgs<T,W>* a)
+    {
+      const int Words = sizeof(T)/sizeof(W);
+      const int N = a->veclen;
+
+      if (N == 1)
+      {
+	for(int j=lo; j < hi; ++j)
+	{
+	  W* w = (W*)&(a->l[a->slots[j]]);
+	  const W* v = a->buf + size_t(j)*Words;
+	  for(int k=0; k < Words; ++k)
+	    w[k] = v[k];
+	}
+	return;
+      }
+
+      for(int b=lo; b < hi; ++b)
+      {
+	const W* v = a->buf + size_t(b)*Words*N;
+
+	for(int lane=0; lane < N; ++lane)
+	{
+	  const int j = b*N + lane;
+	  if (j >= a->nslots)
+	    break;
+
+	  W* w = (W*)&(a->l[a->slots[j]]);
+	  for(int k=0; k < Words; ++k)
+	    w[k] = v[k*N + lane];
+	}
+      }
+    }
+  }
+
+
+  //! Copy the sites of src into the buffer dest laid out by order
+  /*!
+   * dest needs order.numWords(Words) words of the floating type of T.
+   * The threads split the buffer, so each writes one contiguous stretch
+   * and reads the sites of src in whatever order the layout asks for.
+   */
+  template<class T>
+  void QDP_extract(typename WordType<T>::Type_t* dest, const OLattice<T>& src, const SiteOrder& order)
+  {
+    typedef typename WordType<T>::Type_t W;
+
+    const int N = order.vectorLength();
+    const int n = (N == 1) ? order.numSlots() : (order.numSlots() + N - 1) / N;
+    if (order.numSlots() == 0)
+      return;
+
+    SiteExport::CopyArgs<T,W> a(const_cast<T*>(src.getF()), dest, order.slotTable(),
+				order.numSlots(), N);
+    dispatch_to_threads(n, a, SiteExport::extractKernel<T,W>);
+  }
+
+
+  //! Copy the buffer src laid out by order into the sites of dest
+  /*! Sites of dest outside the layout are left alone */
+  template<class T>
+  void QDP_insert(OLattice<T>& dest, const typename WordType<T>::Type_t* src, const SiteOrder& order)
+  {
+    typedef typename WordType<T>::Type_t W;
+
+    const int N = order.vectorLength();
+    const int n = (N == 1) ? order.numSlots() : (order.numSlots() + N - 1) / N;
+    if (order.numSlots() == 0)
+      return;
+
+    SiteExport::CopyArgs<T,W> a(writable(dest).getF(), const_cast<W*>(src), order.slotTable(),
+				order.numSlots(), N);
+    dispatch_to_threads(n, a, SiteExport::insertKernel<T,W>);
+  }
+
+  /** @} */ // end of group1
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,97 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Threaded copies of lattice sites between full and compact storage
+ *
+ * Compact OSubLattice storage holds the sites of a subset in site table
+ * order. Going to and from a full field follows the runs of consecutive
+ * sites when the subset has them, one block copy per run, and the site
+ * table otherwise.
+ */
+
+#ifndef QDP_SITECOPY_H
+#define QDP_SITECOPY_H
+
+#include <cstring>
+
+namespace QDP
+{
+  namespace SiteCopy
+  {
+    //! Copy n sites from s to d, which do not overlap
+    template<class T>
+    inline void block(T* d, const T* s, int n)
+    {
+      std::memcpy((void*)d, (const void*)s, size_t(n)*sizeof(T));
+    }
+  }
+
+
+  //! d[j] = s[j] for the n sites of contiguous storage
+  template<class T>
+  void copySites(T* d, const T* s, int n)
+  {
+    if (d == s || n <= 0)
+      return;
+
+    dispatch_range(n, [&](int lo, int hi, int myId) {
+	SiteCopy::block(d + lo, s + lo, hi - lo);
+      });
+  }
+
+  //! d[j] = s[j] converting the sites of one type to another
+  template<class T, class T1>
+  void copySites(T* d, const T1* s, int n)
+  {
+    dispatch_range(n, [&](int lo, int hi, int myId) {
+	for(int j=lo; j < hi; ++j)
+	  d[j] = s[j];
+      });
+  }
+
+
+  //! d[j] = s[tab[j]] for the site table of ss: full storage into compact
+  template<class T>
+  void gatherSites(T* d, const T* s, const Subset& ss)
+  {
+    if (ss.hasRuns())
+    {
+      const SiteRun* runs = ss.runTable().slice();
+      dispatch_range(ss.numRuns(), [&](int lo, int hi, int myId) {
+	  for(int r=lo; r < hi; ++r)
+	    SiteCopy::block(d + runs[r].pos, s + runs[r].site, runs[r+1].pos - runs[r].pos);
+	});
+      return;
+    }
+
+    const int *tab = ss.siteTable().slice();
+    dispatch_range(ss, sizeof(T), [&](int lo, int hi, int myId) {
+	for(int j=lo; j < hi; ++j)
+	  d[j] = s[tab[j]];
+      });
+  }
+
+
+  //! d[tab[j]] = s[j] for the site table of ss: compact storage into full
+  template<class T>
+  void scatterSites(T* d, const T* s, const Subset& ss)
+  {
+    if (ss.hasRuns())
+    {
+      const SiteRun* runs = ss.runTable().slice();
+      dispatch_range(ss.numRuns(), [&](int lo, int hi, int myId) {
+	  for(int r=lo; r < hi; ++r)
+	    SiteCopy::block(d + runs[r].site, s + runs[r].pos, runs[r+1].pos - runs[r].pos);
+	});
+      return;
+    }
+
+    const int *tab = ss.siteTable().slice();
+    dispatch_range(ss, sizeof(T), [&](int lo, int hi, int myId) {
+	for(int j=lo; j < hi; ++j)
+	  d[tab[j]] = s[j];
+      });
+  }
+}
+
+#endif
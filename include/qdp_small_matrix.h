@@ -0,0 +1,525 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Inverses, determinants, eigensystems and square roots of the small matrix at each site
+ */
+
+#ifndef QDP_SMALL_MATRIX_H
+#define QDP_SMALL_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  namespace SmallMatrixInternal
+  {
+    //! An n x n complex matrix worked on in double precision
+    template<int N>
+    struct CMat
+    {
+      double re[N][N], im[N][N];
+    };
+
+    //! The site types seen as n x n matrices
+    template<class S>
+    struct Shape;
+
+    //! Colour matrices
+    template<class T, int N>
+    struct Shape< PScalar< PColorMatrix< RComplex<T>, N> > >
+    {
+      enum {n = N};
+      typedef PScalar< PColorMatrix< RComplex<T>, N> > S;
+      static RComplex<T>& at(S& s, int i, int j) {return s.elem().elem(i,j);}
+      static const RComplex<T>& at(const S& s, int i, int j) {return s.elem().elem(i,j);}
+    };
+
+    //! Spin matrices
+    template<class T, int N>
+    struct Shape< PSpinMatrix< PScalar< RComplex<T> >, N> >
+    {
+      enum {n = N};
+      typedef PSpinMatrix< PScalar< RComplex<T> >, N> S;
+      static RComplex<T>& at(S& s, int i, int j) {return s.elem(i,j).elem();}
+      static const RComplex<T>& at(const S& s, int i, int j) {return s.elem(i,j).elem();}
+    };
+
+    //! Spin-colour matrices, row spin*Nc + colour
+    template<class T, int C, int N>
+    struct Shape< PSpinMatrix< PColorMatrix< RComplex<T>, C>, N> >
+    {
+      enum {n = N*C};
+      typedef PSpinMatrix< PColorMatrix< RComplex<T>, C>, N> S;
+      static RComplex<T>& at(S& s, int i, int j) {return s.elem(i/C, j/C).elem(i%C, j%C);}
+      static const RComplex<T>& at(const S& s, int i, int j) {return s.elem(i/C, j/C).elem(i%C, j%C);}
+    };
+
+    //! a = the block of s of rows and columns off .. off+N-1
+    template<int N, class S>
+    inline void load(CMat<N>& a, const S& s, int off = 0)
+    {
+      for(int i=0; i < N; ++i)
+	for(int j=0; j < N; ++j)
+	{
+	  a.re[i][j] = Shape<S>::at(s, off+i, off+j).real();
+	  a.im[i][j] = Shape<S>::at(s, off+i, off+j).imag();
+	}
+    }
+
+    //! The block of s at off = a
+    template<int N, class S>
+    inline void store(S& s, const CMat<N>& a, int off = 0)
+    {
+      for(int i=0; i < N; ++i)
+	for(int j=0; j < N; ++j)
+	{
+	  Shape<S>::at(s, off+i, off+j).real() = a.re[i][j];
+	  Shape<S>::at(s, off+i, off+j).imag() = a.im[i][j];
+	}
+    }
+
+    //! a = a^{-1}, by Gauss-Jordan elimination with partial pivoting
+    /*! A singular a gives entries that are not finite */
+    template<int N>
+    inline void invert(CMat<N>& a)
+    {
+      int col[N];
+
+      for(int k=0; k < N; ++k)
+      {
+	// The largest pivot in column k
+	int p = k;
+	double big = -1;
+	for(int i=k; i < N; ++i)
+	{
+	  const double m = a.re[i][k]*a.re[i][k] + a.im[i][k]*a.im[i][k];
+	  if (m > big)
+	  {
+	    big = m;
+	    p = i;
+	  }
+	}
+	col[k] = p;
+	if (p != k)
+	  for(int j=0; j < N; ++j)
+	  {
+	    std::swap(a.re[k][j], a.re[p][j]);
+	    std::swap(a.im[k][j], a.im[p][j]);
+	  }
+
+	// Row k by 1/pivot, the pivot's place taking 1/pivot
+	const double pr = a.re[k][k] / big, pi = -a.im[k][k] / big;
+	a.re[k][k] = 1;
+	a.im[k][k] = 0;
+	for(int j=0; j < N; ++j)
+	{
+	  const double r = a.re[k][j];
+	  a.re[k][j] = r*pr - a.im[k][j]*pi;
+	  a.im[k][j] = r*pi + a.im[k][j]*pr;
+	}
+
+	// Column k out of the other rows
+	for(int i=0; i < N; ++i)
+	{
+	  if (i == k)
+	    continue;
+	  const double fr = a.re[i][k], fi = a.im[i][k];
+	  a.re[i][k] = 0;
+	  a.im[i][k] = 0;
+	  for(int j=0; j < N; ++j)
+	  {
+	    a.re[i][j] -= fr*a.re[k][j] - fi*a.im[k][j];
+	    a.im[i][j] -= fr*a.im[k][j] + fi*a.re[k][j];
+	  }
+	}
+      }
+
+      // Undo the row swaps as column swaps, last first
+      for(int k=N-1; k >= 0; --k)
+	if (col[k] != k)
+	  for(int i=0; i < N; ++i)
+	  {
+	    std::swap(a.re[i][k], a.re[i][col[k]]);
+	    std::swap(a.im[i][k], a.im[i][col[k]]);
+	  }
+    }
+
+    //! The determinant of a, by LU decomposition with partial pivoting
+    template<int N>
+    inline std::complex<double> det(CMat<N> a)
+    {
+      std::complex<double> d(1, 0);
+
+      for(int k=0; k < N; ++k)
+      {
+	int p = k;
+	double big = -1;
+	for(int i=k; i < N; ++i)
+	{
+	  const double m = a.re[i][k]*a.re[i][k] + a.im[i][k]*a.im[i][k];
+	  if (m > big)
+	  {
+	    big = m;
+	    p = i;
+	  }
+	}
+	if (big == 0)
+	  return std::complex<double>(0, 0);
+	if (p != k)
+	{
+	  d = -d;
+	  for(int j=k; j < N; ++j)
+	  {
+	    std::swap(a.re[k][j], a.re[p][j]);
+	    std::swap(a.im[k][j], a.im[p][j]);
+	  }
+	}
+
+	const std::complex<double> piv(a.re[k][k], a.im[k][k]);
+	d *= piv;
+
+	for(int i=k+1; i < N; ++i)
+	{
+	  const std::complex<double> f = std::complex<double>(a.re[i][k], a.im[i][k]) / piv;
+	  for(int j=k+1; j < N; ++j)
+	  {
+	    a.re[i][j] -= f.real()*a.re[k][j] - f.imag()*a.im[k][j];
+	    a.im[i][j] -= f.real()*a.im[k][j] + f.imag()*a.re[k][j];
+	  }
+	}
+      }
+
+      return d;
+    }
+
+    //! The eigenvalues lambda, ascending, and eigenvectors, the columns of v, of hermitian a
+    /*!
+     * Cyclic Jacobi: each rotation takes the phase off a(p,q) and then
+     * zeroes it as for a real symmetric matrix. It is accurate for
+     * close and equal eigenvalues, where the closed forms for 3x3 are
+     * not, and needs about five sweeps.
+     */
+    template<int N>
+    inline void eigenHermitian(double lambda[N], CMat<N>& v, CMat<N> a)
+    {
+      for(int i=0; i < N; ++i)
+	for(int j=0; j < N; ++j)
+	{
+	  v.re[i][j] = (i == j) ? 1 : 0;
+	  v.im[i][j] = 0;
+	}
+
+      for(int sweep=0; sweep < 50; ++sweep)
+      {
+	double off = 0, diag = 0;
+	for(int i=0; i < N; ++i)
+	{
+	  diag += a.re[i][i]*a.re[i][i];
+	  for(int j=i+1; j < N; ++j)
+	    off += a.re[i][j]*a.re[i][j] + a.im[i][j]*a.im[i][j];
+	}
+	if (off <= 1.0e-32*diag || off == 0)
+	  break;
+
+	for(int p=0; p < N-1; ++p)
+	  for(int q=p+1; q < N; ++q)
+	  {
+	    const double b = std::sqrt(a.re[p][q]*a.re[p][q] + a.im[p][q]*a.im[p][q]);
+	    if (b == 0)
+	      continue;
+
+	    // a(p,q) = b e^{i phi}
+	    const double er = a.re[p][q] / b, ei = a.im[p][q] / b;
+
+	    const double zeta = (a.re[q][q] - a.re[p][p]) / (2*b);
+	    const double t = ((zeta >= 0) ? 1 : -1) / (std::fabs(zeta) + std::sqrt(1 + zeta*zeta));
+	    const double c = 1 / std::sqrt(1 + t*t);
+	    const double s = t*c;
+
+	    // a <- a U, v <- v U with U = [[c, s], [-s e^{-i phi}, c e^{-i phi}]] on p, q
+	    for(int i=0; i < N; ++i)
+	    {
+	      const double qr = a.re[i][q]*er + a.im[i][q]*ei;    // a(i,q) e^{-i phi}
+	      const double qi = a.im[i][q]*er - a.re[i][q]*ei;
+	      const double pr = a.re[i][p], pi = a.im[i][p];
+	      a.re[i][p] = c*pr - s*qr;
+	      a.im[i][p] = c*pi - s*qi;
+	      a.re[i][q] = s*pr + c*qr;
+	      a.im[i][q] = s*pi + c*qi;
+
+	      const double vr = v.re[i][q]*er + v.im[i][q]*ei;
+	      const double vi = v.im[i][q]*er - v.re[i][q]*ei;
+	      const double wr = v.re[i][p], wi = v.im[i][p];
+	      v.re[i][p] = c*wr - s*vr;
+	      v.im[i][p] = c*wi - s*vi;
+	      v.re[i][q] = s*wr + c*vr;
+	      v.im[i][q] = s*wi + c*vi;
+	    }
+
+	    // a <- U^dag a
+	    for(int j=0; j < N; ++j)
+	    {
+	      const double qr = a.re[q][j]*er - a.im[q][j]*ei;    // e^{i phi} a(q,j)
+	      const double qi = a.im[q][j]*er + a.re[q][j]*ei;
+	      const double pr = a.re[p][j], pi = a.im[p][j];
+	      a.re[p][j] = c*pr - s*qr;
+	      a.im[p][j] = c*pi - s*qi;
+	      a.re[q][j] = s*pr + c*qr;
+	      a.im[q][j] = s*pi + c*qi;
+	    }
+
+	    a.re[p][q] = a.im[p][q] = a.re[q][p] = a.im[q][p] = 0;
+	    a.im[p][p] = a.im[q][q] = 0;
+	  }
+      }
+
+      for(int i=0; i < N; ++i)
+	lambda[i] = a.re[i][i];
+
+      // Ascending, by selection
+      for(int i=0; i < N-1; ++i)
+      {
+	int k = i;
+	for(int j=i+1; j < N; ++j)
+	  if (lambda[j] < lambda[k])
+	    k = j;
+	if (k == i)
+	  continue;
+
+	std::swap(lambda[i], lambda[k]);
+	for(int r=0; r < N; ++r)
+	{
+	  std::swap(v.re[r][i], v.re[r][k]);
+	  std::swap(v.im[r][i], v.im[r][k]);
+	}
+      }
+    }
+
+    //! a = a^{1/2} for hermitian non-negative a, negative eigenvalues taken as 0
+    template<int N>
+    inline void sqrtHermitian(CMat<N>& a)
+    {
+      double lambda[N];
+      CMat<N> v;
+      eigenHermitian(lambda, v, a);
+
+      for(int k=0; k < N; ++k)
+	lambda[k] = std::sqrt(std::max(lambda[k], 0.0));
+
+      // v diag(sqrt(lambda)) v^dag
+      for(int i=0; i < N; ++i)
+	for(int j=0; j < N; ++j)
+	{
+	  double r = 0, s = 0;
+	  for(int k=0; k < N; ++k)
+	  {
+	    r += lambda[k]*(v.re[i][k]*v.re[j][k] + v.im[i][k]*v.im[j][k]);
+	    s += lambda[k]*(v.im[i][k]*v.re[j][k] - v.re[i][k]*v.im[j][k]);
+	  }
+	  a.re[i][j] = r;
+	  a.im[i][j] = s;
+	}
+    }
+
+
+    //! dest = src^{-1}
+    struct OpInverse
+    {
+      template<class S>
+      static void apply(S& dest, const S& src)
+	{
+	  CMat<Shape<S>::n> a;
+	  load(a, src);
+	  invert(a);
+	  store(dest, a);
+	}
+    };
+
+    //! dest = src^{-1} for src block diagonal in the spin pairs (0,1) and (2,3)
+    struct OpChiralInverse
+    {
+      template<class S>
+      static void apply(S& dest, const S& src)
+	{
+	  enum {h = Shape<S>::n / 2};
+	  CMat<h> a;
+	  for(int b=0; b < 2; ++b)
+	  {
+	    load(a, src, b*h);
+	    invert(a);
+	    store(dest, a, b*h);
+	  }
+
+	  // The blocks off the diagonal are zero
+	  for(int i=0; i < h; ++i)
+	    for(int j=0; j < h; ++j)
+	    {
+	      zero_rep(Shape<S>::at(dest, i, h+j));
+	      zero_rep(Shape<S>::at(dest, h+i, j));
+	    }
+	}
+    };
+
+    //! dest = src^{1/2}
+    struct OpSqrtHermitian
+    {
+      template<class S>
+      static void apply(S& dest, const S& src)
+	{
+	  CMat<Shape<S>::n> a;
+	  load(a, src);
+	  sqrtHermitian(a);
+	  store(dest, a);
+	}
+    };
+
+    //! user argument for siteKernel
+    template<class D, class S>
+    struct SiteArgs
+    {
+      D* d;
+      const S* s;
+    };
+
+    //! user function applying Op to the sites [lo,hi)
+    template<class Op, class S>
+    void siteKernel(int lo, int hi, int myId, SiteArgs<S,S>* a)
+    {
+      for(int i=lo; i < hi; ++i)
+	Op::apply(a->d[i], a->s[i]);
+    }
+
+    //! user function for the determinants of the sites [lo,hi)
+    template<class T, class S>
+    void detKernel(int lo, int hi, int myId, SiteArgs<PScalar< PScalar< RComplex<T> > >, S>* a)
+    {
+      for(int i=lo; i < hi; ++i)
+      {
+	CMat<Shape<S>::n> m;
+	load(m, a->s[i]);
+	std::complex<double> d = det(m);
+	a->d[i].elem().elem().real() = d.real();
+	a->d[i].elem().elem().imag() = d.imag();
+      }
+    }
+
+    //! user argument for eigenKernel
+    template<class T, class S>
+    struct EigenArgs
+    {
+      PScalar< PScalar< RScalar<T> > >* lambda[Shape<S>::n];
+      S* v;
+      const S* s;
+    };
+
+    //! user function for the eigensystems of the sites [lo,hi)
+    template<class T, class S>
+    void eigenKernel(int lo, int hi, int myId, EigenArgs<T,S>* a)
+    {
+      enum {n = Shape<S>::n};
+      for(int i=lo; i < hi; ++i)
+      {
+	CMat<n> m, v;
+	double lambda[n];
+	load(m, a->s[i]);
+	eigenHermitian(lambda, v, m);
+	store(a->v[i], v);
+	for(int k=0; k < n; ++k)
+	  a->lambda[k][i].elem().elem().elem() = lambda[k];
+      }
+    }
+
+    //! Apply Op to every site of src
+    template<class Op, class S>
+    void sweep(OLattice<S>& dest, const OLattice<S>& src)
+    {
+      SiteArgs<S,S> a;
+      a.d = writable(dest).getF();
+      a.s = src.getF();
+      dispatch_to_threads(Layout::sitesOnNode(), a, siteKernel<Op,S>);
+    }
+  }
+
+
+  //! dest = a^{-1} at each site, a colour, spin or spin-colour matrix field
+  /*!
+   * Gauss-Jordan elimination with partial pivoting in double precision,
+   * in one threaded sweep; dest may be a. A singular site gives entries
+   * that are not finite.
+   */
+  template<class S>
+  void inverse(OLattice<S>& dest, const OLattice<S>& a)
+  {
+    SmallMatrixInternal::sweep<SmallMatrixInternal::OpInverse>(dest, a);
+  }
+
+  //! dest = a^{-1} for a spin-colour field block diagonal in chirality, such as a clover term
+  /*!
+   * a has two blocks of (Ns/2)*Nc, 6x6 for QCD, on the spin pairs (0,1)
+   * and (2,3) of the DeGrand-Rossi basis, and each is inverted alone.
+   * Entries of a outside the blocks are not read.
+   */
+  template<class T>
+  void inverseChiralBlocks(OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& dest,
+			   const OLattice< PSpinMatrix< PColorMatrix< RComplex<T>, Nc>, Ns> >& a)
+  {
+    SmallMatrixInternal::sweep<SmallMatrixInternal::OpChiralInverse>(dest, a);
+  }
+
+  //! d = det(a) at each site
+  template<class T, class S>
+  void determinant(OLattice< PScalar< PScalar< RComplex<T> > > >& d, const OLattice<S>& a)
+  {
+    SmallMatrixInternal::SiteArgs<PScalar< PScalar< RComplex<T> > >, S> args;
+    args.d = writable(d).getF();
+    args.s = a.getF();
+    dispatch_to_threads(Layout::sitesOnNode(), args, SmallMatrixInternal::detKernel<T,S>);
+  }
+
+  //! The eigenvalues, ascending, and eigenvectors of the hermitian matrix at each site
+  /*!
+   * lambda[k] is eigenvalue k and column k of v its eigenvector, so
+   * a = v diag(lambda) adj(v). By cyclic Jacobi rotations in double
+   * precision, accurate also for degenerate eigenvalues.
+   */
+  template<class T, class S>
+  void eigenHermitian(multi1d< OLattice< PScalar< PScalar< RScalar<T> > > > >& lambda,
+		      OLattice<S>& v, const OLattice<S>& a)
+  {
+    enum {n = SmallMatrixInternal::Shape<S>::n};
+
+    if (lambda.size() != n)
+      lambda.resize(n);
+
+    SmallMatrixInternal::EigenArgs<T,S> args;
+    for(int k=0; k < n; ++k)
+      args.lambda[k] = writable(lambda[k]).getF();
+    args.v = writable(v).getF();
+    args.s = a.getF();
+    dispatch_to_threads(Layout::sitesOnNode(), args, SmallMatrixInternal::eigenKernel<T,S>);
+  }
+
+  //! dest = a^{1/2} at each site for hermitian non-negative a
+  /*!
+   * From the eigensystem, negative eigenvalues taken as zero. The
+   * inverse square root of the polar decompositions of smearing is
+   * inverse(dest, dest) after this.
+   */
+  template<class S>
+  void sqrtHermitian(OLattice<S>& dest, const OLattice<S>& a)
+  {
+    SmallMatrixInternal::sweep<SmallMatrixInternal::OpSqrtHermitian>(dest, a);
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
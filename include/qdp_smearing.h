@@ -0,0 +1,255 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Fused gauge covariant (Wuppertal/Jacobi) smearing of quark fields
+ */
+
+#ifndef QDP_SMEARING_H
+#define QDP_SMEARING_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace SmearingInternal
+  {
+    //! Bit of the flags of a site whose neighbour in (dir,mu) is off-node
+    /*! dir is 0 backward and 1 forward */
+    inline unsigned char bit(int dir, int mu) {return 1 << (2*mu + dir);}
+
+    //! Start of a site list, null when empty
+    inline const int* sitePtr(const std::vector<int>& v) {return v.empty() ? 0 : &v[0];}
+
+    //! Arguments of the threaded parts of covariantSmear
+    template<class T, class U>
+    struct Args
+    {
+      typedef typename WordType<T>::Type_t W;
+
+      T* chi;
+      const T* psi;
+      const U* u[Nd];
+      const int* goff[2][Nd];        // source of each site, [0] backward [1] forward
+      T* face[2][Nd];                // [0] U^dag psi to send, then received; [1] psi received
+      const int* sites;              // sites worked on
+      const unsigned char* flags;    // off-node neighbours of each site, or null
+      int j_decay;                   // direction left out
+      int mu;                        // direction filled by faceKernel
+      W alpha, beta;
+    };
+
+    //! U_mu(y)^dag psi(y) for the y whose forward neighbour in mu is off-node
+    template<class T, class U>
+    void faceKernel(int lo, int hi, int myId, Args<T,U>* a)
+    {
+      const int mu = a->mu;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int y = a->sites[j];
+	if (a->flags[y] & bit(1,mu))
+	  a->face[0][mu][y] = adj(a->u[mu][y]) * a->psi[y];
+      }
+    }
+
+    //! One smearing step on sites[lo..hi)
+    /*!
+     * A neighbour flagged off-node is read from the received face,
+     * anything else straight from psi. Each link is loaded once per site
+     * and applied to all spin components of psi, e.g. all 12 columns of
+     * a propagator.
+     */
+    template<class T, class U>
+    void smearKernel(int lo, int hi, int myId, Args<T,U>* a)
+    {
+      typedef typename Args<T,U>::W W;
+      const int nw = sizeof(T)/sizeof(W);
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int x = a->sites[j];
+	unsigned char f = (a->flags == 0) ? 0 : a->flags[x];
+
+	T acc;
+	zero_rep(acc);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  if (mu == a->j_decay)
+	    continue;
+
+	  // U_mu(x) psi(x+mu)
+	  if (f & bit(1,mu))
+	    acc += a->u[mu][x] * a->face[1][mu][x];
+	  else
+	    acc += a->u[mu][x] * a->psi[a->goff[1][mu][x]];
+
+	  // U_mu(x-mu)^dag psi(x-mu)
+	  if (f & bit(0,mu))
+	    acc += a->face[0][mu][x];
+	  else
+	  {
+	    int y = a->goff[0][mu][x];
+	    acc += adj(a->u[mu][y]) * a->psi[y];
+	  }
+	}
+
+	// chi = alpha psi + beta acc, word by word
+	W* c = (W*)&(a->chi[x]);
+	const W* p = (const W*)&(a->psi[x]);
+	const W* s = (const W*)&acc;
+	for(int k=0; k < nw; ++k)
+	  c[k] = a->alpha*p[k] + a->beta*s[k];
+      }
+    }
+  }
+
+
+  //! iter steps of psi(x) <- alpha psi(x) + beta sum_{mu != j_decay} [U_mu(x) psi(x+mu) + U_mu(x-mu)^dag psi(x-mu)]
+  /*!
+   * The usual loop of u[mu]*shift(psi,FORWARD,mu) + shift(adj(u[mu])*psi,BACKWARD,mu)
+   * over the directions other than j_decay, done in one sweep per step.
+   * Per step the faces of all 2(Nd-1) directions are in flight together
+   * and the sites needing nothing from another node are done meanwhile;
+   * only the backward faces are multiplied by the links before they go.
+   * The steps go back and forth between psi and one work field, so no
+   * other lattice temporary is made. T may be a colour vector, a
+   * fermion or a propagator.
+   */
+  template<class T, class U>
+  void covariantSmear(OLattice<T>& psi, const multi1d< OLattice<U> >& u,
+		      const Real& alpha, const Real& beta, int iter, int j_decay = Nd-1)
+  {
+    using namespace SmearingInternal;
+
+    if (u.size() != Nd)
+      QDP_error_exit("covariantSmear: need Nd gauge links, have %d", u.size());
+    if (iter <= 0)
+      return;
+
+    const int nodeSites = Layout::sitesOnNode();
+
+    OLattice<T> work;
+    Args<T,U> a;
+    a.j_decay = j_decay;
+    a.alpha = toDouble(alpha);
+    a.beta  = toDouble(beta);
+
+    // Sites with an off-node neighbour, and the faces this node sends
+    std::vector<unsigned char> flags(nodeSites, 0);
+    bool face = false;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      a.u[mu] = u[mu].getF();
+
+      for(int dir=0; dir < 2; ++dir)
+      {
+	Map& m = shift.getMap(2*dir-1, mu);
+	a.goff[dir][mu] = m.goffset().slice();
+	if (mu == j_decay)
+	  continue;
+
+	const Subset& b = m.boundary(all);
+	const int* tab = b.siteTable().slice();
+	for(int j=0; j < b.numSiteTable(); ++j)
+	  flags[tab[j]] |= bit(dir,mu);
+
+	face = face || (b.numSiteTable() > 0);
+      }
+    }
+
+    std::vector<int> inner, outer;
+    for(int x=0; x < nodeSites; ++x)
+      (flags[x] ? outer : inner).push_back(x);
+
+    multi2d< OLattice<T> > faces(face ? 2 : 0, face ? Nd : 0);
+    if (face)
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	a.face[0][mu] = faces(0,mu).getF();
+	a.face[1][mu] = faces(1,mu).getF();
+      }
+
+    OLattice<T>* src = &psi;
+    OLattice<T>* dst = &work;
+
+    for(int n=0; n < iter; ++n)
+    {
+      a.psi = writable(*src).getF();
+      a.chi = writable(*dst).getF();
+
+      if (! face)
+      {
+	// Everything is on the node
+	a.sites = sitePtr(inner);
+	a.flags = 0;
+	dispatch_to_threads(inner.size(), a, smearKernel<T,U>);
+      }
+      else
+      {
+	std::vector< MapHandle<T> > handles;
+
+	a.sites = sitePtr(outer);
+	a.flags = &flags[0];
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  if (mu == j_decay)
+	    continue;
+
+	  a.mu = mu;
+	  dispatch_to_threads(outer.size(), a, faceKernel<T,U>);
+
+	  handles.push_back(shift.start(faces(0,mu), BACKWARD, mu));
+	  handles.push_back(shift.start(*src, FORWARD, mu));
+	}
+
+	// Interior sites while the faces are in flight
+	a.sites = sitePtr(inner);
+	a.flags = 0;
+	dispatch_to_threads(inner.size(), a, smearKernel<T,U>);
+
+	// Then the sites that need a face
+	for(int mu=0, k=0; mu < Nd; ++mu)
+	{
+	  if (mu == j_decay)
+	    continue;
+
+	  handles[k++].finishBoundary(faces(0,mu));
+	  handles[k++].finishBoundary(faces(1,mu));
+	}
+
+	a.sites = sitePtr(outer);
+	a.flags = &flags[0];
+	dispatch_to_threads(outer.size(), a, smearKernel<T,U>);
+      }
+
+      std::swap(src, dst);
+    }
+
+    if (src != &psi)
+      psi = *src;
+  }
+
+
+  //! iter Wuppertal steps, psi <- (psi + kappa H psi) / (1 + 2(Nd-1) kappa)
+  /*! H is the hopping term in the directions other than j_decay, see covariantSmear */
+  template<class T, class U>
+  void wuppertalSmear(OLattice<T>& psi, const multi1d< OLattice<U> >& u,
+		      const Real& kappa, int iter, int j_decay = Nd-1)
+  {
+    const int ndir = (j_decay >= 0 && j_decay < Nd) ? Nd-1 : Nd;
+    Real norm = Real(1) / (Real(1) + Real(2*ndir)*kappa);
+    covariantSmear(psi, u, norm, kappa*norm, iter, j_decay);
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,160 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Structure of arrays copies of lattice fields for SIMD kernels
+ */
+
+#ifndef QDP_SOA_H
+#define QDP_SOA_H
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! A lattice field stored as blocks of N sites, word by word
+  /*!
+   * OLattice keeps whole sites one after the other, so the real and
+   * imaginary parts and the colour and spin components of one site are
+   * interleaved and SIMD loads across sites need shuffles. Here the
+   * sites on the node are cut into blocks of N. Within a block word k
+   * of all N sites is contiguous:
+   *
+   *   word(site,k) = block(site/N)[k*N + site%N]
+   *
+   * so a kernel with N equal to the SIMD width (N-word vectors) loads
+   * each component straight with unit stride. N is QDP_SOA_LENGTH
+   * unless given.
+   *
+   *   SoAField<Fermion::Subtype_t> x(psi);
+   *   for(int b=0; b < x.numBlocks(); ++b)
+   *     kernel(x.block(b));
+   *   x.unpack(psi);
+   *
+   * The lanes past the last site of the node are zero after pack().
+   */
+  template<class T, int N = QDP_SOA_LENGTH>
+  class SoAField
+  {
+  public:
+    typedef typename WordType<T>::Type_t W;
+
+    //! Number of words in one site
+    enum {Words = sizeof(T)/sizeof(W)};
+
+    //! Sites in a block
+    enum {Length = N};
+
+    //! Storage for the sites on this node
+    SoAField() {alloc_mem();}
+
+    //! A copy of l
+    explicit SoAField(const OLattice<T>& l) {alloc_mem(); pack(l);}
+
+    ~SoAField() {free_mem();}
+
+    //! Number of blocks
+    int numBlocks() const {return nblocks;}
+
+    //! Words*N words of block b
+    W* block(int b) {return F + size_t(b)*Words*N;}
+    const W* block(int b) const {return F + size_t(b)*Words*N;}
+
+    //! Word k of a site
+    W& word(int site, int k) {return block(site/N)[k*N + site%N];}
+    const W& word(int site, int k) const {return block(site/N)[k*N + site%N];}
+
+    //! Copy l in
+    void pack(const OLattice<T>& l)
+      {
+	PackArgs a(const_cast<SoAField*>(this), l.getF(), true);
+	dispatch_to_threads(nblocks, a, packKernel);
+      }
+
+    //! Copy back out into l
+    void unpack(OLattice<T>& l) const
+      {
+	PackArgs a(const_cast<SoAField*>(this), l.getF(), false);
+	dispatch_to_threads(nblocks, a, packKernel);
+      }
+
+  private:
+    //! Hide copies
+    SoAField(const SoAField&);
+    void operator=(const SoAField&);
+
+    //! user argument for pack and unpack
+    struct PackArgs
+    {
+      PackArgs(SoAField* s_, T* l_, bool in_) : s(s_), l(l_), in(in_) {}
+
+      SoAField* s;
+      T* l;
+      bool in;
+    };
+
+    //! user function for pack and unpack
+    static void packKernel(int lo, int hi, int myId, PackArgs* a)
+      {
+	const int nsites = a->s->nsites;
+
+	for(int b=lo; b < hi; ++b)
+	{
+	  W* v = a->s->block(b);
+
+	  for(int lane=0; lane < N; ++lane)
+	  {
+	    int site = b*N + lane;
+	    if (site >= nsites)
+	    {
+	      if (a->in)
+		for(int k=0; k < Words; ++k)
+		  v[k*N + lane] = W(0);
+	      continue;
+	    }
+
+	    W* w = (W *)&(a->l[site]);
+	    if (a->in)
+	      for(int k=0; k < Words; ++k)
+		v[k*N + lane] = w[k];
+	    else
+	      for(int k=0; k < Words; ++k)
+		w[k] = v[k*N + lane];
+	  }
+	}
+      }
+
+    void alloc_mem()
+      {
+	nsites  = Layout::sitesOnNode();
+	nblocks = (nsites + N - 1) / N;
+
+	size_t bytes = size_t(nblocks)*Words*N*sizeof(W);
+	try
+	{
+	  F = (W*)QDP::Allocator::theQDPAllocator::Instance().allocate(bytes, QDP::Allocator::DEFAULT);
+	}
+	catch(std::bad_alloc) {
+	  QDPIO::cerr << "Allocation failed in SoAField: " << bytes << " bytes" << std::endl;
+	  QDP::Allocator::printAllocStats();
+	  QDP_abort(1);
+	}
+      }
+
+    void free_mem()
+      {
+	QDP::Allocator::theQDPAllocator::Instance().free(F);
+      }
+
+    int nsites;
+    int nblocks;
+    W* F;
+  };
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
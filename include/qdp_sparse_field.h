@@ -0,0 +1,305 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Lattice fields nonzero on a few sites only, such as point and wall sources
+ */
+
+#ifndef QDP_SPARSE_FIELD_H
+#define QDP_SPARSE_FIELD_H
+
+namespace QDP
+{
+
+  /** \addtogroup group1
+   *  @{
+   */
+
+  //! A subset of the sites listed, belonging to no set
+  /*!
+   * Expressions are evaluated on it as on any subset, visiting the sites
+   * in the order given. Having no set, it cannot hold an OSubLattice,
+   * and a shift read on it exchanges its whole face.
+   */
+  class SiteList : public Subset
+  {
+  public:
+    //! No sites
+    SiteList() {remake();}
+
+    //! The sites tab, local site indices on this node
+    explicit SiteList(const multi1d<int>& tab) : sites(tab) {remake();}
+
+    SiteList(const SiteList& s) : Subset(), sites(s.sites) {remake();}
+
+    SiteList& operator=(const SiteList& s)
+      {
+	sites = s.sites;
+	remake();
+	return *this;
+      }
+
+    //! Position of site i in the list, -1 if not there
+    int find(int i) const
+      {
+	for(int j=0; j < sites.size(); ++j)
+	  if (sites[j] == i)
+	    return j;
+	return -1;
+      }
+
+    //! Put site i at the end of the list
+    void append(int i)
+      {
+	multi1d<int> tab(sites.size() + 1);
+	for(int j=0; j < sites.size(); ++j)
+	  tab[j] = sites[j];
+	tab[sites.size()] = i;
+	sites = tab;
+	remake();
+      }
+
+  private:
+    //! Point the subset at the list, a range when the sites are consecutive
+    void remake()
+      {
+	const int n = sites.size();
+	bool rep = n > 0;
+	for(int j=1; j < n && rep; ++j)
+	  rep = (sites[j] == sites[0] + j);
+
+	make(rep, rep ? sites[0] : -1, rep ? sites[n-1] : -1, &sites, 0, 0);
+      }
+
+    multi1d<int> sites;
+  };
+
+
+  //! A lattice field stored on a few sites, zero on all others
+  /*!
+   * Point and wall sources are zero almost everywhere. As dense fields
+   * zeroing, filling and adding them costs full lattice bandwidth; here
+   * only the sites held are stored and touched:
+   *
+   *   SparseLattice<LatticeFermion::Subtype_t> src;
+   *   src.set(coord, f);                         // a point source
+   *   wall.assign(gauss, timeslices[t0]);        // a timeslice of a field
+   *   chi += src;                                // the sites of src only
+   *   DComplex c = innerProduct(src, psi);       // the same
+   *   src = u[0] * shift(psi, FORWARD, 0);       // evaluated on its sites
+   *   LatticeFermion d = src.dense();            // when a full field is needed
+   *
+   * The sites are kept on the node holding them, in the order they were
+   * set, and subset() is the list of them for evaluating any expression
+   * there only.
+   */
+  template<class T>
+  class SparseLattice
+  {
+  public:
+    //! Zero everywhere
+    SparseLattice() {}
+
+    //! The value at the site coord becomes v. Called on all nodes
+    void set(const multi1d<int>& coord, const OScalar<T>& v)
+      {
+	if (Layout::nodeNumber(coord) != Layout::nodeNumber())
+	  return;
+
+	const int i = Layout::linearSiteIndex(coord);
+	int j = sites.find(i);
+	if (j < 0)
+	{
+	  j = sites.numSiteTable();
+	  sites.append(i);
+
+	  multi1d<T> v1(j + 1);
+	  for(int k=0; k < j; ++k)
+	    v1[k] = vals[k];
+	  vals = v1;
+	}
+	vals[j] = v.elem();
+      }
+
+    //! The field r on the sites of s and zero elsewhere
+    /*! A wall source is the timeslice of a field */
+    template<class T1, class C1>
+    void assign(const QDPType<T1,C1>& r, const Subset& s)
+      {
+	assign(PETE_identity(r), s);
+      }
+
+    template<class RHS, class T1>
+    void assign(const QDPExpr<RHS,OLattice<T1> >& r, const Subset& s)
+      {
+	sites = SiteList(s.siteTable());
+	vals.resize(sites.numSiteTable());
+	evaluate_F(vals.slice(), OpAssign(), r, sites);
+      }
+
+    //! r evaluated on the sites held, which stay the same
+    template<class T1, class C1>
+    SparseLattice& operator=(const QDPType<T1,C1>& r)
+      {
+	return *this = PETE_identity(r);
+      }
+
+    template<class RHS, class T1>
+    SparseLattice& operator=(const QDPExpr<RHS,OLattice<T1> >& r)
+      {
+	evaluate_F(vals.slice(), OpAssign(), r, sites);
+	return *this;
+      }
+
+    //! Add r evaluated on the sites held
+    template<class RHS, class T1>
+    SparseLattice& operator+=(const QDPExpr<RHS,OLattice<T1> >& r)
+      {
+	evaluate_F(vals.slice(), OpAddAssign(), r, sites);
+	return *this;
+      }
+
+    template<class T1, class C1>
+    SparseLattice& operator+=(const QDPType<T1,C1>& r)
+      {
+	return *this += PETE_identity(r);
+      }
+
+    //! The sites held on this node, as a subset to evaluate on
+    const Subset& subset() const {return sites;}
+
+    //! Number of sites held on this node
+    int numSites() const {return sites.numSiteTable();}
+
+    //! The value of the j-th site held
+    const T& value(int j) const {return vals[j];}
+
+    //! d = this field on all sites
+    void densify(OLattice<T>& d) const
+      {
+	d = zero;
+	scatterSites(writable(d).getF(), vals.slice(), sites);
+      }
+
+    //! This field on all sites
+    OLattice<T> dense() const
+      {
+	OLattice<T> d;
+	densify(d);
+	return d;
+      }
+
+    //! d[i] += sign * this[i] on the sites held
+    void addTo(OLattice<T>& d, int sign) const
+      {
+	T* f = writable(d).getF();
+	const T* v = vals.slice();
+	const int* tab = sites.siteTable().slice();
+
+	dispatch_range(sites, sizeof(T), [&](int lo, int hi, int myId) {
+	    for(int j=lo; j < hi; ++j)
+	      if (sign > 0)
+		f[tab[j]] += v[j];
+	      else
+		f[tab[j]] -= v[j];
+	  });
+      }
+
+  private:
+    SiteList sites;
+    multi1d<T> vals;
+  };
+
+
+  //! d += s on the sites of s only
+  template<class T>
+  inline OLattice<T>& operator+=(OLattice<T>& d, const SparseLattice<T>& s)
+  {
+    s.addTo(d, +1);
+    return d;
+  }
+
+  //! d -= s on the sites of s only
+  template<class T>
+  inline OLattice<T>& operator-=(OLattice<T>& d, const SparseLattice<T>& s)
+  {
+    s.addTo(d, -1);
+    return d;
+  }
+
+  //! a + s, one copy of a and the sites of s
+  template<class T>
+  OLattice<T> operator+(const OLattice<T>& a, const SparseLattice<T>& s)
+  {
+    OLattice<T> d = a;
+    d += s;
+    return d;
+  }
+
+  template<class T>
+  OLattice<T> operator+(const SparseLattice<T>& s, const OLattice<T>& a)
+  {
+    return a + s;
+  }
+
+  //! a - s, one copy of a and the sites of s
+  template<class T>
+  OLattice<T> operator-(const OLattice<T>& a, const SparseLattice<T>& s)
+  {
+    OLattice<T> d = a;
+    d -= s;
+    return d;
+  }
+
+
+  //! <s,a> summed over the sites of s only
+  template<class T, class T1>
+  typename BinaryReturn<OLattice<T>, OLattice<T1>, FnInnerProduct>::Type_t
+  innerProduct(const SparseLattice<T>& s, const OLattice<T1>& a)
+  {
+    typename BinaryReturn<OLattice<T>, OLattice<T1>, FnInnerProduct>::Type_t d;
+    zero_rep(d.elem());
+
+    const int* tab = s.subset().siteTable().slice();
+    for(int j=0; j < s.numSites(); ++j)
+      d.elem() += localInnerProduct(s.value(j), a.elem(tab[j]));
+
+    QDPInternal::globalSum(d);
+    return d;
+  }
+
+  //! <a,s> summed over the sites of s only
+  template<class T, class T1>
+  typename BinaryReturn<OLattice<T1>, OLattice<T>, FnInnerProduct>::Type_t
+  innerProduct(const OLattice<T1>& a, const SparseLattice<T>& s)
+  {
+    typename BinaryReturn<OLattice<T1>, OLattice<T>, FnInnerProduct>::Type_t d;
+    zero_rep(d.elem());
+
+    const int* tab = s.subset().siteTable().slice();
+    for(int j=0; j < s.numSites(); ++j)
+      d.elem() += localInnerProduct(a.elem(tab[j]), s.value(j));
+
+    QDPInternal::globalSum(d);
+    return d;
+  }
+
+  //! |s|^2 over the sites held
+  template<class T>
+  typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t
+  norm2(const SparseLattice<T>& s)
+  {
+    typename UnaryReturn<OLattice<T>, FnNorm2>::Type_t d;
+    zero_rep(d.elem());
+
+    for(int j=0; j < s.numSites(); ++j)
+      d.elem() += localNorm2(s.value(j));
+
+    QDPInternal::globalSum(d);
+    return d;
+  }
+
+  /** @} */ // end of group1
+
+} // namespace QDP
+
+#endif
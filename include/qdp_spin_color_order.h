@@ -0,0 +1,284 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Spin and colour transpositions of propagators, and their other nesting, in one pass
+ */
+
+#ifndef QDP_SPIN_COLOR_ORDER_H
+#define QDP_SPIN_COLOR_ORDER_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group1
+   *  @{
+   */
+
+  namespace SpinColorOrderInternal
+  {
+    //! Where word k of a spin-colour site goes
+    /*!
+     * A site of PSpinMatrix<PColorMatrix<RComplex<W>,N>,S> holds word
+     * (((s1*S + s2)*N + c1)*N + c2)*2 + ri. The word goes to the same
+     * place with s1,s2 swapped when spin, c1,c2 swapped when color, and
+     * to (((c1*N + c2)*S + s1)*S + s2)*2 + ri when nest, the site of
+     * PColorMatrix<PSpinMatrix<RComplex<W>,S>,N>. The reverse nesting
+     * is the inverse of that.
+     */
+    inline std::vector<int> permutation(int S, int N, bool spin, bool color, bool nest, bool inverse)
+    {
+      std::vector<int> perm(S*S*N*N*2);
+
+      for(int s1=0; s1 < S; ++s1)
+	for(int s2=0; s2 < S; ++s2)
+	  for(int c1=0; c1 < N; ++c1)
+	    for(int c2=0; c2 < N; ++c2)
+	      for(int ri=0; ri < 2; ++ri)
+	      {
+		const int from = (((s1*S + s2)*N + c1)*N + c2)*2 + ri;
+		const int t1 = spin ? s2 : s1, t2 = spin ? s1 : s2;
+		const int d1 = color ? c2 : c1, d2 = color ? c1 : c2;
+		const int to = nest ? (((d1*N + d2)*S + t1)*S + t2)*2 + ri
+		                    : (((t1*S + t2)*N + d1)*N + d2)*2 + ri;
+		if (inverse)
+		  perm[to] = from;
+		else
+		  perm[from] = to;
+	      }
+
+      return perm;
+    }
+
+    //! user argument for the kernels
+    template<class W>
+    struct PermuteArgs
+    {
+      const W* src;
+      W* dst;
+      const int* perm;
+      int words;
+      const int* sites;      // null for all the sites of the node
+      int veclen;            // of the buffer, for the copies to and from one
+      int nslots;
+    };
+
+    //! user function for dst(x) <- perm src(x) at sites[lo..hi), dst may be src
+    template<class W, int Words>
+    void permuteKernel(int lo, int hi, int myId, PermuteArgs<W>* a)
+    {
+      W t[Words];
+
+      for(int j=lo; j < hi; ++j)
+      {
+	const int x = a->sites ? a->sites[j] : j;
+	const W* s = a->src + size_t(x)*Words;
+	W* d = a->dst + size_t(x)*Words;
+
+	for(int k=0; k < Words; ++k)
+	  t[a->perm[k]] = s[k];
+	for(int k=0; k < Words; ++k)
+	  d[k] = t[k];
+      }
+    }
+
+    //! user function for the permuted sites of a field into a buffer laid out by a SiteOrder
+    template<class W, int Words>
+    void extractKernel(int lo, int hi, int myId, PermuteArgs<W>* a)
+    {
+      const int N = a->veclen;
+
+      for(int b=lo; b < hi; ++b)
+      {
+	for(int lane=0; lane < N; ++lane)
+	{
+	  const int j = b*N + lane;
+	  W* v = a->dst + size_t(b)*Words*N + lane;
+	  if (j >= a->nslots)
+	  {
+	    for(int k=0; k < Words; ++k)
+	      v[k*N] = W(0);
+	    continue;
+	  }
+
+	  const W* s = a->src + size_t(a->sites[j])*Words;
+	  for(int k=0; k < Words; ++k)
+	    v[a->perm[k]*N] = s[k];
+	}
+      }
+    }
+
+    //! user function for a buffer laid out by a SiteOrder into the permuted sites of a field
+    template<class W, int Words>
+    void insertKernel(int lo, int hi, int myId, PermuteArgs<W>* a)
+    {
+      const int N = a->veclen;
+
+      for(int b=lo; b < hi; ++b)
+      {
+	for(int lane=0; lane < N; ++lane)
+	{
+	  const int j = b*N + lane;
+	  if (j >= a->nslots)
+	    break;
+
+	  const W* v = a->src + size_t(b)*Words*N + lane;
+	  W* d = a->dst + size_t(a->sites[j])*Words;
+	  for(int k=0; k < Words; ++k)
+	    d[k] = v[a->perm[k]*N];
+	}
+      }
+    }
+
+    //! Permute the sites of s from src to dst, which may be the same
+    template<class W, int Words>
+    void permute(W* dst, const W* src, const std::vector<int>& perm, const Subset& s)
+    {
+      PermuteArgs<W> a;
+      a.src = src;
+      a.dst = dst;
+      a.perm = &perm[0];
+      a.words = Words;
+      a.veclen = 1;
+
+      int n;
+      if (s.hasOrderedRep() && s.start() == 0 && s.end() == Layout::sitesOnNode()-1)
+      {
+	a.sites = 0;
+	n = Layout::sitesOnNode();
+      }
+      else
+      {
+	a.sites = s.siteTable().slice();
+	n = s.numSiteTable();
+      }
+      a.nslots = n;
+
+      if (n > 0)
+	dispatch_to_threads(n, a, permuteKernel<W,Words>);
+    }
+  }
+
+
+  //! Transpose the spin indices of a propagator in place, on the sites of s
+  /*!
+   * The same as p = transposeSpin(p) without the temporary field: each
+   * site is read once into a small buffer and written back transposed,
+   * the sites split over the threads.
+   */
+  template<class W, int N, int S>
+  void transposeSpinInPlace(OLattice< PSpinMatrix< PColorMatrix< RComplex<W>, N>, S> >& p,
+			    const Subset& s = all)
+  {
+    static const std::vector<int> perm = SpinColorOrderInternal::permutation(S, N, true, false, false, false);
+    W* f = (W*)writable(p).getF();
+    SpinColorOrderInternal::permute<W,S*S*N*N*2>(f, f, perm, s);
+  }
+
+  //! Transpose the colour indices of a propagator in place, on the sites of s
+  template<class W, int N, int S>
+  void transposeColorInPlace(OLattice< PSpinMatrix< PColorMatrix< RComplex<W>, N>, S> >& p,
+			     const Subset& s = all)
+  {
+    static const std::vector<int> perm = SpinColorOrderInternal::permutation(S, N, false, true, false, false);
+    W* f = (W*)writable(p).getF();
+    SpinColorOrderInternal::permute<W,S*S*N*N*2>(f, f, perm, s);
+  }
+
+  //! Transpose the spin and the colour indices of a propagator in place, on the sites of s
+  /*! The transpose of the SN x SN matrix, transpose(p) without the temporary */
+  template<class W, int N, int S>
+  void transposeInPlace(OLattice< PSpinMatrix< PColorMatrix< RComplex<W>, N>, S> >& p,
+			const Subset& s = all)
+  {
+    static const std::vector<int> perm = SpinColorOrderInternal::permutation(S, N, true, true, false, false);
+    W* f = (W*)writable(p).getF();
+    SpinColorOrderInternal::permute<W,S*S*N*N*2>(f, f, perm, s);
+  }
+
+
+  //! The propagator src with the colour indices outside the spin ones
+  /*! dest(x)[c1][c2][s1][s2] = src(x)[s1][s2][c1][c2] on the sites of s, in one pass */
+  template<class W, int N, int S>
+  void colorSpinOrder(OLattice< PColorMatrix< PSpinMatrix< RComplex<W>, S>, N> >& dest,
+		      const OLattice< PSpinMatrix< PColorMatrix< RComplex<W>, N>, S> >& src,
+		      const Subset& s = all)
+  {
+    static const std::vector<int> perm = SpinColorOrderInternal::permutation(S, N, false, false, true, false);
+    SpinColorOrderInternal::permute<W,S*S*N*N*2>((W*)writable(dest).getF(), (const W*)src.getF(), perm, s);
+  }
+
+  //! The propagator src with the spin indices outside the colour ones, the inverse of colorSpinOrder
+  template<class W, int N, int S>
+  void spinColorOrder(OLattice< PSpinMatrix< PColorMatrix< RComplex<W>, N>, S> >& dest,
+		      const OLattice< PColorMatrix< PSpinMatrix< RComplex<W>, S>, N> >& src,
+		      const Subset& s = all)
+  {
+    static const std::vector<int> perm = SpinColorOrderInternal::permutation(S, N, false, false, true, true);
+    SpinColorOrderInternal::permute<W,S*S*N*N*2>((W*)writable(dest).getF(), (const W*)src.getF(), perm, s);
+  }
+
+
+  //! Copy a propagator into a buffer laid out by order, colour indices outside the spin ones
+  /*!
+   * QDP_extract and the colour-major order of many external solvers in
+   * one pass: slot j of dest holds src at order.site(j) as
+   * [c1][c2][s1][s2][re,im], blocked by the vector length of order like
+   * QDP_extract. With spin_transpose the spin indices are also swapped.
+   */
+  template<class W, int N, int S>
+  void QDP_extractColorSpin(W* dest, const OLattice< PSpinMatrix< PColorMatrix< RComplex<W>, N>, S> >& src,
+			    const SiteOrder& order, bool spin_transpose = false)
+  {
+    const int Words = S*S*N*N*2;
+    static const std::vector<int> perm[2] = {
+      SpinColorOrderInternal::permutation(S, N, false, false, true, false),
+      SpinColorOrderInternal::permutation(S, N, true,  false, true, false)};
+
+    const int V = order.vectorLength();
+    if (order.numSlots() == 0)
+      return;
+
+    SpinColorOrderInternal::PermuteArgs<W> a;
+    a.src = (const W*)src.getF();
+    a.dst = dest;
+    a.perm = &perm[spin_transpose][0];
+    a.words = Words;
+    a.sites = order.slotTable();
+    a.veclen = V;
+    a.nslots = order.numSlots();
+    dispatch_to_threads((order.numSlots() + V - 1) / V, a, SpinColorOrderInternal::extractKernel<W,Words>);
+  }
+
+  //! Copy a buffer laid out by order, colour indices outside the spin ones, into a propagator
+  /*! The inverse of QDP_extractColorSpin. Sites of dest outside the layout are left alone */
+  template<class W, int N, int S>
+  void QDP_insertColorSpin(OLattice< PSpinMatrix< PColorMatrix< RComplex<W>, N>, S> >& dest, const W* src,
+			   const SiteOrder& order, bool spin_transpose = false)
+  {
+    const int Words = S*S*N*N*2;
+    static const std::vector<int> perm[2] = {
+      SpinColorOrderInternal::permutation(S, N, false, false, true, false),
+      SpinColorOrderInternal::permutation(S, N, true,  false, true, false)};
+
+    const int V = order.vectorLength();
+    if (order.numSlots() == 0)
+      return;
+
+    SpinColorOrderInternal::PermuteArgs<W> a;
+    a.src = src;
+    a.dst = (W*)writable(dest).getF();
+    a.perm = &perm[spin_transpose][0];
+    a.words = Words;
+    a.sites = order.slotTable();
+    a.veclen = V;
+    a.nslots = order.numSlots();
+    dispatch_to_threads((order.numSlots() + V - 1) / V, a, SpinColorOrderInternal::insertKernel<W,Words>);
+  }
+
+  /** @} */ // end of group1
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,512 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Kernels for the staggered (Ns=1) colour vectors
+ */
+
+#ifndef QDP_STAGGERED_H
+#define QDP_STAGGERED_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  //! Kernels on PSpinVector<PColorVector<RComplex<W>,N>,1> sites
+  /*!
+   * The generic, SSE and BAGEL kernels are written for four spinors and
+   * half spinors, so staggered fields go through the expression
+   * templates. Here the BLAS-1 forms
+   *
+   *   y += a*x;  y -= a*x;  y = a*x;  y = a*x +- z;  y = a*x +- b*z
+   *
+   * and norm2, innerProduct and innerProductReal on a subset are matched
+   * for any precision and number of colours and done as word loops over
+   * the runs of the subset, skipping the padding of single precision
+   * sites, with the norms summed in REAL64. The hops of a
+   * Dslash multiply a link and a vector and fold in the phase of the
+   * site in the same sweep:
+   *
+   *   LatticeStaggeredFermion chi, t;
+   *   multi1d<LatticeReal> eta(Nd);
+   *   for(int mu=0; mu < Nd; ++mu)
+   *     eta[mu] = staggeredPhase(mu);
+   *
+   *   chi[rb[0]] = zero;
+   *   for(int mu=0; mu < Nd; ++mu)
+   *   {
+   *     t = shift(psi, FORWARD, mu);
+   *     phasedMultiplyAdd(chi, Real(1), eta[mu], u[mu], t, rb[0]);
+   *     phasedAdjMultiply(t, eta[mu], u[mu], psi, rb[1]);
+   *     chi[rb[0]] -= shift(t, BACKWARD, mu);
+   *   }
+   *
+   * The three link terms of asqtad and HISQ are the same with the long
+   * links and shift(psi, FORWARD, mu, 3), one exchange for the hop.
+   */
+  namespace StaggeredKernels
+  {
+    //! The site of a staggered fermion
+    template<class W, int N>
+    using Vec = PSpinVector<PColorVector<RComplex<W>, N>, 1>;
+
+    //! The site of a link
+    template<class W, int N>
+    using Link = PScalar<PColorMatrix<RComplex<W>, N> >;
+
+    //! The site of a real number, such as a phase
+    template<class W>
+    using Real = PScalar<PScalar<RScalar<W> > >;
+
+    //! A field and a scalar leaf of an expression
+    template<class T>
+    using Field = Reference< QDPType<T, OLattice<T> > >;
+
+    template<class T>
+    using Scalar = Reference< QDPType<T, OScalar<T> > >;
+
+    //! The expression a*x
+    template<class W, int N>
+    using Scaled = BinaryNode<OpMultiply, Scalar< Real<W> >, Field< Vec<W,N> > >;
+
+
+    //! user argument for the staggered kernels
+    template<class W, int N>
+    struct Args
+    {
+      const int* tab;     //!< site table, null to go by runs
+      const SiteRun* runs;
+      int nruns;
+      Vec<W,N>* d;
+      const Vec<W,N>* x;
+      const Vec<W,N>* y;  //!< null for none
+      W a;
+      W b;
+      const Link<W,N>* u;
+      const Real<W>* eta;
+      REAL64* part;
+    };
+
+    //! Fill the site loop of a from s
+    template<class W, int N>
+    inline void sites(Args<W,N>& a, const Subset& s)
+      {
+	a.tab = 0;
+	a.runs = 0;
+	a.nruns = 0;
+	if (s.hasRuns())
+	{
+	  a.runs = s.runTable().slice();
+	  a.nruns = s.numRuns();
+	}
+	else
+	  a.tab = s.siteTable().slice();
+      }
+
+    //! Call f(site, n) on runs of n consecutive sites covering positions [lo,hi)
+    template<class W, int N, class F>
+    inline void forRuns(int lo, int hi, const Args<W,N>* a, const F& f)
+      {
+	if (! a->tab)
+	{
+	  forSiteRuns(a->runs, a->nruns, lo, hi, f);
+	  return;
+	}
+	for(int j=lo; j < hi; ++j)
+	  f(a->tab[j], 1);
+      }
+
+    //! Words from one site to the next
+    /*! More than the 2N of the vector when the site is padded for alignment */
+    template<class W, int N>
+    inline int stride() {return sizeof(Vec<W,N>)/sizeof(W);}
+
+    //! d = a*x + b*y, or d = a*x without y
+    template<class W, int N>
+    void axpbyKernel(int lo, int hi, int myId, Args<W,N>* a)
+      {
+	const int st = stride<W,N>();
+	const W ca = a->a, cb = a->b;
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    W* dp = (W*)&a->d[i];
+	    const W* xp = (const W*)&a->x[i];
+	    const W* yp = a->y ? (const W*)&a->y[i] : 0;
+	    for(int k=0; k < n*st; k += st)
+	    {
+	      if (yp)
+		for(int w=k; w < k + 2*N; ++w)
+		  dp[w] = ca*xp[w] + cb*yp[w];
+	      else
+		for(int w=k; w < k + 2*N; ++w)
+		  dp[w] = ca*xp[w];
+	    }
+	  });
+      }
+
+    //! Partial Re<x,y>, and Im<x,y> when Complex, of thread myId
+    template<class W, int N, bool Complex>
+    void reduceKernel(int lo, int hi, int myId, Args<W,N>* a)
+      {
+	REAL64 sr = 0, si = 0;
+	const int st = stride<W,N>();
+	forRuns(lo, hi, a, [&](int i, int n) {
+	    const W* xp = (const W*)&a->x[i];
+	    const W* yp = (const W*)&a->y[i];
+	    for(int k=0; k < n*st; k += st)
+	      for(int w=k; w < k + 2*N; w += 2)
+	      {
+		const REAL64 xr = xp[w], xi = xp[w+1];
+		const REAL64 yr = yp[w], yi = yp[w+1];
+		sr += xr*yr + xi*yi;
+		if (Complex)
+		  si += xr*yi - xi*yr;
+	      }
+	  });
+	a->part[2*myId]   = sr;
+	a->part[2*myId+1] = si;
+      }
+
+    //! d = a*eta*u*x, d += a*eta*u*x, or the same with adj(u)
+    /*! The site of x is read whole before d is written, so d may be x */
+    template<class W, int N, bool Adj, bool Acc>
+    void linkKernel(int lo, int hi, int myId, Args<W,N>* a)
+      {
+	forRuns(lo, hi, a, [&](int i0, int n) {
+	    for(int i=i0; i < i0 + n; ++i)
+	    {
+	      const W e = a->a * a->eta[i].elem().elem().elem();
+	      const W* up = (const W*)&a->u[i];
+	      const W* xp = (const W*)&a->x[i];
+	      W* dp = (W*)&a->d[i];
+
+	      W r[2*N];
+	      for(int c=0; c < N; ++c)
+	      {
+		W re = 0, im = 0;
+		for(int k=0; k < N; ++k)
+		{
+		  // u(c,k) x(k), or conj(u(k,c)) x(k)
+		  const int m = Adj ? (k*N + c) : (c*N + k);
+		  const W ur = up[2*m], ui = Adj ? -up[2*m+1] : up[2*m+1];
+		  re += ur*xp[2*k] - ui*xp[2*k+1];
+		  im += ur*xp[2*k+1] + ui*xp[2*k];
+		}
+		r[2*c]   = e*re;
+		r[2*c+1] = e*im;
+	      }
+
+	      for(int w=0; w < 2*N; ++w)
+		dp[w] = Acc ? dp[w] + r[w] : r[w];
+	    }
+	  });
+      }
+
+    //! d = a*x + b*y on s, d = a*x with no y
+    template<class W, int N>
+    void axpby(OLattice< Vec<W,N> >& d, W ca, const OLattice< Vec<W,N> >& x,
+	       W cb, const OLattice< Vec<W,N> >* y, const Subset& s)
+      {
+	Args<W,N> a;
+	sites(a, s);
+	a.x = x.getF();
+	a.y = y ? y->getF() : 0;
+	a.d = writable(d).getF();
+	a.a = ca;
+	a.b = cb;
+	a.u = 0;
+	a.eta = 0;
+	a.part = 0;
+	dispatch_to_threads(s.numSiteTable(), a, axpbyKernel<W,N>);
+      }
+
+    //! Re<x,y> and Im<x,y> on s, or only the real part
+    template<class W, int N, bool Complex>
+    void reduce(const OLattice< Vec<W,N> >& x, const OLattice< Vec<W,N> >& y,
+		const Subset& s, REAL64* res)
+      {
+	std::vector<REAL64> part(2*qdpNumThreads(), 0);
+	Args<W,N> a;
+	sites(a, s);
+	a.x = x.getF();
+	a.y = y.getF();
+	a.part = &part[0];
+	dispatch_to_threads(s.numSiteTable(), a, reduceKernel<W,N,Complex>);
+
+	res[0] = res[1] = 0;
+	for(int t=0; t < qdpNumThreads(); ++t)
+	{
+	  res[0] += part[2*t];
+	  res[1] += part[2*t+1];
+	}
+	QDPInternal::globalSumArray(res, 2);
+      }
+
+    //! The link kernel on s
+    template<class W, int N, bool Adj, bool Acc>
+    void link(OLattice< Vec<W,N> >& d, W ca, const OLattice< Real<W> >& eta,
+	      const OLattice< Link<W,N> >& u, const OLattice< Vec<W,N> >& x, const Subset& s)
+      {
+	Args<W,N> a;
+	sites(a, s);
+	a.x = x.getF();
+	a.y = 0;
+	a.u = u.getF();
+	a.eta = eta.getF();
+	a.d = writable(d).getF();
+	a.a = ca;
+	a.b = 0;
+	a.part = 0;
+	dispatch_to_threads(s.numSiteTable(), a, linkKernel<W,N,Adj,Acc>);
+      }
+
+    //! The scalar a and field x of a*x
+    template<class W, int N>
+    inline W scale(const Scaled<W,N>& e) {return e.left().elem().elem().elem().elem();}
+
+    template<class W, int N>
+    inline const OLattice< Vec<W,N> >& field(const Scaled<W,N>& e)
+      {
+	return static_cast<const OLattice< Vec<W,N> >&>(e.right());
+      }
+
+    template<class T>
+    inline const OLattice<T>& field(const QDPType<T, OLattice<T> >& e)
+      {
+	return static_cast<const OLattice<T>&>(e);
+      }
+  }
+
+
+  //! y += a*x for staggered fields
+  template<class W, int N>
+  void evaluate(OLattice< StaggeredKernels::Vec<W,N> >& d, const OpAddAssign& op,
+		const QDPExpr<StaggeredKernels::Scaled<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& rhs,
+		const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered y += a*x");
+    const StaggeredKernels::Scaled<W,N>& e = rhs.expression();
+    StaggeredKernels::axpby(d, StaggeredKernels::scale(e), StaggeredKernels::field(e), W(1), &d, s);
+  }
+
+  //! y -= a*x for staggered fields
+  template<class W, int N>
+  void evaluate(OLattice< StaggeredKernels::Vec<W,N> >& d, const OpSubtractAssign& op,
+		const QDPExpr<StaggeredKernels::Scaled<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& rhs,
+		const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered y -= a*x");
+    const StaggeredKernels::Scaled<W,N>& e = rhs.expression();
+    StaggeredKernels::axpby(d, W(-StaggeredKernels::scale(e)), StaggeredKernels::field(e), W(1), &d, s);
+  }
+
+  //! y = a*x for staggered fields
+  template<class W, int N>
+  void evaluate(OLattice< StaggeredKernels::Vec<W,N> >& d, const OpAssign& op,
+		const QDPExpr<StaggeredKernels::Scaled<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& rhs,
+		const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered y = a*x");
+    const StaggeredKernels::Scaled<W,N>& e = rhs.expression();
+    StaggeredKernels::axpby<W,N>(d, StaggeredKernels::scale(e), StaggeredKernels::field(e), W(0), 0, s);
+  }
+
+  //! y = a*x + z for staggered fields
+  template<class W, int N>
+  void evaluate(OLattice< StaggeredKernels::Vec<W,N> >& d, const OpAssign& op,
+		const QDPExpr<BinaryNode<OpAdd, StaggeredKernels::Scaled<W,N>,
+		StaggeredKernels::Field< StaggeredKernels::Vec<W,N> > >,
+		OLattice< StaggeredKernels::Vec<W,N> > >& rhs,
+		const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered y = a*x + z");
+    const StaggeredKernels::Scaled<W,N>& e = rhs.expression().left();
+    StaggeredKernels::axpby(d, StaggeredKernels::scale(e), StaggeredKernels::field(e),
+			    W(1), &StaggeredKernels::field(rhs.expression().right()), s);
+  }
+
+  //! y = a*x - z for staggered fields
+  template<class W, int N>
+  void evaluate(OLattice< StaggeredKernels::Vec<W,N> >& d, const OpAssign& op,
+		const QDPExpr<BinaryNode<OpSubtract, StaggeredKernels::Scaled<W,N>,
+		StaggeredKernels::Field< StaggeredKernels::Vec<W,N> > >,
+		OLattice< StaggeredKernels::Vec<W,N> > >& rhs,
+		const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered y = a*x - z");
+    const StaggeredKernels::Scaled<W,N>& e = rhs.expression().left();
+    StaggeredKernels::axpby(d, StaggeredKernels::scale(e), StaggeredKernels::field(e),
+			    W(-1), &StaggeredKernels::field(rhs.expression().right()), s);
+  }
+
+  //! y = a*x + b*z for staggered fields
+  template<class W, int N>
+  void evaluate(OLattice< StaggeredKernels::Vec<W,N> >& d, const OpAssign& op,
+		const QDPExpr<BinaryNode<OpAdd, StaggeredKernels::Scaled<W,N>, StaggeredKernels::Scaled<W,N> >,
+		OLattice< StaggeredKernels::Vec<W,N> > >& rhs,
+		const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered y = a*x + b*z");
+    const StaggeredKernels::Scaled<W,N>& e = rhs.expression().left();
+    const StaggeredKernels::Scaled<W,N>& f = rhs.expression().right();
+    StaggeredKernels::axpby(d, StaggeredKernels::scale(e), StaggeredKernels::field(e),
+			    StaggeredKernels::scale(f), &StaggeredKernels::field(f), s);
+  }
+
+  //! y = a*x - b*z for staggered fields
+  template<class W, int N>
+  void evaluate(OLattice< StaggeredKernels::Vec<W,N> >& d, const OpAssign& op,
+		const QDPExpr<BinaryNode<OpSubtract, StaggeredKernels::Scaled<W,N>, StaggeredKernels::Scaled<W,N> >,
+		OLattice< StaggeredKernels::Vec<W,N> > >& rhs,
+		const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered y = a*x - b*z");
+    const StaggeredKernels::Scaled<W,N>& e = rhs.expression().left();
+    const StaggeredKernels::Scaled<W,N>& f = rhs.expression().right();
+    StaggeredKernels::axpby(d, StaggeredKernels::scale(e), StaggeredKernels::field(e),
+			    W(-StaggeredKernels::scale(f)), &StaggeredKernels::field(f), s);
+  }
+
+
+  //! |x|^2 on s of a staggered field, summed in REAL64
+  template<class W, int N>
+  typename UnaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, FnNorm2>::Type_t
+  norm2(const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s1,
+	const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered norm2");
+    const OLattice< StaggeredKernels::Vec<W,N> >& x = static_cast<const OLattice< StaggeredKernels::Vec<W,N> >&>(s1);
+    REAL64 r[2];
+    StaggeredKernels::reduce<W,N,false>(x, x, s, r);
+
+    typename UnaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, FnNorm2>::Type_t d;
+    d.elem().elem().elem().elem() = r[0];
+    return d;
+  }
+
+  template<class W, int N>
+  typename UnaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, FnNorm2>::Type_t
+  norm2(const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s1)
+  {
+    return norm2(s1, all);
+  }
+
+  //! <x,y> on s of staggered fields, summed in REAL64
+  template<class W, int N>
+  typename BinaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, OLattice< StaggeredKernels::Vec<W,N> >,
+			FnInnerProduct>::Type_t
+  innerProduct(const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s1,
+	       const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s2,
+	       const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered innerProduct");
+    REAL64 r[2];
+    StaggeredKernels::reduce<W,N,true>(static_cast<const OLattice< StaggeredKernels::Vec<W,N> >&>(s1),
+				       static_cast<const OLattice< StaggeredKernels::Vec<W,N> >&>(s2), s, r);
+
+    typename BinaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, OLattice< StaggeredKernels::Vec<W,N> >,
+      FnInnerProduct>::Type_t d;
+    d.elem().elem().elem().real() = r[0];
+    d.elem().elem().elem().imag() = r[1];
+    return d;
+  }
+
+  template<class W, int N>
+  typename BinaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, OLattice< StaggeredKernels::Vec<W,N> >,
+			FnInnerProduct>::Type_t
+  innerProduct(const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s1,
+	       const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s2)
+  {
+    return innerProduct(s1, s2, all);
+  }
+
+  //! Re <x,y> on s of staggered fields, summed in REAL64
+  template<class W, int N>
+  typename BinaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, OLattice< StaggeredKernels::Vec<W,N> >,
+			FnInnerProductReal>::Type_t
+  innerProductReal(const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s1,
+		   const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s2,
+		   const Subset& s)
+  {
+    QDP_KERNEL_SELECTED("staggered innerProductReal");
+    REAL64 r[2];
+    StaggeredKernels::reduce<W,N,false>(static_cast<const OLattice< StaggeredKernels::Vec<W,N> >&>(s1),
+					static_cast<const OLattice< StaggeredKernels::Vec<W,N> >&>(s2), s, r);
+
+    typename BinaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, OLattice< StaggeredKernels::Vec<W,N> >,
+      FnInnerProductReal>::Type_t d;
+    d.elem().elem().elem().elem() = r[0];
+    return d;
+  }
+
+  template<class W, int N>
+  typename BinaryReturn<OLattice< StaggeredKernels::Vec<W,N> >, OLattice< StaggeredKernels::Vec<W,N> >,
+			FnInnerProductReal>::Type_t
+  innerProductReal(const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s1,
+		   const QDPType<StaggeredKernels::Vec<W,N>, OLattice< StaggeredKernels::Vec<W,N> > >& s2)
+  {
+    return innerProductReal(s1, s2, all);
+  }
+
+
+  //! d = eta u x on s: a link times a staggered vector with the phase of the site
+  template<class W, int N>
+  void phasedMultiply(OLattice< StaggeredKernels::Vec<W,N> >& d,
+		      const OLattice< StaggeredKernels::Real<W> >& eta,
+		      const OLattice< StaggeredKernels::Link<W,N> >& u,
+		      const OLattice< StaggeredKernels::Vec<W,N> >& x, const Subset& s)
+  {
+    StaggeredKernels::link<W,N,false,false>(d, W(1), eta, u, x, s);
+  }
+
+  //! d = eta adj(u) x on s
+  template<class W, int N>
+  void phasedAdjMultiply(OLattice< StaggeredKernels::Vec<W,N> >& d,
+			 const OLattice< StaggeredKernels::Real<W> >& eta,
+			 const OLattice< StaggeredKernels::Link<W,N> >& u,
+			 const OLattice< StaggeredKernels::Vec<W,N> >& x, const Subset& s)
+  {
+    StaggeredKernels::link<W,N,true,false>(d, W(1), eta, u, x, s);
+  }
+
+  //! d += a eta u x on s
+  /*! With a = +1 or -1 for the forward and backward hops */
+  template<class W, int N, class S>
+  void phasedMultiplyAdd(OLattice< StaggeredKernels::Vec<W,N> >& d, const OScalar<S>& a,
+			 const OLattice< StaggeredKernels::Real<W> >& eta,
+			 const OLattice< StaggeredKernels::Link<W,N> >& u,
+			 const OLattice< StaggeredKernels::Vec<W,N> >& x, const Subset& s)
+  {
+    StaggeredKernels::link<W,N,false,true>(d, W(toDouble(a)), eta, u, x, s);
+  }
+
+  //! d += a eta adj(u) x on s
+  template<class W, int N, class S>
+  void phasedAdjMultiplyAdd(OLattice< StaggeredKernels::Vec<W,N> >& d, const OScalar<S>& a,
+			    const OLattice< StaggeredKernels::Real<W> >& eta,
+			    const OLattice< StaggeredKernels::Link<W,N> >& u,
+			    const OLattice< StaggeredKernels::Vec<W,N> >& x, const Subset& s)
+  {
+    StaggeredKernels::link<W,N,true,true>(d, W(toDouble(a)), eta, u, x, s);
+  }
+
+
+  //! The staggered phase eta_mu(x) = (-1)^(x_0 + ... + x_(mu-1))
+  inline LatticeReal staggeredPhase(int mu)
+  {
+    LatticeInteger n = zero;
+    for(int nu=0; nu < mu; ++nu)
+      n += Layout::latticeCoordinate(nu);
+
+    LatticeReal eta = where((n & 1) == 0, LatticeReal(1), LatticeReal(-1));
+    return eta;
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
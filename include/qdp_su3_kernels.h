@@ -0,0 +1,519 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Exponentials and projections of SU(3) fields, one sweep each
+ */
+
+#ifndef QDP_SU3_KERNELS_H
+#define QDP_SU3_KERNELS_H
+
+#include <cmath>
+
+namespace QDP
+{
+
+  /** \addtogroup group3
+   *  @{
+   */
+
+  namespace SU3Internal
+  {
+    //! A 3x3 complex matrix worked on in double precision
+    struct M3
+    {
+      double re[3][3], im[3][3];
+
+      template<class T>
+      void load(const PColorMatrix<RComplex<T>,Nc>& a)
+	{
+	  for(int i=0; i < 3; ++i)
+	    for(int j=0; j < 3; ++j)
+	    {
+	      re[i][j] = a.elem(i,j).real();
+	      im[i][j] = a.elem(i,j).imag();
+	    }
+	}
+
+      template<class T>
+      void store(PColorMatrix<RComplex<T>,Nc>& a) const
+	{
+	  for(int i=0; i < 3; ++i)
+	    for(int j=0; j < 3; ++j)
+	    {
+	      a.elem(i,j).real() = T(re[i][j]);
+	      a.elem(i,j).imag() = T(im[i][j]);
+	    }
+	}
+    };
+
+    //! c = a * b
+    inline void mult(M3& c, const M3& a, const M3& b)
+    {
+      for(int i=0; i < 3; ++i)
+	for(int j=0; j < 3; ++j)
+	{
+	  double r = 0, s = 0;
+	  for(int k=0; k < 3; ++k)
+	  {
+	    r += a.re[i][k]*b.re[k][j] - a.im[i][k]*b.im[k][j];
+	    s += a.re[i][k]*b.im[k][j] + a.im[i][k]*b.re[k][j];
+	  }
+	  c.re[i][j] = r;
+	  c.im[i][j] = s;
+	}
+    }
+
+    //! The determinant of a
+    inline void det(double& dr, double& di, const M3& a)
+    {
+      dr = di = 0;
+      for(int j=0; j < 3; ++j)
+      {
+	const int j1 = (j+1) % 3, j2 = (j+2) % 3;
+
+	// a(1,j1) a(2,j2) - a(1,j2) a(2,j1)
+	double mr = (a.re[1][j1]*a.re[2][j2] - a.im[1][j1]*a.im[2][j2]) - (a.re[1][j2]*a.re[2][j1] - a.im[1][j2]*a.im[2][j1]);
+	double mi = (a.re[1][j1]*a.im[2][j2] + a.im[1][j1]*a.re[2][j2]) - (a.re[1][j2]*a.im[2][j1] + a.im[1][j2]*a.re[2][j1]);
+	dr += a.re[0][j]*mr - a.im[0][j]*mi;
+	di += a.re[0][j]*mi + a.im[0][j]*mr;
+      }
+    }
+
+    //! Column k of a is the complex conjugate of the cross product of columns i and j
+    inline void crossColumns(M3& a, int i, int j, int k)
+    {
+      for(int r=0; r < 3; ++r)
+      {
+	const int r1 = (r+1) % 3, r2 = (r+2) % 3;
+	a.re[r][k] =   (a.re[r1][i]*a.re[r2][j] - a.im[r1][i]*a.im[r2][j]) - (a.re[r2][i]*a.re[r1][j] - a.im[r2][i]*a.im[r1][j]);
+	a.im[r][k] = -((a.re[r1][i]*a.im[r2][j] + a.im[r1][i]*a.re[r2][j]) - (a.re[r2][i]*a.im[r1][j] + a.im[r2][i]*a.re[r1][j]));
+      }
+    }
+
+    //! sin(w)/w
+    inline double sinc(double w)
+    {
+      if (std::fabs(w) > 0.05)
+	return std::sin(w) / w;
+
+      const double w2 = w*w;
+      return 1 - w2/6*(1 - w2/20*(1 - w2/42));
+    }
+
+    //! e = exp(i q) for hermitian traceless q
+    /*!
+     * Cayley-Hamilton, as in Morningstar and Peardon, hep-lat/0311018:
+     * exp(iQ) = f0 + f1 Q + f2 Q^2 with the f_j given by the invariants
+     * c0 = det Q and c1 = tr Q^2 / 2.
+     */
+    inline void expiQ(M3& e, const M3& q)
+    {
+      M3 q2;
+      mult(q2, q, q);
+
+      double c0 = 0, c1 = 0;
+      for(int i=0; i < 3; ++i)
+      {
+	c1 += q2.re[i][i];
+	for(int k=0; k < 3; ++k)
+	  c0 += q.re[i][k]*q2.re[k][i] - q.im[i][k]*q2.im[k][i];
+      }
+      c0 /= 3;
+      c1 /= 2;
+
+      double f0r, f0i, f1r, f1i, f2r, f2i;
+
+      if (c1 < 1.0e-14)
+      {
+	// exp(iQ) = 1 + iQ - Q^2/2 + ..., the rest below rounding
+	f0r = 1;   f0i = 0;
+	f1r = 0;   f1i = 1;
+	f2r = -0.5; f2i = 0;
+      }
+      else
+      {
+	// f_j(-c0) = (-1)^j conj(f_j(c0))
+	const bool neg = c0 < 0;
+	const double c0max = 2 * c1/3 * std::sqrt(c1/3);
+	const double theta = std::acos(std::min(1.0, std::fabs(c0) / c0max));
+	const double u = std::sqrt(c1/3) * std::cos(theta/3);
+	const double w = std::sqrt(c1) * std::sin(theta/3);
+
+	const double u2 = u*u, w2 = w*w;
+	const double cw = std::cos(w), xi = sinc(w);
+	const double c2u = std::cos(2*u), s2u = std::sin(2*u);
+	const double cu = std::cos(u), su = std::sin(u);
+
+	// h_j = e^{2iu} a_j + e^{-iu} b_j
+	const double b0r = 8*u2*cw, b0i = 2*u*(3*u2 + w2)*xi;
+	const double b1r = -2*u*cw, b1i = (3*u2 - w2)*xi;
+	const double b2r = -cw,     b2i = -3*u*xi;
+
+	const double h0r = (u2 - w2)*c2u + (cu*b0r + su*b0i);
+	const double h0i = (u2 - w2)*s2u + (cu*b0i - su*b0r);
+	const double h1r = 2*u*c2u + (cu*b1r + su*b1i);
+	const double h1i = 2*u*s2u + (cu*b1i - su*b1r);
+	const double h2r = c2u + (cu*b2r + su*b2i);
+	const double h2i = s2u + (cu*b2i - su*b2r);
+
+	const double rd = 1 / (9*u2 - w2);
+	f0r = h0r*rd; f0i = h0i*rd;
+	f1r = h1r*rd; f1i = h1i*rd;
+	f2r = h2r*rd; f2i = h2i*rd;
+
+	if (neg)
+	{
+	  f0i = -f0i;
+	  f1r = -f1r;
+	  f2i = -f2i;
+	}
+      }
+
+      for(int i=0; i < 3; ++i)
+	for(int j=0; j < 3; ++j)
+	{
+	  e.re[i][j] = (f1r*q.re[i][j] - f1i*q.im[i][j]) + (f2r*q2.re[i][j] - f2i*q2.im[i][j]);
+	  e.im[i][j] = (f1r*q.im[i][j] + f1i*q.re[i][j]) + (f2r*q2.im[i][j] + f2i*q2.re[i][j]);
+	}
+      for(int i=0; i < 3; ++i)
+      {
+	e.re[i][i] += f0r;
+	e.im[i][i] += f0i;
+      }
+    }
+
+    //! Gram-Schmidt on the first two columns of a, the third their conjugate cross product
+    inline void reunit(M3& a)
+    {
+      double n = 0;
+      for(int r=0; r < 3; ++r)
+	n += a.re[r][0]*a.re[r][0] + a.im[r][0]*a.im[r][0];
+      n = 1 / std::sqrt(n);
+      for(int r=0; r < 3; ++r)
+      {
+	a.re[r][0] *= n;
+	a.im[r][0] *= n;
+      }
+
+      // v <- v - (u^dag v) u
+      double tr = 0, ti = 0;
+      for(int r=0; r < 3; ++r)
+      {
+	tr += a.re[r][0]*a.re[r][1] + a.im[r][0]*a.im[r][1];
+	ti += a.re[r][0]*a.im[r][1] - a.im[r][0]*a.re[r][1];
+      }
+      n = 0;
+      for(int r=0; r < 3; ++r)
+      {
+	a.re[r][1] -= tr*a.re[r][0] - ti*a.im[r][0];
+	a.im[r][1] -= tr*a.im[r][0] + ti*a.re[r][0];
+	n += a.re[r][1]*a.re[r][1] + a.im[r][1]*a.im[r][1];
+      }
+      n = 1 / std::sqrt(n);
+      for(int r=0; r < 3; ++r)
+      {
+	a.re[r][1] *= n;
+	a.im[r][1] *= n;
+      }
+
+      crossColumns(a, 0, 1, 2);
+    }
+
+    //! The SU(3) matrix nearest a: its unitary polar factor with the phase of the determinant divided out
+    /*!
+     * The polar factor comes from scaled Newton iterations
+     * u <- (g u + (g u)^{-dag}) / 2, g = |det u|^{-1/3}, which converge
+     * quadratically; nearly unitary a take two or three.
+     */
+    inline void projectSU3(M3& a)
+    {
+      for(int iter=0; iter < 100; ++iter)
+      {
+	double dr, di;
+	det(dr, di, a);
+	const double d2 = dr*dr + di*di;
+	if (d2 == 0)
+	  break;
+	const double g = std::pow(d2, -1.0/6);
+
+	// (g a)^{-dag} = conj(cofactors) / (g conj(det)), cofactors of a
+	M3 b;
+	for(int i=0; i < 3; ++i)
+	  for(int j=0; j < 3; ++j)
+	  {
+	    const int i1 = (i+1) % 3, i2 = (i+2) % 3, j1 = (j+1) % 3, j2 = (j+2) % 3;
+	    double cr = (a.re[i1][j1]*a.re[i2][j2] - a.im[i1][j1]*a.im[i2][j2]) - (a.re[i1][j2]*a.re[i2][j1] - a.im[i1][j2]*a.im[i2][j1]);
+	    double ci = (a.re[i1][j1]*a.im[i2][j2] + a.im[i1][j1]*a.re[i2][j2]) - (a.re[i1][j2]*a.im[i2][j1] + a.im[i1][j2]*a.re[i2][j1]);
+
+	    // conj(c / det) / g
+	    const double qr = (cr*dr + ci*di) / (d2*g);
+	    const double qi = (ci*dr - cr*di) / (d2*g);
+	    b.re[i][j] = qr;
+	    b.im[i][j] = -qi;
+	  }
+
+	double change = 0;
+	for(int i=0; i < 3; ++i)
+	  for(int j=0; j < 3; ++j)
+	  {
+	    const double nr = 0.5*(g*a.re[i][j] + b.re[i][j]);
+	    const double ni = 0.5*(g*a.im[i][j] + b.im[i][j]);
+	    change += (nr - a.re[i][j])*(nr - a.re[i][j]) + (ni - a.im[i][j])*(ni - a.im[i][j]);
+	    a.re[i][j] = nr;
+	    a.im[i][j] = ni;
+	  }
+
+	if (change < 1.0e-28)
+	  break;
+      }
+
+      double dr, di;
+      det(dr, di, a);
+      const double phi = std::atan2(di, dr) / 3;
+      const double pr = std::cos(phi), pi = -std::sin(phi);
+      for(int i=0; i < 3; ++i)
+	for(int j=0; j < 3; ++j)
+	{
+	  const double r = a.re[i][j];
+	  a.re[i][j] = r*pr - a.im[i][j]*pi;
+	  a.im[i][j] = r*pi + a.im[i][j]*pr;
+	}
+    }
+
+
+    //! dest = exp(i src)
+    struct OpExpiQ
+    {
+      enum {SU3 = 1};
+
+      template<class T>
+      static void apply(PColorMatrix<RComplex<T>,Nc>& dest, const PColorMatrix<RComplex<T>,Nc>& src)
+	{
+	  M3 q, e;
+	  q.load(src);
+	  expiQ(e, q);
+	  e.store(dest);
+	}
+    };
+
+    //! dest = exp(i src) dest
+    struct OpMultiplyExpiQ
+    {
+      enum {SU3 = 1};
+
+      template<class T>
+      static void apply(PColorMatrix<RComplex<T>,Nc>& dest, const PColorMatrix<RComplex<T>,Nc>& src)
+	{
+	  M3 q, e, u, v;
+	  q.load(src);
+	  u.load(dest);
+	  expiQ(e, q);
+	  mult(v, e, u);
+	  v.store(dest);
+	}
+    };
+
+    //! dest = reunitarized src
+    struct OpReunit
+    {
+      enum {SU3 = 1};
+
+      template<class T>
+      static void apply(PColorMatrix<RComplex<T>,Nc>& dest, const PColorMatrix<RComplex<T>,Nc>& src)
+	{
+	  M3 a;
+	  a.load(src);
+	  reunit(a);
+	  a.store(dest);
+	}
+    };
+
+    //! dest = SU(3) projection of src
+    struct OpProjectSU3
+    {
+      enum {SU3 = 1};
+
+      template<class T>
+      static void apply(PColorMatrix<RComplex<T>,Nc>& dest, const PColorMatrix<RComplex<T>,Nc>& src)
+	{
+	  M3 a;
+	  a.load(src);
+	  projectSU3(a);
+	  a.store(dest);
+	}
+    };
+
+    //! dest = (src - src^dag)/2 less its trace, for any Nc
+    struct OpProjectTA
+    {
+      enum {SU3 = 0};
+
+      template<class T>
+      static void apply(PColorMatrix<RComplex<T>,Nc>& dest, const PColorMatrix<RComplex<T>,Nc>& src)
+	{
+	  PColorMatrix<RComplex<T>,Nc> a;
+	  T tr = 0;
+	  for(int i=0; i < Nc; ++i)
+	  {
+	    for(int j=0; j < Nc; ++j)
+	    {
+	      a.elem(i,j).real() = T(0.5)*(src.elem(i,j).real() - src.elem(j,i).real());
+	      a.elem(i,j).imag() = T(0.5)*(src.elem(i,j).imag() + src.elem(j,i).imag());
+	    }
+	    tr += a.elem(i,i).imag();
+	  }
+	  tr /= T(Nc);
+	  for(int i=0; i < Nc; ++i)
+	    a.elem(i,i).imag() -= tr;
+	  dest = a;
+	}
+    };
+
+
+    //! user argument for siteKernel
+    template<class Op, class RHS, class T>
+    struct SiteArgs
+    {
+      typedef PScalar< PColorMatrix< RComplex<T>, Nc> >  Link_t;
+
+      SiteArgs(Link_t* d_, const QDPExpr<RHS,OLattice<Link_t> >& s_) : d(d_), s(s_) {}
+
+      Link_t* d;
+      const QDPExpr<RHS,OLattice<Link_t> >& s;
+    };
+
+    //! user function applying Op to every site in [lo,hi)
+    template<class Op, class RHS, class T>
+    void siteKernel(int lo, int hi, int myId, SiteArgs<Op,RHS,T>* a)
+    {
+      typedef typename SiteArgs<Op,RHS,T>::Link_t  Link_t;
+      for(int i=lo; i < hi; ++i)
+      {
+	Link_t v = forEach(a->s, EvalLeaf1(i), OpCombine());
+	Op::apply(a->d[i].elem(), v.elem());
+      }
+    }
+
+    //! Apply Op to every site of dest, the expression s evaluated at the site
+    template<class Op, class RHS, class T>
+    void sweep(const char* name, OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& dest,
+	       const QDPExpr<RHS,OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > > >& s)
+    {
+      if (Op::SU3 && Nc != 3)
+	QDP_error_exit("%s: needs Nc = 3, have %d", name, Nc);
+
+      SiteArgs<Op,RHS,T> args(dest.getF(), s);
+      startShifts(s);
+      dispatch_to_threads(Layout::sitesOnNode(), args, siteKernel<Op,RHS,T>);
+    }
+  }
+
+
+  //! e = exp(i q) for a hermitian traceless q, exactly, in one sweep
+  /*!
+   * By the Cayley-Hamilton theorem, as in hep-lat/0311018, each site
+   * worked on in double precision. q may be any expression, e.g.
+   * expiQ(e, Real(eps)*p), and may be e itself.
+   */
+  template<class RHS, class T>
+  void expiQ(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& e,
+	     const QDPExpr<RHS,OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > > >& q)
+  {
+    SU3Internal::sweep<SU3Internal::OpExpiQ>("expiQ", e, q);
+  }
+
+  //! e = exp(i q) for a hermitian traceless lattice field q
+  template<class T>
+  void expiQ(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& e,
+	     const OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& q)
+  {
+    expiQ(e, PETE_identity(q));
+  }
+
+  //! u = exp(i q) u for a hermitian traceless q, the update of links in a molecular dynamics step
+  template<class RHS, class T>
+  void multiplyExpiQ(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& u,
+		     const QDPExpr<RHS,OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > > >& q)
+  {
+    SU3Internal::sweep<SU3Internal::OpMultiplyExpiQ>("multiplyExpiQ", u, q);
+  }
+
+  //! u = exp(i q) u for a hermitian traceless lattice field q
+  template<class T>
+  void multiplyExpiQ(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& u,
+		     const OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& q)
+  {
+    multiplyExpiQ(u, PETE_identity(q));
+  }
+
+  //! Reunitarize u to SU(3) in place
+  /*!
+   * Normalises the first column, orthogonalises and normalises the
+   * second and makes the third the conjugate of their cross product,
+   * as reunit does with REUNITARIZE, in one sweep.
+   */
+  template<class T>
+  void reunitarize(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& u)
+  {
+    SU3Internal::sweep<SU3Internal::OpReunit>("reunitarize", u, PETE_identity(u));
+  }
+
+  //! dest = the SU(3) matrix nearest to w at each site
+  /*!
+   * The unitary factor of the polar decomposition of w, with the phase
+   * of its determinant divided out, as used to project smeared links.
+   * Unlike reunitarize it does not favour any column.
+   */
+  template<class RHS, class T>
+  void projectSU3(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& dest,
+		  const QDPExpr<RHS,OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > > >& w)
+  {
+    SU3Internal::sweep<SU3Internal::OpProjectSU3>("projectSU3", dest, w);
+  }
+
+  //! dest = the SU(3) matrix nearest to the lattice field w at each site
+  template<class T>
+  void projectSU3(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& dest,
+		  const OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& w)
+  {
+    projectSU3(dest, PETE_identity(w));
+  }
+
+  //! Project u onto SU(3) in place
+  template<class T>
+  void projectSU3(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& u)
+  {
+    projectSU3(u, PETE_identity(u));
+  }
+
+  //! dest = the traceless antihermitian part of a, (a - a^dag)/2 - tr/Nc
+  /*!
+   * As taproj, in one sweep, for any Nc.
+   */
+  template<class RHS, class T>
+  void projectTA(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& dest,
+		 const QDPExpr<RHS,OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > > >& a)
+  {
+    SU3Internal::sweep<SU3Internal::OpProjectTA>("projectTA", dest, a);
+  }
+
+  //! dest = the traceless antihermitian part of the lattice field a
+  template<class T>
+  void projectTA(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& dest,
+		 const OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& a)
+  {
+    projectTA(dest, PETE_identity(a));
+  }
+
+  //! Take the traceless antihermitian part of a in place
+  template<class T>
+  void projectTA(OLattice<PScalar<PColorMatrix<RComplex<T>,Nc> > >& a)
+  {
+    projectTA(a, PETE_identity(a));
+  }
+
+  /** @} */ // end of group3
+
+} // namespace QDP
+
+#endif
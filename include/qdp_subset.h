@@ -6,6 +6,10 @@
 #ifndef QDP_SUBSET_H
 #define QDP_SUBSET_H
 
+#include <atomic>
+#include <algorithm>
+#include <string>
+
 namespace QDP {
 
 /*! @defgroup subsets Sets and Subsets
@@ -27,8 +31,149 @@ public:
   virtual ~SetFunc() {}
   virtual int operator() (const multi1d<int>& coordinate) const = 0;
   virtual int numSubsets() const = 0;
+
+  //! Same coloring on a coordinate that needs no heap allocation
+  /*! Set::make calls this one. The default hands a view of coordinate to the multi1d version */
+  virtual int operator() (const Layout::LatticeCoord& coordinate) const
+    {
+      multi1d<int> coord(const_cast<int*>(coordinate.data()), Nd);
+      return (*this)(coord);
+    }
+
+  //! Colors of the node sites lo .. hi-1 into color[0] .. color[hi-lo-1]
+  /*! Set::make calls this on the threads. The default calls the coordinate
+   *  version site by site; a coloring that can do a batch without a
+   *  virtual call per site overrides it */
+  virtual void colorSites(int lo, int hi, int* color) const
+    {
+      const int node = Layout::nodeNumber();
+      Layout::LatticeCoord coord;
+      for(int i=lo; i < hi; ++i)
+      {
+	Layout::siteCoords(node, i, coord);
+	color[i-lo] = (*this)(coord);
+      }
+    }
+
+  //! A name of the coloring, equal for SetFuncs coloring the lattice alike
+  /*! Set::make keeps the sets of named colorings until the layout changes
+   *  and copies them when asked again. Empty, the default, is never kept */
+  virtual std::string cacheKey() const {return std::string();}
+
+  //! The direction d when the subsets are the slices of coordinate d, else -1
+  /*! Subset k must then hold the sites with coordinate k in direction d.
+   *  Sums over such a set need only the nodes holding a slice, see sumMulti */
+  virtual int sliceDirection() const {return -1;}
+};
+
+//-----------------------------------------------------------------------
+//! Timeslices: the subset of a site is its coordinate in direction dir
+class SetTimeSliceFunc : public SetFunc
+{
+public:
+  SetTimeSliceFunc(int dir = Nd-1);
+
+  int operator() (const multi1d<int>& coordinate) const {return coordinate[dir];}
+  int operator() (const Layout::LatticeCoord& coordinate) const {return coordinate[dir];}
+  int numSubsets() const {return nslice;}
+  void colorSites(int lo, int hi, int* color) const;
+  std::string cacheKey() const;
+  int sliceDirection() const {return dir;}
+
+private:
+  int dir;
+  int nslice;
 };
 
+//! Red/black checkerboards by the parity of the sum of the first ndim coordinates
+class SetCheckerboardFunc : public SetFunc
+{
+public:
+  SetCheckerboardFunc(int ndim = Nd);
+
+  int operator() (const multi1d<int>& coordinate) const;
+  int operator() (const Layout::LatticeCoord& coordinate) const;
+  int numSubsets() const {return 2;}
+  void colorSites(int lo, int hi, int* color) const;
+  std::string cacheKey() const;
+
+private:
+  int ndim;
+};
+
+//! Blocks of block[mu] sites in each direction mu, numbered lexicographically, x fastest
+/*! For multigrid aggregates and momentum blocks. Each block edge must divide the lattice */
+class SetBlockFunc : public SetFunc
+{
+public:
+  SetBlockFunc(const multi1d<int>& block);
+
+  int operator() (const multi1d<int>& coordinate) const;
+  int operator() (const Layout::LatticeCoord& coordinate) const;
+  int numSubsets() const {return nblock;}
+  void colorSites(int lo, int hi, int* color) const;
+  std::string cacheKey() const;
+
+private:
+  multi1d<int> block;
+  multi1d<int> nblocks;   // blocks in each direction
+  int nblock;
+};
+
+//-----------------------------------------------------------------------
+//! A run of consecutive node sites of a subset
+struct SiteRun
+{
+  int site;   //!< first site of the run
+  int pos;    //!< position of that site in the site table
+};
+
+//! A run of consecutive node sites of one color of a Set
+struct ColorRun
+{
+  int site;   //!< first site of the run
+  int color;  //!< the subset it belongs to
+};
+
+//! Call f(site, n) on the runs of n consecutive sites at site table positions [lo,hi)
+/*! runs holds nruns runs and an end entry whose pos is the number of sites */
+template<class F>
+inline void forSiteRuns(const SiteRun* runs, int nruns, int lo, int hi, const F& f)
+{
+  if (lo >= hi)
+    return;
+
+  // The last run starting at or before lo
+  int r = std::upper_bound(runs, runs + nruns, lo,
+			   [](int p, const SiteRun& run) {return p < run.pos;}) - runs - 1;
+
+  for(int j=lo; j < hi; ++r)
+  {
+    const int stop = std::min(hi, runs[r+1].pos);
+    f(runs[r].site + (j - runs[r].pos), stop - j);
+    j = stop;
+  }
+}
+
+//! Call f(site, n, color) on the runs of one color covering the node sites [lo,hi)
+/*! runs holds nruns runs and an end entry whose site is the number of sites */
+template<class F>
+inline void forColorRuns(const ColorRun* runs, int nruns, int lo, int hi, const F& f)
+{
+  if (lo >= hi)
+    return;
+
+  int r = std::upper_bound(runs, runs + nruns, lo,
+			   [](int i, const ColorRun& run) {return i < run.site;}) - runs - 1;
+
+  for(int i=lo; i < hi; ++r)
+  {
+    const int stop = std::min(hi, runs[r+1].site);
+    f(i, stop - i, runs[r].color);
+    i = stop;
+  }
+}
+
 //-----------------------------------------------------------------------
 // Forward declaration
 class Set;
@@ -39,12 +184,13 @@ class Subset
 {
 public:
   //! There can be an empty constructor
-  Subset() {}
+  Subset() : numSites(0), sitetable(0), runtable(0), tiletable(0), built(true) {}
 
   //! Copy constructor
   Subset(const Subset& s):
     ordRep(s.ordRep), startSite(s.startSite), endSite(s.endSite), 
-    sub_index(s.sub_index), sitetable(s.sitetable), set(s.set)
+    sub_index(s.sub_index), numSites(s.numSites), sitetable(s.sitetable), runtable(s.runtable),
+    tiletable(s.tiletable), set(s.set), built(s.built.load())
     {}
 
   // Simple constructor
@@ -63,29 +209,81 @@ protected:
   // Simple constructor
   void make(bool rep, int start, int end, multi1d<int>* ind, int cb, Set* set);
 
+  //! Constructor from a run table, the site table ind is filled on first use
+  void make(multi1d<SiteRun>* runs, multi1d<int>* ind, int cb, Set* set);
+
 private:
+  //! Fill the site table from the runs
+  void buildSiteTable() const;
+
   bool ordRep;
   int startSite;
   int endSite;
   int sub_index;
+  int numSites;
 
-  //! Site lookup table
+  //! Site lookup table, empty until siteTable() when made from runs
   multi1d<int>* sitetable;
 
+  //! The runs of consecutive sites, null when made from a site table
+  multi1d<SiteRun>* runtable;
+
+  //! The site table ordered tile by tile, null when not tiled
+  multi1d<int>* tiletable;
+
   //! Original set
   Set *set;
 
+  //! Is the site table filled
+  mutable std::atomic<bool> built;
+
 public:
   inline bool hasOrderedRep() const {return ordRep;}
   inline int start() const {return startSite;}
   inline int end() const {return endSite;}
 
-  const multi1d<int>& siteTable() const {return *sitetable;}
-  inline int numSiteTable() const {return sitetable->size();}
+  //! Do site loops visit start() .. end() in memory order
+  /*! Then they may run over the range and skip the site table */
+  inline bool isContiguous() const {return ordRep && ! tiletable;}
+
+  //! May site loops go run by run, as they do unless the sites are tiled
+  inline bool loopsByRuns() const {return runtable && ! tiletable;}
+
+  //! The sites of the subset in order
+  /*! A subset made from runs fills it on the first call */
+  const multi1d<int>& siteTable() const
+    {
+      if (! built.load(std::memory_order_acquire))
+	buildSiteTable();
+      return *sitetable;
+    }
+
+  inline int numSiteTable() const {return numSites;}
+
+  //! Has the subset a run table
+  inline bool hasRuns() const {return runtable != 0;}
+
+  //! The runs of consecutive sites in site table order, and an end entry
+  /*! The end entry has pos == numSiteTable(). Only when hasRuns() */
+  const multi1d<SiteRun>& runTable() const {return *runtable;}
+
+  //! Number of runs
+  inline int numRuns() const {return runtable ? runtable->size() - 1 : 0;}
+
+  //! The sites of siteTable() in the order site loops should visit them
+  /*!
+   * With Layout::setSiteTiling() on, the sites of each cache sized
+   * tile of the local lattice come together, otherwise this is the
+   * site table. Either way it holds numSiteTable() sites.
+   */
+  const multi1d<int>& traversalTable() const {return tiletable ? *tiletable : siteTable();}
 
   //! The super-set of this subset
   const Set& getSet() const { return *set; }
 
+  //! Is the subset one of a set, false for a bare list of sites
+  bool hasSet() const { return set != 0; }
+
   friend class Set;
 };
 
@@ -96,10 +294,10 @@ class Set
 {
 public:
   //! There can be an empty constructor
-  Set() {}
+  Set() : stamp(0), slicedir(-1) {}
 
   //! Constructor from a function object
-  Set(const SetFunc& fn) {make(fn);}
+  Set(const SetFunc& fn) : stamp(0), slicedir(-1) {make(fn);}
 
   //! Constructor from a function object
   void make(const SetFunc& fn);
@@ -116,23 +314,91 @@ public:
   //! The = operator
   Set& operator=(const Set& s);
 
+  //! Forget the sets kept for SetFuncs with a cacheKey
+  /*! Done when the layout is made. The subsets of sets made from kept
+   *  ones use their site tables, so such sets go out of use with them */
+  static void clearCache();
+
+  //! Number of sets kept for SetFuncs with a cacheKey
+  static int numCached();
+
+  //! The sites in both a and b, or in either, made on first use and kept
+  /*! Use a & b and a | b */
+  static const Subset& combine(const Subset& a, const Subset& b, bool both);
+
 protected:
+  //! Color the sites with fn and make the subsets, bypassing the cache
+  void build(const SetFunc& fn);
+
+  //! Make the subsets of the colors in lat_color, cut into runs of consecutive sites
+  void makeRuns(int nsubset_indices);
+
+  //! Order the sites of the subsets tile by tile when Layout::siteTiling is on
+  void makeTiles(int nsubset_indices);
+
   //! A set is composed of an array of subsets
   multi1d<Subset> sub;
 
   //! Index or color array of lattice
   multi1d<int> lat_color;
 
-  //! Array of sitetable arrays
+  //! Array of sitetable arrays, filled on first use
   multi1d<multi1d<int> > sitetables;
 
+  //! Array of the run tables of the subsets
+  multi1d<multi1d<SiteRun> > runtables;
+
+  //! The runs of all colors in site order
+  multi1d<ColorRun> colorruns;
+
+  //! Position of each node site in the site table of its subset
+  multi1d<int> sitepos;
+
+  //! The sitetables ordered tile by tile, empty when not tiled
+  multi1d<multi1d<int> > tiletables;
+
+  //! Tells the colorings of sets apart, new with each makeRuns and copied with the set
+  unsigned long stamp;
+
+  //! SetFunc::sliceDirection of the coloring
+  int slicedir;
+
 public:
   //! The coloring of the lattice sites
   const multi1d<int>& latticeColoring() const {return lat_color;}
+
+  //! The runs of one color covering the node sites in order, and an end entry
+  /*! The end entry has site == the number of sites on the node. Empty when the
+   *  architecture builds no runs */
+  const multi1d<ColorRun>& colorRuns() const {return colorruns;}
+
+  //! Position of each node site in the site table of its subset
+  /*! Site i of a field stored compactly on the subset of its color is
+   *  element sitePositions()[i], see OSubLattice */
+  const multi1d<int>& sitePositions() const {return sitepos;}
+
+  //! The direction the subsets slice the lattice in, -1 if they do not
+  int sliceDirection() const {return slicedir;}
+
+  friend class LatticeLayout;
 };
 
 
 
+//-----------------------------------------------------------------------
+//! The sites in both a and b
+/*!
+ * Such as the even sites of a timeslice, rb[0] & timeslices[t]. The
+ * subset is made once for the colorings of the two sets, with its own
+ * runs, site table and cached thread partitions, and later calls return
+ * it again. a and b must be subsets of sets on the same lattice.
+ */
+inline Subset operator&(const Subset& a, const Subset& b) {return Set::combine(a, b, true);}
+
+//! The sites in a or b or both, kept like those of operator&
+inline Subset operator|(const Subset& a, const Subset& b) {return Set::combine(a, b, false);}
+
+
 //-----------------------------------------------------------------------
 //! Default all subset
 extern Subset all;
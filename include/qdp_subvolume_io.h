@@ -0,0 +1,103 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Writing and reading a box of sites straight from the nodes holding them
+ */
+
+#ifndef QDP_SUBVOLUME_IO_H
+#define QDP_SUBVOLUME_IO_H
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace QDP
+{
+  /*! @addtogroup io
+   *
+   * @{
+   */
+
+  //--------------------------------------------------------------------------------
+  //! A box of the lattice written and read by the nodes holding its sites
+  /*!
+    The box runs from lower_left to upper_right inclusive in every
+    direction, as for the hyperslab QDPFileWriter::write. In the file it
+    is lex ordered with x fastest and big-endian, so a box of whole time
+    slices is laid out as TimeSliceIO and AsyncTimeSliceReader expect.
+
+    Each node puts the sites it holds straight at their offsets with
+    pwrite, or takes them with pread; a node without sites of the box
+    does not open the file. Nothing goes through the primary node, so
+    the time taken follows the size of the box, not of the lattice. The
+    file must be visible to all nodes.
+
+    write() and read() are collective only to add up the checksum of the
+    box, one global sum of a checksum for each piece of an x-row.
+
+      SubvolumeIO sink = SubvolumeIO::timeSlices(t0, t0+2);
+      for(int i=0; i < nvec; ++i)
+        sink.write("prop.bin", chi[i], i*sink.bytes(chi[i]));
+  */
+  class SubvolumeIO
+  {
+  public:
+    //! The box from lower_left to upper_right
+    SubvolumeIO(const multi1d<int>& lower_left, const multi1d<int>& upper_right);
+
+    //! The time slices t0 to t1
+    static SubvolumeIO timeSlices(int t0, int t1);
+
+    //! Sites in the box
+    size_t volume() const {return box_vol;}
+
+    //! Sites of the box on this node
+    size_t localVolume() const {return sites.size();}
+
+    //! Bytes the box of a field takes in the file
+    template<class T>
+    size_t bytes(const OLattice<T>& d) const {return box_vol*sizeof(T);}
+
+    //! Write the box of d to the file from offset start
+    /*! Collective. Returns the checksum of the bytes written */
+    template<class T>
+    QDPUtil::n_uint32_t write(const std::string& path, const OLattice<T>& d, off_t start=0) const
+      {
+	typedef typename WordType<T>::Type_t W;
+	return writeSites(path, (const char*)d.getF(), sizeof(W), sizeof(T)/sizeof(W), start);
+      }
+
+    //! Read the box of d from the file at offset start
+    /*! Collective. Sites outside the box are left alone. Returns the checksum of the bytes read */
+    template<class T>
+    QDPUtil::n_uint32_t read(const std::string& path, OLattice<T>& d, off_t start=0) const
+      {
+	typedef typename WordType<T>::Type_t W;
+	return readSites(path, (char*)writable(d).getF(), sizeof(W), sizeof(T)/sizeof(W), start);
+      }
+
+  private:
+    QDPUtil::n_uint32_t writeSites(const std::string& path, const char* data,
+				   size_t size, size_t nmemb, off_t start) const;
+    QDPUtil::n_uint32_t readSites(const std::string& path, char* data,
+				  size_t size, size_t nmemb, off_t start) const;
+
+    //! Checksum of the box from the crc of every piece, over all nodes
+    QDPUtil::n_uint32_t combine(std::vector<unsigned int>& crcs, size_t sizemem) const;
+
+    multi1d<int> lo, hi;
+    size_t box_vol;
+    int nseg;                     // pieces of an x-row, cut where node subgrids start
+    std::vector<int> seg_len;     // sites in each piece of a row
+
+    std::vector<int> sites;       // linear index of the sites here, in file order
+    std::vector<size_t> runs;     // box index of the first site of each piece here
+    std::vector<int> run_id;      // piece number of each, row*nseg + piece in the row
+    std::vector<int> run_len;     // sites in each
+  };
+
+  /*! @} */   // end of group io
+
+} // namespace QDP
+
+#endif
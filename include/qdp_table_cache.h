@@ -0,0 +1,70 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief On-disk cache of the layout, set and map tables of identical jobs
+ *
+ * Layout::create tabulates the site ordering of the node, colors the
+ * sites of the default sets and builds the tables of the shift maps,
+ * each a sweep over the node sites with a coordinate computation per
+ * site. A campaign runs the same lattice on the same node grid
+ * thousands of times. With a cache directory given (-table-cache or
+ * TableCache::setDirectory) every node writes its tables at the first
+ * create into a file named by a hash of the geometry, and later jobs
+ * map that file and copy the tables from it instead.
+ *
+ * A file is used only when its header repeats the geometry of the job
+ * exactly, and each table only when its length and crc32 check out.
+ * Anything else is ignored and the file written again. Tables cached
+ * are the layout site tables, the colorings of sets whose SetFunc has
+ * a cacheKey (which includes rb, rb3, mcb and all) and the maps that
+ * are fixed displacements, like shift. Tables made after create are
+ * added to the file at QDP_finalize.
+ */
+
+#ifndef QDP_TABLE_CACHE_H
+#define QDP_TABLE_CACHE_H
+
+#include <string>
+#include <vector>
+
+namespace QDP
+{
+  class MapFunc;
+
+  namespace TableCache
+  {
+    //! Keep the tables in files under dir, empty to turn the cache off (the default)
+    void setDirectory(const std::string& dir);
+
+    //! The cache directory, empty when off
+    const std::string& directory();
+
+    //! Is the cache on and open for a layout
+    bool active();
+
+    //! Open the file of this node for the geometry, called by Layout::create
+    /*! The geometry lists everything the tables depend on; the file is
+     *  named by its hash and holds it for checking */
+    void open(const std::vector<int>& geometry);
+
+    //! Write the file when tables were kept that it did not have
+    /*! Called at the end of Layout::create and by QDP_finalize */
+    void flush();
+
+    //! Copy the table name into t, false when the file has no valid one
+    bool load(const std::string& name, multi1d<int>& t);
+
+    //! Keep t under name, written at the next flush
+    void store(const std::string& name, const multi1d<int>& t);
+
+    //! The name of the tables of a map, empty when the map is not a fixed displacement
+    std::string mapKey(const MapFunc& func);
+
+    //! Tables loaded and stored since open
+    int numLoaded();
+    int numStored();
+  }
+
+} // namespace QDP
+
+#endif
@@ -0,0 +1,125 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Per-thread timing of the parallel regions
+ */
+
+#ifndef QDP_THREAD_REPORT_H
+#define QDP_THREAD_REPORT_H
+
+#include <string>
+#include <typeinfo>
+
+namespace QDP
+{
+  namespace ThreadReport
+  {
+    //! Time every thread of every dispatch_to_threads. Off by default
+    /*!
+     * Each dispatch records when it forks, when every thread starts and
+     * ends its share, and when it joins. The times are summed per region:
+     * per expression inside evaluate, per kernel otherwise.
+     */
+    void setEnabled(bool on);
+
+    //! Are the dispatches timed
+    bool enabled();
+
+    //! The times of one kind of parallel region, summed over its calls
+    /*!
+     * busy is the time a thread spends in its share; the least, mean and
+     * most busy thread of each call are summed. fork runs until the last
+     * thread starts and join from the last thread ending.
+     */
+    struct Region
+    {
+      std::string name;
+      unsigned long calls;
+      unsigned long sites;      // or runs of sites, as handed to the threads
+      QDPTime_t wall;
+      QDPTime_t busy_min;
+      QDPTime_t busy_mean;
+      QDPTime_t busy_max;
+      QDPTime_t fork;
+      QDPTime_t join;
+    };
+
+    //! The region named name, made on first use
+    Region* region(const std::string& name);
+
+    //! The region of an expression, named by the types of op and rhs
+    Region* region(const std::type_info& op, const std::type_info& rhs);
+
+    //! The region of the kernels taking a user argument of type arg
+    Region* region(const std::type_info& arg);
+
+    //! The region of evaluates of rhs with op, null when not timing
+    template<class Op, class RHS>
+    inline Region* exprRegion(const Op&, const RHS&)
+    {
+      if (! enabled())
+	return 0;
+
+      static Region* r = region(typeid(Op), typeid(RHS));
+      return r;
+    }
+
+    //! Dispatches on this thread while alive count under r
+    /*! A null r leaves the enclosing region */
+    class Scope
+    {
+    public:
+      explicit Scope(Region* r);
+      ~Scope();
+
+    private:
+      Region* prev;
+      bool set;
+    };
+
+    //! The region of the innermost Scope on this thread, null if none
+    Region* current();
+
+    //! Is this thread inside a timed dispatch
+    bool timing();
+
+    //! Mark this thread inside a timed dispatch or not
+    void setTiming(bool on);
+
+    //! Start and end stamps for n threads, 2n zeros, of this thread
+    QDPTime_t* stamps(int n);
+
+    //! Add a dispatch of n sites from t0 to t1 to r
+    /*! start and end hold the stamps of threads threads, zero for those without sites */
+    void record(Region* r, int n, QDPTime_t t0, QDPTime_t t1,
+		const QDPTime_t* start, const QDPTime_t* end, int threads);
+
+    //! user argument of a timed dispatch, wrapping the real one
+    template<class Arg>
+    struct TimedArgs
+    {
+      Arg* a;
+      void (*func)(int,int,int,Arg*);
+      QDPTime_t* start;
+      QDPTime_t* end;
+    };
+
+    //! user function of a timed dispatch
+    template<class Arg>
+    void timedKernel(int lo, int hi, int myId, TimedArgs<Arg>* t)
+    {
+      t->start[myId] = getClockTime();
+      t->func(lo, hi, myId, t->a);
+      t->end[myId] = getClockTime();
+    }
+
+    //! dispatch_to_threads with the stamps taken, see qdp_dispatch.h
+    template<class Arg>
+    void timed(int numSiteTable, Arg& a, void (*func)(int,int,int,Arg*));
+
+    //! Print the regions of this node, the longest first
+    void print();
+  }
+}
+
+#endif
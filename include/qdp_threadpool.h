@@ -0,0 +1,50 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief Persistent thread pool used by the dispatcher
+ *
+ * A fixed set of worker threads is created once at QDP_initialize and
+ * reused by every dispatch_to_threads call, so a call costs a wakeup
+ * rather than a thread fork/join.
+ */
+
+#ifndef QDP_THREADPOOL_H
+#define QDP_THREADPOOL_H
+
+namespace QDP
+{
+  namespace ThreadPool
+  {
+    //! Work function: handle [lo,hi) as thread myId
+    typedef void (*userfunc_t)(int lo, int hi, int myId, void *arg);
+
+    //! Start the workers
+    /*!
+     * The number of threads is taken from QDP_NUM_THREADS, otherwise from
+     * the cpus this process may run on. QDP_PIN_THREADS=1 binds thread k to
+     * the k-th such cpu. QDP_SPIN_COUNT sets how long an idle worker polls
+     * before it sleeps. Returns 0 on success.
+     */
+    int init();
+
+    //! Stop and join the workers
+    void finalize();
+
+    //! Number of threads including the calling one
+    int numThreads();
+
+    //! Id of the calling thread, 0 for the master
+    int threadNum();
+
+    //! Run func over [0,n) on all threads and wait for them
+    /*!
+     * Thread myId always gets [n*myId/m, n*(myId+1)/m) with m=min(threads,n),
+     * so a given subset is split the same way on every call and its sites
+     * stay with the same pinned thread.  Calls made from inside a worker
+     * run serially on that worker.
+     */
+    void call(userfunc_t func, int n, void *arg);
+  }
+}
+
+#endif
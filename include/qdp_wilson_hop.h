@@ -0,0 +1,279 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Fused Wilson hopping term
+ */
+
+#ifndef QDP_WILSON_HOP_H
+#define QDP_WILSON_HOP_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace WilsonHopInternal
+  {
+    //! Half spinor (1 + sign*gamma_mu) psi
+    template<class T>
+    inline typename UnaryReturn<T, FnSpinProjectDir0Minus>::Type_t
+    project(const T& psi, int mu, int sign)
+    {
+      switch (mu + 4*(sign > 0))
+      {
+      case 0: return spinProjectDir0Minus(psi);
+      case 1: return spinProjectDir1Minus(psi);
+      case 2: return spinProjectDir2Minus(psi);
+      case 3: return spinProjectDir3Minus(psi);
+      case 4: return spinProjectDir0Plus(psi);
+      case 5: return spinProjectDir1Plus(psi);
+      case 6: return spinProjectDir2Plus(psi);
+      default: return spinProjectDir3Plus(psi);
+      }
+    }
+
+    //! Full spinor back from a half spinor made with project(psi,mu,sign)
+    template<class H>
+    inline typename UnaryReturn<H, FnSpinReconstructDir0Minus>::Type_t
+    reconstruct(const H& h, int mu, int sign)
+    {
+      switch (mu + 4*(sign > 0))
+      {
+      case 0: return spinReconstructDir0Minus(h);
+      case 1: return spinReconstructDir1Minus(h);
+      case 2: return spinReconstructDir2Minus(h);
+      case 3: return spinReconstructDir3Minus(h);
+      case 4: return spinReconstructDir0Plus(h);
+      case 5: return spinReconstructDir1Plus(h);
+      case 6: return spinReconstructDir2Plus(h);
+      default: return spinReconstructDir3Plus(h);
+      }
+    }
+
+    //! Bit of the flags of a site whose neighbour in (dir,mu) is off-node
+    /*! dir is 0 backward and 1 forward */
+    inline unsigned char bit(int dir, int mu) {return 1 << (2*mu + dir);}
+
+    //! Start of a site list, null when empty
+    inline const int* sitePtr(const std::vector<int>& v) {return v.empty() ? 0 : &v[0];}
+
+    //! Arguments of the threaded parts of wilsonHop
+    template<class T, class U>
+    struct Args
+    {
+      typedef typename UnaryReturn<T, FnSpinProjectDir0Minus>::Type_t  H;
+
+      T* chi;
+      const T* psi;
+      const U* u[Nd];
+      const int* goff[2][Nd];        // source of each site, [0] backward [1] forward
+      H* face[2][Nd];                // half spinors to send, then those received
+      const int* sites;              // sites worked on
+      const unsigned char* flags;    // off-node neighbours of each site, or null
+      int isign;
+      int mu;                        // direction filled by faceKernel
+    };
+
+    //! Project the sites others need for the forward and backward maps in mu
+    /*!
+     * The forward map sends psi(y) for the y whose backward neighbour is
+     * off-node, and the backward map sends U_mu(y)^dag psi(y) for the y
+     * whose forward neighbour is. flags holds the off-node neighbours of
+     * every site of this node.
+     */
+    template<class T, class U>
+    void faceKernel(int lo, int hi, int myId, Args<T,U>* a)
+    {
+      const int mu = a->mu;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int y = a->sites[j];
+	if (a->flags[y] & bit(0,mu))
+	  a->face[1][mu][y] = project(a->psi[y], mu, -a->isign);
+	if (a->flags[y] & bit(1,mu))
+	  a->face[0][mu][y] = adj(a->u[mu][y]) * project(a->psi[y], mu, a->isign);
+      }
+    }
+
+    //! The hopping term on sites[lo..hi)
+    /*!
+     * A neighbour flagged off-node is read from the received face,
+     * anything else is projected and multiplied here, so each site is
+     * written once and no half spinor goes through memory on-node.
+     */
+    template<class T, class U>
+    void hopKernel(int lo, int hi, int myId, Args<T,U>* a)
+    {
+      typedef typename Args<T,U>::H  H;
+      const int isign = a->isign;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int x = a->sites[j];
+	unsigned char f = (a->flags == 0) ? 0 : a->flags[x];
+
+	T acc;
+	zero_rep(acc);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  // (1 - isign gamma_mu) U_mu(x) psi(x+mu)
+	  if (f & bit(1,mu))
+	    acc += reconstruct(a->u[mu][x] * a->face[1][mu][x], mu, -isign);
+	  else
+	  {
+	    H h = project(a->psi[a->goff[1][mu][x]], mu, -isign);
+	    acc += reconstruct(a->u[mu][x] * h, mu, -isign);
+	  }
+
+	  // (1 + isign gamma_mu) U_mu(x-mu)^dag psi(x-mu)
+	  if (f & bit(0,mu))
+	    acc += reconstruct(a->face[0][mu][x], mu, isign);
+	  else
+	  {
+	    int y = a->goff[0][mu][x];
+	    H h = adj(a->u[mu][y]) * project(a->psi[y], mu, isign);
+	    acc += reconstruct(h, mu, isign);
+	  }
+	}
+
+	a->chi[x] = acc;
+      }
+    }
+  }
+
+
+  //! Wilson hopping term on the sites of s
+  /*!
+   * chi(x) = sum_mu (1 - isign gamma_mu) U_mu(x) psi(x+mu)
+   *                + (1 + isign gamma_mu) U_mu(x-mu)^dag psi(x-mu)
+   *
+   * Computes in one sweep what is usually written with spinProject,
+   * shift, u*, adj(u)* and spinReconstruct per direction, so psi and u
+   * are read and chi written once per site and no half spinor field is
+   * made. Only the half spinors on the faces are projected into
+   * buffers and exchanged, all 2*Nd at once. The sites of s needing
+   * nothing from another node are done while the faces are in flight.
+   *
+   * Needs Ns = Nd = 4. chi must not be psi.
+   */
+  template<class T, class U>
+  void wilsonHop(OLattice<T>& chi, const multi1d< OLattice<U> >& u,
+		 const OLattice<T>& psi, int isign, const Subset& s)
+  {
+    using namespace WilsonHopInternal;
+    typedef typename Args<T,U>::H  H;
+
+    if (Nd != 4 || Ns != 4)
+      QDP_error_exit("wilsonHop: needs Nd = Ns = 4");
+
+    if (u.size() != Nd)
+      QDP_error_exit("wilsonHop: need Nd gauge links, have %d", u.size());
+
+    if (&chi == &psi)
+      QDP_error_exit("wilsonHop: chi may not be psi");
+
+    const int nodeSites = Layout::sitesOnNode();
+
+    Args<T,U> a;
+    a.chi   = &chi.elem(0);
+    a.psi   = &psi.elem(0);
+    a.isign = isign;
+
+    // Sites of s with an off-node neighbour, and those face sites of
+    // this node that others need
+    std::vector<unsigned char> flags(nodeSites, 0);
+    std::vector<unsigned char> sends(nodeSites, 0);
+    bool face = false;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      a.u[mu] = &u[mu].elem(0);
+
+      for(int dir=0; dir < 2; ++dir)
+      {
+	Map& m = shift.getMap(2*dir-1, mu);
+	a.goff[dir][mu] = m.goffset().slice();
+
+	const Subset& b = m.boundary(s);
+	const int* tab = b.siteTable().slice();
+	for(int j=0; j < b.numSiteTable(); ++j)
+	  flags[tab[j]] |= bit(dir,mu);
+
+	const Subset& ball = m.boundary(all);
+	const int* tall = ball.siteTable().slice();
+	for(int j=0; j < ball.numSiteTable(); ++j)
+	  sends[tall[j]] |= bit(dir,mu);
+
+	face = face || (ball.numSiteTable() > 0);
+      }
+    }
+
+    std::vector<int> inner, outer;
+    {
+      const int* tab = s.siteTable().slice();
+      for(int j=0; j < s.numSiteTable(); ++j)
+	(flags[tab[j]] ? outer : inner).push_back(tab[j]);
+    }
+
+    if (! face)
+    {
+      // Everything is on the node
+      a.sites = sitePtr(inner);
+      a.flags = 0;
+      dispatch_to_threads(inner.size(), a, hopKernel<T,U>);
+      return;
+    }
+
+    // Project the faces and launch them. After start the send buffers
+    // hold the faces, so the received ones can land in the same fields
+    multi2d< OLattice<H> > faces(2, Nd);
+    std::vector< MapHandle<H> > handles;
+
+    std::vector<int> senders;
+    for(int y=0; y < nodeSites; ++y)
+      if (sends[y])
+	senders.push_back(y);
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      a.face[0][mu] = &faces(0,mu).elem(0);
+      a.face[1][mu] = &faces(1,mu).elem(0);
+    }
+
+    a.sites = sitePtr(senders);
+    a.flags = &sends[0];
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      a.mu = mu;
+      dispatch_to_threads(senders.size(), a, faceKernel<T,U>);
+
+      for(int dir=0; dir < 2; ++dir)
+	handles.push_back(shift.start(faces(dir,mu), 2*dir-1, mu));
+    }
+
+    // Interior sites while the faces are in flight
+    a.sites = sitePtr(inner);
+    a.flags = 0;
+    dispatch_to_threads(inner.size(), a, hopKernel<T,U>);
+
+    // Then the sites that need a face
+    for(int mu=0, k=0; mu < Nd; ++mu)
+      for(int dir=0; dir < 2; ++dir, ++k)
+	handles[k].finishBoundary(faces(dir,mu));
+
+    a.sites = sitePtr(outer);
+    a.flags = &flags[0];
+    dispatch_to_threads(outer.size(), a, hopKernel<T,U>);
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
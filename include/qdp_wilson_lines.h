@@ -0,0 +1,166 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Polyakov loops and straight Wilson lines from the links of a line gathered once
+ */
+
+#ifndef QDP_WILSON_LINES_H
+#define QDP_WILSON_LINES_H
+
+#include <vector>
+
+namespace QDP
+{
+
+  /** \addtogroup group5
+   *  @{
+   */
+
+  namespace WilsonLinesInternal
+  {
+    //! The sites of this node as lines in direction mu, and the nodes along mu
+    struct Column
+    {
+      explicit Column(int mu);
+
+      int mu;
+      int s;                    // subgrid extent in mu
+      int np;                   // nodes along mu
+      int me;                   // coordinate of this node along mu
+      int nlines;               // lines through the subgrid
+      std::vector<int> site;    // linear index of point t of line k at k*s + t
+      std::vector<int> nodes;   // node at each coordinate along mu
+    };
+
+    //! The column of direction mu, made on first use and kept
+    const Column& column(int mu);
+
+    //! Give every node along mu the block of bytes of each, in node order along mu
+    /*! Collective. all holds np blocks */
+    void allGather(const Column& c, const char* mine, char* all, size_t bytes);
+  }
+
+
+  //! poly(x) = U(x) U(x+mu) ... U(x-mu), the Polyakov loop in direction mu starting at x
+  /*!
+   * Each node multiplies the links of its part of every line, once
+   * from the front and once from the back, and the products of the
+   * whole parts go to the other nodes along mu in one exchange. No
+   * shift is made: this is about np + 2 products per site and one message
+   * of one link per line, instead of the Lt shifts of the usual loop of
+   * poly = u * shift(poly, FORWARD, mu).
+   */
+  template<class U>
+  void polyakovLoop(OLattice<U>& poly, const OLattice<U>& u, int mu)
+  {
+    using namespace WilsonLinesInternal;
+
+    const Column& c = column(mu);
+    const U* f = u.getF();
+    U* d = writable(poly).getF();
+
+    // Prefix and suffix products of the part of each line here
+    std::vector<U> pre(c.nlines*c.s), suf(c.nlines*c.s);
+
+#pragma omp parallel for
+    for(int k=0; k < c.nlines; ++k)
+    {
+      const int* line = &c.site[k*c.s];
+      pre[k*c.s] = f[line[0]];
+      for(int t=1; t < c.s; ++t)
+	pre[k*c.s + t] = pre[k*c.s + t-1] * f[line[t]];
+
+      suf[k*c.s + c.s-1] = f[line[c.s-1]];
+      for(int t=c.s-2; t >= 0; --t)
+	suf[k*c.s + t] = f[line[t]] * suf[k*c.s + t+1];
+    }
+
+    // Whole parts of each line from every node along mu
+    std::vector<U> mine(c.nlines), all(c.nlines*c.np);
+    for(int k=0; k < c.nlines; ++k)
+      mine[k] = suf[k*c.s];
+    allGather(c, (const char*)&mine[0], (char*)&all[0], c.nlines*sizeof(U));
+
+#pragma omp parallel for
+    for(int k=0; k < c.nlines; ++k)
+    {
+      // The parts of the nodes after this one, round the lattice
+      U mid;
+      if (c.np > 1)
+      {
+	mid = all[((c.me + 1) % c.np)*c.nlines + k];
+	for(int q=2; q < c.np; ++q)
+	  mid = mid * all[((c.me + q) % c.np)*c.nlines + k];
+      }
+
+      // U(x) .. end of this part, the other parts, start of this part .. U(x-mu)
+      const int* line = &c.site[k*c.s];
+      for(int t=0; t < c.s; ++t)
+      {
+	U r = suf[k*c.s + t];
+	if (c.np > 1)
+	  r = r * mid;
+	if (t > 0)
+	  r = r * pre[k*c.s + t-1];
+	d[line[t]] = r;
+      }
+    }
+  }
+
+
+  //! w[l-1](x) = U(x) U(x+mu) ... U(x+(l-1)mu), the straight Wilson lines of lengths 1..lmax
+  /*!
+   * The links of every line through the subgrid are gathered from the
+   * nodes along mu in one exchange, Lt links per line, and each node
+   * then multiplies its lines out for all lengths at once: lmax products
+   * per site and no shift. Lines longer than Lt wrap around.
+   */
+  template<class U>
+  void wilsonLines(multi1d< OLattice<U> >& w, const OLattice<U>& u, int mu, int lmax)
+  {
+    using namespace WilsonLinesInternal;
+
+    const Column& c = column(mu);
+    const int lt = c.s*c.np;
+    const U* f = u.getF();
+
+    if (w.size() != lmax)
+      w.resize(lmax);
+
+    std::vector<U*> d(lmax);
+    for(int l=0; l < lmax; ++l)
+      d[l] = writable(w[l]).getF();
+
+    // The whole of every line, by the coordinate along mu
+    std::vector<U> mine(c.nlines*c.s), all(c.nlines*lt);
+    for(int k=0; k < c.nlines; ++k)
+      for(int t=0; t < c.s; ++t)
+	mine[k*c.s + t] = f[c.site[k*c.s + t]];
+    allGather(c, (const char*)&mine[0], (char*)&all[0], c.nlines*c.s*sizeof(U));
+
+#pragma omp parallel for
+    for(int j=0; j < c.nlines*c.s; ++j)
+    {
+      const int k = j / c.s;
+      const int t = j % c.s;
+      const int x = c.site[j];
+      const int t0 = c.me*c.s + t;
+
+      // Block of node tt/s, point tt%s of line k
+      int tt = t0 % lt;
+      U r = all[(tt / c.s)*c.nlines*c.s + k*c.s + tt % c.s];
+      d[0][x] = r;
+      for(int l=1; l < lmax; ++l)
+      {
+	tt = (t0 + l) % lt;
+	r = r * all[(tt / c.s)*c.nlines*c.s + k*c.s + tt % c.s];
+	d[l][x] = r;
+      }
+    }
+  }
+
+  /** @} */ // end of group5
+
+} // namespace QDP
+
+#endif
@@ -39,6 +39,15 @@ namespace QDP
 
     Note that only the primary node opens and reads XML files. Results from
     Xpath queries are broadcast to all nodes.
+
+    With setParseOnAllNodes(true) the primary node instead broadcasts the
+    document once when it is opened, every node parses its copy, and the
+    queries are answered locally without a broadcast each. The mode is
+    fixed when a reader is opened, and must be the same on all nodes.
+
+    Either way the result of each query is kept by the reader, so reading
+    a path again neither evaluates the Xpath nor communicates. The kept
+    results are dropped when the document changes.
   */
   class XMLReader : protected XMLXPathReader::BasicXPathReader
   {
@@ -129,7 +138,8 @@ namespace QDP
     template<typename T>
     void set(const std::string& xpath, const T& to_set) 
       {
-	if (Layout::primaryNode())
+	cache.clear();
+	if (active())
 	{  
 	  BasicXPathReader::set<T>(xpath, to_set);
 	}
@@ -147,6 +157,13 @@ namespace QDP
 
     void registerNamespace(const std::string& prefix, const std::string& uri);
 
+    //! Parse documents on every node rather than only on the primary
+    /*! Applies to readers opened afterwards */
+    static void setParseOnAllNodes(bool on);
+
+    //! Are documents parsed on every node
+    static bool parseOnAllNodes();
+
   private:
     //! Hide the = operator
     void operator=(const XMLReader&) {}
@@ -167,9 +184,19 @@ namespace QDP
     readAttrPrimitive(const std::string& xpath, 
 		      const std::string& attrib_name,
 		      T& result);
+    //! Is the document read on this node
+    bool active() const;
+
+    //! Open the document of a stream, on the nodes that parse it
+    void openStream(std::istream& is);
+
   private:
     bool  iop;  //file open or closed?
     bool  derived; // is this reader derived from another reader?
+    bool  local; // was the document parsed on every node?
+
+    //! Results of earlier queries, by xpath and type
+    std::map<std::string, std::string> cache;
   };
 
 
@@ -1061,6 +1088,9 @@ namespace QDP
   //! Writes XML metadata to a file
   /*!
     \ingroup io
+
+    Output goes to the file in chunks of a fixed buffer as it is written,
+    so the memory used does not grow with the document.
   */
 
   class XMLFileWriter : public XMLWriter
@@ -1108,6 +1138,9 @@ namespace QDP
   private:
     std::ofstream output_stream;
     std::ostream& getOstream(void) {return output_stream;}
+
+    //! Buffer of the stream, written to the file each time it fills
+    std::vector<char> chunk;
   };
 
 
@@ -0,0 +1,67 @@
+// -*- C++ -*-
+
+/*! @file
+ * @brief AVX2 and AVX-512 versions of the double precision SSE kernels
+ *
+ * The SSE entry points (vaxpy4, local_sumsq4, ssed_m_eq_mm, ...) hand
+ * their work to these when the CPU they run on has the instructions, so
+ * the evaluate specialisations built on the SSE kernels pick them up
+ * without change. The kernels are compiled with target attributes, the
+ * library itself needs no -mavx flags.
+ */
+
+#ifndef QDP_SCALARSITE_AVX_H
+#define QDP_SCALARSITE_AVX_H
+
+#include "qdp_precision.h"
+
+namespace QDP {
+  namespace AVX {
+
+    //! Widest vector instructions the kernels may use
+    enum Level { LEVEL_SSE, LEVEL_AVX2, LEVEL_AVX512 };
+
+    //! The level in use - found from the CPU on first call
+    Level level();
+
+    //! Use at most l, e.g. LEVEL_SSE to time the SSE kernels
+    /*! Levels the CPU does not have are ignored */
+    void setLevel(Level l);
+
+    //! True when the AVX kernels should be used
+    inline bool enabled() {return level() != LEVEL_SSE;}
+
+    /* Out += scale*In */
+    void vaxpy4(REAL64 *Out, REAL64 *scalep, REAL64 *InScale, int n_4spin);
+
+    /* y = a*x + b*y */
+    void vaxpby4(REAL64 *y, REAL64 *a, REAL64 *x, REAL64 *b, int n_4vec);
+
+    /* z = a*x */
+    void vscal4(REAL64 *z, REAL64 *a, REAL64 *x, int n_4spin);
+
+    /* sum = |x|^2 */
+    void local_sumsq4(REAL64 *sum, REAL64 *vecptr, int n_4spin);
+
+    /* sum[0..1] = <y,x> */
+    void local_vcdot4(REAL64 *sum, REAL64 *y, REAL64 *x, int n_4spin);
+
+    /* sum = Re <y,x> */
+    void local_vcdot_real4(REAL64 *sum, REAL64 *y, REAL64 *x, int n_4spin);
+
+    /* M3 = M1*M2 */
+    void m_eq_mm(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat);
+
+    /* M3 = M1*adj(M2) */
+    void m_eq_mh(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat);
+
+    /* M3 = adj(M1)*M2 */
+    void m_eq_hm(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat);
+
+    /* M3 = adj(M1)*adj(M2) */
+    void m_eq_hh(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat);
+
+  } // namespace AVX
+} // namespace QDP
+
+#endif
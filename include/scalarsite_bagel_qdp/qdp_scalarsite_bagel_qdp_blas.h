@@ -43,6 +43,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y += a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -87,6 +88,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y -= a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -134,6 +136,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -196,6 +199,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y + a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + a*x");
 
 
   // Peel the stuff out of the expression
@@ -258,6 +262,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right());
@@ -318,6 +323,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y - a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - a*x");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().left());
 
@@ -378,6 +384,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y += x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += x*a");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().left());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().right());
@@ -421,6 +428,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y -= x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= x*a");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().left());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().right());
@@ -468,6 +476,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -531,6 +540,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y + x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + x*a");
 
 
   // Peel the stuff out of the expression
@@ -596,6 +606,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right());
 
@@ -656,6 +667,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y - x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - x*a");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().left());
 
@@ -715,6 +727,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v+v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v+v");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
@@ -758,6 +771,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v-v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v-v");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
@@ -801,6 +815,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v = a*v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*v");
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
 
@@ -840,6 +855,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v = v*a " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = v*a");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().right());
@@ -1041,6 +1057,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1114,6 +1131,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1193,6 +1211,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1278,6 +1297,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1349,6 +1369,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1421,6 +1442,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1499,6 +1521,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1583,6 +1606,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1643,6 +1667,7 @@ norm2(const QDPType<TVec ,OLattice< TVec > >& s1, const Subset& s)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using BJ sumsq" << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq");
 
   DOUBLE lsum=(DOUBLE)0;
 
@@ -1651,6 +1676,7 @@ norm2(const QDPType<TVec ,OLattice< TVec > >& s1, const Subset& s)
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ sumsq " << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq");
     int n_3vec = (s.end() - s.start() + 1)*4;
     const REAL *s1ptr =  &(s1.elem(s.start()).elem(0).elem(0).real());
 
@@ -1688,6 +1714,7 @@ norm2(const QDPType<TVec ,OLattice< TVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using BJ sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq all");
 
 
   int n_3vec = (all.end() - all.start() + 1)*4;
@@ -1711,6 +1738,7 @@ innerProduct(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -1753,6 +1781,7 @@ innerProduct(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProduct s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct s");
 
     // This BinaryReturn has Type_t
     // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -1802,6 +1831,7 @@ innerProductReal(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -1844,6 +1874,7 @@ innerProductReal(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProductReal s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal s");
 
     unsigned long n_3vec = (s.end() - s.start() + 1)*4;
     qdp_lcdotr(&ip_re,
@@ -1884,6 +1915,7 @@ norm2(const multi1d< OLattice< TVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE multi1d sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE multi1d sumsq all");
 
   int n_3vec = (all.end() - all.start() + 1)*4;
   DOUBLE ltmp = 0;
@@ -1915,6 +1947,7 @@ norm2(const multi1d< OLattice< TVec > >& s1, const Subset& s)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE multi1d sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE multi1d sumsq all");
   
   DOUBLE ltmp = 0;
   for(int n=0; n < s1.size(); ++n) {
@@ -1964,6 +1997,7 @@ innerProduct(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: multi1d innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("multi1d innerProduct all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -2013,6 +2047,7 @@ innerProductReal(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal(multi1d) all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal(multi1d) all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -2059,6 +2094,7 @@ innerProductReal(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal(multi1d) all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal(multi1d) all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
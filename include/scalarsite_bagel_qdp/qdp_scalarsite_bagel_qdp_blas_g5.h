@@ -45,6 +45,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += a*P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -91,6 +92,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += a*P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -139,6 +141,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= a*P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -183,6 +186,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= a*P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -229,6 +233,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -270,6 +275,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -310,6 +316,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -353,6 +360,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -399,6 +407,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a*P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a*P{+} y");
 
 
   // Peel the stuff out of the expression
@@ -466,6 +475,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a*P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a*P{-} y");
 
 
   // Peel the stuff out of the expression
@@ -532,6 +542,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a*P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a*P{+} y");
 
 
   // Peel the stuff out of the expression
@@ -598,6 +609,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a*P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a*P{-} y");
 
 
   // Peel the stuff out of the expression
@@ -662,6 +674,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{+} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -725,6 +738,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{-} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -789,6 +803,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{+} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -852,6 +867,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{-} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -913,6 +929,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   cout << "BJ: v = a*P{+}v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*P{+}v");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right().child());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
@@ -958,6 +975,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   cout << "BJ: v = a*P{-}v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*P{-}v");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right().child());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
@@ -1008,6 +1026,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*P+y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*P+y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1086,6 +1105,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*P-y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*P-y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1164,6 +1184,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x - b*P+y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*P+y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1243,6 +1264,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x - b*P-y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*P-y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1321,6 +1343,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*(GammaConst<Ns,Ns*Ns-1>()*x)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*(GammaConst<Ns,Ns*Ns-1>()*x)");
 
 
    typedef BinaryNode< 
@@ -1384,6 +1407,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a GammaConst<Ns,Ns*Ns-1>()*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a GammaConst<Ns,Ns*Ns-1>()*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -1463,6 +1487,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*y");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -1550,6 +1575,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = GammaConst<Ns,Ns*Ns-1>()*(ax - by)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = GammaConst<Ns,Ns*Ns-1>()*(ax - by)");
 
   typedef BinaryNode<OpSubtract,
 	             BinaryNode<OpMultiply,
@@ -1639,6 +1665,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -1738,6 +1765,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -1833,6 +1861,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a GammaConst<Ns,Ns*Ns-1>()*i*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -1922,6 +1951,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a GammaConst<Ns,Ns*Ns-1>()*i*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -2010,6 +2040,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z += a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z += a GammaConst<Ns,Ns*Ns-1>()*i*y");
 
 #if 0
   typedef BinaryNode<OpMultiply,
@@ -2098,6 +2129,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z -= a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z -= a GammaConst<Ns,Ns*Ns-1>()*i*y");
 
 #if 0 
   typedef BinaryNode<OpMultiply,
@@ -48,6 +48,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(M*M) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("M*M");
   
    if( s.hasOrderedRep() ) { 
      // Do whole subset
@@ -102,6 +103,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(A*M) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("A*M");
   
    if( s.hasOrderedRep() ) { 
      // Do whole subset
@@ -171,6 +173,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(M*A) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("M*A");
   
    if( s.hasOrderedRep() ) { 
      // Do whole subset
@@ -226,6 +229,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(A*A) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("A*A");
   BAGELQDPFloat one_minus_i[2] QDP_ALIGN16;
   one_minus_i[0] = (BAGELQDPFloat)1;
   one_minus_i[1] = (BAGELQDPFloat)(-1);
@@ -285,6 +289,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(M*M) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("M*M");
 
   BAGELQDPFloat plus_one[2] QDP_ALIGN16;
   plus_one[0] = (BAGELQDPFloat)1;
@@ -342,6 +347,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(A*M) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("A*M");
 
   BAGELQDPFloat plus_one[2] QDP_ALIGN16;
   plus_one[0] = (BAGELQDPFloat)1;
@@ -408,6 +414,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(M*A) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("M*A");
   BAGELQDPFloat plus_one[2] QDP_ALIGN16;
   plus_one[0] = (BAGELQDPFloat)1;
   plus_one[1] = (BAGELQDPFloat)0;
@@ -466,6 +473,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(A*A) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("A*A");
   BAGELQDPFloat one_minus_i[2] QDP_ALIGN16;
   one_minus_i[0] = (BAGELQDPFloat)1;
   one_minus_i[1] = (BAGELQDPFloat)(-1);
@@ -531,6 +539,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(M*M) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("M*M");
 
   BAGELQDPFloat minus_one[2] QDP_ALIGN16;
   minus_one[0] = (BAGELQDPFloat)-1;
@@ -588,6 +597,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(A*M) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("A*M");
 
   BAGELQDPFloat minus_one[2] QDP_ALIGN16;
   minus_one[0] = (BAGELQDPFloat)-1;
@@ -661,6 +671,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(M*A) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("M*A");
   BAGELQDPFloat minus_one[2] QDP_ALIGN16;
   minus_one[0] = (BAGELQDPFloat)-1;
   minus_one[1] = (BAGELQDPFloat)0;
@@ -719,6 +730,7 @@ void evaluate(OLattice<PScalar<PColorMatrix<RComplexFloat, 3> > >& d,
 #ifdef DEBUG_BAGELQDP_LINALG
   QDPIO::cout << "evaluate(A*A) subset = s " << endl;
 #endif
+  QDP_KERNEL_SELECTED("A*A");
   BAGELQDPFloat one_minus_i[2] QDP_ALIGN16;
   one_minus_i[0] = (BAGELQDPFloat)1;
   one_minus_i[1] = (BAGELQDPFloat)(-1);
@@ -0,0 +1,162 @@
+#ifndef GENERIC_SMALL_NC_H
+#define GENERIC_SMALL_NC_H
+/*
+ * Generic routines for colour matrices and vectors of Nc other than 3
+ *
+ * The SU(3) routines are written out by hand. These are templates on
+ * the number of colours N whose loops are unrolled at compile time by
+ * Unroll, so SU(2), SU(4) and SU(5) get the same straight line code of
+ * real multiplies into registers, rather than the nested complex
+ * operators of the primitive types.
+ */
+
+namespace GenericSmallNc
+{
+  //! f(0), f(1), ..., f(K-1), unrolled
+  template<int K>
+  struct Unroll
+  {
+    template<class F>
+    static inline void loop(const F& f) {Unroll<K-1>::loop(f); f(K-1);}
+  };
+
+  template<>
+  struct Unroll<0>
+  {
+    template<class F>
+    static inline void loop(const F&) {}
+  };
+
+  /* cc = op(aa) * op(bb), op the adjoint when AA or AB */
+  template<int N, bool AA, bool AB, class T>
+  inline void multMM(const PMatrix<RComplex<T>,N,PColorMatrix>& aa,
+		     const PMatrix<RComplex<T>,N,PColorMatrix>& bb,
+		     PMatrix<RComplex<T>,N,PColorMatrix>& cc)
+  {
+    Unroll<N>::loop([&](int i) {
+      Unroll<N>::loop([&](int j) {
+	T re = 0, im = 0;
+	Unroll<N>::loop([&](int k) {
+	  const RComplex<T>& x = AA ? aa.elem(k,i) : aa.elem(i,k);
+	  const RComplex<T>& y = AB ? bb.elem(j,k) : bb.elem(k,j);
+	  const T xi = AA ? -x.imag() : x.imag();
+	  const T yi = AB ? -y.imag() : y.imag();
+	  re += x.real()*y.real() - xi*yi;
+	  im += x.real()*yi + xi*y.real();
+	});
+	cc.elem(i,j).real() = re;
+	cc.elem(i,j).imag() = im;
+      });
+    });
+  }
+
+  /* cc = op(aa) * bb, op the adjoint when AA */
+  template<int N, bool AA, class T>
+  inline void multMV(const PMatrix<RComplex<T>,N,PColorMatrix>& aa,
+		     const PVector<RComplex<T>,N,PColorVector>& bb,
+		     PVector<RComplex<T>,N,PColorVector>& cc)
+  {
+    Unroll<N>::loop([&](int i) {
+      T re = 0, im = 0;
+      Unroll<N>::loop([&](int k) {
+	const RComplex<T>& x = AA ? aa.elem(k,i) : aa.elem(i,k);
+	const T xi = AA ? -x.imag() : x.imag();
+	re += x.real()*bb.elem(k).real() - xi*bb.elem(k).imag();
+	im += x.real()*bb.elem(k).imag() + xi*bb.elem(k).real();
+      });
+      cc.elem(i).real() = re;
+      cc.elem(i).imag() = im;
+    });
+  }
+
+  /* cc = op(aa) * bb for each of the S spin components of bb */
+  template<int N, int S, bool AA, class M, class V, class D>
+  inline void multMS(const M& aa, const V& bb, D& cc)
+  {
+    Unroll<S>::loop([&](int s) {
+      multMV<N,AA>(aa, bb.elem(s), cc.elem(s));
+    });
+  }
+}
+
+
+/* Specialisations of the colour operators on RComplexFloat for N colours,
+ * those the SU(3) routines of qdp_scalarsite_generic_linalg.h have */
+#define QDP_GENERIC_SMALL_NC_MM(FN, OP, N, AA, AB) \
+template<> \
+inline BinaryReturn<PMatrix<RComplexFloat,N,PColorMatrix>, \
+  PMatrix<RComplexFloat,N,PColorMatrix>, OP>::Type_t \
+FN(const PMatrix<RComplexFloat,N,PColorMatrix>& l, \
+   const PMatrix<RComplexFloat,N,PColorMatrix>& r) \
+{ \
+  BinaryReturn<PMatrix<RComplexFloat,N,PColorMatrix>, \
+    PMatrix<RComplexFloat,N,PColorMatrix>, OP>::Type_t  d; \
+  GenericSmallNc::multMM<N,AA,AB>(l,r,d); \
+  return d; \
+} \
+\
+template<> \
+inline BinaryReturn<PScalar<PColorMatrix<RComplexFloat,N> >, \
+  PScalar<PColorMatrix<RComplexFloat,N> >, OP>::Type_t \
+FN(const PScalar<PColorMatrix<RComplexFloat,N> >& l, \
+   const PScalar<PColorMatrix<RComplexFloat,N> >& r) \
+{ \
+  BinaryReturn<PScalar<PColorMatrix<RComplexFloat,N> >, \
+    PScalar<PColorMatrix<RComplexFloat,N> >, OP>::Type_t  d; \
+  GenericSmallNc::multMM<N,AA,AB>(l.elem(),r.elem(),d.elem()); \
+  return d; \
+}
+
+#define QDP_GENERIC_SMALL_NC_MV(FN, OP, N, AA) \
+template<> \
+inline BinaryReturn<PMatrix<RComplexFloat,N,PColorMatrix>, \
+  PVector<RComplexFloat,N,PColorVector>, OP>::Type_t \
+FN(const PMatrix<RComplexFloat,N,PColorMatrix>& l, \
+   const PVector<RComplexFloat,N,PColorVector>& r) \
+{ \
+  BinaryReturn<PMatrix<RComplexFloat,N,PColorMatrix>, \
+    PVector<RComplexFloat,N,PColorVector>, OP>::Type_t  d; \
+  GenericSmallNc::multMV<N,AA>(l,r,d); \
+  return d; \
+} \
+\
+template<> \
+inline BinaryReturn<PScalar<PColorMatrix<RComplexFloat,N> >, \
+  PScalar<PColorVector<RComplexFloat,N> >, OP>::Type_t \
+FN(const PScalar<PColorMatrix<RComplexFloat,N> >& l, \
+   const PScalar<PColorVector<RComplexFloat,N> >& r) \
+{ \
+  BinaryReturn<PScalar<PColorMatrix<RComplexFloat,N> >, \
+    PScalar<PColorVector<RComplexFloat,N> >, OP>::Type_t  d; \
+  GenericSmallNc::multMV<N,AA>(l.elem(),r.elem(),d.elem()); \
+  return d; \
+}
+
+#define QDP_GENERIC_SMALL_NC_MS(FN, OP, N, S, AA) \
+template<> \
+inline BinaryReturn<PScalar<PColorMatrix<RComplexFloat,N> >, \
+  PVector<PColorVector<RComplexFloat,N>,S,PSpinVector>, OP>::Type_t \
+FN(const PScalar<PColorMatrix<RComplexFloat,N> >& l, \
+   const PVector<PColorVector<RComplexFloat,N>,S,PSpinVector>& r) \
+{ \
+  BinaryReturn<PScalar<PColorMatrix<RComplexFloat,N> >, \
+    PVector<PColorVector<RComplexFloat,N>,S,PSpinVector>, OP>::Type_t  d; \
+  GenericSmallNc::multMS<N,S,AA>(l.elem(),r,d); \
+  return d; \
+}
+
+#define QDP_GENERIC_SMALL_NC(N) \
+  QDP_GENERIC_SMALL_NC_MM(operator*, OpMultiply, N, false, false) \
+  QDP_GENERIC_SMALL_NC_MM(adjMultiply, OpAdjMultiply, N, true, false) \
+  QDP_GENERIC_SMALL_NC_MM(multiplyAdj, OpMultiplyAdj, N, false, true) \
+  QDP_GENERIC_SMALL_NC_MM(adjMultiplyAdj, OpAdjMultiplyAdj, N, true, true) \
+  QDP_GENERIC_SMALL_NC_MV(operator*, OpMultiply, N, false) \
+  QDP_GENERIC_SMALL_NC_MV(adjMultiply, OpAdjMultiply, N, true) \
+  QDP_GENERIC_SMALL_NC_MS(operator*, OpMultiply, N, 1, false) \
+  QDP_GENERIC_SMALL_NC_MS(adjMultiply, OpAdjMultiply, N, 1, true) \
+  QDP_GENERIC_SMALL_NC_MS(operator*, OpMultiply, N, 2, false) \
+  QDP_GENERIC_SMALL_NC_MS(adjMultiply, OpAdjMultiply, N, 2, true) \
+  QDP_GENERIC_SMALL_NC_MS(operator*, OpMultiply, N, 4, false) \
+  QDP_GENERIC_SMALL_NC_MS(adjMultiply, OpAdjMultiply, N, 4, true)
+
+#endif
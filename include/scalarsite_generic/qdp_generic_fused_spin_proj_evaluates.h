@@ -39,6 +39,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir0Plus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -49,7 +50,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir0Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -74,7 +75,7 @@ void evaluate(OLattice< HVec >& d,
 
     unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir0Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -115,6 +116,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir0Minus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -123,7 +125,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir0Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -149,7 +151,7 @@ void evaluate(OLattice< HVec >& d,
 
     unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir0Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -192,6 +194,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir1Plus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -200,7 +203,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir1Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -227,7 +230,7 @@ void evaluate(OLattice< HVec >& d,
 
    unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir1Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -270,6 +273,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir1Minus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -278,7 +282,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir1Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -304,7 +308,7 @@ void evaluate(OLattice< HVec >& d,
 
     unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir1Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -346,6 +350,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir2Plus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -355,7 +360,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir2Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -381,7 +386,7 @@ void evaluate(OLattice< HVec >& d,
 
     unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir2Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -423,6 +428,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir2Minus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -431,7 +437,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir2Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -458,7 +464,7 @@ void evaluate(OLattice< HVec >& d,
 
     unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir2Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -500,6 +506,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir3Plus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -510,7 +517,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir3Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -536,7 +543,7 @@ void evaluate(OLattice< HVec >& d,
 
     unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir3Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -577,6 +584,7 @@ void evaluate(OLattice< HVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir3Minus(Vec)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left().child());
   const OLattice< FVec >& a = static_cast< const OLattice< FVec >& >(rhs.expression().right().child());
 
@@ -586,7 +594,7 @@ void evaluate(OLattice< HVec >& d,
 
     ordered_fused_spin_proj_user_arg arg = {u, a, d, s.start(), inlineSpinProjDir3Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, ordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
@@ -614,7 +622,7 @@ void evaluate(OLattice< HVec >& d,
 
     unordered_fused_spin_proj_user_arg arg = {u, a, d, tab, inlineSpinProjDir3Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_proj_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_proj", totalSize, arg, unordered_fused_spin_proj_evaluate_function);
 
     ///////////////////
     // Original code
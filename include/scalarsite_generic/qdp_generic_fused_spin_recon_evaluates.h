@@ -29,6 +29,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir0Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -37,7 +38,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d, s.start(), inlineSpinReconDir0Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -65,7 +66,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir0Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -101,6 +102,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir0Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -110,7 +112,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d, s.start(), inlineSpinReconDir0Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -137,7 +139,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir0Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -179,6 +181,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir1Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -188,7 +191,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d, s.start(), inlineSpinReconDir1Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -215,7 +218,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir1Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -253,6 +256,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir1Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -262,7 +266,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d, s.start(), inlineSpinReconDir1Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -289,7 +293,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir1Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -329,6 +333,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir2Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -339,7 +344,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d,  s.start(),inlineSpinReconDir2Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -366,7 +371,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir2Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -404,6 +409,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir2Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -414,7 +420,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d, s.start(), inlineSpinReconDir2Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -440,7 +446,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir2Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -480,6 +486,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir3Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -490,7 +497,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d, s.start(), inlineSpinReconDir3Plus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -517,7 +524,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir3Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -556,6 +563,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir3Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -565,7 +573,7 @@ void evaluate(OLattice< FVec >& d,
 
     ordered_fused_spin_recon_user_arg arg = {u, a, d, s.start(), inlineSpinReconDir3Minus};
 
-    dispatch_to_threads(totalSize, arg, ordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, ordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -590,7 +598,7 @@ void evaluate(OLattice< FVec >& d,
 
     unordered_fused_spin_recon_user_arg arg = {u, a, d, tab, inlineSpinReconDir3Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_fused_spin_recon_evaluate_function);
+    dispatch_to_threads_tuned("fused_spin_recon", totalSize, arg, unordered_fused_spin_recon_evaluate_function);
 
     ///////////////////
     // Original code
@@ -629,6 +637,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir0Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -704,6 +713,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir0Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -782,6 +792,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir1Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -857,6 +868,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir1Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -933,6 +945,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir2Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -1004,6 +1017,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir2Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -1078,6 +1092,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir3Plus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
@@ -1150,6 +1165,7 @@ void evaluate(OLattice< FVec >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir3Minus( u * psi)");
   const OLattice< SU3Mat >& u = static_cast< const OLattice< SU3Mat >& >(rhs.expression().left());
   const OLattice< HVec >& a = static_cast< const OLattice< HVec >& >(rhs.expression().right());
 
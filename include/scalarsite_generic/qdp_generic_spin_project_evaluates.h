@@ -35,6 +35,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir0Plus(Vec)");
 
   //  Get at pointer for 4 vec
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
@@ -47,7 +48,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir0Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
 
     ///////////////////
     // Original code
@@ -63,7 +64,7 @@ void evaluate(OLattice< HVec >& b,
 
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab, inlineSpinProjDir0Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
 
     ///////////////////
     // Original code
@@ -91,6 +92,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir1Plus(Vec)");
 
   
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
@@ -104,7 +106,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir1Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -119,7 +121,7 @@ void evaluate(OLattice< HVec >& b,
 
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinProjDir1Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -147,6 +149,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir2Plus(Vec)");
   
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
 
@@ -158,7 +161,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir2Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -173,7 +176,7 @@ void evaluate(OLattice< HVec >& b,
 
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinProjDir2Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -201,6 +204,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir3Plus(Vec)");
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
 
   if( s.hasOrderedRep() ) {
@@ -211,7 +215,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir3Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -226,7 +230,7 @@ void evaluate(OLattice< HVec >& b,
 
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinProjDir3Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -254,6 +258,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir0Minus(Vec)");
 
   //  Get at pointer for 4 vec
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
@@ -266,7 +271,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir0Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -281,7 +286,7 @@ void evaluate(OLattice< HVec >& b,
 
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinProjDir0Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -309,6 +314,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir1Minus(Vec)");
 
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
 
@@ -320,7 +326,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir1Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -336,7 +342,7 @@ void evaluate(OLattice< HVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab, inlineSpinProjDir1Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -364,6 +370,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir2Minus(Vec)");
 
   
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
@@ -376,7 +383,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir2Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -391,7 +398,7 @@ void evaluate(OLattice< HVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinProjDir2Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -420,6 +427,7 @@ void evaluate(OLattice< HVec >& b,
 	      OLattice< HVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir3Minus(Vec)");
   const OLattice< FVec >& a = static_cast<const OLattice< FVec > &>(rhs.expression().child());
 
   if( s.hasOrderedRep() ) { 
@@ -431,7 +439,7 @@ void evaluate(OLattice< HVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinProjDir3Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -446,7 +454,7 @@ void evaluate(OLattice< HVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinProjDir3Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -477,6 +485,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir0Plus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -489,7 +498,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir0Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -504,7 +513,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir0Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -534,6 +543,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir1Plus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -545,7 +555,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir1Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -560,7 +570,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir1Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -588,6 +598,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir2Plus(Vec)");
 
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
@@ -600,7 +611,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir2Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -615,7 +626,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir2Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -643,6 +654,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir3Plus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -654,7 +666,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir3Plus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -669,7 +681,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir3Plus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -698,6 +710,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir0Minus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -709,7 +722,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir0Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -725,7 +738,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir0Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -753,6 +766,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir1Minus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -765,7 +779,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir1Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -781,7 +795,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir1Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -809,6 +823,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir2Minus(Vec)");
 
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
@@ -821,7 +836,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir2Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -837,7 +852,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir2Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -865,6 +880,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir3Minus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -876,7 +892,7 @@ void evaluate(OLattice< FVec >& b,
 
     ordered_spin_project_user_arg arg = {aptr, bptr, inlineSpinReconDir3Minus};
 
-    dispatch_to_threads(total_n_vec, arg, ordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", total_n_vec, arg, ordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -892,7 +908,7 @@ void evaluate(OLattice< FVec >& b,
  
     unordered_spin_project_user_arg<A, B> arg = {a, b, tab,  inlineSpinReconDir3Minus};
 
-    dispatch_to_threads(totalSize, arg, unordered_spin_project_evaluate_function);
+    dispatch_to_threads_tuned("spin_project", totalSize, arg, unordered_spin_project_evaluate_function);
     
     ///////////////////
     // Original code
@@ -922,6 +938,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir0Plus(Vec)");
 
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
@@ -979,6 +996,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir1Plus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -1034,6 +1052,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir2Plus(Vec)");
   
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -1089,6 +1108,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir3Plus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -1144,6 +1164,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir0Minus(Vec)");
 
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
@@ -1201,6 +1222,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir1Minus(Vec)");
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
 
@@ -1256,6 +1278,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir2Minus(Vec)");
 
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
@@ -1313,6 +1336,7 @@ void evaluate(OLattice< FVec >& b,
 	      OLattice< FVec > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir3Minus(Vec)");
 
 
   const OLattice< HVec >& a = static_cast<const OLattice< HVec > &>(rhs.expression().child());
@@ -62,6 +62,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y += a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -125,6 +126,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y -= a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -189,6 +191,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -217,7 +220,8 @@ void evaluate( OLattice< TVec > &d,
     
     ordered_vaxpy3_user_arg a = {zptr, aptr, xptr, yptr};
 
-    dispatch_to_threads(total_n_3vec, a, ordered_vaxpy3_evaluate_function);
+    dispatch_to_threads_tuned("vaxpy3_z", total_n_3vec, a, ordered_vaxpy3_evaluate_function,
+			      &d != &x && &d != &y);
     
     ////////////////
     // Original code
@@ -233,7 +237,8 @@ void evaluate( OLattice< TVec > &d,
 
     unordered_vaxpy3_z_user_arg arg(x, y, d, aptr, tab);
 
-    dispatch_to_threads(totalSize, arg, unordered_vaxpy3_z_evaluate_function);
+    dispatch_to_threads_tuned("vaxpy3_z", totalSize, arg, unordered_vaxpy3_z_evaluate_function,
+			      &d != &x && &d != &y);
 
     ////////////////
     // Original code
@@ -269,6 +274,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y + a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + a*x");
 
 
   // Peel the stuff out of the expression
@@ -352,6 +358,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right());
@@ -429,6 +436,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y - a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - a*x");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().left());
 
@@ -508,6 +516,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y += x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += x*a");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().left());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().right());
@@ -576,6 +585,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y -= x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= x*a");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().left());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().right());
@@ -646,6 +656,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -729,6 +740,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y + x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + x*a");
 
 
   // Peel the stuff out of the expression
@@ -815,6 +827,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right());
 
@@ -894,6 +907,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y - x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - x*a");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().left());
 
@@ -974,6 +988,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v+v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v+v");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
@@ -1041,6 +1056,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v-v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v-v");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
@@ -1106,6 +1122,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v = a*v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*v");
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
 
@@ -1166,6 +1183,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v = v*a " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = v*a");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().right());
@@ -1476,6 +1494,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1567,6 +1586,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1664,6 +1684,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1767,6 +1788,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1857,6 +1879,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1948,6 +1971,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2045,6 +2069,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2148,6 +2173,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2227,12 +2253,14 @@ norm2(const QDPType<TVec ,OLattice< TVec > >& s1, const Subset& s)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using BJ sumsq" << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq");
 
   if ( s.hasOrderedRep() ) {
 
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ sumsq " << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq");
     int n_3vec = (s.end() - s.start() + 1);
     const REAL *s1ptr =  &(s1.elem(s.start()).elem(0).elem(0).real());
     
@@ -2273,6 +2301,7 @@ norm2(const QDPType<TVec ,OLattice< TVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using BJ sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq all");
 
   int n_3vec = (all.end() - all.start() + 1);
   const REAL *s1ptr =  &(s1.elem(all.start()).elem(0).elem(0).real());
@@ -2296,6 +2325,7 @@ innerProduct(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -2337,6 +2367,7 @@ innerProduct(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProduct s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct s");
 
     // This BinaryReturn has Type_t
     // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -2404,6 +2435,7 @@ innerProductReal(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -2444,6 +2476,7 @@ innerProductReal(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProductReal s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal s");
 
     // This BinaryReturn has Type_t
     // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -2495,6 +2528,7 @@ norm2(const multi1d< OLattice< TVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE multi1d sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE multi1d sumsq all");
 
   int n_3vec = (all.end() - all.start() + 1);
   DOUBLE ltmp = 0;
@@ -2523,6 +2557,7 @@ innerProduct(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: multi1d innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("multi1d innerProduct all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -2573,6 +2608,7 @@ innerProductReal(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal(multi1d) all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal(multi1d) all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
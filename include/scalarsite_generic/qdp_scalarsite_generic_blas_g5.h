@@ -61,6 +61,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += a*P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -128,6 +129,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += a*P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -194,6 +196,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= a*P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -258,6 +261,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= a*P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -322,6 +326,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -382,6 +387,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -442,6 +448,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -501,6 +508,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -565,6 +573,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a*P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a*P{+} y");
 
 
   // Peel the stuff out of the expression
@@ -653,6 +662,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a*P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a*P{-} y");
 
 
   // Peel the stuff out of the expression
@@ -741,6 +751,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a*P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a*P{+} y");
 
 
   // Peel the stuff out of the expression
@@ -829,6 +840,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a*P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a*P{-} y");
 
 
   // Peel the stuff out of the expression
@@ -915,6 +927,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{+} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -998,6 +1011,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{-} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -1083,6 +1097,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{+} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -1168,6 +1183,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{-} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -1248,6 +1264,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   cout << "BJ: v = a*P{+}v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*P{+}v");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right().child());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
@@ -1314,6 +1331,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   cout << "BJ: v = a*P{-}v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*P{-}v");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right().child());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
@@ -1384,6 +1402,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*P+y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*P+y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1483,6 +1502,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*P-y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*P-y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1580,6 +1600,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x - b*P+y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*P+y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1676,6 +1697,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x - b*P-y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*P-y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1771,6 +1793,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*(GammaConst<Ns,Ns*Ns-1>()*x)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*(GammaConst<Ns,Ns*Ns-1>()*x)");
 
 
    typedef BinaryNode< 
@@ -1855,6 +1878,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a GammaConst<Ns,Ns*Ns-1>()*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a GammaConst<Ns,Ns*Ns-1>()*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -1954,6 +1978,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*y");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -2059,6 +2084,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = GammaConst<Ns,Ns*Ns-1>()*(ax - by)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = GammaConst<Ns,Ns*Ns-1>()*(ax - by)");
 
   typedef BinaryNode<OpSubtract,
 	             BinaryNode<OpMultiply,
@@ -2167,6 +2193,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -2285,6 +2312,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -2400,6 +2428,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a GammaConst<Ns,Ns*Ns-1>()*i*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -2507,6 +2536,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a GammaConst<Ns,Ns*Ns-1>()*i*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -2616,6 +2646,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z += a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z += a GammaConst<Ns,Ns*Ns-1>()*i*y");
 
 #if 0
   typedef BinaryNode<OpMultiply,
@@ -2722,6 +2753,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z -= a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z -= a GammaConst<Ns,Ns*Ns-1>()*i*y");
 
 #if 0 
   typedef BinaryNode<OpMultiply,
@@ -34,6 +34,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OScalar< CScal > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("vector z *= complex a");
   const OScalar< CScal >& a = static_cast< const OScalar<CScal >&>(rhs.expression().child()); 
 
 #ifdef DEBUG_CBLAS  
@@ -94,6 +95,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("vector z = complex a * vector x");
   const OScalar< CScal >& a = static_cast< const OScalar<CScal >&>(rhs.expression().left()); 
   
   const OLattice< CTVec > &x = static_cast<const OLattice< CTVec >&>(rhs.expression().right());
@@ -161,6 +163,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("vector z = vector x * complex a");
   const OScalar< CScal >& a = static_cast< const OScalar<CScal >&>(rhs.expression().right()); 
   
   const OLattice< CTVec > &x = static_cast<const OLattice< CTVec >&>(rhs.expression().left());
@@ -226,6 +229,7 @@ void evaluate(OLattice< CTVec >& d,
 	      OLattice< CTVec > > &rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("y += a*x");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "y += a*x" << endl;
@@ -290,6 +294,7 @@ void evaluate(OLattice< CTVec >& d,
 	      OLattice< CTVec > > &rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("y += x*a");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "y += x*a" << endl;
@@ -352,6 +357,7 @@ void evaluate(OLattice< CTVec >& d,
 	      OLattice< CTVec > > &rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("y -= a*x");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "y -= a*x" << endl;
@@ -418,6 +424,7 @@ void evaluate(OLattice< CTVec >& d,
 	      OLattice< CTVec > > &rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("y -= x*a");
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "y -= x*a" << endl;
 #endif
@@ -485,6 +492,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = a*x + y");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = a*x + y" << endl;
@@ -568,6 +576,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = x*a + y");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = x*a + y" << endl;
@@ -651,6 +660,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = a*x - y");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = a*x - y" << endl;
@@ -733,6 +743,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = x*a - y");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = x*a - y" << endl;
@@ -818,6 +829,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = y + a*x");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = y + a*x" << endl;
@@ -902,6 +914,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = y + x*a");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = y + x*a" << endl;
@@ -988,6 +1001,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = y - a*x");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = y - a*x" << endl;
@@ -1075,6 +1089,7 @@ void evaluate( OLattice< CTVec > &d,
 	       OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = y - x*a");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = y - x*a" << endl;
@@ -1165,6 +1180,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = ax + by");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = a*x + b*y" << endl;
@@ -1258,6 +1274,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = xa + by");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = x*a + b*y" << endl;
@@ -1356,6 +1373,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = ax + yb");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = a*x + y*b" << endl;
@@ -1460,6 +1478,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = xa + yb");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = x*a + y*b" << endl;
@@ -1551,6 +1570,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = ax - by");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = a*x - b*y" << endl;
@@ -1644,6 +1664,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = xa - by");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = x*a - b*y" << endl;
@@ -1742,6 +1763,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = ax - yb");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = a*x - y*b" << endl;
@@ -1846,6 +1868,7 @@ void evaluate( OLattice< CTVec > &d,
 	        OLattice< CTVec > > &rhs,
 	       const Subset& s)
 {
+  QDP_KERNEL_SELECTED("z = xa - yb");
 
 #ifdef DEBUG_CBLAS
   QDPIO::cout << "z = x*a - y*b" << endl;
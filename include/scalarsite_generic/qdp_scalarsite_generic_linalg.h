@@ -30,6 +30,7 @@ typedef RComplex<REAL>  RComplexFloat;
 #include "scalarsite_generic/generic_mat_vec.h"
 // #include "scalarsite_generic/generic_adj_mat_vec.h" -- No longer used."
 #include "scalarsite_generic/generic_addvec.h"
+#include "scalarsite_generic/generic_small_nc.h"
 
 
 // #define QDP_SCALARSITE_DEBUG
@@ -453,6 +454,13 @@ operator+(const PScalar<PColorVector<RComplexFloat,3> >& l,
 }
 
 
+// Optimized versions of the colour matrix products above for SU(2),
+// SU(4) and SU(5), from the unrolled templates of generic_small_nc.h
+QDP_GENERIC_SMALL_NC(2)
+QDP_GENERIC_SMALL_NC(4)
+QDP_GENERIC_SMALL_NC(5)
+
+
 #if 1
 
 ////////////////////////////////
@@ -500,7 +508,8 @@ void evaluate(OLattice<PSpinVector<PColorVector<RComplexFloat, 3>, 2> >& d,
     
     ordered_linalg_user_arg a(d, l, r, base);
     
-    dispatch_to_threads(totalSize, a, ordered_linalg_evaluate_userfunc);
+    dispatch_to_threads_tuned("mult_su3_mat_hvec", totalSize, a, ordered_linalg_evaluate_userfunc,
+			      &d != &r);
 
     ////////////////////
     // Original code
@@ -525,7 +534,8 @@ void evaluate(OLattice<PSpinVector<PColorVector<RComplexFloat, 3>, 2> >& d,
 
     unordered_linalg_user_arg arg(d, l, r, tab);
 
-    dispatch_to_threads(totalSize, arg, unordered_linalg_evaluate_userfunc);
+    dispatch_to_threads_tuned("mult_su3_mat_hvec", totalSize, arg, unordered_linalg_evaluate_userfunc,
+			      &d != &r);
     
     ////////////////////
     // Original code
@@ -77,6 +77,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: y += a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -143,6 +144,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: y -= a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -209,6 +211,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = a*x + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -290,6 +293,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = y + a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + a*x");
 
 
   // Peel the stuff out of the expression
@@ -373,6 +377,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = a*x - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right());
@@ -453,6 +458,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = y - a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - a*x");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().left());
 
@@ -528,6 +534,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: y += x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += x*a");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().left());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().right());
@@ -590,6 +597,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: y -= x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= x*a");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().left());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().right());
@@ -657,6 +665,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = x*a + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -735,6 +744,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = y + x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + x*a");
 
 
   // Peel the stuff out of the expression
@@ -817,6 +827,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = x*a - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right());
 
@@ -896,6 +907,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "SSE: z = y - x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - x*a");
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().left());
 
@@ -972,6 +984,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "SSE: v+v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v+v");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
@@ -1034,6 +1047,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "SSE: v-v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v-v");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&>(rhs.expression().right());
@@ -1097,6 +1111,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "SSE: v = a*v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*v");
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
 
@@ -1156,6 +1171,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   cout << "SSE: v = v*a " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = v*a");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().left());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().right());
@@ -1457,6 +1473,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1545,6 +1562,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1640,6 +1658,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1742,6 +1761,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1831,6 +1851,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1922,6 +1943,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2018,6 +2040,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2120,6 +2143,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2206,12 +2230,14 @@ norm2(const QDPType<TVec ,OLattice< TVec > >& s1, const Subset& s)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE sumsq" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE sumsq");
 
   if ( s.hasOrderedRep() ) {
 
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ sumsq " << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq");
     int n_real = (s.end() - s.start() + 1);
     ordered_sse_norm_single_user_arg arg;
     arg.vptr = (REAL32*) &(s1.elem(s.start()).elem(0).elem(0).real());
@@ -2257,6 +2283,7 @@ norm2(const QDPType<TVec ,OLattice< TVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE sumsq all");
 
   int n_real = (all.end() - all.start() + 1);
   ordered_sse_norm_single_user_arg arg;
@@ -2287,6 +2314,7 @@ innerProduct(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -2331,6 +2359,7 @@ innerProduct(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProduct s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct s");
 
     // This BinaryReturn has Type_t
     // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -2389,6 +2418,7 @@ innerProductReal(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -2434,6 +2464,7 @@ innerProductReal(const QDPType< TVec, OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProductReal s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal s");
 
     // This BinaryReturn has Type_t
     // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -2478,6 +2509,7 @@ norm2(const multi1d< OLattice< TVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE multi1d sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE multi1d sumsq all");
 
   int n_real = (all.end() - all.start() + 1);
   REAL64 ltmp = 0;
@@ -2506,6 +2538,7 @@ inline UnaryReturn<OLattice< TVec >, FnNorm2>::Type_t
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE multi1d sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE multi1d sumsq all");
 
   REAL64 ltmp = 0;
 
@@ -2552,6 +2585,7 @@ innerProduct(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: multi1d innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("multi1d innerProduct all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RComplex<PScalar<REAL> > > > >
@@ -2600,6 +2634,7 @@ innerProduct(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: multi1d innerProduct subset" << endl;
 #endif
+  QDP_KERNEL_SELECTED("multi1d innerProduct subset");
 
   
   // This BinaryReturn has Type_t
@@ -2680,6 +2715,7 @@ innerProductReal(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal(multi1d) all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal(multi1d) all");
 
   // This BinaryReturn hasType_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -2726,6 +2762,7 @@ innerProductReal(const multi1d< OLattice<TVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal(multi1d) all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal(multi1d) all");
 
   // This BinaryReturn hasType_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL> > > > >
@@ -75,6 +75,7 @@ void evaluate(OLattice< DVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y += a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*x");
 
   const OLattice< DVec >& x = static_cast<const OLattice< DVec > &>(rhs.expression().right());
   const OScalar< DScal >& a = static_cast<const OScalar< DScal > &> (rhs.expression().left());
@@ -135,6 +136,7 @@ void evaluate(OLattice< DVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y -= a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*x");
 
   const OLattice< DVec >& x = static_cast<const OLattice< DVec > &>(rhs.expression().right());
   const OScalar< DScal >& a = static_cast<const OScalar< DScal > &> (rhs.expression().left());
@@ -201,6 +203,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -298,6 +301,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y + a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + a*x");
 
 
   // Peel the stuff out of the expression
@@ -396,6 +400,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y");
 
 
   const OLattice< DVec >& y = static_cast<const OLattice< DVec >&> (rhs.expression().right());
@@ -490,6 +495,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y - a*x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - a*x");
 
   const OLattice< DVec >& y = static_cast<const OLattice< DVec >&> (rhs.expression().left());
 
@@ -583,6 +589,7 @@ void evaluate(OLattice< DVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y += x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += x*a");
 
   const OLattice< DVec >& x = static_cast<const OLattice< DVec > &>(rhs.expression().left());
   const OScalar< DScal >& a = static_cast<const OScalar< DScal > &> (rhs.expression().right());
@@ -648,6 +655,7 @@ void evaluate(OLattice< DVec >& d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "y -= x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= x*a");
 
   const OLattice< DVec >& x = static_cast<const OLattice< DVec > &>(rhs.expression().left());
   const OScalar< DScal >& a = static_cast<const OScalar< DScal > &> (rhs.expression().right());
@@ -715,6 +723,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -813,6 +822,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y + x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y + x*a");
 
 
   // Peel the stuff out of the expression
@@ -912,6 +922,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y");
 
   const OLattice< DVec >& y = static_cast<const OLattice< DVec >&> (rhs.expression().right());
 
@@ -1009,6 +1020,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = y - x*a" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = y - x*a");
 
   const OLattice< DVec >& y = static_cast<const OLattice< DVec >&> (rhs.expression().left());
 
@@ -1104,6 +1116,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v+v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v+v");
 
   const OLattice< DVec >& x = static_cast<const OLattice< DVec >&>(rhs.expression().left());
   const OLattice< DVec >& y = static_cast<const OLattice< DVec >&>(rhs.expression().right());
@@ -1185,6 +1198,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v-v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v-v");
 
   const OLattice< DVec >& x = static_cast<const OLattice< DVec >&>(rhs.expression().left());
   const OLattice< DVec >& y = static_cast<const OLattice< DVec >&>(rhs.expression().right());
@@ -1267,6 +1281,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v = a*v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*v");
   const OLattice< DVec > &x = static_cast<const OLattice< DVec >&>(rhs.expression().right());
   const OScalar< DScal > &a = static_cast<const OScalar< DScal >&>(rhs.expression().left());
 
@@ -1330,6 +1345,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   cout << "BJ: v = v*a " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = v*a");
 
   const OLattice< DVec > &x = static_cast<const OLattice< DVec >&>(rhs.expression().left());
   const OScalar< DScal > &a = static_cast<const OScalar< DScal >&>(rhs.expression().right());
@@ -1644,6 +1660,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1754,6 +1771,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1869,6 +1887,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1994,6 +2013,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a + y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a + y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2105,6 +2125,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2216,6 +2237,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - b*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - b*y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2333,6 +2355,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = a*x - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2458,6 +2481,7 @@ void evaluate( OLattice< DVec > &d,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "z = x*a - y*b" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x*a - y*b");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -2559,12 +2583,14 @@ norm2(const QDPType<DVec ,OLattice< DVec > >& s1, const Subset& s)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using BJ sumsq" << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq");
 
   if ( s.hasOrderedRep() ) {
 
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ sumsq " << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq");
 
     ordered_norm_double_user_arg arg;
     int n4vec = s.end()-s.start()+1;
@@ -2622,6 +2648,7 @@ norm2(const QDPType<DVec ,OLattice< DVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using BJ sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("sumsq all");
   ordered_norm_double_user_arg arg;
   int n4vec = all.end()-all.start()+1;
 
@@ -2665,6 +2692,7 @@ innerProduct(const QDPType< DVec, OLattice<DVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct all");
     ordered_inner_product_double_user_arg arg;
     int n4vec = all.end()-all.start()+1;
     arg.xptr = (REAL64*)&(v1.elem(all.start()).elem(0).elem(0).real());
@@ -2734,6 +2762,7 @@ innerProduct(const QDPType< DVec, OLattice<DVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProduct s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProduct s");
     ordered_inner_product_double_user_arg arg;
     int n4vec = s.end()-s.start()+1;
     arg.xptr = (REAL64*)&(v1.elem(s.start()).elem(0).elem(0).real());
@@ -2819,6 +2848,7 @@ innerProductReal(const QDPType< DVec, OLattice<DVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL64> > > > >
@@ -2859,6 +2889,7 @@ innerProductReal(const QDPType< DVec, OLattice<DVec> > &v1,
 #ifdef DEBUG_BLAS
     QDPIO::cout << "BJ: innerProductReal s" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal s");
 
     // This BinaryReturn has Type_t
     // OScalar<OScalar<OScalar<RScalar<PScalar<REAL64> > > > >
@@ -2910,6 +2941,7 @@ norm2(const multi1d< OLattice< DVec > >& s1)
 #ifdef DEBUG_BLAS
   QDPIO::cout << "Using SSE multi1d sumsq all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("SSE multi1d sumsq all");
 
   int n_4vec = (all.end() - all.start() + 1);
   REAL64 ltmp = 0;
@@ -2938,6 +2970,7 @@ innerProduct(const multi1d< OLattice<DVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: multi1d innerProduct all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("multi1d innerProduct all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RComplex<PScalar<REAL64> > > > >
@@ -2990,6 +3023,7 @@ innerProductReal(const multi1d< OLattice<DVec> > &v1,
 #ifdef DEBUG_BLAS
   QDPIO::cout << "BJ: innerProductReal(multi1d) all" << endl;
 #endif
+  QDP_KERNEL_SELECTED("innerProductReal(multi1d) all");
 
   // This BinaryReturn has Type_t
   // OScalar<OScalar<OScalar<RScalar<PScalar<REAL64> > > > >
@@ -46,6 +46,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += a*P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -90,6 +91,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += a*P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += a*P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -137,6 +139,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= a*P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -183,6 +186,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= a*P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= a*P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().right().child());
   const OScalar< TScal >& a = static_cast<const OScalar< TScal > &> (rhs.expression().left());
@@ -229,6 +233,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -271,6 +276,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y += P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y += P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -311,6 +317,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= P{+}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= P{+}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -348,6 +355,7 @@ void evaluate(OLattice< TVec >& d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "y -= P{-}x" << endl;
 #endif
+  QDP_KERNEL_SELECTED("y -= P{-}x");
 
   const OLattice< TVec >& x = static_cast<const OLattice< TVec > &>(rhs.expression().child());
 
@@ -395,6 +403,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a*P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a*P{+} y");
 
 
   // Peel the stuff out of the expression
@@ -463,6 +472,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a*P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a*P{-} y");
 
 
   // Peel the stuff out of the expression
@@ -530,6 +540,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a*P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a*P{+} y");
 
 
   // Peel the stuff out of the expression
@@ -597,6 +608,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a*P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a*P{-} y");
 
 
   // Peel the stuff out of the expression
@@ -665,6 +677,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{+} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -730,6 +743,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{-} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -794,6 +808,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{+} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{+} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -857,6 +872,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + P{-} y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + P{-} y");
 
 
   const OLattice< TVec >& y = static_cast<const OLattice< TVec >&> (rhs.expression().right().child());
@@ -918,6 +934,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   cout << "BJ: v = a*P{+}v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*P{+}v");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right().child());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
@@ -963,6 +980,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   cout << "BJ: v = a*P{-}v " << endl;
 #endif
+  QDP_KERNEL_SELECTED("v = a*P{-}v");
 
   const OLattice< TVec > &x = static_cast<const OLattice< TVec >&>(rhs.expression().right().child());
   const OScalar< TScal > &a = static_cast<const OScalar< TScal >&>(rhs.expression().left());
@@ -1013,6 +1031,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*P+y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*P+y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1090,6 +1109,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*P-y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*P-y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1167,6 +1187,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x - b*P+y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*P+y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1243,6 +1264,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x - b*P-y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x - b*P-y");
 
   // Peel the stuff out of the expression
   // y is the right side of rhs
@@ -1320,6 +1342,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*(GammaConst<Ns,Ns*Ns-1>()*x)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*(GammaConst<Ns,Ns*Ns-1>()*x)");
 
 
    typedef BinaryNode< 
@@ -1380,6 +1403,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a GammaConst<Ns,Ns*Ns-1>()*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a GammaConst<Ns,Ns*Ns-1>()*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -1458,6 +1482,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*y");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -1546,6 +1571,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = GammaConst<Ns,Ns*Ns-1>()*(ax - by)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = GammaConst<Ns,Ns*Ns-1>()*(ax - by)");
 
   typedef BinaryNode<OpSubtract,
 	             BinaryNode<OpMultiply,
@@ -1637,6 +1663,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -1737,6 +1764,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = a*x + b*GammaConst<Ns,Ns*Ns-1>()*timesI(y)");
 
   typedef BinaryNode<OpMultiply,
             Reference< QDPType<TScal, OScalar< TScal > > >,  
@@ -1835,6 +1863,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x + a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x + a GammaConst<Ns,Ns*Ns-1>()*i*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -1923,6 +1952,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z = x - a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z = x - a GammaConst<Ns,Ns*Ns-1>()*i*y");
   const OLattice<TVec>& x = static_cast<const OLattice<TVec>&>(rhs.expression().left());
 
   typedef BinaryNode<OpMultiply,
@@ -2013,6 +2043,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z += a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z += a GammaConst<Ns,Ns*Ns-1>()*i*y");
 
 #if 0
   typedef BinaryNode<OpMultiply,
@@ -2099,6 +2130,7 @@ void evaluate( OLattice< TVec > &d,
 #ifdef DEBUG_BLAS_G5
   QDPIO::cout << "z -= a GammaConst<Ns,Ns*Ns-1>()*i*y" << endl;
 #endif
+  QDP_KERNEL_SELECTED("z -= a GammaConst<Ns,Ns*Ns-1>()*i*y");
 
 #if 0 
   typedef BinaryNode<OpMultiply,
@@ -39,6 +39,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir0Plus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -117,6 +118,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir0Minus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -195,6 +197,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir1Plus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -275,6 +278,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir1Minus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -354,6 +358,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir2Plus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -429,6 +434,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir2Minus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -509,6 +515,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir3Plus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -587,6 +594,7 @@ void evaluate(OLattice< HVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("HalfVec = adj(u)*SpinProjectDir3Minus(Vec)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left().child());
   const OLattice< FVec32 >& a = static_cast< const OLattice< FVec32 >& >(rhs.expression().right().child());
 
@@ -31,6 +31,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir0Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -109,6 +110,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir0Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -188,6 +190,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir1Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -268,6 +271,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir1Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -351,6 +355,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir2Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -437,6 +442,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir2Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -519,6 +525,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir3Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -601,6 +608,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec = SpinReconstructDir3Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -685,6 +693,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir0Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -768,6 +777,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir0Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -851,6 +861,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir1Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -931,6 +942,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir1Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -1013,6 +1025,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir2Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -1094,6 +1107,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir2Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -1174,6 +1188,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir3Plus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
@@ -1256,6 +1271,7 @@ void evaluate(OLattice< FVec32 >& d,
                     >&rhs,
 	      const Subset& s)
 {
+  QDP_KERNEL_SELECTED("Vec += SpinReconstructDir3Minus( u * psi)");
   const OLattice< SU3Mat32 >& u = static_cast< const OLattice< SU3Mat32 >& >(rhs.expression().left());
   const OLattice< HVec32 >& a = static_cast< const OLattice< HVec32 >& >(rhs.expression().right());
 
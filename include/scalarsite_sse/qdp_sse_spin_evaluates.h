@@ -36,6 +36,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir0Plus(Vec)");
 
   //  Get at pointer for 4 vec
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
@@ -94,6 +95,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir1Plus(Vec)");
 
   
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
@@ -148,6 +150,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir2Plus(Vec)");
   
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
 
@@ -201,6 +204,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir3Plus(Vec)");
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
 
   if( s.hasOrderedRep() ) { 
@@ -252,6 +256,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir0Minus(Vec)");
 
   //  Get at pointer for 4 vec
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
@@ -305,6 +310,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir1Minus(Vec)");
 
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
 
@@ -357,6 +363,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir2Minus(Vec)");
 
   
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
@@ -411,6 +418,7 @@ void evaluate(OLattice< HVec32 >& b,
 	      OLattice< HVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinProjectDir3Minus(Vec)");
   const OLattice< FVec32 >& a = static_cast<const OLattice< FVec32 > &>(rhs.expression().child());
 
   if(s.hasOrderedRep()) { 
@@ -466,6 +474,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir0Plus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -520,6 +529,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir1Plus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -574,6 +584,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir2Plus(Vec)");
 
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
@@ -628,6 +639,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir3Plus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -681,6 +693,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir0Minus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -735,6 +748,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir1Minus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -788,6 +802,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir2Minus(Vec)");
 
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
@@ -842,6 +857,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d = SpinReconstructDir3Minus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -897,6 +913,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir0Plus(Vec)");
 
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
@@ -951,6 +968,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir1Plus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -1004,6 +1022,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir2Plus(Vec)");
   
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -1057,6 +1076,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir3Plus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -1110,6 +1130,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir0Minus(Vec)");
 
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
@@ -1165,6 +1186,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir1Minus(Vec)");
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
 
@@ -1218,6 +1240,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir2Minus(Vec)");
 
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
@@ -1272,6 +1295,7 @@ void evaluate(OLattice< FVec32 >& b,
 	      OLattice< FVec32 > > &rhs,
 	      const Subset& s) 
 {
+  QDP_KERNEL_SELECTED("d += SpinReconstructDir3Minus(Vec)");
 
 
   const OLattice< HVec32 >& a = static_cast<const OLattice< HVec32 > &>(rhs.expression().child());
@@ -0,0 +1,76 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Tables of the blocks of a multigrid aggregation
+ */
+
+#include "qdp.h"
+#include "qdp_aggregate.h"
+
+namespace QDP
+{
+
+  BlockAggregation::BlockAggregation(const multi1d<int>& block) :
+    bsize(block), csize(Nd), local_csize(Nd)
+  {
+    if (block.size() != Nd)
+      QDP_error_exit("BlockAggregation: block has %d extents, need %d", block.size(), Nd);
+
+    const multi1d<int>& subgrid = Layout::subgridLattSize();
+    nblocks = 1;
+    bvol = 1;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (block[mu] <= 0 || subgrid[mu] % block[mu] != 0)
+	QDP_error_exit("BlockAggregation: block extent %d does not divide the subgrid extent %d in direction %d",
+		       block[mu], subgrid[mu], mu);
+
+      local_csize[mu] = subgrid[mu] / block[mu];
+      csize[mu] = Layout::lattSize()[mu] / block[mu];
+      nblocks *= local_csize[mu];
+      bvol *= block[mu];
+    }
+
+    // Block of every fine site, from its coordinate within the node
+    const int nsites = Layout::sitesOnNode();
+    const int node = Layout::nodeNumber();
+    const multi1d<int>& nodecoord = Layout::nodeCoord();
+    blk.resize(nsites);
+
+    Layout::LatticeCoord coord;
+    for(int i=0; i < nsites; ++i)
+    {
+      Layout::siteCoords(node, i, coord);
+
+      int b = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+      {
+	const int local = coord[mu] - nodecoord[mu]*subgrid[mu];
+	b = b*local_csize[mu] + local / block[mu];
+      }
+      blk[i] = b;
+    }
+
+    // Fine sites grouped by block, each group in increasing site order
+    std::vector<int> fill(nblocks, 0);
+    fine.resize(nsites);
+    for(int i=0; i < nsites; ++i)
+    {
+      const int b = blk[i];
+      fine[b*bvol + fill[b]++] = i;
+    }
+  }
+
+
+  multi1d<int> BlockAggregation::coarseCoord(int b) const
+  {
+    const multi1d<int>& nodecoord = Layout::nodeCoord();
+    multi1d<int> coord(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      coord[mu] = nodecoord[mu]*local_csize[mu] + b % local_csize[mu];
+      b /= local_csize[mu];
+    }
+    return coord;
+  }
+
+} // namespace QDP
@@ -0,0 +1,340 @@
+/*! @file
+ * @brief Statistics kept by the lattice memory allocators
+ *
+ * Everything is a fixed size table, so keeping the counts costs a few
+ * additions and never allocates. The trace of setLatticeTrace, off by
+ * default, is the exception.
+ */
+
+#include "qdp.h"
+#include <cstring>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <algorithm>
+
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+
+namespace QDP
+{
+  namespace Allocator
+  {
+    namespace
+    {
+      AllocStats stats;
+      bool stats_at_finalize = false;
+
+      //! Current pushFunc tags - deeper nesting keeps the innermost that fits
+      enum { MaxTagDepth = 64 };
+      const char* tag_stack[MaxTagDepth];
+      int tag_depth = 0;
+
+      const char* untagged = "untagged";
+      const char* overflow = "other";
+
+      //! OLattice allocations of one reason and caller, see setLatticeTrace
+      struct LatticeSite
+      {
+	enum { Depth = 6 };
+
+	std::string reason;
+	const char* tag;      // the innermost pushFunc tag, or null
+	size_t allocs;
+	size_t bytes;
+	size_t site_bytes;    // of the last one
+	int nframes;
+	void* frames[Depth];  // the stack of the first one
+      };
+
+      bool lattice_trace = false;
+      std::mutex trace_lock;
+
+      std::map<std::pair<std::string, size_t>, LatticeSite>& latticeSites()
+      {
+	static std::map<std::pair<std::string, size_t>, LatticeSite> s;
+	return s;
+      }
+
+      int sizeClass(size_t bytes)
+      {
+	int k = 0;
+	while (bytes > 1 && k < AllocStats::NumSizeClasses-1)
+	{
+	  bytes >>= 1;
+	  ++k;
+	}
+	return k;
+      }
+
+      TagStats& tagStats(const char* tag)
+      {
+	for(int t=0; t < stats.num_tags; ++t)
+	  if (stats.tags[t].tag == tag || strcmp(stats.tags[t].tag, tag) == 0)
+	    return stats.tags[t];
+
+	// The last slot collects every tag that does not fit
+	if (stats.num_tags == AllocStats::MaxTags-1)
+	  tag = overflow;
+	if (stats.num_tags == AllocStats::MaxTags)
+	  return stats.tags[AllocStats::MaxTags-1];
+
+	TagStats& t = stats.tags[stats.num_tags++];
+	t.tag = tag;
+	t.allocs = 0;
+	t.bytes = 0;
+	return t;
+      }
+    }
+
+
+    const AllocStats& getAllocStats()
+    {
+      return stats;
+    }
+
+
+    void resetAllocPeak()
+    {
+      stats.peak_bytes = stats.current_bytes;
+      stats.peak_objects = stats.live_objects;
+      stats.fast_peak_bytes = stats.fast_current_bytes;
+      stats.pool_peak_bytes = stats.pool_bytes;
+    }
+
+
+    void setAllocStatsAtFinalize(bool p)
+    {
+      stats_at_finalize = p;
+    }
+
+
+    bool allocStatsAtFinalize()
+    {
+      return stats_at_finalize;
+    }
+
+
+    void printAllocStats()
+    {
+      if (! Layout::primaryNode())
+	return;
+
+      const double MB = 1024.0*1024.0;
+
+      QDPIO::cout << "Lattice memory statistics" << std::endl;
+      printf("  current= %.1f MB  peak= %.1f MB  live objects= %lu  peak objects= %lu\n",
+	     stats.current_bytes/MB, stats.peak_bytes/MB,
+	     (unsigned long)stats.live_objects, (unsigned long)stats.peak_objects);
+      printf("  allocs= %lu  frees= %lu  failures= %lu\n",
+	     (unsigned long)stats.allocs, (unsigned long)stats.frees, (unsigned long)stats.failures);
+      if (stats.failures > 0)
+	printf("  last failed request= %lu bytes\n", (unsigned long)stats.failed_bytes);
+      if (stats.fast_allocs + stats.fast_fallbacks > 0)
+	printf("  fast tier= %.1f MB  peak= %.1f MB  allocs= %lu  fallbacks= %lu\n",
+	       stats.fast_current_bytes/MB, stats.fast_peak_bytes/MB,
+	       (unsigned long)stats.fast_allocs, (unsigned long)stats.fast_fallbacks);
+      if (stats.pool_arenas > 0)
+	printf("  pool arenas= %lu  mapped= %.1f MB  peak= %.1f MB\n",
+	       (unsigned long)stats.pool_arenas, stats.pool_bytes/MB, stats.pool_peak_bytes/MB);
+
+      printf("  by size:\n");
+      for(int k=0; k < AllocStats::NumSizeClasses; ++k)
+      {
+	const SizeClassStats& c = stats.size_class[k];
+	if (c.allocs == 0)
+	  continue;
+	printf("    [%lu, %lu) bytes  allocs= %lu  live= %lu\n",
+	       (k == 0) ? 0UL : 1UL << k, 1UL << (k+1), (unsigned long)c.allocs, (unsigned long)c.live);
+      }
+
+      if (stats.num_tags > 0)
+      {
+	printf("  by tag:\n");
+	for(int t=0; t < stats.num_tags; ++t)
+	  printf("    %-32s allocs= %lu  bytes= %.1f MB\n", stats.tags[t].tag,
+		 (unsigned long)stats.tags[t].allocs, stats.tags[t].bytes/MB);
+      }
+      fflush(stdout);
+    }
+
+
+    void setLatticeTrace(bool on)
+    {
+      lattice_trace = on;
+    }
+
+
+    bool latticeTrace()
+    {
+      return lattice_trace;
+    }
+
+
+    void printLatticeTrace()
+    {
+      if (! lattice_trace || ! Layout::primaryNode())
+	return;
+
+      std::lock_guard<std::mutex> lock(trace_lock);
+
+      std::vector<const LatticeSite*> sites;
+      for(auto& s : latticeSites())
+	sites.push_back(&s.second);
+      std::sort(sites.begin(), sites.end(),
+		[](const LatticeSite* a, const LatticeSite* b) {return a->bytes > b->bytes;});
+
+      const double MB = 1024.0*1024.0;
+
+      QDPIO::cout << "Lattice allocations by reason and caller" << std::endl;
+      for(const LatticeSite* s : sites)
+      {
+	printf("  %-24s allocs= %lu  bytes= %.1f MB  bytes/site= %lu\n", s->reason.c_str(),
+	       (unsigned long)s->allocs, s->bytes/MB, (unsigned long)s->site_bytes);
+
+	if (s->tag != 0)
+	  printf("    in %s\n", s->tag);
+#if defined(__GLIBC__)
+	else
+	{
+	  char** names = backtrace_symbols(s->frames, s->nframes);
+	  for(int f=0; names != 0 && f < s->nframes; ++f)
+	    printf("    at %s\n", names[f]);
+	  ::free(names);
+	}
+#endif
+      }
+      fflush(stdout);
+    }
+
+
+    namespace Stats
+    {
+      void noteLattice(const char* reason, size_t bytes, size_t site_bytes)
+      {
+	const char* tag = 0;
+	if (tag_depth > 0)
+	  tag = tag_stack[(tag_depth <= MaxTagDepth ? tag_depth : MaxTagDepth)-1];
+
+	// The caller: the tag if there is one, else the frames above this one
+	void* frames[LatticeSite::Depth + 1];
+	int n = 0;
+	size_t caller = (size_t)tag;
+#if defined(__GLIBC__)
+	if (tag == 0)
+	{
+	  n = backtrace(frames, LatticeSite::Depth + 1);
+	  for(int f=1; f < n; ++f)
+	    caller = caller*1000003 ^ (size_t)frames[f];
+	}
+#endif
+
+	std::lock_guard<std::mutex> lock(trace_lock);
+
+	auto key = std::make_pair(std::string(reason), caller);
+	auto it = latticeSites().find(key);
+	if (it == latticeSites().end())
+	{
+	  LatticeSite s;
+	  s.reason = reason;
+	  s.tag = tag;
+	  s.allocs = 0;
+	  s.bytes = 0;
+	  s.nframes = std::max(n - 1, 0);
+	  for(int f=0; f < s.nframes; ++f)
+	    s.frames[f] = frames[f+1];
+	  it = latticeSites().insert(std::make_pair(key, s)).first;
+	}
+
+	LatticeSite& s = it->second;
+	++s.allocs;
+	s.bytes += bytes;
+	s.site_bytes = site_bytes;
+      }
+
+      void noteAlloc(size_t bytes)
+      {
+	++stats.allocs;
+	++stats.live_objects;
+	stats.current_bytes += bytes;
+
+	if (stats.current_bytes > stats.peak_bytes)
+	  stats.peak_bytes = stats.current_bytes;
+	if (stats.live_objects > stats.peak_objects)
+	  stats.peak_objects = stats.live_objects;
+
+	SizeClassStats& c = stats.size_class[sizeClass(bytes)];
+	++c.allocs;
+	++c.live;
+
+	if (tag_depth > 0)
+	{
+	  TagStats& t = tagStats(tag_stack[(tag_depth <= MaxTagDepth ? tag_depth : MaxTagDepth)-1]);
+	  ++t.allocs;
+	  t.bytes += bytes;
+	}
+      }
+
+      void noteFree(size_t bytes)
+      {
+	++stats.frees;
+	--stats.live_objects;
+	stats.current_bytes -= bytes;
+	--stats.size_class[sizeClass(bytes)].live;
+      }
+
+      void noteFailure(size_t bytes)
+      {
+	++stats.failures;
+	stats.failed_bytes = bytes;
+      }
+
+      void noteFastAlloc(size_t bytes)
+      {
+	++stats.fast_allocs;
+	stats.fast_current_bytes += bytes;
+	if (stats.fast_current_bytes > stats.fast_peak_bytes)
+	  stats.fast_peak_bytes = stats.fast_current_bytes;
+      }
+
+      void noteFastFree(size_t bytes)
+      {
+	stats.fast_current_bytes -= bytes;
+      }
+
+      void noteFastFallback(size_t bytes)
+      {
+	++stats.fast_fallbacks;
+      }
+
+      void notePoolArena(size_t bytes)
+      {
+	++stats.pool_arenas;
+	stats.pool_bytes += bytes;
+	if (stats.pool_bytes > stats.pool_peak_bytes)
+	  stats.pool_peak_bytes = stats.pool_bytes;
+      }
+
+      void notePoolArenaFree(size_t bytes)
+      {
+	--stats.pool_arenas;
+	stats.pool_bytes -= bytes;
+      }
+
+      void pushTag(const char* tag)
+      {
+	if (tag_depth < MaxTagDepth)
+	  tag_stack[tag_depth] = (tag != 0) ? tag : untagged;
+	++tag_depth;
+      }
+
+      void popTag()
+      {
+	if (tag_depth > 0)
+	  --tag_depth;
+      }
+    }
+
+  } // namespace Allocator
+} // namespace QDP
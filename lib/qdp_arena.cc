@@ -0,0 +1,164 @@
+/*! @file
+ * @brief Bump arenas for short-lived lattice temporaries, and thread scratch
+ */
+
+#include "qdp.h"
+#include <cstdlib>
+#include <algorithm>
+
+namespace QDP
+{
+  namespace Allocator
+  {
+    namespace
+    {
+      //! Innermost arena scope of this thread
+      __thread ArenaScope* current = 0;
+
+      //! Round up to the lattice alignment
+      inline size_t alignUp(size_t n)
+      {
+	return (n + QDP_ALIGNMENT_SIZE - 1) & ~size_t(QDP_ALIGNMENT_SIZE - 1);
+      }
+    }
+
+
+    ArenaScope::ArenaScope(size_t bytes) : last(0), live(0), misses(0), outer(current)
+    {
+      // Without the memory every allocation just falls back
+      size_t n = alignUp(bytes);
+      try
+      {
+	base = (unsigned char*)theQDPAllocator::Instance().allocate(n, DEFAULT);
+      }
+      catch(std::bad_alloc) {
+	base = 0;
+	n = 0;
+      }
+
+      top = peak = base;
+      end = base + n;
+
+      current = this;
+    }
+
+
+    ArenaScope::~ArenaScope()
+    {
+      if (live > 0)
+      {
+	QDPIO::cerr << "ArenaScope: " << live << " lattice objects still use the arena at the end of its scope" << std::endl;
+	QDP_abort(1);
+      }
+
+      current = outer;
+      if (base != 0)
+	theQDPAllocator::Instance().free(base);
+    }
+
+
+    void* arenaAllocate(size_t bytes)
+    {
+      ArenaScope* a = current;
+      if (a == 0)
+	return 0;
+
+      const size_t head = alignUp(sizeof(ArenaScope::Piece));
+      size_t n = head + alignUp(bytes);
+      if (n > size_t(a->end - a->top))
+      {
+	a->misses++;
+	return 0;
+      }
+
+      ArenaScope::Piece* piece = (ArenaScope::Piece*)a->top;
+      piece->prev = a->last;
+      piece->live = true;
+
+      a->last = piece;
+      a->top += n;
+      if (a->top > a->peak)
+	a->peak = a->top;
+      a->live++;
+
+      return (unsigned char*)piece + head;
+    }
+
+
+    bool arenaFree(void* p)
+    {
+      ArenaScope* a = current;
+      for(; a != 0; a = a->outer)
+	if ((unsigned char*)p >= a->base && (unsigned char*)p < a->end)
+	  break;
+
+      if (a == 0)
+	return false;
+
+      const size_t head = alignUp(sizeof(ArenaScope::Piece));
+      ArenaScope::Piece* piece = (ArenaScope::Piece*)((unsigned char*)p - head);
+      piece->live = false;
+      a->live--;
+
+      // Hand back the space of every dead piece at the top
+      while (a->last != 0 && ! a->last->live)
+      {
+	a->top = (unsigned char*)a->last;
+	a->last = a->last->prev;
+      }
+
+      return true;
+    }
+
+
+    namespace
+    {
+      //! The scratch blocks of a thread, freed when it ends
+      struct ThreadScratch
+      {
+	void* block[NumScratchSlots];
+	size_t size[NumScratchSlots];
+
+	ThreadScratch()
+	  {
+	    for(int k=0; k < NumScratchSlots; ++k)
+	    {
+	      block[k] = 0;
+	      size[k] = 0;
+	    }
+	  }
+
+	~ThreadScratch()
+	  {
+	    for(int k=0; k < NumScratchSlots; ++k)
+	      free(block[k]);
+	  }
+      };
+
+      thread_local ThreadScratch scratch;
+    }
+
+
+    void* threadScratchBytes(size_t bytes, int slot)
+    {
+      if (slot < 0 || slot >= NumScratchSlots)
+	QDP_error_exit("threadScratch: slot %d is not in [0,%d)", slot, int(NumScratchSlots));
+
+      if (bytes > scratch.size[slot])
+      {
+	// Grow geometrically so a slowly rising size settles quickly
+	size_t n = alignUp(std::max(bytes, 2*scratch.size[slot]));
+	void* p = 0;
+	if (posix_memalign(&p, QDP_ALIGNMENT_SIZE, n) != 0)
+	  QDP_error_exit("threadScratch: cannot get %lu bytes", (unsigned long)n);
+
+	free(scratch.block[slot]);
+	scratch.block[slot] = p;
+	scratch.size[slot] = n;
+      }
+
+      return scratch.block[slot];
+    }
+
+  } // namespace Allocator
+} // namespace QDP
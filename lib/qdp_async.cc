@@ -0,0 +1,120 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Independent lattice statements, sums and I/O run as tasks
+ */
+
+#include "qdp.h"
+#include "qdp_async.h"
+
+#include <pthread.h>
+
+namespace QDP
+{
+
+  AsyncTask AsyncScope::add(Task* t)
+  {
+    if (! t->state)
+      t->state.reset(new AsyncInternal::State);
+    t->state->scope = this;
+
+    std::vector<const void*> w;
+    t->writes(w);
+
+    // After every task writing what t reads or writes, or reading what t writes
+    for(int k=0; k < tasks.size(); ++k)
+    {
+      const Task* u = tasks[k];
+      if (u->wave < t->wave)
+	continue;
+
+      bool dep = false;
+      for(int i=0; i < w.size() && ! dep; ++i)
+	dep = u->reads(w[i]);
+
+      std::vector<const void*> uw;
+      u->writes(uw);
+      for(int i=0; i < uw.size() && ! dep; ++i)
+      {
+	dep = t->reads(uw[i]);
+	for(int j=0; j < w.size() && ! dep; ++j)
+	  dep = (uw[i] == w[j]);
+      }
+
+      if (dep)
+	t->wave = u->wave + 1;
+    }
+
+    tasks.push_back(t);
+    return AsyncTask(t->state);
+  }
+
+
+  //! The io() tasks of a wave, in the order recorded
+  void* AsyncScope::helperLoop(void* arg)
+  {
+    std::vector<Task*>& io = *(std::vector<Task*>*)arg;
+    for(int k=0; k < io.size(); ++k)
+      io[k]->run();
+    return 0;
+  }
+
+
+  void AsyncScope::wait()
+  {
+    if (tasks.size() == 0)
+      return;
+
+    int waves = 0;
+    for(int k=0; k < tasks.size(); ++k)
+      waves = std::max(waves, tasks[k]->wave + 1);
+
+    for(int wave=0; wave < waves; ++wave)
+    {
+      std::vector<Task*> io, rest;
+      for(int k=0; k < tasks.size(); ++k)
+	if (tasks[k]->wave == wave)
+	  (tasks[k]->helper ? io : rest).push_back(tasks[k]);
+
+      pthread_t helper;
+      bool threaded = false;
+      if (io.size() > 0)
+      {
+	threaded = (pthread_create(&helper, 0, helperLoop, (void*)&io) == 0);
+	if (! threaded)
+	  helperLoop((void*)&io);
+      }
+
+      int nwords = 0;
+      for(int k=0; k < rest.size(); ++k)
+      {
+	rest[k]->run();
+	nwords += rest[k]->words();
+      }
+
+      // The sums of the wave in one global sum
+      if (nwords > 0)
+      {
+	std::vector<REAL64> buf(nwords);
+	for(int k=0, off=0; k < rest.size(); off += rest[k]->words(), ++k)
+	  rest[k]->pack(&buf[off]);
+
+	QDPInternal::globalSumArray(&buf[0], nwords);
+
+	for(int k=0, off=0; k < rest.size(); off += rest[k]->words(), ++k)
+	  rest[k]->unpack(&buf[off]);
+      }
+
+      if (threaded)
+	pthread_join(helper, 0);
+    }
+
+    for(int k=0; k < tasks.size(); ++k)
+    {
+      tasks[k]->state->done = true;
+      tasks[k]->state->scope = 0;
+      delete tasks[k];
+    }
+    tasks.clear();
+  }
+
+} // namespace QDP
@@ -0,0 +1,519 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Background writing of lattice fields
+ */
+
+#include "qdp.h"
+#include "qdp_byteorder.h"
+#include "qdp_async_io.h"
+#include "qdp_util.h"
+
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace QDP
+{
+
+  namespace
+  {
+    //! The x-rows of this node in file order, and the linear index of their sites
+    void nodeRows(std::vector<int>& rows, std::vector<int>& sites)
+    {
+      const int xinc = Layout::subgridLattSize()[0];
+
+      for(int linear=0; linear < Layout::sitesOnNode(); ++linear)
+      {
+	multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), linear);
+	if (coord[0] % xinc != 0)
+	  continue;
+
+	int site = local_site(coord, Layout::lattSize());
+	rows.push_back(site);
+
+	for(int i=0; i < xinc; ++i)
+	  sites.push_back(Layout::linearSiteIndex(site+i));
+      }
+    }
+  }
+
+
+  //! The thread of a writer and the lock around its queue
+  struct AsyncLatticeWriter::Worker
+  {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+  };
+
+
+  AsyncLatticeWriter::AsyncLatticeWriter() : fd(-1), offset(0), checksum(0),
+					     busy(false), closing(false), worker(0)
+  {
+  }
+
+
+  AsyncLatticeWriter::~AsyncLatticeWriter()
+  {
+    wait();
+  }
+
+
+  void AsyncLatticeWriter::open(const std::string& p)
+  {
+    wait();
+
+    // Node order of the sites as they go in the file
+    if (sites.empty())
+      nodeRows(rows, sites);
+
+    // Truncate it once before anyone writes
+    int ok = 1;
+    if (Layout::primaryNode())
+    {
+      int f = ::open(p.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      ok = (f >= 0 && ::close(f) == 0) ? 1 : 0;
+    }
+    QDPInternal::broadcast(ok);
+    if (! ok)
+      QDP_error_exit("AsyncLatticeWriter: cannot create %s", p.c_str());
+
+    fd = ::open(p.c_str(), O_WRONLY);
+    if (fd < 0)
+      QDP_error_exit("AsyncLatticeWriter: cannot open %s on node %d", p.c_str(), Layout::nodeNumber());
+
+    path = p;
+    offset = 0;
+    checksum = 0;
+    closing = false;
+
+    worker = new Worker;
+    pthread_mutex_init(&worker->mutex, 0);
+    pthread_cond_init(&worker->cond, 0);
+    if (pthread_create(&worker->thread, 0, workerLoop, (void *)this) != 0)
+      QDP_error_exit("AsyncLatticeWriter: cannot start the writer thread");
+  }
+
+
+  void AsyncLatticeWriter::writeLattice(const char* data, size_t size, size_t nmemb)
+  {
+    if (! is_open())
+      QDP_error_exit("AsyncLatticeWriter: write without an open file");
+
+    Job* job = new Job;
+    job->size  = size;
+    job->nmemb = nmemb;
+    job->start = offset;
+    job->crcs.assign(Layout::vol() / Layout::subgridLattSize()[0], 0);
+
+    offset += off_t(size*nmemb)*Layout::vol();
+
+    // Snapshot, or write now if there is no room for one
+    const size_t bytes = size*nmemb*Layout::sitesOnNode();
+    char* buf = 0;
+    try
+    {
+      buf = (char *)Allocator::theQDPAllocator::Instance().allocate(bytes, Allocator::DEFAULT);
+    }
+    catch(std::bad_alloc) {
+      buf = 0;
+    }
+
+    jobs.push_back(job);
+
+    if (buf == 0)
+    {
+      job->data  = data;
+      job->owned = false;
+      run(job);
+      return;
+    }
+
+    memcpy(buf, data, bytes);
+    job->data  = buf;
+    job->owned = true;
+
+    pthread_mutex_lock(&worker->mutex);
+    queue.push_back(job);
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->mutex);
+  }
+
+
+  // Gather, swap, checksum and write the rows of one field
+  void AsyncLatticeWriter::run(Job* job)
+  {
+    const int xinc = Layout::subgridLattSize()[0];
+    const size_t sizemem  = job->size*job->nmemb;
+    const size_t rowbytes = sizemem*xinc;
+
+    std::vector<char> row_buf(rowbytes);
+
+    for(size_t r=0; r < rows.size(); ++r)
+    {
+      // Gather, swap and checksum each site in one pass
+      QDPUtil::n_uint32_t crc = 0;
+      for(int i=0; i < xinc; ++i)
+	crc = QDPUtil::crc32_to_big_endian(crc, &row_buf[i*sizemem], job->data + sites[r*xinc+i]*sizemem,
+					   job->size, job->nmemb);
+
+      job->crcs[rows[r]/xinc] = crc;
+
+      const char* p = &row_buf[0];
+      size_t n = rowbytes;
+      off_t off = job->start + off_t(rows[r])*sizemem;
+      while (n > 0)
+      {
+	ssize_t k = pwrite(fd, p, n, off);
+	if (k <= 0)
+	  QDP_error_exit("AsyncLatticeWriter: pwrite to %s failed on node %d",
+			 path.c_str(), Layout::nodeNumber());
+	p += k;
+	off += k;
+	n -= k;
+      }
+    }
+  }
+
+
+  void* AsyncLatticeWriter::workerLoop(void* arg)
+  {
+    AsyncLatticeWriter* w = (AsyncLatticeWriter *)arg;
+
+    pthread_mutex_lock(&w->worker->mutex);
+    for(;;)
+    {
+      while (w->queue.empty() && ! w->closing)
+	pthread_cond_wait(&w->worker->cond, &w->worker->mutex);
+
+      if (w->queue.empty())
+	break;
+
+      Job* job = w->queue.front();
+      w->queue.pop_front();
+      w->busy = true;
+      pthread_mutex_unlock(&w->worker->mutex);
+
+      w->run(job);
+
+      pthread_mutex_lock(&w->worker->mutex);
+      w->busy = false;
+    }
+    pthread_mutex_unlock(&w->worker->mutex);
+
+    return 0;
+  }
+
+
+  bool AsyncLatticeWriter::test()
+  {
+    if (worker == 0)
+      return true;
+
+    pthread_mutex_lock(&worker->mutex);
+    bool done = queue.empty() && ! busy;
+    pthread_mutex_unlock(&worker->mutex);
+
+    return done;
+  }
+
+
+  void AsyncLatticeWriter::wait()
+  {
+    if (! is_open())
+      return;
+
+    pthread_mutex_lock(&worker->mutex);
+    closing = true;
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->mutex);
+
+    pthread_join(worker->thread, 0);
+    pthread_mutex_destroy(&worker->mutex);
+    pthread_cond_destroy(&worker->cond);
+    delete worker;
+    worker = 0;
+
+    if (::close(fd) != 0)
+      QDP_error_exit("AsyncLatticeWriter: error closing %s on node %d", path.c_str(), Layout::nodeNumber());
+    fd = -1;
+
+    // Every node is done with the file once the row crcs are summed
+    const int xinc = Layout::subgridLattSize()[0];
+    for(std::list<Job*>::iterator j=jobs.begin(); j != jobs.end(); ++j)
+    {
+      Job* job = *j;
+      const int nrows = job->crcs.size();
+      QDPInternal::globalSumArray(&job->crcs[0], nrows);
+
+      if (Layout::primaryNode())
+      {
+	QDPUtil::CRC32Shift op;
+	QDPUtil::crc32_shift(op, job->size*job->nmemb*xinc);
+
+	QDPUtil::n_uint32_t crc = 0;
+	for(int row=0; row < nrows; ++row)
+	  crc = QDPUtil::crc32_combine(op, crc, job->crcs[row]);
+
+	checksum = QDPUtil::crc32_combine(checksum, crc, job->size*job->nmemb*Layout::vol());
+      }
+
+      if (job->owned)
+	Allocator::theQDPAllocator::Instance().free((void *)job->data);
+      delete job;
+    }
+    jobs.clear();
+
+    QDPInternal::broadcast(checksum);
+  }
+
+
+
+  //--------------------------------------------------------------------------------
+  //! The thread of a reader, the lock around its queue and the finished signal
+  struct AsyncTimeSliceReader::Worker
+  {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_cond_t done;
+  };
+
+
+  AsyncTimeSliceReader::AsyncTimeSliceReader() : fd(-1), closing(false), worker(0)
+  {
+  }
+
+
+  AsyncTimeSliceReader::~AsyncTimeSliceReader()
+  {
+    close();
+  }
+
+
+  void AsyncTimeSliceReader::open(const std::string& p)
+  {
+    close();
+
+    if (sites.empty())
+      nodeRows(rows, sites);
+
+    fd = ::open(p.c_str(), O_RDONLY);
+    if (fd < 0)
+      QDP_error_exit("AsyncTimeSliceReader: cannot open %s on node %d", p.c_str(), Layout::nodeNumber());
+
+    path = p;
+    closing = false;
+
+    worker = new Worker;
+    pthread_mutex_init(&worker->mutex, 0);
+    pthread_cond_init(&worker->cond, 0);
+    pthread_cond_init(&worker->done, 0);
+    if (pthread_create(&worker->thread, 0, workerLoop, (void *)this) != 0)
+      QDP_error_exit("AsyncTimeSliceReader: cannot start the reader thread");
+  }
+
+
+  void AsyncTimeSliceReader::close()
+  {
+    if (! is_open())
+      return;
+
+    pthread_mutex_lock(&worker->mutex);
+    closing = true;
+    queue.clear();
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->mutex);
+
+    pthread_join(worker->thread, 0);
+    pthread_mutex_destroy(&worker->mutex);
+    pthread_cond_destroy(&worker->cond);
+    pthread_cond_destroy(&worker->done);
+    delete worker;
+    worker = 0;
+
+    for(std::list<Job*>::iterator j=jobs.begin(); j != jobs.end(); ++j)
+      delete *j;
+    jobs.clear();
+
+    if (::close(fd) != 0)
+      QDP_error_exit("AsyncTimeSliceReader: error closing %s on node %d", path.c_str(), Layout::nodeNumber());
+    fd = -1;
+  }
+
+
+  void AsyncTimeSliceReader::readSlice(char* data, size_t size, size_t nmemb, int t, off_t start, bool check)
+  {
+    if (! is_open())
+      QDP_error_exit("AsyncTimeSliceReader: read without an open file");
+
+    const int tDir = Nd-1;
+    if ((t < 0) || (t >= Layout::lattSize()[tDir]))
+      QDP_error_exit("AsyncTimeSliceReader: invalid time slice %d", t);
+
+    const int xinc = Layout::subgridLattSize()[0];
+
+    Job* job = new Job;
+    job->data  = data;
+    job->size  = size;
+    job->nmemb = nmemb;
+    job->start = start;
+    job->t     = t;
+    job->check = check;
+    job->crcs.assign(Layout::vol() / Layout::lattSize()[tDir] / xinc, 0);
+    job->stored = 0;
+    job->done  = false;
+
+    jobs.push_back(job);
+
+    pthread_mutex_lock(&worker->mutex);
+    queue.push_back(job);
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->mutex);
+  }
+
+
+  // Read, checksum and swap the rows of one slice held here
+  void AsyncTimeSliceReader::run(Job* job)
+  {
+    const int xinc = Layout::subgridLattSize()[0];
+    const int slice_vol = Layout::vol() / Layout::lattSize()[Nd-1];
+    const int first = job->t * slice_vol;
+    const size_t sizemem  = job->size*job->nmemb;
+    const size_t rowbytes = sizemem*xinc;
+
+    size_t nrows = 0;
+    for(size_t r=0; r < rows.size(); ++r)
+      if (rows[r] >= first && rows[r] < first + slice_vol)
+	++nrows;
+
+    job->buf.resize(nrows*rowbytes);
+
+    char* p = job->buf.empty() ? 0 : &job->buf[0];
+    for(size_t r=0; r < rows.size(); ++r)
+    {
+      if (rows[r] < first || rows[r] >= first + slice_vol)
+	continue;
+
+      char* q = p;
+      size_t n = rowbytes;
+      off_t off = job->start + off_t(rows[r] - first)*sizemem;
+      while (n > 0)
+      {
+	ssize_t k = pread(fd, q, n, off);
+	if (k <= 0)
+	  QDP_error_exit("AsyncTimeSliceReader: pread from %s failed on node %d",
+			 path.c_str(), Layout::nodeNumber());
+	q += k;
+	off += k;
+	n -= k;
+      }
+
+      job->crcs[(rows[r] - first)/xinc] = QDPUtil::crc32_from_big_endian(0, p, p, job->size, job->nmemb*xinc);
+
+      p += rowbytes;
+    }
+
+    // The record checksum, stored big-endian after the slice
+    if (job->check && Layout::primaryNode())
+    {
+      QDPUtil::n_uint32_t crc;
+      off_t off = job->start + off_t(slice_vol)*sizemem;
+      if (pread(fd, (char *)&crc, sizeof(crc), off) != (ssize_t)sizeof(crc))
+	QDP_error_exit("AsyncTimeSliceReader: pread from %s failed on node %d",
+		       path.c_str(), Layout::nodeNumber());
+
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap((char *)&crc, sizeof(crc), 1);
+      job->stored = crc;
+    }
+  }
+
+
+  void* AsyncTimeSliceReader::workerLoop(void* arg)
+  {
+    AsyncTimeSliceReader* r = (AsyncTimeSliceReader *)arg;
+
+    pthread_mutex_lock(&r->worker->mutex);
+    for(;;)
+    {
+      while (r->queue.empty() && ! r->closing)
+	pthread_cond_wait(&r->worker->cond, &r->worker->mutex);
+
+      if (r->closing)
+	break;
+
+      Job* job = r->queue.front();
+      r->queue.pop_front();
+      pthread_mutex_unlock(&r->worker->mutex);
+
+      r->run(job);
+
+      pthread_mutex_lock(&r->worker->mutex);
+      job->done = true;
+      pthread_cond_signal(&r->worker->done);
+    }
+    pthread_mutex_unlock(&r->worker->mutex);
+
+    return 0;
+  }
+
+
+  QDPUtil::n_uint32_t AsyncTimeSliceReader::next()
+  {
+    if (jobs.empty())
+      QDP_error_exit("AsyncTimeSliceReader: next() with nothing queued");
+
+    Job* job = jobs.front();
+    jobs.pop_front();
+
+    pthread_mutex_lock(&worker->mutex);
+    while (! job->done)
+      pthread_cond_wait(&worker->done, &worker->mutex);
+    pthread_mutex_unlock(&worker->mutex);
+
+    // Into the field
+    const int xinc = Layout::subgridLattSize()[0];
+    const int slice_vol = Layout::vol() / Layout::lattSize()[Nd-1];
+    const int first = job->t * slice_vol;
+    const size_t sizemem  = job->size*job->nmemb;
+    const size_t rowbytes = sizemem*xinc;
+
+    const char* p = job->buf.empty() ? 0 : &job->buf[0];
+    for(size_t r=0; r < rows.size(); ++r)
+    {
+      if (rows[r] < first || rows[r] >= first + slice_vol)
+	continue;
+
+      for(int i=0; i < xinc; ++i)
+	memcpy(job->data + sites[r*xinc+i]*sizemem, p + i*sizemem, sizemem);
+
+      p += rowbytes;
+    }
+
+    // The checksum of the slice in file order
+    const int nrows = job->crcs.size();
+    QDPInternal::globalSumArray(&job->crcs[0], nrows);
+
+    QDPUtil::n_uint32_t crc = 0;
+    if (Layout::primaryNode())
+    {
+      QDPUtil::CRC32Shift op;
+      QDPUtil::crc32_shift(op, rowbytes);
+      for(int row=0; row < nrows; ++row)
+	crc = QDPUtil::crc32_combine(op, crc, job->crcs[row]);
+
+      if (job->check && crc != job->stored)
+      {
+	QDPIO::cerr << "AsyncTimeSliceReader: Mismatched Checksums: Expected: " << crc 
+		    << " but read " << job->stored << " for time slice " << job->t << std::endl;
+	QDP_abort(1);
+      }
+    }
+    QDPInternal::broadcast(crc);
+
+    delete job;
+    return crc;
+  }
+
+} // namespace QDP
@@ -0,0 +1,236 @@
+/*! @file
+ * @brief Run time choice of the threading and SIMD level of a kernel
+ */
+
+#include "qdp.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <mutex>
+
+#if QDP_USE_SSE == 1
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
+#endif
+
+namespace QDP
+{
+  namespace AutoTune
+  {
+    namespace
+    {
+      //! A winner and its time
+      struct Entry
+      {
+	Variant v;
+	double secs;
+      };
+
+      bool tune_on = false;
+      std::string cache_file;
+      bool cache_loaded = false;
+      std::mutex tune_lock;
+      std::map<std::string, Entry> table;
+
+      //! Timed runs of each candidate, the fastest counts
+      const int reps = 3;
+
+      std::string makeKey(const char* kernel, int sites, const char* type)
+      {
+	std::ostringstream os;
+	os << kernel << '/' << sites << '/' << type;
+	return os.str();
+      }
+
+      //! The variants worth trying on n sites
+      std::vector<Variant> candidates(int n)
+      {
+	std::vector<int> threads;
+	for(int t=qdpNumThreads(); t >= 1; t /= 2)
+	  threads.push_back(t);
+	if (threads.back() != 1)
+	  threads.push_back(1);
+
+	std::vector<int> simd(1, -1);
+#if QDP_USE_SSE == 1
+	for(int l=AVX::LEVEL_SSE; l < AVX::level(); ++l)
+	  simd.push_back(l);
+#endif
+
+	const int chunks[] = {0, 64, 512};
+
+	std::vector<Variant> c;
+	for(int s=0; s < simd.size(); ++s)
+	  for(int t=0; t < threads.size(); ++t)
+	    for(int k=0; k < sizeof(chunks)/sizeof(chunks[0]); ++k)
+	    {
+	      // A chunk only matters when every thread gets several
+	      if (chunks[k] > 0 && chunks[k]*threads[t]*2 > n)
+		continue;
+	      Variant v = {threads[t], chunks[k], simd[s]};
+	      c.push_back(v);
+	    }
+	return c;
+      }
+    }
+
+
+    void setEnabled(bool on) {tune_on = on;}
+
+    bool enabled() {return tune_on;}
+
+    void setCacheFile(const std::string& file)
+    {
+      cache_file = file;
+      cache_loaded = false;
+      tune_on = true;
+    }
+
+
+    SimdScope::SimdScope(int simd) : saved(-1)
+    {
+#if QDP_USE_SSE == 1
+      if (simd >= 0)
+      {
+	saved = AVX::level();
+	AVX::setLevel(AVX::Level(simd));
+      }
+#endif
+    }
+
+    SimdScope::~SimdScope()
+    {
+#if QDP_USE_SSE == 1
+      if (saved >= 0)
+	AVX::setLevel(AVX::Level(saved));
+#endif
+    }
+
+
+    Variant lookup(const char* kernel, int sites, const char* type,
+		   const std::function<void(const Variant&)>& run)
+    {
+      // Read the cache on first use, when the thread count is known
+      if (! cache_loaded && ! cache_file.empty())
+      {
+	cache_loaded = true;
+	load(cache_file);
+      }
+
+      const std::string key = makeKey(kernel, sites, type);
+      {
+	std::lock_guard<std::mutex> lock(tune_lock);
+	std::map<std::string, Entry>::const_iterator p = table.find(key);
+	if (p != table.end())
+	{
+	  // A table from a job with more threads is capped to this one
+	  Variant v = p->second.v;
+	  if (v.threads > qdpNumThreads())
+	    v.threads = qdpNumThreads();
+	  return v;
+	}
+      }
+
+      // Time every candidate on the live data
+      const std::vector<Variant> c = candidates(sites);
+      Entry best = {c[0], -1.0};
+      for(int i=0; i < c.size(); ++i)
+      {
+	run(c[i]);
+
+	double secs = -1.0;
+	for(int r=0; r < reps; ++r)
+	{
+	  const QDPTime_t t0 = getClockTime();
+	  run(c[i]);
+	  const double s = 1.0e-9*(getClockTime() - t0);
+	  if (secs < 0 || s < secs)
+	    secs = s;
+	}
+
+	if (best.secs < 0 || secs < best.secs)
+	{
+	  best.v = c[i];
+	  best.secs = secs;
+	}
+      }
+
+      std::lock_guard<std::mutex> lock(tune_lock);
+      table[key] = best;
+      return best.v;
+    }
+
+
+    int numEntries()
+    {
+      std::lock_guard<std::mutex> lock(tune_lock);
+      return table.size();
+    }
+
+
+    void load(const std::string& file)
+    {
+      std::ifstream in(file.c_str());
+      if (! in)
+	return;
+
+      std::lock_guard<std::mutex> lock(tune_lock);
+      std::string line;
+      while (std::getline(in, line))
+      {
+	if (line.empty() || line[0] == '#')
+	  continue;
+
+	std::istringstream is(line);
+	std::string key;
+	Entry e;
+	if (is >> key >> e.v.threads >> e.v.chunk >> e.v.simd >> e.secs)
+	{
+	  if (e.v.threads < 1)
+	    e.v.threads = 1;
+	  table[key] = e;
+	}
+	else
+	  QDPIO::cerr << "AutoTune: skipping bad line in " << file << ": " << line << std::endl;
+      }
+    }
+
+
+    void save(const std::string& file)
+    {
+      if (! Layout::primaryNode())
+	return;
+
+      std::ofstream out(file.c_str());
+      if (! out)
+      {
+	QDPIO::cerr << "AutoTune: cannot write " << file << std::endl;
+	return;
+      }
+
+      std::lock_guard<std::mutex> lock(tune_lock);
+      out << "# kernel/sites/type threads chunk simd seconds" << std::endl;
+      for(std::map<std::string, Entry>::const_iterator p=table.begin(); p != table.end(); ++p)
+	out << p->first << " " << p->second.v.threads << " " << p->second.v.chunk
+	    << " " << p->second.v.simd << " " << p->second.secs << std::endl;
+    }
+
+
+    void print()
+    {
+      std::lock_guard<std::mutex> lock(tune_lock);
+      QDPIO::cout << "AutoTune: " << table.size() << " kernels" << std::endl;
+      for(std::map<std::string, Entry>::const_iterator p=table.begin(); p != table.end(); ++p)
+	QDPIO::cout << "  " << p->first << ": threads= " << p->second.v.threads
+		    << " chunk= " << p->second.v.chunk << " simd= " << p->second.v.simd
+		    << "  " << p->second.secs << " s" << std::endl;
+    }
+
+
+    void finalize()
+    {
+      if (! cache_file.empty())
+	save(cache_file);
+    }
+  }
+}
@@ -9,10 +9,25 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include "qdp_byteorder.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QDP_BSWAP_X86
+#include <immintrin.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 namespace QDPUtil
 {
+  //! Buffers larger than this are byte-swapped by all the OpenMP threads
+  static const size_t bswap_thread_bytes = 1 << 20;
+
+  //! Bytes handled per step of the fused copies, small enough to stay in cache
+  static const size_t fused_block_bytes = 1 << 14;
   //! Is the native byte order big endian?
   bool big_endian()
   {
@@ -25,8 +40,8 @@ namespace QDPUtil
   }
 
 
-  //! Byte-swap an array of data each of size nmemb
-  void byte_swap(void *ptr, size_t size, size_t nmemb)
+  //! Byte-swap with plain loads and stores
+  static void byte_swap_generic(void *ptr, size_t size, size_t nmemb)
   {
     unsigned int j;
 
@@ -164,12 +179,207 @@ namespace QDPUtil
     break;
 
     default:
-      std::cerr << __func__ << ": unsupported word size = " << size << "\n";
+      break;
+    }
+  }
+
+
+
+#if defined(QDP_BSWAP_X86)
+  //! Shuffle control reversing each word of size bytes in a 16 byte lane
+  static void bswap_mask(unsigned char *mask, size_t size)
+  {
+    for(int i=0; i < 16; i++)
+      mask[i] = (i/size)*size + (size-1 - i%size);
+  }
+
+  __attribute__((target("ssse3")))
+  static size_t byte_swap_ssse3(char *p, size_t size, size_t nbytes)
+  {
+    unsigned char m[16];
+    bswap_mask(m, size);
+    const __m128i mask = _mm_loadu_si128((const __m128i*)m);
+
+    size_t n = 0;
+    for(; n + 16 <= nbytes; n += 16)
+    {
+      __m128i v = _mm_loadu_si128((const __m128i*)(p+n));
+      _mm_storeu_si128((__m128i*)(p+n), _mm_shuffle_epi8(v, mask));
+    }
+    return n;
+  }
+
+  __attribute__((target("avx2")))
+  static size_t byte_swap_avx2(char *p, size_t size, size_t nbytes)
+  {
+    unsigned char m[16];
+    bswap_mask(m, size);
+    const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)m));
+
+    size_t n = 0;
+    for(; n + 64 <= nbytes; n += 64)
+    {
+      __m256i v0 = _mm256_loadu_si256((const __m256i*)(p+n));
+      __m256i v1 = _mm256_loadu_si256((const __m256i*)(p+n+32));
+      _mm256_storeu_si256((__m256i*)(p+n),    _mm256_shuffle_epi8(v0, mask));
+      _mm256_storeu_si256((__m256i*)(p+n+32), _mm256_shuffle_epi8(v1, mask));
+    }
+    for(; n + 32 <= nbytes; n += 32)
+    {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(p+n));
+      _mm256_storeu_si256((__m256i*)(p+n), _mm256_shuffle_epi8(v, mask));
+    }
+    return n;
+  }
+
+  //! 2 for AVX2, 1 for SSSE3, 0 otherwise. Fixed at the first call
+  static int bswap_level()
+  {
+    static const int level =
+      __builtin_cpu_supports("avx2") ? 2 : (__builtin_cpu_supports("ssse3") ? 1 : 0);
+    return level;
+  }
+#endif
+
+  //! Byte-swap nmemb words, the bulk with byte shuffles when available
+  static void byte_swap_block(char *p, size_t size, size_t nmemb)
+  {
+    size_t done = 0;
+
+#if defined(QDP_BSWAP_X86)
+    switch (bswap_level())
+    {
+    case 2:
+      done = byte_swap_avx2(p, size, nmemb*size);
+      break;
+    case 1:
+      done = byte_swap_ssse3(p, size, nmemb*size);
+      break;
+    default:
+      break;
+    }
+#endif
+
+    // A lane holds a whole number of words, so the rest starts on a word
+    byte_swap_generic(p + done, size, nmemb - done/size);
+  }
+
+
+  //! Stop on a word size byte_swap does not know
+  static void check_word_size(const char *func, size_t size)
+  {
+    switch (size)
+    {
+    case 1:
+    case 2:
+    case 4:
+    case 8:
+    case 16:
+      break;
+
+    default:
+      std::cerr << func << ": unsupported word size = " << size << "\n";
       exit(1);
     }
   }
 
 
+  //! Byte-swap an array of data each of size nmemb
+  /*!
+   * Buffers of more than bswap_thread_bytes are split over the OpenMP
+   * threads, unless already called within a parallel region.
+   */
+  void byte_swap(void *ptr, size_t size, size_t nmemb)
+  {
+    check_word_size(__func__, size);
+    if (size == 1)  /* n_uint8_t: byte - do nothing */
+      return;
+
+    char *p = (char *)ptr;
+
+#if defined(_OPENMP)
+    if (nmemb*size > bswap_thread_bytes && ! omp_in_parallel())
+    {
+#pragma omp parallel
+      {
+	size_t nt  = omp_get_num_threads();
+	size_t me  = omp_get_thread_num();
+	size_t lo  = nmemb*me/nt;
+	size_t hi  = nmemb*(me+1)/nt;
+
+	byte_swap_block(p + lo*size, size, hi - lo);
+      }
+      return;
+    }
+#endif
+
+    byte_swap_block(p, size, nmemb);
+  }
+
+
+  //! Copy a block and put it in big-endian order
+  static void copy_block_big_endian(char *dst, const char *src, size_t size, size_t nmemb)
+  {
+    if (dst != src)
+      memcpy(dst, src, size*nmemb);
+
+    if (size > 1 && ! big_endian())
+      byte_swap_block(dst, size, nmemb);
+  }
+
+
+  //! Copy between native and big-endian order
+  /*!
+   * The copy goes a cache sized block at a time, so each block is swapped
+   * while it is still in cache. dst may be src.
+   */
+  void copy_big_endian(char *dst, const char *src, size_t size, size_t nmemb)
+  {
+    check_word_size(__func__, size);
+
+    const size_t block = fused_block_bytes / size;
+    for(size_t n = 0; n < nmemb; n += block)
+    {
+      size_t m = (nmemb - n < block) ? nmemb - n : block;
+      copy_block_big_endian(dst + n*size, src + n*size, size, m);
+    }
+  }
+
+
+  //! Copy native words into big-endian order and checksum the copy
+  n_uint32_t crc32_to_big_endian(n_uint32_t crc, char *dst, const char *src, size_t size, size_t nmemb)
+  {
+    check_word_size(__func__, size);
+
+    const size_t block = fused_block_bytes / size;
+    for(size_t n = 0; n < nmemb; n += block)
+    {
+      size_t m = (nmemb - n < block) ? nmemb - n : block;
+      copy_block_big_endian(dst + n*size, src + n*size, size, m);
+      crc = crc32(crc, dst + n*size, m*size);
+    }
+
+    return crc;
+  }
+
+
+  //! Checksum big-endian words and copy them into native order
+  n_uint32_t crc32_from_big_endian(n_uint32_t crc, char *dst, const char *src, size_t size, size_t nmemb)
+  {
+    check_word_size(__func__, size);
+
+    const size_t block = fused_block_bytes / size;
+    for(size_t n = 0; n < nmemb; n += block)
+    {
+      size_t m = (nmemb - n < block) ? nmemb - n : block;
+      crc = crc32(crc, src + n*size, m*size);
+      copy_block_big_endian(dst + n*size, src + n*size, size, m);
+    }
+
+    return crc;
+  }
+
+
   //! fread on a binary file written in big-endian order
   size_t bfread(void *ptr, size_t size, size_t nmemb, FILE *stream)
   {
@@ -0,0 +1,127 @@
+/*! @file
+ * @brief QIO and NERSC checksums of lattice fields, each node over its own sites
+ */
+
+#include "qdp.h"
+
+#include <cstring>
+
+namespace QDP
+{
+  namespace ChecksumInternal
+  {
+    QIOChecksum combine(const std::vector<QDPUtil::n_uint32_t>& a, const std::vector<QDPUtil::n_uint32_t>& b)
+    {
+      QIOChecksum c = {0, 0};
+      for(int t=0; t < a.size(); ++t)
+      {
+	c.suma ^= a[t];
+	c.sumb ^= b[t];
+      }
+
+      // An xor over the nodes: each node adds its pair into a slot of its own
+      std::vector<unsigned int> all(2*Layout::numNodes(), 0);
+      all[2*Layout::nodeNumber()] = c.suma;
+      all[2*Layout::nodeNumber() + 1] = c.sumb;
+      QDPInternal::globalSumArray(&all[0], all.size());
+
+      c.suma = c.sumb = 0;
+      for(int n=0; n < Layout::numNodes(); ++n)
+      {
+	c.suma ^= all[2*n];
+	c.sumb ^= all[2*n + 1];
+      }
+
+      return c;
+    }
+
+
+    //! user argument for nerscKernel
+    struct NerscArgs
+    {
+      const multi1d<LatticeColorMatrix>* u;
+      int rows;                        // 2 or 3 rows of each link
+      QDPUtil::n_uint32_t* sums;       // per thread
+    };
+
+    //! user function for the NERSC words of sites [lo,hi), as linksToArchiv writes them
+    void nerscKernel(int lo, int hi, int myId, NerscArgs* a)
+    {
+      QDPUtil::n_uint32_t sum = 0;
+
+      for(int x=lo; x < hi; ++x)
+	for(int dd=0; dd < Nd; ++dd)
+	{
+	  const PColorMatrix<RComplex<REAL>,Nc>& m = (*a->u)[dd].elem(x).elem();
+	  for(int ii=0; ii < a->rows; ++ii)
+	    for(int kk=0; kk < Nc; ++kk)
+	    {
+	      REAL32 w[2] = {REAL32(m.elem(ii,kk).real()), REAL32(m.elem(ii,kk).imag())};
+	      QDPUtil::n_uint32_t v[2];
+	      memcpy(v, w, sizeof(v));
+	      sum += v[0] + v[1];
+	    }
+	}
+
+      a->sums[myId] += sum;
+    }
+
+
+    //! user argument for wordKernel
+    struct WordArgs
+    {
+      const QDPUtil::n_uint32_t* p;
+      QDPUtil::n_uint32_t* sums;       // per thread
+    };
+
+    //! user function for words [lo,hi)
+    void wordKernel(int lo, int hi, int myId, WordArgs* a)
+    {
+      QDPUtil::n_uint32_t sum = 0;
+      for(int i=lo; i < hi; ++i)
+	sum += a->p[i];
+      a->sums[myId] += sum;
+    }
+  }
+
+
+  QDPUtil::n_uint32_t nerscChecksum(const multi1d<LatticeColorMatrix>& u, int mat_size)
+  {
+    using namespace ChecksumInternal;
+
+    if (mat_size != 12 && mat_size != 18)
+    {
+      QDPIO::cerr << __func__ << ": unexpected size" << std::endl;
+      QDP_abort(1);
+    }
+
+    std::vector<QDPUtil::n_uint32_t> sums(qdpNumThreads(), 0);
+    NerscArgs a = {&u, (mat_size == 12) ? 2 : 3, &sums[0]};
+    dispatch_to_threads(Layout::sitesOnNode(), a, nerscKernel);
+
+    QDPUtil::n_uint32_t checksum = 0;
+    for(int t=0; t < sums.size(); ++t)
+      checksum += sums[t];
+
+    QDPInternal::globalSumArray((unsigned int*)&checksum, 1);
+
+    return checksum;
+  }
+
+
+  QDPUtil::n_uint32_t nerscWordSum(const void* buf, size_t bytes)
+  {
+    using namespace ChecksumInternal;
+
+    std::vector<QDPUtil::n_uint32_t> sums(qdpNumThreads(), 0);
+    WordArgs a = {(const QDPUtil::n_uint32_t*)buf, &sums[0]};
+    dispatch_to_threads(bytes / sizeof(QDPUtil::n_uint32_t), a, wordKernel);
+
+    QDPUtil::n_uint32_t sum = 0;
+    for(int t=0; t < sums.size(); ++t)
+      sum += sums[t];
+
+    return sum;
+  }
+
+} // namespace QDP
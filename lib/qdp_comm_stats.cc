@@ -0,0 +1,234 @@
+/*! @file
+ * @brief Statistics kept by the communications
+ *
+ * Counting an exchange costs a few additions and the clock reads around
+ * its wait, so the counts are always kept.
+ */
+
+#include "qdp.h"
+#include <cstdio>
+#include <algorithm>
+
+namespace QDP
+{
+  namespace CommStats
+  {
+    namespace
+    {
+      struct Channel
+      {
+	std::string label;
+	Counters counts;
+	int trace_id;           // name on the timeline, made on first use
+      };
+
+      bool stats_at_finalize = false;
+
+      std::vector<Channel>& channels()
+      {
+	static std::vector<Channel> c;
+	if (c.empty())
+	{
+	  const char* fixed[NumFixedChannels] = {"reduction", "broadcast", "route", "send/recv"};
+	  c.resize(NumFixedChannels);
+	  for(int ch=0; ch < NumFixedChannels; ++ch)
+	  {
+	    c[ch].label = fixed[ch];
+	    c[ch].counts = Counters();
+	    c[ch].trace_id = -1;
+	  }
+	}
+	return c;
+      }
+
+      //! Put a call of channel ch on the timeline
+      void trace(Channel& c, QDPTime_t t_start, QDPTime_t t_done)
+      {
+	if (! Trace::enabled())
+	  return;
+	if (c.trace_id < 0)
+	  c.trace_id = Trace::name(c.label);
+	Trace::record(Trace::Comm, c.trace_id, t_start, t_done);
+      }
+
+      std::map<int, PeerCounters>& peers()
+      {
+	static std::map<int, PeerCounters> p;
+	return p;
+      }
+    }
+
+
+    int numChannels()
+    {
+      return channels().size();
+    }
+
+
+    const std::string& channelLabel(int ch)
+    {
+      return channels()[ch].label;
+    }
+
+
+    const Counters& channelCounters(int ch)
+    {
+      return channels()[ch].counts;
+    }
+
+
+    const std::map<int, PeerCounters>& peerCounters()
+    {
+      return peers();
+    }
+
+
+    int channel(const std::string& label)
+    {
+      std::vector<Channel>& c = channels();
+      for(int ch=0; ch < c.size(); ++ch)
+	if (c[ch].label == label)
+	  return ch;
+
+      c.push_back(Channel());
+      c.back().label = label;
+      c.back().counts = Counters();
+      c.back().trace_id = -1;
+      return c.size()-1;
+    }
+
+
+    void resetCommStats()
+    {
+      std::vector<Channel>& c = channels();
+      for(int ch=0; ch < c.size(); ++ch)
+	c[ch].counts = Counters();
+      peers().clear();
+    }
+
+
+    void setCommStatsAtFinalize(bool p)
+    {
+      stats_at_finalize = p;
+    }
+
+
+    bool commStatsAtFinalize()
+    {
+      return stats_at_finalize;
+    }
+
+
+    void printCommStats()
+    {
+      const std::vector<Channel>& c = channels();
+      const int nch = c.size();
+      const int nodes = Layout::numNodes();
+      const int me = Layout::nodeNumber();
+
+      // Totals over the nodes, and the wait of every node to find the spread
+      enum {NumTotals = 7};
+      std::vector<double> tot(NumTotals*nch, 0.0);
+      std::vector<double> wait(nodes*nch, 0.0);
+      for(int ch=0; ch < nch; ++ch)
+      {
+	const Counters& n = c[ch].counts;
+	double* t = &tot[NumTotals*ch];
+	t[0] = n.calls;
+	t[1] = n.msgs_sent;
+	t[2] = n.msgs_recv;
+	t[3] = n.bytes_sent;
+	t[4] = n.bytes_recv;
+	t[5] = n.overlap_ns;
+	t[6] = n.wait_ns;
+	wait[me*nch + ch] = n.wait_ns;
+      }
+      QDPInternal::globalSumArray(&tot[0], tot.size());
+      QDPInternal::globalSumArray(&wait[0], wait.size());
+
+      if (! Layout::primaryNode())
+	return;
+
+      const double MB = 1024.0*1024.0;
+      const double ms = 1.0e6;
+
+      QDPIO::cout << "Communication statistics over " << nodes << " nodes" << std::endl;
+      for(int ch=0; ch < nch; ++ch)
+      {
+	const double* t = &tot[NumTotals*ch];
+	if (t[0] == 0)
+	  continue;
+
+	double wmin = wait[ch], wmax = wait[ch];
+	for(int n=1; n < nodes; ++n)
+	{
+	  wmin = std::min(wmin, wait[n*nch + ch]);
+	  wmax = std::max(wmax, wait[n*nch + ch]);
+	}
+
+	printf("  %-24s calls= %.0f  msgs sent= %.0f recv= %.0f  MB sent= %.3f recv= %.3f\n",
+	       c[ch].label.c_str(), t[0], t[1], t[2], t[3]/MB, t[4]/MB);
+	printf("  %-24s overlap= %.3f ms  wait min= %.3f mean= %.3f max= %.3f ms per node\n",
+	       "", t[5]/(nodes*ms), wmin/ms, t[6]/(nodes*ms), wmax/ms);
+      }
+
+      if (! peers().empty())
+      {
+	printf("  peers of node %d:\n", me);
+	for(std::map<int, PeerCounters>::const_iterator p=peers().begin(); p != peers().end(); ++p)
+	  printf("    node %-6d msgs sent= %lu recv= %lu  MB sent= %.3f recv= %.3f\n", p->first,
+		 (unsigned long)p->second.msgs_sent, (unsigned long)p->second.msgs_recv,
+		 p->second.bytes_sent/MB, p->second.bytes_recv/MB);
+      }
+      fflush(stdout);
+    }
+
+
+    namespace Stats
+    {
+      void noteExchange(int ch, const std::vector<Message>& msgs,
+			QDPTime_t t_start, QDPTime_t t_wait, QDPTime_t t_done)
+      {
+	Counters& n = channels()[ch].counts;
+	std::map<int, PeerCounters>& p = peers();
+	trace(channels()[ch], t_start, t_done);
+
+	++n.calls;
+	n.overlap_ns += t_wait - t_start;
+	n.wait_ns += t_done - t_wait;
+
+	for(int m=0; m < msgs.size(); ++m)
+	{
+	  PeerCounters& peer = p[msgs[m].node];
+	  if (msgs[m].send)
+	  {
+	    ++n.msgs_sent;
+	    n.bytes_sent += msgs[m].bytes;
+	    ++peer.msgs_sent;
+	    peer.bytes_sent += msgs[m].bytes;
+	  }
+	  else
+	  {
+	    ++n.msgs_recv;
+	    n.bytes_recv += msgs[m].bytes;
+	    ++peer.msgs_recv;
+	    peer.bytes_recv += msgs[m].bytes;
+	  }
+	}
+      }
+
+
+      void noteCollective(int ch, size_t bytes, QDPTime_t t_start, QDPTime_t t_wait, QDPTime_t t_done)
+      {
+	Counters& n = channels()[ch].counts;
+	trace(channels()[ch], t_start, t_done);
+
+	++n.calls;
+	n.bytes_sent += bytes;
+	n.overlap_ns += t_wait - t_start;
+	n.wait_ns += t_done - t_wait;
+      }
+    }
+
+  } // namespace CommStats
+} // namespace QDP
@@ -38,8 +38,13 @@ Comments) 1950 to 1952 in the files ftp://ds.internic.net/rfc/rfc1950.txt
 */
 
 #include <cstdlib>
+#include <vector>
 #include "qdp_byteorder.h"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 namespace QDPUtil
 {
 
@@ -174,24 +179,57 @@ namespace QDPUtil
     return (uLongf *)crc_table;
   }
 
-/* ========================================================================= */
+/* =========================================================================
+ * Slicing-by-8: table k maps a byte to its crc followed by k zero bytes,
+ * so eight bytes are folded in per iteration with independent lookups.
+ */
+  struct CRC32Slice8
+  {
+    uLongf t[8][256];
+
+    CRC32Slice8()
+    {
+      const uLongf *tab = get_crc_table();
+      for (int n = 0; n < 256; n++)
+	t[0][n] = tab[n];
+      for (int k = 1; k < 8; k++)
+	for (int n = 0; n < 256; n++)
+	  t[k][n] = (t[k-1][n] >> 8) ^ tab[t[k-1][n] & 0xff];
+    }
+  };
+
+  static const CRC32Slice8& get_slice8_table()
+  {
+    static const CRC32Slice8 tab;
+    return tab;
+  }
+
 #define DO1(buf) crc = crc_table[((int)crc ^ (*buf++)) & 0xff] ^ (crc >> 8);
-#define DO2(buf)  DO1(buf); DO1(buf);
-#define DO4(buf)  DO2(buf); DO2(buf);
-#define DO8(buf)  DO4(buf); DO4(buf);
 
-/* ========================================================================= */
-  n_uint32_t crc32(n_uint32_t crc, const unsigned char *buf, size_t len)
+  //! Buffers larger than this are checksummed in pieces by all the OpenMP threads
+  static const size_t crc_thread_bytes = 1 << 20;
+
+  //! crc32 of one buffer on the calling thread
+  static n_uint32_t crc32_block(n_uint32_t crc, const unsigned char *buf, size_t len)
   {
-    if (buf == Z_NULL) return 0L;
 #ifdef DYNAMIC_CRC_TABLE
     if (crc_table_empty)
       make_crc_table();
 #endif
+    const uLongf (*t)[256] = get_slice8_table().t;
+
     crc = crc ^ 0xffffffffL;
     while (len >= 8)
     {
-      DO8(buf);
+      n_uint32_t lo = crc ^ (n_uint32_t(buf[0]) | (n_uint32_t(buf[1]) << 8) |
+			     (n_uint32_t(buf[2]) << 16) | (n_uint32_t(buf[3]) << 24));
+      n_uint32_t hi = (n_uint32_t(buf[4]) | (n_uint32_t(buf[5]) << 8) |
+		       (n_uint32_t(buf[6]) << 16) | (n_uint32_t(buf[7]) << 24));
+      crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^
+	t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+	t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+	t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+      buf += 8;
       len -= 8;
     }
     if (len) 
@@ -203,6 +241,44 @@ namespace QDPUtil
     return crc ^ 0xffffffffL;
   }
 
+/* =========================================================================
+ * Large buffers are cut into one piece per thread and the pieces' crc's
+ * joined with crc32_combine
+ */
+  n_uint32_t crc32(n_uint32_t crc, const unsigned char *buf, size_t len)
+  {
+    if (buf == Z_NULL) return 0L;
+
+#if defined(_OPENMP)
+    if (len > crc_thread_bytes && ! omp_in_parallel())
+    {
+      std::vector<n_uint32_t> part(omp_get_max_threads());
+      std::vector<size_t> plen(part.size(), 0);
+      int nt = 1;
+
+#pragma omp parallel
+      {
+	size_t num = omp_get_num_threads();
+	size_t me  = omp_get_thread_num();
+	size_t lo  = len*me/num;
+	size_t hi  = len*(me+1)/num;
+
+	part[me] = crc32_block(0, buf + lo, hi - lo);
+	plen[me] = hi - lo;
+#pragma omp single
+	nt = num;
+      }
+
+      for (int i = 0; i < nt; i++)
+	crc = crc32_combine(crc, part[i], plen[i]);
+
+      return crc;
+    }
+#endif
+
+    return crc32_block(crc, buf, len);
+  }
+
 
 /* ========================================================================= */
   n_uint32_t crc32(n_uint32_t crc, const char *buf, size_t len)
@@ -211,4 +287,91 @@ namespace QDPUtil
     return crc32(crc, (const unsigned char*)(buf), len);
   }
 
+
+/* =========================================================================
+ * Combining crc's of consecutive blocks, after crc32_combine of zlib 1.2.
+ * Appending a byte is linear over GF(2) on the crc, so appending len zero
+ * bytes is a 32x32 bit matrix, built here by repeated squaring.
+ */
+  static n_uint32_t gf2_matrix_times(const n_uint32_t *mat, n_uint32_t vec)
+  {
+    n_uint32_t sum = 0;
+    while (vec)
+    {
+      if (vec & 1)
+	sum ^= *mat;
+      vec >>= 1;
+      mat++;
+    }
+    return sum;
+  }
+
+  static void gf2_matrix_square(n_uint32_t *square, const n_uint32_t *mat)
+  {
+    for (int n = 0; n < 32; n++)
+      square[n] = gf2_matrix_times(mat, mat[n]);
+  }
+
+  //! op = mat*op
+  static void gf2_matrix_apply(n_uint32_t *op, const n_uint32_t *mat)
+  {
+    for (int n = 0; n < 32; n++)
+      op[n] = gf2_matrix_times(mat, op[n]);
+  }
+
+  void crc32_shift(CRC32Shift& op, size_t len)
+  {
+    n_uint32_t even[32];    /* even-power-of-two zeros operator */
+    n_uint32_t odd[32];     /* odd-power-of-two zeros operator */
+
+    for (int n = 0; n < 32; n++)
+      op.m[n] = n_uint32_t(1) << n;
+
+    if (len == 0)
+      return;
+
+    /* put operator for one zero bit in odd */
+    odd[0] = 0xedb88320UL;
+    n_uint32_t row = 1;
+    for (int n = 1; n < 32; n++)
+    {
+      odd[n] = row;
+      row <<= 1;
+    }
+
+    /* put operator for two zero bits in even, then four in odd */
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+
+    /* apply len zeros: the first square puts the operator for one zero
+       byte, eight zero bits, in even */
+    do
+    {
+      gf2_matrix_square(even, odd);
+      if (len & 1)
+	gf2_matrix_apply(op.m, even);
+      len >>= 1;
+
+      if (len == 0)
+	break;
+
+      gf2_matrix_square(odd, even);
+      if (len & 1)
+	gf2_matrix_apply(op.m, odd);
+      len >>= 1;
+    } while (len != 0);
+  }
+
+  n_uint32_t crc32_combine(const CRC32Shift& op, n_uint32_t crc1, n_uint32_t crc2)
+  {
+    return gf2_matrix_times(op.m, crc1) ^ crc2;
+  }
+
+  n_uint32_t crc32_combine(n_uint32_t crc1, n_uint32_t crc2, size_t len2)
+  {
+    CRC32Shift op;
+    crc32_shift(op, len2);
+    return crc32_combine(op, crc1, crc2);
+  }
+
 } // namespace QDPUtil
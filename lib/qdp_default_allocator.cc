@@ -9,14 +9,15 @@
 namespace QDP {
 namespace Allocator {
  
-  // The type returned on map insertion, allows me to check
-  // the insertion was successful.
-  typedef std::pair<MapT::iterator, bool> InsertRetVal;
+  namespace {
+    //! Marks the header of a live block
+    const unsigned int live_magic = 0x51445041;  // "QDPA"
+  }
 
 
   //! Allocator function. Allocates n_bytes, into a memory pool
   //! This is a default implementation, with only 1 memory pool
-  //! So we simply ignore the memory pool hint.
+  //! besides the fast tier, which a FAST hint tries first.
   void*
   QDPDefaultAllocator::allocate(size_t n_bytes,const MemoryPoolHint& mem_pool_hint) {
     
@@ -31,38 +32,53 @@ namespace Allocator {
     if ( n_bytes % (32*1024) == 0 ) { 
       bytes_to_alloc += 0; // 2 lines bytes to kill cache aliasing
     }
-    bytes_to_alloc += QDP_ALIGNMENT_SIZE;
+    bytes_to_alloc += QDP_ALIGNMENT_SIZE + sizeof(BlockHeader);
 
     // Try and allocate the memory
-    try { 
-      unaligned = new unsigned char[ bytes_to_alloc ];
+    unaligned = 0;
+    if ( mem_pool_hint == FAST )
+      unaligned = (unsigned char *)fastAllocate(bytes_to_alloc);
+
+    const bool fast = (unaligned != 0);
+    if ( ! fast ) {
+      try { 
+	unaligned = new unsigned char[ bytes_to_alloc ];
+      }
+      catch( std::bad_alloc ) { 
+	Stats::noteFailure(n_bytes);
+	QDPIO::cerr << "Unable to allocate memory in allocate()" << std::endl;
+	throw;  // Re throw the bad alloc is the correct behaviour
+
+      }
     }
-    catch( std::bad_alloc ) { 
-      QDPIO::cerr << "Unable to allocate memory in allocate()" << std::endl;
-      throw;  // Re throw the bad alloc is the correct behaviour
 
-    }
+    // Work out the aligned pointer, leaving room for the header in front
+    aligned = (unsigned char *)( ( (unsigned long)unaligned + sizeof(BlockHeader) + (QDP_ALIGNMENT_SIZE-1) ) & ~(QDP_ALIGNMENT_SIZE - 1));
 
-    // Work out the aligned pointer
-    aligned = (unsigned char *)( ( (unsigned long)unaligned + (QDP_ALIGNMENT_SIZE-1) ) & ~(QDP_ALIGNMENT_SIZE - 1));
+    BlockHeader* h = (BlockHeader *)aligned - 1;
+    h->magic = live_magic;
+    h->bytes = bytes_to_alloc;
+    h->size = n_bytes;
+    h->unaligned = unaligned;
+    h->fast = fast;
 
 #if defined(QDP_DEBUG_MEMORY)
     // Current location
     FuncInfo_t& info = infostack.top();
+    h->func = info.func;
+    h->line = info.line;
+#endif
 
-    // Insert into the map
-    InsertRetVal r = the_alignment_map.insert(
-      std::make_pair(aligned, MapVal(unaligned, info.func, info.line, bytes_to_alloc)));
-#else
-    // Insert into the map
-    InsertRetVal r = the_alignment_map.insert(std::make_pair(aligned, unaligned));
+#if defined(QDP_ALLOCATOR_REGISTRY)
+    // Push onto the list of live blocks
+    h->prev = 0;
+    h->next = registry;
+    if (registry)
+      registry->prev = h;
+    registry = h;
 #endif
 
-    // Check success of insertion.
-    if( ! r.second ) { 
-      QDPIO::cerr << "Failed to insert (unaligned,aligned) pair into map" << std::endl;
-      QDP_abort(1);
-    }
+    Stats::noteAlloc(n_bytes);
 
     // Return the aligned pointer
     return (void *)aligned;
@@ -72,51 +88,51 @@ namespace Allocator {
   //! Free an aligned pointer, which was allocated by us.
   void 
   QDPDefaultAllocator::free(void *mem) { 
-    unsigned char* unaligned; 
-
-    // Look up the original unaligned pointer in the memory. 
-    MapT::iterator iter = the_alignment_map.find((unsigned char*)mem);
-    if( iter != the_alignment_map.end() ) 
-    { 
-#if defined(QDP_DEBUG_MEMORY)
-      // Find the original unaligned pointer
-      unaligned = iter->second.unaligned;
-#else
-      // Find the original unaligned pointer
-      unaligned = iter->second;
-#endif
-      
-      // Remove its entry from the map
-      the_alignment_map.erase(iter);
+    BlockHeader* h = (BlockHeader *)mem - 1;
 
-      // Delete the actual unaligned pointer
-      delete [] unaligned;
-    }
-    else { 
-      QDPIO::cerr << "Pointer not found in map" << std::endl;
+    // Catch pointers that are not ours and double frees
+    if ( mem == 0 || h->magic != live_magic ) { 
+      QDPIO::cerr << "Pointer not allocated by QDPDefaultAllocator or already freed" << std::endl;
       QDP_abort(1);
     }
+    h->magic = 0;
+
+#if defined(QDP_ALLOCATOR_REGISTRY)
+    // Unlink from the list of live blocks
+    if (h->prev)
+      h->prev->next = h->next;
+    else
+      registry = h->next;
+    if (h->next)
+      h->next->prev = h->prev;
+#endif
+
+    Stats::noteFree(h->size);
+
+    // Delete the actual unaligned pointer
+    if ( h->fast )
+      fastFree(h->unaligned, h->bytes);
+    else
+      delete [] h->unaligned;
   }
 
 
 #if defined(QDP_DEBUG_MEMORY)
-  //! Dump the map
+  //! Dump the live blocks
   void
   QDPDefaultAllocator::dump()
   {
      if ( Layout::primaryNode() )
      {
        size_t sum = 0;
-       typedef MapT::const_iterator CI;
        QDPIO::cout << "Dumping memory map" << std::endl;
-       for( CI j = the_alignment_map.begin();
-             j != the_alignment_map.end(); j++)
+       for(const BlockHeader* h = registry; h != 0; h = h->next)
        {
-	 sum += j->second.bytes;
-         printf("mem= 0x%x  bytes= %d  bytes/site= %d  line= %d  func= %s\n", j->first, 
-                j->second.bytes, j->second.bytes/Layout::sitesOnNode(), j->second.line, j->second.func.c_str());
+	 sum += h->bytes;
+         printf("mem= 0x%lx  bytes= %lu  bytes/site= %lu  line= %d  func= %s\n", (unsigned long)(h+1), 
+                (unsigned long)h->bytes, (unsigned long)(h->bytes/Layout::sitesOnNode()), h->line, h->func);
        }
-       printf("total bytes= %d\n", sum);
+       printf("total bytes= %lu\n", (unsigned long)sum);
      }
   }
 
@@ -125,6 +141,7 @@ namespace Allocator {
   QDPDefaultAllocator::pushFunc(const char* func, int line)
   {
     infostack.push(FuncInfo_t(func,line));
+    Stats::pushTag(func);
   }
 
   // Nuker
@@ -138,6 +155,7 @@ namespace Allocator {
     }
   
     infostack.pop();
+    Stats::popTag();
   }
 
 
@@ -152,30 +170,38 @@ namespace Allocator {
 
 #else
 
-  //! Dump the map
+  //! Dump the live blocks
   void
   QDPDefaultAllocator::dump()
   {
      if ( Layout::primaryNode() )
      {
-       typedef MapT::const_iterator CI;
        QDPIO::cout << "Dumping memory map" << std::endl;
-       for( CI j = the_alignment_map.begin();
-             j != the_alignment_map.end(); j++)
+#if defined(QDP_ALLOCATOR_REGISTRY)
+       for(const BlockHeader* h = registry; h != 0; h = h->next)
        {
-         printf("mem= 0x%lx  unaligned= 0x%lx\n", (unsigned long)j->first, 
-		(unsigned long)j->second);
+         printf("mem= 0x%lx  unaligned= 0x%lx\n", (unsigned long)(h+1), 
+		(unsigned long)h->unaligned);
        }
+#endif
+       printf("live blocks= %lu  bytes= %lu\n", (unsigned long)getAllocStats().live_objects,
+	      (unsigned long)getAllocStats().current_bytes);
      }
   }
 
   // Setter
   void
-  QDPDefaultAllocator::pushFunc(const char* func, int line) {}
+  QDPDefaultAllocator::pushFunc(const char* func, int line) 
+  {
+    Stats::pushTag(func);
+  }
 
   // Nuker
   void
-  QDPDefaultAllocator::popFunc() {}
+  QDPDefaultAllocator::popFunc() 
+  {
+    Stats::popTag();
+  }
 
   // Init
   void
@@ -0,0 +1,87 @@
+/*! @file
+ * @brief Several independent lattices in one job, each on its own group of nodes
+ */
+
+#include "qdp.h"
+#include "qdp_ensemble.h"
+
+namespace QDP
+{
+  namespace Ensemble
+  {
+    namespace
+    {
+      int n_members = 1;
+      int my_member = 0;
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+      QMP_comm_t world = 0;
+#endif
+    }
+
+    void setMembers(int n)
+    {
+      if (n < 1)
+	QDP_error_exit("Ensemble::setMembers: need at least one member, have %d", n);
+      n_members = n;
+    }
+
+    int members() {return n_members;}
+
+    int member() {return my_member;}
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+
+    void init()
+    {
+      world = QMP_comm_get_default();
+      if (n_members == 1)
+	return;
+
+      const int nodes = QMP_comm_get_number_of_nodes(world);
+      const int node = QMP_comm_get_node_number(world);
+      if (nodes % n_members != 0)
+	QDP_error_exit("Ensemble::init: %d nodes do not split into %d members", nodes, n_members);
+
+      // Consecutive ranks, which schedulers tend to put on one host
+      my_member = node / (nodes / n_members);
+
+      QMP_comm_t group;
+      if (QMP_comm_split(world, my_member, node, &group) != QMP_SUCCESS)
+	QDP_error_exit("Ensemble::init: QMP_comm_split failed");
+      if (QMP_comm_set_default(group) != QMP_SUCCESS)
+	QDP_error_exit("Ensemble::init: QMP_comm_set_default failed");
+
+      if (node == 0)
+	QDP_info("QDP runs %d independent members of %d nodes", n_members, nodes / n_members);
+    }
+
+    int worldNodeNumber() {return QMP_comm_get_node_number(world);}
+
+    int worldNumNodes() {return QMP_comm_get_number_of_nodes(world);}
+
+    void worldBroadcast(void* buf, size_t bytes)
+    {
+      if (QMP_comm_broadcast(world, buf, bytes) != QMP_SUCCESS)
+	QDP_error_exit("Ensemble::worldBroadcast: QMP_comm_broadcast failed");
+    }
+
+    void worldBarrier()
+    {
+      QMP_comm_barrier(world);
+    }
+
+#else
+
+    void init() {n_members = 1;}
+
+    int worldNodeNumber() {return 0;}
+
+    int worldNumNodes() {return 1;}
+
+    void worldBroadcast(void* buf, size_t bytes) {}
+
+    void worldBarrier() {}
+
+#endif
+  }
+}
@@ -0,0 +1,424 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Fourier transforms of lattice fields
+ */
+
+#include "qdp.h"
+#include "qdp_fft.h"
+
+#include <cmath>
+#include <vector>
+
+namespace QDP
+{
+
+  namespace
+  {
+    //! A complex number as the sites hold it
+    template<class W>
+    struct Cx
+    {
+      W re, im;
+    };
+
+    //! Factors of n, twos first and then ascending primes
+    std::vector<int> factorise(int n)
+    {
+      std::vector<int> f;
+      for(int p=2; n > 1; ++p)
+      {
+	if (p*p > n)
+	  p = n;
+	while (n % p == 0)
+	{
+	  f.push_back(p);
+	  n /= p;
+	}
+      }
+      return f;
+    }
+
+
+    //! One dimensional transforms of length n of points of ncomp complex numbers
+    /*!
+     * Mixed radix decimation in time: each pass splits its points into p
+     * interleaved subsequences, transforms those and combines them with
+     * radix p butterflies. Radix 2 is done by hand.
+     */
+    template<class W>
+    class LineFFT
+    {
+    public:
+      LineFFT(int n_, int ncomp_, int sign) : n(n_), ncomp(ncomp_), factors(factorise(n_)), twiddle(n_)
+	{
+	  for(int j=0; j < n; ++j)
+	  {
+	    double a = sign * 2 * M_PI * j / n;
+	    twiddle[j].re = W(cos(a));
+	    twiddle[j].im = W(sin(a));
+	  }
+	}
+
+      //! Scratch each thread needs
+      size_t scratchSize() const
+	{
+	  int p = 2;
+	  for(int i=0; i < factors.size(); ++i)
+	    p = std::max(p, factors[i]);
+	  return p*ncomp;
+	}
+
+      //! Transform in[n][ncomp] into out[n][ncomp]
+      void transform(const Cx<W>* in, Cx<W>* out, Cx<W>* scratch) const
+	{
+	  pass(in, 1, out, n, 0, scratch);
+	}
+
+    private:
+      void pass(const Cx<W>* in, int stride, Cx<W>* out, int len, int level, Cx<W>* t) const
+	{
+	  if (len == 1)
+	  {
+	    for(int c=0; c < ncomp; ++c)
+	      out[c] = in[c];
+	    return;
+	  }
+
+	  const int p = factors[level];
+	  const int m = len / p;
+	  for(int r=0; r < p; ++r)
+	    pass(in + r*stride*ncomp, stride*p, out + r*m*ncomp, m, level+1, t);
+
+	  // X[k + m s] = sum_r w_len^{r (k + m s)} Y_r[k]
+	  const int step = n / len;
+	  for(int k=0; k < m; ++k)
+	  {
+	    for(int r=0; r < p; ++r)
+	    {
+	      const Cx<W>& w = twiddle[(r*k*step) % n];
+	      Cx<W>* y = out + (r*m + k)*ncomp;
+	      for(int c=0; c < ncomp; ++c)
+	      {
+		t[r*ncomp+c].re = w.re*y[c].re - w.im*y[c].im;
+		t[r*ncomp+c].im = w.re*y[c].im + w.im*y[c].re;
+	      }
+	    }
+
+	    if (p == 2)
+	    {
+	      Cx<W>* x0 = out + k*ncomp;
+	      Cx<W>* x1 = out + (k+m)*ncomp;
+	      for(int c=0; c < ncomp; ++c)
+	      {
+		x0[c].re = t[c].re + t[ncomp+c].re;
+		x0[c].im = t[c].im + t[ncomp+c].im;
+		x1[c].re = t[c].re - t[ncomp+c].re;
+		x1[c].im = t[c].im - t[ncomp+c].im;
+	      }
+	      continue;
+	    }
+
+	    for(int s=0; s < p; ++s)
+	    {
+	      Cx<W>* x = out + (k + m*s)*ncomp;
+	      for(int c=0; c < ncomp; ++c)
+		x[c] = t[c];
+	      for(int r=1; r < p; ++r)
+	      {
+		const Cx<W>& w = twiddle[((r*s) % p) * (n/p)];
+		const Cx<W>* y = t + r*ncomp;
+		for(int c=0; c < ncomp; ++c)
+		{
+		  x[c].re += w.re*y[c].re - w.im*y[c].im;
+		  x[c].im += w.re*y[c].im + w.im*y[c].re;
+		}
+	      }
+	    }
+	  }
+	}
+
+      int n, ncomp;
+      std::vector<int> factors;
+      std::vector< Cx<W> > twiddle;     // exp(sign i 2 pi j/n)
+    };
+
+
+    //! Lines to transform, each of len points
+    /*!
+     * Point x of line j is the site index[j*len + x] of lines, or without
+     * an index the point j*len + x. Lines lo..hi are gathered, transformed
+     * and put back where they came from.
+     */
+    template<class W>
+    struct LineArgs
+    {
+      Cx<W>* lines;
+      const int* index;
+      int len;
+      int ncomp;
+      const LineFFT<W>* plan;
+    };
+
+    template<class W>
+    void lineKernel(int lo, int hi, int myId, LineArgs<W>* a)
+    {
+      const int len = a->len, ncomp = a->ncomp;
+      Cx<W>* in = Allocator::threadScratch< Cx<W> >(len*ncomp, 0);
+      Cx<W>* out = Allocator::threadScratch< Cx<W> >(len*ncomp, 1);
+      Cx<W>* scratch = Allocator::threadScratch< Cx<W> >(a->plan->scratchSize(), 2);
+
+      for(int j=lo; j < hi; ++j)
+      {
+	if (a->index)
+	{
+	  for(int x=0; x < len; ++x)
+	  {
+	    const Cx<W>* s = a->lines + size_t(a->index[j*len + x])*ncomp;
+	    for(int c=0; c < ncomp; ++c)
+	      in[x*ncomp+c] = s[c];
+	  }
+	}
+	else
+	{
+	  const Cx<W>* s = a->lines + size_t(j)*len*ncomp;
+	  for(int i=0; i < len*ncomp; ++i)
+	    in[i] = s[i];
+	}
+
+	a->plan->transform(in, out, scratch);
+
+	if (a->index)
+	{
+	  for(int x=0; x < len; ++x)
+	  {
+	    Cx<W>* s = a->lines + size_t(a->index[j*len + x])*ncomp;
+	    for(int c=0; c < ncomp; ++c)
+	      s[c] = out[x*ncomp+c];
+	  }
+	}
+	else
+	{
+	  Cx<W>* s = a->lines + size_t(j)*len*ncomp;
+	  for(int i=0; i < len*ncomp; ++i)
+	    s[i] = out[i];
+	}
+      }
+    }
+
+
+    //! Moves the pieces of lines between the field and the all-to-all buffer
+    /*!
+     * Line j of this node, of the l points site[j*l + x], goes to the node
+     * at position r along the direction for lo[r] <= j < lo[r+1], at
+     * buf + start[r] + ((j - lo[r])*l + x)*ncomp.
+     */
+    template<class W>
+    struct PackArgs
+    {
+      Cx<W>* field;
+      Cx<W>* buf;
+      const int* site;
+      const int* owner;     // r of each line
+      const int* lo;
+      const size_t* start;
+      int l;
+      int ncomp;
+      bool pack;
+    };
+
+    template<class W>
+    void packKernel(int lo, int hi, int myId, PackArgs<W>* a)
+    {
+      const int l = a->l, ncomp = a->ncomp;
+      for(int j=lo; j < hi; ++j)
+      {
+	const int r = a->owner[j];
+	Cx<W>* b = a->buf + a->start[r] + size_t(j - a->lo[r])*l*ncomp;
+	for(int x=0; x < l; ++x)
+	{
+	  Cx<W>* f = a->field + size_t(a->site[j*l + x])*ncomp;
+	  if (a->pack)
+	    for(int c=0; c < ncomp; ++c)
+	      b[x*ncomp+c] = f[c];
+	  else
+	    for(int c=0; c < ncomp; ++c)
+	      f[c] = b[x*ncomp+c];
+	}
+      }
+    }
+
+
+    //! Puts the pieces of one node's lines together and back after the transform
+    /*!
+     * The piece of line j from position s along the direction sits at
+     * buf + start[s] + (j*l + x)*ncomp for its l points x, which are
+     * the points s*l + x of the whole line.
+     */
+    template<class W>
+    struct AssembleArgs
+    {
+      Cx<W>* buf;
+      Cx<W>* lines;
+      const size_t* start;
+      int nodes_along;
+      int l;
+      int ncomp;
+      bool gather;
+    };
+
+    template<class W>
+    void assembleKernel(int lo, int hi, int myId, AssembleArgs<W>* a)
+    {
+      const int l = a->l, ncomp = a->ncomp, len = l*a->nodes_along;
+      for(int j=lo; j < hi; ++j)
+	for(int s=0; s < a->nodes_along; ++s)
+	{
+	  Cx<W>* b = a->buf + a->start[s] + size_t(j)*l*ncomp;
+	  Cx<W>* d = a->lines + (size_t(j)*len + s*l)*ncomp;
+	  if (a->gather)
+	    for(int i=0; i < l*ncomp; ++i)
+	      d[i] = b[i];
+	  else
+	    for(int i=0; i < l*ncomp; ++i)
+	      b[i] = d[i];
+	}
+    }
+
+
+    //! Transform along mu
+    template<class W>
+    void fftDirection(Cx<W>* data, int ncomp, int sign, int mu)
+    {
+      const multi1d<int>& sub = Layout::subgridLattSize();
+      const int l = sub[mu];
+      const int nodes_along = Layout::logicalSize()[mu];
+      const int len = l * nodes_along;
+      const int vol = Layout::sitesOnNode();
+      const int nl = vol / l;
+      const int me = Layout::nodeNumber();
+
+      // The sites of this node by line j along mu and position x on it
+      std::vector<int> site(vol);
+      Layout::LatticeCoord coord;
+      for(int i=0; i < vol; ++i)
+      {
+	Layout::siteCoords(me, i, coord);
+	int j = 0;
+	for(int nu=Nd-1; nu >= 0; --nu)
+	  if (nu != mu)
+	    j = j*sub[nu] + coord[nu] % sub[nu];
+	site[j*l + coord[mu] % l] = i;
+      }
+
+      LineFFT<W> plan(len, ncomp, sign);
+
+      if (nodes_along == 1)
+      {
+	LineArgs<W> args = {data, site.data(), len, ncomp, &plan};
+	dispatch_to_threads(nl, args, lineKernel<W>);
+	return;
+      }
+
+      // Deal the lines out over the nodes along mu, lo[r] <= j < lo[r+1] to position r
+      multi1d<int> ncoord = Layout::nodeCoord();
+      const int mine = ncoord[mu];
+      std::vector<int> group(nodes_along), lo(nodes_along+1), owner(nl);
+      for(int r=0; r < nodes_along; ++r)
+      {
+	ncoord[mu] = r;
+	group[r] = Layout::getNodeNumberFrom(ncoord);
+	lo[r] = int((long long)nl*r / nodes_along);
+      }
+      lo[nodes_along] = nl;
+      for(int r=0; r < nodes_along; ++r)
+	for(int j=lo[r]; j < lo[r+1]; ++j)
+	  owner[j] = r;
+
+      const int nmine = lo[mine+1] - lo[mine];
+      const int nodes = Layout::numNodes();
+      const size_t point = ncomp*sizeof(Cx<W>);
+
+      std::vector<size_t> send_bytes(nodes, 0), recv_bytes(nodes, 0);
+      for(int r=0; r < nodes_along; ++r)
+      {
+	send_bytes[group[r]] = size_t(lo[r+1] - lo[r])*l*point;
+	recv_bytes[group[r]] = size_t(nmine)*l*point;
+      }
+
+      // Where the block of each position along mu starts, blocks in node order
+      std::vector<size_t> send_start(nodes_along), recv_start(nodes_along);
+      size_t send_total = 0, recv_total = 0;
+      for(int q=0; q < nodes; ++q)
+	for(int r=0; r < nodes_along; ++r)
+	  if (group[r] == q)
+	  {
+	    send_start[r] = send_total / sizeof(Cx<W>);
+	    recv_start[r] = recv_total / sizeof(Cx<W>);
+	    send_total += send_bytes[q];
+	    recv_total += recv_bytes[q];
+	  }
+
+      std::vector< Cx<W> > send(vol*ncomp), recv(recv_total / sizeof(Cx<W>));
+
+      PackArgs<W> pack = {data, send.data(), site.data(), owner.data(), lo.data(), send_start.data(),
+			  l, ncomp, true};
+      dispatch_to_threads(nl, pack, packKernel<W>);
+
+      QDPInternal::exchangeAll((const char*)send.data(), send_bytes.data(),
+			       (char*)recv.data(), recv_bytes.data());
+
+      // Whole lines, transformed in place
+      std::vector< Cx<W> > lines(size_t(nmine)*len*ncomp);
+      AssembleArgs<W> assemble = {recv.data(), lines.data(), recv_start.data(), nodes_along, l, ncomp, true};
+      dispatch_to_threads(nmine, assemble, assembleKernel<W>);
+
+      LineArgs<W> args = {lines.data(), 0, len, ncomp, &plan};
+      dispatch_to_threads(nmine, args, lineKernel<W>);
+
+      assemble.gather = false;
+      dispatch_to_threads(nmine, assemble, assembleKernel<W>);
+
+      // And home again
+      QDPInternal::exchangeAll((const char*)recv.data(), recv_bytes.data(),
+			       (char*)send.data(), send_bytes.data());
+
+      pack.pack = false;
+      dispatch_to_threads(nl, pack, packKernel<W>);
+    }
+
+
+    template<class W>
+    void fftAll(W* data, int ncomp, int sign, const multi1d<bool>& dirs)
+    {
+      if (sign != 1 && sign != -1)
+      {
+	QDPIO::cerr << "fft: sign must be +1 or -1, not " << sign << std::endl;
+	QDP_abort(1);
+      }
+      if (dirs.size() != Nd)
+      {
+	QDPIO::cerr << "fft: need a choice for each of the " << Nd << " directions" << std::endl;
+	QDP_abort(1);
+      }
+
+      for(int mu=0; mu < Nd; ++mu)
+	if (dirs[mu])
+	  fftDirection((Cx<W>*)data, ncomp, sign, mu);
+    }
+  }
+
+
+  namespace FFTInternal
+  {
+    void fftLattice(REAL32* data, int ncomp, int sign, const multi1d<bool>& dirs)
+    {
+      fftAll(data, ncomp, sign, dirs);
+    }
+
+    void fftLattice(REAL64* data, int ncomp, int sign, const multi1d<bool>& dirs)
+    {
+      fftAll(data, ncomp, sign, dirs);
+    }
+  }
+
+} // namespace QDP
@@ -0,0 +1,62 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Plaquettes and staples of a gauge field in one sweep
+ */
+
+#include "qdp.h"
+#include "qdp_gauge_loops.h"
+
+namespace QDP
+{
+
+  namespace
+  {
+    //! Function object of the map reading x + mu - nu at x
+    struct CornerMapFunc : public MapFunc
+    {
+      CornerMapFunc(int mu_, int nu_) : mu(mu_), nu(nu_) {}
+
+      virtual multi1d<int> operator() (const multi1d<int>& coord, int sign) const
+	{
+	  const multi1d<int>& nrow = Layout::lattSize();
+	  const int s = (sign > 0) ? 1 : -1;
+
+	  multi1d<int> lc = coord;
+	  lc[mu] = (coord[mu] + s + nrow[mu]) % nrow[mu];
+	  lc[nu] = (coord[nu] - s + nrow[nu]) % nrow[nu];
+	  return lc;
+	}
+
+      virtual bool displacement(Layout::LatticeCoord& disp) const
+	{
+	  disp.fill(0);
+	  disp[mu] = 1;
+	  disp[nu] = -1;
+	  return true;
+	}
+
+      int mu, nu;
+    };
+  }
+
+
+  namespace GaugeLoopsInternal
+  {
+    Map& cornerMap(int mu, int nu)
+    {
+      static Map* maps[Nd][Nd] = {{0}};
+
+      if (maps[mu][nu] == 0)
+      {
+	maps[mu][nu] = new Map;
+#if defined(ARCH_PARSCALAR)
+	maps[mu][nu]->setCommLabel("staples");
+#endif
+	maps[mu][nu]->make(CornerMapFunc(mu, nu));
+      }
+
+      return *maps[mu][nu];
+    }
+  }
+
+} // namespace QDP
@@ -1,10 +1,173 @@
 #include "qdp.h"
 #include "qdp_threadbind.h"
 
+#if defined(__linux__)
+#include <sched.h>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#endif
+
 namespace QDP {
 
+#if defined(__linux__)
+
+  namespace {
+
+    //! A hardware thread and the core it sits on
+    struct HwThread
+    {
+      int package;
+      int core;
+      int cpu;
+
+      bool operator<(const HwThread& h) const
+	{
+	  if (package != h.package) return package < h.package;
+	  if (core != h.core) return core < h.core;
+	  return cpu < h.cpu;
+	}
+    };
+
+    //! Read one number from a sysfs topology file of cpu, -1 if there is none
+    int topology(int cpu, const char* what)
+    {
+      char name[128];
+      snprintf(name, sizeof(name), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, what);
+
+      int val = -1;
+      FILE* f = fopen(name, "r");
+      if (f)
+      {
+	if (fscanf(f, "%d", &val) != 1)
+	  val = -1;
+	fclose(f);
+      }
+      return val;
+    }
+
+    //! The cpus this process may run on, grouped by core
+    /*! Cores in package and core order, each holding its SMT threads */
+    std::vector< std::vector<int> > coresAllowed()
+    {
+      cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      sched_getaffinity(0, sizeof(allowed), &allowed);
+
+      std::vector<HwThread> hw;
+      for(int cpu=0; cpu < CPU_SETSIZE; ++cpu)
+	if (CPU_ISSET(cpu, &allowed))
+	{
+	  // Without the topology every cpu is its own core
+	  HwThread h = {topology(cpu, "physical_package_id"), topology(cpu, "core_id"), cpu};
+	  if (h.core < 0)
+	    h.core = cpu;
+	  hw.push_back(h);
+	}
+      std::sort(hw.begin(), hw.end());
+
+      std::vector< std::vector<int> > cores;
+      for(int i=0; i < hw.size(); ++i)
+      {
+	if (i == 0 || hw[i].package != hw[i-1].package || hw[i].core != hw[i-1].core)
+	  cores.push_back(std::vector<int>());
+	cores.back().push_back(hw[i].cpu);
+      }
+      return cores;
+    }
+
+    //! user argument for the binding
+    struct BindArgs
+    {
+      const std::vector< std::vector<int> >* cores;
+      int nCores;
+      int threadsPerCore;
+      int* failed;
+    };
+
+    //! Bind thread myId to SMT thread myId % threadsPerCore of core myId / threadsPerCore
+    void bindKernel(int lo, int hi, int myId, BindArgs* a)
+    {
+      const std::vector< std::vector<int> >& cores = *a->cores;
+      const int core = (myId / a->threadsPerCore) % std::min(a->nCores, int(cores.size()));
+      const std::vector<int>& smt = cores[core];
+      const int cpu = smt[(myId % a->threadsPerCore) % smt.size()];
+
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      if (sched_setaffinity(0, sizeof(set), &set) != 0)
+	a->failed[myId] = 1;
+    }
+
+    //! user argument for the report
+    struct ReportArgs
+    {
+      int* cpu;
+    };
+
+    void reportKernel(int lo, int hi, int myId, ReportArgs* a)
+    {
+      a->cpu[myId] = sched_getcpu();
+    }
+  }
+
+
+  // Threads fill the cores in order, SMT threads of a core next to each other
+  void setThreadAffinity(int nCores, int threadsPerCore)
+  {
+    std::vector< std::vector<int> > cores = coresAllowed();
+    if (cores.empty() || nCores < 1 || threadsPerCore < 1)
+    {
+      QDPIO::cout << "setThreadAffinity: nothing to bind to\n";
+      return;
+    }
+
+    if (nCores*threadsPerCore < qdpNumThreads())
+      QDPIO::cout << "setThreadAffinity: " << qdpNumThreads() << " threads on " << nCores
+		  << " cores with " << threadsPerCore << " threads each, wrapping around\n";
+
+    // One index per thread, so each thread binds itself
+    const int nthr = qdpNumThreads();
+    std::vector<int> failed(nthr, 0);
+    BindArgs a = {&cores, nCores, threadsPerCore, &failed[0]};
+    dispatch_to_threads(nthr, a, bindKernel);
+
+    for(int t=0; t < nthr; ++t)
+      if (failed[t])
+	QDPIO::cout << "WARN: Could not do sched_setaffinity for thread " << t << "\n";
+  }
+
+  void reportAffinity()
+  {
+    std::vector< std::vector<int> > cores = coresAllowed();
+
+    const int nthr = qdpNumThreads();
+    std::vector<int> cpu(nthr, -1);
+    ReportArgs a = {&cpu[0]};
+    dispatch_to_threads(nthr, a, reportKernel);
+
+    QDPIO::cout << "Thread Bindings\n";
+    for(int t=0; t < nthr; ++t)
+    {
+      int core = -1, smt = -1;
+      for(int c=0; c < cores.size(); ++c)
+	for(int s=0; s < cores[c].size(); ++s)
+	  if (cores[c][s] == cpu[t])
+	  {
+	    core = c;
+	    smt = s;
+	  }
+
+      QDPIO::cout << "thread " << t << ": cpu = " << cpu[t] << " core = " << core
+		  << " hardware thread = " << smt << std::endl;
+    }
+  }
+
+#else
+
   // Default: User should use runtime
-  void setThreadAffinity(int nCores, int threadsPerCore) 
+  void setThreadAffinity(int nCores, int threadsPerCore)
   {
     QDPIO::cout << "Direct thread affinity not implemented for this architecture. Please use GOMP_CPU_AFFINITY, KMP_AFFINITY or other appropriate method\n";
   }
@@ -15,6 +178,7 @@ namespace QDP {
     QDPIO::cout << "Affinity reporting not implemented for this architecture\n";
   }
 
+#endif
 
 }; // END namespace
 
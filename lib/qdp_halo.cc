@@ -0,0 +1,231 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Tables and exchange of the ghost zones of HaloLayout
+ */
+
+#include "qdp.h"
+#include "qdp_halo.h"
+
+#include <cstring>
+#include <map>
+#include <set>
+
+namespace QDP
+{
+
+  namespace
+  {
+    //! Local coordinate of position p of a box of extents pad
+    void boxCoord(int p, const multi1d<int>& pad, Layout::LatticeCoord& q)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	q[mu] = p % pad[mu];
+	p /= pad[mu];
+      }
+    }
+
+    //! The site reached from origin by q-depth, wrapped around the lattice
+    void wrapped(const multi1d<int>& origin, const Layout::LatticeCoord& q, int depth,
+		 Layout::LatticeCoord& g)
+    {
+      const multi1d<int>& latt = Layout::lattSize();
+      for(int mu=0; mu < Nd; ++mu)
+	g[mu] = (origin[mu] + q[mu] - depth + latt[mu]) % latt[mu];
+    }
+
+    //! Is q in the ghost zone of the box
+    bool ghost(const Layout::LatticeCoord& q, const multi1d<int>& sub, int depth)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+	if (q[mu] < depth || q[mu] >= sub[mu] + depth)
+	  return true;
+      return false;
+    }
+
+    //! Lattice coordinate of the first site of the subgrid of node
+    multi1d<int> subgridOrigin(int node)
+    {
+      multi1d<int> org = Layout::getLogicalCoordFrom(node);
+      for(int mu=0; mu < Nd; ++mu)
+	org[mu] *= Layout::subgridLattSize()[mu];
+      return org;
+    }
+  }
+
+
+  HaloLayout::HaloLayout(int depth) : d(depth), pad(Nd), str(Nd)
+  {
+    const multi1d<int>& sub = Layout::subgridLattSize();
+    const int me = Layout::nodeNumber();
+    const int nodes = Layout::numNodes();
+
+    vol = 1;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (d < 0 || d > sub[mu])
+	QDP_error_exit("HaloLayout: depth %d is more than the subgrid extent %d in direction %d",
+		       d, sub[mu], mu);
+
+      pad[mu] = sub[mu] + 2*d;
+      str[mu] = vol;
+      vol *= pad[mu];
+    }
+
+    Layout::LatticeCoord q, g;
+
+    // The subgrid
+    const multi1d<int> org = subgridOrigin(me);
+    pos.resize(Layout::sitesOnNode());
+    for(int linear=0; linear < Layout::sitesOnNode(); ++linear)
+    {
+      Layout::siteCoords(me, linear, g);
+      int p = 0;
+      for(int mu=0; mu < Nd; ++mu)
+	p += (g[mu] - org[mu] + d)*str[mu];
+      pos[linear] = p;
+    }
+
+    // The ghost zone of this node, by the node holding each site
+    std::map<int, std::vector<int> > recv;
+    for(int p=0; p < vol; ++p)
+    {
+      boxCoord(p, pad, q);
+      if (! ghost(q, sub, d))
+	continue;
+
+      wrapped(org, q, d, g);
+      int node = Layout::nodeNumber(g);
+      if (node == me)
+      {
+	local_dst.push_back(p);
+	local_src.push_back(Layout::linearSiteIndex(g));
+      }
+      else
+	recv[node].push_back(p);
+    }
+
+    // The nodes around, at most one subgrid away in each direction
+    std::set<int> around;
+    const multi1d<int>& logical = Layout::logicalSize();
+    const multi1d<int>& mine = Layout::nodeCoord();
+    int nshell = 1;
+    for(int mu=0; mu < Nd; ++mu)
+      nshell *= 3;
+
+    for(int k=0; k < nshell; ++k)
+    {
+      multi1d<int> nc(Nd);
+      for(int mu=0, kk=k; mu < Nd; ++mu, kk /= 3)
+	nc[mu] = (mine[mu] + kk % 3 - 1 + logical[mu]) % logical[mu];
+
+      int node = Layout::getNodeNumberFrom(nc);
+      if (node != me)
+	around.insert(node);
+    }
+
+    // What their ghost zones want from here, in the order they walk them
+    std::map<int, std::vector<int> > send;
+    for(std::set<int>::const_iterator n=around.begin(); n != around.end(); ++n)
+    {
+      const multi1d<int> norg = subgridOrigin(*n);
+      for(int p=0; p < vol; ++p)
+      {
+	boxCoord(p, pad, q);
+	if (! ghost(q, sub, d))
+	  continue;
+
+	wrapped(norg, q, d, g);
+	if (Layout::nodeNumber(g) == me)
+	  send[*n].push_back(Layout::linearSiteIndex(g));
+      }
+    }
+
+    recv_num.assign(nodes, 0);
+    for(std::map<int, std::vector<int> >::const_iterator r=recv.begin(); r != recv.end(); ++r)
+    {
+      recv_num[r->first] = r->second.size();
+      recv_pos.insert(recv_pos.end(), r->second.begin(), r->second.end());
+    }
+
+    send_num.assign(nodes, 0);
+    for(std::map<int, std::vector<int> >::const_iterator s=send.begin(); s != send.end(); ++s)
+    {
+      send_num[s->first] = s->second.size();
+      send_sites.insert(send_sites.end(), s->second.begin(), s->second.end());
+    }
+  }
+
+
+  int HaloLayout::index(const multi1d<int>& x) const
+  {
+    int p = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      p += (x[mu] + d)*str[mu];
+    return p;
+  }
+
+
+  bool HaloLayout::inside(int p, int margin) const
+  {
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      int x = p % pad[mu];
+      p /= pad[mu];
+      if (x < margin || x >= pad[mu] - margin)
+	return false;
+    }
+    return true;
+  }
+
+
+  void HaloLayout::fill(char* halo, const char* field, size_t bytes) const
+  {
+    const int nsites = pos.size();
+    const int nlocal = local_dst.size();
+
+#pragma omp parallel for
+    for(int i=0; i < nsites; ++i)
+      std::memcpy(halo + size_t(pos[i])*bytes, field + size_t(i)*bytes, bytes);
+
+#pragma omp parallel for
+    for(int k=0; k < nlocal; ++k)
+      std::memcpy(halo + size_t(local_dst[k])*bytes, field + size_t(local_src[k])*bytes, bytes);
+
+    // Every node takes part, with one message to each node around it
+    if (Layout::numNodes() == 1 || d == 0)
+      return;
+
+    const int nsend = send_sites.size();
+    const int nrecv = recv_pos.size();
+    std::vector<char> sbuf(size_t(nsend)*bytes + 1), rbuf(size_t(nrecv)*bytes + 1);
+
+#pragma omp parallel for
+    for(int k=0; k < nsend; ++k)
+      std::memcpy(&sbuf[size_t(k)*bytes], field + size_t(send_sites[k])*bytes, bytes);
+
+    std::vector<size_t> send_bytes(send_num.size()), recv_bytes(recv_num.size());
+    for(size_t n=0; n < send_num.size(); ++n)
+    {
+      send_bytes[n] = send_num[n]*bytes;
+      recv_bytes[n] = recv_num[n]*bytes;
+    }
+
+    QDPInternal::exchangeAll(&sbuf[0], &send_bytes[0], &rbuf[0], &recv_bytes[0]);
+
+#pragma omp parallel for
+    for(int k=0; k < nrecv; ++k)
+      std::memcpy(halo + size_t(recv_pos[k])*bytes, &rbuf[size_t(k)*bytes], bytes);
+  }
+
+
+  void HaloLayout::extract(char* field, const char* halo, size_t bytes) const
+  {
+    const int nsites = pos.size();
+
+#pragma omp parallel for
+    for(int i=0; i < nsites; ++i)
+      std::memcpy(field + size_t(i)*bytes, halo + size_t(pos[i])*bytes, bytes);
+  }
+
+} // namespace QDP
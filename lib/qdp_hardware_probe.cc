@@ -0,0 +1,375 @@
+/*! @file
+ * @brief Startup probe of the machine choosing threads, pool size and kernels
+ */
+
+#include "qdp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sched.h>
+#include <unistd.h>
+
+#if QDP_USE_SSE == 1
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
+#endif
+
+namespace QDP
+{
+  namespace HardwareProbe
+  {
+    namespace
+    {
+      bool probe_on = false;
+      Config conf;
+
+      //! Bandwidths within this fraction of the best count as the best
+      const double triad_slack = 0.97;
+
+      //! Share of the free memory given to the pool
+      const double pool_share = 0.7;
+
+      //! Wait for all the nodes
+      void barrier()
+      {
+	double d = 0;
+	QDPInternal::globalSum(d);
+      }
+
+      //! v of every node, in node order
+      std::vector<double> allNodes(double v)
+      {
+	std::vector<double> all(Layout::numNodes(), 0.0);
+	all[Layout::nodeNumber()] = v;
+	QDPInternal::globalSumArray(&all[0], all.size());
+	return all;
+      }
+
+      //! Cpus the process may run on
+      int affinityCpus()
+      {
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0)
+	  return CPU_COUNT(&set);
+#endif
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? n : 1;
+      }
+
+      //! Nodes with the host name of this one
+      int nodesOnHost()
+      {
+	char name[256] = {0};
+	gethostname(name, sizeof(name)-1);
+
+	// FNV-1a cut to 31 bits, exact in a double
+	unsigned int h = 2166136261u;
+	for(const char* c=name; *c; ++c)
+	  h = (h ^ (unsigned char)(*c)) * 16777619u;
+
+	std::vector<double> ids = allNodes(h & 0x7fffffff);
+	int n = 0;
+	for(int k=0; k < ids.size(); ++k)
+	  if (ids[k] == ids[Layout::nodeNumber()])
+	    ++n;
+	return n;
+      }
+
+      //! Width of the vector registers the CPU has
+      int simdBits()
+      {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+	  return 512;
+	if (__builtin_cpu_supports("avx"))
+	  return 256;
+	if (__builtin_cpu_supports("sse2"))
+	  return 128;
+	return 0;
+#elif defined(__aarch64__)
+	return 128;
+#else
+	return 0;
+#endif
+      }
+
+      //! Data cache sizes of cpu0 from sysfs, 0 where it says nothing
+      void cacheSizes(size_t& l1, size_t& l2, size_t& l3)
+      {
+	l1 = l2 = l3 = 0;
+	for(int k=0; k < 16; ++k)
+	{
+	  char dir[128];
+	  snprintf(dir, sizeof(dir), "/sys/devices/system/cpu/cpu0/cache/index%d/", k);
+
+	  std::ifstream flevel((std::string(dir) + "level").c_str());
+	  std::ifstream ftype((std::string(dir) + "type").c_str());
+	  std::ifstream fsize((std::string(dir) + "size").c_str());
+	  if (! flevel || ! ftype || ! fsize)
+	    break;
+
+	  int level = 0;
+	  std::string type, size;
+	  flevel >> level;
+	  ftype >> type;
+	  fsize >> size;
+	  if (type == "Instruction" || size.empty())
+	    continue;
+
+	  size_t bytes = atol(size.c_str());
+	  if (size[size.size()-1] == 'K')
+	    bytes <<= 10;
+	  else if (size[size.size()-1] == 'M')
+	    bytes <<= 20;
+
+	  if (level == 1)
+	    l1 = bytes;
+	  else if (level == 2)
+	    l2 = bytes;
+	  else if (level == 3)
+	    l3 = bytes;
+	}
+      }
+
+      //! MemAvailable of the host, 0 when it is not known
+      size_t freeBytes()
+      {
+	std::ifstream f("/proc/meminfo");
+	std::string key;
+	size_t kb;
+	std::string unit;
+	while (f >> key >> kb >> unit)
+	  if (key == "MemAvailable:")
+	    return kb << 10;
+	return 0;
+      }
+
+
+      //! Arrays of the STREAM triad
+      struct TriadArgs
+      {
+	double* a;
+	const double* b;
+	const double* c;
+	double s;
+      };
+
+      void triadKernel(int lo, int hi, int myId, TriadArgs* t)
+      {
+	for(int i=lo; i < hi; ++i)
+	  t->a[i] = t->b[i] + t->s*t->c[i];
+      }
+
+      //! Triad GB/s of this node on the threads it has now, all the nodes at once
+      double triad(std::vector<double>& a, std::vector<double>& b, std::vector<double>& c)
+      {
+	const int n = a.size();
+	TriadArgs t = {&a[0], &b[0], &c[0], 3.0};
+
+	// Pages go to the threads that use them, then the best of a few passes
+	dispatch_to_threads(n, t, triadKernel);
+
+	double best = 0;
+	for(int rep=0; rep < 5; ++rep)
+	{
+	  barrier();
+	  const QDPTime_t t0 = getClockTime();
+	  dispatch_to_threads(n, t, triadKernel);
+	  const double secs = 1.0e-9*(getClockTime() - t0);
+	  if (secs > 0)
+	    best = std::max(best, 3.0*sizeof(double)*n / secs / 1.0e9);
+	}
+	return best;
+      }
+
+      //! Time the thread counts up to max_threads and use the one chosen
+      void chooseThreads(int max_threads)
+      {
+	// Well out of the caches of the host, which its nodes share, but
+	// not so much memory that the pass takes long
+	const size_t bytes = std::max(size_t(16) << 20, std::min(4*conf.l3/conf.nodes_on_host, size_t(128) << 20));
+	const size_t n = bytes / sizeof(double);
+	std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+
+	conf.thread_counts.clear();
+	conf.triad_gbs.clear();
+
+#if defined(QDP_USE_OMP_THREADS)
+	if (! conf.threads_given)
+	{
+	  for(int t=1; t < max_threads; t *= 2)
+	    conf.thread_counts.push_back(t);
+	}
+#endif
+	conf.thread_counts.push_back(max_threads);
+
+	double best = 0;
+	for(int k=0; k < conf.thread_counts.size(); ++k)
+	{
+#if defined(QDP_USE_OMP_THREADS)
+	  omp_set_num_threads(conf.thread_counts[k]);
+#endif
+	  std::vector<double> all = allNodes(triad(a, b, c));
+	  double mean = 0;
+	  for(int r=0; r < all.size(); ++r)
+	    mean += all[r] / all.size();
+
+	  conf.triad_gbs.push_back(mean);
+	  best = std::max(best, mean);
+	}
+
+	conf.threads = conf.thread_counts.back();
+	for(int k=conf.thread_counts.size()-1; k >= 0; --k)
+	  if (conf.triad_gbs[k] >= triad_slack*best)
+	  {
+	    conf.threads = conf.thread_counts[k];
+	    break;
+	  }
+
+#if defined(QDP_USE_OMP_THREADS)
+	omp_set_num_threads(conf.threads);
+#endif
+      }
+
+      //! Use the fastest level of the SSE/AVX kernels, the nodes adding their times
+      void chooseKernels()
+      {
+	conf.kernels.clear();
+
+#if QDP_USE_SSE == 1
+	static const char* names[] = {"sse", "avx2", "avx512"};
+	const AVX::Level top = AVX::level();
+
+	// A fermion block in cache, so the instructions and not the memory count
+	const int nspin = 256;
+	std::vector<REAL64> x(24*nspin, 1.0), y(24*nspin, 0.0);
+	REAL64 scale = 0.5;
+
+	int fastest = top;
+	double fastest_secs = 0;
+	for(int l=AVX::LEVEL_SSE; l <= top; ++l)
+	{
+	  AVX::setLevel(AVX::Level(l));
+
+	  double best = 0;
+	  for(int rep=0; rep < 3; ++rep)
+	  {
+	    const QDPTime_t t0 = getClockTime();
+	    for(int i=0; i < 1000; ++i)
+	      AVX::vaxpy4(&y[0], &scale, &x[0], nspin);
+	    const double secs = 1.0e-9*(getClockTime() - t0);
+	    if (rep == 0 || secs < best)
+	      best = secs;
+	  }
+
+	  QDPInternal::globalSum(best);
+	  if (l == AVX::LEVEL_SSE || best < fastest_secs)
+	  {
+	    fastest = l;
+	    fastest_secs = best;
+	  }
+	}
+
+	AVX::setLevel(AVX::Level(fastest));
+	conf.kernels = names[fastest];
+#endif
+      }
+    }
+
+
+    void setEnabled(bool on) {probe_on = on;}
+
+    bool enabled() {return probe_on;}
+
+    const Config& config() {return conf;}
+
+
+    void run(float& pool_gb, bool pool_given)
+    {
+      const QDPTime_t t0 = getClockTime();
+
+      conf.cpus = affinityCpus();
+      conf.nodes_on_host = nodesOnHost();
+      conf.simd_bits = simdBits();
+      cacheSizes(conf.l1, conf.l2, conf.l3);
+
+      // Free memory of each node's share of its host, the least of any node
+      std::vector<double> free = allNodes(double(freeBytes()) / conf.nodes_on_host);
+      conf.free_bytes = size_t(*std::min_element(free.begin(), free.end()));
+
+      // The cpus of the node: those it may run on when the launcher
+      // gave it a share, else its share of the host. Never more than
+      // the threads started, which sized the per thread tables
+      int max_threads = conf.cpus;
+      if (conf.cpus == sysconf(_SC_NPROCESSORS_ONLN))
+	max_threads = std::max(1, conf.cpus / conf.nodes_on_host);
+      max_threads = std::min(max_threads, qdpNumThreads());
+
+      conf.threads_given = true;
+#if defined(QDP_USE_OMP_THREADS)
+      conf.threads_given = (getenv("OMP_NUM_THREADS") != 0);
+#endif
+      if (conf.threads_given)
+	max_threads = qdpNumThreads();
+
+      // The primary node decides for all
+      QDPInternal::broadcast(max_threads);
+      chooseThreads(max_threads);
+
+      conf.pool_given = pool_given;
+      if (! pool_given && conf.free_bytes > 0)
+	pool_gb = std::max(0.125, std::floor(8*pool_share*conf.free_bytes/double(1 << 30)) / 8);
+      conf.pool_gb = pool_gb;
+
+      chooseKernels();
+
+      // The tuner has something to choose with several threads or levels
+      if (conf.threads > 1 || (! conf.kernels.empty() && conf.kernels != "sse"))
+	AutoTune::setEnabled(true);
+      conf.autotune = AutoTune::enabled();
+
+      print();
+
+      char line[64];
+      snprintf(line, sizeof(line), "  probe seconds= %.3f", 1.0e-9*(getClockTime() - t0));
+      QDPIO::cout << line << std::endl;
+    }
+
+
+    void print()
+    {
+      char line[256];
+
+      QDPIO::cout << "Hardware probe:" << std::endl;
+      snprintf(line, sizeof(line), "  cpus= %d  nodes on host= %d  simd bits= %d",
+	       conf.cpus, conf.nodes_on_host, conf.simd_bits);
+      QDPIO::cout << line << std::endl;
+      snprintf(line, sizeof(line), "  caches KB: L1d= %zu  L2= %zu  L3= %zu",
+	       conf.l1 >> 10, conf.l2 >> 10, conf.l3 >> 10);
+      QDPIO::cout << line << std::endl;
+      snprintf(line, sizeof(line), "  free memory per node GB= %.2f", conf.free_bytes / double(1 << 30));
+      QDPIO::cout << line << std::endl;
+
+      QDPIO::cout << "  triad GB/s by threads:";
+      for(int k=0; k < conf.thread_counts.size(); ++k)
+      {
+	snprintf(line, sizeof(line), "  %d: %.1f", conf.thread_counts[k], conf.triad_gbs[k]);
+	QDPIO::cout << line;
+      }
+      QDPIO::cout << std::endl;
+
+      snprintf(line, sizeof(line), "  threads= %d%s  pool GB= %.3g%s  kernels= %s  autotune= %s",
+	       conf.threads, conf.threads_given ? " (given)" : "",
+	       conf.pool_gb, conf.pool_given ? " (given)" : "",
+	       conf.kernels.empty() ? "none" : conf.kernels.c_str(),
+	       conf.autotune ? "on" : "off");
+      QDPIO::cout << line << std::endl;
+    }
+  }
+
+} // namespace QDP
@@ -75,7 +75,7 @@ namespace QDP {
 
 	//lookup routines:
 	std::string HDF5::pwd()const{
-		return getNameById(current_group);
+		return cwd;
 	}
 
 	std::string HDF5::parentDir()const{
@@ -124,6 +124,83 @@ namespace QDP {
         return dirlist;
 	}
 
+	//group cache:
+	std::string HDF5::absolutePath(const std::string& name)const{
+		std::vector<std::string> parts;
+		if(name.find_first_of("/")!=0){
+			std::vector<std::string> base;
+			const_cast<HDF5*>(this)->tokenize(cwd, base, "/");
+			parts=base;
+		}
+
+		std::vector<std::string> dirlist;
+		const_cast<HDF5*>(this)->tokenize(name, dirlist, "/");
+		for(unsigned int i=0; i<dirlist.size(); i++){
+			if(dirlist[i]==".") continue;
+			if(dirlist[i]==".."){
+				if(!parts.empty()) parts.pop_back();
+				continue;
+			}
+			parts.push_back(dirlist[i]);
+		}
+
+		std::string path;
+		for(unsigned int i=0; i<parts.size(); i++) path+="/"+parts[i];
+		return path.empty() ? std::string("/") : path;
+	}
+
+	hid_t HDF5::groupHandle(const std::string& path){
+		if(path=="/") return file_id;
+
+		std::map<std::string,hid_t>::const_iterator it=groups.find(path);
+		if(it!=groups.end()) return it->second;
+
+		hid_t h=H5Gopen(file_id,path.c_str(),H5P_DEFAULT);
+		if(h>=0) keepGroup(path,h);
+		return h;
+	}
+
+	void HDF5::keepGroup(const std::string& path, hid_t h){
+		//a walk over very many groups should not hold them all open: keep the current one only
+		const unsigned int max_groups=4096;
+		if(groups.size()>=max_groups){
+			std::map<std::string,hid_t>::iterator it=groups.begin();
+			while(it!=groups.end()){
+				if(it->second!=current_group){
+					H5Gclose(it->second);
+					groups.erase(it++);
+				}
+				else ++it;
+			}
+		}
+		groups[path]=h;
+	}
+
+	void HDF5::forgetGroups(const std::string& path){
+		std::map<std::string,hid_t>::iterator it=groups.lower_bound(path);
+		while(it!=groups.end() && it->first.compare(0,path.size(),path)==0){
+			if(it->first.size()==path.size() || it->first[path.size()]=='/'){
+				H5Gclose(it->second);
+				groups.erase(it++);
+			}
+			else ++it;
+		}
+	}
+
+	void HDF5::closeGroups(){
+		for(std::map<std::string,hid_t>::iterator it=groups.begin(); it!=groups.end(); ++it)
+			H5Gclose(it->second);
+		groups.clear();
+	}
+
+	void HDF5::setCollectiveMetadata(hid_t fapl_id){
+#if H5_VERSION_GE(1,10,0)
+		//every node makes the same lookups, so one node reads and broadcasts them:
+		H5Pset_all_coll_metadata_ops(fapl_id,true);
+		H5Pset_coll_metadata_write(fapl_id,true);
+#endif
+	}
+
 	//check if object exists:
 	bool HDF5::objectExists(const ::std::string& name){
 		return objectExists(file_id,name);
@@ -138,15 +215,27 @@ namespace QDP {
 		}
 		else start_group=loc_id;
 
-		//iterate through the tree and check whether everything on the way exists:
-		htri_t exists=H5Lexists(start_group,dirlist[0].c_str(),H5P_DEFAULT);
-		if(exists!=1) return false;
-		exists=H5Oexists_by_name(start_group,dirlist[0].c_str(),H5P_DEFAULT);
-		if(exists!=1) return false;
-		std::string tmpstring=dirlist[0];
-		for(unsigned int i=1; i<dirlist.size(); i++){
-			tmpstring+="/"+dirlist[i];
-			exists=H5Lexists(start_group,tmpstring.c_str(),H5P_DEFAULT);
+		if(dirlist.empty()) return true;
+
+		//groups held open exist, so the part of the path down to the deepest of them needs no lookup:
+		unsigned int first=0;
+		std::string tmpstring;
+		if(start_group==file_id || start_group==current_group){
+			std::string base=(start_group==file_id) ? std::string("") : (cwd=="/" ? std::string("") : cwd);
+			std::string path=base;
+			for(unsigned int i=0; i<dirlist.size(); i++){
+				path+="/"+dirlist[i];
+				if(groups.find(path)==groups.end()) continue;
+				first=i+1;
+				tmpstring=path.substr(base.size()+1);
+			}
+			if(first==dirlist.size()) return true;
+		}
+
+		//iterate through the rest of the tree and check whether everything on the way exists:
+		for(unsigned int i=first; i<dirlist.size(); i++){
+			tmpstring+=(i==0 ? "" : "/")+dirlist[i];
+			htri_t exists=H5Lexists(start_group,tmpstring.c_str(),H5P_DEFAULT);
 			if(exists!=1) return false;
 			exists=H5Oexists_by_name(start_group,tmpstring.c_str(),H5P_DEFAULT);
 			if(exists!=1) return false;
@@ -196,61 +285,33 @@ namespace QDP {
 
 	//navigation routines:
 	void HDF5::pop(){
-		//only do something if not at root-level:
-        if(pwd().compare("/")!=0){
-            hid_t tmp_group;
-            
-            //lookup what current and parent directory is:
-            ::std::string cdir=pwd();
-            ::std::string pdir=parentDir();
-            
-            //close group to prevent data loss and then go to new group:
-            H5Gclose(current_group);
-            tmp_group=H5Gopen(file_id,pdir.c_str(),H5P_DEFAULT);
-            
-            current_group=tmp_group;
-        }
+		//only do something if not at root-level. The group stays open in the cache:
+		if(pwd().compare("/")!=0){
+			std::string pdir=parentDir();
+			current_group=groupHandle(pdir);
+			cwd=pdir;
+		}
 	}
   
 	void HDF5::cd(const std::string& dirname){
-		std::string tmpdirname(dirname);
-		if(tmpdirname.compare("..")==0){
-			pop();
-		}
-		else if(tmpdirname.compare(pwd())!=0){
-			hid_t tmp_group;
-      
-			//open HDF5 group relative to current_group:
-			tmp_group=H5Gopen(current_group,tmpdirname.c_str(),H5P_DEFAULT);
-      
-			if(tmp_group<0){
-				QDPIO::cerr << "HDF5::cd: error, the group " << tmpdirname << " does not exist!" << std::endl;
-				return;
-			}
-			//only close current_group if tmp_group is not further below in the tree or completely outside:
-			//get the names of the new and current dir:
-			std::string ndir=getNameById(tmp_group);
-			std::string cdir=pwd();
-      
-			//perform different tests:
-			if(ndir.find(cdir)==::std::string::npos || ndir.compare("/")==0){
-				//ndir is not inside cdir tree or ndir is root directory, so close cdir tree:
-			    while(pwd().compare("/")!=0){
-			    	pop();
-			    }
-			}
-			else if(cdir.find(ndir)==0){
-				//ndir is parent of cdir: iterate up from cdir and close all dirs on the way:
-				while(current_group!=tmp_group){
-					pop();
-				}
-			}
-			current_group=tmp_group;
+		std::string ndir=absolutePath(dirname);
+		if(ndir==cwd) return;
+
+		//the group from the cache, opened on first use:
+		hid_t tmp_group=groupHandle(ndir);
+		if(tmp_group<0){
+			QDPIO::cerr << "HDF5::cd: error, the group " << dirname << " does not exist!" << std::endl;
+			return;
 		}
+		current_group=tmp_group;
+		cwd=ndir;
 	}
 
 	//close-routine
 	int HDF5::close(){
+		closeGroups();
+		cwd.clear();
+
 		if(file_id>0){
 			herr_t err=1;
       
@@ -645,6 +706,40 @@ namespace QDP {
 		rd(obj_name,datum,H5T_FLOAT,true);
 	}
 
+	//rows of 2D datasets
+	void HDF5::readRows(const std::string& obj_name, multi2d<int>& datum, const ullong& first, const long long& count){
+		rdRows(obj_name,datum,H5T_NATIVE_INT,H5T_INTEGER,first,count);
+	}
+
+	void HDF5::readRows(const std::string& obj_name, multi2d<float>& datum, const ullong& first, const long long& count){
+		rdRows(obj_name,datum,H5T_NATIVE_FLOAT,H5T_FLOAT,first,count);
+	}
+
+	void HDF5::readRows(const std::string& obj_name, multi2d<double>& datum, const ullong& first, const long long& count){
+		rdRows(obj_name,datum,H5T_NATIVE_DOUBLE,H5T_FLOAT,first,count);
+	}
+
+	ullong HDF5::numRows(const std::string& obj_name){
+		if(!objectExists(current_group,obj_name)){
+			HDF5_error_exit("HDF5::numRows: error, dataset "+obj_name+" does not exists!");
+		}
+		hid_t dset_id=H5Dopen(current_group,obj_name.c_str(),H5P_DEFAULT);
+		if(dset_id<0){
+			HDF5_error_exit("HDF5::numRows: error, cannot open dataset "+obj_name+"!");
+		}
+		hid_t space_id=H5Dget_space(dset_id);
+		int rank=H5Sget_simple_extent_ndims(space_id);
+		ullong rows=0;
+		if(rank>0){
+			std::vector<hsize_t> dims(rank);
+			H5Sget_simple_extent_dims(space_id, &dims[0], NULL);
+			rows=dims[0];
+		}
+		H5Sclose(space_id);
+		H5Dclose(dset_id);
+		return rows;
+	}
+
 	//***********************************************************************************************************************************
 	//***********************************************************************************************************************************
 	//READING Compound types:                                                                                                            
@@ -807,7 +902,8 @@ namespace QDP {
 
 	void HDF5::readLattice(const std::string& name, const hid_t& type_id, 
 							const hid_t& base_type_id, const ullong& obj_size, 
-							const ullong& tot_size, char* buf, bool invert_order) {
+							const ullong& tot_size, char* buf, bool invert_order,
+							const hid_t& mem_type_id) {
 		// determine local sizes
 		const int mynode = Layout::nodeNumber();
 		const int nodeSites = Layout::sitesOnNode();
@@ -856,27 +952,29 @@ namespace QDP {
 		if(H5Tget_class(base_type_id)!=H5T_FLOAT){
 			HDF5_error_exit("HDF5Reader::read: error, invalid base datatype while trying to read lattice!");
 		}
+		//the words in memory, converted by HDF5 when a memory type is given:
+		unsigned int mem_float_size=(mem_type_id>=0 ? H5Tget_size(mem_type_id) : hdf5_float_size);
 
 		//32 GB MPIO pointer protection
 		hid_t err;
 		size_t two_gb = (size_t) 2 * 1024 * 1024 * 1024;
 		size_t total_size = tot_size;
 		unsigned int blocks = 1;
-		while( (total_size * hdf5_float_size) > two_gb) {
+		while( (total_size * mem_float_size) > two_gb) {
 			dim_size[0] = dim_size[0] >> 1;
 			total_size = total_size >> 1;
 			blocks = blocks << 1;
 		} // while  
 
 		//allocate buffers and do some error handling
-		char* buf_small = new (std::nothrow) char[total_size*hdf5_float_size];
+		char* buf_small = new (std::nothrow) char[total_size*mem_float_size];
 		if(buf_small == 0x0) {
 			HDF5_error_exit("Unable to allocate buf\n");
 		} // if
 
 		hsize_t rank = static_cast<hsize_t>(dimensions);
 		hid_t memspace = H5Screate_simple(rank, dim_size, NULL);
-		hid_t nat_type_id=H5Tget_native_type(type_id,H5T_DIR_ASCEND);
+		hid_t nat_type_id=(mem_type_id>=0 ? H5Tcopy(mem_type_id) : H5Tget_native_type(type_id,H5T_DIR_ASCEND));
 
 		// read:
 		for(int i = 0; i < blocks; ++ i) {
@@ -884,8 +982,8 @@ namespace QDP {
 			H5Sselect_hyperslab(filespace, H5S_SELECT_SET, const_cast<const hsize_t*>(offset),
 			NULL, const_cast<const hsize_t*>(dim_size), NULL);
 			err = H5Dread(dset_id, nat_type_id, memspace, filespace, plist_id, static_cast<void*>(buf_small));
-			for(ullong j = 0; j < (total_size*hdf5_float_size); j++){
-				(buf + i * (total_size*hdf5_float_size) )[j] = buf_small[j];
+			for(ullong j = 0; j < (total_size*mem_float_size); j++){
+				(buf + i * (total_size*mem_float_size) )[j] = buf_small[j];
 			}
 		} // for
 		
@@ -896,20 +994,20 @@ namespace QDP {
 			int dstruct_size=tot_size/nodeSites;
 			
 			//create temporary buffer
-			char* tmpbuf=new char[nodeSites*dstruct_size*hdf5_float_size];
+			char* tmpbuf=new char[nodeSites*dstruct_size*mem_float_size];
 			for(unsigned int x=0; x<locsizes[0]; x++){
 				for(unsigned int y=0; y<locsizes[1]; y++){
 					for(unsigned int z=0; z<locsizes[2]; z++){
 						for(unsigned int t=0; t<locsizes[3]; t++){
 							//transpose from reversed input order to chroma input order
-							memcpy(&tmpbuf[dstruct_size*hdf5_float_size*(x+locsizes[0]*(y+locsizes[1]*(z+locsizes[2]*t)))],
-									&buf[dstruct_size*hdf5_float_size*(t+locsizes[3]*(z+locsizes[2]*(y+locsizes[1]*x)))],
-									dstruct_size*hdf5_float_size);
+							memcpy(&tmpbuf[dstruct_size*mem_float_size*(x+locsizes[0]*(y+locsizes[1]*(z+locsizes[2]*t)))],
+									&buf[dstruct_size*mem_float_size*(t+locsizes[3]*(z+locsizes[2]*(y+locsizes[1]*x)))],
+									dstruct_size*mem_float_size);
 						}
 					}
 				}
 			}
-			memcpy(buf,tmpbuf,nodeSites*dstruct_size*hdf5_float_size);
+			memcpy(buf,tmpbuf,nodeSites*dstruct_size*mem_float_size);
 			delete [] tmpbuf;
 		}
 		
@@ -925,6 +1023,120 @@ namespace QDP {
 		H5Dclose(dset_id);
 	} // readLattice()  
 
+	//part of a lattice dataset, in slabs along the slowest dimension of the file:
+	void HDF5::readLatticeRegion(const std::string& name, const hid_t& mem_type_id, const ullong& words_per_site,
+				     const multi1d<int>& lower, const multi1d<int>& extent, bool invert_order,
+				     const std::function<void(const std::vector<int>&, const char*)>& put){
+		if(lower.size()!=Nd || extent.size()!=Nd){
+			HDF5_error_exit("HDF5::readRegion: error, the box needs Nd lower corners and extents!");
+		}
+		for(int mu=0; mu<Nd; mu++){
+			if(lower[mu]<0 || extent[mu]<0 || lower[mu]+extent[mu]>Layout::lattSize()[mu]){
+				HDF5_error_exit("HDF5::readRegion: error, the box does not lie in the lattice!");
+			}
+		}
+
+		multi1d<ullong> sizes;
+		hid_t type_id;
+		readPrepareLattice(name,type_id,sizes);
+		bool isfloat=(H5Tget_class(type_id)==H5T_FLOAT);
+		H5Tclose(type_id);
+		if(!isfloat){
+			HDF5_error_exit("HDF5::readRegion: error, "+name+" is not a dataset of floating point words!");
+		}
+		if(sizes.size()!=(Nd+1)){
+			HDF5_error_exit("HDF5::readRegion: error, wrong dimensionality!");
+		}
+		if(sizes[Nd]!=words_per_site){
+			HDF5_error_exit("HDF5::readRegion: error, the sites of "+name+" differ in size from those of the field!");
+		}
+
+		//file dimension i holds lattice direction latt[i]:
+		std::vector<int> latt(Nd);
+		for(int i=0; i<Nd; i++){
+			latt[i]=(invert_order ? Nd-1-i : i);
+			if(sizes[i]!=Layout::lattSize()[latt[i]]){
+				HDF5_error_exit("HDF5::readRegion: mismatching lattice extents.");
+			}
+		}
+
+		//the part of the box on this node, in file order:
+		std::vector<hsize_t> start(Nd+1), count(Nd+1);
+		bool empty=false;
+		for(int i=0; i<Nd; i++){
+			int mu=latt[i];
+			int nlo=Layout::nodeCoord()[mu]*Layout::subgridLattSize()[mu];
+			int lo=std::max(lower[mu],nlo);
+			int hi=std::min(lower[mu]+extent[mu],nlo+Layout::subgridLattSize()[mu]);
+			start[i]=lo;
+			count[i]=(hi>lo ? hi-lo : 0);
+			if(hi<=lo) empty=true;
+		}
+		start[Nd]=0;
+		count[Nd]=words_per_site;
+
+		//slabs of the slowest dimension of at most 64 MB, as many on every node, since reads are collective:
+		const size_t word_size=H5Tget_size(mem_type_id);
+		size_t row_bytes=words_per_site*word_size;
+		for(int i=1; i<Nd; i++) row_bytes*=Layout::subgridLattSize()[latt[i]];
+		const int rows=Layout::subgridLattSize()[latt[0]];
+		const int slab=std::max(1, std::min(rows, static_cast<int>((size_t(64)*1024*1024)/std::max(row_bytes,size_t(1)))));
+		const int nslabs=(rows+slab-1)/slab;
+
+		hid_t dset_id=H5Dopen(current_group,name.c_str(),H5P_DEFAULT);
+		hid_t filespace=H5Dget_space(dset_id);
+		hid_t plist_id=H5Pcreate(H5P_DATASET_XFER);
+		H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+
+		std::vector<char> buf;
+		std::vector<int> sites;
+		multi1d<int> coord(Nd);
+		for(int n=0; n<nslabs; n++){
+			//this node's rows of slab n:
+			std::vector<hsize_t> s_start(start), s_count(count);
+			hsize_t nodefirst=Layout::nodeCoord()[latt[0]]*rows;
+			hsize_t first=std::max<hsize_t>(start[0], nodefirst+n*slab);
+			hsize_t last=std::min<hsize_t>(start[0]+count[0], nodefirst+(n+1)*slab);
+			s_start[0]=first;
+			s_count[0]=(!empty && last>first ? last-first : 0);
+
+			hsize_t nsites=1;
+			for(int i=0; i<Nd; i++) nsites*=s_count[i];
+
+			hsize_t memsize=nsites*words_per_site;
+			hid_t memspace=H5Screate_simple(1, &memsize, NULL);
+			buf.resize(std::max<size_t>(nsites*words_per_site*word_size,1));
+			if(nsites>0){
+				H5Sselect_hyperslab(filespace, H5S_SELECT_SET, &s_start[0], NULL, &s_count[0], NULL);
+			}
+			else{
+				H5Sselect_none(filespace);
+				H5Sselect_none(memspace);
+			}
+			herr_t status=H5Dread(dset_id, mem_type_id, memspace, filespace, plist_id, static_cast<void*>(&buf[0]));
+			H5Sclose(memspace);
+			if(status<0){
+				HDF5_error_exit("HDF5::readRegion: error reading "+name+"!");
+			}
+
+			//the sites in the order read, the last dimension of the file fastest:
+			sites.resize(nsites);
+			for(hsize_t k=0; k<nsites; k++){
+				hsize_t r=k;
+				for(int i=Nd-1; i>=0; i--){
+					coord[latt[i]]=s_start[i]+r%s_count[i];
+					r/=s_count[i];
+				}
+				sites[k]=Layout::linearSiteIndex(coord);
+			}
+			if(nsites>0) put(sites,&buf[0]);
+		}
+
+		H5Pclose(plist_id);
+		H5Sclose(filespace);
+		H5Dclose(dset_id);
+	}
+
 
 	//read LatticeColorMatrix
 	template<>void HDF5::read< PScalar< PColorMatrix< RComplex<REAL64>, 3> > >(const std::string& name, 
@@ -1486,6 +1698,7 @@ namespace QDP {
 		MPI_Info info  = MPI_INFO_NULL;
 		QMP_get_hidden_comm(QMP_comm_get_default(),reinterpret_cast<void**>(&mpicomm));
 		H5Pset_fapl_mpio(fapl_id,*mpicomm, info);
+		setCollectiveMetadata(fapl_id);
    
 		
 		file_id=H5Fopen(filename.c_str(),H5F_ACC_RDONLY,fapl_id);
@@ -1496,6 +1709,7 @@ namespace QDP {
 		}
       
 		current_group=file_id;
+		cwd="/";
 	}
 
 
@@ -1528,7 +1742,11 @@ namespace QDP {
 		hid_t fcpl_id = H5Pcreate(H5P_FILE_CREATE);
 
 		//switch on LUSTRE optimizations:
-		if(stripesize>0){ 
+		if(wopts.alignment>0){
+			//memory alignment from the write options:
+			H5Pset_alignment(fapl_id,wopts.align_threshold,wopts.alignment);
+		}
+		else if(stripesize>0){ 
 			//memory alignment:
 			H5Pset_alignment(fapl_id,maxalign,stripesize);
 		}
@@ -1540,6 +1758,7 @@ namespace QDP {
 		MPI_Info info  = MPI_INFO_NULL;
 		QMP_get_hidden_comm(QMP_comm_get_default(),reinterpret_cast<void**>(&mpicomm));
 		H5Pset_fapl_mpio(fapl_id,*mpicomm,info);
+		if(wopts.collective_metadata) setCollectiveMetadata(fapl_id);
 
 		//collective file creation/opening:
 		//on node 0, test if file exists:
@@ -1591,6 +1810,7 @@ namespace QDP {
 		}
 
 		current_group=file_id;
+		cwd="/";
 	}
 
 	//create a new group inside current one w/o steping into it:
@@ -1618,6 +1838,15 @@ namespace QDP {
 		hid_t last_group;
 		for(unsigned int i=0; i<static_cast<unsigned int>(dirlist.size()); i++){
 			last_group=current_group;
+			std::string path=absolutePath(dirlist[i]);
+
+			//a group already open is there and needs no lookup:
+			std::map<std::string,hid_t>::const_iterator it=groups.find(path);
+			if(it!=groups.end()){
+				current_group=it->second;
+				cwd=path;
+				continue;
+			}
 
 			//check if group exists:
 			htri_t ex=H5Lexists(last_group,dirlist[i].c_str(),H5P_DEFAULT);
@@ -1658,6 +1887,10 @@ namespace QDP {
 			if(current_group<0){
 				HDF5_error_exit("HDF5Writer::push: something went wrong, aborting!");
 			}
+			if(current_group!=last_group){
+				keepGroup(path,current_group);
+				cwd=path;
+			}
 		}
 		
 		//close plist-identifier
@@ -2186,8 +2419,28 @@ namespace QDP {
 			offset[Nd] = node_offset[Nd] = 0;
 		}
 
-		//LUSTRE optimization:
-		if(stripesize > 0) H5Pset_chunk(dcpl_id,dimension, total_count);
+		//LUSTRE optimization, chunks: the node subgrid unless given explicitly
+		if(wopts.chunk.size()==Nd){
+			hsize_t* chunk = new hsize_t[dimension];
+			for(unsigned int i = 0; i < Nd; ++ i){
+				chunk[i] = static_cast<hsize_t>(wopts.chunk[(Nd - 1) - i]);
+				if((chunk[i] == 0) || (chunk[i] > spacesize[i])){
+					HDF5_error_exit("HDF5Writer::write: error, chunk extent out of range!");
+				}
+			}
+			if(obj_size>1) chunk[Nd] = obj_size;
+			H5Pset_chunk(dcpl_id,dimension, chunk);
+			delete [] chunk;
+		}
+		else if((stripesize > 0) || wopts.chunk_subgrid || wopts.filtered()) H5Pset_chunk(dcpl_id,dimension, total_count);
+		setFilters(dcpl_id);
+
+		//benchmark from creation to close, timing the slowest node:
+		StopWatch swatch_bench;
+		if(wopts.benchmark){
+			MPI_Barrier(*mpicomm);
+			swatch_bench.start();
+		}
 
 		//create dataset:
 		hid_t dset_id = H5Dcreate(current_group, name.c_str(), datatype, filespace,
@@ -2196,9 +2449,10 @@ namespace QDP {
 		H5Pclose(dcpl_id);
 		delete [] spacesize;
 
-		//create property list for writeout:
+		//create property list for writeout. Filters need collective transfer:
 		hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
-		H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+		if(wopts.collective || wopts.filtered()) H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+		else H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_INDEPENDENT);
 
 		size_t typesize=H5Tget_size(datatype);
 		size_t total_size = typesize * obj_size * Layout::sitesOnNode();
@@ -2234,8 +2488,206 @@ namespace QDP {
 		H5Sclose(filespace);
 		H5Sclose(memspace);
 		H5Pclose(plist_id);
+
+		if(wopts.benchmark){
+			MPI_Barrier(*mpicomm);
+			swatch_bench.stop();
+
+			double gbytes = static_cast<double>(typesize) * obj_size * Layout::vol() / 1.0e9;
+			double secs = swatch_bench.getTimeInSeconds();
+			QDPIO::cout << "HDF5Writer: wrote " << name << ": " << gbytes << " GB in " << secs << " s. Bandwidth: "
+				    << gbytes/secs << " GB/s (" << (wopts.collective || wopts.filtered() ? "collective" : "independent")
+				    << (wopts.filtered() ? ", filtered" : "") << ")" << std::endl;
+		}
 	} // writeLattice() 
 
+	//filters from the write options:
+	void HDF5Writer::setFilters(hid_t dcpl_id){
+		if(wopts.shuffle) H5Pset_shuffle(dcpl_id);
+		if(wopts.deflate > 0){
+			if(H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0){
+				HDF5_error_exit("HDF5Writer::write: error, deflate filter is not available!");
+			}
+			H5Pset_deflate(dcpl_id, wopts.deflate);
+		}
+		if(wopts.szip > 0){
+			if(H5Zfilter_avail(H5Z_FILTER_SZIP) <= 0){
+				HDF5_error_exit("HDF5Writer::write: error, szip filter is not available!");
+			}
+			H5Pset_szip(dcpl_id, H5_SZIP_NN_OPTION_MASK, wopts.szip);
+		}
+	}
+
+	//chunked and filtered creation list for datasets that node 0 writes:
+	hid_t HDF5Writer::createPrimaryDcpl(int rank, const hsize_t* dims){
+		hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+		if(!wopts.filtered()) return dcpl_id;
+
+		//filters need a chunked layout, one chunk holds the whole dataset:
+		for(int i=0; i<rank; i++){
+			if(dims[i] == 0) return dcpl_id;
+		}
+		H5Pset_chunk(dcpl_id, rank, dims);
+		setFilters(dcpl_id);
+		return dcpl_id;
+	}
+
+	//write from node 0 alone, or collectively with the other nodes selecting nothing:
+	herr_t HDF5Writer::writePrimary(hid_t dataid, const hid_t& hdftype, const void* buf){
+		herr_t status = 0;
+		hid_t plist_id = H5Pcreate (H5P_DATASET_XFER);
+
+		if(!wopts.filtered()){
+			H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_INDEPENDENT);
+			if(buf != 0x0) status = H5Dwrite(dataid,hdftype,H5S_ALL,H5S_ALL,plist_id,buf);
+		}
+		else{
+			H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+			hid_t filespace = H5Dget_space(dataid);
+			hid_t memspace = H5Scopy(filespace);
+			char dummy = 0;
+			if(buf == 0x0){
+				H5Sselect_none(filespace);
+				H5Sselect_none(memspace);
+				buf = &dummy;
+			}
+			status = H5Dwrite(dataid,hdftype,memspace,filespace,plist_id,buf);
+			H5Sclose(memspace);
+			H5Sclose(filespace);
+		}
+
+		H5Pclose(plist_id);
+		return status;
+	}
+
+	//an extensible dataset for append, or the one there already:
+	void HDF5Writer::appendPrepare(const std::string& dataname, const std::string& path, const hid_t& hdftype, const hsize_t& rowlen){
+		AppendBuffer buffer;
+		buffer.memtype=hdftype;
+		buffer.rowlen=rowlen;
+		buffer.rows_in_file=0;
+		buffer.nrows=0;
+
+		hid_t dataid;
+		if(objectExists(current_group,dataname)){
+			H5O_info_t objinfo;
+			H5Oget_info_by_name(current_group,dataname.c_str(),&objinfo,H5P_DEFAULT);
+			if(objinfo.type!=H5O_TYPE_DATASET){
+				HDF5_error_exit("HDF5Writer::append: error, "+dataname+" exists and is not a dataset!");
+			}
+			dataid=H5Dopen(current_group,dataname.c_str(),H5P_DEFAULT);
+
+			//it must take more rows of the same length and kind:
+			hid_t type_id=H5Dget_type(dataid);
+			bool sametype=(H5Tget_class(type_id)==H5Tget_class(hdftype));
+			H5Tclose(type_id);
+			hid_t spaceid=H5Dget_space(dataid);
+			hsize_t dims[2], maxdims[2];
+			bool fits=(H5Sget_simple_extent_ndims(spaceid)==2);
+			if(fits){
+				H5Sget_simple_extent_dims(spaceid, dims, maxdims);
+				fits=(dims[1]==rowlen && maxdims[0]==H5S_UNLIMITED);
+			}
+			H5Sclose(spaceid);
+			if(!sametype || !fits){
+				HDF5_error_exit("HDF5Writer::append: error, "+dataname+" exists and cannot take these rows!");
+			}
+			buffer.rows_in_file=dims[0];
+		}
+		else{
+			//no rows yet, as many as will come later:
+			hsize_t dims[2]={0,rowlen}, maxdims[2]={H5S_UNLIMITED,rowlen};
+			hsize_t chunk[2]={static_cast<hsize_t>(std::max(wopts.append_rows,1)),std::max(rowlen,static_cast<hsize_t>(1))};
+			hid_t spaceid=H5Screate_simple(2, dims, maxdims);
+			hid_t dcpl_id=H5Pcreate(H5P_DATASET_CREATE);
+			H5Pset_chunk(dcpl_id, 2, chunk);
+			setFilters(dcpl_id);
+			dataid=H5Dcreate(current_group,dataname.c_str(),hdftype,spaceid,H5P_DEFAULT,dcpl_id,H5P_DEFAULT);
+			H5Pclose(dcpl_id);
+			H5Sclose(spaceid);
+			if(dataid<0){
+				HDF5_error_exit("HDF5Writer::append: error, cannot create dataset "+dataname+"!");
+			}
+		}
+		H5Dclose(dataid);
+		appends[path]=buffer;
+	}
+
+	//all nodes extend the dataset, node 0 writes the new rows into it:
+	void HDF5Writer::appendFlush(const std::string& path, AppendBuffer& buffer){
+		if(buffer.nrows==0) return;
+
+		hid_t dataid=H5Dopen(file_id,path.c_str(),H5P_DEFAULT);
+		if(dataid<0){
+			HDF5_error_exit("HDF5Writer::append: error, cannot open dataset "+path+" to write its rows!");
+		}
+		hsize_t dims[2]={buffer.rows_in_file+buffer.nrows,buffer.rowlen};
+		herr_t status=H5Dset_extent(dataid, dims);
+
+		hsize_t start[2]={buffer.rows_in_file,0}, block[2]={buffer.nrows,buffer.rowlen};
+		hid_t filespace=H5Dget_space(dataid);
+		hid_t memspace=H5Screate_simple(2, block, NULL);
+		hid_t plist_id=H5Pcreate(H5P_DATASET_XFER);
+		bool mine=(Layout::nodeNumber()==0 && buffer.rowlen>0);
+		if(mine){
+			H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, block, NULL);
+		}
+		else{
+			H5Sselect_none(filespace);
+			H5Sselect_none(memspace);
+		}
+
+		//filtered chunks are written collectively, the other nodes selecting nothing:
+		char dummy=0;
+		const void* buf=(mine ? static_cast<const void*>(&buffer.rows[0]) : static_cast<const void*>(&dummy));
+		if(wopts.filtered()){
+			H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+			if(status>=0) status=H5Dwrite(dataid,buffer.memtype,memspace,filespace,plist_id,buf);
+		}
+		else{
+			H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_INDEPENDENT);
+			if(status>=0 && mine) status=H5Dwrite(dataid,buffer.memtype,memspace,filespace,plist_id,buf);
+		}
+		H5Pclose(plist_id);
+		H5Sclose(memspace);
+		H5Sclose(filespace);
+		H5Dclose(dataid);
+
+		int g_stat=0;
+		get_global(g_stat, (int)status);    // get node 0 value
+		if(g_stat<0){
+			HDF5_error_exit("HDF5Writer::append: writing the rows of "+path+" failed!");
+		}
+
+		buffer.rows_in_file+=buffer.nrows;
+		buffer.nrows=0;
+		buffer.rows.clear();
+	}
+
+	void HDF5Writer::append(const std::string& obj_name, const multi1d<int>& row){
+		ap(obj_name,row,H5T_NATIVE_INT);
+	}
+
+	void HDF5Writer::append(const std::string& obj_name, const multi1d<float>& row){
+		ap(obj_name,row,H5T_NATIVE_FLOAT);
+	}
+
+	void HDF5Writer::append(const std::string& obj_name, const multi1d<double>& row){
+		ap(obj_name,row,H5T_NATIVE_DOUBLE);
+	}
+
+	void HDF5Writer::flushAppends(){
+		for(std::map<std::string, AppendBuffer>::iterator it=appends.begin(); it!=appends.end(); ++it){
+			appendFlush(it->first,it->second);
+		}
+	}
+
+	int HDF5Writer::close(){
+		if(file_id>0) flushAppends();
+		appends.clear();
+		return HDF5::close();
+	}
+
 	//float lattice color matrix:
 	template<>
 	void HDF5Writer::write< PScalar< PColorMatrix< RComplex<REAL32>, 3> > >(const std::string& name, const LatticeColorMatrixF3& field, const HDF5Base::writemode& mode){
@@ -2658,6 +3110,7 @@ namespace QDP {
 					}
 				}
 				deleteAllAttributes(name);
+				forgetGroups(absolutePath(name));
 				H5Ldelete(current_group,name.c_str(),H5P_DEFAULT);
 			}
 		}
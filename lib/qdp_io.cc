@@ -7,12 +7,23 @@
 #include "qdp_byteorder.h"
 #include <complex>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace QDP
 {
 
   //--------------------------------------------------------------------------------
   // Text reader object support
-  TextReader::TextReader() {}
+  TextReader::TextReader() : object_depth(0) {}
+
+  void TextReader::endObject(void* p, int n)
+  {
+    if (--object_depth == 0)
+      QDPInternal::broadcast(p, n);
+  }
 
   // Propagate status to all nodes
   bool TextReader::fail()
@@ -39,6 +50,9 @@ namespace QDP
       lleng = input.length() + 1;
     }
 
+    if (object_depth > 0)
+      return;
+
     // First must broadcast size of string
     QDPInternal::broadcast(lleng);
 
@@ -113,8 +127,9 @@ namespace QDP
     if (Layout::primaryNode())
       getIstream() >> input;
 
-    // Now broadcast back out to all nodes
-    QDPInternal::broadcast(input);
+    // Now broadcast back out to all nodes, or leave it to endObject
+    if (object_depth == 0)
+      QDPInternal::broadcast(input);
   }
 
   // Different bindings for read functions
@@ -405,12 +420,22 @@ namespace QDP
 
   void TextWriter::write(const float& output)
   {
-    writePrimitive<float>(output);
+    // Shortest text that reads back to the same value
+    if (Layout::primaryNode())
+    {
+      char b[NumFormat::maxChars];
+      getOstream().write(b, NumFormat::shortest(b, output));
+    }
   }
 
   void TextWriter::write(const double& output)
   {
-    writePrimitive<double>(output);
+    // Shortest text that reads back to the same value
+    if (Layout::primaryNode())
+    {
+      char b[NumFormat::maxChars];
+      getOstream().write(b, NumFormat::shortest(b, output));
+    }
   }
 
   void TextWriter::write(const bool& output)
@@ -719,17 +744,39 @@ namespace QDP
       // Read
       // By default, we expect all data to be in big-endian
       getIstream().read(input, size*nmemb);
-      internalChecksum() = QDPUtil::crc32(internalChecksum(), input, size*nmemb);
 
-      if (! QDPUtil::big_endian())
-      {
-	// little-endian
-	// Swap
-	QDPUtil::byte_swap(input, size, nmemb);
-      }
+      // Checksum the big-endian bytes and swap them in one pass
+      internalChecksum() = QDPUtil::crc32_from_big_endian(internalChecksum(), input, input, size, nmemb);
     }
   }
 
+  void BinaryReader::readBytesPrimaryNode(char* input, size_t nbytes)
+  {
+    if (Layout::primaryNode())
+    {
+      getIstream().read(input, nbytes);
+      internalChecksum() = QDPUtil::crc32(internalChecksum(), input, nbytes);
+    }
+  }
+
+
+  BinaryReader::off_type BinaryReader::parallelBegin()
+  {
+    long long pos = 0;
+    if (Layout::primaryNode())
+      pos = getIstream().tellg();
+    QDPInternal::broadcast(pos);
+    return pos;
+  }
+
+  void BinaryReader::parallelEnd(off_type start, size_t len, QDPUtil::n_uint32_t crc)
+  {
+    if (Layout::primaryNode())
+    {
+      getIstream().seekg(start + off_type(len));
+      internalChecksum() = QDPUtil::crc32_combine(internalChecksum(), crc, len);
+    }
+  }
 
   void BinaryReader::readArrayLittleEndian(char* input, size_t size, size_t nmemb)
   {
@@ -963,13 +1010,14 @@ namespace QDP
 
   //--------------------------------------------------------------------------------
   // Binary reader support
-  BinaryFileReader::BinaryFileReader() {checksum=0;}
+  BinaryFileReader::BinaryFileReader() : parallel(false) {checksum=0;}
 
-  BinaryFileReader::BinaryFileReader(const std::string& p) {checksum=0;open(p);}
+  BinaryFileReader::BinaryFileReader(const std::string& p) : parallel(false) {checksum=0;open(p);}
 
   void BinaryFileReader::open(const std::string& p) 
   {
     checksum = 0;
+    path = p;
     if (Layout::primaryNode()) 
       f.open(p.c_str(),std::ifstream::in | std::ifstream::binary);
 
@@ -1007,6 +1055,194 @@ namespace QDP
   BinaryFileReader::~BinaryFileReader() {close();}
 
 
+  //--------------------------------------------------------------------------------
+  // Mapped binary reader support
+  BinaryMappedFileReader::BinaryMappedFileReader() : checksum(0), base(0), len(0), f(&buf) {}
+
+  BinaryMappedFileReader::BinaryMappedFileReader(const std::string& p) : checksum(0), base(0), len(0), f(&buf) {open(p);}
+
+  BinaryMappedFileReader::~BinaryMappedFileReader() {close();}
+
+  void BinaryMappedFileReader::open(const std::string& p)
+  {
+    close();
+    checksum = 0;
+
+    int fd = ::open(p.c_str(), O_RDONLY);
+    if (fd < 0)
+      QDP_error_exit("BinaryMappedFileReader: error opening file %s on node %d", p.c_str(), Layout::nodeNumber());
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+      QDP_error_exit("BinaryMappedFileReader: cannot map empty or unreadable file %s", p.c_str());
+
+    void* m = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED)
+      QDP_error_exit("BinaryMappedFileReader: mmap of %s failed on node %d", p.c_str(), Layout::nodeNumber());
+
+    base = (const char*)m;
+    len  = st.st_size;
+    buf.set(base, len);
+    f.clear();
+  }
+
+  void BinaryMappedFileReader::close()
+  {
+    if (base != 0)
+    {
+      munmap(const_cast<char*>(base), len);
+      base = 0;
+      len = 0;
+      buf.set(0, 0);
+    }
+  }
+
+  std::streambuf::pos_type 
+  BinaryMappedFileReader::MappedBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+  {
+    off_type pos = off;
+    if (dir == std::ios_base::cur)
+      pos += gptr() - eback();
+    else if (dir == std::ios_base::end)
+      pos += egptr() - eback();
+
+    if (! (which & std::ios_base::in) || pos < 0 || pos > egptr() - eback())
+      return pos_type(off_type(-1));
+
+    setg(eback(), eback() + pos, egptr());
+    return pos_type(pos);
+  }
+
+  std::streambuf::pos_type 
+  BinaryMappedFileReader::MappedBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+  {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+
+  // Every node reads, there is nothing to broadcast
+  void BinaryMappedFileReader::readArrayPrimaryNode(char* input, size_t size, size_t nmemb)
+  {
+    f.read(input, size*nmemb);
+    checksum = QDPUtil::crc32_from_big_endian(checksum, input, input, size, nmemb);
+  }
+
+  void BinaryMappedFileReader::readBytesPrimaryNode(char* input, size_t nbytes)
+  {
+    f.read(input, nbytes);
+    checksum = QDPUtil::crc32(checksum, input, nbytes);
+  }
+
+  void BinaryMappedFileReader::readArray(char* input, size_t size, size_t nmemb)
+  {
+    readArrayPrimaryNode(input, size, nmemb);
+  }
+
+  void BinaryMappedFileReader::readArrayPrimaryNodeLittleEndian(char* input, size_t size, size_t nmemb)
+  {
+    f.read(input, size*nmemb);
+
+    if (QDPUtil::big_endian())
+      QDPUtil::byte_swap(input, size, nmemb);
+  }
+
+  void BinaryMappedFileReader::readArrayLittleEndian(char* input, size_t size, size_t nmemb)
+  {
+    readArrayPrimaryNodeLittleEndian(input, size, nmemb);
+  }
+
+  void BinaryMappedFileReader::readDesc(std::string& input)
+  {
+    int n;
+    readArrayPrimaryNode((char*)&n, sizeof(int), 1);
+
+    if (n < 0 || size_t(n) > len)
+      QDP_error_exit("BinaryMappedFileReader: bad string length %d", n);
+
+    input.resize(n);
+    if (n > 0)
+      readArrayPrimaryNode(&input[0], sizeof(char), n);
+  }
+
+  void BinaryMappedFileReader::read(std::string& input, size_t maxBytes)
+  {
+    char *str = new(std::nothrow) char[maxBytes];
+    if( str == 0x0 ) { 
+      QDP_error_exit("Couldnt new str in qdp_io.cc\n");
+    }
+
+    f.getline(str, maxBytes);
+    size_t n = strlen(str);
+    checksum = QDPUtil::crc32(checksum, str, n);   // no string terminator
+    checksum = QDPUtil::crc32(checksum, "\n", 1);   // account for newline written
+
+    input = str;
+    delete[] str;
+  }
+
+  bool BinaryMappedFileReader::fail() {return f.fail();}
+
+  QDPUtil::n_uint32_t BinaryMappedFileReader::getChecksum() {return checksum;}
+
+  BinaryReader::pos_type BinaryMappedFileReader::currentPosition() {return f.tellg();}
+
+  void BinaryMappedFileReader::seek(pos_type pos)
+  {
+    f.seekg(pos);
+    checksum = 0;
+  }
+
+  void BinaryMappedFileReader::seekBegin(off_type off)
+  {
+    f.seekg(off, std::ios_base::beg);
+    checksum = 0;
+  }
+
+  void BinaryMappedFileReader::seekRelative(off_type off)
+  {
+    f.seekg(off, std::ios_base::cur);
+    checksum = 0;
+  }
+
+  void BinaryMappedFileReader::seekEnd(off_type off)
+  {
+    f.seekg(-off, std::ios_base::end);
+    checksum = 0;
+  }
+
+  void BinaryMappedFileReader::rewind()
+  {
+    f.clear();
+    f.seekg(0, std::ios_base::beg);
+    checksum = 0;
+  }
+
+
+  //--------------------------------------------------------------------------------
+  // Write words in big-endian order through a small buffer, updating crc with the
+  // bytes written. The output is left alone rather than swapped there and back
+  static void writeBigEndian(std::ostream& os, QDPUtil::n_uint32_t& crc,
+			     const char* output, size_t size, size_t nmemb)
+  {
+    if (QDPUtil::big_endian() || size == 1)
+    {
+      crc = QDPUtil::crc32(crc, output, size*nmemb);
+      os.write(output, size*nmemb);
+      return;
+    }
+
+    char buf[16384];
+    const size_t block = sizeof(buf) / size;
+
+    for(size_t n = 0; n < nmemb; n += block)
+    {
+      size_t m = (nmemb - n < block) ? nmemb - n : block;
+      crc = QDPUtil::crc32_to_big_endian(crc, buf, output + n*size, size, m);
+      os.write(buf, m*size);
+    }
+  }
+
+
   //--------------------------------------------------------------------------------
   // Binary writer support
   BinaryWriter::BinaryWriter() {}
@@ -1157,25 +1393,17 @@ namespace QDP
   }
 
   void BinaryWriter::writeArrayPrimaryNode(const char* output, size_t size, size_t nmemb)
+  {
+    if (Layout::primaryNode())
+      writeBigEndian(getOstream(), internalChecksum(), output, size, nmemb);
+  }
+
+  void BinaryWriter::writeBytesPrimaryNode(const char* output, size_t nbytes)
   {
     if (Layout::primaryNode())
     {
-      if (QDPUtil::big_endian())
-      {
-	/* big-endian */
-	/* Write */
-	internalChecksum() = QDPUtil::crc32(internalChecksum(), output, size*nmemb);
-	getOstream().write(output, size*nmemb);
-      }
-      else
-      {
-	/* little-endian */
-	/* Swap and write and swap */
-	QDPUtil::byte_swap(const_cast<char *>(output), size, nmemb);
-	internalChecksum() = QDPUtil::crc32(internalChecksum(), output, size*nmemb);
-	getOstream().write(output, size*nmemb);
-	QDPUtil::byte_swap(const_cast<char *>(output), size, nmemb);
-      }
+      internalChecksum() = QDPUtil::crc32(internalChecksum(), output, nbytes);
+      getOstream().write(output, nbytes);
     }
   }
 
@@ -1184,6 +1412,27 @@ namespace QDP
     writeArrayPrimaryNode(output, size, nmemb);
   }
 
+  BinaryWriter::off_type BinaryWriter::parallelBegin()
+  {
+    long long pos = 0;
+    if (Layout::primaryNode())
+    {
+      getOstream().flush();
+      pos = getOstream().tellp();
+    }
+    QDPInternal::broadcast(pos);
+    return pos;
+  }
+
+  void BinaryWriter::parallelEnd(off_type start, size_t len, QDPUtil::n_uint32_t crc)
+  {
+    if (Layout::primaryNode())
+    {
+      getOstream().seekp(start + off_type(len));
+      internalChecksum() = QDPUtil::crc32_combine(internalChecksum(), crc, len);
+    }
+  }
+
   // Get the checksum from the binary node to all nodes
   QDPUtil::n_uint32_t BinaryWriter::getChecksum()
   {
@@ -1392,13 +1641,14 @@ namespace QDP
 
   //--------------------------------------------------------------------------------
   // Binary writer support
-  BinaryFileWriter::BinaryFileWriter() {checksum = 0;}
+  BinaryFileWriter::BinaryFileWriter() : parallel(false) {checksum = 0;}
 
-  BinaryFileWriter::BinaryFileWriter(const std::string& p) {checksum = 0; open(p);}
+  BinaryFileWriter::BinaryFileWriter(const std::string& p) : parallel(false) {checksum = 0; open(p);}
 
   void BinaryFileWriter::open(const std::string& p) 
   {
     checksum = 0;
+    path = p;
     if (Layout::primaryNode()) 
       f.open(p.c_str(),std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
 
@@ -1643,4 +1893,152 @@ namespace QDP
   BinaryFileReaderWriter::~BinaryFileReaderWriter() {close();}
 
 
+  //--------------------------------------------------------------------------------
+  // Node local binary reader/writer support
+  BinaryLocalFileReaderWriter::BinaryLocalFileReaderWriter() {checksum=0;}
+
+  BinaryLocalFileReaderWriter::BinaryLocalFileReaderWriter(const std::string& p, std::ios_base::openmode mode) 
+  {
+    checksum = 0;
+    open(p, mode);
+  }
+
+  BinaryLocalFileReaderWriter::~BinaryLocalFileReaderWriter() {close();}
+
+  void BinaryLocalFileReaderWriter::open(const std::string& p, std::ios_base::openmode mode) 
+  {
+    checksum = 0;
+    f.open(p.c_str(), mode | std::ios_base::binary);
+
+    if (! is_open())
+      QDP_error_exit("BinaryLocalFileReaderWriter: error opening file %s on node %d",
+		     p.c_str(), Layout::nodeNumber());
+  }
+
+  void BinaryLocalFileReaderWriter::close()
+  {
+    if (is_open())
+      f.close();
+  }
+
+  void BinaryLocalFileReaderWriter::flush()
+  {
+    if (is_open())
+      f.flush();
+  }
+
+  // Readers: this node reads, there is nothing to broadcast
+  void BinaryLocalReaderWriter::readArrayPrimaryNode(char* input, size_t size, size_t nmemb)
+  {
+    getIOstream().read(input, size*nmemb);
+    internalChecksum() = QDPUtil::crc32_from_big_endian(internalChecksum(), input, input, size, nmemb);
+  }
+
+  void BinaryLocalReaderWriter::readBytesPrimaryNode(char* input, size_t nbytes)
+  {
+    getIOstream().read(input, nbytes);
+    internalChecksum() = QDPUtil::crc32(internalChecksum(), input, nbytes);
+  }
+
+  void BinaryLocalReaderWriter::readArray(char* input, size_t size, size_t nmemb)
+  {
+    readArrayPrimaryNode(input, size, nmemb);
+  }
+
+  void BinaryLocalReaderWriter::readArrayPrimaryNodeLittleEndian(char* input, size_t size, size_t nmemb)
+  {
+    getIOstream().read(input, size*nmemb);
+
+    if (QDPUtil::big_endian())
+      QDPUtil::byte_swap(input, size, nmemb);
+  }
+
+  void BinaryLocalReaderWriter::readArrayLittleEndian(char* input, size_t size, size_t nmemb)
+  {
+    readArrayPrimaryNodeLittleEndian(input, size, nmemb);
+  }
+
+  void BinaryLocalReaderWriter::readDesc(std::string& input)
+  {
+    int n;
+    readArrayPrimaryNode((char*)&n, sizeof(int), 1);
+
+    if (n < 0)
+      QDP_error_exit("BinaryLocalFileReaderWriter: bad string length %d", n);
+
+    input.resize(n);
+    if (n > 0)
+      readArrayPrimaryNode(&input[0], sizeof(char), n);
+  }
+
+  void BinaryLocalReaderWriter::read(std::string& input, size_t maxBytes)
+  {
+    char *str = new(std::nothrow) char[maxBytes];
+    if( str == 0x0 ) { 
+      QDP_error_exit("Couldnt new str in qdp_io.cc\n");
+    }
+
+    getIOstream().getline(str, maxBytes);
+    size_t n = strlen(str);
+    internalChecksum() = QDPUtil::crc32(internalChecksum(), str, n);   // no string terminator
+    internalChecksum() = QDPUtil::crc32(internalChecksum(), "\n", 1);   // account for newline written
+
+    input = str;
+    delete[] str;
+  }
+
+  // Writers: this node writes
+  void BinaryLocalReaderWriter::writeArrayPrimaryNode(const char* output, size_t size, size_t nmemb)
+  {
+    writeBigEndian(getIOstream(), internalChecksum(), output, size, nmemb);
+  }
+
+  void BinaryLocalReaderWriter::writeBytesPrimaryNode(const char* output, size_t nbytes)
+  {
+    internalChecksum() = QDPUtil::crc32(internalChecksum(), output, nbytes);
+    getIOstream().write(output, nbytes);
+  }
+
+  void BinaryLocalReaderWriter::writeArray(const char* output, size_t size, size_t nmemb)
+  {
+    writeArrayPrimaryNode(output, size, nmemb);
+  }
+
+  bool BinaryLocalReaderWriter::fail() {return getIOstream().fail();}
+
+  QDPUtil::n_uint32_t BinaryLocalReaderWriter::getChecksum() {return internalChecksum();}
+
+  BinaryReaderWriter::pos_type BinaryLocalReaderWriter::currentPosition() {return getIOstream().tellg();}
+
+  void BinaryLocalReaderWriter::seek(pos_type pos)
+  {
+    getIOstream().seekg(pos);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalReaderWriter::seekBegin(off_type off)
+  {
+    getIOstream().seekg(off, std::ios_base::beg);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalReaderWriter::seekRelative(off_type off)
+  {
+    getIOstream().seekg(off, std::ios_base::cur);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalReaderWriter::seekEnd(off_type off)
+  {
+    getIOstream().seekg(-off, std::ios_base::end);
+    internalChecksum() = 0;
+  }
+
+  void BinaryLocalReaderWriter::rewind()
+  {
+    getIOstream().seekg(0, std::ios_base::beg);
+    internalChecksum() = 0;
+  }
+
+
 } // namespace QDP
@@ -29,42 +29,54 @@ namespace
   // Float tolerance
   const Double tol = 1.e-5;  /* tolerance for floating point checks */
 
+  //! Read and write the archive payload from every node at once
+  bool archiv_parallel = false;
+
   // Grrh, I do not want to expose the plaquette code.
+  //! The plaquettes and links in one sweep over the lattice and one global sum
   void mesplq(Double& w_plaq, Double& link, const multi1d<LatticeColorMatrix>& u)
   {
-    w_plaq = link = 0.0;
+    multi1d<Double> plaq(Nd*(Nd-1)/2);
+    multi1d<Double> tr(Nd);
+    MultiReduction red(all);
 
     // Compute the average plaquettes
-    for(int mu=1; mu < Nd; ++mu)
+    for(int mu=1, p=0; mu < Nd; ++mu)
     {
-      for(int nu=0; nu < mu; ++nu)
+      for(int nu=0; nu < mu; ++nu, ++p)
       {
-	/* tmp_0 = u(x+mu,nu)*u_dag(x+nu,mu) */
-	LatticeColorMatrix tmp_0 = shift(u[nu],FORWARD,mu) * adj(shift(u[mu],FORWARD,nu));
-
-	/* tmp_1 = tmp_0*u_dag(x,nu)=u(x+mu,nu)*u_dag(x+nu,mu)*u_dag(x,nu) */
-	LatticeColorMatrix tmp_1 = tmp_0 * adj(u[nu]);
-
-	/* tmp = sum(tr(u(x,mu)*tmp_1=u(x,mu)*u(x+mu,nu)*u_dag(x+nu,mu)*u_dag(x,nu))) */
-	Double tmp = sum(real(trace(u[mu]*tmp_1)));
-
-	w_plaq += tmp;
+	/* sum(tr(u(x,mu)*u(x+mu,nu)*u_dag(x+nu,mu)*u_dag(x,nu))) */
+	red.sum(plaq[p], real(trace(u[mu]*(shift(u[nu],FORWARD,mu)*adj(shift(u[mu],FORWARD,nu))*adj(u[nu])))));
       }
     }
-  
-    // NERSC normalization
-    w_plaq *= 2.0 / double(Layout::vol()*Nd*(Nd-1)*Nc);
-  
+
     // Compute the average link
     for(int mu=0; mu < Nd; ++mu)
-      link += sum(real(trace(u[mu])));
+      red.sum(tr[mu], real(trace(u[mu])));
 
+    red.evaluate();
+
+    w_plaq = link = 0.0;
+    for(int p=0; p < plaq.size(); ++p)
+      w_plaq += plaq[p];
+    for(int mu=0; mu < Nd; ++mu)
+      link += tr[mu];
+
+    // NERSC normalization
+    w_plaq *= 2.0 / double(Layout::vol()*Nd*(Nd-1)*Nc);
     link /= double(Layout::vol()*Nd*Nc);
   }
 
 } // end anonymous namespace
 
 
+//! Read and write archive payloads from every node at once
+void setArchivParallel(bool on) {archiv_parallel = on;}
+
+//! Are archive payloads read and written from every node at once
+bool archivParallel() {return archiv_parallel;}
+
+
 
 //! Write a multi1d array
 template<class T>
@@ -497,6 +509,7 @@ void readArchiv(BinaryReader& cfg_in, multi1d<LatticeColorMatrix>& u,
 void readArchiv(ArchivGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::string& file)
 {
   BinaryFileReader cfg_in(file);
+  cfg_in.setParallel(archiv_parallel);
 
   readArchivHeader(cfg_in, header);   // read header
   n_uint32_t checksum;
@@ -697,6 +710,7 @@ void writeArchiv(ArchivGauge_t& header, const multi1d<LatticeColorMatrix>& u, co
   header.checksum = computeChecksum(u, header.mat_size);
 
   BinaryFileWriter cfg_out(file);
+  cfg_out.setParallel(archiv_parallel);
 
   writeArchivHeader(cfg_out, header);   // write header
   writeArchiv(cfg_out, u, header.mat_size);  // continuing writing after header
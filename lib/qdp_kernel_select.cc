@@ -0,0 +1,92 @@
+/*! @file
+ * @brief Report of the kernels chosen for each expression
+ */
+
+#include "qdp.h"
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+namespace QDP
+{
+  namespace KernelReport
+  {
+    namespace
+    {
+      bool report_on = false;
+
+      //! Calls of each kernel and expression
+      std::map<std::pair<std::string,std::string>, unsigned long*> table;
+
+      //! Order of the printout: by kernel, the busiest expression first
+      bool busier(const std::pair<std::pair<std::string,std::string>, unsigned long>& a,
+		  const std::pair<std::pair<std::string,std::string>, unsigned long>& b)
+      {
+	if (a.first.first != b.first.first)
+	  return a.first.first < b.first.first;
+	return a.second > b.second;
+      }
+    }
+
+
+    void setEnabled(bool on) {report_on = on;}
+
+    bool enabled() {return report_on;}
+
+
+    unsigned long* counter(const std::string& kernel, const std::string& expr)
+    {
+      unsigned long*& c = table[std::make_pair(kernel, expr)];
+      if (c == 0)
+	c = new unsigned long(0);
+      return c;
+    }
+
+
+    std::string typeName(const char* name)
+    {
+#if defined(__GNUC__)
+      int status = 0;
+      char* d = abi::__cxa_demangle(name, 0, 0, &status);
+      if (status == 0 && d != 0)
+      {
+	std::string s(d);
+	std::free(d);
+	return s;
+      }
+#endif
+      return name;
+    }
+
+
+    void print()
+    {
+      if (! report_on)
+	return;
+
+      std::vector<std::pair<std::pair<std::string,std::string>, unsigned long> > rows;
+      for(std::map<std::pair<std::string,std::string>, unsigned long*>::const_iterator p=table.begin();
+	  p != table.end(); ++p)
+	rows.push_back(std::make_pair(p->first, *(p->second)));
+
+      std::sort(rows.begin(), rows.end(), busier);
+
+      QDPIO::cout << "Kernels selected on node 0:" << std::endl;
+      for(int i=0; i < rows.size(); ++i)
+      {
+	// An optimised kernel is listed with the file it is in
+	std::string where = rows[i].first.second;
+	if (rows[i].first.first != "generic" && rows[i].first.first != "canonical")
+	  where = where.substr(where.find_last_of('/') + 1);
+
+	QDPIO::cout << "  " << rows[i].first.first << "  calls= " << rows[i].second
+		    << "  " << where << std::endl;
+      }
+    }
+  }
+}
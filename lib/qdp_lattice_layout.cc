@@ -0,0 +1,204 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Secondary lattices with their own geometry
+ */
+
+#include "qdp.h"
+
+namespace QDP
+{
+
+  namespace
+  {
+    //! Every site in one subset
+    class AllFunc : public SetFunc
+    {
+    public:
+      int operator() (const multi1d<int>& coordinate) const {return 0;}
+      int numSubsets() const {return 1;}
+    };
+
+    //! Checkerboards by the parity of the sum of the coordinates
+    class ParityFunc : public SetFunc
+    {
+    public:
+      int operator() (const multi1d<int>& coordinate) const
+	{
+	  int sum = 0;
+	  for(int m=0; m < coordinate.size(); ++m)
+	    sum += coordinate[m];
+
+	  return sum & 1;
+	}
+
+      int numSubsets() const {return 2;}
+    };
+  }
+
+
+  LatticeLayout::LatticeLayout(const multi1d<int>& latt) :
+    latt_size(latt), subgrid(latt.size()), node_grid(latt.size())
+  {
+    const int nd = latt.size();
+    const multi1d<int>& logical = Layout::logicalSize();
+
+    for(int mu=nd; mu < Nd; ++mu)
+      if (logical[mu] != 1)
+	QDP_error_exit("LatticeLayout: the node grid has extent %d in direction %d, which a lattice of %d directions lacks",
+		       logical[mu], mu, nd);
+
+    volume = 1;
+    nsites = 1;
+    for(int mu=0; mu < nd; ++mu)
+    {
+      node_grid[mu] = (mu < Nd) ? logical[mu] : 1;
+      if (latt[mu] <= 0 || latt[mu] % node_grid[mu] != 0)
+	QDP_error_exit("LatticeLayout: extent %d in direction %d is not a multiple of the node grid extent %d",
+		       latt[mu], mu, node_grid[mu]);
+
+      subgrid[mu] = latt[mu] / node_grid[mu];
+      volume *= latt[mu];
+      nsites *= subgrid[mu];
+    }
+
+    makeSet(all_set, AllFunc());
+    makeSet(rb_set, ParityFunc());
+
+    /*
+     * The shift tables. Along a split direction the sites on one edge of
+     * the node take their source from the neighbouring node. Both ends
+     * number the face in increasing site order: the sites of an edge and
+     * of the opposite edge differ only in the coordinate of dir, so they
+     * come in the same order on every node.
+     */
+    const int me = Layout::nodeNumber();
+    shifts.resize(2*nd);
+
+    for(int dir=0; dir < nd; ++dir)
+    {
+      int stride = 1;
+      for(int mu=0; mu < dir; ++mu)
+	stride *= subgrid[mu];
+
+      const int sub = subgrid[dir];
+      const bool split = node_grid[dir] > 1;
+
+      for(int isign=+1; isign >= -1; isign -= 2)
+      {
+	ShiftTable& t = shifts[2*dir + (isign > 0 ? 0 : 1)];
+	t.src.resize(nsites);
+	t.nface = 0;
+
+	const int recv_edge = (isign > 0) ? sub-1 : 0;
+	const int send_edge = (isign > 0) ? 0 : sub-1;
+
+	for(int i=0; i < nsites; ++i)
+	{
+	  const int c = (i / stride) % sub;
+
+	  if (split && c == recv_edge)
+	    t.src[i] = -1 - t.nface++;
+	  else if (c + isign < 0)
+	    t.src[i] = i + (sub-1)*stride;
+	  else if (c + isign >= sub)
+	    t.src[i] = i - (sub-1)*stride;
+	  else
+	    t.src[i] = i + isign*stride;
+
+	  if (split && c == send_edge)
+	    t.send.push_back(i);
+	}
+
+	t.send_node = t.recv_node = me;
+	if (split)
+	{
+	  multi1d<int> nc = Layout::getLogicalCoordFrom(me);
+	  const int here = nc[dir];
+	  nc[dir] = (here + isign + node_grid[dir]) % node_grid[dir];
+	  t.recv_node = Layout::getNodeNumberFrom(nc);
+	  nc[dir] = (here - isign + node_grid[dir]) % node_grid[dir];
+	  t.send_node = Layout::getNodeNumberFrom(nc);
+	}
+      }
+    }
+  }
+
+
+  int LatticeLayout::nodeNumber(const multi1d<int>& coord) const
+  {
+    multi1d<int> nc(Nd);
+    nc = 0;
+    for(int mu=0; mu < numDim() && mu < Nd; ++mu)
+      nc[mu] = coord[mu] / subgrid[mu];
+
+    return Layout::getNodeNumberFrom(nc);
+  }
+
+
+  int LatticeLayout::linearSiteIndex(const multi1d<int>& coord) const
+  {
+    int i = 0;
+    for(int mu=numDim()-1; mu >= 0; --mu)
+      i = i*subgrid[mu] + coord[mu] % subgrid[mu];
+
+    return i;
+  }
+
+
+  multi1d<int> LatticeLayout::siteCoords(int node, int index) const
+  {
+    const multi1d<int> nc = Layout::getLogicalCoordFrom(node);
+    multi1d<int> coord(numDim());
+    for(int mu=0; mu < numDim(); ++mu)
+    {
+      coord[mu] = ((mu < Nd) ? nc[mu] : 0)*subgrid[mu] + index % subgrid[mu];
+      index /= subgrid[mu];
+    }
+
+    return coord;
+  }
+
+
+  void LatticeLayout::makeSet(Set& set, const SetFunc& fn) const
+  {
+    const int nsubset_indices = fn.numSubsets();
+    const int node = Layout::nodeNumber();
+
+    set.lat_color.resize(nsites);
+
+#pragma omp parallel for
+    for(int linear=0; linear < nsites; ++linear)
+    {
+      const int icolor = fn(siteCoords(node, linear));
+      if (icolor < 0 || icolor >= nsubset_indices)
+	QDP_error_exit("LatticeLayout: coloring is outside legal range: color[%d]=%d",linear,icolor);
+
+      set.lat_color[linear] = icolor;
+    }
+
+    // Tiles follow the subgrid of Layout, so the sites go in order
+    set.tiletables.resize(0);
+    set.makeRuns(nsubset_indices);
+  }
+
+
+  const LatticeLayout::ShiftTable& LatticeLayout::shiftTable(int isign, int dir) const
+  {
+    if (dir < 0 || dir >= numDim() || (isign != +1 && isign != -1))
+      QDP_error_exit("LatticeLayout::shift: no shift by %d in direction %d of %d", isign, dir, numDim());
+
+    return shifts[2*dir + (isign > 0 ? 0 : 1)];
+  }
+
+
+  void LatticeLayout::exchange(const ShiftTable& t, const char* send, char* recv, size_t bytes) const
+  {
+    std::vector<size_t> send_bytes(Layout::numNodes(), 0);
+    std::vector<size_t> recv_bytes(Layout::numNodes(), 0);
+    send_bytes[t.send_node] = t.send.size()*bytes;
+    recv_bytes[t.recv_node] = t.nface*bytes;
+
+    QDPInternal::exchangeAll(send, &send_bytes[0], recv, &recv_bytes[0]);
+  }
+
+} // namespace QDP
@@ -10,6 +10,11 @@
 #include "qdp.h"
 #include "qdp_util.h"
 
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
 namespace QDP {
 
 	namespace Layout
@@ -37,6 +42,361 @@ namespace QDP {
 			return physcoord;
 		}
 
+		//! Site ordering selected for the next create()
+		static SiteOrdering site_ordering = ORDER_CONFIGURED;
+
+		void setSiteOrdering(SiteOrdering order) {site_ordering = order;}
+
+		SiteOrdering siteOrdering()
+		{
+			if (site_ordering != ORDER_CONFIGURED)
+				return site_ordering;
+
+#if QDP_USE_LEXICO_LAYOUT == 1
+			return ORDER_LEXICO;
+#elif QDP_USE_CB2_LAYOUT == 1
+			return ORDER_CB2;
+#elif QDP_USE_CB3D_LAYOUT == 1
+			return ORDER_CB3D;
+#elif QDP_USE_CB32_LAYOUT == 1
+			return ORDER_CB32;
+#else
+#error "no appropriate layout defined"
+#endif
+		}
+
+		//! Names of the site orderings, in the order of SiteOrdering
+		static const char* const site_ordering_names[] = {
+			"default", "lexico", "cb2", "cb3d", "cb32", "morton"
+		};
+
+		const char* siteOrderingName(SiteOrdering order)
+		{
+			return site_ordering_names[order];
+		}
+
+		bool siteOrderingFromName(const char* name, SiteOrdering& order)
+		{
+			for(int i=0; i <= ORDER_MORTON; ++i)
+				if (strcmp(name, site_ordering_names[i]) == 0)
+				{
+					order = SiteOrdering(i);
+					return true;
+				}
+
+			return false;
+		}
+
+
+		//! Times of the phases of create, in the order they first ran
+		static std::vector< std::pair<std::string,double> > startup_times;
+
+		void startupPhase(const char* name, double secs)
+		{
+			for(int i=0; i < startup_times.size(); ++i)
+				if (startup_times[i].first == name)
+				{
+					startup_times[i].second += secs;
+					return;
+				}
+			startup_times.push_back(std::make_pair(std::string(name), secs));
+		}
+
+		void printStartupTimes()
+		{
+			QDPIO::cout << "  startup seconds:";
+			for(int i=0; i < startup_times.size(); ++i)
+				QDPIO::cout << " " << startup_times[i].first << "= " << startup_times[i].second;
+			QDPIO::cout << std::endl;
+
+			startup_times.clear();
+		}
+
+
+		//! Whether create picks the logical grid when none was declared
+		static bool geometry_optimizer = true;
+
+		void setGeometryOptimizer(bool on) {geometry_optimizer = on;}
+
+		bool geometryOptimizer() {return geometry_optimizer;}
+
+		int haloSites(const multi1d<int>& latt, const multi1d<int>& grid)
+		{
+			int subvol = 1;
+			for(int mu=0; mu < Nd; ++mu)
+				subvol *= latt[mu] / grid[mu];
+
+			int sites = 0;
+			for(int mu=0; mu < Nd; ++mu)
+				if (grid[mu] > 1)
+					sites += 2 * (subvol / (latt[mu] / grid[mu]));
+
+			return sites;
+		}
+
+		double offHostHaloSites(const multi1d<int>& latt, const multi1d<int>& grid, int per_host)
+		{
+			int nodes = 1;
+			for(int mu=0; mu < Nd; ++mu)
+				nodes *= grid[mu];
+
+			if (per_host <= 1)
+				return haloSites(latt, grid);
+
+			int subvol = 1;
+			for(int mu=0; mu < Nd; ++mu)
+				subvol *= latt[mu] / grid[mu];
+
+			// Rank r sits at the lexicographic coordinate r of the grid, direction 0 fastest
+			double sites = 0;
+			for(int r=0; r < nodes; ++r)
+			{
+				int stride = 1;
+				for(int mu=0; mu < Nd; ++mu)
+				{
+					const int x = (r / stride) % grid[mu];
+					const int face = subvol / (latt[mu] / grid[mu]);
+
+					if (grid[mu] > 1)
+						for(int sign=-1; sign <= 1; sign += 2)
+						{
+							const int n = r + (((x + sign + grid[mu]) % grid[mu]) - x)*stride;
+							if (n / per_host != r / per_host)
+								sites += face;
+						}
+
+					stride *= grid[mu];
+				}
+			}
+
+			return sites / nodes;
+		}
+
+		//! Append to grids every grid[0..d] whose sizes divide latt / min_dim and multiply to nodes
+		static void searchGrids(const multi1d<int>& latt, const multi1d<int>& min_dim,
+			int d, int nodes, multi1d<int>& grid, std::vector< multi1d<int> >& grids)
+		{
+			if (d < 0)
+			{
+				if (nodes == 1)
+					grids.push_back(grid);
+				return;
+			}
+
+			for(int f=nodes; f >= 1; --f)
+			{
+				if (nodes % f != 0 || (latt[d] / min_dim[d]) % f != 0)
+					continue;
+
+				grid[d] = f;
+				searchGrids(latt, min_dim, d-1, nodes / f, grid, grids);
+			}
+		}
+
+		multi1d<int> optimalLogicalSize(const multi1d<int>& latt, const multi1d<int>& min_dim,
+			int nodes, int per_host)
+		{
+			multi1d<int> grid(Nd);
+			std::vector< multi1d<int> > grids;
+			searchGrids(latt, min_dim, Nd-1, nodes, grid, grids);
+
+			if (per_host < 1 || nodes % per_host != 0)
+				per_host = 1;
+
+			int best_halo = -1;
+			for(int i=0; i < grids.size(); ++i)
+			{
+				int halo = haloSites(latt, grids[i]);
+				if (best_halo < 0 || halo < best_halo)
+					best_halo = halo;
+			}
+
+			// Only the grids tied on the total are worth the off host count
+			multi1d<int> best;
+			double best_off = 0;
+			for(int i=0; i < grids.size(); ++i)
+			{
+				if (haloSites(latt, grids[i]) != best_halo)
+					continue;
+
+				double off = (per_host > 1) ? offHostHaloSites(latt, grids[i], per_host) : 0;
+				if (best.size() == 0 || off < best_off)
+				{
+					best = grids[i];
+					best_off = off;
+				}
+			}
+
+			return best;
+		}
+
+
+		//! Site tables of this node
+		/*! 
+		 * site_lexico maps a linear site index to the lexicographic (x fastest)
+		 * site of the subgrid and site_linear is its inverse
+		 */
+		static multi1d<int> site_linear;
+		static multi1d<int> site_lexico;
+
+		//! Tabulate an ordering given by its linearSiteIndex and siteCoords functions
+		/*! Also checks the two functions are inverses on the node */
+		void initSiteTables(int (*index)(const multi1d<int>& coord), 
+			multi1d<int> (*coords)(int node, int linear), int node, 
+			const multi1d<int>& origin)
+		{
+			const multi1d<int>& nrow = subgridLattSize();
+			int subvol = 1;
+			for(int m=0; m < Nd; ++m)
+				subvol *= nrow[m];
+
+			site_linear.resize(subvol);
+			site_lexico.resize(subvol);
+			site_linear = -1;
+
+			// The functions are pure, so the sites can go in parallel.
+			// A site off the node is marked -1 and reported below
+#pragma omp parallel for
+			for(int linear=0; linear < subvol; ++linear)
+			{
+				multi1d<int> coord = coords(node, linear);
+				int site = 0;
+				for(int m=Nd-1; m >= 0 && site >= 0; --m)
+				{
+					int c = coord[m] - origin[m];
+					site = (c < 0 || c >= nrow[m]) ? -1 : site*nrow[m] + c;
+				}
+
+				site_lexico[linear] = (site >= 0 && index(coord) != linear) ? -2 : site;
+			}
+
+			for(int linear=0; linear < subvol; ++linear)
+			{
+				const int site = site_lexico[linear];
+				if (site == -1)
+					QDP_error_exit("Layout::create - the %s layout puts a site off node", 
+						siteOrderingName(siteOrdering()));
+
+				if (site < 0 || site_linear[site] >= 0)
+					QDP_error_exit("Layout::create - the %s layout does not work with this lattice size", 
+						siteOrderingName(siteOrdering()));
+
+				site_linear[site] = linear;
+			}
+		}
+
+		//! Tabulate the Morton ordering for the subgrid
+		/*!
+		 * Sites are split by the parity of their subgrid coordinate. Within
+		 * one parity the coordinate (x/2,y,z,t) is ordered along a Morton
+		 * curve, interleaving the bits of all directions. Dimensions that are
+		 * not a power of two simply leave gaps in the curve. Every 2^Nd block
+		 * of a checkerboard is then contiguous, as is every larger
+		 * power-of-two block, so neighbours in all directions share cache
+		 * lines. subgrid[0] must be even.
+		 */
+		void initMortonTables()
+		{
+			const multi1d<int>& nrow = subgridLattSize();
+			int subvol = 1;
+			for(int m=0; m < Nd; ++m)
+				subvol *= nrow[m];
+
+			if (nrow[0] % 2 != 0)
+				QDP_error_exit("Layout::create - the Morton layout needs an even subgrid size in direction 0");
+
+			int nbits = 0;
+			for(int m=0; m < Nd; ++m)
+				while ((1 << nbits) < nrow[m])
+					++nbits;
+
+			if (nbits*Nd > 63)
+				QDP_error_exit("Layout::create - subgrid too large for the Morton layout");
+
+			// Sort key: parity on top, interleaved cb coordinate bits below
+			std::vector<std::pair<unsigned long long,int> > key(subvol);
+			multi1d<int> coord(Nd);
+			for(int site=0; site < subvol; ++site)
+			{
+				int rem = site, parity = 0;
+				for(int m=0; m < Nd; ++m)
+				{
+					coord[m] = rem % nrow[m];
+					rem /= nrow[m];
+					parity += coord[m];
+				}
+				coord[0] >>= 1;
+
+				unsigned long long k = (unsigned long long)(parity & 1) << 63;
+				for(int b=0; b < nbits; ++b)
+					for(int m=0; m < Nd; ++m)
+						k |= (unsigned long long)((coord[m] >> b) & 1) << (b*Nd + m);
+
+				key[site] = std::make_pair(k, site);
+			}
+			std::sort(key.begin(), key.end());
+
+			site_linear.resize(subvol);
+			site_lexico.resize(subvol);
+			for(int linear=0; linear < subvol; ++linear)
+			{
+				site_lexico[linear] = key[linear].second;
+				site_linear[key[linear].second] = linear;
+			}
+		}
+
+		//! Take the site tables from the table cache, false when it has none
+		bool loadSiteTables()
+		{
+			multi1d<int> linear, lexico;
+			if (! TableCache::load("layout linear", linear) || ! TableCache::load("layout lexico", lexico)
+				|| linear.size() != sitesOnNode() || lexico.size() != sitesOnNode())
+				return false;
+
+			site_linear = linear;
+			site_lexico = lexico;
+			return true;
+		}
+
+		//! Keep the site tables in the table cache
+		void storeSiteTables()
+		{
+			TableCache::store("layout linear", site_linear);
+			TableCache::store("layout lexico", site_lexico);
+		}
+
+		//! Tabulated linear index of a lattice coordinate on this node
+		int tableLinearSiteIndex(const int* coord)
+		{
+			const multi1d<int>& nrow = subgridLattSize();
+			int site = 0;
+			for(int m=Nd-1; m >= 0; --m)
+				site = site*nrow[m] + coord[m] % nrow[m];
+
+			return site_linear[site];
+		}
+
+		//! Subgrid coordinate of a tabulated linear index
+		void tableSubgridCoords(int linear, int* coord)
+		{
+			const multi1d<int>& nrow = subgridLattSize();
+			int rem = site_lexico[linear];
+			for(int m=0; m < Nd; ++m)
+			{
+				coord[m] = rem % nrow[m];
+				rem /= nrow[m];
+			}
+		}
+
+		multi1d<int> tableSubgridCoords(int linear)
+		{
+			multi1d<int> coord(Nd);
+			tableSubgridCoords(linear, &coord[0]);
+
+			return coord;
+		}
+
+
 		extern "C" { 
 
 			/* Export this to "C" */
@@ -93,6 +453,19 @@ namespace QDP {
 
 		return coord;
 	}
+
+	void Layout::lexicoCoord(int ipos, Layout::LatticeCoord& coord)
+	{
+		const multi1d<int>& latt_size = Layout::lattSize();
+
+		for(int i = Nd-1; i < 2*Nd-1; ++i)
+		{
+			int ix = i % Nd;
+
+			coord[ix] = ipos % latt_size[ix];
+			ipos = ipos / latt_size[ix];
+		}
+	}
   
 	//! Calculates the lexicographic site index from the coordinate of a site
 	/*! 
@@ -144,6 +517,17 @@ namespace QDP {
 
 		return coord;
 	}
+
+	void Layout::lexicoCoord(int ipos, Layout::LatticeCoord& coord)
+	{
+		const multi1d<int>& latt_size = Layout::lattSize();
+
+		for(int i=0; i < Nd; ++i)
+		{
+			coord[i] = ipos % latt_size[i];
+			ipos = ipos / latt_size[i];
+		}
+	}
   
 	//! Calculates the lexicographic site index from the coordinate of a site
 	/*! 
@@ -7,6 +7,7 @@
 
 #include "qdp.h"
 #include "qdp_util.h"
+#include <map>
 
 namespace QDP {
 
@@ -14,9 +15,10 @@ namespace QDP {
 ArrayBiDirectionalMap  shift;
 
 //! Function object used for constructing the default nearest neighbor map
+/*! With a distance k it reaches k sites along the direction instead of one */
 struct NearestNeighborMapFunc : public ArrayMapFunc
 {
-  NearestNeighborMapFunc() {}
+  NearestNeighborMapFunc(int k = 1) : dist(k) {}
 
   // Virtual destructor - no cleanup needed
   virtual ~NearestNeighborMapFunc() {} 
@@ -26,24 +28,63 @@ struct NearestNeighborMapFunc : public ArrayMapFunc
       multi1d<int> lc = coord;
 
       const multi1d<int>& nrow = Layout::lattSize();
-      lc[dir] = (coord[dir] + sgnum(sign) + 4*nrow[dir]) % nrow[dir];
+      lc[dir] = ((coord[dir] + sgnum(sign)*dist) % nrow[dir] + nrow[dir]) % nrow[dir];
 
       return lc;
     }
 
+  virtual Layout::LatticeCoord operator() (const Layout::LatticeCoord& coord, int sign, int dir) const
+    {
+      Layout::LatticeCoord lc = coord;
+
+      const multi1d<int>& nrow = Layout::lattSize();
+      lc[dir] = ((coord[dir] + sgnum(sign)*dist) % nrow[dir] + nrow[dir]) % nrow[dir];
+
+      return lc;
+    }
+
+  virtual bool displacement(int dir, Layout::LatticeCoord& disp) const
+    {
+      disp.fill(0);
+      disp[dir] = dist;
+      return true;
+    }
+
   virtual int numArray() const {return Nd;}
 
 private:
   int sgnum(int x) const {return (x > 0) ? 1 : -1;}
+
+  int dist;
 }; 
 
 
+//! The shifts by more than one site, built on first use
+/*! Keyed by (direction, distance, sign > 0) */
+typedef std::map<std::pair<std::pair<int,int>,bool>, Map*> DistanceMaps;
+
+static DistanceMaps& distanceMaps()
+{
+  static DistanceMaps maps;
+  return maps;
+}
+
+
 //! Initializer for maps
 void initDefaultMaps()
 {
+  // Shifts by k sites made on a previous layout are stale
+  DistanceMaps& dm = distanceMaps();
+  for(DistanceMaps::iterator m=dm.begin(); m != dm.end(); ++m)
+    delete m->second;
+  dm.clear();
+
   // Initialize the nearest neighbor map
   NearestNeighborMapFunc bbb;
 
+#if defined(ARCH_PARSCALAR)
+  shift.setCommLabel("shift");
+#endif
   shift.make(bbb);
 }
 
@@ -64,6 +105,16 @@ struct PackageArrayMapFunc : public MapFunc
       return pmap(coord, isign, dir);
     }
 
+  virtual Layout::LatticeCoord operator() (const Layout::LatticeCoord& coord, int isign) const
+    {
+      return pmap(coord, isign, dir);
+    }
+
+  virtual bool displacement(Layout::LatticeCoord& disp) const
+    {
+      return pmap.displacement(dir, disp);
+    }
+
 private:
   const ArrayMapFunc& pmap;
   const int dir;
@@ -104,6 +155,21 @@ struct PackageBiDirectionalMapFunc : public MapFunc
       return pmap(coord, mult*isign);
     }
 
+  virtual Layout::LatticeCoord operator() (const Layout::LatticeCoord& coord, int isign) const
+    {
+      return pmap(coord, mult*isign);
+    }
+
+  virtual bool displacement(Layout::LatticeCoord& disp) const
+    {
+      if (! pmap.displacement(disp))
+	return false;
+
+      for(int i=0; i < Nd; ++i)
+	disp[i] *= mult;
+      return true;
+    }
+
 private:
   const MapFunc& pmap;
   const int mult;
@@ -142,6 +208,21 @@ struct PackageArrayBiDirectionalMapFunc : public MapFunc
       return pmap(coord, mult*isign, dir);
     }
 
+  virtual Layout::LatticeCoord operator() (const Layout::LatticeCoord& coord, int isign) const
+    {
+      return pmap(coord, mult*isign, dir);
+    }
+
+  virtual bool displacement(Layout::LatticeCoord& disp) const
+    {
+      if (! pmap.displacement(dir, disp))
+	return false;
+
+      for(int i=0; i < Nd; ++i)
+	disp[i] *= mult;
+      return true;
+    }
+
 private:
   const ArrayMapFunc& pmap;
   const int mult;
@@ -152,6 +233,11 @@ private:
 //! Initializer for an array of bi-directional maps
 void ArrayBiDirectionalMap::make(const ArrayMapFunc& func)
 {
+#if defined(ARCH_PARSCALAR)
+  // Batched comms are laid out for the previous maps
+  freeBatches();
+#endif
+
   // We are allowed to declare a mapsa, but not allocate one.
   // There is an empty constructor for Map. Hence, the resize will
   // actually allocate the space.
@@ -167,6 +253,38 @@ void ArrayBiDirectionalMap::make(const ArrayMapFunc& func)
     PackageArrayBiDirectionalMapFunc  my_pos_map(func,+1,dir);
     bimapsa(1,dir).make(my_pos_map);
   }
+
+#if defined(ARCH_PARSCALAR)
+  setCommLabel(comm_label);
+#endif
+}
+
+
+//! The map x -> x + isign*k in direction dir, made on first use and kept
+/*!
+ * One map moves the whole k deep face, so shift(x,isign,dir,k) is a
+ * single exchange where k nearest neighbor shifts would be k of them,
+ * each waiting on the last. Sources on this node are looked up directly.
+ */
+Map& distanceMap(int isign, int dir, int k)
+{
+  if (dir < 0 || dir >= Nd || k < 1)
+    QDP_error_exit("shift: direction %d and distance %d", dir, k);
+
+  Map*& m = distanceMaps()[std::make_pair(std::make_pair(dir, k), isign > 0)];
+  if (m == 0)
+  {
+    NearestNeighborMapFunc func(k);
+    PackageArrayBiDirectionalMapFunc my_map(func, (isign > 0) ? +1 : -1, dir);
+
+    m = new Map;
+#if defined(ARCH_PARSCALAR)
+    m->setCommLabel("shift");
+#endif
+    m->make(my_map);
+  }
+
+  return *m;
 }
 
 
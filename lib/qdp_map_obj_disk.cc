@@ -14,11 +14,16 @@ namespace QDP
     // Anonymous namespace
     namespace {
       const std::string file_magic="XXXXQDPLazyDiskMapObjFileXXXX";
+      const std::string manifest_magic="XXXXQDPLazyDiskMapObjManifestXXXX";
+      const std::string index_magic="QDPMOIDX";
     };
 
     // Magic string at start of file.
     std::string getFileMagic() {return file_magic;}
 
+    // Magic string at end of a file with an index.
+    std::string getIndexMagic() {return index_magic;}
+
     // Get meta-data
     std::string getMetaData(const std::string& filename)
     {
@@ -51,20 +56,96 @@ namespace QDP
       bool new_file = false;
 
       if (Layout::primaryNode()) 
-      {
-	struct stat statbuf;
-	if ((mode & std::ios_base::trunc) || (stat(file.c_str(), &statbuf) != 0 && (errno == ENOENT)))
-	{
-	  if (errno == ENOENT)
-	    errno = 0;	/* In case someone looks at errno. */
-	  new_file = true;
-	}
-      }
+	new_file = checkForNewFileLocal(file, mode);
 
       QDPInternal::broadcast(new_file);
 
       return new_file;
     }
+
+
+    // Check for a file on this node
+    bool checkForNewFileLocal(const std::string& file, std::ios_base::openmode mode)
+    {
+      bool new_file = false;
+
+      struct stat statbuf;
+      if ((mode & std::ios_base::trunc) || (stat(file.c_str(), &statbuf) != 0 && (errno == ENOENT)))
+      {
+	if (errno == ENOENT)
+	  errno = 0;	/* In case someone looks at errno. */
+	new_file = true;
+      }
+
+      return new_file;
+    }
+
+
+    // Name of a shard
+    std::string shardFile(const std::string& manifest, int shard)
+    {
+      std::ostringstream s;
+      s << manifest << "." << shard;
+      return s.str();
+    }
+
+
+    // List the shards
+    void writeManifest(const std::string& manifest, int nshards)
+    {
+      // Shards sit next to the manifest, so keep only their base names
+      std::string::size_type slash = manifest.rfind('/');
+      std::string dir = (slash == std::string::npos) ? std::string() : manifest.substr(0, slash+1);
+
+      BinaryFileWriter bin(manifest);
+      bin.writeDesc(manifest_magic);
+      write(bin, nshards);
+      for(int i=0; i < nshards; ++i)
+	bin.writeDesc(shardFile(manifest, i).substr(dir.length()));
+      write(bin, bin.getChecksum());
+      bin.close();
+    }
+
+
+    // Read the list of shards
+    std::vector<std::string> readManifest(const std::string& manifest)
+    {
+      std::string::size_type slash = manifest.rfind('/');
+      std::string dir = (slash == std::string::npos) ? std::string() : manifest.substr(0, slash+1);
+
+      BinaryFileReader bin(manifest);
+
+      std::string read_magic;
+      bin.readDesc(read_magic);
+      if (read_magic != manifest_magic) { 
+	QDPIO::cerr << "Magic String Wrong: Expected: " << manifest_magic << " but read: " << read_magic << std::endl;
+	QDP_abort(1);
+      }
+
+      int nshards;
+      read(bin, nshards);
+
+      std::vector<std::string> files(nshards);
+      for(int i=0; i < nshards; ++i)
+      {
+	bin.readDesc(files[i]);
+	if (files[i].empty() || files[i][0] != '/')
+	  files[i] = dir + files[i];
+      }
+
+      QDPUtil::n_uint32_t calc_checksum = bin.getChecksum();
+      QDPUtil::n_uint32_t read_checksum;
+      read(bin, read_checksum);
+      bin.close();
+
+      if (read_checksum != calc_checksum) { 
+	QDPIO::cerr << "Mismatched Checksums in manifest " << manifest << ": Expected: " << calc_checksum 
+		    << " but read " << read_checksum << std::endl;
+	QDP_abort(1);
+      }
+
+      return files;
+    }
   }
     
 }
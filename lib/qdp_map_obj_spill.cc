@@ -0,0 +1,162 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Memory mapped scratch file behind MapObjectSpill
+ */
+
+#include "qdp.h"
+#include "qdp_map_obj_spill.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace QDP
+{
+
+  namespace
+  {
+    std::string spill_dir;
+
+    //! Default directory of the scratch files
+    std::string defaultSpillDir()
+    {
+      const char* dir = std::getenv("QDP_SPILL_DIR");
+      if (dir == 0 || *dir == '\0')
+	dir = std::getenv("TMPDIR");
+      if (dir == 0 || *dir == '\0')
+	dir = "/tmp";
+      return dir;
+    }
+  }
+
+
+  void SpillFile::setDirectory(const std::string& dir)
+  {
+    spill_dir = dir;
+  }
+
+
+  std::string SpillFile::directory()
+  {
+    return spill_dir.empty() ? defaultSpillDir() : spill_dir;
+  }
+
+
+  SpillFile::SpillFile() : fd(-1), bytes(0), stride(0), nslots(0), stored(0), loaded(0)
+  {
+  }
+
+
+  SpillFile::~SpillFile()
+  {
+    close();
+  }
+
+
+  void SpillFile::open(size_t slot_bytes)
+  {
+    close();
+
+    std::string name = directory() + "/qdp_spill_XXXXXX";
+    std::vector<char> path(name.begin(), name.end());
+    path.push_back('\0');
+
+    fd = mkstemp(&path[0]);
+    if (fd < 0)
+      QDP_error_exit("SpillFile: cannot make a scratch file in %s", directory().c_str());
+
+    // Only the descriptor keeps the file, so it is gone with the job
+    unlink(&path[0]);
+
+    const size_t page = sysconf(_SC_PAGESIZE);
+    bytes = slot_bytes;
+    stride = ((slot_bytes + page - 1) / page) * page;
+    if (stride == 0)
+      stride = page;
+  }
+
+
+  void SpillFile::close()
+  {
+    nslots = 0;
+    free_slots.clear();
+
+    if (fd >= 0)
+      ::close(fd);
+    fd = -1;
+  }
+
+
+  int SpillFile::newSlot()
+  {
+    if (! free_slots.empty())
+    {
+      int slot = free_slots.back();
+      free_slots.pop_back();
+      return slot;
+    }
+
+    int slot = nslots;
+    if (ftruncate(fd, off_t(slot+1) * stride) != 0)
+      QDP_error_exit("SpillFile: cannot grow the scratch file to %lu bytes",
+		     (unsigned long)((slot+1) * stride));
+
+    ++nslots;
+    return slot;
+  }
+
+
+  void SpillFile::freeSlot(int slot)
+  {
+    free_slots.push_back(slot);
+  }
+
+
+  unsigned char* SpillFile::mapSlot(int slot)
+  {
+    void* p = mmap(0, stride, PROT_READ | PROT_WRITE, MAP_SHARED, fd, off_t(slot) * stride);
+    if (p == MAP_FAILED)
+      QDP_error_exit("SpillFile: cannot map slot %d of the scratch file", slot);
+    return (unsigned char*)p;
+  }
+
+
+  void SpillFile::store(int slot, const void* src)
+  {
+    unsigned char* mem = mapSlot(slot);
+    std::memcpy(mem, src, bytes);
+    stored += bytes;
+
+    // Start the write-back and let the pages go from this process; the
+    // kernel frees them once they are on disk
+#if defined(__linux__) && defined(SYNC_FILE_RANGE_WRITE)
+    sync_file_range(fd, off_t(slot) * stride, stride, SYNC_FILE_RANGE_WRITE);
+#else
+    msync(mem, stride, MS_ASYNC);
+#endif
+    munmap(mem, stride);
+  }
+
+
+  void SpillFile::load(int slot, void* dst)
+  {
+    unsigned char* mem = mapSlot(slot);
+    madvise(mem, stride, MADV_SEQUENTIAL);
+    std::memcpy(dst, mem, bytes);
+    loaded += bytes;
+
+    munmap(mem, stride);
+  }
+
+
+  void SpillFile::prefetch(int slot)
+  {
+    if (slot < 0 || slot >= nslots)
+      return;
+
+    posix_fadvise(fd, off_t(slot) * stride, stride, POSIX_FADV_WILLNEED);
+  }
+
+} // namespace QDP
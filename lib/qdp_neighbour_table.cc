@@ -0,0 +1,48 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Neighbour indexing of maps for hand written site loops
+ */
+
+#include "qdp.h"
+#include "qdp_neighbour_table.h"
+
+namespace QDP
+{
+
+  NeighbourTable::NeighbourTable(const Map& m)
+  {
+    make(m);
+  }
+
+  NeighbourTable::NeighbourTable(int isign, int dir)
+  {
+    if (dir < 0 || dir >= Nd || (isign != +1 && isign != -1))
+      QDP_error_exit("NeighbourTable: no shift by %d in direction %d", isign, dir);
+
+    make(shift.getMap(isign, dir));
+  }
+
+  void NeighbourTable::make(const Map& m)
+  {
+    const multi1d<int>& goff = m.goffset();
+    const multi1d<int>& roff = m.roffset();   // empty without a face
+
+    const int n = goff.size();
+    idx.resize(n);
+    face.resize(n);
+
+    dispatch_range(n, [&](int lo, int hi, int myId) {
+	for(int x=lo; x < hi; ++x)
+	{
+	  const bool f = (roff.size() > 0 && roff[x] >= 0);
+	  idx[x] = f ? roff[x] : goff[x];
+	  face[x] = f ? 1 : 0;
+	}
+      });
+
+    nface = 0;
+    for(int x=0; x < n; ++x)
+      nface += face[x];
+  }
+
+} // namespace QDP
@@ -0,0 +1,221 @@
+/*! @file
+ * @brief Faces put straight into the receive buffers of other nodes with MPI-3 one sided communication
+ *
+ * All the nodes share one dynamic window over a duplicate of the
+ * communicator of QMP, locked for passive target access once by init. A
+ * channel attaches its end to it: the receiver its slice of the map's
+ * receive buffer and a flag, the sender a flag. The flags are counters,
+ *
+ *   sent     at the receiver, the sender put face number sent
+ *   posted   at the sender, the receiver may take face number posted
+ *
+ * as the two counters of a NodeShm channel. The face lands in the
+ * buffer the receiver reads it from, so the receiver only posts the
+ * next face when it starts the next exchange on that buffer, not as
+ * soon as it has the face. A send waits for posted, puts the face,
+ * flushes it to the receiver and only then raises sent, so the
+ * receiver seeing the flag sees the face. A send is done on return, as
+ * that of a NodeShm channel. The flags are written and read with MPI
+ * atomics, which drive the progress of the window.
+ */
+
+#include "qdp.h"
+#include "qdp_node_rma.h"
+
+#if defined(QDP_USE_MPI_RMA)
+#include <mpi.h>
+#include <map>
+#include <vector>
+#include <sched.h>
+#endif
+
+namespace QDP
+{
+  namespace NodeRma
+  {
+#if defined(QDP_USE_MPI_RMA)
+
+    namespace
+    {
+      bool use = false;
+
+      MPI_Comm rma_comm = MPI_COMM_NULL;
+      MPI_Win win;
+
+      //! Rank in rma_comm of each node
+      std::vector<int>& ranks()
+      {
+	static std::vector<int> r;
+	return r;
+      }
+
+      //! Channels made so far by each pair of nodes
+      std::map<std::pair<int,int>, int>& pairCount()
+      {
+	static std::map<std::pair<int,int>, int> c;
+	return c;
+      }
+
+      //! The counter at address a of rank r, atomically
+      long readFlag(int r, MPI_Aint a)
+      {
+	long v, none = 0;
+	MPI_Fetch_and_op(&none, &v, MPI_LONG, r, a, MPI_NO_OP, win);
+	MPI_Win_flush(r, win);
+	return v;
+      }
+
+      //! Spin on the counter at address a of rank r until it reaches n
+      void waitFlag(int r, MPI_Aint a, long n)
+      {
+	for(int i=0; readFlag(r, a) < n; ++i)
+	  if (i > 1000)
+	    sched_yield();
+      }
+    }
+
+
+    struct Channel::Flag
+    {
+      alignas(64) long value;
+    };
+
+
+    void init()
+    {
+      if (! use)
+	return;
+
+      // The nodes of this QDP, a group of the job with -ensemble
+      MPI_Comm* comm;
+      QMP_get_hidden_comm(QMP_comm_get_default(), reinterpret_cast<void**>(&comm));
+
+      if (MPI_Comm_dup(*comm, &rma_comm) != MPI_SUCCESS)
+	QDP_error_exit("NodeRma::init: MPI_Comm_dup failed");
+
+      int n;
+      MPI_Comm_size(rma_comm, &n);
+
+      // QMP need not number the nodes as MPI does
+      int node = Layout::nodeNumber();
+      std::vector<int> nodes(n);
+      MPI_Allgather(&node, 1, MPI_INT, &nodes[0], 1, MPI_INT, rma_comm);
+
+      ranks().assign(Layout::numNodes(), -1);
+      for(int r=0; r < n; ++r)
+	ranks()[nodes[r]] = r;
+
+      if (MPI_Win_create_dynamic(MPI_INFO_NULL, rma_comm, &win) != MPI_SUCCESS)
+	QDP_error_exit("NodeRma::init: MPI_Win_create_dynamic failed");
+      MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+      QDPIO::cout << "QDP puts map faces through an MPI window" << std::endl;
+    }
+
+    void finalize()
+    {
+      if (rma_comm == MPI_COMM_NULL)
+	return;
+
+      MPI_Win_unlock_all(win);
+      MPI_Win_free(&win);
+      MPI_Comm_free(&rma_comm);
+      ranks().clear();
+    }
+
+    bool enabled()
+    {
+      return use && ranks().size() > 0;
+    }
+
+    void setEnabled(bool on)
+    {
+      use = on;
+    }
+
+
+    Channel::Channel(int from, int to, void* buf_, size_t bytes_) :
+      buf(buf_), bytes(bytes_), count(0), sender(from == Layout::nodeNumber())
+    {
+      const int other = sender ? to : from;
+      rank = ranks()[other];
+
+      // The tag tells the channels of a pair apart, in the order they were made
+      const int tag = pairCount()[std::make_pair(from, to)]++ % 32768;
+
+      flag = new Flag;
+      flag->value = sender ? 1 : 0;
+      MPI_Win_attach(win, flag, sizeof(Flag));
+
+      MPI_Aint mine[2], theirs[2];
+      MPI_Get_address(flag, &mine[0]);
+      MPI_Get_address(buf, &mine[1]);
+      if (! sender && bytes > 0)
+	MPI_Win_attach(win, buf, bytes);
+
+      MPI_Request req;
+      MPI_Irecv(theirs, 2, MPI_AINT, rank, tag, rma_comm, &req);
+      MPI_Send(mine, 2, MPI_AINT, rank, tag, rma_comm);
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+
+      remote_flag = theirs[0];
+      remote_buf = theirs[1];
+    }
+
+    Channel::~Channel()
+    {
+      if (! sender && bytes > 0)
+	MPI_Win_detach(win, buf);
+      MPI_Win_detach(win, flag);
+      delete flag;
+    }
+
+    void Channel::send()
+    {
+      const long n = ++count;
+      MPI_Aint mine;
+      MPI_Get_address(flag, &mine);
+      waitFlag(ranks()[Layout::nodeNumber()], mine, n);
+
+      if (bytes > 0)
+	MPI_Put(buf, int(bytes), MPI_BYTE, rank, remote_buf, int(bytes), MPI_BYTE, win);
+      MPI_Win_flush(rank, win);
+      MPI_Accumulate(&n, 1, MPI_LONG, rank, remote_flag, 1, MPI_LONG, MPI_REPLACE, win);
+      MPI_Win_flush(rank, win);
+    }
+
+    void Channel::receive()
+    {
+      const long n = ++count;
+      MPI_Aint mine;
+      MPI_Get_address(flag, &mine);
+      waitFlag(ranks()[Layout::nodeNumber()], mine, n);
+    }
+
+    void Channel::post()
+    {
+      const long next = count + 1;
+      MPI_Accumulate(&next, 1, MPI_LONG, rank, remote_flag, 1, MPI_LONG, MPI_REPLACE, win);
+      MPI_Win_flush(rank, win);
+    }
+
+#else
+
+    void init() {}
+    void finalize() {}
+    bool enabled() {return false;}
+    void setEnabled(bool on) {}
+
+    Channel::Channel(int from, int to, void* buf_, size_t bytes_)
+    {
+      QDP_error_exit("NodeRma: not built with --enable-mpi-rma");
+    }
+
+    Channel::~Channel() {}
+    void Channel::send() {}
+    void Channel::receive() {}
+    void Channel::post() {}
+
+#endif
+  }
+}
@@ -0,0 +1,424 @@
+/*! @file
+ * @brief Faces and global sums through shared memory between nodes on one host
+ *
+ * A channel is a POSIX shared memory segment named after the job, the
+ * two nodes and the number of channels the pair made before. It holds
+ * two counters on their own cache lines and then the face:
+ *
+ *   posted   the receiver may take face number posted
+ *   sent     the sender copied in face number sent
+ *
+ * The receiver posts face 1 when it makes the segment and face n+1 as
+ * soon as it copied face n out, so the sender only waits when the
+ * receiver is a whole exchange behind.
+ *
+ * The global sums use an MPI shared window of the host holding a slot
+ * per node and one for the total, each a counter and sumChunk bytes.
+ * The k-th sum of a node raises its counter to k once its slot is
+ * filled, and the first node raises that of the total when it is done.
+ * A node only fills its slot for sum k+1 after it took total k, and
+ * the first node waits for all the slots before it writes the total, so
+ * it never adds a slot or overwrites a total still being read.
+ *
+ * A shared block is another window, all of it with the first node of
+ * the host. Its all-gather is a broadcast between the first nodes per
+ * node of the job, from the first node of the host of that node.
+ */
+
+#include "qdp.h"
+#include "qdp_node_shm.h"
+
+#if defined(QDP_USE_MPI_SHM)
+#include <mpi.h>
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include <new>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace QDP
+{
+  namespace NodeShm
+  {
+#if defined(QDP_USE_MPI_SHM)
+
+    namespace
+    {
+      bool use = true;
+      unsigned job = 0;
+
+      //! Bytes of an array summed at a time
+      const int sumChunk = 4096;
+
+      //! A slot of the window for the sums
+      struct SumSlot
+      {
+	alignas(64) std::atomic<long> seq;
+	alignas(64) char data[sumChunk];
+      };
+
+      MPI_Comm host_comm = MPI_COMM_NULL;
+      MPI_Comm leader_comm = MPI_COMM_NULL;   // the first nodes of the hosts
+      MPI_Win sum_win;
+      SumSlot* slots = 0;                     // the total, then one per node of the host
+      int host_rank = 0;
+      int host_size = 1;
+      long sums = 0;
+
+      //! The rank in leader_comm of the first node of the host of each node
+      std::vector<int> leader_of;
+
+      //! Is each node on this host
+      std::vector<bool>& local()
+      {
+	static std::vector<bool> l;
+	return l;
+      }
+
+      //! Channels made so far by each pair of nodes
+      std::map<std::pair<int,int>, int>& pairCount()
+      {
+	static std::map<std::pair<int,int>, int> c;
+	return c;
+      }
+
+      //! Spin, and let others run when it takes long
+      template<class Ready>
+      void spinUntil(const Ready& ready)
+      {
+	for(int i=0; ! ready(); ++i)
+	  if (i > 1000)
+	    sched_yield();
+      }
+    }
+
+
+    struct Channel::Header
+    {
+      alignas(64) std::atomic<long> posted;
+      alignas(64) std::atomic<long> sent;
+    };
+
+
+    void init()
+    {
+      // The nodes of this QDP, a group of the job with -ensemble
+      MPI_Comm* comm;
+      QMP_get_hidden_comm(QMP_comm_get_default(), reinterpret_cast<void**>(&comm));
+
+      if (MPI_Comm_split_type(*comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &host_comm) != MPI_SUCCESS)
+	QDP_error_exit("NodeShm::init: MPI_Comm_split_type failed");
+
+      MPI_Comm_size(host_comm, &host_size);
+      MPI_Comm_rank(host_comm, &host_rank);
+      const int n = host_size;
+
+      int me = Layout::nodeNumber();
+      std::vector<int> nodes(n);
+      MPI_Allgather(&me, 1, MPI_INT, &nodes[0], 1, MPI_INT, host_comm);
+
+      local().assign(Layout::numNodes(), false);
+      for(int i=0; i < n; ++i)
+	local()[nodes[i]] = true;
+
+      MPI_Comm_split(*comm, (host_rank == 0) ? 0 : MPI_UNDEFINED, me, &leader_comm);
+
+      int leader = 0;
+      if (leader_comm != MPI_COMM_NULL)
+	MPI_Comm_rank(leader_comm, &leader);
+      MPI_Bcast(&leader, 1, MPI_INT, 0, host_comm);
+
+      std::vector<int> pairs(2*Layout::numNodes());
+      int mine[2] = {me, leader};
+      MPI_Allgather(mine, 2, MPI_INT, &pairs[0], 2, MPI_INT, *comm);
+      leader_of.assign(Layout::numNodes(), 0);
+      for(int i=0; i < Layout::numNodes(); ++i)
+	leader_of[pairs[2*i]] = pairs[2*i+1];
+
+      // The first node of the host holds the window, the others map it
+      MPI_Aint size = (host_rank == 0) ? (n+1)*sizeof(SumSlot) : 0;
+      void* base;
+      if (MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, host_comm, &base, &sum_win) != MPI_SUCCESS)
+	QDP_error_exit("NodeShm::init: MPI_Win_allocate_shared failed");
+
+      int disp;
+      MPI_Win_shared_query(sum_win, 0, &size, &disp, &base);
+      slots = (SumSlot*)base;
+      if (host_rank == 0)
+	for(int i=0; i <= n; ++i)
+	  new(&slots[i].seq) std::atomic<long>(0);
+      MPI_Barrier(host_comm);
+
+      // Segments of different jobs, or members of an ensemble, on a host must not meet
+      job = getpid();
+      MPI_Bcast(&job, 1, MPI_UNSIGNED, 0, *comm);
+
+      if (n > 1)
+	QDPIO::cout << "QDP shares faces through memory between the " << n
+		    << " nodes of a host" << std::endl;
+    }
+
+    void finalize()
+    {
+      if (host_comm == MPI_COMM_NULL)
+	return;
+
+      MPI_Win_free(&sum_win);
+      if (leader_comm != MPI_COMM_NULL)
+	MPI_Comm_free(&leader_comm);
+      MPI_Comm_free(&host_comm);
+      local().clear();
+      leader_of.clear();
+    }
+
+    bool enabled()
+    {
+      return use && local().size() > 0;
+    }
+
+    void setEnabled(bool on)
+    {
+      use = on;
+    }
+
+    bool onNode(int node)
+    {
+      return node != Layout::nodeNumber() && node < local().size() && local()[node];
+    }
+
+
+    namespace
+    {
+      //! The hierarchical sum of x[0..n) with MPI type t
+      template<class T>
+      bool hostSum(T* x, int n, MPI_Datatype t)
+      {
+	// One node per host gains nothing over the plain sum
+	if (! enabled() || host_size == 1)
+	  return false;
+
+	const int chunk = sumChunk / sizeof(T);
+	for(int lo=0; lo < n; lo += chunk)
+	{
+	  const int m = std::min(chunk, n - lo);
+	  const long k = ++sums;
+	  T* total = (T*)slots[0].data;
+
+	  if (host_rank == 0)
+	  {
+	    // Once every slot is filled nobody reads the last total any more
+	    for(int r=1; r < host_size; ++r)
+	    {
+	      SumSlot& s = slots[1+r];
+	      spinUntil([&]() {return s.seq.load(std::memory_order_acquire) >= k;});
+	    }
+
+	    // The nodes of the host in order, so every run adds the same way
+	    memcpy(total, x + lo, m*sizeof(T));
+	    for(int r=1; r < host_size; ++r)
+	    {
+	      const T* y = (const T*)slots[1+r].data;
+	      for(int j=0; j < m; ++j)
+		total[j] += y[j];
+	    }
+
+	    if (leader_comm != MPI_COMM_NULL)
+	      MPI_Allreduce(MPI_IN_PLACE, total, m, t, MPI_SUM, leader_comm);
+
+	    slots[0].seq.store(k, std::memory_order_release);
+	  }
+	  else
+	  {
+	    SumSlot& s = slots[1+host_rank];
+	    memcpy(s.data, x + lo, m*sizeof(T));
+	    s.seq.store(k, std::memory_order_release);
+
+	    spinUntil([&]() {return slots[0].seq.load(std::memory_order_acquire) >= k;});
+	  }
+
+	  memcpy(x + lo, total, m*sizeof(T));
+	}
+
+	return true;
+      }
+    }
+
+    bool globalSum(int* x, int n)    {return hostSum(x, n, MPI_INT);}
+    bool globalSum(float* x, int n)  {return hostSum(x, n, MPI_FLOAT);}
+    bool globalSum(double* x, int n) {return hostSum(x, n, MPI_DOUBLE);}
+
+
+    Channel::Channel(int from, int to, void* buf_, size_t bytes_) :
+      buf(buf_), bytes(bytes_), count(0), sender(from == Layout::nodeNumber())
+    {
+      char name[64];
+      snprintf(name, sizeof(name), "/qdp.%u.%d.%d.%d", job, from, to, pairCount()[std::make_pair(from, to)]++);
+
+      mapped = sizeof(Header) + bytes;
+
+      int fd;
+      if (sender)
+      {
+	// The receiver makes the segment at the same point of the program
+	spinUntil([&]() {fd = shm_open(name, O_RDWR, 0600); return fd >= 0 || errno != ENOENT;});
+	if (fd < 0)
+	  QDP_error_exit("NodeShm: cannot open %s: %s", name, strerror(errno));
+
+	// and may not have sized it yet
+	struct stat st;
+	spinUntil([&]() {return fstat(fd, &st) == 0 && size_t(st.st_size) >= mapped;});
+
+	// Nobody else opens it, it stays until both ends unmap it
+	shm_unlink(name);
+      }
+      else
+      {
+	fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (fd < 0 || ftruncate(fd, mapped) != 0)
+	  QDP_error_exit("NodeShm: cannot make %s: %s", name, strerror(errno));
+      }
+
+      void* seg = mmap(0, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      close(fd);
+      if (seg == MAP_FAILED)
+	QDP_error_exit("NodeShm: cannot map %s: %s", name, strerror(errno));
+
+      head = (Header*)seg;
+      data = (char*)seg + sizeof(Header);
+
+      if (! sender)
+	head->posted.store(1, std::memory_order_release);
+    }
+
+    Channel::~Channel()
+    {
+      munmap(head, mapped);
+    }
+
+    void Channel::send()
+    {
+      const long n = ++count;
+      spinUntil([&]() {return head->posted.load(std::memory_order_acquire) >= n;});
+
+      memcpy(data, buf, bytes);
+      head->sent.store(n, std::memory_order_release);
+    }
+
+    void Channel::receive()
+    {
+      const long n = ++count;
+      spinUntil([&]() {return head->sent.load(std::memory_order_acquire) >= n;});
+
+      memcpy(buf, data, bytes);
+      head->posted.store(n+1, std::memory_order_release);
+    }
+
+
+    struct SharedBlock::Window
+    {
+      MPI_Win win;
+    };
+
+    SharedBlock::SharedBlock(size_t bytes_) : win(0), base(0), bytes(bytes_)
+    {
+      if (! enabled())
+	return;
+
+      win = new Window;
+      MPI_Aint size = (host_rank == 0) ? std::max(bytes, size_t(1)) : 0;
+      void* p;
+      if (MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, host_comm, &p, &win->win) != MPI_SUCCESS)
+	QDP_error_exit("NodeShm::SharedBlock: MPI_Win_allocate_shared of %lu bytes failed", (unsigned long)bytes);
+
+      int disp;
+      MPI_Win_shared_query(win->win, 0, &size, &disp, &p);
+      base = (char*)p;
+    }
+
+    SharedBlock::~SharedBlock()
+    {
+      if (! win)
+	return;
+
+      MPI_Barrier(host_comm);
+      MPI_Win_free(&win->win);
+      delete win;
+    }
+
+    void SharedBlock::allGather(size_t offset, size_t block)
+    {
+      if (! base)
+	QDP_error_exit("NodeShm::SharedBlock: allGather without a block");
+
+      // Every node of the host wrote its block
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      MPI_Barrier(host_comm);
+
+      if (leader_comm != MPI_COMM_NULL)
+      {
+	int nhosts;
+	MPI_Comm_size(leader_comm, &nhosts);
+
+	// Runs of nodes on one host go in one broadcast, in pieces of at most 1 GB
+	const int nodes = Layout::numNodes();
+	const size_t piece = size_t(1) << 30;
+	for(int lo=0; lo < nodes && nhosts > 1; )
+	{
+	  int hi = lo + 1;
+	  while (hi < nodes && leader_of[hi] == leader_of[lo])
+	    ++hi;
+
+	  char* p = base + offset + size_t(lo)*block;
+	  const size_t n = size_t(hi - lo)*block;
+	  for(size_t done=0; done < n; done += piece)
+	    MPI_Bcast(p + done, int(std::min(piece, n - done)), MPI_BYTE, leader_of[lo], leader_comm);
+
+	  lo = hi;
+	}
+      }
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      MPI_Barrier(host_comm);
+    }
+
+#else
+
+    void init() {}
+    void finalize() {}
+    bool enabled() {return false;}
+    void setEnabled(bool on) {}
+    bool onNode(int node) {return false;}
+
+    bool globalSum(int* x, int n)    {return false;}
+    bool globalSum(float* x, int n)  {return false;}
+    bool globalSum(double* x, int n) {return false;}
+
+    Channel::Channel(int from, int to, void* buf_, size_t bytes_)
+    {
+      QDP_error_exit("NodeShm: not built with --enable-mpi-shm");
+    }
+
+    Channel::~Channel() {}
+    void Channel::send() {}
+    void Channel::receive() {}
+
+    SharedBlock::SharedBlock(size_t bytes_) : win(0), base(0), bytes(bytes_) {}
+    SharedBlock::~SharedBlock() {}
+
+    void SharedBlock::allGather(size_t offset, size_t block)
+    {
+      QDP_error_exit("NodeShm: not built with --enable-mpi-shm");
+    }
+
+#endif
+  }
+}
@@ -0,0 +1,200 @@
+/*! @file
+ * @brief Fast formatting and parsing of numbers for text and XML IO
+ */
+
+#include "qdp.h"
+#include <cerrno>
+#include <cfloat>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+// Floating point to_chars and from_chars came later than the integer ones
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define QDP_HAVE_FP_CHARCONV 1
+#endif
+
+namespace QDP
+{
+  namespace NumFormat
+  {
+    namespace
+    {
+      //! Shortest %g form that reads back, trying digits from lo to hi
+      /*! Any text of fewer than lo digits that reads back is what %.{lo}g gives */
+      template<typename T>
+      int shortestG(char* buf, T x, int lo, int hi)
+      {
+	char b[maxChars+8];
+	int n = 0;
+	for(int p=lo; p <= hi; ++p)
+	{
+	  n = std::snprintf(b, sizeof(b), "%.*g", p, double(x));
+	  if (p == hi || T(std::strtod(b, 0)) == x)
+	    break;
+	}
+	for(int i=0; i < n; ++i)
+	  buf[i] = b[i];
+	return n;
+      }
+
+      bool isSpace(char c) {return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';}
+
+      //! Parse one token at p, true when it is all of one number
+      bool parseOne(const char* p, const char* e, const char*& q, double& x)
+      {
+#if defined(QDP_HAVE_FP_CHARCONV)
+	if (*p == '+')
+	  ++p;
+	std::from_chars_result r = std::from_chars(p, e, x);
+	q = r.ptr;
+	return r.ec == std::errc();
+#else
+	char* t;
+	errno = 0;
+	x = std::strtod(p, &t);
+	q = t;
+	return q != p && errno != ERANGE;
+#endif
+      }
+
+      bool parseOne(const char* p, const char* e, const char*& q, float& x)
+      {
+#if defined(QDP_HAVE_FP_CHARCONV)
+	if (*p == '+')
+	  ++p;
+	std::from_chars_result r = std::from_chars(p, e, x);
+	q = r.ptr;
+	return r.ec == std::errc();
+#else
+	char* t;
+	errno = 0;
+	x = std::strtof(p, &t);
+	q = t;
+	return q != p && errno != ERANGE;
+#endif
+      }
+
+      bool parseOne(const char* p, const char*, const char*& q, long int& x)
+      {
+	char* t;
+	errno = 0;
+	x = std::strtol(p, &t, 10);
+	q = t;
+	return q != p && errno != ERANGE;
+      }
+
+      bool parseOne(const char* p, const char*, const char*& q, unsigned long int& x)
+      {
+	// strtoul takes a minus sign and wraps, istream does too
+	char* t;
+	errno = 0;
+	x = std::strtoul(p, &t, 10);
+	q = t;
+	return q != p && errno != ERANGE;
+      }
+
+      //! Narrower integers go through long and are range checked
+      template<typename T, typename W>
+      bool parseNarrow(const char* p, const char* e, const char*& q, T& x)
+      {
+	W w;
+	if (! parseOne(p, e, q, w))
+	  return false;
+	x = T(w);
+	return W(x) == w;
+      }
+
+      bool parseOne(const char* p, const char* e, const char*& q, int& x) {return parseNarrow<int,long>(p, e, q, x);}
+      bool parseOne(const char* p, const char* e, const char*& q, short int& x) {return parseNarrow<short,long>(p, e, q, x);}
+      bool parseOne(const char* p, const char* e, const char*& q, unsigned int& x) {return parseNarrow<unsigned int,unsigned long>(p, e, q, x);}
+      bool parseOne(const char* p, const char* e, const char*& q, unsigned short int& x) {return parseNarrow<unsigned short,unsigned long>(p, e, q, x);}
+
+      template<typename T>
+      bool parseTokens(const std::string& s, std::vector<T>& out)
+      {
+	out.clear();
+	const char* p = s.c_str();
+	const char* e = p + s.size();
+	for(;;)
+	{
+	  while (p < e && isSpace(*p))
+	    ++p;
+	  if (p == e)
+	    return true;
+
+	  // A token must be one number and nothing else
+	  T x;
+	  const char* q;
+	  if (! parseOne(p, e, q, x) || (q < e && ! isSpace(*q)))
+	    return false;
+	  out.push_back(x);
+	  p = q;
+	}
+      }
+    }
+
+
+    int shortest(char* buf, float x)
+    {
+#if defined(QDP_HAVE_FP_CHARCONV)
+      return std::to_chars(buf, buf+maxChars, x).ptr - buf;
+#else
+      return shortestG(buf, x, FLT_DIG, FLT_DIG+3);
+#endif
+    }
+
+    int shortest(char* buf, double x)
+    {
+#if defined(QDP_HAVE_FP_CHARCONV)
+      return std::to_chars(buf, buf+maxChars, x).ptr - buf;
+#else
+      return shortestG(buf, x, DBL_DIG, DBL_DIG+2);
+#endif
+    }
+
+    int integer(char* buf, long int x)
+    {
+      const bool neg = x < 0;
+      unsigned long u = neg ? 0UL - (unsigned long)(x) : (unsigned long)(x);
+      int n = integer(buf + (neg ? 1 : 0), u);
+      if (neg)
+      {
+	buf[0] = '-';
+	++n;
+      }
+      return n;
+    }
+
+    int integer(char* buf, unsigned long int x)
+    {
+      char b[maxChars];
+      int n = 0;
+      do
+      {
+	b[n++] = char('0' + x % 10);
+	x /= 10;
+      } while (x);
+
+      for(int i=0; i < n; ++i)
+	buf[i] = b[n-1-i];
+      return n;
+    }
+
+
+    bool parseList(const std::string& s, std::vector<float>& out) {return parseTokens(s, out);}
+    bool parseList(const std::string& s, std::vector<double>& out) {return parseTokens(s, out);}
+    bool parseList(const std::string& s, std::vector<int>& out) {return parseTokens(s, out);}
+    bool parseList(const std::string& s, std::vector<unsigned int>& out) {return parseTokens(s, out);}
+    bool parseList(const std::string& s, std::vector<short int>& out) {return parseTokens(s, out);}
+    bool parseList(const std::string& s, std::vector<unsigned short int>& out) {return parseTokens(s, out);}
+    bool parseList(const std::string& s, std::vector<long int>& out) {return parseTokens(s, out);}
+    bool parseList(const std::string& s, std::vector<unsigned long int>& out) {return parseTokens(s, out);}
+  }
+}
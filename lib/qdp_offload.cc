@@ -0,0 +1,85 @@
+/*! @file
+ * @brief Device offload switches
+ */
+
+#include "qdp.h"
+
+#if defined(QDP_USE_OMP_OFFLOAD)
+#include <omp.h>
+#endif
+
+namespace QDP
+{
+  namespace Offload
+  {
+    namespace
+    {
+      bool offload_on = false;
+      int min_sites = 4096;
+#if defined(QDP_GPU_AWARE_COMMS)
+      CommsPath comms_path = COMMS_DEVICE;
+#else
+      CommsPath comms_path = COMMS_STAGED;
+#endif
+    }
+
+    bool available()
+    {
+#if defined(QDP_USE_OMP_OFFLOAD)
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    void setEnabled(bool on)
+    {
+      if (on && ! available())
+      {
+	QDPIO::cerr << "Offload: this library was built without --enable-omp-offload, staying on the host" << std::endl;
+	return;
+      }
+      offload_on = on;
+    }
+
+    bool enabled() {return offload_on;}
+
+    void setMinSites(int n) {min_sites = n;}
+
+    int minSites() {return min_sites;}
+
+    void setCommsPath(CommsPath p) {comms_path = p;}
+
+    CommsPath commsPath() {return comms_path;}
+
+
+    void* deviceAlloc(size_t n)
+    {
+#if defined(QDP_USE_OMP_OFFLOAD)
+      void* p = omp_target_alloc(n, omp_get_default_device());
+      if (p == 0 && n > 0)
+	QDP_error_exit("Offload: unable to allocate %lu bytes on the device\n", (unsigned long)n);
+      return p;
+#else
+      QDP_error_exit("Offload: deviceAlloc needs a library built with --enable-omp-offload\n");
+      return 0;
+#endif
+    }
+
+    void deviceFree(void* p)
+    {
+#if defined(QDP_USE_OMP_OFFLOAD)
+      if (p)
+	omp_target_free(p, omp_get_default_device());
+#endif
+    }
+
+    void copyToHost(void* h, const void* d, size_t n)
+    {
+#if defined(QDP_USE_OMP_OFFLOAD)
+      if (n > 0 && omp_target_memcpy(h, d, n, 0, 0, omp_get_initial_device(), omp_get_default_device()) != 0)
+	QDP_error_exit("Offload: copy of %lu bytes from the device failed\n", (unsigned long)n);
+#endif
+    }
+  }
+}
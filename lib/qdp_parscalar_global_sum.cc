@@ -1,47 +1,100 @@
 #include "qdp.h"
 #include <string.h>
+#include <vector>
+
+#if defined(QDP_USE_MPI_IALLREDUCE)
+#include <mpi.h>
+#endif
 
 namespace QDPGlobalSums {
 
+  namespace {
+    //! Rank of the node at coordinate c in direction dim, the other coordinates as mine
+    int nodeAt(int dim, int c)
+    {
+      const int ndim = QMP_get_logical_number_of_dimensions();
+      const int* mine = QMP_get_logical_coordinates();
+      std::vector<int> coord(mine, mine + ndim);
+      coord[dim] = c;
+      return QMP_get_node_number_from(&coord[0]);
+    }
+
+    //! Send send to node to while receiving recv from node from, -1 for neither
+    QMP_status_t exchange(QMP_msgmem_t send, int to, QMP_msgmem_t recv, int from)
+    {
+      QMP_msghandle_t send_handle = 0, recv_handle = 0;
+      QMP_status_t status = QMP_SUCCESS;
+
+      if (from >= 0) {
+	recv_handle = QMP_declare_receive_from(recv, from, 0);
+	status = recv_handle ? QMP_start(recv_handle) : QMP_ERROR;
+      }
+
+      if (to >= 0 && status == QMP_SUCCESS) {
+	send_handle = QMP_declare_send_to(send, to, 0);
+	status = send_handle ? QMP_start(send_handle) : QMP_ERROR;
+      }
+
+      if (send_handle) {
+	if (status == QMP_SUCCESS)
+	  status = QMP_wait(send_handle);
+	QMP_free_msghandle(send_handle);
+      }
+
+      if (recv_handle) {
+	if (status == QMP_SUCCESS)
+	  status = QMP_wait(recv_handle);
+	QMP_free_msghandle(recv_handle);
+      }
+
+      return status;
+    }
+  }
+
+
   // Given an array x of length elements
   // This routine will compute:
   //        y[i] = sum x[i]  for each individual i
-  // ie the return value will also be an array of length element.
+  // over the P nodes along dimension dim, ie the return value will also
+  // be an array of length element.
   //
-  // Implementation note: I create a table all_data[nproc][length]
-  // I do all my message passing first, then I sum.
-  // 
-  // Consider when no_of_procs in dim=3, length=1
+  // Implementation note: the sum is a binary tree of fixed shape over
+  // the coordinate c of the nodes, done by recursive doubling in
+  // log2(P) + 2 exchanges instead of P-1 around a ring.
   //
-  // after the two communications the procs will have teh following all
-  // data 
+  // With Q the largest power of two <= P
+  //  1) node c >= Q sends its data to c-Q, which adds it to its own
+  //  2) for k = 1, 2, 4, .. < Q nodes c and c^k swap their partial sums
+  //     and both add them, the one of the lower node first
+  //  3) node c-Q hands the total back to node c >= Q
   //
-  // proc0             proc1          proc2
-  //  proc0_data       proc1_data     proc2_data
-  //  proc2_data       proc0_data     proc1_data
-  //  proc1_data       proc2_data     proc0_data
+  // Consider P=6, Q=4, with di the data of node i:
   //
-  // where proci_data is the data originating from processor i.
-  // (receives are always done from the minus direction, sends to plus)
-  // 
-  // I then sum on each processor, starting the sum from element i,
-  // where i is the index of the processor 
-  // so on proc0 I start the sum from all_data element 0
-  //    on proc1                 from all_data element 1 (proc0_data)
-  //    on proc2                 from all_data element 2 (proc0_data)
-  // as the summation index becomes too big, I wrap it around.
+  //  after 1)   d0+d4   d1+d5   d2   d3
+  //  after k=1  (d0+d4)+(d1+d5)        d2+d3
+  //  after k=2  ((d0+d4)+(d1+d5)) + (d2+d3)   on nodes 0..3, then 4,5
   //
-  // This way, all the processors carry out their sums in exactly the
-  // same order, which should yield binary exactness
+  // Partners add the same two operands in the same order, so at every
+  // step the nodes of a block hold the same bits, and the shape of the
+  // tree only depends on P. This way the result is binary exact across
+  // the nodes and from run to run.
 
   template<typename T>
   QMP_status_t sumTDirection(T* x, int length, int dim)
   {
+    const int procs_in_dimension = QMP_get_logical_dimensions()[dim];
+    if (procs_in_dimension == 1 || length == 0)
+      return QMP_SUCCESS;
+
+    const int c = QMP_get_logical_coordinates()[dim];
+    int Q = 1;
+    while (2*Q <= procs_in_dimension)
+      Q *= 2;
+
     int blocksize = sizeof(T)*length;
     if (blocksize % 8 != 0) { 
 	blocksize += (8 - blocksize%8);
     }
-    // Allocate space for message to send
     // Communicate all the data at once (ie sizeof(T)*length bytes)
     QMP_mem_t* send_mem = QMP_allocate_aligned_memory(blocksize,
 						      8, 
@@ -55,104 +108,61 @@ namespace QDPGlobalSums {
 						      (QMP_MEM_COMMS|QMP_MEM_FAST));
 
     if( recv_mem == 0x0 ) { 
+      QMP_free_memory(send_mem);
       return QMP_NOMEM_ERR;
     }
 
-    // In addition I need to send to PLUS dir and receive from 
-    // Minus dir
-    void *sendmem_pointer = QMP_get_memory_pointer(send_mem);
-    void *recvmem_pointer = QMP_get_memory_pointer(recv_mem);
+    T *send_buf = (T *)QMP_get_memory_pointer(send_mem);
+    T *recv_buf = (T *)QMP_get_memory_pointer(recv_mem);
 
     // (I leave the trailers full of junk)
-    // memset(sendmem_pointer, 0x0, blocksize);
-    // memset(recvmem_pointer, 0x0, blocksize);
-
-    QMP_msgmem_t send_msgmem = QMP_declare_msgmem( sendmem_pointer, 
-						    blocksize) ;
-
-    QMP_msgmem_t recv_msgmem = QMP_declare_msgmem( recvmem_pointer, 
-						     blocksize) ;
-    // Send to + dir
-    QMP_msghandle_t send_handle = QMP_declare_send_relative(send_msgmem, dim, +1, 0);
-
-    // Recv from -dir
-    QMP_msghandle_t recv_handle = QMP_declare_receive_relative(recv_msgmem, dim, -1, 0);
-
-    // Get the number of CPU-s in this direction
-    // Do I need to free these?
-    const int* logical_dimensions = QMP_get_logical_dimensions();
-    const int* logical_coordinates = QMP_get_logical_coordinates();
-    
-    int procs_in_dimension = logical_dimensions[dim];
+    QMP_msgmem_t send_msgmem = QMP_declare_msgmem(send_buf, blocksize);
+    QMP_msgmem_t recv_msgmem = QMP_declare_msgmem(recv_buf, blocksize);
 
-    multi2d<T> all_data(length, procs_in_dimension);
-    
+    const size_t bytes = sizeof(T)*length;
+    QMP_status_t status = QMP_SUCCESS;
 
-    // Copy my data to send buffer to stat with
-    memcpy(sendmem_pointer, x, sizeof(T)*length);
-
-    // Copy my data to all_data 
-    for(int j=0; j < length; j++) { 
-      all_data(j,0) = x[j];
+    // 1) Fold the nodes beyond Q onto the first ones
+    if (c >= Q) {
+      memcpy(send_buf, x, bytes);
+      status = exchange(send_msgmem, nodeAt(dim, c-Q), recv_msgmem, -1);
+    }
+    else if (c+Q < procs_in_dimension) {
+      status = exchange(send_msgmem, -1, recv_msgmem, nodeAt(dim, c+Q));
+      for(int j=0; j < length; j++)
+	x[j] = x[j] + recv_buf[j];
     }
 
-    for(int i=0; i < procs_in_dimension-1; i++) { 
-      QMP_status_t status;
-
-      // Start receiving from -dir
-      status  = QMP_start(recv_handle);
-      if( status != QMP_SUCCESS ) { 
-	return status;
-      }
-
-      // Start sending to +dir
-      status = QMP_start(send_handle);
-      if( status != QMP_SUCCESS ) { 
-	return status;
-      }
-
-      // Finish the send
-      status = QMP_wait(send_handle);
-      if( status != QMP_SUCCESS ) { 
-	return status;
-      }
-
-      status = QMP_wait(recv_handle);
-      if( status != QMP_SUCCESS ) { 
-	return status;
-      }
-
-      // Copy what I have received so I can send it on
-      memcpy(sendmem_pointer, recvmem_pointer, sizeof(T)*length);
+    // 2) Recursive doubling among the first Q nodes
+    for(int k=1; k < Q && c < Q && status == QMP_SUCCESS; k *= 2) {
+      const int partner = c ^ k;
+      const int node = nodeAt(dim, partner);
+      memcpy(send_buf, x, bytes);
+      status = exchange(send_msgmem, node, recv_msgmem, node);
 
-      for(int j=0; j < length; j++) { 
-	all_data(j,i+1) = ((T *)recvmem_pointer)[j];
-      }
+      for(int j=0; j < length; j++)
+	x[j] = (c < partner) ? x[j] + recv_buf[j] : recv_buf[j] + x[j];
     }
 
-
-    for(int j=0; j < length; j++) { 
-    // The index of the data received from 0 in this dimension
-      int my_index = logical_coordinates[dim];
-      x[j] = all_data(j, my_index);
-      for(int i=0; i < procs_in_dimension-1; i++) {
-	// Increment pointer with wraparound
-	my_index = (my_index + 1) % procs_in_dimension;
-	x[j] += all_data(j, my_index);
+    // 3) Hand the total back to the folded nodes
+    if (status == QMP_SUCCESS) {
+      if (c >= Q) {
+	status = exchange(send_msgmem, -1, recv_msgmem, nodeAt(dim, c-Q));
+	memcpy(x, recv_buf, bytes);
+      }
+      else if (c+Q < procs_in_dimension) {
+	memcpy(send_buf, x, bytes);
+	status = exchange(send_msgmem, nodeAt(dim, c+Q), recv_msgmem, -1);
       }
     }
 
     // Free up the comms
-    QMP_free_msghandle(recv_handle);
-    QMP_free_msghandle(send_handle);
     QMP_free_msgmem(recv_msgmem);
     QMP_free_msgmem(send_msgmem);
 
     QMP_free_memory(recv_mem);
     QMP_free_memory(send_mem);
-    // free(logical_dimensions);
-    // free(logical_coordinates);
-    return QMP_SUCCESS;
+    return status;
   }
 
   // Global sum: call sumTDirection in all available directions
@@ -172,6 +182,43 @@ namespace QDPGlobalSums {
     return QMP_SUCCESS;
   }
 
+  // Sums of slices: the nodes at coordinate c in direction dir hold the
+  // slices c*per .. (c+1)*per-1. Those are summed along every other
+  // direction, after which each node has the totals of its own slices,
+  // and then along dir, where every node brings in its own and zeros
+  template<typename T>
+  QMP_status_t sumSlices(T* x, int words, int nslice, int dir)
+  {
+    const int ndim = QMP_get_logical_number_of_dimensions();
+    const int procs = QMP_get_logical_dimensions()[dir];
+    const int per = nslice / procs;
+    const int c = QMP_get_logical_coordinates()[dir];
+
+    T* mine = x + size_t(c)*per*words;
+    for(int dim=0; dim < ndim; dim++) {
+      if (dim == dir)
+	continue;
+      QMP_status_t status = sumTDirection<T>(mine, per*words, dim);
+      if (status != QMP_SUCCESS)
+	return status;
+    }
+
+    for(size_t j=0; j < size_t(c)*per*words; j++)
+      x[j] = 0;
+    for(size_t j=size_t(c+1)*per*words; j < size_t(nslice)*words; j++)
+      x[j] = 0;
+
+    return sumTDirection<T>(x, nslice*words, dir);
+  }
+
+  QMP_status_t QDP_sum_slices(double *x, int words, int nslice, int dir) {
+    return sumSlices<double>(x, words, nslice, dir);
+  }
+
+  QMP_status_t QDP_sum_slices(float *x, int words, int nslice, int dir) {
+    return sumSlices<float>(x, words, nslice, dir);
+  }
+
   QMP_status_t QDP_sum_int(int *i) { 
 #ifndef USE_QDP_QMP_GLOBAL_SUM
     return QMP_sum_int(i);
@@ -196,4 +243,116 @@ namespace QDPGlobalSums {
 #endif
   }
 
+  QMP_status_t QDP_sum_double_array_ordered(double *x, int length) { 
+    return sumT<double>(x,length);
+  }
+
+
+  //-------------------------------------------------------------------------
+  // Split-phase sums
+  //
+  // With a non-blocking MPI underneath QMP the plain sum is an
+  // MPI_Iallreduce. The reproducible sum gathers every node's array with
+  // an MPI_Iallgather and adds the rows in node order, so like
+  // sumTDirection all nodes do the same additions in the same order.
+  // Both run on a private duplicate of QMP's communicator, so they can never
+  // be matched against halo messages that are in flight at the same time.
+  //
+  // Otherwise the sum is done in startSum with the blocking routines.
+
+  struct AsyncSum
+  {
+    double *x;
+    int length;
+    bool reproducible;
+#if defined(QDP_USE_MPI_IALLREDUCE)
+    MPI_Request req;
+    std::vector<double> all_data;
+#endif
+  };
+
+#if defined(QDP_USE_MPI_IALLREDUCE)
+  namespace {
+    //! Communicator for the split-phase sums
+    /*! Made on the first sum, which all the nodes enter together */
+    MPI_Comm sumComm()
+    {
+      static MPI_Comm comm = MPI_COMM_NULL;
+      if (comm == MPI_COMM_NULL)
+      {
+	MPI_Comm* qmp;
+	QMP_get_hidden_comm(QMP_comm_get_default(), reinterpret_cast<void**>(&qmp));
+	MPI_Comm_dup(*qmp, &comm);
+      }
+      return comm;
+    }
+  }
+#endif
+
+  AsyncSum* startSum(double *x, int length, bool reproducible)
+  {
+    AsyncSum *s = new AsyncSum;
+    s->x = x;
+    s->length = length;
+    s->reproducible = reproducible;
+
+#if defined(QDP_USE_MPI_IALLREDUCE)
+    int err;
+    if (length == 0)
+    {
+      s->req = MPI_REQUEST_NULL;
+      err = MPI_SUCCESS;
+    }
+    else if (reproducible)
+    {
+      int nprocs;
+      MPI_Comm_size(sumComm(), &nprocs);
+      s->all_data.resize(length*nprocs);
+      err = MPI_Iallgather(x, length, MPI_DOUBLE, &s->all_data[0], length, MPI_DOUBLE, 
+			   sumComm(), &s->req);
+    }
+    else
+      err = MPI_Iallreduce(MPI_IN_PLACE, x, length, MPI_DOUBLE, MPI_SUM, sumComm(), &s->req);
+
+    if (err != MPI_SUCCESS)
+      QDP::QDP_error_exit("startSum: failed to start a global sum of %d doubles", length);
+#else
+    QMP_status_t err = reproducible ? sumT<double>(x, length) : QMP_sum_double_array(x, length);
+    if (err != QMP_SUCCESS)
+      QDP::QDP_error_exit(QMP_error_string(err));
+#endif
+
+    return s;
+  }
+
+  bool testSum(AsyncSum *s)
+  {
+#if defined(QDP_USE_MPI_IALLREDUCE)
+    int flag;
+    MPI_Test(&s->req, &flag, MPI_STATUS_IGNORE);
+    return flag != 0;
+#else
+    return true;
+#endif
+  }
+
+  void finishSum(AsyncSum *s)
+  {
+#if defined(QDP_USE_MPI_IALLREDUCE)
+    MPI_Wait(&s->req, MPI_STATUS_IGNORE);
+
+    if (s->reproducible && s->length > 0)
+    {
+      const int nprocs = s->all_data.size() / s->length;
+      for(int j=0; j < s->length; j++) { 
+	s->x[j] = s->all_data[j];
+	for(int i=1; i < nprocs; i++)
+	  s->x[j] += s->all_data[i*s->length + j];
+      }
+    }
+#endif
+
+    delete s;
+  }
+
 }; // End namespace
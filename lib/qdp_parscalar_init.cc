@@ -9,6 +9,9 @@
 #include <unistd.h>
 
 #include "qdp.h"
+#if defined(QDP_USE_LIBXML2)
+#include "qdp_iogauge.h"
+#endif
 #include "qmp.h"
 
 #if defined(QDP_USE_QMT_THREADS)
@@ -50,6 +53,7 @@ namespace QDP {
 		//
 		// Default pool size
 		pool_size_in_gb = 8;
+		bool pool_size_given = false;
 		
 		// Look for help
 		bool help_flag = false;
@@ -87,6 +91,8 @@ namespace QDP {
 #if defined(QDP_USE_PROFILING)   
 				fprintf(stderr,"    -p        %%d [%d] profile level\n", 
 						getProfileLevel());
+				fprintf(stderr,"    -pfile    %%s  write the profile as JSON, or CSV for a .csv name, at QDP_finalize\n");
+				fprintf(stderr,"    -pcounters %%s  hardware counters to read in each profile scope, e.g. cycles,instructions,LLC-load-misses\n");
 #endif
 				
 				// logical geometry info
@@ -98,6 +104,8 @@ namespace QDP {
 				for(int i=1; i < Nd; i++) 
 					fprintf(stderr,",-1");
 				fprintf(stderr,"] logical machine geometry\n");
+				fprintf(stderr,"    -ensemble %%d  Split the nodes into this many independent QDP members\n");
+				fprintf(stderr,"    -geom-qmp  Let QMP choose the geometry without -geom, not the one of least halo\n");
 				
 #ifdef USE_REMOTE_QIO
 				fprintf(stderr,"    -cd       %%s [.] set working dir for QIO interface\n");
@@ -107,8 +115,39 @@ namespace QDP {
 						rtinode);
 #endif
 
-				fprintf(stderr, "   -poolsize <X>  Create a fixed pool of X GB for Pool Alloc\n");
-				fprintf(stderr, "   -bind c:s   Bind Threads -- BlueGene Q only, c  cores per node and s SMT threads to run per core \n");
+				fprintf(stderr, "   -poolsize <X>  Create a pool of X GB for Pool Alloc\n");
+				fprintf(stderr, "   -poolgrow <X>  Grow a full pool by at least X GB, 0 for a fixed pool\n");
+				fprintf(stderr, "   -memstats   Print lattice memory statistics at QDP_finalize\n");
+				fprintf(stderr, "   -trace-temps  Count lattice allocations by reason and caller, printed at QDP_finalize\n");
+				fprintf(stderr, "   -commstats  Print communication statistics at QDP_finalize\n");
+				fprintf(stderr, "   -flopcount  Count the flops and bytes of every expression, printed at QDP_finalize\n");
+				fprintf(stderr, "   -kernel-report  Count the calls of the kernel chosen for each expression, printed at QDP_finalize\n");
+				fprintf(stderr, "   -thread-report  Time every thread of the parallel regions, printed at QDP_finalize\n");
+				fprintf(stderr, "   -trace <file>  Write a timeline of the operations on every node as Chrome trace JSON\n");
+				fprintf(stderr, "   -autotune   Time the threading variants of the tunable kernels on first use\n");
+				fprintf(stderr, "   -autotune-file <file>  Tune, reading earlier winners from file and saving them at QDP_finalize\n");
+				fprintf(stderr, "   -rng lcg|philox  Generator of random and gaussian\n");
+				fprintf(stderr, "   -partition-balance  Rebalance the thread partitions of subsets from measured times\n");
+				fprintf(stderr, "   -offload    Run lattice loops on the device, when built with --enable-omp-offload\n");
+				fprintf(stderr, "   -offload-min-sites <n>  Smallest subset run on the device\n");
+				fprintf(stderr, "   -offload-comms host|device|staged  Where shift faces are packed and sent from with -offload\n");
+				fprintf(stderr, "   -shm-comms on|off  Hand shift faces and global sums to nodes on the same host through shared memory, when built with --enable-mpi-shm\n");
+				fprintf(stderr, "   -rma-comms on|off  Put shift faces into the receive buffers of other nodes with MPI one sided communication, when built with --enable-mpi-rma\n");
+				fprintf(stderr, "   -progress off|on|<cpu>  Drive outstanding messages from a thread, pinned to cpu if given\n");
+#ifdef QDP_USE_LIBXML2
+				fprintf(stderr, "   -xml-parse-all-nodes  Parse XML documents on every node instead of broadcasting each query\n");
+				fprintf(stderr, "   -archiv-parallel  Read and write NERSC archive payloads from every node at once\n");
+				fprintf(stderr, "   -qio-readahead <MB>  Read QIO files this far ahead of the records taken\n");
+#endif
+				fprintf(stderr, "   -poolpages default|thp|2m|1g  Pages backing the Pool Alloc pool\n");
+				fprintf(stderr, "   -numa none|touch|bind  Place lattice pages with the threads that use them\n");
+				fprintf(stderr, "   -lattice-cow  Copies of a lattice field share its sites until one is written\n");
+				fprintf(stderr, "   -fast-memory <node>|hbw[:<MB>]  Give FAST lattice fields the memory of a NUMA node or memkind\n");
+				fprintf(stderr, "   -tile <n>   Visit sites in tiles of n^Nd sites of the local lattice\n");
+				fprintf(stderr, "   -layout default|lexico|cb2|cb3d|cb32|morton  Order of the sites within a node\n");
+				fprintf(stderr, "   -table-cache <dir>  Read the layout, set and map tables from dir, written there by the first job\n");
+				fprintf(stderr, "   -bind c:s   Bind threads to c cores per node with s SMT threads per core\n");
+				fprintf(stderr, "   -probe      Measure the machine at startup and choose the threads, pool size and kernels\n");
 
 				
 				QDP_abort(1);
@@ -128,11 +167,224 @@ namespace QDP {
 				sscanf((*argv)[++i], "%d", &lev);
 				setProgramProfileLevel(lev);
 			}
+			else if (strcmp((*argv)[i], "-pfile")==0) 
+			{
+				setProfileFile((*argv)[++i]);
+			}
+			else if (strcmp((*argv)[i], "-pcounters")==0) 
+			{
+				setProfileCounters((*argv)[++i]);
+			}
 #endif
 			else if ( strcmp((*argv)[i],"-poolsize")==0)
 			{
 				sscanf((*argv)[++i], "%f", &pool_size_in_gb);
-
+				pool_size_given = true;
+			}
+			else if (strcmp((*argv)[i], "-poolgrow")==0) 
+			{
+				float gb = 0;
+				sscanf((*argv)[++i], "%f", &gb);
+				Allocator::setPoolGrowth(size_t(gb*1024*1024*1024));
+			}
+			else if (strcmp((*argv)[i], "-memstats")==0) 
+			{
+				Allocator::setAllocStatsAtFinalize(true);
+			}
+			else if (strcmp((*argv)[i], "-trace-temps")==0) 
+			{
+				Allocator::setLatticeTrace(true);
+			}
+			else if (strcmp((*argv)[i], "-commstats")==0) 
+			{
+				CommStats::setCommStatsAtFinalize(true);
+			}
+			else if (strcmp((*argv)[i], "-flopcount")==0) 
+			{
+				setExprCounting(true);
+			}
+			else if (strcmp((*argv)[i], "-kernel-report")==0) 
+			{
+				KernelReport::setEnabled(true);
+			}
+			else if (strcmp((*argv)[i], "-thread-report")==0) 
+			{
+				ThreadReport::setEnabled(true);
+			}
+			else if (strcmp((*argv)[i], "-trace")==0) 
+			{
+				Trace::setTraceFile((*argv)[++i]);
+			}
+			else if (strcmp((*argv)[i], "-autotune")==0) 
+			{
+				AutoTune::setEnabled(true);
+			}
+			else if (strcmp((*argv)[i], "-autotune-file")==0) 
+			{
+				AutoTune::setCacheFile((*argv)[++i]);
+			}
+			else if (strcmp((*argv)[i], "-partition-balance")==0) 
+			{
+				Partition::setRebalance(true);
+			}
+			else if (strcmp((*argv)[i], "-offload")==0) 
+			{
+				Offload::setEnabled(true);
+			}
+			else if (strcmp((*argv)[i], "-offload-min-sites")==0) 
+			{
+				int n;
+				sscanf((*argv)[++i], "%d", &n);
+				Offload::setMinSites(n);
+			}
+			else if (strcmp((*argv)[i], "-offload-comms")==0) 
+			{
+				const char* path = (*argv)[++i];
+				if (strcmp(path, "host")==0)
+					Offload::setCommsPath(Offload::COMMS_HOST);
+				else if (strcmp(path, "device")==0)
+					Offload::setCommsPath(Offload::COMMS_DEVICE);
+				else if (strcmp(path, "staged")==0)
+					Offload::setCommsPath(Offload::COMMS_STAGED);
+				else
+				{
+					QDPIO::cerr << __func__ << ": unknown -offload-comms path " << path << std::endl;
+					QDP_abort(1);
+				}
+			}
+			else if (strcmp((*argv)[i], "-shm-comms")==0) 
+			{
+				const char* mode = (*argv)[++i];
+				if (strcmp(mode, "on")==0)
+					NodeShm::setEnabled(true);
+				else if (strcmp(mode, "off")==0)
+					NodeShm::setEnabled(false);
+				else
+				{
+					QDPIO::cerr << __func__ << ": unknown -shm-comms mode " << mode << std::endl;
+					QDP_abort(1);
+				}
+			}
+			else if (strcmp((*argv)[i], "-rma-comms")==0) 
+			{
+				const char* mode = (*argv)[++i];
+				if (strcmp(mode, "on")==0)
+					NodeRma::setEnabled(true);
+				else if (strcmp(mode, "off")==0)
+					NodeRma::setEnabled(false);
+				else
+				{
+					QDPIO::cerr << __func__ << ": unknown -rma-comms mode " << mode << std::endl;
+					QDP_abort(1);
+				}
+			}
+			else if (strcmp((*argv)[i], "-progress")==0) 
+			{
+				const char* mode = (*argv)[++i];
+				if (strcmp(mode, "on")==0)
+					Progress::setMode(true);
+				else if (strcmp(mode, "off")==0)
+					Progress::setMode(false);
+				else
+					Progress::setMode(true, atoi(mode));
+			}
+#ifdef QDP_USE_LIBXML2
+			else if (strcmp((*argv)[i], "-xml-parse-all-nodes")==0) 
+			{
+				XMLReader::setParseOnAllNodes(true);
+			}
+			else if (strcmp((*argv)[i], "-archiv-parallel")==0) 
+			{
+				setArchivParallel(true);
+			}
+			else if (strcmp((*argv)[i], "-qio-readahead")==0) 
+			{
+				int mb;
+				sscanf((*argv)[++i], "%d", &mb);
+				QDPFileReader::setReadAhead(size_t(mb) << 20);
+			}
+#endif
+			else if (strcmp((*argv)[i], "-rng")==0) 
+			{
+				const char* name = (*argv)[++i];
+				RNG::Generator gen;
+				if (RNG::generatorFromName(name, gen))
+					RNG::setGenerator(gen);
+				else
+				{
+					QDPIO::cerr << __func__ << ": unknown -rng value " << name << std::endl;
+					QDP_abort(1);
+				}
+			}
+			else if (strcmp((*argv)[i], "-poolpages")==0) 
+			{
+				const char* pages = (*argv)[++i];
+				if (strcmp(pages, "default")==0)
+					Allocator::setPoolPages(Allocator::POOL_PAGES_DEFAULT);
+				else if (strcmp(pages, "thp")==0)
+					Allocator::setPoolPages(Allocator::POOL_PAGES_THP);
+				else if (strcmp(pages, "2m")==0)
+					Allocator::setPoolPages(Allocator::POOL_PAGES_HUGE_2M);
+				else if (strcmp(pages, "1g")==0)
+					Allocator::setPoolPages(Allocator::POOL_PAGES_HUGE_1G);
+				else
+				{
+					QDPIO::cerr << __func__ << ": unknown -poolpages value " << pages << std::endl;
+					QDP_abort(1);
+				}
+			}
+			else if (strcmp((*argv)[i], "-layout")==0) 
+			{
+				const char* name = (*argv)[++i];
+				Layout::SiteOrdering order;
+				if (Layout::siteOrderingFromName(name, order))
+					Layout::setSiteOrdering(order);
+				else
+				{
+					QDPIO::cerr << __func__ << ": unknown -layout value " << name << std::endl;
+					QDP_abort(1);
+				}
+			}
+			else if (strcmp((*argv)[i], "-table-cache")==0) 
+			{
+				TableCache::setDirectory((*argv)[++i]);
+			}
+			else if (strcmp((*argv)[i], "-tile")==0) 
+			{
+				int edge;
+				sscanf((*argv)[++i], "%d", &edge);
+				Layout::setSiteTiling(edge);
+			}
+			else if (strcmp((*argv)[i], "-numa")==0) 
+			{
+				const char* mode = (*argv)[++i];
+				if (strcmp(mode, "none")==0)
+					Allocator::setLatticePlacement(Allocator::PLACE_LAZY);
+				else if (strcmp(mode, "touch")==0)
+					Allocator::setLatticePlacement(Allocator::PLACE_FIRST_TOUCH);
+				else if (strcmp(mode, "bind")==0)
+					Allocator::setLatticePlacement(Allocator::PLACE_BIND);
+				else
+				{
+					QDPIO::cerr << __func__ << ": unknown -numa mode " << mode << std::endl;
+					QDP_abort(1);
+				}
+			}
+			else if (strcmp((*argv)[i], "-lattice-cow")==0) 
+			{
+				Allocator::setLatticeCopyOnWrite(true);
+			}
+			else if (strcmp((*argv)[i], "-fast-memory")==0) 
+			{
+				const char* tier = (*argv)[++i];
+				int node = -1;
+				if (strncmp(tier, "hbw", 3) != 0 && sscanf(tier, "%d", &node) != 1)
+				{
+					QDPIO::cerr << __func__ << ": unknown -fast-memory value " << tier << std::endl;
+					QDP_abort(1);
+				}
+				const char* mb = strchr(tier, ':');
+				Allocator::setFastMemory(node, mb ? size_t(atol(mb+1))*1024*1024 : 0);
 			}
 			else if (strcmp((*argv)[i], "-geom")==0) 
 			{
@@ -144,6 +396,16 @@ namespace QDP {
 					logical_geom[j] = uu;
 				}
 			}
+			else if (strcmp((*argv)[i], "-ensemble")==0) 
+			{
+				int n;
+				sscanf((*argv)[++i], "%d", &n);
+				Ensemble::setMembers(n);
+			}
+			else if (strcmp((*argv)[i], "-geom-qmp")==0) 
+			{
+				Layout::setGeometryOptimizer(false);
+			}
 			else if (strcmp((*argv)[i], "-iogeom")==0) 
 			{
 				setIOGeomP = true;
@@ -159,6 +421,10 @@ namespace QDP {
 				threadbind = true;
 				sscanf((*argv)[++i], "%d:%d", &n_cores, &n_threads_per_core);
 			}
+			else if (strcmp((*argv)[i], "-probe")==0) 
+			{
+				HardwareProbe::setEnabled(true);
+			}
 #ifdef USE_REMOTE_QIO
 			else if (strcmp((*argv)[i], "-cd")==0) 
 			{
@@ -210,6 +476,8 @@ namespace QDP {
 		
 
 
+		// Taken as given when the caller set up QMP
+		bool thread_multiple = true;
 		if (QMP_is_initialized() == QMP_FALSE)
 		{
 			QMP_thread_level_t prv;
@@ -218,11 +486,15 @@ namespace QDP {
 				QDPIO::cerr << __func__ << ": QMP_init_msg_passing failed" << std::endl;
 				QDP_abort(1);
 			}
+			thread_multiple = (prv == QMP_THREAD_MULTIPLE);
 		}
 		
 #if QDP_DEBUG >= 1
 		QDP_info("QMP inititalized");
 #endif
+
+		// From here on the nodes are those of this member
+		Ensemble::init();
 		
 		if (setGeomP)
 			if (QMP_declare_logical_topology(logical_geom.slice(), Nd) != QMP_SUCCESS)
@@ -289,6 +561,24 @@ namespace QDP {
 		
 #endif
 #endif
+
+#ifdef QDP_USE_POOL_THREADS
+		// Start the persistent workers
+		if( Layout::primaryNode() ) { 
+			std::cout << "QDP use the thread pool: Initializing threads..." ;
+		} 
+		int pool_status = ThreadPool::init();
+		
+		if( pool_status == 0 ) { 
+			if (  Layout::primaryNode() ) { 
+				std::cout << "Success. We have " << qdpNumThreads() << " threads \n";
+			} 
+		}
+		else { 
+			std::cout << "Failure... ThreadPool::init() returned " << pool_status << std::endl;
+			QDP_abort(1);
+		}
+#endif
 		
 		// Alloc space for reductions
 		ThreadReductions::norm2_results = new REAL64 [ qdpNumThreads() ];
@@ -309,13 +599,21 @@ namespace QDP {
 		QDPIO::cout.init(&std::cout);
 		QDPIO::cerr.init(&std::cerr);
 
-#ifdef QDP_USE_OMP_THREADS
+		// Which nodes share this host, for the map faces, once they may print
+		NodeShm::init();
+		NodeRma::init();
+		Progress::init(thread_multiple);
+
   		if ( threadbind ) {
 		  QDPIO::cout  << "Attempting to bind threads: " << n_cores << " cores with " << n_threads_per_core << " threads per core" << std::endl;
 		  setThreadAffinity(n_cores, n_threads_per_core);
+		  reportAffinity();
 		}
-		reportAffinity();
-#endif
+
+		// Threads, pool size and kernels from the machine, after any binding
+		if (HardwareProbe::enabled())
+			HardwareProbe::run(pool_size_in_gb, pool_size_given);
+
 		initProfile(__FILE__, __func__, __LINE__);
 		
 		QDPIO::cout << "Initialize done" << std::endl;
@@ -347,8 +645,39 @@ namespace QDP {
 		std::cout << "QDP use qmt threading: Finalizing threads" << std::endl;
 		qmt_finalize();
 #endif 
+
+#if defined(QDP_USE_POOL_THREADS)
+		ThreadPool::finalize();
+#endif
 		
 		printProfile();
+
+		if (Allocator::allocStatsAtFinalize())
+			Allocator::printAllocStats();
+
+		Allocator::printLatticeTrace();
+
+		if (CommStats::commStatsAtFinalize())
+			CommStats::printCommStats();
+
+		if (getExprCounting())
+			printExprCounts();
+
+		KernelReport::print();
+
+		ThreadReport::print();
+
+		Trace::write();
+
+		AutoTune::finalize();
+
+		TableCache::flush();
+
+		// Persistent map communications must go before QMP does
+		Map::freeAllComms();
+		NodeShm::finalize();
+		NodeRma::finalize();
+		Progress::finalize();
 		
 		QMP_finalize_msg_passing();
 		
@@ -7,10 +7,11 @@
  *
  * Layout
  *
- * This routine provides various layouts, including
+ * This routine provides various layouts, selected at run time, including
  *    lexicographic
  *    2-checkerboard  (even/odd-checkerboarding of sites)
  *    32-style checkerboard (even/odd-checkerboarding of hypercubes)
+ *    Morton checkerboard (blocks of each checkerboard along a Morton curve)
  */
 
 #include "qdp_diagnostics.h"
@@ -20,6 +21,9 @@
 #include "qdp_allocator.h"
 #include "qmp.h"
 
+#include <unistd.h>
+#include <vector>
+
 
 namespace QDP 
 {
@@ -42,6 +46,21 @@ namespace QDP
   namespace Layout
   {
 
+    //-----------------------------------------------------
+    //! One site ordering
+    /*! 
+     * The functions compute the ordering directly. Layout::create
+     * tabulates them for this node and they are only called for
+     * sites on other nodes afterwards.
+     */
+    struct SiteOrderingFuncs
+    {
+      int (*linearSiteIndex)(const multi1d<int>& coord);
+      multi1d<int> (*siteCoords)(int node, int linear);
+      multi1d<int> (*minimalLayoutMapping)();
+    };
+
+
     //-----------------------------------------------------
     //! Local data specific to all architectures
     /*! 
@@ -75,6 +94,10 @@ namespace QDP
       //! Total number of nodes
       int num_nodes;
 
+      //! Site ordering fixed at create
+      SiteOrdering ordering;
+      const SiteOrderingFuncs* funcs;
+
       bool iogrid_defined;
       int  num_iogrid;
       multi1d<int> iogrid;
@@ -153,6 +176,20 @@ namespace QDP
     //! Return the smallest lattice size per node allowed
     multi1d<int> minimalLayoutMapping();
 
+    //! The functions of the selected site ordering, defined below
+    static const SiteOrderingFuncs& orderingFuncs(SiteOrdering order);
+
+    //! The site tables, see qdp_layout.cc
+    void initSiteTables(int (*index)(const multi1d<int>& coord), 
+			multi1d<int> (*coords)(int node, int linear), int node, 
+			const multi1d<int>& origin);
+    void initMortonTables();
+    bool loadSiteTables();
+    void storeSiteTables();
+    int tableLinearSiteIndex(const int* coord);
+    multi1d<int> tableSubgridCoords(int linear);
+    void tableSubgridCoords(int linear, int* coord);
+
     //! Initializer for layout
     void init()
     {
@@ -170,7 +207,8 @@ namespace QDP
     //! The linearized site index for the corresponding lexicographic site
     int linearSiteIndex(int site)
     { 
-      multi1d<int> coord = crtesn(site, lattSize());
+      LatticeCoord coord;
+      lexicoCoord(site, coord);
     
       return linearSiteIndex(coord);
     }
@@ -219,20 +257,91 @@ namespace QDP
 #if QDP_DEBUG >= 2
       QDP_info("Create default subsets");
 #endif
-      // Default set and subsets
+      // Default set and subsets, none kept from another layout
+      QDPTime_t t0 = getClockTime();
+      Set::clearCache();
       initDefaultSets();
+      startupPhase("sets", 1.0e-9*(getClockTime() - t0));
 
       // Default maps
+      t0 = getClockTime();
       initDefaultMaps();
+      startupPhase("maps", 1.0e-9*(getClockTime() - t0));
 
       // Initialize RNG
+      t0 = getClockTime();
       RNG::initDefaultRNG();
+      startupPhase("rng", 1.0e-9*(getClockTime() - t0));
 
       // Set default profile level
       setProfileLevel(getProgramProfileLevel());
     }
 
 
+    //! A hash of the host name of each node, the same for the nodes of one host
+    static std::vector<double> hostIds()
+    {
+      char name[256] = {0};
+      gethostname(name, sizeof(name)-1);
+
+      // FNV-1a cut to 31 bits, exact in a double
+      unsigned int h = 2166136261u;
+      for(const char* c=name; *c; ++c)
+	h = (h ^ (unsigned char)(*c)) * 16777619u;
+
+      std::vector<double> ids(numNodes(), 0.0);
+      ids[nodeNumber()] = h & 0x7fffffff;
+      QDPInternal::globalSumArray(&ids[0], ids.size());
+
+      return ids;
+    }
+
+    //! Nodes per host when every host has the same number of consecutive ranks, else 1
+    static int nodesPerHost(const std::vector<double>& ids)
+    {
+      int per_host = 1;
+      while (per_host < ids.size() && ids[per_host] == ids[0])
+	++per_host;
+
+      if (ids.size() % per_host != 0)
+	return 1;
+
+      for(int r=0; r < ids.size(); ++r)
+	if (ids[r] != ids[r - r % per_host] || (r % per_host == 0 && r > 0 && ids[r] == ids[r-1]))
+	  return 1;
+
+      return per_host;
+    }
+
+
+    //! What the tables of this node depend on, for the table cache
+    /*! The lattice, the node grid and where every node sits in it */
+    static std::vector<int> tableCacheGeometry()
+    {
+      std::vector<int> g;
+      g.push_back(Nd);
+      g.push_back(_layout.ordering);
+      g.push_back(_layout.num_nodes);
+      g.push_back(_layout.node_rank);
+      for(int i=0; i < Nd; ++i)
+      {
+	g.push_back(_layout.nrow[i]);
+	g.push_back(_layout.logical_size[i]);
+      }
+
+      // The placement of the nodes enters as an FNV-1a hash of their coordinates
+      unsigned long long h = 14695981039346656037ull;
+      for(int node=0; node < _layout.num_nodes; ++node)
+      {
+	multi1d<int> coord = getLogicalCoordFrom(node);
+	for(int i=0; i < Nd; ++i)
+	  h = (h ^ (unsigned int)coord[i]) * 1099511628211ull;
+      }
+      g.push_back(int(h & 0x7fffffff));
+      g.push_back(int((h >> 32) & 0x7fffffff));
+      return g;
+    }
+
     //! Main lattice creation routine
     void create()
     {
@@ -245,6 +354,9 @@ namespace QDP
       _layout.vol=1;
       for(int i=0; i < Nd; ++i) 
 	_layout.vol *= _layout.nrow[i];
+
+      _layout.ordering = siteOrdering();
+      _layout.funcs = &orderingFuncs(_layout.ordering);
   
 #if QDP_DEBUG >= 2
       QDP_info("vol=%d",_layout.vol);
@@ -277,6 +389,20 @@ namespace QDP
       for(int i=0; i < Nd; ++i)
 	nrow[i] = _layout.nrow[i] / min_dim[i];
 
+      // Otherwise pick the grid with the least halo, neighbours on one host
+      // where the hosts can be told apart
+      std::vector<double> host = hostIds();
+      const int per_host = nodesPerHost(host);
+      if (geometryOptimizer() && QMP_logical_topology_is_declared() == QMP_FALSE)
+      {
+	multi1d<int> grid = optimalLogicalSize(_layout.nrow, min_dim, numNodes(), per_host);
+	if (grid.size() == Nd)
+	{
+	  if (QMP_declare_logical_topology(grid.slice(), Nd) != QMP_SUCCESS)
+	    QDP_error_exit("Layout::create - QMP_declare_logical_topology failed");
+	}
+      }
+
       int* nrow_slice=const_cast<int*>(nrow.slice());
       QMP_layout_grid(nrow_slice, Nd);
 
@@ -300,6 +426,22 @@ namespace QDP
 	_layout.subgrid_vol *= _layout.subgrid_nrow[i];
       }
 
+      // Tabulate the ordering of the sites on this node
+      multi1d<int> origin = _layout.logical_coord;
+      origin *= _layout.subgrid_nrow;
+      TableCache::open(TableCache::directory().empty() ? std::vector<int>() : tableCacheGeometry());
+      QDPTime_t t0 = getClockTime();
+      if (! loadSiteTables())
+      {
+	if (_layout.ordering == ORDER_MORTON)
+	  initMortonTables();
+	else
+	  initSiteTables(_layout.funcs->linearSiteIndex, _layout.funcs->siteCoords, 
+			 _layout.node_rank, origin);
+	storeSiteTables();
+      }
+      startupPhase("tables", 1.0e-9*(getClockTime() - t0));
+
       // Diagnostics
       QDPIO::cout << "Lattice initialized:\n";
       QDPIO::cout << "  problem size =";
@@ -325,6 +467,7 @@ namespace QDP
       QDPIO::cout << "  total number of nodes = " << Layout::numNodes() << std::endl;
       QDPIO::cout << "  total volume = " << _layout.vol << std::endl;
       QDPIO::cout << "  subgrid volume = " << _layout.subgrid_vol << std::endl;
+      QDPIO::cout << "  site ordering = " << siteOrderingName(_layout.ordering) << std::endl;
       if ( _layout.iogrid_defined ) { 
         QDPIO::cout << "  Number of IO nodes = " << _layout.num_iogrid << std::endl;
         QDPIO::cout << "  IO grid size =";
@@ -333,6 +476,7 @@ namespace QDP
         QDPIO::cout << std::endl;
       } 
 
+      t0 = getClockTime();
       // Sanity check - check the QMP node number functions
       for(int node=0; node < Layout::numNodes(); ++node)
       { 
@@ -342,6 +486,31 @@ namespace QDP
 	if (node != node2)
 	  QDP_error_exit("Layout::create - Layout problems, the QMP logical to physical node map functions do not work correctly with this lattice size");
       }
+      startupPhase("nodes", 1.0e-9*(getClockTime() - t0));
+
+      // Predicted communication: face sites this node sends in the shifts of
+      // all directions, and how many go to other hosts
+      double halo[2] = {double(haloSites(_layout.nrow, _layout.logical_size)), 0.0};
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	if (_layout.logical_size[mu] == 1)
+	  continue;
+
+	for(int sign=-1; sign <= 1; sign += 2)
+	{
+	  multi1d<int> coord = _layout.logical_coord;
+	  coord[mu] = (coord[mu] + sign + _layout.logical_size[mu]) % _layout.logical_size[mu];
+	  if (host[getNodeNumberFrom(coord)] != host[nodeNumber()])
+	    halo[1] += _layout.subgrid_vol / _layout.subgrid_nrow[mu];
+	}
+      }
+      QDPInternal::globalSumArray(halo, 2);
+
+      const double fermion = sizeof(LatticeFermion::Subtype_t);
+      QDPIO::cout << "  halo sites per node = " << halo[0] / numNodes()
+		  << ", " << halo[1] / numNodes() << " off host, "
+		  << halo[0] / numNodes() * fermion / (1024*1024) << " MB for a fermion shifted both ways in every direction"
+		  << std::endl;
 
       // Sanity check - check the layout functions make sense
 #if QDP_DEBUG >= 2
@@ -372,12 +541,23 @@ namespace QDP
 
       size_t pool_size_in_MB = static_cast<size_t>(floor(pool_size_in_gb*1024.0));
 
+      t0 = getClockTime();
       Allocator::theQDPAllocator::Instance().init(pool_size_in_MB);
+      startupPhase("pool", 1.0e-9*(getClockTime() - t0));
 
       // Initialize various defaults
       initDefaults();
 
+      if (TableCache::active())
+      {
+	double n[2] = {double(TableCache::numLoaded()), double(TableCache::numStored())};
+	QDPInternal::globalSumArray(n, 2);
+	QDPIO::cout << "  table cache: " << n[0] / numNodes() << " tables read, "
+		    << n[1] / numNodes() << " made per node" << std::endl;
+	TableCache::flush();
+      }
 
+      printStartupTimes();
       QDPIO::cout << "Finished lattice layout" << std::endl;
 
 #if QDP_DEBUG >= 2
@@ -388,15 +568,11 @@ namespace QDP
 
 
   //-----------------------------------------------------------------------------
-#if QDP_USE_LEXICO_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a lexicographic layout")
-
   namespace Layout
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is a simple lexicographic lattice ordering */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int lexicoLinearSiteIndex(const multi1d<int>& coord)
     {
       multi1d<int> tmp_coord(Nd);
 
@@ -422,7 +598,7 @@ QDPXX_MESSAGE("Using a lexicographic layout")
 
     //! Returns the lattice site for some input node and linear index
     /*! This layout is a simple lexicographic lattice ordering */
-    multi1d<int> siteCoords(int node, int linear)
+    static multi1d<int> lexicoSiteCoords(int node, int linear)
     {
       multi1d<int> coord = getLogicalCoordFrom(node);
 
@@ -439,7 +615,7 @@ QDPXX_MESSAGE("Using a lexicographic layout")
 
     //! Return the smallest lattice size per node allowed
     /*! This layout is a simple lexicographic lattice ordering */
-    multi1d<int> minimalLayoutMapping()
+    static multi1d<int> lexicoMinimalLayoutMapping()
     {
       multi1d<int> dim(Nd);
       dim = 1;
@@ -450,15 +626,12 @@ QDPXX_MESSAGE("Using a lexicographic layout")
 
   //-----------------------------------------------------------------------------
 
-#elif QDP_USE_CB2_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
-
+  //-----------------------------------------------------------------------------
   namespace Layout
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int cb2LinearSiteIndex(const multi1d<int>& coord)
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> 1;
       multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
@@ -478,29 +651,12 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
     }
 
 
-    //! The node number for the corresponding lattice coordinate
-    /*! 
-     * This layout is appropriate for a 2 checkerboard (red/black) lattice,
-     * but to find the nodeNumber this function resembles a simple lexicographic 
-     * layout
-     */
-    int nodeNumber(const multi1d<int>& coord)
-    {
-      multi1d<int> tmp_coord(Nd);
-
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] / Layout::subgridLattSize()[i];
-    
-      return Layout::getNodeNumberFrom(tmp_coord);
-    }
-
-
     //! Reconstruct the lattice coordinate from the node and site number
     /*! 
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    static multi1d<int> cb2SiteCoords(int node, int linearsite) // ignore node
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> 1;
       multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
@@ -531,7 +687,7 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
 
     //! Return the smallest lattice size per node allowed
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    multi1d<int> minimalLayoutMapping()
+    static multi1d<int> cb2MinimalLayoutMapping()
     {
       multi1d<int> dim(Nd);
       dim = 1;
@@ -543,15 +699,13 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
 
   //-----------------------------------------------------------------------------
 
-#elif QDP_USE_CB3D_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a 3D checkerboard (red/black) layout")
+#if QDP_USE_CB3D_LAYOUT == 1
 
   namespace Layout
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int cb3dLinearSiteIndex(const multi1d<int>& coord)
     {
       int subgrid_vol_cb = Layout::sitesOnNode() / 2;
       multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
@@ -572,29 +726,12 @@ QDPXX_MESSAGE("Using a 3D checkerboard (red/black) layout")
     }
 
 
-    //! The node number for the corresponding lattice coordinate
-    /*! 
-     * This layout is appropriate for a 2 checkerboard (red/black) lattice,
-     * but to find the nodeNumber this function resembles a simple lexicographic 
-     * layout
-     */
-    int nodeNumber(const multi1d<int>& coord)
-    {
-      multi1d<int> tmp_coord(Nd);
-
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] / Layout::subgridLattSize()[i];
-    
-      return Layout::getNodeNumberFrom(tmp_coord);
-    }
-
-
     //! Reconstruct the lattice coordinate from the node and site number
     /*! 
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    static multi1d<int> cb3dSiteCoords(int node, int linearsite) // ignore node
     {
       int subgrid_vol_cb = Layout::sitesOnNode() / 2;
       multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
@@ -632,7 +769,7 @@ QDPXX_MESSAGE("Using a 3D checkerboard (red/black) layout")
 
     //! Return the smallest lattice size per node allowed
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    multi1d<int> minimalLayoutMapping()
+    static multi1d<int> cb3dMinimalLayoutMapping()
     {
       multi1d<int> dim(Nd);
       multi1d<int> lsize=Layout::lattSize(); // Full lattice size;
@@ -643,12 +780,11 @@ QDPXX_MESSAGE("Using a 3D checkerboard (red/black) layout")
     }
   }
 
+#endif
 
   //-----------------------------------------------------------------------------
 
-#elif QDP_USE_CB32_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a 32 checkerboard layout")
+#if QDP_USE_CB32_LAYOUT == 1
 
 #error "THIS BIT STILL UNDER CONSTRUCTION"
 
@@ -656,7 +792,7 @@ QDPXX_MESSAGE("Using a 32 checkerboard layout")
   {
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 32-style checkerboard lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int cb32LinearSiteIndex(const multi1d<int>& coord)
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> (Nd+1);
       multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
@@ -685,29 +821,12 @@ QDPXX_MESSAGE("Using a 32 checkerboard layout")
     }
 
 
-    //! The node number for the corresponding lattice coordinate
-    /*! 
-     * This layout is appropriate for a 32 checkerboard (red/black) lattice,
-     * but to find the nodeNumber this function resembles a simple lexicographic 
-     * layout
-     */
-    int nodeNumber(const multi1d<int>& coord)
-    {
-      multi1d<int> tmp_coord(Nd);
-
-      for(int i=0; i < coord.size(); ++i)
-	tmp_coord[i] = coord[i] / Layout::subgridLattSize()[i];
-    
-      return Layout::getNodeNumberFrom(tmp_coord);
-    }
-
-
     //! Reconstruct the lattice coordinate from the node and site number
     /*! 
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    static multi1d<int> cb32SiteCoords(int node, int linearsite) // ignore node
     {
       int subgrid_vol_cb = Layout::sitesOnNode() >> (Nd+1);
       multi1d<int> subgrid_cb_nrow = Layout::subgridLattSize();
@@ -744,7 +863,7 @@ QDPXX_MESSAGE("Using a 32 checkerboard layout")
 
     //! Return the smallest lattice size per node allowed
     /*! This layout is appropriate for a 32-style checkerboard lattice */
-    multi1d<int> minimalLayoutMapping()
+    static multi1d<int> cb32MinimalLayoutMapping()
     {
       multi1d<int> dim(Nd);
 
@@ -756,11 +875,148 @@ QDPXX_MESSAGE("Using a 32 checkerboard layout")
     }
   }
 
-#else
+#endif
+
+  //-----------------------------------------------------------------------------
+  namespace Layout
+  {
+    //! The Morton ordering of qdp_layout.cc does not depend on the node
+    static int mortonLinearSiteIndex(const multi1d<int>& coord)
+    {
+      return tableLinearSiteIndex(coord.slice());
+    }
 
-#error "no appropriate layout defined"
 
+    static multi1d<int> mortonSiteCoords(int node, int linear)
+    {
+      multi1d<int> coord = getLogicalCoordFrom(node);
+      coord *= Layout::subgridLattSize();
+      coord += tableSubgridCoords(linear);
+
+      return coord;
+    }
+
+
+    static multi1d<int> mortonMinimalLayoutMapping()
+    {
+      multi1d<int> dim(Nd);
+      dim = 1;
+      dim[0] = 2;       // must have multiple length 2 for cb
+
+      return dim;
+    }
+
+
+    //! The functions of an ordering
+    static const SiteOrderingFuncs& orderingFuncs(SiteOrdering order)
+    {
+      static const SiteOrderingFuncs lexico = 
+	{lexicoLinearSiteIndex, lexicoSiteCoords, lexicoMinimalLayoutMapping};
+      static const SiteOrderingFuncs cb2 = 
+	{cb2LinearSiteIndex, cb2SiteCoords, cb2MinimalLayoutMapping};
+#if QDP_USE_CB3D_LAYOUT == 1
+      static const SiteOrderingFuncs cb3d = 
+	{cb3dLinearSiteIndex, cb3dSiteCoords, cb3dMinimalLayoutMapping};
 #endif
+      static const SiteOrderingFuncs morton = 
+	{mortonLinearSiteIndex, mortonSiteCoords, mortonMinimalLayoutMapping};
+
+      switch (order)
+      {
+      case ORDER_LEXICO:
+	return lexico;
+      case ORDER_CB2:
+	return cb2;
+#if QDP_USE_CB3D_LAYOUT == 1
+      case ORDER_CB3D:
+	return cb3d;
+#endif
+      case ORDER_MORTON:
+	return morton;
+      default:
+	QDP_error_exit("Layout::create - the %s layout is not available", siteOrderingName(order));
+      }
+
+      return lexico;
+    }
+
+
+    //! The linearized site index for the corresponding coordinate
+    /*! Sites on this node are looked up in the tables made by create */
+    int linearSiteIndex(const multi1d<int>& coord)
+    {
+      for(int m=0; m < Nd; ++m)
+	if (coord[m] / _layout.subgrid_nrow[m] != _layout.logical_coord[m])
+	  return _layout.funcs->linearSiteIndex(coord);
+
+      return tableLinearSiteIndex(coord.slice());
+    }
+
+
+    //! Reconstruct the lattice coordinate from the node and site number
+    /*! Sites on this node are looked up in the tables made by create */
+    multi1d<int> siteCoords(int node, int linear)
+    {
+      if (node != _layout.node_rank)
+	return _layout.funcs->siteCoords(node, linear);
+
+      multi1d<int> coord = _layout.logical_coord;
+      coord *= _layout.subgrid_nrow;
+      coord += tableSubgridCoords(linear);
+
+      return coord;
+    }
+
+
+    //! Return the smallest lattice size per node allowed
+    multi1d<int> minimalLayoutMapping()
+    {
+      return _layout.funcs->minimalLayoutMapping();
+    }
+
+
+    //! Reconstruct the lattice coordinate from the node and site number
+    void siteCoords(int node, int linear, LatticeCoord& coord)
+    {
+      if (node != _layout.node_rank)
+      {
+	multi1d<int> tmp_coord = _layout.funcs->siteCoords(node, linear);
+	for(int m=0; m < Nd; ++m)
+	  coord[m] = tmp_coord[m];
+	return;
+      }
+
+      tableSubgridCoords(linear, coord.data());
+      for(int m=0; m < Nd; ++m)
+	coord[m] += _layout.logical_coord[m] * _layout.subgrid_nrow[m];
+    }
+
+
+    //! The node number for the corresponding lattice coordinate
+    int nodeNumber(const LatticeCoord& coord)
+    {
+      int node_coord[Nd];
+      for(int m=0; m < Nd; ++m)
+	node_coord[m] = coord[m] / _layout.subgrid_nrow[m];
+
+      return QMP_get_node_number_from(node_coord);
+    }
+
+
+    //! The linearized site index for the corresponding coordinate
+    int linearSiteIndex(const LatticeCoord& coord)
+    {
+      for(int m=0; m < Nd; ++m)
+	if (coord[m] / _layout.subgrid_nrow[m] != _layout.logical_coord[m])
+	{
+	  // A view on coord, no copy
+	  multi1d<int> tmp_coord(const_cast<int*>(coord.data()), Nd);
+	  return _layout.funcs->linearSiteIndex(tmp_coord);
+	}
+
+      return tableLinearSiteIndex(coord.data());
+    }
+  }
 
   //-----------------------------------------------------------------------------
 
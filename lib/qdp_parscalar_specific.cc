@@ -9,6 +9,14 @@
 #include "qdp_util.h"
 #include "qmp.h"
 
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 
 namespace QDP {
 
@@ -31,6 +39,18 @@ namespace QDP {
 #if QDP_DEBUG >= 3
     QDP_info("Map::make");
 #endif
+    // Any persistent comms and site splits belong to the previous map
+    freeComms();
+    freeSplitSets();
+
+    if (comm_channel < 0)
+      setCommLabel("map");
+
+    // A displacement made by an earlier job of this geometry
+    const std::string key = TableCache::mapKey(func);
+    if (! key.empty() && loadTables(key))
+      return;
+
     const int nodeSites = Layout::sitesOnNode();
 
     //--------------------------------------
@@ -46,18 +66,36 @@ namespace QDP {
        Loop works out forward and backward neighbours and writes
        one value per value of linear. So no write conflicts */
 
+    // A fixed displacement is applied here instead of through func
+    Layout::LatticeCoord disp;
+    const bool displaced = func.displacement(disp);
+    const multi1d<int>& nrow = Layout::lattSize();
+
 #pragma omp parallel for
     for(int linear=0; linear < nodeSites; ++linear)
     {
       // Get the true lattice coord of this linear site index
-      multi1d<int> coord = Layout::siteCoords(my_node, linear);
+      Layout::LatticeCoord coord;
+      Layout::siteCoords(my_node, linear, coord);
 
-      // Source neighbor for this destination site
-      multi1d<int> fcoord = func(coord,+1);
+      Layout::LatticeCoord fcoord, bcoord;
+      if (displaced)
+      {
+	for(int m=0; m < Nd; ++m)
+	{
+	  fcoord[m] = ((coord[m] + disp[m]) % nrow[m] + nrow[m]) % nrow[m];
+	  bcoord[m] = ((coord[m] - disp[m]) % nrow[m] + nrow[m]) % nrow[m];
+	}
+      }
+      else
+      {
+	// Source neighbor for this destination site
+	fcoord = func(coord,+1);
 
-      // Destination neighbor receiving data from this site
-      // This functions as the inverse map
-      multi1d<int> bcoord = func(coord,-1);
+	// Destination neighbor receiving data from this site
+	// This functions as the inverse map
+	bcoord = func(coord,-1);
+      }
 
       int fnode = Layout::nodeNumber(fcoord);
       int bnode = Layout::nodeNumber(bcoord);
@@ -118,6 +156,11 @@ namespace QDP {
 
     // If no srce/dest nodes, then we know no off-node communications
     offnodeP = (cnt_srcenodes > 0) ? true : false;
+
+    // Position of each site in the packed receive buffer, -1 when the
+    // source is on this node. Filled in below when there are faces
+    roffsets.resize(nodeSites);
+    roffsets = -1;
   
     //
     // The rest of the routine is devoted to supporting off-node communications
@@ -128,6 +171,8 @@ namespace QDP {
 #if QDP_DEBUG >= 3
       QDP_info("no off-node communications: exiting Map::make");
 #endif
+      if (! key.empty())
+	storeTables(key);
       return;
     }
 
@@ -187,47 +232,62 @@ namespace QDP {
   
 
 #if QDP_DEBUG >= 3
-    for(int i=0; i < destnodes.size(); ++i)
-    {
-      QDP_info("srcenodes(%d) = %d",i,srcenodes(i));
-      QDP_info("destnodes(%d) = %d",i,destnodes(i));
-    }
+    for(int i=0; i < srcenodes_num.size(); ++i)
+      QDP_info("srcenodes_num(%d) = %d",i,srcenodes_num(i));
 
     for(int i=0; i < destnodes_num.size(); ++i)
-    {
-      QDP_info("srcenodes_num(%d) = %d",i,srcenodes_num(i));
       QDP_info("destnodes_num(%d) = %d",i,destnodes_num(i));
-    }
 #endif
 
-    // Implementation limitation in the Map::operator(). Only support
-    // a node sending data all to one node or no sending at all (offNodeP == false).
-    if (srcenodes.size() != 1)
-      QDP_error_exit("Map: for now only allow 1 destination node");
-      
-    if (destnodes.size() != 1)
-      QDP_error_exit("Map: for now only allow receives from 1 node");
+    // The receive buffer holds the faces from each source node back to
+    // back, in the order of srcenodes and in increasing site order 
+    // within a face. Rebuild roffsets accordingly
+    multi1d<int> srcenodes_start(srcenodes.size());
+    for(int p=0, cnt=0; p < srcenodes.size(); ++p)
+    {
+      srcenodes_start[p] = cnt;
+      cnt += srcenodes_num[p];
+    }
 
+    for(int linear=0; linear < nodeSites; ++linear)
+    {
+      int this_node = srcnode[linear];
+      if (this_node == my_node)
+	continue;
 
-    // Now make a small scatter array for the dest_buf so that when data
-    // is sent, it is put in an order the gather can pick it up
-    // If we allow multiple dest nodes, then soffsets here needs to be
-    // an array of arrays
-    soffsets.resize(destnodes_num[0]);
+      for(int p=0; p < srcenodes.size(); ++p)
+	if (srcenodes[p] == this_node)
+	{
+	  roffsets[linear] = srcenodes_start[p]++;
+	  break;
+	}
+    }
+
+    // Now make a small scatter array for the send buffer so that when data
+    // is sent, it is put in an order the gather can pick it up. The faces
+    // for each destination node are back to back in the order of destnodes
+    int dstnum = 0;
+    for(int p=0; p < destnodes_num.size(); ++p)
+      dstnum += destnodes_num[p];
+
+    soffsets.resize(dstnum);
   
-    // Loop through sites on my *destination* node - here I assume all nodes have
+    // Loop through sites on each *destination* node - here I assume all nodes have
     // the same number of sites. Mimic the gather pattern needed on that node and
     // set my scatter array to scatter into the correct site order
-    for(int i=0, si=0; i < nodeSites; ++i) 
+    for(int p=0, si=0; p < destnodes.size(); ++p)
     {
-      // Get the true lattice coord of this linear site index
-      multi1d<int> coord = Layout::siteCoords(destnodes[0], i);
-      multi1d<int> fcoord = func(coord,+1);
-      int fnode = Layout::nodeNumber(fcoord);
-      int fline = Layout::linearSiteIndex(fcoord);
-
-      if (fnode == my_node)
-				soffsets[si++] = fline;
+      for(int i=0; i < nodeSites; ++i) 
+      {
+	// Get the true lattice coord of this linear site index
+	multi1d<int> coord = Layout::siteCoords(destnodes[p], i);
+	multi1d<int> fcoord = func(coord,+1);
+	int fnode = Layout::nodeNumber(fcoord);
+	int fline = Layout::linearSiteIndex(fcoord);
+
+	if (fnode == my_node)
+	  soffsets[si++] = fline;
+      }
     }
 
 #if QDP_DEBUG >= 3
@@ -237,12 +297,927 @@ namespace QDP {
 #endif
 
 
+    if (! key.empty())
+      storeTables(key);
+
 #if QDP_DEBUG >= 3
     QDP_info("exiting Map::make");
 #endif
   }
 
 
+  //! The tables of a map as named in the table cache
+  namespace
+  {
+    const char* const map_table_names[] = {
+      "goffsets", "soffsets", "srcnode", "dstnode", "roffsets",
+      "srcenodes", "destnodes", "srcenodes_num", "destnodes_num", "offnodeP"
+    };
+    const int num_map_tables = sizeof(map_table_names)/sizeof(map_table_names[0]);
+  }
+
+  bool Map::loadTables(const std::string& key)
+  {
+    multi1d<int> t[num_map_tables];
+    for(int k=0; k < num_map_tables; ++k)
+      if (! TableCache::load(key + " " + map_table_names[k], t[k]))
+	return false;
+
+    // The per site tables must cover the node, the lists agree in length
+    const int nodeSites = Layout::sitesOnNode();
+    for(int k=0; k < 5; ++k)
+      if (k != 1 && t[k].size() != nodeSites)
+	return false;
+    if (t[5].size() != t[7].size() || t[6].size() != t[8].size() || t[9].size() != 1)
+      return false;
+
+    goffsets = t[0];
+    soffsets = t[1];
+    srcnode = t[2];
+    dstnode = t[3];
+    roffsets = t[4];
+    srcenodes = t[5];
+    destnodes = t[6];
+    srcenodes_num = t[7];
+    destnodes_num = t[8];
+    offnodeP = (t[9][0] != 0);
+    return true;
+  }
+
+  void Map::storeTables(const std::string& key) const
+  {
+    multi1d<int> flag(1);
+    flag[0] = offnodeP ? 1 : 0;
+
+    const multi1d<int>* t[num_map_tables] = {
+      &goffsets, &soffsets, &srcnode, &dstnode, &roffsets,
+      &srcenodes, &destnodes, &srcenodes_num, &destnodes_num, &flag
+    };
+    for(int k=0; k < num_map_tables; ++k)
+      TableCache::store(key + " " + map_table_names[k], *t[k]);
+  }
+
+
+//-----------------------------------------------------------------------------
+// Persistent communications for maps
+
+  //! Maps currently holding persistent communication resources
+  static std::set<Map*>& mapsWithComms()
+  {
+    static std::set<Map*> maps;
+    return maps;
+  }
+
+  //! Array maps currently holding batched communication resources
+  static std::set<ArrayBiDirectionalMap*>& batchedMaps()
+  {
+    static std::set<ArrayBiDirectionalMap*> maps;
+    return maps;
+  }
+
+
+  //! Allocate communicable memory, preferring fast memory
+  static QMP_mem_t* allocCommsMemory(int nbytes, void*& ptr, const char* name)
+  {
+    // A restricted map may have nothing to send or receive
+    nbytes = std::max(nbytes, 1);
+
+    QMP_mem_t* mem = QMP_allocate_aligned_memory(nbytes, QDP_ALIGNMENT_SIZE, 
+						 (QMP_MEM_COMMS|QMP_MEM_FAST) );
+    if( mem == 0x0 ) { 
+      mem = QMP_allocate_aligned_memory(nbytes, QDP_ALIGNMENT_SIZE, QMP_MEM_COMMS);
+      if( mem == 0x0 ) { 
+	QDP_error_exit("Unable to allocate %s\n", name);
+      }
+    }
+
+    ptr = QMP_get_memory_pointer(mem);
+
+    // Total and utter paranoia
+    if ( ptr == 0x0 ) { 
+      QDP_error_exit("QMP_get_memory_pointer returned NULL pointer from non NULL QMP_mem_t (%s)\n", name);
+    }
+
+    return mem;
+  }
+
+
+  //! Declare a message memory, failing loudly
+  static QMP_msgmem_t declareMsgmem(void* buf, int nbytes)
+  {
+    QMP_msgmem_t m = QMP_declare_msgmem(buf, nbytes);
+    if( m == (QMP_msgmem_t)NULL ) { 
+      QDP_error_exit("QMP_declare_msgmem failed\n");
+    }
+
+    return m;
+  }
+
+
+  //! Declare a receive, failing loudly
+  static QMP_msghandle_t declareReceive(QMP_msgmem_t m, int node)
+  {
+    QMP_msghandle_t h = QMP_declare_receive_from(m, node, 0);
+    if( h == (QMP_msghandle_t)NULL ) { 
+      QDP_error_exit("QMP_declare_receive_from failed for node %d\n", node);
+    }
+
+    return h;
+  }
+
+
+  //! Declare a send, failing loudly
+  static QMP_msghandle_t declareSend(QMP_msgmem_t m, int node)
+  {
+    QMP_msghandle_t h = QMP_declare_send_to(m, node, 0);
+    if( h == (QMP_msghandle_t)NULL ) { 
+      QDP_error_exit("QMP_declare_send_to failed for node %d\n", node);
+    }
+
+    return h;
+  }
+
+
+  //! Find or build free persistent comms for objects of size elem_size
+  /*! 
+   * Comms still in flight or whose receive buffer is held by a live
+   * shifted leaf are skipped, so e.g. two shifts in the same expression
+   * get separate buffers. After the first such expression there is
+   * nothing more to allocate.
+   */
+  Map::MapComms& Map::getComms(int elem_size, bool host)
+  {
+    for(int i=0; i < comms.size(); ++i)
+      if (comms[i]->elem_size == elem_size && comms[i]->host == host && ! comms[i]->in_flight && comms[i]->users == 0)
+	return *(comms[i]);
+
+#if QDP_DEBUG >= 3
+    QDP_info("Map: setting up persistent comms for elem_size=%d", elem_size);
+#endif
+
+    MapComms* c = new(std::nothrow) MapComms;
+    if( c == 0x0 ) { 
+      QDP_error_exit("Unable to new MapComms in Map::getComms\n");
+    }
+
+    c->elem_size = elem_size;
+    c->host = host;
+    c->in_flight = false;
+    c->users = 0;
+
+    int dstnum = soffsets.size()*elem_size;
+    int srcnum = 0;
+    for(int p=0; p < srcenodes_num.size(); ++p)
+      srcnum += srcenodes_num[p]*elem_size;
+
+    // With offload on the face is packed on the device, and sent either
+    // from there or from a host copy made one destination at a time
+    const Offload::CommsPath path = (Offload::enabled() && ! host) ? Offload::commsPath() : Offload::COMMS_HOST;
+    c->dev_send = (path == Offload::COMMS_HOST) ? 0 : Offload::deviceAlloc(dstnum);
+    c->staged = (path == Offload::COMMS_STAGED);
+
+    if (path == Offload::COMMS_DEVICE)
+    {
+      c->send_buf_mem = 0;
+      c->send_buf = c->dev_send;
+    }
+    else
+      c->send_buf_mem = allocCommsMemory(dstnum, c->send_buf, "send_buf_mem"); // packed data to send
+    c->recv_buf_mem = allocCommsMemory(srcnum, c->recv_buf, "recv_buf_mem"); // packed receive data
+
+    // Faces for this host are copied through shared memory, but never
+    // straight out of device memory. The choice is the same on every node
+    const bool shm = NodeShm::enabled() && path != Offload::COMMS_DEVICE;
+
+    // and those for the other nodes may be put into their receive buffers
+    const bool rma = NodeRma::enabled() && path != Offload::COMMS_DEVICE;
+
+#if QDP_DEBUG >= 3
+    QDP_info("Map: send = 0x%x  recv = 0x%x",c->send_buf,c->recv_buf);
+#endif
+
+    // One receive per source node and one send per destination node,
+    // all started and waited on together
+    std::vector<QMP_msghandle_t> mh_a;
+
+    char *recv_buf = (char *)c->recv_buf;
+    for(int p=0; p < srcenodes.size(); ++p)
+    {
+#if QDP_DEBUG >= 3
+      QDP_info("Map: establish recv=%d",srcenodes[p]);
+#endif
+      int nbytes = srcenodes_num[p]*elem_size;
+      c->recv_shm.push_back(0);
+      c->recv_rma.push_back(0);
+      if (shm && NodeShm::onNode(srcenodes[p]))
+	c->recv_shm.back() = new NodeShm::Channel(srcenodes[p], Layout::nodeNumber(), recv_buf, nbytes);
+      else if (rma)
+	c->recv_rma.back() = new NodeRma::Channel(srcenodes[p], Layout::nodeNumber(), recv_buf, nbytes);
+      else
+      {
+	c->msg.push_back(declareMsgmem(recv_buf, nbytes));
+	mh_a.push_back(declareReceive(c->msg.back(), srcenodes[p]));
+      }
+      recv_buf += nbytes;
+
+      CommStats::Message m = {srcenodes[p], size_t(nbytes), false};
+      c->stats_msgs.push_back(m);
+    }
+
+    char *send_buf = (char *)c->send_buf;
+    for(int p=0; p < destnodes.size(); ++p)
+    {
+#if QDP_DEBUG >= 3
+      QDP_info("Map: establish send=%d",destnodes[p]);
+#endif
+      int nbytes = destnodes_num[p]*elem_size;
+      c->send_shm.push_back(0);
+      c->send_rma.push_back(0);
+      if (shm && NodeShm::onNode(destnodes[p]))
+      {
+	c->send_shm.back() = new NodeShm::Channel(Layout::nodeNumber(), destnodes[p], send_buf, nbytes);
+	if (c->staged)
+	  c->send_mh.push_back(0);
+      }
+      else if (rma)
+      {
+	c->send_rma.back() = new NodeRma::Channel(Layout::nodeNumber(), destnodes[p], send_buf, nbytes);
+	if (c->staged)
+	  c->send_mh.push_back(0);
+      }
+      else
+      {
+	c->msg.push_back(declareMsgmem(send_buf, nbytes));
+	if (c->staged)
+	  c->send_mh.push_back(declareSend(c->msg.back(), destnodes[p]));
+	else
+	  mh_a.push_back(declareSend(c->msg.back(), destnodes[p]));
+      }
+      send_buf += nbytes;
+
+      CommStats::Message m = {destnodes[p], size_t(nbytes), true};
+      c->stats_msgs.push_back(m);
+    }
+
+    // The multiple handle takes ownership of mh_a
+    c->mh = 0;
+    if (mh_a.size() > 0)
+    {
+      c->mh = QMP_declare_multiple(&(mh_a[0]), mh_a.size());
+      if( c->mh == (QMP_msghandle_t)NULL ) { 
+	QDP_error_exit("QMP_declare_multiple for mh failed in Map::getComms\n");
+      }
+    }
+
+    comms.push_back(c);
+    mapsWithComms().insert(this);
+
+    return *c;
+  }
+
+
+  //! Start the messages of mh, all of them or the receives when staged
+  void Map::startReceives(MapComms& c)
+  {
+    QMP_status_t err;
+
+#if QDP_DEBUG >= 3
+    QDP_info("Map: calling start to %d send and %d recv nodes",destnodes.size(),srcenodes.size());
+#endif
+
+    c.t_start = getClockTime();
+    for(int p=0; p < c.recv_rma.size(); ++p)
+      if (c.recv_rma[p])
+	c.recv_rma[p]->post();
+    if (c.mh && (err = QMP_start(c.mh)) != QMP_SUCCESS)
+      QDP_error_exit(QMP_error_string(err));
+    if (c.mh)
+      Progress::watch(c.mh);
+
+    c.in_flight = true;
+  }
+
+
+  //! Start the send to destination p when staged or through a channel
+  /*! A channel send is done on return */
+  void Map::startSend(MapComms& c, int p)
+  {
+    QMP_status_t err;
+
+    if (c.send_shm[p])
+      c.send_shm[p]->send();
+    else if (c.send_rma[p])
+      c.send_rma[p]->send();
+    else if (p < c.send_mh.size())
+    {
+      if ((err = QMP_start(c.send_mh[p])) != QMP_SUCCESS)
+	QDP_error_exit(QMP_error_string(err));
+      Progress::watch(c.send_mh[p]);
+    }
+  }
+
+
+  //! Start all the messages of the face packed in c
+  void Map::startComms(MapComms& c)
+  {
+    startReceives(c);
+    for(int p=0; p < c.send_shm.size(); ++p)
+      startSend(c, p);
+  }
+
+
+  //! Wait on the messages of c
+  void Map::waitComms(MapComms& c)
+  {
+    QMP_status_t err;
+
+#if QDP_DEBUG >= 3
+    QDP_info("Map: calling wait");
+#endif
+
+    QDPTime_t t_wait = getClockTime();
+    if (c.mh)
+    {
+      Progress::unwatch(c.mh);
+      if ((err = QMP_wait(c.mh)) != QMP_SUCCESS)
+	QDP_error_exit(QMP_error_string(err));
+    }
+
+    for(int p=0; p < c.send_mh.size(); ++p)
+      if (c.send_mh[p])
+      {
+	Progress::unwatch(c.send_mh[p]);
+	if ((err = QMP_wait(c.send_mh[p])) != QMP_SUCCESS)
+	  QDP_error_exit(QMP_error_string(err));
+      }
+
+    for(int p=0; p < c.recv_shm.size(); ++p)
+      if (c.recv_shm[p])
+	c.recv_shm[p]->receive();
+      else if (c.recv_rma[p])
+	c.recv_rma[p]->receive();
+
+    CommStats::Stats::noteExchange(comm_channel, c.stats_msgs, c.t_start, t_wait, getClockTime());
+    c.in_flight = false;
+  }
+
+
+  //! dest(x) = src(x+offsets) for a record of bytes bytes at each site
+  void Map::shiftRecords(void* dest, const void* src, size_t bytes)
+  {
+    if (! offnodeP)
+    {
+      MapInternal::RecordArgs a = {(char*)dest, (const char*)src, bytes, goffsets.slice(), 0};
+      dispatch_to_threads(goffsets.size(), a, MapInternal::recordKernel);
+      return;
+    }
+
+    MapComms& c = getComms(bytes, true);
+
+    MapInternal::RecordArgs pack = {(char*)c.send_buf, (const char*)src, bytes, soffsets.slice(), 0};
+    dispatch_to_threads(soffsets.size(), pack, MapInternal::recordKernel);
+    startComms(c);
+
+    const Subset& inner = interior(all);
+    MapInternal::RecordArgs in = {(char*)dest, (const char*)src, bytes, goffsets.slice(), inner.siteTable().slice()};
+    dispatch_to_threads(inner.numSiteTable(), in, MapInternal::recordKernel);
+
+    waitComms(c);
+
+    const Subset& face = boundary(all);
+    MapInternal::RecordArgs out = {(char*)dest, (const char*)c.recv_buf, bytes, roffsets.slice(), face.siteTable().slice()};
+    dispatch_to_threads(face.numSiteTable(), out, MapInternal::recordKernel);
+  }
+
+
+  //! Only the face sites that ds reads travel, see restricted()
+  void Map::shiftCompact(void* dest, const Subset& ds, const int* dpos,
+			 const void* src, const int* spos, int nsrc, size_t bytes)
+  {
+    Map& r = restricted(ds);
+
+    if (! r.offnodeP)
+    {
+      MapInternal::CompactArgs a = {(char*)dest, (const char*)src, bytes, goffsets.slice(),
+				    ds.siteTable().slice(), dpos, spos, nsrc};
+      dispatch_to_threads(ds.numSiteTable(), a, MapInternal::compactKernel);
+      return;
+    }
+
+    MapComms& c = r.getComms(bytes, true);
+
+    MapInternal::CompactArgs pack = {(char*)c.send_buf, (const char*)src, bytes, r.soffsets.slice(),
+				     0, 0, spos, nsrc};
+    dispatch_to_threads(r.soffsets.size(), pack, MapInternal::compactKernel);
+    r.startComms(c);
+
+    const Subset& inner = interior(ds);
+    MapInternal::CompactArgs in = {(char*)dest, (const char*)src, bytes, goffsets.slice(),
+				   inner.siteTable().slice(), dpos, spos, nsrc};
+    dispatch_to_threads(inner.numSiteTable(), in, MapInternal::compactKernel);
+
+    r.waitComms(c);
+
+    const Subset& face = boundary(ds);
+    MapInternal::CompactArgs out = {(char*)dest, (const char*)c.recv_buf, bytes, r.roffsets.slice(),
+				    face.siteTable().slice(), dpos, 0, 0};
+    dispatch_to_threads(face.numSiteTable(), out, MapInternal::compactKernel);
+  }
+
+
+  //! Release the persistent communication buffers and message handles
+  void Map::freeComms()
+  {
+    if (comms.size() == 0)
+      return;
+
+    for(int i=0; i < comms.size(); ++i)
+    {
+      MapComms* c = comms[i];
+
+      // Never pull buffers out from under an outstanding message
+      if (c->in_flight)
+      {
+	if (c->mh)
+	{
+	  Progress::unwatch(c->mh);
+	  QMP_wait(c->mh);
+	}
+	for(int p=0; p < c->send_mh.size(); ++p)
+	  if (c->send_mh[p])
+	  {
+	    Progress::unwatch(c->send_mh[p]);
+	    QMP_wait(c->send_mh[p]);
+	  }
+      }
+
+      if (c->mh)
+	QMP_free_msghandle(c->mh);
+      for(int p=0; p < c->send_mh.size(); ++p)
+	if (c->send_mh[p])
+	  QMP_free_msghandle(c->send_mh[p]);
+      for(int m=0; m < c->msg.size(); ++m)
+	QMP_free_msgmem(c->msg[m]);
+      for(int p=0; p < c->recv_shm.size(); ++p)
+	delete c->recv_shm[p];
+      for(int p=0; p < c->send_shm.size(); ++p)
+	delete c->send_shm[p];
+      for(int p=0; p < c->recv_rma.size(); ++p)
+	delete c->recv_rma[p];
+      for(int p=0; p < c->send_rma.size(); ++p)
+	delete c->send_rma[p];
+
+      QMP_free_memory(c->recv_buf_mem);
+      if (c->send_buf_mem)
+	QMP_free_memory(c->send_buf_mem);
+      Offload::deviceFree(c->dev_send);
+
+      delete c;
+    }
+
+    comms.clear();
+    mapsWithComms().erase(this);
+  }
+
+
+  //! Release the persistent communications of every map
+  void Map::freeAllComms()
+  {
+    // freeComms modifies the registries, so work from copies
+    std::set<ArrayBiDirectionalMap*> batched(batchedMaps());
+
+    for(std::set<ArrayBiDirectionalMap*>::iterator m=batched.begin(); m != batched.end(); ++m)
+      (*m)->freeBatches();
+
+    std::set<Map*> maps(mapsWithComms());
+
+    for(std::set<Map*>::iterator m=maps.begin(); m != maps.end(); ++m)
+      (*m)->freeComms();
+  }
+
+
+//-----------------------------------------------------------------------------
+// Batched communications for all the maps of an ArrayBiDirectionalMap
+
+  //! Append node to the list if it is not there yet
+  static void addPeer(std::vector<int>& peers, int node)
+  {
+    for(int i=0; i < peers.size(); ++i)
+      if (peers[i] == node)
+	return;
+
+    peers.push_back(node);
+  }
+
+
+  //! Find or build the batched comms for objects of size elem_size
+  /*!
+   * All faces going to the same node are packed back to back into one
+   * message, in the order of bimapsa, and likewise on the receiving
+   * side. So every node pair exchanges at most one message per batch.
+   */
+  ArrayBiDirectionalMap::BatchComms& ArrayBiDirectionalMap::getBatch(int elem_size)
+  {
+    for(int i=0; i < batches.size(); ++i)
+      if (batches[i]->elem_size == elem_size)
+	return *(batches[i]);
+
+#if QDP_DEBUG >= 3
+    QDP_info("ArrayBiDirectionalMap: setting up batched comms for elem_size=%d", elem_size);
+#endif
+
+    BatchComms* b = new(std::nothrow) BatchComms;
+    if( b == 0x0 ) { 
+      QDP_error_exit("Unable to new BatchComms in ArrayBiDirectionalMap::getBatch\n");
+    }
+
+    const int nodeSites = Layout::sitesOnNode();
+
+    b->elem_size = elem_size;
+    b->send_idx.resize(bimapsa.size2(), bimapsa.size1());
+    b->recv_idx.resize(bimapsa.size2(), bimapsa.size1());
+
+    // Distinct nodes we send to and receive from
+    std::vector<int> send_peers, recv_peers;
+    for(int i=0; i < bimapsa.size2(); ++i)
+      for(int j=0; j < bimapsa.size1(); ++j)
+      {
+	const Map& m = bimapsa(i,j);
+	if (! m.offnodeP)
+	  continue;
+
+	for(int p=0; p < m.destnodes.size(); ++p)
+	  addPeer(send_peers, m.destnodes[p]);
+	for(int p=0; p < m.srcenodes.size(); ++p)
+	  addPeer(recv_peers, m.srcenodes[p]);
+      }
+
+    for(int i=0; i < bimapsa.size2(); ++i)
+      for(int j=0; j < bimapsa.size1(); ++j)
+      {
+	b->send_idx(i,j).resize(bimapsa(i,j).soffsets.size());
+	b->recv_idx(i,j).resize(nodeSites);
+	b->recv_idx(i,j) = -1;
+      }
+
+    // Position in the batch send buffer of every entry of each soffsets
+    std::vector<int> send_start;
+    int send_cnt = 0;
+    for(int q=0; q < send_peers.size(); ++q)
+    {
+      send_start.push_back(send_cnt);
+      for(int i=0; i < bimapsa.size2(); ++i)
+	for(int j=0; j < bimapsa.size1(); ++j)
+	{
+	  const Map& m = bimapsa(i,j);
+	  if (! m.offnodeP)
+	    continue;
+
+	  // soffsets holds the faces per destination node back to back
+	  multi1d<int>& idx = b->send_idx(i,j);
+	  int si = 0;
+	  for(int p=0; p < m.destnodes.size(); ++p)
+	  {
+	    if (m.destnodes[p] == send_peers[q])
+	      for(int k=0; k < m.destnodes_num[p]; ++k)
+		idx[si+k] = send_cnt++;
+
+	    si += m.destnodes_num[p];
+	  }
+	}
+    }
+    send_start.push_back(send_cnt);
+
+    // Position in the batch receive buffer of every off-node site
+    std::vector<int> recv_start;
+    int recv_cnt = 0;
+    for(int q=0; q < recv_peers.size(); ++q)
+    {
+      recv_start.push_back(recv_cnt);
+      for(int i=0; i < bimapsa.size2(); ++i)
+	for(int j=0; j < bimapsa.size1(); ++j)
+	{
+	  const Map& m = bimapsa(i,j);
+	  if (! m.offnodeP)
+	    continue;
+
+	  // Same increasing site order within a face as the sender assumes
+	  multi1d<int>& idx = b->recv_idx(i,j);
+	  for(int linear=0; linear < nodeSites; ++linear)
+	    if (m.srcnode[linear] == recv_peers[q])
+	      idx[linear] = recv_cnt++;
+	}
+    }
+    recv_start.push_back(recv_cnt);
+
+    b->send_buf_mem = 0;
+    b->recv_buf_mem = 0;
+    b->send_buf = 0;
+    b->recv_buf = 0;
+    b->mh = 0;
+
+    if (send_cnt > 0)
+    {
+      b->send_buf_mem = allocCommsMemory(send_cnt*elem_size, b->send_buf, "batched send_buf_mem");
+      b->recv_buf_mem = allocCommsMemory(recv_cnt*elem_size, b->recv_buf, "batched recv_buf_mem");
+
+      std::vector<QMP_msghandle_t> mh_a;
+
+      for(int q=0; q < recv_peers.size(); ++q)
+      {
+	char *buf = (char *)b->recv_buf + recv_start[q]*elem_size;
+	b->msg.push_back(declareMsgmem(buf, (recv_start[q+1]-recv_start[q])*elem_size));
+	mh_a.push_back(declareReceive(b->msg.back(), recv_peers[q]));
+
+	CommStats::Message m = {recv_peers[q], size_t(recv_start[q+1]-recv_start[q])*elem_size, false};
+	b->stats_msgs.push_back(m);
+      }
+
+      for(int q=0; q < send_peers.size(); ++q)
+      {
+	char *buf = (char *)b->send_buf + send_start[q]*elem_size;
+	b->msg.push_back(declareMsgmem(buf, (send_start[q+1]-send_start[q])*elem_size));
+	mh_a.push_back(declareSend(b->msg.back(), send_peers[q]));
+
+	CommStats::Message m = {send_peers[q], size_t(send_start[q+1]-send_start[q])*elem_size, true};
+	b->stats_msgs.push_back(m);
+      }
+
+#if QDP_DEBUG >= 3
+      QDP_info("ArrayBiDirectionalMap: %d sends and %d receives in one batch",
+	       send_peers.size(), recv_peers.size());
+#endif
+
+      // The multiple handle takes ownership of mh_a
+      b->mh = QMP_declare_multiple(&(mh_a[0]), mh_a.size());
+      if( b->mh == (QMP_msghandle_t)NULL ) { 
+	QDP_error_exit("QMP_declare_multiple failed in ArrayBiDirectionalMap::getBatch\n");
+      }
+    }
+
+    batches.push_back(b);
+    batchedMaps().insert(this);
+
+    return *b;
+  }
+
+
+  //! Count the communications of the maps under label
+  void ArrayBiDirectionalMap::setCommLabel(const std::string& label)
+  {
+    comm_label = label;
+    batch_channel = CommStats::channel(label + " all");
+
+    for(int i=0; i < bimapsa.size2(); ++i)
+      for(int j=0; j < bimapsa.size1(); ++j)
+      {
+	std::ostringstream lab;
+	lab << label << ((i == 0) ? "(-1," : "(+1,") << j << ")";
+	bimapsa(i,j).setCommLabel(lab.str());
+      }
+  }
+
+
+  //! Release the batched communication buffers and message handles
+  void ArrayBiDirectionalMap::freeBatches()
+  {
+    if (batches.size() == 0)
+      return;
+
+    for(int i=0; i < batches.size(); ++i)
+    {
+      BatchComms* b = batches[i];
+
+      if (b->mh)
+	QMP_free_msghandle(b->mh);
+
+      for(int m=0; m < b->msg.size(); ++m)
+	QMP_free_msgmem(b->msg[m]);
+
+      if (b->recv_buf_mem)
+	QMP_free_memory(b->recv_buf_mem);
+      if (b->send_buf_mem)
+	QMP_free_memory(b->send_buf_mem);
+
+      delete b;
+    }
+
+    batches.clear();
+    batchedMaps().erase(this);
+  }
+
+
+//-----------------------------------------------------------------------------
+// Interior and boundary sites of maps
+
+  //! Function object splitting the colors of a Set by where the map source lives
+  class SetSplitFunc : public SetFunc
+  {
+  public:
+    SetSplitFunc(const Set& ss_, const multi1d<int>& srcnode_) : 
+      ss(ss_), srcnode(srcnode_), my_node(Layout::nodeNumber()) {}
+
+    int operator() (const multi1d<int>& coordinate) const
+      {
+	int linear = Layout::linearSiteIndex(coordinate);
+	int face = (srcnode[linear] != my_node) ? 1 : 0;
+
+	return 2*ss.latticeColoring()[linear] + face;
+      }
+
+    int numSubsets() const {return 2*ss.numSubsets();}
+
+  private:
+    const Set& ss;
+    const multi1d<int>& srcnode;
+    int my_node;
+  };
+
+
+  //! Set splitting each subset of a Set into interior and boundary sites
+  const Set& Map::splitSet(const Set& ss)
+  {
+    std::map<const Set*, Set*>::iterator p = split_sets.find(&ss);
+    if (p != split_sets.end())
+      return *(p->second);
+
+    Set* split = new Set(SetSplitFunc(ss, srcnode));
+    split_sets.insert(std::make_pair(&ss, split));
+
+    return *split;
+  }
+
+
+  //! Release the cached interior/boundary sets and restricted maps
+  void Map::freeSplitSets()
+  {
+    for(std::map<const Set*, Set*>::iterator p=split_sets.begin(); p != split_sets.end(); ++p)
+      delete p->second;
+
+    split_sets.clear();
+
+    for(std::map<std::pair<const Set*,int>, Map*>::iterator p=restricted_maps.begin(); p != restricted_maps.end(); ++p)
+      delete p->second;
+
+    restricted_maps.clear();
+  }
+
+
+  //! Sites of s whose mapped source lives on this node
+  const Subset& Map::interior(const Subset& s)
+  {
+    return splitSet(s.getSet())[2*s.color()];
+  }
+
+
+  //! Sites of s whose mapped source comes from another node
+  const Subset& Map::boundary(const Subset& s)
+  {
+    return splitSet(s.getSet())[2*s.color()+1];
+  }
+
+
+  //! The map for destinations in s only
+  Map& Map::restricted(const Subset& s)
+  {
+    // The same on every node, so both ends of a face agree. A subset
+    // of no set differs from node to node, so it takes the whole face
+    if (! offnodeP || ! s.hasSet() || s.getSet().numSubsets() == 1)
+      return *this;
+
+    const std::pair<const Set*,int> key(&s.getSet(), s.color());
+    std::map<std::pair<const Set*,int>, Map*>::iterator p = restricted_maps.find(key);
+    if (p != restricted_maps.end())
+      return *(p->second);
+
+    Map* r = new Map;
+    r->restrictFrom(*this, s);
+    restricted_maps.insert(std::make_pair(key, r));
+
+    return *r;
+  }
+
+
+  //! Make this the map m for destinations in s
+  /*!
+   * Each node marks the sites of its receive buffer that s reads and
+   * sends the marks back to the nodes they come from, which then only
+   * pack those. Both ends keep the order of the full face, so they
+   * agree on where each site goes without further words.
+   */
+  void Map::restrictFrom(const Map& m, const Subset& s)
+  {
+    comm_channel = m.comm_channel;
+    goffsets = m.goffsets;
+    srcnode = m.srcnode;
+    dstnode = m.dstnode;
+
+    int srcnum = 0;
+    for(int p=0; p < m.srcenodes_num.size(); ++p)
+      srcnum += m.srcenodes_num[p];
+
+    std::vector<int> need(srcnum, 0);
+    const int* tab = s.siteTable().slice();
+    for(int j=0; j < s.numSiteTable(); ++j)
+    {
+      int k = m.roffsets[tab[j]];
+      if (k >= 0)
+	need[k] = 1;
+    }
+
+    // The marks go back along the map, from each destination to its source
+    std::vector<int> got(m.soffsets.size(), 0);
+    std::vector<QMP_msgmem_t> msg;
+    std::vector<QMP_msghandle_t> mh_a;
+
+    for(int p=0, off=0; p < m.destnodes.size(); ++p)
+    {
+      msg.push_back(declareMsgmem(&got[off], m.destnodes_num[p]*sizeof(int)));
+      mh_a.push_back(declareReceive(msg.back(), m.destnodes[p]));
+      off += m.destnodes_num[p];
+    }
+
+    for(int p=0, off=0; p < m.srcenodes.size(); ++p)
+    {
+      msg.push_back(declareMsgmem(&need[off], m.srcenodes_num[p]*sizeof(int)));
+      mh_a.push_back(declareSend(msg.back(), m.srcenodes[p]));
+      off += m.srcenodes_num[p];
+    }
+
+    QMP_msghandle_t mh = QMP_declare_multiple(&mh_a[0], mh_a.size());
+    if (mh == (QMP_msghandle_t)NULL)
+      QDP_error_exit("Map::restricted: QMP_declare_multiple failed");
+    if (QMP_start(mh) != QMP_SUCCESS || QMP_wait(mh) != QMP_SUCCESS)
+      QDP_error_exit("Map::restricted: exchange of the face marks failed");
+    QMP_free_msghandle(mh);
+    for(int i=0; i < msg.size(); ++i)
+      QMP_free_msgmem(msg[i]);
+
+    // Receive side: the marked sites in their order, nodes sending none dropped
+    std::vector<int> pos(srcnum, -1);
+    std::vector<int> se, sn;
+    for(int p=0, k=0, cnt=0; p < m.srcenodes.size(); ++p)
+    {
+      int n = 0;
+      for(int j=0; j < m.srcenodes_num[p]; ++j, ++k)
+	if (need[k])
+	  pos[k] = cnt + n++;
+
+      if (n > 0)
+      {
+	se.push_back(m.srcenodes[p]);
+	sn.push_back(n);
+      }
+      cnt += n;
+    }
+
+    roffsets.resize(m.roffsets.size());
+    for(int i=0; i < roffsets.size(); ++i)
+      roffsets[i] = (m.roffsets[i] < 0) ? -1 : pos[m.roffsets[i]];
+
+    // Send side: the marked sites of each destination
+    std::vector<int> so, de, dn;
+    for(int p=0, k=0; p < m.destnodes.size(); ++p)
+    {
+      int n = 0;
+      for(int j=0; j < m.destnodes_num[p]; ++j, ++k)
+	if (got[k])
+	{
+	  so.push_back(m.soffsets[k]);
+	  ++n;
+	}
+
+      if (n > 0)
+      {
+	de.push_back(m.destnodes[p]);
+	dn.push_back(n);
+      }
+    }
+
+    srcenodes.resize(se.size());
+    srcenodes_num.resize(se.size());
+    for(int p=0; p < se.size(); ++p)
+    {
+      srcenodes[p] = se[p];
+      srcenodes_num[p] = sn[p];
+    }
+
+    destnodes.resize(de.size());
+    destnodes_num.resize(de.size());
+    for(int p=0; p < de.size(); ++p)
+    {
+      destnodes[p] = de[p];
+      destnodes_num[p] = dn[p];
+    }
+
+    soffsets.resize(so.size());
+    for(int i=0; i < so.size(); ++i)
+      soffsets[i] = so[i];
+
+    offnodeP = (se.size() > 0 || de.size() > 0);
+  }
+
+
 //------------------------------------------------------------------------
 // Message passing convenience routines
 //------------------------------------------------------------------------
@@ -314,9 +1289,25 @@ namespace QDP {
 	       count,srce_node,dest_node);
 #endif
 
+      QDPTime_t t0 = getClockTime();
+
 //    QMP_route(buffer, count, srce_node, dest_node);
       DML_route_bytes((char*)buffer, count, srce_node, dest_node);
 
+      // Only the two ends move any data
+      std::vector<CommStats::Message> msgs;
+      if (srce_node != dest_node)
+      {
+	const int me = Layout::nodeNumber();
+	CommStats::Message send = {dest_node, size_t(count), true};
+	CommStats::Message recv = {srce_node, size_t(count), false};
+	if (me == srce_node)
+	  msgs.push_back(send);
+	if (me == dest_node)
+	  msgs.push_back(recv);
+      }
+      CommStats::Stats::noteExchange(CommStats::Route, msgs, t0, t0, getClockTime());
+
 #if QDP_DEBUG >= 2
       QDP_info("finished a route");
 #endif
@@ -330,47 +1321,268 @@ namespace QDP {
       QDP_info("starting a sendToWait, count=%d, destnode=%d", count,dest_node);
 #endif
 
-      QMP_msgmem_t request_msg = QMP_declare_msgmem(send_buf, count);
-      QMP_msghandle_t request_mh = QMP_declare_send_to(request_msg, dest_node, 0);
+      QMP_msgmem_t request_msg = QMP_declare_msgmem(send_buf, count);
+      QMP_msghandle_t request_mh = QMP_declare_send_to(request_msg, dest_node, 0);
+
+      QDPTime_t t0 = getClockTime();
+      if (QMP_start(request_mh) != QMP_SUCCESS)
+	QDP_error_exit("sendToWait failed\n");
+
+      QDPTime_t t1 = getClockTime();
+      QMP_wait(request_mh);
+
+      CommStats::Message m = {dest_node, size_t(count), true};
+      std::vector<CommStats::Message> msgs(1, m);
+      CommStats::Stats::noteExchange(CommStats::PointToPoint, msgs, t0, t1, getClockTime());
+
+      QMP_free_msghandle(request_mh);
+      QMP_free_msgmem(request_msg);
+
+#if QDP_DEBUG >= 2
+      QDP_info("finished a sendToWait");
+#endif
+    }
+
+    //! Receive from another node (wait)
+    void 
+    recvFromWait(void *recv_buf, int srce_node, int count)
+    {
+#if QDP_DEBUG >= 2
+      QDP_info("starting a recvFromWait, count=%d, srcenode=%d", count, srce_node);
+#endif
+
+      QMP_msgmem_t request_msg = QMP_declare_msgmem(recv_buf, count);
+      QMP_msghandle_t request_mh = QMP_declare_receive_from(request_msg, srce_node, 0);
+
+      QDPTime_t t0 = getClockTime();
+      if (QMP_start(request_mh) != QMP_SUCCESS)
+	QDP_error_exit("recvFromWait failed\n");
+
+      QDPTime_t t1 = getClockTime();
+      QMP_wait(request_mh);
+
+      CommStats::Message m = {srce_node, size_t(count), false};
+      std::vector<CommStats::Message> msgs(1, m);
+      CommStats::Stats::noteExchange(CommStats::PointToPoint, msgs, t0, t1, getClockTime());
+
+      QMP_free_msghandle(request_mh);
+      QMP_free_msgmem(request_msg);
+
+#if QDP_DEBUG >= 2
+      QDP_info("finished a recvFromWait");
+#endif
+    }
+
+
+    //! Send send_bytes[q] bytes to each node q, receive recv_bytes[q] from each
+    /*! 
+     * The blocks lie one after the other in node order in send and recv.
+     * Messages go out in pieces of at most 1GB, all the pieces of a round
+     * together.
+     */
+    void exchangeAll(const char* send, const size_t* send_bytes, char* recv, const size_t* recv_bytes)
+    {
+      const int nodes = Layout::numNodes();
+      const int me = Layout::nodeNumber();
+      const size_t piece = size_t(1) << 30;
+
+      std::vector<size_t> soff(nodes+1, 0), roff(nodes+1, 0);
+      size_t most = 0;
+      for(int q=0; q < nodes; ++q)
+      {
+	soff[q+1] = soff[q] + send_bytes[q];
+	roff[q+1] = roff[q] + recv_bytes[q];
+	if (q != me)
+	  most = std::max(most, std::max(send_bytes[q], recv_bytes[q]));
+      }
+
+      if (send_bytes[me] != recv_bytes[me])
+	QDP_error_exit("exchangeAll: node %d sends itself %lu bytes but expects %lu", 
+		       me, (unsigned long)send_bytes[me], (unsigned long)recv_bytes[me]);
+      if (send_bytes[me] > 0)
+	memcpy(recv + roff[me], send + soff[me], send_bytes[me]);
+
+      QDPTime_t t0 = getClockTime();
+      std::vector<CommStats::Message> msgs;
+
+      for(size_t done=0; done < most; done += piece)
+      {
+	std::vector<QMP_msgmem_t> mem;
+	std::vector<QMP_msghandle_t> mh;
+
+	for(int q=0; q < nodes; ++q)
+	{
+	  if (q == me || recv_bytes[q] <= done)
+	    continue;
+
+	  int n = int(std::min(piece, recv_bytes[q] - done));
+	  mem.push_back(declareMsgmem(recv + roff[q] + done, n));
+	  mh.push_back(declareReceive(mem.back(), q));
+
+	  CommStats::Message m = {q, size_t(n), false};
+	  msgs.push_back(m);
+	}
+
+	for(int q=0; q < nodes; ++q)
+	{
+	  if (q == me || send_bytes[q] <= done)
+	    continue;
+
+	  int n = int(std::min(piece, send_bytes[q] - done));
+	  mem.push_back(declareMsgmem(const_cast<char*>(send) + soff[q] + done, n));
+	  mh.push_back(declareSend(mem.back(), q));
+
+	  CommStats::Message m = {q, size_t(n), true};
+	  msgs.push_back(m);
+	}
+
+	for(int i=0; i < mh.size(); ++i)
+	  if (QMP_start(mh[i]) != QMP_SUCCESS)
+	    QDP_error_exit("exchangeAll: QMP_start failed on node %d", me);
+
+	for(int i=0; i < mh.size(); ++i)
+	{
+	  if (QMP_wait(mh[i]) != QMP_SUCCESS)
+	    QDP_error_exit("exchangeAll: QMP_wait failed on node %d", me);
+	  QMP_free_msghandle(mh[i]);
+	  QMP_free_msgmem(mem[i]);
+	}
+      }
+
+      CommStats::Stats::noteExchange(CommStats::PointToPoint, msgs, t0, t0, getClockTime());
+    }
+
+  };
+
+
+//-----------------------------------------------------------------------------
+// Parallel IO of lattice quantities
+  namespace
+  {
+    //! pread or pwrite all of n bytes at off
+    void transferAll(int fd, char* buf, size_t n, off_t off, bool out, const std::string& name)
+    {
+      while (n > 0)
+      {
+	ssize_t k = out ? pwrite(fd, buf, n, off) : pread(fd, buf, n, off);
+	if (k <= 0)
+	  QDP_error_exit("%s: %s failed on node %d", name.c_str(), 
+			 (out ? "pwrite" : "pread"), Layout::nodeNumber());
+	buf += k;
+	off += k;
+	n -= k;
+      }
+    }
+
+
+    //! The crc of the whole block from the crcs of its rows of rowbytes each
+    /*! Each node filled in its own rows; the sum also makes sure every node is done with the file */
+    QDPUtil::n_uint32_t combineRowCrcs(multi1d<unsigned int>& crcs, size_t rowbytes)
+    {
+      QDPInternal::globalSumArray(&crcs[0], crcs.size());
+
+      QDPUtil::n_uint32_t crc = 0;
+      if (Layout::primaryNode())
+      {
+	QDPUtil::CRC32Shift op;
+	QDPUtil::crc32_shift(op, rowbytes);
+	for(int row=0; row < crcs.size(); ++row)
+	  crc = QDPUtil::crc32_combine(op, crc, crcs[row]);
+      }
+
+      return crc;
+    }
+
+
+    //! Lex index of the first site of each x-row of xinc sites on this node
+    multi1d<int> nodeRows(int xinc)
+    {
+      multi1d<int> rows(Layout::sitesOnNode() / xinc);
+      int n = 0;
+      for(int linear=0; linear < Layout::sitesOnNode(); ++linear)
+      {
+	multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), linear);
+	if (coord[0] % xinc == 0)
+	  rows[n++] = local_site(coord, Layout::lattSize());
+      }
+      return rows;
+    }
+
+
+    //! Move the lex ordered x-rows of this node straight to or from the file
+    /*!
+     * The file holds the whole lattice in lex order from start, one site of
+     * sizemem bytes after the other in big-endian, as the serial writer
+     * puts it. Each node handles its own rows of xinc sites. The crc of
+     * every row is summed into one array so the primary node can work out
+     * the checksum of the whole block in file order.
+     */
+    QDPUtil::n_uint32_t transferLattice(const std::string& name, bool out, off_t start,
+					char* data, size_t size, size_t nmemb)
+    {
+      const int xinc  = Layout::subgridLattSize()[0];
+      const int nrows = Layout::vol() / xinc;
+      const size_t sizemem  = size*nmemb;
+      const size_t rowbytes = sizemem*xinc;
+
+      int fd = open(name.c_str(), out ? O_WRONLY : O_RDONLY);
+      if (fd < 0)
+	QDP_error_exit("parallel IO: cannot open %s on node %d", name.c_str(), Layout::nodeNumber());
+
+      char *row_buf = new(std::nothrow) char[rowbytes];
+      if( row_buf == 0x0 ) { 
+	QDP_error_exit("Unable to allocate row_buf\n");
+      }
 
-      if (QMP_start(request_mh) != QMP_SUCCESS)
-	QDP_error_exit("sendToWait failed\n");
+      multi1d<unsigned int> crcs(nrows);
+      crcs = 0;
 
-      QMP_wait(request_mh);
+      for(int linear=0; linear < Layout::sitesOnNode(); ++linear)
+      {
+	multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), linear);
+	if (coord[0] % xinc != 0)
+	  continue;
 
-      QMP_free_msghandle(request_mh);
-      QMP_free_msgmem(request_msg);
+	// First site of a row
+	int site = local_site(coord, Layout::lattSize());
+	off_t off = start + off_t(site)*sizemem;
 
-#if QDP_DEBUG >= 2
-      QDP_info("finished a sendToWait");
-#endif
-    }
+	// Gather, swap and checksum each site in one pass
+	QDPUtil::n_uint32_t crc = 0;
 
-    //! Receive from another node (wait)
-    void 
-    recvFromWait(void *recv_buf, int srce_node, int count)
-    {
-#if QDP_DEBUG >= 2
-      QDP_info("starting a recvFromWait, count=%d, srcenode=%d", count, srce_node);
-#endif
+	if (out)
+	{
+	  for(int i=0; i < xinc; ++i)
+	  {
+	    int l = Layout::linearSiteIndex(site+i);
+	    crc = QDPUtil::crc32_to_big_endian(crc, row_buf+i*sizemem, data+l*sizemem, size, nmemb);
+	  }
 
-      QMP_msgmem_t request_msg = QMP_declare_msgmem(recv_buf, count);
-      QMP_msghandle_t request_mh = QMP_declare_receive_from(request_msg, srce_node, 0);
+	  crcs[site/xinc] = crc;
+	  transferAll(fd, row_buf, rowbytes, off, true, name);
+	}
+	else
+	{
+	  transferAll(fd, row_buf, rowbytes, off, false, name);
 
-      if (QMP_start(request_mh) != QMP_SUCCESS)
-	QDP_error_exit("recvFromWait failed\n");
+	  for(int i=0; i < xinc; ++i)
+	  {
+	    int l = Layout::linearSiteIndex(site+i);
+	    crc = QDPUtil::crc32_from_big_endian(crc, data+l*sizemem, row_buf+i*sizemem, size, nmemb);
+	  }
 
-      QMP_wait(request_mh);
+	  crcs[site/xinc] = crc;
+	}
+      }
 
-      QMP_free_msghandle(request_mh);
-      QMP_free_msgmem(request_msg);
+      delete[] row_buf;
 
-#if QDP_DEBUG >= 2
-      QDP_info("finished a recvFromWait");
-#endif
-    }
+      if (close(fd) != 0)
+	QDP_error_exit("parallel IO: error closing %s on node %d", name.c_str(), Layout::nodeNumber());
 
-  };
+      return combineRowCrcs(crcs, rowbytes);
+    }
+  }
 
 
 //-----------------------------------------------------------------------------
@@ -378,6 +1590,16 @@ namespace QDP {
   void writeOLattice(BinaryWriter& bin, 
 		     const char* output, size_t size, size_t nmemb)
   {
+    // Every node writes its own sites
+    std::string name = bin.parallelFile();
+    if (! name.empty())
+    {
+      BinaryWriter::off_type start = bin.parallelBegin();
+      QDPUtil::n_uint32_t crc = transferLattice(name, true, start, const_cast<char*>(output), size, nmemb);
+      bin.parallelEnd(start, size*nmemb*Layout::vol(), crc);
+      return;
+    }
+
     const int xinc = Layout::subgridLattSize()[0];
 
     size_t sizemem = size*nmemb;
@@ -393,7 +1615,9 @@ namespace QDP {
     for(int site=0; site < Layout::vol(); site += xinc)
     {
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Layout::LatticeCoord coord;
+      Layout::lexicoCoord(site, coord);
+      int node = Layout::nodeNumber(coord);
 
       // Send nodes must wait for a ready signal from the master node
       // to prevent message pileups on the master node
@@ -409,8 +1633,8 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
-	  memcpy(recv_buf+i*sizemem, output+linear*sizemem, sizemem);
+	  int linear = Layout::linearSiteIndex(site+i);
+	  QDPUtil::copy_big_endian(recv_buf+i*sizemem, output+linear*sizemem, size, nmemb);
 	}
       }
 
@@ -429,7 +1653,8 @@ namespace QDP {
 #endif
       }
 
-      bin.writeArrayPrimaryNode(recv_buf, size, nmemb*xinc);
+      // The owner put the row in file order while gathering it
+      bin.writeBytesPrimaryNode(recv_buf, tot_size);
     }
 
     delete[] recv_buf;
@@ -517,7 +1742,9 @@ namespace QDP {
       // subgridLattSize strip.
 
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Layout::LatticeCoord coord;
+      Layout::lexicoCoord(site, coord);
+      int node = Layout::nodeNumber(coord);
 
       // Send nodes must wait for a ready signal from the master node
       // to prevent message pileups on the master node
@@ -534,10 +1761,10 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 	  if (lat_color[linear] == color)
 	  {
-	    memcpy(recv_buf+site_cnt*sizemem, output+linear*sizemem, sizemem);
+	    QDPUtil::copy_big_endian(recv_buf+site_cnt*sizemem, output+linear*sizemem, size, nmemb);
 	    site_cnt++;
 	  }
 	}
@@ -569,7 +1796,7 @@ namespace QDP {
 #endif
       }
 
-      bin.writeArrayPrimaryNode(recv_buf, size, nmemb*site_cnt);
+      bin.writeBytesPrimaryNode(recv_buf, site_cnt*sizemem);
     }
 
     delete[] recv_buf_size;
@@ -583,6 +1810,16 @@ namespace QDP {
   void readOLattice(BinaryReader& bin, 
 		    char* input, size_t size, size_t nmemb)
   {
+    // Every node reads its own sites
+    std::string name = bin.parallelFile();
+    if (! name.empty())
+    {
+      BinaryReader::off_type start = bin.parallelBegin();
+      QDPUtil::n_uint32_t crc = transferLattice(name, false, start, input, size, nmemb);
+      bin.parallelEnd(start, size*nmemb*Layout::vol(), crc);
+      return;
+    }
+
     const int xinc = Layout::subgridLattSize()[0];
 
     size_t sizemem = size*nmemb;
@@ -596,10 +1833,13 @@ namespace QDP {
     for(int site=0; site < Layout::vol(); site += xinc)
     {
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Layout::LatticeCoord coord;
+      Layout::lexicoCoord(site, coord);
+      int node = Layout::nodeNumber(coord);
 
-      // Only on primary node read the data
-      bin.readArrayPrimaryNode(recv_buf, size, nmemb*xinc);
+      // Only on primary node read the data. It stays in file order until
+      // the owner scatters it
+      bin.readBytesPrimaryNode(recv_buf, tot_size);
 
       // Send result to destination node. Avoid sending prim-node sending to itself
       if (node != 0)
@@ -620,9 +1860,9 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 
-	  memcpy(input+linear*sizemem, recv_buf+i*sizemem, sizemem);
+	  QDPUtil::copy_big_endian(input+linear*sizemem, recv_buf+i*sizemem, size, nmemb);
 	}
       }
     }
@@ -705,7 +1945,9 @@ namespace QDP {
       // subgridLattSize strip.
 
       // first site in each segment uniquely identifies the node
-      int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+      Layout::LatticeCoord coord;
+      Layout::lexicoCoord(site, coord);
+      int node = Layout::nodeNumber(coord);
 
       // Find the amount of data to read. Unfortunately, have to ask the remote node
       // Place the result in a send buffer
@@ -714,7 +1956,7 @@ namespace QDP {
       {
 	for(int i=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 	  if (lat_color[linear] == color)
 	  {
 	    site_cnt++;
@@ -740,7 +1982,7 @@ namespace QDP {
       }
 
       // Only on primary node read the data
-      bin.readArrayPrimaryNode(recv_buf, size, nmemb*site_cnt);
+      bin.readBytesPrimaryNode(recv_buf, site_cnt*sizemem);
 
       // Send result to destination node. Avoid sending prim-node sending to itself
       if (node != 0)
@@ -764,10 +2006,10 @@ namespace QDP {
       {
 	for(int i=0,j=0; i < xinc; ++i)
 	{
-	  int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
+	  int linear = Layout::linearSiteIndex(site+i);
 	  if (lat_color[linear] == color)
 	  {
-	    memcpy(input+linear*sizemem, recv_buf+j*sizemem, sizemem);
+	    QDPUtil::copy_big_endian(input+linear*sizemem, recv_buf+j*sizemem, size, nmemb);
 	    j++;
 	  }
 	}
@@ -804,10 +2046,12 @@ namespace QDP {
       for (int site=start_lexico; site < stop_lexico; site += xinc)
       {
 	// first site in each segment uniquely identifies the node
-	int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+	Layout::LatticeCoord coord;
+	Layout::lexicoCoord(site, coord);
+	int node = Layout::nodeNumber(coord);
 
 	// Only on primary node read the data
-	bin.readArrayPrimaryNode(recv_buf, size, nmemb*xinc);
+	bin.readBytesPrimaryNode(recv_buf, tot_size);
 
 	// Send result to destination node. Avoid sending prim-node sending to itself
 	if (node != 0)
@@ -827,8 +2071,8 @@ namespace QDP {
 	{
 	  for(int i=0; i < xinc; ++i)
 	  {
-	    int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
-	    memcpy(input+linear*sizemem, recv_buf+i*sizemem, sizemem);
+	    int linear = Layout::linearSiteIndex(site+i);
+	    QDPUtil::copy_big_endian(input+linear*sizemem, recv_buf+i*sizemem, size, nmemb);
 	  }
 	}
       }
@@ -862,7 +2106,9 @@ namespace QDP {
       for (int site=start_lexico; site < stop_lexico; site += xinc)
       {
 	// first site in each segment uniquely identifies the node
-	int node = Layout::nodeNumber(crtesn(site, Layout::lattSize()));
+	Layout::LatticeCoord coord;
+	Layout::lexicoCoord(site, coord);
+	int node = Layout::nodeNumber(coord);
 
 	// Send nodes must wait for a ready signal from the master node
 	// to prevent message pileups on the master node
@@ -874,8 +2120,8 @@ namespace QDP {
 	// Copy to buffer: be really careful since max(linear) could vary among nodes
 	if (Layout::nodeNumber() == node){
 	  for(int i=0; i < xinc; ++i){
-	    int linear = Layout::linearSiteIndex(crtesn(site+i, Layout::lattSize()));
-	    memcpy(recv_buf+i*sizemem, output+linear*sizemem, sizemem);
+	    int linear = Layout::linearSiteIndex(site+i);
+	    QDPUtil::copy_big_endian(recv_buf+i*sizemem, output+linear*sizemem, size, nmemb);
 	  }
 	}
 
@@ -893,7 +2139,7 @@ namespace QDP {
 #endif
 	}
 
-	bin.writeArrayPrimaryNode(recv_buf, size, nmemb*xinc);
+	bin.writeBytesPrimaryNode(recv_buf, tot_size);
       }
       delete[] recv_buf;
     }
@@ -912,81 +2158,213 @@ namespace QDP {
 
   n_uint32_t computeChecksum(const multi1d<LatticeColorMatrix>& u,
 			     int mat_size)
-  {
-    size_t size = sizeof(REAL32);
-    size_t su3_size = size*mat_size;
-    n_uint32_t checksum = 0;   // checksum
-
-    multi1d<multi1d<ColorMatrix> > sa(Nd);   // extract gauge fields
-    const int nodeSites = Layout::sitesOnNode();
-
-    for(int dd=0; dd<Nd; dd++)        /* dir */
     {
-      sa[dd].resize(nodeSites);
-      QDP_extract(sa[dd], u[dd], all);
-    }
+    return nerscChecksum(u, mat_size);
+  }
 
-    char  *chk_buf = new(std::nothrow) char[su3_size];
-    if( chk_buf == 0x0 ) { 
-      QDP_error_exit("Unable to allocate chk_buf\n");
-    }
 
-    for(int linear=0; linear < nodeSites; ++linear)
+//-----------------------------------------------------------------------
+// Sites of NERSC archives
+  namespace
+  {
+    //! Set the Nd links of site linear from one site of an archive
+    /*! in holds Nd matrices of mat_size words of float_size bytes, in host order */
+    void archivToLinks(multi1d<LatticeColorMatrix>& u, int linear, const char* in,
+		       int mat_size, int float_size)
     {
+      const size_t su3_size = size_t(float_size)*mat_size;
+      REAL su3[3][3][2];
+
       for(int dd=0; dd<Nd; dd++)        /* dir */
       {
-	switch (mat_size)
+	// Transfer the data from input into SU3
+	if (float_size == 4) 
 	{
-	case 12:
+	  REAL* su3_p = (REAL *)su3;
+	  const REAL32* input_p = (const REAL32 *)( in+su3_size*dd );
+	  for(int cp_index=0; cp_index < mat_size; cp_index++) {
+	    su3_p[cp_index] = (REAL)(input_p[cp_index]);
+	  }
+	}
+	else if (float_size == 8) 
 	{
-	  REAL32 su3[2][3][2];
-
-	  for(int kk=0; kk<Nc; kk++)      /* color */
-	    for(int ii=0; ii<2; ii++)    /* color */
-	    {
-	      Complex sitecomp = peekColor(sa[dd][linear],ii,kk);
-	      su3[ii][kk][0] = toFloat(Real(real(sitecomp)));
-	      su3[ii][kk][1] = toFloat(Real(imag(sitecomp)));
-	    }
-
-	  memcpy(chk_buf, &(su3[0][0][0]), su3_size);
+	  // IEEE64BIT case
+	  REAL *su3_p = (REAL *)su3;
+	  const REAL64 *input_p = (const REAL64 *)( in+su3_size*dd );
+	  for(int cp_index=0; cp_index < mat_size; cp_index++) { 
+	    su3_p[cp_index] = (REAL)input_p[cp_index];
+	  }
+	}
+	else { 
+	  QDPIO::cerr << __func__ << ": Unknown mat size" << std::endl;
+	  QDP_abort(1);
 	}
-	break;
 
-	case 18:
+	/* Reconstruct the third column  if necessary */
+	if (mat_size == 12) 
 	{
-	  REAL32 su3[3][3][2];
+	  su3[2][0][0] = su3[0][1][0]*su3[1][2][0] - su3[0][1][1]*su3[1][2][1]
+	    - su3[0][2][0]*su3[1][1][0] + su3[0][2][1]*su3[1][1][1];
+	  su3[2][0][1] = su3[0][2][0]*su3[1][1][1] + su3[0][2][1]*su3[1][1][0]
+	    - su3[0][1][0]*su3[1][2][1] - su3[0][1][1]*su3[1][2][0];
 
-	  for(int kk=0; kk<Nc; kk++)      /* color */
-	    for(int ii=0; ii<Nc; ii++)    /* color */
-	    {
-	      Complex sitecomp = peekColor(sa[dd][linear],ii,kk);
-	      su3[ii][kk][0] = toFloat(Real(real(sitecomp)));
-	      su3[ii][kk][1] = toFloat(Real(imag(sitecomp)));
-	    }
-
-	  memcpy(chk_buf, &(su3[0][0][0]), su3_size);
+	  su3[2][1][0] = su3[0][2][0]*su3[1][0][0] - su3[0][2][1]*su3[1][0][1]
+	    - su3[0][0][0]*su3[1][2][0] + su3[0][0][1]*su3[1][2][1];
+	  su3[2][1][1] = su3[0][0][0]*su3[1][2][1] + su3[0][0][1]*su3[1][2][0]
+	    - su3[0][2][0]*su3[1][0][1] - su3[0][2][1]*su3[1][0][0];
+          
+	  su3[2][2][0] = su3[0][0][0]*su3[1][1][0] - su3[0][0][1]*su3[1][1][1]
+	    - su3[0][1][0]*su3[1][0][0] + su3[0][1][1]*su3[1][0][1];
+	  su3[2][2][1] = su3[0][1][0]*su3[1][0][1] + su3[0][1][1]*su3[1][0][0]
+	    - su3[0][0][0]*su3[1][1][1] - su3[0][0][1]*su3[1][1][0];
 	}
-	break;
 
-	default:
-	  QDPIO::cerr << __func__ << ": unexpected size" << std::endl;
-	  QDP_abort(1);
+	/* Copy into the big array */
+	for(int kk=0; kk<Nc; kk++)      /* color */
+	  for(int ii=0; ii<Nc; ii++)    /* color */
+	  {
+	    u[dd].elem(linear).elem().elem(ii,kk).real() = su3[ii][kk][0];
+	    u[dd].elem(linear).elem().elem(ii,kk).imag() = su3[ii][kk][1];
+	  }
+      }
+    }
+
+
+    //! Write the Nd links of site linear as one site of an archive of mat_size REAL32 words
+    void linksToArchiv(REAL32* out, const multi1d<LatticeColorMatrix>& u, int linear, int mat_size)
+    {
+      const int nrow = (mat_size == 12) ? 2 : 3;
+
+      for(int dd=0; dd<Nd; dd++)        /* dir */
+      {
+	for(int ii=0; ii<nrow; ii++)      /* color */
+	  for(int kk=0; kk<Nc; kk++)      /* color */
+	  {
+	    out[2*(kk+Nc*ii)]   = toFloat(Real(u[dd].elem(linear).elem().elem(ii,kk).real()));
+	    out[2*(kk+Nc*ii)+1] = toFloat(Real(u[dd].elem(linear).elem().elem(ii,kk).imag()));
+	  }
+	out += mat_size;
+      }
+    }
+
+
+    //! NERSC checksum of n bytes: the sum of their 32 bit words
+    n_uint32_t archivWordSum(const char* buf, size_t n)
+    {
+      n_uint32_t sum = 0;
+      const n_uint32_t* p = (const n_uint32_t*)buf;
+      for(size_t i=0; i < n/sizeof(n_uint32_t); ++i)
+	sum += p[i];
+      return sum;
+    }
+
+
+    //! user argument for the parallel archive reader and writer
+    struct ArchivRowArgs
+    {
+      multi1d<LatticeColorMatrix>* u;
+      const int *rows;           //!< lex index of the first site of each row
+      int fd;
+      off_t start;               //!< file offset of site 0
+      const std::string* name;
+      int mat_size;
+      int float_size;
+      bool out;
+      n_uint32_t *sums;          //!< NERSC checksum of each thread
+      unsigned int *crcs;        //!< crc of each lex row
+    };
+
+    //! user function moving rows of an archive straight to or from the file
+    /*!
+     * Reading, each row is swapped to host order, checksummed and set
+     * into the links, reconstructing the third row, site by site while
+     * it is in cache. Writing does the same backwards.
+     */
+    void archivRowKernel(int lo, int hi, int myId, ArchivRowArgs *a)
+    {
+      const int xinc = Layout::subgridLattSize()[0];
+      const size_t sitebytes = size_t(a->float_size)*a->mat_size*Nd;
+      const size_t rowbytes = sitebytes*xinc;
+
+      char* raw = Allocator::threadScratch<char>(rowbytes, 0);
+      char* host = Allocator::threadScratch<char>(sitebytes, 1);
+      n_uint32_t sum = 0;
+
+      for(int r=lo; r < hi; ++r)
+      {
+	const int site = a->rows[r];
+	const off_t off = a->start + off_t(site)*sitebytes;
+	QDPUtil::n_uint32_t crc = 0;
+
+	if (a->out)
+	{
+	  for(int i=0; i < xinc; ++i)
+	  {
+	    linksToArchiv((REAL32 *)&host[0], *a->u, Layout::linearSiteIndex(site+i), a->mat_size);
+	    sum += archivWordSum(&host[0], sitebytes);
+	    crc = QDPUtil::crc32_to_big_endian(crc, &raw[i*sitebytes], &host[0], a->float_size, a->mat_size*Nd);
+	  }
+	  transferAll(a->fd, &raw[0], rowbytes, off, true, *a->name);
+	}
+	else
+	{
+	  transferAll(a->fd, &raw[0], rowbytes, off, false, *a->name);
+	  for(int i=0; i < xinc; ++i)
+	  {
+	    crc = QDPUtil::crc32_from_big_endian(crc, &host[0], &raw[i*sitebytes], a->float_size, a->mat_size*Nd);
+	    sum += archivWordSum(&host[0], sitebytes);
+	    archivToLinks(*a->u, Layout::linearSiteIndex(site+i), &host[0], a->mat_size, a->float_size);
+	  }
 	}
 
-	// Compute checksum
-	n_uint32_t* chk_ptr = (n_uint32_t*)chk_buf;
-	for(unsigned int i=0; i < mat_size*size/sizeof(n_uint32_t); ++i)
-	  checksum += chk_ptr[i];
+	a->crcs[site/xinc] = crc;
       }
+
+      a->sums[myId] = sum;
     }
 
-    delete[] chk_buf;
 
-    // Get all nodes to contribute
-    QDPInternal::globalSumArray((unsigned int*)&checksum, 1);   // g++ requires me to narrow the type to unsigned int
+    //! Move the archive links of this node straight to or from the file, returning the NERSC checksum
+    /*! The crc of the block in file order is left in crc */
+    n_uint32_t transferArchiv(const std::string& name, bool out, off_t start,
+			      multi1d<LatticeColorMatrix>& u, int mat_size, int float_size,
+			      QDPUtil::n_uint32_t& crc)
+    {
+      const int xinc = Layout::subgridLattSize()[0];
+      const size_t rowbytes = size_t(float_size)*mat_size*Nd*xinc;
+
+      if (float_size != 4 && float_size != 8)
+      {
+	QDPIO::cerr << __func__ << ": Unknown float size " << float_size << std::endl;
+	QDP_abort(1);
+      }
+
+      int fd = open(name.c_str(), out ? O_WRONLY : O_RDONLY);
+      if (fd < 0)
+	QDP_error_exit("parallel IO: cannot open %s on node %d", name.c_str(), Layout::nodeNumber());
+
+      multi1d<int> rows = nodeRows(xinc);
+      multi1d<unsigned int> crcs(Layout::vol() / xinc);
+      crcs = 0;
+      std::vector<n_uint32_t> sums(qdpNumThreads(), 0);
+
+      ArchivRowArgs args = {&u, rows.slice(), fd, start, &name, mat_size, float_size, out, &sums[0], &crcs[0]};
+      dispatch_to_threads(rows.size(), args, archivRowKernel);
+
+      if (close(fd) != 0)
+	QDP_error_exit("parallel IO: error closing %s on node %d", name.c_str(), Layout::nodeNumber());
+
+      crc = combineRowCrcs(crcs, rowbytes);
 
-    return checksum;
+      n_uint32_t checksum = 0;
+      for(int t=0; t < sums.size(); ++t)
+	checksum += sums[t];
+
+      // Get all nodes to contribute
+      QDPInternal::globalSumArray((unsigned int*)&checksum, 1);
+
+      return checksum;
+    }
   }
 
 
@@ -1003,6 +2381,17 @@ namespace QDP {
   void readArchiv(BinaryReader& cfg_in, multi1d<LatticeColorMatrix>& u, 
 		  n_uint32_t& checksum, int mat_size, int float_size)
   {
+    // Every node reads its own sites
+    std::string name = cfg_in.parallelFile();
+    if (! name.empty())
+    {
+      BinaryReader::off_type start = cfg_in.parallelBegin();
+      QDPUtil::n_uint32_t crc;
+      checksum = transferArchiv(name, false, start, u, mat_size, float_size, crc);
+      cfg_in.parallelEnd(start, size_t(float_size)*mat_size*Nd*Layout::vol(), crc);
+      return;
+    }
+
     size_t size = float_size;
     size_t su3_size = size*mat_size;
     size_t tot_size = su3_size*Nd;
@@ -1018,27 +2407,18 @@ namespace QDP {
       QDP_error_exit("Unable to allocate recv_buf\n");
     }
 
-    checksum = 0;
-
     // Find the location of each site and send to primary node
     for(int site=0; site < Layout::vol(); ++site)
     {
-      multi1d<int> coord = crtesn(site, Layout::lattSize());
+      Layout::LatticeCoord coord;
+      Layout::lexicoCoord(site, coord);
 
       int node   = Layout::nodeNumber(coord);
-      int linear = Layout::linearSiteIndex(coord);
+      int linear = (Layout::nodeNumber() == node) ? Layout::linearSiteIndex(coord) : 0;
 
       // Only on primary node read the data
       cfg_in.readArrayPrimaryNode(recv_buf, size, mat_size*Nd);
 
-      if (Layout::primaryNode()) 
-      {
-	// Compute checksum
-	n_uint32_t* chk_ptr = (n_uint32_t*)recv_buf;
-	for(unsigned int i=0; i < mat_size*Nd*size/sizeof(n_uint32_t); ++i)
-	  checksum += chk_ptr[i];
-      }
-
       // Send result to destination node. Avoid sending prim-node sending to itself
       if (node != 0)
       {
@@ -1060,71 +2440,13 @@ namespace QDP {
 
     delete[] recv_buf;
 
-    QDPInternal::broadcast(checksum);
+    // Each node sums the words of its own sites, not the primary node all of them
+    checksum = nerscWordSum(input, tot_size*nodeSites);
+    QDPInternal::globalSumArray((unsigned int*)&checksum, 1);
 
     // Reconstruct the gauge field
-    ColorMatrix  sitefield;
-    REAL su3[3][3][2];
-
     for(int linear=0; linear < nodeSites; ++linear)
-    {
-      for(int dd=0; dd<Nd; dd++)        /* dir */
-      {
-	// Transfer the data from input into SU3
-	if (float_size == 4) 
-	{
-	  REAL* su3_p = (REAL *)su3;
-	  REAL32* input_p = (REAL32 *)( input+su3_size*(dd+Nd*linear) );
-	  for(int cp_index=0; cp_index < mat_size; cp_index++) {
-	    su3_p[cp_index] = (REAL)(input_p[cp_index]);
-	  }
-	}
-	else if (float_size == 8) 
-	{
-	  // IEEE64BIT case
-	  REAL *su3_p = (REAL *)su3;
-	  REAL64 *input_p = (REAL64 *)( input+su3_size*(dd+Nd*linear) );
-	  for(int cp_index=0; cp_index < mat_size; cp_index++) { 
-	    su3_p[cp_index] = (REAL)input_p[cp_index];
-	  }
-	}
-	else { 
-	  QDPIO::cerr << __func__ << ": Unknown mat size" << std::endl;
-	  QDP_abort(1);
-	}
-
-	/* Reconstruct the third column  if necessary */
-	if (mat_size == 12) 
-	{
-	  su3[2][0][0] = su3[0][1][0]*su3[1][2][0] - su3[0][1][1]*su3[1][2][1]
-	    - su3[0][2][0]*su3[1][1][0] + su3[0][2][1]*su3[1][1][1];
-	  su3[2][0][1] = su3[0][2][0]*su3[1][1][1] + su3[0][2][1]*su3[1][1][0]
-	    - su3[0][1][0]*su3[1][2][1] - su3[0][1][1]*su3[1][2][0];
-
-	  su3[2][1][0] = su3[0][2][0]*su3[1][0][0] - su3[0][2][1]*su3[1][0][1]
-	    - su3[0][0][0]*su3[1][2][0] + su3[0][0][1]*su3[1][2][1];
-	  su3[2][1][1] = su3[0][0][0]*su3[1][2][1] + su3[0][0][1]*su3[1][2][0]
-	    - su3[0][2][0]*su3[1][0][1] - su3[0][2][1]*su3[1][0][0];
-          
-	  su3[2][2][0] = su3[0][0][0]*su3[1][1][0] - su3[0][0][1]*su3[1][1][1]
-	    - su3[0][1][0]*su3[1][0][0] + su3[0][1][1]*su3[1][0][1];
-	  su3[2][2][1] = su3[0][1][0]*su3[1][0][1] + su3[0][1][1]*su3[1][0][0]
-	    - su3[0][0][0]*su3[1][1][1] - su3[0][0][1]*su3[1][1][0];
-	}
-
-	/* Copy into the big array */
-	for(int kk=0; kk<Nc; kk++)      /* color */
-	{
-	  for(int ii=0; ii<Nc; ii++)    /* color */
-	  {
-	    Complex sitecomp = cmplx(Real(su3[ii][kk][0]), Real(su3[ii][kk][1]));
-	    pokeColor(sitefield,sitecomp,ii,kk);
-	  }
-	}
-      
-	u[dd].elem(linear) = sitefield.elem();
-      }
-    }
+      archivToLinks(u, linear, input+tot_size*linear, mat_size, float_size);
   
     delete[] input;
   }
@@ -1142,6 +2464,17 @@ namespace QDP {
   void writeArchiv(BinaryWriter& cfg_out, const multi1d<LatticeColorMatrix>& u,
 		   int mat_size)
   {
+    // Every node writes its own sites
+    std::string name = cfg_out.parallelFile();
+    if (! name.empty())
+    {
+      BinaryWriter::off_type start = cfg_out.parallelBegin();
+      QDPUtil::n_uint32_t crc;
+      transferArchiv(name, true, start, const_cast<multi1d<LatticeColorMatrix>&>(u), mat_size, sizeof(REAL32), crc);
+      cfg_out.parallelEnd(start, sizeof(REAL32)*mat_size*Nd*Layout::vol(), crc);
+      return;
+    }
+
     size_t size = sizeof(REAL32);
     size_t su3_size = size*mat_size;
     size_t tot_size = su3_size*Nd;
@@ -1163,10 +2496,11 @@ namespace QDP {
     // Find the location of each site and send to primary node
     for(int site=0; site < Layout::vol(); ++site)
     {
-      multi1d<int> coord = crtesn(site, Layout::lattSize());
+      Layout::LatticeCoord coord;
+      Layout::lexicoCoord(site, coord);
 
       int node   = Layout::nodeNumber(coord);
-      int linear = Layout::linearSiteIndex(coord);
+      int linear = (Layout::nodeNumber() == node) ? Layout::linearSiteIndex(coord) : 0;
 
       // Copy to buffer: be really careful since max(linear) could vary among nodes
       if (Layout::nodeNumber() == node)
@@ -1235,4 +2569,69 @@ namespace QDP {
     }
   }
 
+
+  //-----------------------------------------------------------------------------
+  // Replicated fields: one copy per host in a shared block when there
+  // is one, else one per node gathered with an all-to-all
+  namespace ReplicaInternal
+  {
+    struct Store::Impl
+    {
+      explicit Impl(size_t bytes) : block(bytes) {}
+
+      NodeShm::SharedBlock block;
+      std::vector<char> buf;
+    };
+
+    Store::Store(size_t bytes) : impl(new Impl(bytes))
+    {
+      if (! impl->block.shared())
+	impl->buf.resize(bytes + 1);
+    }
+
+    Store::~Store() {delete impl;}
+
+    bool Store::shared() const {return impl->block.shared();}
+
+    char* Store::data() const
+    {
+      return impl->block.shared() ? impl->block.data() : &impl->buf[0];
+    }
+
+    void Store::allGather(size_t offset, size_t block)
+    {
+      if (impl->block.shared())
+      {
+	impl->block.allGather(offset, block);
+	return;
+      }
+
+      // Every node sends its block to all the others. The copies to send
+      // are made a piece at a time, so the buffer stays below 256 MB
+      const int nodes = Layout::numNodes();
+      const int me = Layout::nodeNumber();
+      if (nodes == 1 || block == 0)
+	return;
+
+      const size_t piece = std::max(size_t(1), (size_t(256) << 20) / nodes);
+      char* all = &impl->buf[0] + offset;
+      std::vector<char> sbuf(nodes*std::min(piece, block)), rbuf(sbuf.size());
+
+      for(size_t done=0; done < block; done += piece)
+      {
+	const size_t n = std::min(piece, block - done);
+	std::vector<size_t> bytes(nodes, n);
+
+	for(int q=0; q < nodes; ++q)
+	  memcpy(&sbuf[q*n], all + me*block + done, n);
+
+	QDPInternal::exchangeAll(&sbuf[0], &bytes[0], &rbuf[0], &bytes[0]);
+
+	for(int q=0; q < nodes; ++q)
+	  if (q != me)
+	    memcpy(all + q*block + done, &rbuf[q*n], n);
+      }
+    }
+  }
+
 } // namespace QDP;
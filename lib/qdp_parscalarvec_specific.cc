@@ -9,6 +9,8 @@
 #include "qdp.h"
 #include "qdp_util.h"
 #include "qmp.h"
+#include <map>
+#include <mutex>
 
 namespace QDP {
 
@@ -84,6 +86,21 @@ void Map::make(const MapFunc& func)
  }
 #endif
 
+  // Outer sites whose lanes all come in order from one outer site on this
+  // node are moved as whole vectors, the others lane by lane
+  const int outerSites = nodeSites >> INNER_LOG;
+  outer_goffsets.resize(outerSites);
+  for(int ii=0; ii < outerSites; ++ii)
+  {
+    const int i0 = ii << INNER_LOG;
+    const int src = goffsets[i0] >> INNER_LOG;
+    bool whole = (goffsets[i0] & (INNER_LEN-1)) == 0;
+    for(int k=0; k < INNER_LEN && whole; ++k)
+      whole = (srcnode[i0+k] == my_node) && (goffsets[i0+k] == (src << INNER_LOG) + k);
+
+    outer_goffsets[ii] = whole ? src : -1;
+  }
+
   // Return a list of the unique nodes in the list
   // NOTE: my_node may be included as a unique node, so one extra
   multi1d<int> srcenodes_tmp = uniquify_list(srcnode);
@@ -249,6 +266,60 @@ void Map::make(const MapFunc& func)
 }
 
 
+//-----------------------------------------------------------------------------
+// Lanes of the outer sites a subset touches
+namespace OuterGrid
+{
+  namespace
+  {
+    typedef std::pair<const int*, int> Key;
+
+    std::mutex lanes_lock;
+    std::map<Key, Lanes> table;
+  }
+
+  const Lanes& lanes(const Subset& s)
+  {
+    const multi1d<int>& tab = s.siteTable();
+
+    std::lock_guard<std::mutex> lock(lanes_lock);
+    const Key key(tab.slice(), s.numSiteTable());
+    std::map<Key, Lanes>::iterator p = table.find(key);
+    if (p != table.end())
+      return p->second;
+
+    // One pass to set the lane bits, site tables need not be sorted
+    multi1d<unsigned int> bits(Layout::outerSitesOnNode());
+    bits = 0;
+    for(int j=0; j < s.numSiteTable(); ++j)
+      bits[tab[j] >> INNER_LOG] |= 1u << (tab[j] & (INNER_LEN-1));
+
+    int n = 0;
+    for(int o=0; o < bits.size(); ++o)
+      if (bits[o])
+	++n;
+
+    Lanes& l = table[key];
+    l.outer.resize(n);
+    l.mask.resize(n);
+    for(int o=0, j=0; o < bits.size(); ++o)
+      if (bits[o])
+      {
+	l.outer[j] = o;
+	l.mask[j++] = bits[o];
+      }
+
+    return l;
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(lanes_lock);
+    table.clear();
+  }
+}
+
+
 //------------------------------------------------------------------------
 // Message passing convenience routines
 //------------------------------------------------------------------------
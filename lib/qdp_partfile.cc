@@ -0,0 +1,682 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Lattice fields in one file per I/O node
+ */
+
+#include "qdp.h"
+#include "qdp_byteorder.h"
+#include "qdp_partfile.h"
+#include "qdp_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(QDP_USE_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace QDP
+{
+
+  namespace
+  {
+    const std::string partfile_magic = "XXXXQDPPartFileSetXXXX";
+    const int partfile_version = 2;
+
+    //! How the parts of a field are stored
+    enum {codec_plain = 0, codec_shuffle_deflate = 1};
+
+    //! pread or pwrite all of n bytes at off
+    void transferAll(int fd, char* buf, size_t n, off_t off, bool out, const std::string& name)
+    {
+      while (n > 0)
+      {
+	ssize_t k = out ? pwrite(fd, buf, n, off) : pread(fd, buf, n, off);
+	if (k <= 0)
+	  QDP_error_exit("%s: %s failed on node %d", name.c_str(),
+			 (out ? "pwrite" : "pread"), Layout::nodeNumber());
+	buf += k;
+	off += k;
+	n -= k;
+      }
+    }
+
+    //! Close the files of the parts of this node
+    void closeParts(std::vector<int>& fds, const std::string& stem)
+    {
+      for(int i=0; i < fds.size(); ++i)
+	if (::close(fds[i]) != 0)
+	  QDP_error_exit("PartFile: error closing a part of %s on node %d", stem.c_str(), Layout::nodeNumber());
+      fds.clear();
+    }
+
+    //! Mantissa bits of a floating point word of size bytes
+    int mantissaBits(size_t size)
+    {
+      return (size == 4) ? 23 : ((size == 8) ? 52 : 0);
+    }
+
+    //! The fewest of mant mantissa bits keeping a relative error below rel
+    /*! Rounding to k bits is off by at most 2^-(k+1) of the value */
+    int keepBits(double rel, int mant)
+    {
+      if (rel <= 0)
+	return mant;
+      int k = int(std::ceil(-std::log2(rel))) - 1;
+      return std::max(0, std::min(k, mant));
+    }
+
+    //! Round the mantissas of n big-endian words to keep bits
+    /*! Infinities and NaNs are left, and so is a word rounding up to infinity */
+    template<class U>
+    void roundWords(char* buf, size_t n, int mant, int keep)
+    {
+      const int drop = mant - keep;
+      if (drop <= 0)
+	return;
+
+      const U expo = ((U(1) << (8*sizeof(U) - 1 - mant)) - 1) << mant;
+      const U half = U(1) << (drop - 1);
+      const U mask = ~((U(1) << drop) - 1);
+
+      unsigned char* p = (unsigned char*)buf;
+      for(size_t i=0; i < n; ++i, p += sizeof(U))
+      {
+	U w = 0;
+	for(int b=0; b < sizeof(U); ++b)
+	  w = (w << 8) | p[b];
+
+	if ((w & expo) == expo)
+	  continue;
+
+	U r = (w + half) & mask;
+	if ((r & expo) == expo)
+	  r = w & mask;
+
+	for(int b=sizeof(U)-1; b >= 0; --b, r >>= 8)
+	  p[b] = (unsigned char)(r & 0xff);
+      }
+    }
+
+    //! Gather byte b of every word into plane b, or scatter the planes back
+    void shuffleBytes(const char* in, char* out, size_t nwords, size_t size, bool gather)
+    {
+      for(size_t b=0; b < size; ++b)
+	for(size_t i=0; i < nwords; ++i)
+	  if (gather)
+	    out[b*nwords + i] = in[i*size + b];
+	  else
+	    out[i*size + b] = in[b*nwords + i];
+    }
+
+    //! user argument for the work on the parts of a node
+    struct PartWork
+    {
+      char* parts;                        // in file order, partbytes each
+      size_t partbytes, size;
+      int mant, keep, codec, level;
+      std::vector< std::vector<char> >* stored;  // compressed parts
+      std::vector<unsigned int>* crcs;
+      std::vector<int>* status;           // nonzero when zlib failed
+    };
+
+    //! user function rounding, checksumming and compressing parts [lo,hi)
+    void packParts(int lo, int hi, int myId, PartWork* a)
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	char* p = a->parts + j*a->partbytes;
+
+	if (a->keep < a->mant)
+	{
+	  if (a->size == 4)
+	    roundWords<unsigned int>(p, a->partbytes/4, a->mant, a->keep);
+	  else
+	    roundWords<unsigned long long>(p, a->partbytes/8, a->mant, a->keep);
+	}
+
+	(*a->crcs)[j] = QDPUtil::crc32(0, p, a->partbytes);
+
+#if defined(QDP_USE_ZLIB)
+	if (a->codec == codec_shuffle_deflate)
+	{
+	  char* planes = Allocator::threadScratch<char>(a->partbytes);
+	  shuffleBytes(p, planes, a->partbytes/a->size, a->size, true);
+
+	  std::vector<char>& out = (*a->stored)[j];
+	  uLongf len = compressBound(a->partbytes);
+	  out.resize(len);
+	  (*a->status)[j] = compress2((Bytef*)out.data(), &len, (const Bytef*)planes,
+				      a->partbytes, a->level);
+	  out.resize(len);
+	}
+#endif
+      }
+    }
+
+    //! user function inflating and checksumming parts [lo,hi)
+    void unpackParts(int lo, int hi, int myId, PartWork* a)
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	char* p = a->parts + j*a->partbytes;
+
+#if defined(QDP_USE_ZLIB)
+	if (a->codec == codec_shuffle_deflate)
+	{
+	  std::vector<char>& in = (*a->stored)[j];
+	  char* planes = Allocator::threadScratch<char>(a->partbytes);
+	  uLongf len = a->partbytes;
+	  int err = uncompress((Bytef*)planes, &len, (const Bytef*)in.data(), in.size());
+	  if (err == Z_OK && len != a->partbytes)
+	    err = Z_DATA_ERROR;
+	  (*a->status)[j] = err;
+	  std::vector<char>().swap(in);
+
+	  if (err != Z_OK)
+	    continue;
+	  shuffleBytes(planes, p, a->partbytes/a->size, a->size, false);
+	}
+#endif
+
+	(*a->crcs)[j] = QDPUtil::crc32(0, p, a->partbytes);
+      }
+    }
+
+    //! A site on its way to the owner of its part
+    struct LayoutSite
+    {
+      int node;       // owner of the part
+      size_t pos;     // in the concatenation of all the parts
+      int linear;     // on this node
+
+      bool operator<(const LayoutSite& b) const
+	{
+	  return (node != b.node) ? (node < b.node) : (pos < b.pos);
+	}
+    };
+  }
+
+
+  //--------------------------------------------------------------------------------
+  PartFileGeometry::PartFileGeometry(const multi1d<int>& grid) : part_grid(grid)
+  {
+    const multi1d<int>& latt = Layout::lattSize();
+    const int nodes = Layout::numNodes();
+    const int me = Layout::nodeNumber();
+
+    if (part_grid.size() != Nd)
+      QDP_error_exit("PartFile: the grid of parts needs %d entries, not %d", Nd, part_grid.size());
+
+    box.resize(Nd);
+    nparts = 1;
+    box_vol = 1;
+    bool node_boxes = true;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (part_grid[mu] < 1 || latt[mu] % part_grid[mu] != 0)
+	QDP_error_exit("PartFile: a grid of %d parts does not divide the lattice extent %d in direction %d",
+		       part_grid[mu], latt[mu], mu);
+
+      box[mu] = latt[mu] / part_grid[mu];
+      nparts *= part_grid[mu];
+      box_vol *= box[mu];
+      node_boxes = node_boxes && (box[mu] == Layout::subgridLattSize()[mu]);
+    }
+
+    // A part that is a node subgrid stays there, the others are dealt out
+    owners.resize(nparts);
+    for(int p=0; p < nparts; ++p)
+    {
+      if (node_boxes)
+      {
+	multi1d<int> origin = crtesn(p, part_grid);
+	origin *= box;
+	owners[p] = Layout::nodeNumber(origin);
+      }
+      else
+	owners[p] = int((long long)(p) * nodes / nparts);
+
+      if (owners[p] == me)
+	my_parts.push_back(p);
+    }
+
+    // The sites here, ordered by their owner and then their place in the parts
+    std::vector<LayoutSite> sites(Layout::sitesOnNode());
+    layout_count.assign(nodes, 0);
+    for(int linear=0; linear < sites.size(); ++linear)
+    {
+      size_t lex;
+      int p = partOf(Layout::siteCoords(me, linear), lex);
+
+      sites[linear].node = owners[p];
+      sites[linear].pos = size_t(p)*box_vol + lex;
+      sites[linear].linear = linear;
+      ++layout_count[owners[p]];
+    }
+    std::sort(sites.begin(), sites.end());
+
+    layout_sites.resize(sites.size());
+    for(int i=0; i < sites.size(); ++i)
+      layout_sites[i] = sites[i].linear;
+
+    // Where each site of the parts here lives
+    part_nodes.resize(my_parts.size()*box_vol);
+    part_count.assign(nodes, 0);
+    for(int j=0, k=0; j < my_parts.size(); ++j)
+    {
+      multi1d<int> origin = crtesn(my_parts[j], part_grid);
+      origin *= box;
+
+      for(size_t lex=0; lex < box_vol; ++lex, ++k)
+      {
+	multi1d<int> coord = crtesn(int(lex), box);
+	coord += origin;
+
+	part_nodes[k] = Layout::nodeNumber(coord);
+	++part_count[part_nodes[k]];
+      }
+    }
+  }
+
+
+  int PartFileGeometry::partOf(const multi1d<int>& coord, size_t& lex) const
+  {
+    multi1d<int> pc(Nd), inner(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      pc[mu] = coord[mu] / box[mu];
+      inner[mu] = coord[mu] % box[mu];
+    }
+
+    lex = local_site(inner, box);
+    return local_site(pc, part_grid);
+  }
+
+
+  std::string PartFileGeometry::partName(const std::string& stem, int p)
+  {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), ".part.%d", p);
+    return stem + buf;
+  }
+
+
+  //--------------------------------------------------------------------------------
+  PartFileWriter::~PartFileWriter()
+  {
+    if (is_open())
+      close();
+  }
+
+
+  void PartFileWriter::open(const std::string& p)
+  {
+    open(p, Layout::isIOGridDefined() ? Layout::getIONodeGrid() : Layout::logicalSize());
+  }
+
+
+  void PartFileWriter::open(const std::string& p, const multi1d<int>& grid)
+  {
+    if (is_open())
+      close();
+
+    stem = p;
+    geom = new PartFileGeometry(grid);
+    sizes.clear();
+    nmembs.clear();
+    codecs.clear();
+    keeps.clear();
+    crcs.clear();
+    lengths.clear();
+
+    const std::vector<int>& mine = geom->myParts();
+    for(int j=0; j < mine.size(); ++j)
+    {
+      std::string name = PartFileGeometry::partName(stem, mine[j]);
+      int fd = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0)
+	QDP_error_exit("PartFileWriter: cannot open %s on node %d", name.c_str(), Layout::nodeNumber());
+      fds.push_back(fd);
+    }
+    offsets.assign(mine.size(), 0);
+  }
+
+
+  void PartFileWriter::writeLattice(const char* data, size_t size, size_t nmemb, bool real)
+  {
+    if (! is_open())
+      QDP_error_exit("PartFileWriter: no set is open");
+
+    if (compress.rel_error < 0 || compress.deflate < 0 || compress.deflate > 9)
+      QDP_error_exit("PartFileWriter: bad compression, deflate level %d and relative error %g",
+		     compress.deflate, compress.rel_error);
+
+#if ! defined(QDP_USE_ZLIB)
+    if (compress.on())
+      QDP_error_exit("PartFileWriter: compression needs QDP++ configured with zlib");
+#endif
+
+    const int codec = compress.on() ? codec_shuffle_deflate : codec_plain;
+    const int mant = real ? mantissaBits(size) : 0;
+    const int keep = (mant > 0) ? keepBits(compress.rel_error, mant) : 0;
+
+    const int nodes = Layout::numNodes();
+    const size_t sizemem = size*nmemb;
+    const size_t partbytes = geom->partVol()*sizemem;
+
+    const std::vector<int>& sites = geom->layoutSites();
+    const std::vector<int>& from = geom->partNodes();
+
+    // The sites here, big-endian, in the order their owners want them
+    std::vector<char> send(sites.size()*sizemem);
+    for(int i=0; i < sites.size(); ++i)
+      QDPUtil::copy_big_endian(&send[i*sizemem], data + sites[i]*sizemem, size, nmemb);
+
+    std::vector<size_t> send_bytes(nodes), recv_bytes(nodes), cursor(nodes);
+    for(int q=0; q < nodes; ++q)
+    {
+      send_bytes[q] = geom->layoutCount()[q]*sizemem;
+      recv_bytes[q] = geom->partCount()[q]*sizemem;
+      cursor[q] = (q == 0) ? 0 : cursor[q-1] + recv_bytes[q-1];
+    }
+
+    std::vector<char> recv(from.size()*sizemem);
+    QDPInternal::exchangeAll(send.empty() ? 0 : &send[0], &send_bytes[0],
+			     recv.empty() ? 0 : &recv[0], &recv_bytes[0]);
+    std::vector<char>().swap(send);
+
+    // Put them in file order, part by part
+    std::vector<char> parts(from.size()*sizemem);
+    for(int k=0; k < from.size(); ++k)
+    {
+      memcpy(&parts[k*sizemem], &recv[cursor[from[k]]], sizemem);
+      cursor[from[k]] += sizemem;
+    }
+
+    // Round, checksum and compress the parts here, each on a thread
+    const std::vector<int>& mine = geom->myParts();
+    std::vector< std::vector<char> > stored(mine.size());
+    std::vector<unsigned int> my_crcs(mine.size());
+    std::vector<int> status(mine.size(), 0);
+
+    PartWork work = {parts.data(), partbytes, size, mant, keep, codec, std::max(compress.deflate, 1),
+		     &stored, &my_crcs, &status};
+    dispatch_to_threads(mine.size(), work, packParts);
+
+    multi1d<unsigned int> part_crcs(geom->numParts());
+    multi1d<double> part_bytes(geom->numParts());   // summed exactly below 2^53
+    part_crcs = 0;
+    part_bytes = 0;
+
+    for(int j=0; j < mine.size(); ++j)
+    {
+      std::string name = PartFileGeometry::partName(stem, mine[j]);
+      if (status[j] != 0)
+	QDP_error_exit("PartFileWriter: compressing %s failed with zlib error %d", name.c_str(), status[j]);
+
+      char* p = (codec == codec_plain) ? &parts[j*partbytes] : stored[j].data();
+      size_t len = (codec == codec_plain) ? partbytes : stored[j].size();
+      transferAll(fds[j], p, len, offsets[j], true, name);
+
+      part_crcs[mine[j]] = my_crcs[j];
+      part_bytes[mine[j]] = len;
+      offsets[j] += len;
+    }
+
+    QDPInternal::globalSumArray(&part_crcs[0], part_crcs.size());
+    QDPInternal::globalSumArray(&part_bytes[0], part_bytes.size());
+
+    multi1d<long long> part_lengths(geom->numParts());
+    for(int p=0; p < part_lengths.size(); ++p)
+      part_lengths[p] = (long long)(part_bytes[p]);
+
+    sizes.push_back(size);
+    nmembs.push_back(nmemb);
+    codecs.push_back(codec);
+    keeps.push_back((keep < mant) ? keep : -1);
+    crcs.push_back(part_crcs);
+    lengths.push_back(part_lengths);
+  }
+
+
+  void PartFileWriter::close()
+  {
+    if (! is_open())
+      return;
+
+    closeParts(fds, stem);
+
+    // The index goes out from the primary node
+    BinaryFileWriter idx(stem);
+    writeDesc(idx, partfile_magic);
+    QDP::write(idx, partfile_version);
+    QDP::write(idx, Layout::lattSize());
+    QDP::write(idx, geom->grid());
+    QDP::write(idx, int(sizes.size()));
+    for(int f=0; f < sizes.size(); ++f)
+    {
+      QDP::write(idx, int(sizes[f]));
+      QDP::write(idx, int(nmembs[f]));
+      QDP::write(idx, codecs[f]);
+      QDP::write(idx, keeps[f]);
+      QDP::write(idx, crcs[f]);
+      QDP::write(idx, lengths[f]);
+    }
+    QDPUtil::n_uint32_t checksum = idx.getChecksum();
+    QDP::write(idx, checksum);
+    idx.close();
+
+    delete geom;
+    geom = 0;
+  }
+
+
+  //--------------------------------------------------------------------------------
+  PartFileReader::~PartFileReader()
+  {
+    if (is_open())
+      close();
+  }
+
+
+  void PartFileReader::open(const std::string& p)
+  {
+    if (is_open())
+      close();
+
+    stem = p;
+    sizes.clear();
+    nmembs.clear();
+    codecs.clear();
+    keeps.clear();
+    crcs.clear();
+    lengths.clear();
+
+    BinaryFileReader idx(stem);
+
+    std::string magic;
+    readDesc(idx, magic);
+    if (magic != partfile_magic)
+      QDP_error_exit("PartFileReader: %s is not the index of a part file set", stem.c_str());
+
+    int version;
+    QDP::read(idx, version);
+    if (version < 1 || version > partfile_version)
+      QDP_error_exit("PartFileReader: %s has version %d, expected at most %d", stem.c_str(), version, partfile_version);
+
+    multi1d<int> latt, grid;
+    QDP::read(idx, latt);
+    QDP::read(idx, grid);
+    for(int mu=0; mu < Nd; ++mu)
+      if (latt.size() != Nd || latt[mu] != Layout::lattSize()[mu])
+	QDP_error_exit("PartFileReader: %s was written on another lattice size", stem.c_str());
+
+    int nfields;
+    QDP::read(idx, nfields);
+    for(int f=0; f < nfields; ++f)
+    {
+      int size, nmemb, codec = codec_plain, keep = -1;
+      multi1d<unsigned int> part_crcs;
+      multi1d<long long> part_lengths;   // version 1 parts are all plain
+      QDP::read(idx, size);
+      QDP::read(idx, nmemb);
+      if (version >= 2)
+      {
+	QDP::read(idx, codec);
+	QDP::read(idx, keep);
+      }
+      QDP::read(idx, part_crcs);
+      if (version >= 2)
+	QDP::read(idx, part_lengths);
+
+      if (codec != codec_plain && codec != codec_shuffle_deflate)
+	QDP_error_exit("PartFileReader: field %d of %s is stored in an unknown way %d", f, stem.c_str(), codec);
+#if ! defined(QDP_USE_ZLIB)
+      if (codec != codec_plain)
+	QDP_error_exit("PartFileReader: field %d of %s is compressed, which needs QDP++ configured with zlib",
+		       f, stem.c_str());
+#endif
+
+      sizes.push_back(size);
+      nmembs.push_back(nmemb);
+      codecs.push_back(codec);
+      keeps.push_back(keep);
+      crcs.push_back(part_crcs);
+      lengths.push_back(part_lengths);
+    }
+
+    QDPUtil::n_uint32_t calc_checksum = idx.getChecksum();
+    QDPUtil::n_uint32_t read_checksum;
+    QDP::read(idx, read_checksum);
+    idx.close();
+
+    if (calc_checksum != read_checksum)
+      QDP_error_exit("PartFileReader: checksum mismatch in the index %s", stem.c_str());
+
+    geom = new PartFileGeometry(grid);
+    next = 0;
+
+    for(int f=0; f < nfields; ++f)
+      if (lengths[f].size() == 0)
+      {
+	lengths[f].resize(geom->numParts());
+	lengths[f] = (long long)(geom->partVol()*sizes[f]*nmembs[f]);
+      }
+
+    const std::vector<int>& mine = geom->myParts();
+    for(int j=0; j < mine.size(); ++j)
+    {
+      std::string name = PartFileGeometry::partName(stem, mine[j]);
+      int fd = ::open(name.c_str(), O_RDONLY);
+      if (fd < 0)
+	QDP_error_exit("PartFileReader: cannot open %s on node %d", name.c_str(), Layout::nodeNumber());
+      fds.push_back(fd);
+    }
+    offsets.assign(mine.size(), 0);
+  }
+
+
+  void PartFileReader::readLattice(char* data, size_t size, size_t nmemb)
+  {
+    if (! is_open())
+      QDP_error_exit("PartFileReader: no set is open");
+
+    if (next >= sizes.size())
+      QDP_error_exit("PartFileReader: all %d fields of %s have been read", int(sizes.size()), stem.c_str());
+
+    if (size != sizes[next] || nmemb != nmembs[next])
+      QDP_error_exit("PartFileReader: field %d of %s has %d words of %d bytes a site, not %d of %d",
+		     next, stem.c_str(), int(nmembs[next]), int(sizes[next]), int(nmemb), int(size));
+
+    const int nodes = Layout::numNodes();
+    const size_t sizemem = size*nmemb;
+    const size_t partbytes = geom->partVol()*sizemem;
+
+    const std::vector<int>& sites = geom->layoutSites();
+    const std::vector<int>& to = geom->partNodes();
+
+    const int codec = codecs[next];
+
+    // Read the parts here, then inflate and checksum them each on a thread
+    std::vector<char> parts(to.size()*sizemem);
+
+    const std::vector<int>& mine = geom->myParts();
+    std::vector< std::vector<char> > stored(mine.size());
+    std::vector<unsigned int> my_crcs(mine.size());
+    std::vector<int> status(mine.size(), 0);
+
+    for(int j=0; j < mine.size(); ++j)
+    {
+      size_t len = lengths[next][mine[j]];
+      if (codec == codec_plain && len != partbytes)
+	QDP_error_exit("PartFileReader: part %d of field %d of %s has %lu bytes, not %lu",
+		       mine[j], next, stem.c_str(), (unsigned long)len, (unsigned long)partbytes);
+
+      char* p = &parts[j*partbytes];
+      if (codec != codec_plain)
+      {
+	stored[j].resize(len);
+	p = stored[j].data();
+      }
+
+      transferAll(fds[j], p, len, offsets[j], false, PartFileGeometry::partName(stem, mine[j]));
+      offsets[j] += len;
+    }
+
+    PartWork work = {parts.data(), partbytes, size, 0, 0, codec, 0, &stored, &my_crcs, &status};
+    dispatch_to_threads(mine.size(), work, unpackParts);
+
+    for(int j=0; j < mine.size(); ++j)
+    {
+      std::string name = PartFileGeometry::partName(stem, mine[j]);
+      if (status[j] != 0)
+	QDP_error_exit("PartFileReader: inflating field %d of %s failed with zlib error %d", next, name.c_str(), status[j]);
+
+      if (my_crcs[j] != crcs[next][mine[j]])
+	QDP_error_exit("PartFileReader: checksum mismatch in field %d of %s", next, name.c_str());
+    }
+
+    // Sort them by the node they live on, keeping file order
+    std::vector<size_t> send_bytes(nodes), recv_bytes(nodes), cursor(nodes);
+    for(int q=0; q < nodes; ++q)
+    {
+      send_bytes[q] = geom->partCount()[q]*sizemem;
+      recv_bytes[q] = geom->layoutCount()[q]*sizemem;
+      cursor[q] = (q == 0) ? 0 : cursor[q-1] + send_bytes[q-1];
+    }
+
+    std::vector<char> send(to.size()*sizemem);
+    for(int k=0; k < to.size(); ++k)
+    {
+      memcpy(&send[cursor[to[k]]], &parts[k*sizemem], sizemem);
+      cursor[to[k]] += sizemem;
+    }
+    std::vector<char>().swap(parts);
+
+    std::vector<char> recv(sites.size()*sizemem);
+    QDPInternal::exchangeAll(send.empty() ? 0 : &send[0], &send_bytes[0],
+			     recv.empty() ? 0 : &recv[0], &recv_bytes[0]);
+
+    for(int i=0; i < sites.size(); ++i)
+      QDPUtil::copy_big_endian(data + sites[i]*sizemem, &recv[i*sizemem], size, nmemb);
+
+    ++next;
+  }
+
+
+  void PartFileReader::close()
+  {
+    if (! is_open())
+      return;
+
+    closeParts(fds, stem);
+
+    delete geom;
+    geom = 0;
+  }
+
+} // namespace QDP
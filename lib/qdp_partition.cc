@@ -0,0 +1,199 @@
+/*! @file
+ * @brief Thread partitions of subsets, cached and optionally rebalanced
+ */
+
+#include "qdp.h"
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace QDP
+{
+  namespace Partition
+  {
+    namespace
+    {
+      //! The partitions of a subset for one site size and thread count
+      struct Entry
+      {
+	std::vector<int> aligned;
+	std::vector<int> balanced;
+	std::vector<double> secs;   //!< slot times summed over the window
+	int calls;                  //!< dispatches in the window
+      };
+
+      //! Site table, sites, threads, site bytes, run order
+      typedef std::tuple<const void*, int, int, int, bool> Key;
+
+      bool balance_on = false;
+      std::mutex part_lock;
+      std::map<Key, Entry> table;
+
+      //! Dispatches timed before the bounds are moved
+      const int window = 4;
+
+      //! Slot times further apart than this are rebalanced
+      const double tolerance = 1.05;
+
+      int gcd(int a, int b)
+      {
+	while (b) {int t = a % b; a = b; b = t;}
+	return a;
+      }
+
+      Key makeKey(const Subset& s, int bytes)
+      {
+	const void* tab = s.hasRuns() ? (const void*)s.runTable().slice() : (const void*)s.siteTable().slice();
+	return Key(tab, s.numSiteTable(), qdpNumThreads(), bytes, s.loopsByRuns());
+      }
+
+      //! Sites per granule of L bytes
+      int granule(int bytes, int L) {return L/gcd(L, bytes);}
+
+      //! Move position p down to where a granule of sites starts
+      int alignPos(const Subset& s, int p, int g)
+      {
+	if (g <= 1 || p <= 0 || p >= s.numSiteTable())
+	  return p;
+
+	if (! s.loopsByRuns())
+	  return p - p % g;
+
+	// The run holding position p
+	const multi1d<SiteRun>& runs = s.runTable();
+	int lo = 0, hi = s.numRuns();
+	while (hi - lo > 1)
+	{
+	  const int mid = (lo + hi)/2;
+	  if (runs[mid].pos <= p)
+	    lo = mid;
+	  else
+	    hi = mid;
+	}
+
+	// Round the site down, or start at the run when that leaves it
+	const int site = runs[lo].site + (p - runs[lo].pos);
+	const int a = site - site % g;
+	return (a >= runs[lo].site) ? runs[lo].pos + (a - runs[lo].site) : runs[lo].pos;
+      }
+
+      //! Align the inner bounds and keep them in order
+      void alignBounds(const Subset& s, int bytes, std::vector<int>& b)
+      {
+	const int n = s.numSiteTable();
+	const int nthr = b.size() - 1;
+
+	// Pages when each thread gets several, cache lines otherwise
+	int g = granule(bytes, 4096);
+	if (n/nthr < 4*g)
+	  g = granule(bytes, 64);
+
+	b[0] = 0;
+	for(int t=1; t < nthr; ++t)
+	{
+	  b[t] = alignPos(s, b[t], g);
+	  if (b[t] < b[t-1])
+	    b[t] = b[t-1];
+	}
+	b[nthr] = n;
+      }
+
+      Entry& lookup(const Subset& s, int bytes)
+      {
+	const Key key = makeKey(s, bytes);
+	std::map<Key, Entry>::iterator p = table.find(key);
+	if (p != table.end())
+	  return p->second;
+
+	const int n = s.numSiteTable();
+	const int nthr = qdpNumThreads();
+
+	Entry& e = table[key];
+	e.aligned.resize(nthr+1);
+	for(int t=0; t <= nthr; ++t)
+	  e.aligned[t] = int((long(n)*t)/nthr);
+	alignBounds(s, bytes, e.aligned);
+
+	e.balanced = e.aligned;
+	e.secs.assign(nthr, 0.0);
+	e.calls = 0;
+	return e;
+      }
+    }
+
+
+    void setRebalance(bool on) {balance_on = on;}
+
+    bool rebalance() {return balance_on;}
+
+
+    const std::vector<int>& bounds(const Subset& s, int bytes, Kind kind)
+    {
+      std::lock_guard<std::mutex> lock(part_lock);
+      Entry& e = lookup(s, bytes);
+      return (kind == BALANCED) ? e.balanced : e.aligned;
+    }
+
+
+    void record(const Subset& s, int bytes, const std::vector<double>& secs)
+    {
+      std::lock_guard<std::mutex> lock(part_lock);
+      Entry& e = lookup(s, bytes);
+      const int nthr = e.secs.size();
+      if (secs.size() != nthr)
+	return;
+
+      for(int t=0; t < nthr; ++t)
+	e.secs[t] += secs[t];
+      if (++e.calls < window)
+	return;
+
+      double total = 0, most = 0;
+      for(int t=0; t < nthr; ++t)
+      {
+	total += e.secs[t];
+	most = std::max(most, e.secs[t]);
+      }
+
+      if (total > 0 && most*nthr > tolerance*total)
+      {
+	// Invert the cumulative cost, linear within each slot
+	std::vector<int> b(nthr+1);
+	const std::vector<int>& old = e.balanced;
+	int slot = 0;
+	double below = 0;
+	for(int t=1; t < nthr; ++t)
+	{
+	  const double target = total*t/nthr;
+	  while (slot < nthr-1 && below + e.secs[slot] < target)
+	    below += e.secs[slot++];
+
+	  const double f = (e.secs[slot] > 0) ? (target - below)/e.secs[slot] : 0.0;
+	  const int nb = old[slot] + int(f*(old[slot+1] - old[slot]));
+
+	  // Half way, so a noisy window does not swing the bounds
+	  b[t] = (old[t] + nb)/2;
+	}
+	alignBounds(s, bytes, b);
+	e.balanced = b;
+      }
+
+      e.secs.assign(nthr, 0.0);
+      e.calls = 0;
+    }
+
+
+    void clear()
+    {
+      std::lock_guard<std::mutex> lock(part_lock);
+      table.clear();
+    }
+
+
+    int numEntries()
+    {
+      std::lock_guard<std::mutex> lock(part_lock);
+      return table.size();
+    }
+  }
+}
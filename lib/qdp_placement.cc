@@ -0,0 +1,312 @@
+/*! @file
+ * @brief NUMA placement of lattice storage, pool settings and the fast tier
+ *
+ * Threads touch, and optionally bind, the pages of the sites they get in
+ * evaluate, so on multi-socket nodes each thread streams local memory.
+ *
+ * Storage hinted FAST is mapped on its own and bound, preferred rather
+ * than strictly, to the NUMA node of the fast memory, so the kernel
+ * still gives normal pages when the tier runs out. The budget of
+ * setFastMemory is kept here; past it the allocators fall back.
+ */
+
+#include "qdp.h"
+#include <mutex>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#endif
+
+#if defined(QDP_USE_MEMKIND)
+#include <hbwmalloc.h>
+#endif
+
+namespace QDP
+{
+  namespace Allocator
+  {
+    namespace
+    {
+      LatticePlacement placement = PLACE_LAZY;
+      PoolPages pool_pages = POOL_PAGES_DEFAULT;
+      size_t pool_growth = size_t(1) << 30;
+      bool copy_on_write = false;
+
+      // The fast tier
+      bool fast_on = false;
+      int fast_node = -1;          // -1 for memkind
+      size_t fast_limit = 0;       // 0 for none
+      size_t fast_used = 0;
+      std::mutex fast_lock;
+
+      __thread MemoryPoolHint lattice_hint = DEFAULT;
+
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+      // From linux/mempolicy.h
+      const int mpol_preferred = 1;
+      const unsigned mpol_mf_move = (1<<1);
+
+      //! Bind [lo,hi) to the node the calling thread runs on
+      void bindToLocalNode(unsigned char* lo, unsigned char* hi)
+      {
+	unsigned cpu, node;
+	if (syscall(SYS_getcpu, &cpu, &node, 0) != 0)
+	  return;
+
+	const int bits = 8*sizeof(unsigned long);
+	unsigned long mask[16] = {0};
+	if (node >= 16*bits)
+	  return;
+	mask[node/bits] = 1UL << (node % bits);
+
+	// Best effort - a failure leaves the first-touch placement
+	syscall(SYS_mbind, lo, hi-lo, mpol_preferred, mask, 16*bits, mpol_mf_move);
+      }
+
+      //! Prefer node for the untouched pages of [p,p+bytes)
+      bool preferNode(void* p, size_t bytes, int node)
+      {
+	const int bits = 8*sizeof(unsigned long);
+	unsigned long mask[16] = {0};
+	if (node < 0 || node >= 16*bits)
+	  return false;
+	mask[node/bits] = 1UL << (node % bits);
+
+	return syscall(SYS_mbind, p, bytes, mpol_preferred, mask, 16*bits, 0) == 0;
+      }
+#else
+      void bindToLocalNode(unsigned char* lo, unsigned char* hi) {}
+
+      bool preferNode(void* p, size_t bytes, int node) {return false;}
+#endif
+
+      //! user argument for the touch
+      struct PlaceArgs
+      {
+	unsigned char* base;
+	size_t site_bytes;
+	size_t page;
+	bool bind;
+      };
+
+      //! user function for the touch
+      /*! Each thread handles the pages that start inside its own sites */
+      void placeKernel(int lo, int hi, int myId, PlaceArgs* a)
+      {
+	unsigned char* start = a->base + lo*a->site_bytes;
+	unsigned char* end   = a->base + hi*a->site_bytes;
+
+	unsigned long first = ((unsigned long)start + a->page - 1) & ~(a->page - 1);
+	if (lo == 0)
+	  first = (unsigned long)start;
+
+	unsigned char* p = (unsigned char*)first;
+	unsigned char* q = (unsigned char*)(((unsigned long)end + a->page - 1) & ~(a->page - 1));
+	if (p >= end)
+	  return;
+
+	if (a->bind)
+	  bindToLocalNode((unsigned char*)((unsigned long)p & ~(a->page - 1)), q);
+
+	for(; p < end; p = (unsigned char*)(((unsigned long)p + a->page) & ~(a->page - 1)))
+	  *(volatile unsigned char*)p = 0;
+      }
+
+      size_t pageSize()
+      {
+#if defined(__linux__)
+	long page = sysconf(_SC_PAGESIZE);
+	if (page > 0)
+	  return page;
+#endif
+	return 4096;
+      }
+    }
+
+
+    void setLatticePlacement(LatticePlacement p)
+    {
+      placement = p;
+    }
+
+
+    LatticePlacement getLatticePlacement()
+    {
+      return placement;
+    }
+
+
+    void setLatticeCopyOnWrite(bool on)
+    {
+      copy_on_write = on;
+    }
+
+
+    bool latticeCopyOnWrite()
+    {
+      return copy_on_write;
+    }
+
+
+    void setPoolPages(PoolPages p)
+    {
+      pool_pages = p;
+    }
+
+
+    PoolPages getPoolPages()
+    {
+      return pool_pages;
+    }
+
+
+    void setPoolGrowth(size_t bytes)
+    {
+      pool_growth = bytes;
+    }
+
+
+    size_t getPoolGrowth()
+    {
+      return pool_growth;
+    }
+
+
+    void setFastMemory(int numa_node, size_t limit_bytes)
+    {
+#if ! defined(QDP_USE_MEMKIND)
+      if (numa_node < 0)
+	QDP_error_exit("setFastMemory: high bandwidth memory needs a build --with-memkind");
+#else
+      if (numa_node < 0 && hbw_check_available() != 0)
+      {
+	QDPIO::cout << "setFastMemory: memkind finds no high bandwidth memory - FAST is ignored" << std::endl;
+	return;
+      }
+#endif
+      std::lock_guard<std::mutex> lock(fast_lock);
+      fast_on = true;
+      fast_node = numa_node;
+      fast_limit = limit_bytes;
+    }
+
+
+    bool fastMemory()
+    {
+      return fast_on;
+    }
+
+
+    void* fastAllocate(size_t bytes)
+    {
+      if (! fast_on)
+	return 0;
+
+      std::lock_guard<std::mutex> lock(fast_lock);
+
+      const size_t page = pageSize();
+      const size_t len = (bytes + page - 1) & ~(page - 1);
+      if (fast_limit > 0 && fast_used + len > fast_limit)
+      {
+	Stats::noteFastFallback(bytes);
+	return 0;
+      }
+
+      void* p = 0;
+#if defined(QDP_USE_MEMKIND)
+      if (fast_node < 0)
+      {
+	if (hbw_posix_memalign(&p, page, len) != 0)
+	  p = 0;
+      }
+      else
+#endif
+#if defined(__linux__)
+      {
+	p = mmap(0, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED)
+	  p = 0;
+	else if (! preferNode(p, len, fast_node))
+	{
+	  munmap(p, len);
+	  p = 0;
+	}
+      }
+#endif
+
+      if (p == 0)
+      {
+	Stats::noteFastFallback(bytes);
+	return 0;
+      }
+
+      fast_used += len;
+      Stats::noteFastAlloc(len);
+      return p;
+    }
+
+
+    void fastFree(void* p, size_t bytes)
+    {
+      if (p == 0)
+	return;
+
+      std::lock_guard<std::mutex> lock(fast_lock);
+
+      const size_t page = pageSize();
+      const size_t len = (bytes + page - 1) & ~(page - 1);
+
+#if defined(QDP_USE_MEMKIND)
+      if (fast_node < 0)
+	hbw_free(p);
+      else
+#endif
+#if defined(__linux__)
+	munmap(p, len);
+#endif
+
+      fast_used -= len;
+      Stats::noteFastFree(len);
+    }
+
+
+    MemoryPoolHint latticeHint()
+    {
+      return lattice_hint;
+    }
+
+
+    FastMemoryScope::FastMemoryScope() : prev(lattice_hint)
+    {
+      lattice_hint = FAST;
+    }
+
+
+    FastMemoryScope::~FastMemoryScope()
+    {
+      lattice_hint = prev;
+    }
+
+
+    void placeLatticeMem(void* mem, size_t site_bytes, size_t nsites, MemoryPoolHint hint)
+    {
+      if (placement == PLACE_LAZY && hint != NUMA_LOCAL)
+	return;
+
+      if (mem == 0 || nsites == 0)
+	return;
+
+      PlaceArgs a;
+      a.base = (unsigned char*)mem;
+      a.site_bytes = site_bytes;
+      a.page = pageSize();
+      // Binding would take FAST storage out of its tier
+      a.bind = (placement == PLACE_BIND && hint != FAST) || hint == NUMA_LOCAL;
+
+      dispatch_to_threads(int(nsites), a, placeKernel);
+    }
+
+  } // namespace Allocator
+} // namespace QDP
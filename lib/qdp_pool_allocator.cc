@@ -1,5 +1,12 @@
 /*! @file
  * @brief QCDOC memory allocator
+ *
+ * Blocks are carved from arenas, each a tbb::fixed_pool over its own
+ * mapping. The first arena is the pool of -poolsize. When no arena has
+ * room, even with the cache flushed, another arena is mapped, of at least
+ * the growth step of setPoolGrowth. Grown arenas that empty go back to
+ * the OS, keeping one spare so a stage that grows and shrinks every
+ * iteration does not map it again each time.
  */
 
 #include "qdp.h"
@@ -7,9 +14,10 @@
 #include "qdp_default_allocator.h"
 #include "qdp_pool_allocator.h"
 #include <vector>
-#include <map>
 #include <new>
 #include <cstdio>
+#include <cstdlib>
+#include <sys/mman.h>
 
 
 #undef DEBUG_POOL_ALLOCATOR
@@ -17,77 +25,293 @@
 namespace QDP {
 namespace Allocator {
 
-	QDPPoolAllocator::QDPPoolAllocator() : _PoolSize(0),
-					       _MyMem(nullptr), _LargePool(nullptr) {}
+	QDPPoolAllocator::QDPPoolAllocator() : _PoolSize(0), _NumArenas(0),
+					       _CacheHits(0), _PoolCalls(0), _Grows(0)
+	{
+		for(int k=0; k < MaxArenas; ++k) {
+			_Arenas[k].Mem = nullptr;
+			_Arenas[k].Pool = nullptr;
+		}
+	}
 
 
 	QDPPoolAllocator::~QDPPoolAllocator() {
-		if ( _LargePool ) delete _LargePool;
-		if ( _MyMem ) {
-			delete [] _MyMem;
-		}
-		_LargePool = nullptr;
-		_MyMem = nullptr;
+		// The cached blocks live inside the arenas, so they go with them
+		for(int k=0; k < _NumArenas; ++k)
+			freeArena(_Arenas[k]);
+		_NumArenas = 0;
 		_PoolSize = 0;
 	}
 
+#if ! defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT 26
+#endif
+
+	// Get bytes for the arena a, trying the requested pages first
+	// and falling back one step at a time
+	bool
+	QDPPoolAllocator::allocArena(PoolArena& a, size_t bytes, PoolPages pages, bool verbose)
+	{
+		a.Mem = nullptr;
+		a.Bytes = bytes;
+		a.Pool = nullptr;
+		a.Live = 0;
+		a.LiveBytes = 0;
+
+#if defined(MAP_HUGETLB)
+		const int   huge_shift[] = { 30, 21 };
+		const char* huge_name[]  = { "1 GiB", "2 MiB" };
+		for(int k=(pages == POOL_PAGES_HUGE_1G ? 0 : 1); k < 2 && pages >= POOL_PAGES_HUGE_2M; ++k) {
+			size_t page = size_t(1) << huge_shift[k];
+			size_t huge_bytes = (bytes + page - 1) & ~(page - 1);
+			void* p = mmap(nullptr, huge_bytes, PROT_READ|PROT_WRITE,
+				       MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB|(huge_shift[k] << MAP_HUGE_SHIFT), -1, 0);
+			if ( p != MAP_FAILED ) {
+				a.Mem = (unsigned char *)p;
+				a.Kind = ARENA_MMAP;
+				a.Bytes = huge_bytes;
+				if ( verbose )
+					QDPIO::cout << "Pool backed by " << huge_name[k] << " huge pages" << std::endl;
+				break;
+			}
+			if ( verbose )
+				QDPIO::cout << "Unable to map " << huge_bytes << " bytes of " << huge_name[k]
+					    << " huge pages - are enough reserved?" << std::endl;
+		}
+		if ( a.Mem == nullptr && pages >= POOL_PAGES_HUGE_2M ) pages = POOL_PAGES_THP;
+#endif
+
+#if defined(MADV_HUGEPAGE)
+		if ( a.Mem == nullptr && pages == POOL_PAGES_THP ) {
+			const size_t page = size_t(1) << 21;
+			void* p = nullptr;
+			if ( posix_memalign(&p, page, bytes) == 0 ) {
+				a.Mem = (unsigned char *)p;
+				a.Kind = ARENA_MALLOC;
+				if ( madvise(p, bytes, MADV_HUGEPAGE) == 0 ) {
+					if ( verbose )
+						QDPIO::cout << "Pool backed by transparent huge pages" << std::endl;
+				}
+				else if ( verbose )
+					QDPIO::cout << "madvise(MADV_HUGEPAGE) failed - pool uses normal pages" << std::endl;
+			}
+		}
+#endif
+
+		if ( a.Mem == nullptr ) {
+			if ( pages != POOL_PAGES_DEFAULT && verbose )
+				QDPIO::cout << "Huge pages not available - pool uses normal pages" << std::endl;
+
+			a.Mem = new (std::nothrow) unsigned char [ bytes ];
+			a.Kind = ARENA_NEW;
+		}
+		if ( a.Mem == nullptr )
+			return false;
+
+		a.Pool = new (std::nothrow) tbb::fixed_pool((void *)a.Mem, a.Bytes);
+		if ( a.Pool == nullptr ) {
+			freeArena(a);
+			return false;
+		}
+
+		Stats::notePoolArena(a.Bytes);
+		return true;
+	}
+
+	void
+	QDPPoolAllocator::freeArena(PoolArena& a)
+	{
+		if ( a.Mem == nullptr ) return;
+
+		delete a.Pool;
+		a.Pool = nullptr;
+
+		switch( a.Kind ) {
+		case ARENA_MMAP:
+			munmap(a.Mem, a.Bytes);
+			break;
+		case ARENA_MALLOC:
+			std::free(a.Mem);
+			break;
+		default:
+			delete [] a.Mem;
+		}
+		Stats::notePoolArenaFree(a.Bytes);
+		a.Mem = nullptr;
+		a.Bytes = 0;
+	}
+
 	void
 	QDPPoolAllocator::init(size_t PoolSizeInMB)
 	{
 
 		QDPIO::cout << "Initializing TBB Pool Allocator" << std::endl;
-		if( _MyMem != nullptr ) {
+		if( _NumArenas != 0 ) {
 			QDPIO::cout << "Allocator Already Inited. Aborting" << std::endl;
 			QDP_abort(1);
 		}
-		theAllocMap.clear();
+
+		// Reserve the bins now so caching a block never allocates
+		for(int b=0; b < NumCacheBins; ++b) {
+			_Cache[b].Size = 0;
+			_Cache[b].Blocks.clear();
+			_Cache[b].Blocks.reserve(MaxBlocksPerBin);
+		}
 
 		QDPIO::cout << std::flush;
 		_PoolSize = PoolSizeInMB*1024*1024;
 
 		QDPIO::cout << "Intializing TBB Fixed Pool Allocator: Allocating " << PoolSizeInMB << " MB"  << std::endl;
 
-		_MyMem = new (std::nothrow) unsigned char [ _PoolSize ];
-		if ( _MyMem == nullptr) {
+		if ( ! allocArena(_Arenas[0], _PoolSize, getPoolPages(), true) ) {
 			QDPIO::cout << "Unable to allocate " << _PoolSize <<" bytes" << std::endl;
 			QDPIO::cout << "Aborting" <<std::endl;
 			QDP_abort(1);
 		}
+		_NumArenas = 1;
+
+		if ( getPoolGrowth() > 0 )
+			QDPIO::cout << "Pool grows by at least " << getPoolGrowth()/(1024*1024) << " MB when full" << std::endl;
+	}
 
-		_LargePool = new (std::nothrow ) tbb::fixed_pool((void *)_MyMem, _PoolSize);
-		if ( _LargePool == nullptr) {
-				QDPIO::cout << "Unable to allocate fixed pool" << std::endl;
-				QDPIO::cout << "Aborting" <<std::endl;
-				QDP_abort(1);
+	// Find the bin holding blocks of n_bytes. Failing that hand back an
+	// empty bin, which the caller may claim for this size, or nullptr.
+	PoolCacheBin*
+	QDPPoolAllocator::findBin(size_t n_bytes)
+	{
+		PoolCacheBin* spare = nullptr;
+		for(int b=0; b < NumCacheBins; ++b) {
+			if ( _Cache[b].Size == n_bytes ) return &_Cache[b];
+			if ( spare == nullptr && _Cache[b].Blocks.empty() ) spare = &_Cache[b];
 		}
+		return spare;
+	}
+
+	// Map another arena with room for bytes and take them from it
+	unsigned char*
+	QDPPoolAllocator::growLocked(size_t bytes, int& arena)
+	{
+		const size_t step = getPoolGrowth();
+		if ( step == 0 ) return nullptr;
+
+		// A released slot, or a new one
+		int k = 0;
+		while ( k < _NumArenas && _Arenas[k].Mem != nullptr ) ++k;
+		if ( k == MaxArenas ) return nullptr;
+
+		// Room for the pool's own bookkeeping besides the block
+		const size_t want = std::max(step, bytes + bytes/16 + (size_t(1) << 20));
+		if ( ! allocArena(_Arenas[k], want, getPoolPages(), false) ) return nullptr;
+		if ( k == _NumArenas ) ++_NumArenas;
+		++_Grows;
+
+		arena = k;
+		return (unsigned char *)(_Arenas[k].Pool->malloc(bytes));
+	}
+
+	// Give grown arenas with no live blocks back to the OS, all but keep
+	void
+	QDPPoolAllocator::releaseEmptyLocked(int keep)
+	{
+		for(int k=1; k < _NumArenas; ++k)
+			if ( k != keep && _Arenas[k].Mem != nullptr && _Arenas[k].Live == 0 )
+				freeArena(_Arenas[k]);
+
+		while ( _NumArenas > 1 && _Arenas[_NumArenas-1].Mem == nullptr ) --_NumArenas;
+	}
+
+	// Return a block to the pool of its arena
+	void
+	QDPPoolAllocator::freeBlockLocked(const PoolMemInfo* d)
+	{
+		PoolArena& a = _Arenas[d->Arena];
+		a.Pool->free(d->Unaligned);
+		--a.Live;
+		a.LiveBytes -= d->Size + QDP_ALIGNMENT_SIZE + sizeof(PoolMemInfo);
+
+		// Keep the arena that just emptied as the spare
+		if ( d->Arena > 0 && a.Live == 0 )
+			releaseEmptyLocked(d->Arena);
 	}
 
 	void*
 	QDPPoolAllocator::allocate(size_t n_bytes,
 				const MemoryPoolHint& mem_pool_hint=DEFAULT)
 	{
+	    // Room for the descriptor in front of the aligned block
 	    size_t BytesToAlloc;
 	    BytesToAlloc = n_bytes;
-	    BytesToAlloc += QDP_ALIGNMENT_SIZE;
+	    BytesToAlloc += QDP_ALIGNMENT_SIZE + sizeof(PoolMemInfo);
+
+	    std::lock_guard<std::mutex> lock(_Lock);
+
+	    // The fast tier keeps its own pages, and its blocks are not cached
+	    if ( mem_pool_hint == FAST ) {
+	      unsigned char* Unaligned = (unsigned char *)fastAllocate(BytesToAlloc);
+	      if ( Unaligned != nullptr ) {
+		unsigned char* Aligned = (unsigned char *)
+		  ( ( (unsigned long)Unaligned + sizeof(PoolMemInfo) + (QDP_ALIGNMENT_SIZE-1) ) & ~(QDP_ALIGNMENT_SIZE - 1));
+		PoolMemInfo* d = (PoolMemInfo *)Aligned - 1;
+		d->Size = n_bytes;
+		d->Unaligned = Unaligned;
+		d->Fast = true;
+		d->Arena = -1;
+
+		Stats::noteAlloc(n_bytes);
+		return (void *)Aligned;
+	      }
+	    }
+
+	    // Steady state: reuse a block of the same size
+	    PoolCacheBin* bin = findBin(n_bytes);
+	    if ( bin != nullptr && bin->Size == n_bytes && ! bin->Blocks.empty() ) {
+	      unsigned char* Aligned = bin->Blocks.back();
+	      bin->Blocks.pop_back();
+	      ++_CacheHits;
+	      Stats::noteAlloc(n_bytes);
+	      return (void *)Aligned;
+	    }
+
+	    // The first arena, then the grown ones, then the same once the
+	    // cache has given its blocks back, and last a new arena
+	    unsigned char* Unaligned = nullptr;
+	    int arena = 0;
+	    for(int pass=0; pass < 2 && Unaligned == nullptr; ++pass) {
+	      if ( pass == 1 ) flushCacheLocked();
+	      for(int k=0; k < _NumArenas && Unaligned == nullptr; ++k)
+		if ( _Arenas[k].Mem != nullptr ) {
+		  Unaligned = (unsigned char *)(_Arenas[k].Pool->malloc(BytesToAlloc));
+		  arena = k;
+		}
+	    }
 
+	    if ( Unaligned == nullptr )
+	      Unaligned = growLocked(BytesToAlloc, arena);
 
-	    unsigned char* Unaligned = (unsigned char *)(_LargePool->malloc(BytesToAlloc));
+	    if ( Unaligned == nullptr ) {
+	      Stats::noteFailure(n_bytes);
+	      QDPIO::cerr << "PoolAlloc::allocate: unable to allocate " << n_bytes << " bytes from the pool" << std::endl;
+	      printAllocStats();
+	      QDP_abort(1);
+	    }
+	    ++_PoolCalls;
+	    ++_Arenas[arena].Live;
+	    _Arenas[arena].LiveBytes += BytesToAlloc;
 
 	    unsigned char* Aligned = (unsigned char *)
-	    				( ( (unsigned long)Unaligned + (QDP_ALIGNMENT_SIZE-1) ) & ~(QDP_ALIGNMENT_SIZE - 1));
+	    				( ( (unsigned long)Unaligned + sizeof(PoolMemInfo) + (QDP_ALIGNMENT_SIZE-1) ) & ~(QDP_ALIGNMENT_SIZE - 1));
 
 #ifdef DEBUG_POOL_ALLOCATOR
 	    QDPIO::cout << " Allocated: " << BytesToAlloc << " Bytes, Unaligend=" <<(unsigned long) Unaligned
-	    			<< " Aligned=" << (unsigned long) Aligned << std::endl;
+	    			<< " Aligned=" << (unsigned long) Aligned << " arena=" << arena << std::endl;
 #endif
-	    // Insert into the map
-	    auto r = theAllocMap.insert(std::make_pair(Aligned, PoolMemInfo{BytesToAlloc,Unaligned}));
+	    PoolMemInfo* d = (PoolMemInfo *)Aligned - 1;
+	    d->Size = n_bytes;
+	    d->Unaligned = Unaligned;
+	    d->Fast = false;
+	    d->Arena = arena;
 
-	    // Check success of insertion.
-	    if( ! r.second ) {
-	      //QDPIO::cerr << "Failed to insert (unaligned,aligned) pair into map" << std::endl;
-	      QDP_abort(1);
-	    }
+	    Stats::noteAlloc(n_bytes);
 
 	    // Return the aligned pointer
 	    return (void *)Aligned;
@@ -95,46 +319,113 @@ namespace Allocator {
 
 	void QDPPoolAllocator::free(void *mem)
 	{
-		try {
-			// Look it up.
-			auto d = theAllocMap[(unsigned char *)mem];
-#ifdef DEBUG_POOL_ALLOCATOR
-			QDPIO::cout << "PoolAlloc::free: Descriptor Found: Size="<< d.Size
-						<< "  Unaligned =" << std::hex <<(unsigned long)d.Unaligned << std::endl;
-#endif
+		if ( mem == nullptr ) return;
+
+		std::lock_guard<std::mutex> lock(_Lock);
 
-			_LargePool->free(d.Unaligned);
+		const PoolMemInfo* d = (const PoolMemInfo *)mem - 1;
+		if ( d->Fast ) {
+			Stats::noteFree(d->Size);
+			fastFree(d->Unaligned, d->Size + QDP_ALIGNMENT_SIZE + sizeof(PoolMemInfo));
+			return;
+		}
 
 #ifdef DEBUG_POOL_ALLOCATOR
-			QDPIO::cout << "PoolAlloc::free: Erasing Addr from theAllocMap... ";
+		QDPIO::cout << "PoolAlloc::free: Descriptor Found: Size="<< d->Size
+			    << "  Unaligned =" << std::hex <<(unsigned long)d->Unaligned << std::endl;
 #endif
+		Stats::noteFree(d->Size);
 
-			// Delete _InUseMap entry
-			theAllocMap.erase((unsigned char *)mem);
+		// Keep it for the next temporary of this size if there is room.
+		// Blocks of grown arenas go straight back, so the arena can empty.
+		PoolCacheBin* bin = (d->Arena == 0) ? findBin(d->Size) : nullptr;
+		if ( bin != nullptr && bin->Blocks.size() < MaxBlocksPerBin ) {
+			bin->Size = d->Size;
+			bin->Blocks.push_back((unsigned char *)mem);
+			return;
+		}
 
-#ifdef DEBUG_POOL_ALLOCATOR
-			QDPIO::cout << " ... done" <<std::endl;
-#endif
+		freeBlockLocked(d);
+	}
+
+	void QDPPoolAllocator::flushCacheLocked()
+	{
+		for(int b=0; b < NumCacheBins; ++b) {
+			std::vector<unsigned char*>& blocks = _Cache[b].Blocks;
+			for(size_t i=0; i < blocks.size(); ++i)
+				freeBlockLocked((const PoolMemInfo *)blocks[i] - 1);
+			blocks.clear();
+			_Cache[b].Size = 0;
 		}
-		catch(...) {
-			//QDPIO::cout << "QDPPoolAllocate::free threw exception" << std::endl;
-			QDP_abort(1);
+	}
+
+	void QDPPoolAllocator::flushCache()
+	{
+		std::lock_guard<std::mutex> lock(_Lock);
+		flushCacheLocked();
+		releaseEmptyLocked(-1);
+	}
+
+	void QDPPoolAllocator::fragmentation(size_t& free_bytes, size_t& largest_block)
+	{
+		std::lock_guard<std::mutex> lock(_Lock);
+
+		free_bytes = 0;
+		largest_block = 0;
+		for(int k=0; k < _NumArenas; ++k) {
+			PoolArena& a = _Arenas[k];
+			if ( a.Mem == nullptr ) continue;
+
+			const size_t avail = a.Bytes - a.LiveBytes;
+			free_bytes += avail;
+
+			// Bisect on what the pool still gives, to a page
+			size_t lo = 0, hi = avail;
+			while ( hi - lo > 4096 ) {
+				size_t mid = lo + (hi - lo)/2;
+				void* p = a.Pool->malloc(mid);
+				if ( p != nullptr ) {
+					a.Pool->free(p);
+					lo = mid;
+				}
+				else
+					hi = mid;
+			}
+			largest_block = std::max(largest_block, lo);
 		}
 	}
 
-	void QDPPoolAllocator::pushFunc(const char * func,int line) {}
-	void QDPPoolAllocator::popFunc(void) {}
+	void QDPPoolAllocator::pushFunc(const char * func,int line) { Stats::pushTag(func); }
+	void QDPPoolAllocator::popFunc(void) { Stats::popTag(); }
 	void QDPPoolAllocator::dump(void)
 	{
 		if ( Layout::primaryNode() ) {
+			size_t free_bytes, largest_block;
+			fragmentation(free_bytes, largest_block);
+
+			std::lock_guard<std::mutex> lock(_Lock);
+
+			QDPIO::cout << "Dumping pool allocator" << std::endl;
+			printf("live blocks= %lu  live bytes= %lu  cache hits= %lu  pool calls= %lu\n",
+			       (unsigned long)getAllocStats().live_objects, (unsigned long)getAllocStats().current_bytes,
+			       (unsigned long)_CacheHits, (unsigned long)_PoolCalls);
 
-			QDPIO::cout << "Dumping memory map" << std::endl;
-			for( auto j = theAllocMap.begin(); j != theAllocMap.end(); j++) {
-				const unsigned long unaligned = (unsigned long)((*j).first);
-				const PoolMemInfo& mem = (*j).second;
+			// Fragmentation: how much of the free memory one block can have
+			printf("free bytes= %lu  largest free block= %lu  (%.0f%% of free)  grows= %lu\n",
+			       (unsigned long)free_bytes, (unsigned long)largest_block,
+			       free_bytes > 0 ? 100.0*largest_block/free_bytes : 100.0, (unsigned long)_Grows);
+
+			for(int k=0; k < _NumArenas; ++k) {
+				if ( _Arenas[k].Mem == nullptr ) continue;
+				printf("arena %d  bytes= %lu  live blocks= %lu  live bytes= %lu\n", k,
+				       (unsigned long)_Arenas[k].Bytes, (unsigned long)_Arenas[k].Live,
+				       (unsigned long)_Arenas[k].LiveBytes);
+			}
 
-				printf("mem= 0x%lx  unaligned= 0x%lx size=%d\n", (unsigned long)unaligned,
-						(unsigned long)mem.Unaligned, mem.Size);
+			for(int b=0; b < NumCacheBins; ++b) {
+				if ( _Cache[b].Blocks.empty() ) continue;
+				printf("cached size= %lu  blocks= %lu\n", (unsigned long)_Cache[b].Size,
+				       (unsigned long)_Cache[b].Blocks.size());
 			}
 		}
 	}
@@ -11,7 +11,18 @@
 
 #if defined(QDP_USE_PROFILING)   
 #include <stack>
-#include <queue>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#endif
+
+#if defined(QDP_USE_PERF_EVENTS)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
 #endif
 
 
@@ -19,6 +30,7 @@ namespace QDP {
 
 static int prof_level = 0;
 static int prog_prof_level = 0;
+static std::string prof_file;
 #ifdef QDP_USE_PROFILING
 static bool prof_init = false;
 #endif
@@ -28,13 +40,46 @@ int getProgramProfileLevel() {return prog_prof_level;}
 QDPTime_t
 getClockTime()
 {
-  struct timeval tp;
-  gettimeofday(&tp,NULL);
-  return((unsigned long)tp.tv_sec * 1000000 + (unsigned long)tp.tv_usec);
-  //struct tms buf;
-  //times(&buf);
-  //return buf.tms_utime + buf.tms_stime;
-  //  return (double)clock()/CLOCKS_PER_SEC;
+  struct timespec tp;
+  clock_gettime(CLOCK_MONOTONIC, &tp);
+  return (QDPTime_t)tp.tv_sec * 1000000000 + (QDPTime_t)tp.tv_nsec;
+}
+
+void setProfileFile(const std::string& file) {prof_file = file;}
+
+
+//--------------------------------------------------------------------------------------
+// Counting of bytes and flops
+//--------------------------------------------------------------------------------------
+
+static bool expr_counting = false;
+static std::atomic<unsigned long long> expr_flops(0);
+static std::atomic<unsigned long long> expr_bytes(0);
+
+void setExprCounting(bool on) {expr_counting = on;}
+bool getExprCounting() {return expr_counting;}
+unsigned long long getExprFlops() {return expr_flops;}
+unsigned long long getExprBytes() {return expr_bytes;}
+
+void resetExprCounts()
+{
+  expr_flops = 0;
+  expr_bytes = 0;
+}
+
+void addExprCounts(double flops, double bytes)
+{
+  expr_flops += (unsigned long long)(flops + 0.5);
+  expr_bytes += (unsigned long long)(bytes + 0.5);
+}
+
+void printExprCounts()
+{
+  double n[2] = {double(expr_flops), double(expr_bytes)};
+  QDPInternal::globalSumArray(n, 2);
+
+  QDPIO::cout << "QDP:ExprCount: flops= " << n[0] << "  bytes= " << n[1]
+	      << "  flops/byte= " << ((n[1] > 0) ? n[0]/n[1] : 0.0) << std::endl;
 }
 
 
@@ -56,6 +101,7 @@ int setProgramProfileLevel(int n) {return prog_prof_level;}
 
 void pushProfileInfo(int level, const std::string& file, const std::string& caller, int line) {}
 void popProfileInfo() {}
+void setProfileCounters(const std::string& events) {}
 
 #else   // Profiling enabled
 
@@ -67,7 +113,204 @@ void popProfileInfo() {}
 std::stack<QDPProfileInfo_t> infostack;
 
 // A queue for the profile data
-std::queue<QDPProfileHead_t> profqueue;
+std::deque<QDPProfileHead_t> profqueue;
+
+
+//--------------------------------------------------------------------------------------
+// Hardware counters
+//--------------------------------------------------------------------------------------
+
+// Counts are charged to the current scope, profqueue.back(), whenever a
+// scope is pushed or popped and when the profile is printed. Each thread
+// of the dispatch has its own counters, opened by the thread itself and
+// read by the master.
+
+static std::vector<std::string> hw_names;
+static std::vector<double> hw_last;       // summed counts at the last charge
+static QDPTime_t hw_last_time = 0;
+static bool hw_open = false;
+
+#if defined(QDP_USE_PERF_EVENTS)
+static std::vector<perf_event_attr> hw_attr;
+static std::vector< std::vector<int> > hw_fd;   // [thread][event], -1 if it is not counted
+
+//! Attributes of a named event, false if the name is not known
+static bool
+hwEvent(const std::string& name, perf_event_attr& attr)
+{
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  struct {const char* name; unsigned type; unsigned long long config;} known[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache-references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+    {"cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"stalled-cycles-frontend", PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+    {"stalled-cycles-backend", PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+    {"L1-dcache-load-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+     (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"LLC-load-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+     (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"task-clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    {"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    {"context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    {"cpu-migrations", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS}
+  };
+
+  for(int k=0; k < sizeof(known)/sizeof(known[0]); ++k)
+    if (name == known[k].name)
+    {
+      attr.type = known[k].type;
+      attr.config = known[k].config;
+      return true;
+    }
+
+  // A raw event, rNNNN in hex
+  if (name.size() > 1 && name[0] == 'r')
+  {
+    char *end;
+    attr.type = PERF_TYPE_RAW;
+    attr.config = strtoull(name.c_str()+1, &end, 16);
+    return *end == '\0';
+  }
+
+  return false;
+}
+
+struct HwOpenArgs {int dummy;};
+
+//! Open the counters of the calling thread
+static void
+hwOpenKernel(int lo, int hi, int myId, HwOpenArgs* a)
+{
+  std::vector<int>& fd = hw_fd[myId];
+  for(int e=0; e < hw_attr.size(); ++e)
+    fd[e] = syscall(__NR_perf_event_open, &hw_attr[e], 0, -1, -1, 0);
+}
+
+//! Counts of the events summed over the threads, scaled up when multiplexed
+static void
+hwRead(std::vector<double>& v)
+{
+  v.assign(hw_names.size(), 0.0);
+  for(int t=0; t < hw_fd.size(); ++t)
+    for(int e=0; e < hw_fd[t].size(); ++e)
+    {
+      unsigned long long buf[3];
+      if (hw_fd[t][e] < 0 || ::read(hw_fd[t][e], buf, sizeof(buf)) != sizeof(buf))
+	continue;
+      if (buf[2] > 0)
+	v[e] += double(buf[0]) * double(buf[1]) / double(buf[2]);
+    }
+}
+#endif
+
+void
+setProfileCounters(const std::string& events)
+{
+#if defined(QDP_USE_PERF_EVENTS)
+  hw_names.clear();
+  hw_attr.clear();
+
+  std::istringstream is(events);
+  std::string name;
+  while (std::getline(is, name, ','))
+  {
+    perf_event_attr attr;
+    if (! hwEvent(name, attr))
+    {
+      QDPIO::cerr << "setProfileCounters: unknown event " << name << std::endl;
+      QDP_abort(1);
+    }
+    hw_names.push_back(name);
+    hw_attr.push_back(attr);
+  }
+#else
+  QDPIO::cerr << "setProfileCounters: hardware counters need a build with --enable-perf-counters" << std::endl;
+#endif
+}
+
+//! Open the counters on first use
+static void
+hwOpen()
+{
+  hw_open = true;
+
+#if defined(QDP_USE_PERF_EVENTS)
+  if (hw_names.empty())
+    return;
+
+  hw_fd.assign(qdpNumThreads(), std::vector<int>(hw_names.size(), -1));
+  HwOpenArgs a;
+  dispatch_to_threads(qdpNumThreads(), a, hwOpenKernel);
+
+  for(int e=0; e < hw_names.size(); ++e)
+    if (hw_fd[0][e] < 0)
+      QDPIO::cerr << "profile: cannot count " << hw_names[e] << ": " << strerror(errno) << std::endl;
+
+  hwRead(hw_last);
+  hw_last_time = getClockTime();
+#endif
+}
+
+//! Add the counts since the last charge to the current scope
+static void
+hwCharge()
+{
+  if (! hw_open)
+    hwOpen();
+
+  if (profqueue.empty())
+  {
+    hw_last_time = getClockTime();
+    return;
+  }
+
+  QDPProfileHead_t& head = profqueue.back();
+  QDPTime_t now = getClockTime();
+  head.time += now - hw_last_time;
+  hw_last_time = now;
+
+#if defined(QDP_USE_PERF_EVENTS)
+  if (hw_names.empty())
+    return;
+
+  std::vector<double> v;
+  hwRead(v);
+  head.hw.resize(v.size(), 0.0);
+  for(int e=0; e < v.size(); ++e)
+    head.hw[e] += v[e] - hw_last[e];
+  hw_last = v;
+#endif
+}
+
+//! Print the counts of every scope summed over the nodes
+static void
+hwPrint(const QDPProfileHead_t& head, const std::vector<double>& sum)
+{
+  const double t = head.time;
+  QDPIO::cout << "  time= " << 1.0e-6*t << " ms";
+
+  int cyc = -1, ins = -1;
+  for(int e=0; e < hw_names.size(); ++e)
+  {
+    QDPIO::cout << "  " << hw_names[e] << "= " << sum[e];
+    if (hw_names[e] == "cycles") cyc = e;
+    if (hw_names[e] == "instructions") ins = e;
+
+    // Lines of 64 bytes brought in from memory, per second of this node
+    if ((hw_names[e] == "cache-misses" || hw_names[e] == "LLC-load-misses") && t > 0)
+      QDPIO::cout << " (" << 64*sum[e]/(Layout::numNodes()*t) << " GB/s per node)";
+  }
+  if (cyc >= 0 && ins >= 0 && sum[cyc] > 0)
+    QDPIO::cout << "  IPC= " << sum[ins]/sum[cyc];
+  QDPIO::cout << std::endl;
+}
 
 
 
@@ -75,9 +318,21 @@ void
 QDPProfile_t::init()
 {
   time = 0;
-  expr = "";
   count = 0;
+  sites = 0;
+  expr = "";
   next = 0;
+  trace_id = -1;
+}
+
+void
+QDPProfile_t::named()
+{
+  if (Trace::enabled())
+    trace_id = Trace::name(expr);
+
+  if (getProfileLevel() > 0)
+    registerProfile(this);
 }
 
 void 
@@ -86,7 +341,7 @@ QDPProfile_t::print()
   if ((getProfileLevel() & 2) > 0)
   {
     QDPIO::cout << expr
-		<< "\t[" << time << "]" << std::endl;
+		<< "\t[" << 1.0e-3*time << " us]" << std::endl;
   }
 }
 
@@ -109,12 +364,112 @@ closeProfile()
   popProfileInfo();
 }
 
+//! Quote a string for JSON
+static std::string
+jsonString(const std::string& s)
+{
+  std::string q = "\"";
+  for(int i=0; i < s.size(); ++i)
+  {
+    if (s[i] == '"' || s[i] == '\\')
+      q += '\\';
+    q += s[i];
+  }
+  return q + "\"";
+}
+
+//! Write all records to prof_file, as CSV if it ends in .csv and JSON otherwise
+/*! The numbers are those of the primary node */
+static void
+dumpProfile()
+{
+  if (prof_file.empty() || Layout::nodeNumber() != 0)
+    return;
+
+  std::ofstream f(prof_file.c_str());
+  if (! f)
+  {
+    QDPIO::cerr << "dumpProfile: cannot open " << prof_file << std::endl;
+    return;
+  }
+
+  const bool csv = prof_file.size() > 4 && prof_file.compare(prof_file.size()-4, 4, ".csv") == 0;
+  if (csv)
+    f << "func,file,line,expr,count,time_ns,sites,bytes,flops\n";
+  else
+    f << "{\n  \"nodes\": " << Layout::numNodes() << ",\n  \"records\": [";
+
+  bool first = true;
+  for(int h=0; h < profqueue.size(); ++h)
+  {
+    const QDPProfileHead_t& head = profqueue[h];
+
+    for(QDPProfile_t *qp = head.start; qp != 0; qp = qp->next)
+    {
+      if (qp->count == 0)
+	continue;
+
+      const double n = qp->sites;
+      if (csv)
+      {
+	// Expressions are full of commas, so quote them
+	std::string e = qp->expr;
+	for(size_t i = e.find('"'); i != std::string::npos; i = e.find('"', i+2))
+	  e.insert(i, 1, '"');
+
+	f << head.info.caller << "," << head.info.file << "," << head.info.line
+	  << ",\"" << e << "\"," << qp->count << "," << qp->time << "," << qp->sites
+	  << "," << qp->bytes*n << "," << qp->flops*n << "\n";
+      }
+      else
+      {
+	f << (first ? "\n" : ",\n")
+	  << "    {\"func\": " << jsonString(head.info.caller)
+	  << ", \"file\": " << jsonString(head.info.file)
+	  << ", \"line\": " << head.info.line
+	  << ", \"expr\": " << jsonString(qp->expr)
+	  << ", \"count\": " << qp->count
+	  << ", \"time_ns\": " << qp->time
+	  << ", \"sites\": " << qp->sites
+	  << ", \"bytes\": " << qp->bytes*n
+	  << ", \"flops\": " << qp->flops*n << "}";
+      }
+      first = false;
+    }
+  }
+
+  if (! csv)
+    f << "\n  ]\n}\n";
+}
+
 void 
 printProfile()
 {
   if (profqueue.size() == 0)
     return;
 
+  hwCharge();
+  dumpProfile();
+
+  // Hardware counts of all scopes summed over the threads and nodes. The
+  // nodes only agree on the scopes when they all pushed the same ones
+  const int nev = hw_names.size();
+  std::vector<double> hw_sum(profqueue.size()*nev + 1, 0.0);
+  if (nev > 0)
+  {
+    for(int h=0; h < profqueue.size(); ++h)
+      for(int e=0; e < profqueue[h].hw.size(); ++e)
+	hw_sum[h*nev + e] = profqueue[h].hw[e];
+
+    double nscope = profqueue.size();
+    QDPInternal::globalSumArray(&nscope, 1);
+    if (nscope == double(profqueue.size())*Layout::numNodes())
+      QDPInternal::globalSumArray(&hw_sum[0], hw_sum.size());
+    else
+      QDPIO::cout << "profile: the nodes saw different scopes, hardware counts are of the primary node" << std::endl;
+  }
+  int h = 0;
+
   while(! profqueue.empty())
   {
     QDPProfileHead_t& head = profqueue.front();
@@ -129,19 +484,20 @@ printProfile()
 		  << "   file = " << head.info.file
 		  << std::endl;
 
+      if (nev > 0)
+	hwPrint(head, std::vector<double>(hw_sum.begin() + h*nev, hw_sum.begin() + (h+1)*nev));
+
       while(qp)
       {
 	if (qp->count > 0)
 	{
-//	  QDPIO::cout << "   " << qp->count << "  [" << qp->time << "]  " << qp->expr << std::endl;
-
-	  // Gag, I still have not really grokked the fricken SL iostream field
-	  // width manipulators. Drop down to low tech just to get out
-	  // the bleaping thing. Note: the real problem is the QDPIO::cout class
-	  // is not really a stream instantiation, hence the needed member functions
-	  // are not there. Sigh.
-	  char lin[80];  // more than adequate
-	  sprintf(lin, "  %7d   [%8d]  ", qp->count, qp->time);
+	  // count, time in us, and the rates of the estimated bytes and flops
+	  const double t = qp->time;
+	  const double n = qp->sites;
+	  char lin[120];
+	  sprintf(lin, "  %9lu   [%12.1f us]  %8.3f GB/s  %8.3f GF/s  ",
+		  (unsigned long)qp->count, 1.0e-3*t,
+		  (t > 0) ? qp->bytes*n/t : 0.0, (t > 0) ? qp->flops*n/t : 0.0);
 	  QDPIO::cout << lin << qp->expr << std::endl;
 	}
 
@@ -149,7 +505,8 @@ printProfile()
       }
     }
 
-    profqueue.pop();
+    profqueue.pop_front();
+    ++h;
   }
 }
 
@@ -171,13 +528,15 @@ setProgramProfileLevel(int n)
 
 void pushProfileInfo(int level, const std::string& file, const std::string& caller, int line)
 {
+  hwCharge();
+
   QDPProfileInfo_t info(level, file, caller, line);
   infostack.push(info);
 
   setProfileLevel(level);
 
   QDPProfileHead_t  head(infostack.top());
-  profqueue.push(head);
+  profqueue.push_back(head);
 
   if ((level & 2) > 0)
   {
@@ -197,15 +556,22 @@ void popProfileInfo()
     QDP_abort(1);
   }
 
+  hwCharge();
+
   QDPProfileInfo_t& info = infostack.top();
   setProfileLevel(info.level);
 
   infostack.pop();
 }
 
+// Expressions may first be seen on several threads at once
+static std::mutex profmutex;
+
 void
 registerProfile(QDPProfile_t* qp)
 {
+  std::lock_guard<std::mutex> lock(profmutex);
+
   if (profqueue.empty())
   {
     QDPIO::cerr << "registerProfile: profile queue empty" << std::endl;
@@ -0,0 +1,149 @@
+/*! @file
+ * @brief A thread driving outstanding messages while the workers compute
+ *
+ * The watched messages sit in a list under a lock. The thread holds the
+ * lock while it tests them, so once unwatch took a message out the
+ * thread cannot be inside QMP with it, and the node may wait on it or
+ * free it. A message found complete is dropped from the list; the wait
+ * on it later returns at once.
+ */
+
+#include "qdp.h"
+#include "qdp_progress.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <vector>
+#include <algorithm>
+
+namespace QDP
+{
+  namespace Progress
+  {
+    namespace
+    {
+      bool want = false;
+      int want_cpu = -1;
+      bool running = false;
+      bool stop = false;
+
+      pthread_t thread;
+      pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+      pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+      std::vector<QMP_msghandle_t> active;
+
+      void* progressLoop(void*)
+      {
+	pthread_mutex_lock(&mutex);
+	while (! stop)
+	{
+	  if (active.empty())
+	  {
+	    pthread_cond_wait(&cond, &mutex);
+	    continue;
+	  }
+
+	  for(int i=0; i < active.size(); )
+	    if (QMP_is_complete(active[i]) == QMP_TRUE)
+	    {
+	      active[i] = active.back();
+	      active.pop_back();
+	    }
+	    else
+	      ++i;
+
+	  // Let the node take messages back between the passes
+	  pthread_mutex_unlock(&mutex);
+	  sched_yield();
+	  pthread_mutex_lock(&mutex);
+	}
+	pthread_mutex_unlock(&mutex);
+
+	return 0;
+      }
+    }
+
+
+    void setMode(bool on, int cpu)
+    {
+      want = on;
+      want_cpu = cpu;
+    }
+
+    void init(bool thread_multiple)
+    {
+      if (! want || running)
+	return;
+
+      if (! thread_multiple)
+      {
+	QDPIO::cout << "No progress thread: QMP does not give QMP_THREAD_MULTIPLE" << std::endl;
+	return;
+      }
+
+      stop = false;
+      if (pthread_create(&thread, 0, progressLoop, 0) != 0)
+	QDP_error_exit("Progress: cannot start the progress thread");
+
+#if defined(__linux__)
+      if (want_cpu >= 0)
+      {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(want_cpu, &set);
+	if (pthread_setaffinity_np(thread, sizeof(set), &set) != 0)
+	  QDPIO::cout << "WARN: Could not bind the progress thread to cpu " << want_cpu << std::endl;
+      }
+#endif
+
+      running = true;
+      QDPIO::cout << "QDP drives messages from a progress thread" << std::endl;
+    }
+
+    void finalize()
+    {
+      if (! running)
+	return;
+
+      pthread_mutex_lock(&mutex);
+      stop = true;
+      active.clear();
+      pthread_cond_signal(&cond);
+      pthread_mutex_unlock(&mutex);
+
+      pthread_join(thread, 0);
+      running = false;
+    }
+
+    bool enabled()
+    {
+      return running;
+    }
+
+    void watch(QMP_msghandle_t mh)
+    {
+      if (! running)
+	return;
+
+      pthread_mutex_lock(&mutex);
+      active.push_back(mh);
+      pthread_cond_signal(&cond);
+      pthread_mutex_unlock(&mutex);
+    }
+
+    void unwatch(QMP_msghandle_t mh)
+    {
+      if (! running)
+	return;
+
+      pthread_mutex_lock(&mutex);
+      std::vector<QMP_msghandle_t>::iterator i = std::find(active.begin(), active.end(), mh);
+      if (i != active.end())
+      {
+	*i = active.back();
+	active.pop_back();
+      }
+      pthread_mutex_unlock(&mutex);
+    }
+  }
+}
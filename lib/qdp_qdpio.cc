@@ -5,6 +5,10 @@
 
 #include "qdp.h"
 
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace QDP 
 {
 
@@ -101,14 +105,134 @@ namespace QDP
 		return node;
 	}
 	
+  //-----------------------------------------------------------------------------
+  // Reading ahead of a QIO reader
+  namespace
+  {
+    //! Bytes read ahead by readers opened from now on
+    size_t read_ahead_bytes = 0;
+  }
+
+  //! The thread fetching a file into the page cache and what it has got to
+  struct QDPFileReader::ReadAhead
+  {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int fd;
+    off_t fetched;       // bytes of the file read so far
+    off_t target;        // read up to here
+    bool closing;
+
+    static void* loop(void* arg);
+  };
+
+
+  // Read chunks until the target is reached, then wait for it to move on
+  void* QDPFileReader::ReadAhead::loop(void* arg)
+  {
+    ReadAhead* r = (ReadAhead *)arg;
+    const size_t chunk = 4 << 20;
+    std::vector<char> buf(chunk);
+
+    pthread_mutex_lock(&r->mutex);
+    for(;;)
+    {
+      while (r->fetched >= r->target && ! r->closing)
+	pthread_cond_wait(&r->cond, &r->mutex);
+
+      if (r->closing)
+	break;
+
+      off_t off = r->fetched;
+      size_t n = std::min(size_t(r->target - off), chunk);
+      pthread_mutex_unlock(&r->mutex);
+
+      // Only the page cache keeps what is read
+      ssize_t k = pread(r->fd, &buf[0], n, off);
+
+      pthread_mutex_lock(&r->mutex);
+      if (k <= 0)
+	break;      // end of file, or leave it to QIO to report
+      r->fetched += k;
+    }
+    pthread_mutex_unlock(&r->mutex);
+
+    return 0;
+  }
+
+
+  void QDPFileReader::setReadAhead(size_t bytes) {read_ahead_bytes = bytes;}
+
+  size_t QDPFileReader::readAhead() {return read_ahead_bytes;}
+
+
+  void QDPFileReader::startReadAhead(const std::string& path)
+  {
+    stopReadAhead();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;     // QIO has it open, so just go without
+
+    read_ahead = new ReadAhead;
+    read_ahead->fd = fd;
+    read_ahead->fetched = 0;
+    read_ahead->target = read_ahead_bytes;
+    read_ahead->closing = false;
+    pthread_mutex_init(&read_ahead->mutex, 0);
+    pthread_cond_init(&read_ahead->cond, 0);
+    if (pthread_create(&read_ahead->thread, 0, ReadAhead::loop, (void *)read_ahead) != 0)
+    {
+      pthread_mutex_destroy(&read_ahead->mutex);
+      pthread_cond_destroy(&read_ahead->cond);
+      ::close(fd);
+      delete read_ahead;
+      read_ahead = 0;
+    }
+  }
+
+
+  void QDPFileReader::stopReadAhead()
+  {
+    if (read_ahead == 0)
+      return;
+
+    pthread_mutex_lock(&read_ahead->mutex);
+    read_ahead->closing = true;
+    pthread_cond_signal(&read_ahead->cond);
+    pthread_mutex_unlock(&read_ahead->mutex);
+
+    pthread_join(read_ahead->thread, 0);
+    pthread_mutex_destroy(&read_ahead->mutex);
+    pthread_cond_destroy(&read_ahead->cond);
+    ::close(read_ahead->fd);
+    delete read_ahead;
+    read_ahead = 0;
+  }
+
+
+  // Move the window on past the record just read
+  void QDPFileReader::advance(size_t bytes)
+  {
+    if (read_ahead == 0)
+      return;
+
+    pthread_mutex_lock(&read_ahead->mutex);
+    read_ahead->target += bytes;
+    pthread_cond_signal(&read_ahead->cond);
+    pthread_mutex_unlock(&read_ahead->mutex);
+  }
+
+
   //-----------------------------------------------------------------------------
   // QDP QIO support
-  QDPFileReader::QDPFileReader() {iop=false;}
+  QDPFileReader::QDPFileReader() {iop=false; read_ahead=0;}
 
   QDPFileReader::QDPFileReader(XMLReader& xml, 
 			       const std::string& path,
 			       QDP_serialparallel_t serpar)
-  {open(xml,path,serpar);}
+  {iop=false; read_ahead=0; open(xml,path,serpar);}
 
   void QDPFileReader::open(XMLReader& file_xml, 
 			   const std::string& path, 
@@ -174,6 +298,10 @@ namespace QDP
 
     QIO_string_destroy(xml_c);
 
+    // A serial read goes through the primary node only
+    if (serpar != QDPIO_PARALLEL && Layout::primaryNode() && readAhead() > 0)
+      startReadAhead(path);
+
     iop=true;
   }
 
@@ -185,6 +313,7 @@ namespace QDP
       //int status = QIO_close_read(qio_in);
       QIO_close_read(qio_in);
     }
+    stopReadAhead();
 
     iop = false;
     iostate = QDPIO_badbit;
@@ -272,6 +401,7 @@ namespace QDP
       QDP_abort(1);
     }
     QDPIO::cout << "QIO_read_finished" << std::endl;
+    advance(from_disk.size());
       
     // Cast appropriately
 //    for(int i=0; i < from_disk.size(); i++) { 
@@ -566,5 +696,171 @@ namespace QDP
     QIO_destroy_record_info(info);
   }
 
+  //-----------------------------------------
+  // Packed records
+  QDPPackedWriter::QDPPackedWriter(QDPFileWriter& qsw_, size_t max_bytes_) :
+    qsw(qsw_), max_bytes(max_bytes_) {}
+
+  QDPPackedWriter::~QDPPackedWriter() {flush();}
+
+  void QDPPackedWriter::add(const std::string& name, XMLBufferWriter& xml, BinaryBufferWriter& bin)
+  {
+    Entry e;
+    e.name = name;
+    e.offset = entries.empty() ? 0 : entries.back().offset + entries.back().xml_bytes + entries.back().bytes;
+    e.xml_bytes = e.bytes = 0;
+
+    // The bytes are kept on the primary node, their count on all
+    if (Layout::primaryNode())
+    {
+      std::string x = xml.str();
+      std::string b = bin.strPrimaryNode();
+      e.xml_bytes = x.size();
+      e.bytes = b.size();
+      data += x;
+      data += b;
+    }
+    QDPInternal::broadcast(e.xml_bytes);
+    QDPInternal::broadcast(e.bytes);
+
+    entries.push_back(e);
+
+    if (e.offset + e.xml_bytes + e.bytes >= max_bytes)
+      flush();
+  }
+
+  void QDPPackedWriter::flush()
+  {
+    if (entries.empty())
+      return;
+
+    XMLBufferWriter index;
+    push(index, "packedRecords");
+    QDP::write(index, "version", 1);
+    push(index, "entries");
+    for(int i=0; i < entries.size(); ++i)
+    {
+      push(index, "elem");
+      QDP::write(index, "name", entries[i].name);
+      QDP::write(index, "offset", entries[i].offset);
+      QDP::write(index, "xmlBytes", entries[i].xml_bytes);
+      QDP::write(index, "bytes", entries[i].bytes);
+      pop(index);
+    }
+    pop(index);
+    pop(index);
+
+    BinaryBufferWriter bin(data);
+    qsw.write(index, bin);
+
+    data.clear();
+    entries.clear();
+  }
+
+
+  QDPPackedReader::QDPPackedReader(QDPFileReader& qsr)
+  {
+    for(;;)
+    {
+      QIO_RecordInfo rec_info;
+      QIO_String* xml_c = QIO_string_create();
+
+      int status = QIO_read_record_info(qsr.qio_in, &rec_info, xml_c);
+      if (status == QIO_EOF)
+      {
+	QIO_string_destroy(xml_c);
+	break;
+      }
+      if (status != QIO_SUCCESS)
+      {
+	QDPIO::cerr << "QDPPackedReader: failed to read the Record Info" << std::endl;
+	QDP_abort(1);
+      }
+
+      // Only packed records are parsed, the others are passed by
+      std::string rec;
+      bool packed = false;
+      if (Layout::primaryNode())
+      {
+	rec = QIO_string_ptr(xml_c);
+	packed = rec.find("<packedRecords>") != std::string::npos;
+      }
+      QDPInternal::broadcast(packed);
+      QIO_string_destroy(xml_c);
+
+      if (! packed)
+      {
+	if (QIO_next_record(qsr.qio_in) != QIO_SUCCESS)
+	{
+	  QDPIO::cerr << "QDPPackedReader: failed to skip a record" << std::endl;
+	  QDP_abort(1);
+	}
+	continue;
+      }
+
+      std::string from_disk;
+      from_disk.resize(QIO_get_datacount(&rec_info));
+      status = QIO_read_record_data(qsr.qio_in,
+				    &(QDPOScalarFactoryPut<char> ),
+				    from_disk.size()*sizeof(char),
+				    sizeof(char),
+				    (void *)&(from_disk[0]));
+      if (status != QIO_SUCCESS)
+      {
+	QDPIO::cerr << "QDPPackedReader: failed to read a packed record" << std::endl;
+	qsr.clear(QDPIO_badbit);
+	QDP_abort(1);
+      }
+      qsr.advance(from_disk.size());
+
+      // The objects are read from the primary node
+      const int record = records.size();
+      records.push_back(std::string());
+      if (Layout::primaryNode())
+	records.back().swap(from_disk);
+
+      std::istringstream ss;
+      if (Layout::primaryNode())
+	ss.str(rec);
+      XMLReader toc(ss);
+
+      const int n = toc.count("/packedRecords/entries/elem");
+      for(int i=0; i < n; ++i)
+      {
+	std::ostringstream path;
+	path << "/packedRecords/entries/elem[" << (i+1) << "]";
+	XMLReader elem(toc, path.str());
+
+	Entry e;
+	e.record = record;
+	QDP::read(elem, "name", e.name);
+	QDP::read(elem, "offset", e.offset);
+	QDP::read(elem, "xmlBytes", e.xml_bytes);
+	QDP::read(elem, "bytes", e.bytes);
+
+	index[e.name] = entries.size();
+	entries.push_back(e);
+      }
+    }
+  }
+
+  void QDPPackedReader::open(const std::string& name, XMLReader& xml, BinaryBufferReader& bin)
+  {
+    std::map<std::string, int>::const_iterator p = index.find(name);
+    if (p == index.end())
+    {
+      QDPIO::cerr << "QDPPackedReader: no object named " << name << std::endl;
+      QDP_abort(1);
+    }
+    const Entry& e = entries[p->second];
+    const std::string& rec = records[e.record];
+
+    std::istringstream ss;
+    if (Layout::primaryNode())
+      ss.str(rec.substr(e.offset, e.xml_bytes));
+    xml.open(ss);
+
+    bin.open(rec.substr(e.offset + e.xml_bytes, e.bytes));
+  }
 
 } // namespace QDP;
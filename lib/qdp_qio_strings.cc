@@ -24,6 +24,25 @@ namespace QDP {
   template<>
   char* QIOStringTraits< LatticeColorVectorD3 >::tname = (char *)"USQCD_D3_ColorVector";
 
+  // Gauge fields of the other numbers of colours
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL32>, 2> > > > >::tname = (char *)"QDP_F2_ColorMatrix";
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL64>, 2> > > > >::tname = (char *)"QDP_D2_ColorMatrix";
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL32>, 4> > > > >::tname = (char *)"QDP_FN_ColorMatrix";
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL64>, 4> > > > >::tname = (char *)"QDP_DN_ColorMatrix";
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL32>, 5> > > > >::tname = (char *)"QDP_FN_ColorMatrix";
+
+  template<>
+  char* QIOStringTraits< multi1d<OLattice< PScalar< PColorMatrix< RComplex<REAL64>, 5> > > > >::tname = (char *)"QDP_DN_ColorMatrix";
+
   // This is for the QIO precision strings
   template<>
   char* QIOStringTraits<float>::tprec = (char *)"F";
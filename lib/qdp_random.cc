@@ -24,6 +24,8 @@ namespace RNG
   Seed ran_mult_n;
   //! The lattice of skewed RNG multipliers
   LatticeSeed *lattice_ran_mult;
+  //! Generator of the lattice fills
+  Generator ran_generator = GEN_LCG;
 
     //! Find the number of bits required to represent x.
   int numbits(int x)
@@ -50,6 +52,78 @@ namespace RNG
   }
 
 
+  //! The work of building the skewed multipliers
+  struct LatticeMultArgs
+  {
+    LatticeSeed& d;
+    const multi1d<Seed>& pow2;   //!< ran_mult^(2^i)
+  };
+
+  //! a^n on each site, n the lexicographic number of the site plus one
+  void latticeMultKernel(int lo, int hi, int myId, LatticeMultArgs* a)
+  {
+    const multi1d<int>& nrow = Layout::lattSize();
+    const int node = Layout::nodeNumber();
+
+    Seed one;
+    one = 1;
+
+    for(int i=lo; i < hi; ++i)
+    {
+      Layout::LatticeCoord coord;
+      Layout::siteCoords(node, i, coord);
+
+      /* The lexicographic value of site K is
+       *
+       *   lexoc(k) = sum_{i = 1, ndim} x(k,i)*L^i     +   1
+       *
+       * and the multiplier is the product of a^(2^b) over its bits b
+       */
+      unsigned long lexoc = 0;
+      for(int m=Nd-1; m >= 0; --m)
+	lexoc = lexoc*nrow[m] + coord[m];
+      lexoc += 1;
+
+      Seed acc = one;
+      for(int b=0; lexoc; ++b, lexoc >>= 1)
+	if (lexoc & 1)
+	  acc = acc * a->pow2[b];
+
+      a->d.elem(i) = acc.elem();
+    }
+  }
+
+
+  //! Build the lattice of skewed multipliers of the linear congruential generator
+  /*!
+   * One threaded pass over the sites, each taking the product of the
+   * powers a^(2^b) for the bits of its number. Seed arithmetic is exact,
+   * so this is the same lattice as the bit by bit lattice products.
+   */
+  void initLatticeRNG()
+  {
+    if (lattice_ran_mult)
+      return;
+
+    // Find the number of bits it takes to represent the total lattice volume.
+    // NOTE: there are no lattice size restrictions here.
+    int nbits = numbits(Layout::vol());
+
+    multi1d<Seed> pow2(nbits);
+    pow2[0] = ran_mult;
+    for(int i=1; i < nbits; ++i)
+      pow2[i] = pow2[i-1] * pow2[i-1];
+
+    lattice_ran_mult = new LatticeSeed;
+    if( lattice_ran_mult == 0x0 ) { 
+      QDP_error_exit("Unable to allocate ran_mult\n");
+    }
+
+    LatticeMultArgs args = {*lattice_ran_mult, pow2};
+    dispatch_to_threads(Layout::sitesOnNode(), args, latticeMultKernel);
+  }
+
+
   //! Initialize the internals of the random number generator
   void initRNG()
   {
@@ -69,58 +143,15 @@ namespace RNG
 
     ran_mult = seed_tmp0;
 
+    // The multipliers of an earlier layout are of no use
+    finalizeRNG();
+
     // Find the number of bits it takes to represent the total lattice volume.
     // NOTE: there are no lattice size restrictions here.
     int nbits = numbits(Layout::vol());
 
-    /* Get the lattice coordinate of each site (note the origin is 0) and
-     *   build up a lexicographic ordering for the lattice. The definition
-     *   here is totally arbitrary and only this routine needs to worry
-     *   about it.  The lexicographic value of site K is
-     *
-     *     lexoc(k) = sum_{i = 1, ndim} x(k,i)*L^i     +   1
-     */
-    LatticeInteger lexoc;
-    lexoc = Layout::latticeCoordinate(Nd-1);
-
-    for(int m=Nd-2; m>=0; --m)
-    {
-      lexoc *= Layout::lattSize()[m];
-      lexoc += Layout::latticeCoordinate(m);
-    }
-
-    lexoc += 1;
-
-    /*
-     * Setup single multiplier ( a^1 ) on each site 
-     */
-    LatticeSeed laa;
-    laa = ran_mult;
-
-    /*
-     * Calculate the multiplier  a^n  where n = lexicographic numbering of the site.
-     *   Put one into each an_f, then multiply them by  a^(2^i) under the context
-     *   flag where i is the bit number of the lexicographic numbering.
-     *   In other words, the very first site is multiplied by a.
-     */
-    LatticeSeed lattice_ran_mult_tmp;
-
-    lattice_ran_mult_tmp = 1;
-
-    LatticeSeed laamult;
-    LatticeBoolean lbit;
-
-    for(int i=0; i<nbits; ++i)
-    {
-      lbit = (lexoc & 1) > 0;
-
-      laamult = lattice_ran_mult_tmp * laa;
-      copymask(lattice_ran_mult_tmp,lbit,laamult);
-
-      lexoc >>= 1;
-      laamult = laa * laa;
-      laa = laamult;
-    }
+    // The site multipliers are built by the first fill of the linear
+    // congruential generator, unless readState brings them first
 
     // Calculate separately the multiplier for the highest lexicographically ordered site.
     // NOTE: I'm changing the meaning here slightly, but in an important way.
@@ -151,13 +182,6 @@ namespace RNG
       aa = aamult;
     }
 
-    lattice_ran_mult = new LatticeSeed;
-    if( lattice_ran_mult == 0x0 ) { 
-      QDP_error_exit("Unable to allocate ran_mult\n");
-    }
-
-    *lattice_ran_mult = lattice_ran_mult_tmp;
-
     QDPIO::cout << "Finished init of RNG" << std::endl; 
 
     setProfileLevel(old_profile_level);
@@ -170,6 +194,63 @@ namespace RNG
   {
     if (lattice_ran_mult)
        delete lattice_ran_mult;
+    lattice_ran_mult = 0;
+  }
+
+
+  void setGenerator(Generator g)
+  {
+    ran_generator = g;
+  }
+
+
+  Generator generator()
+  {
+    return ran_generator;
+  }
+
+
+  bool generatorFromName(const char* name, Generator& g)
+  {
+    if (strcmp(name, "lcg") == 0)
+      g = GEN_LCG;
+    else if (strcmp(name, "philox") == 0)
+      g = GEN_PHILOX;
+    else
+      return false;
+    return true;
+  }
+
+
+  CounterKey nextCounterKey(bool lattice)
+  {
+    // The 47 bits of the seed, 12 per word
+    int w[4];
+    for(int k=0; k < 4; ++k)
+      w[k] = ran_seed.elem().elem().elem(k).elem();
+
+    CounterKey key;
+    key.k[0] = (unsigned int)w[0] | ((unsigned int)w[1] << 12) | (((unsigned int)w[2] & 0xff) << 24);
+    key.k[1] = ((unsigned int)w[2] >> 8) | ((unsigned int)w[3] << 4);
+
+    // Advance the seed as the linear congruential generator does
+    Seed ran_tmp = ran_seed * (lattice ? ran_mult_n : ran_mult);
+    ran_seed = ran_tmp;
+
+    return key;
+  }
+
+
+  unsigned int lexicoSite(int site)
+  {
+    Layout::LatticeCoord coord;
+    Layout::siteCoords(Layout::nodeNumber(), site, coord);
+
+    const multi1d<int>& nrow = Layout::lattSize();
+    unsigned int lex = coord[Nd-1];
+    for(int m=Nd-2; m >= 0; --m)
+      lex = lex*nrow[m] + coord[m];
+    return lex;
   }
 
 
@@ -187,6 +268,66 @@ namespace RNG
   }
 
 
+  namespace
+  {
+    //! Marks the state of writeState
+    const int state_magic = 0x514e4752;   // "QRNG"
+    const int state_version = 1;
+  }
+
+
+  void writeState(BinaryWriter& bin)
+  {
+    write(bin, state_magic);
+    write(bin, state_version);
+    write(bin, int(ran_generator));
+    write(bin, Nd);
+    for(int m=0; m < Nd; ++m)
+      write(bin, Layout::lattSize()[m]);
+
+    write(bin, ran_seed);
+
+    const int sites = (lattice_ran_mult != 0) ? 1 : 0;
+    write(bin, sites);
+    if (sites)
+      write(bin, *lattice_ran_mult);
+  }
+
+
+  void readState(BinaryReader& bin)
+  {
+    int magic, version, gen, nd;
+    read(bin, magic);
+    read(bin, version);
+    if (magic != state_magic || version != state_version)
+      QDP_error_exit("RNG::readState: not a state of this generator");
+
+    read(bin, gen);
+    read(bin, nd);
+    bool same = (nd == Nd);
+    for(int m=0; m < nd; ++m)
+    {
+      int n;
+      read(bin, n);
+      same = same && (n == Layout::lattSize()[m]);
+    }
+    if (! same)
+      QDP_error_exit("RNG::readState: the state is of another lattice size");
+
+    ran_generator = Generator(gen);
+    read(bin, ran_seed);
+
+    int sites;
+    read(bin, sites);
+    if (sites)
+    {
+      if (! lattice_ran_mult)
+	lattice_ran_mult = new LatticeSeed;
+      read(bin, *lattice_ran_mult);
+    }
+  }
+
+
   //! Scalar random number generator. Done on the front end. */
   /*! 
    * It is linear congruential with modulus m = 2**47, increment c = 0,
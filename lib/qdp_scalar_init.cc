@@ -7,6 +7,7 @@
 
 
 #include "qdp.h"
+#include "qdp_threadbind.h"
 
 #if defined(QDP_USE_QMT_THREADS)
 #include <qmt.h>
@@ -30,6 +31,7 @@ void QDP_initialize(int *argc, char ***argv)
   if (isInit)
     QDP_error_exit("QDP already inited");
 
+  Ensemble::init();   // one node is one member
   Layout::init();   // setup extremely basic functionality in Layout
 
   isInit = true;
@@ -55,6 +57,19 @@ void QDP_initialize(int *argc, char ***argv)
 #endif
 #endif
 
+#ifdef QDP_USE_POOL_THREADS
+  // Start the persistent workers
+  std::cout << "QDP uses the thread pool: Initializing threads..." ;
+  int pool_status = ThreadPool::init();
+  if( pool_status == 0 ) { 
+    std::cout << "Success. We have " << qdpNumThreads() << " threads \n"; 
+  }
+  else { 
+    std::cout << "Failure... ThreadPool::init() returned " << pool_status << std::endl;
+    QDP_abort(1);
+  }
+#endif
+
 
 // Alloc space for reductions
   ThreadReductions::norm2_results = new REAL64 [ qdpNumThreads() ];
@@ -78,6 +93,7 @@ void QDP_initialize(int *argc, char ***argv)
   // Process command line
   //
   pool_size_in_gb = 8;
+  bool pool_size_given = false;
 
   // Look for help
   bool help_flag = false;
@@ -95,8 +111,36 @@ void QDP_initialize(int *argc, char ***argv)
 #if defined(QDP_USE_PROFILING)   
     fprintf(stderr,"    -p        %%d [%d] profile level\n", 
 	    getProfileLevel());
+    fprintf(stderr,"    -pfile    %%s  write the profile as JSON, or CSV for a .csv name, at QDP_finalize\n");
+    fprintf(stderr,"    -pcounters %%s  hardware counters to read in each profile scope, e.g. cycles,instructions,LLC-load-misses\n");
 #endif
-    fprintf(stderr, " -poolsize <X>  Create a fixed pool of X GB for Pool Alloc\n");
+    fprintf(stderr, " -poolsize <X>  Create a pool of X GB for Pool Alloc\n");
+    fprintf(stderr, " -poolgrow <X>  Grow a full pool by at least X GB, 0 for a fixed pool\n");
+    fprintf(stderr, " -memstats  Print lattice memory statistics at QDP_finalize\n");
+    fprintf(stderr, " -trace-temps  Count lattice allocations by reason and caller, printed at QDP_finalize\n");
+    fprintf(stderr, " -flopcount  Count the flops and bytes of every expression, printed at QDP_finalize\n");
+    fprintf(stderr, " -kernel-report  Count the calls of the kernel chosen for each expression, printed at QDP_finalize\n");
+    fprintf(stderr, " -thread-report  Time every thread of the parallel regions, printed at QDP_finalize\n");
+    fprintf(stderr, " -trace <file>  Write a timeline of the operations as Chrome trace JSON at QDP_finalize\n");
+    fprintf(stderr, " -autotune  Time the threading variants of the tunable kernels on first use\n");
+    fprintf(stderr, " -autotune-file <file>  Tune, reading earlier winners from file and saving them at QDP_finalize\n");
+    fprintf(stderr, " -rng lcg|philox  Generator of random and gaussian\n");
+    fprintf(stderr, " -partition-balance  Rebalance the thread partitions of subsets from measured times\n");
+    fprintf(stderr, " -offload  Run lattice loops on the device, when built with --enable-omp-offload\n");
+    fprintf(stderr, " -offload-min-sites <n>  Smallest subset run on the device\n");
+#ifdef QDP_USE_LIBXML2
+    fprintf(stderr, " -xml-parse-all-nodes  Parse XML documents on every node instead of broadcasting each query\n");
+    fprintf(stderr, " -qio-readahead <MB>  Read QIO files this far ahead of the records taken\n");
+#endif
+    fprintf(stderr, " -poolpages default|thp|2m|1g  Pages backing the Pool Alloc pool\n");
+    fprintf(stderr, " -numa none|touch|bind  Place lattice pages with the threads that use them\n");
+    fprintf(stderr, " -lattice-cow  Copies of a lattice field share its sites until one is written\n");
+    fprintf(stderr, " -fast-memory <node>|hbw[:<MB>]  Give FAST lattice fields the memory of a NUMA node or memkind\n");
+    fprintf(stderr, " -tile <n>  Visit sites in tiles of n^Nd sites of the local lattice\n");
+    fprintf(stderr, " -layout default|lexico|cb2|cb3d|cb32|morton  Order of the sites within a node\n");
+    fprintf(stderr, " -table-cache <dir>  Read the layout, set and map tables from dir, written there by the first job\n");
+    fprintf(stderr, " -bind c:s  Bind threads to c cores with s SMT threads per core\n");
+    fprintf(stderr, " -probe  Measure the machine at startup and choose the threads, pool size and kernels\n");
     exit(1);
   }
 
@@ -109,19 +153,169 @@ void QDP_initialize(int *argc, char ***argv)
       sscanf((*argv)[++i], "%d", &lev);
       setProgramProfileLevel(lev);
     }
+
+    if (strcmp((*argv)[i], "-pfile")==0)
+      setProfileFile((*argv)[++i]);
+
+    if (strcmp((*argv)[i], "-pcounters")==0)
+      setProfileCounters((*argv)[++i]);
 #endif
     if ( strcmp((*argv)[i],"-poolsize")==0)
       {
 	sscanf((*argv)[++i], "%f", &pool_size_in_gb);
-	
+	pool_size_given = true;
       }
 
+    if (strcmp((*argv)[i], "-poolgrow")==0)
+    {
+      float gb = 0;
+      sscanf((*argv)[++i], "%f", &gb);
+      Allocator::setPoolGrowth(size_t(gb*1024*1024*1024));
+    }
+
+    if (strcmp((*argv)[i], "-memstats")==0)
+      Allocator::setAllocStatsAtFinalize(true);
+
+    if (strcmp((*argv)[i], "-trace-temps")==0)
+      Allocator::setLatticeTrace(true);
+
+    if (strcmp((*argv)[i], "-flopcount")==0)
+      setExprCounting(true);
+
+    if (strcmp((*argv)[i], "-kernel-report")==0)
+      KernelReport::setEnabled(true);
+
+    if (strcmp((*argv)[i], "-thread-report")==0)
+      ThreadReport::setEnabled(true);
+
+    if (strcmp((*argv)[i], "-trace")==0)
+      Trace::setTraceFile((*argv)[++i]);
+
+    if (strcmp((*argv)[i], "-autotune")==0)
+      AutoTune::setEnabled(true);
+
+    if (strcmp((*argv)[i], "-autotune-file")==0)
+      AutoTune::setCacheFile((*argv)[++i]);
+
+    if (strcmp((*argv)[i], "-partition-balance")==0)
+      Partition::setRebalance(true);
+
+    if (strcmp((*argv)[i], "-offload")==0)
+      Offload::setEnabled(true);
+
+    if (strcmp((*argv)[i], "-offload-min-sites")==0)
+    {
+      int n;
+      sscanf((*argv)[++i], "%d", &n);
+      Offload::setMinSites(n);
+    }
+
+#ifdef QDP_USE_LIBXML2
+    if (strcmp((*argv)[i], "-xml-parse-all-nodes")==0)
+      XMLReader::setParseOnAllNodes(true);
+
+    if (strcmp((*argv)[i], "-qio-readahead")==0)
+    {
+      int mb;
+      sscanf((*argv)[++i], "%d", &mb);
+      QDPFileReader::setReadAhead(size_t(mb) << 20);
+    }
+#endif
+
+    if (strcmp((*argv)[i], "-rng")==0)
+    {
+      const char* name = (*argv)[++i];
+      RNG::Generator gen;
+      if (RNG::generatorFromName(name, gen))
+	RNG::setGenerator(gen);
+      else
+	QDP_error_exit("unknown -rng value %s", name);
+    }
+
+    if (strcmp((*argv)[i], "-poolpages")==0)
+    {
+      const char* pages = (*argv)[++i];
+      if (strcmp(pages, "default")==0)
+	Allocator::setPoolPages(Allocator::POOL_PAGES_DEFAULT);
+      else if (strcmp(pages, "thp")==0)
+	Allocator::setPoolPages(Allocator::POOL_PAGES_THP);
+      else if (strcmp(pages, "2m")==0)
+	Allocator::setPoolPages(Allocator::POOL_PAGES_HUGE_2M);
+      else if (strcmp(pages, "1g")==0)
+	Allocator::setPoolPages(Allocator::POOL_PAGES_HUGE_1G);
+      else
+	QDP_error_exit("unknown -poolpages value %s", pages);
+    }
+
+    if (strcmp((*argv)[i], "-layout")==0)
+    {
+      const char* name = (*argv)[++i];
+      Layout::SiteOrdering order;
+      if (Layout::siteOrderingFromName(name, order))
+	Layout::setSiteOrdering(order);
+      else
+	QDP_error_exit("unknown -layout value %s", name);
+    }
+
+    if (strcmp((*argv)[i], "-table-cache")==0)
+      TableCache::setDirectory((*argv)[++i]);
+
+    if (strcmp((*argv)[i], "-tile")==0)
+    {
+      int edge;
+      sscanf((*argv)[++i], "%d", &edge);
+      Layout::setSiteTiling(edge);
+    }
+
+    if (strcmp((*argv)[i], "-numa")==0)
+    {
+      const char* mode = (*argv)[++i];
+      if (strcmp(mode, "none")==0)
+	Allocator::setLatticePlacement(Allocator::PLACE_LAZY);
+      else if (strcmp(mode, "touch")==0)
+	Allocator::setLatticePlacement(Allocator::PLACE_FIRST_TOUCH);
+      else if (strcmp(mode, "bind")==0)
+	Allocator::setLatticePlacement(Allocator::PLACE_BIND);
+      else
+	QDP_error_exit("unknown -numa mode %s", mode);
+    }
+
+    if (strcmp((*argv)[i], "-lattice-cow")==0)
+    {
+      Allocator::setLatticeCopyOnWrite(true);
+    }
+
+    if (strcmp((*argv)[i], "-fast-memory")==0)
+    {
+      const char* tier = (*argv)[++i];
+      int node = -1;
+      if (strncmp(tier, "hbw", 3) != 0 && sscanf(tier, "%d", &node) != 1)
+	QDP_error_exit("unknown -fast-memory value %s", tier);
+      const char* mb = strchr(tier, ':');
+      Allocator::setFastMemory(node, mb ? size_t(atol(mb+1))*1024*1024 : 0);
+    }
+
+    if (strcmp((*argv)[i], "-bind")==0)
+    {
+      int n_cores = 1, n_threads_per_core = 1;
+      sscanf((*argv)[++i], "%d:%d", &n_cores, &n_threads_per_core);
+      setThreadAffinity(n_cores, n_threads_per_core);
+      reportAffinity();
+    }
+
+    if (strcmp((*argv)[i], "-probe")==0)
+      HardwareProbe::setEnabled(true);
+
     if (i >= *argc) 
     {
       QDP_error_exit("missing argument at the end");
     }
   }
 
+  // Threads, pool size and kernels from the machine, after any binding
+  if (HardwareProbe::enabled())
+    HardwareProbe::run(pool_size_in_gb, pool_size_given);
+
   initProfile(__FILE__, __func__, __LINE__);
 }
 
@@ -156,8 +350,30 @@ void QDP_finalize()
     qmt_finalize();
 #endif 
 
+#if defined(QDP_USE_POOL_THREADS)
+  ThreadPool::finalize();
+#endif
+
   printProfile();
 
+  if (Allocator::allocStatsAtFinalize())
+    Allocator::printAllocStats();
+
+  Allocator::printLatticeTrace();
+
+  if (getExprCounting())
+    printExprCounts();
+
+  KernelReport::print();
+
+  ThreadReport::print();
+
+  Trace::write();
+
+  AutoTune::finalize();
+
+  TableCache::flush();
+
   isInit = false;
 }
 
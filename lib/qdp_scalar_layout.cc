@@ -6,10 +6,11 @@
  *
  * Layout
  *
- * This routine provides various layouts, including
+ * This routine provides various layouts, selected at run time, including
  *    lexicographic
  *    2-checkerboard  (even/odd-checkerboarding of sites)
  *    32-style checkerboard (even/odd-checkerboarding of hypercubes)
+ *    Morton checkerboard (blocks of each checkerboard along a Morton curve)
  */
 
 #include "qdp_diagnostics.h"
@@ -26,6 +27,16 @@ namespace QDP
   // Layout stuff specific to a scalar architecture
   namespace Layout
   {
+    //-----------------------------------------------------
+    //! One site ordering
+    /*! Layout::create tabulates these functions */
+    struct SiteOrderingFuncs
+    {
+      int (*linearSiteIndex)(const multi1d<int>& coord);
+      multi1d<int> (*siteCoords)(int node, int linearsite);
+    };
+
+
     //-----------------------------------------------------
     //! Local data specific to a scalar architecture
     /*! 
@@ -53,6 +64,9 @@ namespace QDP
       //! IO Grid size
       multi1d<int> iogrid;
 
+      //! Site ordering fixed at create
+      SiteOrdering ordering;
+
     } _layout;
 
 
@@ -156,26 +170,50 @@ namespace QDP
       return _layout.iogrid;
     }
 	  
+    //! The functions of the selected site ordering, defined below
+    static const SiteOrderingFuncs& orderingFuncs(SiteOrdering order);
+
+    //! The site tables, see qdp_layout.cc
+    void initSiteTables(int (*index)(const multi1d<int>& coord), 
+			multi1d<int> (*coords)(int node, int linear), int node, 
+			const multi1d<int>& origin);
+    void initMortonTables();
+    bool loadSiteTables();
+    void storeSiteTables();
+    int tableLinearSiteIndex(const int* coord);
+    multi1d<int> tableSubgridCoords(int linear);
+    void tableSubgridCoords(int linear, int* coord);
+
     //! Initializer for layout
     void init() {}
 
     //! The linearized site index for the corresponding lexicographic site
     int linearSiteIndex(int lexicosite)
     {
-      return linearSiteIndex(crtesn(lexicosite, lattSize()));
+      LatticeCoord coord;
+      lexicoCoord(lexicosite, coord);
+
+      return tableLinearSiteIndex(coord.data());
     }
 
     //! Initializer for all the layout defaults
     void initDefaults()
     {
-      // Default set and subsets
+      // Default set and subsets, none kept from another layout
+      QDPTime_t t0 = getClockTime();
+      Set::clearCache();
       initDefaultSets();
+      startupPhase("sets", 1.0e-9*(getClockTime() - t0));
 
       // Default maps
+      t0 = getClockTime();
       initDefaultMaps();
+      startupPhase("maps", 1.0e-9*(getClockTime() - t0));
 
       // Initialize RNG
+      t0 = getClockTime();
       RNG::initDefaultRNG();
+      startupPhase("rng", 1.0e-9*(getClockTime() - t0));
 
       // Set default profile level
       setProfileLevel(getProgramProfileLevel());
@@ -184,6 +222,17 @@ namespace QDP
       setIONodeGridDefaults();	
     }
 
+    //! What the tables of this node depend on, for the table cache
+    static std::vector<int> tableCacheGeometry()
+    {
+      std::vector<int> g;
+      g.push_back(Nd);
+      g.push_back(_layout.ordering);
+      for(int i=0; i < Nd; ++i)
+	g.push_back(_layout.nrow[i]);
+      return g;
+    }
+
     //! Initializer for layout
     void create()
     {
@@ -206,6 +255,23 @@ namespace QDP
       _layout.logical_coord = 0;
       _layout.logical_size = 1;
 
+      // Tabulate the ordering of the sites, or read it from the table cache
+      _layout.ordering = siteOrdering();
+      TableCache::open(tableCacheGeometry());
+      QDPTime_t t0 = getClockTime();
+      if (! loadSiteTables())
+      {
+	if (_layout.ordering == ORDER_MORTON)
+	  initMortonTables();
+	else
+	{
+	  const SiteOrderingFuncs& funcs = orderingFuncs(_layout.ordering);
+	  initSiteTables(funcs.linearSiteIndex, funcs.siteCoords, 0, _layout.logical_coord);
+	}
+	storeSiteTables();
+      }
+      startupPhase("tables", 1.0e-9*(getClockTime() - t0));
+
 #if QDP_DEBUG >= 2
       fprintf(stderr,"vol=%d\n",_layout.vol);
 #endif
@@ -236,6 +302,7 @@ namespace QDP
       QDPIO::cout << "  total number of nodes = " << 1 << std::endl;
       QDPIO::cout << "  total volume = " << _layout.vol << std::endl;
       QDPIO::cout << "  subgrid volume = " << _layout.vol << std::endl;
+      QDPIO::cout << "  site ordering = " << siteOrderingName(_layout.ordering) << std::endl;
 
 
       // Sanity check - check the layout functions make sense
@@ -263,20 +330,26 @@ namespace QDP
       }
      size_t pool_size_in_MB = static_cast<size_t>(floor(pool_size_in_gb*1024.0));
 
+      t0 = getClockTime();
       Allocator::theQDPAllocator::Instance().init(pool_size_in_MB);
+      startupPhase("pool", 1.0e-9*(getClockTime() - t0));
       // Initialize various defaults
       initDefaults();
 
+      if (TableCache::active())
+      {
+	QDPIO::cout << "  table cache: " << TableCache::numLoaded() << " tables read, "
+		    << TableCache::numStored() << " made" << std::endl;
+	TableCache::flush();
+      }
+
+      printStartupTimes();
       QDPIO::cout << "Finished lattice layout" << std::endl;
     }
   }
 
 
   //-----------------------------------------------------------------------------
-#if QDP_USE_LEXICO_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a lexicographic layout")
-
   namespace Layout
   {
     //! Reconstruct the lattice coordinate from the node and site number
@@ -284,14 +357,14 @@ QDPXX_MESSAGE("Using a lexicographic layout")
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    static multi1d<int> lexicoSiteCoords(int node, int linearsite) // ignore node
     {
       return crtesn(linearsite, lattSize());
     }
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is a simple lexicographic lattice ordering */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int lexicoLinearSiteIndex(const multi1d<int>& coord)
     {
       return local_site(coord, lattSize());
     }
@@ -300,10 +373,6 @@ QDPXX_MESSAGE("Using a lexicographic layout")
 
   //-----------------------------------------------------------------------------
 
-#elif QDP_USE_CB2_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
-
   namespace Layout
   {
     //! Reconstruct the lattice coordinate from the node and site number
@@ -311,7 +380,7 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    static multi1d<int> cb2SiteCoords(int node, int linearsite) // ignore node
     {
       int vol_cb = vol() >> 1;
       multi1d<int> cb_nrow = lattSize();
@@ -332,7 +401,7 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int cb2LinearSiteIndex(const multi1d<int>& coord)
     {
       int vol_cb = vol() >> 1;
       multi1d<int> cb_nrow = lattSize();
@@ -355,9 +424,7 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout")
 
   //-----------------------------------------------------------------------------
 
-#elif QDP_USE_CB3D_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout but in 3D. Time running fastest")
+#if QDP_USE_CB3D_LAYOUT == 1
 
   namespace Layout
   {
@@ -371,7 +438,7 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout but in 3D. Time running
      * NB: Time is local and fastest running 
      */
 
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    static multi1d<int> cb3dSiteCoords(int node, int linearsite) // ignore node
     {
       int vol_cb = vol() / 2;
       multi1d<int> cb_nrow = lattSize();
@@ -395,7 +462,7 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout but in 3D. Time running
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 2 checkerboard (red/black) lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int cb3dLinearSiteIndex(const multi1d<int>& coord)
     {
       int vol_cb = vol() / 2;
       multi1d<int> cb_nrow = lattSize();
@@ -416,13 +483,10 @@ QDPXX_MESSAGE("Using a 2 checkerboard (red/black) layout but in 3D. Time running
     }
   }
 
+#endif
 
   //-----------------------------------------------------------------------------
 
-#elif QDP_USE_CB32_LAYOUT == 1
-
-QDPXX_MESSAGE("Using a 32 checkerboard layout")
-
   namespace Layout
   {
     //! Reconstruct the lattice coordinate from the node and site number
@@ -430,7 +494,7 @@ QDPXX_MESSAGE("Using a 32 checkerboard layout")
      * This is the inverse of the nodeNumber and linearSiteIndex functions.
      * The API requires this function to be here.
      */
-    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    static multi1d<int> cb32SiteCoords(int node, int linearsite) // ignore node
     {
       int vol_cb = vol() >> (Nd+1);
       multi1d<int> cb_nrow(Nd);
@@ -460,7 +524,7 @@ QDPXX_MESSAGE("Using a 32 checkerboard layout")
 
     //! The linearized site index for the corresponding coordinate
     /*! This layout is appropriate for a 32-style checkerboard lattice */
-    int linearSiteIndex(const multi1d<int>& coord)
+    static int cb32LinearSiteIndex(const multi1d<int>& coord)
     {
       int vol_cb = vol() >> (Nd+1);
       multi1d<int> cb_nrow(Nd);
@@ -489,11 +553,67 @@ QDPXX_MESSAGE("Using a 32 checkerboard layout")
     }
   }
 
-#else
-
-#error "no appropriate layout defined"
+  //-----------------------------------------------------------------------------
+  namespace Layout
+  {
+    //! The functions of an ordering
+    static const SiteOrderingFuncs& orderingFuncs(SiteOrdering order)
+    {
+      static const SiteOrderingFuncs lexico = {lexicoLinearSiteIndex, lexicoSiteCoords};
+      static const SiteOrderingFuncs cb2 = {cb2LinearSiteIndex, cb2SiteCoords};
+#if QDP_USE_CB3D_LAYOUT == 1
+      static const SiteOrderingFuncs cb3d = {cb3dLinearSiteIndex, cb3dSiteCoords};
+#endif
+      static const SiteOrderingFuncs cb32 = {cb32LinearSiteIndex, cb32SiteCoords};
 
+      switch (order)
+      {
+      case ORDER_LEXICO:
+	return lexico;
+      case ORDER_CB2:
+	return cb2;
+#if QDP_USE_CB3D_LAYOUT == 1
+      case ORDER_CB3D:
+	return cb3d;
 #endif
+      case ORDER_CB32:
+	return cb32;
+      default:
+	QDP_error_exit("Layout::create - the %s layout is not available", siteOrderingName(order));
+      }
+
+      return lexico;
+    }
+
+    //! Reconstruct the lattice coordinate from the node and site number
+    /*! Looked up in the tables made by create */
+    multi1d<int> siteCoords(int node, int linearsite) // ignore node
+    {
+      return tableSubgridCoords(linearsite);
+    }
+
+    //! The linearized site index for the corresponding coordinate
+    /*! Looked up in the tables made by create */
+    int linearSiteIndex(const multi1d<int>& coord)
+    {
+      return tableLinearSiteIndex(coord.slice());
+    }
+
+    //! The linearized site index for the corresponding coordinate
+    int linearSiteIndex(const LatticeCoord& coord)
+    {
+      return tableLinearSiteIndex(coord.data());
+    }
+
+    //! All sites are on node 0
+    int nodeNumber(const LatticeCoord& coord) {return 0;}
+
+    //! Reconstruct the lattice coordinate from the node and site number
+    void siteCoords(int node, int linearsite, LatticeCoord& coord) // ignore node
+    {
+      tableSubgridCoords(linearsite, coord.data());
+    }
+  }
 
   //-----------------------------------------------------------------------------
 
@@ -18,6 +18,11 @@ void Map::make(const MapFunc& func)
   QDP_info("Map::make");
 #endif
 
+  // A displacement made by an earlier job of this geometry
+  const std::string key = TableCache::mapKey(func);
+  if (! key.empty() && TableCache::load(key + " goffsets", goffsets) && goffsets.size() == Layout::vol())
+    return;
+
   //--------------------------------------
   // Setup the communication index arrays
   goffsets.resize(Layout::vol());
@@ -30,19 +35,36 @@ void Map::make(const MapFunc& func)
   // nrow is not used here. Comment it out to satisfy -Wall 
   // const multi1d<int>& nrow = Layout::lattSize();
 
+  // A fixed displacement is applied here instead of through func
+  Layout::LatticeCoord disp;
+  const bool displaced = func.displacement(disp);
+  const multi1d<int>& nrow = Layout::lattSize();
+
   // Loop over the sites on this node
-#pragma omp parallel for
-  for(int linear=0; linear < Layout::vol(); ++linear)
-  {
-    // Get the true lattice coord of this linear site index
-    multi1d<int> coord = Layout::siteCoords(0, linear);
+  dispatch_range(Layout::vol(), [&](int lo, int hi, int myId) {
+      for(int linear=lo; linear < hi; ++linear)
+      {
+	// Get the true lattice coord of this linear site index
+	Layout::LatticeCoord coord;
+	Layout::siteCoords(0, linear, coord);
+
+	// Source neighbor for this destination site
+	Layout::LatticeCoord fcoord;
+	if (displaced)
+	{
+	  for(int m=0; m < Nd; ++m)
+	    fcoord[m] = ((coord[m] + disp[m]) % nrow[m] + nrow[m]) % nrow[m];
+	}
+	else
+	  fcoord = func(coord,+1);
 
-    // Source neighbor for this destination site
-    multi1d<int> fcoord = func(coord,+1);
+	// Source linear site and node
+	goffsets[linear] = Layout::linearSiteIndex(fcoord);
+      }
+    });
 
-    // Source linear site and node
-    goffsets[linear] = Layout::linearSiteIndex(fcoord);
-  }
+  if (! key.empty())
+    TableCache::store(key + " goffsets", goffsets);
 
 #if 0
   for(int ipos=0; ipos < Layout::vol(); ++ipos)
@@ -52,6 +74,44 @@ void Map::make(const MapFunc& func)
 
 
 
+//! dest(x) = src(x+offsets) for a record of bytes bytes at each site
+void Map::shiftRecords(void* dest, const void* src, size_t bytes)
+{
+  MapInternal::RecordArgs a = {(char*)dest, (const char*)src, bytes, goffsets.slice(), 0};
+  dispatch_to_threads(goffsets.size(), a, MapInternal::recordKernel);
+}
+
+
+void Map::shiftCompact(void* dest, const Subset& ds, const int* dpos,
+		       const void* src, const int* spos, int nsrc, size_t bytes)
+{
+  MapInternal::CompactArgs a = {(char*)dest, (const char*)src, bytes, goffsets.slice(),
+				ds.siteTable().slice(), dpos, spos, nsrc};
+  dispatch_to_threads(ds.numSiteTable(), a, MapInternal::compactKernel);
+}
+
+
+//! Function object for a set whose second subset is empty
+class SetNoneFunc : public SetFunc
+{
+public:
+  int operator() (const multi1d<int>& coordinate) const {return 0;}
+  int numSubsets() const {return 2;}
+};
+
+
+//! Sites of s whose mapped source comes from another node - none
+const Subset& Map::boundary(const Subset& s)
+{
+  static Set* none = 0;
+  if (none == 0)
+    none = new Set(SetNoneFunc());
+
+  return (*none)[1];
+}
+
+
+
 //-----------------------------------------------------------------------
 // Compute simple NERSC-like checksum of a gauge field
 /*
@@ -65,80 +125,7 @@ void Map::make(const MapFunc& func)
 uint32_t computeChecksum(const multi1d<LatticeColorMatrix>& u,
 			   int mat_size)
 {
-  size_t size = sizeof(REAL32);
-  size_t su3_size = size*mat_size;
-  uint32_t checksum = 0;   // checksum
-  const int nodeSites = Layout::sitesOnNode();
-
-  multi1d<multi1d<ColorMatrix> > sa(Nd);   // extract gauge fields
-
-  for(int dd=0; dd<Nd; dd++)        /* dir */
-  {
-    sa[dd].resize(nodeSites);
-    QDP_extract(sa[dd], u[dd], all);
-  }
-
-  char  *chk_buf = new(std::nothrow) char[su3_size];
-  if( chk_buf == 0x0 ) { 
-    QDP_error_exit("Unable to allocate chk_buf\n");
-  }
-
-  for(int linear=0; linear < nodeSites; ++linear)
-  {
-    for(int dd=0; dd<Nd; dd++)        /* dir */
-    {
-      switch (mat_size)
-      {
-      case 12:
-      {
-	REAL32 su3[2][3][2];
-
-	for(int kk=0; kk<Nc; kk++)      /* color */
-	  for(int ii=0; ii<2; ii++)    /* color */
-	  {
-	    Complex sitecomp = peekColor(sa[dd][linear],ii,kk);
-	    su3[ii][kk][0] = toFloat(Real(real(sitecomp)));
-	    su3[ii][kk][1] = toFloat(Real(imag(sitecomp)));
-	  }
-
-	memcpy(chk_buf, &(su3[0][0][0]), su3_size);
-      }
-      break;
-
-      case 18:
-      {
-	REAL32 su3[3][3][2];
-
-	for(int kk=0; kk<Nc; kk++)      /* color */
-	  for(int ii=0; ii<Nc; ii++)    /* color */
-	  {
-	    Complex sitecomp = peekColor(sa[dd][linear],ii,kk);
-	    su3[ii][kk][0] = toFloat(Real(real(sitecomp)));
-	    su3[ii][kk][1] = toFloat(Real(imag(sitecomp)));
-	  }
-
-	memcpy(chk_buf, &(su3[0][0][0]), su3_size);
-      }
-      break;
-
-      default:
-	QDPIO::cerr << __func__ << ": unexpected size" << std::endl;
-	QDP_abort(1);
-      }
-
-      // Compute checksum
-      uint32_t* chk_ptr = (uint32_t*)chk_buf;
-      for(int i=0; i < mat_size*size/sizeof(uint32_t); ++i)
-	checksum += chk_ptr[i];
-    }
-  }
-
-  delete[] chk_buf;
-
-  // Get all nodes to contribute
-  QDPInternal::globalSumArray((unsigned int*)&checksum, 1);   // g++ requires me to narrow the type to unsigned int
-
-  return checksum;
+  return nerscChecksum(u, mat_size);
 }
 
 
@@ -303,4 +290,28 @@ void writeArchiv(BinaryWriter& cfg_out, const multi1d<LatticeColorMatrix>& u,
 }
 
 
+//-----------------------------------------------------------------------------
+// Replicated fields: one node, so the copy is a plain one
+namespace ReplicaInternal
+{
+  struct Store::Impl
+  {
+    std::vector<char> buf;
+  };
+
+  Store::Store(size_t bytes) : impl(new Impl)
+  {
+    impl->buf.resize(bytes + 1);
+  }
+
+  Store::~Store() {delete impl;}
+
+  bool Store::shared() const {return false;}
+
+  char* Store::data() const {return &impl->buf[0];}
+
+  void Store::allGather(size_t offset, size_t block) {}
+}
+
+
 } // namespace QDP;
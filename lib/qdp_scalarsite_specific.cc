@@ -8,6 +8,12 @@
 
 #include "qdp.h"
 #include "qdp_util.h"
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <atomic>
 
 namespace QDP {
 
@@ -25,17 +31,32 @@ namespace Layout
     if (mu < 0 || mu >= Nd)
       QDP_error_exit("dimension out of bounds");
 
-    /* This pragma is from Jacques... Should be OK, since each i is independent
-     * no danger of concurrent writes */
-#pragma omp parallel for
-    for(int i=0; i < nodeSites; ++i) 
-    {
-      Integer cc = Layout::siteCoords(nodeNumber,i)[mu];
-      d.elem(i) = cc.elem();
-    }
+    // Each i is independent, no danger of concurrent writes
+    dispatch_range(nodeSites, [&](int lo, int hi, int myId) {
+	Layout::LatticeCoord coord;
+	for(int i=lo; i < hi; ++i)
+	{
+	  Layout::siteCoords(nodeNumber, i, coord);
+	  d.elem(i).elem().elem().elem() = coord[mu];
+	}
+      });
 
     return d;
   }
+
+  static int site_tiling = 0;
+
+  //! Visit sites in tiles of edge^Nd sites of the local lattice
+  void setSiteTiling(int edge)
+  {
+    if (edge < 0)
+      QDP_error_exit("setSiteTiling: negative tile edge %d", edge);
+
+    site_tiling = edge;
+  }
+
+  //! The tile edge of setSiteTiling, 0 when off
+  int siteTiling() {return site_tiling;}
 }
 
 
@@ -51,136 +72,376 @@ std::ostream& operator<<(std::ostream& s, const multi1d<T>& s1)
 }
 
 
+//-----------------------------------------------------------------------------
+namespace
+{
+  //! user argument for colorRunsKernel
+  struct ColorRunsArgs
+  {
+    const int* color;
+    std::vector<ColorRun>* runs;   // per thread
+  };
+
+  //! user function cutting the sites [lo,hi) into runs of one color
+  void colorRunsKernel(int lo, int hi, int myId, ColorRunsArgs* a)
+  {
+    std::vector<ColorRun>& r = a->runs[myId];
+    for(int i=lo; i < hi; ++i)
+      if (r.empty() || r.back().color != a->color[i])
+      {
+	ColorRun run = {i, a->color[i]};
+	r.push_back(run);
+      }
+  }
+
+  //! user argument for sitePosKernel
+  struct SitePosArgs
+  {
+    const ColorRun* runs;          // with the end entry
+    const int* pos;                // site table position of the first site of each run
+    int* sitepos;
+  };
+
+  //! user function filling the site positions of the runs [lo,hi)
+  void sitePosKernel(int lo, int hi, int myId, SitePosArgs* a)
+  {
+    for(int r=lo; r < hi; ++r)
+      for(int i=a->runs[r].site; i < a->runs[r+1].site; ++i)
+	a->sitepos[i] = a->pos[r] + (i - a->runs[r].site);
+  }
+
+  //! user argument for colorKernel
+  struct ColorArgs
+  {
+    const SetFunc* fun;
+    int* color;
+    int nsubset;
+  };
+
+  //! user function coloring the sites [lo,hi)
+  void colorKernel(int lo, int hi, int myId, ColorArgs* a)
+  {
+    a->fun->colorSites(lo, hi, a->color + lo);
+
+    for(int linear=lo; linear < hi; ++linear)
+      if (a->color[linear] < 0 || a->color[linear] >= a->nsubset)
+	QDP_error_exit("Set: coloring is outside legal range: color[%d]=%d",linear,a->color[linear]);
+  }
+
+  //! The stamp of the last coloring made
+  std::atomic<unsigned long> last_stamp(0);
+
+  //! The sets of the SetFuncs with a cacheKey, by key and site tiling
+  std::map<std::string, std::unique_ptr<Set> >& setCache()
+  {
+    static std::map<std::string, std::unique_ptr<Set> > c;
+    return c;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+//! Make the subsets of the colors in lat_color
+void Set::makeRuns(int nsubset_indices)
+{
+  const int nodeSites = lat_color.size();
+
+  // Cached thread partitions are keyed by site tables, which may be
+  // freed and handed out again below
+  Partition::clear();
+
+  // Intersections and unions made with the old colors are not of this set
+  stamp = ++last_stamp;
+
+  // This actually allocates the subsets
+  sub.resize(nsubset_indices);
+
+  // Create the array holding the array of sitetable info
+  sitetables.resize(nsubset_indices);
+
+  /*
+   * The runs of one color are cut on the threads, each over its share of
+   * the sites, and joined where a run crosses from one share to the
+   * next. The runs of a subset are then its runs of consecutive sites,
+   * and a scan over the runs, not the sites, gives their site table
+   * positions. The site tables are only filled when something asks for
+   * them, so a set of many small subsets costs little more than its
+   * coloring.
+   */
+  std::vector< std::vector<ColorRun> > truns(qdpNumThreads());
+  ColorRunsArgs ca = {lat_color.slice(), &truns[0]};
+  dispatch_to_threads(nodeSites, ca, colorRunsKernel);
+
+  std::sort(truns.begin(), truns.end(),
+	    [](const std::vector<ColorRun>& a, const std::vector<ColorRun>& b)
+	    {return ! a.empty() && (b.empty() || a[0].site < b[0].site);});
+
+  std::vector<ColorRun> cruns;
+  for(int t=0; t < truns.size(); ++t)
+    for(int r=0; r < truns[t].size(); ++r)
+      if (cruns.empty() || cruns.back().color != truns[t][r].color)
+	cruns.push_back(truns[t][r]);
+
+  colorruns.resize(cruns.size() + 1);
+  for(int r=0; r < cruns.size(); ++r)
+    colorruns[r] = cruns[r];
+  ColorRun cend = {nodeSites, -1};
+  colorruns[cruns.size()] = cend;
+
+  std::vector< std::vector<SiteRun> > runs(nsubset_indices);
+  std::vector<int> count(nsubset_indices, 0);
+  std::vector<int> pos(cruns.size());
+  for(int r=0; r < cruns.size(); ++r)
+  {
+    const int cb = cruns[r].color;
+    SiteRun run = {cruns[r].site, count[cb]};
+    runs[cb].push_back(run);
+    pos[r] = count[cb];
+    count[cb] += colorruns[r+1].site - cruns[r].site;
+  }
+
+  sitepos.resize(nodeSites);
+  SitePosArgs sa = {colorruns.slice(), pos.data(), &sitepos[0]};
+  dispatch_to_threads(cruns.size(), sa, sitePosKernel);
+
+  runtables.resize(nsubset_indices);
+
+  for(int cb=0; cb < nsubset_indices; ++cb)
+  {
+    multi1d<SiteRun>& runtable = runtables[cb];
+    runtable.resize(runs[cb].size() + 1);
+    for(int r=0; r < runs[cb].size(); ++r)
+      runtable[r] = runs[cb][r];
+
+    SiteRun end = {-1, count[cb]};
+    runtable[runs[cb].size()] = end;
+
+    sub[cb].make(&(runtables[cb]), &(sitetables[cb]), cb, this);
+
+#if QDP_DEBUG >= 2
+    QDP_info("Subset(%d): %d sites in %d runs",cb,count[cb],int(runs[cb].size()));
+#endif
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+namespace
+{
+  //! user argument for combineKernel
+  struct CombineArgs
+  {
+    const int* color_a;
+    int a;
+    const int* color_b;
+    int b;
+    bool both;
+    int* color;
+  };
+
+  //! user function coloring 0 the sites [lo,hi) of the intersection or union
+  void combineKernel(int lo, int hi, int myId, CombineArgs* p)
+  {
+    for(int i=lo; i < hi; ++i)
+    {
+      const bool in_a = (p->color_a[i] == p->a);
+      const bool in_b = (p->color_b[i] == p->b);
+      p->color[i] = (p->both ? (in_a && in_b) : (in_a || in_b)) ? 0 : 1;
+    }
+  }
+
+  //! Stamp and color of each operand, in order, and intersection or union
+  typedef std::tuple<unsigned long, int, unsigned long, int, bool> CombineKey;
+
+  //! The two color sets of the intersections and unions made so far
+  std::map<CombineKey, std::unique_ptr<Set> >& combineCache()
+  {
+    static std::map<CombineKey, std::unique_ptr<Set> > c;
+    return c;
+  }
+}
+
+
+//! The intersection or union of a and b, as subset 0 of a kept set
+const Subset& Set::combine(const Subset& a, const Subset& b, bool both)
+{
+  const Set& sa = a.getSet();
+  const Set& sb = b.getSet();
+
+  if (sa.lat_color.size() != sb.lat_color.size())
+    QDP_error_exit("Subset %s: the subsets are of lattices of %d and %d sites",
+		   both ? "intersection" : "union", sa.lat_color.size(), sb.lat_color.size());
+
+  // The operations commute
+  CombineKey key(sa.stamp, a.color(), sb.stamp, b.color(), both);
+  if (std::make_pair(sb.stamp, b.color()) < std::make_pair(sa.stamp, a.color()))
+    key = CombineKey(sb.stamp, b.color(), sa.stamp, a.color(), both);
+
+  std::unique_ptr<Set>& kept = combineCache()[key];
+  if (! kept)
+  {
+    kept.reset(new Set);
+    kept->lat_color.resize(sa.lat_color.size());
+
+    CombineArgs p = {sa.lat_color.slice(), a.color(), sb.lat_color.slice(), b.color(), both, &kept->lat_color[0]};
+    dispatch_to_threads(sa.lat_color.size(), p, combineKernel);
+
+    // Tiles follow the subgrid of Layout, which a LatticeLayout need not have
+    kept->makeRuns(2);
+    if (sa.lat_color.size() == Layout::sitesOnNode())
+      kept->makeTiles(2);
+  }
+
+  return (*kept)[0];
+}
+
+
+//-----------------------------------------------------------------------------
+//! Forget the sets kept for SetFuncs with a cacheKey
+void Set::clearCache()
+{
+  setCache().clear();
+  combineCache().clear();
+}
+
+//! Number of sets kept for SetFuncs with a cacheKey
+int Set::numCached()
+{
+  return setCache().size();
+}
+
+
 //-----------------------------------------------------------------------------
 //! Constructor from a function object
 void Set::make(const SetFunc& fun)
+{
+  // A coloring made before is copied, its subsets sharing the tables
+  const std::string name = fun.cacheKey();
+  if (! name.empty())
+  {
+    const std::string key = name + " tiling " + std::to_string(Layout::siteTiling());
+    std::unique_ptr<Set>& kept = setCache()[key];
+    if (! kept)
+    {
+      kept.reset(new Set);
+      kept->build(fun);
+    }
+
+    // The tables this set drops may key cached thread partitions
+    Partition::clear();
+    *this = *kept;
+    return;
+  }
+
+  build(fun);
+}
+
+
+//! Color the sites with fun and make the subsets
+void Set::build(const SetFunc& fun)
 {
   int nsubset_indices = fun.numSubsets();
   const int nodeSites = Layout::sitesOnNode();
-  const int nodeNumber = Layout::nodeNumber();
+  slicedir = fun.sliceDirection();
 
 #if QDP_DEBUG >= 2
   QDP_info("Set a subset: nsubset = %d",nsubset_indices);
 #endif
 
-  // This actually allocates the subsets
-  sub.resize(nsubset_indices);
+  // A named coloring may come from an earlier job of this geometry
+  const std::string name = fun.cacheKey();
+  if (name.empty() || ! TableCache::load("set " + name, lat_color) || lat_color.size() != nodeSites)
+  {
+    // Create the space of the colorings of the lattice
+    lat_color.resize(nodeSites);
 
-  // Create the space of the colorings of the lattice
-  lat_color.resize(nodeSites);
+    // Color the sites in batches on the threads
+    ColorArgs a = {&fun, &lat_color[0], nsubset_indices};
+    dispatch_to_threads(nodeSites, a, colorKernel);
 
-  // Create the array holding the array of sitetable info
-  sitetables.resize(nsubset_indices);
+    if (! name.empty())
+      TableCache::store("set " + name, lat_color);
+  }
 
-  // Loop over linear sites determining their color
-  /* This OMP pragma added by Jacques. Should be OK since in the end 
-     each value of linear is independent */
+#if QDP_DEBUG >= 1
+  // Sanity checks of the layout
+  const int nodeNumber = Layout::nodeNumber();
 #pragma omp parallel for
   for(int linear=0; linear < nodeSites; ++linear)
   {
-    multi1d<int> coord = Layout::siteCoords(nodeNumber, linear);
+    Layout::LatticeCoord coord;
+    Layout::siteCoords(nodeNumber, linear, coord);
 
     int node   = Layout::nodeNumber(coord);
     int lin    = Layout::linearSiteIndex(coord);
-    int icolor = fun(coord);
 
 #if QDP_DEBUG >= 3
-    std::cerr<<"linear="<<linear<<" coord="<<coord<<" node="<<node<<" col="<<icolor << std::endl;
+    std::cerr<<"linear="<<linear<<" coord="<<coord<<" node="<<node<<" col="<<lat_color[linear] << std::endl;
 #endif
 
-    // Sanity checks
     if (node != nodeNumber)
       QDP_error_exit("Set: found site with node outside current node!");
 
     if (lin != linear)
       QDP_error_exit("Set: inconsistent linear sites");
+  }
+#endif
 
-    if (icolor < 0 || icolor >= nsubset_indices)
-      QDP_error_exit("Set: coloring is outside legal range: color[%d]=%d",linear,icolor);
+  makeRuns(nsubset_indices);
+  makeTiles(nsubset_indices);
+}
 
-    // The coloring of this linear site
-    lat_color[linear] = icolor;
-  }
-  
-  
-  /*
-   * Loop over the lexicographic sites.
-   * This implementation of the Set will always use a
-   * sitetable.
-   */
 
-  /* NB: This OMP parallel added by Jacques.
-   * Should be OK because each subset is independent, 
-   * tho the number of subsets may be small... so scope for improvement
-   * from threading may be limited */
+//-----------------------------------------------------------------------------
+//! Order the sites of each subset tile by tile when the sites are tiled
+void Set::makeTiles(int nsubset_indices)
+{
+  const int nodeSites = lat_color.size();
+  const int nodeNumber = Layout::nodeNumber();
+
+  const int edge = Layout::siteTiling();
+  tiletables.resize((edge > 0) ? nsubset_indices : 0);
+  if (edge == 0)
+    return;
+
+  // Tile of each site on the node, lexicographic in the local coordinates
+  const multi1d<int>& subgrid = Layout::subgridLattSize();
+  multi1d<int> tile(nodeSites);
+  int ntiles = 1;
+  for(int m=0; m < Nd; ++m)
+    ntiles *= (subgrid[m] + edge - 1) / edge;
 
 #pragma omp parallel for
-  for(int cb=0; cb < nsubset_indices; ++cb)
+  for(int linear=0; linear < nodeSites; ++linear)
   {
-    // Always construct the sitetables. 
+    multi1d<int> coord = Layout::siteCoords(nodeNumber, linear);
 
-    // First loop and see how many sites are needed
-    int num_sitetable = 0;
+    int t = 0;
+    for(int m=Nd-1; m >= 0; --m)
+      t = t*((subgrid[m] + edge - 1) / edge) + (coord[m] % subgrid[m]) / edge;
 
-    /* FIXME: This is a 'histogram' -- not yet threaded */
-    for(int linear=0; linear < nodeSites; ++linear) {
-      if (lat_color[linear] == cb) {
-	++num_sitetable;
-      }
-    }
-    // Now take the inverse of the lattice coloring to produce
-    // the site list
-    multi1d<int>& sitetable = sitetables[cb];
-    sitetable.resize(num_sitetable);
+    tile[linear] = t;
+  }
 
+#pragma omp parallel for
+  for(int cb=0; cb < nsubset_indices; ++cb)
+  {
+    // Counting sort keeps the layout order within a tile
+    const multi1d<int>& sitetable = sub[cb].siteTable();
+    multi1d<int>& tiletable = tiletables[cb];
+    tiletable.resize(sitetable.size());
 
-    // Site ordering stuff for later
-    bool ordRep;
-    int start, end;
+    std::vector<int> first(ntiles+1, 0);
+    for(int j=0; j < sitetable.size(); ++j)
+      ++first[tile[sitetable[j]]+1];
 
-    // Handle the case that there are no sites
-    if (num_sitetable > 0)
-    {
-      // For later sanity, initialize this to something 
-      for(int i=0; i < num_sitetable; ++i)
-	sitetable[i] = -1;
-
-      for(int linear=0, j=0; linear < nodeSites; ++linear)
-	if (lat_color[linear] == cb)
-	  sitetable[j++] = linear;
-
-
-      // Check *if* this coloring is contiguous and find the start
-      // and ending sites
-      ordRep = true;
-      start = sitetable[0];   // this is the beginning
-      end = sitetable[sitetable.size()-1];  // the absolute last site
-      
-      // Now look for a hole
-      for(int prev=sitetable[0], i=0; i < sitetable.size(); ++i)
-	if (sitetable[i] != prev++)
-	{
-#if QDP_DEBUG >= 2
-	  QDP_info("Set(%d): sitetable[%d]=%d",cb,i,sitetable[i]);
-#endif
-	
-	  // Found a hold. The rep is not ordered.
-	  ordRep = false;
-	  start = end = -1;
-	  break;
-	}
-    }
-    else  // num_sitetable == 0
-    {
-      ordRep = false;
-      start = end = -1;
-    }
+    for(int t=0; t < ntiles; ++t)
+      first[t+1] += first[t];
 
-    sub[cb].make(ordRep, start, end, &(sitetables[cb]), cb, this);
+    for(int j=0; j < sitetable.size(); ++j)
+      tiletable[first[tile[sitetable[j]]]++] = sitetable[j];
 
-#if QDP_DEBUG >= 2
-    QDP_info("Subset(%d)",cb);
-#endif
+    sub[cb].tiletable = &(tiletables[cb]);
   }
 }
 	  
@@ -57,11 +57,17 @@ void Set::make(const SetFunc& func)
 {
   int nsubset_indices = func.numSubsets();
   const int nodeSites = Layout::sitesOnNode();
+  slicedir = func.sliceDirection();
 
 #if QDP_DEBUG >= 2
   QDP_info("Set a subset: nsubset = %d",nsubset_indices);
 #endif
 
+#if defined(ARCH_PARSCALARVEC)
+  // The site tables are remade, so are the lane masks taken from them
+  OuterGrid::clear();
+#endif
+
   // This actually allocates the subsets
   sub.resize(nsubset_indices);
 
@@ -0,0 +1,97 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Site orders of buffers shared with external libraries
+ */
+
+#include "qdp.h"
+#include "qdp_site_export.h"
+#include "qdp_util.h"
+
+namespace QDP
+{
+
+  namespace
+  {
+    //! The sites of this node by lex index within the subgrid
+    std::vector<int> subgridLexico()
+    {
+      const multi1d<int>& sub = Layout::subgridLattSize();
+      std::vector<int> sites(Layout::sitesOnNode());
+
+      for(int linear=0; linear < Layout::sitesOnNode(); ++linear)
+      {
+	multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), linear);
+	for(int mu=0; mu < Nd; ++mu)
+	  coord[mu] %= sub[mu];
+
+	sites[local_site(coord, sub)] = linear;
+      }
+
+      return sites;
+    }
+
+    void checkVectorLength(int veclen)
+    {
+      if (veclen < 1)
+	QDP_error_exit("SiteOrder: vector length %d", veclen);
+    }
+  }
+
+
+  SiteOrder::SiteOrder(std::vector<int>& s, int n) : veclen(n)
+  {
+    checkVectorLength(veclen);
+    slots.swap(s);
+  }
+
+
+  SiteOrder::SiteOrder(const multi1d<int>& sites, int n) : slots(sites.size()), veclen(n)
+  {
+    checkVectorLength(veclen);
+    for(int j=0; j < sites.size(); ++j)
+    {
+      if (sites[j] < 0 || sites[j] >= Layout::sitesOnNode())
+	QDP_error_exit("SiteOrder: site %d of slot %d is not on the node", sites[j], j);
+      slots[j] = sites[j];
+    }
+  }
+
+
+  SiteOrder SiteOrder::lexico(int veclen)
+  {
+    std::vector<int> sites = subgridLexico();
+    return SiteOrder(sites, veclen);
+  }
+
+
+  SiteOrder SiteOrder::evenOdd(int veclen)
+  {
+    std::vector<int> lex = subgridLexico();
+    std::vector<int> sites;
+    sites.reserve(lex.size());
+
+    // Parity of the global coordinates, so it agrees with rb[0] and rb[1]
+    for(int cb=0; cb < 2; ++cb)
+      for(size_t k=0; k < lex.size(); ++k)
+      {
+	multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), lex[k]);
+	int sum = 0;
+	for(int mu=0; mu < Nd; ++mu)
+	  sum += coord[mu];
+
+	if (sum % 2 == cb)
+	  sites.push_back(lex[k]);
+      }
+
+    return SiteOrder(sites, veclen);
+  }
+
+
+  SiteOrder SiteOrder::subset(const Subset& s, int veclen)
+  {
+    const int* tab = s.siteTable().slice();
+    std::vector<int> sites(tab, tab + s.numSiteTable());
+    return SiteOrder(sites, veclen);
+  }
+
+} // namespace QDP
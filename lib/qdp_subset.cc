@@ -4,6 +4,7 @@
 
 #include "qdp.h"
 #include "qdp_util.h"
+#include <mutex>
 
 namespace QDP 
 {
@@ -37,6 +38,7 @@ namespace QDP
   public:
     int operator() (const multi1d<int>& coordinate) const {return 0;}
     int numSubsets() const {return 1;}
+    std::string cacheKey() const {return "all";}
   };
 
   
@@ -54,6 +56,7 @@ namespace QDP
       }
 
     int numSubsets() const {return 2;}
+    std::string cacheKey() const {return "checkerboard " + std::to_string(Nd);}
   };
 
   //! Function object used for constructing red-black (2) checkerboard in 3d
@@ -74,6 +77,7 @@ namespace QDP
       }
 
     int numSubsets() const {return 2;}
+    std::string cacheKey() const {return "checkerboard 3";}
   };
 
   
@@ -96,9 +100,136 @@ namespace QDP
       }
 
     int numSubsets() const {return 1 << (Nd+1);}
+    std::string cacheKey() const {return "mcb";}
   };
 
 
+  //---------------------------------------------------------------------
+  // The built in colorings call their coordinate version directly, not
+  // through the virtual table, on each site of a batch
+
+  SetTimeSliceFunc::SetTimeSliceFunc(int dir_) : dir(dir_)
+  {
+    if (dir < 0 || dir >= Nd)
+      QDP_error_exit("SetTimeSliceFunc: no direction %d", dir);
+
+    nslice = Layout::lattSize()[dir];
+  }
+
+  void SetTimeSliceFunc::colorSites(int lo, int hi, int* color) const
+  {
+    const int node = Layout::nodeNumber();
+    Layout::LatticeCoord coord;
+    for(int i=lo; i < hi; ++i)
+    {
+      Layout::siteCoords(node, i, coord);
+      color[i-lo] = coord[dir];
+    }
+  }
+
+  std::string SetTimeSliceFunc::cacheKey() const
+  {
+    return "timeslice " + std::to_string(dir);
+  }
+
+
+  SetCheckerboardFunc::SetCheckerboardFunc(int ndim_) : ndim(ndim_)
+  {
+    if (ndim < 1 || ndim > Nd)
+      QDP_error_exit("SetCheckerboardFunc: cannot checkerboard %d directions", ndim);
+  }
+
+  int SetCheckerboardFunc::operator() (const multi1d<int>& coordinate) const
+  {
+    int sum = 0;
+    for(int m=0; m < ndim; ++m)
+      sum += coordinate[m];
+
+    return sum & 1;
+  }
+
+  int SetCheckerboardFunc::operator() (const Layout::LatticeCoord& coordinate) const
+  {
+    int sum = 0;
+    for(int m=0; m < ndim; ++m)
+      sum += coordinate[m];
+
+    return sum & 1;
+  }
+
+  void SetCheckerboardFunc::colorSites(int lo, int hi, int* color) const
+  {
+    const int node = Layout::nodeNumber();
+    Layout::LatticeCoord coord;
+    for(int i=lo; i < hi; ++i)
+    {
+      Layout::siteCoords(node, i, coord);
+      color[i-lo] = SetCheckerboardFunc::operator()(coord);
+    }
+  }
+
+  std::string SetCheckerboardFunc::cacheKey() const
+  {
+    return "checkerboard " + std::to_string(ndim);
+  }
+
+
+  SetBlockFunc::SetBlockFunc(const multi1d<int>& block_) : block(block_), nblocks(Nd)
+  {
+    if (block.size() != Nd)
+      QDP_error_exit("SetBlockFunc: need a block edge in each of %d directions, have %d", Nd, block.size());
+
+    nblock = 1;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      const int latt = Layout::lattSize()[mu];
+      if (block[mu] <= 0 || latt % block[mu] != 0)
+	QDP_error_exit("SetBlockFunc: block edge %d does not divide the lattice extent %d in direction %d",
+		       block[mu], latt, mu);
+
+      nblocks[mu] = latt / block[mu];
+      nblock *= nblocks[mu];
+    }
+  }
+
+  int SetBlockFunc::operator() (const multi1d<int>& coordinate) const
+  {
+    int b = 0;
+    for(int mu=Nd-1; mu >= 0; --mu)
+      b = b*nblocks[mu] + coordinate[mu] / block[mu];
+
+    return b;
+  }
+
+  int SetBlockFunc::operator() (const Layout::LatticeCoord& coordinate) const
+  {
+    int b = 0;
+    for(int mu=Nd-1; mu >= 0; --mu)
+      b = b*nblocks[mu] + coordinate[mu] / block[mu];
+
+    return b;
+  }
+
+  void SetBlockFunc::colorSites(int lo, int hi, int* color) const
+  {
+    const int node = Layout::nodeNumber();
+    Layout::LatticeCoord coord;
+    for(int i=lo; i < hi; ++i)
+    {
+      Layout::siteCoords(node, i, coord);
+      color[i-lo] = SetBlockFunc::operator()(coord);
+    }
+  }
+
+  std::string SetBlockFunc::cacheKey() const
+  {
+    std::string key = "block";
+    for(int mu=0; mu < Nd; ++mu)
+      key += " " + std::to_string(block[mu]);
+    return key;
+  }
+
+
   //! Initializer for sets
   void initDefaultSets()
   {
@@ -133,8 +264,56 @@ namespace QDP
     startSite = _start;
     endSite   = _end;
     sub_index = cb;
+    numSites  = ind->size();
     sitetable = ind;
+    runtable  = 0;
+    tiletable = 0;
     set       = _set;
+    built     = true;
+  }
+
+  //! Simple constructor called to produce a Subset from the runs of a Set
+  void Subset::make(multi1d<SiteRun>* runs, multi1d<int>* ind, int cb, Set* _set)
+  {
+    const int nruns = runs->size() - 1;
+
+    // One run is a contiguous range
+    numSites  = (*runs)[nruns].pos;
+    ordRep    = (nruns == 1);
+    startSite = ordRep ? (*runs)[0].site : -1;
+    endSite   = ordRep ? (*runs)[0].site + numSites - 1 : -1;
+    sub_index = cb;
+    sitetable = ind;
+    runtable  = runs;
+    tiletable = 0;
+    set       = _set;
+    built     = (numSites == ind->size());
+  }
+
+  namespace
+  {
+    //! Serialises the first fills of the site tables
+    std::mutex sitetable_lock;
+  }
+
+  //! Fill the site table from the runs
+  void Subset::buildSiteTable() const
+  {
+    std::lock_guard<std::mutex> lock(sitetable_lock);
+
+    // Another copy of this subset may have filled it
+    if (sitetable->size() != numSites)
+    {
+      multi1d<int> tab(numSites);
+      const multi1d<SiteRun>& runs = *runtable;
+      for(int r=0; r < runs.size()-1; ++r)
+	for(int j=runs[r].pos; j < runs[r+1].pos; ++j)
+	  tab[j] = runs[r].site + (j - runs[r].pos);
+
+      *sitetable = std::move(tab);
+    }
+
+    built.store(true, std::memory_order_release);
   }
 
   //! Simple constructor called to produce a Subset from inside a Set
@@ -144,8 +323,12 @@ namespace QDP
     startSite = s.startSite;
     endSite   = s.endSite;
     sub_index = s.sub_index;
+    numSites  = s.numSites;
     sitetable = s.sitetable;
+    runtable  = s.runtable;
+    tiletable = s.tiletable;
     set       = s.set;
+    built     = s.built.load();
   }
 
   //! Simple constructor called to produce a Subset from inside a Set
@@ -162,6 +345,12 @@ namespace QDP
     sub = s.sub;
     lat_color = s.lat_color;
     sitetables = s.sitetables;
+    runtables = s.runtables;
+    colorruns = s.colorruns;
+    sitepos = s.sitepos;
+    tiletables = s.tiletables;
+    stamp = s.stamp;
+    slicedir = s.slicedir;
     return *this;
   }
 
@@ -0,0 +1,205 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Writing and reading a box of sites straight from the nodes holding them
+ */
+
+#include "qdp.h"
+#include "qdp_byteorder.h"
+#include "qdp_subvolume_io.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace QDP
+{
+
+  SubvolumeIO::SubvolumeIO(const multi1d<int>& lower_left, const multi1d<int>& upper_right) :
+    lo(lower_left), hi(upper_right)
+  {
+    if (lo.size() != Nd || hi.size() != Nd)
+      QDP_error_exit("SubvolumeIO: corners need %d coordinates", Nd);
+
+    box_vol = 1;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (lo[mu] < 0 || hi[mu] >= Layout::lattSize()[mu] || lo[mu] > hi[mu])
+	QDP_error_exit("SubvolumeIO: invalid box in direction %d", mu);
+      box_vol *= hi[mu] - lo[mu] + 1;
+    }
+
+    // Pieces of an x-row, each inside one node subgrid
+    const int sx = Layout::subgridLattSize()[0];
+    nseg = hi[0]/sx - lo[0]/sx + 1;
+    for(int s=0; s < nseg; ++s)
+    {
+      int x0 = std::max(lo[0], (lo[0]/sx + s)*sx);
+      int x1 = std::min(hi[0], (lo[0]/sx + s + 1)*sx - 1);
+      seg_len.push_back(x1 - x0 + 1);
+    }
+
+    // The sites here in the box, in file order
+    std::vector<std::pair<size_t,int> > here;
+    for(int linear=0; linear < Layout::sitesOnNode(); ++linear)
+    {
+      multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), linear);
+
+      bool inside = true;
+      size_t b = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+      {
+	if (coord[mu] < lo[mu] || coord[mu] > hi[mu])
+	  inside = false;
+	b = b*(hi[mu] - lo[mu] + 1) + (coord[mu] - lo[mu]);
+      }
+
+      if (inside)
+	here.push_back(std::make_pair(b, linear));
+    }
+    std::sort(here.begin(), here.end());
+
+    const int row_len = hi[0] - lo[0] + 1;
+    for(size_t k=0; k < here.size(); ++k)
+    {
+      const size_t b = here[k].first;
+      const int x = lo[0] + int(b % row_len);
+      const int id = int(b / row_len)*nseg + (x/sx - lo[0]/sx);
+
+      if (run_id.empty() || run_id.back() != id)
+      {
+	runs.push_back(b);
+	run_id.push_back(id);
+	run_len.push_back(0);
+      }
+      ++run_len.back();
+      sites.push_back(here[k].second);
+    }
+  }
+
+
+  SubvolumeIO SubvolumeIO::timeSlices(int t0, int t1)
+  {
+    multi1d<int> lower_left(Nd), upper_right(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      lower_left[mu] = 0;
+      upper_right[mu] = Layout::lattSize()[mu] - 1;
+    }
+    lower_left[Nd-1] = t0;
+    upper_right[Nd-1] = t1;
+
+    return SubvolumeIO(lower_left, upper_right);
+  }
+
+
+  QDPUtil::n_uint32_t SubvolumeIO::writeSites(const std::string& path, const char* data,
+					      size_t size, size_t nmemb, off_t start) const
+  {
+    const size_t sizemem = size*nmemb;
+    std::vector<unsigned int> crcs(box_vol/(hi[0] - lo[0] + 1)*nseg, 0);
+
+    if (! sites.empty())
+    {
+      // No truncation: other boxes may share the file
+      int fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+      if (fd < 0)
+	QDP_error_exit("SubvolumeIO: cannot open %s on node %d", path.c_str(), Layout::nodeNumber());
+
+      std::vector<char> buf(sites.size()*sizemem);
+
+      size_t k = 0;
+      for(size_t r=0; r < runs.size(); ++r)
+      {
+	// Gather, swap and checksum the piece, then write it in one go
+	char* piece = &buf[k*sizemem];
+	QDPUtil::n_uint32_t crc = 0;
+	for(int i=0; i < run_len[r]; ++i, ++k)
+	  crc = QDPUtil::crc32_to_big_endian(crc, &buf[k*sizemem], data + sites[k]*sizemem, size, nmemb);
+	crcs[run_id[r]] = crc;
+
+	const char* p = piece;
+	size_t n = run_len[r]*sizemem;
+	off_t off = start + off_t(runs[r])*sizemem;
+	while (n > 0)
+	{
+	  ssize_t w = pwrite(fd, p, n, off);
+	  if (w <= 0)
+	    QDP_error_exit("SubvolumeIO: pwrite to %s failed on node %d", path.c_str(), Layout::nodeNumber());
+	  p += w;
+	  off += w;
+	  n -= w;
+	}
+      }
+
+      if (::close(fd) != 0)
+	QDP_error_exit("SubvolumeIO: error closing %s on node %d", path.c_str(), Layout::nodeNumber());
+    }
+
+    return combine(crcs, sizemem);
+  }
+
+
+  QDPUtil::n_uint32_t SubvolumeIO::readSites(const std::string& path, char* data,
+					     size_t size, size_t nmemb, off_t start) const
+  {
+    const size_t sizemem = size*nmemb;
+    std::vector<unsigned int> crcs(box_vol/(hi[0] - lo[0] + 1)*nseg, 0);
+
+    if (! sites.empty())
+    {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+	QDP_error_exit("SubvolumeIO: cannot open %s on node %d", path.c_str(), Layout::nodeNumber());
+
+      std::vector<char> buf(sites.size()*sizemem);
+
+      size_t k = 0;
+      for(size_t r=0; r < runs.size(); ++r)
+      {
+	char* piece = &buf[k*sizemem];
+
+	char* p = piece;
+	size_t n = run_len[r]*sizemem;
+	off_t off = start + off_t(runs[r])*sizemem;
+	while (n > 0)
+	{
+	  ssize_t got = pread(fd, p, n, off);
+	  if (got <= 0)
+	    QDP_error_exit("SubvolumeIO: pread from %s failed on node %d", path.c_str(), Layout::nodeNumber());
+	  p += got;
+	  off += got;
+	  n -= got;
+	}
+
+	// Checksum and swap the piece, then scatter it
+	QDPUtil::n_uint32_t crc = 0;
+	for(int i=0; i < run_len[r]; ++i, ++k)
+	  crc = QDPUtil::crc32_from_big_endian(crc, data + sites[k]*sizemem, &buf[k*sizemem], size, nmemb);
+	crcs[run_id[r]] = crc;
+      }
+
+      if (::close(fd) != 0)
+	QDP_error_exit("SubvolumeIO: error closing %s on node %d", path.c_str(), Layout::nodeNumber());
+    }
+
+    return combine(crcs, sizemem);
+  }
+
+
+  QDPUtil::n_uint32_t SubvolumeIO::combine(std::vector<unsigned int>& crcs, size_t sizemem) const
+  {
+    QDPInternal::globalSumArray(&crcs[0], crcs.size());
+
+    // One shift operator for each piece of a row
+    std::vector<QDPUtil::CRC32Shift> op(nseg);
+    for(int s=0; s < nseg; ++s)
+      QDPUtil::crc32_shift(op[s], seg_len[s]*sizemem);
+
+    QDPUtil::n_uint32_t crc = 0;
+    for(size_t k=0; k < crcs.size(); ++k)
+      crc = QDPUtil::crc32_combine(op[k % nseg], crc, crcs[k]);
+
+    return crc;
+  }
+
+} // namespace QDP
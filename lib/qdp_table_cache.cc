@@ -0,0 +1,301 @@
+/*! @file
+ * @brief On-disk cache of the layout, set and map tables of identical jobs
+ *
+ * A file holds a header and the tables one after another:
+ *
+ *   "QDPTBL1"  magic, 8 bytes
+ *   int n, int geometry[n]
+ *   per table: int namelen, char name[namelen], long long count,
+ *              unsigned int crc32, int data[count]
+ *
+ * all in the byte order of the node, which the geometry records.
+ */
+
+#include "qdp.h"
+#include "qdp_byteorder.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace QDP
+{
+  namespace TableCache
+  {
+    namespace
+    {
+      const char magic[8] = "QDPTBL1";
+
+      //! Bumped when the tables of a geometry change meaning
+      const int format_version = 1;
+
+      std::string cache_dir;
+
+      //! The file of this node, empty when no layout opened the cache
+      std::string file;
+      std::vector<int> geom;
+
+      //! The mapped file
+      char* mapped = 0;
+      size_t mapped_len = 0;
+
+      //! A table in the mapped file
+      struct Entry
+      {
+	const char* data;
+	long long count;
+	unsigned int crc;
+      };
+      std::map<std::string, Entry> in_file;
+
+      //! Tables made since the file was read, written at flush
+      std::map<std::string, std::vector<int> > kept;
+
+      int nloaded = 0, nstored = 0;
+
+      void unmap()
+      {
+	if (mapped)
+	  munmap(mapped, mapped_len);
+	mapped = 0;
+	mapped_len = 0;
+	in_file.clear();
+      }
+
+      //! Map the file and index its tables, nothing when it is absent or not for this geometry
+      void mapFile()
+      {
+	unmap();
+
+	int fd = ::open(file.c_str(), O_RDONLY);
+	if (fd < 0)
+	  return;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+	  void* p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	  if (p != MAP_FAILED)
+	  {
+	    mapped = (char*)p;
+	    mapped_len = st.st_size;
+	  }
+	}
+	::close(fd);
+
+	if (! mapped)
+	  return;
+
+	// Header: the magic and the geometry, which must be that of the job
+	size_t pos = 0;
+	int n = -1;
+	if (mapped_len < sizeof(magic) + sizeof(int) || memcmp(mapped, magic, sizeof(magic)) != 0)
+	{
+	  QDP_info("TableCache: %s is not a table file, ignored", file.c_str());
+	  unmap();
+	  return;
+	}
+	pos = sizeof(magic);
+	memcpy(&n, mapped + pos, sizeof(int));
+	pos += sizeof(int);
+
+	if (n != geom.size() || mapped_len - pos < n*sizeof(int) ||
+	    memcmp(mapped + pos, geom.data(), n*sizeof(int)) != 0)
+	{
+	  QDP_info("TableCache: %s is for another geometry, ignored", file.c_str());
+	  unmap();
+	  return;
+	}
+	pos += n*sizeof(int);
+
+	// The tables, up to the first that does not fit the file
+	while (pos < mapped_len)
+	{
+	  int namelen;
+	  Entry e;
+	  if (mapped_len - pos < sizeof(int))
+	    break;
+	  memcpy(&namelen, mapped + pos, sizeof(int));
+	  pos += sizeof(int);
+
+	  if (namelen < 0 || mapped_len - pos < namelen + sizeof(long long) + sizeof(unsigned int))
+	    break;
+	  std::string name(mapped + pos, namelen);
+	  pos += namelen;
+	  memcpy(&e.count, mapped + pos, sizeof(long long));
+	  pos += sizeof(long long);
+	  memcpy(&e.crc, mapped + pos, sizeof(unsigned int));
+	  pos += sizeof(unsigned int);
+
+	  if (e.count < 0 || (mapped_len - pos)/sizeof(int) < e.count)
+	    break;
+	  e.data = mapped + pos;
+	  pos += e.count*sizeof(int);
+
+	  in_file[name] = e;
+	}
+
+	if (pos != mapped_len)
+	  QDP_info("TableCache: %s is truncated, the last tables are made again", file.c_str());
+      }
+
+      unsigned int crcOf(const char* data, long long count)
+      {
+	return QDPUtil::crc32(0, data, size_t(count)*sizeof(int));
+      }
+
+      //! Append a table to f
+      bool writeTable(FILE* f, const std::string& name, const char* data, long long count)
+      {
+	const int namelen = name.size();
+	const unsigned int crc = crcOf(data, count);
+	return fwrite(&namelen, sizeof(int), 1, f) == 1
+	  && fwrite(name.data(), 1, namelen, f) == namelen
+	  && fwrite(&count, sizeof(long long), 1, f) == 1
+	  && fwrite(&crc, sizeof(unsigned int), 1, f) == 1
+	  && (count == 0 || fwrite(data, sizeof(int), count, f) == count);
+      }
+    }
+
+
+    void setDirectory(const std::string& dir) {cache_dir = dir;}
+
+    const std::string& directory() {return cache_dir;}
+
+    bool active() {return ! file.empty();}
+
+    void open(const std::vector<int>& geometry)
+    {
+      unmap();
+      kept.clear();
+      file.clear();
+      nloaded = nstored = 0;
+
+      if (cache_dir.empty())
+	return;
+
+      // The byte order and word size are part of the geometry
+      geom.clear();
+      geom.push_back(format_version);
+      geom.push_back(0x01020304);
+      geom.push_back(sizeof(int));
+      geom.push_back(sizeof(long long));
+      geom.insert(geom.end(), geometry.begin(), geometry.end());
+
+      // FNV-1a of the geometry names the file
+      unsigned long long h = 14695981039346656037ull;
+      for(int i=0; i < geom.size(); ++i)
+	for(int b=0; b < 4; ++b)
+	  h = (h ^ ((unsigned int)geom[i] >> (8*b) & 0xff)) * 1099511628211ull;
+
+      char name[64];
+      snprintf(name, sizeof(name), "/qdp-tables-%016llx-%d.bin", h, Layout::nodeNumber());
+      file = cache_dir + name;
+
+      mapFile();
+    }
+
+
+    bool load(const std::string& name, multi1d<int>& t)
+    {
+      if (file.empty())
+	return false;
+
+      std::map<std::string, Entry>::iterator p = in_file.find(name);
+      if (p == in_file.end())
+	return false;
+
+      const Entry& e = p->second;
+      if (crcOf(e.data, e.count) != e.crc)
+      {
+	QDP_info("TableCache: table %s of %s fails its checksum, made again", name.c_str(), file.c_str());
+	in_file.erase(p);
+	return false;
+      }
+
+      t.resize(e.count);
+      if (e.count > 0)
+	memcpy(&t[0], e.data, size_t(e.count)*sizeof(int));
+
+      ++nloaded;
+      return true;
+    }
+
+
+    void store(const std::string& name, const multi1d<int>& t)
+    {
+      if (file.empty())
+	return;
+
+      std::vector<int>& v = kept[name];
+      v.assign(t.slice(), t.slice() + t.size());
+      ++nstored;
+    }
+
+
+    void flush()
+    {
+      if (file.empty() || kept.empty())
+	return;
+
+      // Write beside the file and move it in place, so that jobs
+      // starting meanwhile read the old file or the new one whole
+      char suffix[32];
+      snprintf(suffix, sizeof(suffix), ".%d.tmp", int(getpid()));
+      const std::string tmp = file + suffix;
+
+      FILE* f = fopen(tmp.c_str(), "wb");
+      if (! f)
+      {
+	QDP_info("TableCache: cannot write %s", tmp.c_str());
+	kept.clear();
+	return;
+      }
+
+      const int n = geom.size();
+      bool ok = fwrite(magic, 1, sizeof(magic), f) == sizeof(magic)
+	&& fwrite(&n, sizeof(int), 1, f) == 1
+	&& fwrite(geom.data(), sizeof(int), n, f) == n;
+
+      for(std::map<std::string, Entry>::const_iterator p=in_file.begin(); ok && p != in_file.end(); ++p)
+	if (kept.find(p->first) == kept.end())
+	  ok = writeTable(f, p->first, p->second.data, p->second.count);
+
+      for(std::map<std::string, std::vector<int> >::const_iterator p=kept.begin(); ok && p != kept.end(); ++p)
+	ok = writeTable(f, p->first, (const char*)p->second.data(), p->second.size());
+
+      ok = (fclose(f) == 0) && ok;
+      if (! ok || rename(tmp.c_str(), file.c_str()) != 0)
+      {
+	QDP_info("TableCache: writing %s failed", file.c_str());
+	remove(tmp.c_str());
+      }
+
+      kept.clear();
+      mapFile();
+    }
+
+
+    std::string mapKey(const MapFunc& func)
+    {
+      Layout::LatticeCoord disp;
+      if (! func.displacement(disp))
+	return std::string();
+
+      std::string key = "map";
+      for(int m=0; m < Nd; ++m)
+	key += " " + std::to_string(disp[m]);
+      return key;
+    }
+
+
+    int numLoaded() {return nloaded;}
+
+    int numStored() {return nstored;}
+  }
+
+} // namespace QDP
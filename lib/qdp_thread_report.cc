@@ -0,0 +1,184 @@
+/*! @file
+ * @brief Per-thread timing of the parallel regions
+ */
+
+#include "qdp.h"
+#include <map>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace QDP
+{
+  namespace ThreadReport
+  {
+    namespace
+    {
+      bool report_on = false;
+
+      __thread Region* scope_region = 0;
+      __thread bool in_dispatch = false;
+
+      std::mutex lock;
+
+      std::map<std::string, Region*>& byName()
+      {
+	static std::map<std::string, Region*> t;
+	return t;
+      }
+
+      std::map<const std::type_info*, Region*>& byArg()
+      {
+	static std::map<const std::type_info*, Region*> t;
+	return t;
+      }
+
+      double ms(QDPTime_t t) {return t*1.0e-6;}
+
+      bool longer(const Region* a, const Region* b) {return a->wall > b->wall;}
+    }
+
+
+    void setEnabled(bool on) {report_on = on;}
+
+    bool enabled() {return report_on;}
+
+
+    Region* region(const std::string& name)
+    {
+      std::lock_guard<std::mutex> g(lock);
+
+      Region*& r = byName()[name];
+      if (r == 0)
+      {
+	r = new Region;
+	r->name = name;
+	r->calls = 0;
+	r->sites = 0;
+	r->wall = r->busy_min = r->busy_mean = r->busy_max = 0;
+	r->fork = r->join = 0;
+      }
+      return r;
+    }
+
+
+    Region* region(const std::type_info& op, const std::type_info& rhs)
+    {
+      return region(KernelReport::typeName(op.name()) + " " + KernelReport::typeName(rhs.name()));
+    }
+
+
+    Region* region(const std::type_info& arg)
+    {
+      {
+	std::lock_guard<std::mutex> g(lock);
+	std::map<const std::type_info*, Region*>::const_iterator p = byArg().find(&arg);
+	if (p != byArg().end())
+	  return p->second;
+      }
+
+      Region* r = region("kernel " + KernelReport::typeName(arg.name()));
+
+      std::lock_guard<std::mutex> g(lock);
+      byArg()[&arg] = r;
+      return r;
+    }
+
+
+    Scope::Scope(Region* r) : prev(scope_region), set(r != 0)
+    {
+      if (set)
+	scope_region = r;
+    }
+
+
+    Scope::~Scope()
+    {
+      if (set)
+	scope_region = prev;
+    }
+
+
+    Region* current() {return scope_region;}
+
+    bool timing() {return in_dispatch;}
+
+    void setTiming(bool on) {in_dispatch = on;}
+
+
+    QDPTime_t* stamps(int n)
+    {
+      thread_local std::vector<QDPTime_t> st;
+      st.assign(2*n, 0);
+      return &st[0];
+    }
+
+
+    void record(Region* r, int n, QDPTime_t t0, QDPTime_t t1,
+		const QDPTime_t* start, const QDPTime_t* end, int threads)
+    {
+      QDPTime_t busy_min = 0, busy_max = 0, busy_sum = 0;
+      QDPTime_t last_start = t0, last_end = t0;
+      int active = 0;
+      for(int i=0; i < threads; ++i)
+      {
+	if (start[i] == 0)
+	  continue;
+
+	const QDPTime_t busy = end[i] - start[i];
+	busy_min = (active == 0) ? busy : std::min(busy_min, busy);
+	busy_max = std::max(busy_max, busy);
+	busy_sum += busy;
+	last_start = std::max(last_start, start[i]);
+	last_end = std::max(last_end, end[i]);
+	++active;
+      }
+
+      std::lock_guard<std::mutex> g(lock);
+
+      r->calls++;
+      r->sites += n;
+      r->wall += t1 - t0;
+      if (active > 0)
+      {
+	r->busy_min += busy_min;
+	r->busy_mean += busy_sum / active;
+	r->busy_max += busy_max;
+	r->fork += last_start - t0;
+	r->join += t1 - last_end;
+      }
+    }
+
+
+    void print()
+    {
+      if (! report_on)
+	return;
+
+      std::vector<const Region*> rows;
+      for(std::map<std::string, Region*>::const_iterator p=byName().begin(); p != byName().end(); ++p)
+	if (p->second->calls > 0)
+	  rows.push_back(p->second);
+
+      std::sort(rows.begin(), rows.end(), longer);
+
+      // The imbalance is the most busy thread against the mean; the
+      // overhead the part of the wall time no thread did work
+      QDPIO::cout << "Parallel regions on node 0, times in ms:" << std::endl;
+      for(int i=0; i < rows.size(); ++i)
+      {
+	const Region& r = *rows[i];
+	const double imbalance = (r.busy_mean > 0) ? double(r.busy_max) / r.busy_mean : 1.0;
+	const double overhead = (r.wall > 0) ? 100.0*(r.fork + r.join) / r.wall : 0.0;
+
+	QDPIO::cout << "  " << r.name << std::endl
+		    << "    calls= " << r.calls << "  items/call= " << r.sites / r.calls
+		    << "  wall= " << ms(r.wall)
+		    << "  busy min/mean/max= " << ms(r.busy_min) << "/" << ms(r.busy_mean) << "/" << ms(r.busy_max)
+		    << "  imbalance= " << imbalance
+		    << "  fork= " << ms(r.fork) << "  join= " << ms(r.join)
+		    << "  overhead= " << overhead << "%" << std::endl;
+      }
+    }
+  }
+}
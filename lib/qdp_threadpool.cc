@@ -0,0 +1,228 @@
+/*! @file
+ * @brief Persistent thread pool
+ *
+ * Workers poll a generation counter for a while after each job and then
+ * sleep on a condition variable, so back to back evaluates hand over
+ * without a system call while an idle pool costs no cpu.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "qdp.h"
+#include "qdp_threadpool.h"
+
+namespace QDP
+{
+  namespace ThreadPool
+  {
+    namespace
+    {
+      int num_threads = 1;
+      bool pinP = false;
+      int spin_count = 10000;
+
+      pthread_t *workers = 0;
+      cpu_set_t allowed;
+
+      //! The current job
+      userfunc_t job_func = 0;
+      void *job_arg = 0;
+      int job_n = 0;
+      int job_active = 0;
+
+      volatile unsigned long generation = 0;
+      unsigned long start_generation = 0;
+      volatile int remaining = 0;
+      volatile bool shutdown = false;
+
+      pthread_mutex_t wake_mutex = PTHREAD_MUTEX_INITIALIZER;
+      pthread_cond_t wake_cond = PTHREAD_COND_INITIALIZER;
+
+      __thread int my_id = 0;
+      __thread bool busyP = false;
+
+      //! Bind the calling thread to the id-th allowed cpu
+      void pin(int id)
+      {
+	int ncpu = CPU_COUNT(&allowed);
+	if (ncpu == 0)
+	  return;
+
+	int k = id % ncpu;
+	for(int cpu=0; cpu < CPU_SETSIZE; ++cpu)
+	{
+	  if (! CPU_ISSET(cpu, &allowed))
+	    continue;
+
+	  if (k-- == 0)
+	  {
+	    cpu_set_t mask;
+	    CPU_ZERO(&mask);
+	    CPU_SET(cpu, &mask);
+	    pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+	    return;
+	  }
+	}
+      }
+
+      //! Run this thread's share of the current job
+      void runShare(int id)
+      {
+	if (id >= job_active)
+	  return;
+
+	int lo = (job_n*id)/job_active;
+	int hi = (job_n*(id+1))/job_active;
+	job_func(lo, hi, id, job_arg);
+      }
+
+      void* workerLoop(void *arg)
+      {
+	my_id = (int)(long)arg;
+	busyP = true;
+
+	if (pinP)
+	  pin(my_id);
+
+	unsigned long seen = start_generation;
+	for(;;)
+	{
+	  for(int spin=0; spin < spin_count && generation == seen; ++spin)
+	    ;
+
+	  if (generation == seen)
+	  {
+	    pthread_mutex_lock(&wake_mutex);
+	    while (generation == seen)
+	      pthread_cond_wait(&wake_cond, &wake_mutex);
+	    pthread_mutex_unlock(&wake_mutex);
+	  }
+
+	  __sync_synchronize();
+	  seen = generation;
+
+	  if (shutdown)
+	    break;
+
+	  runShare(my_id);
+	  __sync_fetch_and_sub(&remaining, 1);
+	}
+
+	return 0;
+      }
+
+      //! Wake all workers on a new generation
+      void release()
+      {
+	pthread_mutex_lock(&wake_mutex);
+	__sync_fetch_and_add(&generation, 1);
+	pthread_cond_broadcast(&wake_cond);
+	pthread_mutex_unlock(&wake_mutex);
+      }
+
+      int getEnvInt(const char *name, int def)
+      {
+	const char *val = getenv(name);
+	return (val == 0) ? def : atoi(val);
+      }
+    }
+
+
+    int init()
+    {
+      if (workers != 0)
+	return 0;
+
+      CPU_ZERO(&allowed);
+      if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+	CPU_ZERO(&allowed);
+
+      int ncpu = CPU_COUNT(&allowed);
+      num_threads = getEnvInt("QDP_NUM_THREADS", (ncpu > 0) ? ncpu : 1);
+      pinP = (getEnvInt("QDP_PIN_THREADS", 0) != 0);
+      spin_count = getEnvInt("QDP_SPIN_COUNT", spin_count);
+
+      if (num_threads < 1)
+	return 1;
+
+      if (pinP)
+	pin(0);
+
+      shutdown = false;
+      start_generation = generation;
+      workers = new pthread_t[num_threads];
+
+      for(int id=1; id < num_threads; ++id)
+      {
+	if (pthread_create(&workers[id], 0, workerLoop, (void *)(long)id) != 0)
+	{
+	  // Keep the threads that did start
+	  num_threads = id;
+	  return 2;
+	}
+      }
+
+      return 0;
+    }
+
+
+    void finalize()
+    {
+      if (workers == 0)
+	return;
+
+      shutdown = true;
+      release();
+
+      for(int id=1; id < num_threads; ++id)
+	pthread_join(workers[id], 0);
+
+      delete[] workers;
+      workers = 0;
+      num_threads = 1;
+    }
+
+
+    int numThreads()
+    {
+      return num_threads;
+    }
+
+
+    int threadNum()
+    {
+      return my_id;
+    }
+
+
+    void call(userfunc_t func, int n, void *arg)
+    {
+      // Serial when there is nobody to share with or when nested
+      if (num_threads == 1 || busyP)
+      {
+	func(0, n, my_id, arg);
+	return;
+      }
+
+      job_func = func;
+      job_arg = arg;
+      job_n = n;
+      job_active = (num_threads > n) ? n : num_threads;
+      remaining = num_threads - 1;
+
+      release();
+
+      busyP = true;
+      runShare(0);
+      busyP = false;
+
+      for(int spin=0; remaining > 0; ++spin)
+	if (spin >= spin_count)
+	  sched_yield();
+
+      __sync_synchronize();
+    }
+  }
+}
@@ -0,0 +1,211 @@
+/*! @file
+ * @brief Timeline of the operations
+ *
+ * Events are appended to a buffer of small fixed records on each node,
+ * naming them through a table of strings, and only turned into text when
+ * the timeline is written by QDP_finalize.
+ */
+
+#include "qdp.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <algorithm>
+
+namespace QDP
+{
+  namespace Trace
+  {
+    namespace
+    {
+      //! One event on the timeline
+      struct Record
+      {
+	QDPTime_t t0;
+	unsigned int dur;        // ns, saturated at 4 s
+	unsigned short id;
+	unsigned char cat;
+      };
+
+      //! Events kept per node before the rest are dropped - 16 bytes each
+      const size_t max_records = 1 << 24;
+
+      bool trace_on = false;
+      std::string trace_file;
+      std::mutex trace_lock;
+      std::vector<Record> records;
+      std::vector<std::string> names;
+      size_t dropped = 0;
+
+      const char* category_names[NumCategories] = {"evaluate", "comm", "user"};
+
+      //! Write s as a JSON string
+      void quote(std::ostream& os, const std::string& s)
+      {
+	os << '"';
+	for(int i=0; i < s.size(); ++i)
+	{
+	  const char c = s[i];
+	  if (c == '"' || c == '\\')
+	    os << '\\' << c;
+	  else if (c == '\n')
+	    os << "\\n";
+	  else if ((unsigned char)c < 0x20)
+	    os << ' ';
+	  else
+	    os << c;
+	}
+	os << '"';
+      }
+
+      //! The events of this node as JSON, with times in us after origin
+      std::string events(int node, QDPTime_t origin)
+      {
+	std::ostringstream os;
+	char ts[64];
+
+	os << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << node
+	   << ",\"args\":{\"name\":\"node " << node << "\"}}";
+	for(int cat=0; cat < NumCategories; ++cat)
+	  os << ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << node << ",\"tid\":" << cat
+	     << ",\"args\":{\"name\":\"" << category_names[cat] << "\"}}";
+
+	for(size_t r=0; r < records.size(); ++r)
+	{
+	  const Record& e = records[r];
+	  snprintf(ts, sizeof(ts), "%.3f,\"dur\":%.3f", 1.0e-3*double(e.t0 - origin), 1.0e-3*e.dur);
+	  os << ",\n{\"ph\":\"X\",\"pid\":" << node << ",\"tid\":" << int(e.cat)
+	     << ",\"cat\":\"" << category_names[e.cat] << "\",\"ts\":" << ts << ",\"name\":";
+	  quote(os, names[e.id]);
+	  os << "}";
+	}
+	return os.str();
+      }
+    }
+
+
+    void setTraceFile(const std::string& file)
+    {
+      std::lock_guard<std::mutex> lock(trace_lock);
+      trace_file = file;
+      trace_on = ! file.empty();
+      if (names.empty())
+	names.push_back("evaluate");
+    }
+
+
+    bool enabled()
+    {
+      return trace_on;
+    }
+
+
+    int name(const std::string& n)
+    {
+      std::lock_guard<std::mutex> lock(trace_lock);
+      for(int i=0; i < names.size(); ++i)
+	if (names[i] == n)
+	  return i;
+
+      // Ids are kept in 16 bits - the rest share the last one
+      if (names.size() == 0xffff)
+	return names.size()-1;
+
+      names.push_back(n);
+      return names.size()-1;
+    }
+
+
+    void record(int cat, int id, QDPTime_t t0, QDPTime_t t1)
+    {
+      if (! trace_on)
+	return;
+
+      Record e;
+      e.t0  = t0;
+      e.dur = std::min(t1 - t0, QDPTime_t(0xffffffffu));
+      e.id  = id;
+      e.cat = cat;
+
+      std::lock_guard<std::mutex> lock(trace_lock);
+      if (records.size() < max_records)
+	records.push_back(e);
+      else
+	++dropped;
+    }
+
+
+    void write()
+    {
+      if (trace_file.empty())
+	return;
+
+      trace_on = false;
+
+      const int nodes = Layout::numNodes();
+      const int me = Layout::nodeNumber();
+
+      // Line the nodes up at a reduction: each places its events relative
+      // to the moment it left it, leaving room for the longest lead
+      std::vector<double> lead(nodes, 0.0);
+      QDPInternal::globalSumArray(&lead[0], nodes);
+      const QDPTime_t t_sync = getClockTime();
+
+      QDPTime_t t_first = t_sync;
+      for(size_t r=0; r < records.size(); ++r)
+	t_first = std::min(t_first, records[r].t0);
+      lead.assign(nodes, 0.0);
+      lead[me] = t_sync - t_first;
+      QDPInternal::globalSumArray(&lead[0], nodes);
+      const QDPTime_t origin = t_sync - QDPTime_t(*std::max_element(lead.begin(), lead.end()));
+
+      double total_dropped = dropped;
+      QDPInternal::globalSum(total_dropped);
+
+      std::string mine = events(me, origin);
+
+      if (! Layout::primaryNode())
+      {
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+	int len = mine.size();
+	QDPInternal::sendToWait((void *)&len, 0, sizeof(int));
+	if (len > 0)
+	  QDPInternal::sendToWait((void *)mine.data(), 0, len);
+#endif
+      }
+      else
+      {
+	std::ofstream f(trace_file.c_str());
+	if (! f)
+	{
+	  QDPIO::cerr << "Trace: cannot write " << trace_file << std::endl;
+	}
+
+	f << "{\"traceEvents\":[\n" << mine;
+	for(int node=1; node < nodes; ++node)
+	{
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+	  int len;
+	  QDPInternal::recvFromWait((void *)&len, node, sizeof(int));
+	  std::string theirs(len, ' ');
+	  if (len > 0)
+	    QDPInternal::recvFromWait((void *)&theirs[0], node, len);
+	  f << ",\n" << theirs;
+#endif
+	}
+	f << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+	QDPIO::cout << "Trace: wrote the timeline of " << nodes << " nodes to " << trace_file;
+	if (total_dropped > 0)
+	  QDPIO::cout << " - " << total_dropped << " events dropped past " << max_records << " per node";
+	QDPIO::cout << std::endl;
+      }
+
+      std::lock_guard<std::mutex> lock(trace_lock);
+      records.clear();
+      dropped = 0;
+    }
+
+  } // namespace Trace
+} // namespace QDP
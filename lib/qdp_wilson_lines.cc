@@ -0,0 +1,96 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Lines of sites along a direction and their gather for qdp_wilson_lines.h
+ */
+
+#include "qdp.h"
+#include "qdp_wilson_lines.h"
+
+#include <cstring>
+
+namespace QDP
+{
+
+  namespace WilsonLinesInternal
+  {
+    Column::Column(int mu_) : mu(mu_)
+    {
+      const multi1d<int>& sub = Layout::subgridLattSize();
+      const int node = Layout::nodeNumber();
+
+      s = sub[mu];
+      np = Layout::logicalSize()[mu];
+      me = Layout::nodeCoord()[mu];
+      nlines = Layout::sitesOnNode() / s;
+
+      // Point t of line k, k the lex index of the local coordinates other than mu
+      site.resize(Layout::sitesOnNode());
+      Layout::LatticeCoord g;
+      for(int linear=0; linear < Layout::sitesOnNode(); ++linear)
+      {
+	Layout::siteCoords(node, linear, g);
+
+	int k = 0;
+	for(int nu=Nd-1; nu >= 0; --nu)
+	  if (nu != mu)
+	    k = k*sub[nu] + g[nu] % sub[nu];
+
+	site[k*s + g[mu] % s] = linear;
+      }
+
+      multi1d<int> nc = Layout::nodeCoord();
+      nodes.resize(np);
+      for(int q=0; q < np; ++q)
+      {
+	nc[mu] = q;
+	nodes[q] = Layout::getNodeNumberFrom(nc);
+      }
+    }
+
+
+    const Column& column(int mu)
+    {
+      static Column* cols[Nd] = {0};
+
+      if (mu < 0 || mu >= Nd)
+	QDP_error_exit("WilsonLines: direction %d out of range", mu);
+
+      if (cols[mu] == 0)
+	cols[mu] = new Column(mu);
+
+      return *cols[mu];
+    }
+
+
+    void allGather(const Column& c, const char* mine, char* all, size_t bytes)
+    {
+      std::memcpy(all + size_t(c.me)*bytes, mine, bytes);
+      if (c.np == 1)
+	return;
+
+      // One copy of mine to each node along mu, the blocks in node order
+      const int nodes = Layout::numNodes();
+      std::vector<size_t> send_bytes(nodes, 0), recv_bytes(nodes, 0);
+      std::vector<int> coord(nodes, -1);
+      for(int q=0; q < c.np; ++q)
+	if (q != c.me)
+	{
+	  send_bytes[c.nodes[q]] = bytes;
+	  recv_bytes[c.nodes[q]] = bytes;
+	  coord[c.nodes[q]] = q;
+	}
+
+      std::vector<char> sbuf(size_t(c.np - 1)*bytes + 1), rbuf(size_t(c.np - 1)*bytes + 1);
+      for(int q=0; q < c.np - 1; ++q)
+	std::memcpy(&sbuf[size_t(q)*bytes], mine, bytes);
+
+      QDPInternal::exchangeAll(&sbuf[0], &send_bytes[0], &rbuf[0], &recv_bytes[0]);
+
+      // Back into order along mu
+      for(int n=0, j=0; n < nodes; ++n)
+	if (coord[n] >= 0)
+	  std::memcpy(all + size_t(coord[n])*bytes, &rbuf[size_t(j++)*bytes], bytes);
+    }
+  }
+
+} // namespace QDP
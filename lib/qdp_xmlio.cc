@@ -5,6 +5,9 @@
 
 #include "qdp.h"
 #include <list>
+#include <cstdio>
+#include <cstring>
+#include <typeinfo>
 
 namespace QDP 
 {
@@ -13,24 +16,42 @@ namespace QDP
 
   //--------------------------------------------------------------------------------
   // XML classes
+  namespace
+  {
+    //! Do readers opened from now on parse on every node
+    bool parse_all_nodes = false;
+
+    //! Cache key of a query for a result of type T
+    template<typename T>
+    std::string cacheKey(const std::string& xpath, const char* what = "")
+    {
+      return xpath + '\n' + what + '\n' + typeid(T).name();
+    }
+  }
+
+  void XMLReader::setParseOnAllNodes(bool on) {parse_all_nodes = on;}
+
+  bool XMLReader::parseOnAllNodes() {return parse_all_nodes;}
+
+
   // XML reader class
-  XMLReader::XMLReader() {iop=derived=false;}
+  XMLReader::XMLReader() {iop=derived=local=false;}
 
   XMLReader::XMLReader(const std::string& filename)
   {
-    iop = derived = false;
+    iop = derived = local = false;
     open(filename);
   }
 
   XMLReader::XMLReader(std::istream& is)
   {
-    iop = derived = false;
+    iop = derived = local = false;
     open(is);
   }
 
   XMLReader::XMLReader(const XMLBufferWriter& mw)
   {
-    iop = derived = false;
+    iop = derived = local = false;
     open(mw);
   }
 
@@ -38,35 +59,59 @@ namespace QDP
   {
     iop = false;
     derived = true;
+    local = false;
     open(old, xpath);
   }
 
 
-  void XMLReader::open(const std::string& filename)
+  bool XMLReader::active() const {return local || Layout::primaryNode();}
+
+  void XMLReader::openStream(std::istream& is)
   {
+    cache.clear();
+    local = parse_all_nodes;
+
+    if (! local)
+    {
+      if (Layout::primaryNode())
+	BasicXPathReader::open(is);
+      return;
+    }
+
+    // One broadcast of the whole document, then every node parses it
+    std::string doc;
     if (Layout::primaryNode())
     {
-#if 0
-      BasicXPathReader::open(filename);
-#else
+      std::ostringstream os;
+      os << is.rdbuf();
+      doc = os.str();
+    }
+    QDPInternal::broadcast_str(doc);
 
+    std::istringstream copy(doc);
+    BasicXPathReader::open(copy);
+  }
+
+
+  void XMLReader::open(const std::string& filename)
+  {
 #if defined(USE_REMOTE_QIO)
-      QDPUtil::RemoteInputFileStream f;
+    QDPUtil::RemoteInputFileStream f;
+    if (Layout::primaryNode())
       f.open(filename.c_str(),std::ifstream::in);
-      BasicXPathReader::open(f);
 #else
-      std::ifstream f;
+    std::ifstream f;
+    if (Layout::primaryNode())
+    {
       f.open(filename.c_str(), std::ios::binary);
       if (f.fail())
       {
 	QDPIO::cerr << "Error opening read file = " << filename << std::endl;
 	QDP_abort(1);
       }
-      BasicXPathReader::open(f);
-#endif
-
-#endif
     }
+#endif
+    openStream(f);
 
     iop = true;
     derived = false;
@@ -74,8 +119,7 @@ namespace QDP
 
   void XMLReader::open(std::istream& is)
   {
-    if (Layout::primaryNode())
-      BasicXPathReader::open(is);
+    openStream(is);
 
     iop = true;
     derived = false;
@@ -83,11 +127,10 @@ namespace QDP
 
   void XMLReader::open(const XMLBufferWriter& mw)
   {
+    std::istringstream is;
     if (Layout::primaryNode())
-    {  
-      std::istringstream is(const_cast<XMLBufferWriter&>(mw).str()+"\n");
-      BasicXPathReader::open(is);
-    }
+      is.str(const_cast<XMLBufferWriter&>(mw).str()+"\n");
+    openStream(is);
 
     iop = true;
     derived = false;
@@ -95,7 +138,10 @@ namespace QDP
 
   void XMLReader::open(XMLReader& old, const std::string& xpath)
   {
-    if( Layout::primaryNode()) 
+    cache.clear();
+    local = old.local;
+
+    if (active()) 
     {
       BasicXPathReader::open((BasicXPathReader&)old, xpath);
     }
@@ -108,12 +154,13 @@ namespace QDP
   {
     if (is_open()) 
     {
-      if (Layout::primaryNode()) 
+      if (active()) 
 	BasicXPathReader::close();
 
       iop = false;
       derived = false;
     }
+    cache.clear();
   }
 
 
@@ -128,12 +175,23 @@ namespace QDP
   // Overloaded Reader Functions
   void XMLReader::get(const std::string& xpath, std::string& result)
   {
+    const std::string key = cacheKey<std::string>(xpath);
+    std::map<std::string, std::string>::const_iterator p = cache.find(key);
+    if (p != cache.end())
+    {
+      result = p->second;
+      return;
+    }
+
     // Only primary node can grab string
-    if (Layout::primaryNode()) 
+    if (active()) 
       BasicXPathReader::get(xpath, result);
 
     // broadcast string
-    QDPInternal::broadcast_str(result);
+    if (! local)
+      QDPInternal::broadcast_str(result);
+
+    cache[key] = result;
   }
 
   void XMLReader::get(const std::string& xpath, int& result)
@@ -182,12 +240,24 @@ namespace QDP
   template<typename T>
   void XMLReader::readPrimitive(const std::string& xpath, T& result)
   {
-    if (Layout::primaryNode()) {
+    // Every node asks the same queries, so they all hit or all miss
+    const std::string key = cacheKey<T>(xpath);
+    std::map<std::string, std::string>::const_iterator p = cache.find(key);
+    if (p != cache.end())
+    {
+      std::memcpy(&result, p->second.data(), sizeof(T));
+      return;
+    }
+
+    if (active()) {
       BasicXPathReader::get(xpath, result);
     }
 
     // Now broadcast back out to all nodes
-    QDPInternal::broadcast(result);
+    if (! local)
+      QDPInternal::broadcast(result);
+
+    cache[key] = std::string(reinterpret_cast<const char*>(&result), sizeof(T));
   }
 
   template<typename T>
@@ -195,12 +265,23 @@ namespace QDP
 				    const std::string& attrib_name, 
 				    T& result)
   {
-    if (Layout::primaryNode()) {
+    const std::string key = cacheKey<T>(xpath, ("@" + attrib_name).c_str());
+    std::map<std::string, std::string>::const_iterator p = cache.find(key);
+    if (p != cache.end())
+    {
+      std::memcpy(&result, p->second.data(), sizeof(T));
+      return;
+    }
+
+    if (active()) {
       BasicXPathReader::getAttribute(xpath, attrib_name, result);
     }
 
     // Now broadcast back out to all nodes
-    QDPInternal::broadcast(result);
+    if (! local)
+      QDPInternal::broadcast(result);
+
+    cache[key] = std::string(reinterpret_cast<const char*>(&result), sizeof(T));
   }
 
   void XMLReader::print(std::ostream& os)
@@ -208,14 +289,15 @@ namespace QDP
     std::ostringstream newos;
     std::string s;
 
-    if (Layout::primaryNode())
+    if (active())
     {
       BasicXPathReader::print(newos);
       s = newos.str();
     }
 
     // Now broadcast back out to all nodes
-    QDPInternal::broadcast_str(s);
+    if (! local)
+      QDPInternal::broadcast_str(s);
     os << s;
   }
    
@@ -224,7 +306,7 @@ namespace QDP
     std::ostringstream newos;
     std::string s;
 
-    if (Layout::primaryNode())
+    if (active())
     {
       if (is_derived())
 	BasicXPathReader::printChildren(newos);
@@ -235,25 +317,41 @@ namespace QDP
     }
 
     // Now broadcast back out to all nodes
-    QDPInternal::broadcast_str(s);
+    if (! local)
+      QDPInternal::broadcast_str(s);
     os << s;
   }
    
   int XMLReader::count(const std::string& xpath)
   {
+    const std::string key = cacheKey<int>(xpath, "count");
+    std::map<std::string, std::string>::const_iterator p = cache.find(key);
+    if (p != cache.end())
+    {
+      int n;
+      std::memcpy(&n, p->second.data(), sizeof(n));
+      return n;
+    }
+
     int n;
-    if (Layout::primaryNode())
+    if (active())
       n = BasicXPathReader::count(xpath);
 
     // Now broadcast back out to all nodes
-    QDPInternal::broadcast(n);
+    if (! local)
+      QDPInternal::broadcast(n);
+
+    cache[key] = std::string(reinterpret_cast<const char*>(&n), sizeof(n));
     return n;
   }
    
   // Namespace Registration?
   void XMLReader::registerNamespace(const std::string& prefix, const std::string& uri)
   {
-    if (Layout::primaryNode())
+    // A prefix may now mean something else
+    cache.clear();
+
+    if (active())
       BasicXPathReader::registerNamespace(prefix, uri);
   }
 
@@ -307,6 +405,61 @@ namespace QDP
   }
    
 
+  //! Parse a list of builtin numbers in one pass
+  /*! Throws like readArrayPrimitive when a token is not a number of the type */
+  template<typename T>
+  void readNumberList(XMLReader& xml, const std::string& xpath, std::vector<T>& result)
+  {
+    std::string list_string;
+    read(xml, xpath, list_string);
+
+    if (! NumFormat::parseList(list_string, result))
+    {
+      std::ostringstream error_message;
+      error_message << "Error in reading array " << xpath << std::endl;
+      throw error_message.str();
+    }
+  }
+
+  //! Parse numbers of word type W into a container of T
+  template<typename W, typename T>
+  void readArrayNumbers(XMLReader& xml, const std::string& xpath, multi1d<T>& result)
+  {
+    std::vector<W> v;
+    readNumberList(xml, xpath, v);
+
+    result.resize(v.size());
+    for(int i=0; i < result.size(); i++) 
+      result[i] = T(v[i]);
+  }
+
+  template<typename W, typename T>
+  void readVectorNumbers(XMLReader& xml, const std::string& xpath, std::vector<T>& result)
+  {
+    std::vector<W> v;
+    readNumberList(xml, xpath, v);
+
+    result.resize(v.size());
+    for(int i=0; i < result.size(); i++) 
+      result[i] = T(v[i]);
+  }
+
+  template<typename W, typename T>
+  void readListNumbers(XMLReader& xml, const std::string& xpath, std::list<T>& result)
+  {
+    // A list stops at the first bad token rather than failing
+    std::string list_string;
+    read(xml, xpath, list_string);
+
+    std::vector<W> v;
+    NumFormat::parseList(list_string, v);
+
+    result.clear();
+    for(int i=0; i < v.size(); i++) 
+      result.push_back(T(v[i]));
+  }
+
+
   //! Read a XML multi1d element
   template<typename T>
   void readArrayPrimitive(XMLReader& xml, const std::string& s, multi1d<T>& result)
@@ -357,42 +510,42 @@ namespace QDP
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<int>& result)
   {
-    readArrayPrimitive<int>(xml, xpath, result);
+    readArrayNumbers<int>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<unsigned int>& result)
   {
-    readArrayPrimitive<unsigned int>(xml, xpath, result);
+    readArrayNumbers<unsigned int>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<short int>& result)
   {
-    readArrayPrimitive<short int>(xml, xpath, result);
+    readArrayNumbers<short int>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<unsigned short int>& result)
   {
-    readArrayPrimitive<unsigned short int>(xml, xpath, result);
+    readArrayNumbers<unsigned short int>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<long int>& result)
   {
-    readArrayPrimitive<long int>(xml, xpath, result);
+    readArrayNumbers<long int>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<unsigned long int>& result)
   {
-    readArrayPrimitive<unsigned long int>(xml, xpath, result);
+    readArrayNumbers<unsigned long int>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<float>& result)
   {
-    readArrayPrimitive<float>(xml, xpath, result);
+    readArrayNumbers<float>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<double>& result)
   {
-    readArrayPrimitive<double>(xml, xpath, result);
+    readArrayNumbers<double>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<bool>& result)
@@ -407,12 +560,12 @@ namespace QDP
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<Real32>& result)
   {
-    readArrayPrimitive<Real32>(xml, xpath, result);
+    readArrayNumbers<float>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<Real64>& result)
   {
-    readArrayPrimitive<Real64>(xml, xpath, result);
+    readArrayNumbers<double>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, multi1d<Boolean>& result)
@@ -464,35 +617,35 @@ namespace QDP
 //! Read a XML Array element
   void read(XMLReader& xml, const std::string& xpath, std::vector<int>& result)
   {
-    readVectorPrimitive<int>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::vector<unsigned int>& result)
   {
-    readVectorPrimitive<unsigned int>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::vector<short int>& result)
   {
-    readVectorPrimitive<short int>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::vector<unsigned short int>& result)
   {
-    readVectorPrimitive<unsigned short int>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::vector<long int>& result)
   {
-    readVectorPrimitive<long int>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::vector<unsigned long int>& result)
   {
-    readVectorPrimitive<unsigned long int>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::vector<float>& result)
   {
-    readVectorPrimitive<float>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::vector<double>& result)
   {
-    readVectorPrimitive<double>(xml, xpath, result);
+    readNumberList(xml, xpath, result);
   }
 //void read(XMLReader& xml, const std::string& xpath, std::vector<bool>& result)
 //{
@@ -506,12 +659,12 @@ namespace QDP
   template<>
   void read(XMLReader& xml, const std::string& xpath, std::vector<Real32>& result)
   {
-    readVectorPrimitive<Real32>(xml, xpath, result);
+    readVectorNumbers<float>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, std::vector<Real64>& result)
   {
-    readVectorPrimitive<Real64>(xml, xpath, result);
+    readVectorNumbers<double>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, std::vector<Boolean>& result)
@@ -545,35 +698,35 @@ namespace QDP
   //! Read a XML list element
   void read(XMLReader& xml, const std::string& xpath, std::list<int>& result)
   {
-    readListPrimitive<int>(xml, xpath, result);
+    readListNumbers<int>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<unsigned int>& result)
   {
-    readListPrimitive<unsigned int>(xml, xpath, result);
+    readListNumbers<unsigned int>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<short int>& result)
   {
-    readListPrimitive<short int>(xml, xpath, result);
+    readListNumbers<short int>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<unsigned short int>& result)
   {
-    readListPrimitive<unsigned short int>(xml, xpath, result);
+    readListNumbers<unsigned short int>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<long int>& result)
   {
-    readListPrimitive<long int>(xml, xpath, result);
+    readListNumbers<long int>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<unsigned long int>& result)
   {
-    readListPrimitive<unsigned long int>(xml, xpath, result);
+    readListNumbers<unsigned long int>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<float>& result)
   {
-    readListPrimitive<float>(xml, xpath, result);
+    readListNumbers<float>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<double>& result)
   {
-    readListPrimitive<double>(xml, xpath, result);
+    readListNumbers<double>(xml, xpath, result);
   }
   void read(XMLReader& xml, const std::string& xpath, std::list<bool>& result)
   {
@@ -587,12 +740,12 @@ namespace QDP
   template<>
   void read(XMLReader& xml, const std::string& xpath, std::list<Real32>& result)
   {
-    readListPrimitive<Real32>(xml, xpath, result);
+    readListNumbers<float>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, std::list<Real64>& result)
   {
-    readListPrimitive<Real64>(xml, xpath, result);
+    readListNumbers<double>(xml, xpath, result);
   }
   template<>
   void read(XMLReader& xml, const std::string& xpath, std::list<Boolean>& result)
@@ -723,13 +876,21 @@ namespace QDP
   }
   void XMLWriter::write(const float& output)
   {
+    // Shortest text that reads back to the same value
     if (Layout::primaryNode())
-      XMLSimpleWriter::write(output);
+    {
+      char b[NumFormat::maxChars];
+      XMLSimpleWriter::write(std::string(b, NumFormat::shortest(b, output)));
+    }
   }
   void XMLWriter::write(const double& output)
   {
+    // Shortest text that reads back to the same value
     if (Layout::primaryNode())
-      XMLSimpleWriter::write(output);
+    {
+      char b[NumFormat::maxChars];
+      XMLSimpleWriter::write(std::string(b, NumFormat::shortest(b, output)));
+    }
   }
   void XMLWriter::write(const bool& output)
   {
@@ -866,6 +1027,40 @@ namespace QDP
   XMLWriter& operator<<(XMLWriter& xml, const bool& d) {xml.write(d);return xml;}
 
 
+  //! Text of the numbers of a list, without an ostream per element
+  template<typename T>
+  inline void appendNumber(std::string& out, const T& x) {NumFormat::append(out, x);}
+  inline void appendNumber(std::string& out, const Real32& x) {NumFormat::append(out, toFloat(x));}
+  inline void appendNumber(std::string& out, const Real64& x) {NumFormat::append(out, toDouble(x));}
+
+  //! Write the numbers of [b,e) in one tag, space separated
+  /*!
+   * Floating point numbers take the shortest text that reads back to
+   * the same value. The text is made straight into one string, and only
+   * on the primary node where it goes
+   */
+  template<typename It>
+  void writeNumberList(XMLWriter& xml, const std::string& s, It b, It e)
+  {
+    std::string output;
+
+    if (Layout::primaryNode())
+    {
+      for(It t=b; t != e; ++t)
+      {
+	if (t != b)
+	  output += ' ';
+	appendNumber(output, *t);
+      }
+    }
+    
+    // Write the array - do not use a normal string write
+    xml.openTag(s);
+    xml << output;
+    xml.closeTag();
+  }
+
+
   // Write an array of basic types
   template<typename T>
   void writeArrayPrimitive(XMLWriter& xml, const std::string& s, const multi1d<T>& s1)
@@ -889,68 +1084,42 @@ namespace QDP
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<int>& output)
   {
-    writeArrayPrimitive<int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.slice(), output.slice()+output.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<unsigned int>& output)
   {
-    writeArrayPrimitive<unsigned int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.slice(), output.slice()+output.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<short int>& output)
   {
-    writeArrayPrimitive<short int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.slice(), output.slice()+output.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<unsigned short int>& output)
   {
-    writeArrayPrimitive<unsigned short int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.slice(), output.slice()+output.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<long int>& output)
   {
-    writeArrayPrimitive<long int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.slice(), output.slice()+output.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<unsigned long int>& output)
   {
-    writeArrayPrimitive<unsigned long int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.slice(), output.slice()+output.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const multi1d<float>& s1)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.slice(), s1.slice()+s1.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const multi1d<double>& s1)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.slice(), s1.slice()+s1.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<bool>& output)
@@ -965,38 +1134,12 @@ namespace QDP
   template<>
   void write(XMLWriter& xml, const std::string& s, const multi1d<Real32>& s1)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.slice(), s1.slice()+s1.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const multi1d<Real64>& s1)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.slice(), s1.slice()+s1.size());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const multi1d<Boolean>& output)
@@ -1027,63 +1170,37 @@ namespace QDP
 
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<int>& output)
   {
-    writeVectorPrimitive<int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<unsigned int>& output)
   {
-    writeVectorPrimitive<unsigned int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<short int>& output)
   {
-    writeVectorPrimitive<short int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<unsigned short int>& output)
   {
-    writeVectorPrimitive<unsigned short int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<long int>& output)
   {
-    writeVectorPrimitive<long int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<unsigned long int>& output)
   {
-    writeVectorPrimitive<unsigned long int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::vector<float>& s1)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::vector<double>& s1)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<bool>& output)
   {
@@ -1097,38 +1214,12 @@ namespace QDP
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::vector<Real32>& s1)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::vector<Real64>& s1)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      output << s1[0];
-      for(int index=1; index < s1.size(); index++) 
-	output << " " << s1[index];
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const std::vector<Boolean>& output)
@@ -1163,69 +1254,37 @@ namespace QDP
 
   void write(XMLWriter& xml, const std::string& xpath, const std::list<int>& output)
   {
-    writeListPrimitive<int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::list<unsigned int>& output)
   {
-    writeListPrimitive<unsigned int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::list<short int>& output)
   {
-    writeListPrimitive<short int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::list<unsigned short int>& output)
   {
-    writeListPrimitive<unsigned short int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::list<long int>& output)
   {
-    writeListPrimitive<long int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::list<unsigned long int>& output)
   {
-    writeListPrimitive<unsigned long int>(xml, xpath, output);
+    writeNumberList(xml, xpath, output.begin(), output.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::list<float>& s1)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      std::list<float>::const_iterator t = s1.begin();
-      
-      output << *t;
-      ++t;
-      for(; t != s1.end(); ++t)
-	output << " " << *t;
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::list<double>& s1)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      std::list<double>::const_iterator t = s1.begin();
-      
-      output << *t;
-      ++t;
-      for(; t != s1.end(); ++t)
-	output << " " << *t;
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   void write(XMLWriter& xml, const std::string& xpath, const std::list<bool>& output)
   {
@@ -1239,44 +1298,12 @@ namespace QDP
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::list<Real32>& s1)
   {
-    std::ostringstream output;
-    output.precision(7);
-
-    if (s1.size() > 0)
-    {
-      std::list<Real32>::const_iterator t = s1.begin();
-      
-      output << *t;
-      ++t;
-      for(; t != s1.end(); ++t)
-	output << " " << *t;
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& s, const std::list<Real64>& s1)
   {
-    std::ostringstream output;
-    output.precision(15);
-
-    if (s1.size() > 0)
-    {
-      std::list<Real64>::const_iterator t = s1.begin();
-      
-      output << *t;
-      ++t;
-      for(; t != s1.end(); ++t)
-	output << " " << *t;
-    }
-    
-    // Write the array - do not use a normal string write
-    xml.openTag(s);
-    xml << output.str();
-    xml.closeTag();
+    writeNumberList(xml, s, s1.begin(), s1.end());
   }
   template<>
   void write(XMLWriter& xml, const std::string& xpath, const std::list<Boolean>& output)
@@ -1322,6 +1349,11 @@ namespace QDP
   {
     if (Layout::primaryNode())
     {
+      // A large buffer, so big documents reach the disk in few writes.
+      // It must be set before the file is opened
+      chunk.resize(1 << 20);
+      output_stream.rdbuf()->pubsetbuf(&chunk[0], chunk.size());
+
       output_stream.open(filename.c_str(), std::ofstream::out);
       if (output_stream.fail())
       {
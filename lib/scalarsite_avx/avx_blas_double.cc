@@ -0,0 +1,224 @@
+/*! @file
+ *  @brief AVX2 and AVX-512 double precision BLAS on 4-spinors
+ *
+ * A 4-spinor is 24 doubles: 6 AVX2 or 3 AVX-512 vectors. The loads are
+ * unaligned since OLattice need only be QDP_ALIGNMENT_SIZE aligned.
+ * The multiply-adds are fused, so results can differ from the SSE
+ * kernels in the last bit.
+ */
+
+#include "qdp_config.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
+#include <immintrin.h>
+
+#define QDP_AVX2_FN   __attribute__((target("avx2,fma")))
+#define QDP_AVX512_FN __attribute__((target("avx512f")))
+
+namespace QDP {
+  namespace AVX {
+
+    namespace
+    {
+      //---------------------------------------------------------------
+      // AVX2
+
+      QDP_AVX2_FN
+      void vaxpy4_avx2(REAL64 *out, REAL64 a, REAL64 *in, int n)
+      {
+	__m256d s = _mm256_set1_pd(a);
+	for(int i=0; i < 6*n; ++i, out += 4, in += 4)
+	  _mm256_storeu_pd(out, _mm256_fmadd_pd(s, _mm256_loadu_pd(in), _mm256_loadu_pd(out)));
+      }
+
+      QDP_AVX2_FN
+      void vaxpby4_avx2(REAL64 *y, REAL64 a, REAL64 *x, REAL64 b, int n)
+      {
+	__m256d sa = _mm256_set1_pd(a);
+	__m256d sb = _mm256_set1_pd(b);
+	for(int i=0; i < 6*n; ++i, y += 4, x += 4)
+	  _mm256_storeu_pd(y, _mm256_fmadd_pd(sa, _mm256_loadu_pd(x), 
+					      _mm256_mul_pd(sb, _mm256_loadu_pd(y))));
+      }
+
+      QDP_AVX2_FN
+      void vscal4_avx2(REAL64 *z, REAL64 a, REAL64 *x, int n)
+      {
+	__m256d s = _mm256_set1_pd(a);
+	for(int i=0; i < 6*n; ++i, z += 4, x += 4)
+	  _mm256_storeu_pd(z, _mm256_mul_pd(s, _mm256_loadu_pd(x)));
+      }
+
+      //! Sum the lanes in a fixed order
+      QDP_AVX2_FN
+      REAL64 lanes_avx2(__m256d v, int stride)
+      {
+	REAL64 w[4];
+	_mm256_storeu_pd(w, v);
+	return (stride == 1) ? (w[0] + w[1]) + (w[2] + w[3]) : w[0] + w[2];
+      }
+
+      QDP_AVX2_FN
+      REAL64 sumsq4_avx2(REAL64 *x, int n)
+      {
+	__m256d s1 = _mm256_setzero_pd();
+	__m256d s2 = _mm256_setzero_pd();
+	for(int i=0; i < 3*n; ++i, x += 8)
+	{
+	  __m256d x1 = _mm256_loadu_pd(x);
+	  __m256d x2 = _mm256_loadu_pd(x+4);
+	  s1 = _mm256_fmadd_pd(x1, x1, s1);
+	  s2 = _mm256_fmadd_pd(x2, x2, s2);
+	}
+	return lanes_avx2(_mm256_add_pd(s1, s2), 1);
+      }
+
+      //! re += y*x lane by lane, im += y*swap(x) with swap exchanging re and im
+      QDP_AVX2_FN
+      void vcdot4_avx2(REAL64 *sum, REAL64 *y, REAL64 *x, int n, bool want_im)
+      {
+	__m256d re = _mm256_setzero_pd();
+	__m256d im = _mm256_setzero_pd();
+	for(int i=0; i < 6*n; ++i, y += 4, x += 4)
+	{
+	  __m256d xv = _mm256_loadu_pd(x);
+	  __m256d yv = _mm256_loadu_pd(y);
+	  re = _mm256_fmadd_pd(yv, xv, re);
+	  if (want_im)
+	    im = _mm256_fmadd_pd(yv, _mm256_permute_pd(xv, 0x5), im);
+	}
+
+	sum[0] = lanes_avx2(re, 1);
+	if (want_im)
+	{
+	  // Even lanes hold y.re*x.im, odd lanes y.im*x.re
+	  REAL64 w[4];
+	  _mm256_storeu_pd(w, im);
+	  sum[1] = (w[0] + w[2]) - (w[1] + w[3]);
+	}
+      }
+
+      //---------------------------------------------------------------
+      // AVX-512
+
+      QDP_AVX512_FN
+      void vaxpy4_avx512(REAL64 *out, REAL64 a, REAL64 *in, int n)
+      {
+	__m512d s = _mm512_set1_pd(a);
+	for(int i=0; i < 3*n; ++i, out += 8, in += 8)
+	  _mm512_storeu_pd(out, _mm512_fmadd_pd(s, _mm512_loadu_pd(in), _mm512_loadu_pd(out)));
+      }
+
+      QDP_AVX512_FN
+      void vaxpby4_avx512(REAL64 *y, REAL64 a, REAL64 *x, REAL64 b, int n)
+      {
+	__m512d sa = _mm512_set1_pd(a);
+	__m512d sb = _mm512_set1_pd(b);
+	for(int i=0; i < 3*n; ++i, y += 8, x += 8)
+	  _mm512_storeu_pd(y, _mm512_fmadd_pd(sa, _mm512_loadu_pd(x), 
+					      _mm512_mul_pd(sb, _mm512_loadu_pd(y))));
+      }
+
+      QDP_AVX512_FN
+      void vscal4_avx512(REAL64 *z, REAL64 a, REAL64 *x, int n)
+      {
+	__m512d s = _mm512_set1_pd(a);
+	for(int i=0; i < 3*n; ++i, z += 8, x += 8)
+	  _mm512_storeu_pd(z, _mm512_mul_pd(s, _mm512_loadu_pd(x)));
+      }
+
+      QDP_AVX512_FN
+      REAL64 sumsq4_avx512(REAL64 *x, int n)
+      {
+	__m512d s = _mm512_setzero_pd();
+	for(int i=0; i < 3*n; ++i, x += 8)
+	{
+	  __m512d xv = _mm512_loadu_pd(x);
+	  s = _mm512_fmadd_pd(xv, xv, s);
+	}
+
+	REAL64 w[8];
+	_mm512_storeu_pd(w, s);
+	return ((w[0] + w[1]) + (w[2] + w[3])) + ((w[4] + w[5]) + (w[6] + w[7]));
+      }
+
+      QDP_AVX512_FN
+      void vcdot4_avx512(REAL64 *sum, REAL64 *y, REAL64 *x, int n, bool want_im)
+      {
+	__m512d re = _mm512_setzero_pd();
+	__m512d im = _mm512_setzero_pd();
+	for(int i=0; i < 3*n; ++i, y += 8, x += 8)
+	{
+	  __m512d xv = _mm512_loadu_pd(x);
+	  __m512d yv = _mm512_loadu_pd(y);
+	  re = _mm512_fmadd_pd(yv, xv, re);
+	  if (want_im)
+	    im = _mm512_fmadd_pd(yv, _mm512_permute_pd(xv, 0x55), im);
+	}
+
+	REAL64 w[8];
+	_mm512_storeu_pd(w, re);
+	sum[0] = ((w[0] + w[1]) + (w[2] + w[3])) + ((w[4] + w[5]) + (w[6] + w[7]));
+	if (want_im)
+	{
+	  _mm512_storeu_pd(w, im);
+	  sum[1] = ((w[0] + w[2]) + (w[4] + w[6])) - ((w[1] + w[3]) + (w[5] + w[7]));
+	}
+      }
+    }
+
+
+    void vaxpy4(REAL64 *Out, REAL64 *scalep, REAL64 *InScale, int n_4spin)
+    {
+      if (level() == LEVEL_AVX512)
+	vaxpy4_avx512(Out, *scalep, InScale, n_4spin);
+      else
+	vaxpy4_avx2(Out, *scalep, InScale, n_4spin);
+    }
+
+
+    void vaxpby4(REAL64 *y, REAL64 *a, REAL64 *x, REAL64 *b, int n_4vec)
+    {
+      if (level() == LEVEL_AVX512)
+	vaxpby4_avx512(y, *a, x, *b, n_4vec);
+      else
+	vaxpby4_avx2(y, *a, x, *b, n_4vec);
+    }
+
+
+    void vscal4(REAL64 *z, REAL64 *a, REAL64 *x, int n_4spin)
+    {
+      if (level() == LEVEL_AVX512)
+	vscal4_avx512(z, *a, x, n_4spin);
+      else
+	vscal4_avx2(z, *a, x, n_4spin);
+    }
+
+
+    void local_sumsq4(REAL64 *sum, REAL64 *vecptr, int n_4spin)
+    {
+      if (level() == LEVEL_AVX512)
+	*sum = sumsq4_avx512(vecptr, n_4spin);
+      else
+	*sum = sumsq4_avx2(vecptr, n_4spin);
+    }
+
+
+    void local_vcdot4(REAL64 *sum, REAL64 *y, REAL64 *x, int n_4spin)
+    {
+      if (level() == LEVEL_AVX512)
+	vcdot4_avx512(sum, y, x, n_4spin, true);
+      else
+	vcdot4_avx2(sum, y, x, n_4spin, true);
+    }
+
+
+    void local_vcdot_real4(REAL64 *sum, REAL64 *y, REAL64 *x, int n_4spin)
+    {
+      if (level() == LEVEL_AVX512)
+	vcdot4_avx512(sum, y, x, n_4spin, false);
+      else
+	vcdot4_avx2(sum, y, x, n_4spin, false);
+    }
+
+  } // namespace AVX
+} // namespace QDP
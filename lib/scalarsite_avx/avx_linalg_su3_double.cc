@@ -0,0 +1,123 @@
+/*! @file
+ *  @brief AVX2 double precision 3x3 complex matrix products
+ *
+ * A row of a colour matrix is three complex numbers: one 256 bit vector
+ * for the first two and a 128 bit one for the last. Each row of the
+ * product is built as a sum of rows of the right matrix scaled by the
+ * complex entries of the left one with fmaddsub. There is no
+ * AVX-512 variant, since a 3 wide complex row does not fill its
+ * registers any better.
+ *
+ * Each product is formed in registers and a local buffer before it is
+ * stored, so m3 may be the same as m1 or m2.
+ */
+
+#include "qdp_config.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
+#include <immintrin.h>
+
+#define QDP_AVX2_FN   __attribute__((target("avx2,fma")))
+
+namespace QDP {
+  namespace AVX {
+
+    namespace
+    {
+      //! Words in a matrix, and offset of (i,j)
+      const int mat_words = 18;
+      inline int at(int i, int j) {return 6*i + 2*j;}
+
+      //! c = op(a)*b with op the adjoint when adj_a is set
+      QDP_AVX2_FN
+      void su3Mul(REAL64 *c, const REAL64 *a, const REAL64 *b, bool adj_a)
+      {
+	__m256d b01[3];
+	__m128d b2[3];
+	for(int k=0; k < 3; ++k)
+	{
+	  b01[k] = _mm256_loadu_pd(b + at(k,0));
+	  b2[k]  = _mm_loadu_pd(b + at(k,2));
+	}
+
+	REAL64 t[mat_words];
+
+	for(int i=0; i < 3; ++i)
+	{
+	  __m256d c01 = _mm256_setzero_pd();
+	  __m128d c2  = _mm_setzero_pd();
+
+	  for(int k=0; k < 3; ++k)
+	  {
+	    REAL64 ar = adj_a ? a[at(k,i)]   : a[at(i,k)];
+	    REAL64 ai = adj_a ? -a[at(k,i)+1] : a[at(i,k)+1];
+
+	    // (ar + i ai)*(br + i bi) = (ar br - ai bi) + i (ar bi + ai br)
+	    __m256d vr = _mm256_set1_pd(ar);
+	    __m256d vi = _mm256_set1_pd(ai);
+	    __m256d s01 = _mm256_mul_pd(vi, _mm256_permute_pd(b01[k], 0x5));
+	    c01 = _mm256_add_pd(c01, _mm256_fmaddsub_pd(vr, b01[k], s01));
+
+	    __m128d wr = _mm_set1_pd(ar);
+	    __m128d wi = _mm_set1_pd(ai);
+	    __m128d s2 = _mm_mul_pd(wi, _mm_permute_pd(b2[k], 0x1));
+	    c2 = _mm_add_pd(c2, _mm_fmaddsub_pd(wr, b2[k], s2));
+	  }
+
+	  _mm256_storeu_pd(t + at(i,0), c01);
+	  _mm_storeu_pd(t + at(i,2), c2);
+	}
+
+	for(int w=0; w < mat_words; ++w)
+	  c[w] = t[w];
+      }
+
+      //! h = adj(m)
+      inline void su3Adj(REAL64 *h, const REAL64 *m)
+      {
+	for(int i=0; i < 3; ++i)
+	  for(int j=0; j < 3; ++j)
+	  {
+	    h[at(i,j)]   =  m[at(j,i)];
+	    h[at(i,j)+1] = -m[at(j,i)+1];
+	  }
+      }
+    }
+
+
+    void m_eq_mm(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat)
+    {
+      for(int i=0; i < n_mat; ++i, m1 += mat_words, m2 += mat_words, m3 += mat_words)
+	su3Mul(m3, m1, m2, false);
+    }
+
+
+    void m_eq_hm(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat)
+    {
+      for(int i=0; i < n_mat; ++i, m1 += mat_words, m2 += mat_words, m3 += mat_words)
+	su3Mul(m3, m1, m2, true);
+    }
+
+
+    void m_eq_mh(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat)
+    {
+      REAL64 h[mat_words];
+      for(int i=0; i < n_mat; ++i, m1 += mat_words, m2 += mat_words, m3 += mat_words)
+      {
+	su3Adj(h, m2);
+	su3Mul(m3, m1, h, false);
+      }
+    }
+
+
+    void m_eq_hh(REAL64* m3, REAL64* m1, REAL64* m2, int n_mat)
+    {
+      REAL64 h[mat_words];
+      for(int i=0; i < n_mat; ++i, m1 += mat_words, m2 += mat_words, m3 += mat_words)
+      {
+	su3Adj(h, m2);
+	su3Mul(m3, m1, h, true);
+      }
+    }
+
+  } // namespace AVX
+} // namespace QDP
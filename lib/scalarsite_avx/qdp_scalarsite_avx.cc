@@ -0,0 +1,47 @@
+/*! @file
+ * @brief Choice of the AVX level for the scalarsite kernels
+ */
+
+#include "qdp_config.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
+
+namespace QDP {
+  namespace AVX {
+
+    namespace
+    {
+      //! -1 until the CPU has been asked
+      int cur_level = -1;
+
+      //! Most the CPU supports
+      Level cpuLevel()
+      {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+	  return LEVEL_AVX512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+	  return LEVEL_AVX2;
+#endif
+	return LEVEL_SSE;
+      }
+    }
+
+
+    Level level()
+    {
+      if (cur_level < 0)
+	cur_level = cpuLevel();
+
+      return Level(cur_level);
+    }
+
+
+    void setLevel(Level l)
+    {
+      Level top = cpuLevel();
+      cur_level = (l < top) ? l : top;
+    }
+
+  } // namespace AVX
+} // namespace QDP
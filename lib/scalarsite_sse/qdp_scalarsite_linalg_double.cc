@@ -84,6 +84,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_M_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_M_times_M");
 
   typedef OLattice< DCol >    C;
 
@@ -129,6 +130,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_aM_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_aM_times_M");
 
   typedef OLattice< DCol >    C;
 
@@ -175,6 +177,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_M_times_aM" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_M_times_aM");
 
   typedef OLattice< DCol >    C;
 
@@ -221,6 +224,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_Ma_times_Ma" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_Ma_times_Ma");
 
   typedef OLattice< DCol >    C;
 
@@ -324,6 +328,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_M_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_M_times_M");
 
   typedef OLattice< DCol >    C;
 
@@ -368,6 +373,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_aM_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_aM_times_M");
 
   typedef OLattice< DCol >    C;
 
@@ -414,6 +420,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_M_times_aM" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_M_times_aM");
 
   typedef OLattice< DCol >    C;
 
@@ -459,6 +466,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_Ma_times_Ma" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_Ma_times_Ma");
 
   typedef OLattice< DCol >    C;
 
@@ -740,6 +748,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_M_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_M_times_M");
 
   typedef OLattice< DCol >    C;
 
@@ -790,6 +799,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_aM_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_aM_times_M");
 
   typedef OLattice< DCol >    C;
 
@@ -837,6 +847,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_M_times_aM" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_M_times_aM");
 
   typedef OLattice< DCol >    C;
 
@@ -884,6 +895,7 @@ void evaluate(OLattice< DCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_Ma_times_Ma" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_Ma_times_Ma");
 
   typedef OLattice< DCol >    C;
 
@@ -30,6 +30,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_M_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_M_times_M");
 
   typedef OLattice< TCol >    C;
 
@@ -74,6 +75,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_aM_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_aM_times_M");
 
   typedef OLattice< TCol >    C;
 
@@ -119,6 +121,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_M_times_aM" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_M_times_aM");
 
   typedef OLattice< TCol >    C;
 
@@ -163,6 +166,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_eq_Ma_times_Ma" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_eq_Ma_times_Ma");
 
   typedef OLattice< TCol >    C;
 
@@ -251,6 +255,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_M_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_M_times_M");
 
   typedef OLattice< TCol >    C;
 
@@ -336,6 +341,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_aM_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_aM_times_M");
 
   typedef OLattice< TCol >    C;
 
@@ -421,6 +427,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_M_times_aM" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_M_times_aM");
 
   typedef OLattice< TCol >    C;
 
@@ -508,6 +515,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_peq_Ma_times_Ma" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_peq_Ma_times_Ma");
 
   typedef OLattice< TCol >    C;
 
@@ -771,6 +779,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_M_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_M_times_M");
 
   typedef OLattice< TCol >    C;
 
@@ -858,6 +867,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_aM_times_M" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_aM_times_M");
 
   typedef OLattice< TCol >    C;
 
@@ -944,6 +954,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_M_times_aM" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_M_times_aM");
 
   typedef OLattice< TCol >    C;
 
@@ -1029,6 +1040,7 @@ void evaluate(OLattice< TCol >& d,
 	      const Subset& s)
 {
 //  cout << "call single site QDP_M_meq_Ma_times_Ma" << endl;
+  QDP_KERNEL_SELECTED("QDP_M_meq_Ma_times_Ma");
 
   typedef OLattice< TCol >    C;
 
@@ -5,6 +5,7 @@
  */
 
 #include "scalarsite_sse/sse_blas_local_sumsq_double.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
 #include <xmmintrin.h>
 namespace QDP {
 
@@ -13,6 +14,11 @@ namespace QDP {
 // #define DEBUG_VAXPY_DOUBLE
   void local_sumsq4(REAL64 *sum, REAL64 *vecptr, int n_4spin)
   {
+    if (AVX::enabled()) {
+      AVX::local_sumsq4(sum, vecptr, n_4spin);
+      return;
+    }
+
 
     // Initialize the 4 sums to zero. Use _mm_setzero_pd() rather than explicit xor
     // Apparently we dont need volatile then.
@@ -9,6 +9,7 @@
 #include <xmmintrin.h>
 #include "qdp_config.h"
 #include "scalarsite_sse/sse_blas_local_vcdot_double.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
 
 namespace QDP {
 
@@ -94,6 +95,11 @@ QDPXX_MESSAGE("Using SSE3")
   // then srore either half.
   void local_vcdot4(REAL64 *sum, REAL64 *y, REAL64* x,int n_4spin)
 {
+  if (AVX::enabled()) {
+    AVX::local_vcdot4(sum, y, x, n_4spin);
+    return;
+  }
+
   // Use _mm_setzero_pd() to initialize the sums rather than xors
   __m128d sum1 = _mm_setzero_pd();
   __m128d sum2 = _mm_setzero_pd();
@@ -7,6 +7,7 @@
 #include <qdp.h>
 #include <xmmintrin.h>
 #include "scalarsite_sse/sse_blas_local_vcdot_real_double.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
 #include <iostream>
 
 namespace QDP {
@@ -33,6 +34,11 @@ namespace QDP {
   // 
   void local_vcdot_real4(REAL64 *sum, REAL64 *y, REAL64* x,int n_4spin)
 {
+  if (AVX::enabled()) {
+    AVX::local_vcdot_real4(sum, y, x, n_4spin);
+    return;
+  }
+
   __m128d sum1 = _mm_setzero_pd();
   __m128d sum2 = _mm_setzero_pd();
   __m128d sum3 = _mm_setzero_pd();
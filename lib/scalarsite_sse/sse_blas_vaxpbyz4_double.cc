@@ -5,6 +5,7 @@
  */
 
 #include "scalarsite_sse/sse_blas_vaxpbyz4_double.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
 #include <xmmintrin.h>
 #include "scalarsite_sse/sse_prefetch.h"
 
@@ -141,6 +142,11 @@ void vaxpbyz4(REAL64 *z, REAL64 *a, REAL64 *x, REAL64 *b, REAL64 *y, int n_4vec)
 
 void vaxpby4(REAL64 *y, REAL64 *a, REAL64 *x, REAL64 *b, int n_4vec)
 {
+  if (AVX::enabled()) {
+    AVX::vaxpby4(y, a, x, b, n_4vec);
+    return;
+  }
+
   __m128d a_sse;
   __m128d b_sse;
  
@@ -5,6 +5,7 @@
  */
 
 #include "scalarsite_sse/sse_blas_vaxpy4_double.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
 #include <xmmintrin.h>
 #include "scalarsite_sse/sse_prefetch.h"
 
@@ -19,6 +20,11 @@ namespace QDP {
 
 void vaxpy4(REAL64 *Out,REAL64 *scalep,REAL64 *InScale, int n_4spin)
 {
+  if (AVX::enabled()) {
+    AVX::vaxpy4(Out, scalep, InScale, n_4spin);
+    return;
+  }
+
   __m128d scalar;
   __m128d tmp1;
   __m128d tmp2;
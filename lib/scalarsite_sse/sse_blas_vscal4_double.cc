@@ -5,6 +5,7 @@
  */
 
 #include "scalarsite_sse/sse_blas_vscal4_double.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
 #include <xmmintrin.h>
 
 namespace QDP {
@@ -13,6 +14,11 @@ namespace QDP {
 
 void vscal4(REAL64 *z,REAL64 *a,REAL64 *x, int n_4spin)
 {
+  if (AVX::enabled()) {
+    AVX::vscal4(z, a, x, n_4spin);
+    return;
+  }
+
   __m128d scalar;
   __m128d tmp1;
 
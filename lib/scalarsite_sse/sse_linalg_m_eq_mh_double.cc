@@ -7,6 +7,7 @@
 #include "qdp_diagnostics.h"
 
 #include "scalarsite_sse/sse_linalg_mm_su3_double.h"
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
 #include <xmmintrin.h>
 #include "qdp_config.h"
 
@@ -413,6 +414,11 @@ QDPXX_MESSAGE("Using SSE3")
   /* M3 = M1*adj(M2) */
   void ssed_m_eq_mh(REAL64* m3, REAL64* m2, REAL64* m1, int n_mat)
   {
+    if (AVX::enabled()) {
+      AVX::m_eq_mh(m3, m2, m1, n_mat);
+      return;
+    }
+
     __m128d m1_1;
     __m128d m1_2;
     __m128d m1_3;
@@ -0,0 +1,178 @@
+/*! \file
+ * \brief Cost of the halo exchange and the global sums on this node grid
+ *
+ * Times shift in each direction and sign for fermion, half fermion and
+ * colour matrix fields, once blocking and once split-phase with the
+ * interior work done while the faces are in flight, and the global sum
+ * of double arrays from one word up, through globalSumArray and through
+ * the node-ordered sumTDirection path. Each point is one CSV line with
+ * the bytes a rank sends per call and the smallest, mean and largest
+ * time of a rank, so the small sums give the latency and the large
+ * faces the bandwidth of the network.
+ *
+ *   bench_comms [-lat X Y Z T] [-secs s] [-maxsum n] [-csv file]
+ *
+ * The node grid is QMP's, e.g. -geom 2 2 1 1.
+ */
+
+#include "qdp.h"
+#include "benchutil.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace QDP;
+using namespace Bench;
+
+namespace
+{
+  //! Node grid as 2x2x1x1
+  std::string gridName()
+  {
+    std::ostringstream os;
+    for(int mu=0; mu < Nd; ++mu)
+      os << (mu ? "x" : "") << Layout::logicalSize()[mu];
+    return os.str();
+  }
+
+  //! Write one line from the times of this rank
+  void report(std::ostream& csv, const char* kind, const char* name, int mu, int sign,
+	      const char* mode, double bytes, double secs)
+  {
+    double smin, smean, smax;
+    nodeSpread(secs, smin, smean, smax);
+
+    if (! Layout::primaryNode())
+      return;
+
+    char dir[32] = "";
+    if (sign != 0)
+      snprintf(dir, sizeof(dir), "%d,%+d", mu, sign);
+    else
+      snprintf(dir, sizeof(dir), ",");
+
+    char line[512];
+    snprintf(line, sizeof(line), "%s,%d,%s,%s,%s,%s,%.0f,%.6g,%.6g,%.6g,%.4f\n",
+	     gridName().c_str(), Layout::numNodes(), kind, name, dir, mode, bytes,
+	     smin, smean, smax, (smean > 0) ? bytes / smean / 1.0e9 : 0.0);
+    csv << line << std::flush;
+  }
+
+  //! Bytes this rank sent on a channel since sent0
+  double sentSince(int ch, size_t sent0, size_t calls0)
+  {
+    const CommStats::Counters& c = CommStats::channelCounters(ch);
+    return (c.calls > calls0) ? double(c.bytes_sent - sent0) / (c.calls - calls0) : 0.0;
+  }
+
+  //! Time shift of one field type in every direction and sign
+  template<class T>
+  void benchShift(std::ostream& csv, const char* name)
+  {
+    OLattice<T> x, y, tmp;
+    gaussian(x);
+    gaussian(y);
+    const Real a = 0.5;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      for(int s=0; s < 2; ++s)
+      {
+	const int sign = s ? -1 : +1;
+	std::ostringstream label;
+	label << "shift(" << (sign > 0 ? "+1" : "-1") << "," << mu << ")";
+	const int ch = CommStats::channel(label.str());
+
+	size_t sent0 = CommStats::channelCounters(ch).bytes_sent;
+	size_t calls0 = CommStats::channelCounters(ch).calls;
+	double secs = timeCall([&]() {y = a*shift(x, sign, mu) + y;});
+	report(csv, "shift", name, mu, sign, "blocking", sentSince(ch, sent0, calls0), secs);
+
+	sent0 = CommStats::channelCounters(ch).bytes_sent;
+	calls0 = CommStats::channelCounters(ch).calls;
+	secs = timeCall([&]() {
+	    MapHandle<T> h = shift.start(x, sign, mu);
+	    h.copyInterior(tmp);
+	    y[h.interior()] = a*tmp + y;
+	    h.finishBoundary(tmp);
+	    y[h.boundary()] = a*tmp + y;
+	  });
+	report(csv, "shift", name, mu, sign, "overlap", sentSince(ch, sent0, calls0), secs);
+      }
+    }
+  }
+
+  //! Time the global sums of arrays of 1 to max_len doubles
+  void benchSums(std::ostream& csv, int max_len)
+  {
+    std::vector<double> v(max_len, 1.0);
+
+    for(int len=1; len <= max_len; len *= 4)
+    {
+      double secs = timeCall([&]() {QDPInternal::globalSumArray(&v[0], len);});
+      report(csv, "sum", "globalSumArray", 0, 0, "", len*sizeof(double), secs);
+
+#if defined(ARCH_PARSCALAR)
+      secs = timeCall([&]() {
+	  QMP_status_t err = QDPGlobalSums::QDP_sum_double_array_ordered(&v[0], len);
+	  if (err != QMP_SUCCESS)
+	    QDP_error_exit(QMP_error_string(err));
+	});
+      report(csv, "sum", "sumTDirection", 0, 0, "", len*sizeof(double), secs);
+#endif
+    }
+  }
+}
+
+
+int main(int argc, char **argv)
+{
+  QDP_initialize(&argc, &argv);
+
+  multi1d<int> nrow(Nd);
+  nrow = 16;
+  int max_sum = 1 << 20;
+  std::string csv_file;
+
+  for(int i=1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-lat") == 0 && i+Nd < argc)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+	nrow[mu] = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-secs") == 0 && i+1 < argc)
+      secsPerPoint() = atof(argv[++i]);
+    else if (strcmp(argv[i], "-maxsum") == 0 && i+1 < argc)
+      max_sum = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-csv") == 0 && i+1 < argc)
+      csv_file = argv[++i];
+  }
+
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  std::ofstream csv_out;
+  if (Layout::primaryNode() && ! csv_file.empty())
+  {
+    csv_out.open(csv_file.c_str());
+    if (! csv_out)
+    {
+      QDPIO::cerr << "bench_comms: cannot write " << csv_file << std::endl;
+      QDP_abort(1);
+    }
+  }
+  std::ostream& csv = csv_file.empty() ? std::cout : csv_out;
+
+  if (Layout::primaryNode())
+    csv << "grid,nodes,kind,name,mu,sign,mode,bytes_per_rank,sec_min,sec_mean,sec_max,gbytes_per_sec_per_rank" << std::endl;
+
+  benchShift<LatticeFermion::Subtype_t>(csv, "fermion");
+  benchShift<LatticeHalfFermion::Subtype_t>(csv, "half_fermion");
+  benchShift<LatticeColorMatrix::Subtype_t>(csv, "color_matrix");
+
+  benchSums(csv, max_sum);
+
+  QDP_finalize();
+  exit(0);
+}
@@ -0,0 +1,442 @@
+/*! \file
+ * \brief Write and read throughput of the I/O backends
+ *
+ * Writes a gauge field and a propagator through each backend this build
+ * has, reads them back and checks they came back unchanged:
+ *
+ *   qio-single, qio-multi, qio-part   QDPFileWriter/QDPFileReader volfmts
+ *   binary                            BinaryFileWriter/BinaryFileReader
+ *   hdf5                              HDF5Writer/HDF5Reader
+ *   archiv                            writeArchiv/readArchiv, gauge only
+ *   mapobj                            MapObjectDisk, one entry per field
+ *
+ * Each pass becomes a CSV line with the aggregate and per node GB/s, the
+ * time to first byte - opening the file and its metadata, before any
+ * lattice data moves - and the share of the pass a crc32 of the same
+ * bytes would take, which is what the checksummed formats pay.
+ *
+ *   bench_io [-lat X Y Z T] [-reps n] [-dir path] [-parallel] [-keep] [-csv file]
+ */
+
+#include "qdp.h"
+#include "benchutil.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#if defined(QDP_USE_LIBXML2)
+#include "qdp_iogauge.h"
+#include "qdp_map_obj_disk.h"
+#endif
+
+using namespace QDP;
+using namespace Bench;
+
+namespace
+{
+  //! The fields moved by every backend
+  struct Fields
+  {
+    multi1d<LatticeColorMatrix> u;
+    LatticePropagator prop;
+
+    Fields() : u(Nd) {}
+
+    double gaugeBytes() const {return double(Nd)*Layout::vol()*sizeof(LatticeColorMatrix::Subtype_t);}
+    double propBytes() const {return double(Layout::vol())*sizeof(LatticePropagator::Subtype_t);}
+  };
+
+  //! One timed pass of a backend
+  struct Pass
+  {
+    double first;               // open and metadata, before the lattice data
+    double total;
+  };
+
+  //! Seconds since t0, once all the nodes have got here
+  double syncedSecs(QDPTime_t t0)
+  {
+    double d = 0;
+    QDPInternal::globalSum(d);
+    return 1.0e-9*(getClockTime() - t0);
+  }
+
+  //! Difference between two sets of fields relative to the first
+  double difference(const Fields& a, const Fields& b, bool gauge_only)
+  {
+    double d = 0, n = 0;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      d += toDouble(norm2(a.u[mu] - b.u[mu]));
+      n += toDouble(norm2(a.u[mu]));
+    }
+    if (! gauge_only)
+    {
+      d += toDouble(norm2(a.prop - b.prop));
+      n += toDouble(norm2(a.prop));
+    }
+    return sqrt(d / n);
+  }
+
+  //! Random diagonal SU(N) matrices, which the gauge formats that drop a row restore exactly
+  LatticeColorMatrix randomSUN()
+  {
+    LatticeColorMatrix m = zero;
+    LatticeReal total = zero;
+    for(int c=0; c < Nc-1; ++c)
+    {
+      LatticeReal phase;
+      random(phase);
+      phase *= 6.283185307179586;
+      total += phase;
+      pokeColor(m, cmplx(cos(phase), sin(phase)), c, c);
+    }
+    pokeColor(m, cmplx(cos(total), -sin(total)), Nc-1, Nc-1);
+    return m;
+  }
+
+  //! Remove the files of a pass, on the primary node
+  void removeFiles(const std::string& file)
+  {
+    if (! Layout::primaryNode())
+      return;
+
+    std::remove(file.c_str());
+    for(int n=0; n < Layout::numNodes(); ++n)
+    {
+      char vol[32];
+      snprintf(vol, sizeof(vol), ".vol%04d", n);
+      std::remove((file + vol).c_str());
+    }
+  }
+
+  //! Seconds to crc32 bytes of lattice data on one node
+  double checksumSecs(const Fields& f, bool gauge_only)
+  {
+    const QDPTime_t t0 = getClockTime();
+    QDPUtil::n_uint32_t crc = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      crc = QDPUtil::crc32(crc, (const char*)f.u[mu].getF(), Layout::sitesOnNode()*sizeof(LatticeColorMatrix::Subtype_t));
+    if (! gauge_only)
+      crc = QDPUtil::crc32(crc, (const char*)f.prop.getF(), Layout::sitesOnNode()*sizeof(LatticePropagator::Subtype_t));
+    double secs = 1.0e-9*(getClockTime() - t0), smin, smean, smax;
+    nodeSpread(secs, smin, smean, smax);
+    return smax;
+  }
+
+
+  //! A way of writing and reading the fields
+  class Backend
+  {
+  public:
+    virtual ~Backend() {}
+    virtual const char* name() const = 0;
+    virtual bool gaugeOnly() const {return false;}
+    virtual void write(const std::string& file, const Fields& f, Pass& p) = 0;
+    virtual void read(const std::string& file, Fields& f, Pass& p) = 0;
+  };
+
+
+  class BinaryBackend : public Backend
+  {
+  public:
+    const char* name() const {return "binary";}
+
+    void write(const std::string& file, const Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	BinaryFileWriter bin(file);
+	p.first = syncedSecs(t0);
+	QDP::write(bin, f.u);
+	QDP::write(bin, f.prop);
+	bin.close();
+	p.total = syncedSecs(t0);
+      }
+
+    void read(const std::string& file, Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	BinaryFileReader bin(file);
+	p.first = syncedSecs(t0);
+	QDP::read(bin, f.u);
+	QDP::read(bin, f.prop);
+	bin.close();
+	p.total = syncedSecs(t0);
+      }
+  };
+
+
+#if defined(QDP_USE_LIBXML2)
+  class QIOBackend : public Backend
+  {
+  public:
+    QIOBackend(QDP_volfmt_t v, QDP_serialparallel_t s, const char* n) : volfmt(v), serpar(s), label(n) {}
+
+    const char* name() const {return label;}
+
+    void write(const std::string& file, const Fields& f, Pass& p)
+      {
+	XMLBufferWriter file_xml, rec_xml;
+	push(file_xml, "bench_io");
+	pop(file_xml);
+	push(rec_xml, "field");
+	pop(rec_xml);
+
+	const QDPTime_t t0 = getClockTime();
+	QDPFileWriter out(file_xml, file, volfmt, serpar);
+	p.first = syncedSecs(t0);
+	out.write(rec_xml, f.u);
+	out.write(rec_xml, f.prop);
+	out.close();
+	p.total = syncedSecs(t0);
+      }
+
+    void read(const std::string& file, Fields& f, Pass& p)
+      {
+	XMLReader file_xml, rec_xml;
+
+	const QDPTime_t t0 = getClockTime();
+	QDPFileReader in(file_xml, file, serpar);
+	p.first = syncedSecs(t0);
+	in.read(rec_xml, f.u);
+	in.read(rec_xml, f.prop);
+	in.close();
+	p.total = syncedSecs(t0);
+      }
+
+  private:
+    QDP_volfmt_t volfmt;
+    QDP_serialparallel_t serpar;
+    const char* label;
+  };
+
+
+  class ArchivBackend : public Backend
+  {
+  public:
+    const char* name() const {return "archiv";}
+    bool gaugeOnly() const {return true;}
+
+    // The header and the data go in one call, so there is no first byte to time apart
+    void write(const std::string& file, const Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	writeArchiv(f.u, file);
+	p.total = syncedSecs(t0);
+	p.first = 0;
+      }
+
+    void read(const std::string& file, Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	readArchiv(f.u, file);
+	p.total = syncedSecs(t0);
+	p.first = 0;
+      }
+  };
+
+
+  class MapObjBackend : public Backend
+  {
+  public:
+    const char* name() const {return "mapobj";}
+
+    void write(const std::string& file, const Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	MapObjectDisk<int, LatticeColorMatrix> links;
+	links.insertUserdata("bench_io");
+	links.open(file, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
+	p.first = syncedSecs(t0);
+	for(int mu=0; mu < Nd; ++mu)
+	  links.insert(mu, f.u[mu]);
+	links.flush();
+
+	MapObjectDisk<int, LatticePropagator> props;
+	props.insertUserdata("bench_io");
+	props.open(file + ".prop", std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
+	props.insert(0, f.prop);
+	props.flush();
+	p.total = syncedSecs(t0);
+      }
+
+    void read(const std::string& file, Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	MapObjectDisk<int, LatticeColorMatrix> links;
+	links.open(file, std::ios_base::in);
+	p.first = syncedSecs(t0);
+	for(int mu=0; mu < Nd; ++mu)
+	  links.get(mu, f.u[mu]);
+
+	MapObjectDisk<int, LatticePropagator> props;
+	props.open(file + ".prop", std::ios_base::in);
+	props.get(0, f.prop);
+	p.total = syncedSecs(t0);
+      }
+  };
+#endif
+
+
+#if defined(QDP_USE_HDF5)
+  class HDF5Backend : public Backend
+  {
+  public:
+    const char* name() const {return "hdf5";}
+
+    void write(const std::string& file, const Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	HDF5Writer h5;
+	h5.open(file, HDF5Base::trunc);
+	p.first = syncedSecs(t0);
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  std::ostringstream name;
+	  name << "u" << mu;
+	  h5.write(name.str(), f.u[mu], HDF5Base::trunc);
+	}
+	h5.write("prop", f.prop, HDF5Base::trunc);
+	h5.close();
+	p.total = syncedSecs(t0);
+      }
+
+    void read(const std::string& file, Fields& f, Pass& p)
+      {
+	const QDPTime_t t0 = getClockTime();
+	HDF5Reader h5;
+	h5.open(file);
+	p.first = syncedSecs(t0);
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  std::ostringstream name;
+	  name << "u" << mu;
+	  h5.read(name.str(), f.u[mu]);
+	}
+	h5.read("prop", f.prop);
+	h5.close();
+	p.total = syncedSecs(t0);
+      }
+  };
+#endif
+
+
+  //! Write one line for a pass that moved bytes
+  void report(std::ostream& csv, const char* backend, const char* dir, double bytes,
+	      const Pass& p, double crc, double diff)
+  {
+    if (! Layout::primaryNode())
+      return;
+
+    const int nodes = Layout::numNodes();
+    char line[512];
+    snprintf(line, sizeof(line), "%s,%d,%s,%.0f,%.6g,%.6g,%.4f,%.4f,%.4f,%s\n",
+	     backend, nodes, dir, bytes, p.first, p.total,
+	     bytes / p.total / 1.0e9, bytes / p.total / nodes / 1.0e9,
+	     crc / p.total, (diff < 1.0e-6) ? "ok" : "MISMATCH");
+    csv << line << std::flush;
+  }
+}
+
+
+int main(int argc, char **argv)
+{
+  QDP_initialize(&argc, &argv);
+
+  multi1d<int> nrow(Nd);
+  nrow = 16;
+  int reps = 1;
+  std::string dir = ".";
+  std::string csv_file;
+  bool parallel = false;
+  bool keep = false;
+
+  for(int i=1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-lat") == 0 && i+Nd < argc)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+	nrow[mu] = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-reps") == 0 && i+1 < argc)
+      reps = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "-dir") == 0 && i+1 < argc)
+      dir = argv[++i];
+    else if (strcmp(argv[i], "-parallel") == 0)
+      parallel = true;
+    else if (strcmp(argv[i], "-keep") == 0)
+      keep = true;
+    else if (strcmp(argv[i], "-csv") == 0 && i+1 < argc)
+      csv_file = argv[++i];
+  }
+
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  std::ofstream csv_out;
+  if (Layout::primaryNode() && ! csv_file.empty())
+  {
+    csv_out.open(csv_file.c_str());
+    if (! csv_out)
+    {
+      QDPIO::cerr << "bench_io: cannot write " << csv_file << std::endl;
+      QDP_abort(1);
+    }
+  }
+  std::ostream& csv = csv_file.empty() ? std::cout : csv_out;
+
+  if (Layout::primaryNode())
+    csv << "backend,nodes,direction,bytes,sec_first_byte,sec_total,gbytes_per_sec,"
+	<< "gbytes_per_sec_per_node,checksum_fraction,check" << std::endl;
+
+  Fields out, in;
+  for(int mu=0; mu < Nd; ++mu)
+    out.u[mu] = randomSUN();
+  gaussian(out.prop);
+
+  std::vector<Backend*> backends;
+  backends.push_back(new BinaryBackend);
+#if defined(QDP_USE_LIBXML2)
+  const QDP_serialparallel_t serpar = parallel ? QDPIO_PARALLEL : QDPIO_SERIAL;
+  backends.push_back(new QIOBackend(QDPIO_SINGLEFILE, serpar, "qio-single"));
+  backends.push_back(new QIOBackend(QDPIO_MULTIFILE, serpar, "qio-multi"));
+  backends.push_back(new QIOBackend(QDPIO_PARTFILE, serpar, "qio-part"));
+  backends.push_back(new ArchivBackend);
+  backends.push_back(new MapObjBackend);
+#endif
+#if defined(QDP_USE_HDF5)
+  backends.push_back(new HDF5Backend);
+#endif
+
+  for(int b=0; b < backends.size(); ++b)
+  {
+    Backend& be = *backends[b];
+    const std::string file = dir + "/bench_io_" + be.name();
+    const double bytes = out.gaugeBytes() + (be.gaugeOnly() ? 0 : out.propBytes());
+    const double crc = checksumSecs(out, be.gaugeOnly());
+
+    for(int r=0; r < reps; ++r)
+    {
+      Pass p;
+      be.write(file, out, p);
+      report(csv, be.name(), "write", bytes, p, crc, 0);
+
+      for(int mu=0; mu < Nd; ++mu)
+	in.u[mu] = zero;
+      in.prop = zero;
+
+      be.read(file, in, p);
+      report(csv, be.name(), "read", bytes, p, crc, difference(out, in, be.gaugeOnly()));
+    }
+
+    if (! keep)
+    {
+      removeFiles(file);
+      removeFiles(file + ".prop");
+    }
+    delete backends[b];
+  }
+
+  QDP_finalize();
+  exit(0);
+}
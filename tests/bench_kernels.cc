@@ -0,0 +1,321 @@
+/*! \file
+ * \brief Sweep the specialised kernels over volume, precision, threads and backend
+ *
+ * Every BLAS, SU(3), spin projection/reconstruction and reduction kernel
+ * is timed on the first block of n sites of the node, for n from in-cache
+ * to the whole local lattice, in single and double precision, for each
+ * thread count and each kernel backend this build can choose at run time.
+ * Each point becomes one CSV line with its GB/s and GFLOP/s and the
+ * fraction it reaches of a STREAM triad measured with the same threads.
+ *
+ *   bench_kernels [-lat X Y Z T] [-secs s] [-threads 1,2,4] [-csv file]
+ *
+ * The bytes are the fields read and written once per site, so a kernel
+ * running from memory should come close to the STREAM bound while one
+ * in cache may pass it.
+ */
+
+#include "qdp.h"
+#include "benchutil.h"
+#include <cstdio>
+#include <fstream>
+
+#if QDP_USE_SSE == 1
+#include "scalarsite_avx/qdp_scalarsite_avx.h"
+#endif
+
+using namespace QDP;
+using namespace Bench;
+
+namespace
+{
+  //! Colour the sites of the node in blocks of consecutive linear index
+  class BlockFunc : public SetFunc
+  {
+  public:
+    BlockFunc(int b) : block(b) {}
+    int operator()(const multi1d<int>& coord) const {return Layout::linearSiteIndex(coord) / block;}
+    int numSubsets() const {return (Layout::sitesOnNode() + block - 1) / block;}
+
+  private:
+    int block;
+  };
+
+  //! One kernel with its work per site
+  struct Kernel
+  {
+    const char* group;
+    const char* name;
+    double flops;                 // per site
+    double words;                 // reals read and written per site
+    std::function<void(const Subset&)> run;
+  };
+
+  //! Arrays of the STREAM triad
+  struct TriadArgs
+  {
+    double* a;
+    const double* b;
+    const double* c;
+    double s;
+  };
+
+  void triadKernel(int lo, int hi, int myId, TriadArgs* t)
+  {
+    for(int i=lo; i < hi; ++i)
+      t->a[i] = t->b[i] + t->s*t->c[i];
+  }
+
+  //! GB/s of the STREAM triad with the current threads, over arrays well out of cache
+  double streamTriad()
+  {
+    const int n = 1 << 22;
+    std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+
+    TriadArgs t = {&a[0], &b[0], &c[0], 3.0};
+    dispatch_to_threads(n, t, triadKernel);      // place the pages with the threads
+
+    double secs = timeCall([&]() {dispatch_to_threads(n, t, triadKernel);});
+    return 3.0*sizeof(double)*n / secs / 1.0e9;
+  }
+
+
+  //! Single precision fields
+  struct SingleP
+  {
+    typedef LatticeFermionF      Fermion;
+    typedef LatticeHalfFermionF  HalfFermion;
+    typedef LatticeColorMatrixF  ColorMatrix;
+    typedef LatticeRealF         LReal;
+    typedef RealF                Real;
+    typedef REAL32               Word;
+    static const char* name() {return "single";}
+  };
+
+  //! Double precision fields
+  struct DoubleP
+  {
+    typedef LatticeFermionD      Fermion;
+    typedef LatticeHalfFermionD  HalfFermion;
+    typedef LatticeColorMatrixD  ColorMatrix;
+    typedef LatticeRealD         LReal;
+    typedef RealD                Real;
+    typedef REAL64               Word;
+    static const char* name() {return "double";}
+  };
+
+
+  //! Time every kernel in precision P on every block size and write the CSV lines
+  template<class P>
+  void benchPrecision(std::ostream& csv, const std::string& backend, int threads, double stream,
+		      const std::vector<Set*>& blocks)
+  {
+    typename P::Fermion x, y, z;
+    typename P::HalfFermion h, k;
+    typename P::ColorMatrix u, v, w;
+    typename P::LReal r;
+    gaussian(x); gaussian(y); gaussian(z);
+    gaussian(h); gaussian(k);
+    gaussian(u); gaussian(v); gaussian(w);
+    gaussian(r);
+
+    const typename P::Real a = 0.5;
+    const typename P::Real b = -0.25;
+
+    const double F = 2*Nc*Ns;          // reals of a fermion
+    const double H = Nc*Ns;            // and of a half fermion
+    const double M = 2*Nc*Nc;          // and of a colour matrix
+    const double mv = Nc*(8*Nc-2);     // flops of a matrix times a colour vector
+
+    std::vector<Kernel> kernels = {
+      {"blas", "vaxpy",   2*F, 3*F, [&](const Subset& s) {y[s] += a*x;}},
+      {"blas", "vaxmy",   2*F, 3*F, [&](const Subset& s) {y[s] -= a*x;}},
+      {"blas", "vaxpby",  3*F, 3*F, [&](const Subset& s) {y[s] = a*x + b*y;}},
+      {"blas", "vaxpbyz", 3*F, 3*F, [&](const Subset& s) {z[s] = a*x + b*y;}},
+      {"blas", "vaypx",   2*F, 3*F, [&](const Subset& s) {y[s] = x + a*y;}},
+      {"blas", "vscal",   F,   2*F, [&](const Subset& s) {z[s] = a*x;}},
+
+      {"su3", "m_eq_mm",   Nc*mv, 3*M, [&](const Subset& s) {w[s] = u*v;}},
+      {"su3", "m_eq_hm",   Nc*mv, 3*M, [&](const Subset& s) {w[s] = adj(u)*v;}},
+      {"su3", "m_eq_mh",   Nc*mv, 3*M, [&](const Subset& s) {w[s] = u*adj(v);}},
+      {"su3", "m_eq_hh",   Nc*mv, 3*M, [&](const Subset& s) {w[s] = adj(u)*adj(v);}},
+      {"su3", "m_peq_mm",  Nc*mv + M, 3*M, [&](const Subset& s) {w[s] += u*v;}},
+      {"su3", "mat_vec",   Ns*mv, M + 2*F, [&](const Subset& s) {z[s] = u*x;}},
+      {"su3", "adj_mat_vec", Ns*mv, M + 2*F, [&](const Subset& s) {z[s] = adj(u)*x;}},
+      {"su3", "mat_hvec",  (Ns/2)*mv, M + 2*H, [&](const Subset& s) {k[s] = u*h;}},
+      {"su3", "adj_mat_hvec", (Ns/2)*mv, M + 2*H, [&](const Subset& s) {k[s] = adj(u)*h;}},
+
+      {"spin", "proj_dir0_plus",    H, F + H, [&](const Subset& s) {h[s] = spinProjectDir0Plus(x);}},
+      {"spin", "proj_dir3_minus",   H, F + H, [&](const Subset& s) {h[s] = spinProjectDir3Minus(x);}},
+      {"spin", "recon_dir0_plus",   0, H + F, [&](const Subset& s) {z[s] = spinReconstructDir0Plus(h);}},
+      {"spin", "recon_peq_dir3_minus", F, H + 2*F, [&](const Subset& s) {z[s] += spinReconstructDir3Minus(h);}},
+      {"spin", "mat_proj_dir1_plus", (Ns/2)*mv + H, M + F + H, [&](const Subset& s) {k[s] = u*spinProjectDir1Plus(x);}},
+      {"spin", "adj_mat_proj_dir2_minus", (Ns/2)*mv + H, M + F + H, [&](const Subset& s) {k[s] = adj(u)*spinProjectDir2Minus(x);}},
+
+      {"reduce", "norm2",            2*F, F,   [&](const Subset& s) {Double d = norm2(x, s);}},
+      {"reduce", "innerProduct",     4*F, 2*F, [&](const Subset& s) {DComplex d = innerProduct(x, y, s);}},
+      {"reduce", "innerProductReal", 2*F, 2*F, [&](const Subset& s) {Double d = innerProductReal(x, y, s);}},
+      {"reduce", "sum",              1,   1,   [&](const Subset& s) {Double d = sum(r, s);}},
+    };
+
+    const double word = sizeof(typename P::Word);
+
+    for(int b=0; b < blocks.size(); ++b)
+    {
+      const Subset& s = (*blocks[b])[0];
+      const double sites = s.numSiteTable();
+
+      for(int i=0; i < kernels.size(); ++i)
+      {
+	const Kernel& kern = kernels[i];
+	const double secs = timeCall([&]() {kern.run(s);});
+	const double gbs  = kern.words*word*sites / secs / 1.0e9;
+	const double gfs  = kern.flops*sites / secs / 1.0e9;
+
+	if (Layout::primaryNode())
+	{
+	  char line[512];
+	  snprintf(line, sizeof(line), "%s,%s,%d,%s,%s,%.0f,%.0f,%.0f,%.6g,%.4f,%.4f,%.4f,%.4f\n",
+		   backend.c_str(), P::name(), threads, kern.group, kern.name,
+		   sites, kern.words*word, kern.flops, secs, gbs, gfs, stream, gbs/stream);
+	  csv << line << std::flush;
+	}
+      }
+    }
+  }
+
+  //! Backends the kernels can be switched between at run time
+  std::vector<std::string> backends()
+  {
+    std::vector<std::string> names;
+#if QDP_USE_SSE == 1
+    names.push_back("sse");
+    AVX::setLevel(AVX::LEVEL_AVX2);
+    if (AVX::level() == AVX::LEVEL_AVX2)
+      names.push_back("avx2");
+    AVX::setLevel(AVX::LEVEL_AVX512);
+    if (AVX::level() == AVX::LEVEL_AVX512)
+      names.push_back("avx512");
+#elif QDP_USE_BAGEL_QDP == 1
+    names.push_back("bagel");
+#elif defined(QDP_USE_GENERIC_OPTS)
+    names.push_back("generic");
+#else
+    names.push_back("none");
+#endif
+    return names;
+  }
+
+  //! Use the kernels of the named backend
+  void useBackend(const std::string& name)
+  {
+#if QDP_USE_SSE == 1
+    if (name == "sse")
+      AVX::setLevel(AVX::LEVEL_SSE);
+    else if (name == "avx2")
+      AVX::setLevel(AVX::LEVEL_AVX2);
+    else if (name == "avx512")
+      AVX::setLevel(AVX::LEVEL_AVX512);
+#endif
+  }
+}
+
+
+int main(int argc, char **argv)
+{
+  QDP_initialize(&argc, &argv);
+
+  multi1d<int> nrow(Nd);
+  nrow = 16;
+  std::vector<int> thread_counts;
+  std::string csv_file;
+
+  for(int i=1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-lat") == 0 && i+Nd < argc)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+	nrow[mu] = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-secs") == 0 && i+1 < argc)
+      secsPerPoint() = atof(argv[++i]);
+    else if (strcmp(argv[i], "-threads") == 0 && i+1 < argc)
+      thread_counts = parseList(argv[++i]);
+    else if (strcmp(argv[i], "-csv") == 0 && i+1 < argc)
+      csv_file = argv[++i];
+  }
+
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // Blocks from a few cache lines of fermions to the whole node
+  std::vector<Set*> blocks;
+  const int node_sites = Layout::sitesOnNode();
+  for(int n=std::min(64, node_sites); ; n *= 4)
+  {
+    n = std::min(n, node_sites);
+    blocks.push_back(new Set);
+    blocks.back()->make(BlockFunc(n));
+    if (n == node_sites)
+      break;
+  }
+
+  const int max_threads = qdpNumThreads();
+  if (thread_counts.empty())
+  {
+    for(int t=1; t < max_threads; t *= 2)
+      thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+  }
+
+  std::ofstream csv_out;
+  if (Layout::primaryNode() && ! csv_file.empty())
+  {
+    csv_out.open(csv_file.c_str());
+    if (! csv_out)
+    {
+      QDPIO::cerr << "bench_kernels: cannot write " << csv_file << std::endl;
+      QDP_abort(1);
+    }
+  }
+  std::ostream& csv = csv_file.empty() ? std::cout : csv_out;
+
+  if (Layout::primaryNode())
+    csv << "backend,precision,threads,group,kernel,sites,bytes_per_site,flops_per_site,"
+	<< "sec_per_call,gbytes_per_sec,gflops_per_sec,stream_gbytes_per_sec,fraction_of_stream" << std::endl;
+
+  const std::vector<std::string> backend_names = backends();
+
+  for(int t=0; t < thread_counts.size(); ++t)
+  {
+    int threads = max_threads;
+#if defined(QDP_USE_OMP_THREADS)
+    threads = std::max(1, std::min(thread_counts[t], max_threads));
+    omp_set_num_threads(threads);
+#else
+    // The thread count is fixed at QDP_initialize
+    if (t > 0)
+      break;
+#endif
+
+    const double stream = streamTriad();
+    QDPIO::cout << "bench_kernels: " << threads << " threads, STREAM triad " << stream << " GB/s" << std::endl;
+
+    for(int be=0; be < backend_names.size(); ++be)
+    {
+      useBackend(backend_names[be]);
+      benchPrecision<SingleP>(csv, backend_names[be], threads, stream, blocks);
+      benchPrecision<DoubleP>(csv, backend_names[be], threads, stream, blocks);
+    }
+  }
+
+#if defined(QDP_USE_OMP_THREADS)
+  omp_set_num_threads(max_threads);
+#endif
+
+  for(int b=0; b < blocks.size(); ++b)
+    delete blocks[b];
+
+  QDP_finalize();
+  exit(0);
+}
@@ -0,0 +1,494 @@
+/*! \file
+ * \brief Cost of the expression templates against hand-written site loops
+ *
+ * Each expression of a fixed set, from one leaf to six, with scalar and
+ * lattice leaves mixed and with and without shifts, is timed twice on the
+ * same fields: once as a QDP statement through evaluate, and once as a
+ * loop over the sites written by hand on the words of the fields, over
+ * the same thread ranges. The ratio of the two times is the cost of
+ * forEach, EvalLeaf1 and OpCombine and of whatever the compiler did not
+ * see through; a ratio near one means the expression is as good as the
+ * loop, a larger one that a specialisation or a fix in the tree is worth
+ * having. Where the kernel allows it, the instructions retired per site
+ * are counted as well, on one thread, so compilers can be compared on
+ * the code they emit and not only on the time.
+ *
+ *   bench_pete [-lat X Y Z T] [-secs s] [-threads 1,2,4] [-csv file]
+ *
+ * Statements that a backend replaces by its own kernel (vaxpy, the SU(3)
+ * products) time that kernel, as a program would see it. The hand loops
+ * of the shifted expressions read the neighbours through a table of the
+ * node, so they are only timed on one node. Each expression is checked
+ * against its loop before it is timed and the largest difference is in
+ * the CSV.
+ */
+
+#include "qdp.h"
+#include "benchutil.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace QDP;
+using namespace Bench;
+
+namespace
+{
+  //! Instructions retired by the calling thread, where the kernel counts them
+  class InstructionCounter
+  {
+  public:
+    InstructionCounter() : fd(-1)
+      {
+#if defined(__linux__)
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+      }
+
+    ~InstructionCounter()
+      {
+#if defined(__linux__)
+	if (fd >= 0)
+	  ::close(fd);
+#endif
+      }
+
+    bool available() const {return fd >= 0;}
+
+    //! Instructions of n calls of f, NaN if they cannot be counted
+    double count(const std::function<void()>& f, int n)
+      {
+	double ins = std::numeric_limits<double>::quiet_NaN();
+#if defined(__linux__)
+	if (fd < 0)
+	  return ins;
+
+	ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	for(int i=0; i < n; ++i)
+	  f();
+	ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+	long long c;
+	if (::read(fd, &c, sizeof(c)) == sizeof(c))
+	  ins = c;
+#endif
+	return ins;
+      }
+
+  private:
+    InstructionCounter(const InstructionCounter&);
+    void operator=(const InstructionCounter&);
+
+    int fd;
+  };
+
+
+  //! d = m v, or adj(m) v, on colour vectors of complex words
+  template<class W>
+  inline void matVec(W* d, const W* m, const W* v, bool adj_m)
+  {
+    for(int i=0; i < Nc; ++i)
+    {
+      W re = 0, im = 0;
+      for(int j=0; j < Nc; ++j)
+      {
+	const W* a = adj_m ? m + 2*(j*Nc + i) : m + 2*(i*Nc + j);
+	const W ai = adj_m ? -a[1] : a[1];
+	re += a[0]*v[2*j] - ai*v[2*j+1];
+	im += a[0]*v[2*j+1] + ai*v[2*j];
+      }
+      d[2*i] = re;
+      d[2*i+1] = im;
+    }
+  }
+
+  //! d = a b, or d += a b, with b adjoint when adj_b
+  template<class W>
+  inline void matMat(W* d, const W* a, const W* b, bool adj_b, bool accum)
+  {
+    for(int i=0; i < Nc; ++i)
+      for(int k=0; k < Nc; ++k)
+      {
+	W re = 0, im = 0;
+	for(int j=0; j < Nc; ++j)
+	{
+	  const W* x = a + 2*(i*Nc + j);
+	  const W* y = adj_b ? b + 2*(k*Nc + j) : b + 2*(j*Nc + k);
+	  const W yi = adj_b ? -y[1] : y[1];
+	  re += x[0]*y[0] - x[1]*yi;
+	  im += x[0]*yi + x[1]*y[0];
+	}
+	if (accum)
+	{
+	  d[2*(i*Nc + k)] += re;
+	  d[2*(i*Nc + k)+1] += im;
+	}
+	else
+	{
+	  d[2*(i*Nc + k)] = re;
+	  d[2*(i*Nc + k)+1] = im;
+	}
+      }
+  }
+
+  //! Largest difference of the words of two fields
+  template<class T>
+  double maxDiff(const OLattice<T>& a, const OLattice<T>& b)
+  {
+    typedef typename WordType<T>::Type_t W;
+    const int n = Layout::sitesOnNode()*(sizeof(T)/sizeof(W));
+    const W* x = (const W*)a.getF();
+    const W* y = (const W*)b.getF();
+
+    double d = 0;
+    for(int k=0; k < n; ++k)
+      d = std::max(d, std::fabs(double(x[k]) - double(y[k])));
+
+    return toDouble(globalMax(Double(d)));
+  }
+
+  //! The linear index on the node of the neighbour of each site in direction mu
+  std::vector<int> forwardNeighbours(int mu)
+  {
+    std::vector<int> nb(Layout::sitesOnNode());
+    for(int i=0; i < nb.size(); ++i)
+    {
+      multi1d<int> x = Layout::siteCoords(Layout::nodeNumber(), i);
+      x[mu] = (x[mu] + 1) % Layout::lattSize()[mu];
+      nb[i] = Layout::linearSiteIndex(x);
+    }
+    return nb;
+  }
+
+
+  //! One expression and its hand-written loop
+  struct Expression
+  {
+    const char* name;
+    int leaves;                   // lattice and scalar leaves
+    int scalars;                  // of them OScalar
+    int shifts;
+    std::function<void()> init;   // the same start for both, before the check
+    std::function<void()> pete;
+    std::function<void()> hand;
+    std::function<double()> diff;
+  };
+
+
+  //! Single precision fields
+  struct SingleP
+  {
+    typedef LatticeFermionF      Fermion;
+    typedef LatticeColorMatrixF  LColorMatrix;
+    typedef ColorMatrixF         ColorMatrix;
+    typedef RealF                Real;
+    typedef REAL32               Word;
+    static const char* name() {return "single";}
+  };
+
+  //! Double precision fields
+  struct DoubleP
+  {
+    typedef LatticeFermionD      Fermion;
+    typedef LatticeColorMatrixD  LColorMatrix;
+    typedef ColorMatrixD         ColorMatrix;
+    typedef RealD                Real;
+    typedef REAL64               Word;
+    static const char* name() {return "double";}
+  };
+
+
+  //! Time every expression in precision P and write the CSV lines
+  template<class P>
+  void benchPrecision(std::ostream& csv, int threads)
+  {
+    typedef typename P::Word W;
+    typedef typename P::Fermion::Subtype_t FSite;
+    typedef typename P::LColorMatrix::Subtype_t MSite;
+
+    typename P::Fermion x, y, v, z, zh;
+    typename P::LColorMatrix u, t, w, wh, w0;
+    typename P::ColorMatrix m;
+    gaussian(x); gaussian(y); gaussian(v);
+    gaussian(u); gaussian(t); gaussian(w0);
+
+    multi1d<int> origin(Nd);
+    origin = 0;
+    m = peekSite(t, origin);
+
+    const typename P::Real a = 0.5;
+    const typename P::Real b = -0.25;
+    const typename P::Real c = 0.125;
+    const W aw = toWordType(a), bw = toWordType(b), cw = toWordType(c);
+
+    const int F = sizeof(FSite)/sizeof(W);     // words of a fermion
+    const int M = sizeof(MSite)/sizeof(W);     // and of a colour matrix
+    const int Cv = 2*Nc;                       // and of a colour vector
+
+    const W* xs = (const W*)x.getF();
+    const W* ys = (const W*)y.getF();
+    const W* vs = (const W*)v.getF();
+    const W* us = (const W*)u.getF();
+    const W* ts = (const W*)t.getF();
+    const W* ms = (const W*)&m.elem();
+
+    // The hand loops write the sites of zh and wh, which stay where they are
+    W* zd = (W*)zh.data();
+    W* wd = (W*)wh.data();
+
+    const bool one_node = (Layout::numNodes() == 1);
+    const std::vector<int> nb0 = forwardNeighbours(0);
+    const std::vector<int> nb1 = forwardNeighbours(1 % Nd);
+
+    const int* tab = all.siteTable().slice();
+
+    // A loop over the sites of all on the threads of evaluate, written
+    // out per expression so that the compiler sees each one whole
+#define HAND_LOOP(BYTES, BODY)						\
+    dispatch_range(all, BYTES, [&](int lo, int hi, int myId) {		\
+	for(int j=lo; j < hi; ++j)					\
+	{								\
+	  const int i = tab[j];						\
+	  BODY;								\
+	}								\
+      })
+
+    auto fdiff = [&]() {return maxDiff(z, zh);};
+    auto mdiff = [&]() {return maxDiff(w, wh);};
+    auto none = [&]() {};
+
+    std::vector<Expression> exprs = {
+      {"copy", 1, 0, 0, none,
+       [&]() {z = x;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int k=0; k < F; ++k) zd[i*F+k] = xs[i*F+k]);},
+       fdiff},
+
+      {"add", 2, 0, 0, none,
+       [&]() {z = x + y;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int k=0; k < F; ++k) zd[i*F+k] = xs[i*F+k] + ys[i*F+k]);},
+       fdiff},
+
+      {"axpy", 3, 1, 0, none,
+       [&]() {z = a*x + y;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int k=0; k < F; ++k) zd[i*F+k] = aw*xs[i*F+k] + ys[i*F+k]);},
+       fdiff},
+
+      {"axpby", 4, 2, 0, none,
+       [&]() {z = a*x + b*y;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int k=0; k < F; ++k) zd[i*F+k] = aw*xs[i*F+k] + bw*ys[i*F+k]);},
+       fdiff},
+
+      {"axpbypcz", 6, 3, 0, none,
+       [&]() {z = a*x + b*y + c*v;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int k=0; k < F; ++k)
+			  zd[i*F+k] = aw*xs[i*F+k] + bw*ys[i*F+k] + cw*vs[i*F+k]);},
+       fdiff},
+
+      {"scalar_mat_vec", 2, 1, 0, none,
+       [&]() {z = m*x;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int s=0; s < Ns; ++s)
+			  matVec(zd + i*F + s*Cv, ms, xs + i*F + s*Cv, false));},
+       fdiff},
+
+      {"mat_vec", 2, 0, 0, none,
+       [&]() {z = u*x;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int s=0; s < Ns; ++s)
+			  matVec(zd + i*F + s*Cv, us + i*M, xs + i*F + s*Cv, false));},
+       fdiff},
+
+      {"adj_mat_vec_axpy", 4, 1, 0, none,
+       [&]() {z = adj(u)*x + a*y;},
+       [&]() {HAND_LOOP(sizeof(FSite), for(int s=0; s < Ns; ++s)
+			  {
+			    W* d = zd + i*F + s*Cv;
+			    matVec(d, us + i*M, xs + i*F + s*Cv, true);
+			    for(int k=0; k < Cv; ++k)
+			      d[k] += aw*ys[i*F + s*Cv + k];
+			  });},
+       fdiff},
+
+      {"mat_mat", 2, 0, 0, none,
+       [&]() {w = u*t;},
+       [&]() {HAND_LOOP(sizeof(MSite), matMat(wd + i*M, us + i*M, ts + i*M, false, false));},
+       mdiff},
+
+      {"mat_mat_peq", 2, 0, 0,
+       [&]() {w = w0; wh = w0;},
+       [&]() {w += u*t;},
+       [&]() {HAND_LOOP(sizeof(MSite), matMat(wd + i*M, us + i*M, ts + i*M, false, true));},
+       mdiff},
+
+      {"shift", 1, 0, 1, none,
+       [&]() {z = shift(x, FORWARD, 0);},
+       [&]() {HAND_LOOP(sizeof(FSite), const int n = nb0[i]; for(int k=0; k < F; ++k) zd[i*F+k] = xs[n*F+k]);},
+       fdiff},
+
+      {"hop", 2, 0, 1, none,
+       [&]() {z = u*shift(x, FORWARD, 0);},
+       [&]() {HAND_LOOP(sizeof(FSite), const int n = nb0[i]; for(int s=0; s < Ns; ++s)
+			  matVec(zd + i*F + s*Cv, us + i*M, xs + n*F + s*Cv, false));},
+       fdiff},
+
+      {"hop_axpy", 4, 1, 1, none,
+       [&]() {z = y + a*(u*shift(x, FORWARD, 0));},
+       [&]() {HAND_LOOP(sizeof(FSite), const int n = nb0[i]; for(int s=0; s < Ns; ++s)
+			  {
+			    W h[2*Nc];
+			    matVec(h, us + i*M, xs + n*F + s*Cv, false);
+			    for(int k=0; k < Cv; ++k)
+			      zd[i*F + s*Cv + k] = ys[i*F + s*Cv + k] + aw*h[k];
+			  });},
+       fdiff},
+
+      {"staple", 3, 0, 2, none,
+       [&]() {w = u*shift(t, FORWARD, 0)*adj(shift(u, FORWARD, 1 % Nd));},
+       [&]() {HAND_LOOP(sizeof(MSite),
+			W h[2*Nc*Nc];
+			matMat(h, us + i*M, ts + nb0[i]*M, false, false);
+			matMat(wd + i*M, h, us + nb1[i]*M, true, false));},
+       mdiff},
+    };
+
+#undef HAND_LOOP
+
+    InstructionCounter counter;
+    const double nsites = Layout::sitesOnNode();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    for(int e=0; e < exprs.size(); ++e)
+    {
+      const Expression& ex = exprs[e];
+      const bool hand = one_node || ex.shifts == 0;
+
+      double diff = nan;
+      if (hand)
+      {
+	ex.init();
+	ex.pete();
+	ex.hand();
+	diff = ex.diff();
+      }
+
+      const double sec_pete = timeCall(ex.pete);
+      const double sec_hand = hand ? timeCall(ex.hand) : nan;
+
+      // The instructions of one thread doing all the sites
+      double ins_pete = nan, ins_hand = nan;
+      if (counter.available())
+      {
+#if defined(QDP_USE_OMP_THREADS)
+	omp_set_num_threads(1);
+#endif
+	if (qdpNumThreads() == 1)
+	{
+	  const int reps = 4;
+	  ins_pete = counter.count(ex.pete, reps) / (reps*nsites);
+	  if (hand)
+	    ins_hand = counter.count(ex.hand, reps) / (reps*nsites);
+	}
+#if defined(QDP_USE_OMP_THREADS)
+	omp_set_num_threads(threads);
+#endif
+      }
+
+      if (Layout::primaryNode())
+      {
+	char line[512];
+	snprintf(line, sizeof(line), "%s,%d,%s,%d,%d,%d,%.0f,%.6g,%.6g,%.4f,%.1f,%.1f,%.3g\n",
+		 P::name(), threads, ex.name, ex.leaves, ex.scalars, ex.shifts, nsites,
+		 sec_pete, sec_hand, sec_pete/sec_hand, ins_pete, ins_hand, diff);
+	csv << line << std::flush;
+      }
+    }
+  }
+}
+
+
+int main(int argc, char **argv)
+{
+  QDP_initialize(&argc, &argv);
+
+  multi1d<int> nrow(Nd);
+  nrow = 8;
+  std::vector<int> thread_counts;
+  std::string csv_file;
+
+  for(int i=1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "-lat") == 0 && i+Nd < argc)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+	nrow[mu] = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-secs") == 0 && i+1 < argc)
+      secsPerPoint() = atof(argv[++i]);
+    else if (strcmp(argv[i], "-threads") == 0 && i+1 < argc)
+      thread_counts = parseList(argv[++i]);
+    else if (strcmp(argv[i], "-csv") == 0 && i+1 < argc)
+      csv_file = argv[++i];
+  }
+
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  const int max_threads = qdpNumThreads();
+  if (thread_counts.empty())
+    thread_counts.push_back(max_threads);
+
+  std::ofstream csv_out;
+  if (Layout::primaryNode() && ! csv_file.empty())
+  {
+    csv_out.open(csv_file.c_str());
+    if (! csv_out)
+    {
+      QDPIO::cerr << "bench_pete: cannot write " << csv_file << std::endl;
+      QDP_abort(1);
+    }
+  }
+  std::ostream& csv = csv_file.empty() ? std::cout : csv_out;
+
+  if (Layout::primaryNode())
+    csv << "precision,threads,expression,leaves,scalar_leaves,shifts,sites,"
+	<< "sec_pete,sec_hand,pete_over_hand,instructions_per_site_pete,instructions_per_site_hand,"
+	<< "max_abs_diff" << std::endl;
+
+  for(int t=0; t < thread_counts.size(); ++t)
+  {
+    int threads = max_threads;
+#if defined(QDP_USE_OMP_THREADS)
+    threads = std::max(1, std::min(thread_counts[t], max_threads));
+    omp_set_num_threads(threads);
+#else
+    // The thread count is fixed at QDP_initialize
+    if (t > 0)
+      break;
+#endif
+
+    benchPrecision<SingleP>(csv, threads);
+    benchPrecision<DoubleP>(csv, threads);
+  }
+
+#if defined(QDP_USE_OMP_THREADS)
+  omp_set_num_threads(max_threads);
+#endif
+
+  QDP_finalize();
+  exit(0);
+}
@@ -0,0 +1,86 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+/*! \file
+ * \brief Timing shared by the bench_* programs
+ */
+
+#include "qdp.h"
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+  using namespace QDP;
+
+  //! Seconds spent timing each point
+  inline double& secsPerPoint()
+  {
+    static double secs = 0.2;
+    return secs;
+  }
+
+  //! Seconds per call of f, calling it until secsPerPoint() have passed
+  /*! Every node makes the same number of calls, so f may communicate */
+  inline double timeCall(const std::function<void()>& f)
+  {
+    f();
+
+    StopWatch swatch;
+    double secs = 0;
+    int iters = 1;
+    for(;;)
+    {
+      swatch.reset();
+      swatch.start();
+      for(int i=0; i < iters; ++i)
+	f();
+      swatch.stop();
+      secs = swatch.getTimeInSeconds();
+
+      // The primary node decides for all, each keeps its own time
+      double lead = secs;
+      QDPInternal::broadcast(lead);
+      if (lead >= secsPerPoint() || iters >= (1 << 30))
+	break;
+      iters = int(iters * ((lead > 0) ? std::min(16.0, std::max(2.0, 1.2*secsPerPoint()/lead)) : 16.0));
+    }
+    return secs / iters;
+  }
+
+  //! Smallest, mean and largest of v over the nodes
+  inline void nodeSpread(double v, double& vmin, double& vmean, double& vmax)
+  {
+    const int nodes = Layout::numNodes();
+    std::vector<double> all(nodes, 0.0);
+    all[Layout::nodeNumber()] = v;
+    QDPInternal::globalSumArray(&all[0], nodes);
+
+    vmin = *std::min_element(all.begin(), all.end());
+    vmax = *std::max_element(all.begin(), all.end());
+    vmean = 0;
+    for(int n=0; n < nodes; ++n)
+      vmean += all[n] / nodes;
+  }
+
+  //! Parse a list like 1,2,4
+  inline std::vector<int> parseList(const char* s)
+  {
+    std::vector<int> v;
+    for(const char* p=s; *p; )
+    {
+      v.push_back(atoi(p));
+      while (*p && *p != ',')
+	++p;
+      if (*p == ',')
+	++p;
+    }
+    return v;
+  }
+}
+
+#endif